@@ -3,7 +3,10 @@
 // This code is licensed under the terms of the Eclipse Public License (EPL).
 
 /*! \file feature-extractor.cpp
-  \brief Example of using the class OsiFeatures to extract problem features from a Mixed-Integer Linear Program
+  \brief Example of using CbcModel::computeFeatures to extract problem features from a Mixed-Integer Linear Program
+
+  Features are found from bounds, types and the matrix without solving an LP,
+  so this is cheap enough to do before every solve.
 
 */
 
@@ -11,7 +14,8 @@
 #include <cstdlib>
 #include <cstring>
 #include <OsiClpSolverInterface.hpp>
-#include <OsiFeatures.hpp>
+#include <CbcModel.hpp>
+#include <CbcFeatures.hpp>
 
 char *basename(char *dest, const char *fileWithPath);
 
@@ -22,9 +26,9 @@ int main( int argc, char ** argv ) {
   }
 
   if (strcmp(argv[1], "-header") == 0) {
-    printf("%s", OsiFeatures::name(0));
-    for ( int i=1 ; (i<OsiFeatures::n) ; ++i )
-      printf(",%s", OsiFeatures::name(i));
+    printf("%s", CbcFeatures::name(0));
+    for ( int i=1 ; (i<CbcFeatures::numberFeatures) ; ++i )
+      printf(",%s", CbcFeatures::name(i));
     printf("\n"); fflush(stdout);
     exit(0);
   }
@@ -39,11 +43,12 @@ int main( int argc, char ** argv ) {
   char instance[256];
   basename(instance, argv[1]);
 
-  double *features = new double[OsiFeatures::n];
-  OsiFeatures::compute(features, &solver);
+  CbcModel model(solver);
+  double *features = new double[CbcFeatures::numberFeatures];
+  model.computeFeatures(features);
 
   printf("%s", instance);
-  for ( int i=0 ; i<OsiFeatures::n ; ++i )
+  for ( int i=0 ; i<CbcFeatures::numberFeatures ; ++i )
     printf(",%g", features[i]);
   printf("\n"); fflush(stdout);
 
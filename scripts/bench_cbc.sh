@@ -0,0 +1,157 @@
+#!/bin/bash
+#* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+#*                                                                           *
+#*            Benchmark runs of cbc over a test set with seeds and threads   *
+#*                                                                           *
+#* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+#
+# usage: bench_cbc.sh BINARY TESTSET DATADIR TIMELIMIT [SEEDS [THREADS [BASELINE]]]
+#        bench_cbc.sh -perf BINARY TESTSET DATADIR [BASELINE [TOLERANCE]]
+#
+#  BINARY    cbc executable
+#  TESTSET   file with one instance name per line (see scripts/bench.test),
+#            with -perf instance name and node limit (see scripts/perf.test)
+#  DATADIR   directory with instances (name, name.mps or name.mps.gz)
+#  TIMELIMIT seconds for each run
+#  SEEDS     list of values for randomCbcSeed (default "1 2 3")
+#  THREADS   list of thread counts (default "0")
+#  BASELINE  results file from an earlier run to compare against
+#  TOLERANCE allowed relative slow down with -perf (default 0.2)
+#
+# Each run is logged in results/bench/ and results/bench.<TESTSET>.csv has
+# one line per run (see parse_bench.awk).  Summary with shifted geometric
+# means (and comparison with BASELINE) is in results/bench.<TESTSET>.res
+#
+# With -perf (performance regression check) each instance is run once
+# without threads, with seed 1 and its node limit, so the work done is the
+# same from run to run.  Logs are in results/perf/ and the csv file is
+# results/perf.<TESTSET>.csv - keep it as the baseline for later runs.
+# With BASELINE exit status is 1 if time or nodes per second of any
+# instance is outside TOLERANCE of the baseline or an instance is no
+# longer solved (see check_perf.awk).
+# Environment: BENCHGAP - relative gap for time to gap (default 0.01)
+#              PERFTIMELIMIT - seconds limit guarding -perf runs (default 3600)
+
+if test "$1" = "-perf"
+then
+    shift
+    MODE=perf
+    BINNAME=$1
+    TSTFILE=$2
+    DATADIR=$3
+    BASELINE=$4
+    TOLERANCE=${5:-0.2}
+    TIMELIMIT=${PERFTIMELIMIT:-3600}
+    SEEDS=1
+    THREADLIST=0
+    if test -z "$DATADIR"
+    then
+        echo "usage: $0 -perf BINARY TESTSET DATADIR [BASELINE [TOLERANCE]]"
+        exit 1
+    fi
+else
+    MODE=bench
+    BINNAME=$1
+    TSTFILE=$2
+    DATADIR=$3
+    TIMELIMIT=$4
+    SEEDS=${5:-"1 2 3"}
+    THREADLIST=${6:-"0"}
+    BASELINE=$7
+    if test -z "$TIMELIMIT"
+    then
+        echo "usage: $0 BINARY TESTSET DATADIR TIMELIMIT [SEEDS [THREADS [BASELINE]]]"
+        echo "       $0 -perf BINARY TESTSET DATADIR [BASELINE [TOLERANCE]]"
+        exit 1
+    fi
+fi
+GAP=${BENCHGAP:-0.01}
+
+SCRIPTPATH=`dirname $0`
+RESULTSPATH=`pwd`/results
+LOGPATH=$RESULTSPATH/$MODE
+TSTNAME=`basename $TSTFILE .test`
+
+# check if the solver and test set exist
+if test ! -x $BINNAME
+then
+    echo "ERROR: solver <$BINNAME> does not exist or is not executable"
+    exit 1
+fi
+if test ! -f $TSTFILE
+then
+    echo "ERROR: test set file <$TSTFILE> does not exist"
+    exit 1
+fi
+if test -n "$BASELINE" -a ! -f "$BASELINE"
+then
+    echo "ERROR: baseline <$BASELINE> does not exist"
+    exit 1
+fi
+
+mkdir -p $LOGPATH
+CSVFILE=$RESULTSPATH/$MODE.$TSTNAME.csv
+RESFILE=$RESULTSPATH/$MODE.$TSTNAME.res
+
+# post system information so results from different machines are not mixed
+echo "# `uname -a`" > $CSVFILE
+echo "# `date` binary $BINNAME timelimit $TIMELIMIT gap $GAP" >> $CSVFILE
+awk -v header=1 -f $SCRIPTPATH/parse_bench.awk /dev/null >> $CSVFILE
+
+while read i NODES
+do
+    if test -z "$i"
+    then
+        continue
+    fi
+    FILE=
+    for f in $DATADIR/$i $DATADIR/$i.mps $DATADIR/$i.mps.gz
+    do
+        if test -f $f
+        then
+            FILE=$f
+            break
+        fi
+    done
+    if test -z "$FILE"
+    then
+        echo @02 FILE NOT FOUND: $i ===========
+        continue
+    fi
+    LIMITS="-sec $TIMELIMIT"
+    if test $MODE = perf
+    then
+        LIMITS="$LIMITS -maxNodes $NODES"
+    fi
+    for THREADS in $THREADLIST
+    do
+        for SEED in $SEEDS
+        do
+            LOGFILE=$LOGPATH/$i.s$SEED.t$THREADS.log
+            echo @01 $i seed $SEED threads $THREADS $NODES
+            if test $THREADS != 0
+            then
+                $BINNAME -import $FILE $LIMITS -threads $THREADS -randomCbcSeed $SEED -solve > $LOGFILE 2>&1 < /dev/null
+            else
+                $BINNAME -import $FILE $LIMITS -randomCbcSeed $SEED -solve > $LOGFILE 2>&1 < /dev/null
+            fi
+            awk -v instance=$i -v seed=$SEED -v threads=$THREADS -v gap=$GAP \
+                -v timelimit=$TIMELIMIT -f $SCRIPTPATH/parse_bench.awk $LOGFILE >> $CSVFILE
+        done
+    done
+done < $TSTFILE
+
+if test $MODE = perf
+then
+    if test -n "$BASELINE"
+    then
+        awk -v tolerance=$TOLERANCE -f $SCRIPTPATH/check_perf.awk $CSVFILE $BASELINE
+    else
+        echo "No baseline - results are in $CSVFILE"
+    fi
+elif test -n "$BASELINE"
+then
+    awk -f $SCRIPTPATH/compare_bench.awk $CSVFILE $BASELINE | tee $RESFILE
+else
+    awk -f $SCRIPTPATH/compare_bench.awk $CSVFILE | tee $RESFILE
+fi
@@ -0,0 +1,81 @@
+#!/usr/bin/awk -f
+#* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+#*                                                                           *
+#*            Performance regression runs of cbc with fixed work limits      *
+#*                                                                           *
+#* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+#
+# usage: awk [-v tolerance=0.2] -f check_perf.awk RESULTS BASELINE
+#
+# Compares files written by bench_cbc.sh -perf instance by instance.  An
+# instance fails if its time (plus one second, so tiny times do not count)
+# is more than 1+tolerance times that of the baseline, if nodes per second
+# (nodes over time plus one second) is less than baseline over 1+tolerance
+# or if it was solved in the baseline and is not now.  Changed node and
+# iteration counts are only reported (search may change on purpose).
+# Exit status is 1 if any instance fails.
+
+BEGIN {
+   FS = ",";
+   if (tolerance == "")
+      tolerance = 0.2;
+   nfiles = 0;
+   nfailed = 0;
+}
+
+FNR == 1 {
+   nfiles++;
+}
+
+/^#/ || /^instance,/ {
+   next;
+}
+
+NF >= 12 {
+   solved = ($4 == "optimal" || $4 == "infeasible" || $4 == "unbounded");
+   if (nfiles == 1) {
+      order[++ninstances] = $1;
+      status[$1] = solved;
+      nodes[$1] = $7;
+      iterations[$1] = $8;
+      time[$1] = $9;
+   } else {
+      inbase[$1] = 1;
+      baseStatus[$1] = solved;
+      baseNodes[$1] = $7;
+      baseIterations[$1] = $8;
+      baseTime[$1] = $9;
+   }
+}
+
+END {
+   printf("%-12s %10s %10s %8s %10s %10s  %s\n", "instance", "time", "baseline",
+      "ratio", "nodes/sec", "baseline", "result");
+   for (k = 1; k <= ninstances; k++) {
+      i = order[k];
+      if (!(i in inbase)) {
+         printf("%-12s not in baseline\n", i);
+         continue;
+      }
+      ratio = (time[i] + 1.0) / (baseTime[i] + 1.0);
+      rate = nodes[i] / (time[i] + 1.0);
+      baseRate = baseNodes[i] / (baseTime[i] + 1.0);
+      result = "ok";
+      if (baseStatus[i] && !status[i])
+         result = "FAILED (not solved)";
+      else if (ratio > 1.0 + tolerance)
+         result = "FAILED (time)";
+      else if (rate * (1.0 + tolerance) < baseRate)
+         result = "FAILED (nodes/sec)";
+      if (result != "ok")
+         nfailed++;
+      if (nodes[i] != baseNodes[i] || iterations[i] != baseIterations[i])
+         result = result sprintf(" - nodes %d (%d) iterations %d (%d)",
+            nodes[i], baseNodes[i], iterations[i], baseIterations[i]);
+      printf("%-12s %10.2f %10.2f %8.3f %10.2f %10.2f  %s\n", i, time[i],
+         baseTime[i], ratio, rate, baseRate, result);
+   }
+   printf("%d instances, %d failed (tolerance %g)\n", ninstances, nfailed, tolerance);
+   if (nfailed)
+      exit 1;
+}
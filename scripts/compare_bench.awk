@@ -0,0 +1,118 @@
+#!/usr/bin/awk -f
+#* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+#*                                                                           *
+#*            Benchmark runs of cbc over a test set with seeds and threads   *
+#*                                                                           *
+#* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+#
+# usage: awk -f compare_bench.awk RESULTS [BASELINE]
+#
+# Summary of files written by bench_cbc.sh - shifted geometric means
+# (exp(mean(log(x+shift)))-shift) for each thread count.  With BASELINE
+# means are over runs (instance, seed, threads) in both files, ratios are
+# RESULTS/BASELINE and instances whose mean time changes by more than 10%
+# or which are solved in only one are listed.
+
+BEGIN {
+   FS = ",";
+   # fields and shifts
+   nfield = 6;
+   name[1] = "time";          column[1] = 9;  shift[1] = 10;
+   name[2] = "firstsolution"; column[2] = 10; shift[2] = 10;
+   name[3] = "timetogap";     column[3] = 11; shift[3] = 10;
+   name[4] = "nodes";         column[4] = 7;  shift[4] = 100;
+   name[5] = "iterations";    column[5] = 8;  shift[5] = 1000;
+   name[6] = "nodespersec";   column[6] = 12; shift[6] = 1;
+   nfiles = 0;
+}
+
+FNR == 1 {
+   nfiles++;
+}
+
+/^#/ || /^instance,/ {
+   next;
+}
+
+NF >= 12 {
+   key = $1 "," $2 "," $3;
+   if (nfiles == 1) {
+      keys[key] = 1;
+   } else {
+      inbase[key] = 1;
+   }
+   for (k = 1; k <= nfield; k++)
+      value[nfiles, key, k] = $(column[k]);
+   solved[nfiles, key] = ($4 == "optimal" || $4 == "infeasible" || $4 == "unbounded");
+   threadset[$3] = 1;
+   instance[key] = $1;
+   thread[key] = $3;
+}
+
+END {
+   baseline = (nfiles > 1);
+   for (t in threadset) {
+      n = 0;
+      nsolved[1] = 0;
+      nsolved[2] = 0;
+      for (k = 1; k <= nfield; k++) {
+         sum[1, k] = 0;
+         sum[2, k] = 0;
+      }
+      for (key in keys) {
+         if (thread[key] != t || (baseline && !(key in inbase)))
+            continue;
+         n++;
+         for (f = 1; f <= nfiles; f++) {
+            nsolved[f] += solved[f, key];
+            for (k = 1; k <= nfield; k++)
+               sum[f, k] += log(value[f, key, k] + shift[k]);
+         }
+      }
+      if (!n)
+         continue;
+      printf("threads %s: %d runs, %d solved", t, n, nsolved[1]);
+      if (baseline)
+         printf(" (baseline %d)", nsolved[2]);
+      printf("\n");
+      printf("%-14s %8s %12s", "", "shift", "geomean");
+      if (baseline)
+         printf(" %12s %8s", "baseline", "ratio");
+      printf("\n");
+      for (k = 1; k <= nfield; k++) {
+         mean1 = exp(sum[1, k] / n) - shift[k];
+         printf("%-14s %8g %12.2f", name[k], shift[k], mean1);
+         if (baseline) {
+            mean2 = exp(sum[2, k] / n) - shift[k];
+            printf(" %12.2f %8.3f", mean2, (mean1 + shift[k]) / (mean2 + shift[k]));
+         }
+         printf("\n");
+      }
+      printf("\n");
+   }
+   if (!baseline)
+      exit;
+   # changes by instance (mean over seeds)
+   for (key in keys) {
+      if (!(key in inbase))
+         continue;
+      ik = instance[key] "," thread[key];
+      count[ik]++;
+      time1[ik] += log(value[1, key, 1] + shift[1]);
+      time2[ik] += log(value[2, key, 1] + shift[1]);
+      solved1[ik] += solved[1, key];
+      solved2[ik] += solved[2, key];
+   }
+   printed = 0;
+   for (ik in count) {
+      ratio = exp((time1[ik] - time2[ik]) / count[ik]);
+      if (ratio > 1.1 || ratio < 1.0 / 1.1 || solved1[ik] != solved2[ik]) {
+         if (!printed) {
+            printf("%-20s %8s %8s %8s %8s\n", "instance,threads", "time", "ratio", "solved", "baseline");
+            printed = 1;
+         }
+         printf("%-20s %8.2f %8.3f %8d %8d\n", ik,
+            exp(time1[ik] / count[ik]) - shift[1], ratio, solved1[ik], solved2[ik]);
+      }
+   }
+}
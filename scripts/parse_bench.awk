@@ -0,0 +1,142 @@
+#!/usr/bin/awk -f
+#* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+#*                                                                           *
+#*            Benchmark runs of cbc over a test set with seeds and threads   *
+#*                                                                           *
+#* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+#
+# Turns log of one cbc run into one comma separated line
+#
+#  instance,seed,threads,status,objective,bound,nodes,iterations,time,
+#  firstsolution,timetogap,nodespersec
+#
+# variables: instance, seed, threads - written as given
+#            gap - relative gap for timetogap (default 0.01)
+#            timelimit - used for firstsolution and timetogap if not reached
+#            header - if set just write names of fields
+# Times are wallclock seconds.  Gap is |solution-bound|/max(1,|solution|).
+
+BEGIN {
+   if (header) {
+      printf("instance,seed,threads,status,objective,bound,nodes,iterations,time,firstsolution,timetogap,nodespersec\n");
+      exit;
+   }
+   if (gap == "")
+      gap = 0.01;
+   status = "unknown";
+   solution = 1.0e50;
+   bound = -1.0e50;
+   nodes = 0;
+   iterations = 0;
+   time = -1;
+   cputime = 0;
+   firstsolution = -1;
+   timetogap = -1;
+   lasttime = 0;
+}
+
+# time in brackets at end of message
+function messagetime() {
+   if (match($0, /\([0-9.eE+-]+ seconds\)/))
+      lasttime = substr($0, RSTART + 1, RLENGTH - 10) + 0;
+   return lasttime;
+}
+
+function absolute(x) {
+   return x < 0 ? -x : x;
+}
+
+function checkgap(t) {
+   if (timetogap < 0 && solution < 1.0e49 && bound > -1.0e49) {
+      scale = absolute(solution);
+      if (scale < 1.0)
+         scale = 1.0;
+      if (absolute(solution - bound) <= gap * scale)
+         timetogap = t;
+   }
+}
+
+/Integer solution of/ {
+   for (i = 1; i < NF; i++) {
+      if ($i == "of") {
+         if ($(i + 1) + 0 < solution)
+            solution = $(i + 1) + 0;
+         break;
+      }
+   }
+   t = messagetime();
+   if (firstsolution < 0)
+      firstsolution = t;
+   checkgap(t);
+}
+
+/ best solution, best possible / {
+   for (i = 1; i < NF; i++) {
+      if ($i == "solution,") {
+         if ($(i - 2) + 0 < 1.0e49 && $(i - 2) + 0 < solution)
+            solution = $(i - 2) + 0;
+      }
+      if ($i == "possible")
+         bound = $(i + 1) + 0;
+   }
+   checkgap(messagetime());
+}
+
+/^Result - / {
+   if ($3 == "Optimal")
+      status = "optimal";
+   else if ($5 == "infeasible" || $3 == "Linear")
+      status = "infeasible";
+   else if ($5 == "unbounded")
+      status = "unbounded";
+   else if ($3 == "Stopped")
+      status = "stopped";
+   else
+      status = "other";
+}
+
+/^Objective value:/ {
+   solution = $3 + 0;
+}
+
+/^Lower bound:/ || /^Upper bound:/ {
+   bound = $3 + 0;
+}
+
+/^Enumerated nodes:/ {
+   nodes = $3 + 0;
+}
+
+/^Total iterations:/ {
+   iterations = $3 + 0;
+}
+
+/^Time \(CPU seconds\):/ {
+   cputime = $4 + 0;
+}
+
+/^Time \(Wallclock [Ss]econds\):/ {
+   time = $4 + 0;
+}
+
+END {
+   if (header)
+      exit;
+   if (time < 0)
+      time = cputime;
+   if (status == "optimal") {
+      bound = solution;
+      if (timetogap < 0)
+         timetogap = time;
+   }
+   if (status == "infeasible" && timetogap < 0)
+      timetogap = time;
+   if (firstsolution < 0)
+      firstsolution = timelimit != "" ? timelimit : time;
+   if (timetogap < 0)
+      timetogap = timelimit != "" ? timelimit : time;
+   printf("%s,%s,%s,%s,%.10g,%.10g,%d,%d,%.2f,%.2f,%.2f,%.2f\n",
+      instance, seed, threads, status,
+      solution < 1.0e49 ? solution : 1.0e50, bound, nodes, iterations,
+      time, firstsolution, timetogap, nodes / (time > 0.01 ? time : 0.01));
+}
@@ -0,0 +1,121 @@
+// Copyright (C) 2002, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#pragma warning(disable : 4786)
+#endif
+
+#include "CbcAsyncMessageHandler.hpp"
+
+// Constructor - writes to fp
+CbcAsyncMessageHandler::CbcAsyncMessageHandler(FILE *fp)
+  : CoinMessageHandler(fp)
+{
+#ifdef CBC_THREAD
+  startWriter();
+#endif
+}
+
+// Copy constructor - same file but own writer
+CbcAsyncMessageHandler::CbcAsyncMessageHandler(const CbcAsyncMessageHandler &rhs)
+  : CoinMessageHandler(rhs)
+{
+#ifdef CBC_THREAD
+  startWriter();
+#endif
+}
+
+// Destructor - writes what is left
+CbcAsyncMessageHandler::~CbcAsyncMessageHandler()
+{
+#ifdef CBC_THREAD
+  pthread_mutex_lock(&mutex_);
+  stop_ = true;
+  pthread_cond_signal(&work_);
+  pthread_mutex_unlock(&mutex_);
+  pthread_join(writerThread_, NULL);
+  pthread_cond_destroy(&done_);
+  pthread_cond_destroy(&work_);
+  pthread_mutex_destroy(&mutex_);
+#endif
+}
+
+// Clone
+CoinMessageHandler *CbcAsyncMessageHandler::clone() const
+{
+  return new CbcAsyncMessageHandler(*this);
+}
+
+// Put message in buffer for writer
+int CbcAsyncMessageHandler::print()
+{
+#ifdef CBC_THREAD
+  pthread_mutex_lock(&mutex_);
+  while (pending_.size() > maximumPending)
+    pthread_cond_wait(&done_, &mutex_);
+  pending_ += messageBuffer();
+  pending_ += '\n';
+  pthread_cond_signal(&work_);
+  pthread_mutex_unlock(&mutex_);
+  return 0;
+#else
+  return CoinMessageHandler::print();
+#endif
+}
+
+// Wait until all lines printed are written
+void CbcAsyncMessageHandler::flush()
+{
+#ifdef CBC_THREAD
+  pthread_mutex_lock(&mutex_);
+  while (pending_.size() || writing_)
+    pthread_cond_wait(&done_, &mutex_);
+  pthread_mutex_unlock(&mutex_);
+#endif
+  fflush(filePointer());
+}
+
+#ifdef CBC_THREAD
+// Start writer
+void CbcAsyncMessageHandler::startWriter()
+{
+  writing_ = false;
+  stop_ = false;
+  pthread_mutex_init(&mutex_, NULL);
+  pthread_cond_init(&work_, NULL);
+  pthread_cond_init(&done_, NULL);
+  pthread_create(&writerThread_, NULL, writer, this);
+}
+
+// What writing thread does
+void *CbcAsyncMessageHandler::writer(void *voidHandler)
+{
+  CbcAsyncMessageHandler *handler = reinterpret_cast< CbcAsyncMessageHandler * >(voidHandler);
+  std::string lines;
+  pthread_mutex_lock(&handler->mutex_);
+  while (true) {
+    while (!handler->stop_ && handler->pending_.empty())
+      pthread_cond_wait(&handler->work_, &handler->mutex_);
+    if (handler->pending_.empty())
+      break; // stopping and all written
+    lines.swap(handler->pending_);
+    handler->writing_ = true;
+    pthread_mutex_unlock(&handler->mutex_);
+    // write without lock so print is not held up
+    FILE *fp = handler->filePointer();
+    fwrite(lines.c_str(), 1, lines.size(), fp);
+    fflush(fp);
+    lines.clear();
+    pthread_mutex_lock(&handler->mutex_);
+    handler->writing_ = false;
+    pthread_cond_broadcast(&handler->done_);
+  }
+  pthread_mutex_unlock(&handler->mutex_);
+  return NULL;
+}
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -0,0 +1,71 @@
+// Copyright (C) 2002, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcAsyncMessageHandler_H
+#define CbcAsyncMessageHandler_H
+
+#include <cstdio>
+#include <string>
+
+#include "CoinMessageHandler.hpp"
+#include "CbcConfig.h"
+#ifdef CBC_THREAD
+#include <pthread.h>
+#endif
+
+/** Message handler which writes on a thread of its own
+
+    print() only appends the line to a buffer, so a slow terminal or file
+    does not hold up the search.  Lines are written in order by a writer
+    thread.  If the writer gets more than maximumPending bytes behind,
+    print waits for it (so memory is bounded).  Without threads this is
+    just a CoinMessageHandler.
+
+    Use with CbcModel::passInMessageHandler.
+*/
+
+class CBCLIB_EXPORT CbcAsyncMessageHandler : public CoinMessageHandler {
+public:
+  /// Constructor - writes to fp
+  CbcAsyncMessageHandler(FILE *fp = stdout);
+  /// Copy constructor - same file but own writer
+  CbcAsyncMessageHandler(const CbcAsyncMessageHandler &rhs);
+  /// Destructor - writes what is left
+  virtual ~CbcAsyncMessageHandler();
+  /// Put message in buffer for writer
+  virtual int print();
+  /// Clone
+  virtual CoinMessageHandler *clone() const;
+  /// Wait until all lines printed are written
+  void flush();
+
+private:
+  /// Illegal assignment operator
+  CbcAsyncMessageHandler &operator=(const CbcAsyncMessageHandler &rhs);
+#ifdef CBC_THREAD
+  /// Start writer
+  void startWriter();
+  /// What writing thread does
+  static void *writer(void *handler);
+  /// Bytes kept before print waits for writer
+  enum {
+    maximumPending = 1048576
+  };
+
+  /// Lines not yet written
+  std::string pending_;
+  pthread_mutex_t mutex_;
+  pthread_cond_t work_; // wakes writer
+  pthread_cond_t done_; // wakes print or flush
+  pthread_t writerThread_;
+  /// Whether writer is writing
+  bool writing_;
+  bool stop_;
+#endif
+};
+
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -0,0 +1,219 @@
+// Copyright (C) 2008, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#pragma warning(disable : 4786)
+#endif
+
+#include <cassert>
+#include <cmath>
+#include <cfloat>
+
+#include "OsiSolverInterface.hpp"
+#include "CbcBatchEvaluator.hpp"
+#include "CoinHelperFunctions.hpp"
+
+// Default Constructor
+CbcBatchEvaluator::CbcBatchEvaluator()
+  : rowLower_(NULL)
+  , rowUpper_(NULL)
+  , columnLower_(NULL)
+  , columnUpper_(NULL)
+  , objective_(NULL)
+  , integer_(NULL)
+  , tolerance_(1.0e-7)
+  , integerTolerance_(1.0e-6)
+  , numberRows_(0)
+  , numberColumns_(0)
+{
+}
+
+// Constructor from solver
+CbcBatchEvaluator::CbcBatchEvaluator(const OsiSolverInterface *solver)
+  : rowCopy_(*solver->getMatrixByRow())
+  , tolerance_(1.0e-7)
+  , integerTolerance_(1.0e-6)
+{
+  numberRows_ = solver->getNumRows();
+  numberColumns_ = solver->getNumCols();
+  solver->getDblParam(OsiPrimalTolerance, tolerance_);
+  rowLower_ = CoinCopyOfArray(solver->getRowLower(), numberRows_);
+  rowUpper_ = CoinCopyOfArray(solver->getRowUpper(), numberRows_);
+  columnLower_ = CoinCopyOfArray(solver->getColLower(), numberColumns_);
+  columnUpper_ = CoinCopyOfArray(solver->getColUpper(), numberColumns_);
+  objective_ = new double[numberColumns_];
+  double direction = solver->getObjSense();
+  const double *objective = solver->getObjCoefficients();
+  integer_ = new char[numberColumns_];
+  for (int i = 0; i < numberColumns_; i++) {
+    objective_[i] = direction * objective[i];
+    integer_[i] = solver->isInteger(i) ? 1 : 0;
+  }
+}
+
+// Copy constructor
+CbcBatchEvaluator::CbcBatchEvaluator(const CbcBatchEvaluator &rhs)
+  : rowLower_(NULL)
+  , rowUpper_(NULL)
+  , columnLower_(NULL)
+  , columnUpper_(NULL)
+  , objective_(NULL)
+  , integer_(NULL)
+{
+  gutsOfCopy(rhs);
+}
+
+// Assignment operator
+CbcBatchEvaluator &
+CbcBatchEvaluator::operator=(const CbcBatchEvaluator &rhs)
+{
+  if (this != &rhs) {
+    gutsOfDelete();
+    gutsOfCopy(rhs);
+  }
+  return *this;
+}
+
+// Destructor
+CbcBatchEvaluator::~CbcBatchEvaluator()
+{
+  gutsOfDelete();
+}
+
+// Free arrays
+void CbcBatchEvaluator::gutsOfDelete()
+{
+  delete[] rowLower_;
+  delete[] rowUpper_;
+  delete[] columnLower_;
+  delete[] columnUpper_;
+  delete[] objective_;
+  delete[] integer_;
+  rowLower_ = NULL;
+  rowUpper_ = NULL;
+  columnLower_ = NULL;
+  columnUpper_ = NULL;
+  objective_ = NULL;
+  integer_ = NULL;
+}
+
+// Copy
+void CbcBatchEvaluator::gutsOfCopy(const CbcBatchEvaluator &rhs)
+{
+  rowCopy_ = rhs.rowCopy_;
+  tolerance_ = rhs.tolerance_;
+  integerTolerance_ = rhs.integerTolerance_;
+  numberRows_ = rhs.numberRows_;
+  numberColumns_ = rhs.numberColumns_;
+  if (rhs.objective_) {
+    rowLower_ = CoinCopyOfArray(rhs.rowLower_, numberRows_);
+    rowUpper_ = CoinCopyOfArray(rhs.rowUpper_, numberRows_);
+    columnLower_ = CoinCopyOfArray(rhs.columnLower_, numberColumns_);
+    columnUpper_ = CoinCopyOfArray(rhs.columnUpper_, numberColumns_);
+    objective_ = CoinCopyOfArray(rhs.objective_, numberColumns_);
+    integer_ = CoinCopyOfArray(rhs.integer_, numberColumns_);
+  }
+}
+
+// Set objective
+void CbcBatchEvaluator::setObjective(const double *objective)
+{
+  CoinMemcpyN(objective, numberColumns_, objective_);
+}
+
+// Row activities for a block of candidates
+void CbcBatchEvaluator::blockActivities(int blockSize, const double *values,
+  double *activities) const
+{
+  const double *element = rowCopy_.getElements();
+  const int *column = rowCopy_.getIndices();
+  const CoinBigIndex *rowStart = rowCopy_.getVectorStarts();
+  const int *rowLength = rowCopy_.getVectorLengths();
+  if (blockSize == CBC_BATCH_BLOCK) {
+    // fixed length so compiler can unroll and vectorize
+    for (int iRow = 0; iRow < numberRows_; iRow++) {
+      double activity[CBC_BATCH_BLOCK];
+      for (int c = 0; c < CBC_BATCH_BLOCK; c++)
+        activity[c] = 0.0;
+      for (CoinBigIndex j = rowStart[iRow]; j < rowStart[iRow] + rowLength[iRow]; j++) {
+        double value = element[j];
+        const double *columnValues = values + column[j] * CBC_BATCH_BLOCK;
+        for (int c = 0; c < CBC_BATCH_BLOCK; c++)
+          activity[c] += value * columnValues[c];
+      }
+      double *rowActivities = activities + iRow * CBC_BATCH_BLOCK;
+      for (int c = 0; c < CBC_BATCH_BLOCK; c++)
+        rowActivities[c] = activity[c];
+    }
+  } else {
+    for (int iRow = 0; iRow < numberRows_; iRow++) {
+      double *rowActivities = activities + iRow * blockSize;
+      for (int c = 0; c < blockSize; c++)
+        rowActivities[c] = 0.0;
+      for (CoinBigIndex j = rowStart[iRow]; j < rowStart[iRow] + rowLength[iRow]; j++) {
+        double value = element[j];
+        const double *columnValues = values + column[j] * blockSize;
+        for (int c = 0; c < blockSize; c++)
+          rowActivities[c] += value * columnValues[c];
+      }
+    }
+  }
+}
+
+// Evaluate candidates
+int CbcBatchEvaluator::evaluate(int numberCandidates, const double *candidates,
+  char *feasible, double *objective, double *infeasibility) const
+{
+  int numberFeasible = 0;
+  double *values = new double[numberColumns_ * CBC_BATCH_BLOCK];
+  double *activities = new double[CoinMax(numberRows_, 1) * CBC_BATCH_BLOCK];
+  for (int first = 0; first < numberCandidates; first += CBC_BATCH_BLOCK) {
+    int blockSize = CoinMin(CBC_BATCH_BLOCK, numberCandidates - first);
+    // interleave
+    for (int c = 0; c < blockSize; c++) {
+      const double *candidate = candidates + (first + c) * numberColumns_;
+      for (int iColumn = 0; iColumn < numberColumns_; iColumn++)
+        values[iColumn * blockSize + c] = candidate[iColumn];
+    }
+    blockActivities(blockSize, values, activities);
+    for (int c = 0; c < blockSize; c++) {
+      double sumInfeasibility = 0.0;
+      double objectiveValue = 0.0;
+      for (int iColumn = 0; iColumn < numberColumns_; iColumn++) {
+        double value = values[iColumn * blockSize + c];
+        objectiveValue += objective_[iColumn] * value;
+        if (value < columnLower_[iColumn] - tolerance_)
+          sumInfeasibility += columnLower_[iColumn] - value;
+        else if (value > columnUpper_[iColumn] + tolerance_)
+          sumInfeasibility += value - columnUpper_[iColumn];
+        if (integer_[iColumn]) {
+          double away = fabs(value - floor(value + 0.5));
+          if (away > integerTolerance_)
+            sumInfeasibility += away;
+        }
+      }
+      for (int iRow = 0; iRow < numberRows_; iRow++) {
+        double activity = activities[iRow * blockSize + c];
+        if (activity < rowLower_[iRow] - tolerance_)
+          sumInfeasibility += rowLower_[iRow] - activity;
+        else if (activity > rowUpper_[iRow] + tolerance_)
+          sumInfeasibility += activity - rowUpper_[iRow];
+      }
+      int k = first + c;
+      objective[k] = objectiveValue;
+      feasible[k] = sumInfeasibility ? 0 : 1;
+      if (infeasibility)
+        infeasibility[k] = sumInfeasibility;
+      if (feasible[k])
+        numberFeasible++;
+    }
+  }
+  delete[] values;
+  delete[] activities;
+  return numberFeasible;
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
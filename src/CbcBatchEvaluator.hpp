@@ -0,0 +1,124 @@
+// Copyright (C) 2008, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcBatchEvaluator_H
+#define CbcBatchEvaluator_H
+
+#include "CbcConfig.h"
+#include "CoinPackedMatrix.hpp"
+
+class OsiSolverInterface;
+
+/// Number of candidates done together by CbcBatchEvaluator
+#define CBC_BATCH_BLOCK 8
+
+/** Checks many candidate solutions at once
+
+    Row activities of a block of candidates are computed in one pass over
+    row copy of matrix (sparse matrix times dense block), with values of
+    candidates interleaved so inner loop is over candidates and can be
+    vectorized.  Column bounds, integrality and row bounds are then
+    checked and objective computed for each candidate.  blockActivities
+    is virtual so an accelerator can do the product.
+ */
+
+class CBCLIB_EXPORT CbcBatchEvaluator {
+public:
+  /// Default Constructor
+  CbcBatchEvaluator();
+
+  /// Constructor from solver (matrix, bounds, objective and integers)
+  CbcBatchEvaluator(const OsiSolverInterface *solver);
+
+  /// Copy constructor
+  CbcBatchEvaluator(const CbcBatchEvaluator &);
+
+  /// Assignment operator
+  CbcBatchEvaluator &operator=(const CbcBatchEvaluator &rhs);
+
+  /// Destructor
+  virtual ~CbcBatchEvaluator();
+
+  /** Evaluate numberCandidates solutions - candidate k starts at
+      candidates+k*numberColumns.  Sets feasible[k] to 1 if feasible and
+      objective[k] (in minimization sense).  If infeasibility given it gets
+      sum of infeasibilities.  Returns number feasible */
+  int evaluate(int numberCandidates, const double *candidates,
+    char *feasible, double *objective, double *infeasibility = NULL) const;
+  /// Set objective (if not to be one from solver)
+  void setObjective(const double *objective);
+  /// Set primal tolerance
+  inline void setTolerance(double value)
+  {
+    tolerance_ = value;
+  }
+  /// Primal tolerance
+  inline double tolerance() const
+  {
+    return tolerance_;
+  }
+  /// Set integer tolerance
+  inline void setIntegerTolerance(double value)
+  {
+    integerTolerance_ = value;
+  }
+  /// Integer tolerance
+  inline double integerTolerance() const
+  {
+    return integerTolerance_;
+  }
+  /// Number of rows
+  inline int numberRows() const
+  {
+    return numberRows_;
+  }
+  /// Number of columns
+  inline int numberColumns() const
+  {
+    return numberColumns_;
+  }
+
+protected:
+  /** Row activities for a block of blockSize (<= CBC_BATCH_BLOCK)
+      candidates.  Value of column j for candidate c is at
+      values[j*blockSize+c] and activity of row i for candidate c goes to
+      activities[i*blockSize+c] */
+  virtual void blockActivities(int blockSize, const double *values,
+    double *activities) const;
+
+private:
+  /// Free arrays
+  void gutsOfDelete();
+  /// Copy
+  void gutsOfCopy(const CbcBatchEvaluator &rhs);
+
+protected:
+  /// Row copy
+  CoinPackedMatrix rowCopy_;
+  /// Row lower bounds
+  double *rowLower_;
+  /// Row upper bounds
+  double *rowUpper_;
+  /// Column lower bounds
+  double *columnLower_;
+  /// Column upper bounds
+  double *columnUpper_;
+  /// Objective (minimization sense)
+  double *objective_;
+  /// Whether column is integer
+  char *integer_;
+  /// Primal tolerance
+  double tolerance_;
+  /// Integer tolerance
+  double integerTolerance_;
+  /// Number of rows
+  int numberRows_;
+  /// Number of columns
+  int numberColumns_;
+};
+
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -0,0 +1,521 @@
+// Copyright (C) 2008, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#pragma warning(disable : 4786)
+#endif
+
+#include <cassert>
+#include <cmath>
+#include <cfloat>
+
+#include "OsiSolverInterface.hpp"
+#include "CbcBoundPropagator.hpp"
+#include "CoinHelperFunctions.hpp"
+
+// Bounds at least this large are taken as infinite
+#define CBC_PROPAGATE_INFINITY 1.0e20
+// Activities this large are not trusted for tightening
+#define CBC_PROPAGATE_LARGE 1.0e12
+
+// Move contribution of one element from old bound to new
+static inline void adjustActivity(double &activity, int &numberInfinite,
+  double element, double oldBound, double newBound)
+{
+  if (fabs(oldBound) >= CBC_PROPAGATE_INFINITY)
+    numberInfinite--;
+  else
+    activity -= element * oldBound;
+  if (fabs(newBound) >= CBC_PROPAGATE_INFINITY)
+    numberInfinite++;
+  else
+    activity += element * newBound;
+}
+
+// Default Constructor
+CbcBoundPropagator::CbcBoundPropagator()
+  : rowLower_(NULL)
+  , rowUpper_(NULL)
+  , lower_(NULL)
+  , upper_(NULL)
+  , minActivity_(NULL)
+  , maxActivity_(NULL)
+  , trailBounds_(NULL)
+  , trailColumn_(NULL)
+  , numberMinInfinite_(NULL)
+  , numberMaxInfinite_(NULL)
+  , queue_(NULL)
+  , inQueue_(NULL)
+  , integer_(NULL)
+  , tolerance_(1.0e-6)
+  , numberRows_(0)
+  , numberColumns_(0)
+  , numberChanges_(0)
+  , maximumChanges_(0)
+  , numberQueued_(0)
+{
+}
+
+// Constructor from solver
+CbcBoundPropagator::CbcBoundPropagator(const OsiSolverInterface *solver)
+  : rowCopy_(*solver->getMatrixByRow())
+  , columnCopy_(*solver->getMatrixByCol())
+  , tolerance_(1.0e-6)
+  , numberChanges_(0)
+  , numberQueued_(0)
+{
+  numberRows_ = solver->getNumRows();
+  numberColumns_ = solver->getNumCols();
+  solver->getDblParam(OsiPrimalTolerance, tolerance_);
+  rowLower_ = CoinCopyOfArray(solver->getRowLower(), numberRows_);
+  rowUpper_ = CoinCopyOfArray(solver->getRowUpper(), numberRows_);
+  lower_ = CoinCopyOfArray(solver->getColLower(), numberColumns_);
+  upper_ = CoinCopyOfArray(solver->getColUpper(), numberColumns_);
+  minActivity_ = new double[2 * numberRows_];
+  maxActivity_ = minActivity_ + numberRows_;
+  numberMinInfinite_ = new int[2 * numberRows_];
+  numberMaxInfinite_ = numberMinInfinite_ + numberRows_;
+  // second half of queue is used while processing
+  queue_ = new int[2 * numberRows_];
+  inQueue_ = new char[numberRows_];
+  memset(inQueue_, 0, numberRows_);
+  integer_ = new char[numberColumns_];
+  for (int i = 0; i < numberColumns_; i++)
+    integer_[i] = solver->isInteger(i) ? 1 : 0;
+  maximumChanges_ = 2 * numberColumns_ + 100;
+  trailBounds_ = new double[2 * maximumChanges_];
+  trailColumn_ = new int[maximumChanges_];
+  computeActivities();
+}
+
+// Copy constructor
+CbcBoundPropagator::CbcBoundPropagator(const CbcBoundPropagator &rhs)
+  : rowLower_(NULL)
+  , rowUpper_(NULL)
+  , lower_(NULL)
+  , upper_(NULL)
+  , minActivity_(NULL)
+  , maxActivity_(NULL)
+  , trailBounds_(NULL)
+  , trailColumn_(NULL)
+  , numberMinInfinite_(NULL)
+  , numberMaxInfinite_(NULL)
+  , queue_(NULL)
+  , inQueue_(NULL)
+  , integer_(NULL)
+{
+  gutsOfCopy(rhs);
+}
+
+// Assignment operator
+CbcBoundPropagator &
+CbcBoundPropagator::operator=(const CbcBoundPropagator &rhs)
+{
+  if (this != &rhs) {
+    gutsOfDelete();
+    gutsOfCopy(rhs);
+  }
+  return *this;
+}
+
+// Destructor
+CbcBoundPropagator::~CbcBoundPropagator()
+{
+  gutsOfDelete();
+}
+
+// Free arrays
+void CbcBoundPropagator::gutsOfDelete()
+{
+  delete[] rowLower_;
+  delete[] rowUpper_;
+  delete[] lower_;
+  delete[] upper_;
+  delete[] minActivity_;
+  delete[] trailBounds_;
+  delete[] trailColumn_;
+  delete[] numberMinInfinite_;
+  delete[] queue_;
+  delete[] inQueue_;
+  delete[] integer_;
+  rowLower_ = NULL;
+  rowUpper_ = NULL;
+  lower_ = NULL;
+  upper_ = NULL;
+  minActivity_ = NULL;
+  maxActivity_ = NULL;
+  trailBounds_ = NULL;
+  trailColumn_ = NULL;
+  numberMinInfinite_ = NULL;
+  numberMaxInfinite_ = NULL;
+  queue_ = NULL;
+  inQueue_ = NULL;
+  integer_ = NULL;
+}
+
+// Copy
+void CbcBoundPropagator::gutsOfCopy(const CbcBoundPropagator &rhs)
+{
+  rowCopy_ = rhs.rowCopy_;
+  columnCopy_ = rhs.columnCopy_;
+  tolerance_ = rhs.tolerance_;
+  numberRows_ = rhs.numberRows_;
+  numberColumns_ = rhs.numberColumns_;
+  numberChanges_ = rhs.numberChanges_;
+  maximumChanges_ = rhs.maximumChanges_;
+  numberQueued_ = rhs.numberQueued_;
+  if (rhs.lower_) {
+    rowLower_ = CoinCopyOfArray(rhs.rowLower_, numberRows_);
+    rowUpper_ = CoinCopyOfArray(rhs.rowUpper_, numberRows_);
+    lower_ = CoinCopyOfArray(rhs.lower_, numberColumns_);
+    upper_ = CoinCopyOfArray(rhs.upper_, numberColumns_);
+    minActivity_ = CoinCopyOfArray(rhs.minActivity_, 2 * numberRows_);
+    maxActivity_ = minActivity_ + numberRows_;
+    numberMinInfinite_ = CoinCopyOfArray(rhs.numberMinInfinite_, 2 * numberRows_);
+    numberMaxInfinite_ = numberMinInfinite_ + numberRows_;
+    queue_ = CoinCopyOfArray(rhs.queue_, 2 * numberRows_);
+    inQueue_ = CoinCopyOfArray(rhs.inQueue_, numberRows_);
+    integer_ = CoinCopyOfArray(rhs.integer_, numberColumns_);
+    trailBounds_ = CoinCopyOfArray(rhs.trailBounds_, 2 * maximumChanges_);
+    trailColumn_ = CoinCopyOfArray(rhs.trailColumn_, maximumChanges_);
+  }
+}
+
+// Compute activities from scratch
+void CbcBoundPropagator::computeActivities()
+{
+  const double *element = rowCopy_.getElements();
+  const int *column = rowCopy_.getIndices();
+  const CoinBigIndex *rowStart = rowCopy_.getVectorStarts();
+  const int *rowLength = rowCopy_.getVectorLengths();
+  for (int iRow = 0; iRow < numberRows_; iRow++) {
+    double minActivity = 0.0;
+    double maxActivity = 0.0;
+    int numberMinInfinite = 0;
+    int numberMaxInfinite = 0;
+    for (CoinBigIndex j = rowStart[iRow]; j < rowStart[iRow] + rowLength[iRow]; j++) {
+      int iColumn = column[j];
+      double value = element[j];
+      double minBound = (value > 0.0) ? lower_[iColumn] : upper_[iColumn];
+      double maxBound = (value > 0.0) ? upper_[iColumn] : lower_[iColumn];
+      if (fabs(minBound) >= CBC_PROPAGATE_INFINITY)
+        numberMinInfinite++;
+      else
+        minActivity += value * minBound;
+      if (fabs(maxBound) >= CBC_PROPAGATE_INFINITY)
+        numberMaxInfinite++;
+      else
+        maxActivity += value * maxBound;
+    }
+    minActivity_[iRow] = minActivity;
+    maxActivity_[iRow] = maxActivity;
+    numberMinInfinite_[iRow] = numberMinInfinite;
+    numberMaxInfinite_[iRow] = numberMaxInfinite;
+  }
+}
+
+// Update activities for new bounds of column
+void CbcBoundPropagator::updateActivities(int iColumn, double oldLower, double oldUpper)
+{
+  const double *element = columnCopy_.getElements();
+  const int *row = columnCopy_.getIndices();
+  CoinBigIndex start = columnCopy_.getVectorStarts()[iColumn];
+  CoinBigIndex end = start + columnCopy_.getVectorLengths()[iColumn];
+  double newLower = lower_[iColumn];
+  double newUpper = upper_[iColumn];
+  for (CoinBigIndex j = start; j < end; j++) {
+    int iRow = row[j];
+    double value = element[j];
+    if (value > 0.0) {
+      adjustActivity(minActivity_[iRow], numberMinInfinite_[iRow], value, oldLower, newLower);
+      adjustActivity(maxActivity_[iRow], numberMaxInfinite_[iRow], value, oldUpper, newUpper);
+    } else {
+      adjustActivity(minActivity_[iRow], numberMinInfinite_[iRow], value, oldUpper, newUpper);
+      adjustActivity(maxActivity_[iRow], numberMaxInfinite_[iRow], value, oldLower, newLower);
+    }
+  }
+}
+
+// Put rows of column on queue
+void CbcBoundPropagator::queueRows(int iColumn)
+{
+  const int *row = columnCopy_.getIndices();
+  CoinBigIndex start = columnCopy_.getVectorStarts()[iColumn];
+  CoinBigIndex end = start + columnCopy_.getVectorLengths()[iColumn];
+  for (CoinBigIndex j = start; j < end; j++) {
+    int iRow = row[j];
+    if (!inQueue_[iRow]) {
+      inQueue_[iRow] = 1;
+      queue_[numberQueued_++] = iRow;
+    }
+  }
+}
+
+// Change bounds of a column (only tightens)
+int CbcBoundPropagator::changeBounds(int iColumn, double lower, double upper)
+{
+  double oldLower = lower_[iColumn];
+  double oldUpper = upper_[iColumn];
+  if (integer_[iColumn]) {
+    if (lower > -CBC_PROPAGATE_INFINITY)
+      lower = ceil(lower - 1.0e-6);
+    if (upper < CBC_PROPAGATE_INFINITY)
+      upper = floor(upper + 1.0e-6);
+  }
+  lower = CoinMax(lower, oldLower);
+  upper = CoinMin(upper, oldUpper);
+  if (lower > upper) {
+    if (lower > upper + tolerance_)
+      return -1;
+    // within tolerance - fix at old bound
+    if (lower == oldLower)
+      upper = lower;
+    else
+      lower = upper;
+  }
+  if (lower == oldLower && upper == oldUpper)
+    return 0;
+  if (numberChanges_ == maximumChanges_) {
+    int newMaximum = 2 * maximumChanges_ + 100;
+    double *tempD = new double[2 * newMaximum];
+    int *tempI = new int[newMaximum];
+    CoinMemcpyN(trailBounds_, 2 * numberChanges_, tempD);
+    CoinMemcpyN(trailColumn_, numberChanges_, tempI);
+    delete[] trailBounds_;
+    delete[] trailColumn_;
+    trailBounds_ = tempD;
+    trailColumn_ = tempI;
+    maximumChanges_ = newMaximum;
+  }
+  trailColumn_[numberChanges_] = iColumn;
+  trailBounds_[2 * numberChanges_] = oldLower;
+  trailBounds_[2 * numberChanges_ + 1] = oldUpper;
+  numberChanges_++;
+  lower_[iColumn] = lower;
+  upper_[iColumn] = upper;
+  updateActivities(iColumn, oldLower, oldUpper);
+  queueRows(iColumn);
+  return 1;
+}
+
+// Tighten columns of a row
+int CbcBoundPropagator::propagateRow(int iRow)
+{
+  double rowLower = rowLower_[iRow];
+  double rowUpper = rowUpper_[iRow];
+  bool useUpper = rowUpper < CBC_PROPAGATE_INFINITY;
+  bool useLower = rowLower > -CBC_PROPAGATE_INFINITY;
+  // row infeasible?
+  if (useUpper && !numberMinInfinite_[iRow]
+    && minActivity_[iRow] > rowUpper + tolerance_ * (1.0 + fabs(rowUpper)))
+    return -1;
+  if (useLower && !numberMaxInfinite_[iRow]
+    && maxActivity_[iRow] < rowLower - tolerance_ * (1.0 + fabs(rowLower)))
+    return -1;
+  if (numberMinInfinite_[iRow] > 1)
+    useUpper = false;
+  if (numberMaxInfinite_[iRow] > 1)
+    useLower = false;
+  if (!useUpper && !useLower)
+    return 0;
+  const double *element = rowCopy_.getElements();
+  const int *column = rowCopy_.getIndices();
+  CoinBigIndex start = rowCopy_.getVectorStarts()[iRow];
+  CoinBigIndex end = start + rowCopy_.getVectorLengths()[iRow];
+  int numberTightened = 0;
+  for (CoinBigIndex j = start; j < end; j++) {
+    int iColumn = column[j];
+    double value = element[j];
+    double lower = lower_[iColumn];
+    double upper = upper_[iColumn];
+    if (lower == upper)
+      continue;
+    double newLower = -COIN_DBL_MAX;
+    double newUpper = COIN_DBL_MAX;
+    // activities are read each time as earlier columns may have moved them
+    if (useUpper && numberMinInfinite_[iRow] <= 1
+      && fabs(minActivity_[iRow]) < CBC_PROPAGATE_LARGE) {
+      double bound = (value > 0.0) ? lower : upper;
+      bool infinite = fabs(bound) >= CBC_PROPAGATE_INFINITY;
+      double residual;
+      bool ok = true;
+      if (!infinite) {
+        residual = minActivity_[iRow] - value * bound;
+        ok = !numberMinInfinite_[iRow];
+      } else {
+        residual = minActivity_[iRow];
+      }
+      if (ok) {
+        double newBound = (rowUpper - residual) / value;
+        if (value > 0.0)
+          newUpper = newBound;
+        else
+          newLower = newBound;
+      }
+    }
+    if (useLower && numberMaxInfinite_[iRow] <= 1
+      && fabs(maxActivity_[iRow]) < CBC_PROPAGATE_LARGE) {
+      double bound = (value > 0.0) ? upper : lower;
+      bool infinite = fabs(bound) >= CBC_PROPAGATE_INFINITY;
+      double residual;
+      bool ok = true;
+      if (!infinite) {
+        residual = maxActivity_[iRow] - value * bound;
+        ok = !numberMaxInfinite_[iRow];
+      } else {
+        residual = maxActivity_[iRow];
+      }
+      if (ok) {
+        double newBound = (rowLower - residual) / value;
+        if (value > 0.0)
+          newLower = CoinMax(newLower, newBound);
+        else
+          newUpper = CoinMin(newUpper, newBound);
+      }
+    }
+    if (!integer_[iColumn]) {
+      // only take worthwhile changes on continuous and keep a little slack
+      if (newLower != -COIN_DBL_MAX) {
+        if (lower > -CBC_PROPAGATE_INFINITY
+          && newLower < lower + 1.0e-3 * CoinMax(1.0, fabs(lower)))
+          newLower = -COIN_DBL_MAX;
+        else
+          newLower -= tolerance_;
+      }
+      if (newUpper != COIN_DBL_MAX) {
+        if (upper < CBC_PROPAGATE_INFINITY
+          && newUpper > upper - 1.0e-3 * CoinMax(1.0, fabs(upper)))
+          newUpper = COIN_DBL_MAX;
+        else
+          newUpper += tolerance_;
+      }
+    }
+    if (newLower == -COIN_DBL_MAX && newUpper == COIN_DBL_MAX)
+      continue;
+    int returnCode = changeBounds(iColumn, newLower, newUpper);
+    if (returnCode < 0)
+      return -1;
+    numberTightened += returnCode;
+  }
+  return numberTightened;
+}
+
+// Propagate queued rows
+int CbcBoundPropagator::propagate(int maximumPasses)
+{
+  int numberTightened = 0;
+  int *work = queue_ + numberRows_;
+  for (int iPass = 0; iPass < maximumPasses && numberQueued_; iPass++) {
+    int number = numberQueued_;
+    for (int i = 0; i < number; i++) {
+      int iRow = queue_[i];
+      work[i] = iRow;
+      inQueue_[iRow] = 0;
+    }
+    numberQueued_ = 0;
+    for (int i = 0; i < number; i++) {
+      int returnCode = propagateRow(work[i]);
+      if (returnCode < 0) {
+        // clear queue
+        for (int k = 0; k < numberQueued_; k++)
+          inQueue_[queue_[k]] = 0;
+        numberQueued_ = 0;
+        return -1;
+      }
+      numberTightened += returnCode;
+    }
+  }
+  return numberTightened;
+}
+
+// Queue all rows and propagate
+int CbcBoundPropagator::propagateAll(int maximumPasses)
+{
+  for (int iRow = 0; iRow < numberRows_; iRow++) {
+    if (!inQueue_[iRow]) {
+      inQueue_[iRow] = 1;
+      queue_[numberQueued_++] = iRow;
+    }
+  }
+  return propagate(maximumPasses);
+}
+
+// Move to new bounds
+void CbcBoundPropagator::setBounds(const double *lower, const double *upper)
+{
+  for (int i = 0; i < numberQueued_; i++)
+    inQueue_[queue_[i]] = 0;
+  numberQueued_ = 0;
+  numberChanges_ = 0;
+  int numberChanged = 0;
+  for (int iColumn = 0; iColumn < numberColumns_; iColumn++) {
+    if (lower[iColumn] != lower_[iColumn] || upper[iColumn] != upper_[iColumn])
+      numberChanged++;
+  }
+  // if many changed cheaper (and cleaner) to start again
+  bool recompute = numberChanged > numberColumns_ / 4;
+  for (int iColumn = 0; iColumn < numberColumns_ && numberChanged; iColumn++) {
+    if (lower[iColumn] != lower_[iColumn] || upper[iColumn] != upper_[iColumn]) {
+      double oldLower = lower_[iColumn];
+      double oldUpper = upper_[iColumn];
+      lower_[iColumn] = lower[iColumn];
+      upper_[iColumn] = upper[iColumn];
+      if (!recompute)
+        updateActivities(iColumn, oldLower, oldUpper);
+      queueRows(iColumn);
+      numberChanged--;
+    }
+  }
+  if (recompute)
+    computeActivities();
+}
+
+// Undo all changes since mark
+void CbcBoundPropagator::backtrack(int mark)
+{
+  assert(mark >= 0 && mark <= numberChanges_);
+  while (numberChanges_ > mark) {
+    numberChanges_--;
+    int iColumn = trailColumn_[numberChanges_];
+    double oldLower = lower_[iColumn];
+    double oldUpper = upper_[iColumn];
+    lower_[iColumn] = trailBounds_[2 * numberChanges_];
+    upper_[iColumn] = trailBounds_[2 * numberChanges_ + 1];
+    if (mark)
+      updateActivities(iColumn, oldLower, oldUpper);
+  }
+  for (int i = 0; i < numberQueued_; i++)
+    inQueue_[queue_[i]] = 0;
+  numberQueued_ = 0;
+  // back at start so clean up any drift
+  if (!mark)
+    computeActivities();
+}
+
+// Number of rows which stop column going down (0) or up (1)
+int CbcBoundPropagator::locks(int iColumn, int way) const
+{
+  const double *element = columnCopy_.getElements();
+  const int *row = columnCopy_.getIndices();
+  CoinBigIndex start = columnCopy_.getVectorStarts()[iColumn];
+  CoinBigIndex end = start + columnCopy_.getVectorLengths()[iColumn];
+  int numberLocks = 0;
+  for (CoinBigIndex j = start; j < end; j++) {
+    int iRow = row[j];
+    bool positive = (element[j] > 0.0) == (way != 0);
+    // going up on positive element pushes towards row upper
+    if (positive) {
+      if (rowUpper_[iRow] < CBC_PROPAGATE_INFINITY)
+        numberLocks++;
+    } else {
+      if (rowLower_[iRow] > -CBC_PROPAGATE_INFINITY)
+        numberLocks++;
+    }
+  }
+  return numberLocks;
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -0,0 +1,187 @@
+// Copyright (C) 2008, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcBoundPropagator_H
+#define CbcBoundPropagator_H
+
+#include "CbcConfig.h"
+#include "CoinPackedMatrix.hpp"
+
+class OsiSolverInterface;
+
+/** Activity based bound propagation
+
+    Lightweight domain propagation over row copy of matrix.  Minimum and
+    maximum activity of each row (finite part and number of infinite
+    contributions) are kept up to date as column bounds change, and rows
+    touched by a change are used to tighten bounds of other columns in
+    them (rounded for integers).  Changes are recorded on a trail so they
+    can be undone back to a mark - so can be used in dives and
+    fix-and-propagate heuristics.
+ */
+
+class CBCLIB_EXPORT CbcBoundPropagator {
+public:
+  /// Default Constructor
+  CbcBoundPropagator();
+
+  /// Constructor from solver (matrix, bounds and integer information)
+  CbcBoundPropagator(const OsiSolverInterface *solver);
+
+  /// Copy constructor
+  CbcBoundPropagator(const CbcBoundPropagator &);
+
+  /// Assignment operator
+  CbcBoundPropagator &operator=(const CbcBoundPropagator &rhs);
+
+  /// Destructor
+  ~CbcBoundPropagator();
+
+  /** Change bounds of a column (only tightens) and queue its rows.
+      Returns -1 if infeasible, 1 if changed, 0 if not */
+  int changeBounds(int iColumn, double lower, double upper);
+  /// Fix a column (see changeBounds)
+  inline int fix(int iColumn, double value)
+  {
+    return changeBounds(iColumn, value, value);
+  }
+  /** Propagate queued rows until nothing changes (or maximumPasses
+      over queue).  Returns number of bounds tightened or -1 if
+      infeasible */
+  int propagate(int maximumPasses = 20);
+  /// Queue all rows and propagate (see propagate)
+  int propagateAll(int maximumPasses = 20);
+  /// Mark for backtrack (position in trail)
+  inline int mark() const
+  {
+    return numberChanges_;
+  }
+  /// Undo all changes since mark (also clears queue)
+  void backtrack(int mark);
+  /** Move to new bounds (looser or tighter) updating activities and
+      queueing rows of changed columns.  Trail is cleared */
+  void setBounds(const double *lower, const double *upper);
+  /// Column of change i on trail (same column may appear more than once)
+  inline int changedColumn(int i) const
+  {
+    return trailColumn_[i];
+  }
+  /// Back to original bounds
+  inline void reset()
+  {
+    backtrack(0);
+  }
+  /// Current lower bounds
+  inline const double *lower() const
+  {
+    return lower_;
+  }
+  /// Current upper bounds
+  inline const double *upper() const
+  {
+    return upper_;
+  }
+  /// Whether column is integer
+  inline bool isInteger(int iColumn) const
+  {
+    return integer_[iColumn] != 0;
+  }
+  /// Number of rows
+  inline int numberRows() const
+  {
+    return numberRows_;
+  }
+  /// Number of columns
+  inline int numberColumns() const
+  {
+    return numberColumns_;
+  }
+  /// Row copy
+  inline const CoinPackedMatrix *rowCopy() const
+  {
+    return &rowCopy_;
+  }
+  /// Column copy
+  inline const CoinPackedMatrix *columnCopy() const
+  {
+    return &columnCopy_;
+  }
+  /** Number of rows which stop column going down (0) or up (1)
+      i.e. locks */
+  int locks(int iColumn, int way) const;
+  /// Set feasibility tolerance
+  inline void setTolerance(double value)
+  {
+    tolerance_ = value;
+  }
+  /// Feasibility tolerance
+  inline double tolerance() const
+  {
+    return tolerance_;
+  }
+
+private:
+  /// Free arrays
+  void gutsOfDelete();
+  /// Copy
+  void gutsOfCopy(const CbcBoundPropagator &rhs);
+  /// Compute activities from scratch
+  void computeActivities();
+  /// Update activities for new bounds of column
+  void updateActivities(int iColumn, double oldLower, double oldUpper);
+  /// Put rows of column on queue
+  void queueRows(int iColumn);
+  /** Tighten columns of a row.  Returns number tightened or -1 if
+      infeasible */
+  int propagateRow(int iRow);
+
+private:
+  /// Row copy
+  CoinPackedMatrix rowCopy_;
+  /// Column copy
+  CoinPackedMatrix columnCopy_;
+  /// Row lower bounds
+  double *rowLower_;
+  /// Row upper bounds
+  double *rowUpper_;
+  /// Current column lower bounds
+  double *lower_;
+  /// Current column upper bounds
+  double *upper_;
+  /// Finite part of minimum activity
+  double *minActivity_;
+  /// Finite part of maximum activity
+  double *maxActivity_;
+  /// Trail of old bounds (lower, upper)
+  double *trailBounds_;
+  /// Column of each trail entry
+  int *trailColumn_;
+  /// Number of infinite contributions to minimum activity
+  int *numberMinInfinite_;
+  /// Number of infinite contributions to maximum activity
+  int *numberMaxInfinite_;
+  /// Queue of rows to propagate
+  int *queue_;
+  /// Whether row in queue
+  char *inQueue_;
+  /// Whether column is integer
+  char *integer_;
+  /// Feasibility tolerance
+  double tolerance_;
+  /// Number of rows
+  int numberRows_;
+  /// Number of columns
+  int numberColumns_;
+  /// Number of entries in trail
+  int numberChanges_;
+  /// Space in trail
+  int maximumChanges_;
+  /// Number of rows in queue
+  int numberQueued_;
+};
+
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -0,0 +1,204 @@
+// Copyright (C) 2002, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#pragma warning(disable : 4786)
+#endif
+
+#include "CbcConfig.h"
+
+#include <cassert>
+#include <cstring>
+
+#include "CoinHelperFunctions.hpp"
+#include "OsiSolverInterface.hpp"
+#include "CbcFullNodeInfo.hpp"
+#include "CbcPartialNodeInfo.hpp"
+#include "CbcBoundTrail.hpp"
+
+// Default Constructor
+CbcBoundTrail::CbcBoundTrail()
+  : lower_(NULL)
+  , upper_(NULL)
+  , baseLower_(NULL)
+  , baseUpper_(NULL)
+  , path_(NULL)
+  , nodeNumber_(NULL)
+  , start_(NULL)
+  , applied_(NULL)
+  , column_(NULL)
+  , oldValue_(NULL)
+  , numberColumns_(0)
+  , depth_(0)
+  , base_(0)
+  , numberEntries_(0)
+  , maximumLevels_(0)
+  , maximumEntries_(0)
+  , numberReused_(0)
+{
+}
+
+// Destructor
+CbcBoundTrail::~CbcBoundTrail()
+{
+  delete[] lower_;
+  delete[] baseLower_;
+  delete[] path_;
+  delete[] nodeNumber_;
+  delete[] start_;
+  delete[] applied_;
+  delete[] column_;
+  delete[] oldValue_;
+}
+
+// Make sure enough space for levels
+void CbcBoundTrail::resizeLevels(int numberLevels)
+{
+  if (numberLevels <= maximumLevels_)
+    return;
+  int newMaximum = CoinMax(2 * maximumLevels_, numberLevels + 10);
+  CbcNodeInfo **path = new CbcNodeInfo *[newMaximum];
+  int *nodeNumber = new int[newMaximum];
+  int *start = new int[newMaximum + 1];
+  char *applied = new char[newMaximum];
+  if (maximumLevels_) {
+    CoinMemcpyN(path_, maximumLevels_, path);
+    CoinMemcpyN(nodeNumber_, maximumLevels_, nodeNumber);
+    CoinMemcpyN(start_, maximumLevels_ + 1, start);
+    CoinMemcpyN(applied_, maximumLevels_, applied);
+  }
+  delete[] path_;
+  delete[] nodeNumber_;
+  delete[] start_;
+  delete[] applied_;
+  path_ = path;
+  nodeNumber_ = nodeNumber;
+  start_ = start;
+  applied_ = applied;
+  maximumLevels_ = newMaximum;
+}
+
+// Make sure enough space for undo entries
+void CbcBoundTrail::resizeEntries(int numberEntries)
+{
+  if (numberEntries <= maximumEntries_)
+    return;
+  int newMaximum = CoinMax(2 * maximumEntries_, numberEntries + 100);
+  int *column = new int[newMaximum];
+  double *oldValue = new double[newMaximum];
+  CoinMemcpyN(column_, numberEntries_, column);
+  CoinMemcpyN(oldValue_, numberEntries_, oldValue);
+  delete[] column_;
+  delete[] oldValue_;
+  column_ = column;
+  oldValue_ = oldValue;
+  maximumEntries_ = newMaximum;
+}
+
+/*
+  Level d of the path is walkback[numberLevels-1-d].  Find how many levels
+  match the last path, undo the edits below that and apply the new ones.
+*/
+bool CbcBoundTrail::moveTo(OsiSolverInterface *solver, CbcNodeInfo **walkback,
+  int numberLevels, int full)
+{
+  numberReused_ = 0;
+  const CbcFullNodeInfo *baseInfo = dynamic_cast< const CbcFullNodeInfo * >(walkback[full]);
+  if (!baseInfo || !baseInfo->allActivated() || !baseInfo->hasBounds()) {
+    depth_ = 0;
+    return false;
+  }
+  int numberColumns = solver->getNumCols();
+  int base = numberLevels - 1 - full;
+  resizeLevels(numberLevels);
+  int numberCommon = 0;
+  if (depth_ && numberColumns == numberColumns_ && base == base_) {
+    // bounds at base may have been tightened
+    if (baseInfo->sameBounds(baseLower_, baseUpper_)) {
+      for (numberCommon = base; numberCommon < CoinMin(depth_, numberLevels); numberCommon++) {
+        const CbcNodeInfo *info = walkback[numberLevels - 1 - numberCommon];
+        if (info != path_[numberCommon] || info->nodeNumber() != nodeNumber_[numberCommon]
+          || info->allActivated() != (applied_[numberCommon] != 0))
+          break;
+      }
+      if (numberCommon == base)
+        numberCommon = 0; // not same full node info
+    }
+  }
+  if (numberCommon) {
+    // undo edits below common ancestor
+    for (int i = numberEntries_ - 1; i >= start_[numberCommon]; i--) {
+      int iColumn = column_[i] & 0x7fffffff;
+      if ((column_[i] & 0x80000000) == 0)
+        lower_[iColumn] = oldValue_[i];
+      else
+        upper_[iColumn] = oldValue_[i];
+    }
+    numberEntries_ = start_[numberCommon];
+    numberReused_ = numberCommon - base;
+  } else {
+    // start again from full node info
+    if (numberColumns != numberColumns_) {
+      delete[] lower_;
+      delete[] baseLower_;
+      lower_ = new double[2 * numberColumns];
+      upper_ = lower_ + numberColumns;
+      baseLower_ = new double[2 * numberColumns];
+      baseUpper_ = baseLower_ + numberColumns;
+      numberColumns_ = numberColumns;
+    }
+    baseInfo->getBounds(lower_, upper_);
+    CoinMemcpyN(lower_, numberColumns, baseLower_);
+    CoinMemcpyN(upper_, numberColumns, baseUpper_);
+    numberEntries_ = 0;
+    for (int i = 0; i <= base; i++) {
+      path_[i] = walkback[numberLevels - 1 - i];
+      nodeNumber_[i] = path_[i]->nodeNumber();
+      applied_[i] = 1;
+      start_[i] = 0;
+    }
+    numberCommon = base + 1;
+  }
+  // apply edits on new branch
+  for (int iLevel = numberCommon; iLevel < numberLevels; iLevel++) {
+    CbcNodeInfo *info = walkback[numberLevels - 1 - iLevel];
+    path_[iLevel] = info;
+    nodeNumber_[iLevel] = info->nodeNumber();
+    start_[iLevel] = numberEntries_;
+    applied_[iLevel] = info->allActivated() ? 1 : 0;
+    if (!applied_[iLevel])
+      continue; // as applyToModel
+    const CbcPartialNodeInfo *partial = dynamic_cast< const CbcPartialNodeInfo * >(info);
+    if (!partial) {
+      depth_ = 0;
+      return false;
+    }
+    int numberChanged = partial->numberChangedBounds();
+    const int *variables = partial->variables();
+    resizeEntries(numberEntries_ + numberChanged);
+    for (int i = 0; i < numberChanged; i++) {
+      int variable = variables[i];
+      int iColumn = variable & 0x3fffffff;
+      if ((variable & 0x80000000) == 0) {
+        column_[numberEntries_] = iColumn;
+        oldValue_[numberEntries_++] = lower_[iColumn];
+        lower_[iColumn] = partial->newBound(i);
+      } else {
+        column_[numberEntries_] = iColumn | 0x80000000;
+        oldValue_[numberEntries_++] = upper_[iColumn];
+        upper_[iColumn] = partial->newBound(i);
+      }
+    }
+  }
+  start_[numberLevels] = numberEntries_;
+  depth_ = numberLevels;
+  base_ = base;
+  solver->setColLower(lower_);
+  solver->setColUpper(upper_);
+  return true;
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
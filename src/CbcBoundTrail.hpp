@@ -0,0 +1,106 @@
+// Copyright (C) 2002, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcBoundTrail_H
+#define CbcBoundTrail_H
+
+#include "CbcConfig.h"
+
+class OsiSolverInterface;
+class CbcNodeInfo;
+
+/** Bounds along the path of the last restored node
+
+    When CbcModel::addCuts1 restores a node it normally resets the bounds
+    from the root (or nearest checkpoint) CbcFullNodeInfo and then applies
+    every CbcPartialNodeInfo edit down to the node.  This keeps the bounds
+    it set last time, the path of node infos they came from and, for each
+    edit, the bound it replaced.  Moving to another node then only undoes
+    the edits below the common ancestor and applies the edits on the
+    new branch, so cost goes with distance in the tree rather than depth.
+
+    The complete bound arrays are still given to the solver, as the
+    previous node may have tightened bounds while it was being solved.
+    Only bounds are handled here; the basis and cuts are still rebuilt
+    by CbcNodeInfo::applyBasisAndCuts.
+*/
+class CBCLIB_EXPORT CbcBoundTrail {
+
+public:
+  /// Default Constructor
+  CbcBoundTrail();
+  /// Destructor
+  ~CbcBoundTrail();
+
+  /** Set bounds in solver for node.
+
+      \p walkback is the path from node info (first) to root and
+      \p full is the position in it of the CbcFullNodeInfo the bounds
+      start from.  Returns false (and forgets path) if path can not be
+      handled, in which case caller must set bounds itself.
+    */
+  bool moveTo(OsiSolverInterface *solver, CbcNodeInfo **walkback,
+    int numberLevels, int full);
+
+  /// Forget path (for example if bounds stored in node infos have been changed)
+  inline void invalidate()
+  {
+    depth_ = 0;
+  }
+  /// Number of levels of last path reused by last move
+  inline int numberReused() const
+  {
+    return numberReused_;
+  }
+
+private:
+  /// Make sure enough space for levels
+  void resizeLevels(int numberLevels);
+  /// Make sure enough space for undo entries
+  void resizeEntries(int numberEntries);
+
+private:
+  /// Illegal copy constructor
+  CbcBoundTrail(const CbcBoundTrail &);
+  /// Illegal assignment operator
+  CbcBoundTrail &operator=(const CbcBoundTrail &);
+
+  /// Bounds as given to solver last time
+  double *lower_;
+  double *upper_;
+  /// Bounds of full node info at base when path started
+  double *baseLower_;
+  double *baseUpper_;
+  /// Node infos on path (root first)
+  CbcNodeInfo **path_;
+  /// Node numbers of path_ (as pointers can be reused)
+  int *nodeNumber_;
+  /// Start of undo entries for each level (one more than levels)
+  int *start_;
+  /// Whether edits at level were applied
+  char *applied_;
+  /// Undo entries - column (0x80000000 set if upper bound)
+  int *column_;
+  /// Undo entries - old value
+  double *oldValue_;
+  /// Number of columns
+  int numberColumns_;
+  /// Number of levels on path (0 if not valid)
+  int depth_;
+  /// Level of full node info bounds started from
+  int base_;
+  /// Number of undo entries in use
+  int numberEntries_;
+  /// Space for levels
+  int maximumLevels_;
+  /// Space for undo entries
+  int maximumEntries_;
+  /// Levels reused by last move
+  int numberReused_;
+};
+
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
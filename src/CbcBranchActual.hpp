@@ -11,6 +11,8 @@
 #include "CbcSOS.hpp"
 #include "CbcSimpleInteger.hpp"
 #include "CbcNWay.hpp"
+#include "CbcIndicator.hpp"
+#include "CbcPiecewise.hpp"
 #include "CbcSimpleIntegerPseudoCost.hpp"
 #include "CbcBranchDefaultDecision.hpp"
 #include "CbcFollowOn.hpp"
@@ -21,6 +21,7 @@
 #include "CoinSort.hpp"
 #include "CoinError.hpp"
 #include "CbcBranchAllDifferent.hpp"
+#include "CbcSolutionChanges.hpp"
 
 /** Default Constructor
 */
@@ -28,6 +29,8 @@ CbcBranchAllDifferent::CbcBranchAllDifferent()
   : CbcBranchCut()
   , numberInSet_(0)
   , which_(NULL)
+  , cachedInfeasibility_(0.0)
+  , cachedStamp_(-1)
 {
 }
 
@@ -36,6 +39,8 @@ CbcBranchAllDifferent::CbcBranchAllDifferent()
 CbcBranchAllDifferent::CbcBranchAllDifferent(CbcModel *model, int numberInSet,
   const int *members)
   : CbcBranchCut(model)
+  , cachedInfeasibility_(0.0)
+  , cachedStamp_(-1)
 {
   numberInSet_ = numberInSet;
   which_ = CoinCopyOfArray(members, numberInSet_);
@@ -43,6 +48,8 @@ CbcBranchAllDifferent::CbcBranchAllDifferent(CbcModel *model, int numberInSet,
 // Copy constructor
 CbcBranchAllDifferent::CbcBranchAllDifferent(const CbcBranchAllDifferent &rhs)
   : CbcBranchCut(rhs)
+  , cachedInfeasibility_(0.0)
+  , cachedStamp_(-1)
 {
   numberInSet_ = rhs.numberInSet_;
   which_ = CoinCopyOfArray(rhs.which_, numberInSet_);
@@ -64,6 +71,8 @@ CbcBranchAllDifferent::operator=(const CbcBranchAllDifferent &rhs)
     delete[] which_;
     numberInSet_ = rhs.numberInSet_;
     which_ = CoinCopyOfArray(rhs.which_, numberInSet_);
+    cachedInfeasibility_ = 0.0;
+    cachedStamp_ = -1;
   }
   return *this;
 }
@@ -127,10 +136,19 @@ CbcBranchAllDifferent::infeasibility(const OsiBranchingInformation * /*info*/,
   int &preferredWay) const
 {
   preferredWay = -1;
-  //OsiSolverInterface * solver = model_->solver();
+  OsiSolverInterface *solver = model_->solver();
   const double *solution = model_->testSolution();
-  //const double * lower = solver->getColLower();
-  //const double * upper = solver->getColUpper();
+  // Use last value if no member changed since then
+  CbcSolutionChanges *changes = model_->solutionChanges();
+  if (!changes) {
+    model_->wantSolutionChanges();
+    changes = model_->solutionChanges();
+  }
+  int stamp = changes->sameArrays(solution, solver->getColLower(), solver->getColUpper()) ? changes->stamp() : -1;
+  if (stamp >= 0 && (cachedStamp_ == stamp || (cachedStamp_ == stamp - 1 && !changes->anyChanged(numberInSet_, which_)))) {
+    cachedStamp_ = stamp;
+    return cachedInfeasibility_;
+  }
   double *values = new double[numberInSet_];
   int i;
   for (i = 0; i < numberInSet_; i++) {
@@ -147,10 +165,12 @@ CbcBranchAllDifferent::infeasibility(const OsiBranchingInformation * /*info*/,
     last = values[i];
   }
   delete[] values;
+  cachedStamp_ = stamp;
   if (closest > 0.99999)
-    return 0.0;
+    cachedInfeasibility_ = 0.0;
   else
-    return 0.5 * (1.0 - closest);
+    cachedInfeasibility_ = 0.5 * (1.0 - closest);
+  return cachedInfeasibility_;
 }
 
 /* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
@@ -53,6 +53,10 @@ protected:
   int numberInSet_;
   /// Which variables
   int *which_;
+  /// Infeasibility at cachedStamp_
+  mutable double cachedInfeasibility_;
+  /// Stamp of CbcSolutionChanges when infeasibility computed (-1 none)
+  mutable int cachedStamp_;
 };
 #endif
 
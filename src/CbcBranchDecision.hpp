@@ -89,6 +89,25 @@ public:
   {
     return 0.0;
   }
+  /** \brief Choose from candidates without solving any extra LPs.
+
+      Used by CbcNode::chooseDynamicBranch before any strong branching.
+      \p whichObject has \p numberCandidates object numbers and
+      \p downEstimate / \p upEstimate (indexed by object) the estimated
+      changes.  Returns position in \p whichObject of choice or -1 to leave
+      choice to normal logic.  \p preferredWay may be set to -1 or +1
+      (0 means use object's preferred way).
+    */
+  virtual int chooseWithoutLookahead(CbcModel *, const int *,
+    int, const double *, const double *, int &)
+  {
+    return -1;
+  }
+  /// Returns true if objects should be told about bounds implied by branches
+  virtual bool wantsInference() const
+  {
+    return false;
+  }
   /// Create C++ lines to get to current state
   virtual void generateCpp(FILE *) {}
   /// Model
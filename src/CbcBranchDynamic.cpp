@@ -613,6 +613,104 @@ CbcBranchDynamicDecision::getBestCriterion() const
 {
   return bestCriterion_;
 }
+
+// Default Constructor
+CbcBranchInferenceDecision::CbcBranchInferenceDecision()
+  : CbcBranchDynamicDecision()
+  , inferenceWeight_(1.0)
+{
+}
+
+// Copy constructor
+CbcBranchInferenceDecision::CbcBranchInferenceDecision(
+  const CbcBranchInferenceDecision &rhs)
+  : CbcBranchDynamicDecision(rhs)
+  , inferenceWeight_(rhs.inferenceWeight_)
+{
+}
+
+CbcBranchInferenceDecision::~CbcBranchInferenceDecision()
+{
+}
+
+// Clone
+CbcBranchDecision *
+CbcBranchInferenceDecision::clone() const
+{
+  return new CbcBranchInferenceDecision(*this);
+}
+
+// Average implied bounds going down and up (zero if no information)
+static void averageInference(const OsiObject *object, double &down, double &up)
+{
+  down = 0.0;
+  up = 0.0;
+  const CbcSimpleIntegerDynamicPseudoCost *dynamicObject = dynamic_cast< const CbcSimpleIntegerDynamicPseudoCost * >(object);
+  if (dynamicObject) {
+    down = dynamicObject->averageDownInference();
+    up = dynamicObject->averageUpInference();
+  }
+}
+
+/* Choose best candidate from pseudocosts and inference.
+   First pass gets averages so the two scores can be added without
+   one swamping the other. */
+int CbcBranchInferenceDecision::chooseWithoutLookahead(CbcModel *model,
+  const int *whichObject, int numberCandidates, const double *downEstimate,
+  const double *upEstimate, int &preferredWay)
+{
+  preferredWay = 0;
+  if (numberCandidates <= 0)
+    return -1;
+  double minProductWeight = CoinMax(model->getDblParam(CbcModel::CbcSmallChange),
+    nonZeroAmount);
+  double sumPseudo = 0.0;
+  double sumInference = 0.0;
+  for (int i = 0; i < numberCandidates; i++) {
+    int iObject = whichObject[i];
+    double down;
+    double up;
+    averageInference(model->object(iObject), down, up);
+    sumPseudo += CoinMax(downEstimate[iObject], minProductWeight) * CoinMax(upEstimate[iObject], minProductWeight);
+    sumInference += (1.0 + down) * (1.0 + up);
+  }
+  double pseudoMultiplier = numberCandidates / (sumPseudo + nonZeroAmount);
+  double inferenceMultiplier = inferenceWeight_ * numberCandidates / (sumInference + nonZeroAmount);
+  int bestChoice = -1;
+  double bestScore = -COIN_DBL_MAX;
+  double bestDown = 0.0;
+  double bestUp = 0.0;
+  for (int i = 0; i < numberCandidates; i++) {
+    int iObject = whichObject[i];
+    double down;
+    double up;
+    averageInference(model->object(iObject), down, up);
+    double score = pseudoMultiplier * CoinMax(downEstimate[iObject], minProductWeight) * CoinMax(upEstimate[iObject], minProductWeight)
+      + inferenceMultiplier * (1.0 + down) * (1.0 + up);
+    if (score > bestScore) {
+      bestScore = score;
+      bestChoice = i;
+      bestDown = down;
+      bestUp = up;
+    }
+  }
+  if (bestDown > bestUp)
+    preferredWay = -1;
+  else if (bestUp > bestDown)
+    preferredWay = 1;
+  return bestChoice;
+}
+
+// Create C++ lines to get to current state
+void CbcBranchInferenceDecision::generateCpp(FILE *fp)
+{
+  CbcBranchInferenceDecision other;
+  fprintf(fp, "0#include \"CbcBranchDynamic.hpp\"\n");
+  fprintf(fp, "3  CbcBranchInferenceDecision decision;\n");
+  if (inferenceWeight_ != other.inferenceWeight_)
+    fprintf(fp, "3  decision.setInferenceWeight(%g);\n", inferenceWeight_);
+  fprintf(fp, "3  cbcModel->setBranchingMethod(decision);\n");
+}
 #ifdef COIN_DEVELOP
 void printHistory(const char *file)
 {
@@ -96,6 +96,64 @@ private:
   /// Pointer to best branching object
   CbcBranchingObject *bestObject_;
 };
+
+/** Branching decision using pseudocosts and inference - no lookahead
+
+  For very large models even limited strong branching can take too long.
+  This never solves an extra LP to choose a candidate.  The score of a
+  candidate is the product of its down and up estimates, relative to the
+  average over candidates, plus inferenceWeight times its inference score,
+  again relative to the average.  The inference score is the product of
+  the average number of bounds implied going down and going up (from
+  CbcModel::fixAssociated and from changes found when node was solved
+  after branching).  The way with more implications is taken first.
+
+  Pseudocosts are updated as CbcBranchDynamicDecision.
+*/
+
+class CBCLIB_EXPORT CbcBranchInferenceDecision : public CbcBranchDynamicDecision {
+public:
+  // Default Constructor
+  CbcBranchInferenceDecision();
+
+  // Copy constructor
+  CbcBranchInferenceDecision(const CbcBranchInferenceDecision &);
+
+  virtual ~CbcBranchInferenceDecision();
+
+  /// Clone
+  virtual CbcBranchDecision *clone() const;
+
+  /// Choose best candidate from pseudocosts and inference
+  virtual int chooseWithoutLookahead(CbcModel *model, const int *whichObject,
+    int numberCandidates, const double *downEstimate, const double *upEstimate,
+    int &preferredWay);
+  /// Returns true as objects should be told about implied bounds
+  virtual bool wantsInference() const
+  {
+    return true;
+  }
+  /// Create C++ lines to get to current state
+  virtual void generateCpp(FILE *fp);
+
+  /// Weight of inference score against pseudocost score
+  inline double inferenceWeight() const
+  {
+    return inferenceWeight_;
+  }
+  /// Set weight of inference score against pseudocost score
+  inline void setInferenceWeight(double value)
+  {
+    inferenceWeight_ = value;
+  }
+
+private:
+  /// Illegal Assignment operator
+  CbcBranchInferenceDecision &operator=(const CbcBranchInferenceDecision &rhs);
+
+  /// Weight of inference score
+  double inferenceWeight_;
+};
 /** Simple branching object for an integer variable with pseudo costs
 
   This object can specify a two-way branch on an integer variable. For each
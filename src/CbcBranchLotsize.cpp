@@ -125,6 +125,7 @@ CbcLotsize::CbcLotsize()
   , numberRanges_(0)
   , largestGap_(0)
   , bound_(NULL)
+  , step_(0.0)
   , range_(0)
 {
 }
@@ -205,6 +206,25 @@ CbcLotsize::CbcLotsize(CbcModel *model,
   delete[] sort;
   delete[] weight;
   range_ = 0;
+  findStep();
+}
+
+/* Evenly spaced points (or starts of ranges) e.g. multiples of a lot
+   size - then position of value can be found directly.
+*/
+void CbcLotsize::findStep()
+{
+  step_ = 0.0;
+  if (numberRanges_ < 3)
+    return;
+  double step = (bound_[rangeType_ * (numberRanges_ - 1)] - bound_[0])
+    / static_cast< double >(numberRanges_ - 1);
+  double tolerance = 1.0e-12 * CoinMax(1.0, fabs(bound_[0]) + fabs(step));
+  for (int i = 1; i < numberRanges_; i++) {
+    if (fabs(bound_[rangeType_ * i] - bound_[0] - i * step) > tolerance)
+      return;
+  }
+  step_ = step;
 }
 
 // Copy constructor
@@ -217,6 +237,7 @@ CbcLotsize::CbcLotsize(const CbcLotsize &rhs)
   numberRanges_ = rhs.numberRanges_;
   range_ = rhs.range_;
   largestGap_ = rhs.largestGap_;
+  step_ = rhs.step_;
   if (numberRanges_) {
     assert(rangeType_ > 0 && rangeType_ < 3);
     bound_ = new double[(numberRanges_ + 1) * rangeType_];
@@ -243,6 +264,7 @@ CbcLotsize::operator=(const CbcLotsize &rhs)
     rangeType_ = rhs.rangeType_;
     numberRanges_ = rhs.numberRanges_;
     largestGap_ = rhs.largestGap_;
+    step_ = rhs.step_;
     delete[] bound_;
     range_ = rhs.range_;
     if (numberRanges_) {
@@ -271,6 +293,39 @@ bool CbcLotsize::findRange(double value) const
   int iLo;
   int iHi;
   double infeasibility = 0.0;
+  if (step_) {
+    // evenly spaced - go straight to range
+    int stride = rangeType_;
+    int last = numberRanges_ - 1;
+    double position = floor((value - bound_[0]) / step_);
+    int iRange = position < 0.0 ? 0 : (position > last ? last : static_cast< int >(position));
+    // rounding (and start of next range counts within tolerance)
+    double slack = rangeType_ == 1 ? 0.0 : integerTolerance;
+    if (iRange < last && value >= bound_[stride * (iRange + 1)] - slack)
+      iRange++;
+    else if (iRange > 0 && value < bound_[stride * iRange])
+      iRange--;
+    range_ = iRange;
+    if (rangeType_ == 1) {
+      if (value - bound_[range_] <= bound_[range_ + 1] - value) {
+        infeasibility = value - bound_[range_];
+      } else {
+        infeasibility = bound_[range_ + 1] - value;
+        if (infeasibility < integerTolerance)
+          range_++;
+      }
+    } else if (value >= bound_[2 * range_] - integerTolerance && value <= bound_[2 * range_ + 1] + integerTolerance) {
+      infeasibility = 0.0;
+    } else if (value - bound_[2 * range_ + 1] < bound_[2 * range_ + 2] - value) {
+      infeasibility = value - bound_[2 * range_ + 1];
+    } else {
+      infeasibility = bound_[2 * range_ + 2] - value;
+    }
+#ifdef CBC_PRINT
+    printLotsize(value, (infeasibility < integerTolerance), 0);
+#endif
+    return (infeasibility < integerTolerance);
+  }
   if (rangeType_ == 1) {
     if (value < bound_[range_] - integerTolerance) {
       iLo = 0;
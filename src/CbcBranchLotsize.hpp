@@ -130,6 +130,12 @@ public:
   {
     return bound_;
   }
+  /** Step between starts of consecutive points or ranges if they are
+      evenly spaced (then findRange is direct) - 0.0 otherwise */
+  inline double step() const
+  {
+    return step_;
+  }
   /** \brief Return true if object can take part in normal heuristics
     */
   virtual bool canDoHeuristics() const
@@ -140,6 +146,8 @@ public:
 private:
   /// Just for debug (CBC_PRINT defined in CbcBranchLotsize.cpp)
   void printLotsize(double value, bool condition, int type) const;
+  /// Set step_ if evenly spaced
+  void findStep();
 
 private:
   /// data
@@ -154,6 +162,8 @@ private:
   double largestGap_;
   /// Ranges
   double *bound_;
+  /// Step if points or starts of ranges evenly spaced (otherwise 0.0)
+  double step_;
   /// Current range
   mutable int range_;
 };
@@ -12,6 +12,7 @@
 #include <cstdlib>
 #include <cmath>
 #include <cfloat>
+#include <algorithm>
 //#define CBC_DEBUG
 
 #include "OsiSolverInterface.hpp"
@@ -34,6 +35,15 @@ CbcBranchToFixLots::CbcBranchToFixLots()
   , depth_(-1)
   , numberClean_(0)
   , alwaysCreate_(false)
+  , candidates_(NULL)
+  , candidateDj_(NULL)
+  , numberCandidates_(0)
+  , numberFixedIntegers_(0)
+  , cachedType_(-1)
+  , cachedNode_(-1)
+  , cachedIterations_(-1)
+  , cachedObjective_(0.0)
+  , cachedSolution_(NULL)
 {
 }
 
@@ -48,7 +58,10 @@ CbcBranchToFixLots::CbcBranchToFixLots(CbcModel *model, double djTolerance,
   int numberClean,
   const char *mark, bool alwaysCreate)
   : CbcBranchCut(model)
+  , candidates_(NULL)
+  , candidateDj_(NULL)
 {
+  clearCache();
   djTolerance_ = djTolerance;
   fractionFixed_ = fractionFixed;
   if (mark) {
@@ -68,7 +81,10 @@ CbcBranchToFixLots::CbcBranchToFixLots(CbcModel *model, double djTolerance,
 // Copy constructor
 CbcBranchToFixLots::CbcBranchToFixLots(const CbcBranchToFixLots &rhs)
   : CbcBranchCut(rhs)
+  , candidates_(NULL)
+  , candidateDj_(NULL)
 {
+  clearCache();
   djTolerance_ = rhs.djTolerance_;
   fractionFixed_ = rhs.fractionFixed_;
   int numberColumns = model_->getNumCols();
@@ -101,6 +117,7 @@ CbcBranchToFixLots::operator=(const CbcBranchToFixLots &rhs)
     depth_ = rhs.depth_;
     numberClean_ = rhs.numberClean_;
     alwaysCreate_ = rhs.alwaysCreate_;
+    clearCache();
   }
   return *this;
 }
@@ -109,6 +126,42 @@ CbcBranchToFixLots::operator=(const CbcBranchToFixLots &rhs)
 CbcBranchToFixLots::~CbcBranchToFixLots()
 {
   delete[] mark_;
+  delete[] candidates_;
+  delete[] candidateDj_;
+}
+// Forget cached shallWe and candidates
+void CbcBranchToFixLots::clearCache()
+{
+  delete[] candidates_;
+  delete[] candidateDj_;
+  candidates_ = NULL;
+  candidateDj_ = NULL;
+  numberCandidates_ = 0;
+  numberFixedIntegers_ = 0;
+  cachedType_ = -1;
+  cachedNode_ = -1;
+  cachedIterations_ = -1;
+  cachedObjective_ = 0.0;
+  cachedSolution_ = NULL;
+}
+/* Whether cached shallWe and candidates are for current LP - if not
+   LP is marked as the one cached */
+bool CbcBranchToFixLots::sameLp() const
+{
+  OsiSolverInterface *solver = model_->solver();
+  int numberNodes = model_->getNodeCount();
+  int numberIterations = solver->getIterationCount();
+  double objective = solver->getObjValue();
+  const double *solution = model_->testSolution();
+  if (cachedType_ >= 0 && numberNodes == cachedNode_ && numberIterations == cachedIterations_
+    && objective == cachedObjective_ && solution == cachedSolution_)
+    return true;
+  cachedType_ = -1;
+  cachedNode_ = numberNodes;
+  cachedIterations_ = numberIterations;
+  cachedObjective_ = objective;
+  cachedSolution_ = solution;
+  return false;
 }
 CbcBranchingObject *
 CbcBranchToFixLots::createCbcBranch(OsiSolverInterface *solver, const OsiBranchingInformation * /*info*/, int /*way*/)
@@ -119,7 +172,6 @@ CbcBranchToFixLots::createCbcBranch(OsiSolverInterface *solver, const OsiBranchi
   const double *solution = model_->testSolution();
   const double *lower = solver->getColLower();
   const double *upper = solver->getColUpper();
-  const double *dj = solver->getReducedCost();
   int i;
   int numberIntegers = model_->numberIntegers();
   const int *integerVariable = model_->integerVariable();
@@ -138,29 +190,11 @@ CbcBranchToFixLots::createCbcBranch(OsiSolverInterface *solver, const OsiBranchi
     assert(type);
     // Take clean first
     if (type == 1) {
-      for (i = 0; i < numberIntegers; i++) {
-        int iColumn = integerVariable[i];
-        if (upper[iColumn] > lower[iColumn]) {
-          if (!mark_ || !mark_[iColumn]) {
-            if (solution[iColumn] < lower[iColumn] + tolerance) {
-              if (dj[iColumn] > djTolerance_) {
-                dsort[nSort] = -dj[iColumn];
-                sort[nSort++] = iColumn;
-              }
-            } else if (solution[iColumn] > upper[iColumn] - tolerance) {
-              if (dj[iColumn] < -djTolerance_) {
-                dsort[nSort] = dj[iColumn];
-                sort[nSort++] = iColumn;
-              }
-            }
-          }
-        } else {
-          numberFixed++;
-        }
-      }
-      // sort
-      CoinSort_2(dsort, dsort + nSort, sort);
-      nSort = CoinMin(nSort, wantedFixed - numberFixed);
+      // candidates were found (wanted ones first) by shallWe for this LP
+      numberFixed = numberFixedIntegers_;
+      nSort = CoinMin(numberCandidates_, wantedFixed - numberFixed);
+      nSort = CoinMax(nSort, 0);
+      memcpy(sort, candidates_, nSort * sizeof(int));
     } else if (type < 10) {
       int i;
       //const double * rowLower = solver->getRowLower();
@@ -328,6 +362,9 @@ CbcBranchToFixLots::createCbcBranch(OsiSolverInterface *solver, const OsiBranchi
 */
 int CbcBranchToFixLots::shallWe() const
 {
+  // infeasibility is asked many times for same LP
+  if (sameLp())
+    return cachedType_;
   int returnCode = 0;
   OsiSolverInterface *solver = model_->solver();
   int numberRows = matrixByRow_.getNumRows();
@@ -372,7 +409,8 @@ int CbcBranchToFixLots::shallWe() const
     }
     delete[] sort;
     delete[] dsort;
-    return (n >= wanted) ? 10 : 0;
+    cachedType_ = (n >= wanted) ? 10 : 0;
+    return cachedType_;
   }
   double integerTolerance = model_->getDblParam(CbcModel::CbcIntegerTolerance);
   // make smaller ?
@@ -380,6 +418,11 @@ int CbcBranchToFixLots::shallWe() const
   // How many fixed are we aiming at
   int wantedFixed = static_cast< int >(static_cast< double >(numberIntegers) * fractionFixed_);
   if (djTolerance_ < 1.0e10) {
+    // one pass collects candidates which createCbcBranch will use
+    if (!candidates_) {
+      candidates_ = new int[numberIntegers];
+      candidateDj_ = new double[numberIntegers];
+    }
     int nSort = 0;
     int numberFixed = 0;
     for (i = 0; i < numberIntegers; i++) {
@@ -388,11 +431,13 @@ int CbcBranchToFixLots::shallWe() const
         if (!mark_ || !mark_[iColumn]) {
           if (solution[iColumn] < lower[iColumn] + tolerance) {
             if (dj[iColumn] > djTolerance_) {
-              nSort++;
+              candidateDj_[nSort] = -dj[iColumn];
+              candidates_[nSort++] = iColumn;
             }
           } else if (solution[iColumn] > upper[iColumn] - tolerance) {
             if (dj[iColumn] < -djTolerance_) {
-              nSort++;
+              candidateDj_[nSort] = dj[iColumn];
+              candidates_[nSort++] = iColumn;
             }
           }
         }
@@ -400,6 +445,31 @@ int CbcBranchToFixLots::shallWe() const
         numberFixed++;
       }
     }
+    numberFixedIntegers_ = numberFixed;
+    numberCandidates_ = nSort;
+    int numberWanted = wantedFixed - numberFixed;
+    if (numberWanted > 0 && numberWanted < nSort) {
+      /* only the numberWanted largest reduced costs are used so select
+         them (in linear time) rather than sorting all candidates */
+      double *temp = CoinCopyOfArray(candidateDj_, nSort);
+      std::nth_element(temp, temp + numberWanted - 1, temp + nSort);
+      double threshold = temp[numberWanted - 1];
+      delete[] temp;
+      int nLess = 0;
+      for (i = 0; i < nSort; i++) {
+        if (candidateDj_[i] < threshold) {
+          CoinSwap(candidateDj_[i], candidateDj_[nLess]);
+          CoinSwap(candidates_[i], candidates_[nLess++]);
+        }
+      }
+      // then ties up to number wanted
+      for (i = nLess; i < nSort && nLess < numberWanted; i++) {
+        if (candidateDj_[i] == threshold) {
+          CoinSwap(candidateDj_[i], candidateDj_[nLess]);
+          CoinSwap(candidates_[i], candidates_[nLess++]);
+        }
+      }
+    }
     if (numberFixed + nSort < wantedFixed && !alwaysCreate_) {
       returnCode = 0;
     } else if (numberFixed < wantedFixed) {
@@ -480,6 +550,7 @@ int CbcBranchToFixLots::shallWe() const
     } else {
     }
   }
+  cachedType_ = returnCode;
   return returnCode;
 }
 double
@@ -559,6 +630,7 @@ void CbcBranchToFixLots::redoSequenceEtc(CbcModel *model, int numberColumns, con
   }
   OsiSolverInterface *solver = model_->solver();
   matrixByRow_ = *solver->getMatrixByRow();
+  clearCache();
 }
 
 /* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
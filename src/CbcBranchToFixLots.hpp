@@ -69,6 +69,12 @@ public:
   /// Redoes data when sequence numbers change
   virtual void redoSequenceEtc(CbcModel *model, int numberColumns, const int *originalColumns);
 
+private:
+  /// Whether cached shallWe and candidates are for current LP (else marks it)
+  bool sameLp() const;
+  /// Forget cached shallWe and candidates
+  void clearCache();
+
 protected:
   /// data
 
@@ -86,6 +92,22 @@ protected:
   int numberClean_;
   /// If true then always create branch
   bool alwaysCreate_;
+  /** Integers which could be fixed on reduced cost at last LP (those
+      wanted first) - kept from shallWe for createCbcBranch */
+  mutable int *candidates_;
+  /// Minus absolute reduced cost of candidates
+  mutable double *candidateDj_;
+  /// Number of candidates
+  mutable int numberCandidates_;
+  /// Number of integers fixed at last LP
+  mutable int numberFixedIntegers_;
+  /// Result of shallWe at last LP (-1 if none)
+  mutable int cachedType_;
+  /// Node count, iteration count and objective of LP which was cached
+  mutable int cachedNode_;
+  mutable int cachedIterations_;
+  mutable double cachedObjective_;
+  mutable const double *cachedSolution_;
 };
 #endif
 
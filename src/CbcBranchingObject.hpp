@@ -11,6 +11,7 @@
 #include <vector>
 #include "CbcBranchBase.hpp"
 #include "OsiBranchingObject.hpp"
+#include "CbcNodePool.hpp"
 
 // The types of objects that will be derived from this class.
 enum CbcBranchObjType {
@@ -23,7 +24,9 @@ enum CbcBranchObjType {
   FollowOnBranchObj = 106,
   DummyBranchObj = 107,
   GeneralDepthBranchObj = 108,
+  IndicatorBranchObj = 109,
   OneGeneralBranchingObj = 110,
+  PiecewiseBranchObj = 111,
   CutBranchingObj = 200,
   LotsizeBranchObj = 300,
   DynamicPseudoCostBranchObj = 400
@@ -68,6 +71,17 @@ public:
   /// Destructor
   virtual ~CbcBranchingObject();
 
+  /// Allocate from node pool
+  static void *operator new(size_t size)
+  {
+    return CbcNodePool::allocate(size);
+  }
+  /// Return to node pool
+  static void operator delete(void *block, size_t size)
+  {
+    CbcNodePool::release(block, size);
+  }
+
   /** Some branchingObjects may claim to be able to skip
         strong branching.  If so they have to fill in CbcStrongInfo.
         The object mention in incoming CbcStrongInfo must match.
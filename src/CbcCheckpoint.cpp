@@ -0,0 +1,715 @@
+// Copyright (C) 2005, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#pragma warning(disable : 4786)
+#endif
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+
+#include "CoinFinite.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinWarmStartBasis.hpp"
+#include "OsiRowCut.hpp"
+#include "CbcModel.hpp"
+#include "CbcNode.hpp"
+#include "CbcFullNodeInfo.hpp"
+#include "CbcCountRowCut.hpp"
+#include "CbcSimpleInteger.hpp"
+#include "CbcSimpleIntegerDynamicPseudoCost.hpp"
+#include "CbcBranchDynamic.hpp"
+#include "CbcTreeSpill.hpp"
+#include "CbcCheckpoint.hpp"
+
+namespace {
+/*
+  A checkpoint is the eight characters "CBCCHKPT" and the header, then
+  root bounds (lower then upper), the solutions (objective then values),
+  the global cuts (cutHeader then indices and elements), the pseudocosts
+  and the nodes (nodeHeader then bound changes relative to root and the
+  basis status arrays as in CbcTreeSpill).
+*/
+typedef struct {
+  double bestObjective;
+  double seconds;
+  int version;
+  unsigned int hash;
+  int numberColumns;
+  int numberRowsAtContinuous;
+  int numberNodes;
+  int numberIterations;
+  int numberSolutions;
+  int numberSavedSolutions;
+  int numberCuts;
+  int numberPseudoCosts;
+  int numberNodesOnTree;
+  int spare;
+} checkpointHeader;
+
+typedef struct {
+  double lb;
+  double ub;
+  int numberElements;
+  int spare;
+} cutHeader;
+
+typedef struct {
+  double sumDownCost;
+  double sumUpCost;
+  double sumDownChange;
+  double sumUpChange;
+  double down;
+  double up;
+  int column;
+  int numberTimesDown;
+  int numberTimesUp;
+  int numberTimesDownInfeasible;
+  int numberTimesUpInfeasible;
+  int spare;
+} pseudoCostRecord;
+
+typedef struct {
+  double objective;
+  double estimate;
+  double sumInfeasibilities;
+  double value;
+  double down[2];
+  double up[2];
+  double changeInGuessed;
+  int depth;
+  int numberUnsatisfied;
+  int state;
+  int nodeInfoNumber;
+  int dynamic;
+  int column;
+  int way;
+  int branchesLeft;
+  int position;
+  int numberChanged;
+  int numberStructural;
+  int numberArtificial;
+} nodeHeader;
+
+const char magic[] = "CBCCHKPT";
+const size_t headerOffset = 8;
+
+// Bytes used by status array in CoinWarmStartBasis
+inline int statusBytes(int n)
+{
+  return 4 * ((n + 15) >> 4);
+}
+// Add n items to end of image
+template < class T >
+void append(std::vector< char > &image, const T *data, int n)
+{
+  const char *bytes = reinterpret_cast< const char * >(data);
+  image.insert(image.end(), bytes, bytes + n * sizeof(T));
+}
+// Copy n items from image at offset and move on - false if off end
+template < class T >
+bool extract(const std::vector< char > &image, size_t &offset, T *data, int n)
+{
+  size_t nBytes = n * sizeof(T);
+  if (n < 0 || offset + nBytes > image.size())
+    return false;
+  if (nBytes)
+    memcpy(data, &image[offset], nBytes);
+  offset += nBytes;
+  return true;
+}
+// Skip n items - false if off end
+template < class T >
+bool skip(const std::vector< char > &image, size_t &offset, const T *, int n)
+{
+  size_t nBytes = n * sizeof(T);
+  if (n < 0 || offset + nBytes > image.size())
+    return false;
+  offset += nBytes;
+  return true;
+}
+// Header of image (zero if none)
+checkpointHeader imageHeader(const std::vector< char > &image)
+{
+  checkpointHeader header;
+  memset(&header, 0, sizeof(header));
+  size_t offset = headerOffset;
+  extract(image, offset, &header, 1);
+  return header;
+}
+// Branch of node if it can go in checkpoint
+const CbcIntegerBranchingObject *integerBranch(CbcModel *model, const CbcNode *node)
+{
+  const CbcIntegerBranchingObject *branch = dynamic_cast< const CbcIntegerBranchingObject * >(node->branchingObject());
+  if (!branch || (branch->type() != SimpleIntegerBranchObj && branch->type() != DynamicPseudoCostBranchObj))
+    return NULL;
+  const CbcObject *object = branch->object();
+  if (!object || object->position() < 0 || object->position() >= model->numberObjects() || model->modifiableObject(object->position()) != object)
+    return NULL;
+  return branch;
+}
+}
+
+// Constructor - file and seconds between checkpoints
+CbcCheckpoint::CbcCheckpoint(const char *fileName, double interval)
+  : interval_(interval)
+  , lastTime_(0.0)
+  , solutionOffset_(0)
+  , cutOffset_(0)
+  , pseudoCostOffset_(0)
+  , nodeOffset_(0)
+  , written_(true)
+{
+  if (fileName)
+    fileName_ = fileName;
+#ifdef CBC_THREAD
+  writing_ = false;
+  stop_ = false;
+  pthread_mutex_init(&mutex_, NULL);
+  pthread_cond_init(&work_, NULL);
+  pthread_cond_init(&done_, NULL);
+  if (fileName_.size())
+    pthread_create(&writerThread_, NULL, writer, this);
+#endif
+}
+
+// Destructor - waits for write
+CbcCheckpoint::~CbcCheckpoint()
+{
+#ifdef CBC_THREAD
+  if (fileName_.size()) {
+    pthread_mutex_lock(&mutex_);
+    stop_ = true;
+    pthread_cond_signal(&work_);
+    pthread_mutex_unlock(&mutex_);
+    pthread_join(writerThread_, NULL);
+  }
+  pthread_cond_destroy(&done_);
+  pthread_cond_destroy(&work_);
+  pthread_mutex_destroy(&mutex_);
+#endif
+}
+
+// Check of problem (sizes, objective and integers)
+unsigned int CbcCheckpoint::problemHash(const CbcModel *model)
+{
+  const OsiSolverInterface *solver = model->solver();
+  int numberColumns = solver->getNumCols();
+  const double *objective = solver->getObjCoefficients();
+  // FNV-1a
+  unsigned int hash = 2166136261u;
+  for (int i = 0; i < numberColumns; i++) {
+    const unsigned char *bytes = reinterpret_cast< const unsigned char * >(objective + i);
+    for (size_t j = 0; j < sizeof(double); j++)
+      hash = (hash ^ bytes[j]) * 16777619u;
+    hash = (hash ^ (solver->isInteger(i) ? 1u : 0u)) * 16777619u;
+  }
+  hash = (hash ^ static_cast< unsigned int >(model->numberRowsAtContinuous())) * 16777619u;
+  return hash;
+}
+
+// Capture state of search into memory
+int CbcCheckpoint::capture(CbcModel *model, int part, int numberParts)
+{
+  const CbcFullNodeInfo *root = model->topOfTree();
+  CbcTree *tree = model->tree();
+  if (model->parallelMode() || !root || !tree)
+    return -1;
+  const CbcTreeSpill *spillTree = dynamic_cast< const CbcTreeSpill * >(tree);
+  if (spillTree && spillTree->numberSpilled())
+    return -1;
+  int numberNodesOnTree = tree->size();
+  for (int i = 0; i < numberNodesOnTree; i++) {
+    const CbcNode *node = tree->nodePointer(i);
+    if (!node->nodeInfo() || !integerBranch(model, node))
+      return -1;
+  }
+  // nodes of this part - dealt out in order of objective
+  std::vector< int > whichNodes;
+  if (numberParts > 1) {
+    std::vector< std::pair< double, int > > sorted(numberNodesOnTree);
+    for (int i = 0; i < numberNodesOnTree; i++)
+      sorted[i] = std::pair< double, int >(tree->nodePointer(i)->objectiveValue(), i);
+    std::sort(sorted.begin(), sorted.end());
+    for (int i = part; i < numberNodesOnTree; i += numberParts)
+      whichNodes.push_back(sorted[i].second);
+  } else {
+    for (int i = 0; i < numberNodesOnTree; i++)
+      whichNodes.push_back(i);
+  }
+  numberNodesOnTree = static_cast< int >(whichNodes.size());
+  OsiSolverInterface *solver = model->solver();
+  int numberColumns = solver->getNumCols();
+  int numberRowsAtContinuous = model->numberRowsAtContinuous();
+  std::vector< char > image;
+  image.reserve(image_.capacity());
+  append(image, magic, 8);
+  checkpointHeader header;
+  memset(&header, 0, sizeof(header));
+  header.bestObjective = model->savedSolutionObjective(0);
+  header.seconds = model->getCurrentSeconds();
+  header.version = version;
+  header.hash = problemHash(model);
+  header.numberColumns = numberColumns;
+  header.numberRowsAtContinuous = numberRowsAtContinuous;
+  header.numberNodes = model->getNodeCount();
+  header.numberIterations = model->getIterationCount();
+  header.numberSolutions = model->getSolutionCount();
+  if (part) {
+    // counts go with first part so merged parts add up
+    header.numberNodes = 0;
+    header.numberIterations = 0;
+  }
+  while (model->savedSolution(header.numberSavedSolutions))
+    header.numberSavedSolutions++;
+  CbcRowCuts *globalCuts = model->globalCuts();
+  header.numberCuts = globalCuts->sizeRowCuts();
+  int numberObjects = model->numberObjects();
+  for (int i = 0; i < numberObjects; i++) {
+    if (dynamic_cast< const CbcSimpleIntegerDynamicPseudoCost * >(model->object(i)))
+      header.numberPseudoCosts++;
+  }
+  header.numberNodesOnTree = numberNodesOnTree;
+  append(image, &header, 1);
+  append(image, root->lower(), numberColumns);
+  append(image, root->upper(), numberColumns);
+  // solutions
+  for (int i = 0; i < header.numberSavedSolutions; i++) {
+    double objective = model->savedSolutionObjective(i);
+    append(image, &objective, 1);
+    append(image, model->savedSolution(i), numberColumns);
+  }
+  // cuts
+  for (int i = 0; i < header.numberCuts; i++) {
+    const OsiRowCut *cut = globalCuts->rowCutPtr(i);
+    const CoinPackedVector &row = cut->row();
+    cutHeader cutRecord;
+    memset(&cutRecord, 0, sizeof(cutRecord));
+    cutRecord.lb = cut->lb();
+    cutRecord.ub = cut->ub();
+    cutRecord.numberElements = row.getNumElements();
+    append(image, &cutRecord, 1);
+    append(image, row.getIndices(), cutRecord.numberElements);
+    append(image, row.getElements(), cutRecord.numberElements);
+  }
+  // pseudocosts
+  for (int i = 0; i < numberObjects; i++) {
+    const CbcSimpleIntegerDynamicPseudoCost *obj = dynamic_cast< const CbcSimpleIntegerDynamicPseudoCost * >(model->object(i));
+    if (!obj)
+      continue;
+    pseudoCostRecord record;
+    memset(&record, 0, sizeof(record));
+    record.sumDownCost = obj->sumDownCost();
+    record.sumUpCost = obj->sumUpCost();
+    record.sumDownChange = obj->sumDownChange();
+    record.sumUpChange = obj->sumUpChange();
+    record.down = obj->downDynamicPseudoCost();
+    record.up = obj->upDynamicPseudoCost();
+    record.column = obj->columnNumber();
+    record.numberTimesDown = obj->numberTimesDown();
+    record.numberTimesUp = obj->numberTimesUp();
+    record.numberTimesDownInfeasible = obj->numberTimesDownInfeasible();
+    record.numberTimesUpInfeasible = obj->numberTimesUpInfeasible();
+    append(image, &record, 1);
+  }
+  // nodes - bounds and basis from addCuts1 as in CbcTreeSpill
+  const double *rootLower = root->lower();
+  const double *rootUpper = root->upper();
+  int *which = new int[numberColumns];
+  double *newLower = new double[2 * numberColumns];
+  double *newUpper = newLower + numberColumns;
+  for (int iNode = 0; iNode < numberNodesOnTree; iNode++) {
+    CbcNode *node = tree->nodePointer(whichNodes[iNode]);
+    const CbcIntegerBranchingObject *branch = integerBranch(model, node);
+    CoinWarmStartBasis *lastws = model->getEmptyBasis();
+    model->addCuts1(node, lastws);
+    // no cuts in record
+    lastws->resize(numberRowsAtContinuous, numberColumns);
+    nodeHeader nodeRecord;
+    memset(&nodeRecord, 0, sizeof(nodeRecord));
+    nodeRecord.objective = node->objectiveValue();
+    nodeRecord.estimate = node->guessedObjectiveValue();
+    nodeRecord.sumInfeasibilities = node->sumInfeasibilities();
+    nodeRecord.value = branch->value();
+    memcpy(nodeRecord.down, branch->downBounds(), 2 * sizeof(double));
+    memcpy(nodeRecord.up, branch->upBounds(), 2 * sizeof(double));
+    nodeRecord.depth = node->depth();
+    nodeRecord.numberUnsatisfied = node->numberUnsatisfied();
+    nodeRecord.state = node->getState();
+    nodeRecord.nodeInfoNumber = node->nodeInfo()->nodeNumber();
+    if (branch->type() == DynamicPseudoCostBranchObj) {
+      const CbcDynamicPseudoCostBranchingObject *dynamicBranch = dynamic_cast< const CbcDynamicPseudoCostBranchingObject * >(branch);
+      nodeRecord.dynamic = 1;
+      nodeRecord.changeInGuessed = dynamicBranch->changeInGuessed();
+    }
+    nodeRecord.column = branch->variable();
+    nodeRecord.way = branch->way();
+    nodeRecord.branchesLeft = branch->numberBranchesLeft();
+    nodeRecord.position = branch->object()->position();
+    const double *lower = solver->getColLower();
+    const double *upper = solver->getColUpper();
+    int numberChanged = 0;
+    for (int i = 0; i < numberColumns; i++) {
+      if (lower[i] != rootLower[i] || upper[i] != rootUpper[i]) {
+        which[numberChanged] = i;
+        newLower[numberChanged] = lower[i];
+        newUpper[numberChanged++] = upper[i];
+      }
+    }
+    nodeRecord.numberChanged = numberChanged;
+    nodeRecord.numberStructural = lastws->getNumStructural();
+    nodeRecord.numberArtificial = lastws->getNumArtificial();
+    append(image, &nodeRecord, 1);
+    append(image, which, numberChanged);
+    append(image, newLower, numberChanged);
+    append(image, newUpper, numberChanged);
+    append(image, lastws->getStructuralStatus(), statusBytes(nodeRecord.numberStructural));
+    append(image, lastws->getArtificialStatus(), statusBytes(nodeRecord.numberArtificial));
+    delete lastws;
+  }
+  delete[] which;
+  delete[] newLower;
+  image_.swap(image);
+  lastTime_ = header.seconds;
+  return numberNodesOnTree;
+}
+
+// Write captured state to file
+void CbcCheckpoint::write()
+{
+  if (!fileName_.size() || image_.empty())
+    return;
+#ifdef CBC_THREAD
+  pthread_mutex_lock(&mutex_);
+  // a newer image replaces one not yet started
+  pending_ = image_;
+  pthread_cond_signal(&work_);
+  pthread_mutex_unlock(&mutex_);
+#else
+  written_ = writeFile(image_);
+#endif
+}
+
+// Wait until file written
+bool CbcCheckpoint::flush()
+{
+#ifdef CBC_THREAD
+  if (fileName_.size()) {
+    pthread_mutex_lock(&mutex_);
+    while (pending_.size() || writing_)
+      pthread_cond_wait(&done_, &mutex_);
+    pthread_mutex_unlock(&mutex_);
+  }
+#endif
+  return written_;
+}
+
+// Write image to name.tmp and rename
+bool CbcCheckpoint::writeFile(const std::vector< char > &image) const
+{
+  std::string tempName = fileName_ + ".tmp";
+  FILE *fp = fopen(tempName.c_str(), "wb");
+  if (!fp)
+    return false;
+  bool ok = fwrite(&image[0], 1, image.size(), fp) == image.size();
+  ok = !fclose(fp) && ok;
+  if (ok) {
+#ifdef _WIN32
+    // rename will not replace existing file here - elsewhere it replaces
+    // atomically so a crash leaves old or new checkpoint, never neither
+    remove(fileName_.c_str());
+#endif
+    ok = !rename(tempName.c_str(), fileName_.c_str());
+  }
+  return ok;
+}
+
+#ifdef CBC_THREAD
+// What writing thread does
+void *CbcCheckpoint::writer(void *voidCheckpoint)
+{
+  CbcCheckpoint *checkpoint = reinterpret_cast< CbcCheckpoint * >(voidCheckpoint);
+  std::vector< char > image;
+  pthread_mutex_lock(&checkpoint->mutex_);
+  while (true) {
+    while (!checkpoint->stop_ && checkpoint->pending_.empty())
+      pthread_cond_wait(&checkpoint->work_, &checkpoint->mutex_);
+    if (checkpoint->pending_.empty())
+      break; // stopping and all written
+    image.swap(checkpoint->pending_);
+    checkpoint->pending_.clear();
+    checkpoint->writing_ = true;
+    pthread_mutex_unlock(&checkpoint->mutex_);
+    // write without lock so search is not held up
+    bool ok = checkpoint->writeFile(image);
+    pthread_mutex_lock(&checkpoint->mutex_);
+    checkpoint->written_ = ok;
+    checkpoint->writing_ = false;
+    pthread_cond_broadcast(&checkpoint->done_);
+  }
+  pthread_mutex_unlock(&checkpoint->mutex_);
+  return NULL;
+}
+#endif
+
+// Read checkpoint
+int CbcCheckpoint::read(const char *fileName)
+{
+  image_.clear();
+  FILE *fp = fopen(fileName, "rb");
+  if (!fp)
+    return -1;
+  char buffer[65536];
+  size_t n;
+  while ((n = fread(buffer, 1, sizeof(buffer), fp)) > 0)
+    image_.insert(image_.end(), buffer, buffer + n);
+  fclose(fp);
+  // check all parts are there
+  checkpointHeader header;
+  size_t offset = headerOffset;
+  bool ok = image_.size() >= headerOffset && !memcmp(&image_[0], magic, 8);
+  ok = ok && extract(image_, offset, &header, 1) && header.version == version;
+  int numberColumns = ok ? header.numberColumns : 0;
+  const double *dummyDouble = NULL;
+  const int *dummyInt = NULL;
+  ok = ok && skip(image_, offset, dummyDouble, 2 * numberColumns);
+  solutionOffset_ = offset;
+  ok = ok && skip(image_, offset, dummyDouble, header.numberSavedSolutions * (numberColumns + 1));
+  cutOffset_ = offset;
+  for (int i = 0; ok && i < header.numberCuts; i++) {
+    cutHeader cutRecord;
+    ok = extract(image_, offset, &cutRecord, 1);
+    ok = ok && skip(image_, offset, dummyInt, cutRecord.numberElements);
+    ok = ok && skip(image_, offset, dummyDouble, cutRecord.numberElements);
+  }
+  pseudoCostOffset_ = offset;
+  const pseudoCostRecord *dummyRecord = NULL;
+  ok = ok && skip(image_, offset, dummyRecord, header.numberPseudoCosts);
+  nodeOffset_ = offset;
+  for (int i = 0; ok && i < header.numberNodesOnTree; i++) {
+    nodeHeader nodeRecord;
+    ok = extract(image_, offset, &nodeRecord, 1);
+    ok = ok && skip(image_, offset, dummyInt, nodeRecord.numberChanged);
+    ok = ok && skip(image_, offset, dummyDouble, 2 * nodeRecord.numberChanged);
+    ok = ok && skip(image_, offset, buffer, statusBytes(nodeRecord.numberStructural) + statusBytes(nodeRecord.numberArtificial));
+  }
+  if (!ok) {
+    image_.clear();
+    return -2;
+  }
+  return 0;
+}
+
+// Give model solutions, cuts and pseudocosts
+bool CbcCheckpoint::restoreStart(CbcModel *model) const
+{
+  if (image_.empty())
+    return false;
+  checkpointHeader header;
+  size_t offset = headerOffset;
+  extract(image_, offset, &header, 1);
+  int numberColumns = header.numberColumns;
+  if (numberColumns != model->solver()->getNumCols()
+    || header.numberRowsAtContinuous != model->numberRowsAtContinuous()
+    || header.hash != problemHash(model))
+    return false;
+  // solutions - worst first so best ends as best
+  offset = solutionOffset_;
+  double *solution = new double[numberColumns];
+  double bestObjective = COIN_DBL_MAX;
+  double *bestSolution = NULL;
+  for (int i = 0; i < header.numberSavedSolutions; i++) {
+    double objective;
+    extract(image_, offset, &objective, 1);
+    extract(image_, offset, solution, numberColumns);
+    if (!i) {
+      bestObjective = objective;
+      bestSolution = CoinCopyOfArray(solution, numberColumns);
+    } else {
+      model->saveExtraSolution(solution, objective);
+    }
+  }
+  if (bestSolution) {
+    // another checkpoint may have given a better one
+    if (bestObjective < model->savedSolutionObjective(0) || !model->savedSolution(0))
+      model->setBestSolution(bestSolution, numberColumns, bestObjective);
+    else
+      model->saveExtraSolution(bestSolution, bestObjective);
+    delete[] bestSolution;
+  }
+  delete[] solution;
+  model->setSolutionCount(header.numberSolutions);
+  // cuts
+  offset = cutOffset_;
+  CbcRowCuts *globalCuts = model->globalCuts();
+  for (int i = 0; i < header.numberCuts; i++) {
+    cutHeader cutRecord;
+    extract(image_, offset, &cutRecord, 1);
+    int n = cutRecord.numberElements;
+    int *indices = new int[n];
+    double *elements = new double[n];
+    extract(image_, offset, indices, n);
+    extract(image_, offset, elements, n);
+    OsiRowCut cut;
+    cut.setLb(cutRecord.lb);
+    cut.setUb(cutRecord.ub);
+    cut.setRow(n, indices, elements, false);
+    globalCuts->addCutIfNotDuplicate(cut);
+    delete[] indices;
+    delete[] elements;
+  }
+  // pseudocosts - matched on column
+  offset = pseudoCostOffset_;
+  int *whichObject = new int[numberColumns];
+  CoinFillN(whichObject, numberColumns, -1);
+  int numberObjects = model->numberObjects();
+  for (int i = 0; i < numberObjects; i++) {
+    const CbcSimpleIntegerDynamicPseudoCost *obj = dynamic_cast< const CbcSimpleIntegerDynamicPseudoCost * >(model->object(i));
+    if (obj)
+      whichObject[obj->columnNumber()] = i;
+  }
+  for (int i = 0; i < header.numberPseudoCosts; i++) {
+    pseudoCostRecord record;
+    extract(image_, offset, &record, 1);
+    if (record.column < 0 || record.column >= numberColumns || whichObject[record.column] < 0)
+      continue;
+    CbcSimpleIntegerDynamicPseudoCost *obj = dynamic_cast< CbcSimpleIntegerDynamicPseudoCost * >(model->modifiableObject(whichObject[record.column]));
+    obj->setSumDownCost(record.sumDownCost);
+    obj->setSumUpCost(record.sumUpCost);
+    obj->setSumDownChange(record.sumDownChange);
+    obj->setSumUpChange(record.sumUpChange);
+    obj->setDownDynamicPseudoCost(record.down);
+    obj->setUpDynamicPseudoCost(record.up);
+    obj->setNumberTimesDown(record.numberTimesDown);
+    obj->setNumberTimesUp(record.numberTimesUp);
+    obj->setNumberTimesDownInfeasible(record.numberTimesDownInfeasible);
+    obj->setNumberTimesUpInfeasible(record.numberTimesUpInfeasible);
+  }
+  delete[] whichObject;
+  return true;
+}
+
+// Put nodes on tree of model
+int CbcCheckpoint::restoreNodes(CbcModel *model) const
+{
+  if (image_.empty())
+    return 0;
+  checkpointHeader header;
+  size_t offset = headerOffset;
+  extract(image_, offset, &header, 1);
+  int numberColumns = header.numberColumns;
+  // bounds are relative to root of captured search
+  double *rootLower = new double[2 * numberColumns];
+  double *rootUpper = rootLower + numberColumns;
+  extract(image_, offset, rootLower, 2 * numberColumns);
+  double *lower = new double[2 * numberColumns];
+  double *upper = lower + numberColumns;
+  int *which = new int[numberColumns];
+  double *newLower = new double[2 * numberColumns];
+  double *newUpper = newLower + numberColumns;
+  int numberRestored = 0;
+  CbcTree *tree = model->tree();
+  offset = nodeOffset_;
+  for (int iNode = 0; iNode < header.numberNodesOnTree; iNode++) {
+    nodeHeader nodeRecord;
+    extract(image_, offset, &nodeRecord, 1);
+    int numberChanged = nodeRecord.numberChanged;
+    extract(image_, offset, which, numberChanged);
+    extract(image_, offset, newLower, numberChanged);
+    extract(image_, offset, newUpper, numberChanged);
+    int nStructural = statusBytes(nodeRecord.numberStructural);
+    int nArtificial = statusBytes(nodeRecord.numberArtificial);
+    char *structuralStatus = new char[nStructural];
+    char *artificialStatus = new char[nArtificial];
+    extract(image_, offset, structuralStatus, nStructural);
+    extract(image_, offset, artificialStatus, nArtificial);
+    CbcObject *object = NULL;
+    if (nodeRecord.position >= 0 && nodeRecord.position < model->numberObjects())
+      object = dynamic_cast< CbcObject * >(model->modifiableObject(nodeRecord.position));
+    CbcSimpleInteger *integerObject = dynamic_cast< CbcSimpleInteger * >(object);
+    if (!integerObject || integerObject->columnNumber() != nodeRecord.column) {
+      // objects changed - can not use
+      delete[] structuralStatus;
+      delete[] artificialStatus;
+      continue;
+    }
+    memcpy(lower, rootLower, numberColumns * sizeof(double));
+    memcpy(upper, rootUpper, numberColumns * sizeof(double));
+    for (int i = 0; i < numberChanged; i++) {
+      int iColumn = which[i];
+      lower[iColumn] = newLower[i];
+      upper[iColumn] = newUpper[i];
+    }
+    CoinWarmStartBasis *basis = new CoinWarmStartBasis();
+    basis->assignBasisStatus(nodeRecord.numberStructural, nodeRecord.numberArtificial,
+      structuralStatus, artificialStatus);
+    // node
+    CbcNode *node = new CbcNode();
+    node->setObjectiveValue(nodeRecord.objective);
+    node->setGuessedObjectiveValue(nodeRecord.estimate);
+    node->setSumInfeasibilities(nodeRecord.sumInfeasibilities);
+    node->setDepth(nodeRecord.depth);
+    node->setNumberUnsatisfied(nodeRecord.numberUnsatisfied);
+    node->setState(nodeRecord.state & ~3);
+    CbcFullNodeInfo *info = new CbcFullNodeInfo(model, node, lower, upper, basis,
+      model->numberRowsAtContinuous());
+    info->setNodeNumber(nodeRecord.nodeInfoNumber);
+    node->setNodeInfo(info);
+    // branching object
+    CbcIntegerBranchingObject *branch;
+    if (nodeRecord.dynamic) {
+      CbcSimpleIntegerDynamicPseudoCost *dynamicObject = dynamic_cast< CbcSimpleIntegerDynamicPseudoCost * >(object);
+      CbcDynamicPseudoCostBranchingObject *dynamicBranch = new CbcDynamicPseudoCostBranchingObject(model, nodeRecord.column, nodeRecord.way, nodeRecord.value, dynamicObject);
+      dynamicBranch->setChangeInGuessed(nodeRecord.changeInGuessed);
+      branch = dynamicBranch;
+    } else {
+      branch = new CbcIntegerBranchingObject(model, nodeRecord.column, nodeRecord.way, nodeRecord.value);
+    }
+    branch->setOriginalObject(object);
+    branch->setDownBounds(nodeRecord.down);
+    branch->setUpBounds(nodeRecord.up);
+    if (nodeRecord.branchesLeft == 1)
+      branch->setNumberBranchesLeft(1);
+    node->setBranchingObject(branch);
+    node->initializeInfo();
+    tree->push(node);
+    numberRestored++;
+  }
+  delete[] rootLower;
+  delete[] lower;
+  delete[] which;
+  delete[] newLower;
+  return numberRestored;
+}
+
+// Nodes done when captured
+int CbcCheckpoint::numberNodes() const
+{
+  return imageHeader(image_).numberNodes;
+}
+// Iterations done when captured
+int CbcCheckpoint::numberIterations() const
+{
+  return imageHeader(image_).numberIterations;
+}
+// Solutions found when captured
+int CbcCheckpoint::numberSolutions() const
+{
+  return imageHeader(image_).numberSolutions;
+}
+// Nodes on tree when captured
+int CbcCheckpoint::numberNodesOnTree() const
+{
+  return imageHeader(image_).numberNodesOnTree;
+}
+// Elapsed seconds when captured
+double CbcCheckpoint::seconds() const
+{
+  return imageHeader(image_).seconds;
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
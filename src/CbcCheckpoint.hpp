@@ -0,0 +1,138 @@
+// Copyright (C) 2005, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcCheckpoint_H
+#define CbcCheckpoint_H
+
+#include <string>
+#include <vector>
+
+#include "CbcConfig.h"
+#ifdef CBC_THREAD
+#include <pthread.h>
+#endif
+
+class CbcModel;
+
+/** Checkpoint of a search so a long job can be resumed
+
+    A checkpoint holds the open nodes (bounds relative to the root, the
+    branch still to do and the basis), the incumbent and saved solutions,
+    the global cut pool, pseudocosts of dynamic objects and counts of nodes
+    and iterations.  It is captured into memory between nodes and the file
+    is written by a thread of its own, so the search only waits while
+    nodes are walked.  The file is written as name.tmp and then renamed, so
+    an interrupted write leaves the last checkpoint.
+
+    The open nodes can also be split into parts (CbcModel::writeSubtrees)
+    so subtrees can be searched by other processes - files are the
+    transport.  A worker reads its part with CbcModel::readCheckpoint
+    and, if it stops on a limit, its own checkpoint holds what is left;
+    several checkpoints can be read together to merge them again.
+
+    When resuming the root LP is solved again but root heuristics and root
+    cuts are skipped - the restored cuts and solutions are used instead -
+    and the nodes are put on the tree in place of the root.
+
+    Only serial search with simple integer branching can be captured and
+    the problem (after preprocessing) must be the same.  Cuts which were
+    only local to nodes are not kept (global cuts may be found again).
+*/
+
+class CBCLIB_EXPORT CbcCheckpoint {
+public:
+  /// Version of file
+  enum {
+    version = 1
+  };
+  /// Constructor - file and seconds between checkpoints (0 only when asked)
+  CbcCheckpoint(const char *fileName = NULL, double interval = 0.0);
+  /// Destructor - waits for write
+  ~CbcCheckpoint();
+
+  /// Whether a checkpoint is due at time seconds
+  inline bool due(double seconds) const
+  {
+    return interval_ > 0.0 && seconds >= lastTime_ + interval_;
+  }
+  /// File name
+  inline const char *fileName() const
+  {
+    return fileName_.c_str();
+  }
+  /** Capture state of search into memory (between nodes).  If
+      numberParts > 1 only nodes part, part+numberParts ... in order of
+      objective are kept (so parts can go to different processes).
+      Returns number of nodes or -1 if search can not be captured.
+      Normally called by CbcModel::captureCheckpoint */
+  int capture(CbcModel *model, int part = 0, int numberParts = 1);
+  /// Write captured state to file (on thread if threads)
+  void write();
+  /// Wait until file written - returns false if last write failed
+  bool flush();
+  /** Read checkpoint - returns 0 if OK, -1 if could not open file, -2 if
+      not a checkpoint of this version */
+  int read(const char *fileName);
+  /** Give model solutions, cuts and pseudocosts (at start of
+      branchAndBound).  Returns false if problem does not match */
+  bool restoreStart(CbcModel *model) const;
+  /** Put nodes on tree of model (after root node).  Returns number of
+      nodes restored */
+  int restoreNodes(CbcModel *model) const;
+  /// Nodes done when captured
+  int numberNodes() const;
+  /// Iterations done when captured
+  int numberIterations() const;
+  /// Solutions found when captured
+  int numberSolutions() const;
+  /// Nodes on tree when captured
+  int numberNodesOnTree() const;
+  /// Elapsed seconds when captured
+  double seconds() const;
+  /// Check of problem (sizes, objective and integers)
+  static unsigned int problemHash(const CbcModel *model);
+
+private:
+  /// Illegal copy constructor
+  CbcCheckpoint(const CbcCheckpoint &rhs);
+  /// Illegal assignment operator
+  CbcCheckpoint &operator=(const CbcCheckpoint &rhs);
+  /// Write image to file
+  bool writeFile(const std::vector< char > &image) const;
+#ifdef CBC_THREAD
+  /// What writing thread does
+  static void *writer(void *checkpoint);
+#endif
+
+  /// Captured (or read) checkpoint
+  std::vector< char > image_;
+  /// File
+  std::string fileName_;
+  /// Seconds between checkpoints
+  double interval_;
+  /// Time of last capture
+  double lastTime_;
+  /// Offsets of parts of image (after read)
+  size_t solutionOffset_;
+  size_t cutOffset_;
+  size_t pseudoCostOffset_;
+  size_t nodeOffset_;
+  /// Whether last write worked
+  bool written_;
+#ifdef CBC_THREAD
+  /// Image given to writer
+  std::vector< char > pending_;
+  pthread_mutex_t mutex_;
+  pthread_cond_t work_; // wakes writer
+  pthread_cond_t done_; // wakes flush
+  pthread_t writerThread_;
+  bool writing_;
+  bool stop_;
+#endif
+};
+
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -34,6 +34,7 @@ CbcClique::CbcClique()
   , type_(NULL)
   , cliqueType_(-1)
   , slack_(-1)
+  , columns_(NULL)
 {
 }
 
@@ -41,6 +42,7 @@ CbcClique::CbcClique()
 CbcClique::CbcClique(CbcModel *model, int cliqueType, int numberMembers,
   const int *which, const char *type, int identifier, int slack)
   : CbcObject(model)
+  , columns_(NULL)
 {
   numberMembers_ = numberMembers;
   int *backward = NULL;
@@ -97,6 +99,7 @@ CbcClique::CbcClique(CbcModel *model, int cliqueType, int numberMembers,
 // Copy constructor
 CbcClique::CbcClique(const CbcClique &rhs)
   : CbcObject(rhs)
+  , columns_(NULL)
 {
   numberMembers_ = rhs.numberMembers_;
   numberNonSOSMembers_ = rhs.numberNonSOSMembers_;
@@ -128,6 +131,8 @@ CbcClique::operator=(const CbcClique &rhs)
     CbcObject::operator=(rhs);
     delete[] members_;
     delete[] type_;
+    delete[] columns_;
+    columns_ = NULL;
     numberMembers_ = rhs.numberMembers_;
     numberNonSOSMembers_ = rhs.numberNonSOSMembers_;
     if (numberMembers_) {
@@ -150,10 +155,24 @@ CbcClique::~CbcClique()
 {
   delete[] members_;
   delete[] type_;
+  delete[] columns_;
+}
+
+// Columns of members
+const int *CbcClique::columns() const
+{
+  if (!columns_ && numberMembers_) {
+    const int *integer = model_->integerVariable();
+    columns_ = new int[numberMembers_];
+    for (int j = 0; j < numberMembers_; j++)
+      columns_[j] = integer[members_[j]];
+  }
+  return columns_;
 }
 /*
-  Unfortunately, that comment is untrue. And there are other issues. This
-  routine is clearly an unfinished work.
+  Values of members are gathered (and put in bounds) first so that the
+  scan of a long clique is a simple loop over contiguous arrays.  Result
+  is as before - the sort of fractional values was never used.
 */
 double
 CbcClique::infeasibility(const OsiBranchingInformation * /*info*/,
@@ -161,64 +180,57 @@ CbcClique::infeasibility(const OsiBranchingInformation * /*info*/,
 {
   int numberUnsatis = 0, numberFree = 0;
   int j;
-  const int *integer = model_->integerVariable();
+  const int *column = columns();
   OsiSolverInterface *solver = model_->solver();
   const double *solution = model_->testSolution();
   const double *lower = solver->getColLower();
   const double *upper = solver->getColUpper();
   double largestValue = 0.0;
   double integerTolerance = model_->getDblParam(CbcModel::CbcIntegerTolerance);
-  double *sort = new double[numberMembers_];
-  /*
-      Calculate integer infeasibility and fill an array. Pick off the infeasibility
-      of the slack and the max infeasibility while we're at it. You can see here
-      the conversion of `non-SOS' (strong value of 0, negative coefficient) to
-      `SOS' (strong value of 1, positive coefficient). Also count the number of
-      variables that have integral values but are not fixed.
-    */
-  double slackValue = 0.0;
+  double *values = new double[numberMembers_];
+  char *notFixed = new char[numberMembers_];
   for (j = 0; j < numberMembers_; j++) {
-    int sequence = members_[j];
-    int iColumn = integer[sequence];
+    int iColumn = column[j];
     double value = solution[iColumn];
     value = CoinMax(value, lower[iColumn]);
-    value = CoinMin(value, upper[iColumn]);
-    double nearest = floor(value + 0.5);
-    double distance = fabs(value - nearest);
-    if (distance > integerTolerance) {
-      if (!type_[j])
+    values[j] = CoinMin(value, upper[iColumn]);
+    notFixed[j] = upper[iColumn] > lower[iColumn] ? 1 : 0;
+  }
+  /*
+      Count fractional members (as strong value i.e. 1.0-value for `non-SOS'
+      members with negative coefficient) and the number of variables that have
+      integral values but are not fixed.
+    */
+  for (j = 0; j < numberMembers_; j++) {
+    double value = values[j];
+    double distance = fabs(value - floor(value + 0.5));
+    int fractional = distance > integerTolerance ? 1 : 0;
+    double strong = type_[j] ? value : 1.0 - value;
+    numberUnsatis += fractional;
+    numberFree += (1 - fractional) & notFixed[j];
+    largestValue = CoinMax(largestValue, fractional ? strong : 0.0);
+  }
+  // if slack then choose that
+  double slackValue = 0.0;
+  if (slack_ >= 0 && slack_ < numberMembers_) {
+    double value = values[slack_];
+    if (fabs(value - floor(value + 0.5)) > integerTolerance) {
+      if (!type_[slack_])
         value = 1.0 - value; // non SOS
-      // if slack then choose that
-      if (j == slack_ && value > 0.05)
+      if (value > 0.05)
         slackValue = value;
-      largestValue = CoinMax(value, largestValue);
-      sort[numberUnsatis++] = -value;
-    } else if (upper[iColumn] > lower[iColumn]) {
-      numberFree++;
     }
   }
-  /*
-      preferredWay will not change. The calculation of otherWay is an expensive
-      noop --- value is ultimately unused. Same for the sort of sort. It looks like
-      there was some notion of branching by splitting the set using even and odd
-      indices (as opposed to first and second half).
-    */
+  delete[] values;
+  delete[] notFixed;
   preferredWay = 1;
-  double otherWay = 0.0;
   if (numberUnsatis) {
-    // sort
-    std::sort(sort, sort + numberUnsatis);
-    for (j = 0; j < numberUnsatis; j++) {
-      if ((j & 1) != 0)
-        otherWay += -sort[j];
-    }
     // Need to think more
     /*
-          Here we have the actual infeasibility calculation. Most previous work is
-          discarded, and we calculate a value using various counts, adjusted by the
-          max value and slack value. This is not scaled to [0, .5].
+          Here we have the actual infeasibility calculation. We calculate a
+          value using various counts, adjusted by the max value and slack
+          value. This is not scaled to [0, .5].
         */
-
     double value = 0.2 * numberUnsatis + 0.01 * (numberMembers_ - numberFree);
     if (fabs(largestValue - 0.5) < 0.1) {
       // close to half
@@ -228,12 +240,8 @@ CbcClique::infeasibility(const OsiBranchingInformation * /*info*/,
       // branching on slack
       value += slackValue;
     }
-    // scale other way
-    otherWay *= value / (1.0 - otherWay);
-    delete[] sort;
     return value;
   } else {
-    delete[] sort;
     return 0.0; // satisfied
   }
 }
@@ -282,6 +290,8 @@ void CbcClique::redoSequenceEtc(CbcModel *model, int numberColumns, const int *o
       type_[n2++] = type_[j];
     }
   }
+  delete[] columns_;
+  columns_ = NULL;
   if (n2 < numberMembers_) {
     //printf("** SOS number of members reduced from %d to %d!\n",numberMembers_,n2);
     numberMembers_ = n2;
@@ -384,6 +394,46 @@ CbcClique::createCbcBranch(OsiSolverInterface *solver, const OsiBranchingInforma
   return branch;
 }
 
+// Position of lowest bit set
+static inline int lowestBit(unsigned int value)
+{
+#if defined(__GNUC__)
+  return __builtin_ctz(value);
+#else
+  int i = 0;
+  while (!(value & 1)) {
+    value >>= 1;
+    i++;
+  }
+  return i;
+#endif
+}
+
+/* Fix members with bit set in mask to weak value.  Only set bits are
+   visited so long cliques fixing a few members are cheap.
+*/
+static void
+fixCliqueMembers(OsiSolverInterface *solver, const CbcClique *clique,
+  const unsigned int *mask, int numberWords)
+{
+  const int *column = clique->columns();
+  for (int iWord = 0; iWord < numberWords; iWord++) {
+    unsigned int bits = mask[iWord];
+    while (bits) {
+      int j = lowestBit(bits) + 32 * iWord;
+      bits &= bits - 1;
+#ifdef FULL_PRINT
+      printf("%d ", j);
+#endif
+      // fix weak way
+      if (clique->type(j))
+        solver->setColUpper(column[j], 0.0);
+      else
+        solver->setColLower(column[j], 1.0);
+    }
+  }
+}
+
 // Default Constructor
 CbcCliqueBranchingObject::CbcCliqueBranchingObject()
   : CbcBranchingObject()
@@ -464,81 +514,20 @@ double
 CbcCliqueBranchingObject::branch()
 {
   decrementNumberBranchesLeft();
-  int iWord;
   int numberMembers = clique_->numberMembers();
-  const int *which = clique_->members();
-  const int *integerVariables = model_->integerVariable();
   int numberWords = (numberMembers + 31) >> 5;
   // *** for way - up means fix all those in down section
   if (way_ < 0) {
 #ifdef FULL_PRINT
     printf("Down Fix ");
 #endif
-    for (iWord = 0; iWord < numberWords; iWord++) {
-      int i;
-      for (i = 0; i < 32; i++) {
-        unsigned int k = 1 << i;
-        if ((upMask_[iWord] & k) != 0) {
-          int iColumn = which[i + 32 * iWord];
-#ifdef FULL_PRINT
-          printf("%d ", i + 32 * iWord);
-#endif
-          // fix weak way
-          if (clique_->type(i + 32 * iWord)) {
-#ifdef FULL_PRINT
-            printf("member %d int %d matcol %d bound %g %g to 0.0\n",
-              i, iColumn, integerVariables[iColumn],
-              model_->solver()->getColLower()[integerVariables[iColumn]],
-              model_->solver()->getColUpper()[integerVariables[iColumn]]);
-#endif
-            model_->solver()->setColUpper(integerVariables[iColumn], 0.0);
-          } else {
-#ifdef FULL_PRINT
-            printf("member %d int %d matcol %d bound %g %g to 1.0\n",
-              i, iColumn, integerVariables[iColumn],
-              model_->solver()->getColLower()[integerVariables[iColumn]],
-              model_->solver()->getColUpper()[integerVariables[iColumn]]);
-#endif
-            model_->solver()->setColLower(integerVariables[iColumn], 1.0);
-          }
-        }
-      }
-    }
+    fixCliqueMembers(model_->solver(), clique_, upMask_, numberWords);
     way_ = 1; // Swap direction
   } else {
 #ifdef FULL_PRINT
     printf("Up Fix ");
 #endif
-    for (iWord = 0; iWord < numberWords; iWord++) {
-      int i;
-      for (i = 0; i < 32; i++) {
-        unsigned int k = 1 << i;
-        if ((downMask_[iWord] & k) != 0) {
-          int iColumn = which[i + 32 * iWord];
-#ifdef FULL_PRINT
-          printf("%d ", i + 32 * iWord);
-#endif
-          // fix weak way
-          if (clique_->type(i + 32 * iWord)) {
-#ifdef FULL_PRINT
-            printf("member %d int %d matcol %d bound %g %g to 0.0\n",
-              i, iColumn, integerVariables[iColumn],
-              model_->solver()->getColLower()[integerVariables[iColumn]],
-              model_->solver()->getColUpper()[integerVariables[iColumn]]);
-#endif
-            model_->solver()->setColUpper(integerVariables[iColumn], 0.0);
-          } else {
-#ifdef FULL_PRINT
-            printf("member %d int %d matcol %d bound %g %g to 1.0\n",
-              i, iColumn, integerVariables[iColumn],
-              model_->solver()->getColLower()[integerVariables[iColumn]],
-              model_->solver()->getColUpper()[integerVariables[iColumn]]);
-#endif
-            model_->solver()->setColLower(integerVariables[iColumn], 1.0);
-          }
-        }
-      }
-    }
+    fixCliqueMembers(model_->solver(), clique_, downMask_, numberWords);
     way_ = -1; // Swap direction
   }
 #ifdef FULL_PRINT
@@ -753,55 +742,20 @@ double
 CbcLongCliqueBranchingObject::branch()
 {
   decrementNumberBranchesLeft();
-  int iWord;
   int numberMembers = clique_->numberMembers();
-  const int *which = clique_->members();
-  const int *integerVariables = model_->integerVariable();
   int numberWords = (numberMembers + 31) >> 5;
   // *** for way - up means fix all those in down section
   if (way_ < 0) {
 #ifdef FULL_PRINT
     printf("Down Fix ");
 #endif
-    for (iWord = 0; iWord < numberWords; iWord++) {
-      int i;
-      for (i = 0; i < 32; i++) {
-        unsigned int k = 1 << i;
-        if ((upMask_[iWord] & k) != 0) {
-          int iColumn = which[i + 32 * iWord];
-#ifdef FULL_PRINT
-          printf("%d ", i + 32 * iWord);
-#endif
-          // fix weak way
-          if (clique_->type(i + 32 * iWord))
-            model_->solver()->setColUpper(integerVariables[iColumn], 0.0);
-          else
-            model_->solver()->setColLower(integerVariables[iColumn], 1.0);
-        }
-      }
-    }
+    fixCliqueMembers(model_->solver(), clique_, upMask_, numberWords);
     way_ = 1; // Swap direction
   } else {
 #ifdef FULL_PRINT
     printf("Up Fix ");
 #endif
-    for (iWord = 0; iWord < numberWords; iWord++) {
-      int i;
-      for (i = 0; i < 32; i++) {
-        unsigned int k = 1 << i;
-        if ((downMask_[iWord] & k) != 0) {
-          int iColumn = which[i + 32 * iWord];
-#ifdef FULL_PRINT
-          printf("%d ", i + 32 * iWord);
-#endif
-          // fix weak way
-          if (clique_->type(i + 32 * iWord))
-            model_->solver()->setColUpper(integerVariables[iColumn], 0.0);
-          else
-            model_->solver()->setColLower(integerVariables[iColumn], 1.0);
-        }
-      }
-    }
+    fixCliqueMembers(model_->solver(), clique_, downMask_, numberWords);
     way_ = -1; // Swap direction
   }
 #ifdef FULL_PRINT
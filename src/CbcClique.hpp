@@ -93,6 +93,10 @@ public:
     return members_;
   }
 
+  /** Columns in solver of members (built from integerVariable of model
+      when first needed so members can be scanned without indirection) */
+  const int *columns() const;
+
   /*! \brief Type of each member, i.e., which way is strong.
   
       This also specifies whether a variable has a +1 or -1 coefficient.
@@ -154,6 +158,9 @@ protected:
       menbers.
     */
   int slack_;
+
+  /// Columns of members (see columns())
+  mutable int *columns_;
 };
 
 /** Branching object for unordered cliques
@@ -0,0 +1,351 @@
+// Copyright (C) 2008, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#pragma warning(disable : 4786)
+#endif
+
+#include <cassert>
+#include <cmath>
+#include <cfloat>
+
+#include "OsiSolverInterface.hpp"
+#include "CbcModel.hpp"
+#include "CbcClique.hpp"
+#include "CbcCliqueTable.hpp"
+#include "CbcBoundPropagator.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinSort.hpp"
+
+// Default Constructor
+CbcCliqueTable::CbcCliqueTable()
+  : cliqueStart_(NULL)
+  , cliqueLiterals_(NULL)
+  , equality_(NULL)
+  , literalStart_(NULL)
+  , literalCliques_(NULL)
+  , numberColumns_(0)
+  , numberCliques_(0)
+  , maximumCliques_(0)
+  , maximumLiterals_(0)
+{
+}
+
+/* Constructor from rows of solver.
+   Each side of a row is made into sum c_j l_j <= b with c_j > 0 over
+   binary literals (complementing negative coefficients) after taking
+   least contribution of other columns.  With c in decreasing order the
+   first k literals where c[k-2]+c[k-1] > b are a clique.
+*/
+CbcCliqueTable::CbcCliqueTable(const OsiSolverInterface *solver)
+  : cliqueStart_(NULL)
+  , cliqueLiterals_(NULL)
+  , equality_(NULL)
+  , literalStart_(NULL)
+  , literalCliques_(NULL)
+  , numberCliques_(0)
+  , maximumCliques_(0)
+  , maximumLiterals_(0)
+{
+  numberColumns_ = solver->getNumCols();
+  int numberRows = solver->getNumRows();
+  const CoinPackedMatrix *matrixByRow = solver->getMatrixByRow();
+  const double *elementByRow = matrixByRow->getElements();
+  const int *column = matrixByRow->getIndices();
+  const CoinBigIndex *rowStart = matrixByRow->getVectorStarts();
+  const int *rowLength = matrixByRow->getVectorLengths();
+  const double *rowLower = solver->getRowLower();
+  const double *rowUpper = solver->getRowUpper();
+  const double *lower = solver->getColLower();
+  const double *upper = solver->getColUpper();
+  double tolerance;
+  solver->getDblParam(OsiPrimalTolerance, tolerance);
+  char *binary = new char[numberColumns_];
+  for (int iColumn = 0; iColumn < numberColumns_; iColumn++)
+    binary[iColumn] = (solver->isBinary(iColumn) && lower[iColumn] == 0.0
+                        && upper[iColumn] == 1.0)
+      ? 1
+      : 0;
+  int maximumLength = 0;
+  for (int iRow = 0; iRow < numberRows; iRow++)
+    maximumLength = CoinMax(maximumLength, rowLength[iRow]);
+  double *coefficient = new double[maximumLength];
+  int *literals = new int[maximumLength];
+  for (int iRow = 0; iRow < numberRows; iRow++) {
+    for (int iSide = 0; iSide < 2; iSide++) {
+      // side 0 is <= rowUpper, side 1 is >= rowLower (negated)
+      double rhs = iSide ? -rowLower[iRow] : rowUpper[iRow];
+      if (rhs > 1.0e20)
+        continue;
+      double multiplier = iSide ? -1.0 : 1.0;
+      int numberBinary = 0;
+      bool possible = true;
+      bool allOne = true;
+      for (CoinBigIndex j = rowStart[iRow]; j < rowStart[iRow] + rowLength[iRow]; j++) {
+        int iColumn = column[j];
+        double value = multiplier * elementByRow[j];
+        if (!value)
+          continue;
+        if (binary[iColumn]) {
+          if (value > 0.0) {
+            literals[numberBinary] = literal(iColumn, 1);
+          } else {
+            literals[numberBinary] = literal(iColumn, 0);
+            rhs -= value;
+            value = -value;
+          }
+          if (value != 1.0)
+            allOne = false;
+          // sort is increasing
+          coefficient[numberBinary++] = -value;
+        } else {
+          // least contribution
+          double bound = value > 0.0 ? lower[iColumn] : upper[iColumn];
+          if (fabs(bound) > 1.0e20) {
+            possible = false;
+            break;
+          }
+          rhs -= value * bound;
+          if (lower[iColumn] != upper[iColumn])
+            allOne = false;
+        }
+      }
+      if (!possible || numberBinary < 2)
+        continue;
+      CoinSort_2(coefficient, coefficient + numberBinary, literals);
+      int n = 1;
+      while (n < numberBinary && -(coefficient[n - 1] + coefficient[n]) > rhs + tolerance)
+        n++;
+      if (n < 2)
+        continue;
+      // sum of literals == 1
+      bool equality = !iSide && allOne && n == numberBinary
+        && rowLower[iRow] == rowUpper[iRow] && fabs(rhs - 1.0) < tolerance;
+      addClique(n, literals, equality);
+    }
+  }
+  delete[] binary;
+  delete[] coefficient;
+  delete[] literals;
+  finish();
+}
+
+// Copy constructor
+CbcCliqueTable::CbcCliqueTable(const CbcCliqueTable &rhs)
+  : cliqueStart_(NULL)
+  , cliqueLiterals_(NULL)
+  , equality_(NULL)
+  , literalStart_(NULL)
+  , literalCliques_(NULL)
+{
+  gutsOfCopy(rhs);
+}
+
+// Assignment operator
+CbcCliqueTable &
+CbcCliqueTable::operator=(const CbcCliqueTable &rhs)
+{
+  if (this != &rhs) {
+    gutsOfDelete();
+    gutsOfCopy(rhs);
+  }
+  return *this;
+}
+
+// Destructor
+CbcCliqueTable::~CbcCliqueTable()
+{
+  gutsOfDelete();
+}
+
+// Free arrays
+void CbcCliqueTable::gutsOfDelete()
+{
+  delete[] cliqueStart_;
+  delete[] cliqueLiterals_;
+  delete[] equality_;
+  delete[] literalStart_;
+  delete[] literalCliques_;
+  cliqueStart_ = NULL;
+  cliqueLiterals_ = NULL;
+  equality_ = NULL;
+  literalStart_ = NULL;
+  literalCliques_ = NULL;
+}
+
+// Copy
+void CbcCliqueTable::gutsOfCopy(const CbcCliqueTable &rhs)
+{
+  numberColumns_ = rhs.numberColumns_;
+  numberCliques_ = rhs.numberCliques_;
+  maximumCliques_ = rhs.maximumCliques_;
+  maximumLiterals_ = rhs.maximumLiterals_;
+  if (rhs.cliqueStart_) {
+    cliqueStart_ = CoinCopyOfArray(rhs.cliqueStart_, maximumCliques_ + 1);
+    cliqueLiterals_ = CoinCopyOfArray(rhs.cliqueLiterals_, maximumLiterals_);
+    equality_ = CoinCopyOfArray(rhs.equality_, maximumCliques_);
+  }
+  if (rhs.literalStart_) {
+    literalStart_ = CoinCopyOfArray(rhs.literalStart_, 2 * numberColumns_ + 1);
+    literalCliques_ = CoinCopyOfArray(rhs.literalCliques_, literalStart_[2 * numberColumns_]);
+  }
+}
+
+// Add clique
+void CbcCliqueTable::addClique(int numberLiterals, const int *literals, bool equality)
+{
+  if (numberLiterals < 2)
+    return;
+  int numberNow = numberCliques_ ? cliqueStart_[numberCliques_] : 0;
+  if (numberCliques_ == maximumCliques_) {
+    int newMaximum = 2 * maximumCliques_ + 100;
+    int *tempI = new int[newMaximum + 1];
+    char *tempC = new char[newMaximum];
+    if (numberCliques_) {
+      CoinMemcpyN(cliqueStart_, numberCliques_ + 1, tempI);
+      CoinMemcpyN(equality_, numberCliques_, tempC);
+    } else {
+      tempI[0] = 0;
+    }
+    delete[] cliqueStart_;
+    delete[] equality_;
+    cliqueStart_ = tempI;
+    equality_ = tempC;
+    maximumCliques_ = newMaximum;
+  }
+  if (numberNow + numberLiterals > maximumLiterals_) {
+    int newMaximum = 2 * maximumLiterals_ + numberLiterals + 1000;
+    int *tempI = new int[newMaximum];
+    CoinMemcpyN(cliqueLiterals_, numberNow, tempI);
+    delete[] cliqueLiterals_;
+    cliqueLiterals_ = tempI;
+    maximumLiterals_ = newMaximum;
+  }
+  CoinMemcpyN(literals, numberLiterals, cliqueLiterals_ + numberNow);
+  equality_[numberCliques_] = equality ? 1 : 0;
+  numberCliques_++;
+  cliqueStart_[numberCliques_] = numberNow + numberLiterals;
+}
+
+// Add cliques from CbcClique objects of model
+void CbcCliqueTable::addCliques(const CbcModel *model)
+{
+  int numberObjects = model->numberObjects();
+  const int *integerVariable = model->integerVariable();
+  int *literals = NULL;
+  int maximumLength = 0;
+  for (int i = 0; i < numberObjects; i++) {
+    const CbcClique *obj = dynamic_cast< const CbcClique * >(model->object(i));
+    if (!obj)
+      continue;
+    int numberMembers = obj->numberMembers();
+    if (numberMembers > maximumLength) {
+      delete[] literals;
+      maximumLength = numberMembers;
+      literals = new int[maximumLength];
+    }
+    const int *members = obj->members();
+    for (int j = 0; j < numberMembers; j++) {
+      int iColumn = integerVariable[members[j]];
+      assert(2 * iColumn < 2 * numberColumns_);
+      // type 1 means +1 coefficient so at most one at one
+      literals[j] = literal(iColumn, obj->type(j));
+    }
+    addClique(numberMembers, literals, obj->cliqueType() == 1);
+  }
+  delete[] literals;
+}
+
+// Build per literal index
+void CbcCliqueTable::finish()
+{
+  delete[] literalStart_;
+  delete[] literalCliques_;
+  int numberLiterals = 2 * numberColumns_;
+  literalStart_ = new int[numberLiterals + 1];
+  CoinZeroN(literalStart_, numberLiterals + 1);
+  int numberElements = numberCliques_ ? cliqueStart_[numberCliques_] : 0;
+  for (int j = 0; j < numberElements; j++)
+    literalStart_[cliqueLiterals_[j] + 1]++;
+  for (int i = 0; i < numberLiterals; i++)
+    literalStart_[i + 1] += literalStart_[i];
+  literalCliques_ = new int[CoinMax(numberElements, 1)];
+  int *put = new int[numberLiterals];
+  CoinMemcpyN(literalStart_, numberLiterals, put);
+  // cliques in increasing order
+  for (int iClique = 0; iClique < numberCliques_; iClique++) {
+    for (int j = cliqueStart_[iClique]; j < cliqueStart_[iClique + 1]; j++)
+      literalCliques_[put[cliqueLiterals_[j]]++] = iClique;
+  }
+  delete[] put;
+}
+
+// True if literals can not both be true
+bool CbcCliqueTable::conflict(int literalA, int literalB) const
+{
+  if ((literalA ^ 1) == literalB)
+    return true;
+  if (literalA == literalB)
+    return false;
+  int i = literalStart_[literalA];
+  int iEnd = literalStart_[literalA + 1];
+  int j = literalStart_[literalB];
+  int jEnd = literalStart_[literalB + 1];
+  while (i < iEnd && j < jEnd) {
+    int iClique = literalCliques_[i];
+    int jClique = literalCliques_[j];
+    if (iClique == jClique)
+      return true;
+    else if (iClique < jClique)
+      i++;
+    else
+      j++;
+  }
+  return false;
+}
+
+// Fix all literals in conflict with given one to false
+int CbcCliqueTable::fixConflicts(CbcBoundPropagator &propagator, int literal) const
+{
+  int numberFixed = 0;
+  for (int i = literalStart_[literal]; i < literalStart_[literal + 1]; i++) {
+    int iClique = literalCliques_[i];
+    for (int j = cliqueStart_[iClique]; j < cliqueStart_[iClique + 1]; j++) {
+      int other = cliqueLiterals_[j];
+      if (other == literal)
+        continue;
+      int returnCode = propagator.fix(column(other), 1 - value(other));
+      if (returnCode < 0)
+        return -1;
+      numberFixed += returnCode;
+    }
+  }
+  return numberFixed;
+}
+
+// Fix conflicts of columns fixed since mark
+int CbcCliqueTable::propagate(CbcBoundPropagator &propagator, int mark) const
+{
+  const double *lower = propagator.lower();
+  const double *upper = propagator.upper();
+  int numberFixed = 0;
+  // trail grows as literals are fixed
+  for (int i = mark; i < propagator.mark(); i++) {
+    int iColumn = propagator.changedColumn(i);
+    if (iColumn >= numberColumns_ || lower[iColumn] != upper[iColumn])
+      continue;
+    double value = lower[iColumn];
+    if (value != 0.0 && value != 1.0)
+      continue;
+    int returnCode = fixConflicts(propagator, literal(iColumn, static_cast< int >(value)));
+    if (returnCode < 0)
+      return -1;
+    numberFixed += returnCode;
+  }
+  return numberFixed;
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -0,0 +1,148 @@
+// Copyright (C) 2008, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcCliqueTable_H
+#define CbcCliqueTable_H
+
+#include "CbcConfig.h"
+
+class OsiSolverInterface;
+class CbcBoundPropagator;
+class CbcModel;
+
+/** Table of cliques of binary literals
+
+    A literal is a binary column at one or zero - literal 2*iColumn is
+    column at one and 2*iColumn+1 is column at zero (complement).  A
+    clique is a set of literals at most one of which can be true (exactly
+    one if equality).  Cliques are kept one after another (start and
+    literals) and for each literal the cliques it is in are kept in
+    increasing order, so whether two literals are in conflict is a merge
+    of two short lists.
+
+    Built once from rows of (preprocessed) solver where any two binaries
+    (after complementing those with negative coefficients) can not be
+    at one together, and from clique objects of model.  Used to fix
+    literals in conflict with one fixed true in node propagation and
+    fix-and-propagate heuristics.
+ */
+
+class CBCLIB_EXPORT CbcCliqueTable {
+public:
+  /// Default Constructor
+  CbcCliqueTable();
+
+  /// Constructor from rows of solver
+  CbcCliqueTable(const OsiSolverInterface *solver);
+
+  /// Copy constructor
+  CbcCliqueTable(const CbcCliqueTable &);
+
+  /// Assignment operator
+  CbcCliqueTable &operator=(const CbcCliqueTable &rhs);
+
+  /// Destructor
+  ~CbcCliqueTable();
+
+  /// Literal for column at value (0 or 1)
+  static inline int literal(int iColumn, int value)
+  {
+    return 2 * iColumn + (value ? 0 : 1);
+  }
+  /// Column of literal
+  static inline int column(int literal)
+  {
+    return literal >> 1;
+  }
+  /// Value column has if literal true
+  static inline int value(int literal)
+  {
+    return (literal & 1) ? 0 : 1;
+  }
+
+  /** Add clique of literals (at least two).  Literals in conflict index
+      are not updated until finish is called */
+  void addClique(int numberLiterals, const int *literals, bool equality = false);
+  /// Add cliques from CbcClique objects of model
+  void addCliques(const CbcModel *model);
+  /// Build per literal index after adding cliques
+  void finish();
+
+  /// True if literals can not both be true
+  bool conflict(int literalA, int literalB) const;
+  /** Fix all literals in conflict with given one to false (literal
+      itself is not fixed).  Returns number fixed or -1 if infeasible */
+  int fixConflicts(CbcBoundPropagator &propagator, int literal) const;
+  /** For columns changed on propagator trail after mark which are now
+      fixed fix literals in conflict.  Returns number fixed or -1 if
+      infeasible */
+  int propagate(CbcBoundPropagator &propagator, int mark) const;
+
+  /// Number of cliques
+  inline int numberCliques() const
+  {
+    return numberCliques_;
+  }
+  /// Number of columns
+  inline int numberColumns() const
+  {
+    return numberColumns_;
+  }
+  /// Number of literals in clique
+  inline int cliqueLength(int iClique) const
+  {
+    return cliqueStart_[iClique + 1] - cliqueStart_[iClique];
+  }
+  /// Literals in clique
+  inline const int *clique(int iClique) const
+  {
+    return cliqueLiterals_ + cliqueStart_[iClique];
+  }
+  /// Whether clique is equality (exactly one true)
+  inline bool equality(int iClique) const
+  {
+    return equality_[iClique] != 0;
+  }
+  /// Number of cliques literal is in (after finish)
+  inline int numberCliquesOf(int literal) const
+  {
+    return literalStart_[literal + 1] - literalStart_[literal];
+  }
+  /// Cliques literal is in - in increasing order (after finish)
+  inline const int *cliquesOf(int literal) const
+  {
+    return literalCliques_ + literalStart_[literal];
+  }
+
+private:
+  /// Free arrays
+  void gutsOfDelete();
+  /// Copy
+  void gutsOfCopy(const CbcCliqueTable &rhs);
+
+private:
+  /// Start of each clique (numberCliques_+1)
+  int *cliqueStart_;
+  /// Literals of cliques
+  int *cliqueLiterals_;
+  /// Whether each clique is equality
+  char *equality_;
+  /// Start of cliques of each literal (2*numberColumns_+1)
+  int *literalStart_;
+  /// Cliques of each literal
+  int *literalCliques_;
+  /// Number of columns
+  int numberColumns_;
+  /// Number of cliques
+  int numberCliques_;
+  /// Space for cliques
+  int maximumCliques_;
+  /// Space for literals
+  int maximumLiterals_;
+};
+
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -0,0 +1,106 @@
+// Copyright (C) 2002, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#pragma warning(disable : 4786)
+#endif
+#include <cstring>
+
+#include "CoinSort.hpp"
+#include "CbcColumnPool.hpp"
+
+// Default Constructor
+CbcColumnPool::CbcColumnPool()
+{
+  starts_.push_back(0);
+}
+
+CbcColumnPool::~CbcColumnPool()
+{
+}
+
+// Columns of model which priced columns can go into
+void CbcColumnPool::setSlots(int numberSlots, const int *which)
+{
+  slots_.assign(which, which + numberSlots);
+  clear();
+}
+
+// Forget priced columns
+void CbcColumnPool::clear()
+{
+  starts_.clear();
+  starts_.push_back(0);
+  rows_.clear();
+  elements_.clear();
+  objective_.clear();
+  hash_.clear();
+}
+
+static unsigned int hashColumn(int numberElements, const int *rows,
+  const double *elements, double objective)
+{
+  unsigned int hash = 2166136261u;
+  unsigned char bytes[sizeof(double)];
+  for (int i = -1; i < numberElements; i++) {
+    double value = i >= 0 ? elements[i] : objective;
+    if (i >= 0)
+      hash = (hash ^ static_cast< unsigned int >(rows[i])) * 16777619u;
+    memcpy(bytes, &value, sizeof(double));
+    for (size_t k = 0; k < sizeof(double); k++)
+      hash = (hash ^ bytes[k]) * 16777619u;
+  }
+  return hash;
+}
+
+// Stores column if new and slot free
+int CbcColumnPool::addColumn(int numberElements, const int *rows,
+  const double *elements, double objective)
+{
+  int numberUsed = numberColumns();
+  if (numberUsed == numberSlots())
+    return -2;
+  // sorted copy without zeros
+  std::vector< int > sortedRows;
+  std::vector< double > sortedElements;
+  for (int i = 0; i < numberElements; i++) {
+    if (elements[i]) {
+      sortedRows.push_back(rows[i]);
+      sortedElements.push_back(elements[i]);
+    }
+  }
+  int n = static_cast< int >(sortedRows.size());
+  if (n)
+    CoinSort_2(&sortedRows[0], &sortedRows[0] + n, &sortedElements[0]);
+  const int *newRows = n ? &sortedRows[0] : NULL;
+  const double *newElements = n ? &sortedElements[0] : NULL;
+  unsigned int hash = hashColumn(n, newRows, newElements, objective);
+  for (int i = 0; i < numberUsed; i++) {
+    if (hash_[i] != hash || columnLength(i) != n || objective_[i] != objective)
+      continue;
+    if (!n || (!memcmp(columnRows(i), newRows, n * sizeof(int))
+                && !memcmp(columnElements(i), newElements, n * sizeof(double))))
+      return -1;
+  }
+  rows_.insert(rows_.end(), sortedRows.begin(), sortedRows.end());
+  elements_.insert(elements_.end(), sortedElements.begin(), sortedElements.end());
+  starts_.push_back(static_cast< CoinBigIndex >(rows_.size()));
+  objective_.push_back(objective);
+  hash_.push_back(hash);
+  return slots_[numberUsed];
+}
+
+// Default Constructor
+CbcPricer::CbcPricer()
+  : maximumPasses_(100)
+{
+}
+
+CbcPricer::~CbcPricer()
+{
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -0,0 +1,148 @@
+// Copyright (C) 2002, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcColumnPool_H
+#define CbcColumnPool_H
+
+#include <cstddef>
+#include <vector>
+
+#include "CbcConfig.h"
+#include "CoinTypes.hpp"
+
+class CbcModel;
+class CbcNode;
+
+/** Columns found by pricing during branch and bound
+
+    The model keeps its size during the search, so columns found by a
+    CbcPricer go into slots - columns of the model with no elements, zero
+    cost and lower bound zero, made by the user with the bounds and
+    integrality priced columns need.  While empty a slot does nothing (it
+    is zero in solutions which matter), so bounds and bases saved in the
+    tree stay valid when a slot is filled and columns are never removed.
+
+    The pool keeps the elements and cost of each priced column (in order
+    added) so the same column is not added twice.
+*/
+
+class CBCLIB_EXPORT CbcColumnPool {
+public:
+  /// Default Constructor
+  CbcColumnPool();
+  /// Destructor
+  ~CbcColumnPool();
+
+  /// Columns of model which priced columns can go into (in order used)
+  void setSlots(int numberSlots, const int *which);
+  /// Number of slots
+  inline int numberSlots() const
+  {
+    return static_cast< int >(slots_.size());
+  }
+  /// Number of priced columns (slots used)
+  inline int numberColumns() const
+  {
+    return static_cast< int >(objective_.size());
+  }
+  /// Number of slots still free
+  inline int numberFreeSlots() const
+  {
+    return numberSlots() - numberColumns();
+  }
+  /// Column of model with priced column i (or slot i)
+  inline int column(int i) const
+  {
+    return slots_[i];
+  }
+  /// Cost of priced column i
+  inline double objective(int i) const
+  {
+    return objective_[i];
+  }
+  /// Number of elements in priced column i
+  inline int columnLength(int i) const
+  {
+    return static_cast< int >(starts_[i + 1] - starts_[i]);
+  }
+  /// Rows of priced column i (sorted)
+  inline const int *columnRows(int i) const
+  {
+    return columnLength(i) ? &rows_[starts_[i]] : NULL;
+  }
+  /// Elements of priced column i
+  inline const double *columnElements(int i) const
+  {
+    return columnLength(i) ? &elements_[starts_[i]] : NULL;
+  }
+  /** Stores column if it is new and there is a free slot.
+      Returns column of model it goes into, -1 if same column already
+      there or -2 if no slot free.  Only bookkeeping - use
+      CbcModel::addPricedColumn to put column in model */
+  int addColumn(int numberElements, const int *rows, const double *elements,
+    double objective);
+  /// Forget priced columns (slots kept)
+  void clear();
+
+private:
+  /// Columns of model for priced columns
+  std::vector< int > slots_;
+  /// Starts of priced columns in rows_ and elements_
+  std::vector< CoinBigIndex > starts_;
+  /// Rows of priced columns
+  std::vector< int > rows_;
+  /// Elements of priced columns
+  std::vector< double > elements_;
+  /// Costs of priced columns
+  std::vector< double > objective_;
+  /// Hash of each priced column
+  std::vector< unsigned int > hash_;
+};
+
+/** Pricing for branch and price
+
+    Called by CbcModel::solveWithCuts at each node (and the root) once
+    the LP is optimal, before the bound is used.  Duals of the rows which
+    were in the continuous problem (numberRowsAtContinuous - cuts come
+    after) are in model->solver()->getRowPrice().  Columns with negative
+    reduced cost are given to model->addPricedColumn and the LP is solved
+    again until price adds no columns or maximumPasses is reached.
+
+    While a pricer is used strong branching and threads are switched off
+    as bounds of unpriced LPs would be used to fathom.  The LP must stay
+    feasible (for example with artificial columns) and cuts only used if
+    they stay valid when columns are added.
+*/
+
+class CBCLIB_EXPORT CbcPricer {
+public:
+  /// Default Constructor
+  CbcPricer();
+  /// Destructor
+  virtual ~CbcPricer();
+  /// Clone
+  virtual CbcPricer *clone() const = 0;
+  /** Prices columns at node (NULL at root) with optimal LP in solver.
+      Returns number of columns added to model */
+  virtual int price(CbcModel *model, CbcNode *node) = 0;
+  /// Maximum number of pricing passes at a node
+  inline int maximumPasses() const
+  {
+    return maximumPasses_;
+  }
+  /// Set maximum number of pricing passes at a node
+  inline void setMaximumPasses(int value)
+  {
+    maximumPasses_ = value;
+  }
+
+protected:
+  /// Maximum number of pricing passes at a node
+  int maximumPasses_;
+};
+
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
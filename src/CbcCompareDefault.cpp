@@ -29,6 +29,9 @@ CbcCompareDefault::CbcCompareDefault()
   , saveWeight_(0.0)
   , cutoff_(COIN_DBL_MAX)
   , bestPossible_(-COIN_DBL_MAX)
+  , lpCostWeight_(0.0)
+  , averageIterations_(0.0)
+  , lpCostGap_(0.0)
   , numberSolutions_(0)
   , treeSize_(0)
   , breadthDepth_(5)
@@ -46,6 +49,9 @@ CbcCompareDefault::CbcCompareDefault(double weight)
   , saveWeight_(0.0)
   , cutoff_(COIN_DBL_MAX)
   , bestPossible_(-COIN_DBL_MAX)
+  , lpCostWeight_(0.0)
+  , averageIterations_(0.0)
+  , lpCostGap_(0.0)
   , numberSolutions_(0)
   , treeSize_(0)
   , breadthDepth_(5)
@@ -65,6 +71,9 @@ CbcCompareDefault::CbcCompareDefault(const CbcCompareDefault &rhs)
   saveWeight_ = rhs.saveWeight_;
   cutoff_ = rhs.cutoff_;
   bestPossible_ = rhs.bestPossible_;
+  lpCostWeight_ = rhs.lpCostWeight_;
+  averageIterations_ = rhs.averageIterations_;
+  lpCostGap_ = rhs.lpCostGap_;
   numberSolutions_ = rhs.numberSolutions_;
   treeSize_ = rhs.treeSize_;
   breadthDepth_ = rhs.breadthDepth_;
@@ -90,6 +99,9 @@ CbcCompareDefault::operator=(const CbcCompareDefault &rhs)
     saveWeight_ = rhs.saveWeight_;
     cutoff_ = rhs.cutoff_;
     bestPossible_ = rhs.bestPossible_;
+    lpCostWeight_ = rhs.lpCostWeight_;
+    averageIterations_ = rhs.averageIterations_;
+    lpCostGap_ = rhs.lpCostGap_;
     numberSolutions_ = rhs.numberSolutions_;
     treeSize_ = rhs.treeSize_;
     breadthDepth_ = rhs.breadthDepth_;
@@ -211,12 +223,46 @@ bool CbcCompareDefault::test(CbcNode *x, CbcNode *y)
     if (y->objectiveValue() - bestPossible_ > THRESH * (cutoff_ - bestPossible_))
       testY *= 2.0; // make worse
 #endif
+    if (lpCostWeight_ > 0.0) {
+      testX += lpCostPenalty(x);
+      testY += lpCostPenalty(y);
+    }
     if (testX != testY)
       return testX > testY;
     else
       return equalityTest(x, y); // so ties will be broken in consistent manner
   }
 }
+// Amount node is made worse by cost of its LP
+double CbcCompareDefault::lpCostPenalty(const CbcNode *node) const
+{
+  if (averageIterations_ <= 0.0 || lpCostGap_ <= 0.0)
+    return 0.0;
+  // children are likely to cost about what node did
+  double ratio = node->lpIterations() / averageIterations_;
+  return lpCostWeight_ * lpCostGap_ * ratio / (ratio + 1.0);
+}
+/*
+  Gap and average are only changed here (when tree is re-sorted) so the
+  heap stays consistent between calls.
+*/
+bool CbcCompareDefault::updateLpCost(CbcModel *model)
+{
+  if (lpCostWeight_ <= 0.0)
+    return false;
+  double saveAverage = averageIterations_;
+  double saveGap = lpCostGap_;
+  averageIterations_ = model->getIterationCount()
+    / static_cast< double >(CoinMax(model->getNodeCount(), 1));
+  // internal (minimization) sense as cutoff
+  double bestPossible = model->getBestPossibleObjValue()
+    * model->solver()->getObjSense();
+  if (cutoff_ < 1.0e50 && bestPossible > -1.0e50)
+    lpCostGap_ = CoinMax(cutoff_ - bestPossible, 0.0);
+  else
+    lpCostGap_ = 0.0;
+  return averageIterations_ != saveAverage || lpCostGap_ != saveGap;
+}
 /*
   Change the weight attached to unsatisfied integer variables, unless it's
   fairly early on in the search and all solutions to date are heuristic.
@@ -233,6 +279,7 @@ bool CbcCompareDefault::newSolution(CbcModel *model,
   weight_ = 0.95 * costPerInteger;
   saveWeight_ = 0.95 * weight_;
   numberSolutions_++;
+  updateLpCost(model);
   //if (numberSolutions_>5)
   //weight_ =0.0; // this searches on objective
   return (true);
@@ -259,6 +306,7 @@ bool CbcCompareDefault::every1000Nodes(CbcModel *model, int numberNodes)
   }
   // get size of tree
   treeSize_ = model->tree()->size();
+  bool lpCostChanged = updateLpCost(model);
   if (treeSize_ > 10000) {
     int n1 = model->solver()->getNumRows() + model->solver()->getNumCols();
     int n2 = model->numberObjects();
@@ -275,7 +323,7 @@ bool CbcCompareDefault::every1000Nodes(CbcModel *model, int numberNodes)
   }
 #endif
   //return numberNodes==11000; // resort if first time
-  return (weight_ != saveWeight);
+  return (weight_ != saveWeight || lpCostChanged);
 }
 // Start dive
 void CbcCompareDefault::startDive(CbcModel *model)
@@ -331,6 +379,8 @@ void CbcCompareDefault::generateCpp(FILE *fp)
   fprintf(fp, "3  CbcCompareDefault compare;\n");
   if (weight_ != other.weight_)
     fprintf(fp, "3  compare.setWeight(%g);\n", weight_);
+  if (lpCostWeight_ != other.lpCostWeight_)
+    fprintf(fp, "3  compare.setLpCostWeight(%g);\n", lpCostWeight_);
   fprintf(fp, "3  cbcModel->setNodeComparison(compare);\n");
 }
 
@@ -94,12 +94,29 @@ public:
   {
     breadthDepth_ = value;
   }
+  /** Weight on cost of LPs (0.0 off).  After a solution a node whose LP
+      took r times the average number of iterations is treated as worse by
+      weight*gap*r/(r+1), so cheap subtrees are preferred when bounds are
+      close - more bound improvement per second than per node */
+  inline double getLpCostWeight() const
+  {
+    return lpCostWeight_;
+  }
+  inline void setLpCostWeight(double value)
+  {
+    lpCostWeight_ = value;
+  }
   /// Start dive
   void startDive(CbcModel *model);
   /// Clean up diving (i.e. switch off or prepare)
   void cleanDive();
 
 protected:
+  /// Amount node is made worse by cost of its LP
+  double lpCostPenalty(const CbcNode *node) const;
+  /// Take gap and average iterations from model - true if changed
+  bool updateLpCost(CbcModel *model);
+
   /// Weight for each infeasibility
   double weight_;
   /// Weight for each infeasibility - computed from solution
@@ -108,6 +125,12 @@ protected:
   double cutoff_;
   /// Best possible solution
   double bestPossible_;
+  /// Weight on cost of LPs
+  double lpCostWeight_;
+  /// Average iterations per node (at last check)
+  double averageIterations_;
+  /// Gap (at last check) - 0.0 if none
+  double lpCostGap_;
   /// Number of solutions
   int numberSolutions_;
   /// Tree size (at last check)
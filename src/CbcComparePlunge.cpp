@@ -0,0 +1,127 @@
+// Copyright (C) 2002, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#pragma warning(disable : 4786)
+#endif
+#include <cassert>
+#include <cstdlib>
+#include <cmath>
+#include <cfloat>
+
+#include "CbcMessage.hpp"
+#include "CbcModel.hpp"
+#include "CbcTree.hpp"
+#include "CoinError.hpp"
+#include "CbcComparePlunge.hpp"
+/** Default Constructor
+
+*/
+CbcComparePlunge::CbcComparePlunge(double fraction)
+  : CbcCompareBase()
+  , fraction_(fraction)
+  , windowTop_(-COIN_DBL_MAX)
+{
+  test_ = this;
+}
+
+// Copy constructor
+CbcComparePlunge::CbcComparePlunge(const CbcComparePlunge &rhs)
+  : CbcCompareBase(rhs)
+  , fraction_(rhs.fraction_)
+  , windowTop_(rhs.windowTop_)
+{
+}
+
+// Clone
+CbcCompareBase *
+CbcComparePlunge::clone() const
+{
+  return new CbcComparePlunge(*this);
+}
+
+// Assignment operator
+CbcComparePlunge &
+CbcComparePlunge::operator=(const CbcComparePlunge &rhs)
+{
+  if (this != &rhs) {
+    CbcCompareBase::operator=(rhs);
+    fraction_ = rhs.fraction_;
+    windowTop_ = rhs.windowTop_;
+  }
+  return *this;
+}
+
+// Destructor
+CbcComparePlunge::~CbcComparePlunge()
+{
+}
+
+// Returns true if y better than x
+bool CbcComparePlunge::test(CbcNode *x, CbcNode *y)
+{
+  double testX = x->objectiveValue();
+  double testY = y->objectiveValue();
+  bool plungeX = testX <= windowTop_;
+  bool plungeY = testY <= windowTop_;
+  if (plungeX != plungeY)
+    return plungeY;
+  if (plungeX) {
+    // newest first
+    if (x->nodeNumber() != y->nodeNumber())
+      return y->nodeNumber() > x->nodeNumber();
+  } else if (testX != testY) {
+    return testX > testY;
+  }
+  return equalityTest(x, y); // so ties will be broken in consistent manner
+}
+
+// Work out window - returns true if changed
+bool CbcComparePlunge::setWindow(CbcModel *model)
+{
+  double saveTop = windowTop_;
+  CbcTree *tree = model->tree();
+  if (tree && !tree->empty()) {
+    double bestPossible = tree->getBestPossibleObjective();
+    double cutoff = model->getCutoff();
+    if (bestPossible >= 1.0e50) {
+      windowTop_ = -COIN_DBL_MAX;
+    } else if (cutoff < 1.0e50) {
+      windowTop_ = bestPossible + fraction_ * CoinMax(cutoff - bestPossible, 0.0);
+    } else {
+      windowTop_ = bestPossible + fraction_ * (fabs(bestPossible) + 1.0);
+    }
+  }
+  return windowTop_ != saveTop;
+}
+
+// Refresh window after a solution
+bool CbcComparePlunge::newSolution(CbcModel *model,
+  double,
+  int)
+{
+  return setWindow(model);
+}
+
+// Refresh window - returns true if tree needs resorting
+bool CbcComparePlunge::every1000Nodes(CbcModel *model, int)
+{
+  return setWindow(model);
+}
+
+// Create C++ lines to get to current state
+void CbcComparePlunge::generateCpp(FILE *fp)
+{
+  CbcComparePlunge other;
+  fprintf(fp, "0#include \"CbcComparePlunge.hpp\"\n");
+  if (fraction_ != other.fraction_)
+    fprintf(fp, "3  CbcComparePlunge compare(%g);\n", fraction_);
+  else
+    fprintf(fp, "3  CbcComparePlunge compare;\n");
+  fprintf(fp, "3  cbcModel->setNodeComparison(compare);\n");
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -0,0 +1,90 @@
+// Copyright (C) 2002, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcComparePlunge_H
+#define CbcComparePlunge_H
+
+//#############################################################################
+/*  These are alternative strategies for node traversal.
+    They can take data etc for fine tuning
+
+    At present the node list is stored as a heap and the "test"
+    comparison function returns true if node y is better than node x.
+
+*/
+#include "CbcNode.hpp"
+#include "CbcCompareBase.hpp"
+#include "CbcCompare.hpp"
+class CbcModel;
+
+/* Best bound with plunging.
+
+   Nodes whose objective is within a window above the best bound on the
+   tree are taken newest first, so the search keeps diving into the
+   children of the node just solved (and the solver basis stays close)
+   for as long as they stay in the window.  Nodes outside the window are
+   taken best bound first.
+
+   The window is fraction * (cutoff - best bound) once there is a
+   solution and fraction * (fabs(best bound) + 1.0) before.  The bound is
+   refreshed in every1000Nodes and after each solution.
+*/
+class CBCLIB_EXPORT CbcComparePlunge : public CbcCompareBase {
+public:
+  /// Default Constructor
+  CbcComparePlunge(double fraction = 0.05);
+  ~CbcComparePlunge();
+  /// Copy constructor
+  CbcComparePlunge(const CbcComparePlunge &rhs);
+
+  /// Assignment operator
+  CbcComparePlunge &operator=(const CbcComparePlunge &rhs);
+
+  /// Clone
+  virtual CbcCompareBase *clone() const;
+  /// Create C++ lines to get to current state
+  virtual void generateCpp(FILE *fp);
+
+  /// Returns true if y better than x
+  virtual bool test(CbcNode *x, CbcNode *y);
+
+  using CbcCompareBase::newSolution;
+  /// Refresh window after a solution
+  virtual bool newSolution(CbcModel *model,
+    double objectiveAtContinuous,
+    int numberInfeasibilitiesAtContinuous);
+  /// Refresh window - returns true if tree needs resorting
+  virtual bool every1000Nodes(CbcModel *model, int numberNodes);
+
+  /// Set fraction of gap used as plunging window
+  inline void setFraction(double value)
+  {
+    fraction_ = value;
+  }
+  /// Get fraction of gap used as plunging window
+  inline double fraction() const
+  {
+    return fraction_;
+  }
+  /// Nodes with objective at or below this are plunged on
+  inline double windowTop() const
+  {
+    return windowTop_;
+  }
+
+protected:
+  /// Work out window from model
+  bool setWindow(CbcModel *model);
+
+protected:
+  /// Fraction of gap used as plunging window
+  double fraction_;
+  /// Top of window
+  double windowTop_;
+};
+
+#endif //CbcComparePlunge_H
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -0,0 +1,245 @@
+// Copyright (C) 2002, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#pragma warning(disable : 4786)
+#endif
+
+#include "CbcConfig.h"
+
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+#include "CoinError.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinPackedMatrix.hpp"
+#include "CoinSort.hpp"
+#include "OsiSolverInterface.hpp"
+#include "OsiRowCut.hpp"
+#include "CbcCountRowCut.hpp"
+#include "CbcConflictAnalysis.hpp"
+
+// Default Constructor
+CbcConflictAnalysis::CbcConflictAnalysis()
+  : aggregate_(NULL)
+  , change_(NULL)
+  , which_(NULL)
+  , numberColumns_(0)
+  , maximumAge_(2000)
+  , maximumSize_(50)
+  , numberConflicts_(0)
+  , numberAged_(0)
+{
+}
+
+// Destructor
+CbcConflictAnalysis::~CbcConflictAnalysis()
+{
+  delete[] aggregate_;
+  delete[] change_;
+  delete[] which_;
+}
+
+/*
+  Aggregate rows with ray (ray or -ray, as sign convention of solver
+  is not known) and see if maximum activity within local bounds is below
+  rhs.  If so relax bound changes back to global values - ones which can
+  not go in conflict first and then smallest contribution first.
+*/
+OsiRowCut *CbcConflictAnalysis::analyze(const OsiSolverInterface *solver,
+  const double *lower, const double *upper, int numberRows)
+{
+  std::vector< double * > rays;
+  try {
+    rays = solver->getDualRays(1, false);
+  } catch (CoinError &e) {
+    return NULL;
+  }
+  if (rays.empty() || !rays[0]) {
+    for (unsigned int i = 0; i < rays.size(); i++)
+      delete[] rays[i];
+    return NULL;
+  }
+  const double *ray = rays[0];
+  int numberColumns = solver->getNumCols();
+  numberRows = CoinMin(numberRows, solver->getNumRows());
+  if (numberColumns > numberColumns_) {
+    delete[] aggregate_;
+    delete[] change_;
+    delete[] which_;
+    aggregate_ = new double[numberColumns];
+    change_ = new double[numberColumns];
+    which_ = new int[numberColumns];
+    numberColumns_ = numberColumns;
+  }
+  const double *rowLower = solver->getRowLower();
+  const double *rowUpper = solver->getRowUpper();
+  const double *localLower = solver->getColLower();
+  const double *localUpper = solver->getColUpper();
+  const CoinPackedMatrix *rowCopy = solver->getMatrixByRow();
+  const double *elementByRow = rowCopy->getElements();
+  const int *column = rowCopy->getIndices();
+  const CoinBigIndex *rowStart = rowCopy->getVectorStarts();
+  const int *rowLength = rowCopy->getVectorLengths();
+  double largest = 0.0;
+  for (int iRow = 0; iRow < numberRows; iRow++)
+    largest = CoinMax(largest, fabs(ray[iRow]));
+  OsiRowCut *conflict = NULL;
+  for (int iTry = 0; iTry < 2 && !conflict && largest > 0.0; iTry++) {
+    double sign = iTry ? -1.0 : 1.0;
+    double tolerance = 1.0e-12 * largest;
+    // aggregated row must be >= rhs
+    double rhs = 0.0;
+    bool bad = false;
+    CoinZeroN(aggregate_, numberColumns);
+    for (int iRow = 0; iRow < numberRows; iRow++) {
+      double value = sign * ray[iRow];
+      if (fabs(value) <= tolerance)
+        continue;
+      if (value > 0.0) {
+        if (rowLower[iRow] < -1.0e20) {
+          bad = true;
+          break;
+        }
+        rhs += value * rowLower[iRow];
+      } else {
+        if (rowUpper[iRow] > 1.0e20) {
+          bad = true;
+          break;
+        }
+        rhs += value * rowUpper[iRow];
+      }
+      for (CoinBigIndex j = rowStart[iRow]; j < rowStart[iRow] + rowLength[iRow]; j++)
+        aggregate_[column[j]] += value * elementByRow[j];
+    }
+    if (bad)
+      continue;
+    // maximum activity within local bounds and changes from global
+    double maximumActivity = 0.0;
+    int numberChanged = 0;
+    for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+      double value = aggregate_[iColumn];
+      if (fabs(value) < 1.0e-12)
+        continue;
+      double bound = (value > 0.0) ? localUpper[iColumn] : localLower[iColumn];
+      if (fabs(bound) > 1.0e20) {
+        bad = true;
+        break;
+      }
+      maximumActivity += value * bound;
+      double globalBound = (value > 0.0) ? upper[iColumn] : lower[iColumn];
+      if (globalBound != bound) {
+        change_[numberChanged] = (fabs(globalBound) < 1.0e20) ? fabs(value * (globalBound - bound)) : COIN_DBL_MAX;
+        which_[numberChanged++] = iColumn;
+      }
+    }
+    if (bad)
+      continue;
+    double slack = rhs - maximumActivity - 1.0e-6 * (1.0 + fabs(rhs));
+    if (slack <= 0.0)
+      continue; // ray does not prove infeasibility
+    // relax changes which can not go in conflict
+    int numberInConflict = 0;
+    for (int i = 0; i < numberChanged; i++) {
+      int iColumn = which_[i];
+      double value = aggregate_[iColumn];
+      bool fixedAtGlobal;
+      if (value > 0.0)
+        fixedAtGlobal = (localUpper[iColumn] == lower[iColumn]);
+      else
+        fixedAtGlobal = (localLower[iColumn] == upper[iColumn]);
+      if (fixedAtGlobal && solver->isInteger(iColumn)) {
+        change_[numberInConflict] = change_[i];
+        which_[numberInConflict++] = iColumn;
+      } else {
+        slack -= change_[i];
+        if (slack <= 0.0) {
+          bad = true;
+          break;
+        }
+      }
+    }
+    if (bad || !numberInConflict)
+      continue;
+    // relax smallest contributions while proof holds
+    CoinSort_2(change_, change_ + numberInConflict, which_);
+    int first = 0;
+    while (first < numberInConflict && change_[first] < slack) {
+      slack -= change_[first];
+      first++;
+    }
+    int numberElements = numberInConflict - first;
+    if (!numberElements || numberElements > maximumSize_)
+      continue;
+    // sum (x - lower) over fixed at lower + sum (upper - x) over fixed at upper >= 1
+    double *element = change_ + first;
+    int *index = which_ + first;
+    double lo = 1.0;
+    for (int i = 0; i < numberElements; i++) {
+      int iColumn = index[i];
+      if (aggregate_[iColumn] > 0.0) {
+        element[i] = 1.0;
+        lo += lower[iColumn];
+      } else {
+        element[i] = -1.0;
+        lo -= upper[iColumn];
+      }
+    }
+    CoinSort_2(index, index + numberElements, element);
+    conflict = new OsiRowCut();
+    conflict->setLb(lo);
+    conflict->setUb(COIN_DBL_MAX);
+    conflict->setRow(numberElements, index, element, false);
+    conflict->setGloballyValid(true);
+    numberConflicts_++;
+  }
+  for (unsigned int i = 0; i < rays.size(); i++)
+    delete[] rays[i];
+  return conflict;
+}
+
+// Note conflict cut now in global cuts
+void CbcConflictAnalysis::added(const OsiRowCut *cut, int nodeNumber)
+{
+  lastUsed_[cut] = nodeNumber;
+}
+
+// Say conflict cut was violated at node
+void CbcConflictAnalysis::used(const OsiRowCut *cut, int nodeNumber)
+{
+  std::map< const OsiRowCut *, int >::iterator found = lastUsed_.find(cut);
+  if (found != lastUsed_.end())
+    found->second = nodeNumber;
+}
+
+/* Remove conflict cuts not violated for maximumAge nodes.
+   Cuts may have gone from global cuts in other ways so map is rebuilt
+   from cuts still there. */
+int CbcConflictAnalysis::age(CbcRowCuts &cuts, int nodeNumber)
+{
+  int numberCuts = cuts.sizeRowCuts();
+  std::map< const OsiRowCut *, int > stillThere;
+  int *which = new int[numberCuts + 1];
+  int numberToErase = 0;
+  for (int i = 0; i < numberCuts; i++) {
+    const OsiRowCut2 *cut = cuts.cut(i);
+    std::map< const OsiRowCut *, int >::iterator found = lastUsed_.find(cut);
+    if (found == lastUsed_.end() || cut->whichRow() != 1)
+      continue;
+    if (nodeNumber - found->second > maximumAge_)
+      which[numberToErase++] = i;
+    else
+      stillThere[cut] = found->second;
+  }
+  lastUsed_.swap(stillThere);
+  cuts.eraseRowCuts(numberToErase, which);
+  delete[] which;
+  numberAged_ += numberToErase;
+  return numberToErase;
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
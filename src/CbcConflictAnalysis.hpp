@@ -0,0 +1,120 @@
+// Copyright (C) 2002, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcConflictAnalysis_H
+#define CbcConflictAnalysis_H
+
+#include <map>
+
+#include "CbcConfig.h"
+
+class OsiSolverInterface;
+class OsiRowCut;
+class CbcRowCuts;
+
+/** Conflict analysis from Farkas rays of infeasible subproblems
+
+    When a node (or a strong branching child) is infeasible the dual ray
+    gives a combination of the original rows, (z'A)x >= rhs, which can
+    not be satisfied within the bounds at the node.  Bound changes from
+    the global bounds which reduce the maximum activity least are relaxed
+    back to their global values as long as the proof still holds; the rest
+    must not all hold in any solution.  If all of them are integers fixed
+    at a global bound this gives the conflict constraint
+
+      sum (x_j - globalLower_j) + sum (globalUpper_j - x_j) >= 1
+
+    over columns fixed at lower and upper bound.  Infeasibility which needs
+    any other bound change (continuous or general integer tightened
+    part way) gives no conflict.  Only rows of the continuous model are
+    used as cuts may only be valid locally.
+
+    Conflicts are put in CbcModel's global cuts (type 1) and removed again
+    if they have not been violated in the global cut scan for maximumAge
+    nodes.  Used if CbcModel::moreSpecialOptions has 4194304 set.
+*/
+class CBCLIB_EXPORT CbcConflictAnalysis {
+
+public:
+  /// Default Constructor
+  CbcConflictAnalysis();
+  /// Destructor
+  ~CbcConflictAnalysis();
+
+  /** Get conflict from ray of infeasible solver.  Bounds in solver are
+      those of subproblem, \p lower and \p upper are global bounds and only
+      the first \p numberRows rows are used.  Returns conflict cut (caller
+      owns) or NULL.
+    */
+  OsiRowCut *analyze(const OsiSolverInterface *solver,
+    const double *lower, const double *upper, int numberRows);
+  /// Note conflict cut now in global cuts
+  void added(const OsiRowCut *cut, int nodeNumber);
+  /// Say conflict cut was violated at node
+  void used(const OsiRowCut *cut, int nodeNumber);
+  /** Remove conflict cuts not violated for maximumAge nodes from \p cuts.
+      Returns number removed */
+  int age(CbcRowCuts &cuts, int nodeNumber);
+
+  /// Maximum nodes a conflict can stay without being used
+  inline int maximumAge() const
+  {
+    return maximumAge_;
+  }
+  /// Set maximum nodes a conflict can stay without being used
+  inline void setMaximumAge(int value)
+  {
+    maximumAge_ = value;
+  }
+  /// Maximum number of columns in a conflict
+  inline int maximumSize() const
+  {
+    return maximumSize_;
+  }
+  /// Set maximum number of columns in a conflict
+  inline void setMaximumSize(int value)
+  {
+    maximumSize_ = value;
+  }
+  /// Number of conflicts found
+  inline int numberConflicts() const
+  {
+    return numberConflicts_;
+  }
+  /// Number of conflicts removed by aging
+  inline int numberAged() const
+  {
+    return numberAged_;
+  }
+
+private:
+  /// Illegal copy constructor
+  CbcConflictAnalysis(const CbcConflictAnalysis &);
+  /// Illegal assignment operator
+  CbcConflictAnalysis &operator=(const CbcConflictAnalysis &);
+
+  /// Node at which each conflict cut in global cuts was last used
+  std::map< const OsiRowCut *, int > lastUsed_;
+  /// Work - aggregated row
+  double *aggregate_;
+  /// Work - contributions of bound changes
+  double *change_;
+  /// Work - columns with bound changes
+  int *which_;
+  /// Size of work arrays
+  int numberColumns_;
+  /// Maximum nodes a conflict can stay without being used
+  int maximumAge_;
+  /// Maximum number of columns in a conflict
+  int maximumSize_;
+  /// Number of conflicts found
+  int numberConflicts_;
+  /// Number of conflicts removed by aging
+  int numberAged_;
+};
+
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
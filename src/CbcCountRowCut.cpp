@@ -7,7 +7,11 @@
 #pragma warning(disable : 4786)
 #endif
 #include <cassert>
+#include <cmath>
+#include <cstring>
 
+#include "CoinHelperFunctions.hpp"
+#include "CoinSort.hpp"
 #include "OsiRowCut.hpp"
 #include "CbcModel.hpp"
 #include "CbcCountRowCut.hpp"
@@ -20,6 +24,7 @@ CbcCountRowCut::CbcCountRowCut()
   , ownerCut_(-1)
   , numberPointingToThis_(0)
   , whichCutGenerator_(-1)
+  , numberSlack_(0)
 {
 #ifdef CHECK_CUT_COUNTS
   printf("CbcCountRowCut default constructor %x\n", this);
@@ -33,6 +38,7 @@ CbcCountRowCut::CbcCountRowCut(const OsiRowCut &rhs)
   , ownerCut_(-1)
   , numberPointingToThis_(0)
   , whichCutGenerator_(-1)
+  , numberSlack_(0)
 {
 #ifdef CHECK_CUT_COUNTS
   printf("CbcCountRowCut constructor %x from RowCut\n", this);
@@ -48,6 +54,7 @@ CbcCountRowCut::CbcCountRowCut(const OsiRowCut &rhs,
   , ownerCut_(whichOne)
   , numberPointingToThis_(numberPointingToThis)
   , whichCutGenerator_(whichGenerator)
+  , numberSlack_(0)
 {
 #ifdef CHECK_CUT_COUNTS
   printf("CbcCountRowCut constructor %x from RowCut and info %d\n",
@@ -106,11 +113,22 @@ bool CbcCountRowCut::canDropCut(const OsiSolverInterface *solver, int iRow) cons
   } else if (effectiveness() != COIN_DBL_MAX) {
     if (iRow >= solver->getNumRows())
       return true;
-    const double *rowActivity = solver->getRowActivity();
-    const double *rowLower = solver->getRowLower();
-    const double *rowUpper = solver->getRowUpper();
     double tolerance;
     solver->getDblParam(OsiPrimalTolerance, tolerance);
+    return canDropCut(solver->getRowActivity(), solver->getRowLower(),
+      solver->getRowUpper(), tolerance, iRow);
+  } else {
+    return false;
+  }
+}
+// Same with arrays from solver passed in
+bool CbcCountRowCut::canDropCut(const double *rowActivity, const double *rowLower,
+  const double *rowUpper, double tolerance, int iRow) const
+{
+  // keep if COIN_DBL_MAX otherwise keep if slack zero
+  if (effectiveness() < 1.0e20) {
+    return true;
+  } else if (effectiveness() != COIN_DBL_MAX) {
     double value = rowActivity[iRow];
     if (value < rowLower[iRow] + tolerance || value > rowUpper[iRow] - tolerance)
       return false;
@@ -258,15 +276,26 @@ CbcRowCuts::CbcRowCuts(int initialMaxSize, int hashMultiplier)
   if (size_) {
     rowCut_ = new OsiRowCut2 *[size_];
     hash_ = new CoinHashLink[hashSize];
+    lastActive_ = new int[size_];
   } else {
     rowCut_ = NULL;
     hash_ = NULL;
+    lastActive_ = NULL;
   }
   for (int i = 0; i < hashSize; i++) {
     hash_[i].index = -1;
     hash_[i].next = -1;
   }
   lastHash_ = -1;
+  storeStart_ = NULL;
+  storeIndex_ = NULL;
+  storeElement_ = NULL;
+  storeNormInverse_ = NULL;
+  numberStored_ = 0;
+  maximumStored_ = 0;
+  maximumStoredElements_ = 0;
+  clock_ = 0;
+  numberEvicted_ = 0;
 }
 CbcRowCuts::~CbcRowCuts()
 {
@@ -274,9 +303,23 @@ CbcRowCuts::~CbcRowCuts()
     delete rowCut_[i];
   delete[] rowCut_;
   delete[] hash_;
+  delete[] storeStart_;
+  delete[] storeIndex_;
+  delete[] storeElement_;
+  delete[] storeNormInverse_;
+  delete[] lastActive_;
 }
 CbcRowCuts::CbcRowCuts(const CbcRowCuts &rhs)
 {
+  storeStart_ = NULL;
+  storeIndex_ = NULL;
+  storeElement_ = NULL;
+  storeNormInverse_ = NULL;
+  numberStored_ = 0;
+  maximumStored_ = 0;
+  maximumStoredElements_ = 0;
+  clock_ = rhs.clock_;
+  numberEvicted_ = rhs.numberEvicted_;
   numberCuts_ = rhs.numberCuts_;
   hashMultiplier_ = rhs.hashMultiplier_;
   size_ = rhs.size_;
@@ -294,9 +337,11 @@ CbcRowCuts::CbcRowCuts(const CbcRowCuts &rhs)
       else
         rowCut_[i] = NULL;
     }
+    lastActive_ = CoinCopyOfArrayPartial(rhs.lastActive_, size_, numberCuts_);
   } else {
     rowCut_ = NULL;
     hash_ = NULL;
+    lastActive_ = NULL;
   }
 }
 CbcRowCuts &
@@ -307,6 +352,11 @@ CbcRowCuts::operator=(const CbcRowCuts &rhs)
       delete rowCut_[i];
     delete[] rowCut_;
     delete[] hash_;
+    delete[] lastActive_;
+    // row copy rebuilt when wanted
+    numberStored_ = 0;
+    clock_ = rhs.clock_;
+    numberEvicted_ = rhs.numberEvicted_;
     numberCuts_ = rhs.numberCuts_;
     hashMultiplier_ = rhs.hashMultiplier_;
     size_ = rhs.size_;
@@ -324,9 +374,11 @@ CbcRowCuts::operator=(const CbcRowCuts &rhs)
         else
           rowCut_[i] = NULL;
       }
+      lastActive_ = CoinCopyOfArrayPartial(rhs.lastActive_, size_, numberCuts_);
     } else {
       rowCut_ = NULL;
       hash_ = NULL;
+      lastActive_ = NULL;
     }
   }
   return *this;
@@ -380,6 +432,7 @@ void CbcRowCuts::eraseRowCut(int sequence)
         // change
         hash_[ipos].index = found;
         rowCut_[found] = rowCut_[numberCuts_];
+        lastActive_[found] = lastActive_[numberCuts_];
         rowCut_[numberCuts_] = NULL;
         break;
       }
@@ -388,6 +441,74 @@ void CbcRowCuts::eraseRowCut(int sequence)
   delete cut;
   rowCut_[numberCuts_] = NULL;
   //assert (!rowCut_[numberCuts_-1]);
+  numberStored_ = 0;
+}
+// Replace cut in place
+void CbcRowCuts::replaceRowCut(int sequence, const OsiRowCut &cut)
+{
+  assert(sequence >= 0 && sequence < numberCuts_);
+  OsiRowCut2 *rowCut = rowCut_[sequence];
+  CoinPackedVector vector = cut.row();
+  int numberElements = vector.getNumElements();
+  CoinSort_2(vector.getIndices(), vector.getIndices() + numberElements,
+    vector.getElements());
+  rowCut->setLb(cut.lb());
+  rowCut->setUb(cut.ub());
+  rowCut->setRow(vector);
+  rowCut->setGloballyValid(cut.globallyValid());
+  lastActive_[sequence] = clock_;
+  // row copy is only good before this cut
+  if (numberStored_ > sequence)
+    numberStored_ = sequence;
+  rebuildHash();
+}
+// Rebuild hash table from all cuts
+void CbcRowCuts::rebuildHash()
+{
+  int hashSize = size_ * hashMultiplier_;
+  for (int i = 0; i < hashSize; i++) {
+    hash_[i].index = -1;
+    hash_[i].next = -1;
+  }
+  lastHash_ = -1;
+  for (int i = 0; i < numberCuts_; i++) {
+    int ipos = hashCut(*rowCut_[i], hashSize);
+    int jpos = ipos;
+    bool found = false;
+    while (true) {
+      int j1 = hash_[ipos].index;
+      if (j1 >= 0) {
+        if (!same(*rowCut_[i], *rowCut_[j1])) {
+          int k = hash_[ipos].next;
+          if (k != -1)
+            ipos = k;
+          else
+            break;
+        } else {
+          found = true;
+          break;
+        }
+      } else {
+        break;
+      }
+    }
+    if (!found) {
+      if (ipos == jpos && hash_[ipos].index < 0) {
+        // first
+        hash_[ipos].index = i;
+      } else {
+        // find next space
+        while (true) {
+          ++lastHash_;
+          assert(lastHash_ < hashSize);
+          if (hash_[lastHash_].index == -1)
+            break;
+        }
+        hash_[ipos].next = lastHash_;
+        hash_[lastHash_].index = i;
+      }
+    }
+  }
 }
 // Truncate
 void CbcRowCuts::truncate(int numberAfter)
@@ -399,6 +520,7 @@ void CbcRowCuts::truncate(int numberAfter)
     rowCut_[i] = NULL;
   }
   numberCuts_ = numberAfter;
+  numberStored_ = CoinMin(numberStored_, numberAfter);
   int hashSize = size_ * hashMultiplier_;
   for (int i = 0; i < hashSize; i++) {
     hash_[i].index = -1;
@@ -449,6 +571,38 @@ void CbcRowCuts::truncate(int numberAfter)
   delete[] rowCut_;
   rowCut_ = temp;
 }
+// Erase cuts in which (any order) and keep order of rest
+void CbcRowCuts::eraseRowCuts(int numberToErase, const int *which)
+{
+  if (numberToErase <= 0 || !numberCuts_)
+    return;
+  char *erase = new char[numberCuts_];
+  memset(erase, 0, numberCuts_);
+  for (int i = 0; i < numberToErase; i++) {
+    assert(which[i] >= 0 && which[i] < numberCuts_);
+    erase[which[i]] = 1;
+  }
+  // kept cuts first then ones to go - truncate deletes those and rebuilds hash
+  OsiRowCut2 **temp = new OsiRowCut2 *[numberCuts_];
+  int nKeep = 0;
+  for (int i = 0; i < numberCuts_; i++) {
+    if (!erase[i]) {
+      lastActive_[nKeep] = lastActive_[i];
+      temp[nKeep++] = rowCut_[i];
+    }
+  }
+  int n = nKeep;
+  for (int i = 0; i < numberCuts_; i++) {
+    if (erase[i])
+      temp[n++] = rowCut_[i];
+  }
+  for (int i = 0; i < numberCuts_; i++)
+    rowCut_[i] = temp[i];
+  delete[] temp;
+  delete[] erase;
+  numberStored_ = 0;
+  truncate(nKeep);
+}
 // Return 0 if added, 1 if not, -1 if not added because of space
 int CbcRowCuts::addCutIfNotDuplicate(const OsiRowCut &cut, int whichType)
 {
@@ -457,6 +611,10 @@ int CbcRowCuts::addCutIfNotDuplicate(const OsiRowCut &cut, int whichType)
   if (numberCuts_ == size_) {
     size_ = 2 * size_ + 100;
     hashSize = hashMultiplier_ * size_;
+    int *lastActive = new int[size_];
+    CoinMemcpyN(lastActive_, numberCuts_, lastActive);
+    delete[] lastActive_;
+    lastActive_ = lastActive;
     OsiRowCut2 **temp = new OsiRowCut2 *[size_];
     delete[] hash_;
     hash_ = new CoinHashLink[hashSize];
@@ -572,6 +730,7 @@ int CbcRowCuts::addCutIfNotDuplicate(const OsiRowCut &cut, int whichType)
       newCutPtr->setUb(newUb);
       newCutPtr->setRow(vector);
       newCutPtr->setGloballyValid(globallyValid);
+      lastActive_[numberCuts_] = clock_;
       rowCut_[numberCuts_++] = newCutPtr;
       //printf("addedGlobalCut of size %d to %x - cuts size %d\n",
       //     cut.row().getNumElements(),this,numberCuts_);
@@ -590,6 +749,10 @@ int CbcRowCuts::addCutIfNotDuplicateWhenGreedy(const OsiRowCut &cut, int whichTy
   if (numberCuts_ == size_) {
     size_ = 2 * size_ + 100;
     hashSize = hashMultiplier_ * size_;
+    int *lastActive = new int[size_];
+    CoinMemcpyN(lastActive_, numberCuts_, lastActive);
+    delete[] lastActive_;
+    lastActive_ = lastActive;
     OsiRowCut2 **temp = new OsiRowCut2 *[size_];
     delete[] hash_;
     hash_ = new CoinHashLink[hashSize];
@@ -704,6 +867,7 @@ int CbcRowCuts::addCutIfNotDuplicateWhenGreedy(const OsiRowCut &cut, int whichTy
       newCutPtr->setLb(newLb);
       newCutPtr->setUb(newUb);
       newCutPtr->setRow(vector);
+      lastActive_[numberCuts_] = clock_;
       rowCut_[numberCuts_++] = newCutPtr;
       //printf("addedGreedyGlobalCut of size %d to %p - cuts size %d\n",
       //     cut.row().getNumElements(),this,numberCuts_);
@@ -724,6 +888,129 @@ void CbcRowCuts::addCuts(OsiCuts &cs)
     rowCut_[i] = NULL;
   }
   numberCuts_ = 0;
+  numberStored_ = 0;
+}
+// Append cuts not in row copy
+void CbcRowCuts::updateStore()
+{
+  if (numberStored_ == numberCuts_)
+    return;
+  if (numberCuts_ > maximumStored_) {
+    int newMaximum = CoinMax(2 * maximumStored_, numberCuts_ + 100);
+    CoinBigIndex *start = new CoinBigIndex[newMaximum + 1];
+    double *normInverse = new double[newMaximum];
+    if (numberStored_) {
+      CoinMemcpyN(storeStart_, numberStored_ + 1, start);
+      CoinMemcpyN(storeNormInverse_, numberStored_, normInverse);
+    } else {
+      start[0] = 0;
+    }
+    delete[] storeStart_;
+    delete[] storeNormInverse_;
+    storeStart_ = start;
+    storeNormInverse_ = normInverse;
+    maximumStored_ = newMaximum;
+  }
+  if (!numberStored_)
+    storeStart_[0] = 0;
+  CoinBigIndex numberElements = storeStart_[numberStored_];
+  for (int i = numberStored_; i < numberCuts_; i++)
+    numberElements += rowCut_[i]->row().getNumElements();
+  if (numberElements > maximumStoredElements_) {
+    CoinBigIndex newMaximum = CoinMax(2 * maximumStoredElements_, numberElements + 1000);
+    int *index = new int[newMaximum];
+    double *element = new double[newMaximum];
+    CoinMemcpyN(storeIndex_, storeStart_[numberStored_], index);
+    CoinMemcpyN(storeElement_, storeStart_[numberStored_], element);
+    delete[] storeIndex_;
+    delete[] storeElement_;
+    storeIndex_ = index;
+    storeElement_ = element;
+    maximumStoredElements_ = newMaximum;
+  }
+  numberElements = storeStart_[numberStored_];
+  for (int i = numberStored_; i < numberCuts_; i++) {
+    const CoinPackedVector &row = rowCut_[i]->row();
+    int n = row.getNumElements();
+    const int *column = row.getIndices();
+    const double *element = row.getElements();
+    double norm = 0.0;
+    for (int j = 0; j < n; j++) {
+      storeIndex_[numberElements + j] = column[j];
+      storeElement_[numberElements + j] = element[j];
+      norm += element[j] * element[j];
+    }
+    numberElements += n;
+    storeStart_[i + 1] = numberElements;
+    storeNormInverse_[i] = (norm > 0.0) ? 1.0 / sqrt(norm) : 0.0;
+  }
+  numberStored_ = numberCuts_;
+}
+// Cuts violated by solution
+int CbcRowCuts::violatedCuts(const double *solution, double tolerance,
+  int *which, double *violation, double *efficacy)
+{
+  updateStore();
+  int numberViolated = 0;
+  for (int i = 0; i < numberCuts_; i++) {
+    double sum = 0.0;
+    for (CoinBigIndex j = storeStart_[i]; j < storeStart_[i + 1]; j++)
+      sum += storeElement_[j] * solution[storeIndex_[j]];
+    const OsiRowCut2 *cut = rowCut_[i];
+    double value = CoinMax(cut->lb() - sum, sum - cut->ub());
+    if (value > -1.0e-7)
+      lastActive_[i] = clock_; // tight or violated
+    if (value > tolerance || cut->effectiveness() == COIN_DBL_MAX) {
+      which[numberViolated] = i;
+      violation[numberViolated] = value;
+      efficacy[numberViolated++] = value * storeNormInverse_[i];
+    }
+  }
+  return numberViolated;
+}
+// Estimated bytes used by cuts
+double CbcRowCuts::bytes() const
+{
+  double sum = 0.0;
+  for (int i = 0; i < numberCuts_; i++)
+    sum += sizeof(OsiRowCut2) + rowCut_[i]->row().getNumElements() * (sizeof(double) + sizeof(int));
+  return sum;
+}
+/* Evict least recently active cuts until at most 90% of limits.
+   Cuts with effectiveness COIN_DBL_MAX and ones active in last
+   minimumAge ticks of clock stay. */
+int CbcRowCuts::evict(int maximumCuts, double maximumBytes, int minimumAge)
+{
+  double totalBytes = (maximumBytes > 0.0) ? bytes() : 0.0;
+  bool tooMany = (maximumCuts > 0 && numberCuts_ > maximumCuts);
+  bool tooBig = (maximumBytes > 0.0 && totalBytes > maximumBytes);
+  if (!tooMany && !tooBig)
+    return 0;
+  int targetCuts = tooMany ? (9 * maximumCuts) / 10 : numberCuts_;
+  double targetBytes = tooBig ? 0.9 * maximumBytes : COIN_DBL_MAX;
+  int *which = new int[numberCuts_];
+  int *age = new int[numberCuts_];
+  int numberCandidates = 0;
+  for (int i = 0; i < numberCuts_; i++) {
+    if (rowCut_[i]->effectiveness() == COIN_DBL_MAX || clock_ - lastActive_[i] < minimumAge)
+      continue;
+    age[numberCandidates] = lastActive_[i];
+    which[numberCandidates++] = i;
+  }
+  // oldest first
+  CoinSort_2(age, age + numberCandidates, which);
+  int numberLeft = numberCuts_;
+  int numberToErase = 0;
+  while (numberToErase < numberCandidates && (numberLeft > targetCuts || totalBytes > targetBytes)) {
+    const OsiRowCut2 *cut = rowCut_[which[numberToErase++]];
+    numberLeft--;
+    totalBytes -= sizeof(OsiRowCut2) + cut->row().getNumElements() * (sizeof(double) + sizeof(int));
+  }
+  eraseRowCuts(numberToErase, which);
+  delete[] which;
+  delete[] age;
+  numberEvicted_ += numberToErase;
+  return numberToErase;
 }
 
 /* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
@@ -84,8 +84,24 @@ public:
     return whichCutGenerator_;
   }
 
+  /// Number of nodes running cut has had basic slack (CbcSlackCutNodes)
+  inline int numberSlack() const
+  {
+    return numberSlack_;
+  }
+  /// Set number of nodes running cut has had basic slack
+  inline void setNumberSlack(int value)
+  {
+    numberSlack_ = value;
+  }
+
   /// Returns true if can drop cut if slack basic
   bool canDropCut(const OsiSolverInterface *solver, int row) const;
+  /** Same but with row activities, row bounds and primal tolerance of
+      last solve passed in so a loop over all cuts only gets them once.
+      Row must be in solver. */
+  bool canDropCut(const double *rowActivity, const double *rowLower,
+    const double *rowUpper, double tolerance, int row) const;
 
 #ifdef CHECK_CUT_COUNTS
   // Just for printing sanity checks
@@ -116,6 +132,9 @@ private:
         -3 unknown
     */
   int whichCutGenerator_;
+
+  /// Number of nodes running cut has had basic slack
+  int numberSlack_;
 };
 /**
    Really for Conflict cuts to -
@@ -153,6 +172,9 @@ public:
     return rowCut_[sequence];
   }
   void eraseRowCut(int sequence);
+  /** Replace cut in place (keeps sequence).  Used when row or bounds of
+      a cut change - changing a cut directly would leave hash wrong */
+  void replaceRowCut(int sequence, const OsiRowCut &cut);
   // Return 0 if added, 1 if not, -1 if not added because of space
   int addCutIfNotDuplicate(const OsiRowCut &cut, int whichType = 0);
   // Return 0 if added, 1 if not, -1 if not added because of space
@@ -161,6 +183,46 @@ public:
   void addCuts(OsiCuts &cs);
   // Truncate
   void truncate(int numberAfter);
+  // Erase cuts in which (any order) and keep order of rest
+  void eraseRowCuts(int numberToErase, const int *which);
+  /** Cuts violated by more than tolerance by solution (in one pass
+      over a row copy of all cuts).  which gets cut sequence, violation
+      the violation and efficacy violation divided by norm of row.
+      Cuts with effectiveness COIN_DBL_MAX are always returned (caller
+      decides).  Returns number.
+  */
+  int violatedCuts(const double *solution, double tolerance,
+    int *which, double *violation, double *efficacy);
+  /** Remove least recently active cuts (tight or violated in
+      violatedCuts) until there are at most 90% of maximumCuts and
+      maximumBytes (zero for no limit).  Cuts active in the last
+      minimumAge ticks of clock and ones with effectiveness COIN_DBL_MAX
+      are never removed.  Returns number removed.
+  */
+  int evict(int maximumCuts, double maximumBytes, int minimumAge);
+  /// Estimated bytes used by cuts
+  double bytes() const;
+  /// Set clock (node count) for activity of cuts
+  inline void setClock(int value)
+  {
+    clock_ = value;
+  }
+  /// When cut was last active (or added)
+  inline int lastActive(int sequence) const
+  {
+    return lastActive_[sequence];
+  }
+  /// Number of cuts removed by evict
+  inline int numberEvicted() const
+  {
+    return numberEvicted_;
+  }
+
+private:
+  /// Append cuts not in row copy (forget row copy if numberStored_ < 0)
+  void updateStore();
+  /// Rebuild hash table from all cuts
+  void rebuildHash();
 
 private:
   OsiRowCut2 **rowCut_;
@@ -170,6 +232,24 @@ private:
   int hashMultiplier_;
   int numberCuts_;
   int lastHash_;
+  /// Row copy of first numberStored_ cuts (bounds are taken from cuts)
+  CoinBigIndex *storeStart_;
+  int *storeIndex_;
+  double *storeElement_;
+  /// 1.0/norm of each stored cut
+  double *storeNormInverse_;
+  /// Number of cuts in row copy
+  int numberStored_;
+  /// Space for cuts in row copy
+  int maximumStored_;
+  /// Space for elements in row copy
+  CoinBigIndex maximumStoredElements_;
+  /// Clock when each cut was last active
+  int *lastActive_;
+  /// Current clock
+  int clock_;
+  /// Number of cuts removed by evict
+  int numberEvicted_;
 };
 #endif
 
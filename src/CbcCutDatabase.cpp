@@ -0,0 +1,231 @@
+// Copyright (C) 2005, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#pragma warning(disable : 4786)
+#endif
+
+#include "CbcConfig.h"
+
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+
+#include "CoinPackedMatrix.hpp"
+#include "OsiSolverInterface.hpp"
+#include "OsiRowCut.hpp"
+#include "OsiCuts.hpp"
+#include "CbcCutDatabase.hpp"
+
+// Mix value into key
+static inline CoinUInt64 mixHash(CoinUInt64 hash, CoinUInt64 value)
+{
+  CoinUInt64 bits = hash ^ (value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2));
+  bits ^= bits >> 31;
+  bits *= 0xbf58476d1ce4e5b9ULL;
+  bits ^= bits >> 29;
+  return bits;
+}
+static inline CoinUInt64 doubleBits(double value)
+{
+  CoinUInt64 bits;
+  if (!value)
+    value = 0.0; // not -0.0
+  memcpy(&bits, &value, sizeof(double));
+  return bits;
+}
+
+// Default Constructor
+CbcCutDatabase::CbcCutDatabase()
+  : key_(0)
+  , objectiveKey_(0)
+  , originalKey_(0)
+{
+  cutStart_.push_back(0);
+}
+
+CbcCutDatabase::~CbcCutDatabase()
+{
+}
+
+// Remember keys and bounds of problem
+void CbcCutDatabase::setProblem(const OsiSolverInterface *solver,
+  const int *originalColumns)
+{
+  int numberColumns = solver->getNumCols();
+  int numberRows = solver->getNumRows();
+  // matrix and integers
+  const CoinPackedMatrix *matrix = solver->getMatrixByCol();
+  const double *element = matrix->getElements();
+  const int *row = matrix->getIndices();
+  const CoinBigIndex *columnStart = matrix->getVectorStarts();
+  const int *columnLength = matrix->getVectorLengths();
+  key_ = mixHash(numberRows, numberColumns);
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    key_ = mixHash(key_, solver->isInteger(iColumn) ? 1 : 0);
+    key_ = mixHash(key_, columnLength[iColumn]);
+    for (CoinBigIndex j = columnStart[iColumn];
+         j < columnStart[iColumn] + columnLength[iColumn]; j++) {
+      key_ = mixHash(key_, row[j]);
+      key_ = mixHash(key_, doubleBits(element[j]));
+    }
+  }
+  const double *objective = solver->getObjCoefficients();
+  objectiveKey_ = mixHash(numberColumns, doubleBits(solver->getObjSense()));
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++)
+    objectiveKey_ = mixHash(objectiveKey_, doubleBits(objective[iColumn]));
+  originalKey_ = mixHash(numberColumns, originalColumns ? 1 : 0);
+  if (originalColumns) {
+    for (int iColumn = 0; iColumn < numberColumns; iColumn++)
+      originalKey_ = mixHash(originalKey_, originalColumns[iColumn]);
+  }
+  const double *columnLower = solver->getColLower();
+  const double *columnUpper = solver->getColUpper();
+  const double *rowLower = solver->getRowLower();
+  const double *rowUpper = solver->getRowUpper();
+  columnLower_.assign(columnLower, columnLower + numberColumns);
+  columnUpper_.assign(columnUpper, columnUpper + numberColumns);
+  rowLower_.assign(rowLower, rowLower + numberRows);
+  rowUpper_.assign(rowUpper, rowUpper + numberRows);
+  cutStart_.assign(1, 0);
+  cutIndex_.clear();
+  cutElement_.clear();
+  cutLower_.clear();
+  cutUpper_.clear();
+  cutCutoff_.clear();
+}
+
+/* Add cuts of first record with same keys whose bounds contain those of
+   problem.  Cuts relying on a cutoff need the same objective and a
+   cutoff now at least as good.
+*/
+int CbcCutDatabase::load(const char *fileName, double cutoff, OsiCuts &cuts) const
+{
+  FILE *fp = fopen(fileName, "r");
+  if (!fp)
+    return 0;
+  int numberColumns = static_cast< int >(columnLower_.size());
+  int numberRows = static_cast< int >(rowLower_.size());
+  int numberAdded = 0;
+  bool readError = false;
+  unsigned long long fileKey;
+  unsigned long long fileObjectiveKey;
+  unsigned long long fileOriginalKey;
+  int fileColumns;
+  int fileRows;
+  int fileCuts;
+  std::vector< int > index;
+  std::vector< double > element;
+  while (!numberAdded && !readError
+    && fscanf(fp, " CBC_CUTS %llx %llx %llx %d %d %d", &fileKey,
+         &fileObjectiveKey, &fileOriginalKey, &fileColumns, &fileRows,
+         &fileCuts)
+      == 6) {
+    bool good = fileKey == static_cast< unsigned long long >(key_)
+      && fileOriginalKey == static_cast< unsigned long long >(originalKey_)
+      && fileColumns == numberColumns && fileRows == numberRows;
+    bool sameObjective = fileObjectiveKey == static_cast< unsigned long long >(objectiveKey_);
+    // bounds of record must contain those of problem
+    for (int i = 0; i < fileColumns + fileRows; i++) {
+      double lower;
+      double upper;
+      if (fscanf(fp, "%lf %lf", &lower, &upper) != 2) {
+        readError = true;
+        break;
+      }
+      if (good) {
+        if (i < numberColumns) {
+          if (columnLower_[i] < lower || columnUpper_[i] > upper)
+            good = false;
+        } else {
+          int iRow = i - numberColumns;
+          if (rowLower_[iRow] < lower || rowUpper_[iRow] > upper)
+            good = false;
+        }
+      }
+    }
+    for (int iCut = 0; iCut < fileCuts && !readError; iCut++) {
+      double cutCutoff;
+      double lb;
+      double ub;
+      int n;
+      if (fscanf(fp, "%lf %lf %lf %d", &cutCutoff, &lb, &ub, &n) != 4 || n < 0) {
+        readError = true;
+        break;
+      }
+      bool goodCut = good && n
+        && (cutCutoff >= 1.0e50 || (sameObjective && cutoff <= cutCutoff));
+      index.resize(n + 1);
+      element.resize(n + 1);
+      for (int j = 0; j < n; j++) {
+        if (fscanf(fp, "%d %lf", &index[j], &element[j]) != 2) {
+          readError = true;
+          break;
+        }
+        if (index[j] < 0 || index[j] >= numberColumns)
+          goodCut = false;
+      }
+      if (goodCut && !readError) {
+        OsiRowCut cut;
+        cut.setLb(lb);
+        cut.setUb(ub);
+        cut.setRow(n, &index[0], &element[0], false);
+        cut.setGloballyValid(true);
+        cuts.insert(cut);
+        numberAdded++;
+      }
+    }
+  }
+  fclose(fp);
+  return numberAdded;
+}
+
+// Remember cut valid for solutions better than cutoff
+void CbcCutDatabase::addCut(const OsiRowCut &cut, double cutoff)
+{
+  const CoinPackedVector &row = cut.row();
+  int n = row.getNumElements();
+  const int *column = row.getIndices();
+  const double *element = row.getElements();
+  cutIndex_.insert(cutIndex_.end(), column, column + n);
+  cutElement_.insert(cutElement_.end(), element, element + n);
+  cutStart_.push_back(static_cast< int >(cutIndex_.size()));
+  cutLower_.push_back(cut.lb());
+  cutUpper_.push_back(cut.ub());
+  cutCutoff_.push_back(cutoff);
+}
+
+// Append record to file
+bool CbcCutDatabase::save(const char *fileName) const
+{
+  FILE *fp = fopen(fileName, "a");
+  if (!fp)
+    return false;
+  int numberColumns = static_cast< int >(columnLower_.size());
+  int numberRows = static_cast< int >(rowLower_.size());
+  int numberCuts = static_cast< int >(cutLower_.size());
+  fprintf(fp, "CBC_CUTS %llx %llx %llx %d %d %d\n",
+    static_cast< unsigned long long >(key_),
+    static_cast< unsigned long long >(objectiveKey_),
+    static_cast< unsigned long long >(originalKey_),
+    numberColumns, numberRows, numberCuts);
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++)
+    fprintf(fp, "%.17g %.17g\n", columnLower_[iColumn], columnUpper_[iColumn]);
+  for (int iRow = 0; iRow < numberRows; iRow++)
+    fprintf(fp, "%.17g %.17g\n", rowLower_[iRow], rowUpper_[iRow]);
+  for (int iCut = 0; iCut < numberCuts; iCut++) {
+    fprintf(fp, "%.17g %.17g %.17g %d", cutCutoff_[iCut], cutLower_[iCut],
+      cutUpper_[iCut], cutStart_[iCut + 1] - cutStart_[iCut]);
+    for (int j = cutStart_[iCut]; j < cutStart_[iCut + 1]; j++)
+      fprintf(fp, " %d %.17g", cutIndex_[j], cutElement_[j]);
+    fprintf(fp, "\n");
+  }
+  bool good = !ferror(fp);
+  fclose(fp);
+  return good;
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
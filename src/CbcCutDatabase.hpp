@@ -0,0 +1,88 @@
+// Copyright (C) 2005, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcCutDatabase_H
+#define CbcCutDatabase_H
+
+#include <vector>
+
+#include "CbcConfig.h"
+#include "CoinTypes.hpp"
+
+class OsiSolverInterface;
+class OsiRowCut;
+class OsiCuts;
+
+/** Root cuts and conflicts kept in a file between solves of one structure
+
+    When models with the same matrix are solved again and again (only
+    objective and bounds change) the same root cuts are found each time.
+    The cuts of a solve are appended to the file with a key of the
+    structure - matrix pattern, elements and integer flags, as for the
+    symmetry file - a key of the mapping to original columns (so the same
+    preprocessing) and the column and row bounds they were found with.
+
+    A later solve with the same keys takes cuts from the first record
+    whose bounds contain its own - a cut valid for a region is valid for
+    any smaller one.  Cuts found after there was a cutoff may rely on it
+    (reduced cost fixing, probing on objective) so they are only taken if
+    the objective is the same and the cutoff now is no worse.  Cuts taken
+    go into the global cut pool; the model then does fewer root passes and
+    does not append a record of its own.
+*/
+
+class CBCLIB_EXPORT CbcCutDatabase {
+public:
+  /// Default Constructor
+  CbcCutDatabase();
+  /// Destructor
+  ~CbcCutDatabase();
+
+  /** Remember keys and bounds of problem in solver (before root cuts).
+      originalColumns is mapping to columns before preprocessing (or NULL) */
+  void setProblem(const OsiSolverInterface *solver, const int *originalColumns);
+  /** Add to cuts those of first record of file valid for problem given to
+      setProblem with cutoff.  Returns number added */
+  int load(const char *fileName, double cutoff, OsiCuts &cuts) const;
+  /// Remember cut (on columns of solver) valid for solutions better than cutoff
+  void addCut(const OsiRowCut &cut, double cutoff);
+  /// Append record of problem and cuts to file.  Returns true if written
+  bool save(const char *fileName) const;
+  /// Number of cuts remembered
+  inline int numberCuts() const
+  {
+    return static_cast< int >(cutLower_.size());
+  }
+
+private:
+  /// Illegal copy constructor
+  CbcCutDatabase(const CbcCutDatabase &);
+  /// Illegal assignment operator
+  CbcCutDatabase &operator=(const CbcCutDatabase &);
+
+  /// Key of matrix and integers
+  CoinUInt64 key_;
+  /// Key of objective
+  CoinUInt64 objectiveKey_;
+  /// Key of original columns
+  CoinUInt64 originalKey_;
+  /// Bounds of problem
+  std::vector< double > columnLower_;
+  std::vector< double > columnUpper_;
+  std::vector< double > rowLower_;
+  std::vector< double > rowUpper_;
+  /// Cuts - start of each in index and element (one more than cuts)
+  std::vector< int > cutStart_;
+  std::vector< int > cutIndex_;
+  std::vector< double > cutElement_;
+  std::vector< double > cutLower_;
+  std::vector< double > cutUpper_;
+  /// Cutoff when cut was found
+  std::vector< double > cutCutoff_;
+};
+
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -24,17 +24,25 @@
 #include "CbcModel.hpp"
 #include "CbcMessage.hpp"
 #include "CbcCutGenerator.hpp"
+#include "CbcSeparationContext.hpp"
 #include "CbcBranchDynamic.hpp"
 #include "CglProbing.hpp"
 #include "CglCliqueStrengthening.hpp"
 #include "CglBKClique.hpp"
 #include "CglOddWheel.hpp"
 #include "CoinTime.hpp"
+#include "CoinHelperFunctions.hpp"
 #ifdef CBC_THREAD
 // need time on a thread by thread basis
 #include <pthread.h>
 #include <time.h>
 #endif
+// Nodes skipped when first switched off by schedule (doubles each time)
+#define CBC_SCHEDULE_BACKOFF 10
+// Most nodes skipped when switched off by schedule
+#define CBC_SCHEDULE_MAXIMUM_BACKOFF 10000
+// Calls needed before scheduling decision
+#define CBC_SCHEDULE_CALLS 10
 
 // Default Constructor
 CbcCutGenerator::CbcCutGenerator()
@@ -58,7 +66,24 @@ CbcCutGenerator::CbcCutGenerator()
   , numberShortCutsAtRoot_(0)
   , switches_(1)
   , maximumTries_(-1)
+  , rootImprovement_(0.0)
+  , rootTime_(0.0)
+  , treeImprovement_(0.0)
+  , treeTime_(0.0)
+  , windowImprovement_(0.0)
+  , windowTime_(0.0)
+  , windowCalls_(0)
+  , passCuts_(0)
+  , backoff_(CBC_SCHEDULE_BACKOFF)
+  , nextTry_(-1)
+  , numberBackoffs_(0)
+  , passBucket_(0)
 {
+  CoinZeroN(depthCalls_, CBC_STATISTICS_DEPTHS);
+  CoinZeroN(depthCuts_, CBC_STATISTICS_DEPTHS);
+  CoinZeroN(depthActive_, CBC_STATISTICS_DEPTHS);
+  CoinZeroN(depthTime_, CBC_STATISTICS_DEPTHS);
+  CoinZeroN(depthImprovement_, CBC_STATISTICS_DEPTHS);
 }
 // Normal constructor
 CbcCutGenerator::CbcCutGenerator(CbcModel *model, CglCutGenerator *generator,
@@ -81,7 +106,24 @@ CbcCutGenerator::CbcCutGenerator(CbcModel *model, CglCutGenerator *generator,
   , numberShortCutsAtRoot_(0)
   , switches_(1)
   , maximumTries_(-1)
+  , rootImprovement_(0.0)
+  , rootTime_(0.0)
+  , treeImprovement_(0.0)
+  , treeTime_(0.0)
+  , windowImprovement_(0.0)
+  , windowTime_(0.0)
+  , windowCalls_(0)
+  , passCuts_(0)
+  , backoff_(CBC_SCHEDULE_BACKOFF)
+  , nextTry_(-1)
+  , numberBackoffs_(0)
+  , passBucket_(0)
 {
+  CoinZeroN(depthCalls_, CBC_STATISTICS_DEPTHS);
+  CoinZeroN(depthCuts_, CBC_STATISTICS_DEPTHS);
+  CoinZeroN(depthActive_, CBC_STATISTICS_DEPTHS);
+  CoinZeroN(depthTime_, CBC_STATISTICS_DEPTHS);
+  CoinZeroN(depthImprovement_, CBC_STATISTICS_DEPTHS);
   if (howOften < -1900) {
     setGlobalCuts(true);
     howOften += 2000;
@@ -130,6 +172,23 @@ CbcCutGenerator::CbcCutGenerator(const CbcCutGenerator &rhs)
   numberCutsAtRoot_ = rhs.numberCutsAtRoot_;
   numberActiveCutsAtRoot_ = rhs.numberActiveCutsAtRoot_;
   numberShortCutsAtRoot_ = rhs.numberShortCutsAtRoot_;
+  rootImprovement_ = rhs.rootImprovement_;
+  rootTime_ = rhs.rootTime_;
+  treeImprovement_ = rhs.treeImprovement_;
+  treeTime_ = rhs.treeTime_;
+  windowImprovement_ = rhs.windowImprovement_;
+  windowTime_ = rhs.windowTime_;
+  windowCalls_ = rhs.windowCalls_;
+  passCuts_ = rhs.passCuts_;
+  backoff_ = rhs.backoff_;
+  nextTry_ = rhs.nextTry_;
+  numberBackoffs_ = rhs.numberBackoffs_;
+  passBucket_ = rhs.passBucket_;
+  CoinCopyN(rhs.depthCalls_, CBC_STATISTICS_DEPTHS, depthCalls_);
+  CoinCopyN(rhs.depthCuts_, CBC_STATISTICS_DEPTHS, depthCuts_);
+  CoinCopyN(rhs.depthActive_, CBC_STATISTICS_DEPTHS, depthActive_);
+  CoinCopyN(rhs.depthTime_, CBC_STATISTICS_DEPTHS, depthTime_);
+  CoinCopyN(rhs.depthImprovement_, CBC_STATISTICS_DEPTHS, depthImprovement_);
 }
 
 // Assignment operator
@@ -161,6 +220,23 @@ CbcCutGenerator::operator=(const CbcCutGenerator &rhs)
     numberCutsAtRoot_ = rhs.numberCutsAtRoot_;
     numberActiveCutsAtRoot_ = rhs.numberActiveCutsAtRoot_;
     numberShortCutsAtRoot_ = rhs.numberShortCutsAtRoot_;
+    rootImprovement_ = rhs.rootImprovement_;
+    rootTime_ = rhs.rootTime_;
+    treeImprovement_ = rhs.treeImprovement_;
+    treeTime_ = rhs.treeTime_;
+    windowImprovement_ = rhs.windowImprovement_;
+    windowTime_ = rhs.windowTime_;
+    windowCalls_ = rhs.windowCalls_;
+    passCuts_ = rhs.passCuts_;
+    backoff_ = rhs.backoff_;
+    nextTry_ = rhs.nextTry_;
+    numberBackoffs_ = rhs.numberBackoffs_;
+    passBucket_ = rhs.passBucket_;
+    CoinCopyN(rhs.depthCalls_, CBC_STATISTICS_DEPTHS, depthCalls_);
+    CoinCopyN(rhs.depthCuts_, CBC_STATISTICS_DEPTHS, depthCuts_);
+    CoinCopyN(rhs.depthActive_, CBC_STATISTICS_DEPTHS, depthActive_);
+    CoinCopyN(rhs.depthTime_, CBC_STATISTICS_DEPTHS, depthTime_);
+    CoinCopyN(rhs.depthImprovement_, CBC_STATISTICS_DEPTHS, depthImprovement_);
   }
   return *this;
 }
@@ -628,18 +704,8 @@ bool CbcCutGenerator::generateCuts(OsiCuts &cs, int fullScan, OsiSolverInterface
     CbcCutModifier *modifier = model_->cutModifier();
     if (modifier) {
       int numberRowCutsAfter = cs.sizeRowCuts();
-      int k;
-      int nOdd = 0;
-      //const OsiSolverInterface * solver = model_->solver();
-      for (k = numberRowCutsAfter - 1; k >= numberRowCutsBefore; k--) {
-        OsiRowCut &thisCut = cs.rowCut(k);
-        int returnCode = modifier->modify(solver, thisCut);
-        if (returnCode) {
-          nOdd++;
-          if (returnCode == 3)
-            cs.eraseRowCut(k);
-        }
-      }
+      // all new cuts in one go so deleting is not quadratic
+      int nOdd = modifier->modifyCuts(solver, cs, numberRowCutsBefore);
       if (nOdd)
         COIN_DETAIL_PRINT(printf("Cut generator %s produced %d cuts of which %d were modified\n",
           generatorName_, numberRowCutsAfter - numberRowCutsBefore, nOdd));
@@ -794,7 +860,7 @@ bool CbcCutGenerator::generateCuts(OsiCuts &cs, int fullScan, OsiSolverInterface
       int nCuts = numberRowCutsAfter - numberRowCutsBefore;
       // Remove NULL cuts!
       int nNull = 0;
-      const double *solution = solver->getColSolution();
+      const double *solution = model_->separationContext()->colSolution(solver);
       bool feasible = true;
       double primalTolerance = 1.0e-7;
       int shortCut = (depth) ? -1 : generator_->maximumLengthOfCutInTree();
@@ -1341,6 +1407,18 @@ void CbcCutGenerator::setWhatDepthInSub(int value)
 {
   depthCutGeneratorInSub_ = value;
 }
+// Copy settings which decide when cuts are generated
+void CbcCutGenerator::copyControl(const CbcCutGenerator *other)
+{
+  whenCutGenerator_ = other->whenCutGenerator_;
+  whenCutGeneratorInSub_ = other->whenCutGeneratorInSub_;
+  switchOffIfLessThan_ = other->switchOffIfLessThan_;
+  depthCutGenerator_ = other->depthCutGenerator_;
+  depthCutGeneratorInSub_ = other->depthCutGeneratorInSub_;
+  inaccuracy_ = other->inaccuracy_;
+  switches_ = other->switches_;
+  maximumTries_ = other->maximumTries_;
+}
 // Add in statistics from other
 void CbcCutGenerator::addStatistics(const CbcCutGenerator *other)
 {
@@ -1362,6 +1440,18 @@ void CbcCutGenerator::addStatistics(const CbcCutGenerator *other)
   numberActiveCutsAtRoot_ += other->numberActiveCutsAtRoot_;
   // Number of short cuts at root
   numberShortCutsAtRoot_ += other->numberShortCutsAtRoot_;
+  // Improvement and time seen by scheduling
+  rootImprovement_ += other->rootImprovement_;
+  rootTime_ += other->rootTime_;
+  treeImprovement_ += other->treeImprovement_;
+  treeTime_ += other->treeTime_;
+  for (int i = 0; i < CBC_STATISTICS_DEPTHS; i++) {
+    depthCalls_[i] += other->depthCalls_[i];
+    depthCuts_[i] += other->depthCuts_[i];
+    depthActive_[i] += other->depthActive_[i];
+    depthTime_[i] += other->depthTime_[i];
+    depthImprovement_[i] += other->depthImprovement_[i];
+  }
 }
 // Scale back statistics by factor
 void CbcCutGenerator::scaleBackStatistics(int factor)
@@ -1384,6 +1474,87 @@ void CbcCutGenerator::scaleBackStatistics(int factor)
   // Number of short cuts at root
   numberShortCutsAtRoot_ = (numberShortCutsAtRoot_ + factor - 1) / factor;
 }
+// Add time and number of row cuts from one call
+void CbcCutGenerator::addScheduleCall(bool atRoot, double seconds, int numberCuts)
+{
+  passBucket_ = atRoot ? 0 : depthBucket(CoinMax(model_->currentDepth(), 1));
+  depthCalls_[passBucket_]++;
+  depthCuts_[passBucket_] += numberCuts;
+  depthTime_[passBucket_] += seconds;
+  if (atRoot) {
+    rootTime_ += seconds;
+  } else {
+    treeTime_ += seconds;
+    windowTime_ += seconds;
+    windowCalls_++;
+  }
+  passCuts_ += numberCuts;
+}
+// Give generator its share of improvement in objective from pass
+void CbcCutGenerator::addScheduleImprovement(bool atRoot, double improvement,
+  int totalCuts)
+{
+  if (passCuts_ && totalCuts > 0 && improvement > 0.0) {
+    double share = improvement * static_cast< double >(passCuts_) / static_cast< double >(totalCuts);
+    depthImprovement_[passBucket_] += share;
+    if (atRoot) {
+      rootImprovement_ += share;
+    } else {
+      treeImprovement_ += share;
+      windowImprovement_ += share;
+    }
+  }
+  passCuts_ = 0;
+}
+// Improvement per second in calls since last decision
+double CbcCutGenerator::windowRate() const
+{
+  if (windowCalls_ < CBC_SCHEDULE_CALLS)
+    return -1.0;
+  return windowImprovement_ / CoinMax(windowTime_, 1.0e-6);
+}
+// Decide whether to back off
+int CbcCutGenerator::schedule(int node, double bestRate)
+{
+  double rate = windowRate();
+  if (rate < 0.0)
+    return 0;
+  int returnCode = 0;
+  if (windowImprovement_ < 1.0e-9 || rate < 0.01 * bestRate) {
+    nextTry_ = node + backoff_;
+    backoff_ = CoinMin(2 * backoff_, CBC_SCHEDULE_MAXIMUM_BACKOFF);
+    numberBackoffs_++;
+    returnCode = 1;
+  } else if (backoff_ > CBC_SCHEDULE_BACKOFF) {
+    // retry was worthwhile
+    backoff_ = CBC_SCHEDULE_BACKOFF;
+    returnCode = 2;
+  }
+  windowImprovement_ = 0.0;
+  windowTime_ = 0.0;
+  windowCalls_ = 0;
+  return returnCode;
+}
+// Bucket for depth in tree
+int CbcCutGenerator::depthBucket(int depth)
+{
+  int bucket = 0;
+  while (depth > 0 && bucket < CBC_STATISTICS_DEPTHS - 1) {
+    depth >>= 1;
+    bucket++;
+  }
+  return bucket;
+}
+// First depth in bucket
+int CbcCutGenerator::bucketDepth(int bucket)
+{
+  return bucket ? 1 << (bucket - 1) : 0;
+}
+// Add cuts still in solver when cuts at node are finished
+void CbcCutGenerator::addDepthActive(int depth, int numberActive)
+{
+  depthActive_[depthBucket(depth)] += numberActive;
+}
 // Create C++ lines to get to current state
 void CbcCutGenerator::generateTuning(FILE *fp)
 {
@@ -1406,6 +1577,13 @@ void CbcCutGenerator::generateTuning(FILE *fp)
     fprintf(fp, "   generator->setMustCallAgain(true);\n");
   if (whetherToUse())
     fprintf(fp, "   generator->setWhetherToUse(true);\n");
+  if (rootTime_ > 0.0 || treeTime_ > 0.0) {
+    fprintf(fp, "// improvement per second %g at root (%g in %.3f seconds), %g in tree (%g in %.3f seconds)\n",
+      rootRate(), rootImprovement_, rootTime_, treeRate(), treeImprovement_, treeTime_);
+    if (numberBackoffs_)
+      fprintf(fp, "// switched off %d times by schedule - next try at node %d, backoff %d nodes\n",
+        numberBackoffs_, nextTry_, backoff_);
+  }
 }
 
 /* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
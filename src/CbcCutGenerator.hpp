@@ -15,6 +15,10 @@ class CbcModel;
 class OsiRowCut;
 class OsiRowCutDebugger;
 
+/** Number of depth buckets for statistics - root, 1, 2-3, 4-7 ...
+    and last one for everything deeper */
+#define CBC_STATISTICS_DEPTHS 8
+
 //#############################################################################
 
 /** Interface between Cbc and Cut Generation Library.
@@ -254,6 +258,11 @@ public:
   {
     return generator_;
   }
+  /// Cuts saved for later use
+  inline const OsiCuts &savedCuts() const
+  {
+    return savedCuts_;
+  }
   /// Number times cut generator entered
   inline int numberTimesEntered() const
   {
@@ -469,12 +478,111 @@ public:
     switches_ &= ~256;
     switches_ |= yesNo ? 256 : 0;
   }
+  /** Copy settings which decide when cuts are generated from other
+      (e.g. to copy in a thread model) - not statistics or generator */
+  void copyControl(const CbcCutGenerator *other);
   /// Add in statistics from other
   void addStatistics(const CbcCutGenerator *other);
   /// Scale back statistics by factor
   void scaleBackStatistics(int factor);
   //@}
 
+  /**@name Scheduling by bound improvement per second
+     (see CbcModel::CbcAdaptiveCuts) */
+  //@{
+  /// Add time and number of row cuts from one call
+  void addScheduleCall(bool atRoot, double seconds, int numberCuts);
+  /** Give generator its share (by row cuts made in this pass) of
+      improvement in objective from pass of totalCuts cuts */
+  void addScheduleImprovement(bool atRoot, double improvement, int totalCuts);
+  /// Row cuts made in this pass so far
+  inline int numberPassCuts() const
+  {
+    return passCuts_;
+  }
+  /// Improvement per second at root
+  inline double rootRate() const
+  {
+    return rootTime_ > 0.0 ? rootImprovement_ / rootTime_ : 0.0;
+  }
+  /// Improvement per second in tree
+  inline double treeRate() const
+  {
+    return treeTime_ > 0.0 ? treeImprovement_ / treeTime_ : 0.0;
+  }
+  /// Time in generator at root and in tree (as seen by scheduling)
+  inline double scheduleTime() const
+  {
+    return rootTime_ + treeTime_;
+  }
+  /// Improvement per second in calls since last decision (-1.0 if too few)
+  double windowRate() const;
+  /// Whether schedule says skip generator at this node
+  inline bool scheduledOff(int node) const
+  {
+    return nextTry_ > node;
+  }
+  /** Decide after enough calls whether to back off.  If improvement per
+      second is tiny or less than 1% of bestRate then generator is not
+      called for next backoff nodes and backoff doubles, otherwise backoff
+      goes back to start.  Returns 1 if switched off, 2 if a retry was
+      good enough to switch back on, 0 otherwise.
+  */
+  int schedule(int node, double bestRate);
+  /// Node at which generator is next tried by schedule
+  inline int nextScheduledTry() const
+  {
+    return nextTry_;
+  }
+  /// Nodes generator is skipped for when next switched off
+  inline int scheduleBackoff() const
+  {
+    return backoff_;
+  }
+  /// Number of times switched off by schedule
+  inline int numberScheduleBackoffs() const
+  {
+    return numberBackoffs_;
+  }
+  //@}
+
+  /**@name Statistics by depth (see CbcModel::writeCutStatistics)
+     Bucket 0 is root, bucket k is depth 2^(k-1) to 2^k-1 and last
+     bucket has everything deeper. */
+  //@{
+  /// Bucket for depth in tree
+  static int depthBucket(int depth);
+  /// First depth in bucket
+  static int bucketDepth(int bucket);
+  /// Add cuts still in solver when cuts at a node at depth are finished
+  void addDepthActive(int depth, int numberActive);
+  /// Calls in bucket
+  inline int depthCalls(int bucket) const
+  {
+    return depthCalls_[bucket];
+  }
+  /// Time in bucket
+  inline double depthTime(int bucket) const
+  {
+    return depthTime_[bucket];
+  }
+  /// Row cuts made in bucket
+  inline int depthCuts(int bucket) const
+  {
+    return depthCuts_[bucket];
+  }
+  /// Row cuts still active after cuts at node (in bucket)
+  inline int depthActive(int bucket) const
+  {
+    return depthActive_[bucket];
+  }
+  /// Improvement in objective attributed to generator in bucket
+  inline double depthImprovement(int bucket) const
+  {
+    return depthImprovement_[bucket];
+  }
+  //@}
+
 private:
   /**@name Private gets and sets */
   //@{
@@ -537,6 +645,40 @@ private:
   int switches_;
   /// Maximum number of times to enter
   int maximumTries_;
+  /// Improvement in objective attributed to generator at root
+  double rootImprovement_;
+  /// Time in generator at root (as seen by scheduling)
+  double rootTime_;
+  /// Improvement in objective attributed to generator in tree
+  double treeImprovement_;
+  /// Time in generator in tree (as seen by scheduling)
+  double treeTime_;
+  /// Improvement since last scheduling decision
+  double windowImprovement_;
+  /// Time since last scheduling decision
+  double windowTime_;
+  /// Calls since last scheduling decision
+  int windowCalls_;
+  /// Row cuts made in current pass
+  int passCuts_;
+  /// Nodes to skip when next switched off
+  int backoff_;
+  /// Node at which generator is next tried
+  int nextTry_;
+  /// Number of times switched off by schedule
+  int numberBackoffs_;
+  /// Depth bucket of current pass
+  int passBucket_;
+  /// Calls by depth bucket
+  int depthCalls_[CBC_STATISTICS_DEPTHS];
+  /// Row cuts made by depth bucket
+  int depthCuts_[CBC_STATISTICS_DEPTHS];
+  /// Row cuts active after cuts at node by depth bucket
+  int depthActive_[CBC_STATISTICS_DEPTHS];
+  /// Time by depth bucket
+  double depthTime_[CBC_STATISTICS_DEPTHS];
+  /// Improvement by depth bucket
+  double depthImprovement_[CBC_STATISTICS_DEPTHS];
 };
 
 // How often to do if mostly switched off (A)
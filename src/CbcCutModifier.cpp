@@ -51,5 +51,40 @@ CbcCutModifier::operator=(const CbcCutModifier &rhs)
   return *this;
 }
 
+// Modify row cuts from first on in one go
+int CbcCutModifier::modifyCuts(const OsiSolverInterface *solver, OsiCuts &cuts,
+  int first)
+{
+  int numberCuts = cuts.sizeRowCuts();
+  int numberModified = 0;
+  // pointers of cuts kept - only made when first cut deleted
+  OsiRowCut **kept = NULL;
+  int numberKept = 0;
+  for (int k = first; k < numberCuts; k++) {
+    OsiRowCut *cut = cuts.rowCutPtr(k);
+    int returnCode = modify(solver, *cut);
+    if (returnCode)
+      numberModified++;
+    if (returnCode == 3) {
+      if (!kept) {
+        kept = new OsiRowCut *[numberCuts];
+        for (numberKept = 0; numberKept < k; numberKept++)
+          kept[numberKept] = cuts.rowCutPtr(numberKept);
+      }
+      delete cut;
+    } else if (kept) {
+      kept[numberKept++] = cut;
+    }
+  }
+  if (kept) {
+    // forget all pointers (cuts not deleted) and put back those kept
+    cuts.dumpCuts();
+    for (int k = 0; k < numberKept; k++)
+      cuts.insert(kept[k]);
+    delete[] kept;
+  }
+  return numberModified;
+}
+
 /* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
 */
@@ -47,6 +47,11 @@ public:
         3 deleted
     */
   virtual int modify(const OsiSolverInterface *solver, OsiRowCut &cut) = 0;
+  /** Modify row cuts from first on in one go - deleted cuts are taken
+        out (without moving the others more than once).  Returns number
+        changed or deleted */
+  virtual int modifyCuts(const OsiSolverInterface *solver, OsiCuts &cuts,
+    int first = 0);
   /// Create C++ lines to get to current state
   virtual void generateCpp(FILE *) {}
 
@@ -25,27 +25,45 @@
 #include "CbcBranchDynamic.hpp"
 #include "CglProbing.hpp"
 #include "CoinTime.hpp"
+#include "CoinHelperFunctions.hpp"
 #include "CbcCutSubsetModifier.hpp"
 
 // Default Constructor
 CbcCutSubsetModifier::CbcCutSubsetModifier()
   : CbcCutModifier()
   , firstOdd_(COIN_INT_MAX)
+  , allowed_(NULL)
 {
 }
 
 // Useful constructor
 CbcCutSubsetModifier::CbcCutSubsetModifier(int firstOdd)
   : CbcCutModifier()
+  , allowed_(NULL)
 {
   firstOdd_ = firstOdd;
 }
 
+// Constructor from subset
+CbcCutSubsetModifier::CbcCutSubsetModifier(int numberColumns, const char *allowed)
+  : CbcCutModifier()
+  , firstOdd_(numberColumns)
+{
+  int numberWords = (numberColumns + 31) >> 5;
+  allowed_ = new unsigned int[CoinMax(numberWords, 1)];
+  CoinZeroN(allowed_, CoinMax(numberWords, 1));
+  for (int i = 0; i < numberColumns; i++) {
+    if (allowed[i])
+      allowed_[i >> 5] |= 1u << (i & 31);
+  }
+}
+
 // Copy constructor
 CbcCutSubsetModifier::CbcCutSubsetModifier(const CbcCutSubsetModifier &rhs)
   : CbcCutModifier(rhs)
 {
   firstOdd_ = rhs.firstOdd_;
+  allowed_ = CoinCopyOfArray(rhs.allowed_, CoinMax((firstOdd_ + 31) >> 5, 1));
 }
 
 // Clone
@@ -62,6 +80,8 @@ CbcCutSubsetModifier::operator=(const CbcCutSubsetModifier &rhs)
   if (this != &rhs) {
     CbcCutModifier::operator=(rhs);
     firstOdd_ = rhs.firstOdd_;
+    delete[] allowed_;
+    allowed_ = CoinCopyOfArray(rhs.allowed_, CoinMax((firstOdd_ + 31) >> 5, 1));
   }
   return *this;
 }
@@ -69,6 +89,7 @@ CbcCutSubsetModifier::operator=(const CbcCutSubsetModifier &rhs)
 // Destructor
 CbcCutSubsetModifier::~CbcCutSubsetModifier()
 {
+  delete[] allowed_;
 }
 /* Returns
    0 unchanged
@@ -85,11 +106,20 @@ int CbcCutSubsetModifier::modify(const OsiSolverInterface * /*solver*/,
   const int *column = cut.row().getIndices();
   //const double * element = cut.row().getElements();
   int returnCode = 0;
-  for (int i = 0; i < n; i++) {
-    if (column[i] >= firstOdd_) {
-      returnCode = 3;
-      break;
+  // no branches in loops - most cuts are kept so all is looked at anyway
+  int largest = 0;
+  for (int i = 0; i < n; i++)
+    largest = CoinMax(largest, column[i]);
+  if (largest >= firstOdd_) {
+    returnCode = 3;
+  } else if (allowed_) {
+    unsigned int missing = 0;
+    for (int i = 0; i < n; i++) {
+      int iColumn = column[i];
+      missing |= (~allowed_[iColumn >> 5] >> (iColumn & 31)) & 1u;
     }
+    if (missing)
+      returnCode = 3;
   }
 #ifdef COIN_DETAIL
   if (!returnCode) {
@@ -25,6 +25,11 @@ class OsiRowCutDebugger;
 
     initially get rid of cuts with variables >= k
     could weaken
+
+    Cuts can also be kept only if all their variables are in a given
+    subset - held as a bitmap so each index is one load and shift.
+    Either test goes over whole index array without branches (largest
+    index then or of missing bits) so compiler can vectorize it.
 */
 
 class CBCLIB_EXPORT CbcCutSubsetModifier : public CbcCutModifier {
@@ -35,6 +40,10 @@ public:
   /// Useful Constructor
   CbcCutSubsetModifier(int firstOdd);
 
+  /** Constructor from subset - cuts are deleted if any column with
+        allowed[i] zero (or >= numberColumns) is in cut */
+  CbcCutSubsetModifier(int numberColumns, const char *allowed);
+
   // Copy constructor
   CbcCutSubsetModifier(const CbcCutSubsetModifier &);
 
@@ -60,6 +69,8 @@ protected:
   /// data
   /// First odd variable
   int firstOdd_;
+  /// Bit for each column below firstOdd_ - set if allowed (or NULL if all)
+  unsigned int *allowed_;
 };
 
 #endif //CbcCutSubsetModifier_H
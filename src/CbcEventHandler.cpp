@@ -20,6 +20,9 @@ CbcEventHandler::CbcEventHandler(CbcModel *model)
   : model_(model)
   , dfltAction_(CbcEventHandler::noAction)
   , eaMap_(0)
+  , eventMask_(~0u)
+  , nodeInterval_(1)
+  , nodesSinceEvent_(0)
 { /* nothing more required */
 }
 
@@ -33,6 +36,9 @@ CbcEventHandler::CbcEventHandler(const CbcEventHandler &rhs)
   : model_(rhs.model_)
   , dfltAction_(rhs.dfltAction_)
   , eaMap_(0)
+  , eventMask_(rhs.eventMask_)
+  , nodeInterval_(rhs.nodeInterval_)
+  , nodesSinceEvent_(0)
 {
   if (rhs.eaMap_ != 0) {
     eaMap_ = new eaMapPair(*rhs.eaMap_);
@@ -48,6 +54,9 @@ CbcEventHandler::operator=(const CbcEventHandler &rhs)
   if (this != &rhs) {
     model_ = rhs.model_;
     dfltAction_ = rhs.dfltAction_;
+    eventMask_ = rhs.eventMask_;
+    nodeInterval_ = rhs.nodeInterval_;
+    nodesSinceEvent_ = 0;
     if (rhs.eaMap_ != 0) {
       eaMap_ = new eaMapPair(*rhs.eaMap_);
     } else {
@@ -54,6 +54,40 @@
 
 class CbcModel;
 
+/*! \brief Progress of branch and bound
+
+  Made every CbcModel::progressInterval() seconds and passed to
+  CbcEventHandler::event(progress, data).  Rates are since the previous
+  record.  threadBusy is only valid during the event.
+*/
+typedef struct {
+  /*! Seconds since start (as CbcModel::getCurrentSeconds) */
+  double time;
+  /*! Best solution value (1.0e100 or more if none) */
+  double bestObjective;
+  /*! Best possible objective */
+  double bestPossible;
+  /*! Relative gap (negative if no solution) */
+  double gap;
+  /*! Nodes done */
+  int numberNodes;
+  /*! Nodes on tree */
+  int numberNodesOnTree;
+  double nodesPerSecond;
+  /*! LP iterations */
+  double numberIterations;
+  double iterationsPerSecond;
+  /*! Work done (see CbcModel::workUnits) */
+  double workUnits;
+  /*! Estimated bytes used (see CbcModel::memoryUsage) */
+  double memory;
+  double memoryHighWater;
+  /*! Number of search threads (0 if none) */
+  int numberThreads;
+  /*! Fraction of time each thread has been busy (numberThreads entries) */
+  const double *threadBusy;
+} CbcProgressRecord;
+
 /*
 */
 
@@ -107,7 +141,9 @@ public:
     /*! Having generated cuts, allows user to think. */
     generatedCuts,
     /*! End of search. */
-    endSearch
+    endSearch,
+    /*! Progress report interval has arrived (data is CbcProgressRecord *). */
+    progress
   };
 
   /*! \brief Action codes returned by the event handler.
@@ -218,6 +254,65 @@ public:
     (*eaMap_)[event] = action;
   }
 
+  /*! \brief Bit of an event in event mask */
+
+  static inline unsigned int eventBit(CbcEvent event)
+  {
+    return 1u << (event - node);
+  }
+
+  /*! \brief Set events the model makes (default all).
+
+    The model does not make, or prepare data for, events not in the mask,
+    so a handler which only cares about solutions costs nothing per node.
+  */
+
+  inline void setEventMask(unsigned int mask)
+  {
+    eventMask_ = mask;
+  }
+
+  /*! \brief Get event mask */
+
+  inline unsigned int eventMask() const
+  {
+    return eventMask_;
+  }
+
+  /*! \brief Whether the model should make this event */
+
+  inline bool wanted(CbcEvent event) const
+  {
+    return (eventMask_ & eventBit(event)) != 0;
+  }
+
+  /*! \brief Make node event only every so many nodes (default 1) */
+
+  inline void setNodeInterval(int value)
+  {
+    nodeInterval_ = value > 0 ? value : 1;
+    nodesSinceEvent_ = 0;
+  }
+
+  /*! \brief Get node interval */
+
+  inline int nodeInterval() const
+  {
+    return nodeInterval_;
+  }
+
+  /*! \brief Count a node - true if node event should be made now */
+
+  inline bool nodeEventDue()
+  {
+    if ((eventMask_ & eventBit(node)) == 0)
+      return false;
+    if (++nodesSinceEvent_ < nodeInterval_)
+      return false;
+    nodesSinceEvent_ = 0;
+    return true;
+  }
+
   //@}
 
 protected:
@@ -239,6 +334,18 @@ protected:
 
   eaMapPair *eaMap_;
 
+  /*! \brief Events made by model (bit eventBit(event)) */
+
+  unsigned int eventMask_;
+
+  /*! \brief Node event made every nodeInterval_ nodes */
+
+  int nodeInterval_;
+
+  /*! \brief Nodes since last node event */
+
+  int nodesSinceEvent_;
+
   //@}
 };
 
@@ -0,0 +1,241 @@
+// Copyright (C) 2002, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#pragma warning(disable : 4786)
+#endif
+
+#include "CbcConfig.h"
+
+#include <cassert>
+#include <cstring>
+
+#include "CoinWarmStartBasis.hpp"
+#include "OsiSolverInterface.hpp"
+#include "OsiRowCut.hpp"
+#ifdef CBC_HAS_CLP
+#include "OsiClpSolverInterface.hpp"
+#include "ClpSimplex.hpp"
+#include "ClpFactorization.hpp"
+#endif
+#include "CbcFactorizationCache.hpp"
+
+// Constructor with most memory (bytes) for copies
+CbcFactorizationCache::CbcFactorizationCache(double maximumBytes)
+  : maximumBytes_(maximumBytes)
+  , bytes_(0.0)
+  , numberRows_(-1)
+  , stamp_(0)
+  , numberSaved_(0)
+  , numberRestored_(0)
+  , installed_(false)
+{
+}
+
+CbcFactorizationCache::~CbcFactorizationCache()
+{
+  clear();
+}
+
+// Forget all copies
+void CbcFactorizationCache::clear()
+{
+  for (int i = static_cast< int >(entries_.size()) - 1; i >= 0; i--)
+    deleteEntry(i);
+  cuts_.clear();
+  numberRows_ = -1;
+  installed_ = false;
+}
+
+// Free entry
+void CbcFactorizationCache::deleteEntry(int i)
+{
+  Entry &entry = entries_[i];
+#ifdef CBC_HAS_CLP
+  delete entry.factorization;
+#endif
+  delete[] entry.pivotVariable;
+  delete entry.basis;
+  bytes_ -= entry.bytes;
+  entries_[i] = entries_.back();
+  entries_.pop_back();
+}
+
+// Whether same columns and rows are basic
+static bool sameBasic(const CoinWarmStartBasis *basis1, const CoinWarmStartBasis *basis2)
+{
+  int numberColumns = basis1->getNumStructural();
+  int numberRows = basis1->getNumArtificial();
+  if (numberColumns != basis2->getNumStructural() || numberRows != basis2->getNumArtificial())
+    return false;
+  for (int i = 0; i < numberColumns; i++) {
+    if ((basis1->getStructStatus(i) == CoinWarmStartBasis::basic) != (basis2->getStructStatus(i) == CoinWarmStartBasis::basic))
+      return false;
+  }
+  for (int i = 0; i < numberRows; i++) {
+    if ((basis1->getArtifStatus(i) == CoinWarmStartBasis::basic) != (basis2->getArtifStatus(i) == CoinWarmStartBasis::basic))
+      return false;
+  }
+  return true;
+}
+
+/* Sum over cuts of bounds and elements - a cut deleted and another made
+   at the same address should not match
+*/
+static double cutsChecksum(const std::vector< const OsiRowCut * > &cuts)
+{
+  double sum = 0.0;
+  int numberCuts = static_cast< int >(cuts.size());
+  for (int i = 0; i < numberCuts; i++) {
+    const OsiRowCut *cut = cuts[i];
+    double multiplier = i + 1.0;
+    sum += multiplier * (cut->lb() + 2.0 * cut->ub());
+    const CoinPackedVector &row = cut->row();
+    int n = row.getNumElements();
+    const int *column = row.getIndices();
+    const double *element = row.getElements();
+    for (int j = 0; j < n; j++)
+      sum += multiplier * (column[j] + 1.0) * element[j];
+  }
+  return sum;
+}
+
+/* Put copy in solver if one is for these rows and basic variables.  Only
+   if Clp's own factorization is of the same number of rows as then its
+   pivot array is big enough and will not be made again.
+*/
+bool CbcFactorizationCache::restore(OsiSolverInterface *solver,
+  int numberRowsAtContinuous, int numberCuts, const OsiRowCut *const *cuts,
+  const CoinWarmStartBasis *basis)
+{
+  installed_ = false;
+  cuts_.assign(cuts, cuts + numberCuts);
+  numberRows_ = numberRowsAtContinuous + numberCuts;
+#ifdef CBC_HAS_CLP
+  OsiClpSolverInterface *clpSolver = dynamic_cast< OsiClpSolverInterface * >(solver);
+  if (!clpSolver) {
+    numberRows_ = -1;
+    return false;
+  }
+  ClpSimplex *simplex = clpSolver->getModelPtr();
+  if (simplex->numberRows() != numberRows_) {
+    numberRows_ = -1;
+    return false;
+  }
+  if (entries_.empty() || !basis)
+    return false;
+  ClpFactorization *factorization = simplex->factorization();
+  int *pivotVariable = simplex->pivotVariable();
+  if (!factorization || !pivotVariable || factorization->numberRows() != numberRows_)
+    return false;
+  int numberEntries = static_cast< int >(entries_.size());
+  bool haveChecksum = false;
+  double checksum = 0.0;
+  for (int i = 0; i < numberEntries; i++) {
+    Entry &entry = entries_[i];
+    if (entry.numberRows != numberRows_ || entry.cuts != cuts_
+      || !sameBasic(entry.basis, basis))
+      continue;
+    if (!haveChecksum) {
+      checksum = cutsChecksum(cuts_);
+      haveChecksum = true;
+    }
+    if (entry.checksum != checksum)
+      continue;
+    simplex->setFactorization(*entry.factorization);
+    memcpy(pivotVariable, entry.pivotVariable, numberRows_ * sizeof(int));
+    entry.lastUsed = ++stamp_;
+    numberRestored_++;
+    installed_ = true;
+    return true;
+  }
+#endif
+  return false;
+}
+
+/* Keep copy of factorization of solver.  Rows must be as at restore and
+   basic variables those of pivot rows (a heuristic may have set another
+   basis without solving).
+*/
+bool CbcFactorizationCache::save(OsiSolverInterface *solver)
+{
+#ifdef CBC_HAS_CLP
+  OsiClpSolverInterface *clpSolver = dynamic_cast< OsiClpSolverInterface * >(solver);
+  if (!clpSolver || numberRows_ <= 0)
+    return false;
+  ClpSimplex *simplex = clpSolver->getModelPtr();
+  int numberRows = simplex->numberRows();
+  int numberColumns = simplex->numberColumns();
+  ClpFactorization *factorization = simplex->factorization();
+  const int *pivotVariable = simplex->pivotVariable();
+  if (numberRows != numberRows_ || !factorization || !pivotVariable
+    || factorization->status() || factorization->numberRows() != numberRows)
+    return false;
+  // each basic variable once in pivot rows
+  int numberTotal = numberColumns + numberRows;
+  char *mark = new char[numberTotal];
+  memset(mark, 0, numberTotal);
+  bool good = true;
+  for (int iRow = 0; iRow < numberRows; iRow++) {
+    int iSequence = pivotVariable[iRow];
+    if (iSequence < 0 || iSequence >= numberTotal || mark[iSequence]) {
+      good = false;
+      break;
+    }
+    mark[iSequence] = 1;
+    ClpSimplex::Status status = iSequence < numberColumns
+      ? simplex->getColumnStatus(iSequence)
+      : simplex->getRowStatus(iSequence - numberColumns);
+    if (status != ClpSimplex::basic) {
+      good = false;
+      break;
+    }
+  }
+  delete[] mark;
+  if (!good)
+    return false;
+  CoinWarmStartBasis *basis = dynamic_cast< CoinWarmStartBasis * >(solver->getWarmStart());
+  if (!basis)
+    return false;
+  // rough size of copy
+  double bytes = static_cast< double >(factorization->numberElements()) * 3.0 * (sizeof(double) + sizeof(int))
+    + static_cast< double >(numberRows) * 12.0 * sizeof(int)
+    + static_cast< double >(cuts_.size()) * sizeof(const OsiRowCut *);
+  if (bytes > maximumBytes_) {
+    delete basis;
+    return false;
+  }
+  // oldest go
+  while (!entries_.empty() && bytes_ + bytes > maximumBytes_) {
+    int oldest = 0;
+    for (int i = 1; i < static_cast< int >(entries_.size()); i++) {
+      if (entries_[i].lastUsed < entries_[oldest].lastUsed)
+        oldest = i;
+    }
+    deleteEntry(oldest);
+  }
+  Entry entry;
+  entry.factorization = new ClpFactorization(*factorization);
+  entry.pivotVariable = new int[numberRows];
+  memcpy(entry.pivotVariable, pivotVariable, numberRows * sizeof(int));
+  entry.basis = basis;
+  entry.cuts = cuts_;
+  entry.checksum = cutsChecksum(cuts_);
+  entry.numberRows = numberRows;
+  entry.bytes = bytes;
+  entry.lastUsed = ++stamp_;
+  entries_.push_back(entry);
+  bytes_ += bytes;
+  numberSaved_++;
+  // not again until rows given again
+  numberRows_ = -1;
+  return true;
+#else
+  return false;
+#endif
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -0,0 +1,117 @@
+// Copyright (C) 2002, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcFactorizationCache_H
+#define CbcFactorizationCache_H
+
+#include <vector>
+
+#include "CbcConfig.h"
+
+class OsiSolverInterface;
+class OsiRowCut;
+class CoinWarmStartBasis;
+class ClpFactorization;
+
+/** Factorizations of recent node LPs kept for their children
+
+    When a node is restored Clp factorizes its basis again even if a node
+    solved a little earlier ended with that basis and the same rows - with
+    very many rows that can cost more than the iterations of the node.
+    After the LP of a node whose rows have not changed since it was
+    restored (no cuts added or taken off) a copy of the factorization is
+    kept here with the basis and the cuts (after the continuous rows) it
+    is for, oldest going when over the memory limit.  When a node is
+    restored with the same cuts and basis the copy is put in the solver
+    and takeInstalled() is true until the next solve, which should then let
+    the factorization carry over (OsiClpSolverInterface special option 8).
+
+    Cuts are compared by pointer, as when CbcModel::addCuts decides rows
+    need not be redone, and by a checksum of their rows.  A factorization is only kept if the basic columns
+    of the solver are those of its pivot rows.  Only Clp and serial search.
+    Used if CbcModel::CbcFactorizationMemory is set.
+*/
+class CBCLIB_EXPORT CbcFactorizationCache {
+
+public:
+  /// Constructor with most memory (bytes) for copies
+  CbcFactorizationCache(double maximumBytes);
+  /// Destructor
+  ~CbcFactorizationCache();
+
+  /** Solver has just been given rows (cuts after numberRowsAtContinuous)
+      and basis of node.  If a copy is for those put it in solver.
+      Returns true if so */
+  bool restore(OsiSolverInterface *solver, int numberRowsAtContinuous,
+    int numberCuts, const OsiRowCut *const *cuts,
+    const CoinWarmStartBasis *basis);
+  /** Keep factorization of solver (just solved) if rows are still those
+      given at restore.  Returns true if kept */
+  bool save(OsiSolverInterface *solver);
+  /// Whether a copy was put in solver (and clear)
+  inline bool takeInstalled()
+  {
+    bool installed = installed_;
+    installed_ = false;
+    return installed;
+  }
+  /// Number of cuts given at restore
+  inline int numberCuts() const
+  {
+    return static_cast< int >(cuts_.size());
+  }
+  /// Forget all copies
+  void clear();
+  /// Number of copies kept
+  inline int numberSaved() const
+  {
+    return numberSaved_;
+  }
+  /// Number of copies put in solver
+  inline int numberRestored() const
+  {
+    return numberRestored_;
+  }
+
+private:
+  /// Illegal copy constructor
+  CbcFactorizationCache(const CbcFactorizationCache &);
+  /// Illegal assignment operator
+  CbcFactorizationCache &operator=(const CbcFactorizationCache &);
+  /// Copy of a factorization
+  typedef struct {
+    ClpFactorization *factorization;
+    int *pivotVariable;
+    CoinWarmStartBasis *basis;
+    std::vector< const OsiRowCut * > cuts;
+    double checksum;
+    int numberRows;
+    double bytes;
+    int lastUsed;
+  } Entry;
+  /// Free entry
+  void deleteEntry(int i);
+
+  /// Copies
+  std::vector< Entry > entries_;
+  /// Cuts of rows given at last restore
+  std::vector< const OsiRowCut * > cuts_;
+  /// Most memory for copies
+  double maximumBytes_;
+  /// Memory in use
+  double bytes_;
+  /// Rows given at last restore (-1 if not known)
+  int numberRows_;
+  /// Count for least recently used
+  int stamp_;
+  int numberSaved_;
+  int numberRestored_;
+  /// Whether a copy was put in solver since last takeInstalled
+  bool installed_;
+};
+
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
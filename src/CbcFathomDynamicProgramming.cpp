@@ -39,6 +39,17 @@ CbcFathomDynamicProgramming::CbcFathomDynamicProgramming()
   , numberNonOne_(0)
   , bitPattern_(0)
   , algorithm_(-1)
+  , maximumStates_(10000000)
+  , numberStates_(0)
+  , maximumStatesSpace_(0)
+  , states_(NULL)
+  , stateCost_(NULL)
+  , stateBack_(NULL)
+  , hash_(NULL)
+  , hashSize_(0)
+  , sparseCutoff_(COIN_DBL_MAX)
+  , sparse_(false)
+  , tooManyStates_(false)
 {
 }
 
@@ -59,8 +70,20 @@ CbcFathomDynamicProgramming::CbcFathomDynamicProgramming(CbcModel &model)
   , numberNonOne_(0)
   , bitPattern_(0)
   , algorithm_(-1)
+  , maximumStates_(10000000)
+  , numberStates_(0)
+  , maximumStatesSpace_(0)
+  , states_(NULL)
+  , stateCost_(NULL)
+  , stateBack_(NULL)
+  , hash_(NULL)
+  , hashSize_(0)
+  , sparseCutoff_(COIN_DBL_MAX)
+  , sparse_(false)
+  , tooManyStates_(false)
 {
   type_ = checkPossible();
+  possible_ = type_ != -1;
 }
 
 // Destructor
@@ -87,6 +110,19 @@ void CbcFathomDynamicProgramming::gutsOfDelete()
   numberBits_ = NULL;
   rhs_ = NULL;
   coefficients_ = NULL;
+  delete[] states_;
+  delete[] stateCost_;
+  delete[] stateBack_;
+  delete[] hash_;
+  states_ = NULL;
+  stateCost_ = NULL;
+  stateBack_ = NULL;
+  hash_ = NULL;
+  numberStates_ = 0;
+  maximumStatesSpace_ = 0;
+  hashSize_ = 0;
+  sparse_ = false;
+  tooManyStates_ = false;
 }
 // Clone
 CbcFathom *
@@ -114,6 +150,17 @@ CbcFathomDynamicProgramming::CbcFathomDynamicProgramming(const CbcFathomDynamicP
   , numberNonOne_(rhs.numberNonOne_)
   , bitPattern_(rhs.bitPattern_)
   , algorithm_(rhs.algorithm_)
+  , maximumStates_(rhs.maximumStates_)
+  , numberStates_(0)
+  , maximumStatesSpace_(0)
+  , states_(NULL)
+  , stateCost_(NULL)
+  , stateBack_(NULL)
+  , hash_(NULL)
+  , hashSize_(0)
+  , sparseCutoff_(COIN_DBL_MAX)
+  , sparse_(false)
+  , tooManyStates_(false)
 {
   if (size_) {
     cost_ = CoinCopyOfArray(rhs.cost_, size_);
@@ -250,21 +297,33 @@ int CbcFathomDynamicProgramming::checkPossible(int allowableSize)
     if (gap <= 1.0)
       n01++;
   }
-  if (allowableSize && size_ <= allowableSize) {
+  // too big for arrays - may be able to keep just states reached
+  bool sparse = allowableSize && size_ > allowableSize && size_ < COIN_INT_MAX
+    && maximumStates_ > 0;
+  if (allowableSize && (size_ <= allowableSize || sparse)) {
     if (n01 == numberColumns && !nbadcoeff)
       algorithm_ = 0; // easiest
     else
       algorithm_ = 1;
   }
-  if (allowableSize && size_ <= allowableSize) {
+  if (allowableSize && (size_ <= allowableSize || sparse)) {
     numberActive_ = numberActive;
     indices_ = new int[numberActive_];
-    cost_ = new double[size_];
-    CoinFillN(cost_, size_, COIN_DBL_MAX);
-    // but do nothing is okay
-    cost_[0] = 0.0;
-    back_ = new int[size_];
-    CoinFillN(back_, size_, -1);
+    sparse_ = sparse;
+    tooManyStates_ = false;
+    if (!sparse_) {
+      cost_ = new double[size_];
+      CoinFillN(cost_, size_, COIN_DBL_MAX);
+      // but do nothing is okay
+      cost_[0] = 0.0;
+      back_ = new int[size_];
+      CoinFillN(back_, size_, -1);
+    } else {
+      // do nothing is okay
+      numberStates_ = 0;
+      int iState = addState(0);
+      stateCost_[iState] = 0.0;
+    }
     startBit_ = new int[numberActive_];
     numberBits_ = new int[numberActive_];
     lookup_ = new int[numberRows];
@@ -428,7 +487,7 @@ int CbcFathomDynamicProgramming::checkPossible(int allowableSize)
     }
   }
   delete[] rhs;
-  if (allowableSize && size_ > allowableSize) {
+  if (allowableSize && size_ > allowableSize && !sparse) {
     COIN_DETAIL_PRINT(printf("Too large - need %d entries x 8 bytes\n", size_));
     return -1; // too big
   } else {
@@ -441,12 +500,16 @@ void CbcFathomDynamicProgramming::resetModel(CbcModel *model)
 {
   model_ = model;
   type_ = checkPossible();
+  possible_ = type_ != -1;
 }
 int CbcFathomDynamicProgramming::fathom(double *&betterSolution)
 {
   int returnCode = 0;
   int type = checkPossible(maximumSizeAllowed_);
-  assert(type != -1);
+  if (type == -1) {
+    // not possible at these bounds (e.g. at a node)
+    return 0;
+  }
   if (type == -2) {
     // infeasible (so complete search done)
     return 1;
@@ -472,6 +535,18 @@ int CbcFathomDynamicProgramming::fathom(double *&betterSolution)
     solver->getDblParam(OsiObjOffset, offset);
     double fixedObj = -offset;
     int i;
+    double *mostNegative = NULL;
+    if (sparse_) {
+      // most that rest of columns could reduce cost (for cutoff on states)
+      mostNegative = new double[numberColumns + 1];
+      mostNegative[numberColumns] = 0.0;
+      for (i = numberColumns - 1; i >= 0; i--) {
+        double cost = direction * objective[i];
+        mostNegative[i] = mostNegative[i + 1] + CoinMin(cost, 0.0) * (upper[i] - lower[i]);
+      }
+      for (i = 0; i < numberColumns; i++)
+        fixedObj += lower[i] * direction * objective[i];
+    }
     // may be possible
     double bestAtTarget = COIN_DBL_MAX;
     for (i = 0; i < numberColumns; i++) {
@@ -480,9 +555,16 @@ int CbcFathomDynamicProgramming::fathom(double *&betterSolution)
       double lowerValue = lower[i];
       assert(lowerValue == floor(lowerValue));
       double cost = direction * objective[i];
-      fixedObj += lowerValue * cost;
       int gap = static_cast< int >(upper[i] - lowerValue);
       CoinBigIndex start = columnStart[i];
+      if (sparse_) {
+        sparseCutoff_ = model_->getCutoff() - fixedObj - mostNegative[i];
+        tryColumn(columnLength[i], row + start, element + start, cost, gap);
+        if (tooManyStates_)
+          break;
+        continue;
+      }
+      fixedObj += lowerValue * cost;
       tryColumn(columnLength[i], row + start, element + start, cost, gap);
       if (cost_[target_] < bestAtTarget) {
         if (model_->messageHandler()->logLevel() > 1)
@@ -490,7 +572,15 @@ int CbcFathomDynamicProgramming::fathom(double *&betterSolution)
         bestAtTarget = cost_[target_];
       }
     }
+    delete[] mostNegative;
+    if (tooManyStates_) {
+      COIN_DETAIL_PRINT(printf("Too many states - more than %d\n", maximumStates_));
+      gutsOfDelete();
+      return 0;
+    }
     returnCode = 1;
+    // states to look at
+    int numberToCheck = sparse_ ? numberStates_ : size_;
     int needed = 0;
     double bestValue = COIN_DBL_MAX;
     int iBest = -1;
@@ -505,11 +595,13 @@ int CbcFathomDynamicProgramming::fathom(double *&betterSolution)
           }
         }
       }
-      for (i = 0; i < size_; i++) {
+      for (int k = 0; k < numberToCheck; k++) {
+        i = sparse_ ? states_[k] : k;
         if ((i & needed) == needed) {
           // this one will do
-          if (cost_[i] < bestValue) {
-            bestValue = cost_[i];
+          double thisCost = sparse_ ? stateCost_[k] : cost_[i];
+          if (thisCost < bestValue) {
+            bestValue = thisCost;
             iBest = i;
           }
         }
@@ -528,7 +620,8 @@ int CbcFathomDynamicProgramming::fathom(double *&betterSolution)
           }
         }
       }
-      for (i = 0; i < size_; i++) {
+      for (int k = 0; k < numberToCheck; k++) {
+        i = sparse_ ? states_[k] : k;
         if ((i & needed) == needed) {
           // this one may do
           bool good = true;
@@ -544,8 +637,9 @@ int CbcFathomDynamicProgramming::fathom(double *&betterSolution)
               break;
             }
           }
-          if (good && cost_[i] < bestValue) {
-            bestValue = cost_[i];
+          double thisCost = sparse_ ? stateCost_[k] : cost_[i];
+          if (good && thisCost < bestValue) {
+            bestValue = thisCost;
             iBest = i;
           }
         }
@@ -561,7 +655,8 @@ int CbcFathomDynamicProgramming::fathom(double *&betterSolution)
         betterSolution = new double[numberColumns];
         memcpy(betterSolution, lower, numberColumns * sizeof(double));
         while (iBest > 0) {
-          int n = decodeBitPattern(iBest - back_[iBest], indices_, numberRows);
+          int iBack = backState(iBest);
+          int n = decodeBitPattern(iBest - iBack, indices_, numberRows);
           // Search for cheapest
           double bestCost = COIN_DBL_MAX;
           int iColumn = -1;
@@ -587,7 +682,7 @@ int CbcFathomDynamicProgramming::fathom(double *&betterSolution)
           assert(iColumn >= 0);
           betterSolution[iColumn]++;
           assert(betterSolution[iColumn] <= upper[iColumn]);
-          iBest = back_[iBest];
+          iBest = iBack;
         }
       }
       // paranoid check
@@ -647,7 +742,10 @@ bool CbcFathomDynamicProgramming::tryColumn(int numberElements, const int *rows,
       }
     }
     if (n && upper) {
-      touched = addOneColumn0(n, indices_, cost);
+      if (!sparse_)
+        touched = addOneColumn0(n, indices_, cost);
+      else
+        touched = addOneColumnSparse(n, indices_, NULL, cost);
     }
   } else {
     for (int j = 0; j < numberElements; j++) {
@@ -666,7 +764,13 @@ bool CbcFathomDynamicProgramming::tryColumn(int numberElements, const int *rows,
         }
       }
     }
-    if (n) {
+    if (n && sparse_) {
+      for (int k = 1; k <= upper; k++) {
+        if (!addOneColumnSparse(n, indices_, coefficients_, cost))
+          break; // no more copies can change anything
+        touched = true;
+      }
+    } else if (n) {
       if (algorithm_ == 1) {
         for (int k = 1; k <= upper; k++) {
           bool t = addOneColumn1(n, indices_, coefficients_, cost);
@@ -959,11 +1063,134 @@ bool CbcFathomDynamicProgramming::addOneColumn1A(int numberElements, const int *
   }
   return touched;
 }
+/* Adds one copy of column to reached states.
+   New states come only from states reached before this copy (costs are
+   saved first) so column is not used twice.
+*/
+bool CbcFathomDynamicProgramming::addOneColumnSparse(int numberElements, const int *rows,
+  const int *coefficients, double cost)
+{
+  int add = 0;
+  for (int i = 0; i < numberElements; i++) {
+    int iRow = rows[i];
+    int value = coefficients ? coefficients[i] : 1;
+    add += value << startBit_[iRow];
+  }
+  bitPattern_ = add;
+  int numberOld = numberStates_;
+  double *oldCost = CoinCopyOfArray(stateCost_, numberOld);
+  bool touched = false;
+  for (int k = 0; k < numberOld; k++) {
+    double newCost = oldCost[k] + cost;
+    if (newCost > sparseCutoff_)
+      continue;
+    int state = states_[k];
+    bool possible = true;
+    for (int i = 0; i < numberElements; i++) {
+      int iRow = rows[i];
+      int value = coefficients ? coefficients[i] : 1;
+      int level = (state >> startBit_[iRow]) & ((1 << numberBits_[iRow]) - 1);
+      if (level + value > rhs_[iRow]) {
+        possible = false;
+        break;
+      }
+    }
+    if (!possible)
+      continue;
+    int next = state + add;
+    int iNext = findState(next);
+    if (iNext < 0) {
+      iNext = addState(next);
+      if (iNext < 0) {
+        tooManyStates_ = true;
+        break;
+      }
+    }
+    if (stateCost_[iNext] > newCost) {
+      stateCost_[iNext] = newCost;
+      stateBack_[iNext] = state;
+      touched = true;
+    }
+  }
+  delete[] oldCost;
+  return touched;
+}
+// Position of state in reached states or -1
+int CbcFathomDynamicProgramming::findState(int state) const
+{
+  if (!hashSize_)
+    return -1;
+  int mask = hashSize_ - 1;
+  int iHash = (static_cast< unsigned int >(state) * 2654435761u) & mask;
+  while (hash_[iHash] >= 0) {
+    int k = hash_[iHash];
+    if (states_[k] == state)
+      return k;
+    iHash = (iHash + 1) & mask;
+  }
+  return -1;
+}
+// Adds state - returns position or -1 if too many
+int CbcFathomDynamicProgramming::addState(int state)
+{
+  if (numberStates_ == maximumStatesSpace_) {
+    if (numberStates_ >= maximumStates_)
+      return -1;
+    int newMaximum = CoinMin(CoinMax(2 * maximumStatesSpace_, 1024), maximumStates_);
+    int *tempStates = new int[newMaximum];
+    double *tempCost = new double[newMaximum];
+    int *tempBack = new int[newMaximum];
+    CoinMemcpyN(states_, numberStates_, tempStates);
+    CoinMemcpyN(stateCost_, numberStates_, tempCost);
+    CoinMemcpyN(stateBack_, numberStates_, tempBack);
+    delete[] states_;
+    delete[] stateCost_;
+    delete[] stateBack_;
+    states_ = tempStates;
+    stateCost_ = tempCost;
+    stateBack_ = tempBack;
+    maximumStatesSpace_ = newMaximum;
+    // hash at most half full
+    hashSize_ = 1;
+    while (hashSize_ < 2 * newMaximum)
+      hashSize_ <<= 1;
+    delete[] hash_;
+    hash_ = new int[hashSize_];
+    CoinFillN(hash_, hashSize_, -1);
+    int mask = hashSize_ - 1;
+    for (int k = 0; k < numberStates_; k++) {
+      int iHash = (static_cast< unsigned int >(states_[k]) * 2654435761u) & mask;
+      while (hash_[iHash] >= 0)
+        iHash = (iHash + 1) & mask;
+      hash_[iHash] = k;
+    }
+  }
+  int k = numberStates_++;
+  states_[k] = state;
+  stateCost_[k] = COIN_DBL_MAX;
+  stateBack_[k] = -1;
+  int mask = hashSize_ - 1;
+  int iHash = (static_cast< unsigned int >(state) * 2654435761u) & mask;
+  while (hash_[iHash] >= 0)
+    iHash = (iHash + 1) & mask;
+  hash_[iHash] = k;
+  return k;
+}
+// State which produced cheapest way to state
+int CbcFathomDynamicProgramming::backState(int state) const
+{
+  if (!sparse_)
+    return back_[state];
+  int k = findState(state);
+  assert(k >= 0);
+  return stateBack_[k];
+}
 // update model
 void CbcFathomDynamicProgramming::setModel(CbcModel *model)
 {
   model_ = model;
   type_ = checkPossible();
+  possible_ = type_ != -1;
 }
 // Gets bit pattern from original column
 int CbcFathomDynamicProgramming::bitPattern(int numberElements, const int *rows,
@@ -22,6 +22,12 @@
 
     The main limiting factor is size of state space.  Each 1 rhs doubles the size of the problem.
     2 or 3 rhs quadruples, 4,5,6,7 by 8 etc.
+
+    If the state space is larger than maximumSize but still fits in an int
+    only states which can be reached are kept (in a hash table) up to
+    maximumStates of them, and states which can not lead to anything
+    better than the cutoff are not kept.  If there would be more states
+    than that nothing is fathomed.
  */
 
 class CBCLIB_EXPORT CbcFathomDynamicProgramming : public CbcFathom {
@@ -64,6 +70,16 @@ public:
   {
     maximumSizeAllowed_ = value;
   }
+  /// Maximum number of reached states kept if state space too large for arrays
+  inline int maximumStates() const
+  {
+    return maximumStates_;
+  }
+  /// Set maximum number of reached states (0 switches off sparse states)
+  inline void setMaximumStates(int value)
+  {
+    maximumStates_ = value;
+  }
   /// Returns type of algorithm and sets up arrays
   int checkPossible(int allowableSize = 0);
   // set algorithm
@@ -128,6 +144,16 @@ private:
     const double *coefficients);
   /// Fills in original column (dense) from bit pattern - returning number nonzero
   int decodeBitPattern(int bitPattern, int *values, int numberRows);
+  /** Adds one copy of column to reached states (coefficients NULL if
+        all 1).  Returns true if any changes */
+  bool addOneColumnSparse(int numberElements, const int *rows,
+    const int *coefficients, double cost);
+  /// Position of state in reached states or -1
+  int findState(int state) const;
+  /// Adds state (cost COIN_DBL_MAX) returning position or -1 if too many
+  int addState(int state);
+  /// State which produced cheapest way to state
+  int backState(int state) const;
 
 protected:
   /// Size of states (power of 2 unless just one constraint)
@@ -164,6 +190,28 @@ protected:
   int bitPattern_;
   /// Current algorithm
   int algorithm_;
+  /// Maximum number of reached states
+  int maximumStates_;
+  /// Number of reached states (if sparse)
+  int numberStates_;
+  /// Space for reached states
+  int maximumStatesSpace_;
+  /// Reached states
+  int *states_;
+  /// Cost of each reached state
+  double *stateCost_;
+  /// State which produced each reached state
+  int *stateBack_;
+  /// Hash table of positions in states_ (size power of 2)
+  int *hash_;
+  /// Size of hash table
+  int hashSize_;
+  /// States more expensive than this can not give better solution
+  double sparseCutoff_;
+  /// True if states are kept sparse
+  bool sparse_;
+  /// True if too many states
+  bool tooManyStates_;
 
 private:
   /// Illegal Assignment operator
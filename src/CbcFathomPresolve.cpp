@@ -0,0 +1,123 @@
+// Copyright (C) 2004, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#pragma warning(disable : 4786)
+#endif
+#include <cassert>
+#include <cstdlib>
+#include <cmath>
+#include <cfloat>
+
+#include "OsiSolverInterface.hpp"
+#include "OsiAuxInfo.hpp"
+#include "CbcModel.hpp"
+#include "CbcSimpleInteger.hpp"
+#include "CbcFathomPresolve.hpp"
+// Searches which did not finish before no more tries
+#define CBC_PRESOLVE_GIVE_UP 5
+// Default Constructor
+CbcFathomPresolve::CbcFathomPresolve()
+  : CbcFathom()
+  , fixedFraction_(0.8)
+  , maximumNodes_(1000)
+  , numberSearches_(0)
+  , numberIncomplete_(0)
+{
+}
+
+// Constructor from model
+CbcFathomPresolve::CbcFathomPresolve(CbcModel &model)
+  : CbcFathom(model)
+  , fixedFraction_(0.8)
+  , maximumNodes_(1000)
+  , numberSearches_(0)
+  , numberIncomplete_(0)
+{
+  possible_ = true;
+}
+
+// Copy constructor
+CbcFathomPresolve::CbcFathomPresolve(const CbcFathomPresolve &rhs)
+  : CbcFathom(rhs)
+  , fixedFraction_(rhs.fixedFraction_)
+  , maximumNodes_(rhs.maximumNodes_)
+  , numberSearches_(rhs.numberSearches_)
+  , numberIncomplete_(rhs.numberIncomplete_)
+{
+}
+
+// Destructor
+CbcFathomPresolve::~CbcFathomPresolve()
+{
+}
+
+// Clone
+CbcFathom *
+CbcFathomPresolve::clone() const
+{
+  return new CbcFathomPresolve(*this);
+}
+
+// Resets stuff if model changes
+void CbcFathomPresolve::resetModel(CbcModel *model)
+{
+  model_ = model;
+  possible_ = true;
+  numberSearches_ = 0;
+  numberIncomplete_ = 0;
+}
+
+// Whether objects and solver allow subtree search
+bool CbcFathomPresolve::checkPossible() const
+{
+  if (!model_ || !model_->continuousSolver() || model_->getNumberThreads())
+    return false;
+  const OsiBabSolver *characteristics = model_->solverCharacteristics();
+  if (characteristics && characteristics->solutionAddsCuts())
+    return false;
+  // sub-model only knows about integers
+  int numberIntegers = model_->numberIntegers();
+  if (!numberIntegers || model_->numberObjects() != numberIntegers)
+    return false;
+  for (int i = 0; i < numberIntegers; i++) {
+    if (!dynamic_cast< const CbcSimpleInteger * >(model_->object(i)))
+      return false;
+  }
+  return model_->continuousSolver()->getNumCols() == model_->solver()->getNumCols();
+}
+
+int CbcFathomPresolve::fathom(double *&newSolution)
+{
+  newSolution = NULL;
+  if (!checkPossible())
+    return 0;
+  OsiSolverInterface *solver = model_->solver();
+  const double *lower = solver->getColLower();
+  const double *upper = solver->getColUpper();
+  int numberIntegers = model_->numberIntegers();
+  const int *integerVariable = model_->integerVariable();
+  int numberFixed = 0;
+  for (int i = 0; i < numberIntegers; i++) {
+    int iColumn = integerVariable[i];
+    if (lower[iColumn] == upper[iColumn])
+      numberFixed++;
+  }
+  // if all fixed LP of node is whole subtree
+  if (numberFixed == numberIntegers || numberFixed < fixedFraction_ * numberIntegers)
+    return 0;
+  numberSearches_++;
+  // any better solution is saved in model
+  int status = model_->subBranchAndBound(lower, upper, maximumNodes_);
+  if (status == 0 || status == 2)
+    return 1;
+  numberIncomplete_++;
+  if (numberIncomplete_ >= CBC_PRESOLVE_GIVE_UP && 2 * numberIncomplete_ > numberSearches_)
+    possible_ = false;
+  return 2;
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
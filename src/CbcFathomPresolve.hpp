@@ -0,0 +1,100 @@
+// Copyright (C) 2004, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcFathomPresolve_H
+#define CbcFathomPresolve_H
+
+#include "CbcFathom.hpp"
+
+//#############################################################################
+/** FathomPresolve class.
+
+    Deep in the tree many integer columns are fixed but the LP of each node
+    still has all of them.  When at least fixedFraction of the integer
+    columns are fixed at a node the subtree is searched instead on a small
+    model - the continuous problem with the bounds of the node is integer
+    presolved and given to CbcModel::subBranchAndBound.  If that search
+    finishes within maximumNodes the node is fathomed and any better
+    solution (mapped back to the columns of the model) has been saved.
+    Otherwise the node is branched on as usual.
+
+    Only problems whose objects are all simple integers can be done, and not
+    when the solver adds cuts at solutions or there are threads.  After
+    several searches which did not finish there are no more tries.
+ */
+
+class CBCLIB_EXPORT CbcFathomPresolve : public CbcFathom {
+public:
+  // Default Constructor
+  CbcFathomPresolve();
+
+  // Constructor with model - assumed before cuts
+  CbcFathomPresolve(CbcModel &model);
+  // Copy constructor
+  CbcFathomPresolve(const CbcFathomPresolve &rhs);
+
+  virtual ~CbcFathomPresolve();
+
+  /// Clone
+  virtual CbcFathom *clone() const;
+
+  /// Resets stuff if model changes
+  virtual void resetModel(CbcModel *model);
+
+  /** returns 0 if no fathoming attempted, 1 fully fathomed,
+        2 incomplete search.  Any better solution has already been given
+        to model so newSolution is left NULL.
+    */
+  virtual int fathom(double *&newSolution);
+
+  /// Fraction of integer columns which must be fixed
+  inline double fixedFraction() const
+  {
+    return fixedFraction_;
+  }
+  inline void setFixedFraction(double value)
+  {
+    fixedFraction_ = value;
+  }
+  /// Maximum nodes in search of presolved subtree
+  inline int maximumNodes() const
+  {
+    return maximumNodes_;
+  }
+  inline void setMaximumNodes(int value)
+  {
+    maximumNodes_ = value;
+  }
+  /// Number of subtrees searched
+  inline int numberSearches() const
+  {
+    return numberSearches_;
+  }
+  /// Number of searches which did not finish
+  inline int numberIncomplete() const
+  {
+    return numberIncomplete_;
+  }
+
+private:
+  /// Illegal Assignment operator
+  CbcFathomPresolve &operator=(const CbcFathomPresolve &rhs);
+  /// Whether objects and solver allow subtree search
+  bool checkPossible() const;
+
+private:
+  /// Fraction of integer columns which must be fixed
+  double fixedFraction_;
+  /// Maximum nodes in search of presolved subtree
+  int maximumNodes_;
+  /// Number of subtrees searched
+  int numberSearches_;
+  /// Number of searches which did not finish
+  int numberIncomplete_;
+};
+
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
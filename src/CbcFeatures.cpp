@@ -0,0 +1,313 @@
+// Copyright (C) 2005, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#pragma warning(disable : 4786)
+#endif
+#include <cmath>
+#include <cstring>
+
+#include "CoinHelperFunctions.hpp"
+#include "CoinPackedMatrix.hpp"
+#include "OsiSolverInterface.hpp"
+#include "CbcFeatures.hpp"
+
+static const char *featureNames[CbcFeatures::numberFeatures] = {
+  "rows", "columns", "elements", "density",
+  "binaryFraction", "generalIntegerFraction", "continuousFraction",
+  "fixedFraction", "unboundedFraction", "freeFraction",
+  "equalityFraction", "rangedFraction",
+  "rowLengthMean", "rowLengthMax", "rowLengthStdDev",
+  "columnLengthMean", "columnLengthMax", "columnLengthStdDev",
+  "singletonRowFraction", "singletonColumnFraction", "emptyColumnFraction",
+  "setPartitionFraction", "setPackingFraction", "setCoverFraction",
+  "cardinalityFraction", "knapsackFraction", "variableBoundFraction",
+  "integerRowFraction", "mixedRowFraction", "continuousRowFraction",
+  "elementMinLog10", "elementMaxLog10", "unitElementFraction",
+  "integerElementFraction",
+  "objectiveDensity", "objectiveMinLog10", "objectiveMaxLog10",
+  "integerObjectiveFraction",
+  "rhsMaxLog10", "integerRhsFraction",
+  "precedenceFraction"
+};
+// Feature for each type of row (-1 if none)
+static const int rowTypeFeature[CbcFeatures::numberRowTypes] = {
+  -1, 21, 22, 23, 24, 25, 26, 40, 27, 28, 29
+};
+
+// Name of feature i
+const char *CbcFeatures::name(int i)
+{
+  if (i < 0 || i >= numberFeatures)
+    return NULL;
+  return featureNames[i];
+}
+
+static inline double safeLog10(double value)
+{
+  return value > 0.0 ? log10(value) : 0.0;
+}
+
+static inline bool isIntegral(double value)
+{
+  return fabs(value - floor(value + 0.5)) < 1.0e-12;
+}
+
+// Type of row
+int CbcFeatures::classifyRow(const OsiSolverInterface *solver, int length,
+  const int *column, const double *element, double rowLower,
+  double rowUpper, int *numberBinary, double *lower, double *upper)
+{
+  const double *columnLower = solver->getColLower();
+  const double *columnUpper = solver->getColUpper();
+  int nBinary = 0;
+  int nGeneral = 0;
+  int nContinuous = 0;
+  bool allOne = true;
+  double sumFixed = 0.0;
+  double value1 = 0.0;
+  double value2 = 0.0;
+  bool sameType = true;
+  int lastType = -1;
+  for (int j = 0; j < length; j++) {
+    int iColumn = column[j];
+    double value = element[j];
+    if (!value)
+      continue;
+    if (columnUpper[iColumn] <= columnLower[iColumn] + 1.0e-8) {
+      sumFixed += value * columnLower[iColumn];
+      continue;
+    }
+    int type;
+    if (!solver->isInteger(iColumn)) {
+      type = 2;
+      nContinuous++;
+    } else if (columnLower[iColumn] == 0.0 && columnUpper[iColumn] == 1.0) {
+      type = 0;
+      nBinary++;
+    } else {
+      type = 1;
+      nGeneral++;
+    }
+    if (lastType >= 0 && type != lastType)
+      sameType = false;
+    lastType = type;
+    if (value != 1.0)
+      allOne = false;
+    if (nBinary + nGeneral + nContinuous == 1)
+      value1 = value;
+    else
+      value2 = value;
+  }
+  int n = nBinary + nGeneral + nContinuous;
+  double lo = rowLower > -1.0e20 ? rowLower - sumFixed : -COIN_DBL_MAX;
+  double up = rowUpper < 1.0e20 ? rowUpper - sumFixed : COIN_DBL_MAX;
+  if (numberBinary)
+    *numberBinary = nBinary;
+  if (lower)
+    *lower = lo;
+  if (upper)
+    *upper = up;
+  if (!n) {
+    return emptyRow;
+  } else if (nBinary == n) {
+    if (!allOne)
+      return knapsackRow;
+    else if (lo == 1.0 && up == 1.0)
+      return setPartitionRow;
+    else if (up == 1.0 && lo <= 0.0)
+      return setPackingRow;
+    else if (lo == 1.0 && up >= n)
+      return setCoverRow;
+    else
+      return cardinalityRow;
+  } else if (n == 2 && sameType && value1 == -value2) {
+    return precedenceRow;
+  } else if (n == 2 && nContinuous == 1) {
+    return variableBoundRow;
+  } else if (!nContinuous) {
+    return integerRow;
+  } else if (nContinuous == n) {
+    return continuousRow;
+  } else {
+    return mixedRow;
+  }
+}
+
+// Fills features
+void CbcFeatures::compute(double *features, const OsiSolverInterface *solver)
+{
+  memset(features, 0, numberFeatures * sizeof(double));
+  int numberRows = solver->getNumRows();
+  int numberColumns = solver->getNumCols();
+  const CoinPackedMatrix *columnCopy = solver->getMatrixByCol();
+  double numberElements = static_cast< double >(columnCopy->getNumElements());
+  features[0] = numberRows;
+  features[1] = numberColumns;
+  features[2] = numberElements;
+  if (numberRows && numberColumns)
+    features[3] = numberElements / (static_cast< double >(numberRows) * numberColumns);
+  const double *lower = solver->getColLower();
+  const double *upper = solver->getColUpper();
+  const double *objective = solver->getObjCoefficients();
+  const int *columnLength = columnCopy->getVectorLengths();
+  const CoinBigIndex *columnStart = columnCopy->getVectorStarts();
+  const double *element = columnCopy->getElements();
+  // pass over columns - types, lengths, coefficients and objective
+  int nBinary = 0;
+  int nGeneral = 0;
+  int nFixed = 0;
+  int nUnbounded = 0;
+  int nFree = 0;
+  int nSingleton = 0;
+  int nEmpty = 0;
+  int maximumLength = 0;
+  double sumLength2 = 0.0;
+  double smallestElement = COIN_DBL_MAX;
+  double largestElement = 0.0;
+  double nUnit = 0.0;
+  double nIntegerElement = 0.0;
+  int nObjective = 0;
+  int nIntegerObjective = 0;
+  double smallestObjective = COIN_DBL_MAX;
+  double largestObjective = 0.0;
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    if (solver->isInteger(iColumn)) {
+      if (lower[iColumn] == 0.0 && upper[iColumn] == 1.0)
+        nBinary++;
+      else
+        nGeneral++;
+    }
+    if (lower[iColumn] == upper[iColumn])
+      nFixed++;
+    if (lower[iColumn] < -1.0e20 && upper[iColumn] > 1.0e20)
+      nFree++;
+    else if (lower[iColumn] < -1.0e20 || upper[iColumn] > 1.0e20)
+      nUnbounded++;
+    int length = columnLength[iColumn];
+    if (!length)
+      nEmpty++;
+    else if (length == 1)
+      nSingleton++;
+    maximumLength = CoinMax(maximumLength, length);
+    sumLength2 += static_cast< double >(length) * length;
+    for (CoinBigIndex j = columnStart[iColumn]; j < columnStart[iColumn] + length; j++) {
+      double value = fabs(element[j]);
+      if (!value)
+        continue;
+      smallestElement = CoinMin(smallestElement, value);
+      largestElement = CoinMax(largestElement, value);
+      if (value == 1.0)
+        nUnit++;
+      if (isIntegral(value))
+        nIntegerElement++;
+    }
+    double value = fabs(objective[iColumn]);
+    if (value) {
+      nObjective++;
+      smallestObjective = CoinMin(smallestObjective, value);
+      largestObjective = CoinMax(largestObjective, value);
+      if (isIntegral(value))
+        nIntegerObjective++;
+    }
+  }
+  if (numberColumns) {
+    double n = numberColumns;
+    features[4] = nBinary / n;
+    features[5] = nGeneral / n;
+    features[6] = (numberColumns - nBinary - nGeneral) / n;
+    features[7] = nFixed / n;
+    features[8] = nUnbounded / n;
+    features[9] = nFree / n;
+    double mean = numberElements / n;
+    features[15] = mean;
+    features[16] = maximumLength;
+    features[17] = sqrt(CoinMax(0.0, sumLength2 / n - mean * mean));
+    features[19] = nSingleton / n;
+    features[20] = nEmpty / n;
+    features[34] = nObjective / n;
+  }
+  if (numberElements) {
+    features[30] = safeLog10(smallestElement);
+    features[31] = safeLog10(largestElement);
+    features[32] = nUnit / numberElements;
+    features[33] = nIntegerElement / numberElements;
+  }
+  if (nObjective) {
+    features[35] = safeLog10(smallestObjective);
+    features[36] = safeLog10(largestObjective);
+    features[37] = static_cast< double >(nIntegerObjective) / nObjective;
+  }
+  // pass over rows - senses, lengths and types
+  if (numberRows) {
+    const CoinPackedMatrix *rowCopy = solver->getMatrixByRow();
+    const int *rowLength = rowCopy->getVectorLengths();
+    const CoinBigIndex *rowStart = rowCopy->getVectorStarts();
+    const int *column = rowCopy->getIndices();
+    const double *elementByRow = rowCopy->getElements();
+    const double *rowLower = solver->getRowLower();
+    const double *rowUpper = solver->getRowUpper();
+    int nEquality = 0;
+    int nRanged = 0;
+    int nSingletonRow = 0;
+    int maximumRowLength = 0;
+    double sumRowLength2 = 0.0;
+    double largestRhs = 0.0;
+    int nRhs = 0;
+    int nIntegerRhs = 0;
+    int rowCount[numberRowTypes];
+    memset(rowCount, 0, sizeof(rowCount));
+    for (int iRow = 0; iRow < numberRows; iRow++) {
+      double lo = rowLower[iRow];
+      double up = rowUpper[iRow];
+      if (lo == up)
+        nEquality++;
+      else if (lo > -1.0e20 && up < 1.0e20)
+        nRanged++;
+      bool integralRhs = true;
+      bool anyRhs = false;
+      if (lo > -1.0e20) {
+        anyRhs = true;
+        largestRhs = CoinMax(largestRhs, fabs(lo));
+        integralRhs = isIntegral(lo);
+      }
+      if (up < 1.0e20) {
+        anyRhs = true;
+        largestRhs = CoinMax(largestRhs, fabs(up));
+        integralRhs = integralRhs && isIntegral(up);
+      }
+      if (anyRhs) {
+        nRhs++;
+        if (integralRhs)
+          nIntegerRhs++;
+      }
+      int length = rowLength[iRow];
+      if (length == 1)
+        nSingletonRow++;
+      maximumRowLength = CoinMax(maximumRowLength, length);
+      sumRowLength2 += static_cast< double >(length) * length;
+      rowCount[classifyRow(solver, length, column + rowStart[iRow],
+        elementByRow + rowStart[iRow], lo, up)]++;
+    }
+    double n = numberRows;
+    features[10] = nEquality / n;
+    features[11] = nRanged / n;
+    double mean = numberElements / n;
+    features[12] = mean;
+    features[13] = maximumRowLength;
+    features[14] = sqrt(CoinMax(0.0, sumRowLength2 / n - mean * mean));
+    features[18] = nSingletonRow / n;
+    for (int k = 0; k < numberRowTypes; k++) {
+      if (rowTypeFeature[k] >= 0)
+        features[rowTypeFeature[k]] = rowCount[k] / n;
+    }
+    features[38] = safeLog10(largestRhs);
+    if (nRhs)
+      features[39] = static_cast< double >(nIntegerRhs) / nRhs;
+  }
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -0,0 +1,77 @@
+// Copyright (C) 2005, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcFeatures_H
+#define CbcFeatures_H
+
+#include "CbcConfig.h"
+
+class OsiSolverInterface;
+
+/** Instance features for choosing parameters
+
+    A fixed vector of features of a model (sizes, column and row types,
+    lengths of rows and columns and ranges of coefficients, objective and
+    right hand sides) for use by learnt models which choose parameters or
+    threads before solving.  Only bounds, types and the matrix are looked
+    at - no LP is solved - and each feature is found in a pass over the
+    column or row copy, so cost is linear in number of elements.
+
+    Feature i is always the same quantity, so features can be stored and
+    new ones only added at the end.
+
+    Rows are typed by classifyRow, which CbcModelAnalysis uses as well.
+ */
+
+class CBCLIB_EXPORT CbcFeatures {
+public:
+  /// Number of features
+  enum {
+    numberFeatures = 41
+  };
+  /// Types of row (see classifyRow)
+  enum RowType {
+    /// no columns (after fixed ones taken out)
+    emptyRow = 0,
+    /// all binary, coefficients 1, = 1
+    setPartitionRow,
+    /// all binary, coefficients 1, <= 1
+    setPackingRow,
+    /// all binary, coefficients 1, >= 1
+    setCoverRow,
+    /// all binary, coefficients 1, other rhs
+    cardinalityRow,
+    /// all binary, other coefficients
+    knapsackRow,
+    /// one continuous and one integer
+    variableBoundRow,
+    /// two of same type with opposite coefficients
+    precedenceRow,
+    /// all integer (some general)
+    integerRow,
+    /// integer and continuous
+    mixedRow,
+    /// all continuous
+    continuousRow,
+    numberRowTypes
+  };
+  /// Name of feature i (NULL if i out of range)
+  static const char *name(int i);
+  /// Fills features (of size numberFeatures)
+  static void compute(double *features, const OsiSolverInterface *solver);
+  /** Type of row with length elements in column and element.  Columns
+      fixed by bounds are taken out first (into row bounds) and tests on
+      row bounds are on what is left.  If given numberBinary is set to
+      number of binaries left and lower and upper to row bounds less
+      fixed columns (-COIN_DBL_MAX or COIN_DBL_MAX if infinite) */
+  static int classifyRow(const OsiSolverInterface *solver, int length,
+    const int *column, const double *element, double rowLower,
+    double rowUpper, int *numberBinary = NULL, double *lower = NULL,
+    double *upper = NULL);
+};
+
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
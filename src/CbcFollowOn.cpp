@@ -31,6 +31,8 @@
 CbcFollowOn::CbcFollowOn()
   : CbcObject()
   , rhs_(NULL)
+  , followStart_(NULL)
+  , followRow_(NULL)
 {
 }
 
@@ -75,6 +77,7 @@ CbcFollowOn::CbcFollowOn(CbcModel *model)
       }
     }
   }
+  buildFollowIndex();
 }
 
 // Copy constructor
@@ -85,6 +88,13 @@ CbcFollowOn::CbcFollowOn(const CbcFollowOn &rhs)
 {
   int numberRows = matrix_.getNumRows();
   rhs_ = CoinCopyOfArray(rhs.rhs_, numberRows);
+  followStart_ = NULL;
+  followRow_ = NULL;
+  if (rhs.followStart_) {
+    int numberColumns = matrix_.getNumCols();
+    followStart_ = CoinCopyOfArray(rhs.followStart_, numberColumns + 1);
+    followRow_ = CoinCopyOfArray(rhs.followRow_, followStart_[numberColumns]);
+  }
 }
 
 // Clone
@@ -101,10 +111,19 @@ CbcFollowOn::operator=(const CbcFollowOn &rhs)
   if (this != &rhs) {
     CbcObject::operator=(rhs);
     delete[] rhs_;
+    delete[] followStart_;
+    delete[] followRow_;
     matrix_ = rhs.matrix_;
     matrixByRow_ = rhs.matrixByRow_;
     int numberRows = matrix_.getNumRows();
     rhs_ = CoinCopyOfArray(rhs.rhs_, numberRows);
+    followStart_ = NULL;
+    followRow_ = NULL;
+    if (rhs.followStart_) {
+      int numberColumns = matrix_.getNumCols();
+      followStart_ = CoinCopyOfArray(rhs.followStart_, numberColumns + 1);
+      followRow_ = CoinCopyOfArray(rhs.followRow_, followStart_[numberColumns]);
+    }
   }
   return *this;
 }
@@ -113,6 +132,35 @@ CbcFollowOn::operator=(const CbcFollowOn &rhs)
 CbcFollowOn::~CbcFollowOn()
 {
   delete[] rhs_;
+  delete[] followStart_;
+  delete[] followRow_;
+}
+// Build column to possible row index
+void CbcFollowOn::buildFollowIndex()
+{
+  int numberColumns = matrix_.getNumCols();
+  const int *row = matrix_.getIndices();
+  const CoinBigIndex *columnStart = matrix_.getVectorStarts();
+  const int *columnLength = matrix_.getVectorLengths();
+  followStart_ = new CoinBigIndex[numberColumns + 1];
+  CoinBigIndex n = 0;
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    followStart_[iColumn] = n;
+    for (CoinBigIndex j = columnStart[iColumn]; j < columnStart[iColumn] + columnLength[iColumn]; j++) {
+      if (rhs_[row[j]])
+        n++;
+    }
+  }
+  followStart_[numberColumns] = n;
+  followRow_ = new int[n];
+  n = 0;
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    for (CoinBigIndex j = columnStart[iColumn]; j < columnStart[iColumn] + columnLength[iColumn]; j++) {
+      int iRow = row[j];
+      if (rhs_[iRow])
+        followRow_[n++] = iRow;
+    }
+  }
 }
 // As some computation is needed in more than one place - returns row
 int CbcFollowOn::gutsOfFollowOn(int &otherRow, int &preferredWay) const
@@ -120,16 +168,12 @@ int CbcFollowOn::gutsOfFollowOn(int &otherRow, int &preferredWay) const
   int whichRow = -1;
   otherRow = -1;
   int numberRows = matrix_.getNumRows();
+  int numberColumns = matrix_.getNumCols();
 
   int i;
   // For sorting
   int *sort = new int[numberRows];
   int *isort = new int[numberRows];
-  // Column copy
-  //const double * element = matrix_.getElements();
-  const int *row = matrix_.getIndices();
-  const CoinBigIndex *columnStart = matrix_.getVectorStarts();
-  const int *columnLength = matrix_.getVectorLengths();
   // Row copy
   const double *elementByRow = matrixByRow_.getElements();
   const int *column = matrixByRow_.getIndices();
@@ -140,6 +184,15 @@ int CbcFollowOn::gutsOfFollowOn(int &otherRow, int &preferredWay) const
   const double *columnUpper = solver->getColUpper();
   const double *solution = solver->getColSolution();
   double integerTolerance = model_->getDblParam(CbcModel::CbcIntegerTolerance);
+  /* Fractional part of each free column (0.0 if fixed or satisfied) -
+     done once in a straight loop so the row scans below only look up */
+  double *fraction = new double[numberColumns];
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    double solValue = solution[iColumn] - columnLower[iColumn];
+    bool isFree = columnLower[iColumn] != columnUpper[iColumn];
+    bool fractional = solValue < 1.0 - integerTolerance && solValue > integerTolerance;
+    fraction[iColumn] = (isFree && fractional) ? solValue : 0.0;
+  }
   int nSort = 0;
   for (i = 0; i < numberRows; i++) {
     if (rhs_[i]) {
@@ -158,7 +211,7 @@ int CbcFollowOn::gutsOfFollowOn(int &otherRow, int &preferredWay) const
           largest = CoinMax(largest, value);
           if (value == 1.0)
             number1++;
-          if (solValue < 1.0 - integerTolerance && solValue > integerTolerance)
+          if (fraction[iColumn])
             numberUnsatisfied++;
         } else {
           rhsValue -= static_cast< int >(value * floor(solValue + 0.5));
@@ -194,22 +247,16 @@ int CbcFollowOn::gutsOfFollowOn(int &otherRow, int &preferredWay) const
       CoinBigIndex j;
       for (j = rowStart[i]; j < rowStart[i] + rowLength[i]; j++) {
         int iColumn = column[j];
-        if (columnLower[iColumn] != columnUpper[iColumn]) {
-          double solValue = solution[iColumn] - columnLower[iColumn];
-          if (solValue < 1.0 - integerTolerance && solValue > integerTolerance) {
-            numberUnsatisfied++;
-            for (CoinBigIndex jj = columnStart[iColumn]; jj < columnStart[iColumn] + columnLength[iColumn]; jj++) {
-              int iRow = row[jj];
-              if (rhs_[iRow]) {
-                other[iRow] += solValue;
-                if (isort[iRow]) {
-                  isort[iRow]++;
-                } else {
-                  isort[iRow] = 1;
-                  which[n++] = iRow;
-                }
-              }
-            }
+        double solValue = fraction[iColumn];
+        if (solValue) {
+          numberUnsatisfied++;
+          // only possible rows are in index
+          for (CoinBigIndex jj = followStart_[iColumn]; jj < followStart_[iColumn + 1]; jj++) {
+            int iRow = followRow_[jj];
+            other[iRow] += solValue;
+            if (!isort[iRow])
+              which[n++] = iRow;
+            isort[iRow]++;
           }
         }
       }
@@ -283,6 +330,7 @@ int CbcFollowOn::gutsOfFollowOn(int &otherRow, int &preferredWay) const
     delete[] which;
     delete[] other;
   }
+  delete[] fraction;
   delete[] sort;
   delete[] isort;
   return whichRow;
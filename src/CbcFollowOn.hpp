@@ -64,6 +64,14 @@ protected:
   CoinPackedMatrix matrixByRow_;
   /// Possible rhs (if 0 then not possible)
   int *rhs_;
+  /// Start of possible rows of each column (numberColumns+1)
+  CoinBigIndex *followStart_;
+  /// Possible rows (rhs_ nonzero) of each column
+  int *followRow_;
+
+private:
+  /// Build column to possible row index from matrix_ and rhs_
+  void buildFollowIndex();
 };
 
 /** General Branching Object class.
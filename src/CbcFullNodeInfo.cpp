@@ -18,6 +18,7 @@
 //#define CBC_CHECK_BASIS
 #include <cassert>
 #include <cfloat>
+#include <algorithm>
 #define CUTS
 #include "OsiSolverInterface.hpp"
 #include "OsiChooseVariable.hpp"
@@ -44,10 +45,31 @@
 using namespace std;
 #include "CglCutGenerator.hpp"
 
+// Most columns kept as differences - otherwise bounds stored in full
+#define CBC_MAXIMUM_DIFFERENT_FRACTION 0.25
+CbcSharedBounds::CbcSharedBounds(const double *lower, const double *upper, int numberColumns)
+  : numberColumns_(numberColumns)
+  , referenceCount_(1)
+{
+  lower_ = new double[2 * numberColumns];
+  upper_ = lower_ + numberColumns;
+  CoinMemcpyN(lower, numberColumns, lower_);
+  CoinMemcpyN(upper, numberColumns, upper_);
+}
+
+CbcSharedBounds::~CbcSharedBounds()
+{
+  delete[] lower_;
+}
+
 CbcFullNodeInfo::CbcFullNodeInfo()
   : CbcNodeInfo()
   , basis_()
   , numberIntegers_(0)
+  , bounds_(NULL)
+  , whichDifferent_(NULL)
+  , differentBounds_(NULL)
+  , numberDifferent_(0)
   , lower_(NULL)
   , upper_(NULL)
 {
@@ -55,39 +77,110 @@ CbcFullNodeInfo::CbcFullNodeInfo()
 CbcFullNodeInfo::CbcFullNodeInfo(CbcModel *model,
   int numberRowsAtContinuous)
   : CbcNodeInfo(NULL, model->currentNode())
+  , whichDifferent_(NULL)
+  , differentBounds_(NULL)
+  , numberDifferent_(0)
+  , lower_(NULL)
+  , upper_(NULL)
 {
   OsiSolverInterface *solver = model->solver();
   numberRows_ = numberRowsAtContinuous;
   numberIntegers_ = model->numberIntegers();
   int numberColumns = model->getNumCols();
-  lower_ = new double[numberColumns];
-  upper_ = new double[numberColumns];
+  bounds_ = new CbcSharedBounds(solver->getColLower(), solver->getColUpper(),
+    numberColumns);
+
+  basis_ = dynamic_cast< CoinWarmStartBasis * >(solver->getWarmStart());
+}
+
+CbcFullNodeInfo::CbcFullNodeInfo(CbcModel *model, CbcNode *owner,
+  const double *lower, const double *upper,
+  CoinWarmStartBasis *basis, int numberRowsAtContinuous)
+  : CbcNodeInfo(NULL, owner)
+  , basis_(basis)
+  , whichDifferent_(NULL)
+  , differentBounds_(NULL)
+  , numberDifferent_(0)
+  , lower_(NULL)
+  , upper_(NULL)
+{
+  numberRows_ = numberRowsAtContinuous;
+  numberIntegers_ = model->numberIntegers();
+  int numberColumns = model->getNumCols();
+  bounds_ = new CbcSharedBounds(lower, upper, numberColumns);
+}
+
+/* Checkpoint - bounds are differences from bounds of nearest full node
+   info above (if not too many)
+*/
+CbcFullNodeInfo::CbcFullNodeInfo(CbcModel *model, CbcNodeInfo *parent,
+  CbcNode *owner, CoinWarmStartBasis *basis)
+  : CbcNodeInfo(parent, owner)
+  , basis_(basis)
+  , bounds_(NULL)
+  , whichDifferent_(NULL)
+  , differentBounds_(NULL)
+  , numberDifferent_(0)
+  , lower_(NULL)
+  , upper_(NULL)
+{
+  OsiSolverInterface *solver = model->solver();
+  numberIntegers_ = model->numberIntegers();
+  int numberColumns = model->getNumCols();
   const double *lower = solver->getColLower();
   const double *upper = solver->getColUpper();
-  int i;
-
-  for (i = 0; i < numberColumns; i++) {
-    lower_[i] = lower[i];
-    upper_[i] = upper[i];
+  const CbcFullNodeInfo *above = NULL;
+  for (CbcNodeInfo *info = parent; info && !above; info = info->parent())
+    above = dynamic_cast< const CbcFullNodeInfo * >(info);
+  CbcSharedBounds *shared = above ? above->bounds_ : NULL;
+  if (shared && shared->numberColumns_ == numberColumns) {
+    int maximumDifferent = static_cast< int >(CBC_MAXIMUM_DIFFERENT_FRACTION * numberColumns);
+    int *which = new int[maximumDifferent + 1];
+    int n = 0;
+    for (int i = 0; i < numberColumns; i++) {
+      if (lower[i] != shared->lower_[i] || upper[i] != shared->upper_[i]) {
+        if (n == maximumDifferent) {
+          n = -1;
+          break;
+        }
+        which[n++] = i;
+      }
+    }
+    if (n >= 0) {
+      bounds_ = shared;
+      bounds_->referenceCount_++;
+      numberDifferent_ = n;
+      if (n) {
+        whichDifferent_ = CoinCopyOfArray(which, n);
+        differentBounds_ = new double[2 * n];
+        for (int i = 0; i < n; i++) {
+          differentBounds_[i] = lower[which[i]];
+          differentBounds_[i + n] = upper[which[i]];
+        }
+      }
+    }
+    delete[] which;
   }
-
-  basis_ = dynamic_cast< CoinWarmStartBasis * >(solver->getWarmStart());
+  if (!bounds_)
+    bounds_ = new CbcSharedBounds(lower, upper, numberColumns);
 }
 
 CbcFullNodeInfo::CbcFullNodeInfo(const CbcFullNodeInfo &rhs)
   : CbcNodeInfo(rhs)
+  , bounds_(rhs.bounds_)
+  , whichDifferent_(NULL)
+  , differentBounds_(NULL)
+  , numberDifferent_(rhs.numberDifferent_)
+  , lower_(NULL)
+  , upper_(NULL)
 {
   basis_ = dynamic_cast< CoinWarmStartBasis * >(rhs.basis_->clone());
   numberIntegers_ = rhs.numberIntegers_;
-  lower_ = NULL;
-  upper_ = NULL;
-  if (rhs.lower_ != NULL) {
-    int numberColumns = basis_->getNumStructural();
-    lower_ = new double[numberColumns];
-    upper_ = new double[numberColumns];
-    assert(upper_ != NULL);
-    memcpy(lower_, rhs.lower_, numberColumns * sizeof(double));
-    memcpy(upper_, rhs.upper_, numberColumns * sizeof(double));
+  if (bounds_)
+    bounds_->referenceCount_++;
+  if (numberDifferent_) {
+    whichDifferent_ = CoinCopyOfArray(rhs.whichDifferent_, numberDifferent_);
+    differentBounds_ = CoinCopyOfArray(rhs.differentBounds_, 2 * numberDifferent_);
   }
 }
 
@@ -100,8 +193,115 @@ CbcFullNodeInfo::clone() const
 CbcFullNodeInfo::~CbcFullNodeInfo()
 {
   delete basis_;
+  freeBounds();
+}
+
+// Stop using bounds
+void CbcFullNodeInfo::freeBounds()
+{
+  if (bounds_ && !--bounds_->referenceCount_)
+    delete bounds_;
+  bounds_ = NULL;
+  delete[] whichDifferent_;
+  delete[] differentBounds_;
   delete[] lower_;
-  delete[] upper_;
+  whichDifferent_ = NULL;
+  differentBounds_ = NULL;
+  lower_ = NULL;
+  upper_ = NULL;
+  numberDifferent_ = 0;
+}
+
+// Bounds of one column
+void CbcFullNodeInfo::columnBounds(int iColumn, double &lower, double &upper) const
+{
+  if (numberDifferent_) {
+    const int *position = std::lower_bound(whichDifferent_,
+      whichDifferent_ + numberDifferent_, iColumn);
+    if (position != whichDifferent_ + numberDifferent_ && *position == iColumn) {
+      int i = static_cast< int >(position - whichDifferent_);
+      lower = differentBounds_[i];
+      upper = differentBounds_[i + numberDifferent_];
+      return;
+    }
+  }
+  lower = bounds_->lower_[iColumn];
+  upper = bounds_->upper_[iColumn];
+}
+
+// Make full arrays lower_ and upper_ from differences
+void CbcFullNodeInfo::expandBounds() const
+{
+  if (lower_ || !bounds_)
+    return;
+  int numberColumns = bounds_->numberColumns_;
+  lower_ = new double[2 * numberColumns];
+  upper_ = lower_ + numberColumns;
+  getBounds(lower_, upper_);
+}
+
+// Make bounds_ full and not shared (before changing them)
+void CbcFullNodeInfo::makeBoundsOwn()
+{
+  if (!bounds_ || (bounds_->referenceCount_ == 1 && !numberDifferent_))
+    return;
+  int numberColumns = bounds_->numberColumns_;
+  double *lower = new double[2 * numberColumns];
+  double *upper = lower + numberColumns;
+  getBounds(lower, upper);
+  freeBounds();
+  bounds_ = new CbcSharedBounds(lower, upper, numberColumns);
+  delete[] lower;
+}
+
+// Copy bounds into full arrays
+void CbcFullNodeInfo::getBounds(double *lower, double *upper) const
+{
+  int numberColumns = bounds_->numberColumns_;
+  CoinMemcpyN(bounds_->lower_, numberColumns, lower);
+  CoinMemcpyN(bounds_->upper_, numberColumns, upper);
+  for (int i = 0; i < numberDifferent_; i++) {
+    int iColumn = whichDifferent_[i];
+    lower[iColumn] = differentBounds_[i];
+    upper[iColumn] = differentBounds_[i + numberDifferent_];
+  }
+}
+
+// Bytes used for bounds (shared part divided among sharers)
+double CbcFullNodeInfo::boundsBytes() const
+{
+  if (!bounds_)
+    return 0.0;
+  double bytes = (2.0 * sizeof(double) * bounds_->numberColumns_) / bounds_->referenceCount_;
+  bytes += numberDifferent_ * (sizeof(int) + 2.0 * sizeof(double));
+  if (lower_)
+    bytes += 2.0 * sizeof(double) * bounds_->numberColumns_;
+  return bytes;
+}
+
+// Whether bounds are same as those given
+bool CbcFullNodeInfo::sameBounds(const double *lower, const double *upper) const
+{
+  int numberColumns = bounds_->numberColumns_;
+  if (!numberDifferent_)
+    return !memcmp(lower, bounds_->lower_, numberColumns * sizeof(double))
+      && !memcmp(upper, bounds_->upper_, numberColumns * sizeof(double));
+  int iDifferent = 0;
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    double lowerValue;
+    double upperValue;
+    if (iDifferent < numberDifferent_ && whichDifferent_[iDifferent] == iColumn) {
+      lowerValue = differentBounds_[iDifferent];
+      upperValue = differentBounds_[iDifferent + numberDifferent_];
+      iDifferent++;
+    } else {
+      lowerValue = bounds_->lower_[iColumn];
+      upperValue = bounds_->upper_[iColumn];
+    }
+    if (lower[iColumn] != lowerValue || upper[iColumn] != upperValue)
+      return false;
+  }
+  return true;
 }
 
 /*
@@ -133,17 +333,34 @@ void CbcFullNodeInfo::applyToModel(CbcModel *model,
     return;
   // branch - do bounds
   assert((active_ & ~16) == 7 || (active_ & ~16) == 15);
+  solver->setColLower(bounds_->lower_);
+  solver->setColUpper(bounds_->upper_);
+  for (int i = 0; i < numberDifferent_; i++) {
+    int iColumn = whichDifferent_[i];
+    solver->setColBounds(iColumn, differentBounds_[i],
+      differentBounds_[i + numberDifferent_]);
+  }
+  applyBasisAndCuts(model, basis, addCuts, currentNumberCuts);
+}
+
+// As applyToModel but leaves bounds alone
+void CbcFullNodeInfo::applyBasisAndCuts(CbcModel *model,
+  CoinWarmStartBasis *&basis,
+  CbcCountRowCut **addCuts,
+  int &currentNumberCuts) const
+{
+  // may be end game
+  if (!active_)
+    return;
   int i;
-  solver->setColLower(lower_);
-  solver->setColUpper(upper_);
   if (basis) {
     int numberColumns = model->getNumCols();
     // move basis - but make sure size stays
     // for bon-min - should not be needed int numberRows = model->getNumRows();
     int numberRows = basis->getNumArtificial();
-    delete basis;
     if (basis_) {
-      basis = dynamic_cast< CoinWarmStartBasis * >(basis_->clone());
+      // copy into basis so its arrays are reused (no allocation per node)
+      *basis = *basis_;
       basis->resize(numberRows, numberColumns);
 #ifdef CBC_CHECK_BASIS
       std::cout << "Basis (after applying root " << this << ") " << std::endl;
@@ -151,33 +368,40 @@ void CbcFullNodeInfo::applyToModel(CbcModel *model,
 #endif
     } else {
       // We have a solver without a basis
+      delete basis;
       basis = NULL;
     }
   }
   for (i = 0; i < numberCuts_; i++)
     addCuts[currentNumberCuts + i] = cuts_[i];
   currentNumberCuts += numberCuts_;
-  assert(!parent_);
   return;
 }
 // Just apply bounds to one variable (1=>infeasible)
 int CbcFullNodeInfo::applyBounds(int iColumn, double &lower, double &upper, int force)
 {
+  if (force & 3)
+    makeBoundsOwn();
+  double *lowerBound = bounds_->lower_;
+  double *upperBound = bounds_->upper_;
+  double lowerValue;
+  double upperValue;
+  columnBounds(iColumn, lowerValue, upperValue);
   if ((force & 1) == 0) {
-    if (lower > lower_[iColumn])
-      COIN_DETAIL_PRINT(printf("%d odd lower going from %g to %g\n", iColumn, lower, lower_[iColumn]));
-    lower = lower_[iColumn];
+    if (lower > lowerValue)
+      COIN_DETAIL_PRINT(printf("%d odd lower going from %g to %g\n", iColumn, lower, lowerValue));
+    lower = lowerValue;
   } else {
-    lower_[iColumn] = lower;
+    lowerBound[iColumn] = lowerValue = lower;
   }
   if ((force & 2) == 0) {
-    if (upper < upper_[iColumn])
-      COIN_DETAIL_PRINT(printf("%d odd upper going from %g to %g\n", iColumn, upper, upper_[iColumn]));
-    upper = upper_[iColumn];
+    if (upper < upperValue)
+      COIN_DETAIL_PRINT(printf("%d odd upper going from %g to %g\n", iColumn, upper, upperValue));
+    upper = upperValue;
   } else {
-    upper_[iColumn] = upper;
+    upperBound[iColumn] = upperValue = upper;
   }
-  return (upper_[iColumn] >= lower_[iColumn]) ? 0 : 1;
+  return (upperValue >= lowerValue) ? 0 : 1;
 }
 
 /* Builds up row basis backwards (until original model).
@@ -189,8 +413,8 @@ CbcFullNodeInfo::buildRowBasis(CoinWarmStartBasis &basis) const
 {
   const unsigned int *saved = reinterpret_cast< const unsigned int * >(basis_->getArtificialStatus());
   unsigned int *now = reinterpret_cast< unsigned int * >(basis.getArtificialStatus());
-  int number = basis_->getNumArtificial() >> 4;
-  ;
+  // checkpoint may have more rows than basis being built
+  int number = CoinMin(basis_->getNumArtificial(), basis.getNumArtificial()) >> 4;
   int i;
   for (i = 0; i < number; i++) {
     if (!now[i])
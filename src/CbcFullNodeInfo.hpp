@@ -65,15 +65,49 @@ class CbcGeneralBranchingObject;
   differences from the parent.
 */
 
+/** Column bounds which several full node infos may share
+
+  Reference counted - like the reference counts of node infos this
+  relies on tree changes being done by one thread at a time.
+*/
+
+class CBCLIB_EXPORT CbcSharedBounds {
+public:
+  /// Constructor - copies bounds
+  CbcSharedBounds(const double *lower, const double *upper, int numberColumns);
+  /// Destructor
+  ~CbcSharedBounds();
+
+  /// Lower bounds (then upper bounds)
+  double *lower_;
+  /// Upper bounds
+  double *upper_;
+  int numberColumns_;
+  int referenceCount_;
+
+private:
+  /// Illegal copy constructor
+  CbcSharedBounds(const CbcSharedBounds &);
+  /// Illegal assignment operator
+  CbcSharedBounds &operator=(const CbcSharedBounds &);
+};
+
 /** \brief Holds complete information for recreating a subproblem.
 
   A CbcFullNodeInfo object contains all necessary information (bounds, basis,
   and cuts) required to recreate a subproblem.
 
-  \todo While there's no explicit statement, the code often makes the implicit
-	assumption that an CbcFullNodeInfo structure will appear only at the
-	root node of the search tree. Things will break if this assumption
-	is violated.
+  Normally a CbcFullNodeInfo object appears only at the root node of the
+  search tree.  A node deep in the tree may also get one (a checkpoint,
+  which still has a parent) so that restoring its descendants need only
+  apply the edits below it; see CbcNode::createInfo.  Ancestors of a
+  checkpoint then only contribute their cuts (see CbcModel::addCuts1).
+
+  Bounds are not copied for each full node info.  Clones share the
+  bounds, and a checkpoint shares the bounds of the nearest full node
+  info above it and keeps only the columns which differ.  Full arrays are
+  made only if asked for with lower() or upper(), and bounds are made
+  private before they are changed.
 */
 
 class CBCLIB_EXPORT CbcFullNodeInfo : public CbcNodeInfo {
@@ -92,6 +126,11 @@ public:
     CbcCountRowCut **addCuts,
     int &currentNumberCuts) const;
 
+  /// As applyToModel but leaves bounds alone
+  virtual void applyBasisAndCuts(CbcModel *model, CoinWarmStartBasis *&basis,
+    CbcCountRowCut **addCuts,
+    int &currentNumberCuts) const;
+
   /// Just apply bounds to one variable - force means overwrite by lower,upper (1=>infeasible)
   virtual int applyBounds(int iColumn, double &lower, double &upper, int force);
 
@@ -108,6 +147,23 @@ public:
   CbcFullNodeInfo(CbcModel *model,
     int numberRowsAtContinuous);
 
+  /** Constructor from stored bounds and basis
+
+      Used to recreate a node which was taken out of the tree (for example
+      spilled to disk).  Takes ownership of \p basis.
+    */
+  CbcFullNodeInfo(CbcModel *model, CbcNode *owner,
+    const double *lower, const double *upper,
+    CoinWarmStartBasis *basis, int numberRowsAtContinuous);
+
+  /** Constructor for checkpoint from current solver bounds
+
+      Keeps \p parent for cuts and reference counts.  Takes ownership of
+      \p basis which should include all cuts down to this node.
+    */
+  CbcFullNodeInfo(CbcModel *model, CbcNodeInfo *parent, CbcNode *owner,
+    CoinWarmStartBasis *basis);
+
   // Copy constructor
   CbcFullNodeInfo(const CbcFullNodeInfo &);
 
@@ -116,36 +172,67 @@ public:
 
   /// Clone
   virtual CbcNodeInfo *clone() const;
-  /// Lower bounds
+  /// True if checkpoint part way down tree (rather than root)
+  inline bool isCheckpoint() const
+  {
+    return parent_ != NULL;
+  }
+  /// Whether there are bounds
+  inline bool hasBounds() const
+  {
+    return bounds_ != NULL;
+  }
+  /// Lower bounds (full array made if only differences stored)
   inline const double *lower() const
   {
+    if (!numberDifferent_)
+      return bounds_ ? bounds_->lower_ : NULL;
+    expandBounds();
     return lower_;
   }
   /// Set a bound
   inline void setColLower(int sequence, double value)
   {
-    lower_[sequence] = value;
+    makeBoundsOwn();
+    bounds_->lower_[sequence] = value;
   }
   /// Mutable lower bounds
-  inline double *mutableLower() const
+  inline double *mutableLower()
   {
-    return lower_;
+    makeBoundsOwn();
+    return bounds_ ? bounds_->lower_ : NULL;
   }
-  /// Upper bounds
+  /// Upper bounds (full array made if only differences stored)
   inline const double *upper() const
   {
+    if (!numberDifferent_)
+      return bounds_ ? bounds_->upper_ : NULL;
+    expandBounds();
     return upper_;
   }
   /// Set a bound
   inline void setColUpper(int sequence, double value)
   {
-    upper_[sequence] = value;
+    makeBoundsOwn();
+    bounds_->upper_[sequence] = value;
   }
   /// Mutable upper bounds
-  inline double *mutableUpper() const
+  inline double *mutableUpper()
   {
-    return upper_;
+    makeBoundsOwn();
+    return bounds_ ? bounds_->upper_ : NULL;
   }
+  /// Copy bounds into full arrays
+  void getBounds(double *lower, double *upper) const;
+  /// Whether bounds are same as those given
+  bool sameBounds(const double *lower, const double *upper) const;
+  /// Number of columns stored as differences from shared bounds
+  inline int numberDifferent() const
+  {
+    return numberDifferent_;
+  }
+  /// Bytes used for bounds (shared part divided among sharers)
+  double boundsBytes() const;
 
 protected:
   // Data
@@ -156,13 +243,28 @@ protected:
     */
   CoinWarmStartBasis *basis_;
   int numberIntegers_;
-  // Bounds stored in full
-  double *lower_;
-  double *upper_;
+  /// Bounds (shared) - columns in whichDifferent_ are overridden
+  CbcSharedBounds *bounds_;
+  /// Columns with bounds different from bounds_ (sorted)
+  int *whichDifferent_;
+  /// Lower bounds of columns in whichDifferent_ (then upper)
+  double *differentBounds_;
+  int numberDifferent_;
+  /// Full bounds made from differences when asked for (else NULL)
+  mutable double *lower_;
+  mutable double *upper_;
 
 private:
   /// Illegal Assignment operator
   CbcFullNodeInfo &operator=(const CbcFullNodeInfo &rhs);
+  /// Bounds of one column
+  void columnBounds(int iColumn, double &lower, double &upper) const;
+  /// Make full arrays lower_ and upper_ from differences
+  void expandBounds() const;
+  /// Make bounds_ full and not shared (before changing them)
+  void makeBoundsOwn();
+  /// Stop using bounds
+  void freeBounds();
 };
 #endif //CbcFullNodeInfo_H
 
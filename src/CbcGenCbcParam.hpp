@@ -57,10 +57,14 @@ public:
     MINIMIZE,
     MIPOPTIONS,
     MOREMIPOPTIONS,
+    MULTIPLEROOTS,
     NUMBERANALYZE,
     NUMBERBEFORE,
     NUMBERMINI,
+    PARALLELCUTS,
+    PROGRESSREPORT,
     STRONGBRANCHING,
+    THREADS,
     TIMELIMIT_BAB,
 
     CBCCBC_LASTPARAM
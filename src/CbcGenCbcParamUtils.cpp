@@ -142,6 +142,16 @@ void addCbcCbcParams(int &numberParameters, CoinParamVec &parameters,
     "more!MipOptions", "More dubious options for mip", -1, COIN_INT_MAX, 0, false);
   parameters.push_back(param);
 
+  param = new CbcCbcParam(CbcCbcParam::MULTIPLEROOTS,
+    "multiple!RootPasses",
+    "Do multiple root passes to collect cuts and solutions",
+    0, 9999, model->getMultipleRootTries());
+  param->setPushFunc(pushCbcCbcInt);
+  param->setObj(model);
+  param->setLongHelp(
+    "Solve (in parallel, if threads are enabled) the root phase this number of times, each with its own different seed, and collect all solutions and cuts generated. The format is bbcc where if bb is non zero, then it is number of threads to use (otherwise uses threads setting) and cc is the number of times to do root phase.  Unlike cbc, repeated passes (aabbcc) are not done by cbc-generic.");
+  parameters.push_back(param);
+
   param = new CbcCbcParam(CbcCbcParam::NUMBERMINI,
     "miniT!ree", "Size of fast mini tree", 0, COIN_INT_MAX, 0, false);
   param->setObj(model);
@@ -165,6 +175,26 @@ void addCbcCbcParams(int &numberParameters, CoinParamVec &parameters,
     "The default is 100 passes if less than 500 columns, 100 passes (but stop if the drop is small) if less than 5000 columns, 20 otherwise.");
   parameters.push_back(param);
 
+#ifdef CBC_THREAD
+  param = new CbcCbcParam(CbcCbcParam::PARALLELCUTS,
+    "parallelC!uts", "Whether to run cut generators in parallel at tree nodes",
+    0, 1, model->getIntParam(CbcModel::CbcParallelTreeCuts));
+  param->setPushFunc(pushCbcCbcInt);
+  param->setObj(model);
+  param->setLongHelp(
+    "If 1 and threads are set, tree search is serial and the threads are used instead to run cut generators in parallel at tree nodes (as threads 200+n does at the root).  Results do not depend on timing.");
+  parameters.push_back(param);
+#endif
+
+  param = new CbcCbcParam(CbcCbcParam::PROGRESSREPORT,
+    "progress!Report", "Seconds between progress records",
+    0.0, 1.0e12, model->progressInterval());
+  param->setPushFunc(pushCbcCbcDbl);
+  param->setObj(model);
+  param->setLongHelp(
+    "If positive, every this many seconds of branch and cut a progress record (best solution, best possible, gap, nodes, iterations per second, memory and busy fraction of each thread) is written to standard error as a line of JSON.  0 switches off.");
+  parameters.push_back(param);
+
   param = new CbcCbcParam(CbcCbcParam::GAPRATIO,
     "ratio!Gap",
     "Stop when the gap between the best possible solution and the incumbent is less than this fraction of the larger of the two",
@@ -192,6 +222,17 @@ void addCbcCbcParams(int &numberParameters, CoinParamVec &parameters,
     "In order to decide which variable to branch on, the code will choose up to this number of unsatisfied variables and try mini up and down branches.  The most effective one is chosen. If a variable is branched on many times then the previous average up and down costs may be used - see number before trust.");
   parameters.push_back(param);
 
+#ifdef CBC_THREAD
+  param = new CbcCbcParam(CbcCbcParam::THREADS,
+    "thread!s", "Number of threads to try and use",
+    0, 100000, model->getNumberThreads() + 100 * model->getThreadMode());
+  param->setPushFunc(pushCbcCbcInt);
+  param->setObj(model);
+  param->setLongHelp(
+    "To use multiple threads, set threads to number wanted.  It may be better to use one or two more than number of cpus available.  If 100+n then n threads and search is repeatable (maybe be somewhat slower), if 200+n use threads for root cuts, 400+n threads used in sub-trees.");
+  parameters.push_back(param);
+#endif
+
   param = new CbcCbcParam(CbcCbcParam::NUMBERBEFORE,
     "trust!PseudoCosts", "Number of branches before we trust pseudocosts",
     -1, 2000000, model->numberBeforeTrust());
@@ -307,6 +348,11 @@ int pushCbcCbcDbl(CoinParam *param)
     key = CbcModel::CbcCurrentCutoff;
     break;
   }
+  case CbcCbcParam::PROGRESSREPORT: {
+    // JSON lines on standard error
+    model->setProgressReport(val, 2);
+    return (retval);
+  }
   default: {
     std::cerr << "pushCbcCbcDbl: no equivalent CbcDblParam for "
               << "parameter code `" << code << "'." << std::endl;
@@ -362,6 +408,20 @@ int pushCbcCbcInt(CoinParam *param)
     model->setNumberBeforeTrust(val);
     break;
   }
+  case CbcCbcParam::MULTIPLEROOTS: {
+    model->setMultipleRootTries(val);
+    break;
+  }
+  case CbcCbcParam::PARALLELCUTS: {
+    key = CbcModel::CbcParallelTreeCuts;
+    break;
+  }
+  case CbcCbcParam::THREADS: {
+    // as cbc - 100, 200 and 400 are thread mode
+    model->setNumberThreads(val % 100);
+    model->setThreadMode(CoinMin(val / 100, 7));
+    break;
+  }
   default: {
     std::cerr << "pushCbcCbcInt: no equivalent CbcIntParam for "
               << "parameter code `" << code << "'." << std::endl;
@@ -24,6 +24,9 @@
 #include "CbcHeuristicDive.hpp"
 #include "CoinSort.hpp"
 #include "CoinError.hpp"
+#ifdef CBC_THREAD
+#include "CbcThread.hpp"
+#endif
 
 #ifdef CBC_HAS_CLP
 #include "OsiClpSolverInterface.hpp"
@@ -189,12 +192,6 @@ CbcGeneralDepth::infeasibility(const OsiBranchingInformation * /*info*/,
           numberDownInfeasible,
           numberUpInfeasible, numberIntegers);
         info->presolveType_ = 1;
-        delete[] down;
-        delete[] up;
-        delete[] numberDown;
-        delete[] numberUp;
-        delete[] numberDownInfeasible;
-        delete[] numberUpInfeasible;
         bool takeHint;
         OsiHintStrength strength;
         solver->getHintParam(OsiDoReducePrint, takeHint, strength);
@@ -203,7 +200,19 @@ CbcGeneralDepth::infeasibility(const OsiBranchingInformation * /*info*/,
         if (strength != OsiHintIgnore && takeHint && saveLevel == 1)
           simplex->setLogLevel(0);
         clpSolver->setBasis();
-        whichSolution_ = simplex->fathomMany(info);
+        whichSolution_ = -2;
+        if (model_->getIntParam(CbcModel::CbcParallelMiniTree))
+          whichSolution_ = fathomManyOnThreads(clpSolver, down, up, priority,
+            numberDown, numberUp, numberDownInfeasible, numberUpInfeasible);
+        if (whichSolution_ == -2)
+          whichSolution_ = simplex->fathomMany(info);
+        delete[] down;
+        delete[] up;
+        delete[] priority;
+        delete[] numberDown;
+        delete[] numberUp;
+        delete[] numberDownInfeasible;
+        delete[] numberUpInfeasible;
         //printf("FAT %d nodes, %d iterations\n",
         //info->numberNodesExplored_,info->numberIterations_);
         //printf("CbcBranch %d rows, %d columns\n",clpSolver->getNumRows(),
@@ -298,6 +307,129 @@ CbcGeneralDepth::infeasibility(const OsiBranchingInformation * /*info*/,
   }
 }
 
+#ifdef CBC_THREAD
+/*
+  Mini tree on threads (CbcModel::CbcParallelMiniTree).  Tree is split at
+  its root on most fractional integer and each half is explored by
+  fathomMany on its own clone of solver with one less level.  Nodes of
+  down half then up half are moved into nodeInfo_ and pseudo cost totals
+  of halves are added, so result does not depend on timing.
+*/
+typedef struct {
+  OsiClpSolverInterface *solver;
+  ClpNodeStuff *info;
+  int whichSolution;
+} CbcMiniTreeHalf;
+static void *doMiniTreeHalf(void *voidInfo)
+{
+  CbcMiniTreeHalf *half = reinterpret_cast< CbcMiniTreeHalf * >(voidInfo);
+  half->whichSolution = half->solver->getModelPtr()->fathomMany(half->info);
+  return NULL;
+}
+#endif
+// Explore mini tree as two halves on threads
+int CbcGeneralDepth::fathomManyOnThreads(OsiClpSolverInterface *clpSolver,
+  const double *down, const double *up, const int *priority,
+  const int *numberDown, const int *numberUp,
+  const int *numberDownInfeasible, const int *numberUpInfeasible) const
+{
+#ifdef CBC_THREAD
+  int maximumNodes = maximumNodes_ / 2;
+  if (maximumDepth_ < 2 || maximumNodes < 2 || model_->getNumberThreads() < 2
+    || model_->master() || model_->masterThread())
+    return -2;
+  // most fractional integer
+  int numberIntegers = model_->numberIntegers();
+  const int *integerVariable = model_->integerVariable();
+  const double *solution = clpSolver->getColSolution();
+  double integerTolerance = model_->getIntegerTolerance();
+  int splitColumn = -1;
+  double splitValue = 0.0;
+  double bestAway = integerTolerance;
+  for (int i = 0; i < numberIntegers; i++) {
+    int iColumn = integerVariable[i];
+    double value = solution[iColumn];
+    double away = fabs(value - floor(value + 0.5));
+    if (away > bestAway) {
+      bestAway = away;
+      splitColumn = iColumn;
+      splitValue = value;
+    }
+  }
+  if (splitColumn < 0)
+    return -2;
+  CbcMiniTreeHalf half[2];
+  for (int way = 0; way < 2; way++) {
+    OsiClpSolverInterface *solver = dynamic_cast< OsiClpSolverInterface * >(clpSolver->clone());
+    if (!way)
+      solver->setColUpper(splitColumn, floor(splitValue));
+    else
+      solver->setColLower(splitColumn, ceil(splitValue));
+    solver->setBasis();
+    ClpNodeStuff *info = new ClpNodeStuff(*nodeInfo_);
+    info->fillPseudoCosts(down, up, priority, numberDown, numberUp,
+      numberDownInfeasible, numberUpInfeasible, numberIntegers);
+    info->maximumNodes_ = maximumNodes;
+    info->nDepth_ = maximumDepth_ - 1;
+    if (!info->nodeInfo_) {
+      ClpNode **nodeInfo = new ClpNode *[maximumNodes];
+      for (int i = 0; i < maximumNodes; i++)
+        nodeInfo[i] = NULL;
+      info->nodeInfo_ = nodeInfo;
+    }
+    half[way].solver = solver;
+    half[way].info = info;
+    half[way].whichSolution = -1;
+  }
+  model_->threadPool(2)->run(doMiniTreeHalf, 2, half,
+    static_cast< int >(sizeof(CbcMiniTreeHalf)));
+  // move nodes across (swapping so each node still has one owner)
+  ClpNodeStuff *info = nodeInfo_;
+  int numberNodes = 0;
+  int whichSolution = -1;
+  int numberExplored = 0;
+  int numberIterations = 0;
+  for (int way = 0; way < 2; way++) {
+    ClpNodeStuff *infoHalf = half[way].info;
+    int which = half[way].whichSolution;
+    if (which >= 0 && (whichSolution < 0
+          || infoHalf->nodeInfo_[which]->objectiveValue()
+            < info->nodeInfo_[whichSolution]->objectiveValue()))
+      whichSolution = numberNodes + which;
+    for (int i = 0; i < infoHalf->nNodes_; i++) {
+      ClpNode *temp = info->nodeInfo_[numberNodes];
+      info->nodeInfo_[numberNodes++] = infoHalf->nodeInfo_[i];
+      infoHalf->nodeInfo_[i] = temp;
+    }
+    numberExplored += infoHalf->numberNodesExplored_;
+    numberIterations += infoHalf->numberIterations_;
+  }
+  info->nNodes_ = numberNodes;
+  info->numberNodesExplored_ = numberExplored + 1;
+  info->numberIterations_ = numberIterations;
+  // totals in halves both start from those in info
+  ClpNodeStuff *info0 = half[0].info;
+  ClpNodeStuff *info1 = half[1].info;
+  for (int i = 0; i < numberIntegers; i++) {
+    info->downPseudo_[i] = info0->downPseudo_[i] + info1->downPseudo_[i] - info->downPseudo_[i];
+    info->upPseudo_[i] = info0->upPseudo_[i] + info1->upPseudo_[i] - info->upPseudo_[i];
+    info->numberDown_[i] = info0->numberDown_[i] + info1->numberDown_[i] - info->numberDown_[i];
+    info->numberUp_[i] = info0->numberUp_[i] + info1->numberUp_[i] - info->numberUp_[i];
+    info->numberDownInfeasible_[i] = info0->numberDownInfeasible_[i]
+      + info1->numberDownInfeasible_[i] - info->numberDownInfeasible_[i];
+    info->numberUpInfeasible_[i] = info0->numberUpInfeasible_[i]
+      + info1->numberUpInfeasible_[i] - info->numberUpInfeasible_[i];
+  }
+  for (int way = 0; way < 2; way++) {
+    delete half[way].info;
+    delete half[way].solver;
+  }
+  return whichSolution;
+#else
+  return -2;
+#endif
+}
+
 // This looks at solution and sets bounds to contain solution
 void CbcGeneralDepth::feasibleRegion()
 {
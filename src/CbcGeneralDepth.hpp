@@ -18,6 +18,7 @@
 */
 #include "ClpSimplex.hpp"
 #include "ClpNode.hpp"
+class OsiClpSolverInterface;
 
 class CBCLIB_EXPORT CbcGeneralDepth : public CbcGeneral {
 
@@ -89,6 +90,14 @@ public:
   /// Redoes data when sequence numbers change
   virtual void redoSequenceEtc(CbcModel *model, int numberColumns, const int *originalColumns);
 
+protected:
+  /** Explore mini tree as two halves on threads (pseudo costs as given
+      to nodeInfo_).  Returns as fathomMany or -2 if not done */
+  int fathomManyOnThreads(OsiClpSolverInterface *clpSolver,
+    const double *down, const double *up, const int *priority,
+    const int *numberDown, const int *numberUp,
+    const int *numberDownInfeasible, const int *numberUpInfeasible) const;
+
 protected:
   /// data
   /// Maximum depth
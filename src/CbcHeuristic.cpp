@@ -32,8 +32,10 @@
 #include "OsiRowCutDebugger.hpp"
 #include "OsiPresolve.hpp"
 #include "CbcBranchActual.hpp"
+#include "CbcSimpleIntegerDynamicPseudoCost.hpp"
 #include "CbcCutGenerator.hpp"
 #include "CoinMpsIO.hpp"
+#include "CoinTime.hpp"
 //==============================================================================
 
 CbcHeuristicNode::CbcHeuristicNode(const CbcHeuristicNode &rhs)
@@ -43,6 +45,8 @@ CbcHeuristicNode::CbcHeuristicNode(const CbcHeuristicNode &rhs)
   for (int i = 0; i < numObjects_; ++i) {
     brObj_[i] = rhs.brObj_[i]->clone();
   }
+  for (int i = 0; i < 4; i++)
+    signature_[i] = rhs.signature_[i];
 }
 
 void CbcHeuristicNodeList::gutsOfDelete()
@@ -50,14 +54,22 @@ void CbcHeuristicNodeList::gutsOfDelete()
   for (int i = (static_cast< int >(nodes_.size())) - 1; i >= 0; --i) {
     delete nodes_[i];
   }
+  nodes_.clear();
+  numberSeen_ = 0;
 }
 
 void CbcHeuristicNodeList::gutsOfCopy(const CbcHeuristicNodeList &rhs)
 {
+  maximumSize_ = rhs.maximumSize_;
+  seed_ = rhs.seed_;
   append(rhs);
+  numberSeen_ = rhs.numberSeen_;
 }
 
 CbcHeuristicNodeList::CbcHeuristicNodeList(const CbcHeuristicNodeList &rhs)
+  : numberSeen_(0)
+  , maximumSize_(200)
+  , seed_(12345678)
 {
   gutsOfCopy(rhs);
 }
@@ -78,7 +90,20 @@ CbcHeuristicNodeList::~CbcHeuristicNodeList()
 
 void CbcHeuristicNodeList::append(CbcHeuristicNode *&node)
 {
-  nodes_.push_back(node);
+  numberSeen_++;
+  if (static_cast< int >(nodes_.size()) < maximumSize_) {
+    nodes_.push_back(node);
+  } else {
+    // reservoir sample so work stays bounded on long runs
+    seed_ = 1664525 * seed_ + 1013904223;
+    int k = static_cast< int >(seed_ % static_cast< unsigned int >(numberSeen_));
+    if (k < maximumSize_) {
+      delete nodes_[k];
+      nodes_[k] = node;
+    } else {
+      delete node;
+    }
+  }
   node = NULL;
 }
 
@@ -116,6 +141,11 @@ CbcHeuristic::CbcHeuristic()
   , numCouldRun_(0)
   , numberSolutionsFound_(0)
   , numberNodesDone_(0)
+  , timeUsed_(0.0)
+  , timeSinceImprovement_(0.0)
+  , objectiveGain_(0.0)
+  , iterationsUsed_(0)
+  , numberImprovements_(0)
   , inputSolution_(NULL)
 {
   // As CbcHeuristic virtual need to modify .cpp if above change
@@ -144,6 +174,11 @@ CbcHeuristic::CbcHeuristic(CbcModel &model)
   , numCouldRun_(0)
   , numberSolutionsFound_(0)
   , numberNodesDone_(0)
+  , timeUsed_(0.0)
+  , timeSinceImprovement_(0.0)
+  , objectiveGain_(0.0)
+  , iterationsUsed_(0)
+  , numberImprovements_(0)
   , inputSolution_(NULL)
 {
 }
@@ -172,6 +207,11 @@ void CbcHeuristic::gutsOfCopy(const CbcHeuristic &rhs)
   runNodes_ = rhs.runNodes_;
   numberSolutionsFound_ = rhs.numberSolutionsFound_;
   numberNodesDone_ = rhs.numberNodesDone_;
+  timeUsed_ = rhs.timeUsed_;
+  timeSinceImprovement_ = rhs.timeSinceImprovement_;
+  objectiveGain_ = rhs.objectiveGain_;
+  iterationsUsed_ = rhs.iterationsUsed_;
+  numberImprovements_ = rhs.numberImprovements_;
   if (rhs.inputSolution_) {
     int numberColumns = model_->getNumCols();
     setInputSolution(rhs.inputSolution_, rhs.inputSolution_[numberColumns]);
@@ -265,6 +305,9 @@ bool CbcHeuristic::shouldHeurRun(int whereFrom)
   whereFrom &= 7;
   if ((whereFrom_ & (1 << whereFrom)) == 0)
     return false;
+  // Over share of time without results (CbcHeuristicTimeBudget)
+  if (overBudget())
+    return false;
     // No longer used for original purpose - so use for ever run at all JJF
 #ifndef JJF_ONE
   // Don't run if hot start or no rows!
@@ -353,6 +396,42 @@ bool CbcHeuristic::shouldHeurRun(int whereFrom)
 #endif
 }
 
+/* Calls solution and adds wall clock time, LP iterations (as counted by
+   model) and any improvement to statistics for this heuristic */
+int CbcHeuristic::solutionWithStatistics(double &objectiveValue,
+  double *newSolution)
+{
+  double startTime = CoinGetTimeOfDay();
+  int startIterations = model_ ? model_->getIterationCount() : 0;
+  double oldValue = objectiveValue;
+  int returnCode = solution(objectiveValue, newSolution);
+  double time = CoinGetTimeOfDay() - startTime;
+  timeUsed_ += time;
+  timeSinceImprovement_ += time;
+  if (model_)
+    iterationsUsed_ += model_->getIterationCount() - startIterations;
+  if (returnCode > 0) {
+    numberImprovements_++;
+    timeSinceImprovement_ = 0.0;
+    if (oldValue < 1.0e50)
+      objectiveGain_ += oldValue - objectiveValue;
+  }
+  return returnCode;
+}
+/* True if time used since last solution is more than share of
+   CbcHeuristicTimeBudget percent of time so far */
+bool CbcHeuristic::overBudget() const
+{
+  if (!model_)
+    return false;
+  double budget = model_->getDblParam(CbcModel::CbcHeuristicTimeBudget);
+  if (budget <= 0.0 || budget >= 100.0)
+    return false;
+  int numberHeuristics = CoinMax(model_->numberHeuristics(), 1);
+  double share = 0.01 * budget * model_->getCurrentSeconds() / numberHeuristics;
+  return (timeSinceImprovement_ > share);
+}
+
 bool CbcHeuristic::shouldHeurRun_randomChoice()
 {
   if (!when_)
@@ -532,6 +611,54 @@ void CbcHeuristic::setModel(CbcModel *model)
    type 0 clone solver, 1 clone continuous solver
    Add 2 to say without integer variables which are at low priority
    Add 4 to say quite likely infeasible so give up easily.*/
+/*
+  Cuts of model solver whose slacks are not basic are added to solver
+  and basis of model solver is mapped across (slacks of cuts left out
+  were basic so basis stays square).
+*/
+int CbcHeuristic::addParentCutsAndBasis(OsiSolverInterface *solver) const
+{
+  const OsiSolverInterface *parent = model_->solver();
+  int numberColumns = solver->getNumCols();
+  int numberRows = solver->getNumRows();
+  int numberParentRows = parent->getNumRows();
+  if (parent->getNumCols() != numberColumns || numberParentRows < numberRows
+    || !parent->isProvenOptimal())
+    return -1;
+  CoinWarmStartBasis *basis = dynamic_cast< CoinWarmStartBasis * >(parent->getWarmStart());
+  if (!basis || basis->getNumStructural() != numberColumns
+    || basis->getNumArtificial() != numberParentRows) {
+    delete basis;
+    return -1;
+  }
+  int *which = new int[numberParentRows - numberRows + 1];
+  int numberCuts = 0;
+  for (int iRow = numberRows; iRow < numberParentRows; iRow++) {
+    if (basis->getArtifStatus(iRow) != CoinWarmStartBasis::basic)
+      which[numberCuts++] = iRow;
+  }
+  if (numberCuts) {
+    const CoinPackedMatrix *rowCopy = parent->getMatrixByRow();
+    const double *rowLower = parent->getRowLower();
+    const double *rowUpper = parent->getRowUpper();
+    for (int i = 0; i < numberCuts; i++) {
+      int iRow = which[i];
+      solver->addRow(rowCopy->getVector(iRow), rowLower[iRow], rowUpper[iRow]);
+    }
+  }
+  CoinWarmStartBasis newBasis;
+  newBasis.setSize(numberColumns, numberRows + numberCuts);
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++)
+    newBasis.setStructStatus(iColumn, basis->getStructStatus(iColumn));
+  for (int iRow = 0; iRow < numberRows; iRow++)
+    newBasis.setArtifStatus(iRow, basis->getArtifStatus(iRow));
+  for (int i = 0; i < numberCuts; i++)
+    newBasis.setArtifStatus(numberRows + i, basis->getArtifStatus(which[i]));
+  solver->setWarmStart(&newBasis);
+  delete[] which;
+  delete basis;
+  return numberCuts;
+}
 OsiSolverInterface *
 CbcHeuristic::cloneBut(int type)
 {
@@ -681,6 +808,113 @@ static double sizeRatio(int numberRowsNow, int numberColumnsNow,
     return 2.0 * (valueNow / valueStart);
 }
 
+/*
+  Parent global cuts are mapped to columns of submodel - a column which
+  has gone must have been fixed in solver (otherwise cut is dropped).
+  Pseudocosts go on dynamic objects created for submodel integers.
+*/
+void CbcHeuristic::inheritFromModel(CbcModel &subModel,
+  const OsiSolverInterface *solver, const int *originalColumns) const
+{
+  int inherit = model_->getIntParam(CbcModel::CbcSubMipInherit);
+  int numberColumns = solver->getNumCols();
+  if (numberColumns != model_->getNumCols())
+    return;
+  int numberColumns2 = subModel.getNumCols();
+  int *back = new int[numberColumns];
+  for (int i = 0; i < numberColumns; i++)
+    back[i] = -1;
+  for (int i = 0; i < numberColumns2; i++)
+    back[originalColumns[i]] = i;
+  const double *lower = solver->getColLower();
+  const double *upper = solver->getColUpper();
+  CbcRowCuts *globalCuts = model_->globalCuts();
+  int numberCuts = globalCuts->sizeRowCuts();
+  if ((inherit & 1) != 0 && numberCuts) {
+    CglStored stored;
+    int *index = new int[numberColumns2];
+    double *element = new double[numberColumns2];
+    int numberAdded = 0;
+    for (int iCut = 0; iCut < numberCuts; iCut++) {
+      const OsiRowCut *cut = globalCuts->rowCutPtr(iCut);
+      const CoinPackedVector &row = cut->row();
+      const int *column = row.getIndices();
+      const double *value = row.getElements();
+      double offset = 0.0;
+      int n = 0;
+      bool good = true;
+      for (int j = 0; j < row.getNumElements(); j++) {
+        int iColumn = column[j];
+        int jColumn = back[iColumn];
+        if (jColumn >= 0) {
+          index[n] = jColumn;
+          element[n++] = value[j];
+        } else if (lower[iColumn] == upper[iColumn]) {
+          offset += value[j] * lower[iColumn];
+        } else {
+          good = false;
+          break;
+        }
+      }
+      if (!good || !n)
+        continue;
+      double lb = cut->lb();
+      if (lb > -COIN_DBL_MAX)
+        lb -= offset;
+      double ub = cut->ub();
+      if (ub < COIN_DBL_MAX)
+        ub -= offset;
+      stored.addCut(lb, ub, n, index, element);
+      numberAdded++;
+    }
+    delete[] index;
+    delete[] element;
+    if (numberAdded) {
+      subModel.addCutGenerator(&stored, 1, "Parent global cuts");
+      subModel.cutGenerator(subModel.numberCutGenerators() - 1)->setGlobalCuts(true);
+    }
+  }
+  if ((inherit & 2) != 0) {
+    // parent object for each column
+    const CbcSimpleIntegerDynamicPseudoCost **parentObject = new const CbcSimpleIntegerDynamicPseudoCost *[numberColumns];
+    for (int i = 0; i < numberColumns; i++)
+      parentObject[i] = NULL;
+    int numberParentObjects = model_->numberObjects();
+    OsiObject **objects = model_->objects();
+    bool any = false;
+    for (int i = 0; i < numberParentObjects; i++) {
+      const CbcSimpleIntegerDynamicPseudoCost *object = dynamic_cast< const CbcSimpleIntegerDynamicPseudoCost * >(objects[i]);
+      if (object && object->columnNumber() < numberColumns) {
+        parentObject[object->columnNumber()] = object;
+        any = true;
+      }
+    }
+    if (any) {
+      subModel.findIntegers(false);
+      int numberObjects = subModel.numberObjects();
+      OsiObject **subObjects = subModel.objects();
+      for (int i = 0; i < numberObjects; i++) {
+        CbcSimpleInteger *object = dynamic_cast< CbcSimpleInteger * >(subObjects[i]);
+        if (!object || dynamic_cast< CbcSimpleIntegerDynamicPseudoCost * >(object))
+          continue;
+        int iColumn = object->columnNumber();
+        const CbcSimpleIntegerDynamicPseudoCost *parent = parentObject[originalColumns[iColumn]];
+        if (!parent)
+          continue;
+        CbcSimpleIntegerDynamicPseudoCost *newObject = new CbcSimpleIntegerDynamicPseudoCost(&subModel, iColumn,
+          parent->downDynamicPseudoCost(), parent->upDynamicPseudoCost());
+        newObject->copySome(parent);
+        newObject->setPriority(object->priority());
+        newObject->setPosition(i);
+        newObject->setPreferredWay(object->preferredWay());
+        delete object;
+        subObjects[i] = newObject;
+      }
+    }
+    delete[] parentObject;
+  }
+  delete[] back;
+}
 //static int saveModel=0;
 // Do mini branch and bound (return 1 if solution)
 int CbcHeuristic::smallBranchAndBound(OsiSolverInterface *solver, int numberNodes,
@@ -692,7 +926,7 @@ int CbcHeuristic::smallBranchAndBound(OsiSolverInterface *solver, int numberNode
   double fractionSmall = fractionSmall_;
   int maximumSolutions = model_->getMaximumSolutions();
   int iterationMultiplier = 100;
-  if (eventHandler) {
+  if (eventHandler && eventHandler->wanted(CbcEventHandler::smallBranchAndBound)) {
     typedef struct {
       double fractionSmall;
       double spareDouble[3];
@@ -900,6 +1134,8 @@ int CbcHeuristic::smallBranchAndBound(OsiSolverInterface *solver, int numberNode
   if (returnCode == 2 || returnCode == -1) {
     model_->setSpecialOptions(saveModelOptions);
     delete[] reset;
+    if (returnCode == -1)
+      numberNodesDone_ = -2; // too large
 #ifdef HISTORY_STATISTICS
     getHistoryStatistics_ = true;
 #endif
@@ -914,7 +1150,21 @@ int CbcHeuristic::smallBranchAndBound(OsiSolverInterface *solver, int numberNode
   solver->setHintParam(OsiDoPresolveInInitial, false, OsiHintTry);
   double signedCutoff = cutoff * solver->getObjSense();
   solver->setDblParam(OsiDualObjectiveLimit, signedCutoff);
-  solver->initialSolve();
+  {
+    // warm start if solver has a basis which fits (e.g. from parent)
+    CoinWarmStartBasis *basis = dynamic_cast< CoinWarmStartBasis * >(solver->getWarmStart());
+    if (basis && basis->getNumStructural() == solver->getNumCols()
+      && basis->getNumArtificial() == solver->getNumRows()
+      && basis->numberBasicStructurals()) {
+      solver->resolve();
+      if (!solver->isProvenOptimal() && !solver->isProvenPrimalInfeasible()
+        && !solver->isDualObjectiveLimitReached())
+        solver->initialSolve();
+    } else {
+      solver->initialSolve();
+    }
+    delete basis;
+  }
   if (solver->isProvenOptimal()) {
     CglPreProcess process;
     OsiSolverInterface *solver2 = NULL;
@@ -1147,6 +1397,9 @@ int CbcHeuristic::smallBranchAndBound(OsiSolverInterface *solver, int numberNode
             maximumSolutions++;
             delete[] bestSolution2;
           }
+          // cuts and pseudocosts of parent
+          if (model_->getIntParam(CbcModel::CbcSubMipInherit))
+            inheritFromModel(model, solver, process.originalColumns());
         } else {
           // modify for event handler
           model.setSpecialOptions(saveModelOptions);
@@ -1221,6 +1474,9 @@ int CbcHeuristic::smallBranchAndBound(OsiSolverInterface *solver, int numberNode
             model.addCutGenerator(&cuts, 1, "Stored from first");
             model.cutGenerator(model.numberCutGenerators() - 1)->setGlobalCuts(true);
           }
+          // a restart may take cuts and pseudocosts found so far
+          if (model_->getIntParam(CbcModel::CbcSubMipInherit))
+            inheritFromModel(model, solver, process.originalColumns());
         }
         // Do search
         if (logLevel > 1)
@@ -1684,6 +1940,8 @@ int CbcHeuristic::smallBranchAndBound(OsiSolverInterface *solver, int numberNode
   getHistoryStatistics_ = true;
 #endif
   solver->setHintParam(OsiDoReducePrint, takeHint, strength);
+  if (returnCode == -1)
+    numberNodesDone_ = -2; // too large
   return returnCode;
 }
 // Set input solution
@@ -1780,6 +2038,20 @@ void CbcHeuristicNode::gutsOfConstructor(CbcModel &model)
     }
     ++numObjects_;
   }
+  // signature
+  for (int i = 0; i < 4; i++)
+    signature_[i] = 0;
+  for (int i = 0; i < numObjects_; i++) {
+    const CbcBranchingObject *br = brObj_[i];
+    if (!br)
+      continue;
+    unsigned int hash = static_cast< unsigned int >(br->type()) * 2654435761u;
+    hash ^= static_cast< unsigned int >(br->variable()) * 40503u;
+    hash ^= hash >> 13;
+    hash *= 0x5bd1e995u;
+    hash ^= hash >> 15;
+    signature_[(hash >> 6) & 3] |= static_cast< CoinUInt64 >(1) << (hash & 63);
+  }
 }
 
 //==============================================================================
@@ -1791,6 +2063,35 @@ CbcHeuristicNode::CbcHeuristicNode(CbcModel &model)
 
 //==============================================================================
 
+// Number of bits set
+static inline int countBits(CoinUInt64 value)
+{
+#if defined(__GNUC__)
+  return __builtin_popcountll(value);
+#else
+  int count = 0;
+  while (value) {
+    value &= value - 1;
+    count++;
+  }
+  return count;
+#endif
+}
+
+/* Each decision in one node and not the other adds at least subsetWeight
+   to distance and sets at most one differing bit, while decisions on the
+   same object set the same bit */
+double
+CbcHeuristicNode::distanceLowerBound(const CbcHeuristicNode *node) const
+{
+  int numberDifferent = 0;
+  for (int i = 0; i < 4; i++)
+    numberDifferent += countBits(signature_[i] ^ node->signature_[i]);
+  return 0.2 * numberDifferent;
+}
+
+//==============================================================================
+
 double
 CbcHeuristicNode::distance(const CbcHeuristicNode *node) const
 {
@@ -1886,7 +2187,10 @@ CbcHeuristicNode::minDistance(const CbcHeuristicNodeList &nodeList) const
 {
   double minDist = COIN_DBL_MAX;
   for (int i = nodeList.size() - 1; i >= 0; --i) {
-    minDist = CoinMin(minDist, distance(nodeList.node(i)));
+    const CbcHeuristicNode *node = nodeList.node(i);
+    if (distanceLowerBound(node) >= minDist)
+      continue;
+    minDist = CoinMin(minDist, distance(node));
   }
   return minDist;
 }
@@ -1897,7 +2201,9 @@ bool CbcHeuristicNode::minDistanceIsSmall(const CbcHeuristicNodeList &nodeList,
   const double threshold) const
 {
   for (int i = nodeList.size() - 1; i >= 0; --i) {
-    if (distance(nodeList.node(i)) >= threshold) {
+    const CbcHeuristicNode *node = nodeList.node(i);
+    // cheap test first
+    if (distanceLowerBound(node) >= threshold || distance(node) >= threshold) {
       continue;
     } else {
       return true;
@@ -11,6 +11,7 @@
 #include "OsiCuts.hpp"
 #include "CoinHelperFunctions.hpp"
 #include "OsiBranchingObject.hpp"
+#include "CoinTypes.hpp"
 #include "CbcConfig.h"
 
 class OsiSolverInterface;
@@ -40,6 +41,10 @@ private:
         listed multiple times. E.g., a general integer variable that has
         been branched on multiple times. */
   CbcBranchingObject **brObj_;
+  /** Bit for each decision (hash of type and variable) - so
+        subsetWeight times number of bits which differ is a cheap lower
+        bound on distance */
+  CoinUInt64 signature_[4];
 
 public:
   CbcHeuristicNode(CbcModel &model);
@@ -51,6 +56,8 @@ public:
   bool minDistanceIsSmall(const CbcHeuristicNodeList &nodeList,
     const double threshold) const;
   double avgDistance(const CbcHeuristicNodeList &nodeList) const;
+  /// Lower bound on distance from signatures
+  double distanceLowerBound(const CbcHeuristicNode *node) const;
 };
 
 class CBCLIB_EXPORT CbcHeuristicNodeList {
@@ -60,15 +67,38 @@ private:
 
 private:
   std::vector< CbcHeuristicNode * > nodes_;
+  /// Number of nodes appended (list is a reservoir sample of them)
+  int numberSeen_;
+  /// Most nodes kept
+  int maximumSize_;
+  /// For choosing which node to replace
+  unsigned int seed_;
 
 public:
-  CbcHeuristicNodeList() {}
+  CbcHeuristicNodeList()
+    : numberSeen_(0)
+    , maximumSize_(200)
+    , seed_(12345678)
+  {
+  }
   CbcHeuristicNodeList(const CbcHeuristicNodeList &rhs);
   CbcHeuristicNodeList &operator=(const CbcHeuristicNodeList &rhs);
   ~CbcHeuristicNodeList();
 
+  /** Append node (taken over and set to NULL).  Once list is full a
+        node kept at random is replaced with equal chance for all seen */
   void append(CbcHeuristicNode *&node);
   void append(const CbcHeuristicNodeList &nodes);
+  /// Set most nodes kept
+  inline void setMaximumSize(int value)
+  {
+    maximumSize_ = (value > 0) ? value : 1;
+  }
+  /// Most nodes kept
+  inline int maximumSize() const
+  {
+    return maximumSize_;
+  }
   inline const CbcHeuristicNode *node(int i) const
   {
     return nodes_[i];
@@ -218,6 +248,16 @@ public:
   {
     return fractionSmall_;
   }
+  /** Nodes done by last small branch and bound (-2 if it gave up as
+        problem too large) - can be set to see if one was done */
+  inline int numberNodesDone() const
+  {
+    return numberNodesDone_;
+  }
+  inline void setNumberNodesDone(int value)
+  {
+    numberNodesDone_ = value;
+  }
   /// Get how many solutions the heuristic thought it got
   inline int numberSolutionsFound() const
   {
@@ -228,6 +268,33 @@ public:
   {
     numberSolutionsFound_++;
   }
+  /** Calls solution and keeps statistics (time, iterations,
+      improvements and gain in objective) - used by model */
+  int solutionWithStatistics(double &objectiveValue, double *newSolution);
+  /// Wall clock seconds used when model called solution
+  inline double timeUsed() const
+  {
+    return timeUsed_;
+  }
+  /// LP iterations (as counted by model) used
+  inline int iterationsUsed() const
+  {
+    return iterationsUsed_;
+  }
+  /// Number of calls which gave an improved solution
+  inline int numberImprovements() const
+  {
+    return numberImprovements_;
+  }
+  /// Total improvement in objective from solutions found
+  inline double objectiveGain() const
+  {
+    return objectiveGain_;
+  }
+  /** True if time used since last improved solution is more than
+      share (1/numberHeuristics) of CbcHeuristicTimeBudget percent of
+      time so far */
+  bool overBudget() const;
 
   /** Do mini branch and bound - return
         0 not finished - no solution
@@ -241,6 +308,11 @@ public:
   int smallBranchAndBound(OsiSolverInterface *solver, int numberNodes,
     double *newSolution, double &newSolutionValue,
     double cutoff, std::string name) const;
+  /** Give submodel of smallBranchAndBound global cuts and pseudocosts of
+        model (CbcSubMipInherit).  solver is problem before preprocessing
+        and originalColumns maps submodel columns to its columns */
+  void inheritFromModel(CbcModel &subModel, const OsiSolverInterface *solver,
+    const int *originalColumns) const;
   /// Create C++ lines to get to current state
   virtual void generateCpp(FILE *) {}
   /// Create C++ lines to get to current state - does work for base class
@@ -360,6 +432,11 @@ public:
         - Add 4 to say quite likely infeasible so give up easily (clp only).
     */
   OsiSolverInterface *cloneBut(int type);
+  /** Give solver (clone of model solver or continuous solver) tight cuts
+      of model solver and basis of model solver restricted to them - so
+      sub-MIP root LP is warm started.  Returns number of cuts added or -1
+      if nothing done */
+  int addParentCutsAndBasis(OsiSolverInterface *solver) const;
 
 protected:
   /// Model
@@ -441,6 +518,21 @@ protected:
   /// How many nodes the heuristic did this go
   mutable int numberNodesDone_;
 
+  /// Wall clock seconds used when model called solution
+  double timeUsed_;
+
+  /// Seconds used since last improved solution
+  double timeSinceImprovement_;
+
+  /// Total improvement in objective from solutions found
+  double objectiveGain_;
+
+  /// LP iterations (as counted by model) used
+  int iterationsUsed_;
+
+  /// Number of calls which gave an improved solution
+  int numberImprovements_;
+
   // Input solution - so can be used as seed
   double *inputSolution_;
 
@@ -0,0 +1,282 @@
+// Copyright (C) 2008, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#pragma warning(disable : 4786)
+#endif
+
+#include <cassert>
+#include <cmath>
+#include <cfloat>
+
+#include "CbcModel.hpp"
+#include "CbcHeuristicALNS.hpp"
+#include "CoinHelperFunctions.hpp"
+
+// Default Constructor
+CbcHeuristicALNS::CbcHeuristicALNS()
+  : CbcHeuristic()
+  , heuristic_(NULL)
+  , weight_(NULL)
+  , time_(NULL)
+  , rate_(NULL)
+  , numberCalls_(NULL)
+  , numberImproved_(NULL)
+  , reactionFactor_(0.2)
+  , targetRate_(0.8)
+  , timeFraction_(0.2)
+  , totalTime_(0.0)
+  , numberHeuristics_(0)
+{
+  setHeuristicName("ALNS");
+}
+
+// Constructor from model
+CbcHeuristicALNS::CbcHeuristicALNS(CbcModel &model)
+  : CbcHeuristic(model)
+  , heuristic_(NULL)
+  , weight_(NULL)
+  , time_(NULL)
+  , rate_(NULL)
+  , numberCalls_(NULL)
+  , numberImproved_(NULL)
+  , reactionFactor_(0.2)
+  , targetRate_(0.8)
+  , timeFraction_(0.2)
+  , totalTime_(0.0)
+  , numberHeuristics_(0)
+{
+  setHeuristicName("ALNS");
+}
+
+// Destructor
+CbcHeuristicALNS::~CbcHeuristicALNS()
+{
+  gutsOfDelete();
+}
+
+// Free arrays
+void CbcHeuristicALNS::gutsOfDelete()
+{
+  for (int i = 0; i < numberHeuristics_; i++)
+    delete heuristic_[i];
+  delete[] heuristic_;
+  delete[] weight_;
+  delete[] numberCalls_;
+  heuristic_ = NULL;
+  weight_ = NULL;
+  time_ = NULL;
+  rate_ = NULL;
+  numberCalls_ = NULL;
+  numberImproved_ = NULL;
+  numberHeuristics_ = 0;
+}
+
+// Copy arrays
+void CbcHeuristicALNS::gutsOfCopy(const CbcHeuristicALNS &rhs)
+{
+  reactionFactor_ = rhs.reactionFactor_;
+  targetRate_ = rhs.targetRate_;
+  timeFraction_ = rhs.timeFraction_;
+  totalTime_ = rhs.totalTime_;
+  numberHeuristics_ = rhs.numberHeuristics_;
+  if (numberHeuristics_) {
+    heuristic_ = new CbcHeuristic *[numberHeuristics_];
+    for (int i = 0; i < numberHeuristics_; i++)
+      heuristic_[i] = rhs.heuristic_[i]->clone();
+    // weight, time and rate together
+    weight_ = CoinCopyOfArray(rhs.weight_, 3 * numberHeuristics_);
+    time_ = weight_ + numberHeuristics_;
+    rate_ = time_ + numberHeuristics_;
+    numberCalls_ = CoinCopyOfArray(rhs.numberCalls_, 2 * numberHeuristics_);
+    numberImproved_ = numberCalls_ + numberHeuristics_;
+  }
+}
+
+// Clone
+CbcHeuristicALNS *
+CbcHeuristicALNS::clone() const
+{
+  return new CbcHeuristicALNS(*this);
+}
+
+// Create C++ lines to get to current state
+void CbcHeuristicALNS::generateCpp(FILE *fp)
+{
+  CbcHeuristicALNS other;
+  fprintf(fp, "0#include \"CbcHeuristicALNS.hpp\"\n");
+  fprintf(fp, "3  CbcHeuristicALNS heuristicALNS(*cbcModel);\n");
+  CbcHeuristic::generateCpp(fp, "heuristicALNS");
+  if (reactionFactor_ != other.reactionFactor_)
+    fprintf(fp, "3  heuristicALNS.setReactionFactor(%g);\n", reactionFactor_);
+  else
+    fprintf(fp, "4  heuristicALNS.setReactionFactor(%g);\n", reactionFactor_);
+  if (targetRate_ != other.targetRate_)
+    fprintf(fp, "3  heuristicALNS.setTargetRate(%g);\n", targetRate_);
+  else
+    fprintf(fp, "4  heuristicALNS.setTargetRate(%g);\n", targetRate_);
+  if (timeFraction_ != other.timeFraction_)
+    fprintf(fp, "3  heuristicALNS.setTimeFraction(%g);\n", timeFraction_);
+  else
+    fprintf(fp, "4  heuristicALNS.setTimeFraction(%g);\n", timeFraction_);
+  fprintf(fp, "3  cbcModel->addHeuristic(&heuristicALNS);\n");
+}
+
+// Copy constructor
+CbcHeuristicALNS::CbcHeuristicALNS(const CbcHeuristicALNS &rhs)
+  : CbcHeuristic(rhs)
+  , heuristic_(NULL)
+  , weight_(NULL)
+  , time_(NULL)
+  , rate_(NULL)
+  , numberCalls_(NULL)
+  , numberImproved_(NULL)
+  , numberHeuristics_(0)
+{
+  gutsOfCopy(rhs);
+}
+
+// Assignment operator
+CbcHeuristicALNS &
+CbcHeuristicALNS::operator=(const CbcHeuristicALNS &rhs)
+{
+  if (this != &rhs) {
+    CbcHeuristic::operator=(rhs);
+    gutsOfDelete();
+    gutsOfCopy(rhs);
+  }
+  return *this;
+}
+
+// Sets value of solution
+// Returns 1 if solution, 0 if not
+int CbcHeuristicALNS::solution(double &solutionValue,
+  double *betterSolution)
+{
+  ++numCouldRun_;
+  if (!numberHeuristics_ || !when_)
+    return 0;
+  double startSeconds = model_->getCurrentSeconds();
+  // keep to share of time (but let each have a go)
+  int numberCalled = 0;
+  for (int i = 0; i < numberHeuristics_; i++) {
+    if (numberCalls_[i])
+      numberCalled++;
+  }
+  if (numberCalled == numberHeuristics_ && totalTime_ > timeFraction_ * startSeconds)
+    return 0;
+  // roulette
+  double sum = 0.0;
+  for (int i = 0; i < numberHeuristics_; i++)
+    sum += weight_[i];
+  double randomNumber = randomNumberGenerator_.randomDouble() * sum;
+  int iHeuristic;
+  for (iHeuristic = 0; iHeuristic < numberHeuristics_ - 1; iHeuristic++) {
+    if (randomNumber < weight_[iHeuristic])
+      break;
+    randomNumber -= weight_[iHeuristic];
+  }
+  CbcHeuristic *heuristic = heuristic_[iHeuristic];
+  double oldValue = solutionValue;
+  heuristic->setNumberNodesDone(-1);
+  int returnCode = heuristic->solution(solutionValue, betterSolution);
+  double seconds = CoinMax(model_->getCurrentSeconds() - startSeconds, 1.0e-3);
+  totalTime_ += seconds;
+  time_[iHeuristic] += seconds;
+  numberCalls_[iHeuristic]++;
+  double reward = 0.0;
+  if (returnCode > 0 && solutionValue < oldValue) {
+    numberImproved_[iHeuristic]++;
+    reward = 1.0;
+    if (oldValue < 1.0e50)
+      reward += CoinMin((oldValue - solutionValue) / (fabs(oldValue) + 1.0e-5), 1.0);
+  }
+  weight_[iHeuristic] = (1.0 - reactionFactor_) * weight_[iHeuristic]
+    + reactionFactor_ * reward / seconds;
+  // every heuristic keeps some chance
+  double largest = 0.0;
+  for (int i = 0; i < numberHeuristics_; i++)
+    largest = CoinMax(largest, weight_[i]);
+  double smallest = CoinMax(0.01 * largest, 1.0e-6);
+  for (int i = 0; i < numberHeuristics_; i++)
+    weight_[i] = CoinMax(weight_[i], smallest);
+  /* neighbourhood size - only if sub-MIP was tried and fraction is
+     plain (larger values are codes) */
+  int numberNodesDone = heuristic->numberNodesDone();
+  double fraction = heuristic->fractionSmall();
+  if (numberNodesDone != -1 && fraction < 1.0) {
+    double done = (numberNodesDone >= 0) ? 1.0 : 0.0;
+    rate_[iHeuristic] = 0.8 * rate_[iHeuristic] + 0.2 * done;
+    if (rate_[iHeuristic] < targetRate_)
+      fraction = CoinMin(1.1 * fraction, 0.99);
+    else if (done)
+      fraction = CoinMax(0.95 * fraction, 0.05);
+    heuristic->setFractionSmall(fraction);
+  }
+#ifdef COIN_DEVELOP
+  printf("ALNS ran %s (%g seconds) - weight %g fraction %g%s\n",
+    heuristic->heuristicName(), seconds, weight_[iHeuristic],
+    heuristic->fractionSmall(), reward ? " - improved" : "");
+#endif
+  return returnCode;
+}
+// Resets stuff if model changes
+void CbcHeuristicALNS::resetModel(CbcModel *model)
+{
+  CbcHeuristic::resetModel(model);
+  for (int i = 0; i < numberHeuristics_; i++)
+    heuristic_[i]->resetModel(model);
+}
+// update model (This is needed if cliques update matrix etc)
+void CbcHeuristicALNS::setModel(CbcModel *model)
+{
+  CbcHeuristic::setModel(model);
+  for (int i = 0; i < numberHeuristics_; i++)
+    heuristic_[i]->setModel(model);
+}
+// Validate model i.e. sets when_ to 0 if necessary (may be NULL)
+void CbcHeuristicALNS::validate()
+{
+  CbcHeuristic::validate();
+  for (int i = 0; i < numberHeuristics_; i++)
+    heuristic_[i]->validate();
+}
+// Adds a neighbourhood heuristic
+void CbcHeuristicALNS::addHeuristic(const CbcHeuristic *heuristic)
+{
+  CbcHeuristic *thisOne = heuristic->clone();
+  CbcHeuristic **tempH = CoinCopyOfArrayPartial(heuristic_, numberHeuristics_ + 1,
+    numberHeuristics_);
+  delete[] heuristic_;
+  heuristic_ = tempH;
+  heuristic_[numberHeuristics_] = thisOne;
+  int n = numberHeuristics_ + 1;
+  double *tempD = new double[3 * n];
+  int *tempI = new int[2 * n];
+  for (int i = 0; i < numberHeuristics_; i++) {
+    tempD[i] = weight_[i];
+    tempD[i + n] = time_[i];
+    tempD[i + 2 * n] = rate_[i];
+    tempI[i] = numberCalls_[i];
+    tempI[i + n] = numberImproved_[i];
+  }
+  // start optimistic so all get tried
+  tempD[numberHeuristics_] = 1.0;
+  tempD[numberHeuristics_ + n] = 0.0;
+  tempD[numberHeuristics_ + 2 * n] = 1.0;
+  tempI[numberHeuristics_] = 0;
+  tempI[numberHeuristics_ + n] = 0;
+  delete[] weight_;
+  delete[] numberCalls_;
+  weight_ = tempD;
+  time_ = weight_ + n;
+  rate_ = time_ + n;
+  numberCalls_ = tempI;
+  numberImproved_ = numberCalls_ + n;
+  numberHeuristics_ = n;
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -0,0 +1,154 @@
+// Copyright (C) 2008, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcHeuristicALNS_H
+#define CbcHeuristicALNS_H
+
+#include "CbcHeuristic.hpp"
+
+/** Adaptive large neighbourhood search class
+
+    Controller over neighbourhood heuristics (RINS, RENS, DINS, VND,
+    local search, DW ...).  Each time it runs one heuristic is chosen by
+    roulette on weights.  Weights learn reward per second - a call earns
+    one for an improved solution plus its relative improvement.
+    Fraction for small branch and bound of each heuristic is moved so
+    that about targetRate() of its sub-MIPs are small enough to be done.
+    Controller only runs while it has used less than timeFraction() of
+    time so far.  Heuristics keep their own rules for when they can do
+    something (e.g. needing a solution).
+ */
+
+class CBCLIB_EXPORT CbcHeuristicALNS : public CbcHeuristic {
+public:
+  // Default Constructor
+  CbcHeuristicALNS();
+
+  // Constructor with model - assumed before cuts
+  CbcHeuristicALNS(CbcModel &model);
+
+  // Copy constructor
+  CbcHeuristicALNS(const CbcHeuristicALNS &);
+
+  // Destructor
+  ~CbcHeuristicALNS();
+
+  /// Clone
+  virtual CbcHeuristicALNS *clone() const;
+
+  /// Assignment operator
+  CbcHeuristicALNS &operator=(const CbcHeuristicALNS &rhs);
+
+  /// Create C++ lines to get to current state
+  virtual void generateCpp(FILE *fp);
+
+  using CbcHeuristic::solution;
+  /** returns 0 if no solution, 1 if valid solution
+        with better objective value than one passed in
+        Sets solution values if good, sets objective value (only if good)
+        Runs one neighbourhood heuristic
+    */
+  virtual int solution(double &objectiveValue,
+    double *newSolution);
+  /// Resets stuff if model changes
+  virtual void resetModel(CbcModel *model);
+
+  /// update model (This is needed if cliques update matrix etc)
+  virtual void setModel(CbcModel *model);
+  /// Validate model i.e. sets when_ to 0 if necessary (may be NULL)
+  virtual void validate();
+  /// Adds a neighbourhood heuristic (cloned)
+  void addHeuristic(const CbcHeuristic *heuristic);
+  /// Number of heuristics
+  inline int numberHeuristics() const
+  {
+    return numberHeuristics_;
+  }
+  /// Heuristic i
+  inline CbcHeuristic *heuristic(int i) const
+  {
+    return heuristic_[i];
+  }
+  /// Weight of heuristic i (reward per second)
+  inline double weight(int i) const
+  {
+    return weight_[i];
+  }
+  /// Set how quickly weights move to latest reward (0.0 - 1.0)
+  inline void setReactionFactor(double value)
+  {
+    reactionFactor_ = value;
+  }
+  /// How quickly weights move to latest reward
+  inline double reactionFactor() const
+  {
+    return reactionFactor_;
+  }
+  /// Set fraction of sub-MIPs wanted small enough to be done
+  inline void setTargetRate(double value)
+  {
+    targetRate_ = value;
+  }
+  /// Fraction of sub-MIPs wanted small enough to be done
+  inline double targetRate() const
+  {
+    return targetRate_;
+  }
+  /// Set fraction of time so far which can be used
+  inline void setTimeFraction(double value)
+  {
+    timeFraction_ = value;
+  }
+  /// Fraction of time so far which can be used
+  inline double timeFraction() const
+  {
+    return timeFraction_;
+  }
+
+protected:
+  /// Free arrays
+  void gutsOfDelete();
+  /// Copy arrays
+  void gutsOfCopy(const CbcHeuristicALNS &rhs);
+
+  // Data
+
+  // Heuristics
+  CbcHeuristic **heuristic_;
+
+  // Weight of each heuristic
+  double *weight_;
+
+  // Seconds used by each heuristic
+  double *time_;
+
+  // Moving average of sub-MIPs small enough to be done
+  double *rate_;
+
+  // Number of times each heuristic has been called
+  int *numberCalls_;
+
+  // Number of improved solutions from each heuristic
+  int *numberImproved_;
+
+  // How quickly weights move to latest reward
+  double reactionFactor_;
+
+  // Fraction of sub-MIPs wanted small enough to be done
+  double targetRate_;
+
+  // Fraction of time so far which can be used
+  double timeFraction_;
+
+  // Seconds used in all
+  double totalTime_;
+
+  // Number of heuristics
+  int numberHeuristics_;
+};
+
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
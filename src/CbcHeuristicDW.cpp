@@ -19,6 +19,7 @@
 #include "CbcStrategy.hpp"
 #include "ClpPresolve.hpp"
 #include "CglProbing.hpp"
+#include "CbcThread.hpp"
 
 static int dummyCallBack(CbcHeuristicDW * /*heuristic*/,
   CbcModel * /*thisModel*/, int /*whereFrom*/)
@@ -69,9 +70,11 @@ void CbcHeuristicDW::setDefaults()
   numberPasses_ = 0;
   howOften_ = 100;
   decayFactor_ = 0.5;
-  functionPointer_ = NULL;
+  functionPointer_ = dummyCallBack;
   solver_ = NULL;
   dwSolver_ = NULL;
+  structure_ = NULL;
+  threadPool_ = NULL;
   bestSolution_ = NULL;
   continuousSolution_ = NULL;
   fixedDj_ = NULL;
@@ -110,6 +113,7 @@ void CbcHeuristicDW::setDefaults()
   nNeeded_ = nNeededBase_;
   nNodes_ = nNodesBase_;
   solveState_ = 0;
+  numberThreads_ = 0;
 }
 // Guts of copy
 void CbcHeuristicDW::gutsOfCopy(const CbcHeuristicDW &rhs)
@@ -139,7 +143,13 @@ void CbcHeuristicDW::gutsOfCopy(const CbcHeuristicDW &rhs)
   nNeeded_ = rhs.nNeeded_;
   nNodes_ = rhs.nNodes_;
   solveState_ = rhs.solveState_;
+  numberThreads_ = rhs.numberThreads_;
+  threadPool_ = NULL; // each copy has own threads
   functionPointer_ = rhs.functionPointer_;
+  // share block structure
+  structure_ = rhs.structure_;
+  if (structure_)
+    structure_->increment();
   if (rhs.solver_)
     solver_ = rhs.solver_->clone();
   else
@@ -239,6 +249,10 @@ void CbcHeuristicDW::gutsOfDelete()
   delete[] startColumnBlock_;
   delete[] intsInBlock_;
   delete[] fingerPrint_;
+#ifdef CBC_THREAD
+  delete threadPool_;
+#endif
+  threadPool_ = NULL;
   //functionPointer_ = NULL;
   solver_ = NULL;
   dwSolver_ = NULL;
@@ -269,6 +283,8 @@ void CbcHeuristicDW::gutsOfDelete()
 CbcHeuristicDW::~CbcHeuristicDW()
 {
   gutsOfDelete();
+  if (structure_ && !structure_->decrement())
+    delete structure_;
 }
 
 // Clone
@@ -285,6 +301,8 @@ CbcHeuristicDW::operator=(const CbcHeuristicDW &rhs)
   if (this != &rhs) {
     CbcHeuristic::operator=(rhs);
     gutsOfDelete();
+    if (structure_ && !structure_->decrement())
+      delete structure_;
     gutsOfCopy(rhs);
   }
   return *this;
@@ -632,56 +650,8 @@ int CbcHeuristicDW::solution(double &solutionValue,
         const int *row = solver->getMatrixByCol()->getIndices();
         const CoinBigIndex *columnStart = solver->getMatrixByCol()->getVectorStarts();
         const int *columnLength = solver->getMatrixByCol()->getVectorLengths();
-        int numberUsed = 0;
-        for (int iBlock = 0; iBlock < numberBlocks_; iBlock++) {
-          int start = startColumnBlock_[iBlock];
-          int end = startColumnBlock_[iBlock + 1];
-          ClpSimplex *tempModel = new ClpSimplex(solver->getModelPtr(),
-            startRowBlock_[iBlock + 1] - startRowBlock_[iBlock],
-            rowsInBlock_ + startRowBlock_[iBlock],
-            end - start,
-            columnsInBlock_ + startColumnBlock_[iBlock]);
-          tempModel->setLogLevel(0);
-          tempModel->setDualObjectiveLimit(COIN_DBL_MAX);
-          double *objectiveX = tempModel->objective();
-          double *columnLowerX = tempModel->columnLower();
-          double *columnUpperX = tempModel->columnUpper();
-          for (int i = start; i < end; i++) {
-            int jColumn = i - start;
-            int iColumn = columnsInBlock_[i];
-            columnLowerX[jColumn] = CoinMax(saveLower_[iColumn], -1.0e12);
-            columnUpperX[jColumn] = CoinMin(saveUpper_[iColumn], 1.0e12);
-            if (solver->isInteger(iColumn))
-              tempModel->setInteger(jColumn);
-            double cost = objectiveX[jColumn];
-            for (CoinBigIndex j = columnStart[iColumn];
-                 j < columnStart[iColumn] + columnLength[iColumn]; j++) {
-              int iRow = row[j];
-              double elementValue = element[j];
-              if (backwardRow_[iRow] >= 0) {
-                cost -= elementValue * duals[iRow];
-              }
-            }
-            objectiveX[jColumn] = cost;
-          }
-          OsiClpSolverInterface solverX(tempModel, true);
-          CbcModel modelX(solverX);
-          modelX.setLogLevel(1);
-          modelX.setMoreSpecialOptions2(57);
-          // need to stop after solutions and nodes
-          //modelX.setMaximumNodes(nNodes_);
-          modelX.setMaximumSolutions(1);
-          modelX.branchAndBound();
-          const double *bestSolutionX = modelX.bestSolution();
-          if (bestSolutionX) {
-            whichBlock[numberUsed++] = iBlock;
-            for (int i = start; i < end; i++) {
-              int jColumn = i - start;
-              int iColumn = columnsInBlock_[i];
-              bestSolution2[iColumn] = bestSolutionX[jColumn];
-            }
-          }
-        }
+        int numberUsed = solveBlocks(0, duals, bestSolution2, element, row,
+          columnStart, columnLength, whichBlock);
         addDW(bestSolution2, numberUsed, whichBlock);
         if (!pass_ && false) {
           // see if gives a solution
@@ -708,62 +678,8 @@ int CbcHeuristicDW::solution(double &solutionValue,
         dwSolver_->resolve();
         dwSolver_->setHintParam(OsiDoDualInResolve, takeHint, OsiHintDo);
         duals = dwSolver_->getRowPrice();
-        numberUsed = 0;
-        for (int iBlock = 0; iBlock < numberBlocks_; iBlock++) {
-          int start = startColumnBlock_[iBlock];
-          int end = startColumnBlock_[iBlock + 1];
-          ClpSimplex *tempModel = new ClpSimplex(solver->getModelPtr(),
-            startRowBlock_[iBlock + 1] - startRowBlock_[iBlock],
-            rowsInBlock_ + startRowBlock_[iBlock],
-            end - start,
-            columnsInBlock_ + startColumnBlock_[iBlock]);
-          tempModel->setLogLevel(0);
-          tempModel->setDualObjectiveLimit(COIN_DBL_MAX);
-          double *objectiveX = tempModel->objective();
-          double *columnLowerX = tempModel->columnLower();
-          double *columnUpperX = tempModel->columnUpper();
-          double convexityDual = duals[numberMasterRows_ + iBlock];
-          for (int i = start; i < end; i++) {
-            int jColumn = i - start;
-            int iColumn = columnsInBlock_[i];
-            columnLowerX[jColumn] = CoinMax(saveLower_[iColumn], -1.0e12);
-            columnUpperX[jColumn] = CoinMin(saveUpper_[iColumn], 1.0e12);
-            if (solver->isInteger(iColumn))
-              tempModel->setInteger(jColumn);
-            double cost = objectiveX[jColumn];
-            for (CoinBigIndex j = columnStart[iColumn];
-                 j < columnStart[iColumn] + columnLength[iColumn]; j++) {
-              int iRow = row[j];
-              double elementValue = element[j];
-              if (backwardRow_[iRow] >= 0) {
-                // duals are from dw
-                cost -= elementValue * duals[backwardRow_[iRow]];
-              }
-            }
-            objectiveX[jColumn] = cost;
-          }
-          OsiClpSolverInterface solverX(tempModel, true);
-          solverX.initialSolve();
-          double cObj = solverX.getObjValue();
-          CbcModel modelX(solverX);
-          modelX.setLogLevel(1);
-          modelX.setMoreSpecialOptions2(57);
-          modelX.setMaximumSolutions(1);
-          modelX.branchAndBound();
-          sprintf(dwPrint, "Block %d contobj %g intobj %g convdual %g",
-            iBlock, cObj, modelX.getObjValue(), convexityDual);
-          model_->messageHandler()->message(CBC_FPUMP2, model_->messages())
-            << dwPrint
-            << CoinMessageEol;
-          const double *bestSolutionX = modelX.bestSolution();
-          if (bestSolutionX) {
-            whichBlock[numberUsed++] = iBlock;
-            for (int i = start; i < end; i++) {
-              int iColumn = columnsInBlock_[i];
-              bestSolution2[iColumn] = bestSolutionX[i - start];
-            }
-          }
-        }
+        numberUsed = solveBlocks(1, duals, bestSolution2, element, row,
+          columnStart, columnLength, whichBlock);
         addDW(bestSolution2, numberUsed, whichBlock);
         if (!pass_ && false) {
           // see if gives a solution
@@ -1307,7 +1223,7 @@ int CbcHeuristicDW::solution(double &solutionValue,
   }
   return returnCode;
 }
-// update model
+// update model (block structure is kept if same size)
 void CbcHeuristicDW::setModel(CbcModel *model)
 {
   if (model != model_) {
@@ -1318,8 +1234,20 @@ void CbcHeuristicDW::setModel(CbcModel *model)
     findStructure();
   }
 }
-// Find structure
+// Find structure (using saved structure if there is one for this size)
 void CbcHeuristicDW::findStructure()
+{
+  int numberRows = solver_->getNumRows();
+  int numberColumns = solver_->getNumCols();
+  if (!structure_ || structure_->numberRows() != numberRows || structure_->numberColumns() != numberColumns) {
+    if (structure_ && !structure_->decrement())
+      delete structure_;
+    structure_ = detectStructure();
+  }
+  setupStructure();
+}
+// Detect block structure (expensive)
+CbcDWStructure *CbcHeuristicDW::detectStructure()
 {
   int numberRows = solver_->getNumRows();
   int numberColumns = solver_->getNumCols();
@@ -1452,7 +1380,7 @@ void CbcHeuristicDW::findStructure()
       }
     }
   }
-  numberBlocks_ = 0;
+  CbcDWStructure *structure = new CbcDWStructure(numberRows, numberColumns);
   if (firstMaster < lastMaster) {
     sprintf(dwPrint, "%d master rows %d <= < %d", lastMaster - firstMaster,
       firstMaster, lastMaster);
@@ -1598,241 +1526,485 @@ void CbcHeuristicDW::findStructure()
       }
       numberBlocks = newNumber;
     }
-    // now set up structures
-    numberBlocks_ = numberBlocks;
-    // so callBack can modify
-    whichRowBlock_ = blockStart;
-    whichColumnBlock_ = columnBlock;
-    intArray_ = NULL;
-    doubleArray_ = NULL;
-    (*(functionPointer_))(this, NULL, 0);
+    // columnBlock is columnBlock and blockStart is rowBlock
+    structure->setBlocks(numberBlocks, blockStart, columnBlock);
+  }
+  delete[] blockStart;
+  return structure;
+}
+// Set up data from block structure
+void CbcHeuristicDW::setupStructure()
+{
+  numberBlocks_ = 0;
+  int numberBlocks = structure_->numberBlocks();
+  if (numberBlocks < 0)
+    return; // no structure
+  int numberRows = solver_->getNumRows();
+  int numberColumns = solver_->getNumCols();
+  char dwPrint[200];
+  // Column copy
+  const CoinPackedMatrix *columnCopy = solver_->getMatrixByCol();
+  const int *row = columnCopy->getIndices();
+  const CoinBigIndex *columnStart = columnCopy->getVectorStarts();
+  const int *columnLength = columnCopy->getVectorLengths();
+  // copy of saved structure
+  int *blockStart = new int[numberRows + numberColumns];
+  int *columnBlock = blockStart + numberRows;
+  memcpy(blockStart, structure_->rowBlock(), numberRows * sizeof(int));
+  memcpy(columnBlock, structure_->columnBlock(), numberColumns * sizeof(int));
+  // now set up structures
+  numberBlocks_ = numberBlocks;
+  // so callBack can modify
+  whichRowBlock_ = blockStart;
+  whichColumnBlock_ = columnBlock;
+  intArray_ = NULL;
+  doubleArray_ = NULL;
+  (*(functionPointer_))(this, NULL, 0);
 
-    saveLower_ = CoinCopyOfArray(solver_->getColLower(), numberColumns);
-    saveUpper_ = CoinCopyOfArray(solver_->getColUpper(), numberColumns);
-    startRowBlock_ = new int[numberBlocks_ + 2];
-    backwardRow_ = new int[numberRows];
-    rowsInBlock_ = new int[numberRows];
-    whichRowBlock_ = new int[numberRows];
-    startColumnBlock_ = new int[numberBlocks_ + 2];
-    columnsInBlock_ = new int[numberColumns];
-    whichColumnBlock_ = new int[numberColumns];
-    intsInBlock_ = new int[numberBlocks_];
-    // use for counts
-    memset(rowsInBlock_, 0, numberBlocks_ * sizeof(int));
-    numberMasterRows_ = 0;
-    for (int i = 0; i < numberRows; i++) {
-      int iBlock = blockStart[i];
-      if (iBlock >= 0) {
-        rowsInBlock_[iBlock]++;
-        whichRowBlock_[i] = iBlock;
-        backwardRow_[i] = -1;
-      } else {
-        whichRowBlock_[i] = -1;
-        backwardRow_[i] = numberMasterRows_;
-        numberMasterRows_++;
-      }
-    }
-    memset(columnsInBlock_, 0, numberBlocks_ * sizeof(int));
-    memset(intsInBlock_, 0, numberBlocks_ * sizeof(int));
-    numberMasterColumns_ = 0;
-    for (int i = 0; i < numberColumns; i++) {
-      int iBlock = columnBlock[i];
-      if (iBlock >= 0) {
-        columnsInBlock_[iBlock]++;
-        whichColumnBlock_[i] = iBlock;
-        if (solver_->isInteger(i))
-          intsInBlock_[iBlock]++;
-      } else {
-        whichColumnBlock_[i] = -1;
-        numberMasterColumns_++;
-      }
-    }
-    // starts
-    int nRow = 0;
-    int nColumn = 0;
-    int maxIntsInBlock = 0;
-    for (int i = 0; i < numberBlocks_; i++) {
-      maxIntsInBlock = CoinMax(maxIntsInBlock, intsInBlock_[i]);
-      startRowBlock_[i] = nRow;
-      startColumnBlock_[i] = nColumn;
-      nRow += rowsInBlock_[i];
-      nColumn += columnsInBlock_[i];
-    }
-    // may not be used - but set anyway
-    sizeFingerPrint_ = (maxIntsInBlock + 31) / 32;
-    startRowBlock_[numberBlocks_] = nRow;
-    startColumnBlock_[numberBlocks_] = nColumn;
-    startRowBlock_[numberBlocks_ + 1] = numberRows;
-    startColumnBlock_[numberBlocks_ + 1] = numberColumns;
-    // do lists
-    for (int i = 0; i < numberRows; ++i) {
-      int iBlock = whichRowBlock_[i];
-      if (iBlock < 0)
-        iBlock = numberBlocks_;
-      int k = startRowBlock_[iBlock];
-      startRowBlock_[iBlock] = k + 1;
-      rowsInBlock_[k] = i;
+  saveLower_ = CoinCopyOfArray(solver_->getColLower(), numberColumns);
+  saveUpper_ = CoinCopyOfArray(solver_->getColUpper(), numberColumns);
+  startRowBlock_ = new int[numberBlocks_ + 2];
+  backwardRow_ = new int[numberRows];
+  rowsInBlock_ = new int[numberRows];
+  whichRowBlock_ = new int[numberRows];
+  startColumnBlock_ = new int[numberBlocks_ + 2];
+  columnsInBlock_ = new int[numberColumns];
+  whichColumnBlock_ = new int[numberColumns];
+  intsInBlock_ = new int[numberBlocks_];
+  // use for counts
+  memset(rowsInBlock_, 0, numberBlocks_ * sizeof(int));
+  numberMasterRows_ = 0;
+  for (int i = 0; i < numberRows; i++) {
+    int iBlock = blockStart[i];
+    if (iBlock >= 0) {
+      rowsInBlock_[iBlock]++;
+      whichRowBlock_[i] = iBlock;
+      backwardRow_[i] = -1;
+    } else {
+      whichRowBlock_[i] = -1;
+      backwardRow_[i] = numberMasterRows_;
+      numberMasterRows_++;
     }
-    for (int i = numberBlocks + 1; i > 0; i--)
-      startRowBlock_[i] = startRowBlock_[i - 1];
-    startRowBlock_[0] = 0;
-    for (int i = 0; i < numberColumns; ++i) {
-      int iBlock = whichColumnBlock_[i];
-      if (iBlock < 0)
-        iBlock = numberBlocks_;
-      int k = startColumnBlock_[iBlock];
-      startColumnBlock_[iBlock] = k + 1;
-      columnsInBlock_[k] = i;
+  }
+  memset(columnsInBlock_, 0, numberBlocks_ * sizeof(int));
+  memset(intsInBlock_, 0, numberBlocks_ * sizeof(int));
+  numberMasterColumns_ = 0;
+  for (int i = 0; i < numberColumns; i++) {
+    int iBlock = columnBlock[i];
+    if (iBlock >= 0) {
+      columnsInBlock_[iBlock]++;
+      whichColumnBlock_[i] = iBlock;
+      if (solver_->isInteger(i))
+        intsInBlock_[iBlock]++;
+    } else {
+      whichColumnBlock_[i] = -1;
+      numberMasterColumns_++;
     }
-    for (int i = numberBlocks + 1; i > 0; i--)
-      startColumnBlock_[i] = startColumnBlock_[i - 1];
-    startColumnBlock_[0] = 0;
-    if (numberBlocks_ < 10000) {
-      affinity_ = new unsigned short[numberBlocks_ * numberBlocks_];
-      // compute space needed
-      int *build = new int[numberMasterRows_];
-      memset(build, 0, numberMasterRows_ * sizeof(int));
-      int nSpace = 0;
-      for (int iBlock = 0; iBlock < numberBlocks_; iBlock++) {
-        int start = startColumnBlock_[iBlock];
-        int end = startColumnBlock_[iBlock + 1];
-        for (int i = start; i < end; i++) {
-          int iColumn = columnsInBlock_[i];
-          for (CoinBigIndex j = columnStart[iColumn];
-               j < columnStart[iColumn] + columnLength[iColumn]; j++) {
-            int iRow = row[j];
-            iRow = backwardRow_[iRow];
-            if (iRow >= 0)
-              build[iRow]++;
-          }
+  }
+  // starts
+  int nRow = 0;
+  int nColumn = 0;
+  int maxIntsInBlock = 0;
+  for (int i = 0; i < numberBlocks_; i++) {
+    maxIntsInBlock = CoinMax(maxIntsInBlock, intsInBlock_[i]);
+    startRowBlock_[i] = nRow;
+    startColumnBlock_[i] = nColumn;
+    nRow += rowsInBlock_[i];
+    nColumn += columnsInBlock_[i];
+  }
+  // may not be used - but set anyway
+  sizeFingerPrint_ = (maxIntsInBlock + 31) / 32;
+  startRowBlock_[numberBlocks_] = nRow;
+  startColumnBlock_[numberBlocks_] = nColumn;
+  startRowBlock_[numberBlocks_ + 1] = numberRows;
+  startColumnBlock_[numberBlocks_ + 1] = numberColumns;
+  // do lists
+  for (int i = 0; i < numberRows; ++i) {
+    int iBlock = whichRowBlock_[i];
+    if (iBlock < 0)
+      iBlock = numberBlocks_;
+    int k = startRowBlock_[iBlock];
+    startRowBlock_[iBlock] = k + 1;
+    rowsInBlock_[k] = i;
+  }
+  for (int i = numberBlocks + 1; i > 0; i--)
+    startRowBlock_[i] = startRowBlock_[i - 1];
+  startRowBlock_[0] = 0;
+  for (int i = 0; i < numberColumns; ++i) {
+    int iBlock = whichColumnBlock_[i];
+    if (iBlock < 0)
+      iBlock = numberBlocks_;
+    int k = startColumnBlock_[iBlock];
+    startColumnBlock_[iBlock] = k + 1;
+    columnsInBlock_[k] = i;
+  }
+  for (int i = numberBlocks + 1; i > 0; i--)
+    startColumnBlock_[i] = startColumnBlock_[i - 1];
+  startColumnBlock_[0] = 0;
+  if (numberBlocks_ < 10000) {
+    affinity_ = new unsigned short[numberBlocks_ * numberBlocks_];
+    // compute space needed
+    int *build = new int[numberMasterRows_];
+    memset(build, 0, numberMasterRows_ * sizeof(int));
+    int nSpace = 0;
+    for (int iBlock = 0; iBlock < numberBlocks_; iBlock++) {
+      int start = startColumnBlock_[iBlock];
+      int end = startColumnBlock_[iBlock + 1];
+      for (int i = start; i < end; i++) {
+        int iColumn = columnsInBlock_[i];
+        for (CoinBigIndex j = columnStart[iColumn];
+             j < columnStart[iColumn] + columnLength[iColumn]; j++) {
+          int iRow = row[j];
+          iRow = backwardRow_[iRow];
+          if (iRow >= 0)
+            build[iRow]++;
         }
-        for (int i = 0; i < numberMasterRows_; i++) {
-          int value = build[i];
-          if (value) {
-            build[i] = 0;
-            nSpace++;
-          }
+      }
+      for (int i = 0; i < numberMasterRows_; i++) {
+        int value = build[i];
+        if (value) {
+          build[i] = 0;
+          nSpace++;
         }
       }
-      // get arrays
-      int *starts = new int[numberBlocks_ + 1 + 2 * nSpace];
-      memset(affinity_, 0, numberBlocks_ * numberBlocks_ * sizeof(unsigned short));
-      // fill arrays
-      int *rowM = starts + numberBlocks_ + 1;
-      int *sumM = rowM + nSpace;
-      nSpace = 0;
-      starts[0] = 0;
-      for (int iBlock = 0; iBlock < numberBlocks_; iBlock++) {
-        int start = startColumnBlock_[iBlock];
-        int end = startColumnBlock_[iBlock + 1];
-        for (int i = start; i < end; i++) {
-          int iColumn = columnsInBlock_[i];
-          for (CoinBigIndex j = columnStart[iColumn];
-               j < columnStart[iColumn] + columnLength[iColumn]; j++) {
-            int iRow = row[j];
-            iRow = backwardRow_[iRow];
-            if (iRow >= 0)
-              build[iRow]++;
-          }
+    }
+    // get arrays
+    int *starts = new int[numberBlocks_ + 1 + 2 * nSpace];
+    memset(affinity_, 0, numberBlocks_ * numberBlocks_ * sizeof(unsigned short));
+    // fill arrays
+    int *rowM = starts + numberBlocks_ + 1;
+    int *sumM = rowM + nSpace;
+    nSpace = 0;
+    starts[0] = 0;
+    for (int iBlock = 0; iBlock < numberBlocks_; iBlock++) {
+      int start = startColumnBlock_[iBlock];
+      int end = startColumnBlock_[iBlock + 1];
+      for (int i = start; i < end; i++) {
+        int iColumn = columnsInBlock_[i];
+        for (CoinBigIndex j = columnStart[iColumn];
+             j < columnStart[iColumn] + columnLength[iColumn]; j++) {
+          int iRow = row[j];
+          iRow = backwardRow_[iRow];
+          if (iRow >= 0)
+            build[iRow]++;
         }
-        for (int i = 0; i < numberMasterRows_; i++) {
-          int value = build[i];
-          if (value) {
-            build[i] = 0;
-            sumM[nSpace] = value;
-            rowM[nSpace++] = i;
-          }
+      }
+      for (int i = 0; i < numberMasterRows_; i++) {
+        int value = build[i];
+        if (value) {
+          build[i] = 0;
+          sumM[nSpace] = value;
+          rowM[nSpace++] = i;
         }
-        starts[iBlock + 1] = nSpace;
       }
-      for (int iBlock = 0; iBlock < numberBlocks_; iBlock++) {
-        int startI = starts[iBlock];
-        int endI = starts[iBlock + 1];
-        if (endI == startI)
+      starts[iBlock + 1] = nSpace;
+    }
+    for (int iBlock = 0; iBlock < numberBlocks_; iBlock++) {
+      int startI = starts[iBlock];
+      int endI = starts[iBlock + 1];
+      if (endI == startI)
+        continue;
+      for (int jBlock = iBlock + 1; jBlock < numberBlocks_; jBlock++) {
+        int startJ = starts[jBlock];
+        int endJ = starts[jBlock + 1];
+        if (endJ == startJ)
           continue;
-        for (int jBlock = iBlock + 1; jBlock < numberBlocks_; jBlock++) {
-          int startJ = starts[jBlock];
-          int endJ = starts[jBlock + 1];
-          if (endJ == startJ)
-            continue;
-          double sum = 0.0;
-          int i = startI;
-          int j = startJ;
-          int rowI = rowM[i];
-          int rowJ = rowM[j];
-          while (rowI != COIN_INT_MAX && rowJ != COIN_INT_MAX) {
-            if (rowI < rowJ) {
-              i++;
-              if (i < endI)
-                rowI = rowM[i];
-              else
-                rowI = COIN_INT_MAX;
-            } else if (rowI > rowJ) {
-              j++;
-              if (j < endJ)
-                rowJ = rowM[j];
-              else
-                rowJ = COIN_INT_MAX;
-            } else {
-              // bias ????????
-              sum += sumM[i] * sumM[j];
-              i++;
-              if (i < endI)
-                rowI = rowM[i];
-              else
-                rowI = COIN_INT_MAX;
-              j++;
-              if (j < endJ)
-                rowJ = rowM[j];
-              else
-                rowJ = COIN_INT_MAX;
-            }
+        double sum = 0.0;
+        int i = startI;
+        int j = startJ;
+        int rowI = rowM[i];
+        int rowJ = rowM[j];
+        while (rowI != COIN_INT_MAX && rowJ != COIN_INT_MAX) {
+          if (rowI < rowJ) {
+            i++;
+            if (i < endI)
+              rowI = rowM[i];
+            else
+              rowI = COIN_INT_MAX;
+          } else if (rowI > rowJ) {
+            j++;
+            if (j < endJ)
+              rowJ = rowM[j];
+            else
+              rowJ = COIN_INT_MAX;
+          } else {
+            // bias ????????
+            sum += sumM[i] * sumM[j];
+            i++;
+            if (i < endI)
+              rowI = rowM[i];
+            else
+              rowI = COIN_INT_MAX;
+            j++;
+            if (j < endJ)
+              rowJ = rowM[j];
+            else
+              rowJ = COIN_INT_MAX;
           }
-          if (sum > 65535)
-            sum = 65535;
-          unsigned short value = static_cast< unsigned short >(sum);
-          affinity_[iBlock * numberBlocks + jBlock] = value;
-          affinity_[jBlock * numberBlocks + iBlock] = value;
         }
+        if (sum > 65535)
+          sum = 65535;
+        unsigned short value = static_cast< unsigned short >(sum);
+        affinity_[iBlock * numberBlocks + jBlock] = value;
+        affinity_[jBlock * numberBlocks + iBlock] = value;
       }
-      // statistics
-      int nTotalZero = 0;
-      int base = 0;
-      for (int iBlock = 0; iBlock < numberBlocks_; iBlock++) {
-        int aff = 0;
-        int nZero = 0;
-        for (int jBlock = 0; jBlock < numberBlocks_; jBlock++) {
-          if (iBlock != jBlock) {
-            if (affinity_[base + jBlock])
-              aff += affinity_[base + jBlock];
-            else
-              nZero++;
-          }
+    }
+    // statistics
+    int nTotalZero = 0;
+    int base = 0;
+    for (int iBlock = 0; iBlock < numberBlocks_; iBlock++) {
+      int aff = 0;
+      int nZero = 0;
+      for (int jBlock = 0; jBlock < numberBlocks_; jBlock++) {
+        if (iBlock != jBlock) {
+          if (affinity_[base + jBlock])
+            aff += affinity_[base + jBlock];
+          else
+            nZero++;
         }
-        //printf("Block %d has affinity %d but zero with %d blocks",
-        //     iBlock,aff,nZero);
-        nTotalZero += nZero;
-        base += numberBlocks;
       }
-      sprintf(dwPrint, "Total not affinity %d - average %g%%",
-        nTotalZero, 100.0 * (static_cast< double >(nTotalZero) / (numberBlocks * numberBlocks)));
-      model_->messageHandler()->message(CBC_FPUMP1, model_->messages())
-        << dwPrint
-        << CoinMessageEol;
+      //printf("Block %d has affinity %d but zero with %d blocks",
+      //     iBlock,aff,nZero);
+      nTotalZero += nZero;
+      base += numberBlocks;
+    }
+    sprintf(dwPrint, "Total not affinity %d - average %g%%",
+      nTotalZero, 100.0 * (static_cast< double >(nTotalZero) / (numberBlocks * numberBlocks)));
+    model_->messageHandler()->message(CBC_FPUMP1, model_->messages())
+      << dwPrint
+      << CoinMessageEol;
 
-      delete[] starts;
-      delete[] build;
-    } else {
-      sprintf(dwPrint, "Too many blocks - no affinity");
-      model_->messageHandler()->message(CBC_FPUMP1, model_->messages())
+    delete[] starts;
+    delete[] build;
+  } else {
+    sprintf(dwPrint, "Too many blocks - no affinity");
+    model_->messageHandler()->message(CBC_FPUMP1, model_->messages())
+      << dwPrint
+      << CoinMessageEol;
+  }
+  if (fullDWEverySoOften_ > 0) {
+    setupDWStructures();
+  }
+  delete[] blockStart;
+}
+/* Write block structure to file so later runs can skip detection.
+   Returns 0 if okay */
+int CbcHeuristicDW::writeStructure(const char *fileName) const
+{
+  if (!structure_)
+    return 1;
+  FILE *fp = fopen(fileName, "w");
+  if (!fp)
+    return 1;
+  int numberRows = structure_->numberRows();
+  int numberColumns = structure_->numberColumns();
+  int numberBlocks = structure_->numberBlocks();
+  fprintf(fp, "CbcHeuristicDW %d %d %d\n", numberRows, numberColumns,
+    numberBlocks);
+  if (numberBlocks >= 0) {
+    const int *rowBlock = structure_->rowBlock();
+    const int *columnBlock = structure_->columnBlock();
+    for (int i = 0; i < numberRows; i++)
+      fprintf(fp, "%d\n", rowBlock[i]);
+    for (int i = 0; i < numberColumns; i++)
+      fprintf(fp, "%d\n", columnBlock[i]);
+  }
+  fclose(fp);
+  return 0;
+}
+/* Read block structure from file (as written by writeStructure).
+   If heuristic has a model then it is set up again using structure.
+   Returns 0 if okay, 1 if can not read, 2 if wrong size for model */
+int CbcHeuristicDW::readStructure(const char *fileName)
+{
+  FILE *fp = fopen(fileName, "r");
+  if (!fp)
+    return 1;
+  int numberRows = -1;
+  int numberColumns = -1;
+  int numberBlocks = -1;
+  if (fscanf(fp, "CbcHeuristicDW %d %d %d", &numberRows, &numberColumns,
+        &numberBlocks)
+      != 3 || numberRows < 0 || numberColumns < 0) {
+    fclose(fp);
+    return 1;
+  }
+  if (solver_ && (numberRows != solver_->getNumRows() || numberColumns != solver_->getNumCols())) {
+    fclose(fp);
+    return 2;
+  }
+  CbcDWStructure *structure = new CbcDWStructure(numberRows, numberColumns);
+  if (numberBlocks >= 0) {
+    int *rowBlock = new int[numberRows + numberColumns];
+    int *columnBlock = rowBlock + numberRows;
+    bool good = true;
+    for (int i = 0; i < numberRows + numberColumns; i++) {
+      if (fscanf(fp, "%d", rowBlock + i) != 1 || rowBlock[i] >= numberBlocks) {
+        good = false;
+        break;
+      }
+    }
+    if (good)
+      structure->setBlocks(numberBlocks, rowBlock, columnBlock);
+    delete[] rowBlock;
+    if (!good) {
+      delete structure;
+      fclose(fp);
+      return 1;
+    }
+  }
+  fclose(fp);
+  if (structure_ && !structure_->decrement())
+    delete structure_;
+  structure_ = structure;
+  if (model_) {
+    // redo with this structure
+    CbcModel *model = model_;
+    gutsOfDelete();
+    model_ = NULL;
+    setModel(model);
+  }
+  return 0;
+}
+#ifdef CBC_THREAD
+// Solve a block on a thread
+static void *solveBlockInPool(void *stuff)
+{
+  CbcDWBlock *block = reinterpret_cast< CbcDWBlock * >(stuff);
+  block->heuristic->solveBlock(*block);
+  return NULL;
+}
+#endif
+/* Solve subproblem for each block (using threads if numberThreads_ > 1)
+   type 0 - duals are for rows of solver, 1 - duals are from DW.
+   Block solutions go into solution and blocks with solution are
+   put in whichBlock in block order.  Returns number of blocks with
+   solution */
+int CbcHeuristicDW::solveBlocks(int type, const double *duals,
+  double *solution, const double *element, const int *row,
+  const CoinBigIndex *columnStart, const int *columnLength,
+  int *whichBlock)
+{
+  OsiClpSolverInterface *solver = dynamic_cast< OsiClpSolverInterface * >(solver_);
+  CbcDWBlock *blocks = new CbcDWBlock[numberBlocks_];
+  int numberThreads = CoinMin(numberThreads_, numberBlocks_);
+  for (int iBlock = 0; iBlock < numberBlocks_; iBlock++) {
+    CbcDWBlock &block = blocks[iBlock];
+    block.heuristic = this;
+    block.solver = solver;
+    block.duals = duals;
+    block.element = element;
+    block.row = row;
+    block.columnStart = columnStart;
+    block.columnLength = columnLength;
+    block.solution = solution;
+    block.continuousObjective = 0.0;
+    block.integerObjective = COIN_DBL_MAX;
+    block.iBlock = iBlock;
+    block.type = type;
+    // do not mix output from threads
+    block.logLevel = (numberThreads > 1) ? 0 : 1;
+    block.found = 0;
+  }
+#ifdef CBC_THREAD
+  if (numberThreads > 1) {
+    if (!threadPool_ || threadPool_->numberThreads() < numberThreads) {
+      delete threadPool_;
+      threadPool_ = new CbcThreadPool(numberThreads);
+    }
+    // blocks only change their own columns of solution
+    threadPool_->run(solveBlockInPool, numberBlocks_, blocks,
+      static_cast< int >(sizeof(CbcDWBlock)));
+  } else {
+#endif
+    for (int iBlock = 0; iBlock < numberBlocks_; iBlock++)
+      solveBlock(blocks[iBlock]);
+#ifdef CBC_THREAD
+  }
+#endif
+  // merge in block order so same as serial
+  char dwPrint[200];
+  int numberUsed = 0;
+  for (int iBlock = 0; iBlock < numberBlocks_; iBlock++) {
+    CbcDWBlock &block = blocks[iBlock];
+    if (type) {
+      sprintf(dwPrint, "Block %d contobj %g intobj %g convdual %g",
+        iBlock, block.continuousObjective, block.integerObjective,
+        duals[numberMasterRows_ + iBlock]);
+      model_->messageHandler()->message(CBC_FPUMP2, model_->messages())
         << dwPrint
         << CoinMessageEol;
     }
-    if (fullDWEverySoOften_ > 0) {
-      setupDWStructures();
+    if (block.found)
+      whichBlock[numberUsed++] = iBlock;
+  }
+  delete[] blocks;
+  return numberUsed;
+}
+// Solve subproblem for one block (may be called on a thread)
+void CbcHeuristicDW::solveBlock(CbcDWBlock &block) const
+{
+  OsiClpSolverInterface *solver = block.solver;
+  const double *duals = block.duals;
+  const double *element = block.element;
+  const int *row = block.row;
+  const CoinBigIndex *columnStart = block.columnStart;
+  const int *columnLength = block.columnLength;
+  int iBlock = block.iBlock;
+  int start = startColumnBlock_[iBlock];
+  int end = startColumnBlock_[iBlock + 1];
+  ClpSimplex *tempModel = new ClpSimplex(solver->getModelPtr(),
+    startRowBlock_[iBlock + 1] - startRowBlock_[iBlock],
+    rowsInBlock_ + startRowBlock_[iBlock],
+    end - start,
+    columnsInBlock_ + startColumnBlock_[iBlock]);
+  tempModel->setLogLevel(0);
+  tempModel->setDualObjectiveLimit(COIN_DBL_MAX);
+  double *objectiveX = tempModel->objective();
+  double *columnLowerX = tempModel->columnLower();
+  double *columnUpperX = tempModel->columnUpper();
+  for (int i = start; i < end; i++) {
+    int jColumn = i - start;
+    int iColumn = columnsInBlock_[i];
+    columnLowerX[jColumn] = CoinMax(saveLower_[iColumn], -1.0e12);
+    columnUpperX[jColumn] = CoinMin(saveUpper_[iColumn], 1.0e12);
+    if (solver->isInteger(iColumn))
+      tempModel->setInteger(jColumn);
+    double cost = objectiveX[jColumn];
+    for (CoinBigIndex j = columnStart[iColumn];
+         j < columnStart[iColumn] + columnLength[iColumn]; j++) {
+      int iRow = row[j];
+      double elementValue = element[j];
+      if (backwardRow_[iRow] >= 0) {
+        if (!block.type)
+          cost -= elementValue * duals[iRow];
+        else
+          cost -= elementValue * duals[backwardRow_[iRow]]; // duals are from dw
+      }
+    }
+    objectiveX[jColumn] = cost;
+  }
+  OsiClpSolverInterface solverX(tempModel, true);
+  if (block.type) {
+    solverX.initialSolve();
+    block.continuousObjective = solverX.getObjValue();
+  }
+  CbcModel modelX(solverX);
+  modelX.setLogLevel(block.logLevel);
+  modelX.setMoreSpecialOptions2(57);
+  // need to stop after solutions and nodes
+  //modelX.setMaximumNodes(nNodes_);
+  modelX.setMaximumSolutions(1);
+  modelX.branchAndBound();
+  block.integerObjective = modelX.getObjValue();
+  const double *bestSolutionX = modelX.bestSolution();
+  if (bestSolutionX) {
+    block.found = 1;
+    for (int i = start; i < end; i++) {
+      int iColumn = columnsInBlock_[i];
+      block.solution[iColumn] = bestSolutionX[i - start];
     }
   }
-  delete[] blockStart;
 }
 // Add DW proposals
 int CbcHeuristicDW::addDW(const double *solution, int numberBlocksUsed,
@@ -2197,5 +2369,32 @@ void CbcHeuristicDW::setupDWStructures()
   delete[] tempRow;
 }
 
+// Constructor - no structure
+CbcDWStructure::CbcDWStructure(int numberRows, int numberColumns)
+  : rowBlock_(NULL)
+  , columnBlock_(NULL)
+  , numberRows_(numberRows)
+  , numberColumns_(numberColumns)
+  , numberBlocks_(-1)
+  , referenceCount_(1)
+{
+}
+// Destructor
+CbcDWStructure::~CbcDWStructure()
+{
+  delete[] rowBlock_;
+}
+// Set blocks (copies arrays)
+void CbcDWStructure::setBlocks(int numberBlocks, const int *rowBlock,
+  const int *columnBlock)
+{
+  delete[] rowBlock_;
+  numberBlocks_ = numberBlocks;
+  rowBlock_ = new int[numberRows_ + numberColumns_];
+  columnBlock_ = rowBlock_ + numberRows_;
+  memcpy(rowBlock_, rowBlock, numberRows_ * sizeof(int));
+  memcpy(columnBlock_, columnBlock, numberColumns_ * sizeof(int));
+}
+
 /* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
 */
@@ -6,6 +6,95 @@
 #define CbcHeuristicDW_H
 
 #include "CbcHeuristic.hpp"
+class OsiClpSolverInterface;
+class CbcThreadPool;
+class CbcHeuristicDW;
+
+/** Block structure found by CbcHeuristicDW (expensive to detect).
+    Shared read only by copies of heuristic (reference counted).
+    Blocks for rows and columns are as detected before callBack.
+ */
+
+class CBCLIB_EXPORT CbcDWStructure {
+public:
+  /// Constructor - no structure
+  CbcDWStructure(int numberRows, int numberColumns);
+  /// Destructor
+  ~CbcDWStructure();
+  /// Set blocks (copies arrays)
+  void setBlocks(int numberBlocks, const int *rowBlock,
+    const int *columnBlock);
+  /// Number of rows
+  inline int numberRows() const
+  {
+    return numberRows_;
+  }
+  /// Number of columns
+  inline int numberColumns() const
+  {
+    return numberColumns_;
+  }
+  /// Number of blocks (-1 if no structure)
+  inline int numberBlocks() const
+  {
+    return numberBlocks_;
+  }
+  /// Block for every row (negative if master or empty)
+  inline const int *rowBlock() const
+  {
+    return rowBlock_;
+  }
+  /// Block for every column (negative if master)
+  inline const int *columnBlock() const
+  {
+    return columnBlock_;
+  }
+  /// Add a user
+  inline void increment()
+  {
+    referenceCount_++;
+  }
+  /// Take off a user and return number left
+  inline int decrement()
+  {
+    return --referenceCount_;
+  }
+
+private:
+  /// Illegal
+  CbcDWStructure(const CbcDWStructure &);
+  CbcDWStructure &operator=(const CbcDWStructure &);
+  /// Block for every row
+  int *rowBlock_;
+  /// Block for every column (part of rowBlock_ array)
+  int *columnBlock_;
+  /// Number of rows
+  int numberRows_;
+  /// Number of columns
+  int numberColumns_;
+  /// Number of blocks
+  int numberBlocks_;
+  /// Number of heuristics using
+  int referenceCount_;
+};
+
+/// Data for solving subproblem of one block (may be on a thread)
+typedef struct {
+  CbcHeuristicDW *heuristic;
+  OsiClpSolverInterface *solver;
+  const double *duals;
+  const double *element;
+  const int *row;
+  const CoinBigIndex *columnStart;
+  const int *columnLength;
+  double *solution; // block columns set if found
+  double continuousObjective;
+  double integerObjective;
+  int iBlock;
+  int type; // 0 duals for rows of solver, 1 duals from DW
+  int logLevel;
+  int found;
+} CbcDWBlock;
 
 /** 
     This is unlike the other heuristics in that it is very very compute intensive.
@@ -235,6 +324,32 @@ public:
   }
   /// Objective value (could also check validity)
   double objectiveValue(const double *solution);
+  /** Write block structure to file so later runs of same model
+      can skip detection.  Returns 0 if okay */
+  int writeStructure(const char *fileName) const;
+  /** Read block structure from file (as written by writeStructure).
+      If heuristic has a model it is set up again using structure,
+      otherwise structure is used by setModel.
+      Returns 0 if okay, 1 if can not read, 2 if wrong size for model */
+  int readStructure(const char *fileName);
+  /// Block structure (shared by copies)
+  inline const CbcDWStructure *structure() const
+  {
+    return structure_;
+  }
+  /** Set number of threads for solving block subproblems
+      (0 or 1 - one after another).  Results are same as serial */
+  inline void setNumberThreads(int value)
+  {
+    numberThreads_ = value;
+  }
+  /// Number of threads for solving block subproblems
+  inline int numberThreads() const
+  {
+    return numberThreads_;
+  }
+  /// Solve subproblem for one block (public so threads can call)
+  void solveBlock(CbcDWBlock &block) const;
 
 private:
   /// Guts of copy
@@ -243,10 +358,19 @@ private:
   void gutsOfDelete();
   /// Set default values
   void setDefaults();
-  /// Find structure
+  /// Find structure (using saved structure if there is one for this size)
   void findStructure();
+  /// Detect block structure (expensive)
+  CbcDWStructure *detectStructure();
+  /// Set up data from block structure
+  void setupStructure();
   /// Set up DW structure
   void setupDWStructures();
+  /// Solve subproblem for each block - returns number with solution
+  int solveBlocks(int type, const double *duals, double *solution,
+    const double *element, const int *row,
+    const CoinBigIndex *columnStart, const int *columnLength,
+    int *whichBlock);
   /// Add DW proposals
   int addDW(const double *solution, int numberBlocksUsed,
     const int *whichBlocks);
@@ -279,6 +403,10 @@ protected:
   int *intArray_;
   /// Local double arrays (each numberBlocks_ long)
   double *doubleArray_;
+  /// Block structure (shared by copies)
+  CbcDWStructure *structure_;
+  /// Threads for block subproblems (created when needed)
+  CbcThreadPool *threadPool_;
   /// Base solver
   OsiSolverInterface *solver_;
   /// DW solver
@@ -365,6 +493,8 @@ protected:
   int numberBadPasses_;
   // 0 - fine, 1 can't be better, 2 max node
   int solveState_;
+  /// Number of threads for block subproblems
+  int numberThreads_;
 };
 
 #endif
@@ -35,6 +35,7 @@ CbcHeuristicDive::CbcHeuristicDive()
   downArray_ = NULL;
   upArray_ = NULL;
   priority_ = NULL;
+  sharedObjective_ = NULL;
   percentageToFix_ = 0.2;
   maxIterations_ = 100;
   maxSimplexIterations_ = 10000;
@@ -54,6 +55,7 @@ CbcHeuristicDive::CbcHeuristicDive(CbcModel &model)
   downArray_ = NULL;
   upArray_ = NULL;
   priority_ = NULL;
+  sharedObjective_ = NULL;
   // Get a copy of original matrix
   assert(model.solver());
   // model may have empty matrix - wait until setModel
@@ -113,6 +115,7 @@ CbcHeuristicDive::CbcHeuristicDive(const CbcHeuristicDive &rhs)
   , matrixByRow_(rhs.matrixByRow_)
   , percentageToFix_(rhs.percentageToFix_)
   , maxTime_(rhs.maxTime_)
+  , sharedObjective_(NULL)
   , smallObjective_(rhs.smallObjective_)
   , maxIterations_(rhs.maxIterations_)
   , maxSimplexIterations_(rhs.maxSimplexIterations_)
@@ -397,6 +400,19 @@ int CbcHeuristicDive::solution(double &solutionValue, int &numberNodes,
     }
   }
 
+  /*
+    Integers not fixed when pass started.  Bounds are only tightened
+    except when fixings of same pass are backed off, so this is a
+    superset of free integers and only gets shorter.
+  */
+  int *freeInteger = new int[numberIntegers];
+  int numberFreeIntegers = 0;
+  for (int i = 0; i < numberIntegers; i++) {
+    int iColumn = integerVariable[i];
+    if (isHeuristicInteger(solver, iColumn) && upper[iColumn] > lower[iColumn])
+      freeInteger[numberFreeIntegers++] = i;
+  }
+
   const double *reducedCost = NULL;
   // See if not NLP
   if (!model_->solverCharacteristics() || model_->solverCharacteristics()->reducedCostsAccurate())
@@ -504,11 +520,22 @@ int CbcHeuristicDive::solution(double &solutionValue, int &numberNodes,
 #endif
     }
 
+    // forget integers fixed in last pass
+    {
+      int n = 0;
+      for (int k = 0; k < numberFreeIntegers; k++) {
+        int i = freeInteger[k];
+        int iColumn = integerVariable[i];
+        if (upper[iColumn] > lower[iColumn])
+          freeInteger[n++] = i;
+      }
+      numberFreeIntegers = n;
+    }
     // do reduced cost fixing
 #if DIVE_PRINT > 1
-    numberReducedCostFixed = reducedCostFix(solver);
+    numberReducedCostFixed = reducedCostFix(solver, freeInteger, numberFreeIntegers);
 #else
-    reducedCostFix(solver);
+    reducedCostFix(solver, freeInteger, numberFreeIntegers);
 #endif
 
     numberAtBoundFixed = 0;
@@ -910,6 +937,9 @@ int CbcHeuristicDive::solution(double &solutionValue, int &numberNodes,
       reasonToStop += 2;
     } else if (CoinCpuTime() - time1 > maxTime_) {
       reasonToStop += 3;
+    } else if (sharedObjective_ && *sharedObjective_ < solutionValue) {
+      // another dive has found a better solution
+      reasonToStop += 6;
     } else if (numberSimplexIterations > maxSimplexIterations) {
       reasonToStop += 4;
       // also switch off
@@ -931,10 +961,9 @@ int CbcHeuristicDive::solution(double &solutionValue, int &numberNodes,
     memcpy(newSolution, solution, numberColumns * sizeof(double));
     numberFractionalVariables = 0;
     double sumFractionalVariables = 0.0;
-    for (int i = 0; i < numberIntegers; i++) {
-      int iColumn = integerVariable[i];
-      if (!isHeuristicInteger(solver, iColumn))
-        continue;
+    // fixed integers can not be fractional
+    for (int k = 0; k < numberFreeIntegers; k++) {
+      int iColumn = integerVariable[freeInteger[k]];
       double value = newSolution[iColumn];
       double away = fabs(floor(value + 0.5) - value);
       if (away > integerTolerance) {
@@ -1105,6 +1134,7 @@ int CbcHeuristicDive::solution(double &solutionValue, int &numberNodes,
   delete[] fixedAtLowerBound;
   delete[] candidate;
   delete[] random;
+  delete[] freeInteger;
   delete[] downArray_;
   downArray_ = NULL;
   delete[] upArray_;
@@ -1399,7 +1429,12 @@ void CbcHeuristicDive::selectBinaryVariables()
 */
 
 int CbcHeuristicDive::reducedCostFix(OsiSolverInterface *solver)
-
+{
+  return reducedCostFix(solver, NULL, model_->numberIntegers());
+}
+// Reduced cost fixing on integers in which (all if NULL)
+int CbcHeuristicDive::reducedCostFix(OsiSolverInterface *solver,
+  const int *which, int numberWhich)
 {
   //return 0; // temp
 #ifndef JJF_ONE
@@ -1427,7 +1462,6 @@ int CbcHeuristicDive::reducedCostFix(OsiSolverInterface *solver)
   const double *solution = solver->getColSolution();
   const double *reducedCost = solver->getReducedCost();
 
-  int numberIntegers = model_->numberIntegers();
   const int *integerVariable = model_->integerVariable();
 
   int numberFixed = 0;
@@ -1439,7 +1473,8 @@ int CbcHeuristicDive::reducedCostFix(OsiSolverInterface *solver)
   if (clpSolver)
     clpSimplex = clpSolver->getModelPtr();
 #endif
-  for (int i = 0; i < numberIntegers; i++) {
+  for (int k = 0; k < numberWhich; k++) {
+    int i = which ? which[k] : k;
     int iColumn = integerVariable[i];
     if (!isHeuristicInteger(solver, iColumn))
       continue;
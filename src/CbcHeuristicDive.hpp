@@ -113,6 +113,13 @@ public:
     maxTime_ = value;
   }
 
+  /** Set best objective found by dives running at same time as this one
+      (or NULL).  Dive stops once it is better than objective passed in */
+  void setSharedObjective(const volatile double *value)
+  {
+    sharedObjective_ = value;
+  }
+
   /// Tests if the heuristic can run
   virtual bool canHeuristicRun();
 
@@ -133,6 +140,10 @@ public:
 
   /// Perform reduced cost fixing on integer variables
   int reducedCostFix(OsiSolverInterface *solver);
+  /** Same on integers which[0..numberWhich-1] (positions in
+      model integerVariable) - all if which NULL */
+  int reducedCostFix(OsiSolverInterface *solver, const int *which,
+    int numberWhich);
   /// Fix other variables at bounds
   virtual int fixOtherVariables(OsiSolverInterface *solver,
     const double *solution,
@@ -179,6 +190,9 @@ protected:
   // Maximum time allowed
   double maxTime_;
 
+  // Best objective of dives running at same time (not owned, not copied)
+  const volatile double *sharedObjective_;
+
   // Small objective (i.e. treat zero objective as this)
   double smallObjective_;
 
@@ -26,6 +26,7 @@
 #include "CbcEventHandler.hpp"
 #ifdef SWITCH_VARIABLES
 #include "CbcSimpleIntegerDynamicPseudoCost.hpp"
+#include "CbcThread.hpp"
 #endif
 
 // Default Constructor
@@ -47,6 +48,8 @@ CbcHeuristicFPump::CbcHeuristicFPump()
   , accumulate_(0)
   , fixOnReducedCosts_(1)
   , roundExpensive_(false)
+  , parallelRuns_(0)
+  , sharedObjective_(NULL)
 {
   setWhen(1);
 }
@@ -71,6 +74,8 @@ CbcHeuristicFPump::CbcHeuristicFPump(CbcModel &model,
   , accumulate_(0)
   , fixOnReducedCosts_(1)
   , roundExpensive_(roundExpensive)
+  , parallelRuns_(0)
+  , sharedObjective_(NULL)
 {
   setWhen(1);
 }
@@ -149,6 +154,10 @@ void CbcHeuristicFPump::generateCpp(FILE *fp)
     fprintf(fp, "3  heuristicFPump.setReducedCostMultiplier(%g);\n", reducedCostMultiplier_);
   else
     fprintf(fp, "4  heuristicFPump.setReducedCostMultiplier(%g);\n", reducedCostMultiplier_);
+  if (parallelRuns_ != other.parallelRuns_)
+    fprintf(fp, "3  heuristicFPump.setParallelRuns(%d);\n", parallelRuns_);
+  else
+    fprintf(fp, "4  heuristicFPump.setParallelRuns(%d);\n", parallelRuns_);
   fprintf(fp, "3  cbcModel->addHeuristic(&heuristicFPump);\n");
 }
 
@@ -171,6 +180,8 @@ CbcHeuristicFPump::CbcHeuristicFPump(const CbcHeuristicFPump &rhs)
   , accumulate_(rhs.accumulate_)
   , fixOnReducedCosts_(rhs.fixOnReducedCosts_)
   , roundExpensive_(rhs.roundExpensive_)
+  , parallelRuns_(rhs.parallelRuns_)
+  , sharedObjective_(NULL)
 {
 }
 
@@ -196,6 +207,8 @@ CbcHeuristicFPump::operator=(const CbcHeuristicFPump &rhs)
     accumulate_ = rhs.accumulate_;
     fixOnReducedCosts_ = rhs.fixOnReducedCosts_;
     roundExpensive_ = rhs.roundExpensive_;
+    parallelRuns_ = rhs.parallelRuns_;
+    sharedObjective_ = NULL;
   }
   return *this;
 }
@@ -205,6 +218,24 @@ void CbcHeuristicFPump::resetModel(CbcModel *)
 {
 }
 
+/* Hash of integer part of rounded solution - equal solutions give equal
+   hash so a full comparison is only needed when hashes match */
+static unsigned int hashIntegers(const double *solution,
+  int numberIntegers, const int *integerVariable)
+{
+  unsigned int hash = 2166136261u;
+  for (int i = 0; i < numberIntegers; i++) {
+    double value = solution[integerVariable[i]];
+    int iValue;
+    if (value > -1.0e9 && value < 1.0e9)
+      iValue = static_cast< int >(floor(value + 0.5));
+    else
+      iValue = (value < 0.0) ? -1000000001 : 1000000001;
+    hash = (hash ^ static_cast< unsigned int >(iValue)) * 16777619u;
+  }
+  return hash;
+}
+
 /**************************BEGIN MAIN PROCEDURE ***********************************/
 
 // See if feasibility pump will give better solution
@@ -684,10 +715,12 @@ int CbcHeuristicFPump::solutionInternal(double &solutionValue,
     // 2 space for last rounded solutions
 #define NUMBER_OLD 4
     double **oldSolution = new double *[NUMBER_OLD];
+    unsigned int oldHash[NUMBER_OLD];
     for (j = 0; j < NUMBER_OLD; j++) {
       oldSolution[j] = new double[numberColumns];
       for (i = 0; i < numberColumns; i++)
         oldSolution[j][i] = -COIN_DBL_MAX;
+      oldHash[j] = hashIntegers(oldSolution[j], numberIntegers, integerVariable);
     }
 
     // 3. Replace objective with an initial 0-valued objective
@@ -816,6 +849,11 @@ int CbcHeuristicFPump::solutionInternal(double &solutionValue,
         // force exit
         switches_ |= 2048;
       }
+      if (sharedObjective_ && *sharedObjective_ < solutionValue) {
+        // another of parallel runs has done better
+        exitAll = true;
+        switches_ |= 2048;
+      }
       if (exitAll || exitThis)
         break;
       memcpy(newSolution, solution, numberColumns * sizeof(double));
@@ -1102,8 +1140,11 @@ int CbcHeuristicFPump::solutionInternal(double &solutionValue,
       } else {
         // SOLUTION IS not INTEGER
         // 1. check for loop
-        bool matched;
+        bool matched = false;
+        unsigned int newHash = hashIntegers(newSolution, numberIntegers, integerVariable);
         for (int k = NUMBER_OLD - 1; k > 0; k--) {
+          if (oldHash[k] != newHash)
+            continue;
           double *b = oldSolution[k];
           matched = true;
           for (i = 0; i < numberIntegers; i++) {
@@ -1194,12 +1235,15 @@ int CbcHeuristicFPump::solutionInternal(double &solutionValue,
           }
           delete[] randomX;
         } else {
+          // oldest goes to front (so just one copy)
+          double *temp = oldSolution[NUMBER_OLD - 1];
           for (j = NUMBER_OLD - 1; j > 0; j--) {
-            for (i = 0; i < numberColumns; i++)
-              oldSolution[j][i] = oldSolution[j - 1][i];
+            oldSolution[j] = oldSolution[j - 1];
+            oldHash[j] = oldHash[j - 1];
           }
-          for (j = 0; j < numberColumns; j++)
-            oldSolution[0][j] = newSolution[j];
+          memcpy(temp, newSolution, numberColumns * sizeof(double));
+          oldSolution[0] = temp;
+          oldHash[0] = newHash;
         }
 
         // 2. update the objective function based on the new rounded solution
@@ -1223,7 +1267,9 @@ int CbcHeuristicFPump::solutionInternal(double &solutionValue,
           // Special code for "artificials"
           if (direction * saveObjective[iColumn] >= artificialCost_) {
             //solver->setObjCoeff(iColumn,scaleFactor*saveObjective[iColumn]);
-            solver->setObjCoeff(iColumn, (artificialFactor * saveObjective[iColumn]) / artificialCost_);
+            double newValue = (artificialFactor * saveObjective[iColumn]) / artificialCost_;
+            if (newValue != oldObjective[iColumn])
+              solver->setObjCoeff(iColumn, newValue);
           }
           if (!solver->isBinary(iColumn) && !doGeneral)
             continue;
@@ -1249,10 +1295,11 @@ int CbcHeuristicFPump::solutionInternal(double &solutionValue,
           if (!offRandom)
             newValue *= randomFactor[iColumn];
 #endif
+          // only changes so solver can keep as much as possible
           if (newValue != oldObjective[iColumn]) {
             numberChanged++;
+            solver->setObjCoeff(iColumn, newValue);
           }
-          solver->setObjCoeff(iColumn, newValue);
           offset += costValue * newSolution[iColumn];
         }
         if (numberPasses == 1 && !totalNumberPasses && (model_->specialOptions() & 8388608) != 0) {
@@ -1776,7 +1823,7 @@ int CbcHeuristicFPump::solutionInternal(double &solutionValue,
           << pumpPrint
           << CoinMessageEol;
         CbcEventHandler *eventHandler = model_->getEventHandler();
-        if (eventHandler) {
+        if (eventHandler && eventHandler->wanted(CbcEventHandler::heuristicPass)) {
           typedef struct {
             double newSumInfeas;
             double trueSolutionValue;
@@ -2593,7 +2640,11 @@ int CbcHeuristicFPump::solution(double &objectiveValue, double *newSolution)
       model_ = saveModel;
     }
   }
-  int returnCode = solutionInternal(objectiveValue, newSolution);
+  int returnCode;
+  if (parallelRuns_ > 1 && !sharedObjective_)
+    returnCode = solutionParallel(objectiveValue, newSolution);
+  else
+    returnCode = solutionInternal(objectiveValue, newSolution);
   if (returnCode2 && false) {
     int numberColumns = model_->getNumCols();
     memcpy(newSolution, newSolution2, numberColumns * sizeof(double));
@@ -2602,6 +2653,91 @@ int CbcHeuristicFPump::solution(double &objectiveValue, double *newSolution)
   return returnCode;
 }
 
+#ifdef CBC_THREAD
+// What one of parallel pumps needs
+typedef struct {
+  CbcModel *model;
+  double *solution;
+  double solutionValue;
+  volatile double *bestObjective;
+  int foundSol;
+} CbcPumpRun;
+// What each thread does
+static void *doPumpRun(void *voidInfo)
+{
+  CbcPumpRun *run = reinterpret_cast< CbcPumpRun * >(voidInfo);
+  run->foundSol = run->model->heuristic(0)->solution(run->solutionValue,
+    run->solution);
+  // a double is written in one go - at worst a better value is missed
+  if (run->foundSol > 0 && run->solutionValue < *run->bestObjective)
+    *run->bestObjective = run->solutionValue;
+  return NULL;
+}
+#endif
+// Runs pumps on threads and returns best solution
+int CbcHeuristicFPump::solutionParallel(double &solutionValue,
+  double *betterSolution)
+{
+#ifdef CBC_THREAD
+  CbcThreadPool *pool = model_->threadPool(parallelRuns_);
+  CbcModel *firstModel = pool ? model_->heuristicModel(this) : NULL;
+  if (!firstModel)
+    return solutionInternal(solutionValue, betterSolution);
+  int numberColumns = model_->getNumCols();
+  volatile double bestObjective = solutionValue;
+  CbcPumpRun *runs = new CbcPumpRun[parallelRuns_];
+  for (int i = 0; i < parallelRuns_; i++) {
+    CbcPumpRun &run = runs[i];
+    run.model = i ? model_->heuristicModel(this) : firstModel;
+    run.solution = new double[numberColumns];
+    run.solutionValue = solutionValue;
+    run.bestObjective = &bestObjective;
+    run.foundSol = 0;
+    CbcHeuristicFPump *pump = dynamic_cast< CbcHeuristicFPump * >(run.model->heuristic(0));
+    assert(pump);
+    pump->parallelRuns_ = 0;
+    pump->sharedObjective_ = &bestObjective;
+    if (i) {
+      // perturb seed and rounding threshold
+      pump->setSeed(getSeed() + 1000003 * i);
+      double offset = 0.05 * static_cast< double >(((i + 1) / 2) % 5);
+      if ((i & 1) != 0)
+        offset = -offset;
+      pump->defaultRounding_ = CoinMax(0.3, CoinMin(0.7, defaultRounding_ + offset));
+    }
+  }
+  pool->run(doPumpRun, parallelRuns_, runs, static_cast< int >(sizeof(CbcPumpRun)));
+  int returnCode = 0;
+  int iBest = -1;
+  // lowest numbered best so same whatever timing
+  for (int i = 0; i < parallelRuns_; i++) {
+    CbcPumpRun &run = runs[i];
+    if (run.foundSol > 0 && run.solutionValue < solutionValue) {
+      solutionValue = run.solutionValue;
+      iBest = i;
+    }
+  }
+  if (iBest >= 0) {
+    memcpy(betterSolution, runs[iBest].solution, numberColumns * sizeof(double));
+    returnCode = 1;
+    char line[100];
+    sprintf(line, "Parallel feasibility pump %d of %d found solution of %g",
+      iBest, parallelRuns_, solutionValue);
+    model_->messageHandler()->message(CBC_FPUMP1, model_->messages())
+      << line
+      << CoinMessageEol;
+  }
+  for (int i = 0; i < parallelRuns_; i++) {
+    delete[] runs[i].solution;
+    delete runs[i].model;
+  }
+  delete[] runs;
+  return returnCode;
+#else
+  return solutionInternal(solutionValue, betterSolution);
+#endif
+}
+
 // update model
 void CbcHeuristicFPump::setModel(CbcModel *model)
 {
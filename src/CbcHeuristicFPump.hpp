@@ -67,6 +67,9 @@ public:
     */
   int solutionGeneral(double &objectiveValue, double *newSolution,
     int maxAround = 1, bool fixSatisfied = false);
+  /** Runs parallelRuns_ pumps on threads with different seeds and
+      rounding and returns best solution (as solution) */
+  int solutionParallel(double &objectiveValue, double *newSolution);
   /// Set maximum Time (default off) - also sets starttime to current
   void setMaximumTime(double value);
   /// Get maximum Time (default 0.0 == time limit off)
@@ -231,6 +234,18 @@ public:
   {
     return reducedCostMultiplier_;
   }
+  /** Set number of independent pumps run at same time on threads (each
+      with own seed and rounding threshold) - first to find a solution
+      stops others.  0 or 1 - off */
+  inline void setParallelRuns(int value)
+  {
+    parallelRuns_ = value;
+  }
+  /// Get number of independent pumps run at same time
+  inline int parallelRuns() const
+  {
+    return parallelRuns_;
+  }
 
 protected:
   // Data
@@ -287,6 +302,11 @@ protected:
          2 - fix integers on reduced costs but only on entry
     */
   int fixOnReducedCosts_;
+  /// Number of independent pumps run on threads (see setParallelRuns)
+  int parallelRuns_;
+  /** If one of parallel runs - best objective of all runs so far
+        (written by owner without lock) */
+  const volatile double *sharedObjective_;
   /// If true round to expensive
   bool roundExpensive_;
 
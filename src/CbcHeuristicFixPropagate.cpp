@@ -0,0 +1,264 @@
+// Copyright (C) 2008, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#pragma warning(disable : 4786)
+#endif
+
+#include <cassert>
+#include <cmath>
+#include <cfloat>
+
+#include "OsiSolverInterface.hpp"
+#include "CbcModel.hpp"
+#include "CbcMessage.hpp"
+#include "CbcHeuristicFixPropagate.hpp"
+#include "CbcBoundPropagator.hpp"
+#include "CbcCliqueTable.hpp"
+#include "CbcImplicationGraph.hpp"
+#include "CbcSimpleIntegerDynamicPseudoCost.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinSort.hpp"
+
+// Default Constructor
+CbcHeuristicFixPropagate::CbcHeuristicFixPropagate()
+  : CbcHeuristic()
+  , order_(0)
+  , numberTries_(0)
+{
+  setHeuristicName("FixPropagate");
+}
+
+// Constructor from model
+CbcHeuristicFixPropagate::CbcHeuristicFixPropagate(CbcModel &model)
+  : CbcHeuristic(model)
+  , order_(0)
+  , numberTries_(0)
+{
+  setHeuristicName("FixPropagate");
+}
+
+// Destructor
+CbcHeuristicFixPropagate::~CbcHeuristicFixPropagate()
+{
+}
+
+// Clone
+CbcHeuristic *
+CbcHeuristicFixPropagate::clone() const
+{
+  return new CbcHeuristicFixPropagate(*this);
+}
+
+// Create C++ lines to get to current state
+void CbcHeuristicFixPropagate::generateCpp(FILE *fp)
+{
+  CbcHeuristicFixPropagate other;
+  fprintf(fp, "0#include \"CbcHeuristicFixPropagate.hpp\"\n");
+  fprintf(fp, "3  CbcHeuristicFixPropagate heuristicFixPropagate(*cbcModel);\n");
+  CbcHeuristic::generateCpp(fp, "heuristicFixPropagate");
+  if (order_ != other.order_)
+    fprintf(fp, "3  heuristicFixPropagate.setOrder(%d);\n", order_);
+  else
+    fprintf(fp, "4  heuristicFixPropagate.setOrder(%d);\n", order_);
+  fprintf(fp, "3  cbcModel->addHeuristic(&heuristicFixPropagate);\n");
+}
+
+// Copy constructor
+CbcHeuristicFixPropagate::CbcHeuristicFixPropagate(const CbcHeuristicFixPropagate &rhs)
+  : CbcHeuristic(rhs)
+  , order_(rhs.order_)
+  , numberTries_(rhs.numberTries_)
+{
+}
+
+// Assignment operator
+CbcHeuristicFixPropagate &
+CbcHeuristicFixPropagate::operator=(const CbcHeuristicFixPropagate &rhs)
+{
+  if (this != &rhs) {
+    CbcHeuristic::operator=(rhs);
+    order_ = rhs.order_;
+    numberTries_ = rhs.numberTries_;
+  }
+  return *this;
+}
+
+// Resets stuff if model changes
+void CbcHeuristicFixPropagate::resetModel(CbcModel *)
+{
+}
+
+// Sets value of solution
+// Returns 1 if solution, 0 if not
+int CbcHeuristicFixPropagate::solution(double &solutionValue,
+  double *betterSolution)
+{
+  ++numCouldRun_;
+  // once - or until solution if when_ >= 2
+  if (!when_ || (numberTries_ && (when_ < 2 || model_->bestSolution())))
+    return 0;
+  int numberIntegers = model_->numberIntegers();
+  if (!numberIntegers)
+    return 0;
+  numberTries_++;
+  OsiSolverInterface *solver = model_->solver();
+  int numberColumns = solver->getNumCols();
+  const int *integerVariable = model_->integerVariable();
+  CbcBoundPropagator propagator(solver);
+  if (propagator.propagateAll() < 0)
+    return 0;
+  // cliques fix other side of fixing at one without going through rows
+  CbcCliqueTable *table = model_->cliqueTable();
+  if (table && table->numberColumns() != numberColumns)
+    table = NULL;
+  // implications (with cliques) if any
+  const CbcImplicationGraph *graph = model_->implicationGraph();
+  if (graph && (graph->numberColumns() != numberColumns || !graph->finished()))
+    graph = NULL;
+  // LP may not be finished - if not go on locks
+  const double *solution = solver->isProvenOptimal() ? solver->getColSolution() : NULL;
+  double *sort = new double[numberIntegers];
+  int *which = new int[numberIntegers];
+  int *downLocks = new int[2 * numberColumns];
+  int *upLocks = downLocks + numberColumns;
+  double *pseudoCost = NULL;
+  if (order_ == 1) {
+    int numberObjects = model_->numberObjects();
+    OsiObject **objects = model_->objects();
+    for (int i = 0; i < numberObjects; i++) {
+      CbcSimpleIntegerDynamicPseudoCost *obj = dynamic_cast< CbcSimpleIntegerDynamicPseudoCost * >(objects[i]);
+      if (obj) {
+        if (!pseudoCost) {
+          pseudoCost = new double[numberColumns];
+          CoinZeroN(pseudoCost, numberColumns);
+        }
+        pseudoCost[obj->columnNumber()] = CoinMax(obj->downDynamicPseudoCost(), 1.0e-6)
+          * CoinMax(obj->upDynamicPseudoCost(), 1.0e-6);
+      }
+    }
+  }
+  for (int i = 0; i < numberIntegers; i++) {
+    int iColumn = integerVariable[i];
+    downLocks[iColumn] = propagator.locks(iColumn, 0);
+    upLocks[iColumn] = propagator.locks(iColumn, 1);
+    which[i] = iColumn;
+    if (pseudoCost)
+      sort[i] = -pseudoCost[iColumn];
+    else
+      sort[i] = -(downLocks[iColumn] + upLocks[iColumn]);
+  }
+  CoinSort_2(sort, sort + numberIntegers, which);
+  const double *lower = propagator.lower();
+  const double *upper = propagator.upper();
+  bool feasible = true;
+  int numberBacktracks = 0;
+  for (int i = 0; i < numberIntegers; i++) {
+    int iColumn = which[i];
+    double lo = lower[iColumn];
+    double up = upper[iColumn];
+    if (lo == up)
+      continue;
+    double value;
+    if (solution) {
+      value = floor(solution[iColumn] + 0.5);
+    } else if (lo > -1.0e20 && (downLocks[iColumn] <= upLocks[iColumn] || up >= 1.0e20)) {
+      // fewer rows stop it going down
+      value = lo;
+    } else if (up < 1.0e20) {
+      value = up;
+    } else {
+      value = 0.0;
+    }
+    value = CoinMax(lo, CoinMin(up, value));
+    int mark = propagator.mark();
+    if (propagator.fix(iColumn, value) < 0
+      || (graph && graph->propagate(propagator, mark, table) < 0)
+      || (!graph && table && table->propagate(propagator, mark) < 0)
+      || propagator.propagate() < 0) {
+      propagator.backtrack(mark);
+      numberBacktracks++;
+      // other way
+      double otherValue;
+      if (solution)
+        otherValue = (solution[iColumn] > value) ? value + 1.0 : value - 1.0;
+      else
+        otherValue = (value == lo) ? up : lo;
+      if (otherValue < lo || otherValue > up || fabs(otherValue) >= 1.0e20
+        || propagator.fix(iColumn, otherValue) < 0
+        || (graph && graph->propagate(propagator, mark, table) < 0)
+        || (!graph && table && table->propagate(propagator, mark) < 0)
+        || propagator.propagate() < 0) {
+        feasible = false;
+        break;
+      }
+    }
+  }
+  delete[] sort;
+  delete[] which;
+  delete[] downLocks;
+  delete[] pseudoCost;
+  if (!feasible)
+    return 0;
+  int returnCode = 0;
+  double direction = solver->getObjSense();
+  const double *objective = solver->getObjCoefficients();
+  if (numberIntegers == numberColumns) {
+    // all fixed - just check rows
+    const double *rowLower = solver->getRowLower();
+    const double *rowUpper = solver->getRowUpper();
+    int numberRows = solver->getNumRows();
+    double primalTolerance;
+    solver->getDblParam(OsiPrimalTolerance, primalTolerance);
+    double *rowActivity = new double[numberRows];
+    solver->getMatrixByCol()->times(lower, rowActivity);
+    for (int iRow = 0; iRow < numberRows; iRow++) {
+      if (rowActivity[iRow] > rowUpper[iRow] + primalTolerance || rowActivity[iRow] < rowLower[iRow] - primalTolerance) {
+        feasible = false;
+        break;
+      }
+    }
+    delete[] rowActivity;
+    double newSolutionValue = 0.0;
+    for (int iColumn = 0; iColumn < numberColumns; iColumn++)
+      newSolutionValue += objective[iColumn] * lower[iColumn];
+    newSolutionValue *= direction;
+    if (feasible && newSolutionValue < solutionValue) {
+      memcpy(betterSolution, lower, numberColumns * sizeof(double));
+      solutionValue = newSolutionValue;
+      returnCode = 1;
+    }
+  } else {
+    // LP with propagated bounds
+    OsiSolverInterface *newSolver = solver->clone();
+    for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+      newSolver->setColLower(iColumn, lower[iColumn]);
+      newSolver->setColUpper(iColumn, upper[iColumn]);
+    }
+    newSolver->setHintParam(OsiDoDualInResolve, false, OsiHintTry);
+    newSolver->resolve();
+    if (newSolver->isProvenOptimal()) {
+      double newSolutionValue = newSolver->getObjValue() * direction;
+      if (newSolutionValue < solutionValue) {
+        memcpy(betterSolution, newSolver->getColSolution(), numberColumns * sizeof(double));
+        solutionValue = newSolutionValue;
+        returnCode = 1;
+      }
+    }
+    delete newSolver;
+  }
+  if (returnCode) {
+    char line[100];
+    sprintf(line, "Fix and propagate solution of %g after %d backtracks",
+      solutionValue, numberBacktracks);
+    model_->messageHandler()->message(CBC_FPUMP1, model_->messages())
+      << line
+      << CoinMessageEol;
+  }
+  return returnCode;
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -0,0 +1,78 @@
+// Copyright (C) 2008, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcHeuristicFixPropagate_H
+#define CbcHeuristicFixPropagate_H
+
+#include "CbcHeuristic.hpp"
+
+/** Fix and propagate heuristic class
+
+    Integer variables are fixed one at a time - in order of locks (most
+    locked first) or of pseudocosts - and bounds are propagated with
+    CbcBoundPropagator after each fixing.  Value is rounded current
+    solution if there is one, otherwise the bound with fewer locks.  On
+    conflict the other way is tried.  Only when all integers are fixed is
+    the LP solved (and not even then if all variables are integer).
+ */
+
+class CBCLIB_EXPORT CbcHeuristicFixPropagate : public CbcHeuristic {
+public:
+  // Default Constructor
+  CbcHeuristicFixPropagate();
+
+  // Constructor with model - assumed before cuts
+  CbcHeuristicFixPropagate(CbcModel &model);
+
+  // Copy constructor
+  CbcHeuristicFixPropagate(const CbcHeuristicFixPropagate &);
+
+  // Destructor
+  ~CbcHeuristicFixPropagate();
+
+  /// Clone
+  virtual CbcHeuristic *clone() const;
+
+  /// Assignment operator
+  CbcHeuristicFixPropagate &operator=(const CbcHeuristicFixPropagate &rhs);
+
+  /// Create C++ lines to get to current state
+  virtual void generateCpp(FILE *fp);
+
+  /// Resets stuff if model changes
+  virtual void resetModel(CbcModel *model);
+
+  using CbcHeuristic::solution;
+  /** returns 0 if no solution, 1 if valid solution
+        with better objective value than one passed in
+        Sets solution values if good, sets objective value (only if good)
+    */
+  virtual int solution(double &objectiveValue,
+    double *newSolution);
+  /** Set order - 0 most locked first, 1 largest pseudocost first
+      (locks if no pseudocosts) */
+  inline void setOrder(int value)
+  {
+    order_ = value;
+  }
+  /// Order (see setOrder)
+  inline int order() const
+  {
+    return order_;
+  }
+
+protected:
+  // Data
+
+  // Order
+  int order_;
+
+  // Number of times tried
+  int numberTries_;
+};
+
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
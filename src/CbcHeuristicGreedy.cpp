@@ -16,6 +16,9 @@
 #include "CbcStrategy.hpp"
 #include "CbcHeuristicGreedy.hpp"
 #include "CoinSort.hpp"
+#include <vector>
+#include <algorithm>
+#include <functional>
 #include "CglPreProcess.hpp"
 // Default Constructor
 CbcHeuristicGreedyCover::CbcHeuristicGreedyCover()
@@ -100,6 +103,33 @@ CbcHeuristicGreedyCover::operator=(const CbcHeuristicGreedyCover &rhs)
   }
   return *this;
 }
+/* Ratio of cost to coverage of an integer column for greedy cover
+   (COIN_DBL_MAX if column covers nothing).  As columns are only increased
+   and elements are positive this can only get larger. */
+static double coverRatio(int iColumn, double cost, double perturbation,
+  bool atRoot, bool allOnes, const CoinBigIndex *columnStart,
+  const int *columnLength, const int *row, const double *element,
+  const double *rowLower, const double *rowActivity)
+{
+  double sum = 0.0;
+  for (CoinBigIndex j = columnStart[iColumn];
+       j < columnStart[iColumn] + columnLength[iColumn]; j++) {
+    int iRow = row[j];
+    double gap = rowLower[iRow] - rowActivity[iRow];
+    double elementValue = allOnes ? 1.0 : element[j];
+    if (gap > 1.0e-7)
+      sum += CoinMin(elementValue, gap);
+  }
+  if (sum > 0.0) {
+    // If at root choose first
+    if (atRoot)
+      return iColumn;
+    else
+      return (cost / sum) * perturbation;
+  } else {
+    return COIN_DBL_MAX;
+  }
+}
 // Returns 1 if solution, 0 if not
 int CbcHeuristicGreedyCover::solution(double &solutionValue,
   double *betterSolution)
@@ -228,8 +258,68 @@ int CbcHeuristicGreedyCover::solution(double &solutionValue,
   int numberLook = numberColumns;
   // See if we want to perturb more
   double perturb = ((algorithm_ % 10) == 0) ? 0.1 : 0.25;
+  /* Perturbation is fixed for each column for this run so that ratios
+     of integer columns only ever get worse */
+  double *perturbation = new double[numberColumns];
+  bool allInteger = true;
+  for (iColumn = 0; iColumn < numberColumns; iColumn++) {
+    perturbation[iColumn] = 1.0 + perturb * randomNumberGenerator_.randomDouble();
+    if (!isHeuristicInteger(solver, iColumn))
+      allInteger = false;
+  }
+  if (allInteger) {
+    /* Fast path - keep heap of ratios, which are lower bounds as ratios
+       only increase, and only recompute top.  Same choice as scanning
+       all columns (ties go to first column). */
+    typedef std::pair< double, int > RatioColumn;
+    std::vector< RatioColumn > heap;
+    heap.reserve(numberColumns);
+    for (iColumn = 0; iColumn < numberColumns; iColumn++) {
+      if (newSolution[iColumn] + 0.99 < originalUpper[iColumn]) {
+        double ratio = coverRatio(iColumn, direction * objective[iColumn],
+          perturbation[iColumn], atRoot, allOnes, columnStart, columnLength,
+          row, element, rowLower, rowActivity);
+        if (ratio < COIN_DBL_MAX)
+          heap.push_back(RatioColumn(ratio, iColumn));
+      }
+    }
+    std::greater< RatioColumn > worse;
+    std::make_heap(heap.begin(), heap.end(), worse);
+    while (!heap.empty()) {
+      std::pop_heap(heap.begin(), heap.end(), worse);
+      int iColumn = heap.back().second;
+      double oldRatio = heap.back().first;
+      heap.pop_back();
+      double cost = direction * objective[iColumn];
+      double ratio = coverRatio(iColumn, cost, perturbation[iColumn], atRoot,
+        allOnes, columnStart, columnLength, row, element, rowLower,
+        rowActivity);
+      if (ratio == COIN_DBL_MAX)
+        continue; // can never be chosen
+      if (ratio != oldRatio && !heap.empty() && RatioColumn(ratio, iColumn) > heap.front()) {
+        // no longer best
+        heap.push_back(RatioColumn(ratio, iColumn));
+        std::push_heap(heap.begin(), heap.end(), worse);
+        continue;
+      }
+      // Increase chosen column
+      newSolution[iColumn] += 1.0;
+      newSolutionValue += cost;
+      for (CoinBigIndex j = columnStart[iColumn];
+           j < columnStart[iColumn] + columnLength[iColumn]; j++) {
+        int iRow = row[j];
+        rowActivity[iRow] += element[j];
+      }
+      if (newSolution[iColumn] + 0.99 < originalUpper[iColumn]) {
+        // may be wanted again
+        heap.push_back(RatioColumn(ratio, iColumn));
+        std::push_heap(heap.begin(), heap.end(), worse);
+      }
+    }
+    numberLook = 0;
+  }
   // Keep going round until a solution
-  while (true) {
+  while (numberLook) {
     // Get column with best ratio
     int bestColumn = -1;
     double bestRatio = COIN_DBL_MAX;
@@ -243,27 +333,12 @@ int CbcHeuristicGreedyCover::solution(double &solutionValue,
       if (isHeuristicInteger(solver, iColumn)) {
         // use current upper or original upper
         if (value + 0.99 < originalUpper[iColumn]) {
-          double sum = 0.0;
-          int numberExact = 0;
-          for (j = columnStart[iColumn];
-               j < columnStart[iColumn] + columnLength[iColumn]; j++) {
-            int iRow = row[j];
-            double gap = rowLower[iRow] - rowActivity[iRow];
-            double elementValue = allOnes ? 1.0 : element[j];
-            if (gap > 1.0e-7) {
-              sum += CoinMin(elementValue, gap);
-              if (fabs(elementValue - gap) < 1.0e-7)
-                numberExact++;
-            }
-          }
-          // could bias if exact
-          if (sum > 0.0) {
+          double ratio = coverRatio(iColumn, cost, perturbation[iColumn],
+            atRoot, allOnes, columnStart, columnLength, row, element,
+            rowLower, rowActivity);
+          if (ratio < COIN_DBL_MAX) {
             // add to next time
             which[newNumber++] = iColumn;
-            double ratio = (cost / sum) * (1.0 + perturb * randomNumberGenerator_.randomDouble());
-            // If at root choose first
-            if (atRoot)
-              ratio = iColumn;
             if (ratio < bestRatio) {
               bestRatio = ratio;
               bestColumn = iColumn;
@@ -299,7 +374,7 @@ int CbcHeuristicGreedyCover::solution(double &solutionValue,
               }
             }
             assert(sum > 0.0);
-            double ratio = (cost / sum) * (1.0 + perturb * randomNumberGenerator_.randomDouble());
+            double ratio = (cost / sum) * perturbation[iColumn];
             if (ratio < bestRatio) {
               bestRatio = ratio;
               bestColumn = iColumn;
@@ -309,6 +384,7 @@ int CbcHeuristicGreedyCover::solution(double &solutionValue,
         }
       }
     }
+    numberLook = newNumber;
     if (bestColumn < 0)
       break; // we have finished
     // Increase chosen column
@@ -322,6 +398,7 @@ int CbcHeuristicGreedyCover::solution(double &solutionValue,
     }
   }
   delete[] which;
+  delete[] perturbation;
   if (newSolutionValue < solutionValue) {
     // check feasible
     memset(rowActivity, 0, numberRows * sizeof(double));
@@ -635,102 +712,91 @@ int CbcHeuristicGreedyEquality::solution(double &solutionValue,
       }
     }
   }
-  // Get initial list
-  int *which = new int[numberColumns];
-  for (iColumn = 0; iColumn < numberColumns; iColumn++)
-    which[iColumn] = iColumn;
-  int numberLook = numberColumns;
+  /* Ratios do not change as columns are increased (only whether column
+     can still be increased) so sort once and go through in order.
+     Same choice as scanning all columns (ties go to first column). */
+  typedef std::pair< double, int > RatioColumn;
+  std::vector< RatioColumn > order;
+  order.reserve(numberColumns);
   // See if we want to perturb more
   double perturb = ((algorithm_ % 10) == 0) ? 0.1 : 0.25;
+  for (iColumn = 0; iColumn < numberColumns; iColumn++) {
+    double cost = direction * objective[iColumn];
+    double sum = 0.0;
+    for (CoinBigIndex j = columnStart[iColumn];
+         j < columnStart[iColumn] + columnLength[iColumn]; j++)
+      sum += (allOnes && isHeuristicInteger(solver, iColumn)) ? 1.0 : element[j];
+    double ratio = (cost / sum) * (1.0 + perturb * randomNumberGenerator_.randomDouble());
+    // If at root
+    if (atRoot && isHeuristicInteger(solver, iColumn)) {
+      if (fraction_ == 1.0)
+        ratio = iColumn; // choose first
+      else
+        ratio = -solution[iColumn]; // choose largest
+    }
+    // empty columns can never be best
+    if (ratio < COIN_DBL_MAX)
+      order.push_back(RatioColumn(ratio, iColumn));
+  }
+  std::sort(order.begin(), order.end());
+  int numberOrder = static_cast< int >(order.size());
+  int iOrder = 0;
   // Keep going round until a solution
-  while (true) {
-    // Get column with best ratio
-    int bestColumn = -1;
-    double bestRatio = COIN_DBL_MAX;
-    double bestStepSize = 0.0;
-    int newNumber = 0;
-    for (int jColumn = 0; jColumn < numberLook; jColumn++) {
-      int iColumn = which[jColumn];
-      CoinBigIndex j;
-      double value = newSolution[iColumn];
-      double cost = direction * objective[iColumn];
-      if (isHeuristicInteger(solver, iColumn)) {
-        // use current upper or original upper
-        if (value + 0.9999 < originalUpper[iColumn]) {
-          double movement = 1.0;
-          double sum = 0.0;
-          for (j = columnStart[iColumn];
-               j < columnStart[iColumn] + columnLength[iColumn]; j++) {
-            int iRow = row[j];
-            double gap = rowUpper[iRow] - rowActivity[iRow];
-            double elementValue = allOnes ? 1.0 : element[j];
-            sum += elementValue;
-            if (movement * elementValue > gap) {
-              movement = gap / elementValue;
-            }
-          }
-          if (movement > 0.999999) {
-            // add to next time
-            which[newNumber++] = iColumn;
-            double ratio = (cost / sum) * (1.0 + perturb * randomNumberGenerator_.randomDouble());
-            // If at root
-            if (atRoot) {
-              if (fraction_ == 1.0)
-                ratio = iColumn; // choose first
-              else
-                ratio = -solution[iColumn]; // choose largest
-            }
-            if (ratio < bestRatio) {
-              bestRatio = ratio;
-              bestColumn = iColumn;
-              bestStepSize = 1.0;
-            }
+  while (iOrder < numberOrder) {
+    int iColumn = order[iOrder].second;
+    CoinBigIndex j;
+    double value = newSolution[iColumn];
+    double stepSize = 0.0;
+    if (isHeuristicInteger(solver, iColumn)) {
+      // use current upper or original upper
+      if (value + 0.9999 < originalUpper[iColumn]) {
+        double movement = 1.0;
+        for (j = columnStart[iColumn];
+             j < columnStart[iColumn] + columnLength[iColumn]; j++) {
+          int iRow = row[j];
+          double gap = rowUpper[iRow] - rowActivity[iRow];
+          double elementValue = allOnes ? 1.0 : element[j];
+          if (movement * elementValue > gap) {
+            movement = gap / elementValue;
           }
         }
-      } else {
-        // continuous
-        if (value < columnUpper[iColumn]) {
-          double movement = 1.0e50;
-          double sum = 0.0;
-          for (j = columnStart[iColumn];
-               j < columnStart[iColumn] + columnLength[iColumn]; j++) {
-            int iRow = row[j];
-            if (element[j] * movement + rowActivity[iRow] > rowUpper[iRow]) {
-              movement = (rowUpper[iRow] - rowActivity[iRow]) / element[j];
-              ;
-            }
-            sum += element[j];
-          }
-          // now ratio
-          if (movement > 1.0e-7) {
-            // add to next time
-            which[newNumber++] = iColumn;
-            double ratio = (cost / sum) * (1.0 + perturb * randomNumberGenerator_.randomDouble());
-            if (ratio < bestRatio) {
-              bestRatio = ratio;
-              bestColumn = iColumn;
-              bestStepSize = movement;
-            }
+        if (movement > 0.999999)
+          stepSize = 1.0;
+      }
+    } else {
+      // continuous
+      if (value < columnUpper[iColumn]) {
+        double movement = 1.0e50;
+        for (j = columnStart[iColumn];
+             j < columnStart[iColumn] + columnLength[iColumn]; j++) {
+          int iRow = row[j];
+          if (element[j] * movement + rowActivity[iRow] > rowUpper[iRow]) {
+            movement = (rowUpper[iRow] - rowActivity[iRow]) / element[j];
+            ;
           }
         }
+        if (movement > 1.0e-7)
+          stepSize = movement;
       }
     }
-    if (bestColumn < 0)
-      break; // we have finished
+    if (!stepSize) {
+      // rows only get fuller so can never be increased again
+      iOrder++;
+      continue;
+    }
     // Increase chosen column
-    newSolution[bestColumn] += bestStepSize;
-    double cost = direction * objective[bestColumn];
-    newSolutionValue += bestStepSize * cost;
-    for (CoinBigIndex j = columnStart[bestColumn];
-         j < columnStart[bestColumn] + columnLength[bestColumn]; j++) {
+    newSolution[iColumn] += stepSize;
+    double cost = direction * objective[iColumn];
+    newSolutionValue += stepSize * cost;
+    for (CoinBigIndex j = columnStart[iColumn];
+         j < columnStart[iColumn] + columnLength[iColumn]; j++) {
       int iRow = row[j];
-      rowActivity[iRow] += bestStepSize * element[j];
-      rhsNeeded -= bestStepSize * element[j];
+      rowActivity[iRow] += stepSize * element[j];
+      rhsNeeded -= stepSize * element[j];
     }
     if (rhsNeeded < 1.0e-8)
       break;
   }
-  delete[] which;
   if (fraction_ < 1.0 && rhsNeeded < 1.0e-8 && newSolutionValue < solutionValue) {
     // do branch and cut
     // fix all nonzero
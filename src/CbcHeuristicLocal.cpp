@@ -1524,8 +1524,11 @@ CbcHeuristicCrossover::CbcHeuristicCrossover()
   : CbcHeuristic()
   , numberSolutions_(0)
   , useNumber_(3)
+  , minimumChange_(1)
 {
   setWhen(1);
+  for (int i = 0; i < 10; i++)
+    random_[i] = 0.0;
 }
 
 // Constructor with model - assumed before cuts
@@ -1534,6 +1537,7 @@ CbcHeuristicCrossover::CbcHeuristicCrossover(CbcModel &model)
   : CbcHeuristic(model)
   , numberSolutions_(0)
   , useNumber_(3)
+  , minimumChange_(1)
 {
   setWhen(1);
   for (int i = 0; i < 10; i++)
@@ -1555,13 +1559,17 @@ CbcHeuristicCrossover::clone() const
 void CbcHeuristicCrossover::generateCpp(FILE *fp)
 {
   CbcHeuristicCrossover other;
-  fprintf(fp, "0#include \"CbcHeuristicProximity.hpp\"\n");
+  fprintf(fp, "0#include \"CbcHeuristicLocal.hpp\"\n");
   fprintf(fp, "3  CbcHeuristicCrossover crossover(*cbcModel);\n");
   CbcHeuristic::generateCpp(fp, "crossover");
   if (useNumber_ != other.useNumber_)
     fprintf(fp, "3  crossover.setNumberSolutions(%d);\n", useNumber_);
   else
     fprintf(fp, "4  crossover.setNumberSolutions(%d);\n", useNumber_);
+  if (minimumChange_ != other.minimumChange_)
+    fprintf(fp, "3  crossover.setMinimumChange(%d);\n", minimumChange_);
+  else
+    fprintf(fp, "4  crossover.setMinimumChange(%d);\n", minimumChange_);
   fprintf(fp, "3  cbcModel->addHeuristic(&crossover);\n");
 }
 
@@ -1569,8 +1577,10 @@ void CbcHeuristicCrossover::generateCpp(FILE *fp)
 CbcHeuristicCrossover::CbcHeuristicCrossover(const CbcHeuristicCrossover &rhs)
   : CbcHeuristic(rhs)
   , attempts_(rhs.attempts_)
+  , poolHash_(rhs.poolHash_)
   , numberSolutions_(rhs.numberSolutions_)
   , useNumber_(rhs.useNumber_)
+  , minimumChange_(rhs.minimumChange_)
 {
   memcpy(random_, rhs.random_, 10 * sizeof(double));
 }
@@ -1583,7 +1593,9 @@ CbcHeuristicCrossover::operator=(const CbcHeuristicCrossover &rhs)
     CbcHeuristic::operator=(rhs);
     useNumber_ = rhs.useNumber_;
     attempts_ = rhs.attempts_;
+    poolHash_ = rhs.poolHash_;
     numberSolutions_ = rhs.numberSolutions_;
+    minimumChange_ = rhs.minimumChange_;
     memcpy(random_, rhs.random_, 10 * sizeof(double));
   }
   return *this;
@@ -1594,24 +1606,80 @@ void CbcHeuristicCrossover::resetModel(CbcModel *model)
 {
   CbcHeuristic::resetModel(model);
 }
+// Hash of integer values of a solution (so same solution is recognised)
+static unsigned int hashSolution(const OsiSolverInterface *solver,
+  const double *solution, int numberColumns)
+{
+  unsigned int hash = 2166136261u;
+  for (int i = 0; i < numberColumns; i++) {
+    if (solver->isInteger(i)) {
+      int value = static_cast< int >(floor(solution[i] + 0.5));
+      hash = (hash ^ static_cast< unsigned int >(value + i)) * 16777619u;
+    }
+  }
+  return hash;
+}
 int CbcHeuristicCrossover::solution(double &solutionValue,
   double *betterSolution)
 {
   if (when_ == 0)
     return 0;
   numCouldRun_++;
-  bool useBest = (numberSolutions_ != model_->getSolutionCount());
-  if (!useBest && (when_ % 10) == 1)
-    return 0;
-  numberSolutions_ = model_->getSolutionCount();
   OsiSolverInterface *continuousSolver = model_->continuousSolver();
-  int useNumber = CoinMin(model_->numberSavedSolutions(), useNumber_);
+  int numberSaved = model_->numberSavedSolutions();
+  int useNumber = CoinMin(numberSaved, useNumber_);
   if (useNumber < 2 || !continuousSolver)
     return 0;
-  // Fix later
-  if (!useBest)
-    abort();
-  numRuns_++;
+  int numberColumns = model_->solver()->getNumCols();
+  // See how many pool solutions are new since last run
+  std::vector< unsigned int > hash(numberSaved);
+  int numberChanged = 0;
+  for (int i = 0; i < numberSaved; i++) {
+    hash[i] = hashSolution(continuousSolver, model_->savedSolution(i),
+      numberColumns);
+    size_t j;
+    for (j = 0; j < poolHash_.size(); j++) {
+      if (hash[i] == poolHash_[j])
+        break;
+    }
+    if (j == poolHash_.size())
+      numberChanged++;
+  }
+  bool useBest = (numberChanged >= CoinMin(minimumChange_, numberSaved));
+  if (!useBest && (when_ % 10) == 1)
+    return 0;
+  int whichSolution[10];
+  if (useBest) {
+    // best ones
+    for (int i = 0; i < useNumber; i++)
+      whichSolution[i] = i;
+    poolHash_ = hash;
+  } else {
+    // best and random others
+    whichSolution[0] = 0;
+    int nChosen = 1;
+    while (nChosen < useNumber) {
+      int k = 1 + static_cast< int >(randomNumberGenerator_.randomDouble() * (numberSaved - 1));
+      k = CoinMin(k, numberSaved - 1);
+      int j;
+      for (j = 0; j < nChosen; j++) {
+        if (whichSolution[j] == k)
+          break;
+      }
+      if (j == nChosen)
+        whichSolution[nChosen++] = k;
+    }
+  }
+  // Do not do same combination twice
+  double key = 0.0;
+  for (int i = 0; i < useNumber; i++)
+    key += hash[whichSolution[i]] * random_[i % 10] + hash[whichSolution[i]];
+  for (size_t i = 0; i < attempts_.size(); i++) {
+    if (attempts_[i] == key)
+      return 0;
+  }
+  attempts_.push_back(key);
+  numberSolutions_ = model_->getSolutionCount();
   double cutoff;
   model_->solver()->getDblParam(OsiDualObjectiveLimit, cutoff);
   double direction = model_->solver()->getObjSense();
@@ -1621,14 +1689,10 @@ int CbcHeuristicCrossover::solution(double &solutionValue,
   // But reset bounds
   solver->setColLower(continuousSolver->getColLower());
   solver->setColUpper(continuousSolver->getColUpper());
-  int numberColumns = solver->getNumCols();
   // Fixed
   double *fixed = new double[numberColumns];
   for (int i = 0; i < numberColumns; i++)
     fixed[i] = -COIN_DBL_MAX;
-  int whichSolution[10];
-  for (int i = 0; i < useNumber; i++)
-    whichSolution[i] = i;
   for (int i = 0; i < useNumber; i++) {
     int k = whichSolution[i];
     const double *solution = model_->savedSolution(k);
@@ -1642,6 +1706,7 @@ int CbcHeuristicCrossover::solution(double &solutionValue,
     }
   }
   const double *colLower = solver->getColLower();
+  int numberFree = 0;
   for (int i = 0; i < numberColumns; i++) {
     if (isHeuristicInteger(solver, i)) {
       double value = fixed[i];
@@ -1652,17 +1717,24 @@ int CbcHeuristicCrossover::solution(double &solutionValue,
         } else if (value == colLower[i]) {
           solver->setColUpper(i, value);
         }
+      } else {
+        numberFree++;
       }
     }
   }
-  int returnCode = smallBranchAndBound(solver, numberNodes_, betterSolution,
-    solutionValue,
-    solutionValue, "CbcHeuristicCrossover");
-  if (returnCode < 0)
-    returnCode = 0; // returned on size
-  if ((returnCode & 2) != 0) {
-    // could add cut
-    returnCode &= ~2;
+  int returnCode = 0;
+  // if all agree then nothing new to find
+  if (numberFree) {
+    numRuns_++;
+    returnCode = smallBranchAndBound(solver, numberNodes_, betterSolution,
+      solutionValue,
+      solutionValue, "CbcHeuristicCrossover");
+    if (returnCode < 0)
+      returnCode = 0; // returned on size
+    if ((returnCode & 2) != 0) {
+      // could add cut
+      returnCode &= ~2;
+    }
   }
 
   delete[] fixed;
@@ -1679,5 +1751,175 @@ void CbcHeuristicCrossover::setModel(CbcModel *model)
   }
 }
 
+// Default Constructor
+CbcHeuristicPolish::CbcHeuristicPolish()
+  : CbcHeuristic()
+  , timeBudget_(30.0)
+  , timeUsed_(0.0)
+  , lastObjective_(COIN_DBL_MAX)
+  , radius_(10)
+  , stop_(false)
+{
+  setHeuristicName("Polish");
+}
+
+// Constructor with model - assumed before cuts
+
+CbcHeuristicPolish::CbcHeuristicPolish(CbcModel &model)
+  : CbcHeuristic(model)
+  , timeBudget_(30.0)
+  , timeUsed_(0.0)
+  , lastObjective_(COIN_DBL_MAX)
+  , radius_(10)
+  , stop_(false)
+{
+  setHeuristicName("Polish");
+}
+
+// Destructor
+CbcHeuristicPolish::~CbcHeuristicPolish()
+{
+}
+
+// Clone
+CbcHeuristic *
+CbcHeuristicPolish::clone() const
+{
+  return new CbcHeuristicPolish(*this);
+}
+// Create C++ lines to get to current state
+void CbcHeuristicPolish::generateCpp(FILE *fp)
+{
+  CbcHeuristicPolish other;
+  fprintf(fp, "0#include \"CbcHeuristicLocal.hpp\"\n");
+  fprintf(fp, "3  CbcHeuristicPolish heuristicPolish(*cbcModel);\n");
+  CbcHeuristic::generateCpp(fp, "heuristicPolish");
+  if (radius_ != other.radius_)
+    fprintf(fp, "3  heuristicPolish.setRadius(%d);\n", radius_);
+  else
+    fprintf(fp, "4  heuristicPolish.setRadius(%d);\n", radius_);
+  if (timeBudget_ != other.timeBudget_)
+    fprintf(fp, "3  heuristicPolish.setTimeBudget(%g);\n", timeBudget_);
+  else
+    fprintf(fp, "4  heuristicPolish.setTimeBudget(%g);\n", timeBudget_);
+  fprintf(fp, "3  cbcModel->addHeuristic(&heuristicPolish);\n");
+}
+
+// Copy constructor
+CbcHeuristicPolish::CbcHeuristicPolish(const CbcHeuristicPolish &rhs)
+  : CbcHeuristic(rhs)
+  , timeBudget_(rhs.timeBudget_)
+  , timeUsed_(rhs.timeUsed_)
+  , lastObjective_(rhs.lastObjective_)
+  , radius_(rhs.radius_)
+  , stop_(rhs.stop_)
+{
+}
+
+// Assignment operator
+CbcHeuristicPolish &
+CbcHeuristicPolish::operator=(const CbcHeuristicPolish &rhs)
+{
+  if (this != &rhs) {
+    CbcHeuristic::operator=(rhs);
+    timeBudget_ = rhs.timeBudget_;
+    timeUsed_ = rhs.timeUsed_;
+    lastObjective_ = rhs.lastObjective_;
+    radius_ = rhs.radius_;
+    stop_ = rhs.stop_;
+  }
+  return *this;
+}
+// Resets stuff if model changes
+void CbcHeuristicPolish::resetModel(CbcModel *)
+{
+  lastObjective_ = COIN_DBL_MAX;
+}
+/*
+  Local branching sub-MIPs around incumbent - chained on each
+  improvement while time budget lasts.
+  Returns 1 if solution, 0 if not
+*/
+int CbcHeuristicPolish::solution(double &solutionValue,
+  double *betterSolution)
+{
+  numCouldRun_++;
+  if (!when() || (when() == 1 && model_->phase() != 1))
+    return 0; // switched off
+  const double *bestSolution = model_->bestSolution();
+  if (!bestSolution || stop_ || timeUsed_ >= timeBudget_)
+    return 0;
+  double incumbentValue = model_->getMinimizationObjValue();
+  // only for new incumbent
+  if (incumbentValue >= lastObjective_ - 1.0e-7)
+    return 0;
+  OsiSolverInterface *continuousSolver = model_->continuousSolver();
+  int numberColumns = continuousSolver->getNumCols();
+  int numberIntegers = model_->numberIntegers();
+  const int *integerVariable = model_->integerVariable();
+  const double *colLower = continuousSolver->getColLower();
+  const double *colUpper = continuousSolver->getColUpper();
+  double *incumbent = CoinCopyOfArray(bestSolution, numberColumns);
+  int *index = new int[numberIntegers];
+  double *element = new double[numberIntegers];
+  int returnCode = 0;
+  double startTime = model_->getCurrentSeconds();
+  while (!stop_ && timeUsed_ < timeBudget_ && !model_->maximumSecondsReached()) {
+    lastObjective_ = incumbentValue;
+    /*
+      sum of binaries at zero plus (one - binary) for those at one is at
+      most radius
+    */
+    int numberBinary = 0;
+    double rhs = radius_;
+    for (int i = 0; i < numberIntegers; i++) {
+      int iColumn = integerVariable[i];
+      if (!isHeuristicInteger(continuousSolver, iColumn))
+        continue;
+      if (colLower[iColumn] != 0.0 || colUpper[iColumn] != 1.0)
+        continue;
+      index[numberBinary] = iColumn;
+      if (incumbent[iColumn] > 0.5) {
+        element[numberBinary++] = -1.0;
+        rhs -= 1.0;
+      } else {
+        element[numberBinary++] = 1.0;
+      }
+    }
+    // neighbourhood would be whole problem
+    if (numberBinary <= 2 * radius_)
+      break;
+    numRuns_++;
+    OsiSolverInterface *newSolver = continuousSolver->clone();
+    newSolver->addRow(numberBinary, index, element, -COIN_DBL_MAX, rhs);
+    double newSolutionValue = solutionValue;
+    int returnCode2 = smallBranchAndBound(newSolver, numberNodes_, betterSolution,
+      newSolutionValue, solutionValue, "CbcHeuristicPolish");
+    delete newSolver;
+    double endTime = model_->getCurrentSeconds();
+    timeUsed_ += endTime - startTime;
+    startTime = endTime;
+    if (returnCode2 < 0)
+      returnCode2 = 0; // returned on size
+    if ((returnCode2 & 1) != 0 && newSolutionValue < solutionValue) {
+      // chain on own solution
+      solutionValue = newSolutionValue;
+      incumbentValue = newSolutionValue;
+      memcpy(incumbent, betterSolution, numberColumns * sizeof(double));
+      returnCode = 1;
+    } else {
+      break;
+    }
+  }
+  if (returnCode) {
+    // make sure betterSolution is last improved one
+    memcpy(betterSolution, incumbent, numberColumns * sizeof(double));
+  }
+  delete[] incumbent;
+  delete[] index;
+  delete[] element;
+  return returnCode;
+}
+
 /* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
 */
@@ -244,7 +244,8 @@ public:
   using CbcHeuristic::solution;
   /** returns 0 if no solution, 1 if valid solution.
         Fix variables if agree in useNumber_ solutions
-        when_ 0 off, 1 only at new solutions, 2 also every now and then
+        when_ 0 off, 1 only when pool has changed enough (best solutions),
+        2 also every now and then (best and random others from pool)
         add 10 to make only if agree at lower bound
     */
   virtual int solution(double &objectiveValue,
@@ -256,17 +257,120 @@ public:
     if (value > 0 && value <= 10)
       useNumber_ = value;
   }
+  /// Sets number of new pool solutions needed before best ones used again
+  inline void setMinimumChange(int value)
+  {
+    minimumChange_ = (value > 0) ? value : 1;
+  }
+  /// Number of new pool solutions needed before best ones used again
+  inline int minimumChange() const
+  {
+    return minimumChange_;
+  }
 
 protected:
   // Data
-  /// Attempts
+  /// Attempts (keys of combinations of solutions tried)
   std::vector< double > attempts_;
+  /// Hashes of pool solutions when best ones last used
+  std::vector< unsigned int > poolHash_;
   /// Random numbers to stop same search happening
   double random_[10];
   /// Number of solutions so we only do after new solution
   int numberSolutions_;
   /// Number of solutions to use
   int useNumber_;
+  /// Number of new pool solutions needed before best ones used again
+  int minimumChange_;
+};
+
+/** Polish class
+
+    Local branching around each new incumbent - a sub-MIP with extra row
+    saying at most radius() binaries may change is solved by small branch
+    and bound.  If it improves, it goes on around its own solution until
+    no improvement or timeBudget() seconds have been used in all.  Can run
+    on background thread in tree (CbcAsyncHeuristics) and stop() makes it
+    give up before next sub-MIP.
+ */
+
+class CBCLIB_EXPORT CbcHeuristicPolish : public CbcHeuristic {
+public:
+  // Default Constructor
+  CbcHeuristicPolish();
+
+  /* Constructor with model - assumed before cuts
+    */
+  CbcHeuristicPolish(CbcModel &model);
+
+  // Copy constructor
+  CbcHeuristicPolish(const CbcHeuristicPolish &);
+
+  // Destructor
+  ~CbcHeuristicPolish();
+
+  /// Clone
+  virtual CbcHeuristic *clone() const;
+
+  /// Assignment operator
+  CbcHeuristicPolish &operator=(const CbcHeuristicPolish &rhs);
+
+  /// Create C++ lines to get to current state
+  virtual void generateCpp(FILE *fp);
+
+  /// Resets stuff if model changes
+  virtual void resetModel(CbcModel *model);
+
+  using CbcHeuristic::solution;
+  /** returns 0 if no solution, 1 if valid solution.
+        Only does something if incumbent is new since last time
+    */
+  virtual int solution(double &objectiveValue,
+    double *newSolution);
+
+  /// Set number of binaries which may change
+  inline void setRadius(int value)
+  {
+    radius_ = value;
+  }
+  /// Number of binaries which may change
+  inline int radius() const
+  {
+    return radius_;
+  }
+  /// Set seconds which may be used in all
+  inline void setTimeBudget(double value)
+  {
+    timeBudget_ = value;
+  }
+  /// Seconds which may be used in all
+  inline double timeBudget() const
+  {
+    return timeBudget_;
+  }
+  /// Seconds used so far
+  inline double timeUsed() const
+  {
+    return timeUsed_;
+  }
+  /// Give up before next sub-MIP (may be called from another thread)
+  inline void stop()
+  {
+    stop_ = true;
+  }
+
+protected:
+  // Data
+  /// Seconds which may be used in all
+  double timeBudget_;
+  /// Seconds used so far
+  double timeUsed_;
+  /// Objective of last incumbent polished
+  double lastObjective_;
+  /// Number of binaries which may change
+  int radius_;
+  /// Set to give up
+  volatile bool stop_;
 };
 
 #endif
@@ -109,6 +109,8 @@ int CbcHeuristicRENS::solution(double &solutionValue,
   const int *integerVariable = model_->integerVariable();
 
   OsiSolverInterface *newSolver = cloneBut(3); // was model_->continuousSolver()->clone();
+  // warm start from this node (basis and tight cuts)
+  addParentCutsAndBasis(newSolver);
   const double *currentSolution = newSolver->getColSolution();
   int type = rensType_ & 15;
   if (type < 12)
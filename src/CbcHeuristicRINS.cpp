@@ -209,6 +209,8 @@ int CbcHeuristicRINS::solution(double &solutionValue,
     const double *currentSolution = solver->getColSolution();
     const int *used = model_->usedInSolution();
     OsiSolverInterface *newSolver = cloneBut(3); // was model_->continuousSolver()->clone();
+    // warm start from this node (basis and tight cuts)
+    addParentCutsAndBasis(newSolver);
     int numberColumns = newSolver->getNumCols();
     int numberContinuous = numberColumns - numberIntegers;
 
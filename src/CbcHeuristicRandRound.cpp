@@ -17,6 +17,7 @@
 #include "CbcModel.hpp"
 #include "CbcMessage.hpp"
 #include "CbcHeuristicRandRound.hpp"
+#include "CbcBatchEvaluator.hpp"
 #include "OsiClpSolverInterface.hpp"
 #include "CoinTime.hpp"
 
@@ -201,6 +202,10 @@ int CbcHeuristicRandRound::solution(double &solutionValue,
 
   // -Get the objective coefficients
   double *originalObjCoeff = CoinCopyOfArray(clpSolver->getObjCoefficients(), numCols);
+  // for checking rounded points in blocks (before objective is changed)
+  CbcBatchEvaluator evaluator(clpSolver);
+  evaluator.setObjective(originalObjCoeff);
+  evaluator.setTolerance(primalTolerance);
 
   // -Get the matrix of the problem
   // rlh: look at using sparse representation
@@ -391,84 +396,64 @@ int CbcHeuristicRandRound::solution(double &solutionValue,
 
   srand(static_cast< unsigned int >(time(NULL) + 1));
   int numRandomPoints = 0;
+  // rounded points are checked a block at a time
+  double *roundRp = new double[CBC_BATCH_BLOCK * numCols];
+  char feasibleRp[CBC_BATCH_BLOCK];
+  double objValueRp[CBC_BATCH_BLOCK];
   while (numRandomPoints < 50000) {
-    numRandomPoints++;
-    //generate the next random point
-    int randomIndex = intRand(numCornerPoints);
-    double random = CoinDrand48();
-    for (int i = 0; i < numCols; i++) {
-      rp[i] = (random * (cornerPoints[randomIndex][i] - rp[i])) + rp[i];
-    }
+    int numberInBlock = CoinMin(CBC_BATCH_BLOCK, 50000 - numRandomPoints);
+    for (int k = 0; k < numberInBlock; k++) {
+      numRandomPoints++;
+      //generate the next random point
+      int randomIndex = intRand(numCornerPoints);
+      double random = CoinDrand48();
+      for (int i = 0; i < numCols; i++) {
+        rp[i] = (random * (cornerPoints[randomIndex][i] - rp[i])) + rp[i];
+      }
 
-    //CRISP ROUNDING
-    //round the random point just generated
-    double *roundRp = new double[numCols];
-    for (int i = 0; i < numCols; i++) {
-      roundRp[i] = rp[i];
-      if (varClassInt[i]) {
-        if (rp[i] >= 0) {
-          if (fmod(rp[i], 1) > 0.5)
-            roundRp[i] = floor(rp[i]) + 1;
-          else
-            roundRp[i] = floor(rp[i]);
-        } else {
-          if (fabs(fmod(rp[i], 1)) > 0.5)
-            roundRp[i] = floor(rp[i]);
-          else
-            roundRp[i] = floor(rp[i]) + 1;
+      //CRISP ROUNDING
+      //round the random point just generated
+      double *thisRp = roundRp + k * numCols;
+      for (int i = 0; i < numCols; i++) {
+        thisRp[i] = rp[i];
+        if (varClassInt[i]) {
+          if (rp[i] >= 0) {
+            if (fmod(rp[i], 1) > 0.5)
+              thisRp[i] = floor(rp[i]) + 1;
+            else
+              thisRp[i] = floor(rp[i]);
+          } else {
+            if (fabs(fmod(rp[i], 1)) > 0.5)
+              thisRp[i] = floor(rp[i]);
+            else
+              thisRp[i] = floor(rp[i]) + 1;
+          }
         }
       }
-    }
-
-    //SOFT ROUNDING
-    // Look at original files for the "how to" on soft rounding;
-    // Soft rounding omitted here.
 
-    //Check the feasibility of the rounded random point
-    // -Check the feasibility
-    // -Get the rows sense
-    rowSense = clpSolver->getRowSense();
-    rhs = clpSolver->getRightHandSide();
-
-    //get the objective value for this feasible point
-    double objValue = 0;
-    for (int i = 0; i < numCols; i++)
-      objValue += roundRp[i] * originalObjCoeff[i];
+      //SOFT ROUNDING
+      // Look at original files for the "how to" on soft rounding;
+      // Soft rounding omitted here.
+    }
 
-    if (objValue < bestObj) {
-      feasibility = 1;
-      for (int i = 0; i < numRows; i++) {
-        double lhs = 0;
-        for (int j = 0; j < numCols; j++) {
-          lhs += matrix[i][j] * roundRp[j];
-        }
-        if (rowSense[i] == 'L' && lhs > rhs[i] + primalTolerance) {
-          feasibility = 0;
-          break;
-        }
-        if (rowSense[i] == 'G' && lhs < rhs[i] - primalTolerance) {
-          feasibility = 0;
-          break;
-        }
-        if (rowSense[i] == 'E' && (lhs - rhs[i] > primalTolerance || lhs - rhs[i] < -primalTolerance)) {
-          feasibility = 0;
-          break;
-        }
-      }
-      if (feasibility) {
+    //Check the feasibility and get the objective value of the block
+    evaluator.evaluate(numberInBlock, roundRp, feasibleRp, objValueRp);
+    for (int k = 0; k < numberInBlock; k++) {
+      double objValue = objValueRp[k];
+      if (objValue < bestObj && feasibleRp[k]) {
+        const double *thisRp = roundRp + k * numCols;
         printf("Feasible Found.\n");
         printf("%.2f\n", CoinCpuTime() - start);
         numFeasibles++;
         feasibles.push_back(std::vector< double >(numCols));
         for (int i = 0; i < numCols; i++)
-          feasibles[numFeasibles - 1][i] = roundRp[i];
+          feasibles[numFeasibles - 1][i] = thisRp[i];
         printf("obj: %f\n", objValue);
-        if (objValue < bestObj)
-          bestObj = objValue;
+        bestObj = objValue;
       }
     }
-    delete[] roundRp;
   }
+  delete[] roundRp;
   printf("Number of Feasible Corners: %d\n", numFeasibleCorners);
   printf("Number of Feasibles Found: %d\n", numFeasibles);
   if (numFeasibles > 0)
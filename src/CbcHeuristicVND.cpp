@@ -37,6 +37,8 @@ CbcHeuristicVND::CbcHeuristicVND()
   k_ = 0;
   kmax_ = 0;
   nDifferent_ = 0;
+  neighbourhood_ = NULL;
+  numberSame_ = -1;
 }
 
 // Constructor with model - assumed before cuts
@@ -59,12 +61,15 @@ CbcHeuristicVND::CbcHeuristicVND(CbcModel &model)
   k_ = 0;
   kmax_ = 0;
   nDifferent_ = 0;
+  neighbourhood_ = NULL;
+  numberSame_ = -1;
 }
 
 // Destructor
 CbcHeuristicVND::~CbcHeuristicVND()
 {
   delete[] baseSolution_;
+  delete[] neighbourhood_;
 }
 
 // Clone
@@ -97,6 +102,10 @@ CbcHeuristicVND::operator=(const CbcHeuristicVND &rhs)
     k_ = rhs.k_;
     kmax_ = rhs.kmax_;
     nDifferent_ = rhs.nDifferent_;
+    // neighbourhood is made again
+    delete[] neighbourhood_;
+    neighbourhood_ = NULL;
+    numberSame_ = -1;
   }
   return *this;
 }
@@ -135,6 +144,9 @@ CbcHeuristicVND::CbcHeuristicVND(const CbcHeuristicVND &rhs)
   k_ = rhs.k_;
   kmax_ = rhs.kmax_;
   nDifferent_ = rhs.nDifferent_;
+  // neighbourhood is made again
+  neighbourhood_ = NULL;
+  numberSame_ = -1;
 }
 // Resets stuff if model changes
 void CbcHeuristicVND::resetModel(CbcModel * /*model*/)
@@ -148,6 +160,9 @@ void CbcHeuristicVND::resetModel(CbcModel * /*model*/)
   } else {
     baseSolution_ = NULL;
   }
+  delete[] neighbourhood_;
+  neighbourhood_ = NULL;
+  numberSame_ = -1;
 }
 /*
   First tries setting a variable to better value.  If feasible then
@@ -166,27 +181,9 @@ int CbcHeuristicVND::solution(double &solutionValue,
     heuristicName(), numRuns_, numCouldRun_, when_);
 #endif
   if (numberSolutions_ < model_->getSolutionCount()) {
-    // new solution - add info
+    // new solution - make neighbourhood again
     numberSolutions_ = model_->getSolutionCount();
-
-    int numberIntegers = model_->numberIntegers();
-    const int *integerVariable = model_->integerVariable();
-
-    int i;
-    for (i = 0; i < numberIntegers; i++) {
-      int iColumn = integerVariable[i];
-      const OsiObject *object = model_->object(i);
-      // get original bounds
-      double originalLower;
-      double originalUpper;
-      getIntegerInformation(object, originalLower, originalUpper);
-      double value = bestSolution[iColumn];
-      if (value < originalLower) {
-        value = originalLower;
-      } else if (value > originalUpper) {
-        value = originalUpper;
-      }
-    }
+    numberSame_ = -1;
   }
   int numberNodes = model_->getNodeCount();
   if (howOften_ == 100) {
@@ -204,48 +201,73 @@ int CbcHeuristicVND::solution(double &solutionValue,
     const int *integerVariable = model_->integerVariable();
 
     const double *currentSolution = solver->getColSolution();
-    OsiSolverInterface *newSolver = cloneBut(3); // was model_->continuousSolver()->clone();
-    //const double * colLower = newSolver->getColLower();
-    //const double * colUpper = newSolver->getColUpper();
 
     double primalTolerance;
     solver->getDblParam(OsiPrimalTolerance, primalTolerance);
 
-    // Sort on distance
-    double *distance = new double[numberIntegers];
-    int *which = new int[numberIntegers];
-
     int i;
-    int nFix = 0;
-    double tolerance = 10.0 * primalTolerance;
-    for (i = 0; i < numberIntegers; i++) {
-      int iColumn = integerVariable[i];
-      const OsiObject *object = model_->object(i);
-      // get original bounds
-      double originalLower;
-      double originalUpper;
-      getIntegerInformation(object, originalLower, originalUpper);
-      double valueInt = bestSolution[iColumn];
-      if (valueInt < originalLower) {
-        valueInt = originalLower;
-      } else if (valueInt > originalUpper) {
-        valueInt = originalUpper;
+    if (numberSame_ + nDifferent_ != numberIntegers)
+      numberSame_ = -1;
+    if (numberSame_ >= 0) {
+      // keep neighbourhood unless lp solution has moved on
+      int nMoved = 0;
+      for (i = 0; i < numberIntegers; i++) {
+        int iColumn = integerVariable[i];
+        if (fabs(currentSolution[iColumn] - baseSolution_[iColumn]) > 0.1)
+          nMoved++;
       }
-      baseSolution_[iColumn] = currentSolution[iColumn];
-      distance[i] = fabs(currentSolution[iColumn] - valueInt);
-      which[i] = i;
-      if (fabs(currentSolution[iColumn] - valueInt) < tolerance)
-        nFix++;
+      if (10 * nMoved > numberIntegers) {
+        numberSame_ = -1;
+      } else {
+        // larger neighbourhood
+        k_ += stepSize_;
+        if (k_ > kmax_)
+          return 0; // wait for new incumbent or lp solution
+      }
+    }
+    if (numberSame_ < 0) {
+      // Sort on distance
+      double *distance = new double[numberIntegers];
+      delete[] neighbourhood_;
+      neighbourhood_ = new int[numberIntegers];
+      int nFix = 0;
+      double tolerance = 10.0 * primalTolerance;
+      for (i = 0; i < numberIntegers; i++) {
+        int iColumn = integerVariable[i];
+        const OsiObject *object = model_->object(i);
+        // get original bounds
+        double originalLower;
+        double originalUpper;
+        getIntegerInformation(object, originalLower, originalUpper);
+        double valueInt = bestSolution[iColumn];
+        if (valueInt < originalLower) {
+          valueInt = originalLower;
+        } else if (valueInt > originalUpper) {
+          valueInt = originalUpper;
+        }
+        baseSolution_[iColumn] = currentSolution[iColumn];
+        distance[i] = fabs(currentSolution[iColumn] - valueInt);
+        neighbourhood_[i] = i;
+        if (fabs(currentSolution[iColumn] - valueInt) < tolerance)
+          nFix++;
+      }
+      CoinSort_2(distance, distance + numberIntegers, neighbourhood_);
+      delete[] distance;
+      numberSame_ = nFix;
+      nDifferent_ = numberIntegers - nFix;
+      stepSize_ = CoinMax(nDifferent_ / 10, 1);
+      k_ = 0;
+      // keep more than a fifth fixed
+      kmax_ = nFix - numberIntegers / 5 - 1;
+      if (kmax_ < 0)
+        return 0;
     }
-    CoinSort_2(distance, distance + numberIntegers, which);
-    nDifferent_ = numberIntegers - nFix;
-    stepSize_ = nDifferent_ / 10;
-    k_ = stepSize_;
-    //nFix = numberIntegers-stepSize_;
+    int nFix = numberSame_ - k_;
+    OsiSolverInterface *newSolver = cloneBut(3); // was model_->continuousSolver()->clone();
     for (i = 0; i < nFix; i++) {
-      int j = which[i];
+      int j = neighbourhood_[i];
       int iColumn = integerVariable[j];
-      const OsiObject *object = model_->object(i);
+      const OsiObject *object = model_->object(j);
       // get original bounds
       double originalLower;
       double originalUpper;
@@ -260,30 +282,26 @@ int CbcHeuristicVND::solution(double &solutionValue,
       newSolver->setColLower(iColumn, nearest);
       newSolver->setColUpper(iColumn, nearest);
     }
-    delete[] distance;
-    delete[] which;
-    if (nFix > numberIntegers / 5) {
-      //printf("%d integers have samish value\n",nFix);
-      returnCode = smallBranchAndBound(newSolver, numberNodes_, betterSolution, solutionValue,
-        model_->getCutoff(), "CbcHeuristicVND");
-      if (returnCode < 0)
-        returnCode = 0; // returned on size
-      else
-        numRuns_++;
-      if ((returnCode & 1) != 0)
-        numberSuccesses_++;
-      //printf("return code %d",returnCode);
-      if ((returnCode & 2) != 0) {
-        // could add cut
-        returnCode &= ~2;
-        //printf("could add cut with %d elements (if all 0-1)\n",nFix);
-      } else {
-        //printf("\n");
-      }
-      numberTries_++;
-      if ((numberTries_ % 10) == 0 && numberSuccesses_ * 3 < numberTries_)
-        howOften_ += static_cast< int >(howOften_ * decayFactor_);
+    //printf("%d integers have samish value\n",nFix);
+    returnCode = smallBranchAndBound(newSolver, numberNodes_, betterSolution, solutionValue,
+      model_->getCutoff(), "CbcHeuristicVND");
+    if (returnCode < 0)
+      returnCode = 0; // returned on size
+    else
+      numRuns_++;
+    if ((returnCode & 1) != 0)
+      numberSuccesses_++;
+    //printf("return code %d",returnCode);
+    if ((returnCode & 2) != 0) {
+      // could add cut
+      returnCode &= ~2;
+      //printf("could add cut with %d elements (if all 0-1)\n",nFix);
+    } else {
+      //printf("\n");
     }
+    numberTries_++;
+    if ((numberTries_ % 10) == 0 && numberSuccesses_ * 3 < numberTries_)
+      howOften_ += static_cast< int >(howOften_ * decayFactor_);
 
     delete newSolver;
   }
@@ -299,6 +317,9 @@ void CbcHeuristicVND::setModel(CbcModel *model)
   int numberColumns = model->solver()->getNumCols();
   baseSolution_ = new double[numberColumns];
   memset(baseSolution_, 0, numberColumns * sizeof(double));
+  delete[] neighbourhood_;
+  neighbourhood_ = NULL;
+  numberSame_ = -1;
 }
 
 /* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
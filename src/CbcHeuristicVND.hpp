@@ -9,7 +9,15 @@
 
 #include "CbcHeuristic.hpp"
 
-/** LocalSearch class
+/** Variable neighbourhood descent
+
+    Integers where the lp solution agrees with the incumbent are fixed and
+    a small branch and bound is done on the rest.  The neighbourhood (the
+    lp solution and order of integers by distance) is kept between calls
+    and only made again if there is a new incumbent or the lp solution has
+    moved on more than a tenth of the integers.  While it is kept each
+    call frees stepSize_ more of the agreeing integers (the furthest
+    first) so successive calls search larger neighbourhoods.
  */
 
 class CBCLIB_EXPORT CbcHeuristicVND : public CbcHeuristic {
@@ -65,6 +73,11 @@ public:
   {
     return baseSolution_;
   }
+  /// Forget neighbourhood so it is made again next time
+  inline void clearNeighbourhood()
+  {
+    numberSame_ = -1;
+  }
 
 protected:
   // Data
@@ -84,8 +97,13 @@ protected:
   int k_;
   int kmax_;
   int nDifferent_;
-  /// Base solution
+  /// Base solution (lp solution when neighbourhood was made)
   double *baseSolution_;
+  /** Integers (as position in integerVariable) in order of distance of
+      lp solution from incumbent when neighbourhood was made */
+  int *neighbourhood_;
+  /// Number at start of neighbourhood_ where lp and incumbent agree (-1 make again)
+  int numberSame_;
 };
 
 #endif
@@ -0,0 +1,422 @@
+// Copyright (C) 2008, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#pragma warning(disable : 4786)
+#endif
+
+#include <cassert>
+#include <cmath>
+#include <cfloat>
+
+#include "OsiSolverInterface.hpp"
+#include "CbcImplicationGraph.hpp"
+#include "CbcCliqueTable.hpp"
+#include "CbcBoundPropagator.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinSort.hpp"
+
+// Default Constructor
+CbcImplicationGraph::CbcImplicationGraph()
+  : source_(NULL)
+  , target_(NULL)
+  , bound_(NULL)
+  , literalStart_(NULL)
+  , columnStart_(NULL)
+  , columnImplications_(NULL)
+  , numberColumns_(0)
+  , numberImplications_(0)
+  , maximumImplications_(0)
+  , finished_(false)
+{
+}
+
+// Constructor for number of columns
+CbcImplicationGraph::CbcImplicationGraph(int numberColumns)
+  : source_(NULL)
+  , target_(NULL)
+  , bound_(NULL)
+  , literalStart_(NULL)
+  , columnStart_(NULL)
+  , columnImplications_(NULL)
+  , numberColumns_(numberColumns)
+  , numberImplications_(0)
+  , maximumImplications_(0)
+  , finished_(false)
+{
+  finish();
+}
+
+// Copy constructor
+CbcImplicationGraph::CbcImplicationGraph(const CbcImplicationGraph &rhs)
+  : source_(NULL)
+  , target_(NULL)
+  , bound_(NULL)
+  , literalStart_(NULL)
+  , columnStart_(NULL)
+  , columnImplications_(NULL)
+{
+  gutsOfCopy(rhs);
+}
+
+// Assignment operator
+CbcImplicationGraph &
+CbcImplicationGraph::operator=(const CbcImplicationGraph &rhs)
+{
+  if (this != &rhs) {
+    gutsOfDelete();
+    gutsOfCopy(rhs);
+  }
+  return *this;
+}
+
+// Destructor
+CbcImplicationGraph::~CbcImplicationGraph()
+{
+  gutsOfDelete();
+}
+
+// Free arrays
+void CbcImplicationGraph::gutsOfDelete()
+{
+  delete[] source_;
+  delete[] target_;
+  delete[] bound_;
+  delete[] literalStart_;
+  delete[] columnStart_;
+  delete[] columnImplications_;
+  source_ = NULL;
+  target_ = NULL;
+  bound_ = NULL;
+  literalStart_ = NULL;
+  columnStart_ = NULL;
+  columnImplications_ = NULL;
+}
+
+// Copy
+void CbcImplicationGraph::gutsOfCopy(const CbcImplicationGraph &rhs)
+{
+  numberColumns_ = rhs.numberColumns_;
+  numberImplications_ = rhs.numberImplications_;
+  maximumImplications_ = rhs.maximumImplications_;
+  finished_ = rhs.finished_;
+  if (rhs.source_) {
+    source_ = CoinCopyOfArray(rhs.source_, maximumImplications_);
+    target_ = CoinCopyOfArray(rhs.target_, maximumImplications_);
+    bound_ = CoinCopyOfArray(rhs.bound_, maximumImplications_);
+  }
+  if (rhs.literalStart_) {
+    literalStart_ = CoinCopyOfArray(rhs.literalStart_, 2 * numberColumns_ + 1);
+    columnStart_ = CoinCopyOfArray(rhs.columnStart_, numberColumns_ + 1);
+    columnImplications_ = CoinCopyOfArray(rhs.columnImplications_,
+      CoinMax(columnStart_[numberColumns_], 1));
+  }
+}
+
+// Add implication
+void CbcImplicationGraph::addImplication(int literal, int iColumn, double bound, bool upper)
+{
+  assert(literal >= 0 && literal < 2 * numberColumns_);
+  assert(iColumn >= 0 && iColumn < numberColumns_);
+  if (CbcCliqueTable::column(literal) == iColumn)
+    return; // nothing to learn
+  if (numberImplications_ == maximumImplications_) {
+    int newMaximum = 2 * maximumImplications_ + 1000;
+    int *tempS = new int[newMaximum];
+    int *tempT = new int[newMaximum];
+    double *tempB = new double[newMaximum];
+    CoinMemcpyN(source_, numberImplications_, tempS);
+    CoinMemcpyN(target_, numberImplications_, tempT);
+    CoinMemcpyN(bound_, numberImplications_, tempB);
+    delete[] source_;
+    delete[] target_;
+    delete[] bound_;
+    source_ = tempS;
+    target_ = tempT;
+    bound_ = tempB;
+    maximumImplications_ = newMaximum;
+  }
+  source_[numberImplications_] = literal;
+  target_[numberImplications_] = 2 * iColumn + (upper ? 1 : 0);
+  bound_[numberImplications_] = bound;
+  numberImplications_++;
+  finished_ = false;
+}
+
+/* Sort by literal and bound and keep tightest of duplicates.
+   Implications are bucketed by literal (counting sort) and each bucket
+   sorted by target so duplicates are next to each other.
+*/
+void CbcImplicationGraph::finish()
+{
+  delete[] literalStart_;
+  delete[] columnStart_;
+  delete[] columnImplications_;
+  int numberLiterals = 2 * numberColumns_;
+  literalStart_ = new int[numberLiterals + 1];
+  CoinZeroN(literalStart_, numberLiterals + 1);
+  for (int j = 0; j < numberImplications_; j++)
+    literalStart_[source_[j] + 1]++;
+  for (int i = 0; i < numberLiterals; i++)
+    literalStart_[i + 1] += literalStart_[i];
+  int *put = new int[numberLiterals];
+  CoinMemcpyN(literalStart_, numberLiterals, put);
+  int *target = new int[CoinMax(numberImplications_, 1)];
+  double *bound = new double[CoinMax(numberImplications_, 1)];
+  for (int j = 0; j < numberImplications_; j++) {
+    int k = put[source_[j]]++;
+    target[k] = target_[j];
+    bound[k] = bound_[j];
+  }
+  delete[] put;
+  int n = 0;
+  for (int iLiteral = 0; iLiteral < numberLiterals; iLiteral++) {
+    int start = literalStart_[iLiteral];
+    int end = literalStart_[iLiteral + 1];
+    literalStart_[iLiteral] = n;
+    if (end - start > 1)
+      CoinSort_2(target + start, target + end, bound + start);
+    for (int j = start; j < end; j++) {
+      if (n > literalStart_[iLiteral] && target_[n - 1] == target[j]) {
+        // same bound - keep tightest
+        if (target[j] & 1)
+          bound_[n - 1] = CoinMin(bound_[n - 1], bound[j]);
+        else
+          bound_[n - 1] = CoinMax(bound_[n - 1], bound[j]);
+      } else {
+        source_[n] = iLiteral;
+        target_[n] = target[j];
+        bound_[n++] = bound[j];
+      }
+    }
+  }
+  literalStart_[numberLiterals] = n;
+  numberImplications_ = n;
+  delete[] target;
+  delete[] bound;
+  // index by column bounded
+  columnStart_ = new int[numberColumns_ + 1];
+  CoinZeroN(columnStart_, numberColumns_ + 1);
+  for (int j = 0; j < n; j++)
+    columnStart_[(target_[j] >> 1) + 1]++;
+  for (int i = 0; i < numberColumns_; i++)
+    columnStart_[i + 1] += columnStart_[i];
+  columnImplications_ = new int[CoinMax(n, 1)];
+  put = new int[CoinMax(numberColumns_, 1)];
+  CoinMemcpyN(columnStart_, numberColumns_, put);
+  for (int j = 0; j < n; j++)
+    columnImplications_[put[target_[j] >> 1]++] = j;
+  delete[] put;
+  finished_ = true;
+}
+
+// Apply what follows from new bounds of one column
+int CbcImplicationGraph::propagateColumn(CbcBoundPropagator &propagator, int iColumn,
+  const CbcCliqueTable *table) const
+{
+  if (iColumn >= numberColumns_)
+    return 0;
+  const double *lower = propagator.lower();
+  const double *upper = propagator.upper();
+  double tolerance = propagator.tolerance();
+  int numberChanged = 0;
+  double value = lower[iColumn];
+  if (value == upper[iColumn] && (value == 0.0 || value == 1.0)) {
+    int literal = CbcCliqueTable::literal(iColumn, static_cast< int >(value));
+    for (int j = literalStart_[literal]; j < literalStart_[literal + 1]; j++) {
+      int jColumn = target_[j] >> 1;
+      int returnCode;
+      if (target_[j] & 1)
+        returnCode = propagator.changeBounds(jColumn, lower[jColumn], bound_[j]);
+      else
+        returnCode = propagator.changeBounds(jColumn, bound_[j], upper[jColumn]);
+      if (returnCode < 0)
+        return -1;
+      numberChanged += returnCode;
+    }
+    if (table) {
+      int returnCode = table->fixConflicts(propagator, literal);
+      if (returnCode < 0)
+        return -1;
+      numberChanged += returnCode;
+    }
+  }
+  // a literal whose bound on this column can not hold must be false
+  for (int k = columnStart_[iColumn]; k < columnStart_[iColumn + 1]; k++) {
+    int j = columnImplications_[k];
+    bool violated = (target_[j] & 1) ? lower[iColumn] > bound_[j] + tolerance
+                                     : upper[iColumn] < bound_[j] - tolerance;
+    if (violated) {
+      int literal = source_[j];
+      int returnCode = propagator.fix(CbcCliqueTable::column(literal),
+        1 - CbcCliqueTable::value(literal));
+      if (returnCode < 0)
+        return -1;
+      numberChanged += returnCode;
+    }
+  }
+  return numberChanged;
+}
+
+// Apply implications of changed columns
+int CbcImplicationGraph::propagate(CbcBoundPropagator &propagator, int mark,
+  const CbcCliqueTable *table,
+  int numberSeeds, const int *seeds) const
+{
+  assert(finished_);
+  if (table && table->numberColumns() != numberColumns_)
+    table = NULL;
+  int numberChanged = 0;
+  for (int i = 0; i < numberSeeds; i++) {
+    int returnCode = propagateColumn(propagator, seeds[i], table);
+    if (returnCode < 0)
+      return -1;
+    numberChanged += returnCode;
+  }
+  // trail grows as bounds are changed so is the worklist
+  for (int i = mark; i < propagator.mark(); i++) {
+    int returnCode = propagateColumn(propagator, propagator.changedColumn(i), table);
+    if (returnCode < 0)
+      return -1;
+    numberChanged += returnCode;
+  }
+  return numberChanged;
+}
+
+/* Apply all that follows from column fixed at value to bounds of solver.
+   Same as propagate but on copies of bounds with a list of columns
+   whose bounds have changed, so no propagator (rows) needed.
+*/
+int CbcImplicationGraph::apply(OsiSolverInterface *solver, int iColumn, int value,
+  const CbcCliqueTable *table) const
+{
+  assert(finished_);
+  if (solver->getNumCols() != numberColumns_ || iColumn >= numberColumns_)
+    return 0;
+  if (table && table->numberColumns() != numberColumns_)
+    table = NULL;
+  if (!numberImplications_ && !table)
+    return 0;
+  const double *originalLower = solver->getColLower();
+  const double *originalUpper = solver->getColUpper();
+  double *lower = CoinCopyOfArray(originalLower, numberColumns_);
+  double *upper = CoinCopyOfArray(originalUpper, numberColumns_);
+  double tolerance;
+  solver->getDblParam(OsiPrimalTolerance, tolerance);
+  // list of columns to look at - a column is only on once at a time
+  int *list = new int[numberColumns_];
+  char *onList = new char[numberColumns_];
+  CoinZeroN(onList, numberColumns_);
+  int numberOnList = 0;
+  bool feasible = true;
+  lower[iColumn] = value;
+  upper[iColumn] = value;
+  list[numberOnList++] = iColumn;
+  onList[iColumn] = 1;
+  while (numberOnList && feasible) {
+    int kColumn = list[--numberOnList];
+    onList[kColumn] = 0;
+    int fixLiteral = -1;
+    double kValue = lower[kColumn];
+    int first = 0;
+    int last = 0;
+    if (kValue == upper[kColumn] && (kValue == 0.0 || kValue == 1.0)) {
+      fixLiteral = CbcCliqueTable::literal(kColumn, static_cast< int >(kValue));
+      first = literalStart_[fixLiteral];
+      last = literalStart_[fixLiteral + 1];
+    }
+    // implications of literal
+    for (int j = first; j < last; j++) {
+      int jColumn = target_[j] >> 1;
+      bool isUpper = (target_[j] & 1) != 0;
+      double bound = bound_[j];
+      if (solver->isInteger(jColumn))
+        bound = isUpper ? floor(bound + 1.0e-6) : ceil(bound - 1.0e-6);
+      if (isUpper && bound < upper[jColumn])
+        upper[jColumn] = bound;
+      else if (!isUpper && bound > lower[jColumn])
+        lower[jColumn] = bound;
+      else
+        continue;
+      if (lower[jColumn] > upper[jColumn] + tolerance) {
+        feasible = false;
+        break;
+      }
+      if (!onList[jColumn]) {
+        list[numberOnList++] = jColumn;
+        onList[jColumn] = 1;
+      }
+    }
+    // clique conflicts of literal
+    if (table && fixLiteral >= 0 && feasible) {
+      const int *cliques = table->cliquesOf(fixLiteral);
+      int numberCliques = table->numberCliquesOf(fixLiteral);
+      for (int i = 0; i < numberCliques && feasible; i++) {
+        const int *literals = table->clique(cliques[i]);
+        int length = table->cliqueLength(cliques[i]);
+        for (int j = 0; j < length; j++) {
+          int other = literals[j];
+          if (other == fixLiteral)
+            continue;
+          int jColumn = CbcCliqueTable::column(other);
+          double otherValue = 1 - CbcCliqueTable::value(other);
+          if (lower[jColumn] == otherValue && upper[jColumn] == otherValue)
+            continue;
+          if (lower[jColumn] > otherValue || upper[jColumn] < otherValue) {
+            feasible = false;
+            break;
+          }
+          lower[jColumn] = otherValue;
+          upper[jColumn] = otherValue;
+          if (!onList[jColumn]) {
+            list[numberOnList++] = jColumn;
+            onList[jColumn] = 1;
+          }
+        }
+      }
+    }
+    // literals whose bound on kColumn can not hold are false
+    for (int k = columnStart_[kColumn]; k < columnStart_[kColumn + 1] && feasible; k++) {
+      int j = columnImplications_[k];
+      bool violated = (target_[j] & 1) ? lower[kColumn] > bound_[j] + tolerance
+                                       : upper[kColumn] < bound_[j] - tolerance;
+      if (violated) {
+        int jColumn = CbcCliqueTable::column(source_[j]);
+        double otherValue = 1 - CbcCliqueTable::value(source_[j]);
+        if (lower[jColumn] == otherValue && upper[jColumn] == otherValue)
+          continue;
+        if (lower[jColumn] > otherValue || upper[jColumn] < otherValue) {
+          feasible = false;
+          break;
+        }
+        lower[jColumn] = otherValue;
+        upper[jColumn] = otherValue;
+        if (!onList[jColumn]) {
+          list[numberOnList++] = jColumn;
+          onList[jColumn] = 1;
+        }
+      }
+    }
+  }
+  int numberChanged = 0;
+  for (int jColumn = 0; jColumn < numberColumns_; jColumn++) {
+    if (lower[jColumn] > originalLower[jColumn]) {
+      solver->setColLower(jColumn, lower[jColumn]);
+      numberChanged++;
+    }
+    if (upper[jColumn] < originalUpper[jColumn]) {
+      solver->setColUpper(jColumn, upper[jColumn]);
+      numberChanged++;
+    }
+  }
+  delete[] lower;
+  delete[] upper;
+  delete[] list;
+  delete[] onList;
+  return feasible ? numberChanged : -1;
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -0,0 +1,139 @@
+// Copyright (C) 2008, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcImplicationGraph_H
+#define CbcImplicationGraph_H
+
+#include <cstddef>
+
+#include "CbcConfig.h"
+
+class OsiSolverInterface;
+class CbcBoundPropagator;
+class CbcCliqueTable;
+
+/** Graph of implications from binary literals to bounds
+
+    A literal is a binary column at one or zero and is numbered as in
+    CbcCliqueTable.  An implication says that if the literal is true
+    some other column has a new lower or upper bound (one binary fixing
+    another is just a bound of 0 or 1).  Implications come from probing
+    at the root, from the user (CbcModel::addImplication) or from
+    anything else which calls addImplication.
+
+    Implications are applied with a worklist so they are transitive -
+    a column fixed by an implication has its own implications applied
+    and, if a clique table is given, its clique conflicts fixed, all in
+    one pass.  The other direction is also used: if a bound implied by a
+    literal can no longer hold the literal is fixed false.
+
+    Used by node propagation, n-way branching and fix and propagate.
+ */
+
+class CBCLIB_EXPORT CbcImplicationGraph {
+public:
+  /// Default Constructor
+  CbcImplicationGraph();
+
+  /// Constructor for number of columns
+  CbcImplicationGraph(int numberColumns);
+
+  /// Copy constructor
+  CbcImplicationGraph(const CbcImplicationGraph &);
+
+  /// Assignment operator
+  CbcImplicationGraph &operator=(const CbcImplicationGraph &rhs);
+
+  /// Destructor
+  ~CbcImplicationGraph();
+
+  /** Add implication - if literal true column has bound as upper (or
+      lower) bound.  Not used until finish is called */
+  void addImplication(int literal, int iColumn, double bound, bool upper);
+  /** Sort implications by literal (keeping tightest of duplicates) and
+      build indices.  Must be called after adding */
+  void finish();
+  /// Whether finish has been called since last add
+  inline bool finished() const
+  {
+    return finished_;
+  }
+
+  /** Apply implications of columns changed on propagator trail after
+      mark (and of seeds - columns changed before trail started) until
+      nothing more follows.  Clique conflicts are fixed as well if table
+      given.  Returns number of bounds changed or -1 if infeasible */
+  int propagate(CbcBoundPropagator &propagator, int mark,
+    const CbcCliqueTable *table = NULL,
+    int numberSeeds = 0, const int *seeds = NULL) const;
+  /** Apply all that follows from column being fixed at value (0 or 1) to
+      bounds of solver (no rows are used).  Column itself is fixed too.
+      Returns number of bounds changed or -1 if infeasible (bounds which
+      cross are still set so solver will find infeasibility) */
+  int apply(OsiSolverInterface *solver, int iColumn, int value,
+    const CbcCliqueTable *table = NULL) const;
+
+  /// Number of columns
+  inline int numberColumns() const
+  {
+    return numberColumns_;
+  }
+  /// Number of implications
+  inline int numberImplications() const
+  {
+    return numberImplications_;
+  }
+  /// Number of implications of literal (after finish)
+  inline int numberImplicationsOf(int literal) const
+  {
+    return literalStart_[literal + 1] - literalStart_[literal];
+  }
+  /** Get implication i - literal, column, bound and whether upper
+      bound (e.g. to generate code) */
+  inline void implication(int i, int &literal, int &iColumn,
+    double &bound, bool &upper) const
+  {
+    literal = source_[i];
+    iColumn = target_[i] >> 1;
+    bound = bound_[i];
+    upper = (target_[i] & 1) != 0;
+  }
+
+private:
+  /// Free arrays
+  void gutsOfDelete();
+  /// Copy
+  void gutsOfCopy(const CbcImplicationGraph &rhs);
+  /** Apply what follows from new bounds of one column.  Returns number
+      of bounds changed or -1 if infeasible */
+  int propagateColumn(CbcBoundPropagator &propagator, int iColumn,
+    const CbcCliqueTable *table) const;
+
+private:
+  /// Literal of each implication (in order after finish)
+  int *source_;
+  /// Column of each implication times two plus one if upper bound
+  int *target_;
+  /// Bound of each implication
+  double *bound_;
+  /// Start of implications of each literal (2*numberColumns_+1)
+  int *literalStart_;
+  /// Start of implications on each column (numberColumns_+1)
+  int *columnStart_;
+  /// Implications on each column
+  int *columnImplications_;
+  /// Number of columns
+  int numberColumns_;
+  /// Number of implications
+  int numberImplications_;
+  /// Space for implications
+  int maximumImplications_;
+  /// Whether indices are up to date
+  bool finished_;
+};
+
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -0,0 +1,424 @@
+// Copyright (C) 2002, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#pragma warning(disable : 4786)
+#endif
+#include <cassert>
+#include <cstdlib>
+#include <cmath>
+#include <cfloat>
+
+#include "CoinTypes.h"
+#include "OsiSolverInterface.hpp"
+#include "CbcModel.hpp"
+#include "CbcMessage.hpp"
+#include "CbcIndicator.hpp"
+#include "CoinHelperFunctions.hpp"
+
+// Tolerance on row activity
+#define CBC_INDICATOR_TOLERANCE 1.0e-7
+
+//##############################################################################
+
+// Default Constructor
+CbcIndicator::CbcIndicator()
+  : CbcObject()
+  , indicatorColumn_(-1)
+  , activeValue_(1)
+  , numberElements_(0)
+  , columns_(NULL)
+  , elements_(NULL)
+  , rowLower_(-COIN_DBL_MAX)
+  , rowUpper_(COIN_DBL_MAX)
+  , boundFixing_(true)
+{
+}
+
+// Useful constructor (which are integer indices)
+CbcIndicator::CbcIndicator(CbcModel *model, int indicatorColumn, int activeValue,
+  int numberElements, const int *columns, const double *elements,
+  double rowLower, double rowUpper, int identifier)
+  : CbcObject(model)
+  , indicatorColumn_(indicatorColumn)
+  , activeValue_(activeValue ? 1 : 0)
+  , numberElements_(numberElements)
+  , rowLower_(rowLower)
+  , rowUpper_(rowUpper)
+  , boundFixing_(true)
+{
+  id_ = identifier;
+  columns_ = CoinCopyOfArray(columns, numberElements_);
+  elements_ = CoinCopyOfArray(elements, numberElements_);
+}
+
+// Copy constructor
+CbcIndicator::CbcIndicator(const CbcIndicator &rhs)
+  : CbcObject(rhs)
+  , indicatorColumn_(rhs.indicatorColumn_)
+  , activeValue_(rhs.activeValue_)
+  , numberElements_(rhs.numberElements_)
+  , rowLower_(rhs.rowLower_)
+  , rowUpper_(rhs.rowUpper_)
+  , boundFixing_(rhs.boundFixing_)
+{
+  columns_ = CoinCopyOfArray(rhs.columns_, numberElements_);
+  elements_ = CoinCopyOfArray(rhs.elements_, numberElements_);
+}
+
+// Clone
+CbcObject *
+CbcIndicator::clone() const
+{
+  return new CbcIndicator(*this);
+}
+
+// Assignment operator
+CbcIndicator &
+CbcIndicator::operator=(const CbcIndicator &rhs)
+{
+  if (this != &rhs) {
+    CbcObject::operator=(rhs);
+    delete[] columns_;
+    delete[] elements_;
+    indicatorColumn_ = rhs.indicatorColumn_;
+    activeValue_ = rhs.activeValue_;
+    numberElements_ = rhs.numberElements_;
+    columns_ = CoinCopyOfArray(rhs.columns_, numberElements_);
+    elements_ = CoinCopyOfArray(rhs.elements_, numberElements_);
+    rowLower_ = rhs.rowLower_;
+    rowUpper_ = rhs.rowUpper_;
+    boundFixing_ = rhs.boundFixing_;
+  }
+  return *this;
+}
+
+// Destructor
+CbcIndicator::~CbcIndicator()
+{
+  delete[] columns_;
+  delete[] elements_;
+}
+double
+CbcIndicator::infeasibility(const OsiBranchingInformation *info,
+  int &preferredWay) const
+{
+  preferredWay = 1;
+  if (indicatorColumn_ < 0)
+    return 0.0;
+  const double *solution = info->solution_;
+  // inactive - or fractional which is left to integer object
+  if (fabs(solution[indicatorColumn_] - activeValue_) > info->integerTolerance_)
+    return 0.0;
+  double activity = 0.0;
+  for (int j = 0; j < numberElements_; j++)
+    activity += elements_[j] * solution[columns_[j]];
+  double violation = CoinMax(rowLower_ - activity, activity - rowUpper_);
+  double tolerance = CoinMax(CBC_INDICATOR_TOLERANCE, info->primalTolerance_);
+  if (violation <= tolerance)
+    return 0.0; // satisfied
+  else
+    return CoinMin(violation, 0.5);
+}
+
+// If indicator active tighten bounds from row
+void CbcIndicator::feasibleRegion()
+{
+  if (indicatorColumn_ < 0)
+    return;
+  OsiSolverInterface *solver = model_->solver();
+  const double *solution = model_->testSolution();
+  double integerTolerance = model_->getDblParam(CbcModel::CbcIntegerTolerance);
+  if (fabs(solution[indicatorColumn_] - activeValue_) <= integerTolerance)
+    propagate(solver);
+}
+// Redoes data when sequence numbers change
+void CbcIndicator::redoSequenceEtc(CbcModel *model, int numberColumns, const int *originalColumns)
+{
+  model_ = model;
+  int numberOld = indicatorColumn_ + 1;
+  int i;
+  for (i = 0; i < numberColumns; i++)
+    numberOld = CoinMax(numberOld, originalColumns[i] + 1);
+  for (i = 0; i < numberElements_; i++)
+    numberOld = CoinMax(numberOld, columns_[i] + 1);
+  int *newColumn = new int[numberOld];
+  for (i = 0; i < numberOld; i++)
+    newColumn[i] = -1;
+  for (i = 0; i < numberColumns; i++)
+    newColumn[originalColumns[i]] = i;
+  mapColumns(newColumn);
+  delete[] newColumn;
+}
+// Change column numbers using map from old to new (-1 if gone)
+void CbcIndicator::mapColumns(const int *newColumn)
+{
+  if (indicatorColumn_ >= 0) {
+    int iColumn = newColumn[indicatorColumn_];
+    if (iColumn < 0)
+      printf("** Indicator column %d vanished - indicator ignored!\n", indicatorColumn_);
+    indicatorColumn_ = iColumn;
+  }
+  int n2 = 0;
+  for (int j = 0; j < numberElements_; j++) {
+    int iColumn = newColumn[columns_[j]];
+    if (iColumn >= 0) {
+      columns_[n2] = iColumn;
+      elements_[n2++] = elements_[j];
+    }
+  }
+  if (n2 < numberElements_) {
+    printf("** Indicator number of elements reduced from %d to %d!\n", numberElements_, n2);
+    numberElements_ = n2;
+  }
+}
+/* Tighten bounds of row columns from row (indicator taken as active).
+   Returns number of bounds changed or -1 if row can not be satisfied */
+int CbcIndicator::propagate(OsiSolverInterface *solver) const
+{
+  const double *lower = solver->getColLower();
+  const double *upper = solver->getColUpper();
+  // activity range - counting infinite contributions
+  double minActivity = 0.0;
+  double maxActivity = 0.0;
+  int numberInfiniteMin = 0;
+  int numberInfiniteMax = 0;
+  int j;
+  for (j = 0; j < numberElements_; j++) {
+    int iColumn = columns_[j];
+    double value = elements_[j];
+    double lo = (value > 0.0) ? lower[iColumn] : upper[iColumn];
+    double up = (value > 0.0) ? upper[iColumn] : lower[iColumn];
+    if (fabs(lo) > 1.0e30)
+      numberInfiniteMin++;
+    else
+      minActivity += value * lo;
+    if (fabs(up) > 1.0e30)
+      numberInfiniteMax++;
+    else
+      maxActivity += value * up;
+  }
+  if (!numberInfiniteMin && minActivity > rowUpper_ + CBC_INDICATOR_TOLERANCE)
+    return -1;
+  if (!numberInfiniteMax && maxActivity < rowLower_ - CBC_INDICATOR_TOLERANCE)
+    return -1;
+  // new bounds computed from old ones then applied
+  double *newLower = new double[2 * numberElements_];
+  double *newUpper = newLower + numberElements_;
+  for (j = 0; j < numberElements_; j++) {
+    int iColumn = columns_[j];
+    double value = elements_[j];
+    double lo = (value > 0.0) ? lower[iColumn] : upper[iColumn];
+    double up = (value > 0.0) ? upper[iColumn] : lower[iColumn];
+    newLower[j] = lower[iColumn];
+    newUpper[j] = upper[iColumn];
+    if (!value)
+      continue;
+    if (rowUpper_ < 1.0e30) {
+      // value * x <= rowUpper - minimum of others
+      bool infinite = fabs(lo) > 1.0e30;
+      if (numberInfiniteMin == (infinite ? 1 : 0)) {
+        double others = minActivity - (infinite ? 0.0 : value * lo);
+        double bound = (rowUpper_ - others) / value;
+        if (value > 0.0)
+          newUpper[j] = CoinMin(newUpper[j], bound);
+        else
+          newLower[j] = CoinMax(newLower[j], bound);
+      }
+    }
+    if (rowLower_ > -1.0e30) {
+      // value * x >= rowLower - maximum of others
+      bool infinite = fabs(up) > 1.0e30;
+      if (numberInfiniteMax == (infinite ? 1 : 0)) {
+        double others = maxActivity - (infinite ? 0.0 : value * up);
+        double bound = (rowLower_ - others) / value;
+        if (value > 0.0)
+          newLower[j] = CoinMax(newLower[j], bound);
+        else
+          newUpper[j] = CoinMin(newUpper[j], bound);
+      }
+    }
+  }
+  int numberChanged = 0;
+  for (j = 0; j < numberElements_; j++) {
+    int iColumn = columns_[j];
+    double lo = newLower[j];
+    double up = newUpper[j];
+    if (solver->isInteger(iColumn)) {
+      lo = ceil(lo - 1.0e-6);
+      up = floor(up + 1.0e-6);
+    }
+    if (lo > up + CBC_INDICATOR_TOLERANCE) {
+      numberChanged = -1;
+      break;
+    }
+    if (lo > lower[iColumn] + CBC_INDICATOR_TOLERANCE) {
+      solver->setColLower(iColumn, CoinMin(lo, upper[iColumn]));
+      numberChanged++;
+    }
+    if (up < upper[iColumn] - CBC_INDICATOR_TOLERANCE) {
+      solver->setColUpper(iColumn, CoinMax(up, lower[iColumn]));
+      numberChanged++;
+    }
+  }
+  delete[] newLower;
+  return numberChanged;
+}
+// Whether current bounds imply row
+bool CbcIndicator::impliedByBounds(const OsiSolverInterface *solver) const
+{
+  const double *lower = solver->getColLower();
+  const double *upper = solver->getColUpper();
+  double minActivity = 0.0;
+  double maxActivity = 0.0;
+  for (int j = 0; j < numberElements_; j++) {
+    int iColumn = columns_[j];
+    double value = elements_[j];
+    double lo = (value > 0.0) ? lower[iColumn] : upper[iColumn];
+    double up = (value > 0.0) ? upper[iColumn] : lower[iColumn];
+    if (fabs(lo) > 1.0e30)
+      minActivity = -COIN_DBL_MAX;
+    else if (minActivity > -COIN_DBL_MAX)
+      minActivity += value * lo;
+    if (fabs(up) > 1.0e30)
+      maxActivity = COIN_DBL_MAX;
+    else if (maxActivity < COIN_DBL_MAX)
+      maxActivity += value * up;
+  }
+  return minActivity >= rowLower_ - CBC_INDICATOR_TOLERANCE && maxActivity <= rowUpper_ + CBC_INDICATOR_TOLERANCE;
+}
+/* Fix indicator active, propagate and if bounds do not imply row
+   add it as cut for subtree */
+void CbcIndicator::enforce(OsiSolverInterface *solver) const
+{
+  double value = activeValue_;
+  solver->setColLower(indicatorColumn_, value);
+  solver->setColUpper(indicatorColumn_, value);
+  if (propagate(solver) < 0) {
+    // row can not hold - make node infeasible
+    solver->setColLower(indicatorColumn_, 1.0);
+    solver->setColUpper(indicatorColumn_, 0.0);
+    return;
+  }
+  if (!boundFixing_ || !impliedByBounds(solver))
+    model_->setNextRowCut(rowCut());
+}
+// Row as a cut
+OsiRowCut
+CbcIndicator::rowCut() const
+{
+  OsiRowCut cut;
+  cut.setLb(rowLower_);
+  cut.setUb(rowUpper_);
+  cut.setRow(numberElements_, columns_, elements_, false);
+  return cut;
+}
+CbcBranchingObject *
+CbcIndicator::createCbcBranch(OsiSolverInterface *solver, const OsiBranchingInformation * /*info*/, int way)
+{
+  // if indicator fixed only enforcing branch is possible
+  bool onlyEnforce = solver->getColLower()[indicatorColumn_] == solver->getColUpper()[indicatorColumn_];
+  CbcBranchingObject *branch = new CbcIndicatorBranchingObject(model_, this, way, onlyEnforce);
+  branch->setOriginalObject(this);
+  return branch;
+}
+
+// Default Constructor
+CbcIndicatorBranchingObject::CbcIndicatorBranchingObject()
+  : CbcBranchingObject()
+  , object_(NULL)
+{
+}
+
+// Useful constructor
+CbcIndicatorBranchingObject::CbcIndicatorBranchingObject(CbcModel *model,
+  const CbcIndicator *indicator, int way, bool onlyEnforce)
+  : CbcBranchingObject(model, indicator->indicatorColumn(), way, indicator->activeValue())
+  , object_(indicator)
+{
+  if (onlyEnforce) {
+    way_ = 1;
+    setNumberBranchesLeft(1);
+  }
+}
+
+// Copy constructor
+CbcIndicatorBranchingObject::CbcIndicatorBranchingObject(const CbcIndicatorBranchingObject &rhs)
+  : CbcBranchingObject(rhs)
+  , object_(rhs.object_)
+{
+}
+
+// Assignment operator
+CbcIndicatorBranchingObject &
+CbcIndicatorBranchingObject::operator=(const CbcIndicatorBranchingObject &rhs)
+{
+  if (this != &rhs) {
+    CbcBranchingObject::operator=(rhs);
+    object_ = rhs.object_;
+  }
+  return *this;
+}
+CbcBranchingObject *
+CbcIndicatorBranchingObject::clone() const
+{
+  return (new CbcIndicatorBranchingObject(*this));
+}
+
+// Destructor
+CbcIndicatorBranchingObject::~CbcIndicatorBranchingObject()
+{
+}
+double
+CbcIndicatorBranchingObject::branch()
+{
+  decrementNumberBranchesLeft();
+  OsiSolverInterface *solver = model_->solver();
+  int iColumn = object_->indicatorColumn();
+  if (way_ < 0) {
+    // indicator inactive - row free
+    double value = 1 - object_->activeValue();
+    solver->setColLower(iColumn, value);
+    solver->setColUpper(iColumn, value);
+    way_ = 1;
+  } else {
+    object_->enforce(solver);
+    way_ = -1; // Swap direction
+  }
+  return 0.0;
+}
+void CbcIndicatorBranchingObject::print()
+{
+  int iColumn = object_->indicatorColumn();
+  if (way_ < 0)
+    printf("Indicator %d set to %d (row free)\n", iColumn, 1 - object_->activeValue());
+  else
+    printf("Indicator %d set to %d (row of %d elements enforced)\n", iColumn,
+      object_->activeValue(), object_->numberElements());
+}
+
+/** Compare the original object of \c this with the original object of \c
+    brObj.  Ordered by indicator column.
+*/
+int CbcIndicatorBranchingObject::compareOriginalObject(const CbcBranchingObject *brObj) const
+{
+  const CbcIndicatorBranchingObject *br = dynamic_cast< const CbcIndicatorBranchingObject * >(brObj);
+  assert(br);
+  return object_->indicatorColumn() - br->object_->indicatorColumn();
+}
+
+/** Compare the \c this with \c brObj.  Same way is same region,
+    otherwise disjoint.
+*/
+CbcRangeCompare
+CbcIndicatorBranchingObject::compareBranchingObject(const CbcBranchingObject *brObj, const bool /*replaceIfOverlap*/)
+{
+  const CbcIndicatorBranchingObject *br = dynamic_cast< const CbcIndicatorBranchingObject * >(brObj);
+  assert(br);
+  return (way_ == br->way_) ? CbcRangeSame : CbcRangeDisjoint;
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -0,0 +1,200 @@
+// Copyright (C) 2002, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcIndicator_H
+#define CbcIndicator_H
+
+#include "CbcBranchBase.hpp"
+#include "OsiRowCut.hpp"
+
+/** Define an indicator constraint.
+
+    When binary indicator column is at activeValue (0 or 1) then
+    rowLower <= sum elements*columns <= rowUpper must hold, otherwise
+    the row is free.  The row is not in the LP (so no big-M) - it is
+    enforced on one branch only.
+
+    If indicator is integral at activeValue and the row is violated
+    then one branch sets indicator to the other value and the other
+    fixes indicator, tightens bounds of row columns from the row and
+    adds the row as a cut in that subtree.  If bounds alone imply the
+    row (always for a single column row such as x <= 0) no cut is
+    added.  If indicator is already fixed only the second branch exists.
+*/
+
+class CBCLIB_EXPORT CbcIndicator : public CbcObject {
+
+public:
+  // Default Constructor
+  CbcIndicator();
+
+  /** Useful constructor - indicator and row columns are matrix indices
+    */
+  CbcIndicator(CbcModel *model, int indicatorColumn, int activeValue,
+    int numberElements, const int *columns, const double *elements,
+    double rowLower, double rowUpper, int identifier);
+
+  // Copy constructor
+  CbcIndicator(const CbcIndicator &);
+
+  /// Clone
+  virtual CbcObject *clone() const;
+
+  /// Assignment operator
+  CbcIndicator &operator=(const CbcIndicator &rhs);
+
+  /// Destructor
+  virtual ~CbcIndicator();
+
+  /// Infeasibility - violation of row if indicator active (at most 0.5)
+  virtual double infeasibility(const OsiBranchingInformation *info,
+    int &preferredWay) const;
+
+  using CbcObject::feasibleRegion;
+  /// If indicator fixed active tighten bounds from row
+  virtual void feasibleRegion();
+
+  /// Creates a branching object
+  virtual CbcBranchingObject *createCbcBranch(OsiSolverInterface *solver, const OsiBranchingInformation *info, int way);
+
+  /// Redoes data when sequence numbers change
+  virtual void redoSequenceEtc(CbcModel *model, int numberColumns, const int *originalColumns);
+  /// Change column numbers using map from old to new (-1 if gone)
+  void mapColumns(const int *newColumn);
+
+  /** Tighten bounds of row columns from row (indicator taken as active).
+        Returns number of bounds changed or -1 if row can not be satisfied */
+  int propagate(OsiSolverInterface *solver) const;
+  /// Whether current bounds of solver imply row
+  bool impliedByBounds(const OsiSolverInterface *solver) const;
+  /** Fix indicator active, propagate and if bounds do not imply row
+        add it as cut for subtree (via CbcModel::setNextRowCut) */
+  void enforce(OsiSolverInterface *solver) const;
+  /// Row as a cut
+  OsiRowCut rowCut() const;
+
+  /// Indicator column
+  inline int indicatorColumn() const
+  {
+    return indicatorColumn_;
+  }
+  /// Value of indicator for which row must hold
+  inline int activeValue() const
+  {
+    return activeValue_;
+  }
+  /// Number of elements in row
+  inline int numberElements() const
+  {
+    return numberElements_;
+  }
+  /// Columns of row
+  inline const int *columns() const
+  {
+    return columns_;
+  }
+  /// Elements of row
+  inline const double *elements() const
+  {
+    return elements_;
+  }
+  /// Row lower bound
+  inline double rowLower() const
+  {
+    return rowLower_;
+  }
+  /// Row upper bound
+  inline double rowUpper() const
+  {
+    return rowUpper_;
+  }
+  /// Whether bounds (rather than cut) used when they imply row
+  inline bool boundFixing() const
+  {
+    return boundFixing_;
+  }
+  /// Set whether bounds (rather than cut) used when they imply row
+  inline void setBoundFixing(bool yesNo)
+  {
+    boundFixing_ = yesNo;
+  }
+
+protected:
+  /// data
+  /// Indicator column
+  int indicatorColumn_;
+  /// Value of indicator for which row must hold
+  int activeValue_;
+  /// Number of elements in row
+  int numberElements_;
+  /// Columns of row
+  int *columns_;
+  /// Elements of row
+  double *elements_;
+  /// Row lower bound
+  double rowLower_;
+  /// Row upper bound
+  double rowUpper_;
+  /// Whether bounds (rather than cut) used when they imply row
+  bool boundFixing_;
+};
+/** Indicator branching object class.
+    way -1 sets indicator inactive, +1 enforces row
+ */
+class CBCLIB_EXPORT CbcIndicatorBranchingObject : public CbcBranchingObject {
+
+public:
+  // Default Constructor
+  CbcIndicatorBranchingObject();
+
+  /** Useful constructor - if onlyEnforce then just one branch
+    */
+  CbcIndicatorBranchingObject(CbcModel *model, const CbcIndicator *indicator,
+    int way, bool onlyEnforce);
+
+  // Copy constructor
+  CbcIndicatorBranchingObject(const CbcIndicatorBranchingObject &);
+
+  // Assignment operator
+  CbcIndicatorBranchingObject &operator=(const CbcIndicatorBranchingObject &rhs);
+
+  /// Clone
+  virtual CbcBranchingObject *clone() const;
+
+  // Destructor
+  virtual ~CbcIndicatorBranchingObject();
+
+  using CbcBranchingObject::branch;
+  /// Does next branch and updates state
+  virtual double branch();
+
+  using CbcBranchingObject::print;
+  /** \brief Print something about branch - only if log level high
+    */
+  virtual void print();
+
+  /** Return the type (an integer identifier) of \c this */
+  virtual CbcBranchObjType type() const
+  {
+    return IndicatorBranchObj;
+  }
+
+  /** Compare the original object of \c this with the original object of \c
+        brObj.  Ordered by indicator column.
+    */
+  virtual int compareOriginalObject(const CbcBranchingObject *brObj) const;
+
+  /** Compare the \c this with \c brObj.  Same way is same region,
+        otherwise disjoint.
+     */
+  virtual CbcRangeCompare compareBranchingObject(const CbcBranchingObject *brObj, const bool replaceIfOverlap = false);
+
+private:
+  /// Points back to object
+  const CbcIndicator *object_;
+};
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -134,12 +134,13 @@ void OsiSolverLink::initialSolve()
   specialOptions_ = 0;
   modelPtr_->setWhatsChanged(0);
   if (numberVariables_) {
-    CoinPackedMatrix *temp = new CoinPackedMatrix(*matrix_);
     // update all bounds before coefficients
     for (int i = 0; i < numberVariables_; i++) {
       info_[i].updateBounds(modelPtr_);
     }
-    int updated = updateCoefficients(modelPtr_, temp);
+    updateCoefficients(modelPtr_, matrix_);
+    // always refresh solver matrix from matrix_
+    CoinPackedMatrix *temp = new CoinPackedMatrix(*matrix_);
     //if (updated || 1) {
       temp->removeGaps(1.0e-14);
       ClpMatrixBase *save = modelPtr_->clpMatrix();
@@ -295,7 +296,6 @@ void OsiSolverLink::resolve()
   bool allFixed = numberFix_ > 0;
   bool feasible = true;
   if (numberVariables_) {
-    CoinPackedMatrix *temp = new CoinPackedMatrix(*matrix_);
     //bool best=true;
     const double *lower = modelPtr_->columnLower();
     const double *upper = modelPtr_->columnUpper();
@@ -308,8 +308,10 @@ void OsiSolverLink::resolve()
       if (up < lo)
         feasible = false;
     }
-    int updated = updateCoefficients(modelPtr_, temp);
+    // matrix_ keeps every element so can be updated in place
+    int updated = updateCoefficients(modelPtr_, matrix_);
     if (updated) {
+      CoinPackedMatrix *temp = new CoinPackedMatrix(*matrix_);
       temp->removeGaps(1.0e-14);
       ClpMatrixBase *save = modelPtr_->clpMatrix();
       ClpPackedMatrix *clpMatrix = dynamic_cast< ClpPackedMatrix * >(save);
@@ -331,8 +333,6 @@ void OsiSolverLink::resolve()
       modelPtr_->replaceMatrix(temp, true);
       modelPtr_->setNewRowCopy(NULL);
       modelPtr_->setClpScaledMatrix(NULL);
-    } else {
-      delete temp;
     }
   }
 #ifdef WRITE_MATRIX
@@ -4652,6 +4652,7 @@ OsiBiLinear::OsiBiLinear()
   , multiplier_(NULL)
   , extraRow_(NULL)
   , chosen_(-1)
+  , updatedMatrix_(NULL)
 {
 }
 
@@ -4683,6 +4684,7 @@ OsiBiLinear::OsiBiLinear(OsiSolverInterface *solver, int xColumn,
   , multiplier_(NULL)
   , extraRow_(NULL)
   , chosen_(-1)
+  , updatedMatrix_(NULL)
 {
   double columnLower[4];
   double columnUpper[4];
@@ -4924,6 +4926,7 @@ OsiBiLinear::OsiBiLinear(CoinModel *coinModel, int xColumn,
   , multiplier_(NULL)
   , extraRow_(NULL)
   , chosen_(-1)
+  , updatedMatrix_(NULL)
 {
   double columnLower[4];
   double columnUpper[4];
@@ -5139,6 +5142,7 @@ OsiBiLinear::OsiBiLinear(const OsiBiLinear &rhs)
   , multiplier_(NULL)
   , extraRow_(NULL)
   , chosen_(rhs.chosen_)
+  , updatedMatrix_(NULL)
 {
   if (numberExtraRows_) {
     multiplier_ = CoinCopyOfArray(rhs.multiplier_, numberExtraRows_);
@@ -5188,6 +5192,7 @@ OsiBiLinear::operator=(const OsiBiLinear &rhs)
       extraRow_ = NULL;
     }
     chosen_ = rhs.chosen_;
+    updatedMatrix_ = NULL;
   }
   return *this;
 }
@@ -5214,6 +5219,8 @@ void OsiBiLinear::addExtraRow(int row, double multiplier)
   extraRow_ = tempI;
   delete[] multiplier_;
   multiplier_ = tempD;
+  // extra row must be filled in
+  updatedMatrix_ = NULL;
 }
 static bool testCoarse = true;
 // Infeasibility - large is 0.5
@@ -6418,8 +6425,20 @@ int OsiBiLinear::updateCoefficients(const double *lower, const double *upper, do
   CoinWarmStartBasis::Status status[4];
   int numStruct = basis ? basis->getNumStructural() - firstLambda_ : 0;
   double coefficient = (boundType_ == 0) ? coefficient_ : 1.0;
+  // envelope same as last time this matrix was updated
+  bool same = updatedMatrix_ == matrix && updatedBounds_[0] == xB[0]
+    && updatedBounds_[1] == xB[1] && updatedBounds_[2] == yB[0]
+    && updatedBounds_[3] == yB[1] && updatedBounds_[4] == coefficient;
+  updatedMatrix_ = matrix;
+  updatedBounds_[0] = xB[0];
+  updatedBounds_[1] = xB[1];
+  updatedBounds_[2] = yB[0];
+  updatedBounds_[3] = yB[1];
+  updatedBounds_[4] = coefficient;
   for (int j = 0; j < 4; j++) {
     status[j] = (j < numStruct) ? basis->getStructStatus(j + firstLambda_) : CoinWarmStartBasis::atLowerBound;
+    if (same)
+      continue;
     int iX = j >> 1;
     double x = xB[iX];
     int iY = j & 1;
@@ -110,7 +110,8 @@ public:
   /// Add a bound modifier
   void addBoundModifier(bool upperBoundAffected, bool useUpperBound, int whichVariable, int whichVariableAffected,
     double multiplier = 1.0);
-  /// Update coefficients - returns number updated if in updating mode
+  /** Update coefficients - returns number changed if in updating mode.
+      matrix_ is updated in place so only changed envelopes are written */
   int updateCoefficients(ClpSimplex *solver, CoinPackedMatrix *matrix);
   /// Analyze constraints to see which are convex (quadratic)
   void analyzeObjects();
@@ -944,7 +945,9 @@ public:
   }
   /// Does work of branching
   void newBounds(OsiSolverInterface *solver, int way, short xOrY, double separator) const;
-  /// Updates coefficients - returns number updated
+  /** Updates coefficients - returns number updated.
+      Nothing is written (and 0 returned) if bounds and coefficient are
+      same as when this matrix was last updated */
   int updateCoefficients(const double *lower, const double *upper, double *objective,
     CoinPackedMatrix *matrix, CoinWarmStartBasis *basis) const;
   /// Returns true value of single xyRow coefficient
@@ -1024,6 +1027,10 @@ protected:
   int *extraRow_;
   /// Which chosen -1 none, 0 x, 1 y
   mutable short chosen_;
+  /// Bounds of x and y and coefficient when matrix last updated
+  mutable double updatedBounds_[5];
+  /// Matrix last updated (NULL if none)
+  mutable const CoinPackedMatrix *updatedMatrix_;
 };
 /** Branching object for BiLinear objects
 
@@ -58,6 +58,11 @@ typedef struct {
   bool jacval_called_with_current_x_;
 } CbcAmplInfo;
 
+/* Objective value at current x.  CbcAmplInfo is laid out by the AMPL
+   reader so the value is kept here, valid while objval flag is set. */
+static const CbcAmplInfo *objectiveInfo = NULL;
+static double objectiveAtX = 0.0;
+
 //#############################################################################
 // Constructors / Destructor / Assignment
 //#############################################################################
@@ -97,6 +102,11 @@ bool get_constraints_linearity(void *amplInfo, int n,
 static bool internal_objval(CbcAmplInfo *info, double &obj_val)
 {
   ASL_pfgh *asl = info->asl_;
+  if (info->objval_called_with_current_x_ && objectiveInfo == info) {
+    // same point as last time
+    obj_val = objectiveAtX;
+    return true;
+  }
   info->objval_called_with_current_x_ = false; // in case the call below fails
 
   if (n_obj == 0) {
@@ -108,6 +118,8 @@ static bool internal_objval(CbcAmplInfo *info, double &obj_val)
     if (!info->nerror_) {
       obj_val = info->obj_sign_ * retval;
       info->objval_called_with_current_x_ = true;
+      objectiveInfo = info;
+      objectiveAtX = obj_val;
       return true;
     } else {
       abort();
@@ -120,8 +132,11 @@ static bool internal_objval(CbcAmplInfo *info, double &obj_val)
 static bool internal_conval(CbcAmplInfo *info, double *g)
 {
   ASL_pfgh *asl = info->asl_;
-  info->conval_called_with_current_x_ = false; // in case the call below fails
   assert(g);
+  // all constraints are in buffer if same point as last time
+  if (info->conval_called_with_current_x_ && g == info->constraintValues_)
+    return true;
+  info->conval_called_with_current_x_ = false; // in case the call below fails
 
   conval(info->non_const_x_, g, (fint *)&info->nerror_);
 
@@ -138,6 +153,16 @@ static bool apply_new_x(CbcAmplInfo *info, bool new_x, int n, const double *x)
 {
   ASL_pfgh *asl = info->asl_;
 
+  if (new_x && info->non_const_x_) {
+    // same point (often - objective then constraints) - keep what is known
+    int i;
+    for (i = 0; i < n; i++) {
+      if (info->non_const_x_[i] != x[i])
+        break;
+    }
+    if (i == n)
+      new_x = false;
+  }
   if (new_x) {
     // update the flags so these methods are called
     // before evaluating the hessian
@@ -227,9 +252,14 @@ static bool eval_jac_g(void *amplInfo, int n, const double *x, bool new_x,
   if (!apply_new_x(info, new_x, n, x)) {
     return false;
   }
+  // whole jacobian is in buffer if same point as last time
+  if (info->jacval_called_with_current_x_ && values == info->gradient_)
+    return true;
 
   jacval(info->non_const_x_, values, (fint *)&info->nerror_);
   if (!info->nerror_) {
+    if (values == info->gradient_)
+      info->jacval_called_with_current_x_ = true;
     return true;
   } else {
     abort();
@@ -628,6 +658,7 @@ ClpConstraintAmpl::ClpConstraintAmpl(int row, void *amplInfo)
 ClpConstraintAmpl::ClpConstraintAmpl(const ClpConstraintAmpl &rhs)
   : ClpConstraint(rhs)
 {
+  amplInfo_ = rhs.amplInfo_;
   numberCoefficients_ = rhs.numberCoefficients_;
   column_ = CoinCopyOfArray(rhs.column_, numberCoefficients_);
   coefficient_ = CoinCopyOfArray(rhs.coefficient_, numberCoefficients_);
@@ -651,6 +682,7 @@ ClpConstraintAmpl::operator=(const ClpConstraintAmpl &rhs)
   if (this != &rhs) {
     delete[] column_;
     delete[] coefficient_;
+    amplInfo_ = rhs.amplInfo_;
     numberCoefficients_ = rhs.numberCoefficients_;
     column_ = CoinCopyOfArray(rhs.column_, numberCoefficients_);
     coefficient_ = CoinCopyOfArray(rhs.coefficient_, numberCoefficients_);
@@ -678,20 +710,26 @@ int ClpConstraintAmpl::gradient(const ClpSimplex *model,
   ASL_pfgh *asl = info->asl_;
   int numberColumns = n_var;
   ;
-  // If not done then do all
+  /*
+    If not done then do all - values and gradients of all constraints go
+    into buffers of info in one call each and other constraints at the
+    same point just take their part (eval_g and eval_jac_g return at once
+    if solution is the point they last saw).
+  */
   if (!info->jacval_called_with_current_x_) {
     bool getStuff = eval_g(amplInfo_, numberColumns, solution, true, info->constraintValues_);
     assert(getStuff);
     getStuff = eval_jac_g(amplInfo_, numberColumns, solution, false, info->gradient_);
     assert(getStuff);
-    info->jacval_called_with_current_x_ = getStuff;
   }
   if (refresh || !lastGradient_) {
     functionValue_ = info->constraintValues_[rowNumber_];
     offset_ = functionValue_; // sign??
-    if (!lastGradient_)
+    if (!lastGradient_) {
+      // nonzeros are always in column_ so only needs zeroing once
       lastGradient_ = new double[numberColumns];
-    CoinZeroN(lastGradient_, numberColumns);
+      CoinZeroN(lastGradient_, numberColumns);
+    }
     assert(!(model && model->rowScale() && useScaling));
     int i;
     int start = info->rowStart_[rowNumber_];
@@ -68,6 +68,8 @@ static Cbc_message us_english[] = {
   { CBC_FATHOM_CHANGE, 49, 1, "Complete fathoming at depth >= %d" },
 #endif
   { CBC_MAXITERS, 50, 1, "Exiting on maximum number of iterations" },
+  { CBC_MEMORY, 51, 2, "Memory %.1f MB (peak %.1f) - nodes %.1f, node info %.1f, warm start %.1f, node cuts %.1f, global cuts %.1f, generators %.1f, solutions %.1f, solvers %.1f, threads %.1f" },
+  { CBC_THREAD_PROGRESS, 52, 2, "Thread %d - %d nodes, %.0f iterations, idle %g seconds (%.1f%%), %d locks (%g waiting), %d merges (%g seconds)" },
   { CBC_NOINT, 3007, 1, "No integer variables - nothing to do" },
   { CBC_WARNING_STRONG, 3008, 1, "Strong branching is fixing too many variables, too expensively!" },
   { CBC_DUMMY_END, 999999, 0, "" }
@@ -73,6 +73,8 @@ enum CBC_Message {
   CBC_RESTART,
   CBC_GENERAL,
   CBC_ROOT_DETAIL,
+  CBC_MEMORY,
+  CBC_THREAD_PROGRESS,
 #ifndef NO_FATHOM_PRINT
   CBC_FATHOM_CHANGE,
 #endif
@@ -89,6 +91,22 @@ public:
   //@}
 };
 
+/** Whether handler would print message messageNumber of messages (detail
+    against log level as in CoinMessageHandler::message).  Check before a
+    message on a hot path (each node or strong branching candidate) so
+    arguments are not formatted only to be thrown away. */
+inline bool CbcMessageWanted(const CoinMessageHandler *handler,
+  const CoinMessages &messages, int messageNumber)
+{
+  int logLevel = handler->logLevel(messages.class_);
+  if (logLevel == -1000)
+    logLevel = handler->logLevel();
+  int detail = messages.message_[messageNumber]->detail();
+  if (detail >= 8 && logLevel >= 0)
+    return (detail & logLevel) != 0;
+  return detail <= logLevel;
+}
+
 #endif
 
 /* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
@@ -4,6 +4,7 @@
 #include <cassert>
 #include <cstdio>
 #include <cstring>
+#include <cctype>
 #include <algorithm>
 #include <vector>
 #include <string>
@@ -13,6 +14,7 @@
 #include "CbcHeuristic.hpp"
 #include <CbcModel.hpp>
 #include "CbcMipStartIO.hpp"
+#include "CbcNameHash.hpp"
 #include "CbcSOS.hpp"
 #include "CoinTime.hpp"
 
@@ -29,78 +31,276 @@ bool isNumericStr(const char *str)
   return true;
 }
 
+// Start of binary mipstart files
+static const char binaryMagic[8] = { 'C', 'b', 'c', 'M', 'i', 'p', 'S', 't' };
+
+/* reads a line of any length into line (without end of line),
+   returns false at end of file */
+static bool readLine(FILE *f, std::vector< char > &line)
+{
+  line.resize(256);
+  size_t n = 0;
+  while (fgets(&line[n], static_cast< int >(line.size() - n), f)) {
+    n += strlen(&line[n]);
+    if (n && line[n - 1] == '\n') {
+      line[--n] = '\0';
+      return true;
+    }
+    if (n + 1 < line.size())
+      return true; // last line without end of line
+    line.resize(2 * line.size());
+  }
+  line[n] = '\0';
+  return n > 0;
+}
+
+/* splits line in place at white space, returns number of tokens
+   (at most maxTokens) */
+static int tokenize(char *line, char **token, int maxTokens)
+{
+  int n = 0;
+  char *c = line;
+  while (n < maxTokens) {
+    while (*c && isspace(static_cast< unsigned char >(*c)))
+      c++;
+    if (!*c)
+      break;
+    token[n++] = c;
+    while (*c && !isspace(static_cast< unsigned char >(*c)))
+      c++;
+    if (!*c)
+      break;
+    *c++ = '\0';
+  }
+  return n;
+}
+
 int CbcMipStartIO::read(OsiSolverInterface *solver, const char *fileName,
-  std::vector< std::pair< std::string, double > > &colValues,
+  std::vector< int > &colIndices, std::vector< double > &colValues,
   double &solObj, CoinMessageHandler *messHandler, CoinMessages *pcoinmsgs)
 {
   CoinMessages &messages = *pcoinmsgs;
 #define STR_SIZE 256
-  FILE *f = fopen(fileName, "r");
+  FILE *f = fopen(fileName, "rb");
   if (!f)
     return 1;
-  char line[STR_SIZE] = "";
-
-  int nLine = 0;
   char printLine[STR_SIZE] = "";
-  while (fgets(line, STR_SIZE, f)) {
-    ++nLine;
-    char col[4][STR_SIZE] = {"", "", "", ""};
-    int nread = sscanf(line, "%s %s %s %s", col[0], col[1], col[2], col[3]);
-    if (!nread)
-      continue;
-    /* line with variable value */
-    if (strlen(col[0]) && isdigit(col[0][0]) && (nread >= 3)) {
+  const int numCols = solver->getNumCols();
+  colIndices.clear();
+  colValues.clear();
+
+  char magic[sizeof(binaryMagic)];
+  if (fread(magic, 1, sizeof(magic), f) == sizeof(magic)
+    && !memcmp(magic, binaryMagic, sizeof(magic))) {
+    /* binary - count, objective, indices and values */
+    int count = 0;
+    bool ok = fread(&count, sizeof(int), 1, f) == 1 && count >= 0
+      && fread(&solObj, sizeof(double), 1, f) == 1;
+    if (ok && count) {
+      colIndices.resize(count);
+      colValues.resize(count);
+      ok = fread(&colIndices[0], sizeof(int), count, f) == static_cast< size_t >(count)
+        && fread(&colValues[0], sizeof(double), count, f) == static_cast< size_t >(count);
+    }
+    int nBad = 0;
+    for (int i = 0; ok && i < count; i++) {
+      if (colIndices[i] < 0 || colIndices[i] >= numCols)
+        nBad++;
+      else if (nBad) {
+        colIndices[i - nBad] = colIndices[i];
+        colValues[i - nBad] = colValues[i];
+      }
+    }
+    if (!ok) {
+      snprintf(printLine, sizeof(printLine), "Reading: %s - binary mipstart file is truncated, ignoring.", fileName);
+      messHandler->message(CBC_GENERAL, messages) << printLine << CoinMessageEol;
+      colIndices.clear();
+      colValues.clear();
+    } else if (nBad) {
+      snprintf(printLine, sizeof(printLine), "Reading: %s - %d columns out of range in mipstart file, ignoring them.", fileName, nBad);
+      messHandler->message(CBC_GENERAL, messages) << printLine << CoinMessageEol;
+      colIndices.resize(count - nBad);
+      colValues.resize(count - nBad);
+    }
+  } else {
+    /* text - lines with index, name and value */
+    rewind(f);
+    CbcNameHash colIdx;
+    colIdx.build(solver, true);
+    std::vector< char > buffer;
+    int nLine = 0;
+    int notFound = 0;
+    while (readLine(f, buffer)) {
+      ++nLine;
+      char *col[3];
+      int nread = tokenize(&buffer[0], col, 3);
+      /* line with variable value */
+      if (nread < 3 || !isdigit(col[0][0]))
+        continue;
       if (!isNumericStr(col[0])) {
-        sprintf(printLine, "Reading: %s, line %d - first column in mipstart file should be numeric, ignoring.", fileName, nLine);
+        snprintf(printLine, sizeof(printLine), "Reading: %s, line %d - first column in mipstart file should be numeric, ignoring.", fileName, nLine);
         messHandler->message(CBC_GENERAL, messages) << printLine << CoinMessageEol;
         continue;
       }
       if (!isNumericStr(col[2])) {
-        sprintf(printLine, "Reading: %s, line %d - Third column in mipstart file should be numeric, ignoring.", fileName, nLine);
+        snprintf(printLine, sizeof(printLine), "Reading: %s, line %d - Third column in mipstart file should be numeric, ignoring.", fileName, nLine);
         messHandler->message(CBC_GENERAL, messages) << printLine << CoinMessageEol;
         continue;
       }
 
-      char *name = col[1];
-      double value = atof(col[2]);
-
-      colValues.push_back(pair< string, double >(string(name), value));
+      int idx = colIdx.find(col[1]);
+      if (idx < 0) {
+        notFound++;
+        continue;
+      }
+      colIndices.push_back(idx);
+      colValues.push_back(strtod(col[2], NULL));
+    }
+    if (notFound) {
+      snprintf(printLine, sizeof(printLine), "Reading: %s - %d names in mipstart file are not columns, ignoring them.", fileName, notFound);
+      messHandler->message(CBC_GENERAL, messages) << printLine << CoinMessageEol;
     }
   }
+  fclose(f);
 
-  const int numCols = solver->getNumCols();
   if (colValues.size()) {
-    sprintf(printLine, "MIPStart values read for %d variables.", static_cast< int >(colValues.size()));
+    snprintf(printLine, sizeof(printLine), "MIPStart values read for %d variables.", static_cast< int >(colValues.size()));
     messHandler->message(CBC_GENERAL, messages) << printLine << CoinMessageEol;
-    vector< pair< string, double > > fullValues;
-    /* for fast search of column names */
-    map< string, int > colIdx;
-    for (int i = 0; i < numCols; i++) {
-      fullValues.push_back(pair< string, double >(solver->getColName(i), 0.0));
-      colIdx[solver->getColName(i)] = i;
-    }
-    for (int i = 0; (i < static_cast< int >(colValues.size())); ++i) {
-      map< string, int >::const_iterator mIt = colIdx.find(colValues[i].first);
-      if (mIt != colIdx.end()) {
-        const int idx = mIt->second;
-        double v = colValues[i].second;
-        fullValues[idx].second = v;
-      }
-    }
-    colValues = fullValues;
   } else {
-    sprintf(printLine, "File %s does not contains a solution.", fileName);
+    snprintf(printLine, sizeof(printLine), "File %s does not contains a solution.", fileName);
     messHandler->message(CBC_GENERAL, messages) << printLine << CoinMessageEol;
-    fclose(f);
     return 1;
   }
 
-  fclose(f);
   return 0;
 }
 
+int CbcMipStartIO::read(OsiSolverInterface *solver, const char *fileName,
+  std::vector< std::pair< std::string, double > > &colValues,
+  double &solObj, CoinMessageHandler *messHandler, CoinMessages *pcoinmsgs)
+{
+  std::vector< int > indices;
+  std::vector< double > values;
+  if (read(solver, fileName, indices, values, solObj, messHandler, pcoinmsgs))
+    return 1;
+
+  /* all columns - ones not in file at zero */
+  const int numCols = solver->getNumCols();
+  std::vector< double > fullValues(numCols, 0.0);
+  for (int i = 0; i < static_cast< int >(indices.size()); ++i)
+    fullValues[indices[i]] = values[i];
+  colValues.clear();
+  colValues.reserve(numCols);
+  for (int i = 0; i < numCols; i++)
+    colValues.push_back(pair< string, double >(solver->getColName(i), fullValues[i]));
+
+  return 0;
+}
+
+int CbcMipStartIO::writeBinary(const char *fileName, int count,
+  const int *colIndices, const double *colValues, double obj)
+{
+  FILE *f = fopen(fileName, "wb");
+  if (!f)
+    return 1;
+  bool ok = fwrite(binaryMagic, 1, sizeof(binaryMagic), f) == sizeof(binaryMagic)
+    && fwrite(&count, sizeof(int), 1, f) == 1
+    && fwrite(&obj, sizeof(double), 1, f) == 1;
+  if (ok && count > 0)
+    ok = fwrite(colIndices, sizeof(int), count, f) == static_cast< size_t >(count)
+      && fwrite(colValues, sizeof(double), count, f) == static_cast< size_t >(count);
+  if (fclose(f))
+    ok = false;
+  return ok ? 0 : 1;
+}
+
+/* when fixing the start does not give a solution - integers the start
+   fixed are freed but objective counts moves away from start and only
+   a few moves are allowed (local branching), then small branch and bound.
+   target is value start wanted (COIN_DBL_MAX if none).
+   returns true if solution found (in sol with cost obj) */
+static bool repairMipStart(CbcModel *model, const OsiSolverInterface *solver,
+  const std::vector< double > &target, double *sol, double &obj,
+  CoinMessageHandler *messHandler, CoinMessages &messages)
+{
+  if (!model)
+    return false;
+  int numberColumns = solver->getNumCols();
+  const double *lower = solver->getColLower();
+  const double *upper = solver->getColUpper();
+  vector< double > distance(numberColumns, 0.0);
+  vector< int > which;
+  vector< double > element;
+  double rhs = 0.0;
+  for (int i = 0; i < numberColumns; i++) {
+    if (target[i] == COIN_DBL_MAX)
+      continue;
+    if (target[i] <= lower[i]) {
+      distance[i] = 1.0;
+      rhs += lower[i];
+    } else if (target[i] >= upper[i]) {
+      distance[i] = -1.0;
+      rhs -= upper[i];
+    } else {
+      continue;
+    }
+    which.push_back(i);
+    element.push_back(distance[i]);
+  }
+  if (!which.size())
+    return false;
+
+  char printLine[STR_SIZE];
+  int numberMoves = CoinMax(10, static_cast< int >(which.size()) / 10);
+  snprintf(printLine, sizeof(printLine), "Trying to repair MIPStart changing at most %d of %d integer values.",
+    numberMoves, static_cast< int >(which.size()));
+  messHandler->message(CBC_GENERAL, messages)
+    << printLine << CoinMessageEol;
+  double start = CoinCpuTime();
+
+  OsiSolverInterface *repair = solver->clone();
+  repair->setObjective(&distance[0]);
+  repair->addRow(static_cast< int >(which.size()), &which[0], &element[0],
+    -COIN_DBL_MAX, rhs + numberMoves);
+  repair->setDblParam(OsiDualObjectiveLimit, COIN_DBL_MAX);
+  repair->initialSolve();
+  bool found = false;
+  if (repair->isProvenOptimal()) {
+    if (repair->getFractionalIndices().size() > 0) {
+      CbcSerendipity heuristic(*model);
+      heuristic.setFractionSmall(2.0);
+      heuristic.setFeasibilityPumpOptions(1008013);
+      double value = COIN_DBL_MAX;
+      int returnCode = heuristic.smallBranchAndBound(repair,
+        1000, sol, value, COIN_DBL_MAX, "RepairMIPStart");
+      found = (returnCode & 1) != 0;
+    } else {
+      copy(repair->getColSolution(), repair->getColSolution() + numberColumns, sol);
+      found = true;
+    }
+  }
+  delete repair;
+
+  if (found) {
+    const double *objective = solver->getObjCoefficients();
+    solver->getDblParam(OsiObjOffset, obj);
+    obj = -obj;
+    int moved = 0;
+    for (int i = 0; i < numberColumns; i++) {
+      obj += objective[i] * sol[i];
+      if (target[i] != COIN_DBL_MAX && fabs(sol[i] - target[i]) > 0.5)
+        moved++;
+    }
+    snprintf(printLine, sizeof(printLine), "MIPStart repaired changing %d integer values in %.2f seconds.",
+      moved, CoinCpuTime() - start);
+    messHandler->message(CBC_GENERAL, messages)
+      << printLine << CoinMessageEol;
+  }
+  return found;
+}
+
 int CbcMipStartIO::computeCompleteSolution(CbcModel *model, OsiSolverInterface *solver,
-  const std::vector< std::string > colNames,
+  const std::vector< std::string > &colNames,
   const std::vector< std::pair< std::string, double > > &colValues,
   double *sol, double &obj, int extraActions, CoinMessageHandler *messHandler, CoinMessages *pmessages)
 {
@@ -114,11 +314,10 @@ int CbcMipStartIO::computeCompleteSolution(CbcModel *model, OsiSolverInterface *
   bool foundIntegerSol = false;
   OsiSolverInterface *lp = solver->clone();
 
-  map< string, int > colIdx;
+  CbcNameHash colIdx;
   assert((static_cast< int >(colNames.size())) == lp->getNumCols());
   /* for fast search of column names */
-  for (int i = 0; (i < static_cast< int >(colNames.size())); ++i)
-    colIdx[colNames[i]] = i;
+  colIdx.build(colNames);
 
   char printLine[STR_SIZE];
   int fixed = 0;
@@ -127,6 +326,8 @@ int CbcMipStartIO::computeCompleteSolution(CbcModel *model, OsiSolverInterface *
   int nContinuousFixed = 0;
   double *realObj = new double[lp->getNumCols()];
   memcpy(realObj, lp->getObjCoefficients(), sizeof(double)*lp->getNumCols());
+  // integer values start asked for (for repair)
+  vector< double > target;
 
   // assuming that variables not fixed are more likely to have zero as value,
   // inserting as default objective function 1
@@ -187,13 +388,12 @@ int CbcMipStartIO::computeCompleteSolution(CbcModel *model, OsiSolverInterface *
     }
   }
   for (int i = 0; (i < static_cast< int >(colValues.size())); ++i) {
-    map< string, int >::const_iterator mIt = colIdx.find(colValues[i].first);
-    if (mIt == colIdx.end()) {
+    const int idx = colIdx.find(colValues[i].first.c_str());
+    if (idx < 0) {
       if (!notFound)
-        strcpy(colNotFound, colValues[i].first.c_str());
+        strncat(colNotFound, colValues[i].first.c_str(), sizeof(colNotFound) - 1);
       notFound++;
     } else {
-      const int idx = mIt->second;
       double v = colValues[i].second;
 #if JUST_FIX_INTEGER
       if (!lp->isInteger(idx))
@@ -221,7 +421,7 @@ int CbcMipStartIO::computeCompleteSolution(CbcModel *model, OsiSolverInterface *
   }
 
   if (notFound >= ((static_cast< double >(colNames.size())) * 0.5)) {
-    sprintf(printLine, "Warning: %d column names were not found (e.g. %s) while filling solution.", notFound, colNotFound);
+    snprintf(printLine, sizeof(printLine), "Warning: %d column names were not found (e.g. %s) while filling solution.", notFound, colNotFound);
     messHandler->message(CBC_GENERAL, messages)
       << printLine << CoinMessageEol;
   }
@@ -229,6 +429,13 @@ int CbcMipStartIO::computeCompleteSolution(CbcModel *model, OsiSolverInterface *
   lp->setHintParam(OsiDoPresolveInInitial, true, OsiHintDo);
 #endif
 
+  target.assign(lp->getNumCols(), COIN_DBL_MAX);
+  for (int i = 0; i < lp->getNumCols(); ++i) {
+    if (lp->isInteger(i) && lp->getColLower()[i] == lp->getColUpper()[i]
+      && solver->getColLower()[i] < solver->getColUpper()[i])
+      target[i] = lp->getColLower()[i];
+  }
+
   lp->setDblParam(OsiDualObjectiveLimit, COIN_DBL_MAX);
   lp->initialSolve();
 
@@ -323,15 +530,17 @@ int CbcMipStartIO::computeCompleteSolution(CbcModel *model, OsiSolverInterface *
   }
 
   if (!lp->isProvenOptimal()) {
-    messHandler->message(CBC_GENERAL, messages)
-      << "Warning: mipstart values could not be used to build a solution." << CoinMessageEol;
-    status = 1;
-    goto TERMINATE;
-  }
-
-  /* some additional effort is needed to provide an integer solution */
-  if (lp->getFractionalIndices().size() > 0) {
-    sprintf(printLine, "MIPStart solution provided values for %d of %d integer variables, %d variables are still fractional.", fixed, lp->getNumIntegers(), static_cast< int >(lp->getFractionalIndices().size()));
+    if (!repairMipStart(model, solver, target, sol, obj, messHandler, messages)) {
+      messHandler->message(CBC_GENERAL, messages)
+        << "Warning: mipstart values could not be used to build a solution." << CoinMessageEol;
+      status = 1;
+      goto TERMINATE;
+    }
+    foundIntegerSol = true;
+    compObj = obj;
+  } else if (lp->getFractionalIndices().size() > 0) {
+    /* some additional effort is needed to provide an integer solution */
+    snprintf(printLine, sizeof(printLine), "MIPStart solution provided values for %d of %d integer variables, %d variables are still fractional.", fixed, lp->getNumIntegers(), static_cast< int >(lp->getFractionalIndices().size()));
     messHandler->message(CBC_GENERAL, messages)
       << printLine << CoinMessageEol;
     double start = CoinCpuTime();
@@ -345,7 +554,7 @@ int CbcMipStartIO::computeCompleteSolution(CbcModel *model, OsiSolverInterface *
       model->getCutoff(),
       "ReduceInMIPStart");
     if ((returnCode & 1) != 0) {
-      sprintf(printLine, "Mini branch and bound defined values for remaining variables in %.2f seconds.",
+      snprintf(printLine, sizeof(printLine), "Mini branch and bound defined values for remaining variables in %.2f seconds.",
         CoinCpuTime() - start);
       messHandler->message(CBC_GENERAL, messages)
         << printLine << CoinMessageEol;
@@ -363,7 +572,7 @@ int CbcMipStartIO::computeCompleteSolution(CbcModel *model, OsiSolverInterface *
     babModel.setMaximumSeconds(60);
     babModel.branchAndBound();
     if (babModel.bestSolution()) {
-      sprintf(printLine, "Mini branch and bound defined values for remaining variables in %.2f seconds.",
+      snprintf(printLine, sizeof(printLine), "Mini branch and bound defined values for remaining variables in %.2f seconds.",
         CoinCpuTime() - start);
       messHandler->message(CBC_GENERAL, messages)
         << printLine << CoinMessageEol;
@@ -372,7 +581,10 @@ int CbcMipStartIO::computeCompleteSolution(CbcModel *model, OsiSolverInterface *
       obj = compObj = babModel.getObjValue();
     }
 #endif
-    else {
+    else if (repairMipStart(model, solver, target, sol, obj, messHandler, messages)) {
+      foundIntegerSol = true;
+      compObj = obj;
+    } else {
       messHandler->message(CBC_GENERAL, messages)
         << "Warning: mipstart values could not be used to build a solution." << CoinMessageEol;
       status = 1;
@@ -390,7 +602,7 @@ int CbcMipStartIO::computeCompleteSolution(CbcModel *model, OsiSolverInterface *
   }
 
   if (foundIntegerSol) {
-    sprintf(printLine, "MIPStart provided solution with cost %g", compObj);
+    snprintf(printLine, sizeof(printLine), "MIPStart provided solution with cost %g", compObj);
     messHandler->message(CBC_GENERAL, messages)
       << printLine << CoinMessageEol;
 #if 0
@@ -15,13 +15,30 @@ class CoinMessages;
 class CBCSOLVERLIB_EXPORT CbcMipStartIO{
 public:  
 /* tries to read mipstart (solution file) from
-   fileName, filling colValues and obj
+   fileName, filling colValues (all columns, ones
+   not in file at zero) and obj
    returns 0 with success,
    1 otherwise */
 static int read(OsiSolverInterface *solver, const char *fileName,
   std::vector< std::pair< std::string, double > > &colValues,
   double &solObj, CoinMessageHandler *messHandler, CoinMessages *pcoinmsgs);
 
+/* as above but just columns in file - text files have
+   lines with index, name and value (found by name),
+   binary ones (see writeBinary) give column indices.
+   obj is only set from binary files */
+static int read(OsiSolverInterface *solver, const char *fileName,
+  std::vector< int > &colIndices, std::vector< double > &colValues,
+  double &solObj, CoinMessageHandler *messHandler, CoinMessages *pcoinmsgs);
+
+/* writes mipstart by column indices - "CbcMipSt" then
+   count (int), obj (double), count ints and count doubles
+   in native byte order.
+   returns 0 with success,
+   1 otherwise */
+static int writeBinary(const char *fileName, int count,
+  const int *colIndices, const double *colValues, double obj);
+
 /* from a partial list of variables tries to fill the
    remaining variable values.
    extraActions 0 -default, otherwise set integers not mentioned
@@ -30,7 +47,7 @@ static int read(OsiSolverInterface *solver, const char *fileName,
    4,6 ones without costs as 1,2 - ones with costs to expensive
 */
 static int computeCompleteSolution(CbcModel *model, OsiSolverInterface *solver,
-  const std::vector< std::string > colNames,
+  const std::vector< std::string > &colNames,
   const std::vector< std::pair< std::string, double > > &colValues,
   double *sol, double &obj, int extraActions, CoinMessageHandler *messHandler, CoinMessages *pmessages);
   
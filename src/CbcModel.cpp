@@ -22,6 +22,17 @@ extern int gomory_try;
 #include <cassert>
 #include <cmath>
 #include <cfloat>
+#include <cstring>
+#include <cctype>
+#include <set>
+#include <map>
+#if defined(_WIN32)
+#include <io.h>
+#define CBC_WRITE_FD _write
+#else
+#include <unistd.h>
+#define CBC_WRITE_FD write
+#endif
 #ifdef CBC_HAS_CLP
 // include Presolve from Clp
 #include "ClpPresolve.hpp"
@@ -42,10 +53,14 @@ extern int gomory_try;
 #include "CoinHelperFunctions.hpp"
 #include "CbcBranchActual.hpp"
 #include "CbcBranchDynamic.hpp"
+#include "CbcBranchCut.hpp"
 #include "CbcHeuristic.hpp"
 #include "CbcHeuristicFPump.hpp"
 #include "CbcHeuristicRINS.hpp"
 #include "CbcHeuristicDive.hpp"
+#include "CbcHeuristicDiveFractional.hpp"
+#include "CbcHeuristicFixPropagate.hpp"
+#include "CbcHeuristicGreedy.hpp"
 #include "CbcModel.hpp"
 #include "CbcTreeLocal.hpp"
 #include "CbcStatistics.hpp"
@@ -59,7 +74,15 @@ extern int gomory_try;
 #include "CbcCutGenerator.hpp"
 #include "CbcFeasibilityBase.hpp"
 #include "CbcFathom.hpp"
+#include "CbcBoundTrail.hpp"
+#include "CbcConflictAnalysis.hpp"
+#include "CbcStrongBudget.hpp"
+#include "CbcSolutionChanges.hpp"
+#include "CbcSeparationContext.hpp"
+#include "CbcStrongCache.hpp"
+#include "CbcPseudoCostArrays.hpp"
 #include "CbcFullNodeInfo.hpp"
+#include "CbcPartialNodeInfo.hpp"
 #ifdef CBC_HAS_NAUTY
 #include "CbcSymmetry.hpp"
 #endif
@@ -82,6 +105,19 @@ extern int gomory_try;
 #include "CbcTree.hpp"
 // This may be dummy
 #include "CbcThread.hpp"
+#include "CbcBoundPropagator.hpp"
+#include "CbcOrbitope.hpp"
+#include "CbcCliqueTable.hpp"
+#include "CbcImplicationGraph.hpp"
+#include "CbcFactorizationCache.hpp"
+#include "CbcCutDatabase.hpp"
+#include "CbcFeatures.hpp"
+#include "CbcPhaseTimes.hpp"
+#include "CbcNodeTrace.hpp"
+#include "CbcCheckpoint.hpp"
+#include "CbcPeerExchange.hpp"
+// Most root cut passes when cuts come from cut database
+#define CBC_CUT_DATABASE_PASSES 2
 /* Various functions local to CbcModel.cpp */
 
 typedef struct {
@@ -90,6 +126,13 @@ typedef struct {
   int switches;
 } rootBundle;
 static void *doRootCbcThread(void *voidInfo);
+#ifdef CBC_THREAD
+// Thread pool passes pointer to entry in array of models
+static void *doRootCbcThreadInPool(void *voidInfo)
+{
+  return doRootCbcThread(*reinterpret_cast< CbcModel ** >(voidInfo));
+}
+#endif
 
 namespace {
 
@@ -123,6 +166,123 @@ static int gcd(int a, int b)
   }
   return b;
 }
+// Greatest common divisor of two integers held (exactly) in doubles
+static double gcdDouble(double a, double b)
+{
+  while (b) {
+    double remainder = fmod(a, b);
+    a = b;
+    b = remainder;
+  }
+  return a;
+}
+/* Positive value as numerator/denominator (continued fractions) with
+   denominator at most 1.0e6.  Returns false if no such fraction is close */
+static bool rationalValue(double value, double &numerator, double &denominator)
+{
+  if (value <= 0.0 || value > 1.0e15)
+    return false;
+  double tolerance = 1.0e-12 * CoinMax(1.0, value);
+  double p0 = 0.0;
+  double q0 = 1.0;
+  double p1 = 1.0;
+  double q1 = 0.0;
+  double x = value;
+  for (int i = 0; i < 40; i++) {
+    double a = floor(x);
+    double p2 = a * p1 + p0;
+    double q2 = a * q1 + q0;
+    if (q2 > 1.0e6)
+      return false;
+    if (fabs(p2 / q2 - value) <= tolerance) {
+      numerator = p2;
+      denominator = q2;
+      return true;
+    }
+    if (x - a < 1.0e-12)
+      return false;
+    x = 1.0 / (x - a);
+    p0 = p1;
+    q0 = q1;
+    p1 = p2;
+    q1 = q2;
+  }
+  return false;
+}
+/* Mark columns which are integer or must be integer in any integer
+   solution - continuous columns alone in an equality row with integer
+   columns where its element divides the other elements and the rhs.
+   Rows are looked at when they get down to one column not known to be
+   integer so this is linear in number of elements */
+static char *impliedIntegers(const OsiSolverInterface *solver)
+{
+  int numberRows = solver->getNumRows();
+  int numberColumns = solver->getNumCols();
+  const double *lower = solver->getColLower();
+  const double *upper = solver->getColUpper();
+  const double *rowLower = solver->getRowLower();
+  const double *rowUpper = solver->getRowUpper();
+  const CoinPackedMatrix *columnCopy = solver->getMatrixByCol();
+  const int *row = columnCopy->getIndices();
+  const CoinBigIndex *columnStart = columnCopy->getVectorStarts();
+  const int *columnLength = columnCopy->getVectorLengths();
+  const CoinPackedMatrix *rowCopy = solver->getMatrixByRow();
+  const double *elementByRow = rowCopy->getElements();
+  const int *column = rowCopy->getIndices();
+  const CoinBigIndex *rowStart = rowCopy->getVectorStarts();
+  const int *rowLength = rowCopy->getVectorLengths();
+  char *integral = new char[numberColumns];
+  int *count = new int[2 * numberRows];
+  int *stack = count + numberRows;
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    integral[iColumn] = solver->isInteger(iColumn) || (lower[iColumn] == upper[iColumn] && lower[iColumn] == floor(lower[iColumn] + 0.5));
+  }
+  int nStack = 0;
+  for (int iRow = 0; iRow < numberRows; iRow++) {
+    int n = 0;
+    for (CoinBigIndex j = rowStart[iRow]; j < rowStart[iRow] + rowLength[iRow]; j++) {
+      if (!integral[column[j]])
+        n++;
+    }
+    count[iRow] = n;
+    if (n == 1 && rowLower[iRow] == rowUpper[iRow])
+      stack[nStack++] = iRow;
+  }
+  while (nStack) {
+    int iRow = stack[--nStack];
+    int jColumn = -1;
+    double jElement = 0.0;
+    for (CoinBigIndex j = rowStart[iRow]; j < rowStart[iRow] + rowLength[iRow]; j++) {
+      if (!integral[column[j]]) {
+        jColumn = column[j];
+        jElement = fabs(elementByRow[j]);
+        break;
+      }
+    }
+    // a fixed column with fractional value blocks row
+    if (jColumn < 0 || !jElement || lower[jColumn] == upper[jColumn])
+      continue;
+    // element must divide rhs and all others
+    double value = rowUpper[iRow] / jElement;
+    bool good = fabs(value - floor(value + 0.5)) < 1.0e-10;
+    for (CoinBigIndex j = rowStart[iRow]; j < rowStart[iRow] + rowLength[iRow] && good; j++) {
+      value = elementByRow[j] / jElement;
+      if (fabs(value - floor(value + 0.5)) > 1.0e-10)
+        good = false;
+    }
+    if (!good)
+      continue;
+    integral[jColumn] = 1;
+    for (CoinBigIndex j = columnStart[jColumn]; j < columnStart[jColumn] + columnLength[jColumn]; j++) {
+      int kRow = row[j];
+      count[kRow]--;
+      if (count[kRow] == 1 && rowLower[kRow] == rowUpper[kRow])
+        stack[nStack++] = kRow;
+    }
+  }
+  delete[] count;
+  return integral;
+}
 
 #ifdef CHECK_NODE_FULL
 
@@ -362,6 +522,128 @@ void verifyCutSize(const CbcTree *branchingTree, CbcModel &model)
 
 /* End unnamed namespace for CbcModel.cpp */
 
+// Columns in a block of setup scan - more than two blocks go on threads
+#define CBC_SCAN_BLOCK 100000
+/* What setup scan finds about a block of columns - integrality and
+   objective of unfixed columns and whether bounds are integral.  Blocks
+   are independent so they can be done on threads and then added up */
+typedef struct {
+  const OsiSolverInterface *solver;
+  int firstColumn;
+  int lastColumn; // one after
+  int numberInteger;
+  int numberIntegerObj;
+  int numberGeneralIntegerObj;
+  int numberIntegerWeight;
+  int numberContinuousObj;
+  int numberFixed;
+  double largestObj;
+  double smallestObj;
+  double cost; // COIN_DBL_MAX none, -COIN_DBL_MAX not all same
+  bool integralBounds;
+} CbcColumnScan;
+
+static void *doColumnScan(void *voidInfo)
+{
+  CbcColumnScan *info = reinterpret_cast< CbcColumnScan * >(voidInfo);
+  const OsiSolverInterface *solver = info->solver;
+  const double *objective = solver->getObjCoefficients();
+  const double *lower = solver->getColLower();
+  const double *upper = solver->getColUpper();
+  info->numberInteger = 0;
+  info->numberIntegerObj = 0;
+  info->numberGeneralIntegerObj = 0;
+  info->numberIntegerWeight = 0;
+  info->numberContinuousObj = 0;
+  info->numberFixed = 0;
+  info->largestObj = 0.0;
+  info->smallestObj = COIN_DBL_MAX;
+  info->cost = COIN_DBL_MAX;
+  info->integralBounds = true;
+  for (int iColumn = info->firstColumn; iColumn < info->lastColumn; iColumn++) {
+    if (upper[iColumn] == lower[iColumn]) {
+      info->numberFixed++;
+      continue;
+    }
+    if (upper[iColumn] > lower[iColumn] + 1.0e-8 && info->integralBounds) {
+      double value = fabs(lower[iColumn]);
+      if (floor(value + 0.5) != value)
+        info->integralBounds = false;
+      value = fabs(upper[iColumn]);
+      if (floor(value + 0.5) != value)
+        info->integralBounds = false;
+    }
+    double objValue = objective[iColumn];
+    bool isInteger = solver->isInteger(iColumn);
+    if (isInteger)
+      info->numberInteger++;
+    if (objValue) {
+      if (!isInteger) {
+        info->numberContinuousObj++;
+      } else {
+        info->largestObj = CoinMax(info->largestObj, fabs(objValue));
+        info->smallestObj = CoinMin(info->smallestObj, fabs(objValue));
+        info->numberIntegerObj++;
+        if (info->cost == COIN_DBL_MAX)
+          info->cost = objValue;
+        else if (info->cost != objValue)
+          info->cost = -COIN_DBL_MAX;
+        int gap = static_cast< int >(upper[iColumn] - lower[iColumn]);
+        if (gap > 1) {
+          info->numberGeneralIntegerObj++;
+          info->numberIntegerWeight += gap;
+        }
+      }
+    }
+  }
+  return NULL;
+}
+/* One pass over columns of solver for setup (checkModel and
+   analyzeObjective).  Large problems are done in blocks on threads
+   (if model has threads) */
+static void scanColumns(CbcModel *model, CbcColumnScan &total)
+{
+  const OsiSolverInterface *solver = model->solver();
+  int numberColumns = solver->getNumCols();
+  int numberBlocks = 1;
+  CbcThreadPool *pool = NULL;
+  if (model->getNumberThreads() > 0 && !model->parentModel()
+    && numberColumns >= 2 * CBC_SCAN_BLOCK) {
+    pool = model->threadPool(model->getNumberThreads());
+    if (pool)
+      numberBlocks = (numberColumns + CBC_SCAN_BLOCK - 1) / CBC_SCAN_BLOCK;
+  }
+  CbcColumnScan *scan = new CbcColumnScan[numberBlocks];
+  for (int i = 0; i < numberBlocks; i++) {
+    scan[i].solver = solver;
+    scan[i].firstColumn = i * CBC_SCAN_BLOCK;
+    scan[i].lastColumn = (i == numberBlocks - 1) ? numberColumns : (i + 1) * CBC_SCAN_BLOCK;
+  }
+  if (pool)
+    pool->run(doColumnScan, numberBlocks, scan, static_cast< int >(sizeof(CbcColumnScan)));
+  else
+    doColumnScan(scan);
+  total = scan[0];
+  for (int i = 1; i < numberBlocks; i++) {
+    total.numberInteger += scan[i].numberInteger;
+    total.numberIntegerObj += scan[i].numberIntegerObj;
+    total.numberGeneralIntegerObj += scan[i].numberGeneralIntegerObj;
+    total.numberIntegerWeight += scan[i].numberIntegerWeight;
+    total.numberContinuousObj += scan[i].numberContinuousObj;
+    total.numberFixed += scan[i].numberFixed;
+    total.largestObj = CoinMax(total.largestObj, scan[i].largestObj);
+    total.smallestObj = CoinMin(total.smallestObj, scan[i].smallestObj);
+    if (total.cost == COIN_DBL_MAX)
+      total.cost = scan[i].cost;
+    else if (scan[i].cost != COIN_DBL_MAX && scan[i].cost != total.cost)
+      total.cost = -COIN_DBL_MAX;
+    total.integralBounds = total.integralBounds && scan[i].integralBounds;
+  }
+  total.firstColumn = 0;
+  total.lastColumn = numberColumns;
+  delete[] scan;
+}
+
 void CbcModel::analyzeObjective()
 /*
   Try to find a minimum change in the objective function. The first scan
@@ -382,6 +664,7 @@ void CbcModel::analyzeObjective()
   const double *objective = getObjCoefficients();
   const double *lower = getColLower();
   const double *upper = getColUpper();
+  cutoffStep_ = 0.0;
   /*
       Scan continuous and integer variables to see if continuous
       are cover or network with integral rhs.
@@ -404,43 +687,30 @@ void CbcModel::analyzeObjective()
     const int *row = solver_->getMatrixByCol()->getIndices();
     const CoinBigIndex *columnStart = solver_->getMatrixByCol()->getVectorStarts();
     const int *columnLength = solver_->getMatrixByCol()->getVectorLengths();
-    int numberInteger = 0;
-    int numberIntegerObj = 0;
-    int numberGeneralIntegerObj = 0;
-    int numberIntegerWeight = 0;
-    int numberContinuousObj = 0;
-    double cost = COIN_DBL_MAX;
-    for (iColumn = 0; iColumn < numberColumns; iColumn++) {
-      if (upper[iColumn] == lower[iColumn]) {
-        CoinBigIndex start = columnStart[iColumn];
-        CoinBigIndex end = start + columnLength[iColumn];
-        for (CoinBigIndex j = start; j < end; j++) {
-          int iRow = row[j];
-          rhs[iRow] += lower[iColumn] * element[j];
-        }
-      } else {
-        double objValue = objective[iColumn];
-        if (solver_->isInteger(iColumn))
-          numberInteger++;
-        if (objValue) {
-          if (!solver_->isInteger(iColumn)) {
-            numberContinuousObj++;
-          } else {
-            largestObj = CoinMax(largestObj, fabs(objValue));
-            smallestObj = CoinMin(smallestObj, fabs(objValue));
-            numberIntegerObj++;
-            if (cost == COIN_DBL_MAX)
-              cost = objValue;
-            else if (cost != objValue)
-              cost = -COIN_DBL_MAX;
-            int gap = static_cast< int >(upper[iColumn] - lower[iColumn]);
-            if (gap > 1) {
-              numberGeneralIntegerObj++;
-              numberIntegerWeight += gap;
-            }
+    CbcColumnScan scan;
+    scanColumns(this, scan);
+    int numberInteger = scan.numberInteger;
+    int numberIntegerObj = scan.numberIntegerObj;
+    int numberGeneralIntegerObj = scan.numberGeneralIntegerObj;
+    int numberIntegerWeight = scan.numberIntegerWeight;
+    int numberContinuousObj = scan.numberContinuousObj;
+    double cost = scan.cost;
+    largestObj = scan.largestObj;
+    smallestObj = scan.smallestObj;
+    // rhs from fixed columns - kept as needed again below
+    double *fixedRhs = NULL;
+    if (scan.numberFixed) {
+      for (iColumn = 0; iColumn < numberColumns; iColumn++) {
+        if (upper[iColumn] == lower[iColumn]) {
+          CoinBigIndex start = columnStart[iColumn];
+          CoinBigIndex end = start + columnLength[iColumn];
+          for (CoinBigIndex j = start; j < end; j++) {
+            int iRow = row[j];
+            rhs[iRow] += lower[iColumn] * element[j];
           }
         }
       }
+      fixedRhs = CoinCopyOfArray(rhs, numberRows);
     }
     int iType = 0;
     if (!numberContinuousObj && numberIntegerObj <= 5 && numberIntegerWeight <= 100 && numberIntegerObj * 3 < numberObjects_ && !parentModel_ && solver_->getNumRows() > 100)
@@ -781,17 +1051,19 @@ void CbcModel::analyzeObjective()
 
     // But try again
     if (continuousMultiplier < 1.0) {
-      memset(rhs, 0, numberRows * sizeof(double));
+      // continuous which must be integer count as integer
+      char *integral = impliedIntegers(solver_);
+      if (fixedRhs)
+        memcpy(rhs, fixedRhs, numberRows * sizeof(double));
+      else
+        memset(rhs, 0, numberRows * sizeof(double));
       int *count = new int[numberRows];
       memset(count, 0, numberRows * sizeof(int));
       for (iColumn = 0; iColumn < numberColumns; iColumn++) {
         CoinBigIndex start = columnStart[iColumn];
         CoinBigIndex end = start + columnLength[iColumn];
         if (upper[iColumn] == lower[iColumn]) {
-          for (CoinBigIndex j = start; j < end; j++) {
-            int iRow = row[j];
-            rhs[iRow] += lower[iColumn] * element[j];
-          }
+          // already in rhs
         } else if (solver_->isInteger(iColumn)) {
           for (CoinBigIndex j = start; j < end; j++) {
             int iRow = row[j];
@@ -814,7 +1086,7 @@ void CbcModel::analyzeObjective()
       for (iColumn = 0; iColumn < numberColumns; iColumn++) {
         if (upper[iColumn] > lower[iColumn]) {
           double objValue = objective[iColumn] * direction;
-          if (objValue && !solver_->isInteger(iColumn)) {
+          if (objValue && !integral[iColumn]) {
             numberObj++;
             CoinBigIndex start = columnStart[iColumn];
             CoinBigIndex end = start + columnLength[iColumn];
@@ -923,6 +1195,7 @@ void CbcModel::analyzeObjective()
         }
       }
       delete[] count;
+      delete[] integral;
       if (allGood) {
 #if COIN_DEVELOP > 1
         if (numberObj)
@@ -932,6 +1205,7 @@ void CbcModel::analyzeObjective()
       }
     }
     delete[] rhs;
+    delete[] fixedRhs;
   }
   /*
       Take a first scan to see if there are unfixed continuous variables in the
@@ -990,18 +1264,13 @@ void CbcModel::analyzeObjective()
   /*
       If a nontrivial increment is possible, try and figure it out. We're looking
       for gcd(c<j>) for all c<j> that are coefficients of unfixed integer
-      variables. Since the c<j> might not be integers, try and inflate them
-      sufficiently that they look like integers (and we'll deflate the gcd
-      later).
-
-      2520.0 is used as it is a nice multiple of 2,3,5,7
+      variables.  Each c<j> is taken as a fraction p/q (continued fractions)
+      and the gcd of fractions is gcd of numerators over lcm of denominators.
+      Integers are held in doubles so are exact up to 2^53.
     */
   if (possibleMultiple && maximumCost) {
-    int increment = 0;
-    double multiplier = 2520.0;
-    while (10.0 * multiplier * maximumCost < 1.0e8)
-      multiplier *= 10.0;
-    int bigIntegers = 0; // Count of large costs which are integer
+    double numerator = 0.0;
+    double denominator = 1.0;
     for (iColumn = 0; iColumn < numberColumns; iColumn++) {
       if (upper[iColumn] > lower[iColumn] + 1.0e-8) {
         double objValue = fabs(objective[iColumn]);
@@ -1012,25 +1281,27 @@ void CbcModel::analyzeObjective()
             objValue *= coeffMultiplier[iColumn];
         }
         if (objValue) {
-          double value = objValue * multiplier;
-          if (value < 2.1e9) {
-            int nearest = static_cast< int >(floor(value + 0.5));
-            if (fabs(value - floor(value + 0.5)) > 1.0e-8) {
-              increment = 0;
-              break;
-            } else if (!increment) {
-              increment = nearest;
-            } else {
-              increment = gcd(increment, nearest);
-            }
+          double p;
+          double q;
+          if (!rationalValue(objValue, p, q)) {
+            numerator = 0.0;
+            break;
+          } else if (!numerator) {
+            numerator = p;
+            denominator = q;
           } else {
-            // large value - may still be multiple of 1.0
-            if (fabs(objValue - floor(objValue + 0.5)) > 1.0e-8) {
-              increment = 0;
+            double common = (denominator / gcdDouble(denominator, q)) * q;
+            double a = numerator * (common / denominator);
+            double b = p * (common / q);
+            if (common > 1.0e12 || a > 4.0e15 || b > 4.0e15) {
+              numerator = 0.0;
               break;
-            } else {
-              bigIntegers++;
             }
+            numerator = gcdDouble(a, b);
+            denominator = common;
+            double reduce = gcdDouble(numerator, denominator);
+            numerator /= reduce;
+            denominator /= reduce;
           }
         }
       }
@@ -1042,16 +1313,9 @@ void CbcModel::analyzeObjective()
     /*
           If the increment beats the current value for objective change, install it.
         */
-    if (increment) {
-      double value = increment;
+    if (numerator) {
+      double value = (numerator / denominator) * scaleFactor;
       double cutoff = getDblParam(CbcModel::CbcCutoffIncrement);
-      if (bigIntegers) {
-        // allow for 1.0
-        increment = gcd(increment, static_cast< int >(multiplier));
-        value = increment;
-      }
-      value /= multiplier;
-      value *= scaleFactor;
       //trueIncrement=CoinMax(cutoff,value);;
       if (value * 0.999 > cutoff) {
         messageHandler()->message(CBC_INTEGERINCREMENT,
@@ -1059,6 +1323,25 @@ void CbcModel::analyzeObjective()
           << value << CoinMessageEol;
         setDblParam(CbcModel::CbcCutoffIncrement, CoinMax(value * 0.999, value - 1.0e-4));
       }
+      if (scaleFactor == 1.0 && value > 1.0e-6) {
+        /*
+          Objective of integer solutions is then constant (offset and
+          fixed columns) plus a multiple of value so setCutoff can
+          round down to that.
+        */
+        double offset;
+        solver_->getDblParam(OsiObjOffset, offset);
+        double constant = -offset;
+        for (iColumn = 0; iColumn < numberColumns; iColumn++) {
+          if (upper[iColumn] <= lower[iColumn] + 1.0e-8)
+            constant += objective[iColumn] * lower[iColumn];
+        }
+        constant *= solver_->getObjSense();
+        if (fabs(constant) < 1.0e12) {
+          cutoffStep_ = value;
+          cutoffStepOffset_ = constant - floor(constant / value) * value;
+        }
+      }
     }
   }
 
@@ -1561,7 +1844,7 @@ void CbcModel::AddIntegers()
         numberColumns,
         couldBeNetwork ? ", all network" : "");
 #endif
-    findIntegers(true, 2);
+    findIntegers(true, 4);
     convertToDynamic();
   }
 #if CBC_USEFUL_PRINTING > 1
@@ -1617,6 +1900,20 @@ static double lengthConflictCuts = 0.0;
   by the current state of the model,  of the solver, and of the constraint
   system held by the solver.
 */
+// What dominated column search needs (may be on thread)
+typedef struct {
+  OsiSolverInterface *solver;
+  CglStored *storedCuts;
+} CbcDominatedInfo;
+
+static void *doDominated(void *voidInfo)
+{
+  CbcDominatedInfo *info = reinterpret_cast< CbcDominatedInfo * >(voidInfo);
+  CglDuplicateRow dupcuts(info->solver);
+  dupcuts.setMode(2);
+  info->storedCuts = dupcuts.outDuplicates(info->solver);
+  return NULL;
+}
 #if defined(CBC_HAS_OSICPX) && defined(CBC_HAS_CPLEX)
 #include "OsiCpxSolverInterface.hpp"
 #include "cplex.h"
@@ -1883,6 +2180,23 @@ void CbcModel::branchAndBound(int doStatistics)
   CbcEventHandler *eventHandler = getEventHandler();
   if (eventHandler)
     eventHandler->setModel(this);
+  /*
+    Dominated columns and clique information only read the model, so with
+    threads search for dominated columns (on a copy, as it may take out
+    rows) while probing information is built.
+  */
+  CbcDominatedInfo dominatedInfo;
+  dominatedInfo.solver = NULL;
+  dominatedInfo.storedCuts = NULL;
+  CbcThreadPool *dominatedPool = NULL;
+  if ((specialOptions_ & 64) != 0) {
+    if (numberThreads_ > 0 && !parentModel_)
+      dominatedPool = threadPool(1);
+    if (dominatedPool) {
+      dominatedInfo.solver = solver_->clone();
+      dominatedPool->start(doDominated, 1, &dominatedInfo, static_cast< int >(sizeof(CbcDominatedInfo)));
+    }
+  }
 #define CLIQUE_ANALYSIS
 #ifdef CLIQUE_ANALYSIS
   // set up for probing
@@ -1897,9 +2211,14 @@ void CbcModel::branchAndBound(int doStatistics)
 
   // Try for dominated columns
   if ((specialOptions_ & 64) != 0) {
-    CglDuplicateRow dupcuts(solver_);
-    dupcuts.setMode(2);
-    CglStored *storedCuts = dupcuts.outDuplicates(solver_);
+    if (dominatedPool) {
+      dominatedPool->wait();
+      delete dominatedInfo.solver;
+    } else {
+      dominatedInfo.solver = solver_;
+      doDominated(&dominatedInfo);
+    }
+    CglStored *storedCuts = dominatedInfo.storedCuts;
     if (storedCuts) {
       COIN_DETAIL_PRINT(printf("adding dup cuts\n"));
       addCutGenerator(storedCuts, 1, "StoredCuts from dominated",
@@ -1956,16 +2275,40 @@ void CbcModel::branchAndBound(int doStatistics)
   status_ = 0;
   secondaryStatus_ = 0;
   phase_ = 0;
+  if (pricer_) {
+    // LPs of children or nodes on threads are not priced so can not fathom
+    numberStrong_ = 0;
+    numberThreads_ = 0;
+  }
+  if (phaseTimes_)
+    phaseTimes_->clear();
+  memset(&lastProgress_, 0, sizeof(CbcProgressRecord));
+  lastPeerExchange_ = 0.0;
+  delete[] rootReducedCost_;
+  rootReducedCost_ = NULL;
+  deleteShadowCache();
+#ifdef CBC_HAS_CLP
+  restoreDualPricing(dynamic_cast< OsiClpSolverInterface * >(solver_));
+#else
+  restoreDualPricing(NULL);
+#endif
+  resetResolveAlgorithm();
+  if (implicationGraph_ && !implicationGraph_->finished())
+    implicationGraph_->finish();
+  globalFixCutoff_ = COIN_DBL_MAX;
   /*
       Scan the variables, noting the integer variables. Create an
       CbcSimpleInteger object for each integer variable.
     */
-  findIntegers(false);
+  findIntegers(false, numberBeforeTrust_ ? 3 : 0);
   // Say not dynamic pseudo costs
   ownership_ &= ~0x40000000;
   // If dynamic pseudo costs then do
   if (numberBeforeTrust_)
     convertToDynamic();
+  // Pseudocosts from an earlier solve
+  if (pseudoCostStartNames_.size())
+    usePseudoCostStart();
   // Set up char array to say if integer (speed)
   delete[] integerInfo_;
   {
@@ -2085,9 +2428,45 @@ void CbcModel::branchAndBound(int doStatistics)
 	moreSpecialOptions2_ |= 65536; // lazy constraints
     }
   }
+  // first feasible soon (CbcFirstFeasible)
+  bool firstFeasible = intParam_[CbcFirstFeasible] && !parentModel_ && numberIntegers_;
+  bool rootStopped = false;
   // If NLP then we assume already solved outside branchAndbound
   if (!solverCharacteristics_->solverType() || solverCharacteristics_->solverType() == 4) {
-    feasible = resolve(NULL, 0) != 0;
+    int saveStartup = intParam_[CbcStartupHeuristics];
+#ifdef CBC_HAS_CLP
+    OsiClpSolverInterface *clpSolver
+      = dynamic_cast< OsiClpSolverInterface * >(solver_);
+#endif
+    if (firstFeasible) {
+      // race heuristics needing no LP first
+      if (!saveStartup)
+        intParam_[CbcStartupHeuristics] = numberThreads_ ? 3 : 1;
+#ifdef CBC_HAS_CLP
+      // root LP stops at deadline
+      if (clpSolver && dblParam_[CbcMaximumSeconds] < 1.0e10) {
+        double timeLeft = CoinMax(dblParam_[CbcMaximumSeconds] - getCurrentSeconds(), 0.0);
+        if (!useElapsedTime())
+          clpSolver->getModelPtr()->setMaximumSeconds(timeLeft);
+        else
+          clpSolver->getModelPtr()->setMaximumWallSeconds(timeLeft);
+      }
+#endif
+    }
+    if (intParam_[CbcStartupHeuristics] && !parentModel_ && numberIntegers_)
+      feasible = resolveWithStartupHeuristics();
+    else
+      feasible = resolve(NULL, 0) != 0;
+    intParam_[CbcStartupHeuristics] = saveStartup;
+    if (firstFeasible) {
+#ifdef CBC_HAS_CLP
+      if (clpSolver) {
+        clpSolver->getModelPtr()->setMaximumSeconds(1.0e50);
+        clpSolver->getModelPtr()->setMaximumWallSeconds(1.0e50);
+      }
+#endif
+      rootStopped = !feasible && solver_->isIterationLimitReached();
+    }
   } else {
     // pick up given status
     feasible = (solver_->isProvenOptimal() && !solver_->isDualObjectiveLimitReached());
@@ -2096,13 +2475,31 @@ void CbcModel::branchAndBound(int doStatistics)
     feasible = false; // pretend infeasible
   }
   numberSavedSolutions_ = 0;
+  savedHash_.clear();
   int saveNumberStrong = numberStrong_;
   int saveNumberBeforeTrust = numberBeforeTrust_;
   /*
       If the linear relaxation of the root is infeasible, bail out now. Otherwise,
       continue with processing the root node.
     */
-  if (!feasible) {
+  if (rootStopped) {
+    // root LP not finished by deadline - any solution is best so far
+    status_ = 1;
+    secondaryStatus_ = 4;
+    handler_->message(CBC_MAXTIME, messages_) << CoinMessageEol;
+    originalContinuousObjective_ = -COIN_DBL_MAX;
+    if (bestSolution_) {
+      char general[200];
+      sprintf(general, "Solution of %g found before root LP finished",
+        bestObjective_);
+      messageHandler()->message(CBC_GENERAL, messages())
+        << general << CoinMessageEol;
+    }
+    solverCharacteristics_ = NULL;
+    if (flipObjective)
+      flipModel();
+    return;
+  } else if (!feasible) {
     status_ = 0;
     if (!solver_->isProvenDualInfeasible()) {
       handler_->message(CBC_INFEAS, messages_) << CoinMessageEol;
@@ -2384,7 +2781,7 @@ void CbcModel::branchAndBound(int doStatistics)
     */
   delete continuousSolver_;
   continuousSolver_ = solver_->clone();
-#ifdef CONFLICT_CUTS
+  // rays wanted for conflict analysis (CbcConflictAnalysis or CONFLICT_CUTS)
   if ((moreSpecialOptions_ & 4194304) != 0) {
 #ifdef CBC_HAS_CLP
     OsiClpSolverInterface *clpSolver
@@ -2397,28 +2794,19 @@ void CbcModel::branchAndBound(int doStatistics)
       else
         clpSolver->getModelPtr()->setSpecialOptions(specialOptions & ~(32 | 2097152));
     }
-  }
-#endif
 #endif
+  }
 #ifdef CBC_HAS_NAUTY
   // maybe allow on fix and restart later
   if ((moreSpecialOptions2_ & (128 | 256)) != 0) {
     if ((specialOptions_&2048)==0) {
-      symmetryInfo_ = new CbcSymmetry();
-      symmetryInfo_->setupSymmetry(this);
-      int numberGenerators = symmetryInfo_->statsOrbits(this, 0);
-      if (!symmetryInfo_->numberUsefulOrbits() && (moreSpecialOptions2_ & (128 | 256)) != (128 | 256)) {
-	delete symmetryInfo_;
-	symmetryInfo_ = NULL;
-	moreSpecialOptions2_ &= ~(128 | 256 | 131072);
-      }
-      if ((moreSpecialOptions2_ & (128 | 256)) == (128 | 256)) {
-	if ((moreSpecialOptions2_&131072) != 0) {
-	  // keep it simple
-	  moreSpecialOptions2_ &= ~(128 | 256);
-	  rootSymmetryInfo_ = symmetryInfo_;
-	  symmetryInfo_ = NULL;
-	}
+      // on thread while root solved if wanted
+      if (!intParam_[CbcAsyncSymmetry] || parentModel_ || !startSymmetryDetection()) {
+        symmetryInfo_ = new CbcSymmetry();
+        if (dblParam_[CbcSymmetryTimeLimit] > 0.0)
+          symmetryInfo_->setMaximumTime(dblParam_[CbcSymmetryTimeLimit]);
+        symmetryInfo_->setupSymmetry(this);
+        adoptSymmetry();
       }
     } else {
       // small B&B
@@ -2541,6 +2929,8 @@ void CbcModel::branchAndBound(int doStatistics)
   delete[] lastNodeInfo_;
   lastNodeInfo_ = new CbcNodeInfo *[maximumDepth_];
   memset(lastNodeInfo_,0,maximumDepth_*sizeof(CbcNodeInfo*));
+  if (boundTrail_)
+    boundTrail_->invalidate();
   delete[] lastNumberCuts_;
   lastNumberCuts_ = new int[maximumDepth_];
   memset(lastNumberCuts_,0,maximumDepth_*sizeof(int));
@@ -2610,6 +3000,30 @@ void CbcModel::branchAndBound(int doStatistics)
   maximumStatistics_ = 0;
   maximumDepthActual_ = 0;
   numberDJFixed_ = 0.0;
+  // subproblems solved (CbcDuplicateNodes) - keys are of bounds so not
+  // if objects branch on cuts
+  delete processedNodes_;
+  processedNodes_ = NULL;
+  numberDuplicateNodes_ = 0;
+  if (intParam_[CbcDuplicateNodes] > 0 && !numberThreads_) {
+    bool possible = true;
+    for (int i = 0; i < numberObjects_; i++) {
+      if (dynamic_cast< CbcBranchCut * >(object_[i])) {
+        possible = false;
+        break;
+      }
+    }
+    if (possible)
+      processedNodes_ = new std::set< std::pair< CoinUInt64, CoinUInt64 > >;
+  }
+  // factorizations of node LPs (CbcFactorizationMemory)
+  delete factorizationCache_;
+  factorizationCache_ = NULL;
+#ifdef CBC_HAS_CLP
+  if (intParam_[CbcFactorizationMemory] > 0 && !numberThreads_
+    && dynamic_cast< OsiClpSolverInterface * >(solver_))
+    factorizationCache_ = new CbcFactorizationCache(intParam_[CbcFactorizationMemory] * 1048576.0);
+#endif
   if (!parentModel_) {
     if ((specialOptions_ & 262144) != 0) {
       // create empty stored cuts
@@ -2687,6 +3101,8 @@ void CbcModel::branchAndBound(int doStatistics)
     }
 #endif
     int otherOptions = (multipleRootTries_ / 10000) % 100;
+    // racing copies search some nodes
+    int raceNodes = otherOptions ? 0 : CoinMax(intParam_[CbcRootRaceNodes], 0);
     rootModels = new CbcModel *[numberModels];
     int newSeed = randomSeed_;
     if (newSeed == 0) {
@@ -2708,7 +3124,7 @@ void CbcModel::branchAndBound(int doStatistics)
     for (int i = 0; i < numberModels; i++) {
       rootModels[i] = new CbcModel(*this);
       rootModels[i]->setNumberThreads(0);
-      rootModels[i]->setMaximumNodes(otherOptions ? -1 : 0);
+      rootModels[i]->setMaximumNodes(otherOptions ? -1 : raceNodes);
       rootModels[i]->setRandomSeed(newSeed + 10000000 * i);
       rootModels[i]->randomNumberGenerator()->setSeed(newSeed + 50000000 * i);
       rootModels[i]->setMultipleRootTries(0);
@@ -2790,29 +3206,23 @@ void CbcModel::branchAndBound(int doStatistics)
 #endif
       for (int iModel = 0; iModel < numberModels; iModel++) {
         doRootCbcThread(rootModels[iModel]);
-        // see if solved at root node
-        if (rootModels[iModel]->getMaximumNodes()) {
+        // see if solved at root node (or in race)
+        if (raceNodes ? !rootModels[iModel]->status() : rootModels[iModel]->getMaximumNodes() != 0) {
           feasible = false;
           break;
         }
       }
 #ifdef CBC_THREAD
     } else {
-      Coin_pthread_t *threadId = new Coin_pthread_t[numberRootThreads];
+      CbcThreadPool *pool = threadPool(numberRootThreads);
       for (int kModel = 0; kModel < numberModels; kModel += numberRootThreads) {
         bool finished = false;
-        for (int iModel = kModel; iModel < CoinMin(numberModels, kModel + numberRootThreads); iModel++) {
-          pthread_create(&(threadId[iModel - kModel].thr), NULL,
-            doRootCbcThread,
-            rootModels[iModel]);
-        }
-        // wait
-        for (int iModel = kModel; iModel < CoinMin(numberModels, kModel + numberRootThreads); iModel++) {
-          pthread_join(threadId[iModel - kModel].thr, NULL);
-        }
+        pool->run(doRootCbcThreadInPool,
+          CoinMin(numberModels, kModel + numberRootThreads) - kModel,
+          rootModels + kModel, static_cast< int >(sizeof(CbcModel *)));
         // see if solved at root node
         for (int iModel = kModel; iModel < CoinMin(numberModels, kModel + numberRootThreads); iModel++) {
-          if (rootModels[iModel]->getMaximumNodes())
+          if (raceNodes ? !rootModels[iModel]->status() : rootModels[iModel]->getMaximumNodes() != 0)
             finished = true;
         }
         if (finished) {
@@ -2820,7 +3230,6 @@ void CbcModel::branchAndBound(int doStatistics)
           break;
         }
       }
-      delete[] threadId;
     }
 #endif
     // sort solutions
@@ -2833,7 +3242,7 @@ void CbcModel::branchAndBound(int doStatistics)
         value[numberSolutions++] = -rootModels[iModel]->getMinimizationObjValue();
       }
     }
-    char general[100];
+    char general[200];
     rootTimeCpu = CoinCpuTime() - rootTimeCpu;
     if (numberRootThreads == 1)
       sprintf(general, "Multiple root solvers took a total of %.2f seconds\n",
@@ -2860,9 +3269,79 @@ void CbcModel::branchAndBound(int doStatistics)
     lastHeuristic_ = NULL;
     delete[] which;
     delete[] value;
+    if (raceNodes && feasible) {
+      // adopt pseudocosts and global cuts of copy with best bound
+      int iBest = 0;
+      for (int iModel = 1; iModel < numberModels; iModel++) {
+        if (rootModels[iModel]->bestPossibleObjective_ > rootModels[iBest]->bestPossibleObjective_ + 1.0e-7)
+          iBest = iModel;
+      }
+      CbcModel *winner = rootModels[iBest];
+      if (winner->numberObjects_ == numberObjects_) {
+        for (int i = 0; i < numberObjects_; i++) {
+          CbcSimpleIntegerDynamicPseudoCost *obj = dynamic_cast< CbcSimpleIntegerDynamicPseudoCost * >(object_[i]);
+          const CbcSimpleIntegerDynamicPseudoCost *otherObj = dynamic_cast< const CbcSimpleIntegerDynamicPseudoCost * >(winner->object_[i]);
+          if (obj && otherObj && obj->columnNumber() == otherObj->columnNumber())
+            obj->copySome(otherObj);
+        }
+      }
+      int numberGlobalBefore = globalCuts_.sizeRowCuts();
+      for (int i = 0; i < winner->globalCuts_.sizeRowCuts(); i++)
+        globalCuts_.addCutIfNotDuplicate(*winner->globalCuts_.rowCutPtr(i));
+      sprintf(general, "Race won by root solver %d after %d nodes (bound %g), %d global cuts adopted",
+        iBest, winner->getNodeCount(), winner->bestPossibleObjective_,
+        globalCuts_.sizeRowCuts() - numberGlobalBefore);
+      messageHandler()->message(CBC_GENERAL,
+        messages())
+        << general << CoinMessageEol;
+    }
   }
-  // Do heuristics
-  if (numberObjects_ && !rootModels)
+  // Resuming from checkpoint - solutions, cuts and pseudocosts
+  {
+    int numberResume = 0;
+    for (int i = 0; i < static_cast< int >(resumeCheckpoints_.size()); i++) {
+      if (resumeCheckpoints_[i]->restoreStart(this)) {
+        resumeCheckpoints_[numberResume++] = resumeCheckpoints_[i];
+      } else {
+        messageHandler()->message(CBC_GENERAL, messages())
+          << "Checkpoint is not of this problem - not used" << CoinMessageEol;
+        delete resumeCheckpoints_[i];
+      }
+    }
+    resumeCheckpoints_.resize(numberResume);
+  }
+  bool resuming = resumeCheckpoints_.size() > 0;
+  // cuts of earlier solves of same structure (setCutDatabaseFile)
+  delete cutDatabase_;
+  cutDatabase_ = NULL;
+  bool usedCutDatabase = false;
+  if (cutDatabaseFile_.size() && !parentModel_ && !resuming && numberCutGenerators_
+    && !solverCharacteristics_->solutionAddsCuts() && (moreSpecialOptions2_ & 65536) == 0) {
+    cutDatabase_ = new CbcCutDatabase();
+    cutDatabase_->setProblem(solver_, originalColumns_);
+    OsiCuts databaseCuts;
+    int numberCuts = cutDatabase_->load(cutDatabaseFile_.c_str(), getCutoff(), databaseCuts);
+    if (numberCuts) {
+      int numberGlobalBefore = globalCuts_.sizeRowCuts();
+      for (int i = 0; i < numberCuts; i++)
+        globalCuts_.addCutIfNotDuplicate(*databaseCuts.rowCutPtr(i));
+      char general[200];
+      sprintf(general, "%d cuts taken from cut database - %d new global cuts",
+        numberCuts, globalCuts_.sizeRowCuts() - numberGlobalBefore);
+      messageHandler()->message(CBC_GENERAL, messages())
+        << general << CoinMessageEol;
+      // this solve adds nothing to file
+      usedCutDatabase = true;
+      delete cutDatabase_;
+      cutDatabase_ = NULL;
+    }
+  }
+  // quick dive before slower heuristics and cuts (CbcFirstFeasible)
+  if (firstFeasible && !bestSolution_ && numberObjects_ && !rootModels && !resuming
+    && !maximumSecondsReached())
+    quickDive();
+  // Do heuristics (on threads while cuts done if wanted)
+  if (numberObjects_ && !rootModels && !resuming && !startRootHeuristics())
     doHeuristicsAtRoot();
   if (solverCharacteristics_->solutionAddsCuts()) {
     // With some heuristics solver needs a resolve here
@@ -2919,7 +3398,7 @@ void CbcModel::branchAndBound(int doStatistics)
         numberIntegers2++;
     }
     if (numberIntegers1 < numberIntegers2) {
-      findIntegers(true, 2);
+      findIntegers(true, 4);
       convertToDynamic();
     }
   }
@@ -2961,7 +3440,8 @@ void CbcModel::branchAndBound(int doStatistics)
   }
   // replace solverType
   double *tightBounds = NULL;
-  if (solverCharacteristics_->tryCuts()) {
+  // no root cuts if resuming (global cuts restored)
+  if (solverCharacteristics_->tryCuts() && !resuming) {
 
     if (numberUnsatisfied) {
       // User event
@@ -2983,7 +3463,8 @@ void CbcModel::branchAndBound(int doStatistics)
           int numberRows = continuousSolver_->getNumRows();
           int maxCuts = 0;
           for (int i = 0; i < numberModels; i++) {
-            solvers[i] = rootModels[i]->solver();
+            // racing copies kept their root
+            solvers[i] = rootModels[i]->raceRootSolver_ ? rootModels[i]->raceRootSolver_ : rootModels[i]->solver();
             const double *lower = solvers[i]->getColLower();
             const double *upper = solvers[i]->getColUpper();
             for (int j = 0; j < numberColumns; j++) {
@@ -3165,9 +3646,32 @@ void CbcModel::branchAndBound(int doStatistics)
             }
           }
         }
-        if (feasible)
-          feasible = solveWithCuts(cuts, maximumCutPassesAtRoot_,
-            NULL);
+        if (feasible) {
+          // cuts can wait until there is a solution (CbcFirstFeasible)
+          int numberPasses = maximumCutPassesAtRoot_;
+          if (firstFeasible && !bestSolution_ && CoinAbs(numberPasses) > 1)
+            numberPasses = numberPasses > 0 ? 1 : -1;
+          // most cuts already there (setCutDatabaseFile)
+          if (usedCutDatabase && CoinAbs(numberPasses) > CBC_CUT_DATABASE_PASSES)
+            numberPasses = numberPasses > 0 ? CBC_CUT_DATABASE_PASSES : -CBC_CUT_DATABASE_PASSES;
+          feasible = solveWithCuts(cuts, numberPasses, NULL);
+        }
+        // Take any solutions from heuristics run while cuts done
+        finishRootHeuristics();
+        // root cuts for cut database
+        if (cutDatabase_ && feasible) {
+          const CoinPackedMatrix *rowCopy = solver_->getMatrixByRow();
+          const double *rowLower = solver_->getRowLower();
+          const double *rowUpper = solver_->getRowUpper();
+          double cutoff = getCutoff();
+          for (int iRow = numberRowsAtContinuous_; iRow < solver_->getNumRows(); iRow++) {
+            OsiRowCut cut;
+            cut.setRow(rowCopy->getVector(iRow));
+            cut.setLb(rowLower[iRow]);
+            cut.setUb(rowUpper[iRow]);
+            cutDatabase_->addCut(cut, cutoff);
+          }
+        }
         if (multipleRootTries_ && (moreSpecialOptions_ & 134217728) != 0) {
           FILE *fp = NULL;
           size_t nRead;
@@ -3414,6 +3918,14 @@ void CbcModel::branchAndBound(int doStatistics)
   // check extra info on feasibility
   if (!solverCharacteristics_->mipFeasible())
     feasible = false;
+  // orbits may have arrived while root done
+  pollSymmetryDetection(false);
+  // racing root copy - keep root for model which started race
+  if (feasible && (specialOptions_ & 8388608) != 0 && intParam_[CbcRootRaceNodes] > 0
+    && getMaximumNodes() > 0) {
+    delete raceRootSolver_;
+    raceRootSolver_ = solver_->clone();
+  }
   // If max nodes==0 - don't do strong branching
   if (!getMaximumNodes()) {
     if (feasible)
@@ -3630,7 +4142,7 @@ void CbcModel::branchAndBound(int doStatistics)
 #endif
   // Save copy of solver
   OsiSolverInterface *saveSolver = NULL;
-  if (!parentModel_ && (specialOptions_ & (512 + 32768)) != 0)
+  if (!parentModel_ && ((specialOptions_ & (512 + 32768)) != 0 || intParam_[CbcRestartFixedPercent] > 0))
     saveSolver = solver_->clone();
   else if (parentModel_ &&
 	   !(specialOptions_&2048) &&
@@ -3650,6 +4162,9 @@ void CbcModel::branchAndBound(int doStatistics)
       flipModel();
     return;
   }
+  // keep root reduced costs so later incumbents fix globally
+  if (feasible && !parentModel_)
+    saveRootReducedCosts();
   /*
       We've taken the continuous relaxation as far as we can. Time to branch.
       The first order of business is to actually create a node. chooseBranch
@@ -4151,6 +4666,9 @@ void CbcModel::branchAndBound(int doStatistics)
         }
       }
       if (probingInfo_->packDown()) {
+        // as bounds at nodes as well as cuts
+        if (intParam_[CbcNodePropagation] || implicationGraph_)
+          addProbingImplications();
 #if CBC_USEFUL_PRINTING > 1
         printf("%d implications on %d 0-1\n", toZero[number01], number01);
 #endif
@@ -4235,14 +4753,30 @@ void CbcModel::branchAndBound(int doStatistics)
 
       initializeInfo sets the reference counts in the nodeInfo object.  Since
       this node is still live, push it onto the heap that holds the live set.
+      If resuming from a checkpoint the root is only kept for its bounds and
+      the nodes of the checkpoint go on the heap instead.
     */
+  CbcNode *resumeRoot = NULL;
   if (newNode) {
     if (newNode->branchingObject()) {
       newNode->initializeInfo();
-      tree_->push(newNode);
+      if (resuming)
+        resumeRoot = newNode;
+      else
+        tree_->push(newNode);
       // save pointer to root node - so can pick up bounds
       if (!topOfTree_)
         topOfTree_ = dynamic_cast< CbcFullNodeInfo * >(newNode->nodeInfo());
+      if (nodeTrace_) {
+        CbcNodeTrace::Record record;
+        CbcNodeTrace::initialize(record);
+        record.time = getCurrentSeconds();
+        record.objective = newNode->objectiveValue();
+        record.iterations = numberIterations_;
+        record.numberUnsatisfied = newNode->numberUnsatisfied();
+        record.outcome = CbcNodeTrace::branched;
+        newNode->nodeInfo()->setTraceId(nodeTrace_->add(record));
+      }
       if (statistics_) {
         if (numberNodes2_ == maximumStatistics_) {
           maximumStatistics_ = 2 * maximumStatistics_;
@@ -4264,7 +4798,7 @@ void CbcModel::branchAndBound(int doStatistics)
       double objectiveValue = newNode->objectiveValue();
       setBestSolution(CBC_SOLUTION, objectiveValue,
         solver_->getColSolution());
-      if (eventHandler) {
+      if (eventHandler && eventHandler->wanted(CbcEventHandler::solution)) {
         // we are stopping anyway so no need to test return code
         eventHandler->event(CbcEventHandler::solution);
       }
@@ -4279,15 +4813,67 @@ void CbcModel::branchAndBound(int doStatistics)
     */
   numberLongStrong_ = 0;
   CbcNode *createdNode = NULL;
+  if (resumeRoot) {
+    // nodes and counts of all checkpoints (parts of one search)
+    int numberRestored = 0;
+    int numberSaved = 0;
+    numberNodes_ = 0;
+    for (int i = 0; i < static_cast< int >(resumeCheckpoints_.size()); i++) {
+      const CbcCheckpoint *checkpoint = resumeCheckpoints_[i];
+      numberRestored += checkpoint->restoreNodes(this);
+      numberSaved += checkpoint->numberNodesOnTree();
+      numberNodes_ += checkpoint->numberNodes();
+      numberIterations_ += checkpoint->numberIterations();
+      numberSolutions_ = CoinMax(numberSolutions_, checkpoint->numberSolutions());
+    }
+    char general[200];
+    sprintf(general, "Resumed from %d checkpoint(s) with %d nodes (of %d) after %d nodes",
+      static_cast< int >(resumeCheckpoints_.size()), numberRestored, numberSaved, numberNodes_);
+    messageHandler()->message(CBC_GENERAL, messages())
+      << general << CoinMessageEol;
+  }
+  clearCheckpoints();
+  // In case root heuristics still running
+  finishRootHeuristics();
 #ifdef CBC_THREAD
   if ((specialOptions_ & 2048) != 0)
     numberThreads_ = 0;
+  // threads used for cuts at nodes rather than for tree search
+  treeCutThreads_ = 0;
+  if (numberThreads_ && intParam_[CbcParallelTreeCuts] && !parentModel_) {
+    treeCutThreads_ = numberThreads_;
+    numberThreads_ = 0;
+  }
+  /*
+    Ramp up - nodes are done serially in best bound order until there are
+    CbcRampUpNodes for each thread, then threads start on them.  With
+    deterministic parallel the nodes are done before the first split.
+  */
+  int rampUpThreads = 0;
+  int rampUpTarget = CoinMax(numberThreads_, 8);
+  CbcCompareObjective rampUpCompare;
+  bool rampUpCompareSet = false;
   if (numberThreads_) {
     nodeCompare_->sayThreaded(); // need to use addresses
-    master_ = new CbcBaseModel(*this,
-      (parallelMode() < -1) ? 1 : 0);
-    masterThread_ = master_->masterThread();
-  }
+    if (intParam_[CbcRampUpNodes] > 0 && !parentModel_) {
+      rampUpTarget = CoinMax(rampUpTarget, numberThreads_ * intParam_[CbcRampUpNodes]);
+      tree_->setComparison(rampUpCompare);
+      rampUpCompareSet = true;
+      if (parallelMode() > 0)
+        rampUpThreads = numberThreads_;
+    }
+    if (!rampUpThreads) {
+      master_ = new CbcBaseModel(*this,
+        (parallelMode() < -1) ? 1 : 0);
+      masterThread_ = master_->masterThread();
+    }
+  }
+  // dives together and heuristics on background thread if tree search serial
+  startDivePortfolio();
+  startTreeHeuristics();
+  // serial until ramped up
+  if (rampUpThreads)
+    numberThreads_ = 0;
 #endif
 #ifdef CBC_HAS_CLP
   {
@@ -4357,8 +4943,9 @@ void CbcModel::branchAndBound(int doStatistics)
   while (true) {
     lockThread();
 #ifdef CBC_HAS_CLP
-    // See if we want dantzig row choice
-    goToDantzig(100, savePivotMethod);
+    // See if we want dantzig row choice (otherwise done in resolve)
+    if ((threadMode_ & 1) != 0)
+      goToDantzig(100, savePivotMethod);
 #endif
     //#define REPORT_DYNAMIC 2
 #if REPORT_DYNAMIC
@@ -4485,6 +5072,8 @@ void CbcModel::branchAndBound(int doStatistics)
     if (numberNodes_ >= nextCheckRestart) {
       if (nextCheckRestart < 100)
         nextCheckRestart = 100;
+      else if (nextCheckRestart < 1000 && intParam_[CbcRestartFixedPercent] > 0)
+        nextCheckRestart = 1000;
       else
         nextCheckRestart = COIN_INT_MAX;
 #ifdef CBC_HAS_CLP
@@ -4510,9 +5099,34 @@ void CbcModel::branchAndBound(int doStatistics)
       /*
               Decide if we want to do a restart.
             */
-      if (saveSolver && (specialOptions_ & (512 + 32768)) != 0) {
-        bool tryNewSearch = solverCharacteristics_->reducedCostsAccurate() && (getCutoff() < 1.0e20 && getCutoff() < checkCutoffForRestart);
+      int restartPercent = intParam_[CbcRestartFixedPercent];
+      if (saveSolver && ((specialOptions_ & (512 + 32768)) != 0 || restartPercent > 0)) {
+        bool reducedCostFixing = solverCharacteristics_->reducedCostsAccurate() && (getCutoff() < 1.0e20 && getCutoff() < checkCutoffForRestart);
+        bool tryNewSearch = reducedCostFixing;
         int numberColumns = getNumCols();
+        if (restartPercent > 0 && topOfTree_) {
+          // bounds tightened at root since copy was taken are global
+          const double *globalLower = topOfTree_->lower();
+          const double *globalUpper = topOfTree_->upper();
+          const double *lower = saveSolver->getColLower();
+          const double *upper = saveSolver->getColUpper();
+          int numberNewlyFixed = 0;
+          for (int i = 0; i < numberIntegers_; i++) {
+            int iColumn = integerVariable_[i];
+            double lo = CoinMax(lower[iColumn], globalLower[iColumn]);
+            double up = CoinMin(upper[iColumn], globalUpper[iColumn]);
+            if (lo > up)
+              continue; // leave to search
+            if (lo == up && lower[iColumn] < upper[iColumn])
+              numberNewlyFixed++;
+            if (lo > lower[iColumn])
+              saveSolver->setColLower(iColumn, lo);
+            if (up < upper[iColumn])
+              saveSolver->setColUpper(iColumn, up);
+          }
+          if (numberNewlyFixed)
+            tryNewSearch = true;
+        }
         if (tryNewSearch) {
           // adding increment back allows current best - tiny bit weaker
           checkCutoffForRestart = getCutoff() + getCutoffIncrement();
@@ -4521,6 +5135,8 @@ void CbcModel::branchAndBound(int doStatistics)
             numberNodes_, getCutoff());
 #endif
           saveSolver->resolve();
+          if (!saveSolver->isProvenOptimal())
+            reducedCostFixing = false;
           double direction = saveSolver->getObjSense();
           double gap = checkCutoffForRestart - saveSolver->getObjValue() * direction;
           double tolerance;
@@ -4544,7 +5160,9 @@ void CbcModel::branchAndBound(int doStatistics)
             int iColumn = integerVariable_[i];
             double djValue = direction * reducedCost[iColumn];
             if (upper[iColumn] - lower[iColumn] > integerTolerance) {
-              if (solution[iColumn] < lower[iColumn] + integerTolerance && djValue > gap) {
+              if (!reducedCostFixing) {
+                // only fixings from bounds
+              } else if (solution[iColumn] < lower[iColumn] + integerTolerance && djValue > gap) {
                 //printf("%d to lb on dj of %g - bounds %g %g\n",
                 //     iColumn,djValue,lower[iColumn],upper[iColumn]);
                 saveSolver->setColUpper(iColumn, lower[iColumn]);
@@ -4590,8 +5208,12 @@ void CbcModel::branchAndBound(int doStatistics)
             numberFixed + numberFixed2, numberFixed2);
 #endif
           numberFixed += numberFixed2;
-          if (numberFixed * 10 < numberColumns && numberFixed * 4 < numberIntegers_)
+          if (restartPercent > 0) {
+            if (numberFixed * 100 < restartPercent * numberIntegers_)
+              tryNewSearch = false;
+          } else if (numberFixed * 10 < numberColumns && numberFixed * 4 < numberIntegers_) {
             tryNewSearch = false;
+          }
         }
 	// check for odd cuts
 	{
@@ -4641,10 +5263,15 @@ void CbcModel::branchAndBound(int doStatistics)
             printf("%d rows added ZZZZZ\n",
               solver_->getNumRows() - continuousSolver_->getNumRows());
 #endif
+          // new search takes global cuts and pseudocosts
+          int saveInherit = intParam_[CbcSubMipInherit];
+          if (restartPercent > 0)
+            intParam_[CbcSubMipInherit] |= 3;
           int returnCode = heuristic.smallBranchAndBound(saveSolver,
             -1, newSolution,
             objectiveValue,
             checkCutoffForRestart, "Reduce");
+          intParam_[CbcSubMipInherit] = saveInherit;
           if (returnCode < 0) {
 #ifdef COIN_DEVELOP
             printf("Restart - not small enough to do search after fixing\n");
@@ -4762,7 +5389,7 @@ void CbcModel::branchAndBound(int doStatistics)
           numberFixedNow_ = n;
         }
       }
-      if (eventHandler) {
+      if (eventHandler && eventHandler->wanted(CbcEventHandler::solution)) {
         if (!eventHandler->event(CbcEventHandler::solution)) {
           eventHappened_ = true; // exit
         }
@@ -4793,8 +5420,9 @@ void CbcModel::branchAndBound(int doStatistics)
     if (numberNodes_ >= lastEvery1000) {
       lockThread();
 #ifdef CBC_HAS_CLP
-      // See if we want dantzig row choice
-      goToDantzig(1000, savePivotMethod);
+      // See if we want dantzig row choice (otherwise done in resolve)
+      if ((threadMode_ & 1) != 0)
+        goToDantzig(1000, savePivotMethod);
 #endif
       if ((specialOptions_&2048)==0 || true) {
 	if (numberNodes_ < 100)
@@ -4910,11 +5538,50 @@ void CbcModel::branchAndBound(int doStatistics)
         lastNumberConflictCuts = numberConflictCuts;
       }
 #endif
-      if (eventHandler && !eventHandler->event(CbcEventHandler::treeStatus)) {
+      if (handler_->logLevel() > 1) {
+        double bytes[CbcLastMemoryType];
+        lockThread();
+        memoryUsage(bytes);
+        unlockThread();
+        double megaBytes = 1.0 / (1024.0 * 1024.0);
+        messageHandler()->message(CBC_MEMORY, messages())
+          << bytes[CbcMemoryTotal] * megaBytes << memoryHighWater_ * megaBytes
+          << bytes[CbcMemoryNodes] * megaBytes << bytes[CbcMemoryNodeInfo] * megaBytes
+          << bytes[CbcMemoryWarmStart] * megaBytes << bytes[CbcMemoryNodeCuts] * megaBytes
+          << bytes[CbcMemoryGlobalCuts] * megaBytes << bytes[CbcMemoryGenerators] * megaBytes
+          << bytes[CbcMemorySolutions] * megaBytes << bytes[CbcMemorySolvers] * megaBytes
+          << bytes[CbcMemoryThreads] * megaBytes
+          << CoinMessageEol;
+      }
+#ifdef CBC_THREAD
+      if (master_ && handler_->logLevel() > 1)
+        master_->logThreadStatistics();
+#endif
+      if (eventHandler && eventHandler->wanted(CbcEventHandler::treeStatus)
+        && !eventHandler->event(CbcEventHandler::treeStatus)) {
         eventHappened_ = true; // exit
       }
       lastSecPrintProgress_ = CoinWallclockTime();
     }
+    if (progressInterval_ > 0.0 && !parentModel_
+      && getCurrentSeconds() >= lastProgress_.time + progressInterval_)
+      reportProgress();
+    if (checkpoint_ && !parentModel_
+      && (checkpointRequested_ || checkpoint_->due(getCurrentSeconds())))
+      takeCheckpoint();
+    if (peerExchange_ && !parentModel_
+      && getCurrentSeconds() >= lastPeerExchange_ + peerInterval_) {
+      lastPeerExchange_ = getCurrentSeconds();
+      lockThread();
+      peerExchange_->poll(this);
+      peerExchange_->publish(this);
+      unlockThread();
+    }
+    if (rootReducedCost_ && getCutoff() < globalFixCutoff_) {
+      lockThread();
+      globalReducedCostFix();
+      unlockThread();
+    }
     // See if can stop on gap
     if (canStopOnGap()) {
       stoppedOnGap_ = true;
@@ -4934,8 +5601,32 @@ void CbcModel::branchAndBound(int doStatistics)
         */
     CbcNode *node = NULL;
 #ifdef CBC_THREAD
+    if (rampUpThreads && (tree_->size() >= rampUpTarget || numberNodes_ >= 20 * rampUpTarget)) {
+      // ramped up - threads take over with usual comparison
+      tree_->setComparison(*nodeCompare_);
+      // so thread copies start from continuous rows
+      int numberCutRows = solver_->getNumRows() - numberRowsAtContinuous_;
+      if (numberCutRows > 0) {
+        int *which = new int[numberCutRows];
+        for (int i = 0; i < numberCutRows; i++)
+          which[i] = numberRowsAtContinuous_ + i;
+        solver_->deleteRows(numberCutRows, which);
+        delete[] which;
+      }
+      lastDepth_ = 0;
+      numberThreads_ = rampUpThreads;
+      rampUpThreads = 0;
+      master_ = new CbcBaseModel(*this, 0);
+      masterThread_ = master_->masterThread();
+      char general[200];
+      sprintf(general, "Ramp up done after %d nodes with %d nodes on tree",
+        numberNodes_, tree_->size());
+      messageHandler()->message(CBC_GENERAL, messages())
+        << general << CoinMessageEol;
+    }
     if (!parallelMode() || parallelMode() == -1) {
 #endif
+      CbcPhaseTimer selectTimer(phaseTimes_, CbcPhaseTimes::select);
 #ifdef CBC_EXPERIMENT7
       int multiplier = (moreSpecialOptions_>>3)&31;
       if (tree_->size()<16*multiplier&&numberNodes_>-100 && (specialOptions_&2048)==0) {
@@ -4951,6 +5642,7 @@ void CbcModel::branchAndBound(int doStatistics)
 #else
       node = tree_->bestNode(cutoff);
 #endif
+      selectTimer.stop();
       // Possible one on tree worse than cutoff
       // Weird comparison function can leave ineligible nodes on tree
       if (!node || node->objectiveValue() > cutoff)
@@ -4999,8 +5691,10 @@ void CbcModel::branchAndBound(int doStatistics)
       //unlockThread();
     } else {
       // Deterministic parallel
-      if ((tree_->size() < CoinMax(numberThreads_, 8) || hotstartSolution_) && !goneParallel) {
+      if ((tree_->size() < rampUpTarget || hotstartSolution_) && !goneParallel) {
+        CbcPhaseTimer selectTimer(phaseTimes_, CbcPhaseTimes::select);
         node = tree_->bestNode(cutoff);
+        selectTimer.stop();
 #ifdef SAVE_NODE_INFO
 	// Save parent node (for user)
 	parentNode_ = node;
@@ -5046,6 +5740,13 @@ void CbcModel::branchAndBound(int doStatistics)
         }
       } else {
         // Split and solve
+        if (!goneParallel && rampUpCompareSet)
+          tree_->setComparison(*nodeCompare_);
+#ifdef CBC_HAS_NAUTY
+        pruneSymmetricNodes();
+        if (tree_->empty())
+          continue;
+#endif
         master_->deterministicParallel();
         goneParallel = true;
       }
@@ -5059,12 +5760,21 @@ void CbcModel::branchAndBound(int doStatistics)
     nDeleteNode = 0;
   }
 #ifdef CBC_THREAD
+  // search may have ended while ramping up
+  if (rampUpCompareSet)
+    tree_->setComparison(*nodeCompare_);
+  if (rampUpThreads)
+    numberThreads_ = rampUpThreads;
   if (master_) {
     master_->stopThreads(-1);
     master_->waitForThreadsInTree(2);
     // adjust time to allow for children on some systems
     //dblParam_[CbcStartSeconds] -= CoinCpuTimeJustChildren();
   }
+  // take any solution background heuristic is still working on
+  finishTreeHeuristics();
+  finishSubBranchAndBound();
+  finishDivePortfolio();
 #endif
   /*
       End of the non-abort actions. The next block of code is executed if we've
@@ -5075,6 +5785,9 @@ void CbcModel::branchAndBound(int doStatistics)
     */
   if (stoppingCriterionReached()) {
     if (tree_->size()) {
+      // so search can be resumed
+      if (checkpoint_ && !parentModel_)
+        takeCheckpoint();
       double dummyBest;
       tree_->cleanTree(this, -COIN_DBL_MAX, dummyBest);
 #if 0 // Does not seem to be needed def CBC_THREAD
@@ -5106,7 +5819,16 @@ void CbcModel::branchAndBound(int doStatistics)
       secondaryStatus_ = 2;
       status_ = 0;
     } else if (maximumSecondsReached()) {
-      handler_->message(CBC_MAXTIME, messages_) << CoinMessageEol;
+      double work = workUnits();
+      if (dblParam_[CbcMaximumWork] > 0.0 && work >= dblParam_[CbcMaximumWork]) {
+        char general[200];
+        sprintf(general, "Work limit of %g reached (%g work units)",
+          dblParam_[CbcMaximumWork], work);
+        messageHandler()->message(CBC_GENERAL, messages())
+          << general << CoinMessageEol;
+      } else {
+        handler_->message(CBC_MAXTIME, messages_) << CoinMessageEol;
+      }
       secondaryStatus_ = 4;
       status_ = 1;
     } else if (numberSolutions_ >= intParam_[CbcMaxNumSol]) {
@@ -5148,7 +5870,7 @@ void CbcModel::branchAndBound(int doStatistics)
     status_ = 1;
   numberNodes_ += numberExtraNodes_;
   numberIterations_ += numberExtraIterations_;
-  if (eventHandler) {
+  if (eventHandler && eventHandler->wanted(CbcEventHandler::endSearch)) {
     eventHandler->event(CbcEventHandler::endSearch);
   }
 #ifdef CBC_HAS_NAUTY
@@ -5168,6 +5890,29 @@ void CbcModel::branchAndBound(int doStatistics)
       << numberIterations_ << numberNodes_ << getCurrentSeconds()
       << CoinMessageEol;
   }
+  if (nodeTrace_)
+    nodeTrace_->flush();
+  if (peerExchange_ && !parentModel_)
+    peerExchange_->publish(this);
+  if (checkpoint_ && !parentModel_ && !checkpoint_->flush()) {
+    messageHandler()->message(CBC_GENERAL, messages())
+      << "Checkpoint file could not be written" << CoinMessageEol;
+  }
+  if (resumeRoot) {
+    // root of resumed search (its bounds were used by checkpoint nodes)
+    delete resumeRoot;
+    topOfTree_ = NULL;
+  }
+  if (phaseTimes_ && !parentModel_) {
+    phaseTimes_->print(handler_, &messages_);
+    const char *traceFile = phaseTimes_->traceFile();
+    if (traceFile && !phaseTimes_->writeTrace(traceFile)) {
+      char general[200];
+      sprintf(general, "Unable to write trace file %s", traceFile);
+      handler_->message(CBC_GENERAL, messages_)
+        << general << CoinMessageEol;
+    }
+  }
   if ((moreSpecialOptions_ & 4194304) != 0) {
     // Conflict cuts
     int numberCuts = globalCuts_.sizeRowCuts();
@@ -5190,6 +5935,46 @@ void CbcModel::branchAndBound(int doStatistics)
         << general << CoinMessageEol;
     }
   }
+  if (cutDatabase_) {
+    // conflicts are also kept (they may rely on cutoff)
+    double cutoff = getCutoff();
+    for (int i = 0; i < globalCuts_.sizeRowCuts(); i++) {
+      OsiRowCut2 *cut = globalCuts_.cut(i);
+      if (cut->whichRow() == 1)
+        cutDatabase_->addCut(*cut, cutoff);
+    }
+    if (cutDatabase_->numberCuts() && cutDatabase_->save(cutDatabaseFile_.c_str())) {
+      char general[200];
+      sprintf(general, "%d cuts saved to cut database",
+        cutDatabase_->numberCuts());
+      messageHandler()->message(CBC_GENERAL, messages())
+        << general << CoinMessageEol;
+    }
+    delete cutDatabase_;
+    cutDatabase_ = NULL;
+  }
+  if (globalCuts_.numberEvicted()) {
+    char general[200];
+    sprintf(general, "%d global cuts evicted as least recently active - %d left",
+      globalCuts_.numberEvicted(), globalCuts_.sizeRowCuts());
+    messageHandler()->message(CBC_GENERAL,
+      messages())
+      << general << CoinMessageEol;
+  }
+  if (intParam_[CbcAdaptiveCuts]) {
+    for (int i = 0; i < numberCutGenerators_; i++) {
+      CbcCutGenerator *generator = generator_[i];
+      if (generator->numberScheduleBackoffs()) {
+        char general[200];
+        sprintf(general, "Cut generator %d (%s) switched off %d times by schedule - %g per second at root, %g in tree",
+          i, generator->cutGeneratorName(), generator->numberScheduleBackoffs(),
+          generator->rootRate(), generator->treeRate());
+        messageHandler()->message(CBC_GENERAL,
+          messages())
+          << general << CoinMessageEol;
+      }
+    }
+  }
   if (numberStrongIterations_)
     handler_->message(CBC_STRONG_STATS, messages_)
       << strongInfo_[0] << numberStrongIterations_ << strongInfo_[2]
@@ -5203,9 +5988,30 @@ void CbcModel::branchAndBound(int doStatistics)
       << maximumDepthActual_
       << numberDJFixed_ << numberFathoms_ << numberExtraNodes_ << numberExtraIterations_
       << CoinMessageEol;
-#ifdef CBC_HAS_NAUTY
-  if (symmetryInfo_)
-    symmetryInfo_->statsOrbits(this, 1);
+  if (numberFathomTries_) {
+    char general[200];
+    sprintf(general, "Fathoming methods tried at %d nodes - %d fathomed",
+      numberFathomTries_, numberFathomSuccesses_);
+    messageHandler()->message(CBC_GENERAL, messages())
+      << general << CoinMessageEol;
+  }
+  if (numberDuplicateNodes_) {
+    char general[200];
+    sprintf(general, "%d nodes pruned as bounds same as those of node already solved",
+      numberDuplicateNodes_);
+    messageHandler()->message(CBC_GENERAL, messages())
+      << general << CoinMessageEol;
+  }
+  if (factorizationCache_ && factorizationCache_->numberSaved()) {
+    char general[200];
+    sprintf(general, "%d node factorizations kept - %d reused by later nodes",
+      factorizationCache_->numberSaved(), factorizationCache_->numberRestored());
+    messageHandler()->message(CBC_GENERAL, messages())
+      << general << CoinMessageEol;
+  }
+#ifdef CBC_HAS_NAUTY
+  if (symmetryInfo_)
+    symmetryInfo_->statsOrbits(this, 1);
   if (rootSymmetryInfo_)
     rootSymmetryInfo_->statsOrbits(this, 1);
 #endif
@@ -5473,6 +6279,34 @@ void CbcModel::branchAndBound(int doStatistics)
   walkback_ = NULL;
   delete[] lastNodeInfo_;
   lastNodeInfo_ = NULL;
+  delete boundTrail_;
+  boundTrail_ = NULL;
+  delete pseudoCostArrays_;
+  pseudoCostArrays_ = NULL;
+  delete conflictAnalysis_;
+  conflictAnalysis_ = NULL;
+  delete strongBudget_;
+  strongBudget_ = NULL;
+  delete solutionChanges_;
+  solutionChanges_ = NULL;
+  // any symmetry detection still going is abandoned
+#ifdef CBC_THREAD
+  delete symmetryDetection_;
+  symmetryDetection_ = NULL;
+#endif
+  delete separationContext_;
+  separationContext_ = NULL;
+#ifdef CBC_THREAD
+  if (treeCutMaster_) {
+    treeCutMaster_->stopThreads(0);
+    delete treeCutMaster_;
+    treeCutMaster_ = NULL;
+  }
+  if (treeCutThreads_) {
+    numberThreads_ = treeCutThreads_;
+    treeCutThreads_ = 0;
+  }
+#endif
   delete[] lastNumberCuts_;
   lastNumberCuts_ = NULL;
   delete[] lastCut_;
@@ -5515,6 +6349,7 @@ void CbcModel::branchAndBound(int doStatistics)
         clpSolver->getModelPtr()->setDualRowPivotAlgorithm(*savePivotMethod);
         delete savePivotMethod;
       }
+      restoreDualPricing(clpSolver);
       clpSolver->setLargestAway(-1.0);
     }
   }
@@ -5617,7 +6452,8 @@ void CbcModel::initialSolve()
       clpSolver->getModelPtr()->setMaximumWallSeconds(maxTime);
   }
 #endif
-  solver_->initialSolve();
+  if (!concurrentInitialSolve())
+    solver_->initialSolve();
   solver_->setHintParam(OsiDoInBranchAndCut, false, OsiHintDo, NULL);
   if (!solver_->isProvenOptimal())
     solver_->resolve();
@@ -5725,7 +6561,40 @@ CbcModel::CbcModel()
   , walkback_(NULL)
   , preProcess_(NULL)
   , lastNodeInfo_(NULL)
+  , boundTrail_(NULL)
+  , pseudoCostArrays_(NULL)
+  , conflictAnalysis_(NULL)
+  , strongBudget_(NULL)
+  , solutionChanges_(NULL)
+  , separationContext_(NULL)
+  , pricer_(NULL)
+  , phaseTimes_(NULL)
+  , nodeTrace_(NULL)
+  , progressInterval_(0.0)
+  , progressFd_(-1)
+  , lastProgress_()
+  , checkpoint_(NULL)
+  , checkpointRequested_(0)
+  , peerExchange_(NULL)
+  , peerInterval_(1.0)
+  , lastPeerExchange_(0.0)
+  , rootReducedCost_(NULL)
+  , shadowCache_(NULL)
+  , shadowRowCopy_(NULL)
+  , shadowUpdates_(0)
+  , switchingIndex_(NULL)
+  , numberSwitching_(0)
+  , cutoffStep_(0.0)
+  , cutoffStepOffset_(0.0)
+  , savedDualPivot_(NULL)
+  , rootObjectiveValue_(0.0)
+  , globalFixCutoff_(COIN_DBL_MAX)
+  , treeCutMaster_(NULL)
+  , treeCutThreads_(0)
   , lastCut_(NULL)
+  , keptCuts_(NULL)
+  , cutsToDrop_(NULL)
+  , maximumKeptCuts_(0)
   , lastDepth_(0)
   , lastNumberCuts2_(0)
   , maximumCuts_(0)
@@ -5763,6 +6632,11 @@ CbcModel::CbcModel()
   , numberHeuristics_(0)
   , heuristic_(NULL)
   , lastHeuristic_(NULL)
+  , numberFathomMethods_(0)
+  , fathom_(NULL)
+  , numberFathomTries_(0)
+  , numberFathomSuccesses_(0)
+  , numberDuplicateNodes_(0)
   , fastNodeDepth_(-1)
   , eventHandler_(NULL)
 #ifdef CBC_HAS_NAUTY
@@ -5775,6 +6649,7 @@ CbcModel::CbcModel()
   , originalColumns_(NULL)
   , howOftenGlobalScan_(3)
   , numberGlobalViolations_(0)
+  , memoryHighWater_(0.0)
   , numberExtraIterations_(0)
   , numberExtraNodes_(0)
   , numberFathoms_(0)
@@ -5819,7 +6694,27 @@ CbcModel::CbcModel()
   , roundIntVars_(false)
   , master_(NULL)
   , masterThread_(NULL)
+  , publishedCutoff_(COIN_DBL_MAX)
+  , threadPool_(NULL)
+  , prefetchPool_(NULL)
+  , prefetchNodeInfo_(NULL)
+  , rootHeuristics_(NULL)
+  , treeHeuristics_(NULL)
+  , divePortfolio_(NULL)
+  , subMipQueue_(NULL)
+  , nodePropagator_(NULL)
+  , processedNodes_(NULL)
+  , factorizationCache_(NULL)
+  , cutDatabase_(NULL)
+  , orbitope_(NULL)
+  , cliqueTable_(NULL)
+  , implicationGraph_(NULL)
+  , raceRootSolver_(NULL)
+  , symmetryDetection_(NULL)
+  , threadQuota_(0)
 {
+  restoreDualPricing(NULL);
+  resetResolveAlgorithm();
   memset(intParam_, 0, sizeof(intParam_));
   intParam_[CbcMaxNumNode] = COIN_INT_MAX;
   intParam_[CbcMaxNodesNotImprovingFeasSol] = COIN_INT_MAX;
@@ -5831,6 +6726,8 @@ CbcModel::CbcModel()
   dblParam_[CbcAllowableGap] = 1.0e-10;
   dblParam_[CbcMaximumSeconds] = 1.0e100;
   dblParam_[CbcMaximumSecondsNotImprovingFeasSol] = 1.0e100;
+  dblParam_[CbcRootStallGain] = 0.01;
+  dblParam_[CbcMaximumCutParallelism] = 0.95;
   dblParam_[CbcCurrentCutoff] = 1.0e100;
   dblParam_[CbcOptimizationDirection] = 1.0;
   dblParam_[CbcCurrentObjectiveValue] = 1.0e100;
@@ -5909,7 +6806,40 @@ CbcModel::CbcModel(const OsiSolverInterface &rhs)
   , walkback_(NULL)
   , preProcess_(NULL)
   , lastNodeInfo_(NULL)
+  , boundTrail_(NULL)
+  , pseudoCostArrays_(NULL)
+  , conflictAnalysis_(NULL)
+  , strongBudget_(NULL)
+  , solutionChanges_(NULL)
+  , separationContext_(NULL)
+  , pricer_(NULL)
+  , phaseTimes_(NULL)
+  , nodeTrace_(NULL)
+  , progressInterval_(0.0)
+  , progressFd_(-1)
+  , lastProgress_()
+  , checkpoint_(NULL)
+  , checkpointRequested_(0)
+  , peerExchange_(NULL)
+  , peerInterval_(1.0)
+  , lastPeerExchange_(0.0)
+  , rootReducedCost_(NULL)
+  , shadowCache_(NULL)
+  , shadowRowCopy_(NULL)
+  , shadowUpdates_(0)
+  , switchingIndex_(NULL)
+  , numberSwitching_(0)
+  , cutoffStep_(0.0)
+  , cutoffStepOffset_(0.0)
+  , savedDualPivot_(NULL)
+  , rootObjectiveValue_(0.0)
+  , globalFixCutoff_(COIN_DBL_MAX)
+  , treeCutMaster_(NULL)
+  , treeCutThreads_(0)
   , lastCut_(NULL)
+  , keptCuts_(NULL)
+  , cutsToDrop_(NULL)
+  , maximumKeptCuts_(0)
   , lastDepth_(0)
   , lastNumberCuts2_(0)
   , maximumCuts_(0)
@@ -5944,6 +6874,11 @@ CbcModel::CbcModel(const OsiSolverInterface &rhs)
   , numberHeuristics_(0)
   , heuristic_(NULL)
   , lastHeuristic_(NULL)
+  , numberFathomMethods_(0)
+  , fathom_(NULL)
+  , numberFathomTries_(0)
+  , numberFathomSuccesses_(0)
+  , numberDuplicateNodes_(0)
   , fastNodeDepth_(-1)
   , eventHandler_(NULL)
 #ifdef CBC_HAS_NAUTY
@@ -5956,6 +6891,7 @@ CbcModel::CbcModel(const OsiSolverInterface &rhs)
   , originalColumns_(NULL)
   , howOftenGlobalScan_(3)
   , numberGlobalViolations_(0)
+  , memoryHighWater_(0.0)
   , numberExtraIterations_(0)
   , numberExtraNodes_(0)
   , numberFathoms_(0)
@@ -6000,7 +6936,27 @@ CbcModel::CbcModel(const OsiSolverInterface &rhs)
   , roundIntVars_(false)
   , master_(NULL)
   , masterThread_(NULL)
+  , publishedCutoff_(COIN_DBL_MAX)
+  , threadPool_(NULL)
+  , prefetchPool_(NULL)
+  , prefetchNodeInfo_(NULL)
+  , rootHeuristics_(NULL)
+  , treeHeuristics_(NULL)
+  , divePortfolio_(NULL)
+  , subMipQueue_(NULL)
+  , nodePropagator_(NULL)
+  , processedNodes_(NULL)
+  , factorizationCache_(NULL)
+  , cutDatabase_(NULL)
+  , orbitope_(NULL)
+  , cliqueTable_(NULL)
+  , implicationGraph_(NULL)
+  , raceRootSolver_(NULL)
+  , symmetryDetection_(NULL)
+  , threadQuota_(0)
 {
+  restoreDualPricing(NULL);
+  resetResolveAlgorithm();
   memset(intParam_, 0, sizeof(intParam_));
   intParam_[CbcMaxNumNode] = COIN_INT_MAX;
   intParam_[CbcMaxNodesNotImprovingFeasSol] = COIN_INT_MAX;
@@ -6012,6 +6968,8 @@ CbcModel::CbcModel(const OsiSolverInterface &rhs)
   dblParam_[CbcAllowableGap] = 1.0e-10;
   dblParam_[CbcMaximumSeconds] = 1.0e100;
   dblParam_[CbcMaximumSecondsNotImprovingFeasSol] = 1.0e100;
+  dblParam_[CbcRootStallGain] = 0.01;
+  dblParam_[CbcMaximumCutParallelism] = 0.95;
   dblParam_[CbcCurrentCutoff] = 1.0e100;
   dblParam_[CbcOptimizationDirection] = 1.0;
   dblParam_[CbcCurrentObjectiveValue] = 1.0e100;
@@ -6132,6 +7090,8 @@ static double *resizeDouble(double *array, int oldLength, int newLength)
 void CbcModel::assignSolver(OsiSolverInterface *&solver, bool deleteSolver)
 
 {
+  // pseudo shadow prices were for old matrix
+  deleteShadowCache();
   // resize stuff if exists
   if (solver && solver_) {
     int nOld = solver_->getNumCols();
@@ -6146,6 +7106,7 @@ void CbcModel::assignSolver(OsiSolverInterface *&solver, bool deleteSolver)
       if (savedSolutions_) {
         for (int i = 0; i < maximumSavedSolutions_; i++)
           savedSolutions_[i] = resizeDouble(savedSolutions_[i], nOld, nNew);
+        savedHash_.clear();
       }
     }
   }
@@ -6252,6 +7213,7 @@ CbcModel::CbcModel(const CbcModel &rhs, bool cloneHandler)
   , fastNodeDepth_(rhs.fastNodeDepth_)
   , howOftenGlobalScan_(rhs.howOftenGlobalScan_)
   , numberGlobalViolations_(rhs.numberGlobalViolations_)
+  , memoryHighWater_(rhs.memoryHighWater_)
   , numberExtraIterations_(rhs.numberExtraIterations_)
   , numberExtraNodes_(rhs.numberExtraNodes_)
   , numberFathoms_(rhs.numberFathoms_)
@@ -6296,6 +7258,28 @@ CbcModel::CbcModel(const CbcModel &rhs, bool cloneHandler)
   , roundIntVars_(rhs.roundIntVars_)
   , master_(NULL)
   , masterThread_(NULL)
+  , publishedCutoff_(rhs.publishedCutoff_)
+  , threadPool_(NULL)
+  , prefetchPool_(NULL)
+  , prefetchNodeInfo_(NULL)
+  , rootHeuristics_(NULL)
+  , treeHeuristics_(NULL)
+  , divePortfolio_(NULL)
+  , subMipQueue_(NULL)
+  , nodePropagator_(NULL)
+  , processedNodes_(NULL)
+  , factorizationCache_(NULL)
+  , cutDatabase_(NULL)
+  , orbitope_(NULL)
+  , cliqueTable_(NULL)
+  , implicationGraph_(NULL)
+  , raceRootSolver_(NULL)
+  , symmetryDetection_(NULL)
+  , threadStatisticsFile_(rhs.threadStatisticsFile_)
+  , threadQuotaFile_(rhs.threadQuotaFile_)
+  , threadQuota_(rhs.threadQuota_)
+  , symmetryFile_(rhs.symmetryFile_)
+  , cutDatabaseFile_(rhs.cutDatabaseFile_)
 {
   memcpy(intParam_, rhs.intParam_, sizeof(intParam_));
   memcpy(dblParam_, rhs.dblParam_, sizeof(dblParam_));
@@ -6342,6 +7326,18 @@ CbcModel::CbcModel(const CbcModel &rhs, bool cloneHandler)
     heuristic_ = NULL;
   }
   lastHeuristic_ = NULL;
+  numberFathomMethods_ = rhs.numberFathomMethods_;
+  if (numberFathomMethods_) {
+    fathom_ = new CbcFathom *[numberFathomMethods_];
+    for (int i = 0; i < numberFathomMethods_; i++) {
+      fathom_[i] = rhs.fathom_[i]->clone();
+    }
+  } else {
+    fathom_ = NULL;
+  }
+  numberFathomTries_ = 0;
+  numberFathomSuccesses_ = 0;
+  numberDuplicateNodes_ = 0;
   if (rhs.eventHandler_) {
     eventHandler_ = rhs.eventHandler_->clone();
   } else {
@@ -6495,6 +7491,50 @@ CbcModel::CbcModel(const CbcModel &rhs, bool cloneHandler)
     lastNodeInfo_ = NULL;
     lastNumberCuts_ = NULL;
   }
+  boundTrail_ = NULL;
+  pseudoCostArrays_ = NULL;
+  conflictAnalysis_ = NULL;
+  strongBudget_ = NULL;
+  solutionChanges_ = NULL;
+  separationContext_ = NULL;
+  // pricer and column pool belong to user model
+  pricer_ = NULL;
+  // same settings but own times (for threads)
+  phaseTimes_ = rhs.phaseTimes_ ? new CbcPhaseTimes(*rhs.phaseTimes_) : NULL;
+  // node trace stays with user model (threads are given it in moveToModel)
+  nodeTrace_ = NULL;
+  progressInterval_ = rhs.progressInterval_;
+  progressFd_ = rhs.progressFd_;
+  memset(&lastProgress_, 0, sizeof(CbcProgressRecord));
+  // checkpoints stay with user model
+  checkpoint_ = NULL;
+  checkpointRequested_ = 0;
+  peerExchange_ = NULL;
+  peerInterval_ = rhs.peerInterval_;
+  lastPeerExchange_ = 0.0;
+  // root reduced costs are only for search in progress
+  rootReducedCost_ = NULL;
+  shadowCache_ = NULL;
+  shadowRowCopy_ = NULL;
+  shadowUpdates_ = 0;
+  switchingIndex_ = NULL;
+  numberSwitching_ = 0;
+  // objective may be changed so analyzeObjective is done again
+  cutoffStep_ = 0.0;
+  cutoffStepOffset_ = 0.0;
+  savedDualPivot_ = NULL;
+  restoreDualPricing(NULL);
+  resetResolveAlgorithm();
+  // implications (some may be from user) go with model
+  if (rhs.implicationGraph_)
+    implicationGraph_ = new CbcImplicationGraph(*rhs.implicationGraph_);
+  rootObjectiveValue_ = 0.0;
+  globalFixCutoff_ = COIN_DBL_MAX;
+  keptCuts_ = NULL;
+  cutsToDrop_ = NULL;
+  maximumKeptCuts_ = 0;
+  treeCutMaster_ = NULL;
+  treeCutThreads_ = 0;
   maximumCuts_ = rhs.maximumCuts_;
   if (maximumCuts_) {
     lastCut_ = new const OsiRowCut *[maximumCuts_];
@@ -6620,6 +7660,7 @@ CbcModel::operator=(const CbcModel &rhs)
     numberSolutions_ = rhs.numberSolutions_;
     numberSavedSolutions_ = rhs.numberSavedSolutions_;
     maximumSavedSolutions_ = rhs.maximumSavedSolutions_;
+    savedHash_ = rhs.savedHash_;
     stateOfSearch_ = rhs.stateOfSearch_;
     whenCuts_ = rhs.whenCuts_;
     numberHeuristicSolutions_ = rhs.numberHeuristicSolutions_;
@@ -6651,6 +7692,7 @@ CbcModel::operator=(const CbcModel &rhs)
     printFrequency_ = rhs.printFrequency_;
     howOftenGlobalScan_ = rhs.howOftenGlobalScan_;
     numberGlobalViolations_ = rhs.numberGlobalViolations_;
+    memoryHighWater_ = rhs.memoryHighWater_;
     numberExtraIterations_ = rhs.numberExtraIterations_;
     numberExtraNodes_ = rhs.numberExtraNodes_;
     preProcess_ = rhs.preProcess_;
@@ -6721,6 +7763,7 @@ CbcModel::operator=(const CbcModel &rhs)
     delete master_;
     master_ = NULL;
     masterThread_ = NULL;
+    publishedCutoff_ = rhs.publishedCutoff_;
     searchStrategy_ = rhs.searchStrategy_;
     strongStrategy_ = rhs.strongStrategy_;
     numberStrongIterations_ = rhs.numberStrongIterations_;
@@ -6755,6 +7798,18 @@ CbcModel::operator=(const CbcModel &rhs)
       heuristic_ = NULL;
     }
     lastHeuristic_ = NULL;
+    numberFathomMethods_ = rhs.numberFathomMethods_;
+    if (numberFathomMethods_) {
+      fathom_ = new CbcFathom *[numberFathomMethods_];
+      for (int i = 0; i < numberFathomMethods_; i++) {
+        fathom_[i] = rhs.fathom_[i]->clone();
+      }
+    } else {
+      fathom_ = NULL;
+    }
+    numberFathomTries_ = rhs.numberFathomTries_;
+    numberFathomSuccesses_ = rhs.numberFathomSuccesses_;
+    numberDuplicateNodes_ = rhs.numberDuplicateNodes_;
     if (eventHandler_)
       delete eventHandler_;
     if (rhs.eventHandler_) {
@@ -6838,6 +7893,14 @@ CbcModel::operator=(const CbcModel &rhs)
     maximumDepth_ = rhs.maximumDepth_;
     keepNamesPreproc = rhs.keepNamesPreproc;
     mipStart_ = rhs.mipStart_;
+    pseudoCostStartNames_ = rhs.pseudoCostStartNames_;
+    pseudoCostStart_ = rhs.pseudoCostStart_;
+    pseudoCostColumnNames_ = rhs.pseudoCostColumnNames_;
+    threadStatisticsFile_ = rhs.threadStatisticsFile_;
+    threadQuotaFile_ = rhs.threadQuotaFile_;
+    threadQuota_ = rhs.threadQuota_;
+    symmetryFile_ = rhs.symmetryFile_;
+    cutDatabaseFile_ = rhs.cutDatabaseFile_;
     delete[] addedCuts_;
     delete[] walkback_;
     // These are only used as temporary arrays so need not be filled
@@ -6863,6 +7926,66 @@ CbcModel::operator=(const CbcModel &rhs)
       lastNodeInfo_ = NULL;
       lastNumberCuts_ = NULL;
     }
+    delete boundTrail_;
+    boundTrail_ = NULL;
+    delete pseudoCostArrays_;
+    pseudoCostArrays_ = NULL;
+    delete conflictAnalysis_;
+    conflictAnalysis_ = NULL;
+    delete strongBudget_;
+    strongBudget_ = NULL;
+    delete solutionChanges_;
+    solutionChanges_ = NULL;
+    delete separationContext_;
+    separationContext_ = NULL;
+    // pricer and column pool are not copied
+    delete pricer_;
+    pricer_ = NULL;
+    columnPool_ = CbcColumnPool();
+    delete phaseTimes_;
+    phaseTimes_ = rhs.phaseTimes_ ? new CbcPhaseTimes(*rhs.phaseTimes_) : NULL;
+    delete nodeTrace_;
+    nodeTrace_ = NULL;
+    progressInterval_ = rhs.progressInterval_;
+    progressFd_ = rhs.progressFd_;
+    memset(&lastProgress_, 0, sizeof(CbcProgressRecord));
+    delete checkpoint_;
+    checkpoint_ = NULL;
+    clearCheckpoints();
+    checkpointRequested_ = 0;
+    delete peerExchange_;
+    peerExchange_ = NULL;
+    peerInterval_ = rhs.peerInterval_;
+    delete[] rootReducedCost_;
+    rootReducedCost_ = NULL;
+    deleteShadowCache();
+    restoreDualPricing(NULL);
+    resetResolveAlgorithm();
+    cutoffStep_ = 0.0;
+    cutoffStepOffset_ = 0.0;
+    // objects are new so index is made again
+    delete[] switchingIndex_;
+    switchingIndex_ = NULL;
+    numberSwitching_ = 0;
+    delete implicationGraph_;
+    if (rhs.implicationGraph_)
+      implicationGraph_ = new CbcImplicationGraph(*rhs.implicationGraph_);
+    else
+      implicationGraph_ = NULL;
+    globalFixCutoff_ = COIN_DBL_MAX;
+    delete[] keptCuts_;
+    keptCuts_ = NULL;
+    delete[] cutsToDrop_;
+    cutsToDrop_ = NULL;
+    maximumKeptCuts_ = 0;
+#ifdef CBC_THREAD
+    if (treeCutMaster_) {
+      treeCutMaster_->stopThreads(0);
+      delete treeCutMaster_;
+      treeCutMaster_ = NULL;
+    }
+#endif
+    treeCutThreads_ = 0;
     maximumCuts_ = rhs.maximumCuts_;
     if (maximumCuts_) {
       lastCut_ = new const OsiRowCut *[maximumCuts_];
@@ -6909,8 +8032,20 @@ CbcModel::~CbcModel()
   eventHandler_ = NULL;
 #ifdef CBC_THREAD
   // Get rid of all threaded stuff
+  delete symmetryDetection_;
   delete master_;
-#endif
+  delete rootHeuristics_;
+  delete treeHeuristics_;
+  delete divePortfolio_;
+  delete subMipQueue_;
+  delete prefetchPool_;
+  delete threadPool_;
+#endif
+  delete nodePropagator_;
+  delete orbitope_;
+  delete cliqueTable_;
+  delete implicationGraph_;
+  delete raceRootSolver_;
 }
 // Clears out as much as possible (except solver)
 void CbcModel::gutsOfDestructor()
@@ -6932,6 +8067,11 @@ void CbcModel::gutsOfDestructor()
     delete heuristic_[i];
   delete[] heuristic_;
   heuristic_ = NULL;
+  for (i = 0; i < numberFathomMethods_; i++)
+    delete fathom_[i];
+  delete[] fathom_;
+  fathom_ = NULL;
+  numberFathomMethods_ = 0;
   delete nodeCompare_;
   nodeCompare_ = NULL;
   delete problemFeasibility_;
@@ -6939,6 +8079,26 @@ void CbcModel::gutsOfDestructor()
   delete[] originalColumns_;
   originalColumns_ = NULL;
   delete strategy_;
+  delete pricer_;
+  pricer_ = NULL;
+  delete phaseTimes_;
+  phaseTimes_ = NULL;
+  delete nodeTrace_;
+  nodeTrace_ = NULL;
+  delete checkpoint_;
+  checkpoint_ = NULL;
+  clearCheckpoints();
+  delete peerExchange_;
+  peerExchange_ = NULL;
+  delete[] rootReducedCost_;
+  rootReducedCost_ = NULL;
+  deleteShadowCache();
+  restoreDualPricing(NULL);
+  delete[] keptCuts_;
+  keptCuts_ = NULL;
+  delete[] cutsToDrop_;
+  cutsToDrop_ = NULL;
+  maximumKeptCuts_ = 0;
   if (updateItems_ != NULL)
       delete[] updateItems_;
   updateItems_ = NULL;
@@ -6949,10 +8109,27 @@ void CbcModel::gutsOfDestructor()
 // Clears out enough to reset CbcModel
 void CbcModel::gutsOfDestructor2()
 {
+  delete nodePropagator_;
+  nodePropagator_ = NULL;
+  delete processedNodes_;
+  processedNodes_ = NULL;
+  delete factorizationCache_;
+  factorizationCache_ = NULL;
+  delete cutDatabase_;
+  cutDatabase_ = NULL;
+  delete orbitope_;
+  orbitope_ = NULL;
+  delete cliqueTable_;
+  cliqueTable_ = NULL;
+  delete raceRootSolver_;
+  raceRootSolver_ = NULL;
   delete[] integerInfo_;
   integerInfo_ = NULL;
   delete[] integerVariable_;
   integerVariable_ = NULL;
+  delete[] switchingIndex_;
+  switchingIndex_ = NULL;
+  numberSwitching_ = 0;
   int i;
   if (ownObjects_) {
     for (i = 0; i < numberObjects_; i++)
@@ -6986,6 +8163,7 @@ void CbcModel::resetModel()
   delete continuousSolver_;
   continuousSolver_ = NULL;
   numberSavedSolutions_ = 0;
+  savedHash_.clear();
   delete[] bestSolution_;
   bestSolution_ = NULL;
   if (savedSolutions_) {
@@ -7011,6 +8189,29 @@ void CbcModel::resetModel()
   walkback_ = NULL;
   delete[] lastNodeInfo_;
   lastNodeInfo_ = NULL;
+  delete boundTrail_;
+  boundTrail_ = NULL;
+  delete pseudoCostArrays_;
+  pseudoCostArrays_ = NULL;
+  delete conflictAnalysis_;
+  conflictAnalysis_ = NULL;
+  delete strongBudget_;
+  strongBudget_ = NULL;
+  delete solutionChanges_;
+  solutionChanges_ = NULL;
+  delete separationContext_;
+  separationContext_ = NULL;
+#ifdef CBC_THREAD
+  if (treeCutMaster_) {
+    treeCutMaster_->stopThreads(0);
+    delete treeCutMaster_;
+    treeCutMaster_ = NULL;
+  }
+  if (treeCutThreads_) {
+    numberThreads_ = treeCutThreads_;
+    treeCutThreads_ = 0;
+  }
+#endif
   delete[] lastNumberCuts_;
   lastNumberCuts_ = NULL;
   delete[] lastCut_;
@@ -7084,6 +8285,7 @@ void CbcModel::resetModel()
   numberStoppedSubTrees_ = 0;
   numberInfeasibleNodes_ = 0;
   numberGlobalViolations_ = 0;
+  memoryHighWater_ = 0.0;
   numberExtraIterations_ = 0;
   numberExtraNodes_ = 0;
   numberFathoms_ = 0;
@@ -7135,6 +8337,7 @@ void CbcModel::gutsOfCopy(const CbcModel &rhs, int mode)
   maximumNumberIterations_ = rhs.maximumNumberIterations_;
   numberSavedSolutions_ = rhs.numberSavedSolutions_;
   maximumSavedSolutions_ = rhs.maximumSavedSolutions_;
+  savedHash_ = rhs.savedHash_;
   if (maximumSavedSolutions_) {
     int n = solver_->getNumCols();
     savedSolutions_ = new double *[maximumSavedSolutions_];
@@ -7149,6 +8352,7 @@ void CbcModel::gutsOfCopy(const CbcModel &rhs, int mode)
   delete master_;
   master_ = NULL;
   masterThread_ = NULL;
+  publishedCutoff_ = rhs.publishedCutoff_;
   memcpy(intParam_, rhs.intParam_, sizeof(intParam_));
   memcpy(dblParam_, rhs.dblParam_, sizeof(dblParam_));
   int i;
@@ -7163,6 +8367,10 @@ void CbcModel::gutsOfCopy(const CbcModel &rhs, int mode)
       delete heuristic_[i];
     }
     delete[] heuristic_;
+    for (i = 0; i < numberFathomMethods_; i++) {
+      delete fathom_[i];
+    }
+    delete[] fathom_;
     delete eventHandler_;
     delete branchingMethod_;
   }
@@ -7196,6 +8404,15 @@ void CbcModel::gutsOfCopy(const CbcModel &rhs, int mode)
   } else {
     heuristic_ = NULL;
   }
+  numberFathomMethods_ = rhs.numberFathomMethods_;
+  if (numberFathomMethods_) {
+    fathom_ = new CbcFathom *[numberFathomMethods_];
+    for (i = 0; i < numberFathomMethods_; i++) {
+      fathom_[i] = rhs.fathom_[i]->clone();
+    }
+  } else {
+    fathom_ = NULL;
+  }
   if (rhs.eventHandler_)
     eventHandler_ = rhs.eventHandler_->clone();
   else
@@ -7425,6 +8642,57 @@ void CbcModel::addHeuristic(CbcHeuristic *generator, const char *name,
 #endif
   numberHeuristics_++;
 }
+// Add one fathoming method
+void CbcModel::addFathom(CbcFathom *method)
+{
+  CbcFathom **temp = fathom_;
+  fathom_ = new CbcFathom *[numberFathomMethods_ + 1];
+  if (temp != NULL) {
+    memcpy(fathom_, temp, numberFathomMethods_ * sizeof(CbcFathom *));
+    delete[] temp;
+  }
+  fathom_[numberFathomMethods_] = method->clone();
+  if (solver_)
+    fathom_[numberFathomMethods_]->setModel(this);
+  numberFathomMethods_++;
+}
+/* Try fathoming methods on bounds of current node.
+   A method returning 1 (complete) or 3 (treat as complete) fathoms node.
+   Any solution is checked by setBestSolution. */
+int CbcModel::fathomNode()
+{
+  int fathomed = 0;
+  bool tried = false;
+  for (int i = 0; i < numberFathomMethods_; i++) {
+    CbcFathom *method = fathom_[i];
+    if (!method->possible())
+      continue;
+    double *newSolution = NULL;
+    int returnCode = method->fathom(newSolution);
+    if (returnCode)
+      tried = true;
+    if (newSolution) {
+      int numberColumns = solver_->getNumCols();
+      const double *objective = solver_->getObjCoefficients();
+      double objValue = 0.0;
+      for (int j = 0; j < numberColumns; j++)
+        objValue += newSolution[j] * objective[j];
+      objValue *= solver_->getObjSense();
+      if (objValue < getCutoff())
+        setBestSolution(CBC_TREE_SOL, objValue, newSolution);
+      delete[] newSolution;
+    }
+    if (returnCode == 1 || returnCode == 3) {
+      fathomed = 1;
+      break;
+    }
+  }
+  if (tried)
+    numberFathomTries_++;
+  if (fathomed)
+    numberFathomSuccesses_++;
+  return fathomed;
+}
 
 /*
   The last subproblem handled by the solver is not necessarily related to the
@@ -7565,10 +8833,39 @@ bool CbcModel::addCuts1(CbcNode *node, CoinWarmStartBasis *&lastws)
   if (lastws)
     lastws->setSize(numberColumns, numberRowsAtContinuous_ + currentNumberCuts);
   currentNumberCuts = 0;
+  /*
+      A CbcFullNodeInfo part way down the path (a checkpoint) holds complete
+      bounds and basis, so above it we only need the cuts.
+    */
+  int nFull = nNode;
+  for (int i = 0; i < nNode - 1; i++) {
+    if (walkback_[i]->allActivated() && dynamic_cast< CbcFullNodeInfo * >(walkback_[i])) {
+      nFull = i + 1;
+      break;
+    }
+  }
+  /*
+      Optionally just undo and apply bound changes below the node we were
+      at last time.
+    */
+  bool boundsSet = false;
+  if ((moreSpecialOptions2_ & 33554432) != 0 && !parallelMode()) {
+    if (!boundTrail_)
+      boundTrail_ = new CbcBoundTrail();
+    boundsSet = boundTrail_->moveTo(solver_, walkback_, nNode, nFull - 1);
+  }
+  while (nNode > nFull) {
+    --nNode;
+    walkback_[nNode]->applyCutsToList(addedCuts_, currentNumberCuts);
+  }
   while (nNode) {
     --nNode;
-    walkback_[nNode]->applyToModel(this, lastws,
-      addedCuts_, currentNumberCuts);
+    if (boundsSet)
+      walkback_[nNode]->applyBasisAndCuts(this, lastws,
+        addedCuts_, currentNumberCuts);
+    else
+      walkback_[nNode]->applyToModel(this, lastws,
+        addedCuts_, currentNumberCuts);
   }
 #ifndef NDEBUG
   if (lastws && !lastws->fullBasis()) {
@@ -7589,6 +8886,70 @@ bool CbcModel::addCuts1(CbcNode *node, CoinWarmStartBasis *&lastws)
   return sameProblem;
 }
 
+/*
+  Both arms of a simple integer branch are solved from the LP of the parent
+  (which is what the solver has now).  Rows are the same as they will be
+  when addCuts restores an arm (before loose cuts are dropped), so the
+  optimal basis of each arm can be used then as it is.
+*/
+bool CbcModel::solveBothChildren(CbcNode *newNode)
+{
+  if (intParam_[CbcSolveBothChildren] == 1) {
+    // best first phase only
+    if (!bestSolution_ || dynamic_cast< CbcCompareDepth * >(nodeCompare_))
+      return false;
+  }
+  CbcIntegerBranchingObject *branch = dynamic_cast< CbcIntegerBranchingObject * >(newNode->modifiableBranchingObject());
+  if (!branch || branch->numberBranches() != 2 || branch->branchIndex())
+    return false;
+  if (!solverCharacteristics_->reducedCostsAccurate() || solverCharacteristics_->solutionAddsCuts())
+    return false;
+  CoinWarmStartBasis *parentBasis = dynamic_cast< CoinWarmStartBasis * >(solver_->getWarmStart());
+  if (!parentBasis)
+    return false;
+  int iColumn = branch->variable();
+  double saveLower = solver_->getColLower()[iColumn];
+  double saveUpper = solver_->getColUpper()[iColumn];
+  double direction = solver_->getObjSense();
+  double cutoff = getCutoff();
+  // first arm is the one branch() does first
+  const double *bounds[2];
+  if (branch->way() < 0) {
+    bounds[0] = branch->downBounds();
+    bounds[1] = branch->upBounds();
+  } else {
+    bounds[0] = branch->upBounds();
+    bounds[1] = branch->downBounds();
+  }
+  double objective[2];
+  CoinWarmStartBasis *basis[2];
+  for (int i = 0; i < 2; i++) {
+    solver_->setColLower(iColumn, bounds[i][0]);
+    solver_->setColUpper(iColumn, bounds[i][1]);
+    solver_->resolve();
+    numberIterations_ += solver_->getIterationCount();
+    basis[i] = NULL;
+    objective[i] = COIN_DBL_MAX;
+    if (solver_->isProvenOptimal() && !solver_->isDualObjectiveLimitReached()) {
+      objective[i] = solver_->getObjValue() * direction;
+      if (objective[i] < cutoff)
+        basis[i] = dynamic_cast< CoinWarmStartBasis * >(solver_->getWarmStart());
+      else
+        objective[i] = COIN_DBL_MAX;
+    }
+    solver_->setColLower(iColumn, saveLower);
+    solver_->setColUpper(iColumn, saveUpper);
+    solver_->setWarmStart(parentBasis);
+  }
+  // back to solution of parent (for heuristics)
+  solver_->resolve();
+  delete parentBasis;
+  newNode->setChildResults(objective[0], basis[0], objective[1], basis[1]);
+  newNode->setObjectiveValue(CoinMax(newNode->objectiveValue(),
+    CoinMin(objective[0], objective[1])));
+  return true;
+}
+
 /*
   adjustCuts might be a better name: If the node is feasible, we sift through
   the cuts collected by addCuts1, add the ones that are tight and omit the
@@ -7603,6 +8964,14 @@ int CbcModel::addCuts(CbcNode *node, CoinWarmStartBasis *&lastws)
       comments there.
     */
   bool sameProblem = addCuts1(node, lastws);
+  // arm may have been solved when node was made - start from its basis
+  const CoinWarmStartBasis *childBasis = node->childBasis();
+  if (childBasis && lastws) {
+    if (childBasis->getNumArtificial() == lastws->getNumArtificial()
+      && childBasis->getNumStructural() == lastws->getNumStructural())
+      *lastws = *childBasis;
+    node->freeChildBasis();
+  }
   int i;
   int numberColumns = getNumCols();
   if (solver_->getNumRows() > maximumRows_) {
@@ -7635,18 +9004,27 @@ int CbcModel::addCuts(CbcNode *node, CoinWarmStartBasis *&lastws)
           Use of compressRows conveys we're compressing the basis and not just
           tweaking the artificialStatus_ array.
         */
+    int numberCutsInSolver = 0;
     if (currentNumberCuts > 0) {
       int numberToAdd = 0;
-      const OsiRowCut **addCuts;
       int numberToDrop = 0;
-      int *cutsToDrop;
-      addCuts = new const OsiRowCut *[currentNumberCuts];
-      cutsToDrop = new int[currentNumberCuts];
+      // work arrays are kept from node to node
+      if (currentNumberCuts > maximumKeptCuts_) {
+        delete[] keptCuts_;
+        delete[] cutsToDrop_;
+        maximumKeptCuts_ = 2 * currentNumberCuts + 10;
+        keptCuts_ = new const OsiRowCut *[maximumKeptCuts_];
+        cutsToDrop_ = new int[maximumKeptCuts_];
+      }
+      const OsiRowCut **addCuts = keptCuts_;
+      int *cutsToDrop = cutsToDrop_;
+      int slackNodes = intParam_[CbcSlackCutNodes] > 0 ? intParam_[CbcSlackCutNodes] : -1;
       assert(currentNumberCuts + numberRowsAtContinuous_ <= lastws->getNumArtificial());
       assert(currentNumberCuts <= maximumWhich_); // we will read from whichGenerator_[0..currentNumberCuts-1] below, so should have all these entries
       for (i = 0; i < currentNumberCuts; i++) {
         CoinWarmStartBasis::Status status = lastws->getArtifStatus(i + numberRowsAtContinuous_);
-        if (addedCuts_[i] && (status != CoinWarmStartBasis::basic || (addedCuts_[i]->effectiveness() > 1.0e10 && !addedCuts_[i]->canDropCut(solver_, i + numberRowsAtContinuous_)))) {
+        // cuts which have not been slack for long stay (CbcSlackCutNodes)
+        if (addedCuts_[i] && (status != CoinWarmStartBasis::basic || (addedCuts_[i]->effectiveness() > 1.0e10 && !addedCuts_[i]->canDropCut(solver_, i + numberRowsAtContinuous_)) || addedCuts_[i]->numberSlack() <= slackNodes)) {
 #ifdef CHECK_CUT_COUNTS
           printf("Using cut %d %x as row %d\n", i, addedCuts_[i],
             numberRowsAtContinuous_ + numberToAdd);
@@ -7780,18 +9158,21 @@ int CbcModel::addCuts(CbcNode *node, CoinWarmStartBasis *&lastws)
 #endif
         solver_->applyRowCuts(numberToAdd, addCuts);
       }
+      numberCutsInSolver = numberToAdd;
 #ifdef CBC_CHECK_BASIS
       printf("addCuts: stripped basis; rows %d + %d\n",
         numberRowsAtContinuous_, numberToAdd);
       lastws->print();
 #endif
-      delete[] addCuts;
-      delete[] cutsToDrop;
     }
     /*
           Set the basis in the solver.
         */
     solver_->setWarmStart(lastws);
+    // factorization of a node solved earlier may do (CbcFactorizationMemory)
+    if (factorizationCache_)
+      factorizationCache_->restore(solver_, numberRowsAtContinuous_,
+        numberCutsInSolver, keptCuts_, lastws);
     /*
           Clean up and we're out of here.
         */
@@ -7954,6 +9335,124 @@ int CbcModel::reducedCostFix()
 #endif
   return numberFixed;
 }
+// Keep reduced costs of root LP for globalReducedCostFix
+void CbcModel::saveRootReducedCosts()
+{
+  delete[] rootReducedCost_;
+  rootReducedCost_ = NULL;
+  globalFixCutoff_ = COIN_DBL_MAX;
+  if (!solverCharacteristics_->reducedCostsAccurate() || !solver_->isProvenOptimal() || !numberIntegers_)
+    return;
+  double direction = solver_->getObjSense();
+  double tolerance;
+  solver_->getDblParam(OsiDualTolerance, tolerance);
+  double integerTolerance = getDblParam(CbcIntegerTolerance);
+  const double *lower = solver_->getColLower();
+  const double *upper = solver_->getColUpper();
+  const double *solution = solver_->getColSolution();
+  const double *reducedCost = solver_->getReducedCost();
+  rootReducedCost_ = new double[2 * numberIntegers_];
+  bool any = false;
+  for (int i = 0; i < numberIntegers_; i++) {
+    int iColumn = integerVariable_[i];
+    double djValue = direction * reducedCost[iColumn];
+    double value = solution[iColumn];
+    if (value < lower[iColumn] + integerTolerance && djValue > tolerance) {
+      value = lower[iColumn];
+    } else if (value > upper[iColumn] - integerTolerance && -djValue > tolerance) {
+      value = upper[iColumn];
+    } else {
+      djValue = 0.0;
+    }
+    if (djValue)
+      any = true;
+    rootReducedCost_[2 * i] = djValue;
+    rootReducedCost_[2 * i + 1] = value;
+  }
+  if (!any) {
+    delete[] rootReducedCost_;
+    rootReducedCost_ = NULL;
+    return;
+  }
+  rootObjectiveValue_ = solver_->getObjValue() * direction;
+}
+/*
+  Any solution better than cutoff has objective at least root objective
+  plus |dj| times distance of variable from its root value - so bounds
+  of variables at a bound in root LP can be tightened for the rest of
+  the search.  Bounds go in root node info which every node starts from.
+*/
+int CbcModel::globalReducedCostFix()
+{
+  if (!rootReducedCost_)
+    return 0;
+  double cutoff = getCutoff();
+  if (cutoff >= globalFixCutoff_)
+    return 0;
+  globalFixCutoff_ = cutoff;
+  double tolerance;
+  solver_->getDblParam(OsiDualTolerance, tolerance);
+  double gap = cutoff - rootObjectiveValue_;
+  if (gap <= 0.0)
+    gap = tolerance;
+  gap += 100.0 * tolerance;
+  const double *lower;
+  const double *upper;
+  if (topOfTree_) {
+    lower = topOfTree_->lower();
+    upper = topOfTree_->upper();
+  } else {
+    lower = solver_->getColLower();
+    upper = solver_->getColUpper();
+  }
+  int numberTightened = 0;
+  int numberFixed = 0;
+  for (int i = 0; i < numberIntegers_; i++) {
+    double djValue = rootReducedCost_[2 * i];
+    if (!djValue)
+      continue;
+    int iColumn = integerVariable_[i];
+    double value = rootReducedCost_[2 * i + 1];
+    // how far variable can move from root value
+    double distance = floor(gap / fabs(djValue) + 1.0e-7);
+    if (djValue > 0.0) {
+      double newBound = value + distance;
+      if (newBound < upper[iColumn] - 0.5) {
+        newBound = CoinMax(newBound, lower[iColumn]);
+        if (topOfTree_)
+          topOfTree_->setColUpper(iColumn, newBound);
+        else
+          solver_->setColUpper(iColumn, newBound);
+        numberTightened++;
+        if (newBound == lower[iColumn])
+          numberFixed++;
+      }
+    } else {
+      double newBound = value - distance;
+      if (newBound > lower[iColumn] + 0.5) {
+        newBound = CoinMin(newBound, upper[iColumn]);
+        if (topOfTree_)
+          topOfTree_->setColLower(iColumn, newBound);
+        else
+          solver_->setColLower(iColumn, newBound);
+        numberTightened++;
+        if (newBound == upper[iColumn])
+          numberFixed++;
+      }
+    }
+  }
+  if (numberTightened) {
+    numberDJFixed_ += numberFixed;
+    if (handler_->logLevel() > 1) {
+      char general[200];
+      sprintf(general, "%d integers fixed and %d bounds tightened by root reduced costs (cutoff %g)",
+        numberFixed, numberTightened - numberFixed, cutoff);
+      messageHandler()->message(CBC_GENERAL, messages())
+        << general << CoinMessageEol;
+    }
+  }
+  return numberTightened;
+}
 // Collect coding to replace whichGenerator
 void CbcModel::resizeWhichGenerator(int numberNow, int numberAfter)
 {
@@ -7985,6 +9484,8 @@ void CbcModel::resizeWhichGenerator(int numberNow, int numberAfter)
   If numberTries == 0 then user did not want any cuts.
 */
 
+// Longest stall window for root cut loop
+#define CBC_MAXIMUM_STALL_WINDOW 20
 bool CbcModel::solveWithCuts(OsiCuts &cuts, int numberTries, CbcNode *node)
 /*
   Parameters:
@@ -7997,6 +9498,7 @@ bool CbcModel::solveWithCuts(OsiCuts &cuts, int numberTries, CbcNode *node)
 */
 
 {
+  CbcPhaseTimer cutsTimer(phaseTimes_, CbcPhaseTimes::cuts);
 #ifdef JJF_ZERO
   if (node && numberTries > 1) {
     if (currentDepth_ < 5)
@@ -8079,6 +9581,9 @@ bool CbcModel::solveWithCuts(OsiCuts &cuts, int numberTries, CbcNode *node)
       and rechecked immediately after the cut generation phase of the loop.
     */
   OsiCuts slackCuts;
+  // slack cuts of an earlier node never got to a cut pool
+  if (intParam_[CbcSubtreeCutPool])
+    subtreeSlackCuts_ = OsiCuts();
   /*
     lh:
       Resolve the problem
@@ -8099,6 +9604,9 @@ bool CbcModel::solveWithCuts(OsiCuts &cuts, int numberTries, CbcNode *node)
   if (node) {
     objectiveValue = node->objectiveValue();
   }
+  // price before anything uses LP as a bound
+  if (pricer_)
+    priceColumns(node);
   int save = moreSpecialOptions_;
   if ((moreSpecialOptions_ & 4194304) != 0)
     moreSpecialOptions_ |= 8388608;
@@ -8156,6 +9664,11 @@ bool CbcModel::solveWithCuts(OsiCuts &cuts, int numberTries, CbcNode *node)
     printf("ray exists\n");
   }
 #endif
+#endif
+#ifndef CONFLICT_CUTS
+  // if infeasible conflict from ray
+  if (!returnCode && (moreSpecialOptions_ & 4194304) != 0)
+    analyzeConflict(solver_);
 #endif
   double lastObjective = solver_->getObjValue() * solver_->getObjSense();
   cut_obj[CUT_HISTORY - 1] = lastObjective;
@@ -8483,6 +9996,21 @@ bool CbcModel::solveWithCuts(OsiCuts &cuts, int numberTries, CbcNode *node)
   bool increaseDrop = (moreSpecialOptions_ & 8192) != 0;
   for (int i = 0; i < numberCutGenerators_; i++)
     generator_[i]->setWhetherInMustCallAgainMode(false);
+  /*
+    Tailing off at root (CbcRootStallWindow) - bound, rows and wall clock
+    time after each pass for last stallWindow passes (first is before cuts).
+  */
+  int stallWindow = 0;
+  if (!node && !numberNodes_ && intParam_[CbcRootStallWindow] > 0)
+    stallWindow = CoinMin(intParam_[CbcRootStallWindow], CBC_MAXIMUM_STALL_WINDOW);
+  double stallObjective[CBC_MAXIMUM_STALL_WINDOW + 1];
+  int stallRows[CBC_MAXIMUM_STALL_WINDOW + 1];
+  double stallTime[CBC_MAXIMUM_STALL_WINDOW + 1];
+  int numberStallPasses = 1;
+  stallObjective[0] = startObjective;
+  stallRows[0] = solver_->getNumRows();
+  stallTime[0] = CoinGetTimeOfDay();
+  bool stalled = false;
   /*
       Begin cut generation loop. Cuts generated during each iteration are
       collected in theseCuts. The loop can be divided into four phases:
@@ -8497,6 +10025,11 @@ bool CbcModel::solveWithCuts(OsiCuts &cuts, int numberTries, CbcNode *node)
           does the necessary bookkeeping in the model.
     */
   do {
+    // another thread may have found a better solution
+    if (refreshPublishedCutoff() && solver_->getObjValue() * solver_->getObjSense() > getCutoff()) {
+      feasible = false;
+      break;
+    }
     currentPassNumber_++;
     numberTries--;
     if (numberTries < 0 && keepGoing) {
@@ -8517,6 +10050,25 @@ bool CbcModel::solveWithCuts(OsiCuts &cuts, int numberTries, CbcNode *node)
           useful.
         */
     int numberViolated = 0;
+    // activity of global cuts is by node
+    globalCuts_.setClock(numberNodes_);
+    // forget conflicts which have not been violated for a while
+    if (conflictAnalysis_ && currentPassNumber_ == 1 && numberNodes_ && (numberNodes_ % 1000) == 0)
+      conflictAnalysis_->age(globalCuts_, numberNodes_);
+    // keep global cuts within budget
+    if (currentPassNumber_ == 1 && numberNodes_ && (numberNodes_ % 100) == 0
+      && (intParam_[CbcMaximumGlobalCuts] > 0 || dblParam_[CbcMaximumGlobalCutBytes] > 0.0)) {
+      int numberEvicted = globalCuts_.evict(intParam_[CbcMaximumGlobalCuts],
+        dblParam_[CbcMaximumGlobalCutBytes], 100);
+      if (numberEvicted && handler_->logLevel() > 1) {
+        char general[200];
+        sprintf(general, "%d global cuts evicted at node %d - %d left",
+          numberEvicted, numberNodes_, globalCuts_.sizeRowCuts());
+        messageHandler()->message(CBC_GENERAL,
+          messages())
+          << general << CoinMessageEol;
+      }
+    }
     if ((currentPassNumber_ == 1 || !numberNodes_) && howOftenGlobalScan_ > 0 && (numberNodes_ % howOftenGlobalScan_) == 0 && (doCutsNow(1) || true)) {
       // global column cuts now done in node at top of tree
       int numberCuts = numberCutGenerators_ ? globalCuts_.sizeRowCuts() : 0;
@@ -8530,11 +10082,17 @@ bool CbcModel::solveWithCuts(OsiCuts &cuts, int numberTries, CbcNode *node)
                                     static_cast< CoinBigIndex >(2 * numberColumns))
           + 100;
         double *violations = new double[numberCuts];
+        double *efficacy = new double[numberCuts];
         int *which = new int[numberCuts];
+        // violations of all cuts in one pass over row copy
+        int numberFound = globalCuts_.violatedCuts(cbcColSolution_, 0.005,
+          which, violations, efficacy);
         int numberPossible = 0;
-        for (int i = 0; i < numberCuts; i++) {
+        for (int k = 0; k < numberFound; k++) {
+          int i = which[k];
           OsiRowCut *thisCut = globalCuts_.rowCutPtr(i);
-          double violation = thisCut->violated(cbcColSolution_);
+          double violation = violations[k];
+          double value = efficacy[k];
           if (thisCut->effectiveness() == COIN_DBL_MAX) {
             // see if already there
             int j;
@@ -8542,17 +10100,23 @@ bool CbcModel::solveWithCuts(OsiCuts &cuts, int numberTries, CbcNode *node)
               if (addedCuts_[j] == thisCut)
                 break;
             }
-            if (j == currentNumberCuts_)
+            if (j == currentNumberCuts_) {
               violation = COIN_DBL_MAX;
+              value = COIN_DBL_MAX;
+            }
             //else
             //printf("already done??\n");
           }
           if (violation > 0.005) {
-            violations[numberPossible] = -violation;
+            // most efficacious first
+            efficacy[numberPossible] = -value;
+            violations[numberPossible] = violation;
             which[numberPossible++] = i;
+            if (conflictAnalysis_ && globalCuts_.cut(i)->whichRow() == 1)
+              conflictAnalysis_->used(thisCut, numberNodes_);
           }
         }
-        CoinSort_2(violations, violations + numberPossible, which);
+        CoinSort_3(efficacy, efficacy + numberPossible, which, violations);
         for (int i = 0; i < numberPossible; i++) {
           int k = which[i];
           OsiRowCut *thisCut = globalCuts_.rowCutPtr(k);
@@ -8573,13 +10137,14 @@ bool CbcModel::solveWithCuts(OsiCuts &cuts, int numberTries, CbcNode *node)
 #else
           theseCuts.insert(thisCut);
 #endif
-          if (violations[i] != -COIN_DBL_MAX)
+          if (violations[i] != COIN_DBL_MAX)
             maximumAdd -= thisCut->row().getNumElements();
           if (maximumAdd < 0)
             break;
         }
         delete[] which;
         delete[] violations;
+        delete[] efficacy;
         numberGlobalViolations_ += numberViolated;
       }
     }
@@ -8709,14 +10274,30 @@ bool CbcModel::solveWithCuts(OsiCuts &cuts, int numberTries, CbcNode *node)
           threadMode with bit 2^1 set indicates we should use threads for root cut
           generation.
         */
-      if ((threadMode_ & 2) == 0 || numberNodes_) {
+      // one view of solution for all generators (and before cloning for threads)
+      separationContext()->build(solver_);
+#ifdef CBC_THREAD
+      // at tree nodes threads may be idle (CbcParallelTreeCuts)
+      CbcBaseModel *cutMaster = (numberNodes_ && node) ? treeCutMaster() : master;
+#endif
+      if (((threadMode_ & 2) == 0 || numberNodes_)
+#ifdef CBC_THREAD
+        && !(numberNodes_ && cutMaster)
+#endif
+      ) {
         status = serialCuts(theseCuts, node, slackCuts, lastNumberCuts);
       } else {
         // do cuts independently
 #ifdef CBC_THREAD
-        status = parallelCuts(master, theseCuts, node, slackCuts, lastNumberCuts);
+        // tree search is serial so numberThreads_ is zero there
+        int saveThreads = numberThreads_;
+        if (numberNodes_)
+          numberThreads_ = treeCutThreads_;
+        status = parallelCuts(cutMaster, theseCuts, node, slackCuts, lastNumberCuts);
+        numberThreads_ = saveThreads;
 #endif
       }
+      separationContext_->invalidate();
       // Do we need feasible and violated?
       feasible = (status >= 0);
       if (status == 1)
@@ -8743,7 +10324,7 @@ bool CbcModel::solveWithCuts(OsiCuts &cuts, int numberTries, CbcNode *node)
           continue;
         // see if heuristic will do anything
         double saveValue = heuristicValue;
-        int ifSol = heuristic_[i]->solution(heuristicValue,
+        int ifSol = heuristic_[i]->solutionWithStatistics(heuristicValue,
           newSolution);
         //theseCuts) ;
         if (ifSol > 0) {
@@ -8777,7 +10358,7 @@ bool CbcModel::solveWithCuts(OsiCuts &cuts, int numberTries, CbcNode *node)
       delete[] newSolution;
     }
     CbcEventHandler *eventHandler = getEventHandler();
-    if (eventHandler) {
+    if (eventHandler && eventHandler->wanted(CbcEventHandler::generatedCuts)) {
       // Massage cuts??
       // save appData
       void *saveAppData = getApplicationData();
@@ -8786,6 +10367,9 @@ bool CbcModel::solveWithCuts(OsiCuts &cuts, int numberTries, CbcNode *node)
       eventHandler->event(CbcEventHandler::generatedCuts);
       setApplicationData(saveAppData);
     }
+    // do not bloat solver with near parallel cuts
+    if (intParam_[CbcMaximumCutsPerRound] > 0)
+      selectCuts(theseCuts, intParam_[CbcMaximumCutsPerRound]);
 #ifdef JJF_ZERO
     // switch on to get all cuts printed
     theseCuts.printCuts();
@@ -9015,6 +10599,8 @@ bool CbcModel::solveWithCuts(OsiCuts &cuts, int numberTries, CbcNode *node)
       if (numberOldActiveCuts_ + numberNewCuts_
         && (numberNewCuts_ || doCutsNow(1))) {
         OsiCuts *saveCuts = node ? NULL : &slackCuts;
+        if (node && intParam_[CbcSubtreeCutPool] && !parallelMode())
+          saveCuts = &subtreeSlackCuts_;
         int nDel = takeOffCuts(cuts, resolveAfterTakeOffCuts_, saveCuts, numberToAdd, addCuts);
         if (nDel)
           lastNumberCuts2_ = 0;
@@ -9109,6 +10695,7 @@ bool CbcModel::solveWithCuts(OsiCuts &cuts, int numberTries, CbcNode *node)
 #endif
           }
         }
+        scheduleCutGenerators((cut_obj[CUT_HISTORY - 1] != -COIN_DBL_MAX) ? thisObj - cut_obj[CUT_HISTORY - 1] : 0.0);
         for (int j = 0; j < CUT_HISTORY - 1; j++)
           cut_obj[j] = cut_obj[j + 1];
         cut_obj[CUT_HISTORY - 1] = thisObj;
@@ -9121,6 +10708,37 @@ bool CbcModel::solveWithCuts(OsiCuts &cuts, int numberTries, CbcNode *node)
           && !keepGoing) {
           numberTries = 0;
         }
+        if (stallWindow && numberTries > 0 && !keepGoing) {
+          /*
+            Compare last stallWindow passes with whole loop - stalled if
+            they gave less than CbcRootStallGain of bound improvement so far
+            or less than half that share of LP growth or of time.
+          */
+          int k = numberStallPasses % (stallWindow + 1);
+          stallObjective[k] = thisObj;
+          stallRows[k] = solver_->getNumRows();
+          stallTime[k] = CoinGetTimeOfDay();
+          numberStallPasses++;
+          if (numberStallPasses > stallWindow) {
+            int kOld = numberStallPasses % (stallWindow + 1);
+            double total = CoinMax(thisObj - stallObjective[0], 1.0e-9 * (1.0 + fabs(thisObj)));
+            double gain = (thisObj - stallObjective[kOld]) / total;
+            double growth = static_cast< double >(stallRows[k] - stallRows[kOld]) / static_cast< double >(CoinMax(numberRowsAtContinuous_, 1));
+            double timeShare = (stallTime[k] - stallTime[kOld]) / CoinMax(stallTime[k] - stallTime[0], 1.0e-6);
+            if (gain < CoinMax(dblParam_[CbcRootStallGain], 0.5 * CoinMax(growth, timeShare))) {
+              stalled = true;
+              numberTries = 0;
+              if (handler_->logLevel() > 1) {
+                char general[200];
+                sprintf(general, "Root cuts stalled after %d passes - last %d gave %.2g of improvement for %.2g growth of rows and %.2g of time",
+                  currentPassNumber_, stallWindow, gain, growth, timeShare);
+                messageHandler()->message(CBC_GENERAL,
+                  messages())
+                  << general << CoinMessageEol;
+              }
+            }
+          }
+        }
         if (numberRowCuts + numberColumnCuts == 0 || (cutIterations == 0 && !allowZeroIterations)) {
           // maybe give it one more try
           if (numberLastAttempts > 2 || currentDepth_ || experimentBreak < 2)
@@ -9182,6 +10800,20 @@ bool CbcModel::solveWithCuts(OsiCuts &cuts, int numberTries, CbcNode *node)
     for (int i = 0; i < numberCutGenerators_; i++)
       generator_[i]->setSwitchedOff(false);
   }
+  // before branching drop cuts which do not hold up bound
+  if (stallWindow && feasible && !keepGoing) {
+    int numberDropped = dropNonBindingCuts(cuts);
+    if (numberDropped && handler_->logLevel() > 1) {
+      char general[200];
+      sprintf(general, "%d root cuts with zero dual dropped%s - %d left",
+        numberDropped, stalled ? " after stall" : "", cuts.sizeRowCuts());
+      messageHandler()->message(CBC_GENERAL,
+        messages())
+        << general << CoinMessageEol;
+    }
+    if (solver_->isDualObjectiveLimitReached() || !solver_->isProvenOptimal())
+      feasible = false;
+  }
   //check feasibility.
   //If solution seems to be integer feasible calling setBestSolution
   //will eventually add extra global cuts which we need to install at
@@ -9295,7 +10927,7 @@ bool CbcModel::solveWithCuts(OsiCuts &cuts, int numberTries, CbcNode *node)
           continue;
         // see if heuristic will do anything
         double saveValue = heuristicValue;
-        int ifSol = heuristic_[i]->solution(heuristicValue,
+        int ifSol = heuristic_[i]->solutionWithStatistics(heuristicValue,
           newSolution);
         if (ifSol > 0) {
           // better solution found
@@ -9848,6 +11480,7 @@ bool CbcModel::solveWithCuts(OsiCuts &cuts, int numberTries, CbcNode *node)
       int newFrequency = generator_[i]->howOften() % 1000000;
       // increment cut counts
       generator_[i]->incrementNumberCutsActive(count[i]);
+      generator_[i]->addDepthActive(0, count[i]);
       CglStored *stored = dynamic_cast< CglStored * >(generator_[i]->generator());
       if (stored && !generator_[i]->numberCutsInTotal())
         continue;
@@ -9981,8 +11614,10 @@ bool CbcModel::solveWithCuts(OsiCuts &cuts, int numberTries, CbcNode *node)
 #endif
           if (iGenerator >= 0)
             iGenerator = iGenerator % 10000;
-          if (iGenerator >= 0 && iGenerator < numberCutGenerators_)
+          if (iGenerator >= 0 && iGenerator < numberCutGenerators_) {
             generator_[iGenerator]->incrementNumberCutsActive();
+            generator_[iGenerator]->addDepthActive(CoinMax(currentDepth_, 1), 1);
+          }
         }
       }
     }
@@ -10064,6 +11699,25 @@ int CbcModel::serialCuts(OsiCuts &theseCuts, CbcNode *node, OsiCuts &slackCuts,
   int switchOff = (!doCutsNow(1) && !fullScan) ? 1 : 0;
   int status = 0;
   int i;
+  /*
+    Cuts from pools of subtrees above this node are much cheaper than
+    running expensive generators again - if any are violated skip
+    generators taking more than twice average time per call.
+  */
+  double expensiveTime = COIN_DBL_MAX;
+  if (node && intParam_[CbcSubtreeCutPool] && !parallelMode()
+    && scanSubtreeCutPools(node, theseCuts, lastNumberCuts)) {
+    double totalTime = 0.0;
+    int numberEntered = 0;
+    for (i = 0; i < numberCutGenerators_; i++) {
+      if (generator_[i]->numberTimesEntered()) {
+        totalTime += generator_[i]->scheduleTime() / generator_[i]->numberTimesEntered();
+        numberEntered++;
+      }
+    }
+    if (numberEntered)
+      expensiveTime = 2.0 * totalTime / numberEntered;
+  }
   for (i = 0; i < numberCutGenerators_ && (!this->maximumSecondsReached()) ; i++) {
     int numberRowCutsBefore = theseCuts.sizeRowCuts();
     int numberColumnCutsBefore = theseCuts.sizeColCuts();
@@ -10072,26 +11726,20 @@ int CbcModel::serialCuts(OsiCuts &theseCuts, CbcNode *node, OsiCuts &slackCuts,
     /*printf("GEN %d %s switches %d\n",
 	       i,generator_[i]->cutGeneratorName(),
 	       generator_[i]->switches());*/
-    bool generate = generator_[i]->normal();
-    // skip if not optimal and should be (maybe a cut generator has fixed variables)
-    if (generator_[i]->howOften() == -100 || (generator_[i]->needsOptimalBasis() && !solver_->basisIsAvailable())
-      || generator_[i]->switchedOff())
-      generate = false;
-    if (switchOff && !generator_[i]->mustCallAgain()) {
-      // switch off if default
-      if (generator_[i]->howOften() == 1 && generator_[i]->whatDepth() < 0) {
-        generate = false;
-      } else if (currentDepth_ > -10 && switchOff == 2) {
-        generate = false;
-      }
-    }
-    if (generator_[i]->whetherCallAtEnd())
+    bool generate = generatorWanted(i, switchOff);
+    // skip expensive ones if cut pools gave cuts
+    if (expensiveTime != COIN_DBL_MAX && generator_[i]->numberTimesEntered()
+      && generator_[i]->scheduleTime() > expensiveTime * generator_[i]->numberTimesEntered()
+      && !generator_[i]->mustCallAgain())
       generate = false;
     const OsiRowCutDebugger *debugger = NULL;
     bool onOptimalPath = false;
     if (generate) {
+      double time1 = CoinCpuTime();
       bool mustResolve = generator_[i]->generateCuts(theseCuts, fullScan, solver_, node);
       numberRowCutsAfter = theseCuts.sizeRowCuts();
+      generator_[i]->addScheduleCall(!numberNodes_, CoinCpuTime() - time1,
+        numberRowCutsAfter - numberRowCutsBefore);
       if (fullScan && generator_[i]->howOften() == 1000000 + SCANCUTS_PROBING) {
         CglProbing *probing = dynamic_cast< CglProbing * >(generator_[i]->generator());
         if (probing && (numberRowCutsBefore < numberRowCutsAfter || numberColumnCutsBefore < theseCuts.sizeColCuts())) {
@@ -10142,6 +11790,8 @@ int CbcModel::serialCuts(OsiCuts &theseCuts, CbcNode *node, OsiCuts &slackCuts,
 #endif
       if (mustResolve /*|| (specialOptions_&1) != 0*/) {
         int returnCode = resolve(node ? node->nodeInfo() : NULL, 2);
+        // solution has changed
+        separationContext()->build(solver_);
         if (returnCode == 0)
           status = -1;
         if (returnCode < 0 && !status)
@@ -10295,60 +11945,360 @@ int CbcModel::serialCuts(OsiCuts &theseCuts, CbcNode *node, OsiCuts &slackCuts,
   return status;
 }
 
+/* Drop new cuts with zero dual (solution stays optimal without them).
+   Cuts are only dropped if there are no old cuts from other nodes. */
 /*
-  Remove slack cuts. We obtain a basis and scan it. Cuts with basic slacks
-  are purged. If any cuts are purged, resolve() is called to restore the
-  solution held in the solver.	If resolve() pivots, there's the possibility
-  that a slack may be pivoted in (trust me :-), so the process iterates.
-  Setting allowResolve to false will suppress reoptimisation (but see note
-  below).
-
-  At the level of the solver's constraint system, loose cuts are really
-  deleted.  There's an implicit assumption that deleteRows will also update
-  the active basis in the solver.
-
-  At the level of nodes and models, it's more complicated.
-
-  New cuts exist only in the collection of cuts passed as a parameter. They
-  are deleted from the collection and that's the end of them.
-
-  Older cuts have made it into addedCuts_. Two separate actions are needed.
-  The reference count for the CbcCountRowCut object is decremented. If this
-  count falls to 0, the node which owns the cut is located, the reference to
-  the cut is removed, and then the cut object is destroyed (courtesy of the
-  CbcCountRowCut destructor). We also need to set the addedCuts_ entry to
-  NULL. This is important so that when it comes time to generate basis edits
-  we can tell this cut was dropped from the basis during processing of the
-  node.
-
-  NOTE: In general, it's necessary to call resolve() after purging slack
-	cuts.  Deleting constraints constitutes a change in the problem, and
-	an OSI is not required to maintain a valid solution when the problem
-	is changed. But ... it's really useful to maintain the active basis,
-	and the OSI is supposed to do that. (Yes, it's splitting hairs.) In
-	some places, it's possible to know that the solution will never be
-	consulted after this call, only the basis.  (E.g., this routine is
-	called as a last act before generating info to place the node in the
-	live set.) For such use, set allowResolve to false.
-
-  TODO: No real harm would be done if we just ignored the rare occasion when
-	the call to resolve() pivoted a slack back into the basis. It's a
-	minor inefficiency, at worst. But it does break assertions which
-	check that there are no loose cuts in the basis. It might be better
-	to remove the assertions.
+  Greedy choice of row cuts - best efficacy first, skipping any whose
+  cosine with a cut already chosen is more than CbcMaximumCutParallelism.
+  Order of kept cuts is not changed.  whichGenerator_ for new cuts is
+  set when they are added to solver so does not need to be moved.
 */
-
-int CbcModel::takeOffCuts(OsiCuts &newCuts,
-  bool allowResolve, OsiCuts *saveCuts,
-  int numberNewCuts, const OsiRowCut **addedCuts)
-
-{ // int resolveIterations = 0 ;
-  if ((moreSpecialOptions2_&524288)!=0)
+int CbcModel::selectCuts(OsiCuts &cuts, int maximumCuts)
+{
+  int numberCuts = cuts.sizeRowCuts();
+  if (numberCuts <= maximumCuts)
+    return 0;
+  int numberColumns = solver_->getNumCols();
+  double maximumParallelism = dblParam_[CbcMaximumCutParallelism];
+  const double *solution = cbcColSolution_;
+  double *score = new double[2 * numberCuts];
+  double *normInverse = score + numberCuts;
+  int *which = new int[2 * numberCuts];
+  int *chosen = which + numberCuts;
+  char *keep = new char[numberCuts];
+  int numberCandidates = 0;
+  int numberChosen = 0;
+  for (int k = 0; k < numberCuts; k++) {
+    const OsiRowCut *thisCut = cuts.rowCutPtr(k);
+    const CoinPackedVector &row = thisCut->row();
+    int n = row.getNumElements();
+    const int *column = row.getIndices();
+    const double *element = row.getElements();
+    double sum = 0.0;
+    double norm = 0.0;
+    for (int j = 0; j < n; j++) {
+      double value = element[j];
+      sum += value * solution[column[j]];
+      norm += value * value;
+    }
+    normInverse[k] = (norm > 1.0e-24) ? 1.0 / sqrt(norm) : 0.0;
+    if (thisCut->effectiveness() >= 1.0e20 || thisCut->lb() > thisCut->ub()) {
+      // must keep
+      keep[k] = 1;
+      chosen[numberChosen++] = k;
+    } else {
+      keep[k] = 0;
+      double violation = CoinMax(thisCut->lb() - sum, sum - thisCut->ub());
+      score[numberCandidates] = -CoinMax(violation, 0.0) * normInverse[k];
+      which[numberCandidates++] = k;
+    }
+  }
+  CoinSort_2(score, score + numberCandidates, which);
+  double *work = new double[numberColumns];
+  CoinZeroN(work, numberColumns);
+  for (int i = 0; i < numberCandidates && numberChosen < maximumCuts; i++) {
+    int k = which[i];
+    const CoinPackedVector &row = cuts.rowCutPtr(k)->row();
+    int n = row.getNumElements();
+    const int *column = row.getIndices();
+    const double *element = row.getElements();
+    for (int j = 0; j < n; j++)
+      work[column[j]] = element[j] * normInverse[k];
+    bool parallel = false;
+    for (int iChosen = 0; iChosen < numberChosen; iChosen++) {
+      int kChosen = chosen[iChosen];
+      const CoinPackedVector &rowChosen = cuts.rowCutPtr(kChosen)->row();
+      int nChosen = rowChosen.getNumElements();
+      const int *columnChosen = rowChosen.getIndices();
+      const double *elementChosen = rowChosen.getElements();
+      double dot = 0.0;
+      for (int j = 0; j < nChosen; j++)
+        dot += work[columnChosen[j]] * elementChosen[j];
+      if (fabs(dot) * normInverse[kChosen] > maximumParallelism) {
+        parallel = true;
+        break;
+      }
+    }
+    for (int j = 0; j < n; j++)
+      work[column[j]] = 0.0;
+    if (!parallel) {
+      keep[k] = 1;
+      chosen[numberChosen++] = k;
+    }
+  }
+  delete[] work;
+  int numberRemoved = 0;
+  for (int k = numberCuts - 1; k >= 0; k--) {
+    if (!keep[k]) {
+      cuts.eraseRowCut(k);
+      numberRemoved++;
+    }
+  }
+  delete[] score;
+  delete[] which;
+  delete[] keep;
+  if (numberRemoved && messageHandler()->logLevel() > 2) {
+    char general[200];
+    sprintf(general, "%d cuts kept out of %d after selection",
+      numberCuts - numberRemoved, numberCuts);
+    messageHandler()->message(CBC_GENERAL, messages())
+      << general << CoinMessageEol;
+  }
+  return numberRemoved;
+}
+int CbcModel::dropNonBindingCuts(OsiCuts &cuts)
+{
+  if (numberOldActiveCuts_ || numberNewCuts_ != cuts.sizeRowCuts())
+    return 0;
+  if ((moreSpecialOptions2_ & 524288) != 0)
     return 0; // leaving all root cuts
-  int numberDropped = 0;
-  int firstOldCut = numberRowsAtContinuous_;
-  int totalNumberCuts = numberNewCuts_ + numberOldActiveCuts_;
-  assert(numberRowsAtContinuous_ + totalNumberCuts == solver_->getNumRows());
+  int numberCuts = cuts.sizeRowCuts();
+  if (numberRowsAtContinuous_ + numberCuts != solver_->getNumRows())
+    return 0;
+  const double *dual = solver_->getRowPrice();
+  int *which = new int[numberCuts];
+  int numberDrop = 0;
+  int kCut = 0;
+  for (int i = 0; i < numberCuts; i++) {
+    int iRow = numberRowsAtContinuous_ + i;
+    if (fabs(dual[iRow]) < 1.0e-9 && cuts.rowCutPtr(i)->effectiveness() < 1.0e20)
+      which[numberDrop++] = i;
+    else
+      whichGenerator_[kCut++] = whichGenerator_[i];
+  }
+  if (numberDrop) {
+    int *rows = new int[numberDrop];
+    for (int k = 0; k < numberDrop; k++)
+      rows[k] = which[k] + numberRowsAtContinuous_;
+    solver_->deleteRows(numberDrop, rows);
+    delete[] rows;
+    for (int k = numberDrop - 1; k >= 0; k--)
+      cuts.eraseRowCut(which[k]);
+    numberNewCuts_ = cuts.sizeRowCuts();
+    // basis has lost tight rows so some pivots may be needed
+    resolve(solver_);
+    setPointers(solver_);
+  }
+  delete[] which;
+  return numberDrop;
+}
+// Whether generator should be called in serialCuts (or in parallelCuts in tree)
+bool CbcModel::generatorWanted(int iGenerator, int switchOff) const
+{
+  CbcCutGenerator *generator = generator_[iGenerator];
+  bool generate = generator->normal();
+  // skip if not optimal and should be (maybe a cut generator has fixed variables)
+  if (generator->howOften() == -100 || (generator->needsOptimalBasis() && !solver_->basisIsAvailable())
+    || generator->switchedOff())
+    generate = false;
+  if (switchOff && !generator->mustCallAgain()) {
+    // switch off if default
+    if (generator->howOften() == 1 && generator->whatDepth() < 0) {
+      generate = false;
+    } else if (currentDepth_ > -10 && switchOff == 2) {
+      generate = false;
+    }
+  }
+  if (generator->whetherCallAtEnd())
+    generate = false;
+  // skip if schedule has switched off for a while
+  if (numberNodes_ && intParam_[CbcAdaptiveCuts] && generator->scheduledOff(numberNodes_)
+    && !generator->mustCallAgain())
+    generate = false;
+  return generate;
+}
+#ifdef CBC_THREAD
+/* Threads for cuts at tree nodes (NULL if not wanted).  branchAndBound
+   has kept threads in treeCutThreads_ and does tree search serially. */
+CbcBaseModel *CbcModel::treeCutMaster()
+{
+  if (!treeCutThreads_ || masterThread_)
+    return NULL;
+  if (!treeCutMaster_) {
+    // thread models are copies so need number of threads
+    numberThreads_ = treeCutThreads_;
+    treeCutMaster_ = new CbcBaseModel(*this, -1);
+    numberThreads_ = 0;
+  }
+  return treeCutMaster_;
+}
+#endif
+// Add violated cuts from subtree cut pools above node
+int CbcModel::scanSubtreeCutPools(CbcNode *node, OsiCuts &theseCuts, int lastNumberCuts)
+{
+  double primalTolerance;
+  solver_->getDblParam(OsiPrimalTolerance, primalTolerance);
+  double tolerance = 100.0 * primalTolerance;
+  // same cut may be in pools of node and of its parent
+  CbcRowCuts uniqueCuts;
+  int numberAdded = 0;
+  for (CbcNodeInfo *info = node->nodeInfo(); info; info = info->parent()) {
+    CbcRowCuts *pool = info->cutPool();
+    int numberCuts = pool ? pool->sizeRowCuts() : 0;
+    if (!numberCuts)
+      continue;
+    int *which = new int[numberCuts];
+    double *violation = new double[2 * numberCuts];
+    double *efficacy = violation + numberCuts;
+    pool->setClock(numberNodes_);
+    int numberViolated = pool->violatedCuts(cbcColSolution_, tolerance,
+      which, violation, efficacy);
+    int numberOld = theseCuts.sizeRowCuts() + lastNumberCuts;
+    resizeWhichGenerator(numberOld, numberOld + numberViolated);
+    for (int k = 0; k < numberViolated; k++) {
+      if (violation[k] <= tolerance)
+        continue;
+      const OsiRowCut *thisCut = pool->cut(which[k]);
+      if (uniqueCuts.addCutIfNotDuplicate(*thisCut))
+        continue;
+      whichGenerator_[numberOld++] = 20097;
+      theseCuts.insert(*thisCut);
+      numberAdded++;
+    }
+    delete[] which;
+    delete[] violation;
+  }
+  if (numberAdded && handler_->logLevel() > 2)
+    printf("%d cuts from subtree cut pools at node %d\n", numberAdded, numberNodes_);
+  return numberAdded;
+}
+// Put cuts of node in cut pool of its info and move up ones both children have
+void CbcModel::addToSubtreeCutPool(CbcNodeInfo *info, const OsiCuts &cuts)
+{
+  int maximumCuts = intParam_[CbcSubtreeCutPool];
+  /* Children of a two way branch cover their parent so a cut valid for
+     both is valid for parent.  Not true with symmetry as children
+     may have been cut down. */
+  bool canPromote = !symmetryInfo_ && !rootSymmetryInfo_;
+  CbcRowCuts *pool = info->cutPool(true);
+  for (int iPass = 0; iPass < 2; iPass++) {
+    const OsiCuts &theseCuts = iPass ? subtreeSlackCuts_ : cuts;
+    int numberCuts = theseCuts.sizeRowCuts();
+    for (int i = 0; i < numberCuts; i++) {
+      const OsiRowCut *thisCut = theseCuts.rowCutPtr(i);
+      // global cuts are in global cut pool already
+      if (thisCut->globallyValid())
+        continue;
+      if (pool->sizeRowCuts() >= maximumCuts)
+        break;
+      // each cut reaches a pool (and so is reported) only once
+      if (pool->addCutIfNotDuplicate(*thisCut) || !canPromote)
+        continue;
+      CbcNodeInfo *child = info;
+      while (true) {
+        CbcNodeInfo *parent = child->parent();
+        if (!parent || !parent->owner() || parent->owner()->numberBranches() != 2)
+          break;
+        CbcRowCuts *reported = parent->childCuts(true);
+        if (reported->sizeRowCuts() >= maximumCuts || reported->addCutIfNotDuplicate(*thisCut) != 1)
+          break;
+        // both children have it
+        if (parent == topOfTree_) {
+          OsiRowCut newCut(*thisCut);
+          newCut.setGloballyValid(true);
+          newCut.mutableRow().setTestForDuplicateIndex(false);
+          globalCuts_.addCutIfNotDuplicate(newCut);
+          break;
+        }
+        CbcRowCuts *parentPool = parent->cutPool(true);
+        if (parentPool->sizeRowCuts() >= maximumCuts || parentPool->addCutIfNotDuplicate(*thisCut))
+          break;
+        child = parent;
+      }
+    }
+  }
+  subtreeSlackCuts_ = OsiCuts();
+}
+// Share improvement from pass of cuts among generators and maybe back off
+void CbcModel::scheduleCutGenerators(double improvement)
+{
+  bool atRoot = !numberNodes_;
+  int totalCuts = 0;
+  for (int i = 0; i < numberCutGenerators_; i++)
+    totalCuts += generator_[i]->numberPassCuts();
+  improvement = CoinMax(improvement, 0.0);
+  for (int i = 0; i < numberCutGenerators_; i++)
+    generator_[i]->addScheduleImprovement(atRoot, improvement, totalCuts);
+  if (atRoot || !intParam_[CbcAdaptiveCuts])
+    return;
+  double bestRate = 0.0;
+  for (int i = 0; i < numberCutGenerators_; i++)
+    bestRate = CoinMax(bestRate, generator_[i]->windowRate());
+  for (int i = 0; i < numberCutGenerators_; i++) {
+    CbcCutGenerator *generator = generator_[i];
+    int decision = generator->schedule(numberNodes_, bestRate);
+    if (decision && handler_->logLevel() > 1) {
+      char general[200];
+      if (decision == 1)
+        sprintf(general, "Cut generator %d (%s) not worth its time (%g per second in tree) - off until node %d",
+          i, generator->cutGeneratorName(), generator->treeRate(),
+          generator->nextScheduledTry());
+      else
+        sprintf(general, "Cut generator %d (%s) worth its time again - back on",
+          i, generator->cutGeneratorName());
+      messageHandler()->message(CBC_GENERAL,
+        messages())
+        << general << CoinMessageEol;
+    }
+  }
+}
+
+/*
+  Remove slack cuts. We obtain a basis and scan it. Cuts with basic slacks
+  are purged. If any cuts are purged, resolve() is called to restore the
+  solution held in the solver.	If resolve() pivots, there's the possibility
+  that a slack may be pivoted in (trust me :-), so the process iterates.
+  Setting allowResolve to false will suppress reoptimisation (but see note
+  below).
+
+  At the level of the solver's constraint system, loose cuts are really
+  deleted.  There's an implicit assumption that deleteRows will also update
+  the active basis in the solver.
+
+  At the level of nodes and models, it's more complicated.
+
+  New cuts exist only in the collection of cuts passed as a parameter. They
+  are deleted from the collection and that's the end of them.
+
+  Older cuts have made it into addedCuts_. Two separate actions are needed.
+  The reference count for the CbcCountRowCut object is decremented. If this
+  count falls to 0, the node which owns the cut is located, the reference to
+  the cut is removed, and then the cut object is destroyed (courtesy of the
+  CbcCountRowCut destructor). We also need to set the addedCuts_ entry to
+  NULL. This is important so that when it comes time to generate basis edits
+  we can tell this cut was dropped from the basis during processing of the
+  node.
+
+  NOTE: In general, it's necessary to call resolve() after purging slack
+	cuts.  Deleting constraints constitutes a change in the problem, and
+	an OSI is not required to maintain a valid solution when the problem
+	is changed. But ... it's really useful to maintain the active basis,
+	and the OSI is supposed to do that. (Yes, it's splitting hairs.) In
+	some places, it's possible to know that the solution will never be
+	consulted after this call, only the basis.  (E.g., this routine is
+	called as a last act before generating info to place the node in the
+	live set.) For such use, set allowResolve to false.
+
+  TODO: No real harm would be done if we just ignored the rare occasion when
+	the call to resolve() pivoted a slack back into the basis. It's a
+	minor inefficiency, at worst. But it does break assertions which
+	check that there are no loose cuts in the basis. It might be better
+	to remove the assertions.
+*/
+
+// Least number of aged cuts taken off together (CbcSlackCutNodes)
+#define CBC_SLACK_CUT_BATCH 10
+int CbcModel::takeOffCuts(OsiCuts &newCuts,
+  bool allowResolve, OsiCuts *saveCuts,
+  int numberNewCuts, const OsiRowCut **addedCuts)
+
+{ // int resolveIterations = 0 ;
+  if ((moreSpecialOptions2_&524288)!=0)
+    return 0; // leaving all root cuts
+  int numberDropped = 0;
+  int firstOldCut = numberRowsAtContinuous_;
+  int totalNumberCuts = numberNewCuts_ + numberOldActiveCuts_;
+  assert(numberRowsAtContinuous_ + totalNumberCuts == solver_->getNumRows());
   int *solverCutIndices = new int[totalNumberCuts];
   int *newCutIndices = new int[numberNewCuts_];
   const CoinWarmStartBasis *ws;
@@ -10362,6 +12312,7 @@ int CbcModel::takeOffCuts(OsiCuts &newCuts,
     problemStatus = clpSolver->getModelPtr()->status();
 #endif
   bool needPurge = true;
+  bool firstPass = true;
   /*
       The outer loop allows repetition of purge in the event that reoptimisation
       changes the basis. To start an iteration, clear the deletion counts and grab
@@ -10382,21 +12333,56 @@ int CbcModel::takeOffCuts(OsiCuts &newCuts,
         */
     int oldCutIndex = 0;
     if (numberOldActiveCuts_) {
+      // get solution arrays once rather than for every cut
+      const double *rowActivity = solver_->getRowActivity();
+      const double *rowLower = solver_->getRowLower();
+      const double *rowUpper = solver_->getRowUpper();
+      double primalTolerance;
+      solver_->getDblParam(OsiPrimalTolerance, primalTolerance);
       lockThread();
+      /*
+            With CbcSlackCutNodes old cuts are aged - a cut is only taken off
+            once its slack has been basic at that many nodes running, and
+            then only if enough cuts have aged to make a batch worth while
+            (otherwise all stay).  New cuts of this node go at once.
+          */
+      int slackNodes = intParam_[CbcSlackCutNodes];
+      if (slackNodes > 0) {
+        int numberAged = 0;
+        int iCut = 0;
+        for (i = 0; i < numberOldActiveCuts_; i++) {
+          while (!addedCuts_[iCut])
+            iCut++;
+          CbcCountRowCut *cut = addedCuts_[iCut++];
+          if (ws->getArtifStatus(i + firstOldCut) == CoinWarmStartBasis::basic) {
+            if (firstPass)
+              cut->setNumberSlack(cut->numberSlack() + 1);
+            if (cut->numberSlack() > slackNodes)
+              numberAged++;
+          } else if (firstPass) {
+            cut->setNumberSlack(0);
+          }
+        }
+        if (numberAged < CoinMax(CBC_SLACK_CUT_BATCH, numberOldActiveCuts_ / 10))
+          slackNodes = COIN_INT_MAX;
+      } else {
+        slackNodes = -1;
+      }
       for (i = 0; i < numberOldActiveCuts_; i++) {
         status = ws->getArtifStatus(i + firstOldCut);
         while (!addedCuts_[oldCutIndex])
           oldCutIndex++;
         assert(oldCutIndex < currentNumberCuts_);
         // always leave if from nextRowCut_
-        if (status == CoinWarmStartBasis::basic && (addedCuts_[oldCutIndex]->effectiveness() <= 1.0e10 || addedCuts_[oldCutIndex]->canDropCut(solver_, i + firstOldCut))) {
+        if (status == CoinWarmStartBasis::basic && (addedCuts_[oldCutIndex]->effectiveness() <= 1.0e10 || addedCuts_[oldCutIndex]->canDropCut(rowActivity, rowLower, rowUpper, primalTolerance, i + firstOldCut)) && addedCuts_[oldCutIndex]->numberSlack() > slackNodes) {
           solverCutIndices[numberOldToDelete++] = i + firstOldCut;
           if (saveCuts) {
             // send to cut pool
             OsiRowCut *slackCut = addedCuts_[oldCutIndex];
             if (slackCut->effectiveness() != -1.234) {
               slackCut->setEffectiveness(-1.234);
-              slackCut->setGloballyValid();
+              if (saveCuts != &subtreeSlackCuts_)
+                slackCut->setGloballyValid();
               saveCuts->insert(*slackCut);
             }
           }
@@ -10454,6 +12440,7 @@ int CbcModel::takeOffCuts(OsiCuts &newCuts,
     }
     numberNewCuts = 0;
     numberNewCuts_ = newCuts.sizeRowCuts();
+    firstPass = false;
     delete ws;
     for (i = numberNewToDelete - 1; i >= 0; i--) {
       int iCut = newCutIndices[i];
@@ -10462,7 +12449,9 @@ int CbcModel::takeOffCuts(OsiCuts &newCuts,
         OsiRowCut *slackCut = newCuts.rowCutPtrAndZap(iCut);
         if (slackCut->effectiveness() != -1.234) {
           slackCut->setEffectiveness(-1.234);
-          slackCut->setGloballyValid();
+          // cuts for a subtree cut pool may be only locally valid
+          if (saveCuts != &subtreeSlackCuts_)
+            slackCut->setGloballyValid();
           saveCuts->insert(slackCut);
         } else {
           delete slackCut;
@@ -10531,11 +12520,327 @@ int CbcModel::takeOffCuts(OsiCuts &newCuts,
     0:	infeasible
    -1:	feasible and finished (do no more work on this subproblem)
 */
+// What startup heuristics need (may be on thread)
+typedef struct {
+  CbcModel *model;
+  double *solution;
+  double solutionValue;
+  int found; // heuristic which found last solution (+1)
+} CbcStartupInfo;
+// Run all heuristics of a copy of model
+static void *doStartupHeuristics(void *voidInfo)
+{
+  CbcStartupInfo *info = reinterpret_cast< CbcStartupInfo * >(voidInfo);
+  CbcModel *model = info->model;
+  for (int i = 0; i < model->numberHeuristics(); i++) {
+    if (model->heuristic(i)->solution(info->solutionValue, info->solution) > 0)
+      info->found = i + 1;
+  }
+  return NULL;
+}
+// Add startup heuristic which (0 fix and propagate, 1 and 2 greedy) if it can run
+static bool addStartupHeuristic(CbcModel *model, int which)
+{
+  if (which == 0) {
+    CbcHeuristicFixPropagate heuristicFixPropagate(*model);
+    model->addHeuristic(&heuristicFixPropagate);
+    return true;
+  } else if (which == 1) {
+    CbcHeuristicGreedyCover heuristicGreedyCover(*model);
+    heuristicGreedyCover.validate();
+    if (!heuristicGreedyCover.when())
+      return false;
+    model->addHeuristic(&heuristicGreedyCover);
+    return true;
+  } else {
+    CbcHeuristicGreedyEquality heuristicGreedyEquality(*model);
+    heuristicGreedyEquality.validate();
+    if (!heuristicGreedyEquality.when())
+      return false;
+    model->addHeuristic(&heuristicGreedyEquality);
+    return true;
+  }
+}
+#define CBC_STARTUP_HEURISTICS 3
+/*
+  Heuristics which need no LP solution (fix and propagate on locks and
+  greedy) are run on a copy of model before initial LP, or on a thread
+  while it is being solved with CbcStartupHeuristics 2.  With 3 each
+  heuristic has its own copy and they race on threads before the LP.
+  Any solution is given to model as soon as heuristics (and LP if on
+  thread) are done so event handler hears of it.
+*/
+bool CbcModel::resolveWithStartupHeuristics()
+{
+  int mode = intParam_[CbcStartupHeuristics];
+  CbcThreadPool *pool = NULL;
+  if (mode == 2)
+    pool = threadPool(1);
+  else if (mode > 2 && numberThreads_)
+    pool = threadPool(CBC_STARTUP_HEURISTICS);
+  // one copy - or one for each heuristic if racing
+  CbcModel *newModel[CBC_STARTUP_HEURISTICS];
+  int numberModels = 0;
+  for (int which = 0; which < CBC_STARTUP_HEURISTICS; which++) {
+    if (!numberModels || (mode > 2 && pool && newModel[numberModels - 1]->numberHeuristics())) {
+      CbcModel *model = copyWithoutHeuristics();
+      if (!model->continuousSolver_)
+        model->continuousSolver_ = solver_->clone();
+      model->numberThreads_ = 0;
+      model->intParam_[CbcStartupHeuristics] = 0;
+      newModel[numberModels++] = model;
+    }
+    addStartupHeuristic(newModel[numberModels - 1], which);
+  }
+  if (!newModel[numberModels - 1]->numberHeuristics() && numberModels > 1)
+    delete newModel[--numberModels];
+  int numberColumns = solver_->getNumCols();
+  CbcStartupInfo info[CBC_STARTUP_HEURISTICS];
+  for (int i = 0; i < numberModels; i++) {
+    info[i].model = newModel[i];
+    info[i].solution = new double[numberColumns];
+    info[i].solutionValue = getCutoff();
+    info[i].found = 0;
+  }
+  bool feasible = true;
+  bool resolved = false;
+  if (pool && mode == 2) {
+    pool->start(doStartupHeuristics, 1, info, static_cast< int >(sizeof(CbcStartupInfo)));
+    feasible = resolve(NULL, 0) != 0;
+    resolved = true;
+    pool->wait();
+  } else if (pool && numberModels > 1) {
+    pool->run(doStartupHeuristics, numberModels, info, static_cast< int >(sizeof(CbcStartupInfo)));
+  } else {
+    for (int i = 0; i < numberModels; i++)
+      doStartupHeuristics(info + i);
+  }
+  // best of copies
+  int best = -1;
+  for (int i = 0; i < numberModels; i++) {
+    if (info[i].found && info[i].solutionValue < getCutoff()
+      && (best < 0 || info[i].solutionValue < info[best].solutionValue))
+      best = i;
+  }
+  if (best >= 0) {
+    CbcHeuristic *saveHeuristic = lastHeuristic_;
+    lastHeuristic_ = newModel[best]->heuristic(info[best].found - 1);
+    setBestSolution(CBC_ROUNDING, info[best].solutionValue, info[best].solution);
+    lastHeuristic_ = saveHeuristic;
+  }
+  for (int i = 0; i < numberModels; i++) {
+    delete[] info[i].solution;
+    delete newModel[i];
+  }
+  if (!resolved)
+    feasible = resolve(NULL, 0) != 0;
+  return feasible;
+}
+/*
+  Fractional dive from root LP solution within part of time left and
+  few iterations (CbcFirstFeasible).  Solution is given to model at once.
+*/
+bool CbcModel::quickDive()
+{
+  CbcHeuristicDiveFractional heuristic(*this);
+  heuristic.setHeuristicName("QuickDive");
+  if (dblParam_[CbcMaximumSeconds] < 1.0e10)
+    heuristic.setMaxTime(CoinMax(0.5 * (dblParam_[CbcMaximumSeconds] - getCurrentSeconds()), 0.0));
+  int numberRows = solver_->getNumRows();
+  heuristic.setMaxSimplexIterationsAtRoot(CoinMax(2 * numberRows, 1000));
+  int numberColumns = solver_->getNumCols();
+  double *newSolution = new double[numberColumns];
+  double heuristicValue = getCutoff();
+  bool found = heuristic.solution(heuristicValue, newSolution) > 0;
+  if (found) {
+    CbcHeuristic *saveHeuristic = lastHeuristic_;
+    lastHeuristic_ = &heuristic;
+    setBestSolution(CBC_ROUNDING, heuristicValue, newSolution);
+    lastHeuristic_ = saveHeuristic;
+  }
+  delete[] newSolution;
+  return found;
+}
+/*
+  Keep activities of original rows in step with bounds of solver and
+  tighten bounds from rows touched by changes since last node.
+*/
+bool CbcModel::propagateNode()
+{
+  int numberColumns = solver_->getNumCols();
+  if (!nodePropagator_) {
+    // only original rows - cuts may be local
+    if (!continuousSolver_ || continuousSolver_->getNumRows() != numberRowsAtContinuous_
+      || continuousSolver_->getNumCols() != numberColumns)
+      return true;
+    nodePropagator_ = new CbcBoundPropagator(continuousSolver_);
+  }
+  if (nodePropagator_->numberColumns() != numberColumns)
+    return true;
+  const double *lower = solver_->getColLower();
+  const double *upper = solver_->getColUpper();
+  CbcImplicationGraph *graph = implicationGraph_;
+  if (graph && (graph->numberColumns() != numberColumns || !graph->finished()))
+    graph = NULL;
+  int *seeds = NULL;
+  int numberSeeds = 0;
+  if (graph) {
+    // changes since last node are not on trail after setBounds
+    const double *oldLower = nodePropagator_->lower();
+    const double *oldUpper = nodePropagator_->upper();
+    seeds = new int[numberColumns];
+    for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+      if (lower[iColumn] != oldLower[iColumn] || upper[iColumn] != oldUpper[iColumn])
+        seeds[numberSeeds++] = iColumn;
+    }
+  }
+  nodePropagator_->setBounds(lower, upper);
+  bool feasible = nodePropagator_->propagate() >= 0;
+  CbcCliqueTable *table = feasible ? cliqueTable() : NULL;
+  if (table && table->numberColumns() != numberColumns)
+    table = NULL;
+  if (feasible && (orbitope_ || table || graph)) {
+    // fixes from implications, cliques or lexicographic order may give more from rows
+    int mark = 0;
+    for (int iPass = 0; iPass < 10; iPass++) {
+      int numberFixed = 0;
+      if (graph) {
+        // cliques are done with implications so chains go through both
+        int n = graph->propagate(*nodePropagator_, mark, table, numberSeeds, seeds);
+        numberSeeds = 0;
+        if (n < 0) {
+          feasible = false;
+          break;
+        }
+        numberFixed += n;
+      } else if (table) {
+        int n = table->propagate(*nodePropagator_, mark);
+        if (n < 0) {
+          feasible = false;
+          break;
+        }
+        numberFixed += n;
+      }
+      if (orbitope_) {
+        int n = orbitope_->propagate(*nodePropagator_);
+        if (n < 0) {
+          feasible = false;
+          break;
+        }
+        numberFixed += n;
+      }
+      if (!numberFixed)
+        break;
+      mark = nodePropagator_->mark();
+      if (nodePropagator_->propagate() < 0) {
+        feasible = false;
+        break;
+      }
+    }
+  }
+  delete[] seeds;
+  if (!feasible)
+    return false;
+  const double *newLower = nodePropagator_->lower();
+  const double *newUpper = nodePropagator_->upper();
+  int numberChanges = nodePropagator_->mark();
+  for (int i = 0; i < numberChanges; i++) {
+    int iColumn = nodePropagator_->changedColumn(i);
+    if (newLower[iColumn] > lower[iColumn])
+      solver_->setColLower(iColumn, newLower[iColumn]);
+    if (newUpper[iColumn] < upper[iColumn])
+      solver_->setColUpper(iColumn, newUpper[iColumn]);
+  }
+  return true;
+}
+
+// Clique table (built when first asked for)
+CbcCliqueTable *CbcModel::cliqueTable()
+{
+  if (!cliqueTable_) {
+    OsiSolverInterface *solver = continuousSolver_ ? continuousSolver_ : solver_;
+    if (!solver)
+      return NULL;
+    cliqueTable_ = new CbcCliqueTable(solver);
+    cliqueTable_->addCliques(this);
+    cliqueTable_->finish();
+    if (cliqueTable_->numberCliques()) {
+      char general[200];
+      sprintf(general, "Clique table has %d cliques", cliqueTable_->numberCliques());
+      messageHandler()->message(CBC_GENERAL, messages())
+        << general << CoinMessageEol;
+    }
+  }
+  return cliqueTable_->numberCliques() ? cliqueTable_ : NULL;
+}
+
+// Add implication
+void CbcModel::addImplication(int iColumn, int value, int jColumn, double bound, bool upper)
+{
+  int numberColumns = solver_->getNumCols();
+  if (implicationGraph_ && implicationGraph_->numberColumns() != numberColumns) {
+    // for some other problem
+    delete implicationGraph_;
+    implicationGraph_ = NULL;
+  }
+  if (!implicationGraph_)
+    implicationGraph_ = new CbcImplicationGraph(numberColumns);
+  implicationGraph_->addImplication(CbcCliqueTable::literal(iColumn, value),
+    jColumn, bound, upper);
+}
+
+/*
+  Put implications found by probing at root into implication graph so
+  they are applied as bounds at nodes (implication cuts only help LP).
+  Entries from toZero[i] to toOne[i] follow from integer i at zero and
+  from toOne[i] to toZero[i+1] from it at one.
+*/
+void CbcModel::addProbingImplications()
+{
+  int numberColumns = solver_->getNumCols();
+  if (implicationGraph_ && implicationGraph_->numberColumns() != numberColumns)
+    return;
+  int number01 = probingInfo_->numberIntegers();
+  const CliqueEntry *entry = probingInfo_->fixEntries();
+  const int *toZero = probingInfo_->toZero();
+  const int *toOne = probingInfo_->toOne();
+  const int *integerVariable = probingInfo_->integerVariable();
+  if (!toZero[number01])
+    return;
+  if (!implicationGraph_)
+    implicationGraph_ = new CbcImplicationGraph(numberColumns);
+  int numberBefore = implicationGraph_->numberImplications();
+  for (int i = 0; i < number01; i++) {
+    int iColumn = integerVariable[i];
+    for (int j = toZero[i]; j < toZero[i + 1]; j++) {
+      int value = (j < toOne[i]) ? 0 : 1;
+      int k = sequenceInCliqueEntry(entry[j]);
+      if (k >= number01)
+        continue;
+      int jColumn = integerVariable[k];
+      if (oneFixesInCliqueEntry(entry[j]))
+        implicationGraph_->addImplication(CbcCliqueTable::literal(iColumn, value),
+          jColumn, 1.0, false);
+      else
+        implicationGraph_->addImplication(CbcCliqueTable::literal(iColumn, value),
+          jColumn, 0.0, true);
+    }
+  }
+  implicationGraph_->finish();
+  char general[200];
+  sprintf(general, "Implication graph has %d implications (%d from probing)",
+    implicationGraph_->numberImplications(),
+    implicationGraph_->numberImplications() - numberBefore);
+  messageHandler()->message(CBC_GENERAL, messages())
+    << general << CoinMessageEol;
+}
+
 int CbcModel::resolve(CbcNodeInfo *parent, int whereFrom,
   double *saveSolution,
   double *saveLower,
   double *saveUpper)
 {
+  CbcPhaseTimer lpTimer(phaseTimes_, CbcPhaseTimes::solveLP);
 #ifdef CBC_STATISTICS
   void cbc_resolve_check(const OsiSolverInterface *solver);
   cbc_resolve_check(solver_);
@@ -10579,6 +12884,10 @@ int CbcModel::resolve(CbcNodeInfo *parent, int whereFrom,
       careful --- where the objective takes on integral values, we may want to keep
       a solution where the objective is right on the cutoff.
     */
+  // propagate branch before LP - node may die here
+  if (feasible && parent && whereFrom == 1 && (intParam_[CbcNodePropagation] || orbitope_
+        || (implicationGraph_ && implicationGraph_->numberColumns() == solver_->getNumCols())))
+    feasible = propagateNode();
   if (feasible) {
     int nTightened = 0;
 #ifdef CBC_HAS_CLP
@@ -10605,7 +12914,19 @@ int CbcModel::resolve(CbcNodeInfo *parent, int whereFrom,
     }
 #endif
     if (nTightened >= 0) {
+#ifdef CBC_HAS_CLP
+      // factorization put in by addCuts can be used (CbcFactorizationMemory)
+      bool keepFactorization = clpSolver && factorizationCache_
+        && factorizationCache_->takeInstalled();
+      int saveClpOptions = keepFactorization ? clpSolver->specialOptions() : 0;
+      if (keepFactorization)
+        clpSolver->setSpecialOptions(saveClpOptions | 8);
+#endif
       resolve(solver_);
+#ifdef CBC_HAS_CLP
+      if (keepFactorization)
+        clpSolver->setSpecialOptions(saveClpOptions);
+#endif
       numberIterations_ += solver_->getIterationCount();
       feasible = (solver_->isProvenOptimal() && !solver_->isDualObjectiveLimitReached());
       if (feasible) {
@@ -11202,6 +13523,184 @@ CbcModel::findCliques(bool makeEquality,
     return this;
   }
 }
+// Delete pseudo shadow price cache
+void CbcModel::deleteShadowCache()
+{
+  delete[] shadowCache_;
+  shadowCache_ = NULL;
+  delete shadowRowCopy_;
+  shadowRowCopy_ = NULL;
+  shadowUpdates_ = 0;
+}
+// Resolves to measure each dual pricing with (adaptDualPricing)
+#define CBC_PRICING_TRIAL 50
+// Put back normal dual pricing if Dantzig was chosen
+void CbcModel::restoreDualPricing(OsiClpSolverInterface *clpSolver)
+{
+#ifdef CBC_HAS_CLP
+  if (savedDualPivot_ && clpSolver) {
+    // model may have changed
+    savedDualPivot_->setModel(NULL);
+    clpSolver->getModelPtr()->setDualRowPivotAlgorithm(*savedDualPivot_);
+  }
+#endif
+  delete savedDualPivot_;
+  savedDualPivot_ = NULL;
+  for (int i = 0; i < 2; i++) {
+    pricingSeconds_[i] = 0.0;
+    pricingIterations_[i] = 0.0;
+    pricingSolves_[i] = 0;
+  }
+  pricingState_ = 0;
+  pricingCountdown_ = CBC_PRICING_TRIAL;
+  pricingPeriod_ = 500;
+}
+// Resolves to measure algorithm not normally chosen with (per situation)
+#define CBC_ALGORITHM_TRIAL 8
+// Forget iterations of resolves (new search)
+void CbcModel::resetResolveAlgorithm()
+{
+  resolveRows_ = -1;
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 2; j++) {
+      algorithmIterations_[i][j] = 0.0;
+      algorithmSolves_[i][j] = 0;
+    }
+    algorithmCountdown_[i] = 4;
+  }
+}
+// Choose primal or dual for resolve in tree
+int CbcModel::chooseResolveAlgorithm(int situation)
+{
+  const double *iterations = algorithmIterations_[situation];
+  const int *solves = algorithmSolves_[situation];
+  int best = 0;
+  // primal must be clearly better as dual stops at cutoff
+  if (solves[0] && solves[1]
+    && iterations[1] * solves[0] < 0.8 * iterations[0] * solves[1])
+    best = 1;
+  if (--algorithmCountdown_[situation] > 0)
+    return best;
+  // try other - often until it has been measured enough
+  algorithmCountdown_[situation] = (solves[1 - best] < CBC_ALGORITHM_TRIAL) ? 8 : 200;
+  return 1 - best;
+}
+// Record iterations of resolve in situation with algorithm
+void CbcModel::recordResolveAlgorithm(int situation, int algorithm, int iterations)
+{
+  algorithmIterations_[situation][algorithm] += iterations;
+  if (++algorithmSolves_[situation][algorithm] >= 100 * CBC_ALGORITHM_TRIAL) {
+    // keep to recent resolves as nodes change
+    algorithmIterations_[situation][algorithm] *= 0.5;
+    algorithmSolves_[situation][algorithm] /= 2;
+  }
+}
+/*
+  Up and down sums of -dual*element for each column.
+
+  The sums over continuous rows are kept in shadowCache_ together with the
+  duals they were made with.  Rows whose dual has not changed (in the tree
+  most rows are not tight so stay at zero) are skipped, and for the others
+  the old contribution is taken off and the new one put on, using a row
+  copy of the continuous rows.  If most duals changed, or after many
+  updates (so rounding does not build up), the sums are made again.  Cuts
+  come and go so are always done from the row copy of the solver.
+*/
+void CbcModel::shadowSums(double *up, double *down)
+{
+  int numberColumns = solver_->getNumCols();
+  int numberRows = solver_->getNumRows();
+  int numberCore = numberRowsAtContinuous_;
+  const double *dual = solver_->getRowPrice();
+  if (shadowRowCopy_ && (shadowRowCopy_->getNumRows() != numberCore || shadowRowCopy_->getNumCols() != numberColumns))
+    deleteShadowCache();
+  if (!shadowRowCopy_) {
+    const CoinPackedMatrix *rowCopy = solver_->getMatrixByRow();
+    shadowRowCopy_ = new CoinPackedMatrix(*rowCopy);
+    if (numberRows > numberCore) {
+      int numberCuts = numberRows - numberCore;
+      int *which = new int[numberCuts];
+      for (int i = 0; i < numberCuts; i++)
+        which[i] = numberCore + i;
+      shadowRowCopy_->deleteRows(numberCuts, which);
+      delete[] which;
+    }
+    // all zero so all rows with a dual are done
+    shadowCache_ = new double[numberCore + 2 * numberColumns];
+    CoinZeroN(shadowCache_, numberCore + 2 * numberColumns);
+    shadowUpdates_ = 0;
+  }
+  double *lastDual = shadowCache_;
+  double *upSum = shadowCache_ + numberCore;
+  double *downSum = upSum + numberColumns;
+  const double *element = shadowRowCopy_->getElements();
+  const int *column = shadowRowCopy_->getIndices();
+  const CoinBigIndex *rowStart = shadowRowCopy_->getVectorStarts();
+  const int *rowLength = shadowRowCopy_->getVectorLengths();
+  int numberChanged = 0;
+  for (int iRow = 0; iRow < numberCore; iRow++) {
+    if (dual[iRow] != lastDual[iRow])
+      numberChanged++;
+  }
+  if (shadowUpdates_ >= 100 || 2 * numberChanged > numberCore) {
+    // make again
+    CoinZeroN(lastDual, numberCore + 2 * numberColumns);
+    shadowUpdates_ = 0;
+  } else {
+    shadowUpdates_++;
+  }
+  for (int iRow = 0; iRow < numberCore; iRow++) {
+    double oldValue = -lastDual[iRow];
+    double newValue = -dual[iRow];
+    if (oldValue == newValue)
+      continue;
+    assert(fabs(newValue) < 1.0e50);
+    lastDual[iRow] = dual[iRow];
+    CoinBigIndex start = rowStart[iRow];
+    CoinBigIndex end = start + rowLength[iRow];
+    for (CoinBigIndex j = start; j < end; j++) {
+      int iColumn = column[j];
+      double value = oldValue * element[j];
+      // take off old
+      if (value > 0.0)
+        upSum[iColumn] -= value;
+      else
+        downSum[iColumn] += value;
+      value = newValue * element[j];
+      if (value > 0.0)
+        upSum[iColumn] += value;
+      else
+        downSum[iColumn] -= value;
+    }
+  }
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    up[iColumn] = CoinMax(upSum[iColumn], 0.0);
+    down[iColumn] = CoinMax(downSum[iColumn], 0.0);
+  }
+  // cuts
+  if (numberRows > numberCore) {
+    const CoinPackedMatrix *rowCopy = solver_->getMatrixByRow();
+    element = rowCopy->getElements();
+    column = rowCopy->getIndices();
+    rowStart = rowCopy->getVectorStarts();
+    rowLength = rowCopy->getVectorLengths();
+    for (int iRow = numberCore; iRow < numberRows; iRow++) {
+      double dualValue = -dual[iRow];
+      if (!dualValue)
+        continue;
+      CoinBigIndex start = rowStart[iRow];
+      CoinBigIndex end = start + rowLength[iRow];
+      for (CoinBigIndex j = start; j < end; j++) {
+        int iColumn = column[j];
+        double value = dualValue * element[j];
+        if (value > 0.0)
+          up[iColumn] += value;
+        else
+          down[iColumn] -= value;
+      }
+    }
+  }
+}
 // Fill in useful estimates
 void CbcModel::pseudoShadow(int iActive)
 {
@@ -11364,7 +13863,26 @@ void CbcModel::pseudoShadow(int iActive)
   int numberIntegers = 0;
   if (doShadow) {
     // shadow prices
-    if (!useMax) {
+    if (!useMax && !rowWeight && numberRowsAtContinuous_ > 0 && numberRowsAtContinuous_ <= numberRows) {
+      // plain duals - sums over rows kept from last time
+      shadowSums(up, down);
+      for (int jColumn = 0; jColumn < numberIntegers_; jColumn++) {
+        int iColumn = integerVariable_[jColumn];
+        double value = direction * objective[iColumn];
+        if (value > 0.0)
+          up[iColumn] += value;
+        else
+          down[iColumn] -= value;
+        if (solver_->isInteger(iColumn)) {
+          if (!numberNodes_ && handler_->logLevel() > 1)
+            printf("%d - up %g down %g cost %g\n",
+              iColumn, up[iColumn], down[iColumn], objective[iColumn]);
+          upSum += up[iColumn];
+          downSum += down[iColumn];
+          numberIntegers++;
+        }
+      }
+    } else if (!useMax) {
       for (int jColumn = 0; jColumn < numberIntegers_; jColumn++) {
         int iColumn = integerVariable_[jColumn];
         CoinBigIndex start = columnStart[iColumn];
@@ -11596,6 +14114,8 @@ void CbcModel::synchronizeModel()
   int i;
   for (i = 0; i < numberHeuristics_; i++)
     heuristic_[i]->setModel(this);
+  for (i = 0; i < numberFathomMethods_; i++)
+    fathom_[i]->setModel(this);
   for (i = 0; i < numberObjects_; i++) {
     CbcObject *obj = dynamic_cast< CbcObject * >(object_[i]);
     if (obj) {
@@ -11642,6 +14162,23 @@ void CbcModel::synchronizeModel()
   I am going to re-order if necessary
 */
 
+#ifndef BRANCH_BREAKEVEN
+#define BRANCH_BREAKEVEN 0.3
+#define BRANCH_PREFERRED_WAY 0
+#else
+#define BRANCH_PREFERRED_WAY 1
+#endif
+// Dynamic object for integer with no history - treat as if will cost what it says up
+static CbcSimpleIntegerDynamicPseudoCost *newDynamicObject(CbcModel *model,
+  int iColumn, double cost)
+{
+  double upCost = CoinMax(1.0e-5, fabs(cost));
+  // and balance at breakeven
+  double downCost = ((1.0 - BRANCH_BREAKEVEN) * upCost) / BRANCH_BREAKEVEN;
+  CbcSimpleIntegerDynamicPseudoCost *newObject = new CbcSimpleIntegerDynamicPseudoCost(model, iColumn, downCost, upCost);
+  newObject->setPreferredWay(BRANCH_PREFERRED_WAY);
+  return newObject;
+}
 void CbcModel::findIntegers(bool startAgain, int type)
 {
   assert(solver_);
@@ -11740,12 +14277,19 @@ void CbcModel::findIntegers(bool startAgain, int type)
       lower bounds.
     */
   numberIntegers_ = 0;
-  if (type == 2)
+  if (type == 2 || type == 4)
     continuousPriority_ = iPriority + 1;
+  const double *cost = solver_->getObjCoefficients();
   for (iColumn = 0; iColumn < numberColumns; iColumn++) {
     if (isInteger(iColumn)) {
       if (!type) {
         object_[numberIntegers_] = new CbcSimpleInteger(this, iColumn);
+      } else if (type >= 3) {
+        CbcSimpleIntegerDynamicPseudoCost *newObject = newDynamicObject(this, iColumn, cost[iColumn]);
+        newObject->setPosition(numberIntegers_);
+        if (type == 4 && !mark[iColumn])
+          newObject->setPriority(iPriority + 1);
+        object_[numberIntegers_] = newObject;
       } else if (type == 1) {
         object_[numberIntegers_] = new CbcSimpleIntegerPseudoCost(this, iColumn, 0.3);
       } else if (type == 2) {
@@ -11777,34 +14321,28 @@ void CbcModel::convertToDynamic()
   const double *cost = solver_->getObjCoefficients();
   bool allDynamic = true;
   for (iObject = 0; iObject < numberObjects_; iObject++) {
-    CbcSimpleInteger *obj1 = dynamic_cast< CbcSimpleInteger * >(object_[iObject]);
-    CbcSimpleIntegerPseudoCost *obj1a = dynamic_cast< CbcSimpleIntegerPseudoCost * >(object_[iObject]);
+    // usually all dynamic already (see findIntegers) so test that first
     CbcSimpleIntegerDynamicPseudoCost *obj2 = dynamic_cast< CbcSimpleIntegerDynamicPseudoCost * >(object_[iObject]);
-    if (obj1 && !obj2) {
+    CbcSimpleInteger *obj1 = obj2 ? NULL : dynamic_cast< CbcSimpleInteger * >(object_[iObject]);
+    if (obj1) {
       // replace
       int iColumn = obj1->columnNumber();
       int priority = obj1->priority();
-      int preferredWay = obj1->preferredWay();
-      double costValue = CoinMax(1.0e-5, fabs(cost[iColumn]));
-      // treat as if will cost what it says up
-      double upCost = costValue;
-#ifndef BRANCH_BREAKEVEN
-#define BRANCH_BREAKEVEN 0.3
-#else
-      preferredWay = 1;
-#endif
-      // and balance at breakeven of 0.3
-      double downCost = ((1.0 - BRANCH_BREAKEVEN) * upCost) / BRANCH_BREAKEVEN;
+      CbcSimpleIntegerDynamicPseudoCost *newObject;
+      CbcSimpleIntegerPseudoCost *obj1a = dynamic_cast< CbcSimpleIntegerPseudoCost * >(obj1);
       if (obj1a) {
-        upCost = obj1a->upPseudoCost();
-        downCost = obj1a->downPseudoCost();
+        newObject = new CbcSimpleIntegerDynamicPseudoCost(this, iColumn,
+          obj1a->downPseudoCost(), obj1a->upPseudoCost());
+        newObject->setPreferredWay(BRANCH_PREFERRED_WAY ? 1 : obj1->preferredWay());
+      } else {
+        newObject = newDynamicObject(this, iColumn, cost[iColumn]);
+        if (!BRANCH_PREFERRED_WAY)
+          newObject->setPreferredWay(obj1->preferredWay());
       }
       delete object_[iObject];
-      CbcSimpleIntegerDynamicPseudoCost *newObject = new CbcSimpleIntegerDynamicPseudoCost(this, iColumn, 1.0e0 * downCost, 1.0e0 * upCost);
       //newObject->setNumberBeforeTrust(numberBeforeTrust_);
       newObject->setPriority(priority);
       newObject->setPosition(iObject);
-      newObject->setPreferredWay(preferredWay);
       object_[iObject] = newObject;
     } else if (!obj2) {
       CbcObject *obj3 = dynamic_cast< CbcObject * >(object_[iObject]);
@@ -11850,16 +14388,42 @@ int CbcModel::findSwitching()
   const double *columnLower = solver_->getColLower();
   const double *columnUpper = solver_->getColUpper();
   const double *element = rowCopy->getElements();
-  //const double * element = solver_->getMatrixByCol()->getElements();
+  const double *columnElement = solver_->getMatrixByCol()->getElements();
   const int *row = solver_->getMatrixByCol()->getIndices();
   const CoinBigIndex *columnStart = solver_->getMatrixByCol()->getVectorStarts();
   const int *columnLength = solver_->getMatrixByCol()->getVectorLengths();
   int numberRows = solver_->getNumRows();
   int numberColumns = solver_->getNumCols();
-  int *sort = new int[2 * numberRows + 2 + numberColumns];
+  int *sort = new int[3 * numberRows + 2 + numberColumns];
   int *whichRow = sort + numberRows + 1;
   int *marked = whichRow + numberRows + 1;
   memset(marked, 0, numberColumns * sizeof(int));
+  /*
+    One pass over rows so each row is looked at once (not once for each
+    binary in it).  Count integers (and continuous which can go negative)
+    in each row and get smallest and largest continuous elements.
+  */
+  int *rowIntegers = marked + numberColumns;
+  double *rowMin = new double[2 * numberRows];
+  double *rowMax = rowMin + numberRows;
+  for (int iRow = 0; iRow < numberRows; iRow++) {
+    int nInteger = 0;
+    double cMax = -COIN_DBL_MAX;
+    double cMin = COIN_DBL_MAX;
+    for (CoinBigIndex k = rowStart[iRow];
+         k < rowStart[iRow] + rowLength[iRow]; k++) {
+      int jColumn = column[k];
+      if (solver_->isInteger(jColumn) || columnLower[jColumn] < 0.0) {
+        nInteger++;
+      } else {
+        cMax = CoinMax(cMax, element[k]);
+        cMin = CoinMin(cMin, element[k]);
+      }
+    }
+    rowIntegers[iRow] = nInteger;
+    rowMin[iRow] = cMin;
+    rowMax[iRow] = cMax;
+  }
   int nnSwitch = 0;
   int nnSwitchTotal = 0;
   int n2Switch = 0;
@@ -11959,37 +14523,24 @@ int CbcModel::findSwitching()
           continue;
       } else if (rowLower[iRow] != -COIN_DBL_MAX) {
         continue;
-      } else if (rowUpper[iRow]) {
-        continue;
-      }
-      int nOther = 0;
-      double bEl = 0.0;
-      double cMax = -COIN_DBL_MAX;
-      double cMin = COIN_DBL_MAX;
-      for (CoinBigIndex k = rowStart[iRow];
-           k < rowStart[iRow] + rowLength[iRow]; k++) {
-        int jColumn = column[k];
-        if (jColumn == iColumn) {
-          bEl = element[k];
-        } else {
-          sort[nOther++] = jColumn;
-          if (solver_->isInteger(jColumn)) {
-            cMin = -1.0;
-            cMax = 1.0;
-            break;
-          } else {
-            cMax = CoinMax(cMax, element[k]);
-            cMin = CoinMin(cMin, element[k]);
-            if (columnLower[jColumn] < 0.0) {
-              cMin = -1.0;
-              cMax = 1.0;
-              break;
-            }
-          }
-        }
+      } else if (rowUpper[iRow]) {
+        continue;
       }
+      // only this binary and continuous which can not go negative
+      if (rowIntegers[iRow] != 1)
+        continue;
+      double bEl = columnElement[j];
+      double cMax = rowMax[iRow];
+      double cMin = rowMin[iRow];
       double largestC = CoinMax(fabs(cMin), fabs(cMax));
       if (((cMin > 0.0 && bEl < 0.0 && !rowUpper[iRow]) || (cMin < 0.0 && bEl > 0.0 && !rowLower[iRow])) && cMin * cMax > 0.0 && fabs(bEl) > largeRatio2 * largestC) {
+        int nOther = 0;
+        for (CoinBigIndex k = rowStart[iRow];
+             k < rowStart[iRow] + rowLength[iRow]; k++) {
+          int jColumn = column[k];
+          if (jColumn != iColumn)
+            sort[nOther++] = jColumn;
+        }
         // forces to zero
         CbcSwitchingBinary *object = dynamic_cast< CbcSwitchingBinary * >(object_[i]);
         if (!object) {
@@ -12031,27 +14582,143 @@ int CbcModel::findSwitching()
     }
   }
   delete[] sort;
+  delete[] rowMin;
   // say switches exist
-  if (n2Switch + nnSwitch)
+  if (n2Switch + nnSwitch) {
     moreSpecialOptions2_ |= 4;
+    delete[] switchingIndex_;
+    switchingIndex_ = NULL;
+    makeSwitchingIndex();
+  }
   return n2Switch + nnSwitch;
 }
+/* Make switchingIndex_ from switching objects (or check it is still right).
+   Returns number of switching objects */
+int CbcModel::makeSwitchingIndex()
+{
+  int numberColumns = solver_->getNumCols();
+  if (switchingIndex_) {
+    // still right if columns same and objects are where they were
+    bool good = switchingIndex_[0] == numberColumns;
+    for (int k = 0; k < numberSwitching_; k++) {
+      int iObject = switchingIndex_[k + 1];
+      if (iObject >= numberObjects_ || !dynamic_cast< CbcSwitchingBinary * >(object_[iObject])) {
+        good = false;
+        break;
+      }
+    }
+    if (good)
+      return numberSwitching_;
+    delete[] switchingIndex_;
+    switchingIndex_ = NULL;
+  }
+  numberSwitching_ = 0;
+  int numberEntries = 0;
+  for (int i = 0; i < numberObjects_; i++) {
+    CbcSwitchingBinary *object = dynamic_cast< CbcSwitchingBinary * >(object_[i]);
+    if (object) {
+      numberSwitching_++;
+      numberEntries += object->numberOther();
+    }
+  }
+  switchingIndex_ = new int[numberSwitching_ + numberColumns + 2 + numberEntries];
+  switchingIndex_[0] = numberColumns;
+  int *which = switchingIndex_ + 1;
+  int *start = which + numberSwitching_;
+  int *entry = start + numberColumns + 1;
+  memset(start, 0, (numberColumns + 1) * sizeof(int));
+  int k = 0;
+  for (int i = 0; i < numberObjects_; i++) {
+    CbcSwitchingBinary *object = dynamic_cast< CbcSwitchingBinary * >(object_[i]);
+    if (object) {
+      which[k++] = i;
+      const int *other = object->otherVariable();
+      for (int j = 0; j < object->numberOther(); j++)
+        start[other[j] + 1]++;
+    }
+  }
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++)
+    start[iColumn + 1] += start[iColumn];
+  for (k = 0; k < numberSwitching_; k++) {
+    const CbcSwitchingBinary *object = static_cast< CbcSwitchingBinary * >(object_[which[k]]);
+    const int *other = object->otherVariable();
+    for (int j = 0; j < object->numberOther(); j++)
+      entry[start[other[j]]++] = k;
+  }
+  // starts were moved on - put back
+  for (int iColumn = numberColumns; iColumn > 0; iColumn--)
+    start[iColumn] = start[iColumn - 1];
+  start[0] = 0;
+  return numberSwitching_;
+}
 // Fix associated variables
 int CbcModel::fixAssociated(OsiSolverInterface *solver, int cleanBasis)
 {
   int nChanged = 0;
   if ((moreSpecialOptions2_ & 4) != 0) {
-    int n = -1;
-    while (n) {
-      n = 0;
-      for (int i = 0; i < numberObjects_; i++) {
-        CbcSwitchingBinary *object = dynamic_cast< CbcSwitchingBinary * >(object_[i]);
-        if (object) {
-          n += object->setAssociatedBounds(solver, cleanBasis);
+    // tell objects about implied bounds if decision wants
+    bool inference = branchingMethod_ && branchingMethod_->wantsInference();
+    if (!solver)
+      solver = solver_;
+    int numberSwitching = makeSwitchingIndex();
+    int numberColumns = solver_->getNumCols();
+    const int *which = switchingIndex_ + 1;
+    const int *start = which + numberSwitching;
+    const int *entry = start + numberColumns + 1;
+    /*
+      First pass looks at all switching objects.  After that an object can
+      only change something if it changed something itself (binary fixed)
+      or shares an associated variable with one which did.
+    */
+    int *save = new int[2 * numberSwitching];
+    int *list = save;
+    int *nextList = list + numberSwitching;
+    char *mark = new char[numberSwitching];
+    memset(mark, 0, numberSwitching);
+    int nList = numberSwitching;
+    for (int k = 0; k < numberSwitching; k++)
+      list[k] = k;
+    while (nList) {
+      int nNext = 0;
+      for (int i = 0; i < nList; i++) {
+        int k = list[i];
+        CbcSwitchingBinary *object = static_cast< CbcSwitchingBinary * >(object_[which[k]]);
+        int nThis = object->setAssociatedBounds(solver, cleanBasis);
+        if (nThis) {
+          if (inference) {
+            int iColumn = object->columnNumber();
+            if (!solver->getColUpper()[iColumn])
+              object->addInference(-1, nThis);
+            else if (solver->getColLower()[iColumn] == 1.0)
+              object->addInference(1, nThis);
+          }
+          nChanged += nThis;
+          if (!mark[k]) {
+            mark[k] = 1;
+            nextList[nNext++] = k;
+          }
+          const int *other = object->otherVariable();
+          for (int j = 0; j < object->numberOther(); j++) {
+            int iColumn = other[j];
+            for (int jj = start[iColumn]; jj < start[iColumn + 1]; jj++) {
+              int kk = entry[jj];
+              if (!mark[kk]) {
+                mark[kk] = 1;
+                nextList[nNext++] = kk;
+              }
+            }
+          }
         }
       }
-      nChanged += n;
+      for (int i = 0; i < nNext; i++)
+        mark[nextList[i]] = 0;
+      int *temp = list;
+      list = nextList;
+      nextList = temp;
+      nList = nNext;
     }
+    delete[] mark;
+    delete[] save;
   }
   return nChanged;
 }
@@ -12372,7 +15039,16 @@ void CbcModel::setCutoff(double value)
     value += tol;
   }
 #endif
+  if (cutoffStep_ > 0.0 && value < 1.0e50) {
+    // integer solutions have objective on lattice - round down to it
+    double steps = floor((value - cutoffStepOffset_) / cutoffStep_ + 1.0e-6);
+    double lattice = cutoffStepOffset_ + steps * cutoffStep_;
+    double tolerance = CoinMin(1.0e-3 * cutoffStep_, 1.0e-6 * (1.0 + fabs(lattice)));
+    value = CoinMin(value, lattice + tolerance);
+  }
   dblParam_[CbcCurrentCutoff] = value;
+  // so threads can pick up without lock (see refreshPublishedCutoff)
+  publishedCutoff_ = value;
   if (solver_) {
     // Solvers know about direction
     // but Clp tries to be too clever and flips twice!
@@ -12520,9 +15196,8 @@ CbcModel::checkSolution(double cutoff, double *solution,
       const double *columnUpper = solver_->getColUpper();
       int numberRows = solver_->getNumRows();
       double *rowActivity = new double[numberRows];
-      memset(rowActivity, 0, numberRows * sizeof(double));
       double *rowSum = new double[numberRows];
-      memset(rowSum, 0, numberRows * sizeof(double));
+      double *clamped = new double[numberColumns];
       int *marked = new int[numberColumns];
       for (int i = 0; i < numberColumns; i++)
         marked[i] = -1;
@@ -12541,10 +15216,6 @@ CbcModel::checkSolution(double cutoff, double *solution,
           }
         }
       }
-      const double *element = solver_->getMatrixByCol()->getElements();
-      const int *row = solver_->getMatrixByCol()->getIndices();
-      const CoinBigIndex *columnStart = solver_->getMatrixByCol()->getVectorStarts();
-      const int *columnLength = solver_->getMatrixByCol()->getVectorLengths();
       const CoinPackedMatrix *rowCopy = solver_->getMatrixByRow();
       const int *column = rowCopy->getIndices();
       const int *rowLength = rowCopy->getVectorLengths();
@@ -12563,16 +15234,10 @@ CbcModel::checkSolution(double cutoff, double *solution,
             printf("column %d has value %.12g below %.12g\n", iColumn, value, columnLower[iColumn]);
           value = columnLower[iColumn];
         }
-        if (value) {
-          CoinBigIndex start = columnStart[iColumn];
-          CoinBigIndex end = start + columnLength[iColumn];
-          for (CoinBigIndex j = start; j < end; j++) {
-            int iRow = row[j];
-            rowActivity[iRow] += value * element[j];
-            rowSum[iRow] += fabs(value * element[j]);
-          }
-        }
+        clamped[iColumn] = value;
       }
+      rowActivities(solver_, clamped, rowActivity, rowSum, true);
+      delete[] clamped;
       for (int i = 0; i < numberRows; i++) {
 #if 0 //def CLP_INVESTIGATE
 	    double inf;
@@ -12697,9 +15362,8 @@ CbcModel::checkSolution(double cutoff, double *solution,
       const double *columnUpper = solver_->getColUpper();
       int numberRows = solver_->getNumRows();
       double *rowActivity = new double[numberRows];
-      memset(rowActivity, 0, numberRows * sizeof(double));
       double *rowSum = new double[numberRows];
-      memset(rowSum, 0, numberRows * sizeof(double));
+      double *clamped = new double[numberColumns];
       int *marked = new int[numberColumns];
       for (int i = 0; i < numberColumns; i++)
         marked[i] = -1;
@@ -12718,10 +15382,6 @@ CbcModel::checkSolution(double cutoff, double *solution,
           }
         }
       }
-      const double *element = solver_->getMatrixByCol()->getElements();
-      const int *row = solver_->getMatrixByCol()->getIndices();
-      const CoinBigIndex *columnStart = solver_->getMatrixByCol()->getVectorStarts();
-      const int *columnLength = solver_->getMatrixByCol()->getVectorLengths();
       const CoinPackedMatrix *rowCopy = solver_->getMatrixByRow();
       const int *column = rowCopy->getIndices();
       const int *rowLength = rowCopy->getVectorLengths();
@@ -12740,16 +15400,10 @@ CbcModel::checkSolution(double cutoff, double *solution,
             printf("column %d has value %.12g below %.12g\n", iColumn, value, columnLower[iColumn]);
           value = columnLower[iColumn];
         }
-        if (value) {
-          CoinBigIndex start = columnStart[iColumn];
-          CoinBigIndex end = start + columnLength[iColumn];
-          for (CoinBigIndex j = start; j < end; j++) {
-            int iRow = row[j];
-            rowActivity[iRow] += value * element[j];
-            rowSum[iRow] += fabs(value * element[j]);
-          }
-        }
+        clamped[iColumn] = value;
       }
+      rowActivities(solver_, clamped, rowActivity, rowSum, true);
+      delete[] clamped;
       for (int i = 0; i < numberRows; i++) {
 #if 0 //def CLP_INVESTIGATE
 	    double inf;
@@ -13041,50 +15695,40 @@ CbcModel::checkSolution(double cutoff, double *solution,
         const double *rowUpper = solver_->getRowUpper();
         int numberRows = solver_->getNumRows();
         double *rowActivity = new double[numberRows];
-        memset(rowActivity, 0, numberRows * sizeof(double));
         double *rowSum = new double[numberRows];
-        memset(rowSum, 0, numberRows * sizeof(double));
-        const double *element = solver_->getMatrixByCol()->getElements();
-        const int *row = solver_->getMatrixByCol()->getIndices();
-        const CoinBigIndex *columnStart = solver_->getMatrixByCol()->getVectorStarts();
-        const int *columnLength = solver_->getMatrixByCol()->getVectorLengths();
         double offset;
         solver_->getDblParam(OsiObjOffset, offset);
         double objValue = -offset;
         const double *objective = getObjCoefficients();
-        for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
-          double value = solution[iColumn];
-          objValue += value * objective[iColumn];
-          if (value) {
-            CoinBigIndex start = columnStart[iColumn];
-            CoinBigIndex end = start + columnLength[iColumn];
-            for (CoinBigIndex j = start; j < end; j++) {
-              int iRow = row[j];
-              rowActivity[iRow] += value * element[j];
-              rowSum[iRow] += fabs(value * element[j]);
-            }
-          }
-        }
-        for (i = 0; i < numberRows; i++) {
+        for (int iColumn = 0; iColumn < numberColumns; iColumn++)
+          objValue += solution[iColumn] * objective[iColumn];
+        // plain sums first - compensated only if solution would be rejected
+        for (int pass = 0; pass < 2; pass++) {
+          if (pass && largestInfeasibility <= 200.0 * primalTolerance)
+            break;
+          largestInfeasibility = 0.0;
+          rowActivities(solver_, solution, rowActivity, rowSum, pass != 0);
+          for (i = 0; i < numberRows; i++) {
 #if CBC_FEASIBILITY_INVESTIGATE > 1
-          double inf;
-          inf = rowLower[i] - rowActivity[i];
-          if (inf > primalTolerance)
-            printf("Row %d inf %g sum %g %g <= %g <= %g\n",
-              i, inf, rowSum[i], rowLower[i], rowActivity[i], rowUpper[i]);
-          inf = rowActivity[i] - rowUpper[i];
-          if (inf > primalTolerance)
-            printf("Row %d inf %g sum %g %g <= %g <= %g\n",
-              i, inf, rowSum[i], rowLower[i], rowActivity[i], rowUpper[i]);
-#endif
-          double infeasibility = CoinMax(rowActivity[i] - rowUpper[i],
-            rowLower[i] - rowActivity[i]);
-          // but allow for errors
-          double factor = CoinMax(1.0, rowSum[i] * 1.0e-3);
-          if (infeasibility > largestInfeasibility * factor) {
-            largestInfeasibility = infeasibility / factor;
-            //printf("inf of %g on row %d sum %g scaled %g\n",
-            //     infeasibility,i,rowSum[i],largestInfeasibility);
+            double inf;
+            inf = rowLower[i] - rowActivity[i];
+            if (inf > primalTolerance)
+              printf("Row %d inf %g sum %g %g <= %g <= %g\n",
+                i, inf, rowSum[i], rowLower[i], rowActivity[i], rowUpper[i]);
+            inf = rowActivity[i] - rowUpper[i];
+            if (inf > primalTolerance)
+              printf("Row %d inf %g sum %g %g <= %g <= %g\n",
+                i, inf, rowSum[i], rowLower[i], rowActivity[i], rowUpper[i]);
+#endif
+            double infeasibility = CoinMax(rowActivity[i] - rowUpper[i],
+              rowLower[i] - rowActivity[i]);
+            // but allow for errors
+            double factor = CoinMax(1.0, rowSum[i] * 1.0e-3);
+            if (infeasibility > largestInfeasibility * factor) {
+              largestInfeasibility = infeasibility / factor;
+              //printf("inf of %g on row %d sum %g scaled %g\n",
+              //     infeasibility,i,rowSum[i],largestInfeasibility);
+            }
           }
         }
         delete[] rowActivity;
@@ -13278,6 +15922,72 @@ CbcModel::checkSolution(double cutoff, double *solution,
   }
 }
 
+/*
+  Row activities by rows - each row is a dot product with no scatter, so
+  plain sums use four partial sums the compiler can vectorize.  Row copy
+  of solver is kept by solver so is normally free.
+*/
+void CbcModel::rowActivities(const OsiSolverInterface *solver,
+  const double *solution, double *rowActivity, double *rowSum,
+  bool compensated)
+{
+  const CoinPackedMatrix *rowCopy = solver->getMatrixByRow();
+  const int *column = rowCopy->getIndices();
+  const int *rowLength = rowCopy->getVectorLengths();
+  const CoinBigIndex *rowStart = rowCopy->getVectorStarts();
+  const double *element = rowCopy->getElements();
+  int numberRows = solver->getNumRows();
+  for (int iRow = 0; iRow < numberRows; iRow++) {
+    CoinBigIndex start = rowStart[iRow];
+    CoinBigIndex end = start + rowLength[iRow];
+    double sum = 0.0;
+    double absSum = 0.0;
+    if (compensated) {
+      // Neumaier - correction collects what is lost in sum
+      double correction = 0.0;
+      for (CoinBigIndex j = start; j < end; j++) {
+        double term = element[j] * solution[column[j]];
+        double newSum = sum + term;
+        if (fabs(sum) >= fabs(term))
+          correction += (sum - newSum) + term;
+        else
+          correction += (term - newSum) + sum;
+        sum = newSum;
+        absSum += fabs(term);
+      }
+      sum += correction;
+    } else {
+      double sum0 = 0.0, sum1 = 0.0, sum2 = 0.0, sum3 = 0.0;
+      double abs0 = 0.0, abs1 = 0.0, abs2 = 0.0, abs3 = 0.0;
+      CoinBigIndex j = start;
+      for (; j + 3 < end; j += 4) {
+        double term0 = element[j] * solution[column[j]];
+        double term1 = element[j + 1] * solution[column[j + 1]];
+        double term2 = element[j + 2] * solution[column[j + 2]];
+        double term3 = element[j + 3] * solution[column[j + 3]];
+        sum0 += term0;
+        sum1 += term1;
+        sum2 += term2;
+        sum3 += term3;
+        abs0 += fabs(term0);
+        abs1 += fabs(term1);
+        abs2 += fabs(term2);
+        abs3 += fabs(term3);
+      }
+      for (; j < end; j++) {
+        double term = element[j] * solution[column[j]];
+        sum0 += term;
+        abs0 += fabs(term);
+      }
+      sum = (sum0 + sum1) + (sum2 + sum3);
+      absSum = (abs0 + abs1) + (abs2 + abs3);
+    }
+    rowActivity[iRow] = sum;
+    if (rowSum)
+      rowSum[iRow] = absSum;
+  }
+}
+
 /*
   Call this routine from anywhere when a solution is found. The solution
   vector is assumed to contain one value for each structural variable.
@@ -13690,7 +16400,7 @@ CbcModel::dealWithEventHandler(CbcEventHandler::CbcEvent event,
   const double *solution)
 {
   CbcEventHandler *eventHandler = getEventHandler();
-  if (eventHandler) {
+  if (eventHandler && eventHandler->wanted(event)) {
     // Temporarily put in best
     double saveObj = bestObjective_;
     int numberColumns = solver_->getNumCols();
@@ -13738,14 +16448,8 @@ bool CbcModel::feasibleSolution(int &numberIntegerInfeasibilities,
   // point to useful information
   OsiBranchingInformation usefulInfo = usefulInformation();
 #define SIMPLE_INTEGER
-#ifdef SIMPLE_INTEGER
-  const double *solution = usefulInfo.solution_;
-  const double *lower = usefulInfo.lower_;
-  const double *upper = usefulInfo.upper_;
-  double tolerance = usefulInfo.integerTolerance_;
-#endif
-  for (j = 0; j < numberIntegers_; j++) {
 #ifndef SIMPLE_INTEGER
+  for (j = 0; j < numberIntegers_; j++) {
     const OsiObject *object = object_[j];
     double infeasibility = object->checkInfeasibility(&usefulInfo);
     if (infeasibility) {
@@ -13753,18 +16457,16 @@ bool CbcModel::feasibleSolution(int &numberIntegerInfeasibilities,
       numberUnsatisfied++;
       //sumUnsatisfied += infeasibility;
     }
+  }
 #else
-    int iColumn = integerVariable_[j];
-    double value = solution[iColumn];
-    value = CoinMax(value, lower[iColumn]);
-    value = CoinMin(value, upper[iColumn]);
-    double nearest = floor(value + 0.5);
-    if (fabs(value - nearest) > tolerance) {
-      numberUnsatisfied++;
-    }
+  numberUnsatisfied = scanIntegers(usefulInfo.solution_, usefulInfo.lower_,
+    usefulInfo.upper_, usefulInfo.integerTolerance_);
+  j = numberIntegers_;
 #endif
-  }
   numberIntegerInfeasibilities = numberUnsatisfied;
+  if (solutionChanges_ && j < numberObjects_)
+    solutionChanges_->mark(solver_->getNumCols(), usefulInfo.solution_,
+      usefulInfo.lower_, usefulInfo.upper_);
   for (; j < numberObjects_; j++) {
     const OsiObject *object = object_[j];
     double infeasibility = object->checkInfeasibility(&usefulInfo);
@@ -13774,12 +16476,47 @@ bool CbcModel::feasibleSolution(int &numberIntegerInfeasibilities,
       //sumUnsatisfied += infeasibility;
     }
   }
+  if (solutionChanges_)
+    solutionChanges_->clear();
   // and restore
   testSolution_ = save;
   numberObjectInfeasibilities = numberUnsatisfied - numberIntegerInfeasibilities;
   return (!numberUnsatisfied);
 }
 
+// Size of blocks in scanIntegers (so flags fit on stack)
+#define CBC_SCAN_BLOCK 256
+/* Scan integer variables for values away from integer.
+   First loop in block just works out flags (no branches), second
+   counts or compacts fractional ones. */
+int CbcModel::scanIntegers(const double *solution, const double *lower,
+  const double *upper, double tolerance, int *which) const
+{
+  int numberFractional = 0;
+  char fractional[CBC_SCAN_BLOCK];
+  for (int jStart = 0; jStart < numberIntegers_; jStart += CBC_SCAN_BLOCK) {
+    int n = CoinMin(CBC_SCAN_BLOCK, numberIntegers_ - jStart);
+    const int *column = integerVariable_ + jStart;
+    for (int k = 0; k < n; k++) {
+      int iColumn = column[k];
+      double value = solution[iColumn];
+      value = (value < lower[iColumn]) ? lower[iColumn] : value;
+      value = (value > upper[iColumn]) ? upper[iColumn] : value;
+      fractional[k] = (fabs(value - floor(value + 0.5)) > tolerance) ? 1 : 0;
+    }
+    if (which) {
+      for (int k = 0; k < n; k++) {
+        which[numberFractional] = jStart + k;
+        numberFractional += fractional[k];
+      }
+    } else {
+      for (int k = 0; k < n; k++)
+        numberFractional += fractional[k];
+    }
+  }
+  return numberFractional;
+}
+
 /* For all vubs see if we can tighten bounds by solving Lp's
    type - 0 just vubs
    1 all (could be very slow)
@@ -13866,6 +16603,44 @@ bool CbcModel::tightenVubs(int type, bool allowMultipleBinary, double useCutoff)
 
   return feasible;
 }
+// What a thread of tightenVubs needs
+typedef struct {
+  OsiSolverInterface *solver; // own copy with zero objective
+  const CoinWarmStart *ws;
+  const int *which;
+  double *newLower; // for each in which (-COIN_DBL_MAX if not solved)
+  double *newUpper; // for each in which (COIN_DBL_MAX if not solved)
+  double endTime;
+  int first; // does first, first+step ...
+  int step;
+  int numberSolves;
+} CbcVubInfo;
+
+static void *doVubs(void *voidInfo)
+{
+  CbcVubInfo *info = reinterpret_cast< CbcVubInfo * >(voidInfo);
+  OsiSolverInterface *solver = info->solver;
+  for (int iVub = info->first; iVub < info->numberSolves; iVub += info->step) {
+    if (CoinGetTimeOfDay() > info->endTime)
+      break;
+    int iColumn = info->which[iVub];
+    for (int iTry = 0; iTry < 2; iTry++) {
+      // all way down then all way up - from same basis each time
+      solver->setObjCoeff(iColumn, iTry ? -1.0 : 1.0);
+      solver->setWarmStart(info->ws);
+      solver->initialSolve();
+      if (solver->isProvenOptimal()) {
+        double value = solver->getColSolution()[iColumn];
+        if (iTry)
+          info->newUpper[iVub] = value;
+        else
+          info->newLower[iVub] = value;
+      }
+    }
+    solver->setObjCoeff(iColumn, 0.0);
+  }
+  return NULL;
+}
 // This version is just handed a list of variables
 bool CbcModel::tightenVubs(int numberSolves, const int *which,
   double useCutoff)
@@ -13981,8 +16756,102 @@ bool CbcModel::tightenVubs(int numberSolves, const int *which,
   memcpy(solution, solver->getColSolution(), numberColumns * sizeof(double));
   for (iColumn = 0; iColumn < numberColumns; iColumn++)
     solver->setObjCoeff(iColumn, 0.0);
+  double endTime = COIN_DBL_MAX;
+  if (dblParam_[CbcVubTimeLimit] > 0.0)
+    endTime = CoinGetTimeOfDay() + dblParam_[CbcVubTimeLimit];
+  CbcThreadPool *pool = NULL;
+  if (numberThreads_ > 0 && !parentModel_ && numberSolves >= 2 * numberThreads_)
+    pool = threadPool(numberThreads_);
+  int numberSequential = numberSolves;
+  if (pool) {
+    numberSequential = 0;
+    int numberThreads = pool->numberThreads();
+    double *newLower = new double[2 * numberSolves];
+    double *newUpper = newLower + numberSolves;
+    for (iVub = 0; iVub < numberSolves; iVub++) {
+      newLower[iVub] = -COIN_DBL_MAX;
+      newUpper[iVub] = COIN_DBL_MAX;
+    }
+    CbcVubInfo *info = new CbcVubInfo[numberThreads];
+    for (int i = 0; i < numberThreads; i++) {
+      info[i].solver = solver->clone();
+      info[i].ws = ws;
+      info[i].which = which;
+      info[i].newLower = newLower;
+      info[i].newUpper = newUpper;
+      info[i].endTime = endTime;
+      info[i].first = i;
+      info[i].step = numberThreads;
+      info[i].numberSolves = numberSolves;
+    }
+    pool->run(doVubs, numberThreads, info, static_cast< int >(sizeof(CbcVubInfo)));
+    for (int i = 0; i < numberThreads; i++)
+      delete info[i].solver;
+    delete[] info;
+    // apply in order
+    int saveFixed = numberFixed;
+    for (iVub = 0; iVub < numberSolves; iVub++) {
+      iColumn = which[iVub];
+      double saveUpper = solver->getColUpper()[iColumn];
+      double saveLower = solver->getColLower()[iColumn];
+      double value = newLower[iVub];
+      if (value > saveLower + 1.0e-4) {
+        if (solver->isInteger(iColumn))
+          value = ceil(value - 0.00001);
+        else
+          value = CoinMax(saveLower, value - 1.0e-8 * (fabs(saveLower) + 1));
+        if (saveUpper - value < 1.0e-7)
+          value = saveUpper; // make sure exactly same
+        solver->setColLower(iColumn, value);
+        saveLower = value;
+        if (saveUpper == saveLower)
+          numberFixed++;
+        else
+          numberTightened++;
+      }
+      value = newUpper[iVub];
+      if (value < saveUpper - 1.0e-4) {
+        if (solver->isInteger(iColumn))
+          value = floor(value + 0.00001);
+        else
+          value = CoinMin(saveUpper, value + 1.0e-8 * (fabs(saveUpper) + 1));
+        if (value - saveLower < 1.0e-7)
+          value = saveLower; // make sure exactly same
+        solver->setColUpper(iColumn, value);
+        saveUpper = value;
+        if (saveUpper == saveLower)
+          numberFixed++;
+        else
+          numberTightened++;
+      }
+    }
+    delete[] newLower;
+    if (numberFixed > saveFixed) {
+      // check still feasible with true costs
+      if (objective) {
+        for (iColumn = 0; iColumn < numberColumns; iColumn++)
+          solver->setObjCoeff(iColumn, objective[iColumn]);
+      }
+      solver->setColSolution(solution);
+      solver->setWarmStart(ws);
+      solver->resolve();
+      if (!solver->isProvenOptimal()) {
+        fprintf(stderr, "Problem is infeasible\n");
+        delete ws;
+        delete[] solution;
+        delete[] vub;
+        delete[] objective;
+        if (solver != solver_)
+          delete solver;
+        setCutoff(saveCutoff);
+        return false;
+      }
+    }
+  }
   //solver->messageHandler()->setLogLevel(2);
-  for (iVub = 0; iVub < numberSolves; iVub++) {
+  for (iVub = 0; iVub < numberSequential; iVub++) {
+    if (CoinGetTimeOfDay() > endTime)
+      break;
     iColumn = which[iVub];
     int iTry;
     for (iTry = 0; iTry < 2; iTry++) {
@@ -14203,6 +17072,235 @@ CbcModel::subTreeModel(OsiSolverInterface *solver) const
     newModel->assignSolver(solver);
   return newModel;
 }
+// Copy of this model without strategy or heuristics
+CbcModel *
+CbcModel::copyWithoutHeuristics()
+{
+  CbcStrategy *saveStrategy = strategy_;
+  strategy_ = NULL;
+  int saveNumberHeuristics = numberHeuristics_;
+  numberHeuristics_ = 0;
+  CbcModel *newModel = new CbcModel(*this);
+  numberHeuristics_ = saveNumberHeuristics;
+  strategy_ = saveStrategy;
+  return newModel;
+}
+// Time phases of node processing
+void CbcModel::setPhaseTimes(bool onOff, int traceFrequency, const char *traceFile)
+{
+  delete phaseTimes_;
+  phaseTimes_ = onOff ? new CbcPhaseTimes(traceFrequency, traceFile) : NULL;
+}
+// Make progress record now
+void CbcModel::reportProgress()
+{
+  CbcProgressRecord record;
+  memset(&record, 0, sizeof(CbcProgressRecord));
+  record.time = getCurrentSeconds();
+#ifdef CBC_THREAD
+  std::vector< double > busy;
+#endif
+  lockThread();
+  double bestPossible = bestPossibleObjective_;
+  if (tree_) {
+    record.numberNodesOnTree = tree_->size();
+    bestPossible = tree_->getBestPossibleObjective();
+  }
+#ifdef CBC_THREAD
+  if (master_) {
+    // nodes being done by threads are not on tree
+    int numberThreads = master_->numberThreads();
+    if (parallelMode() > 0) {
+      for (int i = 0; i < numberThreads; i++) {
+        CbcThread *child = master_->child(i);
+        if (child->node())
+          bestPossible = CoinMin(bestPossible, child->node()->objectiveValue());
+      }
+    }
+    busy.resize(numberThreads);
+    master_->threadBusy(&busy[0]);
+    record.numberThreads = numberThreads;
+    record.threadBusy = &busy[0];
+  }
+#endif
+  double bytes[CbcLastMemoryType];
+  record.memory = memoryUsage(bytes);
+  unlockThread();
+  record.memoryHighWater = memoryHighWater_;
+  record.bestObjective = bestObjective_;
+  record.bestPossible = CoinMin(bestPossible, bestObjective_);
+  record.gap = -1.0;
+  if (bestObjective_ < 1.0e50) {
+    double largest = CoinMax(fabs(bestObjective_), fabs(record.bestPossible));
+    record.gap = largest ? (bestObjective_ - record.bestPossible) / largest : 0.0;
+  }
+  record.numberNodes = numberNodes_;
+  record.numberIterations = numberIterations_;
+  record.workUnits = workUnits();
+  double elapsed = record.time - lastProgress_.time;
+  if (elapsed > 0.0) {
+    record.nodesPerSecond = (record.numberNodes - lastProgress_.numberNodes) / elapsed;
+    record.iterationsPerSecond = (record.numberIterations - lastProgress_.numberIterations) / elapsed;
+  }
+  if (eventHandler_ && eventHandler_->wanted(CbcEventHandler::progress)
+    && !eventHandler_->event(CbcEventHandler::progress, &record)) {
+    eventHappened_ = true; // exit
+  }
+  if (progressFd_ >= 0) {
+    char buffer[200];
+    sprintf(buffer, "{\"time\": %.3f, \"nodes\": %d, \"nodesOnTree\": %d, ",
+      record.time, record.numberNodes, record.numberNodesOnTree);
+    std::string line = buffer;
+    if (record.bestObjective < 1.0e50)
+      sprintf(buffer, "\"best\": %.12g, ", record.bestObjective);
+    else
+      strcpy(buffer, "\"best\": null, ");
+    line += buffer;
+    if (record.bestPossible < 1.0e50)
+      sprintf(buffer, "\"bound\": %.12g, ", record.bestPossible);
+    else
+      strcpy(buffer, "\"bound\": null, ");
+    line += buffer;
+    if (record.gap >= 0.0)
+      sprintf(buffer, "\"gap\": %g, ", record.gap);
+    else
+      strcpy(buffer, "\"gap\": null, ");
+    line += buffer;
+    sprintf(buffer, "\"nodesPerSecond\": %.1f, \"iterations\": %.0f, \"iterationsPerSecond\": %.1f, \"work\": %.0f, ",
+      record.nodesPerSecond, record.numberIterations, record.iterationsPerSecond,
+      record.workUnits);
+    line += buffer;
+    sprintf(buffer, "\"memory\": %.0f, \"memoryHighWater\": %.0f, \"threadBusy\": [",
+      record.memory, record.memoryHighWater);
+    line += buffer;
+    for (int i = 0; i < record.numberThreads; i++) {
+      sprintf(buffer, "%s%.3f", i ? ", " : "", record.threadBusy[i]);
+      line += buffer;
+    }
+    line += "]}\n";
+    if (CBC_WRITE_FD(progressFd_, line.c_str(), static_cast< unsigned int >(line.size())) < 0)
+      progressFd_ = -1;
+  }
+  lastProgress_ = record;
+  lastProgress_.threadBusy = NULL;
+}
+// Checkpoints of search to file
+void CbcModel::setCheckpoint(const char *fileName, double seconds)
+{
+  delete checkpoint_;
+  checkpoint_ = fileName ? new CbcCheckpoint(fileName, seconds) : NULL;
+  checkpointRequested_ = 0;
+}
+// Exchange incumbents and cuts with other processes
+void CbcModel::setPeerExchange(const char *baseName, int slot, int numberPeers,
+  double seconds)
+{
+  delete peerExchange_;
+  peerExchange_ = baseName ? new CbcPeerExchange(baseName, slot, numberPeers) : NULL;
+  peerInterval_ = seconds;
+}
+// Capture part of search into checkpoint
+int CbcModel::captureCheckpoint(CbcCheckpoint *checkpoint, int part, int numberParts)
+{
+  // addCuts1 changes record of cuts in solver - put back after
+  int saveDepth = lastDepth_;
+  int saveCurrentDepth = currentDepth_;
+  CbcNodeInfo **saveNodeInfo = NULL;
+  int *saveNumberCuts = NULL;
+  if (saveDepth) {
+    saveNodeInfo = CoinCopyOfArray(lastNodeInfo_, saveDepth);
+    saveNumberCuts = CoinCopyOfArray(lastNumberCuts_, saveDepth);
+  }
+  int numberNodes = checkpoint->capture(this, part, numberParts);
+  lastDepth_ = saveDepth;
+  currentDepth_ = saveCurrentDepth;
+  if (saveDepth) {
+    memcpy(lastNodeInfo_, saveNodeInfo, saveDepth * sizeof(CbcNodeInfo *));
+    memcpy(lastNumberCuts_, saveNumberCuts, saveDepth * sizeof(int));
+  }
+  delete[] saveNodeInfo;
+  delete[] saveNumberCuts;
+  return numberNodes;
+}
+// Capture and write checkpoint now
+int CbcModel::takeCheckpoint()
+{
+  checkpointRequested_ = 0;
+  if (!checkpoint_)
+    return -1;
+  int numberNodes = captureCheckpoint(checkpoint_);
+  char general[200];
+  if (numberNodes < 0) {
+    sprintf(general, "Checkpoint needs serial search with simple integer branching - switched off");
+    delete checkpoint_;
+    checkpoint_ = NULL;
+  } else {
+    checkpoint_->write();
+    sprintf(general, "Checkpoint of %d nodes after %d nodes to %.120s",
+      numberNodes, numberNodes_, checkpoint_->fileName());
+  }
+  messageHandler()->message(CBC_GENERAL, messages())
+    << general << CoinMessageEol;
+  return numberNodes;
+}
+// Split open nodes into checkpoints for other processes
+int CbcModel::writeSubtrees(const char *baseName, int numberParts)
+{
+  int numberNodes = 0;
+  for (int iPart = 0; iPart < numberParts; iPart++) {
+    char suffix[20];
+    sprintf(suffix, ".%d", iPart);
+    std::string fileName = baseName;
+    fileName += suffix;
+    CbcCheckpoint checkpoint(fileName.c_str());
+    int n = captureCheckpoint(&checkpoint, iPart, numberParts);
+    if (n < 0)
+      return -1;
+    checkpoint.write();
+    if (!checkpoint.flush())
+      return -1;
+    numberNodes += n;
+  }
+  char general[200];
+  sprintf(general, "%d nodes split into %d parts %.120s.0 ...",
+    numberNodes, numberParts, baseName);
+  messageHandler()->message(CBC_GENERAL, messages())
+    << general << CoinMessageEol;
+  return numberNodes;
+}
+// Read checkpoint so next branchAndBound resumes
+int CbcModel::readCheckpoint(const char *fileName)
+{
+  CbcCheckpoint *checkpoint = new CbcCheckpoint();
+  int returnCode = checkpoint->read(fileName);
+  if (returnCode)
+    delete checkpoint;
+  else
+    resumeCheckpoints_.push_back(checkpoint);
+  return returnCode;
+}
+// Forget checkpoints read by readCheckpoint
+void CbcModel::clearCheckpoints()
+{
+  for (int i = 0; i < static_cast< int >(resumeCheckpoints_.size()); i++)
+    delete resumeCheckpoints_[i];
+  resumeCheckpoints_.clear();
+}
+// Write record for each node to file
+bool CbcModel::setNodeTraceFile(const char *fileName)
+{
+  delete nodeTrace_;
+  nodeTrace_ = NULL;
+  if (!fileName)
+    return true;
+  nodeTrace_ = new CbcNodeTrace(fileName);
+  if (!nodeTrace_->isOpen()) {
+    delete nodeTrace_;
+    nodeTrace_ = NULL;
+    return false;
+  }
+  return true;
+}
 //#############################################################################
 // Set/Get Application Data
 // This is a pointer that the application can store into and retrieve
@@ -14685,6 +17783,9 @@ int CbcModel::resolve(OsiSolverInterface *solver)
         clpSolver->setSpecialOptions(save2 | 2048);
       }
     }
+    // measure for choice of dual pricing
+    bool adaptPricing = pricingState_ >= 0 && numberNodes_ && !parentModel_ && (threadMode_ & 1) == 0;
+    double startTime = adaptPricing ? CoinGetTimeOfDay() : 0.0;
 #ifdef CHECK_KNOWN_SOLUTION
     bool onOptimalPath = false;
     if ((specialOptions_ & 1) != 0) {
@@ -14695,7 +17796,31 @@ int CbcModel::resolve(OsiSolverInterface *solver)
       }
     }
 #endif
-    clpSolver->resolve();
+    // primal may be better than dual (e.g. after cuts taken off)
+    int situation = -1;
+    int algorithm = 0;
+    if (numberNodes_ && !intParam_[CbcResolveAlgorithm]) {
+      int numberRows = clpSimplex->numberRows();
+      if (resolveRows_ >= 0)
+        situation = (numberRows > resolveRows_) ? 0 : ((numberRows < resolveRows_) ? 1 : 2);
+      resolveRows_ = numberRows;
+      if (situation >= 0)
+        algorithm = chooseResolveAlgorithm(situation);
+    }
+    if (algorithm) {
+      bool takeHint;
+      OsiHintStrength strength;
+      clpSolver->getHintParam(OsiDoDualInResolve, takeHint, strength);
+      clpSolver->setHintParam(OsiDoDualInResolve, false, OsiHintDo);
+      clpSolver->resolve();
+      clpSolver->setHintParam(OsiDoDualInResolve, takeHint, strength);
+    } else {
+      clpSolver->resolve();
+      if (adaptPricing)
+        adaptDualPricing(clpSolver, CoinGetTimeOfDay() - startTime);
+    }
+    if (situation >= 0)
+      recordResolveAlgorithm(situation, algorithm, clpSimplex->numberIterations());
 #ifdef CHECK_RAY
     static int nSolves = 0;
     static int nInfSolves = 0;
@@ -15314,6 +18439,8 @@ int CbcModel::chooseBranch(CbcNode *&newNode, int numberPassesLeft,
       }
 #endif
 #ifdef CBC_HAS_NAUTY
+      if (symmetryDetection_)
+        pollSymmetryDetection(false);
       if (symmetryInfo_) {
         CbcNodeInfo *infoX = oldNode ? oldNode->nodeInfo() : NULL;
         bool worthTrying = false;
@@ -15371,7 +18498,17 @@ int CbcModel::chooseBranch(CbcNode *&newNode, int numberPassesLeft,
       if (numberBeforeTrust_ == 0) {
         anyAction = newNode->chooseBranch(this, oldNode, numberPassesLeft);
       } else {
+        // strong branching results saved in parent for siblings
+        CbcStrongCache *strongCache = NULL;
+        int cacheSize = intParam_[CbcStrongCacheSize];
+        if (cacheSize > 0 && parallelMode() == 0 && !masterThread_
+          && oldNode && oldNode->nodeInfo() && lowerBefore) {
+          strongCache = oldNode->nodeInfo()->strongCache(cacheSize);
+          strongCache->setCurrent(solver_, lowerBefore, upperBefore);
+        }
         anyAction = newNode->chooseDynamicBranch(this, oldNode, branches, numberPassesLeft);
+        if (strongCache)
+          strongCache->clearCurrent();
         if (anyAction == -3)
           anyAction = newNode->chooseBranch(this, oldNode, numberPassesLeft); // dynamic did nothing
       }
@@ -15607,6 +18744,8 @@ int CbcModel::chooseBranch(CbcNode *&newNode, int numberPassesLeft,
       maximumDepthActual_ = CoinMax(maximumDepthActual_, newNode->depth());
       // Number of branches is in oldNode!
       newNode->initializeInfo();
+      if (oldNode && intParam_[CbcSubtreeCutPool] && !parallelMode())
+        addToSubtreeCutPool(newNode->nodeInfo(), cuts);
       if (cuts.sizeRowCuts()) {
         int initialNumber = ((threadMode_ & 1) == 0) ? 0 : 1000000000;
         lockThread();
@@ -15757,6 +18896,7 @@ void CbcModel::setBestSolution(const double *solution, int numberColumns,
   if (bestSolution_)
     saveExtraSolution(bestSolution_, bestObjective_);
   bestObjective_ = objectiveValue;
+  checkCutoffStep(objectiveValue);
   // may be able to change cutoff now
   double cutoff = getCutoff();
   double increment = getDblParam(CbcModel::CbcCutoffIncrement);
@@ -15871,11 +19011,7 @@ void CbcModel::doHeuristicsAtRoot(int deleteHeuristicsAfterwards)
               if (lastSolutionCount > 0 && (heuristic_[i]->switches() & 16) == 0)
                 continue; // no point
               parameters[i - iChunk].solutionValue = heuristicValue;
-              // Don't want a strategy object
-              CbcStrategy *saveStrategy = strategy_;
-              strategy_ = NULL;
-              CbcModel *newModel = new CbcModel(*this);
-              strategy_ = saveStrategy;
+              CbcModel *newModel = copyWithoutHeuristics();
               assert(!newModel->continuousSolver_);
               if (continuousSolver_)
                 newModel->continuousSolver_ = continuousSolver_->clone();
@@ -15886,19 +19022,18 @@ void CbcModel::doHeuristicsAtRoot(int deleteHeuristicsAfterwards)
               ;
               parameters[i - iChunk].foundSol = 0;
               //newModel->gutsOfCopy(*this,-1);
-              for (int j = 0; j < numberHeuristics_; j++)
-                delete newModel->heuristic_[j];
-              //newModel->heuristic_ = new CbcHeuristic * [1];
+              newModel->heuristic_ = new CbcHeuristic *[1];
               newModel->heuristic_[0] = heuristic_[i]->clone();
               newModel->heuristic_[0]->setModel(newModel);
               newModel->heuristic_[0]->resetModel(newModel);
               newModel->numberHeuristics_ = 1;
             }
             void
-            parallelHeuristics(int numberThreads,
+            parallelHeuristics(CbcThreadPool *pool,
+              int numberThreads,
               int sizeOfData,
               void *argBundle);
-            parallelHeuristics(nThisTime,
+            parallelHeuristics(threadPool(chunk), nThisTime,
               static_cast< int >(sizeof(argBundle)),
               parameters);
             double cutoff = heuristicValue;
@@ -15948,7 +19083,7 @@ void CbcModel::doHeuristicsAtRoot(int deleteHeuristicsAfterwards)
             // see if heuristic will do anything
             double saveValue = heuristicValue;
             double before = getCurrentSeconds();
-            int ifSol = heuristic_[i]->solution(heuristicValue,
+            int ifSol = heuristic_[i]->solutionWithStatistics(heuristicValue,
               newSolution);
             if (handler_->logLevel() > 1) {
               char line[100];
@@ -16013,7 +19148,7 @@ void CbcModel::doHeuristicsAtRoot(int deleteHeuristicsAfterwards)
                   thisSolutionCount = -1000000;
                   break;
                 }
-                if (eventHandler) {
+                if (eventHandler && eventHandler->wanted(CbcEventHandler::heuristicSolution)) {
                   if (!eventHandler->event(CbcEventHandler::heuristicSolution)) {
                     eventHappened_ = true; // exit
                     thisSolutionCount = -1000000;
@@ -16043,7 +19178,7 @@ void CbcModel::doHeuristicsAtRoot(int deleteHeuristicsAfterwards)
             } else {
               heuristicValue = saveValue;
             }
-            if (eventHandler) {
+            if (eventHandler && eventHandler->wanted(CbcEventHandler::afterHeuristic)) {
               if (!eventHandler->event(CbcEventHandler::afterHeuristic)) {
                 eventHappened_ = true; // exit
                 thisSolutionCount = -1000000;
@@ -16072,7 +19207,7 @@ void CbcModel::doHeuristicsAtRoot(int deleteHeuristicsAfterwards)
         = dynamic_cast< CbcTreeLocal * >(tree_);
       if (tree)
         tree->passInSolution(bestSolution_, heuristicValue);
-      if (eventHandler) {
+      if (eventHandler && eventHandler->wanted(CbcEventHandler::solution)) {
         if (!eventHandler->event(CbcEventHandler::solution)) {
           eventHappened_ = true; // exit
         }
@@ -16125,9 +19260,14 @@ void CbcModel::zapIntegerInformation(bool leaveObjects)
     object_ = NULL;
   }
 }
+// Most integers and implications written out as structure
+#define CBC_GENERATE_MAXIMUM_INTEGERS 5000
+#define CBC_GENERATE_MAXIMUM_IMPLICATIONS 2000
 // Create C++ lines to get to current state
-void CbcModel::generateCpp(FILE *fp, int /*options*/)
+void CbcModel::generateCpp(FILE *fp, int options)
 {
+  if ((options & 2) != 0)
+    generateStructureCpp(fp);
   // Do cut generators
   int i;
   for (i = 0; i < numberCutGenerators_; i++) {
@@ -16161,6 +19301,8 @@ void CbcModel::generateCpp(FILE *fp, int /*options*/)
   }
   if (nodeCompare_)
     nodeCompare_->generateCpp(fp);
+  if (branchingMethod_)
+    branchingMethod_->generateCpp(fp);
   tree_->generateCpp(fp);
   CbcModel defaultModel;
   CbcModel *other = &defaultModel;
@@ -16272,6 +19414,75 @@ void CbcModel::generateCpp(FILE *fp, int /*options*/)
   fprintf(fp, "%d  cbcModel->setMaximumSeconds(%g);\n", dValue1 == dValue2 ? 4 : 3, dValue1);
   fprintf(fp, "%d  cbcModel->setMaximumSeconds(save_cbcMaximumSeconds);\n", dValue1 == dValue2 ? 7 : 6);
 }
+/* Create C++ lines to put back static structure of model - priorities
+   and preferred directions of integer objects and implications.  Lines are
+   all "5" so they come after any preprocessing in generated driver, and are
+   only used if processed model has same number of columns.  Very large
+   structure is not written as generated driver has limited number of lines.
+*/
+void CbcModel::generateStructureCpp(FILE *fp)
+{
+  int numberColumns = solver_->getNumCols();
+  bool doObjects = false;
+  if (numberIntegers_ && numberIntegers_ <= CBC_GENERATE_MAXIMUM_INTEGERS) {
+    for (int i = 0; i < numberIntegers_; i++) {
+      const CbcSimpleInteger *thisOne = dynamic_cast< const CbcSimpleInteger * >(object_[i]);
+      if (thisOne && (thisOne->priority() != 1000 || thisOne->preferredWay())) {
+        doObjects = true;
+        break;
+      }
+    }
+  }
+  int numberImplications = 0;
+  if (implicationGraph_ && implicationGraph_->numberColumns() == numberColumns)
+    numberImplications = implicationGraph_->numberImplications();
+  if (numberImplications > CBC_GENERATE_MAXIMUM_IMPLICATIONS)
+    numberImplications = 0;
+  if (!doObjects && !numberImplications)
+    return;
+  fprintf(fp, "5  // structure of model family\n");
+  fprintf(fp, "5  if (cbcModel->getNumCols()==%d) {\n", numberColumns);
+  if (doObjects) {
+    fprintf(fp, "5    cbcModel->findIntegers(false);\n");
+    fprintf(fp, "5    if (cbcModel->numberIntegers()==%d) {\n", numberIntegers_);
+    int i;
+    fprintf(fp, "5      static const int priority[%d] = {", numberIntegers_);
+    for (i = 0; i < numberIntegers_; i++) {
+      if ((i % 10) == 0)
+        fprintf(fp, "\n5        ");
+      const CbcSimpleInteger *thisOne = dynamic_cast< const CbcSimpleInteger * >(object_[i]);
+      fprintf(fp, "%d,", thisOne ? thisOne->priority() : 1000);
+    }
+    fprintf(fp, "\n5      };\n");
+    fprintf(fp, "5      static const int way[%d] = {", numberIntegers_);
+    for (i = 0; i < numberIntegers_; i++) {
+      if ((i % 20) == 0)
+        fprintf(fp, "\n5        ");
+      const CbcSimpleInteger *thisOne = dynamic_cast< const CbcSimpleInteger * >(object_[i]);
+      fprintf(fp, "%d,", thisOne ? thisOne->preferredWay() : 0);
+    }
+    fprintf(fp, "\n5      };\n");
+    fprintf(fp, "5      for (int i=0;i<%d;i++) {\n", numberIntegers_);
+    fprintf(fp, "5        CbcObject * obj = dynamic_cast< CbcObject *>(cbcModel->modifiableObject(i));\n");
+    fprintf(fp, "5        if (obj) {\n");
+    fprintf(fp, "5          obj->setPriority(priority[i]);\n");
+    fprintf(fp, "5          obj->setPreferredWay(way[i]);\n");
+    fprintf(fp, "5        }\n");
+    fprintf(fp, "5      }\n");
+    fprintf(fp, "5    }\n");
+  }
+  for (int i = 0; i < numberImplications; i++) {
+    int literal;
+    int jColumn;
+    double bound;
+    bool upper;
+    implicationGraph_->implication(i, literal, jColumn, bound, upper);
+    fprintf(fp, "5    cbcModel->addImplication(%d,%d,%d,%.17g,%s);\n",
+      CbcCliqueTable::column(literal), CbcCliqueTable::value(literal),
+      jColumn, bound, upper ? "true" : "false");
+  }
+  fprintf(fp, "5  }\n");
+}
 // So we can use osiObject or CbcObject during transition
 void getIntegerInformation(const OsiObject *object, double &originalLower,
   double &originalUpper)
@@ -16319,6 +19530,57 @@ void CbcModel::setCutModifier(CbcCutModifier &modifier)
    node NULL on return if no branches left
    newNode NULL if no new node created
 */
+// Mix value into hash of node bounds
+static inline CoinUInt64 mixNodeHash(CoinUInt64 hash, CoinUInt64 value)
+{
+  CoinUInt64 bits = hash ^ (value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2));
+  bits ^= bits >> 31;
+  bits *= 0xbf58476d1ce4e5b9ULL;
+  bits ^= bits >> 29;
+  return bits;
+}
+/* Bounds of solver (node after branch) give key - two hashes so a clash
+   is most unlikely.  Only done when branch just changes bounds (and no
+   objects branch on cuts) as otherwise nodes with same bounds may be
+   different subproblems.  The subtree of the node solved first covers
+   all of a later one so that can be pruned.
+*/
+bool CbcModel::duplicateNode(const CbcNode *node)
+{
+  if (!processedNodes_ || parallelMode() != 0)
+    return false;
+  const OsiBranchingObject *branch = node->branchingObject();
+  if (!dynamic_cast< const CbcIntegerBranchingObject * >(branch)
+    && !dynamic_cast< const CbcSOSBranchingObject * >(branch)
+    && !dynamic_cast< const CbcCliqueBranchingObject * >(branch)
+    && !dynamic_cast< const CbcLongCliqueBranchingObject * >(branch))
+    return false;
+  int numberColumns = solver_->getNumCols();
+  const double *lower = solver_->getColLower();
+  const double *upper = solver_->getColUpper();
+  CoinUInt64 key1 = numberColumns;
+  CoinUInt64 key2 = 0;
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    CoinUInt64 lowerBits;
+    CoinUInt64 upperBits;
+    // so -0.0 same as 0.0
+    double value = lower[iColumn] ? lower[iColumn] : 0.0;
+    memcpy(&lowerBits, &value, sizeof(double));
+    value = upper[iColumn] ? upper[iColumn] : 0.0;
+    memcpy(&upperBits, &value, sizeof(double));
+    CoinUInt64 hash = mixNodeHash(mixNodeHash(iColumn, lowerBits), upperBits);
+    key1 = mixNodeHash(key1, hash);
+    key2 += mixNodeHash(hash, 0x2545f4914f6cdd1dULL);
+  }
+  std::pair< CoinUInt64, CoinUInt64 > key(key1, key2);
+  if (processedNodes_->find(key) != processedNodes_->end()) {
+    numberDuplicateNodes_++;
+    return true;
+  }
+  if (static_cast< int >(processedNodes_->size()) < intParam_[CbcDuplicateNodes])
+    processedNodes_->insert(key);
+  return false;
+}
 int CbcModel::doOneNode(CbcModel *baseModel, CbcNode *&node, CbcNode *&newNode)
 {
   int foundSolution = 0;
@@ -16332,6 +19594,8 @@ int CbcModel::doOneNode(CbcModel *baseModel, CbcNode *&node, CbcNode *&newNode)
       numberCutGenerators_ = 0; // so can dive and branch
   }
   currentNode_ = node; // so can be accessed elsewhere
+  if (phaseTimes_)
+    phaseTimes_->setNode(numberNodes_);
   double bestObjective = bestObjective_;
   numberUpdateItems_ = 0;
   // Say not on optimal path
@@ -16383,7 +19647,21 @@ int CbcModel::doOneNode(CbcModel *baseModel, CbcNode *&node, CbcNode *&newNode)
     lastNumberCuts2_ = baseModel->lastNumberCuts2_;
   }
   int save2 = maximumDepth_;
+  CbcPhaseTimer restoreTimer(phaseTimes_, CbcPhaseTimes::restore);
   int retCode = addCuts(node, lastws);
+  restoreTimer.stop();
+  CbcNodeTrace::Record traceRecord;
+  if (nodeTrace_) {
+    // branch must be picked up before it is done
+    CbcNodeTrace::initialize(traceRecord);
+    CbcNodeTrace::setBranch(traceRecord, node);
+    if (retCode) {
+      traceRecord.time = getCurrentSeconds();
+      traceRecord.objective = node->objectiveValue();
+      traceRecord.outcome = CbcNodeTrace::fathomed;
+      nodeTrace_->add(traceRecord);
+    }
+  }
 #ifdef SWITCH_VARIABLES
   fixAssociated(solver_, 0);
 #endif
@@ -16468,7 +19746,22 @@ int CbcModel::doOneNode(CbcModel *baseModel, CbcNode *&node, CbcNode *&newNode)
     phase_ = 2;
     OsiCuts cuts;
     int saveNumber = numberIterations_;
-    if (solverCharacteristics_->solutionAddsCuts()) {
+    double saveLpTime = CoinGetTimeOfDay();
+    // same bounds as node already solved (CbcDuplicateNodes)
+    bool duplicate = duplicateNode(node);
+    // next node can be got ready while this is solved
+    startNodePrefetch();
+    if (duplicate) {
+      feasible = false;
+      // node won't be referencing cuts
+      for (i = 0; i < currentNumberCuts_; i++) {
+        if (addedCuts_[i]) {
+          if (!addedCuts_[i]->decrement())
+            delete addedCuts_[i];
+          addedCuts_[i] = NULL;
+        }
+      }
+    } else if (solverCharacteristics_->solutionAddsCuts()) {
       int returnCode = resolve(node ? node->nodeInfo() : NULL, 1);
       feasible = returnCode != 0;
       if (feasible) {
@@ -16855,6 +20148,34 @@ int CbcModel::doOneNode(CbcModel *baseModel, CbcNode *&node, CbcNode *&newNode)
       feasible = solveWithCuts(cuts, maximumCutPasses_, node);
 #endif
     }
+    finishNodePrefetch();
+    // keep factorization for children if rows as restored (CbcFactorizationMemory)
+    if (feasible && factorizationCache_ && !numberNewCuts_
+      && numberOldActiveCuts_ == factorizationCache_->numberCuts()
+      && solver_->getNumRows() == numberRowsAtContinuous_ + numberOldActiveCuts_)
+      factorizationCache_->save(solver_);
+    if (feasible && parallelMode() <= 0 && branchingMethod_ && branchingMethod_->wantsInference()) {
+      /* Tell object branched on how many integer bounds were tightened
+         (by probing, reduced cost fixing etc) after branch.
+         Not done with opportunistic threads as objects may be shared */
+      const CbcBranchingObject *branch = dynamic_cast< const CbcBranchingObject * >(node->branchingObject());
+      CbcSimpleIntegerDynamicPseudoCost *object = branch ? dynamic_cast< CbcSimpleIntegerDynamicPseudoCost * >(branch->object()) : NULL;
+      if (object) {
+        int branchColumn = object->columnNumber();
+        const double *lower = solver_->getColLower();
+        const double *upper = solver_->getColUpper();
+        int numberImplied = 0;
+        for (int i = 0; i < numberIntegers_; i++) {
+          int iColumn = integerVariable_[i];
+          if (iColumn != branchColumn && (lower[iColumn] > lowerBefore[iColumn] || upper[iColumn] < upperBefore[iColumn]))
+            numberImplied++;
+        }
+        // way is what will be taken next
+        object->addInference(-branch->way(), numberImplied);
+      }
+    }
+    if (feasible && numberFathomMethods_ && fathomNode())
+      feasible = false;
     if ((specialOptions_ & 1) != 0 && onOptimalPath) {
       if (solver_->getRowCutDebuggerAlways()->optimalValue() < getCutoff()) {
         if (!solver_->getRowCutDebugger() || !feasible) {
@@ -16971,7 +20292,6 @@ int CbcModel::doOneNode(CbcModel *baseModel, CbcNode *&node, CbcNode *&newNode)
                                 */
                 int n = partial->numberChangedBounds();
                 const int *which = partial->variables();
-                const double *values = partial->newBounds();
                 for (int i = 0; i < n; i++) {
                   int variable = which[i];
                   int k = variable & 0x3fffffff;
@@ -17190,6 +20510,9 @@ int CbcModel::doOneNode(CbcModel *baseModel, CbcNode *&node, CbcNode *&newNode)
 #endif
       // Set objective value (not so obvious if NLP etc)
       setObjectiveValue(newNode, node);
+      // so node selection can see what children may cost
+      newNode->setLpWork(numberIterations_ - saveNumber,
+        CoinGetTimeOfDay() - saveLpTime);
       int anyAction = -1;
       bool resolved = false;
       if (newNode->objectiveValue() >= getCutoff()) {
@@ -17199,6 +20522,7 @@ int CbcModel::doOneNode(CbcModel *baseModel, CbcNode *&node, CbcNode *&newNode)
         checkingNode = true;
         OsiSolverBranch *branches = NULL;
         // point to useful information
+        CbcPhaseTimer branchTimer(phaseTimes_, CbcPhaseTimes::branch);
         anyAction = chooseBranch(newNode, numberPassesLeft, node, cuts, resolved,
           lastws, lowerBefore, upperBefore, branches);
       }
@@ -17263,7 +20587,8 @@ int CbcModel::doOneNode(CbcModel *baseModel, CbcNode *&node, CbcNode *&newNode)
         */
     // Set currentNode_ so can be used in handler
     currentNode_ = newNode;
-    if (eventHandler_ && !eventHandler_->event(CbcEventHandler::node)) {
+    if (eventHandler_ && eventHandler_->nodeEventDue()
+      && !eventHandler_->event(CbcEventHandler::node)) {
       eventHappened_ = true; // exit
     }
     if (parallelMode() >= 0)
@@ -17279,6 +20604,27 @@ int CbcModel::doOneNode(CbcModel *baseModel, CbcNode *&node, CbcNode *&newNode)
       else
         statistics_[numberNodes2_ - 1]->sayInfeasible();
     }
+    if (nodeTrace_) {
+      traceRecord.time = getCurrentSeconds();
+      traceRecord.iterations = numberIterations_ - saveNumber;
+      if (newNode && newNode->active()) {
+        traceRecord.objective = newNode->objectiveValue();
+        traceRecord.numberUnsatisfied = newNode->numberUnsatisfied();
+        traceRecord.outcome = newNode->branchingObject() ? CbcNodeTrace::branched : CbcNodeTrace::solution;
+      } else {
+        bool overCutoff;
+        if (feasible) {
+          traceRecord.objective = solver_->getObjValue();
+          overCutoff = traceRecord.objective >= getCutoff();
+        } else {
+          overCutoff = solver_->isDualObjectiveLimitReached();
+        }
+        traceRecord.outcome = overCutoff ? CbcNodeTrace::cutoff : CbcNodeTrace::infeasible;
+      }
+      int id = nodeTrace_->add(traceRecord);
+      if (newNode && newNode->nodeInfo())
+        newNode->nodeInfo()->setTraceId(id);
+    }
     lockThread();
     bool locked = true;
     if (parallelMode() <= 0) {
@@ -17337,10 +20683,11 @@ int CbcModel::doOneNode(CbcModel *baseModel, CbcNode *&node, CbcNode *&newNode)
           }
         }
         if (newNode->branchingObject()) {
-          handler_->message(CBC_BRANCH, messages_)
-            << numberNodes_ << newNode->objectiveValue()
-            << newNode->numberUnsatisfied() << newNode->depth()
-            << CoinMessageEol;
+          if (CbcMessageWanted(handler_, messages_, CBC_BRANCH))
+            handler_->message(CBC_BRANCH, messages_)
+              << numberNodes_ << newNode->objectiveValue()
+              << newNode->numberUnsatisfied() << newNode->depth()
+              << CoinMessageEol;
           // Increment cut counts (taking off current)
           int numberLeft = newNode->numberBranches();
           for (i = 0; i < currentNumberCuts_; i++) {
@@ -17354,6 +20701,8 @@ int CbcModel::doOneNode(CbcModel *baseModel, CbcNode *&node, CbcNode *&newNode)
           }
           unlockThread();
           locked = false;
+          if (intParam_[CbcSolveBothChildren])
+            solveBothChildren(newNode);
           double estValue = newNode->guessedObjectiveValue();
           int found = -1;
           double *newSolution = new double[numberColumns];
@@ -17362,12 +20711,38 @@ int CbcModel::doOneNode(CbcModel *baseModel, CbcNode *&node, CbcNode *&newNode)
           int whereFrom = 3;
           // allow more heuristics
           currentPassNumber_ = 0;
+          CbcPhaseTimer heuristicsTimer(phaseTimes_, CbcPhaseTimes::heuristics);
+          // solution from background heuristic (CbcAsyncHeuristics)
+          if (pollTreeHeuristics(false)) {
+            foundSolution = 1;
+            heurValue = getCutoff();
+            whereFrom |= 8; // say solution found
+          }
+          // and from sub-MIPs on threads (CbcSubMipThreads)
+          if (pollSubBranchAndBound(false)) {
+            foundSolution = 1;
+            heurValue = getCutoff();
+            whereFrom |= 8; // say solution found
+          }
           for (iHeur = 0; iHeur < numberHeuristics_; iHeur++) {
             // skip if can't run here
             if (!heuristic_[iHeur]->shouldHeurRun(whereFrom))
               continue;
+            // tree search does not wait for heuristics on background thread
+            if (postTreeHeuristic(iHeur))
+              continue;
+            // dives run together (CbcConcurrentDives)
+            int numberFound = runDivePortfolio(iHeur);
+            if (numberFound >= 0) {
+              if (numberFound) {
+                foundSolution = 1;
+                heurValue = getCutoff();
+                whereFrom |= 8; // say solution found
+              }
+              continue;
+            }
             double saveValue = heurValue;
-            int ifSol = heuristic_[iHeur]->solution(heurValue, newSolution);
+            int ifSol = heuristic_[iHeur]->solutionWithStatistics(heurValue, newSolution);
             if (ifSol > 0) {
               // new solution found
               heuristic_[iHeur]->incrementNumberSolutionsFound();
@@ -17401,10 +20776,13 @@ int CbcModel::doOneNode(CbcModel *baseModel, CbcNode *&node, CbcNode *&newNode)
             foundSolution = 1;
           }
           delete[] newSolution;
+          heuristicsTimer.stop();
           newNode->setGuessedObjectiveValue(estValue);
           if (parallelMode() >= 0) {
-            if (!masterThread_) // only if serial
+            if (!masterThread_) { // only if serial
+              CbcPhaseTimer pushTimer(phaseTimes_, CbcPhaseTimes::treePush);
               tree_->push(newNode);
+            }
           }
           if (statistics_) {
             if (numberNodes2_ == maximumStatistics_) {
@@ -17466,9 +20844,14 @@ int CbcModel::doOneNode(CbcModel *baseModel, CbcNode *&node, CbcNode *&newNode)
       // set nodenumber correctly
       if (node->nodeInfo())
         node->nodeInfo()->setNodeNumber(numberNodes2_);
+      // arm left was solved when node was made - so bound is exact
+      if (node->haveChildResults())
+        node->setObjectiveValue(CoinMax(node->objectiveValue(), node->childObjective()));
       if (parallelMode() >= 0) {
-        if (!masterThread_) // only if serial
+        if (!masterThread_) { // only if serial
+          CbcPhaseTimer pushTimer(phaseTimes_, CbcPhaseTimes::treePush);
           tree_->push(node);
+        }
       }
       if (statistics_) {
         if (numberNodes2_ == maximumStatistics_) {
@@ -17591,6 +20974,8 @@ int CbcModel::doOneNode(CbcModel *baseModel, CbcNode *&node, CbcNode *&newNode)
 // Adds an update information object
 void CbcModel::addUpdateInformation(const CbcObjectUpdateData &data)
 {
+  if (shareUpdateInformation(data))
+    return;
   if (numberUpdateItems_ == maximumNumberUpdateItems_) {
     maximumNumberUpdateItems_ += 10;
     CbcObjectUpdateData *temp = new CbcObjectUpdateData[maximumNumberUpdateItems_];
@@ -17624,6 +21009,9 @@ void CbcModel::previousBounds(CbcNode *node, CbcNodeInfo *where, int iColumn,
       nWhere = nNode;
   }
   assert(nWhere >= 0);
+  // bounds in node infos may change
+  if (boundTrail_)
+    boundTrail_->invalidate();
   nWhere = nNode - nWhere;
   for (i = 0; i < nWhere; i++) {
     --nNode;
@@ -17730,6 +21118,65 @@ void CbcModel::fillPseudoCosts(double *downCosts, double *upCosts,
 #endif
   delete[] back;
 }
+// Pseudocost arrays for batched scoring (NULL if not wanted)
+CbcPseudoCostArrays *CbcModel::pseudoCostArrays()
+{
+  if (!intParam_[CbcBatchPseudoCosts])
+    return NULL;
+  if (!pseudoCostArrays_)
+    pseudoCostArrays_ = new CbcPseudoCostArrays();
+  return pseudoCostArrays_->check(this) ? pseudoCostArrays_ : NULL;
+}
+// Adaptive strong branching budget (NULL if not wanted)
+CbcStrongBudget *CbcModel::strongBudget()
+{
+  if (!intParam_[CbcAdaptiveStrong])
+    return NULL;
+  if (!strongBudget_)
+    strongBudget_ = new CbcStrongBudget();
+  return strongBudget_;
+}
+// Objects want columns changed since last pass
+void CbcModel::wantSolutionChanges()
+{
+  if (!solutionChanges_)
+    solutionChanges_ = new CbcSolutionChanges();
+}
+// View of solver for round of cut generation
+CbcSeparationContext *CbcModel::separationContext()
+{
+  if (!separationContext_)
+    separationContext_ = new CbcSeparationContext();
+  return separationContext_;
+}
+// Conflict from Farkas ray of infeasible solver into global cuts
+int CbcModel::analyzeConflict(const OsiSolverInterface *solver)
+{
+  if ((moreSpecialOptions_ & 4194304) == 0 || parentModel_ || parallelMode() || !topOfTree_)
+    return 0;
+  if (!solver->isProvenPrimalInfeasible())
+    return 0;
+  if (!conflictAnalysis_)
+    conflictAnalysis_ = new CbcConflictAnalysis();
+  OsiRowCut *cut = conflictAnalysis_->analyze(solver, topOfTree_->lower(),
+    topOfTree_->upper(), numberRowsAtContinuous_);
+  if (!cut)
+    return 0;
+  if ((specialOptions_ & 1) != 0 && continuousSolver_) {
+    const OsiRowCutDebugger *debugger = continuousSolver_->getRowCutDebugger();
+    if (debugger && debugger->invalidCut(*cut)) {
+      printf("Conflict cut cuts off optimal solution\n");
+      delete cut;
+      return 0;
+    }
+  }
+  int numberBefore = globalCuts_.sizeRowCuts();
+  makeGlobalCut(cut);
+  if (globalCuts_.sizeRowCuts() > numberBefore)
+    conflictAnalysis_->added(globalCuts_.cut(numberBefore), numberNodes_);
+  delete cut;
+  return 1;
+}
 // Redo walkback arrays
 void CbcModel::redoWalkBack()
 {
@@ -17752,6 +21199,101 @@ void CbcModel::redoWalkBack()
   delete[] lastNumberCuts_;
   lastNumberCuts_ = temp3;
 }
+// Rough estimate of bytes used by a solver
+static double solverBytes(const OsiSolverInterface *solver)
+{
+  if (!solver)
+    return 0.0;
+  int numberRows = solver->getNumRows();
+  int numberColumns = solver->getNumCols();
+  double numberElements = solver->getNumElements();
+  // row and column copies of matrix and about ten arrays each for rows and columns
+  return 2.0 * numberElements * (sizeof(double) + sizeof(int))
+    + 10.0 * sizeof(double) * (numberRows + numberColumns);
+}
+// Bytes in a row cut
+static double cutBytes(const OsiRowCut *cut)
+{
+  return sizeof(CbcCountRowCut) + cut->row().getNumElements() * (sizeof(double) + sizeof(int));
+}
+/* Estimated bytes used by branch and bound by category.
+   Node infos are found by walking up from live nodes and each is
+   counted once.
+*/
+double CbcModel::memoryUsage(double *bytes)
+{
+  for (int i = 0; i < CbcLastMemoryType; i++)
+    bytes[i] = 0.0;
+  int numberColumns = solver_ ? solver_->getNumCols() : 0;
+  std::set< const CbcNodeInfo * > seen;
+  int numberNodes = tree_ ? tree_->size() : 0;
+  for (int iNode = -1; iNode < numberNodes; iNode++) {
+    const CbcNode *node = (iNode >= 0) ? tree_->nodePointer(iNode) : currentNode_;
+    if (!node)
+      continue;
+    bytes[CbcMemoryNodes] += sizeof(CbcNode);
+    if (node->branchingObject())
+      bytes[CbcMemoryNodes] += sizeof(CbcDynamicPseudoCostBranchingObject);
+    const CbcNodeInfo *info = node->nodeInfo();
+    while (info && seen.insert(info).second) {
+      const CbcPartialNodeInfo *partial = dynamic_cast< const CbcPartialNodeInfo * >(info);
+      if (partial) {
+        bytes[CbcMemoryNodeInfo] += sizeof(CbcPartialNodeInfo)
+          + partial->numberChangedBounds() * (partial->binaryBounds() ? sizeof(int) : sizeof(double) + sizeof(int));
+        // both bases are kept while diff deferred - at most twice diff
+        bytes[CbcMemoryWarmStart] += (partial->basisDiffDeferred() ? 2 : 1)
+          * partial->basisDiffBytes();
+      } else if (dynamic_cast< const CbcFullNodeInfo * >(info)) {
+        bytes[CbcMemoryNodeInfo] += sizeof(CbcFullNodeInfo)
+          + dynamic_cast< const CbcFullNodeInfo * >(info)->boundsBytes();
+        bytes[CbcMemoryWarmStart] += sizeof(CoinWarmStartBasis)
+          + 0.25 * (numberColumns + numberRowsAtContinuous_ + info->numberCuts());
+      }
+      int numberCuts = info->numberCuts();
+      bytes[CbcMemoryNodeInfo] += numberCuts * sizeof(CbcCountRowCut *);
+      CbcCountRowCut **cuts = info->cuts();
+      for (int i = 0; i < numberCuts; i++) {
+        if (cuts[i])
+          bytes[CbcMemoryNodeCuts] += cutBytes(cuts[i]);
+      }
+      info = info->parent();
+    }
+  }
+  for (int i = 0; i < globalCuts_.sizeRowCuts(); i++)
+    bytes[CbcMemoryGlobalCuts] += cutBytes(globalCuts_.rowCutPtr(i));
+  if (globalConflictCuts_) {
+    for (int i = 0; i < globalConflictCuts_->sizeRowCuts(); i++)
+      bytes[CbcMemoryGlobalCuts] += cutBytes(globalConflictCuts_->rowCutPtr(i));
+  }
+  for (int i = 0; i < numberCutGenerators_; i++) {
+    const OsiCuts &saved = generator_[i]->savedCuts();
+    bytes[CbcMemoryGenerators] += sizeof(CbcCutGenerator);
+    for (int j = 0; j < saved.sizeRowCuts(); j++)
+      bytes[CbcMemoryGenerators] += cutBytes(saved.rowCutPtr(j));
+  }
+  if (bestSolution_)
+    bytes[CbcMemorySolutions] += sizeof(double) * numberColumns;
+  if (continuousSolution_)
+    bytes[CbcMemorySolutions] += sizeof(double) * numberColumns;
+  if (usedInSolution_)
+    bytes[CbcMemorySolutions] += sizeof(int) * numberColumns;
+  bytes[CbcMemorySolutions] += numberSavedSolutions_ * sizeof(double) * (numberColumns + 2);
+  bytes[CbcMemorySolvers] = solverBytes(solver_) + solverBytes(continuousSolver_)
+    + solverBytes(referenceSolver_) + solverBytes(atSolutionSolver_);
+#ifdef CBC_THREAD
+  if (master_) {
+    for (int i = 0; i < master_->numberThreads(); i++) {
+      CbcModel *model = master_->model(i);
+      if (model && model != this)
+        bytes[CbcMemoryThreads] += sizeof(CbcModel) + solverBytes(model->solver());
+    }
+  }
+#endif
+  for (int i = 0; i < CbcMemoryTotal; i++)
+    bytes[CbcMemoryTotal] += bytes[i];
+  memoryHighWater_ = CoinMax(memoryHighWater_, bytes[CbcMemoryTotal]);
+  return bytes[CbcMemoryTotal];
+}
 /* Return true if we want to do cuts
    If allowForTopOfTree zero then just does on multiples of depth
    if 1 then allows for doing at top of tree
@@ -17870,6 +21412,7 @@ void CbcModel::setMaximumSavedSolutions(int value)
     maximumSavedSolutions_ = value;
     numberSavedSolutions_ = CoinMin(numberSavedSolutions_,
       maximumSavedSolutions_);
+    savedHash_.clear();
     if (!maximumSavedSolutions_)
       delete[] savedSolutions_;
   } else if (value > maximumSavedSolutions_) {
@@ -17912,46 +21455,139 @@ CbcModel::savedSolution(int which) const
     return NULL;
   }
 }
-// Save a solution
-void CbcModel::saveExtraSolution(const double *solution, double objectiveValue)
+// Hash of integer values of a solution (zero values make no difference)
+static unsigned int integerHash(const OsiSolverInterface *solver,
+  const double *solution, int numberColumns)
 {
-  double *save = NULL;
-  if (maximumSavedSolutions_) {
-    if (!savedSolutions_) {
-      savedSolutions_ = new double *[maximumSavedSolutions_];
-      for (int i = 0; i < maximumSavedSolutions_; i++)
-        savedSolutions_[i] = NULL;
+  unsigned int hash = 2166136261u;
+  for (int i = 0; i < numberColumns; i++) {
+    if (solver->isInteger(i)) {
+      int value = static_cast< int >(floor(solution[i] + 0.5));
+      if (value)
+        hash = (hash ^ static_cast< unsigned int >(value * 131 + i)) * 16777619u;
     }
-    int n = solver_->getNumCols();
-    int k;
-    for (k = numberSavedSolutions_ - 1; k >= 0; k--) {
-      double *sol = savedSolutions_[k];
-      assert(static_cast< int >(sol[0]) == n);
-      if (objectiveValue > sol[1])
+  }
+  return hash;
+}
+// Number of integer variables with different values (stops at maximum)
+static int integerDistance(const OsiSolverInterface *solver,
+  const double *solution1, const double *solution2, int numberColumns,
+  int maximum)
+{
+  int distance = 0;
+  for (int i = 0; i < numberColumns; i++) {
+    if (solver->isInteger(i) && fabs(solution1[i] - solution2[i]) > 0.5) {
+      distance++;
+      if (distance >= maximum)
         break;
     }
-    k++; // where to put
-    if (k < maximumSavedSolutions_) {
-      if (numberSavedSolutions_ == maximumSavedSolutions_) {
-        save = savedSolutions_[numberSavedSolutions_ - 1];
-      } else {
-        save = new double[n + 2];
-        numberSavedSolutions_++;
-      }
-      // move up
-      for (int j = maximumSavedSolutions_ - 1; j > k; j--)
-        savedSolutions_[j] = savedSolutions_[j - 1];
-      savedSolutions_[k] = save;
-      save[0] = n;
-      save[1] = objectiveValue;
-      memcpy(save + 2, solution, n * sizeof(double));
-      bool allInt = (solver_->getNumIntegers() == solver_->getNumCols());
-      double *x = save + 2;
-      if (roundIntVars_ || allInt) {
-        for ( int i=0 ; (i<n) ; ++i )
-          if (solver_->isInteger(i))
-            x[i] = floor(x[i] + 0.5);
-      }
+  }
+  return distance;
+}
+// Save a solution
+void CbcModel::saveExtraSolution(const double *solution, double objectiveValue)
+{
+  if (!maximumSavedSolutions_)
+    return;
+  if (!savedSolutions_) {
+    savedSolutions_ = new double *[maximumSavedSolutions_];
+    for (int i = 0; i < maximumSavedSolutions_; i++)
+      savedSolutions_[i] = NULL;
+  }
+  int n = solver_->getNumCols();
+  if (static_cast< int >(savedHash_.size()) != numberSavedSolutions_) {
+    savedHash_.resize(numberSavedSolutions_);
+    for (int i = 0; i < numberSavedSolutions_; i++)
+      savedHash_[i] = integerHash(solver_, savedSolutions_[i] + 2, n);
+  }
+  unsigned int hash = integerHash(solver_, solution, n);
+  // Same integer values as best or one kept - keep better
+  if (bestSolution_ && solution != bestSolution_
+    && !integerDistance(solver_, solution, bestSolution_, n, 1))
+    return;
+  for (int i = 0; i < numberSavedSolutions_; i++) {
+    if (savedHash_[i] == hash
+      && !integerDistance(solver_, solution, savedSolutions_[i] + 2, n, 1)) {
+      if (objectiveValue >= savedSolutions_[i][1] || solution == savedSolutions_[i] + 2)
+        return;
+      deleteSavedSolution(i + 1);
+      break;
+    }
+  }
+  int k;
+  for (k = numberSavedSolutions_ - 1; k >= 0; k--) {
+    double *sol = savedSolutions_[k];
+    assert(static_cast< int >(sol[0]) == n);
+    if (objectiveValue > sol[1])
+      break;
+  }
+  k++; // where to put
+  double *save;
+  if (numberSavedSolutions_ == maximumSavedSolutions_) {
+    /*
+      Full - drop the solution (new one at k or a saved one) nearest to a
+      better one if it differs in fewer than 5% of integers, otherwise the
+      worst.  The saved solutions stay varied for crossover and the like.
+    */
+    int nearDistance = solver_->getNumIntegers() / 20;
+    int drop = numberSavedSolutions_;
+    int dropDistance = nearDistance + 1;
+    for (int j = numberSavedSolutions_; j >= 0; j--) {
+      const double *x = (j == k) ? solution : savedSolutions_[j < k ? j : j - 1] + 2;
+      int distance = dropDistance;
+      if (bestSolution_ && x != bestSolution_)
+        distance = integerDistance(solver_, x, bestSolution_, n, distance);
+      for (int i = 0; i < j && distance; i++) {
+        const double *y = (i == k) ? solution : savedSolutions_[i < k ? i : i - 1] + 2;
+        distance = integerDistance(solver_, x, y, n, distance);
+      }
+      if (distance < dropDistance) {
+        drop = j;
+        dropDistance = distance;
+      }
+    }
+    if (drop == k)
+      return; // new one adds least
+    int which = drop < k ? drop : drop - 1;
+    save = savedSolutions_[which];
+    for (int j = which; j < numberSavedSolutions_ - 1; j++)
+      savedSolutions_[j] = savedSolutions_[j + 1];
+    savedHash_.erase(savedHash_.begin() + which);
+    numberSavedSolutions_--;
+    if (which < k)
+      k--;
+  } else {
+    save = new double[n + 2];
+  }
+  // move up
+  for (int j = numberSavedSolutions_; j > k; j--)
+    savedSolutions_[j] = savedSolutions_[j - 1];
+  savedSolutions_[k] = save;
+  savedHash_.insert(savedHash_.begin() + k, hash);
+  numberSavedSolutions_++;
+  save[0] = n;
+  save[1] = objectiveValue;
+  memcpy(save + 2, solution, n * sizeof(double));
+  bool allInt = (solver_->getNumIntegers() == solver_->getNumCols());
+  double *x = save + 2;
+  if (roundIntVars_ || allInt) {
+    for ( int i=0 ; (i<n) ; ++i )
+      if (solver_->isInteger(i))
+        x[i] = floor(x[i] + 0.5);
+  }
+}
+// Switch off rounding of cutoff if solution is not on lattice
+void CbcModel::checkCutoffStep(double objectiveValue)
+{
+  if (cutoffStep_ > 0.0) {
+    double steps = (objectiveValue - cutoffStepOffset_) / cutoffStep_;
+    if (fabs(steps - floor(steps + 0.5)) * cutoffStep_ > 1.0e-5 * (1.0 + fabs(objectiveValue))) {
+      char general[200];
+      sprintf(general, "Solution %g not multiple of objective step %g - step not used",
+        objectiveValue, cutoffStep_);
+      messageHandler()->message(CBC_GENERAL, messages())
+        << general << CoinMessageEol;
+      cutoffStep_ = 0.0;
     }
   }
 }
@@ -17959,11 +21595,15 @@ void CbcModel::saveExtraSolution(const double *solution, double objectiveValue)
 void CbcModel::saveBestSolution(const double *solution, double objectiveValue)
 {
   int n = solver_->getNumCols();
-  if (bestSolution_)
-    saveExtraSolution(bestSolution_, bestObjective_);
-  else
+  if (bestSolution_) {
+    // old best is not kept if only continuous values change
+    if (integerDistance(solver_, solution, bestSolution_, n, 1))
+      saveExtraSolution(bestSolution_, bestObjective_);
+  } else {
     bestSolution_ = new double[n];
+  }
   bestObjective_ = objectiveValue;
+  checkCutoffStep(objectiveValue);
   memcpy(bestSolution_, solution, n * sizeof(double));
   bool allInt = (solver_->getNumIntegers() == solver_->getNumCols());
   if (roundIntVars_ || allInt) {
@@ -17971,6 +21611,13 @@ void CbcModel::saveBestSolution(const double *solution, double objectiveValue)
       if (solver_->isInteger(i))
         bestSolution_[i] = floor(bestSolution_[i] + 0.5);
   }
+  // drop saved solution with same integer values
+  for (int i = 0; i < numberSavedSolutions_; i++) {
+    if (!integerDistance(solver_, bestSolution_, savedSolutions_[i] + 2, n, 1)) {
+      deleteSavedSolution(i + 1);
+      break;
+    }
+  }
   if ((moreSpecialOptions2_&65536)!=0) {
     // save a copy of solver with constraints
     delete atSolutionSolver_;
@@ -17989,12 +21636,17 @@ void CbcModel::deleteSolutions()
     savedSolutions_[i] = NULL;
   }
   numberSavedSolutions_ = 0;
+  savedHash_.clear();
 }
 // Delete a saved solution and move others up
 void CbcModel::deleteSavedSolution(int which)
 {
   if (which > 0 && which <= numberSavedSolutions_) {
     delete[] savedSolutions_[which - 1];
+    if (static_cast< int >(savedHash_.size()) == numberSavedSolutions_)
+      savedHash_.erase(savedHash_.begin() + (which - 1));
+    else
+      savedHash_.clear();
     // move up
     numberSavedSolutions_--;
     for (int j = which - 1; j < numberSavedSolutions_; j++) {
@@ -18033,6 +21685,65 @@ void CbcModel::goToDantzig(int numberNodes, ClpDualRowPivot *&savePivotMethod)
     }
   }
 }
+// Choose between normal dual pricing and Dantzig from measured time
+void CbcModel::adaptDualPricing(OsiClpSolverInterface *clpSolver, double seconds)
+{
+  ClpSimplex *simplex = clpSolver->getModelPtr();
+  int method = savedDualPivot_ ? 1 : 0;
+  if (!method && dynamic_cast< ClpDualRowDantzig * >(simplex->dualRowPivot())) {
+    // nothing to choose
+    pricingState_ = -1;
+    return;
+  }
+  pricingSeconds_[method] += seconds;
+  pricingIterations_[method] += simplex->numberIterations();
+  pricingSolves_[method]++;
+  if (--pricingCountdown_ > 0)
+    return;
+  int wanted = method;
+  if (pricingState_ == 0) {
+    // have measure of this one - try other
+    wanted = 1 - method;
+    pricingState_ = 1;
+    pricingCountdown_ = CBC_PRICING_TRIAL;
+  } else if (pricingState_ == 1) {
+    double average0 = pricingSeconds_[0] / CoinMax(pricingSolves_[0], 1);
+    double average1 = pricingSeconds_[1] / CoinMax(pricingSolves_[1], 1);
+    // Dantzig must be clearly better as steepest edge is more robust
+    wanted = (average1 < 0.9 * average0) ? 1 : 0;
+#ifdef COIN_DEVELOP
+    printf("%d node, normal %g seconds %g iterations per solve, Dantzig %g seconds %g iterations -> %s\n",
+      numberNodes_, average0, pricingIterations_[0] / CoinMax(pricingSolves_[0], 1),
+      average1, pricingIterations_[1] / CoinMax(pricingSolves_[1], 1),
+      wanted ? "Dantzig" : "normal");
+#endif
+    pricingState_ = 2;
+    pricingCountdown_ = pricingPeriod_;
+    pricingPeriod_ = CoinMin(2 * pricingPeriod_, 32000);
+  } else {
+    // nodes may be different now - measure both again
+    for (int i = 0; i < 2; i++) {
+      pricingSeconds_[i] = 0.0;
+      pricingIterations_[i] = 0.0;
+      pricingSolves_[i] = 0;
+    }
+    pricingState_ = 0;
+    pricingCountdown_ = CBC_PRICING_TRIAL;
+  }
+  if (wanted != method) {
+    if (wanted) {
+      savedDualPivot_ = simplex->dualRowPivot()->clone(true);
+      ClpDualRowDantzig dantzig;
+      simplex->setDualRowPivotAlgorithm(dantzig);
+    } else {
+      // model may have changed
+      savedDualPivot_->setModel(NULL);
+      simplex->setDualRowPivotAlgorithm(*savedDualPivot_);
+      delete savedDualPivot_;
+      savedDualPivot_ = NULL;
+    }
+  }
+}
 #else
 CbcModel::goToDantzig(int numberNodes, ClpDualRowPivot *&savePivotMethod)
 {
@@ -18293,7 +22004,7 @@ bool CbcModel::integerPresolveThisModel(OsiSolverInterface *originalSolver,
           if (!heuristic_[iHeuristic]->shouldHeurRun(whereFrom))
             continue;
           double saveValue = heuristicValue;
-          int ifSol = heuristic_[iHeuristic]->solution(heuristicValue,
+          int ifSol = heuristic_[iHeuristic]->solutionWithStatistics(heuristicValue,
             newSolution);
           if (ifSol > 0) {
             // better solution found
@@ -18526,6 +22237,8 @@ bool CbcModel::maximumSecondsReached() const
   if (numberSolutions_ && (!hitMaxTime)) {
       hitMaxTime = totalTime - lastTimeImprovingFeasSol_ >= dblParam_[CbcMaximumSecondsNotImprovingFeasSol];
   }
+  if (dblParam_[CbcMaximumWork] > 0.0 && !hitMaxTime)
+    hitMaxTime = workUnits() >= dblParam_[CbcMaximumWork];
   if (parentModel_ && !hitMaxTime) {
     // In a sub tree
     assert(parentModel_);
@@ -18535,6 +22248,9 @@ bool CbcModel::maximumSecondsReached() const
       double maxSecondsNotImprFS = parentModel_->getDblParam(CbcMaximumSecondsNotImprovingFeasSol);
       hitMaxTime = totalTime - lastTimeImprovingFeasSol_ >= maxSecondsNotImprFS;
     }
+    double maxWork = parentModel_->getDblParam(CbcMaximumWork);
+    if (maxWork > 0.0 && !hitMaxTime)
+      hitMaxTime = parentModel_->workUnits() + workUnits() >= maxWork;
   }
   if (hitMaxTime) {
     // Set eventHappened_ so will by-pass as much stuff as possible
@@ -18542,30 +22258,29 @@ bool CbcModel::maximumSecondsReached() const
   }
   return hitMaxTime;
 }
+// Deterministic measure of work done
+double CbcModel::workUnits() const
+{
+  double work = static_cast< double >(numberIterations_) + numberExtraIterations_
+    + numberNodes_ + numberExtraNodes_;
+  int numberCalls = 0;
+  for (int i = 0; i < numberCutGenerators_; i++)
+    numberCalls += generator_[i]->numberTimes();
+  for (int i = 0; i < numberHeuristics_; i++)
+    numberCalls += heuristic_[i]->numRuns();
+  if (numberCalls && solver_) {
+    double callWork = 0.01 * (solver_->getNumRows() + solver_->getNumCols());
+    work += numberCalls * CoinMax(callWork, 1.0);
+  }
+  return work;
+}
 // Check original model before it gets messed up
 void CbcModel::checkModel()
 {
-  int iColumn;
-  int numberColumns = getNumCols();
-  const double *lower = getColLower();
-  const double *upper = getColUpper();
-  int setFlag = 65536;
-  for (iColumn = 0; iColumn < numberColumns; iColumn++) {
-    if (upper[iColumn] > lower[iColumn] + 1.0e-8) {
-      double value;
-      value = fabs(lower[iColumn]);
-      if (floor(value + 0.5) != value) {
-        setFlag = 0;
-        break;
-      }
-      value = fabs(upper[iColumn]);
-      if (floor(value + 0.5) != value) {
-        setFlag = 0;
-        break;
-      }
-    }
-  }
-  specialOptions_ |= setFlag;
+  CbcColumnScan scan;
+  scanColumns(this, scan);
+  if (scan.integralBounds)
+    specialOptions_ |= 65536;
 }
 static void flipSolver(OsiSolverInterface *solver, double newCutoff)
 {
@@ -18975,6 +22690,8 @@ CbcModel::strengthenedModel()
   walkback_ = NULL;
   delete[] lastNodeInfo_;
   lastNodeInfo_ = NULL;
+  delete boundTrail_;
+  boundTrail_ = NULL;
   delete[] lastNumberCuts_;
   lastNumberCuts_ = NULL;
   delete[] lastCut_;
@@ -19052,6 +22769,7 @@ CbcModel::cleanModel(const double *lower, const double *upper)
   model->setCutoff(cutoff);
   return model;
 }
+#endif
 /* Invoke the branch & cut algorithm on partially fixed problem
 
    The method uses a subModel created by cleanModel. The search
@@ -19074,7 +22792,6 @@ int CbcModel::subBranchAndBound(CbcModel *model,
   CbcModel *presolvedModel,
   int maximumNodes)
 {
-  int i;
   double cutoff = model->getCutoff();
   CbcModel *model2;
   if (presolvedModel)
@@ -19082,8 +22799,14 @@ int CbcModel::subBranchAndBound(CbcModel *model,
   else
     model2 = model;
   // Do complete search
-
-  for (i = 0; i < numberHeuristics_; i++) {
+  setUpSubBranchAndBound(model2, maximumNodes);
+  model2->branchAndBound();
+  return takeSubBranchAndBound(model, presolvedModel, cutoff);
+}
+// Give sub-MIP heuristics, node comparison and options of this model
+void CbcModel::setUpSubBranchAndBound(CbcModel *model2, int maximumNodes)
+{
+  for (int i = 0; i < numberHeuristics_; i++) {
     model2->addHeuristic(heuristic_[i]);
     model2->heuristic(i)->resetModel(model2);
   }
@@ -19095,7 +22818,16 @@ int CbcModel::subBranchAndBound(CbcModel *model,
   model2->setMaximumCutPassesAtRoot(maximumCutPassesAtRoot_);
   model2->setPrintFrequency(50);
   model2->setIntParam(CbcModel::CbcMaxNumNode, maximumNodes);
-  model2->branchAndBound();
+}
+// Take back solution of sub-MIP after search and delete models
+int CbcModel::takeSubBranchAndBound(CbcModel *model, CbcModel *presolvedModel,
+  double cutoff)
+{
+  CbcModel *model2;
+  if (presolvedModel)
+    model2 = presolvedModel;
+  else
+    model2 = model;
   delete model2->nodeComparison();
   if (model2->getMinimizationObjValue() > cutoff) {
     // no good
@@ -19168,10 +22900,15 @@ int CbcModel::subBranchAndBound(const double *lower, const double *upper,
   model.setCutoff(cutoff);
   // integer presolve
   CbcModel *model2 = model.integerPresolve(false);
-  if (!model2 || !model2->getNumRows()) {
-    delete model2;
+  if (!model2) {
+    // infeasible
     delete solver;
     return 2;
+  } else if (!model2->getNumRows()) {
+    // not searched
+    delete model2;
+    delete solver;
+    return 3;
   }
   if (handler_->logLevel() > 1)
     printf("Reduced model has %d rows and %d columns\n",
@@ -19229,7 +22966,6 @@ int CbcModel::subBranchAndBound(const double *lower, const double *upper,
   delete solver;
   return status;
 }
-#endif
 
 static void *doRootCbcThread(void *voidInfo)
 {
@@ -19643,6 +23379,325 @@ void CbcModel::setMIPStart(int count, const char **colNames, const double colVal
   for (int i = 0; (i < count); ++i)
     mipStart_.push_back(std::pair< std::string, double >(std::string(colNames[i]), colValues[i]));
 }
+// Write pseudocosts learnt by dynamic integer objects to csv file
+int CbcModel::writePseudoCosts(const char *fileName,
+  const std::vector< std::string > *columnNames) const
+{
+  FILE *fp = fopen(fileName, "w");
+  if (!fp)
+    return -1;
+  fprintf(fp, "name,down,up,downcount,upcount\n");
+  std::vector< std::string > names;
+  std::vector< double > values;
+  int numberWritten = getPseudoCosts(names, values, columnNames);
+  for (int i = 0; i < numberWritten; i++) {
+    const double *value = &values[4 * i];
+    fprintf(fp, "%s,%.15g,%.15g,%d,%d\n", names[i].c_str(),
+      value[0], value[1], static_cast< int >(value[2]),
+      static_cast< int >(value[3]));
+  }
+  fclose(fp);
+  return numberWritten;
+}
+// Pseudocosts learnt by dynamic integer objects kept in memory
+int CbcModel::getPseudoCosts(std::vector< std::string > &names,
+  std::vector< double > &values,
+  const std::vector< std::string > *columnNames) const
+{
+  names.clear();
+  values.clear();
+  for (int i = 0; i < numberObjects_; i++) {
+    const CbcSimpleIntegerDynamicPseudoCost *obj = dynamic_cast< const CbcSimpleIntegerDynamicPseudoCost * >(object_[i]);
+    if (!obj)
+      continue;
+    int iColumn = obj->columnNumber();
+    std::string name;
+    if (columnNames) {
+      if (iColumn >= static_cast< int >(columnNames->size()))
+        continue;
+      name = (*columnNames)[iColumn];
+    } else {
+      name = solver_->getColName(iColumn);
+    }
+    if (!name.size())
+      continue;
+    names.push_back(name);
+    values.push_back(obj->downDynamicPseudoCost());
+    values.push_back(obj->upDynamicPseudoCost());
+    values.push_back(obj->numberTimesDown());
+    values.push_back(obj->numberTimesUp());
+  }
+  return static_cast< int >(names.size());
+}
+// Pseudocosts to use at start from an earlier model
+void CbcModel::setPseudoCostStart(const std::vector< std::string > &names,
+  const std::vector< double > &values)
+{
+  assert(values.size() == 4 * names.size());
+  pseudoCostStartNames_ = names;
+  pseudoCostStart_ = values;
+}
+// Features of model in solver (no LP solved)
+void CbcModel::computeFeatures(double *features) const
+{
+  CbcFeatures::compute(features, solver_);
+}
+// Pass in pricer for branch and price
+void CbcModel::passInPricer(const CbcPricer *pricer)
+{
+  delete pricer_;
+  pricer_ = pricer ? pricer->clone() : NULL;
+}
+
+// Puts coefficients and cost of slot in a solver - false if can not
+static bool fillSlot(OsiSolverInterface *solver, int iColumn, int numberElements,
+  const int *rows, const double *elements, double objective)
+{
+#ifdef CBC_HAS_CLP
+  OsiClpSolverInterface *clpSolver
+    = dynamic_cast< OsiClpSolverInterface * >(solver);
+  if (!clpSolver)
+    return false;
+  for (int i = 0; i < numberElements; i++)
+    clpSolver->modifyCoefficient(rows[i], iColumn, elements[i]);
+  clpSolver->setObjCoeff(iColumn, objective);
+  return true;
+#else
+  return false;
+#endif
+}
+
+// Puts priced column in next free slot
+int CbcModel::addPricedColumn(int numberElements, const int *rows,
+  const double *elements, double objective)
+{
+  // coefficients can only be changed in Clp
+#ifdef CBC_HAS_CLP
+  if (!dynamic_cast< OsiClpSolverInterface * >(solver_))
+    return -2;
+#else
+  return -2;
+#endif
+  int iColumn = columnPool_.addColumn(numberElements, rows, elements, objective);
+  if (iColumn < 0)
+    return iColumn;
+  int iPool = columnPool_.numberColumns() - 1;
+  int n = columnPool_.columnLength(iPool);
+  const int *which = columnPool_.columnRows(iPool);
+  const double *values = columnPool_.columnElements(iPool);
+  fillSlot(solver_, iColumn, n, which, values, objective);
+  if (continuousSolver_)
+    fillSlot(continuousSolver_, iColumn, n, which, values, objective);
+  // slot was empty so can be zero in solutions without changing them
+  if (bestSolution_)
+    bestSolution_[iColumn] = 0.0;
+  for (int i = 0; i < numberSavedSolutions_; i++)
+    savedSolutions_[i][iColumn + 2] = 0.0;
+  savedHash_.clear();
+  return iColumn;
+}
+
+// Adds priced columns to LP of node until pricer finds none
+void CbcModel::priceColumns(CbcNode *node)
+{
+  // LP without all columns is not a bound so must not stop at cutoff
+  double saveLimit;
+  solver_->getDblParam(OsiDualObjectiveLimit, saveLimit);
+  solver_->setDblParam(OsiDualObjectiveLimit, COIN_DBL_MAX);
+  solver_->resolve();
+  int maximumPasses = pricer_->maximumPasses();
+  for (int iPass = 0; iPass < maximumPasses; iPass++) {
+    if (!solver_->isProvenOptimal())
+      break;
+    if (!pricer_->price(this, node))
+      break;
+    solver_->resolve();
+  }
+  solver_->setDblParam(OsiDualObjectiveLimit, saveLimit);
+}
+/* Write statistics of cut generators by depth bucket - one record
+   for each generator and bucket which was used */
+int CbcModel::writeCutStatistics(const char *fileName, bool json) const
+{
+  FILE *fp = fopen(fileName, "w");
+  if (!fp)
+    return -1;
+  if (json)
+    fprintf(fp, "{\n  \"cutStatistics\": [");
+  else
+    fprintf(fp, "generator,name,depth,calls,time,cuts,active,improvement\n");
+  int numberWritten = 0;
+  for (int i = 0; i < numberCutGenerators_; i++) {
+    const CbcCutGenerator *generator = generator_[i];
+    for (int k = 0; k < CBC_STATISTICS_DEPTHS; k++) {
+      if (!generator->depthCalls(k))
+        continue;
+      if (json) {
+        fprintf(fp, "%s\n    { \"generator\": %d, \"name\": \"%s\", \"depth\": %d, \"calls\": %d, \"time\": %.6f, \"cuts\": %d, \"active\": %d, \"improvement\": %.15g }",
+          numberWritten ? "," : "", i, generator->cutGeneratorName(),
+          CbcCutGenerator::bucketDepth(k), generator->depthCalls(k),
+          generator->depthTime(k), generator->depthCuts(k),
+          generator->depthActive(k), generator->depthImprovement(k));
+      } else {
+        fprintf(fp, "%d,%s,%d,%d,%.6f,%d,%d,%.15g\n", i,
+          generator->cutGeneratorName(), CbcCutGenerator::bucketDepth(k),
+          generator->depthCalls(k), generator->depthTime(k),
+          generator->depthCuts(k), generator->depthActive(k),
+          generator->depthImprovement(k));
+      }
+      numberWritten++;
+    }
+  }
+  if (json)
+    fprintf(fp, "\n  ]\n}\n");
+  fclose(fp);
+  return numberWritten;
+}
+/* Read pseudocosts written by writePseudoCosts - headings may be in any
+   order and ones not known are skipped */
+int CbcModel::readPseudoCosts(const char *fileName, int maximumCount)
+{
+  FILE *fp = fopen(fileName, "r");
+  if (!fp)
+    return -1;
+  pseudoCostStartNames_.clear();
+  pseudoCostStart_.clear();
+  char line[1000];
+  // position of name, down, up, downcount, upcount
+  int field[5] = { -1, -1, -1, -1, -1 };
+  const char *headings[] = { "name", "down", "up", "downcount", "upcount" };
+  int numberFields = 0;
+  if (fgets(line, 1000, fp)) {
+    char *pos = line;
+    char *put = line;
+    while (*pos >= ' ' && *pos != '\n') {
+      if (*pos != ' ' && *pos != '\t') {
+        *put = static_cast< char >(tolower(*pos));
+        put++;
+      }
+      pos++;
+    }
+    *put = '\0';
+    pos = line;
+    while (pos) {
+      char *comma = strchr(pos, ',');
+      if (comma)
+        *comma = '\0';
+      for (int i = 0; i < 5; i++) {
+        if (!strcmp(headings[i], pos) && field[i] < 0)
+          field[i] = numberFields;
+      }
+      numberFields++;
+      pos = comma ? comma + 1 : NULL;
+    }
+  }
+  if (field[0] < 0) {
+    fclose(fp);
+    return 0;
+  }
+  while (fgets(line, 1000, fp)) {
+    char *pos = line;
+    char *put = line;
+    while (*pos >= ' ' && *pos != '\n') {
+      if (*pos != ' ' && *pos != '\t') {
+        *put = *pos;
+        put++;
+      }
+      pos++;
+    }
+    *put = '\0';
+    if (!strncmp(line, "ENDATA", 6) || !strncmp(line, "endata", 6))
+      break;
+    std::string name;
+    double value[4] = { 0.0, 0.0, 0.0, 0.0 };
+    pos = line;
+    for (int iField = 0; pos && iField < numberFields; iField++) {
+      char *comma = strchr(pos, ',');
+      if (comma)
+        *comma = '\0';
+      if (iField == field[0]) {
+        name = pos;
+      } else {
+        for (int i = 1; i < 5; i++) {
+          if (iField == field[i])
+            value[i - 1] = atof(pos);
+        }
+      }
+      pos = comma ? comma + 1 : NULL;
+    }
+    if (!name.size())
+      continue;
+    for (int i = 2; i < 4; i++) {
+      value[i] = floor(CoinMax(value[i], 0.0));
+      if (maximumCount >= 0)
+        value[i] = CoinMin(value[i], static_cast< double >(maximumCount));
+    }
+    pseudoCostStartNames_.push_back(name);
+    for (int i = 0; i < 4; i++)
+      pseudoCostStart_.push_back(value[i]);
+  }
+  fclose(fp);
+  return static_cast< int >(pseudoCostStartNames_.size());
+}
+// Give pseudocosts read by readPseudoCosts to dynamic objects
+int CbcModel::usePseudoCostStart()
+{
+  int numberChanged = 0;
+  if (pseudoCostStartNames_.size()) {
+    std::map< std::string, int > whichName;
+    for (int i = 0; i < static_cast< int >(pseudoCostStartNames_.size()); i++)
+      whichName[pseudoCostStartNames_[i]] = i;
+    for (int i = 0; i < numberObjects_; i++) {
+      CbcSimpleIntegerDynamicPseudoCost *obj = dynamic_cast< CbcSimpleIntegerDynamicPseudoCost * >(object_[i]);
+      if (!obj)
+        continue;
+      int iColumn = obj->columnNumber();
+      std::string name;
+      if (pseudoCostColumnNames_.size()) {
+        if (iColumn >= static_cast< int >(pseudoCostColumnNames_.size()))
+          continue;
+        name = pseudoCostColumnNames_[iColumn];
+      } else {
+        name = solver_->getColName(iColumn);
+      }
+      std::map< std::string, int >::const_iterator it = whichName.find(name);
+      if (it == whichName.end())
+        continue;
+      const double *value = &pseudoCostStart_[4 * it->second];
+      double down = value[0];
+      double up = value[1];
+      int numberDown = static_cast< int >(value[2]);
+      int numberUp = static_cast< int >(value[3]);
+      if (down > 0.0) {
+        if (numberDown) {
+          obj->setNumberTimesDown(numberDown);
+          obj->setSumDownCost(down * numberDown);
+          obj->setSumDownChange(numberDown);
+        }
+        obj->setDownDynamicPseudoCost(down);
+      }
+      if (up > 0.0) {
+        if (numberUp) {
+          obj->setNumberTimesUp(numberUp);
+          obj->setSumUpCost(up * numberUp);
+          obj->setSumUpChange(numberUp);
+        }
+        obj->setUpDynamicPseudoCost(up);
+      }
+      if (down > 0.0 || up > 0.0)
+        numberChanged++;
+    }
+    char general[200];
+    sprintf(general, "%d pseudocosts out of %d used from start",
+      numberChanged, static_cast< int >(pseudoCostStartNames_.size()));
+    messageHandler()->message(CBC_GENERAL, messages())
+      << general << CoinMessageEol;
+  }
+  pseudoCostStartNames_.clear();
+  pseudoCostStart_.clear();
+  pseudoCostColumnNames_.clear();
+  return numberChanged;
+}
 #ifdef CBC_HAS_NAUTY
 // get rid of all
 void CbcModel::zapSymmetry()
@@ -19650,6 +23705,185 @@ void CbcModel::zapSymmetry()
   delete symmetryInfo_;
   symmetryInfo_ = NULL;
 }
+// Print statistics for symmetryInfo_ and keep if useful
+void CbcModel::adoptSymmetry()
+{
+  symmetryInfo_->statsOrbits(this, 0);
+  if (intParam_[CbcOrbitopeFixing] && !orbitope_) {
+    int numberGenerators = symmetryInfo_->numberPermutations();
+    const int **next = new const int *[numberGenerators + 1];
+    int *cycleLength = new int[numberGenerators + 1];
+    for (int i = 0; i < numberGenerators; i++) {
+      next[i] = symmetryInfo_->permutation(i);
+      cycleLength[i] = symmetryInfo_->numberInPermutation(i);
+    }
+    orbitope_ = CbcOrbitope::find(solver_, numberGenerators, next, cycleLength);
+    delete[] next;
+    delete[] cycleLength;
+    if (orbitope_) {
+      char general[200];
+      sprintf(general, "Orbitope with %d columns of %d binaries - kept in lexicographic order",
+        orbitope_->numberColumns(), orbitope_->numberRows());
+      messageHandler()->message(CBC_GENERAL, messages())
+        << general << CoinMessageEol;
+      // orbital fixing and branching would not be valid as well
+      delete symmetryInfo_;
+      symmetryInfo_ = NULL;
+      moreSpecialOptions2_ &= ~(128 | 256 | 131072);
+      return;
+    }
+  }
+  if (!symmetryInfo_->numberUsefulOrbits() && (moreSpecialOptions2_ & (128 | 256)) != (128 | 256)) {
+    delete symmetryInfo_;
+    symmetryInfo_ = NULL;
+    moreSpecialOptions2_ &= ~(128 | 256 | 131072);
+  }
+  if ((moreSpecialOptions2_ & (128 | 256)) == (128 | 256)) {
+    if ((moreSpecialOptions2_&131072) != 0) {
+      // keep it simple
+      moreSpecialOptions2_ &= ~(128 | 256);
+      rootSymmetryInfo_ = symmetryInfo_;
+      symmetryInfo_ = NULL;
+    }
+  }
+}
+// Order nodes on objective
+static bool betterNode(const CbcNode *a, const CbcNode *b)
+{
+  return a->objectiveValue() < b->objectiveValue();
+}
+/* Take off nodes which are symmetric copies of other nodes.
+   Only nodes near top of tree which have not been branched on yet are
+   looked at.  Bounds of each are built from node information back to a
+   full node.  A key made from bounds and orbits (so same for images
+   under group) gives candidates and then each generator is tried.  If
+   a generator maps bounds of one node to those of a better one, the
+   subtree of better node has images of all solutions of other one.
+*/
+int CbcModel::pruneSymmetricNodes()
+{
+  CbcSymmetry *symmetry = rootSymmetryInfo_ ? rootSymmetryInfo_ : symmetryInfo_;
+  if (!symmetry || !symmetry->numberPermutations() || orbitope_)
+    return 0;
+  int numberColumns = solver_->getNumCols();
+  const int *whichOrbit = symmetry->whichOrbit();
+  if (!whichOrbit || symmetry->numberColumns() != numberColumns)
+    return 0;
+  std::vector< CbcNode * > candidates;
+  for (int i = 0; i < tree_->size(); i++) {
+    CbcNode *node = tree_->nodePointer(i);
+    if (node && node->active() && node->nodeInfo() && node->depth() <= 10
+      && node->branchingObject() && !node->branchingObject()->branchIndex())
+      candidates.push_back(node);
+  }
+  int numberCandidates = static_cast< int >(candidates.size());
+  if (numberCandidates < 2)
+    return 0;
+  std::sort(candidates.begin(), candidates.end(), betterNode);
+  double *bounds = new double[2 * numberColumns * numberCandidates];
+  std::vector< std::pair< CoinUInt64, int > > keys;
+  std::vector< CbcNodeInfo * > chain;
+  for (int k = 0; k < numberCandidates; k++) {
+    double *lower = bounds + 2 * k * numberColumns;
+    double *upper = lower + numberColumns;
+    chain.clear();
+    CbcNodeInfo *nodeInfo = candidates[k]->nodeInfo();
+    CbcFullNodeInfo *fullInfo = NULL;
+    while (nodeInfo) {
+      fullInfo = dynamic_cast< CbcFullNodeInfo * >(nodeInfo);
+      if (fullInfo)
+        break;
+      chain.push_back(nodeInfo);
+      nodeInfo = nodeInfo->parent();
+    }
+    if (!fullInfo)
+      continue;
+    fullInfo->getBounds(lower, upper);
+    bool good = true;
+    for (int j = static_cast< int >(chain.size()) - 1; j >= 0; j--) {
+      CbcPartialNodeInfo *partialInfo = dynamic_cast< CbcPartialNodeInfo * >(chain[j]);
+      if (!partialInfo) {
+        good = false;
+        break;
+      }
+      const int *variables = partialInfo->variables();
+      for (int i = 0; i < partialInfo->numberChangedBounds(); i++) {
+        int variable = variables[i];
+        int iColumn = variable & 0x3fffffff;
+        if ((variable & 0x80000000) == 0)
+          lower[iColumn] = partialInfo->newBound(i);
+        else
+          upper[iColumn] = partialInfo->newBound(i);
+      }
+    }
+    if (!good)
+      continue;
+    CoinUInt64 key = 0;
+    for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+      int iOrbit = whichOrbit[iColumn];
+      CoinUInt64 id = iOrbit >= 0 ? iOrbit : numberColumns + iColumn;
+      CoinUInt64 lowerBits;
+      CoinUInt64 upperBits;
+      double value = lower[iColumn] ? lower[iColumn] : 0.0;
+      memcpy(&lowerBits, &value, sizeof(double));
+      value = upper[iColumn] ? upper[iColumn] : 0.0;
+      memcpy(&upperBits, &value, sizeof(double));
+      // sum so order of columns in orbit does not matter
+      key += mixNodeHash(mixNodeHash(id, lowerBits), upperBits);
+    }
+    keys.push_back(std::pair< CoinUInt64, int >(key, k));
+  }
+  // same keys together (better node first)
+  std::sort(keys.begin(), keys.end());
+  int numberGenerators = symmetry->numberPermutations();
+  std::vector< CbcNode * > removed;
+  std::vector< int > kept;
+  int numberKeys = static_cast< int >(keys.size());
+  for (int first = 0; first < numberKeys;) {
+    int last = first + 1;
+    while (last < numberKeys && keys[last].first == keys[first].first)
+      last++;
+    kept.clear();
+    kept.push_back(keys[first].second);
+    for (int j = first + 1; j < last; j++) {
+      int k = keys[j].second;
+      const double *lowerK = bounds + 2 * k * numberColumns;
+      const double *upperK = lowerK + numberColumns;
+      bool symmetric = false;
+      for (int jKept = 0; jKept < static_cast< int >(kept.size()) && !symmetric; jKept++) {
+        const double *lowerKept = bounds + 2 * kept[jKept] * numberColumns;
+        const double *upperKept = lowerKept + numberColumns;
+        for (int iGenerator = 0; iGenerator < numberGenerators && !symmetric; iGenerator++) {
+          const int *orbit = symmetry->permutation(iGenerator);
+          symmetric = true;
+          for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+            int jColumn = orbit[iColumn] >= 0 ? orbit[iColumn] : iColumn;
+            if (lowerK[iColumn] != lowerKept[jColumn] || upperK[iColumn] != upperKept[jColumn]) {
+              symmetric = false;
+              break;
+            }
+          }
+        }
+      }
+      if (symmetric)
+        removed.push_back(candidates[k]);
+      else if (kept.size() < 20)
+        kept.push_back(k);
+    }
+    first = last;
+  }
+  delete[] bounds;
+  int numberRemoved = static_cast< int >(removed.size());
+  if (numberRemoved) {
+    tree_->removeNodes(this, &removed[0], numberRemoved);
+    char general[200];
+    sprintf(general, "%d symmetric nodes taken off tree before sharing out to threads",
+      numberRemoved);
+    messageHandler()->message(CBC_GENERAL, messages())
+      << general << CoinMessageEol;
+  }
+  return numberRemoved;
+}
 #endif
 /* Add SOS info to solver -
    Overwrites SOS information in solver with information
@@ -6,6 +6,7 @@
 #define CbcModel_H
 #include <string>
 #include <vector>
+#include <set>
 #include "CbcConfig.h"
 #include "CoinMessageHandler.hpp"
 #include "OsiSolverInterface.hpp"
@@ -14,6 +15,7 @@
 #include "CoinWarmStartBasis.hpp"
 #include "CbcCompareBase.hpp"
 #include "CbcCountRowCut.hpp"
+#include "CbcColumnPool.hpp"
 #include "CbcMessage.hpp"
 #include "CbcEventHandler.hpp"
 #include "ClpDualRowPivot.hpp"
@@ -31,14 +33,37 @@ class CglStored;
 class CbcCutModifier;
 class CglTreeProbingInfo;
 class CbcHeuristic;
+class CbcFathom;
 class OsiObject;
 class CbcThread;
+class CbcThreadPool;
+class CbcRootHeuristics;
+class CbcTreeHeuristics;
+class CbcSubMipQueue;
+class CbcDivePortfolio;
+class CbcSymmetryDetection;
+class CbcBoundPropagator;
+class CbcOrbitope;
+class CbcCliqueTable;
+class CbcImplicationGraph;
+class CbcFactorizationCache;
+class CbcCutDatabase;
 class CbcTree;
 class CbcStrategy;
 class CbcSymmetry;
 class CbcFeasibilityBase;
 class CbcStatistics;
 class CbcFullNodeInfo;
+class CbcBoundTrail;
+class CbcPseudoCostArrays;
+class CbcConflictAnalysis;
+class CbcStrongBudget;
+class CbcSolutionChanges;
+class CbcSeparationContext;
+class CbcPhaseTimes;
+class CbcNodeTrace;
+class CbcCheckpoint;
+class CbcPeerExchange;
 class CbcEventHandler;
 class CglPreProcess;
 class OsiClpSolverInterface;
@@ -129,6 +154,182 @@ public:
     /** Maximum number of nodes without improving the best feasible
      *  solution (just checked if a feasible solution was already found ) */
     CbcMaxNodesNotImprovingFeasSol,
+    /** Reliability branching lookahead in chooseDynamicBranch.
+            If nonzero, strong branching stops after this many candidates
+            in a row which did not improve on best, and second side of a
+            candidate is not solved if candidate can not beat best.
+            0 (default) keeps old rules based on numberStrong */
+    CbcStrongLookahead,
+    /** If nonzero chooseDynamicBranch finds infeasibilities of simple
+            dynamic integer objects from contiguous arrays
+            (see CbcPseudoCostArrays) rather than one virtual call per object */
+    CbcBatchPseudoCosts,
+    /** If nonzero (and solver is Clp) up to this many strong branching
+            candidates in chooseDynamicBranch are done in one call to
+            ClpSimplex::strongBranching before the usual loop */
+    CbcBatchStrongBranching,
+    /** If nonzero strong branching results of children are saved in node
+            info (up to this many) so siblings can reuse them for candidates
+            their bound changes do not touch (see CbcStrongCache) */
+    CbcStrongCacheSize,
+    /** If nonzero number of strong branching candidates and hot start
+            iterations in chooseDynamicBranch are scaled for each range of
+            depths by how much strong branching learns for the time it takes
+            (see CbcStrongBudget) */
+    CbcAdaptiveStrong,
+    /** If nonzero chooseDynamicBranch keeps one hot start snapshot for
+            the whole strong branching loop.  Variables fixed because one
+            side is infeasible are left as bound changes for later candidates
+            and the node is resolved once at the end, rather than unmarking,
+            resolving and marking again after every fix */
+    CbcKeepHotStart,
+    /** If nonzero maximum number of cuts in global cut pool.  When
+            exceeded least recently active (tight or violated in global cut
+            scan) cuts are removed down to 90% */
+    CbcMaximumGlobalCuts,
+    /** If nonzero cut generators are skipped in tree with exponential
+            backoff when their share of bound improvement per second
+            is tiny or much less than that of best generator
+            (see CbcCutGenerator::schedule) */
+    CbcAdaptiveCuts,
+    /** If nonzero maximum number of cuts kept in cut pool of each tree
+            node for its subtree.  Cuts taken off at a node (and its tight
+            local cuts) are kept, descendants scan pools of ancestors before
+            expensive cut generators and a cut both children of a two way
+            branch have is moved up to parent (and to global cuts at top
+            of tree) */
+    CbcSubtreeCutPool,
+    /** If nonzero number of passes of root cut loop over which tailing off
+            is measured (at most 20).  Loop stops when they gave less than
+            CbcRootStallGain of bound improvement so far, or less than half
+            the relative growth of rows or share of time they took.  Cuts
+            with zero dual are then dropped before branching */
+    CbcRootStallWindow,
+    /** If nonzero and there are threads, tree search is serial and the
+            threads are used instead to run cut generators in parallel at
+            tree nodes (as threadMode 2 does at root).  Cuts are put
+            together in generator order so results do not depend on timing */
+    CbcParallelTreeCuts,
+    /** If nonzero maximum number of row cuts added to solver in one
+            pass of cuts.  Cuts are chosen greedily by efficacy (violation
+            divided by norm) skipping any too parallel to ones chosen
+            (see CbcMaximumCutParallelism) */
+    CbcMaximumCutsPerRound,
+    /** If nonzero and tree search is serial, RINS, diving, local
+            search and polish heuristics run on a background thread.  At a node where
+            one would run it is given a snapshot of solver and incumbent and
+            tree search goes on - solution is taken when it has finished */
+    CbcAsyncHeuristics,
+    /** If nonzero and tree search is serial, dive heuristics are run as
+            a portfolio - at a node up to this many dives run at the same
+            time from the same LP solution and the rest stop as soon as one
+            finds a better solution.  Which dives run is learnt as a bandit */
+    CbcConcurrentDives,
+    /** What mini branch and bound of heuristics (RINS, RENS, DINS, local
+            search etc) takes from this model.  1 - global cuts (as far as
+            they survive preprocessing of submodel), 2 - pseudocosts */
+    CbcSubMipInherit,
+    /** If nonzero bounds are propagated over original rows at each node
+            before the LP is resolved (row activities are kept up to date
+            as bounds change on branching) - so some nodes die without
+            simplex iterations */
+    CbcNodePropagation,
+    /** If nonzero heuristics which need no LP solution (fix and propagate
+            on locks, greedy) are run before the root LP - 1 first, 2 on a
+            thread while it is solved.  Solution is given to model (and
+            event handler) before the LP with 1, as soon as LP returns with 2.
+            3 - each heuristic on its own thread (if threads) before LP */
+    CbcStartupHeuristics,
+    /** If nonzero with multipleRootTries the root copies race - each
+            goes on to search this many nodes instead of stopping after the
+            root.  Cuts and bounds from roots of all copies are used as
+            before, while pseudocosts and global cuts of the most promising
+            copy (best bound) are adopted */
+    CbcRootRaceNodes,
+    /** If nonzero (and symmetry wanted) nauty runs on a background thread
+            while root LP and cuts are done.  Orbital fixing starts once
+            orbits arrive (checked at end of root and at each node) */
+    CbcAsyncSymmetry,
+    /** If nonzero (and symmetry wanted) generators of symmetry group are
+            used to find a full orbitope of binaries (columns of matrix may
+            be permuted - e.g. identical machines).  Columns are then kept
+            in lexicographic order by fixing at each node (with bound
+            propagation) instead of orbital fixing and branching */
+    CbcOrbitopeFixing,
+    /** If nonzero and there are threads, mini tree of general depth
+            branching (CbcGeneralDepth) is split on its most fractional
+            integer and the two halves are explored at the same time on
+            clones of solver.  Nodes of down half come first so results
+            do not depend on timing */
+    CbcParallelMiniTree,
+    /** If nonzero and solver is Clp, initialSolve races dual simplex,
+            primal simplex and barrier (with crossover) on copies of
+            solver on threads.  First optimal basis is taken and others
+            are stopped */
+    CbcConcurrentRootLp,
+    /** If nonzero and there are threads, tree search starts with a ramp
+            up - nodes are done serially in best bound order (breadth
+            first) until there are this many open nodes for each thread,
+            and only then do threads take nodes.  With deterministic
+            parallel it is the number of nodes before the first split.
+            Root configurations can be raced first (CbcRootRaceNodes) */
+    CbcRampUpNodes,
+    /** If nonzero the search restarts once this percentage of integers
+            is globally fixed early on (checked after 50, 100 and 1000
+            nodes) - by reduced costs against the incumbent and by bounds
+            tightened at root (probing, tightenVubs, conflicts).  The
+            reduced problem is preprocessed again and searched as a new
+            branch and bound which gets incumbent, global cuts and
+            pseudocosts of this one */
+    CbcRestartFixedPercent,
+    /** If nonzero both arms of a simple integer branch are solved as
+            soon as the node is made (from the LP of the parent).  Node
+            goes on tree with the smaller objective and each arm keeps its
+            optimal basis, so when it is taken it starts from that basis.
+            1 - only once there is a solution and comparison is not depth
+            first (best first phase), 2 - always */
+    CbcSolveBothChildren,
+    /** If nonzero sub-MIPs given to startSubBranchAndBound are solved on
+            this many threads of their own while search goes on.  Zero
+            solves them at once on calling thread as subBranchAndBound */
+    CbcSubMipThreads,
+    /** Algorithm for resolves in tree.  0 - dual or primal chosen for
+            rows added (cuts), rows removed (cuts taken off) and only
+            bounds changed from iterations each has taken before, 1 -
+            always dual */
+    CbcResolveAlgorithm,
+    /** If nonzero an old cut whose slack is basic stays in LP until it
+            has been slack at this many nodes running, and then cuts are
+            only taken off when enough have aged (in a batch).  Saves
+            taking cuts off and adding them again along a dive.  Zero
+            takes slack cuts off at once */
+    CbcSlackCutNodes,
+    /** If nonzero (and serial search) while a node is solved a thread
+            gets the node at top of tree ready to be restored - basis diffs
+            of its path which were deferred are made */
+    CbcPrefetchNodes,
+    /** If nonzero general integers (dynamic pseudo cost objects) with
+            more than this many values at a node and solution near one end
+            are branched on at middle of range so domain is halved */
+    CbcSplitRange,
+    /** If nonzero (opportunistic threads) number of threads given nodes
+            goes down when threads spend much time waiting for lock and up
+            again when tree grows (see also setThreadQuota) */
+    CbcAdaptiveThreads,
+    /** If nonzero (and serial search) bounds of each node after branch
+            are remembered, up to this many, and a node whose bounds are
+            those of one already solved is pruned before its LP */
+    CbcDuplicateNodes,
+    /** If nonzero (Clp and serial search) factorizations of node LPs are
+            kept, using up to this many megabytes, so a child restored with
+            the same rows and basis need not factorize again */
+    CbcFactorizationMemory,
+    /** If nonzero search is for a feasible solution soon rather than
+            proof (set CbcMaximumSeconds as deadline).  Startup heuristics
+            race on threads before root LP, root LP stops at deadline,
+            quick dive is done before other root heuristics and root cuts
+            have one pass until there is a solution */
+    CbcFirstFeasible,
     /** Just a marker, so that a static sized array can store parameters. */
     CbcLastIntParam
   };
@@ -198,10 +399,63 @@ public:
     /** \brief Maximum time without improving the best solution found, checked only if a
      * feasible solution is already available */
     CbcMaximumSecondsNotImprovingFeasSol,
+    /** If nonzero estimated bytes allowed for global cut pool - as
+            CbcMaximumGlobalCuts least recently active cuts are removed */
+    CbcMaximumGlobalCutBytes,
+    /** Fraction of root bound improvement last CbcRootStallWindow passes
+            must give for root cut loop to carry on (default 0.01) */
+    CbcRootStallGain,
+    /** Largest cosine of angle between a cut and those already chosen
+            when CbcMaximumCutsPerRound is set (default 0.95) */
+    CbcMaximumCutParallelism,
+    /** If nonzero percentage of time heuristics may use - a heuristic
+            which has used more than its share since it last found a
+            solution is not run (see CbcHeuristic::overBudget) */
+    CbcHeuristicTimeBudget,
+    /** If positive most wall clock seconds nauty may take finding
+            symmetry - if exceeded orbits of generators found so far are used
+            (see CbcSymmetry::setMaximumTime) */
+    CbcSymmetryTimeLimit,
+    /** If positive most seconds preprocessing (CglPreProcess in
+            CbcSolver) may take - so probing there is time boxed */
+    CbcPreProcessTimeLimit,
+    /** If positive stop (as on time limit) when workUnits() reaches
+            this - unlike seconds the result does not depend on machine
+            or load */
+    CbcMaximumWork,
+    /** If positive most wall clock seconds tightenVubs may take - no
+            more lps are started once exceeded */
+    CbcVubTimeLimit,
     /** Just a marker, so that a static sized array can store parameters. */
     CbcLastDblParam
   };
 
+  /// Categories for memoryUsage
+  enum CbcMemoryType {
+    /// Live nodes and their branching objects
+    CbcMemoryNodes = 0,
+    /// Node infos (bounds) on path from live nodes to root
+    CbcMemoryNodeInfo,
+    /// Warm start diffs and bases in node infos
+    CbcMemoryWarmStart,
+    /// Cuts (CbcCountRowCut) held by node infos
+    CbcMemoryNodeCuts,
+    /// Global cut pool (and conflict cuts)
+    CbcMemoryGlobalCuts,
+    /// Cut generators and cuts saved in them
+    CbcMemoryGenerators,
+    /// Best and saved solutions
+    CbcMemorySolutions,
+    /// Solver and copies of it kept by model
+    CbcMemorySolvers,
+    /// Thread model clones and their solvers
+    CbcMemoryThreads,
+    /// Sum of above
+    CbcMemoryTotal,
+    /** Just a marker, so that a static sized array can store values. */
+    CbcLastMemoryType
+  };
+
   //---------------------------------------------------------------------------
 
 public:
@@ -250,6 +504,29 @@ private:
         -1 - infeasible
     */
   int parallelCuts(CbcBaseModel *master, OsiCuts &cuts, CbcNode *node, OsiCuts &slackCuts, int lastNumberCuts);
+  /** Share improvement in objective from a pass of cuts among
+        generators (by row cuts each made) and, in tree if CbcAdaptiveCuts
+        set, let generators back off if not worth their time */
+  void scheduleCutGenerators(double improvement);
+  /** Add violated cuts from cut pools of nodes above node to cuts
+        (CbcSubtreeCutPool).  Returns number added */
+  int scanSubtreeCutPools(CbcNode *node, OsiCuts &cuts, int lastNumberCuts);
+  /** Drop cuts from solver (and cuts) which have zero dual so do not
+        hold up bound.  Only if all cuts are new.  Returns number dropped */
+  int dropNonBindingCuts(OsiCuts &cuts);
+  /** Keep at most maximumCuts row cuts chosen by efficacy and
+        parallelism (CbcMaximumCutsPerRound).  Cuts with effectiveness
+        of 1.0e20 or more and infeasible cuts are always kept.
+        Returns number removed */
+  int selectCuts(OsiCuts &cuts, int maximumCuts);
+  /// Whether generator is to be called in this pass of cuts at node
+  bool generatorWanted(int iGenerator, int switchOff) const;
+  /** Threads kept for cuts at tree nodes (CbcParallelTreeCuts).
+        NULL if not wanted */
+  CbcBaseModel *treeCutMaster();
+  /** Put cuts (and slack cuts saved at node) in cut pool of info
+        of new node and move up any both children now have */
+  void addToSubtreeCutPool(CbcNodeInfo *info, const OsiCuts &cuts);
   /** Input one node output N nodes to put on tree and optional solution update
         This should be able to operate in parallel so is given a solver and is const(ish)
         However we will need to keep an array of solver_ and bases and more
@@ -260,6 +537,42 @@ private:
     int &numberNodesOutput, int &status);
   /// Update size of whichGenerator
   void resizeWhichGenerator(int numberNow, int numberAfter);
+  /** Give sub-MIP heuristics, node comparison and options of this
+        model as subBranchAndBound does */
+  void setUpSubBranchAndBound(CbcModel *model2, int maximumNodes);
+  /** Up and down sums of -dual*element for each column (without
+        objective).  Continuous rows come from shadowCache_ which is only
+        redone for rows whose dual changed, cuts are done each time */
+  void shadowSums(double *up, double *down);
+  /// Delete pseudo shadow price cache
+  void deleteShadowCache();
+  /** After a resolve in tree choose between normal dual pricing and
+        Dantzig from measured seconds per resolve (so both time per
+        iteration and iterations per node count).  Each pricing is
+        measured for a while, the better kept for a period (doubling each
+        time) and then both measured again.  Each thread model does this
+        for its own solver */
+  void adaptDualPricing(OsiClpSolverInterface *clpSolver, double seconds);
+  /// Put back normal dual pricing if Dantzig was chosen
+  void restoreDualPricing(OsiClpSolverInterface *clpSolver);
+  /** Choose primal (1) or dual (0) for resolve in tree in situation
+      (0 rows added, 1 rows removed, 2 only bounds changed).  Dual unless
+      primal has taken clearly fewer iterations in that situation - the
+      one not chosen is tried now and then so both stay measured */
+  int chooseResolveAlgorithm(int situation);
+  /// Record iterations of resolve in situation with algorithm
+  void recordResolveAlgorithm(int situation, int algorithm, int iterations);
+  /// Forget iterations of resolves (new search)
+  void resetResolveAlgorithm();
+  /// Stop rounding cutoff to objective step if solution says it is wrong
+  void checkCutoffStep(double objectiveValue);
+  /// Add implications found by probing at root to implication graph
+  void addProbingImplications();
+#ifdef SWITCH_VARIABLES
+  /** Make switchingIndex_ from switching objects (or check it is still
+        right).  Returns number of switching objects */
+  int makeSwitchingIndex();
+#endif
 
 public:
 #ifdef CBC_KEEP_DEPRECATED
@@ -269,6 +582,7 @@ public:
       The method creates a new model with given bounds and with no tree.
     */
   CbcModel *cleanModel(const double *lower, const double *upper);
+#endif
   /** \brief Invoke the branch \& cut algorithm on partially fixed problem
 
       The method presolves the given model and does branch and cut. The search
@@ -305,7 +619,33 @@ public:
     */
   int subBranchAndBound(const double *lower, const double *upper,
     int maximumNodes);
+  /** \brief As first form of subBranchAndBound but on a thread
+
+      With CbcSubMipThreads nonzero sub-MIP is queued and solved on a thread
+      of its own while caller goes on - returns -1.  Global cuts of this
+      model are copied in (unless presolved) and sub-MIP is stopped once
+      cutoff of this model shows it can not help.  A better solution is
+      saved when pollSubBranchAndBound is called (at each node in tree).
+      Otherwise this is just subBranchAndBound and returns its status.
+
+      Deletes model2 (and presolvedModel)
+    */
+  int startSubBranchAndBound(CbcModel *model2,
+    CbcModel *presolvedModel,
+    int maximumNodes);
+  /** Save better solutions from sub-MIPs which have finished (or wait for
+      them) and start more.  Returns number of times solution improved */
+  int pollSubBranchAndBound(bool wait);
+  /** Stop sub-MIPs (those waiting are thrown away), save any solution
+      found and stop threads */
+  void finishSubBranchAndBound();
+  /** What subBranchAndBound does after search of sub-MIP - take back
+      solution and save it if better than cutoff, then delete model (and
+      presolvedModel).  Returns status as subBranchAndBound */
+  int takeSubBranchAndBound(CbcModel *model, CbcModel *presolvedModel,
+    double cutoff);
 
+#ifdef CBC_KEEP_DEPRECATED
   /** \brief Process root node and return a strengthened model
 
       The method assumes that initialSolve() has been called to solve the
@@ -347,6 +687,17 @@ public:
         newNode NULL if no new node created
     */
   int doOneNode(CbcModel *baseModel, CbcNode *&node, CbcNode *&newNode);
+  /** Solve both arms of branch of newNode now (CbcSolveBothChildren) and
+      keep objectives and bases in node.  Solver is left as it was.
+      Returns false if not done */
+  bool solveBothChildren(CbcNode *newNode);
+  /** Try fathoming methods on bounds of current node.
+      Returns 1 if node fathomed (any solution found has been stored)
+    */
+  int fathomNode();
+  /** Whether bounds of node (after branch) are those of a node already
+      solved (CbcDuplicateNodes).  If not they are remembered */
+  bool duplicateNode(const CbcNode *node);
 
 public:
   /** \brief Reoptimise an LP relaxation
@@ -366,6 +717,30 @@ public:
     double *saveSolution = NULL,
     double *saveLower = NULL,
     double *saveUpper = NULL);
+  /** Propagate bounds over original rows before LP at a node
+      (see CbcNodePropagation).  Returns false if node infeasible */
+  bool propagateNode();
+  /** Table of cliques of binaries from rows of continuous solver and
+      clique objects - built when first asked for.  NULL if no cliques */
+  CbcCliqueTable *cliqueTable();
+  /** Add implication - if binary iColumn is at value (0 or 1) then
+      jColumn has bound as upper (or lower) bound.  Implications with
+      those found by probing at root are applied transitively at nodes
+      (which turns on node propagation), in n-way branching and in fix
+      and propagate.  Columns are those of solver when search starts -
+      if preprocessing changes columns implications are not used */
+  void addImplication(int iColumn, int value, int jColumn, double bound, bool upper);
+  /// Implication graph (NULL if no implications)
+  inline CbcImplicationGraph *implicationGraph() const
+  {
+    return implicationGraph_;
+  }
+  /** Run heuristics needing no LP solution (CbcStartupHeuristics) and
+      initial resolve.  Returns true if LP feasible */
+  bool resolveWithStartupHeuristics();
+  /** Short fractional dive from root LP before other root heuristics
+      (CbcFirstFeasible).  Returns true if solution found */
+  bool quickDive();
   /// Make given rows (L or G) into global cuts and remove from lp
   void makeGlobalCuts(int numberRows, const int *which);
   /// Make given cut into a global cut
@@ -450,6 +825,10 @@ public:
            bounds by solving lp's
 
       This version is just handed a list of variables to be processed.
+      With threads the lps are shared out, each started from the basis
+      after probing, and bounds are applied in order of \p which once
+      all are done (so without CbcVubTimeLimit the result does not depend
+      on timing).  Probing is then only done before the lps.
     */
   bool tightenVubs(int numberVubs, const int *which,
     double useCutoff = 1.0e50);
@@ -560,7 +939,10 @@ public:
       one.
       If \p startAgain is true, a new scan is forced, overwriting any existing
       integer variable information.
-      If type > 0 then 1==PseudoCost, 2 new ones low priority
+      If type > 0 then 1==PseudoCost, 2 new ones low priority,
+      3 and 4 as 0 and 2 but make CbcSimpleIntegerDynamicPseudoCost
+      objects at once (as convertToDynamic would) so huge models do not
+      make every object twice
     */
 
   void findIntegers(bool startAgain, int type = 0);
@@ -573,7 +955,8 @@ public:
 #ifdef SWITCH_VARIABLES
   /// Convert Dynamic to Switching
   int findSwitching();
-  /// Fix associated variables
+  /** Fix associated variables.  Only switching objects whose binary or
+      associated variables may have changed are looked at again */
   int fixAssociated(OsiSolverInterface *solver, int cleanBasis);
   /// Debug associated variables
   int checkAssociated(const OsiSolverInterface *solver,
@@ -617,7 +1000,9 @@ public:
   /*! \brief Set cutoff bound on the objective function.
 
       When using strict comparison, the bound is adjusted by a tolerance to
-      avoid accidentally cutting off the optimal solution.
+      avoid accidentally cutting off the optimal solution.  If
+      analyzeObjective found objective of integer solutions is a constant
+      plus a multiple of a step, the bound is rounded down to that.
     */
   void setCutoff(double value);
 
@@ -694,8 +1079,12 @@ public:
   /// Current time since start of branchAndbound
   double getCurrentSeconds() const;
 
-  /// Return true if maximum time reached
+  /// Return true if maximum time (or CbcMaximumWork) reached
   bool maximumSecondsReached() const;
+  /** Deterministic measure of work done - LP iterations (including
+      those of sub-trees), nodes, and calls to cut generators and
+      heuristics each counted as (rows+columns)/100 iterations */
+  double workUnits() const;
 
   /** Set the
       \link CbcModel::CbcIntegerTolerance integrality tolerance \endlink
@@ -1397,6 +1786,15 @@ public:
     */
   virtual double checkSolution(double cutoff, double *solution,
     int fixVariables, double originalObjValue);
+  /** Row activities of solution in solver (and sums of absolute values
+      of terms if rowSum not NULL).  Goes along rows of row copy so each
+      row is a dot product (four partial sums so compiler can vectorize).
+      If compensated then summation is compensated (Neumaier) so error
+      does not grow with number of terms.  Used to check solutions
+    */
+  static void rowActivities(const OsiSolverInterface *solver,
+    const double *solution, double *rowActivity, double *rowSum,
+    bool compensated = false);
   /** Test the current solution for feasiblility.
 
       Scan all objects for indications of infeasibility. This is broken down
@@ -1405,6 +1803,14 @@ public:
     */
   bool feasibleSolution(int &numberIntegerInfeasibilities,
     int &numberObjectInfeasibilities) const;
+  /** Scan integer variables for values away from integer (as
+      CbcSimpleInteger with default break even).  If \p which is not NULL
+      the positions (in integerVariable()) of fractional ones are put
+      there in order.  Done in blocks with plain loops so the compiler is
+      free to vectorize.  Returns number fractional.
+    */
+  int scanIntegers(const double *solution, const double *lower,
+    const double *upper, double tolerance, int *which = NULL) const;
 
   /** Solution to the most recent lp relaxation.
 
@@ -1612,6 +2018,19 @@ public:
   {
     numberGlobalViolations_ = 0;
   }
+  /** Estimated bytes used by branch and bound.
+
+      \p bytes should have CbcLastMemoryType entries and is filled in by
+      CbcMemoryType.  Objects kept by cut generators and heuristics other
+      than saved cuts are not counted.  Returns total (and updates high
+      water mark).
+    */
+  double memoryUsage(double *bytes);
+  /// Largest total seen by memoryUsage
+  inline double memoryHighWater() const
+  {
+    return memoryHighWater_;
+  }
   /// Whether to force a resolve after takeOffCuts
   inline bool resolveAfterTakeOffCuts() const
   {
@@ -1895,6 +2314,39 @@ public:
     lastHeuristic_ = last;
   }
 
+  /** Add one fathoming method - a clone is kept.
+
+      At each node with feasible solution which does not satisfy integer
+      constraints each method with possible() true is tried on node bounds.
+      If it fathoms the node (returning 1 or 3) there is no branching.
+    */
+  void addFathom(CbcFathom *method);
+  /// Get the specified fathoming method
+  inline CbcFathom *fathomMethod(int i) const
+  {
+    return fathom_[i];
+  }
+  /// Get the number of fathoming methods
+  inline int numberFathomMethods() const
+  {
+    return numberFathomMethods_;
+  }
+  /// Number of nodes fathoming methods were tried at
+  inline int numberFathomTries() const
+  {
+    return numberFathomTries_;
+  }
+  /// Number of nodes fathomed by fathoming methods
+  inline int numberFathomSuccesses() const
+  {
+    return numberFathomSuccesses_;
+  }
+  /// Number of nodes pruned as duplicates of nodes already solved
+  inline int numberDuplicateNodes() const
+  {
+    return numberDuplicateNodes_;
+  }
+
   /** Pass in branching priorities.
 
         If ifClique then priorities are on cliques otherwise priorities are
@@ -2148,6 +2600,16 @@ public:
         18 bit 262144 - some statistics for fairly simple orbital 
  	19 bit 524288 - freeze problem at root cuts
  	20 bit 1048576 - use ranging in CbcNode
+ 	21 bit 2097152 - use 4-ary heap for live nodes (CbcTreeDHeap)
+ 	22 bit 4194304 - use objective buckets for live nodes (CbcTreeBucket)
+ 	23 bit 8388608 - best bound with plunging node comparison (CbcComparePlunge)
+ 	24 bit 16777216 - no checkpoint node information deep in tree
+ 	25 bit 33554432 - move between nodes by bound differences (CbcBoundTrail)
+ 	26 bit 67108864 - opportunistic threads keep diving on own children
+ 	27 bit 134217728 - deterministic threads share cutoffs on work unit clock
+ 	28 bit 268435456 - opportunistic threads share pseudocosts as found
+ 	29 bit 536870912 - strong branching in parallel near root (uses threads)
+ 	30 bit 1073741824 - root heuristics on threads while root cuts done
     */
   inline void setMoreSpecialOptions2(int value)
   {
@@ -2186,7 +2648,9 @@ public:
   {
     temporaryPointer_ = pointer;
   }
-  /// Go to dantzig pivot selection if easy problem (clp only)
+  /** Go to dantzig pivot selection if easy problem (clp only).
+      Only used with deterministic threads - otherwise pricing is chosen
+      in resolve from measured time (see adaptDualPricing) */
   void goToDantzig(int numberNodes, ClpDualRowPivot *&savePivotMethod);
   /// Now we may not own objects - just point to solver's objects
   inline bool ownObjects() const
@@ -2358,6 +2822,7 @@ public:
         4 set then use numberThreads in root mini branch and bound
         8 set and numberThreads - do heuristics numberThreads at a time
         8 set and numberThreads==0 do all heuristics at once
+        16 set then bind threads to processors and make their solvers there
         default is 0
     */
   inline void setThreadMode(int value)
@@ -2402,6 +2867,203 @@ public:
        Unlocks a thread if parallel to say cut pool stuff not needed
     */
   void unlockThread();
+  /** If a thread in opportunistic mode, lower cutoff to one published
+        by base model (without lock).  If root heuristics are running on
+        threads, pass their solutions to model.  Returns true if cutoff changed */
+  bool refreshPublishedCutoff();
+  /// Get pool with at least numberThreads threads (created if needed)
+  CbcThreadPool *threadPool(int numberThreads);
+  /** Set file for JSON thread statistics written when threads finish
+        (NULL or "" for none) */
+  inline void setThreadStatisticsFile(const char *fileName)
+  {
+    threadStatisticsFile_ = fileName ? fileName : "";
+  }
+  /// File for JSON thread statistics (NULL if none)
+  inline const char *threadStatisticsFile() const
+  {
+    return threadStatisticsFile_.size() ? threadStatisticsFile_.c_str() : NULL;
+  }
+  /** Most threads to give nodes to (0 all).  May be changed at any time
+        during search (e.g. from event handler or another thread) so a
+        scheduler can resize a job - threads over quota go idle after
+        their current node */
+  inline void setThreadQuota(int value)
+  {
+    threadQuota_ = value;
+  }
+  inline int threadQuota() const
+  {
+    return threadQuota_;
+  }
+  /** Set file holding thread quota (a number) which is read about once a
+        second during search (NULL or "" for none) */
+  inline void setThreadQuotaFile(const char *fileName)
+  {
+    threadQuotaFile_ = fileName ? fileName : "";
+  }
+  /// File holding thread quota (NULL if none)
+  inline const char *threadQuotaFile() const
+  {
+    return threadQuotaFile_.size() ? threadQuotaFile_.c_str() : NULL;
+  }
+  /** Time phases of node processing (select, restore, LP, cuts,
+        heuristics, branch and push) on each thread and print table at end
+        of branchAndBound.  If traceFrequency > 0 phases of every
+        traceFrequency'th node are written to traceFile as a Chrome trace.
+        Switched off (the default) if onOff false */
+  void setPhaseTimes(bool onOff, int traceFrequency = 0,
+    const char *traceFile = NULL);
+  /// Phase times (NULL if not timing)
+  inline CbcPhaseTimes *phaseTimes() const
+  {
+    return phaseTimes_;
+  }
+  /** Write a record for each node of search to fileName (as CSV if name
+        ends in ".csv", otherwise binary - see CbcNodeTrace).  NULL stops
+        trace.  Returns false if file could not be opened */
+  bool setNodeTraceFile(const char *fileName);
+  /// Node trace (NULL if none)
+  inline CbcNodeTrace *nodeTrace() const
+  {
+    return nodeTrace_;
+  }
+  /** Every seconds seconds of branch and bound make a CbcProgressRecord
+        and pass it to event handler as CbcEventHandler::progress.  If fd
+        >= 0 each record is also written to fd as a line of JSON.  Only
+        done by top model (not sub-MIPs).  seconds <= 0.0 (the default)
+        switches off */
+  inline void setProgressReport(double seconds, int fd = -1)
+  {
+    progressInterval_ = seconds;
+    progressFd_ = fd;
+  }
+  /// Seconds between progress records (<= 0.0 if none)
+  inline double progressInterval() const
+  {
+    return progressInterval_;
+  }
+  /// Make progress record now (as for setProgressReport)
+  void reportProgress();
+  /// Last progress record (threadBusy not valid)
+  inline const CbcProgressRecord &lastProgress() const
+  {
+    return lastProgress_;
+  }
+  /** Every seconds seconds of branch and bound (and when asked by
+        requestCheckpoint or when stopped on a limit) capture open nodes,
+        solutions, global cuts and pseudocosts and write them to fileName
+        (see CbcCheckpoint).  Only serial search.  seconds <= 0.0 only
+        when asked.  NULL fileName switches off */
+  void setCheckpoint(const char *fileName, double seconds = 0.0);
+  /// Checkpoint being written (NULL if none)
+  inline CbcCheckpoint *checkpoint() const
+  {
+    return checkpoint_;
+  }
+  /** Ask for checkpoint at next node (may be called from a signal
+        handler) */
+  inline void requestCheckpoint()
+  {
+    checkpointRequested_ = 1;
+  }
+  /// Capture and write checkpoint now - returns number of nodes or -1
+  int takeCheckpoint();
+  /** Capture part (of numberParts) of search into checkpoint - between
+        nodes.  Returns number of nodes or -1 */
+  int captureCheckpoint(CbcCheckpoint *checkpoint, int part = 0,
+    int numberParts = 1);
+  /** Read checkpoint written by an earlier search of this problem - next
+        branchAndBound resumes from it rather than doing root cuts and
+        heuristics.  May be called more than once (parts written by
+        writeSubtrees or left by workers) - nodes of all are used and the
+        best solution kept.  Returns 0 if OK, -1 if could not open file,
+        -2 if not a checkpoint */
+  int readCheckpoint(const char *fileName);
+  /// Forget checkpoints read by readCheckpoint
+  void clearCheckpoints();
+  /** Split open nodes into numberParts checkpoints baseName.0 ... so
+        subtrees can be searched by other processes (each resumes with
+        readCheckpoint).  Nodes are dealt out in order of objective so
+        each part has a share of the best bounds.  Each part has the
+        incumbent, global cuts and pseudocosts.  Nodes stay on this tree.
+        Returns number of nodes written or -1 if search can not be
+        captured (as for setCheckpoint) or a file could not be written */
+  int writeSubtrees(const char *baseName, int numberParts);
+  /** Exchange incumbents and global cuts with other processes solving
+        same problem - this is slot (of numberPeers) and files are
+        baseName.slot (see CbcPeerExchange).  Every seconds seconds
+        between nodes better solutions and cuts of peers are taken and
+        own are published.  NULL baseName switches off */
+  void setPeerExchange(const char *baseName, int slot, int numberPeers,
+    double seconds = 1.0);
+  /// Exchange with other processes (NULL if none)
+  inline CbcPeerExchange *peerExchange() const
+  {
+    return peerExchange_;
+  }
+  /** Make solver again (clone) in calling thread and delete old one -
+        so its memory is local to thread's processor */
+  void makeSolverLocal();
+  /** Start root heuristics on threads (moreSpecialOptions2 bit 30).
+        Returns false if not started - caller should do doHeuristicsAtRoot */
+  bool startRootHeuristics();
+  /// Wait for root heuristics started by startRootHeuristics and take solutions
+  void finishRootHeuristics();
+  /** Start getting node at top of tree ready to be restored on a thread
+        (CbcPrefetchNodes) - call before node is solved */
+  void startNodePrefetch();
+  /// Wait for thread started by startNodePrefetch
+  void finishNodePrefetch();
+  /** Make copies of model for heuristics run on background thread in
+        tree (CbcAsyncHeuristics).  Returns false if none */
+  bool startTreeHeuristics();
+  /** Give heuristic snapshot of node and run it on background thread.
+        Returns false if caller should run it (not one for background) */
+  bool postTreeHeuristic(int iHeuristic);
+  /** Take solution from background heuristic if it has finished (or
+        wait for it).  Returns number of improved solutions */
+  int pollTreeHeuristics(bool wait);
+  /// Wait for background heuristic, take solution and stop thread
+  void finishTreeHeuristics();
+  /** Copy of this model with only a clone of heuristic in it
+        (no threads, strategy or background heuristics) */
+  CbcModel *heuristicModel(const CbcHeuristic *heuristic);
+  /** Copy of this model without strategy or heuristics.  Cheaper than
+        copying heuristics (which may keep copies of matrix) only to
+        delete them - caller adds heuristics it wants */
+  CbcModel *copyWithoutHeuristics();
+  /// Give copy from heuristicModel solver, incumbent and cutoff of this node
+  void snapshotForHeuristic(CbcModel *newModel) const;
+  /** Make copies of model for dives run as a portfolio in tree
+        (CbcConcurrentDives).  Returns false if none */
+  bool startDivePortfolio();
+  /** Run dives in portfolio if heuristic is one of them and they have not
+        been run at this node.  Returns -1 if caller should run heuristic,
+        otherwise number of improved solutions */
+  int runDivePortfolio(int iHeuristic);
+  /// Delete dive portfolio
+  void finishDivePortfolio();
+  /** Start symmetry detection on background thread (CbcAsyncSymmetry).
+        Symmetry options are off until orbits arrive.  Returns false if
+        not started (caller should find symmetry) */
+  bool startSymmetryDetection();
+  /** If symmetry detection has finished (or wait true) take orbits and
+        switch options back.  Returns true if symmetry now in use */
+  bool pollSymmetryDetection(bool wait);
+  /** Solve continuous LP with several algorithms on threads
+        (CbcConcurrentRootLp) and load first optimal basis into solver.
+        Returns false if not done (caller should solve as usual) */
+  bool concurrentInitialSolve();
+  /** If a thread in opportunistic mode sharing pseudocosts, pass update
+        to base model now (object of this thread is left to caller).  Returns
+        true if done - otherwise caller should save update for end of node */
+  bool shareUpdateInformation(const CbcObjectUpdateData &data);
+  /** If a thread in opportunistic mode sharing pseudocosts, take
+        pseudocosts of object from base model if another thread has more
+        information on a side this one does not yet trust.
+        Returns true if changed */
+  bool refreshSharedPseudoCosts(int iObject);
   /** Set information in a child
         -3 pass pointer to child thread info
         -2 just stop
@@ -2442,11 +3104,24 @@ public:
       penalties.  Returns number fixed
     */
   int reducedCostFix();
+  /** Keep reduced costs of root LP (after cuts) for globalReducedCostFix.
+      Only variables nonbasic at a bound are kept */
+  void saveRootReducedCosts();
+  /** Reduced cost fixing with root LP against current cutoff.  Bounds
+      are tightened in root node (so in every open node and every thread
+      when nodes are next solved) - LP is not touched.  Does
+      nothing if cutoff is no better than last time.  Returns number of
+      bounds tightened
+    */
+  int globalReducedCostFix();
   /** Makes all handlers same.  If makeDefault 1 then makes top level
         default and rest point to that.  If 2 then each is copy
     */
   void synchronizeHandlers(int makeDefault);
-  /// Save a solution to saved list
+  /** Save a solution to saved list.  A solution with the same integer
+      values as one kept only replaces it if better.  When the list is full
+      a solution near (in integer values) to a better one is dropped before
+      the worst, so the list stays diverse */
   void saveExtraSolution(const double *solution, double objectiveValue);
   /// Save a solution to best and move current to saved
   void saveBestSolution(const double *solution, double objectiveValue);
@@ -2454,6 +3129,8 @@ public:
   void deleteSolutions();
   /// Encapsulates solver resolve
   int resolve(OsiSolverInterface *solver);
+  /// Adds priced columns to LP of node (NULL at root) until pricer finds none
+  void priceColumns(CbcNode *node);
 #ifdef CLP_RESOLVE
   /// Special purpose resolve
   int resolveClp(OsiClpSolverInterface *solver, int type);
@@ -2541,7 +3218,9 @@ public:
   void synchronizeNumberBeforeTrust(int type = 0);
   /// Zap integer information in problem (may leave object info)
   void zapIntegerInformation(bool leaveObjects = true);
-  /// Fill in useful estimates
+  /** Fill in useful estimates.  With type 0 (plain dual) sums over
+      continuous rows are kept and only rows whose dual changed are
+      redone, so this is cheap enough to do at every node */
   void pseudoShadow(int type);
   /** Return pseudo costs
         If not all integers or not pseudo costs - returns all zero
@@ -2639,6 +3318,34 @@ public:
   {
     maximumNumberIterations_ = value;
   }
+  /** Set file where symmetry generators are kept between runs (NULL or
+        "" for none).  Generators found by nauty are appended with a hash
+        of structure of problem and read back (after checking they still
+        map problem to itself) instead of running nauty again.  Only used
+        when generators are wanted (orbital fixing on generators,
+        CbcOrbitopeFixing or threads) */
+  inline void setSymmetryFile(const char *fileName)
+  {
+    symmetryFile_ = fileName ? fileName : "";
+  }
+  /// File for symmetry generators (NULL if none)
+  inline const char *symmetryFile() const
+  {
+    return symmetryFile_.size() ? symmetryFile_.c_str() : NULL;
+  }
+  /** Set file where root cuts and conflicts are kept between runs on the
+        same structure (NULL or "" for none).  Cuts still valid for the
+        bounds (and cutoff) of a later run go into the global cut pool
+        and fewer root passes are done - see CbcCutDatabase */
+  inline void setCutDatabaseFile(const char *fileName)
+  {
+    cutDatabaseFile_ = fileName ? fileName : "";
+  }
+  /// File for cut database (NULL if none)
+  inline const char *cutDatabaseFile() const
+  {
+    return cutDatabaseFile_.size() ? cutDatabaseFile_.c_str() : NULL;
+  }
 #ifdef CBC_HAS_NAUTY
   /// Symmetry information
   inline CbcSymmetry *symmetryInfo() const
@@ -2652,6 +3359,14 @@ public:
   }
   /// get rid of all
   void zapSymmetry();
+  /** Print statistics for symmetryInfo_ just found and keep it only if
+      useful (may become rootSymmetryInfo_) */
+  void adoptSymmetry();
+  /** Take off tree open nodes whose bounds are image under a generator
+      of those of another open node (which is kept).  Done before nodes
+      are shared out to threads so they do not search symmetric copies.
+      Returns number taken off */
+  int pruneSymmetricNodes();
   /// Root symmetry information
   inline CbcSymmetry *rootSymmetryInfo() const
   {
@@ -2727,8 +3442,13 @@ public:
   {
     return ((ownership_ & 0x40000000) != 0);
   }
-  /// Create C++ lines to get to current state
+  /** Create C++ lines to get to current state.  If options&2 static
+      structure (priorities and preferred directions of integers and
+      implications) is also written so a family of similar models can be
+      solved by a driver with structure of one built in */
   void generateCpp(FILE *fp, int options);
+  /// Create C++ lines to put back static structure (see generateCpp)
+  void generateStructureCpp(FILE *fp);
   /// Generate an OsiBranchingInformation object
   OsiBranchingInformation usefulInformation() const;
   /** Warm start object produced by heuristic or strong branching
@@ -2743,6 +3463,27 @@ public:
   }
   /// Redo walkback arrays
   void redoWalkBack();
+  /** Pseudocost arrays for batched scoring in chooseDynamicBranch.
+        NULL if CbcBatchPseudoCosts not set or no suitable objects */
+  CbcPseudoCostArrays *pseudoCostArrays();
+  /** Look for conflict in Farkas ray of infeasible solver (node or strong
+        branching child) and add it to global cuts.  Only if
+        moreSpecialOptions_ 4194304 set.  Returns 1 if conflict added */
+  int analyzeConflict(const OsiSolverInterface *solver);
+  /** Adaptive strong branching budget for chooseDynamicBranch.
+        NULL if CbcAdaptiveStrong not set */
+  CbcStrongBudget *strongBudget();
+  /** Columns changed since last pass over objects
+        (see CbcSolutionChanges).  NULL if no object wants it */
+  inline CbcSolutionChanges *solutionChanges() const
+  {
+    return solutionChanges_;
+  }
+  /// Objects call this (when first evaluated) to get solutionChanges
+  void wantSolutionChanges();
+  /** View of solver arrays for a round of cut generation
+        (see CbcSeparationContext) */
+  CbcSeparationContext *separationContext();
   //@}
 
   void setMIPStart(const std::vector< std::pair< std::string, double > > &mipstart)
@@ -2772,6 +3513,72 @@ public:
     return this->mipStart_;
   }
 
+  /** Write pseudocosts learnt by dynamic integer objects to a csv file
+      with headings name,down,up,downcount,upcount.  Names are taken from
+      columnNames (indexed by column of this model) if given, otherwise
+      from solver.  Returns number of records written or -1 if file
+      could not be opened */
+  int writePseudoCosts(const char *fileName,
+    const std::vector< std::string > *columnNames = NULL) const;
+  /** Write statistics of cut generators by depth bucket (see
+      CbcCutGenerator::depthBucket) - time, calls, row cuts made, cuts
+      active after cuts at node and bound improvement attributed to
+      generator.  As csv with headings
+      generator,name,depth,calls,time,cuts,active,improvement (depth is
+      first depth in bucket) or as JSON if json true.
+      Returns number of records written or -1 if file could not be opened */
+  int writeCutStatistics(const char *fileName, bool json = false) const;
+  /** Read pseudocosts written by writePseudoCosts.  They are given to
+      dynamic integer objects (matched on column name) at start of next
+      branchAndBound and count as that many earlier branches on each
+      side - at most maximumCount if that is >= 0.
+      Returns number of records read or -1 if file could not be opened */
+  int readPseudoCosts(const char *fileName, int maximumCount = -1);
+  /** Give pseudocosts read by readPseudoCosts to dynamic objects
+      and forget them.  Returns number of objects changed */
+  int usePseudoCostStart();
+  /** Names (indexed by column of this model) pseudocosts at start are
+      matched on - e.g. those of original model after preprocessing.
+      If not set names in solver are used */
+  inline void setPseudoCostColumnNames(const std::vector< std::string > &names)
+  {
+    pseudoCostColumnNames_ = names;
+  }
+  /** Pseudocosts learnt by dynamic integer objects as names and four
+      values each (down, up, down count, up count) - as writePseudoCosts
+      but kept in memory.  Returns number of names */
+  int getPseudoCosts(std::vector< std::string > &names,
+    std::vector< double > &values,
+    const std::vector< std::string > *columnNames = NULL) const;
+  /** Pseudocosts to use at start of next branchAndBound - as
+      readPseudoCosts but from getPseudoCosts of an earlier model */
+  void setPseudoCostStart(const std::vector< std::string > &names,
+    const std::vector< double > &values);
+  /** Fills features (CbcFeatures::numberFeatures of them) of model in
+      solver - sizes, types and ranges found without solving an LP, so
+      cheap enough to choose parameters before solving */
+  void computeFeatures(double *features) const;
+  /** Pass in pricer for branch and price (cloned) - NULL switches off.
+      Slots for priced columns are set in columnPool().  Pricer and pool
+      are not copied with model */
+  void passInPricer(const CbcPricer *pricer);
+  /// Pricer (NULL if none)
+  inline CbcPricer *pricer() const
+  {
+    return pricer_;
+  }
+  /// Pool of priced columns
+  inline CbcColumnPool *columnPool()
+  {
+    return &columnPool_;
+  }
+  /** Puts priced column in next free slot of column pool - in solver,
+      continuous solver and saved solutions (where slot is set to zero).
+      Rows must be rows of continuous problem.  Returns column of model,
+      -1 if same column already in pool or -2 if no free slot */
+  int addPricedColumn(int numberElements, const int *rows,
+    const double *elements, double objective);
+
   //---------------------------------------------------------------------------
 
 private:
@@ -2853,6 +3660,12 @@ private:
       values for integer variables which will be converted to a complete integer initial feasible solution
     */
   std::vector< std::pair< std::string, double > > mipStart_;
+  /// Names for pseudocosts to use at start (see readPseudoCosts)
+  std::vector< std::string > pseudoCostStartNames_;
+  /// Down cost, up cost, down count and up count for each name
+  std::vector< double > pseudoCostStart_;
+  /// Names of columns to match pseudocosts at start (if empty solver's)
+  std::vector< std::string > pseudoCostColumnNames_;
 
   /** keepNamesPreproc
    *  if variables names will be preserved in the pre-processed problem
@@ -2871,6 +3684,8 @@ private:
   CbcRowCuts globalCuts_;
   /// Global conflict cuts
   CbcRowCuts *globalConflictCuts_;
+  /// Slack cuts at node waiting for cut pool of subtree (CbcSubtreeCutPool)
+  OsiCuts subtreeSlackCuts_;
 
   /// Minimum degradation in objective value to continue cut generation
   double minimumDrop_;
@@ -2880,6 +3695,8 @@ private:
   int numberSavedSolutions_;
   /// Maximum number of saved solutions
   int maximumSavedSolutions_;
+  /// Hash of integer values of saved solutions (rebuilt if size wrong)
+  std::vector< unsigned int > savedHash_;
   /** State of search
         0 - no solution
         1 - only heuristic solutions
@@ -2960,7 +3777,100 @@ private:
   /// preProcess used before branch and bound (optional)
   CglPreProcess *preProcess_;
   CbcNodeInfo **lastNodeInfo_;
+  /// Bounds along path of last node (optional - for moving by differences)
+  CbcBoundTrail *boundTrail_;
+  /// Pseudocosts in arrays for chooseDynamicBranch (optional)
+  CbcPseudoCostArrays *pseudoCostArrays_;
+  /// Conflict analysis of infeasible subproblems (optional)
+  CbcConflictAnalysis *conflictAnalysis_;
+  /// Adaptive strong branching budget (optional)
+  CbcStrongBudget *strongBudget_;
+  /// Columns changed since last pass over objects (optional)
+  CbcSolutionChanges *solutionChanges_;
+  /// View of solver for a round of cut generation (optional)
+  CbcSeparationContext *separationContext_;
+  /// Pricer for branch and price (optional)
+  CbcPricer *pricer_;
+  /// Priced columns and slots for them
+  CbcColumnPool columnPool_;
+  /// Times of phases of node processing (optional)
+  CbcPhaseTimes *phaseTimes_;
+  /// Trace of nodes (optional - threads use that of base model)
+  CbcNodeTrace *nodeTrace_;
+  /// Seconds between progress records
+  double progressInterval_;
+  /// File descriptor for progress records as JSON (-1 if none)
+  int progressFd_;
+  /// Last progress record
+  CbcProgressRecord lastProgress_;
+  /// Checkpoint being written (optional)
+  CbcCheckpoint *checkpoint_;
+  /// Checkpoints to resume from at next branchAndBound (optional)
+  std::vector< CbcCheckpoint * > resumeCheckpoints_;
+  /// Set by requestCheckpoint
+  volatile int checkpointRequested_;
+  /// Exchange with other processes (optional)
+  CbcPeerExchange *peerExchange_;
+  /// Seconds between exchanges and time of last one
+  double peerInterval_;
+  double lastPeerExchange_;
+  /** Reduced costs (direction times) and values of integers at root
+      (2*numberIntegers_ - dj then value for each).  Dj zero if basic */
+  double *rootReducedCost_;
+  /** Pseudo shadow prices kept between calls - dual used for each
+      continuous row then up sums and down sums for each column */
+  double *shadowCache_;
+  /// Row copy of continuous rows for shadowCache_
+  CoinPackedMatrix *shadowRowCopy_;
+  /// Number of incremental updates of shadowCache_ since it was made
+  int shadowUpdates_;
+  /** If positive objective of any integer solution is cutoffStepOffset_
+      plus a multiple of this (from analyzeObjective) so setCutoff rounds
+      down to that */
+  double cutoffStep_;
+  double cutoffStepOffset_;
+  /// Normal dual pricing of solver while Dantzig is used (adaptive pricing)
+  ClpDualRowPivot *savedDualPivot_;
+  /// Seconds and iterations of resolves with normal (0) and Dantzig (1)
+  double pricingSeconds_[2];
+  double pricingIterations_[2];
+  /// Resolves measured with each pricing
+  int pricingSolves_[2];
+  /** Adaptive pricing state - 0 measuring pricing in use, 1 trying
+      other, 2 settled, -1 off (normal pricing is Dantzig) */
+  int pricingState_;
+  /// Resolves left in this state
+  int pricingCountdown_;
+  /// Resolves to stay settled next time
+  int pricingPeriod_;
+  /// Number of rows at last resolve in tree (for choice of algorithm)
+  int resolveRows_;
+  /** Iterations and resolves with dual (0) and primal (1) after rows
+      added (0), rows removed (1) and only bounds changed (2) */
+  double algorithmIterations_[3][2];
+  int algorithmSolves_[3][2];
+  /// Resolves in each situation until algorithm not chosen is tried
+  int algorithmCountdown_[3];
+  /** Index of switching objects - number of columns, object numbers of
+      switching objects, then for each column start (numberColumns+1)
+      and switching objects (as position in object numbers) with that
+      column as associated variable */
+  int *switchingIndex_;
+  /// Number of switching objects in switchingIndex_
+  int numberSwitching_;
+  /// Objective of root LP for rootReducedCost_
+  double rootObjectiveValue_;
+  /// Cutoff when globalReducedCostFix last done
+  double globalFixCutoff_;
+  /// Threads for cuts at tree nodes (optional)
+  CbcBaseModel *treeCutMaster_;
+  /// Number of threads kept for cuts at tree nodes (CbcParallelTreeCuts)
+  int treeCutThreads_;
   const OsiRowCut **lastCut_;
+  /// Work arrays of addCuts (cuts kept and rows dropped) and their size
+  const OsiRowCut **keptCuts_;
+  int *cutsToDrop_;
+  int maximumKeptCuts_;
   int lastDepth_;
   int lastNumberCuts2_;
   int maximumCuts_;
@@ -3151,6 +4061,16 @@ private:
   CbcHeuristic **heuristic_;
   /// Pointer to heuristic solver which found last solution (or NULL)
   CbcHeuristic *lastHeuristic_;
+  /// Number of fathoming methods
+  int numberFathomMethods_;
+  /// Fathoming methods tried at nodes
+  CbcFathom **fathom_;
+  /// Number of nodes fathoming methods were tried at
+  int numberFathomTries_;
+  /// Number of nodes fathomed by fathoming methods
+  int numberFathomSuccesses_;
+  /// Number of nodes pruned as duplicates (CbcDuplicateNodes)
+  int numberDuplicateNodes_;
   /// Depth for fast nodes
   int fastNodeDepth_;
   /*! Pointer to the event handler */
@@ -3189,6 +4109,8 @@ private:
   /** Number of times global cuts violated.  When global cut pool then this
         should be kept for each cut and type of cut */
   int numberGlobalViolations_;
+  /// Largest total seen by memoryUsage
+  double memoryHighWater_;
   /// Number of extra iterations in fast lp
   int numberExtraIterations_;
   /// Number of extra nodes in fast lp
@@ -3319,6 +4241,50 @@ private:
   CbcBaseModel *master_;
   /// Pointer to masterthread
   CbcThread *masterThread_;
+  /// Cutoff as last set - read by threads without lock
+  volatile double publishedCutoff_;
+  /// Threads kept for root models and parallel heuristics
+  CbcThreadPool *threadPool_;
+  /// Thread getting next node ready while node solved (CbcPrefetchNodes)
+  CbcThreadPool *prefetchPool_;
+  /// Node info being got ready (NULL if none)
+  CbcNodeInfo *prefetchNodeInfo_;
+  /// Root heuristics running on threads while root cuts done
+  CbcRootHeuristics *rootHeuristics_;
+  /// Heuristics running on background thread in tree
+  CbcTreeHeuristics *treeHeuristics_;
+  /// Dives run at same time in tree
+  CbcDivePortfolio *divePortfolio_;
+  /// Sub-MIPs solved on threads (see startSubBranchAndBound)
+  CbcSubMipQueue *subMipQueue_;
+  /// Bound propagation at nodes (built when first needed)
+  CbcBoundPropagator *nodePropagator_;
+  /// Keys of bounds of nodes solved (CbcDuplicateNodes) - NULL if not used
+  std::set< std::pair< CoinUInt64, CoinUInt64 > > *processedNodes_;
+  /// Factorizations of node LPs (CbcFactorizationMemory) - NULL if not used
+  CbcFactorizationCache *factorizationCache_;
+  /// Cuts of this solve for cut database file - NULL if not used
+  CbcCutDatabase *cutDatabase_;
+  /// Root solver of a racing root copy (see CbcRootRaceNodes)
+  OsiSolverInterface *raceRootSolver_;
+  /// Symmetry being found on background thread
+  CbcSymmetryDetection *symmetryDetection_;
+  /// Orbitope kept in lexicographic order at nodes (see CbcOrbitopeFixing)
+  CbcOrbitope *orbitope_;
+  /// Clique table (see cliqueTable())
+  CbcCliqueTable *cliqueTable_;
+  /// Implications from probing and user (see addImplication)
+  CbcImplicationGraph *implicationGraph_;
+  /// File for JSON thread statistics
+  std::string threadStatisticsFile_;
+  /// File holding thread quota
+  std::string threadQuotaFile_;
+  /// Most threads to give nodes to (0 all) - may be set by other threads
+  volatile int threadQuota_;
+  /// File for symmetry generators
+  std::string symmetryFile_;
+  /// File for cut database
+  std::string cutDatabaseFile_;
   //@}
 };
 /// So we can use osiObject or CbcObject during transition
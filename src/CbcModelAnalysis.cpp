@@ -0,0 +1,336 @@
+// Copyright (C) 2002, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#pragma warning(disable : 4786)
+#endif
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "CoinHelperFunctions.hpp"
+#include "CoinPackedMatrix.hpp"
+#include "OsiSolverInterface.hpp"
+#include "CbcMessage.hpp"
+#include "CbcModelAnalysis.hpp"
+#ifdef CBC_THREAD
+#include <pthread.h>
+#endif
+
+// Constructor
+CbcModelAnalysis::CbcModelAnalysis()
+{
+  clear();
+}
+
+// Forget results
+void CbcModelAnalysis::clear()
+{
+  memset(rowCount_, 0, sizeof(rowCount_));
+  rowsWithBinaries_ = 0;
+  numberRows_ = 0;
+  numberColumns_ = 0;
+  numberElements_ = 0;
+  numberBinary_ = 0;
+  numberGeneral_ = 0;
+  numberContinuous_ = 0;
+  numberBlocks_ = 0;
+  largestBlock_ = 0;
+  smallestElement_ = 0.0;
+  largestElement_ = 0.0;
+  smallestObjective_ = 0.0;
+  largestObjective_ = 0.0;
+  largestRhs_ = 0.0;
+  symmetryLikelihood_ = 0.0;
+  fingerprint_ = 0;
+  valid_ = false;
+}
+
+static inline unsigned int hashDouble(unsigned int hash, double value)
+{
+  unsigned char bytes[sizeof(double)];
+  memcpy(bytes, &value, sizeof(double));
+  for (size_t i = 0; i < sizeof(double); i++)
+    hash = (hash ^ bytes[i]) * 16777619u;
+  return hash;
+}
+
+static inline unsigned int hashInt(unsigned int hash, int value)
+{
+  for (size_t i = 0; i < sizeof(int); i++) {
+    hash = (hash ^ (value & 255)) * 16777619u;
+    value >>= 8;
+  }
+  return hash;
+}
+
+// Fingerprint of model (bounds, types, objective and matrix)
+unsigned int CbcModelAnalysis::fingerprint(const OsiSolverInterface *solver)
+{
+  unsigned int hash = 2166136261u;
+  int numberRows = solver->getNumRows();
+  int numberColumns = solver->getNumCols();
+  const double *rowLower = solver->getRowLower();
+  const double *rowUpper = solver->getRowUpper();
+  for (int i = 0; i < numberRows; i++) {
+    hash = hashDouble(hash, rowLower[i]);
+    hash = hashDouble(hash, rowUpper[i]);
+  }
+  const double *lower = solver->getColLower();
+  const double *upper = solver->getColUpper();
+  const double *objective = solver->getObjCoefficients();
+  const CoinPackedMatrix *matrix = solver->getMatrixByCol();
+  const double *element = matrix->getElements();
+  const int *row = matrix->getIndices();
+  const CoinBigIndex *columnStart = matrix->getVectorStarts();
+  const int *columnLength = matrix->getVectorLengths();
+  for (int i = 0; i < numberColumns; i++) {
+    hash = hashDouble(hash, lower[i]);
+    hash = hashDouble(hash, upper[i]);
+    hash = hashDouble(hash, objective[i]);
+    hash = hashInt(hash, solver->isInteger(i) ? 1 : 0);
+    for (CoinBigIndex j = columnStart[i]; j < columnStart[i] + columnLength[i]; j++) {
+      hash = hashInt(hash, row[j]);
+      hash = hashDouble(hash, element[j]);
+    }
+  }
+  return hash;
+}
+
+// Classifies rows and makes column signatures in one part
+static void *analyzePart(void *voidPart)
+{
+  CbcModelAnalysis::Part *part = reinterpret_cast< CbcModelAnalysis::Part * >(voidPart);
+  const OsiSolverInterface *solver = part->solver;
+  const double *lower = solver->getColLower();
+  const double *upper = solver->getColUpper();
+  const double *rowLower = solver->getRowLower();
+  const double *rowUpper = solver->getRowUpper();
+  const double *objective = solver->getObjCoefficients();
+  memset(part->rowCount, 0, sizeof(part->rowCount));
+  part->rowsWithBinaries = 0;
+  part->smallestElement = COIN_DBL_MAX;
+  part->largestElement = 0.0;
+  part->largestRhs = 0.0;
+  // rows
+  const double *elementByRow = part->rowCopy->getElements();
+  const int *column = part->rowCopy->getIndices();
+  const CoinBigIndex *rowStart = part->rowCopy->getVectorStarts();
+  const int *rowLength = part->rowCopy->getVectorLengths();
+  for (int iRow = part->firstRow; iRow < part->lastRow; iRow++) {
+    for (CoinBigIndex j = rowStart[iRow]; j < rowStart[iRow] + rowLength[iRow]; j++) {
+      double absValue = fabs(elementByRow[j]);
+      if (!absValue)
+        continue;
+      part->smallestElement = CoinMin(part->smallestElement, absValue);
+      part->largestElement = CoinMax(part->largestElement, absValue);
+    }
+    int nBinary;
+    double lo;
+    double up;
+    int rowType = CbcFeatures::classifyRow(solver, rowLength[iRow],
+      column + rowStart[iRow], elementByRow + rowStart[iRow],
+      rowLower[iRow], rowUpper[iRow], &nBinary, &lo, &up);
+    if (lo > -1.0e20)
+      part->largestRhs = CoinMax(part->largestRhs, fabs(lo));
+    if (up < 1.0e20)
+      part->largestRhs = CoinMax(part->largestRhs, fabs(up));
+    if (nBinary >= 2)
+      part->rowsWithBinaries++;
+    part->rowCount[rowType]++;
+  }
+  // column signatures (order of coefficients does not matter)
+  const double *element = part->columnCopy->getElements();
+  const CoinBigIndex *columnStart = part->columnCopy->getVectorStarts();
+  const int *columnLength = part->columnCopy->getVectorLengths();
+  std::vector< double > sorted;
+  for (int iColumn = part->firstColumn; iColumn < part->lastColumn; iColumn++) {
+    unsigned int hash = 2166136261u;
+    hash = hashDouble(hash, lower[iColumn]);
+    hash = hashDouble(hash, upper[iColumn]);
+    hash = hashDouble(hash, objective[iColumn]);
+    hash = hashInt(hash, solver->isInteger(iColumn) ? 1 : 0);
+    CoinBigIndex start = columnStart[iColumn];
+    sorted.assign(element + start, element + start + columnLength[iColumn]);
+    std::sort(sorted.begin(), sorted.end());
+    for (size_t k = 0; k < sorted.size(); k++)
+      hash = hashDouble(hash, sorted[k]);
+    part->signature[iColumn] = hash;
+  }
+  return NULL;
+}
+
+// Root in union find (with path halving)
+static int findRoot(std::vector< int > &parent, int i)
+{
+  while (parent[i] != i) {
+    parent[i] = parent[parent[i]];
+    i = parent[i];
+  }
+  return i;
+}
+
+// Analyzes model
+bool CbcModelAnalysis::analyze(const OsiSolverInterface *solver, int numberThreads)
+{
+  int numberRows = solver->getNumRows();
+  int numberColumns = solver->getNumCols();
+  int numberElements = static_cast< int >(solver->getNumElements());
+  unsigned int newFingerprint = fingerprint(solver);
+  if (valid_ && newFingerprint == fingerprint_ && numberRows == numberRows_
+    && numberColumns == numberColumns_ && numberElements == numberElements_)
+    return false;
+  clear();
+  numberRows_ = numberRows;
+  numberColumns_ = numberColumns;
+  numberElements_ = numberElements;
+  fingerprint_ = newFingerprint;
+  // make both copies here - solvers build them lazily
+  const CoinPackedMatrix *rowCopy = solver->getMatrixByRow();
+  const CoinPackedMatrix *columnCopy = solver->getMatrixByCol();
+  std::vector< unsigned int > signature(numberColumns);
+  // not worth threads on small models
+  if (numberElements < 100000)
+    numberThreads = 1;
+  numberThreads = CoinMax(numberThreads, 1);
+  std::vector< Part > parts(numberThreads);
+  for (int i = 0; i < numberThreads; i++) {
+    Part &part = parts[i];
+    part.solver = solver;
+    part.rowCopy = rowCopy;
+    part.columnCopy = columnCopy;
+    part.signature = numberColumns ? &signature[0] : NULL;
+    part.firstRow = static_cast< int >((static_cast< double >(numberRows) * i) / numberThreads);
+    part.lastRow = static_cast< int >((static_cast< double >(numberRows) * (i + 1)) / numberThreads);
+    part.firstColumn = static_cast< int >((static_cast< double >(numberColumns) * i) / numberThreads);
+    part.lastColumn = static_cast< int >((static_cast< double >(numberColumns) * (i + 1)) / numberThreads);
+  }
+#ifdef CBC_THREAD
+  if (numberThreads > 1) {
+    std::vector< pthread_t > threads(numberThreads);
+    for (int i = 0; i < numberThreads; i++)
+      pthread_create(&threads[i], NULL, analyzePart, &parts[i]);
+    for (int i = 0; i < numberThreads; i++)
+      pthread_join(threads[i], NULL);
+  } else {
+    analyzePart(&parts[0]);
+  }
+#else
+  for (int i = 0; i < numberThreads; i++)
+    analyzePart(&parts[i]);
+#endif
+  smallestElement_ = COIN_DBL_MAX;
+  for (int i = 0; i < numberThreads; i++) {
+    const Part &part = parts[i];
+    for (int k = 0; k < numberRowTypes; k++)
+      rowCount_[k] += part.rowCount[k];
+    rowsWithBinaries_ += part.rowsWithBinaries;
+    smallestElement_ = CoinMin(smallestElement_, part.smallestElement);
+    largestElement_ = CoinMax(largestElement_, part.largestElement);
+    largestRhs_ = CoinMax(largestRhs_, part.largestRhs);
+  }
+  if (smallestElement_ == COIN_DBL_MAX)
+    smallestElement_ = 0.0;
+  // columns
+  const double *lower = solver->getColLower();
+  const double *upper = solver->getColUpper();
+  const double *objective = solver->getObjCoefficients();
+  smallestObjective_ = COIN_DBL_MAX;
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    double value = fabs(objective[iColumn]);
+    if (value) {
+      smallestObjective_ = CoinMin(smallestObjective_, value);
+      largestObjective_ = CoinMax(largestObjective_, value);
+    }
+    if (upper[iColumn] <= lower[iColumn] + 1.0e-8)
+      continue;
+    if (!solver->isInteger(iColumn))
+      numberContinuous_++;
+    else if (lower[iColumn] == 0.0 && upper[iColumn] == 1.0)
+      numberBinary_++;
+    else
+      numberGeneral_++;
+  }
+  if (smallestObjective_ == COIN_DBL_MAX)
+    smallestObjective_ = 0.0;
+  // blocks - union columns in each row
+  std::vector< int > parent(numberColumns);
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++)
+    parent[iColumn] = iColumn;
+  std::vector< char > inRow(numberColumns, 0);
+  const int *column = rowCopy->getIndices();
+  const CoinBigIndex *rowStart = rowCopy->getVectorStarts();
+  const int *rowLength = rowCopy->getVectorLengths();
+  for (int iRow = 0; iRow < numberRows; iRow++) {
+    int first = -1;
+    for (CoinBigIndex j = rowStart[iRow]; j < rowStart[iRow] + rowLength[iRow]; j++) {
+      int iColumn = column[j];
+      if (upper[iColumn] <= lower[iColumn] + 1.0e-8)
+        continue;
+      inRow[iColumn] = 1;
+      int root = findRoot(parent, iColumn);
+      if (first < 0) {
+        first = root;
+      } else if (root != first) {
+        parent[root] = first;
+      }
+    }
+  }
+  std::vector< int > blockSize(numberColumns, 0);
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    if (inRow[iColumn])
+      blockSize[findRoot(parent, iColumn)]++;
+  }
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    if (blockSize[iColumn]) {
+      numberBlocks_++;
+      largestBlock_ = CoinMax(largestBlock_, blockSize[iColumn]);
+    }
+  }
+  // columns sharing signature
+  if (numberColumns) {
+    std::sort(signature.begin(), signature.end());
+    int numberAlike = 0;
+    int start = 0;
+    for (int i = 1; i <= numberColumns; i++) {
+      if (i == numberColumns || signature[i] != signature[start]) {
+        if (i - start > 1)
+          numberAlike += i - start;
+        start = i;
+      }
+    }
+    symmetryLikelihood_ = static_cast< double >(numberAlike) / numberColumns;
+  }
+  valid_ = true;
+  return true;
+}
+
+// Print summary
+void CbcModelAnalysis::print(CoinMessageHandler *handler, const CoinMessages &messages) const
+{
+  if (!valid_)
+    return;
+  char general[400];
+  sprintf(general, "Analysis - %d rows: %d partitioning, %d packing, %d covering, %d cardinality, %d knapsack, %d variable bound, %d precedence, %d integer, %d mixed, %d continuous",
+    numberRows_, rowCount_[setPartitionRow], rowCount_[setPackingRow], rowCount_[setCoverRow],
+    rowCount_[cardinalityRow], rowCount_[knapsackRow], rowCount_[variableBoundRow],
+    rowCount_[precedenceRow], rowCount_[integerRow], rowCount_[mixedRow], rowCount_[continuousRow]);
+  handler->message(CBC_GENERAL, messages)
+    << general << CoinMessageEol;
+  sprintf(general, "Analysis - %d binary, %d general integer and %d continuous columns in %d blocks (largest %d columns)",
+    numberBinary_, numberGeneral_, numberContinuous_, numberBlocks_, largestBlock_);
+  handler->message(CBC_GENERAL, messages)
+    << general << CoinMessageEol;
+  sprintf(general, "Analysis - elements %g to %g, objective %g to %g, largest rhs %g, %.1f%% of columns look alike",
+    smallestElement_, largestElement_, smallestObjective_, largestObjective_, largestRhs_,
+    100.0 * symmetryLikelihood_);
+  handler->message(CBC_GENERAL, messages)
+    << general << CoinMessageEol;
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -0,0 +1,192 @@
+// Copyright (C) 2002, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcModelAnalysis_H
+#define CbcModelAnalysis_H
+
+#include "CoinMessageHandler.hpp"
+#include "CbcSolverConfig.h"
+#include "CbcFeatures.hpp"
+
+class OsiSolverInterface;
+class CoinPackedMatrix;
+
+/** Structure of a model for choosing settings.
+
+    Rows are classified (set partitioning, packing and covering,
+    cardinality, knapsack, variable bound, precedence, other) by
+    CbcFeatures::classifyRow so as for instance features, connected
+    blocks of rows and columns are found, and ranges of coefficients
+    gathered.  Columns with the same bounds, type, objective and sorted
+    coefficients are counted as a hint of symmetry.  Rows and columns are
+    split over threads if asked.
+
+    A fingerprint of the model is kept so analyze does nothing if called
+    again on an unchanged model.
+*/
+
+class CBCSOLVERLIB_EXPORT CbcModelAnalysis {
+public:
+  /// Types of row (those of CbcFeatures::classifyRow)
+  enum RowType {
+    emptyRow = CbcFeatures::emptyRow,
+    setPartitionRow = CbcFeatures::setPartitionRow,
+    setPackingRow = CbcFeatures::setPackingRow,
+    setCoverRow = CbcFeatures::setCoverRow,
+    cardinalityRow = CbcFeatures::cardinalityRow,
+    knapsackRow = CbcFeatures::knapsackRow,
+    variableBoundRow = CbcFeatures::variableBoundRow,
+    precedenceRow = CbcFeatures::precedenceRow,
+    integerRow = CbcFeatures::integerRow,
+    mixedRow = CbcFeatures::mixedRow,
+    continuousRow = CbcFeatures::continuousRow,
+    numberRowTypes = CbcFeatures::numberRowTypes
+  };
+
+  /// Constructor
+  CbcModelAnalysis();
+
+  /** Analyzes model using up to numberThreads threads.  Returns true if
+      done, false if model same as last time (so results kept) */
+  bool analyze(const OsiSolverInterface *solver, int numberThreads = 1);
+  /// Forget results
+  void clear();
+  /// Whether there are results
+  inline bool valid() const
+  {
+    return valid_;
+  }
+  /// Print summary
+  void print(CoinMessageHandler *handler, const CoinMessages &messages) const;
+
+  /// Number of rows of a type
+  inline int rowsOfType(int type) const
+  {
+    return rowCount_[type];
+  }
+  /// Number of rows with at least two binaries
+  inline int rowsWithBinaries() const
+  {
+    return rowsWithBinaries_;
+  }
+  /// Number of rows
+  inline int numberRows() const
+  {
+    return numberRows_;
+  }
+  /// Number of columns
+  inline int numberColumns() const
+  {
+    return numberColumns_;
+  }
+  /// Number of elements
+  inline int numberElements() const
+  {
+    return numberElements_;
+  }
+  /// Number of binary columns (not fixed)
+  inline int numberBinary() const
+  {
+    return numberBinary_;
+  }
+  /// Number of general integer columns (not fixed)
+  inline int numberGeneralInteger() const
+  {
+    return numberGeneral_;
+  }
+  /// Number of continuous columns (not fixed)
+  inline int numberContinuous() const
+  {
+    return numberContinuous_;
+  }
+  /// Number of connected blocks (with at least one row)
+  inline int numberBlocks() const
+  {
+    return numberBlocks_;
+  }
+  /// Columns in largest block
+  inline int largestBlock() const
+  {
+    return largestBlock_;
+  }
+  /// Smallest absolute element
+  inline double smallestElement() const
+  {
+    return smallestElement_;
+  }
+  /// Largest absolute element
+  inline double largestElement() const
+  {
+    return largestElement_;
+  }
+  /// Smallest absolute nonzero objective
+  inline double smallestObjective() const
+  {
+    return smallestObjective_;
+  }
+  /// Largest absolute objective
+  inline double largestObjective() const
+  {
+    return largestObjective_;
+  }
+  /// Largest absolute finite rhs
+  inline double largestRhs() const
+  {
+    return largestRhs_;
+  }
+  /// Fraction of columns which look like another one
+  inline double symmetryLikelihood() const
+  {
+    return symmetryLikelihood_;
+  }
+
+  /// Part of analysis done by each thread (public so threads see it)
+  typedef struct {
+    const OsiSolverInterface *solver;
+    const CoinPackedMatrix *rowCopy;
+    const CoinPackedMatrix *columnCopy;
+    unsigned int *signature;
+    int firstRow;
+    int lastRow;
+    int firstColumn;
+    int lastColumn;
+    int rowCount[numberRowTypes];
+    int rowsWithBinaries;
+    double smallestElement;
+    double largestElement;
+    double largestRhs;
+  } Part;
+
+private:
+  /// Fingerprint of model
+  static unsigned int fingerprint(const OsiSolverInterface *solver);
+
+private:
+  /// Rows of each type
+  int rowCount_[numberRowTypes];
+  int rowsWithBinaries_;
+  int numberRows_;
+  int numberColumns_;
+  int numberElements_;
+  int numberBinary_;
+  int numberGeneral_;
+  int numberContinuous_;
+  int numberBlocks_;
+  int largestBlock_;
+  double smallestElement_;
+  double largestElement_;
+  double smallestObjective_;
+  double largestObjective_;
+  double largestRhs_;
+  double symmetryLikelihood_;
+  /// Fingerprint of model analyzed
+  unsigned int fingerprint_;
+  /// Whether results there
+  bool valid_;
+};
+
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -0,0 +1,455 @@
+// Copyright (C) 2002, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#pragma warning(disable : 4786)
+#endif
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <cctype>
+#include <cfloat>
+#include <cmath>
+
+#include "CoinFileIO.hpp"
+#include "CoinFinite.hpp"
+#include "CoinPackedMatrix.hpp"
+#include "OsiClpSolverInterface.hpp"
+#include "ClpSimplex.hpp"
+#include "CbcMpsReader.hpp"
+
+// Longest line which can be read
+#define CBC_MPS_LINE 4096
+
+// Constructor
+CbcMpsReader::CbcMpsReader()
+  : keepNames_(true)
+  , numberRows_(0)
+  , numberColumns_(0)
+  , numberElements_(0)
+  , numberIntegers_(0)
+  , numberErrors_(0)
+  , objectiveSense_(1.0)
+  , objectiveOffset_(0.0)
+  , columnStart_(NULL)
+  , length_(NULL)
+  , row_(NULL)
+  , element_(NULL)
+  , columnLower_(NULL)
+  , columnUpper_(NULL)
+  , objective_(NULL)
+  , rowLower_(NULL)
+  , rowUpper_(NULL)
+  , integer_(NULL)
+{
+  memset(token_, 0, sizeof(token_));
+}
+
+// Destructor
+CbcMpsReader::~CbcMpsReader()
+{
+  freeArrays();
+}
+// Frees arrays
+void CbcMpsReader::freeArrays()
+{
+  delete[] columnStart_;
+  delete[] length_;
+  delete[] row_;
+  delete[] element_;
+  delete[] columnLower_;
+  delete[] columnUpper_;
+  delete[] objective_;
+  delete[] rowLower_;
+  delete[] rowUpper_;
+  delete[] integer_;
+  columnStart_ = NULL;
+  length_ = NULL;
+  row_ = NULL;
+  element_ = NULL;
+  columnLower_ = NULL;
+  columnUpper_ = NULL;
+  objective_ = NULL;
+  rowLower_ = NULL;
+  rowUpper_ = NULL;
+  integer_ = NULL;
+}
+// Split line into tokens - returns number (or -1 if too many)
+int CbcMpsReader::tokenize(char *line)
+{
+  int n = 0;
+  char *pos = line;
+  while (*pos) {
+    while (*pos && isspace(static_cast< unsigned char >(*pos)))
+      pos++;
+    if (!*pos)
+      break;
+    if (n == 8)
+      return -1;
+    token_[n++] = pos;
+    while (*pos && !isspace(static_cast< unsigned char >(*pos)))
+      pos++;
+    if (*pos)
+      *pos++ = '\0';
+  }
+  return n;
+}
+// Row index of name (-1 not known, -2 ignored free row)
+int CbcMpsReader::rowIndex(const char *name) const
+{
+  std::map< std::string, int >::const_iterator it = rowNames_.find(name);
+  return it == rowNames_.end() ? -1 : it->second;
+}
+/* One pass through file.  First pass builds rows and counts columns
+   and elements, second pass fills arrays allocated between passes */
+int CbcMpsReader::pass(const char *fileName, int which)
+{
+  CoinFileInput *input = NULL;
+  try {
+    input = CoinFileInput::create(fileName);
+  } catch (CoinError &) {
+    return -1;
+  }
+  char line[CBC_MPS_LINE];
+  Section section = sectionNone;
+  int returnCode = 0;
+  int iColumn = -1;
+  bool integer = false;
+  bool gotObjective = false;
+  std::string lastColumn;
+  // row last given an element by column (to find duplicates)
+  int *lastSeen = NULL;
+  if (which) {
+    lastSeen = new int[numberRows_];
+    for (int i = 0; i < numberRows_; i++)
+      lastSeen[i] = -1;
+  }
+  while (!returnCode && input->gets(line, CBC_MPS_LINE)) {
+    size_t length = strlen(line);
+    if (length == CBC_MPS_LINE - 1 && line[length - 1] != '\n') {
+      returnCode = unsupported; // line too long
+      break;
+    }
+    if (line[0] == '*' || line[0] == '\n' || line[0] == '\r' || !line[0])
+      continue;
+    bool header = !isspace(static_cast< unsigned char >(line[0]));
+    int n = tokenize(line);
+    if (n < 0) {
+      returnCode = unsupported;
+      break;
+    } else if (!n) {
+      continue;
+    }
+    if (header) {
+      const char *key = token_[0];
+      if (!strcmp(key, "NAME")) {
+        section = sectionName;
+        if (n > 1)
+          problemName_ = token_[1];
+      } else if (!strcmp(key, "OBJSENSE")) {
+        section = sectionObjSense;
+        if (n > 1) {
+          if (!strcmp(token_[1], "MAX") || !strcmp(token_[1], "MAXIMIZE"))
+            objectiveSense_ = -1.0;
+          else if (strcmp(token_[1], "MIN") && strcmp(token_[1], "MINIMIZE"))
+            returnCode = unsupported;
+        }
+      } else if (!strcmp(key, "ROWS")) {
+        section = sectionRows;
+      } else if (!strcmp(key, "COLUMNS")) {
+        section = sectionColumns;
+      } else if (!strcmp(key, "RHS")) {
+        section = sectionRhs;
+      } else if (!strcmp(key, "RANGES")) {
+        section = sectionRanges;
+      } else if (!strcmp(key, "BOUNDS")) {
+        section = sectionBounds;
+      } else if (!strcmp(key, "ENDATA")) {
+        section = sectionEnd;
+        break;
+      } else {
+        // SOS, QUADOBJ, QSECTION, CSECTION, INDICATORS ...
+        returnCode = unsupported;
+      }
+      continue;
+    }
+    switch (section) {
+    case sectionObjSense:
+      if (!strcmp(token_[0], "MAX") || !strcmp(token_[0], "MAXIMIZE"))
+        objectiveSense_ = -1.0;
+      else if (strcmp(token_[0], "MIN") && strcmp(token_[0], "MINIMIZE"))
+        returnCode = unsupported;
+      break;
+    case sectionRows:
+      if (which)
+        break;
+      if (n != 2 || strlen(token_[0]) != 1) {
+        returnCode = unsupported;
+        break;
+      }
+      switch (toupper(token_[0][0])) {
+      case 'N':
+        // first free row is objective - others are dropped
+        if (!gotObjective) {
+          objectiveName_ = token_[1];
+          gotObjective = true;
+        }
+        rowNames_[token_[1]] = -2;
+        break;
+      case 'E':
+      case 'L':
+      case 'G':
+        rowNames_[token_[1]] = numberRows_++;
+        rowType_.push_back(static_cast< char >(toupper(token_[0][0])));
+        if (keepNames_)
+          rowNameList_.push_back(token_[1]);
+        break;
+      default:
+        returnCode = unsupported;
+        break;
+      }
+      break;
+    case sectionColumns: {
+      if (n == 3 && !strcmp(token_[1], "'MARKER'")) {
+        if (!strcmp(token_[2], "'INTORG'"))
+          integer = true;
+        else if (!strcmp(token_[2], "'INTEND'"))
+          integer = false;
+        else
+          returnCode = unsupported;
+        break;
+      }
+      if (n != 3 && n != 5) {
+        returnCode = unsupported; // probably fixed format with spaces
+        break;
+      }
+      if (lastColumn != token_[0]) {
+        lastColumn = token_[0];
+        iColumn++;
+        if (!which) {
+          numberColumns_++;
+        } else {
+          if (iColumn)
+            length_[iColumn - 1] = static_cast< int >(numberElements_ - columnStart_[iColumn - 1]);
+          columnStart_[iColumn] = numberElements_;
+          columnNames_[lastColumn] = iColumn;
+          if (keepNames_)
+            columnNameList_.push_back(lastColumn);
+          if (integer)
+            integer_[iColumn] = 1;
+        }
+      }
+      for (int k = 1; k < n; k += 2) {
+        const char *name = token_[k];
+        if (!which) {
+          numberElements_++;
+          continue;
+        }
+        double value = atof(token_[k + 1]);
+        if (objectiveName_ == name) {
+          objective_[iColumn] = value;
+          continue;
+        }
+        int iRow = rowIndex(name);
+        if (iRow == -2)
+          continue;
+        if (iRow < 0 || lastSeen[iRow] == iColumn) {
+          numberErrors_++; // unknown or duplicate
+          continue;
+        }
+        lastSeen[iRow] = iColumn;
+        if (value) {
+          row_[numberElements_] = iRow;
+          element_[numberElements_++] = value;
+        }
+      }
+    } break;
+    case sectionRhs:
+    case sectionRanges: {
+      if (!which)
+        break;
+      // set name may be missing
+      int first = (n & 1) ? 1 : 0;
+      for (int k = first; k + 1 < n; k += 2) {
+        const char *name = token_[k];
+        double value = atof(token_[k + 1]);
+        if (section == sectionRhs && objectiveName_ == name) {
+          objectiveOffset_ = value;
+          continue;
+        }
+        int iRow = rowIndex(name);
+        if (iRow == -2)
+          continue;
+        if (iRow < 0) {
+          numberErrors_++;
+          continue;
+        }
+        if (section == sectionRhs)
+          rowLower_[iRow] = value;
+        else
+          rowUpper_[iRow] = value;
+      }
+    } break;
+    case sectionBounds: {
+      if (!which)
+        break;
+      const char *type = token_[0];
+      bool needValue = strcmp(type, "FR") && strcmp(type, "MI") && strcmp(type, "PL") && strcmp(type, "BV");
+      // type [set] column [value]
+      const char *name;
+      double value = 0.0;
+      if (needValue) {
+        if (n < 3 || n > 4) {
+          returnCode = unsupported;
+          break;
+        }
+        name = token_[n - 2];
+        value = atof(token_[n - 1]);
+      } else {
+        if (n < 2 || n > 4) {
+          returnCode = unsupported;
+          break;
+        }
+        name = token_[n == 2 ? 1 : 2];
+      }
+      std::map< std::string, int >::const_iterator it = columnNames_.find(name);
+      if (it == columnNames_.end()) {
+        numberErrors_++;
+        break;
+      }
+      int jColumn = it->second;
+      if (!strcmp(type, "UP") || !strcmp(type, "UI")) {
+        columnUpper_[jColumn] = value;
+        // as CoinMpsIO - negative upper with zero lower means free below
+        if (value < 0.0 && !columnLower_[jColumn])
+          columnLower_[jColumn] = -COIN_DBL_MAX;
+      } else if (!strcmp(type, "LO") || !strcmp(type, "LI")) {
+        columnLower_[jColumn] = value;
+      } else if (!strcmp(type, "FX")) {
+        columnLower_[jColumn] = value;
+        columnUpper_[jColumn] = value;
+      } else if (!strcmp(type, "FR")) {
+        columnLower_[jColumn] = -COIN_DBL_MAX;
+        columnUpper_[jColumn] = COIN_DBL_MAX;
+      } else if (!strcmp(type, "MI")) {
+        columnLower_[jColumn] = -COIN_DBL_MAX;
+      } else if (!strcmp(type, "PL")) {
+        columnUpper_[jColumn] = COIN_DBL_MAX;
+      } else if (!strcmp(type, "BV")) {
+        columnLower_[jColumn] = 0.0;
+        columnUpper_[jColumn] = 1.0;
+      } else {
+        returnCode = unsupported; // SC etc
+        break;
+      }
+      if (type[1] == 'I' || type[0] == 'B')
+        integer_[jColumn] = 1; // integer from bounds section
+    } break;
+    default:
+      break;
+    }
+  }
+  delete input;
+  delete[] lastSeen;
+  if (!returnCode && section != sectionEnd)
+    returnCode = unsupported; // no ENDATA
+  if (returnCode)
+    return returnCode;
+  if (which && numberColumns_)
+    length_[numberColumns_ - 1] = static_cast< int >(numberElements_ - columnStart_[numberColumns_ - 1]);
+  return 0;
+}
+// Read fileName into solver
+int CbcMpsReader::readMps(const char *fileName, OsiClpSolverInterface *solver,
+  bool keepNames)
+{
+  keepNames_ = keepNames;
+  int returnCode = pass(fileName, 0);
+  if (returnCode)
+    return returnCode;
+  // arrays of exactly right size
+  columnStart_ = new CoinBigIndex[numberColumns_ + 1];
+  length_ = new int[numberColumns_];
+  row_ = new int[numberElements_];
+  element_ = new double[numberElements_];
+  columnLower_ = new double[numberColumns_];
+  columnUpper_ = new double[numberColumns_];
+  objective_ = new double[numberColumns_];
+  rowLower_ = new double[numberRows_];
+  rowUpper_ = new double[numberRows_];
+  integer_ = new char[numberColumns_];
+  for (int i = 0; i < numberColumns_; i++) {
+    columnLower_[i] = 0.0;
+    columnUpper_[i] = COIN_DBL_MAX;
+    objective_[i] = 0.0;
+    integer_[i] = 0;
+  }
+  // rhs in rowLower_ and range in rowUpper_ until end
+  for (int i = 0; i < numberRows_; i++) {
+    rowLower_[i] = 0.0;
+    rowUpper_[i] = COIN_DBL_MAX;
+  }
+  numberElements_ = 0;
+  returnCode = pass(fileName, 1);
+  if (returnCode) {
+    freeArrays();
+    return returnCode;
+  }
+  columnStart_[numberColumns_] = numberElements_;
+  for (int i = 0; i < numberRows_; i++) {
+    double rhs = rowLower_[i];
+    double range = rowUpper_[i];
+    bool gotRange = range != COIN_DBL_MAX;
+    switch (rowType_[i]) {
+    case 'E':
+      rowLower_[i] = rhs;
+      rowUpper_[i] = rhs;
+      if (gotRange) {
+        if (range > 0.0)
+          rowUpper_[i] = rhs + range;
+        else
+          rowLower_[i] = rhs + range;
+      }
+      break;
+    case 'L':
+      rowLower_[i] = gotRange ? rhs - fabs(range) : -COIN_DBL_MAX;
+      rowUpper_[i] = rhs;
+      break;
+    default:
+      rowLower_[i] = rhs;
+      rowUpper_[i] = gotRange ? rhs + fabs(range) : COIN_DBL_MAX;
+      break;
+    }
+  }
+  // solver takes over arrays
+  CoinPackedMatrix *matrix = new CoinPackedMatrix();
+  matrix->assignMatrix(true, numberRows_, numberColumns_, numberElements_,
+    element_, row_, columnStart_, length_);
+  solver->assignProblem(matrix, columnLower_, columnUpper_, objective_,
+    rowLower_, rowUpper_);
+  int *which = new int[numberColumns_];
+  numberIntegers_ = 0;
+  for (int i = 0; i < numberColumns_; i++) {
+    if (integer_[i])
+      which[numberIntegers_++] = i;
+  }
+  solver->setInteger(which, numberIntegers_);
+  delete[] which;
+  solver->setObjSense(objectiveSense_);
+  solver->setDblParam(OsiObjOffset, objectiveOffset_);
+  solver->setStrParam(OsiProbName, problemName_);
+  if (keepNames_) {
+    solver->getModelPtr()->copyNames(rowNameList_, columnNameList_);
+    rowNameList_.clear();
+    columnNameList_.clear();
+  }
+  freeArrays();
+  rowNames_.clear();
+  columnNames_.clear();
+  return numberErrors_;
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
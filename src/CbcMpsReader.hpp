@@ -0,0 +1,120 @@
+// Copyright (C) 2002, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcMpsReader_H
+#define CbcMpsReader_H
+
+#include <string>
+#include <vector>
+#include <map>
+
+#include "CbcSolverConfig.h"
+#include "CoinTypes.hpp"
+
+class OsiClpSolverInterface;
+class CoinFileInput;
+
+/** Reads an MPS file straight into a Clp solver.
+
+    CoinMpsIO keeps its own copy of the matrix and names which is then
+    copied into the solver.  Here the file (which may be compressed) is
+    read twice a line at a time - first to find rows and count columns
+    and elements, then to fill arrays of exactly the right size which
+    are given to the solver (assignProblem) so no other copy of the
+    matrix exists.  Sections are NAME, OBJSENSE, ROWS, COLUMNS (with
+    integer markers), RHS, RANGES and BOUNDS in free format.  Anything
+    else (SOS, quadratic, semicontinuous bounds, names with spaces)
+    gives unsupported so caller can use the solver's own readMps.
+*/
+
+class CBCSOLVERLIB_EXPORT CbcMpsReader {
+public:
+  /// Return code when file needs CoinMpsIO
+  enum {
+    unsupported = -2
+  };
+  /// Constructor
+  CbcMpsReader();
+  /// Destructor
+  ~CbcMpsReader();
+
+  /** Read fileName into solver.  Returns 0 if fine, number of errors
+      (elements or bounds for unknown rows or columns - skipped) if any,
+      -1 if file can not be opened and unsupported if some of file can
+      not be read here (solver unchanged then) */
+  int readMps(const char *fileName, OsiClpSolverInterface *solver,
+    bool keepNames = true);
+
+private:
+  /// Sections of file
+  enum Section {
+    sectionNone = 0,
+    sectionName,
+    sectionObjSense,
+    sectionRows,
+    sectionColumns,
+    sectionRhs,
+    sectionRanges,
+    sectionBounds,
+    sectionEnd
+  };
+  /** One pass through file - pass 0 finds rows and counts, pass 1
+      fills arrays.  Returns as readMps */
+  int pass(const char *fileName, int which);
+  /// Split line into tokens - returns number (or -1 if too many)
+  int tokenize(char *line);
+  /// Row index of name (-1 not known, -2 ignored free row)
+  int rowIndex(const char *name) const;
+  /// Frees arrays
+  void freeArrays();
+  /// Illegal copy constructor
+  CbcMpsReader(const CbcMpsReader &);
+  /// Illegal assignment operator
+  CbcMpsReader &operator=(const CbcMpsReader &);
+
+private:
+  /// Tokens of current line
+  char *token_[8];
+  /// Names of rows
+  std::map< std::string, int > rowNames_;
+  /// Names of columns (filled in second pass)
+  std::map< std::string, int > columnNames_;
+  /// Row and column names in order if kept
+  std::vector< std::string > rowNameList_;
+  std::vector< std::string > columnNameList_;
+  /// Problem name
+  std::string problemName_;
+  /// Name of objective row
+  std::string objectiveName_;
+  /// Type of each row (E, L or G)
+  std::vector< char > rowType_;
+  /// Whether names kept
+  bool keepNames_;
+  /// Numbers
+  int numberRows_;
+  int numberColumns_;
+  CoinBigIndex numberElements_;
+  int numberIntegers_;
+  int numberErrors_;
+  /// Objective sense
+  double objectiveSense_;
+  /// Objective offset (rhs of objective row)
+  double objectiveOffset_;
+  /// Arrays filled in second pass
+  CoinBigIndex *columnStart_;
+  int *length_;
+  int *row_;
+  double *element_;
+  double *columnLower_;
+  double *columnUpper_;
+  double *objective_;
+  double *rowLower_;
+  double *rowUpper_;
+  char *integer_;
+};
+
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
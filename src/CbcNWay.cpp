@@ -20,6 +20,8 @@
 #include "CbcModel.hpp"
 #include "CbcMessage.hpp"
 #include "CbcNWay.hpp"
+#include "CbcSolutionChanges.hpp"
+#include "CbcImplicationGraph.hpp"
 #include "CbcBranchActual.hpp"
 #include "CoinSort.hpp"
 #include "CoinError.hpp"
@@ -32,6 +34,8 @@ CbcNWay::CbcNWay()
   , numberMembers_(0)
   , members_(NULL)
   , consequence_(NULL)
+  , cachedInfeasibility_(0.0)
+  , cachedStamp_(-1)
 {
 }
 
@@ -49,6 +53,8 @@ CbcNWay::CbcNWay(CbcModel *model, int numberMembers,
     members_ = NULL;
   }
   consequence_ = NULL;
+  cachedInfeasibility_ = 0.0;
+  cachedStamp_ = -1;
 }
 
 // Copy constructor
@@ -57,6 +63,8 @@ CbcNWay::CbcNWay(const CbcNWay &rhs)
 {
   numberMembers_ = rhs.numberMembers_;
   consequence_ = NULL;
+  cachedInfeasibility_ = 0.0;
+  cachedStamp_ = -1;
   if (numberMembers_) {
     members_ = new int[numberMembers_];
     memcpy(members_, rhs.members_, numberMembers_ * sizeof(int));
@@ -89,6 +97,8 @@ CbcNWay::operator=(const CbcNWay &rhs)
     CbcObject::operator=(rhs);
     delete[] members_;
     numberMembers_ = rhs.numberMembers_;
+    cachedInfeasibility_ = 0.0;
+    cachedStamp_ = -1;
     if (consequence_) {
       for (int i = 0; i < numberMembers_; i++)
         delete consequence_[i];
@@ -144,10 +154,20 @@ void CbcNWay::setConsequence(int iColumn, const CbcConsequence &consequence)
 void CbcNWay::applyConsequence(int iSequence, int state) const
 {
   assert(state == -9999 || state == 9999);
+  OsiSolverInterface *solver = model_->solver();
   if (consequence_) {
     CbcConsequence *consequence = consequence_[iSequence];
     if (consequence)
-      consequence->applyToSolver(model_->solver(), state);
+      consequence->applyToSolver(solver, state);
+  }
+  CbcImplicationGraph *graph = model_->implicationGraph();
+  if (graph && graph->finished()) {
+    // and what follows from member at zero or one
+    int iColumn = members_[iSequence];
+    double value = (state == 9999) ? solver->getColUpper()[iColumn]
+                                   : solver->getColLower()[iColumn];
+    if (value == 0.0 || value == 1.0)
+      graph->apply(solver, iColumn, static_cast< int >(value), model_->cliqueTable());
   }
 }
 double
@@ -161,6 +181,18 @@ CbcNWay::infeasibility(const OsiBranchingInformation * /*info*/,
   const double *lower = solver->getColLower();
   const double *upper = solver->getColUpper();
   double largestValue = 0.0;
+  preferredWay = 1;
+  // Use last value if no member changed since then
+  CbcSolutionChanges *changes = model_->solutionChanges();
+  if (!changes) {
+    model_->wantSolutionChanges();
+    changes = model_->solutionChanges();
+  }
+  int stamp = changes->sameArrays(solution, lower, upper) ? changes->stamp() : -1;
+  if (stamp >= 0 && (cachedStamp_ == stamp || (cachedStamp_ == stamp - 1 && !changes->anyChanged(numberMembers_, members_)))) {
+    cachedStamp_ = stamp;
+    return cachedInfeasibility_;
+  }
 
   double integerTolerance = model_->getDblParam(CbcModel::CbcIntegerTolerance);
 
@@ -175,10 +207,12 @@ CbcNWay::infeasibility(const OsiBranchingInformation * /*info*/,
       largestValue = CoinMax(distance, largestValue);
     }
   }
-  preferredWay = 1;
+  cachedStamp_ = stamp;
   if (numberUnsatis) {
+    cachedInfeasibility_ = largestValue;
     return largestValue;
   } else {
+    cachedInfeasibility_ = 0.0;
     return 0.0; // satisfied
   }
 }
@@ -357,13 +391,16 @@ CbcNWayBranchingObject::branch()
     int iSequence = order_[j];
     int iColumn = members[iSequence];
     if (j != which) {
-      model_->solver()->setColUpper(iColumn, lower[iColumn]);
+      // only change bounds which need it
+      if (upper[iColumn] != lower[iColumn])
+        model_->solver()->setColUpper(iColumn, lower[iColumn]);
       //model_->solver()->setColLower(iColumn,lower[iColumn]);
       assert(lower[iColumn] > -1.0e20);
       // apply any consequences
       object_->applyConsequence(iSequence, -9999);
     } else {
-      model_->solver()->setColLower(iColumn, upper[iColumn]);
+      if (lower[iColumn] != upper[iColumn])
+        model_->solver()->setColLower(iColumn, upper[iColumn]);
       //model_->solver()->setColUpper(iColumn,upper[iColumn]);
 #ifdef FULL_PRINT
       printf("Up Fix %d to %g\n", iColumn, upper[iColumn]);
@@ -74,6 +74,10 @@ protected:
   int *members_;
   /// Consequences (normally NULL)
   CbcConsequence **consequence_;
+  /// Infeasibility at cachedStamp_
+  mutable double cachedInfeasibility_;
+  /// Stamp of CbcSolutionChanges when infeasibility computed (-1 none)
+  mutable int cachedStamp_;
 };
 /** N way branching Object class.
     Variable is number of set.
@@ -0,0 +1,113 @@
+// Copyright (C) 2002, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#pragma warning(disable : 4786)
+#endif
+#include <cstring>
+
+#include "OsiSolverInterface.hpp"
+#include "CbcNameHash.hpp"
+
+// Constructor
+CbcNameHash::CbcNameHash()
+  : used_(0)
+  , stale_(true)
+{
+}
+
+// Empty table for n names
+void CbcNameHash::reserve(int n)
+{
+  names_.clear();
+  start_.resize(n);
+  size_t size = 16;
+  while (size < 2 * static_cast< size_t >(n))
+    size *= 2;
+  table_.assign(size, -1);
+  used_ = 0;
+}
+
+// Builds from column (or row) names in solver
+void CbcNameHash::build(const OsiSolverInterface *solver, bool columns)
+{
+  int n = columns ? solver->getNumCols() : solver->getNumRows();
+  reserve(n);
+  for (int i = 0; i < n; i++) {
+    std::string name = columns ? solver->getColName(i) : solver->getRowName(i);
+    start_[i] = names_.size();
+    names_.insert(names_.end(), name.c_str(), name.c_str() + name.size() + 1);
+    insert(i, name.c_str());
+  }
+  stale_ = false;
+}
+
+// Builds from names
+void CbcNameHash::build(const std::vector< std::string > &names)
+{
+  int n = static_cast< int >(names.size());
+  reserve(n);
+  for (int i = 0; i < n; i++) {
+    const std::string &name = names[i];
+    start_[i] = names_.size();
+    names_.insert(names_.end(), name.c_str(), name.c_str() + name.size() + 1);
+    insert(i, name.c_str());
+  }
+  stale_ = false;
+}
+
+// New name for index (which may be one past end)
+void CbcNameHash::add(int index, const char *name)
+{
+  if (stale_)
+    return;
+  if (2 * (used_ + 1) > table_.size() || index > static_cast< int >(start_.size())) {
+    stale_ = true;
+    return;
+  }
+  if (index == static_cast< int >(start_.size()))
+    start_.push_back(0);
+  start_[index] = names_.size();
+  names_.insert(names_.end(), name, name + strlen(name) + 1);
+  insert(index, name);
+}
+
+// Index of name or -1
+int CbcNameHash::find(const char *name) const
+{
+  if (table_.empty())
+    return -1;
+  size_t mask = table_.size() - 1;
+  for (size_t k = hashValue(name) & mask;; k = (k + 1) & mask) {
+    int index = table_[k];
+    if (index < 0)
+      return -1;
+    if (!strcmp(&names_[start_[index]], name))
+      return index;
+  }
+}
+
+size_t CbcNameHash::hashValue(const char *name)
+{
+  size_t value = 2166136261u;
+  for (; *name; name++)
+    value = (value ^ static_cast< unsigned char >(*name)) * 16777619u;
+  return value;
+}
+
+// Later entries for same name win (old ones for renamed entries can not match)
+void CbcNameHash::insert(int index, const char *name)
+{
+  size_t mask = table_.size() - 1;
+  size_t k = hashValue(name) & mask;
+  while (table_[k] >= 0 && strcmp(&names_[start_[table_[k]]], name))
+    k = (k + 1) & mask;
+  if (table_[k] < 0)
+    used_++;
+  table_[k] = index;
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
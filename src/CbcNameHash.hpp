@@ -0,0 +1,75 @@
+// Copyright (C) 2002, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcNameHash_H
+#define CbcNameHash_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "CbcSolverConfig.h"
+
+class OsiSolverInterface;
+
+/** Index of row or column names.
+
+    Open addressing (FNV hash, linear probing) into one buffer holding
+    all names - much cheaper to build and search than a map of strings
+    when there are millions of names.  Names may be appended and
+    renamed; anything else needs a rebuild (see stale).
+*/
+
+class CBCSOLVERLIB_EXPORT CbcNameHash {
+public:
+  /// Constructor
+  CbcNameHash();
+
+  /// Index must be built again
+  inline void invalidate()
+  {
+    stale_ = true;
+  }
+  /// Whether index must be built again
+  inline bool stale() const
+  {
+    return stale_;
+  }
+
+  /// Builds from column (or row) names in solver
+  void build(const OsiSolverInterface *solver, bool columns);
+  /// Builds from names
+  void build(const std::vector< std::string > &names);
+
+  /// New name for index (which may be one past end)
+  void add(int index, const char *name);
+
+  /// Index of name or -1
+  int find(const char *name) const;
+
+private:
+  /// Empty table for n names
+  void reserve(int n);
+  /// Hash value of name
+  static size_t hashValue(const char *name);
+  /// Puts name in table (later entries for same name win)
+  void insert(int index, const char *name);
+
+private:
+  /// All names each followed by 0
+  std::vector< char > names_;
+  /// Start of each name in names_
+  std::vector< size_t > start_;
+  /// Table of indices (-1 empty), size a power of 2
+  std::vector< int > table_;
+  /// Used entries in table
+  size_t used_;
+  /// Whether must be built again
+  bool stale_;
+};
+
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -41,12 +41,18 @@
 #include "CbcStrategy.hpp"
 #include "CbcBranchActual.hpp"
 #include "CbcBranchDynamic.hpp"
+#include "CbcPseudoCostArrays.hpp"
+#include "CbcStrongCache.hpp"
+#include "CbcStrongBudget.hpp"
+#include "CbcSolutionChanges.hpp"
 #include "OsiRowCut.hpp"
 #include "OsiRowCutDebugger.hpp"
 #include "OsiCuts.hpp"
 #include "CbcCountRowCut.hpp"
 #include "CbcFeasibilityBase.hpp"
 #include "CbcMessage.hpp"
+// This may be dummy
+#include "CbcThread.hpp"
 #ifdef CBC_HAS_CLP
 #include "OsiClpSolverInterface.hpp"
 #include "ClpSimplexOther.hpp"
@@ -62,12 +68,18 @@ CbcNode::CbcNode()
   , objectiveValue_(1.0e100)
   , guessedObjectiveValue_(1.0e100)
   , sumInfeasibilities_(0.0)
+  , lpSeconds_(0.0)
   , branch_(NULL)
   , depth_(-1)
   , numberUnsatisfied_(0)
   , nodeNumber_(-1)
+  , lpIterations_(0)
   , state_(0)
 {
+  childObjective_[0] = -COIN_DBL_MAX;
+  childObjective_[1] = -COIN_DBL_MAX;
+  childBasis_[0] = NULL;
+  childBasis_[1] = NULL;
 #ifdef CHECK_NODE
   printf("CbcNode %p Constructor\n", this);
 #endif
@@ -84,12 +96,18 @@ CbcNode::CbcNode(CbcModel *model,
   , objectiveValue_(1.0e100)
   , guessedObjectiveValue_(1.0e100)
   , sumInfeasibilities_(0.0)
+  , lpSeconds_(0.0)
   , branch_(NULL)
   , depth_(-1)
   , numberUnsatisfied_(0)
   , nodeNumber_(-1)
+  , lpIterations_(0)
   , state_(0)
 {
+  childObjective_[0] = -COIN_DBL_MAX;
+  childObjective_[1] = -COIN_DBL_MAX;
+  childBasis_[0] = NULL;
+  childBasis_[1] = NULL;
 #ifdef CHECK_NODE
   printf("CbcNode %p Constructor from model\n", this);
 #endif
@@ -106,6 +124,44 @@ CbcNode::CbcNode(CbcModel *model,
 #define CBC_NEW_CREATEINFO
 #ifdef CBC_NEW_CREATEINFO
 
+/*
+  Estimate of bytes in basis diff from oldBasis to newBasis.  As
+  CoinWarmStartBasis::generateDiff there is an index and value for each
+  changed word of status, unless that would be more than whole basis.
+*/
+static int basisDiffBytes(const CoinWarmStartBasis *newBasis,
+  const CoinWarmStartBasis *oldBasis)
+{
+  int numberChanged = 0;
+  int numberWords = 0;
+  for (int iPass = 0; iPass < 2; iPass++) {
+    const unsigned int *newStatus;
+    const unsigned int *oldStatus;
+    int newWords;
+    int oldWords;
+    if (!iPass) {
+      newStatus = reinterpret_cast< const unsigned int * >(newBasis->getStructuralStatus());
+      oldStatus = reinterpret_cast< const unsigned int * >(oldBasis->getStructuralStatus());
+      newWords = (newBasis->getNumStructural() + 15) >> 4;
+      oldWords = (oldBasis->getNumStructural() + 15) >> 4;
+    } else {
+      newStatus = reinterpret_cast< const unsigned int * >(newBasis->getArtificialStatus());
+      oldStatus = reinterpret_cast< const unsigned int * >(oldBasis->getArtificialStatus());
+      newWords = (newBasis->getNumArtificial() + 15) >> 4;
+      oldWords = (oldBasis->getNumArtificial() + 15) >> 4;
+    }
+    int numberCommon = CoinMin(newWords, oldWords);
+    for (int i = 0; i < numberCommon; i++) {
+      if (newStatus[i] != oldStatus[i])
+        numberChanged++;
+    }
+    numberChanged += newWords - numberCommon;
+    numberWords += newWords;
+  }
+  int bytes = CoinMin(2 * numberChanged, numberWords) * static_cast< int >(sizeof(unsigned int));
+  return bytes + static_cast< int >(sizeof(CoinWarmStartBasisDiff));
+}
+
 /*
   New createInfo, with basis manipulation hidden inside mergeBasis. Allows
   solvers to override and carry over all information from one basis to
@@ -243,8 +299,10 @@ void CbcNode::createInfo(CbcModel *model,
           diff process has no knowledge of the meaning of an entry) but it does
           mean that we'll always generate a whack of diff entries because the expanded
           basis is considerably larger than the stripped basis.
+
+          The diff itself may be left until a subproblem below this node is
+          restored (see below) - many nodes are pruned before that.
         */
-    CoinWarmStartDiff *basisDiff = expanded->generateDiff(lastws);
 
     /*
           Diff the bound vectors. It's assumed the number of structural variables
@@ -257,11 +315,18 @@ void CbcNode::createInfo(CbcModel *model,
     const double *lower = solver->getColLower();
     const double *upper = solver->getColUpper();
 
-    double *boundChanges = new double[2 * numberColumns];
-    int *variables = new int[2 * numberColumns];
+    // count first so arrays are only as long as needed
     int numberChangedBounds = 0;
-
     int i;
+    for (i = 0; i < numberColumns; i++) {
+      if (lower[i] != lastLower[i])
+        numberChangedBounds++;
+      if (upper[i] != lastUpper[i])
+        numberChangedBounds++;
+    }
+    double *boundChanges = new double[numberChangedBounds];
+    int *variables = new int[numberChangedBounds];
+    numberChangedBounds = 0;
     for (i = 0; i < numberColumns; i++) {
       if (lower[i] != lastLower[i]) {
         variables[numberChangedBounds] = i;
@@ -289,19 +354,84 @@ void CbcNode::createInfo(CbcModel *model,
 #endif
     //if (lastNode->branchingObject()->boundBranch())
     //assert (numberChangedBounds);
+    /*
+          Every so often store bounds and basis in full (a checkpoint) so that
+          restoring a deep node does not have to apply every edit back to the
+          root. With spacing K a restore applies about K/2 edits while each
+          node carries 1/K of a full record, so the sum is least when K*K
+          times the average edit is about twice a full record. Walk up to the
+          nearest full record adding up the edits; K*K*average is depth*total.
+        */
+    int diffBytes = basisDiffBytes(expanded, lastws);
+    bool checkpoint = false;
+    if ((model->moreSpecialOptions2() & 16777216) == 0) {
+      double fullBytes = sizeof(CbcFullNodeInfo) + 2.0 * sizeof(double) * numberColumns
+        + 0.25 * (numberColumns + expanded->getNumArtificial());
+      double editBytes = sizeof(CbcPartialNodeInfo) + diffBytes
+        + numberChangedBounds * (sizeof(double) + sizeof(int));
+      int depth = 1;
+      const CbcNodeInfo *info = lastNode->nodeInfo_;
+      while (info) {
+        const CbcPartialNodeInfo *partial = dynamic_cast< const CbcPartialNodeInfo * >(info);
+        if (!partial)
+          break;
+        editBytes += sizeof(CbcPartialNodeInfo) + partial->basisDiffBytes()
+          + partial->numberChangedBounds() * (partial->binaryBounds() ? sizeof(int) : sizeof(double) + sizeof(int));
+        depth++;
+        if (depth >= 4 && depth * editBytes >= 2.0 * fullBytes) {
+          checkpoint = true;
+          break;
+        }
+        info = info->parent();
+      }
+    }
+    /*
+          The diff is made by the time a subproblem below this node is
+          restored, so a node pruned by cutoff before then never needs it.
+          Keeping both bases until then costs memory though, so only defer
+          when the diff would be at least half their size anyway.  Not when
+          threads may restore below this node at the same time, or when a
+          strategy makes the node information.
+        */
+    bool deferDiff = false;
+    if (!checkpoint && !strategy && !model->getNumberThreads()) {
+      double basesBytes = 0.25 * (2 * numberColumns + expanded->getNumArtificial()
+                                   + lastws->getNumArtificial());
+      deferDiff = basesBytes <= 2.0 * diffBytes;
+    }
     /*
           Hand the lot over to the CbcPartialNodeInfo constructor, then clean up and
           return.
         */
-    if (!strategy) {
+    CoinWarmStartDiff *basisDiff = NULL;
+    if (checkpoint) {
+      delete nodeInfo_;
+      // takes over expanded basis
+      nodeInfo_ = new CbcFullNodeInfo(model, lastNode->nodeInfo_, this, expanded);
+      expanded = NULL;
+    } else if (deferDiff) {
       delete nodeInfo_;
+      // takes over both bases
+      CoinWarmStartBasis *oldBasis = dynamic_cast< CoinWarmStartBasis * >(lastws->clone());
+      nodeInfo_ = new CbcPartialNodeInfo(lastNode->nodeInfo_, this, numberChangedBounds,
+        variables, boundChanges, expanded, oldBasis);
+      expanded = NULL;
+    } else if (!strategy) {
+      delete nodeInfo_;
+      basisDiff = expanded->generateDiff(lastws);
       nodeInfo_ = new CbcPartialNodeInfo(lastNode->nodeInfo_, this, numberChangedBounds,
         variables, boundChanges, basisDiff);
     } else {
+      basisDiff = expanded->generateDiff(lastws);
       nodeInfo_ = strategy->partialNodeInfo(model, lastNode->nodeInfo_, this,
         numberChangedBounds, variables, boundChanges,
         basisDiff);
     }
+    if (!checkpoint) {
+      CbcPartialNodeInfo *partial = dynamic_cast< CbcPartialNodeInfo * >(nodeInfo_);
+      if (partial)
+        partial->setBasisDiffBytes(diffBytes);
+    }
     delete basisDiff;
     delete[] boundChanges;
     delete[] variables;
@@ -687,7 +817,40 @@ int CbcNode::chooseBranch(CbcModel *model, CbcNode *lastNode, int numberPassesLe
         choice[i].possibleBranch = NULL;
       numberStrong = 0;
       bool canDoOneHot = false;
-      for (i = 0; i < numberObjects; i++) {
+      /* Integers which are integral would give zero infeasibility (as in
+         feasibleSolution) so only fractional ones and other objects need
+         be asked - not if hot start or switching variables.  Objects need
+         not be in order of integerVariable() so go by column.  Priority
+         -999 ones say integral values are infeasible so are always asked */
+      int *scanList = NULL;
+      int numberToScan = numberObjects;
+      if (!hotstartSolution && (model->moreSpecialOptions2() & 4) == 0) {
+        int numberIntegers = model->numberIntegers();
+        const int *integerVariable = model->integerVariable();
+        scanList = new int[CoinMax(numberObjects, numberIntegers)];
+        int numberFractional = model->scanIntegers(usefulInfo.solution_, usefulInfo.lower_,
+          usefulInfo.upper_, usefulInfo.integerTolerance_, scanList);
+        int numberColumns = solver->getNumCols();
+        char *fractional = new char[numberColumns];
+        memset(fractional, 0, numberColumns);
+        for (int j = 0; j < numberFractional; j++)
+          fractional[integerVariable[scanList[j]]] = 1;
+        numberToScan = 0;
+        for (int j = 0; j < numberObjects; j++) {
+          const CbcSimpleInteger *thisOne = dynamic_cast< const CbcSimpleInteger * >(model->object(j));
+          if (!thisOne || thisOne->priority() == -999
+            || fractional[thisOne->columnNumber()])
+            scanList[numberToScan++] = j;
+        }
+        delete[] fractional;
+      }
+      // let large objects see which columns changed since last pass
+      CbcSolutionChanges *solutionChanges = model->solutionChanges();
+      if (solutionChanges)
+        solutionChanges->mark(solver->getNumCols(), usefulInfo.solution_,
+          usefulInfo.lower_, usefulInfo.upper_);
+      for (int iScan = 0; iScan < numberToScan; iScan++) {
+        i = scanList ? scanList[iScan] : iScan;
         OsiObject *object = model->modifiableObject(i);
         int preferredWay;
         double infeasibility = object->infeasibility(&usefulInfo, preferredWay);
@@ -803,6 +966,9 @@ int CbcNode::chooseBranch(CbcModel *model, CbcNode *lastNode, int numberPassesLe
           }
         }
       }
+      delete[] scanList;
+      if (solutionChanges)
+        solutionChanges->clear();
       if (!canDoOneHot && hotstartSolution) {
         // switch off as not possible
         hotstartSolution = NULL;
@@ -1001,7 +1167,8 @@ int CbcNode::chooseBranch(CbcModel *model, CbcNode *lastNode, int numberPassesLe
         // User may want to clean up before strong branching
         if ((clp->specialOptions() & 32) != 0) {
           clp->primal(1);
-          if (clp->numberIterations())
+          if (clp->numberIterations()
+            && CbcMessageWanted(model->messageHandler(), *model->messagesPointer(), CBC_ITERATE_STRONG))
             model->messageHandler()->message(CBC_ITERATE_STRONG, *model->messagesPointer())
               << clp->numberIterations()
               << CoinMessageEol;
@@ -1510,12 +1677,13 @@ int CbcNode::chooseBranch(CbcModel *model, CbcNode *lastNode, int numberPassesLe
         CbcBranchingObject **objects = new CbcBranchingObject *[numberStrong];
         for (i = 0; i < numberStrong; i++) {
           int iColumn = choice[i].possibleBranch->variable();
-          model->messageHandler()->message(CBC_STRONG, *model->messagesPointer())
-            << i << iColumn
-            << choice[i].downMovement << choice[i].numIntInfeasDown
-            << choice[i].upMovement << choice[i].numIntInfeasUp
-            << choice[i].possibleBranch->value()
-            << CoinMessageEol;
+          if (CbcMessageWanted(model->messageHandler(), *model->messagesPointer(), CBC_STRONG))
+            model->messageHandler()->message(CBC_STRONG, *model->messagesPointer())
+              << i << iColumn
+              << choice[i].downMovement << choice[i].numIntInfeasDown
+              << choice[i].upMovement << choice[i].numIntInfeasUp
+              << choice[i].possibleBranch->value()
+              << CoinMessageEol;
           changeUp[i] = choice[i].upMovement;
           numberInfeasibilitiesUp[i] = choice[i].numIntInfeasUp;
           changeDown[i] = choice[i].downMovement;
@@ -1585,6 +1753,173 @@ int CbcNode::chooseBranch(CbcModel *model, CbcNode *lastNode, int numberPassesLe
   return anyAction;
 }
 
+/*
+  Strong branching results worked out before the main loop of
+  chooseDynamicBranch - either on threads or by one call to Clp.
+*/
+typedef struct {
+  int iColumn;
+  double value;
+  double objective[2]; // down, up
+  int status[2]; // 0 optimal, 1 infeasible, 2 unfinished
+  int iterations[2];
+  int unsatisfied[2];
+} CbcStrongResult;
+/* Result can be used as it stands if both ways finished below cutoff and
+   neither gave a solution (anything else is redone in usual way) */
+static bool goodStrongResult(const CbcStrongResult &result, double cutoff)
+{
+  for (int way = 0; way < 2; way++) {
+    if (result.status[way] || result.objective[way] >= cutoff || !result.unsatisfied[way])
+      return false;
+  }
+  return true;
+}
+// Number of integer variables not satisfied by solution
+static int numberUnsatisfiedIntegers(const double *solution,
+  const int *integerVariable, int numberIntegers, double integerTolerance)
+{
+  int unsatisfied = 0;
+  for (int j = 0; j < numberIntegers; j++) {
+    double value = solution[integerVariable[j]];
+    if (fabs(value - floor(value + 0.5)) > integerTolerance)
+      unsatisfied++;
+  }
+  return unsatisfied;
+}
+#ifdef CBC_THREAD
+/*
+  Parallel strong branching (moreSpecialOptions2 bit 29).  Candidates are
+  split in order into blocks, one per thread, and every block is solved
+  on a clone of the solver from the same hot start, so results do not
+  depend on timing.
+*/
+typedef struct {
+  OsiSolverInterface *solver;
+  CbcStrongResult *result;
+  const int *integerVariable;
+  int numberIntegers;
+  double integerTolerance;
+  int first;
+  int last;
+} CbcParallelStrongBundle;
+static void *doStrongThread(void *voidInfo)
+{
+  CbcParallelStrongBundle *bundle = reinterpret_cast< CbcParallelStrongBundle * >(voidInfo);
+  OsiSolverInterface *solver = bundle->solver;
+  solver->markHotStart();
+  for (int i = bundle->first; i < bundle->last; i++) {
+    CbcStrongResult &result = bundle->result[i];
+    int iColumn = result.iColumn;
+    double saveLower = solver->getColLower()[iColumn];
+    double saveUpper = solver->getColUpper()[iColumn];
+    for (int way = 0; way < 2; way++) {
+      if (!way)
+        solver->setColUpper(iColumn, floor(result.value));
+      else
+        solver->setColLower(iColumn, ceil(result.value));
+      solver->solveFromHotStart();
+      if (solver->isProvenOptimal())
+        result.status[way] = 0;
+      else if (solver->isIterationLimitReached()
+        && !solver->isDualObjectiveLimitReached())
+        result.status[way] = 2;
+      else
+        result.status[way] = 1;
+      result.objective[way] = solver->getObjSense() * solver->getObjValue();
+      result.iterations[way] = solver->getIterationCount();
+      int unsatisfied = 0;
+      if (result.status[way] != 1)
+        unsatisfied = numberUnsatisfiedIntegers(solver->getColSolution(),
+          bundle->integerVariable, bundle->numberIntegers, bundle->integerTolerance);
+      result.unsatisfied[way] = unsatisfied;
+      solver->setColLower(iColumn, saveLower);
+      solver->setColUpper(iColumn, saveUpper);
+    }
+  }
+  solver->unmarkHotStart();
+  return NULL;
+}
+#endif
+#ifdef CBC_HAS_CLP
+/*
+  Batched strong branching (CbcModel::CbcBatchStrongBranching).  All
+  candidates are done by one call to ClpSimplex::strongBranching so
+  factorization and other set up is shared rather than redone for each
+  solveFromHotStart.  Returns false if Clp could not do it (then
+  everything is done in usual way).
+*/
+static bool batchStrongBranching(OsiClpSolverInterface *osiclp,
+  CbcStrongResult *result, int numberStrong, int maximumIterations,
+  double objectiveValue, const int *integerVariable, int numberIntegers,
+  double integerTolerance)
+{
+  ClpSimplex *clp = osiclp->getModelPtr();
+  int numberColumns = clp->numberColumns();
+  double *newLower = new double[2 * numberStrong];
+  double *newUpper = newLower + numberStrong;
+  double **outputSolution = new double *[2 * numberStrong];
+  int *outputStuff = new int[4 * numberStrong];
+  int *which = new int[numberStrong];
+  for (int i = 0; i < numberStrong; i++) {
+    which[i] = result[i].iColumn;
+    newLower[i] = ceil(result[i].value);
+    newUpper[i] = floor(result[i].value);
+    outputSolution[2 * i] = new double[numberColumns];
+    outputSolution[2 * i + 1] = new double[numberColumns];
+  }
+  // as in chooseBranch
+  int specialOptions = osiclp->specialOptions();
+  int clpOptions = clp->specialOptions();
+  int saveLogLevel = clp->logLevel();
+  int saveMaxIts = clp->maximumIterations();
+  int startFinishOptions;
+  clp->setLogLevel(0);
+  if ((specialOptions & 1) == 0) {
+    startFinishOptions = 0;
+    clp->setSpecialOptions(clpOptions | (64 | 1024));
+  } else {
+    startFinishOptions = 1 + 2 + 4;
+    if ((specialOptions & 4) == 0)
+      clp->setSpecialOptions(clpOptions | (64 | 128 | 512 | 1024 | 4096));
+    else
+      clp->setSpecialOptions(clpOptions | (64 | 128 | 512 | 1024 | 2048 | 4096));
+  }
+  clp->setMaximumIterations(maximumIterations);
+  int returnCode = clp->strongBranching(numberStrong, which,
+    newLower, newUpper, outputSolution,
+    outputStuff, outputStuff + 2 * numberStrong, false, false,
+    startFinishOptions);
+  clp->setSpecialOptions(clpOptions); // restore
+  clp->setMaximumIterations(saveMaxIts);
+  clp->setLogLevel(saveLogLevel);
+  if (returnCode != -2) {
+    for (int i = 0; i < numberStrong; i++) {
+      for (int way = 0; way < 2; way++) {
+        int iStatus = outputStuff[2 * i + way];
+        if (iStatus != 0 && iStatus != 1)
+          iStatus = 2;
+        result[i].status[way] = iStatus;
+        // changes in objective come back in bounds
+        result[i].objective[way] = objectiveValue + (way ? newLower[i] : newUpper[i]);
+        result[i].iterations[way] = outputStuff[2 * numberStrong + 2 * i + way];
+        int unsatisfied = 0;
+        if (iStatus != 1)
+          unsatisfied = numberUnsatisfiedIntegers(outputSolution[2 * i + way],
+            integerVariable, numberIntegers, integerTolerance);
+        result[i].unsatisfied[way] = unsatisfied;
+      }
+    }
+  }
+  for (int i = 0; i < 2 * numberStrong; i++)
+    delete[] outputSolution[i];
+  delete[] outputSolution;
+  delete[] outputStuff;
+  delete[] which;
+  delete[] newLower;
+  return returnCode != -2;
+}
+#endif
 /*
   Version for dynamic pseudo costs.
 
@@ -2102,10 +2437,28 @@ int CbcNode::chooseDynamicBranch(CbcModel *model, CbcNode *lastNode,
             */
       int problemType = model->problemType();
       bool canDoOneHot = false;
+      // infeasibilities of simple integers in one go if wanted
+      const double *batchInfeasibility = NULL;
+      const double *batchDownEstimate = NULL;
+      const double *batchUpEstimate = NULL;
+      if (!hotstartSolution) {
+        CbcPseudoCostArrays *pseudoCostArrays = model->pseudoCostArrays();
+        if (pseudoCostArrays) {
+          batchInfeasibility = pseudoCostArrays->infeasibilities(model);
+          batchDownEstimate = pseudoCostArrays->downEstimates();
+          batchUpEstimate = pseudoCostArrays->upEstimates();
+        }
+      }
       for (i = 0; i < numberObjects; i++) {
+        if (batchInfeasibility && !batchInfeasibility[i]) {
+          // for debug
+          downEstimate[i] = -1.0;
+          upEstimate[i] = -1.0;
+          continue;
+        }
         OsiObject *object = model->modifiableObject(i);
         CbcSimpleIntegerDynamicPseudoCost *dynamicObject = dynamic_cast< CbcSimpleIntegerDynamicPseudoCost * >(object);
-        double infeasibility = object->checkInfeasibility(&usefulInfo);
+        double infeasibility = (batchInfeasibility && batchInfeasibility[i] > 0.0) ? batchInfeasibility[i] : object->checkInfeasibility(&usefulInfo);
         int priorityLevel = object->priority();
         if (hotstartSolution) {
           // we are doing hot start
@@ -2145,9 +2498,19 @@ int CbcNode::chooseDynamicBranch(CbcModel *model, CbcNode *lastNode,
           int numberThisDown = 0;
           bool gotUp = false;
           int numberThisUp = 0;
-          double downGuess = object->downEstimate();
-          double upGuess = object->upEstimate();
+          double downGuess;
+          double upGuess;
+          if (batchInfeasibility && batchInfeasibility[i] > 0.0) {
+            // worked out with infeasibility
+            downGuess = batchDownEstimate[i];
+            upGuess = batchUpEstimate[i];
+          } else {
+            downGuess = object->downEstimate();
+            upGuess = object->upEstimate();
+          }
           if (dynamicObject) {
+            // another thread may have found out about this object
+            model->refreshSharedPseudoCosts(i);
             // Use this object's numberBeforeTrust
             int numberBeforeTrustThis = dynamicObject->numberBeforeTrust();
             iColumn = dynamicObject->columnNumber();
@@ -2490,6 +2853,12 @@ int CbcNode::chooseDynamicBranch(CbcModel *model, CbcNode *lastNode,
     solver->getIntParam(OsiMaxNumIterationHotStart, saveLimit);
     if (!numberPassesLeft)
       skipAll = 1;
+    // decision may choose without solving any extra LPs
+    int chosenWay = 0;
+    int chosen = decision->chooseWithoutLookahead(model, whichObject, numberToDo,
+      downEstimate, upEstimate, chosenWay);
+    if (chosen >= 0)
+      skipAll = 1;
     if (!skipAll) {
       ws = solver->getWarmStart();
       int limit = 100;
@@ -2499,19 +2868,37 @@ int CbcNode::chooseDynamicBranch(CbcModel *model, CbcNode *lastNode,
     // Say which one will be best
     int whichChoice = 0;
     int bestChoice;
+    /*
+      Reliability branching lookahead.  Best product of down and up
+      changes so far is kept.  Once down is solved to optimality the score
+      of a candidate can be no more than down change times distance to
+      cutoff - if that is not better than best, up is not solved.
+    */
+    int numberLookahead = model->getIntParam(CbcModel::CbcStrongLookahead);
+    /* if set hot start is not redone when strong branching fixes a variable -
+       fix is just a bound change for later candidates and one resolve at end */
+    bool keepHotStart = model->getIntParam(CbcModel::CbcKeepHotStart) != 0;
+    // candidates and iterations may be scaled by depth
+    CbcStrongBudget *strongBudget = model->strongBudget();
+    double strongStartTime = strongBudget ? model->getCurrentSeconds() : 0.0;
+    double bestScore = 0.0;
     if (iBestGot >= 0)
       bestChoice = iBestGot;
     else
       bestChoice = iBestNot;
     assert(bestChoice >= 0);
+    if (chosen >= 0)
+      bestChoice = chosen;
     // If we have hit max time don't do strong branching
     bool hitMaxTime = (model->getCurrentSeconds() > model->getDblParam(CbcModel::CbcMaximumSeconds));
     // also give up if we are looping round too much
-    if (hitMaxTime || numberPassesLeft <= 0 || useShadow == 2) {
+    if (chosen >= 0 || hitMaxTime || numberPassesLeft <= 0 || useShadow == 2) {
       int iObject = whichObject[bestChoice];
       OsiObject *object = model->modifiableObject(iObject);
       int preferredWay;
       object->infeasibility(&usefulInfo, preferredWay);
+      if (chosenWay)
+        preferredWay = chosenWay;
       CbcObject *obj = dynamic_cast< CbcObject * >(object);
       assert(obj);
       branch_ = obj->createCbcBranch(solver, &usefulInfo, preferredWay);
@@ -2749,6 +3136,11 @@ int CbcNode::chooseDynamicBranch(CbcModel *model, CbcNode *lastNode,
       if (searchStrategy == 2)
         numberToDo = CoinMin(numberToDo, 20);
       iDo = 0;
+      if (strongBudget && !skipAll) {
+        int limit;
+        solver->getIntParam(OsiMaxNumIterationHotStart, limit);
+        solver->setIntParam(OsiMaxNumIterationHotStart, strongBudget->iterationLimit(depth_, limit));
+      }
       int saveLimit2;
       solver->getIntParam(OsiMaxNumIterationHotStart, saveLimit2);
       int numberTest = numberNotTrusted > 0 ? numberStrong : (numberStrong + 1) / 2;
@@ -2863,6 +3255,8 @@ int CbcNode::chooseDynamicBranch(CbcModel *model, CbcNode *lastNode,
         }
       }
 #endif
+      if (strongBudget && !strongType)
+        numberTest = strongBudget->numberCandidates(depth_, numberTest);
 #ifdef CBC_HAS_NAUTY
       const int *orbits = NULL;
 #endif
@@ -2998,7 +3392,104 @@ int CbcNode::chooseDynamicBranch(CbcModel *model, CbcNode *lastNode,
 	//	 iDo,numberBoth);
       }
 #endif
+      /* Strong branch first candidates in one go - near root in parallel
+         or if wanted by Clp in one batch */
+      CbcStrongResult *strongResult = NULL;
+      int *strongIndex = NULL;
+      int numberParallelThreads = 0;
+      int numberBatch = 0;
+#ifdef CBC_THREAD
+      if (depth_ < 5 && (model->moreSpecialOptions2() & 536870912) != 0
+        && !model->master() && !model->masterThread())
+        numberParallelThreads = model->getNumberThreads();
+#endif
+#ifdef CBC_HAS_CLP
+      if (numberParallelThreads <= 1 && osiclp)
+        numberBatch = model->getIntParam(CbcModel::CbcBatchStrongBranching);
+#endif
+#ifdef CBC_HAS_NAUTY
+      if (orbits || model->rootSymmetryInfo()) {
+        numberParallelThreads = 0; // down branch may fix more
+        numberBatch = 0;
+      }
+#endif
+      if ((numberParallelThreads > 1 || numberBatch > 0) && numberTest > 1 && !skipAll
+        && solver->isProvenOptimal()) {
+        strongIndex = new int[numberToDo];
+        strongResult = new CbcStrongResult[numberToDo];
+        int maximumStrong = numberTest;
+        if (numberParallelThreads <= 1)
+          maximumStrong = CoinMin(numberTest, numberBatch);
+        int numberStrongResults = 0;
+        for (int jDo = 0; jDo < numberToDo; jDo++) {
+          strongIndex[jDo] = -1;
+          if (numberStrongResults == maximumStrong)
+            continue;
+          CbcSimpleIntegerDynamicPseudoCost *dynamicObject = dynamic_cast< CbcSimpleIntegerDynamicPseudoCost * >(model->modifiableObject(whichObject[jDo]));
+          if (!dynamicObject)
+            continue;
+          int iColumn = dynamicObject->columnNumber();
+          double value = saveSolution[iColumn];
+          if (fabs(value - floor(value + 0.5)) <= integerTolerance)
+            continue;
+          // as fillStrongInfo - trusted ones will not be strong branched
+          if (!strongType
+            && dynamicObject->numberTimesUp() >= dynamicObject->numberBeforeTrust() + 2 * dynamicObject->numberTimesUpInfeasible()
+            && dynamicObject->numberTimesDown() >= dynamicObject->numberBeforeTrust() + 2 * dynamicObject->numberTimesDownInfeasible())
+            continue;
+          strongIndex[jDo] = numberStrongResults;
+          strongResult[numberStrongResults].iColumn = iColumn;
+          strongResult[numberStrongResults++].value = value;
+        }
+        int maxHotIterations;
+        solver->getIntParam(OsiMaxNumIterationHotStart, maxHotIterations);
+        if (searchStrategy == 2)
+          maxHotIterations = 10;
+        bool done = false;
+        if (numberStrongResults > 1) {
+#ifdef CBC_THREAD
+          if (numberParallelThreads > 1) {
+            int numberBundles = CoinMin(numberParallelThreads, numberStrongResults);
+            CbcParallelStrongBundle *bundle = new CbcParallelStrongBundle[numberBundles];
+            for (int i = 0; i < numberBundles; i++) {
+              bundle[i].solver = solver->clone();
+              bundle[i].solver->setIntParam(OsiMaxNumIterationHotStart, maxHotIterations);
+              bundle[i].result = strongResult;
+              bundle[i].integerVariable = model->integerVariable();
+              bundle[i].numberIntegers = model->numberIntegers();
+              bundle[i].integerTolerance = integerTolerance;
+              bundle[i].first = (i * numberStrongResults) / numberBundles;
+              bundle[i].last = ((i + 1) * numberStrongResults) / numberBundles;
+            }
+            model->threadPool(numberBundles)->run(doStrongThread, numberBundles, bundle, static_cast< int >(sizeof(CbcParallelStrongBundle)));
+            for (int i = 0; i < numberBundles; i++)
+              delete bundle[i].solver;
+            delete[] bundle;
+            done = true;
+          }
+#endif
+#ifdef CBC_HAS_CLP
+          if (!done && numberBatch > 0)
+            done = batchStrongBranching(osiclp, strongResult, numberStrongResults,
+              maxHotIterations, objectiveValue_, model->integerVariable(),
+              model->numberIntegers(), integerTolerance);
+#endif
+        }
+        if (!done) {
+          delete[] strongResult;
+          strongResult = NULL;
+          delete[] strongIndex;
+          strongIndex = NULL;
+        }
+      }
+      // results of siblings (if bounds on their support unchanged)
+      CbcStrongCache *strongCache = (lastNode && lastNode->nodeInfo()) ? lastNode->nodeInfo()->strongCache() : NULL;
+      if (strongCache && !strongCache->active())
+        strongCache = NULL;
       for (iDo = 0; iDo < numberToDo; iDo++) {
+        // another thread may have found a better solution
+        if (model->refreshPublishedCutoff())
+          cutoff = model->getCutoff();
         int iObject = whichObject[iDo];
         OsiObject *object = model->modifiableObject(iObject);
         CbcSimpleIntegerDynamicPseudoCost *dynamicObject = dynamic_cast< CbcSimpleIntegerDynamicPseudoCost * >(object);
@@ -3007,6 +3498,10 @@ int CbcNode::chooseDynamicBranch(CbcModel *model, CbcNode *lastNode,
         double infeasibility = object->infeasibility(&usefulInfo, preferredWay);
         bool feasibleSolution = false;
         double predictedChange = 0.0;
+        // set if up not solved as candidate can not beat best
+        bool stopEarly = false;
+        // set if result came from strong branching at sibling
+        bool fromCache = false;
         // may have become feasible
         if (!infeasibility) {
           if (strongType != 2 || solver->getColLower()[iColumn] == solver->getColUpper()[iColumn])
@@ -3078,7 +3573,43 @@ int CbcNode::chooseDynamicBranch(CbcModel *model, CbcNode *lastNode,
             xMark++;
           }
         }
-        if (!canSkip) {
+        if (!canSkip && strongResult && strongIndex[iDo] >= 0
+          && goodStrongResult(strongResult[strongIndex[iDo]], cutoff)) {
+          // both ways already solved (on another thread or in batch)
+          const CbcStrongResult &result = strongResult[strongIndex[iDo]];
+          assert(dynamicObject && result.iColumn == iColumn);
+          numberTest--;
+          numberStrongDone += 2;
+          numberStrongIterations += result.iterations[0] + result.iterations[1];
+          choice.finishedDown = true;
+          choice.downMovement = CoinMax(result.objective[0] - objectiveValue_, 0.0);
+          choice.numItersDown = result.iterations[0];
+          choice.numIntInfeasDown = result.unsatisfied[0];
+          choice.numObjInfeasDown = result.unsatisfied[0];
+          choice.finishedUp = true;
+          choice.upMovement = CoinMax(result.objective[1] - objectiveValue_, 0.0);
+          choice.numItersUp = result.iterations[1];
+          choice.numIntInfeasUp = result.unsatisfied[1];
+          choice.numObjInfeasUp = result.unsatisfied[1];
+          // Update branching information as createUpdateInformation
+          for (int way = 0; way < 2; way++) {
+            CbcObjectUpdateData update(dynamicObject, way ? 1 : -1,
+              way ? choice.upMovement : choice.downMovement, 0,
+              numberUnsatisfied_ - result.unsatisfied[way], result.value);
+            update.originalObjective_ = objectiveValue_;
+            update.cutoff_ = cutoff;
+            update.objectNumber_ = iObject;
+            model->addUpdateInformation(update);
+          }
+        } else if (!canSkip && strongCache && dynamicObject
+          && strongCache->find(iColumn, choice.downMovement, choice.upMovement)) {
+          // solved both ways at sibling - pseudocosts were updated then
+          fromCache = true;
+          choice.finishedDown = true;
+          choice.numItersDown = 0;
+          choice.finishedUp = true;
+          choice.numItersUp = 0;
+        } else if (!canSkip) {
           numberTest--;
           // just do a few
           if (searchStrategy == 2)
@@ -3198,6 +3729,10 @@ int CbcNode::chooseDynamicBranch(CbcModel *model, CbcNode *lastNode,
               }
             }
 #endif
+#endif
+#ifndef CONFLICT_CUTS
+            if ((model->moreSpecialOptions() & 4194304) != 0)
+              model->analyzeConflict(solver);
 #endif
           }
           // say infeasible if branch says so
@@ -3353,8 +3888,16 @@ int CbcNode::chooseDynamicBranch(CbcModel *model, CbcNode *lastNode,
                                choice.numObjInfeasDown);
 #endif
 
-          // repeat the whole exercise, forcing the variable up
-          predictedChange = choice.possibleBranch->branch();
+          // can candidate still beat best?
+          if (numberLookahead && choice.finishedDown && choice.downMovement < 1.0e100
+            && cutoff < 1.0e50 && bestScore > 0.0) {
+            double maxScore = CoinMax(choice.downMovement, 1.0e-6)
+              * CoinMax(cutoff - objectiveValue_, 1.0e-6);
+            stopEarly = (maxScore <= bestScore);
+          }
+          if (!stopEarly) {
+            // repeat the whole exercise, forcing the variable up
+            predictedChange = choice.possibleBranch->branch();
 #ifdef CBC_HAS_NAUTY
 	  if (model->rootSymmetryInfo() && false) {
 	    if (iColumn<numberColumns) {
@@ -3366,213 +3909,194 @@ int CbcNode::chooseDynamicBranch(CbcModel *model, CbcNode *lastNode,
 	    }
 	  }
 #endif
-          solver->solveFromHotStart();
+            solver->solveFromHotStart();
 #ifdef CBC_HAS_CLP
-          if (osiclp && goToEndInStrongBranching) {
-            osiclp->setIntParam(OsiMaxNumIterationHotStart, saveMaxHotIts);
-            osiclp->setSpecialOptions(saveOsiClpOptions);
-          }
+            if (osiclp && goToEndInStrongBranching) {
+              osiclp->setIntParam(OsiMaxNumIterationHotStart, saveMaxHotIts);
+              osiclp->setSpecialOptions(saveOsiClpOptions);
+            }
 #endif
-          if ((model->moreSpecialOptions2() & 32768) != 0 && solver->isProvenOptimal()) {
-            // If any small values re-do
-            model->cleanBounds(solver, cleanVariables);
-          }
-          numberStrongDone++;
-          numberStrongIterations += solver->getIterationCount();
-          /*
-                      We now have an estimate of objective degradation that we can use for strong
-                      branching. If we're over the cutoff, the variable is monotone up.
-                      If we actually made it to optimality, check for a solution, and if we have
-                      a good one, call setBestSolution to process it. Note that this may reduce the
-                      cutoff, so we check again to see if we can declare this variable monotone.
-                    */
-          if (solver->isProvenOptimal())
-            iStatus = 0; // optimal
-          else if (solver->isIterationLimitReached()
-            && !solver->isDualObjectiveLimitReached()) {
-            iStatus = 2; // unknown
-          } else {
-            iStatus = 1; // infeasible
+            if ((model->moreSpecialOptions2() & 32768) != 0 && solver->isProvenOptimal()) {
+              // If any small values re-do
+              model->cleanBounds(solver, cleanVariables);
+            }
+            numberStrongDone++;
+            numberStrongIterations += solver->getIterationCount();
+            /*
+                        We now have an estimate of objective degradation that we can use for strong
+                        branching. If we're over the cutoff, the variable is monotone up.
+                        If we actually made it to optimality, check for a solution, and if we have
+                        a good one, call setBestSolution to process it. Note that this may reduce the
+                        cutoff, so we check again to see if we can declare this variable monotone.
+                      */
+            if (solver->isProvenOptimal())
+              iStatus = 0; // optimal
+            else if (solver->isIterationLimitReached()
+              && !solver->isDualObjectiveLimitReached()) {
+              iStatus = 2; // unknown
+            } else {
+              iStatus = 1; // infeasible
 #ifdef CONFLICT_CUTS
 #ifdef CBC_HAS_CLP
-            if (osiclp && (model->moreSpecialOptions() & 4194304) != 0) {
-              const CbcFullNodeInfo *topOfTree = model->topOfTree();
-              if (topOfTree) {
+              if (osiclp && (model->moreSpecialOptions() & 4194304) != 0) {
+                const CbcFullNodeInfo *topOfTree = model->topOfTree();
+                if (topOfTree) {
 #if CONFLICT_CUTS == 2
-                OsiRowCut *cut = osiclp->smallModelCut(topOfTree->lower(),
-                  topOfTree->upper(),
-                  model->numberRowsAtContinuous(),
-                  model->whichGenerator());
+                  OsiRowCut *cut = osiclp->smallModelCut(topOfTree->lower(),
+                    topOfTree->upper(),
+                    model->numberRowsAtContinuous(),
+                    model->whichGenerator());
 #else
-                OsiRowCut *cut = osiclp->modelCut(topOfTree->lower(),
-                  topOfTree->upper(),
-                  model->numberRowsAtContinuous(),
-                  model->whichGenerator(), 0);
-#endif
-                if (cut) {
-                  //printf("XXXXXX found conflict cut in strong branching\n");
-                  //cut->print();
-                  if ((model->specialOptions() & 1) != 0) {
-                    const OsiRowCutDebugger *debugger = model->continuousSolver()->getRowCutDebugger();
-                    if (debugger) {
-                      if (debugger->invalidCut(*cut)) {
-                        model->continuousSolver()->applyRowCuts(1, cut);
-                        model->continuousSolver()->writeMps("bad");
+                  OsiRowCut *cut = osiclp->modelCut(topOfTree->lower(),
+                    topOfTree->upper(),
+                    model->numberRowsAtContinuous(),
+                    model->whichGenerator(), 0);
+#endif
+                  if (cut) {
+                    //printf("XXXXXX found conflict cut in strong branching\n");
+                    //cut->print();
+                    if ((model->specialOptions() & 1) != 0) {
+                      const OsiRowCutDebugger *debugger = model->continuousSolver()->getRowCutDebugger();
+                      if (debugger) {
+                        if (debugger->invalidCut(*cut)) {
+                          model->continuousSolver()->applyRowCuts(1, cut);
+                          model->continuousSolver()->writeMps("bad");
+                        }
+                        CoinAssert(!debugger->invalidCut(*cut));
                       }
-                      CoinAssert(!debugger->invalidCut(*cut));
                     }
+                    model->makeGlobalCut(cut);
                   }
-                  model->makeGlobalCut(cut);
                 }
               }
-            }
 #endif
 #endif
-          }
-          // say infeasible if branch says so
-          if (predictedChange == COIN_DBL_MAX)
-            iStatus = 1;
-          if (iStatus != 2 && solver->getIterationCount() > realMaxHotIterations)
-            numberUnfinished++;
-          newObjectiveValue = solver->getObjSense() * solver->getObjValue();
-          choice.numItersUp = solver->getIterationCount();
-          objectiveChange = CoinMax(newObjectiveValue - objectiveValue_, 0.0);
-          // Update branching information if wanted
-          cbcobj = dynamic_cast< CbcBranchingObject * >(choice.possibleBranch);
-          if (cbcobj) {
-            CbcObject *object = cbcobj->object();
-            assert(object);
-            CbcObjectUpdateData update = object->createUpdateInformation(solver, this, cbcobj);
-            update.objectNumber_ = choice.objectNumber;
-            model->addUpdateInformation(update);
-          } else {
-            decision->updateInformation(solver, this);
-          }
-          if (!iStatus) {
-            choice.finishedUp = true;
-            if (newObjectiveValue >= cutoff) {
-              objectiveChange = 1.0e100; // say infeasible
-              numberStrongInfeasible++;
+#ifndef CONFLICT_CUTS
+              if ((model->moreSpecialOptions() & 4194304) != 0)
+                model->analyzeConflict(solver);
+#endif
+            }
+            // say infeasible if branch says so
+            if (predictedChange == COIN_DBL_MAX)
+              iStatus = 1;
+            if (iStatus != 2 && solver->getIterationCount() > realMaxHotIterations)
+              numberUnfinished++;
+            newObjectiveValue = solver->getObjSense() * solver->getObjValue();
+            choice.numItersUp = solver->getIterationCount();
+            objectiveChange = CoinMax(newObjectiveValue - objectiveValue_, 0.0);
+            // Update branching information if wanted
+            cbcobj = dynamic_cast< CbcBranchingObject * >(choice.possibleBranch);
+            if (cbcobj) {
+              CbcObject *object = cbcobj->object();
+              assert(object);
+              CbcObjectUpdateData update = object->createUpdateInformation(solver, this, cbcobj);
+              update.objectNumber_ = choice.objectNumber;
+              model->addUpdateInformation(update);
             } else {
+              decision->updateInformation(solver, this);
+            }
+            if (!iStatus) {
+              choice.finishedUp = true;
+              if (newObjectiveValue >= cutoff) {
+                objectiveChange = 1.0e100; // say infeasible
+                numberStrongInfeasible++;
+              } else {
 #ifdef CBCNODE_TIGHTEN_BOUNDS
-              // Can we tighten bounds?
-              if (iColumn < numberColumns && cutoff < 1.0e20
-                && objectiveChange > 1.0e-5) {
-                double value = saveSolution[iColumn];
-                double up = ceil(value + integerTolerance) - value;
-                double changePer = objectiveChange / (up + 1.0e-7);
-                double distance = (cutoff - objectiveValue_) / changePer;
-                distance += 1.0e-3;
-                if (distance < 5.0) {
-                  double newUpper = floor(value + distance);
-                  if (newUpper < saveUpper[iColumn]) {
-                    //printf("Could decrease upper bound on %d from %g to %g\n",
-                    //   iColumn,saveUpper[iColumn],newUpper);
-                    saveUpper[iColumn] = newUpper;
-                    solver->setColUpper(iColumn, newUpper);
+                // Can we tighten bounds?
+                if (iColumn < numberColumns && cutoff < 1.0e20
+                  && objectiveChange > 1.0e-5) {
+                  double value = saveSolution[iColumn];
+                  double up = ceil(value + integerTolerance) - value;
+                  double changePer = objectiveChange / (up + 1.0e-7);
+                  double distance = (cutoff - objectiveValue_) / changePer;
+                  distance += 1.0e-3;
+                  if (distance < 5.0) {
+                    double newUpper = floor(value + distance);
+                    if (newUpper < saveUpper[iColumn]) {
+                      //printf("Could decrease upper bound on %d from %g to %g\n",
+                      //   iColumn,saveUpper[iColumn],newUpper);
+                      saveUpper[iColumn] = newUpper;
+                      solver->setColUpper(iColumn, newUpper);
+                    }
                   }
                 }
-              }
 #endif
-              // See if integer solution
-              feasibleSolution = model->feasibleSolution(choice.numIntInfeasUp,
-                choice.numObjInfeasUp);
+                // See if integer solution
+                feasibleSolution = model->feasibleSolution(choice.numIntInfeasUp,
+                  choice.numObjInfeasUp);
 	      // Check no odd cuts
 	      if (feasibleSolution)
 		feasibleSolution = model->reallyValid();
-              if (feasibleSolution
-                && model->problemFeasibility()->feasible(model, -1) >= 0) {
+                if (feasibleSolution
+                  && model->problemFeasibility()->feasible(model, -1) >= 0) {
 #ifdef BONMIN
-                std::cout << "Node has become integer feasible" << std::endl;
-                numberUnsatisfied_ = 0;
-                break;
+                  std::cout << "Node has become integer feasible" << std::endl;
+                  numberUnsatisfied_ = 0;
+                  break;
 #endif
-                if (auxiliaryInfo->solutionAddsCuts()) {
-                  needHotStartUpdate = true;
-                  solver->unmarkHotStart();
-                }
-                model->setLogLevel(saveLogLevel);
-                model->setBestSolution(CBC_STRONGSOL,
-                  newObjectiveValue,
-                  solver->getColSolution());
-                if (choice.finishedDown) {
-                  double cutoff = model->getCutoff();
-                  double downObj = objectiveValue_
-                    + choice.downMovement;
-                  if (downObj >= cutoff) {
-                    choice.downMovement = 1.0e100;
-                    numberStrongInfeasible++;
+                  if (auxiliaryInfo->solutionAddsCuts()) {
+                    needHotStartUpdate = true;
+                    solver->unmarkHotStart();
                   }
-                }
-                if (needHotStartUpdate) {
-                  model->resolve(NULL, 11, saveSolution, saveLower, saveUpper);
-#ifdef CHECK_DEBUGGER_PATH
-                  if ((model->specialOptions() & 1) != 0 && onOptimalPath) {
-                    const OsiRowCutDebugger *debugger = solver->getRowCutDebugger();
-                    if (!debugger) {
-                      printf("Strong branching up on %d went off optimal path\n", iObject);
-                      abort();
+                  model->setLogLevel(saveLogLevel);
+                  model->setBestSolution(CBC_STRONGSOL,
+                    newObjectiveValue,
+                    solver->getColSolution());
+                  if (choice.finishedDown) {
+                    double cutoff = model->getCutoff();
+                    double downObj = objectiveValue_
+                      + choice.downMovement;
+                    if (downObj >= cutoff) {
+                      choice.downMovement = 1.0e100;
+                      numberStrongInfeasible++;
                     }
                   }
+                  if (needHotStartUpdate) {
+                    model->resolve(NULL, 11, saveSolution, saveLower, saveUpper);
+#ifdef CHECK_DEBUGGER_PATH
+                    if ((model->specialOptions() & 1) != 0 && onOptimalPath) {
+                      const OsiRowCutDebugger *debugger = solver->getRowCutDebugger();
+                      if (!debugger) {
+                        printf("Strong branching up on %d went off optimal path\n", iObject);
+                        abort();
+                      }
+                    }
 #endif
-                  newObjectiveValue = solver->getObjSense() * solver->getObjValue();
-                  objectiveValue_ = CoinMax(objectiveValue_, newObjectiveValue);
-                  objectiveChange = CoinMax(newObjectiveValue - objectiveValue_, 0.0);
-                  model->feasibleSolution(choice.numIntInfeasDown,
-                    choice.numObjInfeasDown);
-                }
-                model->setLastHeuristic(NULL);
-                model->incrementUsed(solver->getColSolution());
-                cutoff = model->getCutoff();
-                if (newObjectiveValue >= cutoff) { //  *new* cutoff
-                  objectiveChange = 1.0e100;
-                  numberStrongInfeasible++;
+                    newObjectiveValue = solver->getObjSense() * solver->getObjValue();
+                    objectiveValue_ = CoinMax(objectiveValue_, newObjectiveValue);
+                    objectiveChange = CoinMax(newObjectiveValue - objectiveValue_, 0.0);
+                    model->feasibleSolution(choice.numIntInfeasDown,
+                      choice.numObjInfeasDown);
+                  }
+                  model->setLastHeuristic(NULL);
+                  model->incrementUsed(solver->getColSolution());
+                  cutoff = model->getCutoff();
+                  if (newObjectiveValue >= cutoff) { //  *new* cutoff
+                    objectiveChange = 1.0e100;
+                    numberStrongInfeasible++;
+                  }
                 }
               }
+            } else if (iStatus == 1) {
+              choice.finishedUp = true;
+              objectiveChange = COIN_DBL_MAX;
+              numberStrongInfeasible++;
+            } else {
+              // Can't say much as we did not finish
+              choice.finishedUp = false;
+              numberUnfinished++;
             }
-          } else if (iStatus == 1) {
-            choice.finishedUp = true;
-            objectiveChange = COIN_DBL_MAX;
-            numberStrongInfeasible++;
-          } else {
-            // Can't say much as we did not finish
-            choice.finishedUp = false;
-            numberUnfinished++;
-          }
-          choice.upMovement = objectiveChange;
+            choice.upMovement = objectiveChange;
 
-          // restore bounds
-          for (j = 0; j < numberColumns; j++) {
-            if (saveLower[j] != lower[j])
-              solver->setColLower(j, saveLower[j]);
-            if (saveUpper[j] != upper[j])
-              solver->setColUpper(j, saveUpper[j]);
-          }
-          if (needHotStartUpdate) {
-            needHotStartUpdate = false;
-            model->resolve(NULL, 11, saveSolution, saveLower, saveUpper);
-#ifdef CHECK_DEBUGGER_PATH
-            if ((model->specialOptions() & 1) != 0 && onOptimalPath) {
-              const OsiRowCutDebugger *debugger = solver->getRowCutDebugger();
-              if (!debugger) {
-                printf("Strong branching up on %d went off optimal path\n", iObject);
-                abort();
-              }
+            // restore bounds
+            for (j = 0; j < numberColumns; j++) {
+              if (saveLower[j] != lower[j])
+                solver->setColLower(j, saveLower[j]);
+              if (saveUpper[j] != upper[j])
+                solver->setColUpper(j, saveUpper[j]);
             }
-#endif
-            double newObjValue = solver->getObjSense() * solver->getObjValue();
-            objectiveValue_ = CoinMax(objectiveValue_, newObjValue);
-            //we may again have an integer feasible solution
-            int numberIntegerInfeasibilities;
-            int numberObjectInfeasibilities;
-            if (model->feasibleSolution(
-                  numberIntegerInfeasibilities,
-                  numberObjectInfeasibilities)) {
-              double objValue = solver->getObjValue();
-              model->setLogLevel(saveLogLevel);
-              model->setBestSolution(CBC_STRONGSOL,
-                objValue,
-                solver->getColSolution());
+            if (needHotStartUpdate) {
+              needHotStartUpdate = false;
               model->resolve(NULL, 11, saveSolution, saveLower, saveUpper);
 #ifdef CHECK_DEBUGGER_PATH
               if ((model->specialOptions() & 1) != 0 && onOptimalPath) {
@@ -3585,18 +4109,53 @@ int CbcNode::chooseDynamicBranch(CbcModel *model, CbcNode *lastNode,
 #endif
               double newObjValue = solver->getObjSense() * solver->getObjValue();
               objectiveValue_ = CoinMax(objectiveValue_, newObjValue);
-              cutoff = model->getCutoff();
-            }
-            solver->markHotStart();
+              //we may again have an integer feasible solution
+              int numberIntegerInfeasibilities;
+              int numberObjectInfeasibilities;
+              if (model->feasibleSolution(
+                    numberIntegerInfeasibilities,
+                    numberObjectInfeasibilities)) {
+                double objValue = solver->getObjValue();
+                model->setLogLevel(saveLogLevel);
+                model->setBestSolution(CBC_STRONGSOL,
+                  objValue,
+                  solver->getColSolution());
+                model->resolve(NULL, 11, saveSolution, saveLower, saveUpper);
+#ifdef CHECK_DEBUGGER_PATH
+                if ((model->specialOptions() & 1) != 0 && onOptimalPath) {
+                  const OsiRowCutDebugger *debugger = solver->getRowCutDebugger();
+                  if (!debugger) {
+                    printf("Strong branching up on %d went off optimal path\n", iObject);
+                    abort();
+                  }
+                }
+#endif
+                double newObjValue = solver->getObjSense() * solver->getObjValue();
+                objectiveValue_ = CoinMax(objectiveValue_, newObjValue);
+                cutoff = model->getCutoff();
+              }
+              solver->markHotStart();
 #ifdef RESET_BOUNDS
-            memcpy(saveLower, solver->getColLower(), solver->getNumCols() * sizeof(double));
-            memcpy(saveUpper, solver->getColUpper(), solver->getNumCols() * sizeof(double));
+              memcpy(saveLower, solver->getColLower(), solver->getNumCols() * sizeof(double));
+              memcpy(saveUpper, solver->getColUpper(), solver->getNumCols() * sizeof(double));
 #endif
-            if (!solver->isProvenOptimal()) {
-              skipAll = -2;
-              canSkip = 1;
+              if (!solver->isProvenOptimal()) {
+                skipAll = -2;
+                canSkip = 1;
+              }
+              xMark++;
             }
-            xMark++;
+          } else {
+#ifdef CBC_HAS_CLP
+            if (osiclp && goToEndInStrongBranching) {
+              osiclp->setIntParam(OsiMaxNumIterationHotStart, saveMaxHotIts);
+              osiclp->setSpecialOptions(saveOsiClpOptions);
+            }
+#endif
+            // not solved - use estimate (candidate will not be chosen)
+            choice.finishedUp = false;
+            choice.upMovement = CoinMax(upEstimate[iObject], 0.0);
+            choice.numItersUp = 0;
           }
 
 #if 0 //def DO_ALL_AT_ROOT
@@ -3619,6 +4178,13 @@ int CbcNode::chooseDynamicBranch(CbcModel *model, CbcNode *lastNode,
                   from the evaluation loop and assume the node will be reoptimised by the
                   caller.
                 */
+        if (strongBudget && !canSkip && !fromCache && !strongType) {
+          // how far out were pseudocosts
+          if (choice.finishedDown)
+            strongBudget->addPrediction(depth_, downEstimate[iObject], choice.downMovement);
+          if (choice.finishedUp && !stopEarly)
+            strongBudget->addPrediction(depth_, upEstimate[iObject], choice.upMovement);
+        }
         // reset
         choice.possibleBranch->resetNumberBranchesLeft();
         if (choice.upMovement < 1.0e100) {
@@ -3626,6 +4192,9 @@ int CbcNode::chooseDynamicBranch(CbcModel *model, CbcNode *lastNode,
             // In case solution coming in was odd
             choice.upMovement = CoinMax(0.0, choice.upMovement);
             choice.downMovement = CoinMax(0.0, choice.downMovement);
+            if (strongCache && !canSkip && !fromCache && dynamicObject
+              && choice.finishedDown && choice.finishedUp && !stopEarly)
+              strongCache->add(iColumn, choice.downMovement, choice.upMovement);
 #if ZERO_ONE == 2
             // branch on 0-1 first (temp)
             if (fabs(choice.possibleBranch->value()) < 1.0) {
@@ -3638,16 +4207,17 @@ int CbcNode::chooseDynamicBranch(CbcModel *model, CbcNode *lastNode,
               if (model->messageHandler()->logLevel() > 3)
                 printf("sort %g downest %g upest %g ", sort[iDo], downEstimate[iObject],
                   upEstimate[iObject]);
-              model->messageHandler()->message(CBC_STRONG, *model->messagesPointer())
-                << iObject << iColumn
-                << choice.downMovement << choice.numIntInfeasDown
-                << choice.upMovement << choice.numIntInfeasUp
-                << choice.possibleBranch->value()
-                << CoinMessageEol;
+              if (CbcMessageWanted(model->messageHandler(), *model->messagesPointer(), CBC_STRONG))
+                model->messageHandler()->message(CBC_STRONG, *model->messagesPointer())
+                  << iObject << iColumn
+                  << choice.downMovement << choice.numIntInfeasDown
+                  << choice.upMovement << choice.numIntInfeasUp
+                  << choice.possibleBranch->value()
+                  << CoinMessageEol;
             }
             int betterWay = 0;
             // If was feasible (extra strong branching) skip
-            if (infeasibility) {
+            if (infeasibility && !stopEarly) {
               CbcBranchingObject *branchObj = dynamic_cast< CbcBranchingObject * >(branch_);
               if (branch_)
                 assert(branchObj);
@@ -3685,6 +4255,9 @@ int CbcNode::chooseDynamicBranch(CbcModel *model, CbcNode *lastNode,
               }
               bestChoice = choice.objectNumber;
               whichChoice = iDo;
+              if (numberLookahead)
+                bestScore = CoinMax(bestScore,
+                  CoinMax(choice.downMovement, 1.0e-6) * CoinMax(choice.upMovement, 1.0e-6));
               if (numberStrong <= 1) {
                 delete ws;
                 ws = NULL;
@@ -3695,12 +4268,18 @@ int CbcNode::chooseDynamicBranch(CbcModel *model, CbcNode *lastNode,
                 delete choice.possibleBranch;
                 choice.possibleBranch = NULL;
               }
-              if (iDo >= 2 * numberStrong) {
+              if (numberLookahead) {
+                // give up after numberLookahead without improvement
+                if (iDo - whichChoice >= numberLookahead) {
+                  delete ws;
+                  ws = NULL;
+                  break;
+                }
+              } else if (iDo >= 2 * numberStrong) {
                 delete ws;
                 ws = NULL;
                 break;
-              }
-              if (!dynamicObject || dynamicObject->numberTimesUp() > 1) {
+              } else if (!dynamicObject || dynamicObject->numberTimesUp() > 1) {
                 if (iDo - whichChoice >= numberStrong) {
                   if (!choiceObject) {
                     delete choice.possibleBranch;
@@ -3724,12 +4303,13 @@ int CbcNode::chooseDynamicBranch(CbcModel *model, CbcNode *lastNode,
             // up feasible, down infeasible
             anyAction = -1;
             worstFeasible = CoinMax(worstFeasible, choice.upMovement);
-            model->messageHandler()->message(CBC_STRONG, *model->messagesPointer())
-              << iObject << iColumn
-              << choice.downMovement << choice.numIntInfeasDown
-              << choice.upMovement << choice.numIntInfeasUp
-              << choice.possibleBranch->value()
-              << CoinMessageEol;
+            if (CbcMessageWanted(model->messageHandler(), *model->messagesPointer(), CBC_STRONG))
+              model->messageHandler()->message(CBC_STRONG, *model->messagesPointer())
+                << iObject << iColumn
+                << choice.downMovement << choice.numIntInfeasDown
+                << choice.upMovement << choice.numIntInfeasUp
+                << choice.possibleBranch->value()
+                << CoinMessageEol;
             //printf("Down infeasible for choice %d sequence %d\n",i,
             // model->object(choice.objectNumber)->columnNumber());
             choice.fix = 1;
@@ -3742,44 +4322,46 @@ int CbcNode::chooseDynamicBranch(CbcModel *model, CbcNode *lastNode,
               //choiceObject = new CbcDynamicPseudoCostBranchingObject(*choiceObject);
               choice.possibleBranch = choiceObject;
             }
-            assert(doneHotStart);
-            solver->unmarkHotStart();
-            model->resolve(NULL, 11, saveSolution, saveLower, saveUpper);
+            if (!keepHotStart) {
+              assert(doneHotStart);
+              solver->unmarkHotStart();
+              model->resolve(NULL, 11, saveSolution, saveLower, saveUpper);
 #ifdef CHECK_DEBUGGER_PATH
-            if ((model->specialOptions() & 1) != 0 && onOptimalPath) {
-              const OsiRowCutDebugger *debugger = solver->getRowCutDebugger();
-              if (!debugger) {
-                printf("Strong branching down on %d went off optimal path\n", iObject);
-                abort();
+              if ((model->specialOptions() & 1) != 0 && onOptimalPath) {
+                const OsiRowCutDebugger *debugger = solver->getRowCutDebugger();
+                if (!debugger) {
+                  printf("Strong branching down on %d went off optimal path\n", iObject);
+                  abort();
+                }
               }
-            }
 #endif
-            double newObjValue = solver->getObjSense() * solver->getObjValue();
-            objectiveValue_ = CoinMax(objectiveValue_, newObjValue);
-            bool goneInfeasible = (!solver->isProvenOptimal() || solver->isDualObjectiveLimitReached());
-            solver->markHotStart();
+              double newObjValue = solver->getObjSense() * solver->getObjValue();
+              objectiveValue_ = CoinMax(objectiveValue_, newObjValue);
+              bool goneInfeasible = (!solver->isProvenOptimal() || solver->isDualObjectiveLimitReached());
+              solver->markHotStart();
 #ifdef RESET_BOUNDS
-            memcpy(saveLower, solver->getColLower(), solver->getNumCols() * sizeof(double));
-            memcpy(saveUpper, solver->getColUpper(), solver->getNumCols() * sizeof(double));
+              memcpy(saveLower, solver->getColLower(), solver->getNumCols() * sizeof(double));
+              memcpy(saveUpper, solver->getColUpper(), solver->getNumCols() * sizeof(double));
 #endif
-            if (!solver->isProvenOptimal()) {
-              skipAll = -2;
-              canSkip = 1;
-            }
-            xMark++;
-            // may be infeasible (if other way stopped on iterations)
-            if (goneInfeasible) {
-              // neither side feasible
-              anyAction = -2;
-              if (!choiceObject) {
-                delete choice.possibleBranch;
-                choice.possibleBranch = NULL;
+              if (!solver->isProvenOptimal()) {
+                skipAll = -2;
+                canSkip = 1;
+              }
+              xMark++;
+              // may be infeasible (if other way stopped on iterations)
+              if (goneInfeasible) {
+                // neither side feasible
+                anyAction = -2;
+                if (!choiceObject) {
+                  delete choice.possibleBranch;
+                  choice.possibleBranch = NULL;
+                }
+                //printf("Both infeasible for choice %d sequence %d\n",i,
+                // model->object(choice.objectNumber)->columnNumber());
+                delete ws;
+                ws = NULL;
+                break;
               }
-              //printf("Both infeasible for choice %d sequence %d\n",i,
-              // model->object(choice.objectNumber)->columnNumber());
-              delete ws;
-              ws = NULL;
-              break;
             }
 #if 0
 	    if (!depth_&&numberRestarts) {
@@ -3798,12 +4380,13 @@ int CbcNode::chooseDynamicBranch(CbcModel *model, CbcNode *lastNode,
             // down feasible, up infeasible
             anyAction = -1;
             worstFeasible = CoinMax(worstFeasible, choice.downMovement);
-            model->messageHandler()->message(CBC_STRONG, *model->messagesPointer())
-              << iObject << iColumn
-              << choice.downMovement << choice.numIntInfeasDown
-              << choice.upMovement << choice.numIntInfeasUp
-              << choice.possibleBranch->value()
-              << CoinMessageEol;
+            if (CbcMessageWanted(model->messageHandler(), *model->messagesPointer(), CBC_STRONG))
+              model->messageHandler()->message(CBC_STRONG, *model->messagesPointer())
+                << iObject << iColumn
+                << choice.downMovement << choice.numIntInfeasDown
+                << choice.upMovement << choice.numIntInfeasUp
+                << choice.possibleBranch->value()
+                << CoinMessageEol;
             choice.fix = -1;
             numberToFix++;
             choice.possibleBranch->fix(solver, saveLower, saveUpper, -1);
@@ -3814,43 +4397,45 @@ int CbcNode::chooseDynamicBranch(CbcModel *model, CbcNode *lastNode,
               //choiceObject = new CbcDynamicPseudoCostBranchingObject(*choiceObject);
               choice.possibleBranch = choiceObject;
             }
-            assert(doneHotStart);
-            solver->unmarkHotStart();
-            model->resolve(NULL, 11, saveSolution, saveLower, saveUpper);
+            if (!keepHotStart) {
+              assert(doneHotStart);
+              solver->unmarkHotStart();
+              model->resolve(NULL, 11, saveSolution, saveLower, saveUpper);
 #ifdef CHECK_DEBUGGER_PATH
-            if ((model->specialOptions() & 1) != 0 && onOptimalPath) {
-              const OsiRowCutDebugger *debugger = solver->getRowCutDebugger();
-              if (!debugger) {
-                printf("Strong branching down on %d went off optimal path\n", iObject);
-                solver->writeMps("query");
-                abort();
+              if ((model->specialOptions() & 1) != 0 && onOptimalPath) {
+                const OsiRowCutDebugger *debugger = solver->getRowCutDebugger();
+                if (!debugger) {
+                  printf("Strong branching down on %d went off optimal path\n", iObject);
+                  solver->writeMps("query");
+                  abort();
+                }
               }
-            }
 #endif
-            double newObjValue = solver->getObjSense() * solver->getObjValue();
-            objectiveValue_ = CoinMax(objectiveValue_, newObjValue);
-            bool goneInfeasible = (!solver->isProvenOptimal() || solver->isDualObjectiveLimitReached());
-            solver->markHotStart();
+              double newObjValue = solver->getObjSense() * solver->getObjValue();
+              objectiveValue_ = CoinMax(objectiveValue_, newObjValue);
+              bool goneInfeasible = (!solver->isProvenOptimal() || solver->isDualObjectiveLimitReached());
+              solver->markHotStart();
 #ifdef RESET_BOUNDS
-            memcpy(saveLower, solver->getColLower(), solver->getNumCols() * sizeof(double));
-            memcpy(saveUpper, solver->getColUpper(), solver->getNumCols() * sizeof(double));
+              memcpy(saveLower, solver->getColLower(), solver->getNumCols() * sizeof(double));
+              memcpy(saveUpper, solver->getColUpper(), solver->getNumCols() * sizeof(double));
 #endif
-            if (!solver->isProvenOptimal()) {
-              skipAll = -2;
-              canSkip = 1;
-            }
-            xMark++;
-            // may be infeasible (if other way stopped on iterations)
-            if (goneInfeasible) {
-              // neither side feasible
-              anyAction = -2;
-              if (!choiceObject) {
-                delete choice.possibleBranch;
-                choice.possibleBranch = NULL;
+              if (!solver->isProvenOptimal()) {
+                skipAll = -2;
+                canSkip = 1;
+              }
+              xMark++;
+              // may be infeasible (if other way stopped on iterations)
+              if (goneInfeasible) {
+                // neither side feasible
+                anyAction = -2;
+                if (!choiceObject) {
+                  delete choice.possibleBranch;
+                  choice.possibleBranch = NULL;
+                }
+                delete ws;
+                ws = NULL;
+                break;
               }
-              delete ws;
-              ws = NULL;
-              break;
             }
 #if 0
 	    if (!depth_&&numberRestarts) {
@@ -3892,6 +4477,8 @@ int CbcNode::chooseDynamicBranch(CbcModel *model, CbcNode *lastNode,
           delete choice.possibleBranch;
         }
       }
+      delete[] strongResult;
+      delete[] strongIndex;
       if (model->messageHandler()->logLevel() > 3) {
         if (anyAction == -2) {
           printf("infeasible\n");
@@ -3918,9 +4505,13 @@ int CbcNode::chooseDynamicBranch(CbcModel *model, CbcNode *lastNode,
         solver->setWarmStart(ws);
       }
       solver->setIntParam(OsiMaxNumIterationHotStart, saveLimit);
+      if (strongBudget) {
+        double now = model->getCurrentSeconds();
+        strongBudget->addTime(now - strongStartTime, now);
+      }
       // Unless infeasible we will carry on
-      // But we could fix anyway
-      if (numberToFix && !hitMaxTime) {
+      // But we could fix anyway (must if fixes were not resolved at once)
+      if (numberToFix && (!hitMaxTime || keepHotStart)) {
         if (anyAction != -2) {
           // apply and take off
           bool feasible = true;
@@ -5069,12 +5660,13 @@ int CbcNode::analyze(CbcModel *model, double *results)
           choice.movement[1] = CoinMax(0.0, choice.movement[1]);
           choice.movement[0] = CoinMax(0.0, choice.movement[0]);
           // feasible -
-          model->messageHandler()->message(CBC_STRONG, *model->messagesPointer())
-            << iColumn << iColumn
-            << choice.movement[0] << choice.numIntInfeas[0]
-            << choice.movement[1] << choice.numIntInfeas[1]
-            << choice.initialValue
-            << CoinMessageEol;
+          if (CbcMessageWanted(model->messageHandler(), *model->messagesPointer(), CBC_STRONG))
+            model->messageHandler()->message(CBC_STRONG, *model->messagesPointer())
+              << iColumn << iColumn
+              << choice.movement[0] << choice.numIntInfeas[0]
+              << choice.movement[1] << choice.numIntInfeas[1]
+              << choice.initialValue
+              << CoinMessageEol;
         } else {
           // up feasible, down infeasible
           needResolve = true;
@@ -5141,12 +5733,13 @@ int CbcNode::analyze(CbcModel *model, double *results)
           choice.movement[1] = CoinMax(0.0, choice.movement[1]);
           choice.movement[0] = CoinMax(0.0, choice.movement[0]);
           // feasible -
-          model->messageHandler()->message(CBC_STRONG, *model->messagesPointer())
-            << iObject << iColumn
-            << choice.movement[0] << choice.numIntInfeas[0]
-            << choice.movement[1] << choice.numIntInfeas[1]
-            << value
-            << CoinMessageEol;
+          if (CbcMessageWanted(model->messageHandler(), *model->messagesPointer(), CBC_STRONG))
+            model->messageHandler()->message(CBC_STRONG, *model->messagesPointer())
+              << iObject << iColumn
+              << choice.movement[0] << choice.numIntInfeas[0]
+              << choice.movement[1] << choice.numIntInfeas[1]
+              << value
+              << CoinMessageEol;
         } else {
           // up feasible, down infeasible
           numberToFix++;
@@ -5714,6 +6307,8 @@ CbcNode::CbcNode(const CbcNode &rhs)
   objectiveValue_ = rhs.objectiveValue_;
   guessedObjectiveValue_ = rhs.guessedObjectiveValue_;
   sumInfeasibilities_ = rhs.sumInfeasibilities_;
+  lpSeconds_ = rhs.lpSeconds_;
+  lpIterations_ = rhs.lpIterations_;
   if (rhs.branch_)
     branch_ = rhs.branch_->clone();
   else
@@ -5722,6 +6317,10 @@ CbcNode::CbcNode(const CbcNode &rhs)
   numberUnsatisfied_ = rhs.numberUnsatisfied_;
   nodeNumber_ = rhs.nodeNumber_;
   state_ = rhs.state_;
+  for (int i = 0; i < 2; i++) {
+    childObjective_[i] = rhs.childObjective_[i];
+    childBasis_[i] = rhs.childBasis_[i] ? dynamic_cast< CoinWarmStartBasis * >(rhs.childBasis_[i]->clone()) : NULL;
+  }
   if (nodeInfo_)
     assert((state_ & 2) != 0);
   else
@@ -5740,6 +6339,8 @@ CbcNode::operator=(const CbcNode &rhs)
     objectiveValue_ = rhs.objectiveValue_;
     guessedObjectiveValue_ = rhs.guessedObjectiveValue_;
     sumInfeasibilities_ = rhs.sumInfeasibilities_;
+    lpSeconds_ = rhs.lpSeconds_;
+    lpIterations_ = rhs.lpIterations_;
     if (rhs.branch_)
       branch_ = rhs.branch_->clone();
     else
@@ -5748,6 +6349,11 @@ CbcNode::operator=(const CbcNode &rhs)
     numberUnsatisfied_ = rhs.numberUnsatisfied_;
     nodeNumber_ = rhs.nodeNumber_;
     state_ = rhs.state_;
+    for (int i = 0; i < 2; i++) {
+      delete childBasis_[i];
+      childObjective_[i] = rhs.childObjective_[i];
+      childBasis_[i] = rhs.childBasis_[i] ? dynamic_cast< CoinWarmStartBasis * >(rhs.childBasis_[i]->clone()) : NULL;
+    }
     if (nodeInfo_)
       assert((state_ & 2) != 0);
     else
@@ -5785,6 +6391,40 @@ CbcNode::~CbcNode()
     }
   }
   delete branch_;
+  delete childBasis_[0];
+  delete childBasis_[1];
+}
+// Keep results of solving both arms when node was made
+void CbcNode::setChildResults(double objective0, CoinWarmStartBasis *basis0,
+  double objective1, CoinWarmStartBasis *basis1)
+{
+  childObjective_[0] = objective0;
+  childObjective_[1] = objective1;
+  delete childBasis_[0];
+  childBasis_[0] = basis0;
+  delete childBasis_[1];
+  childBasis_[1] = basis1;
+}
+// Objective of arm branch() will do next
+double CbcNode::childObjective() const
+{
+  int arm = branch_ ? branch_->branchIndex() : 0;
+  return (arm < 2) ? childObjective_[arm] : -COIN_DBL_MAX;
+}
+// Optimal basis of arm branch() will do next
+const CoinWarmStartBasis *CbcNode::childBasis() const
+{
+  int arm = branch_ ? branch_->branchIndex() : 0;
+  return (arm < 2) ? childBasis_[arm] : NULL;
+}
+// Delete basis of arm branch() will do next
+void CbcNode::freeChildBasis()
+{
+  int arm = branch_ ? branch_->branchIndex() : 0;
+  if (arm < 2) {
+    delete childBasis_[arm];
+    childBasis_[arm] = NULL;
+  }
 }
 // Decrement  active cut counts
 void CbcNode::decrementCuts(int change)
@@ -5826,6 +6466,14 @@ void CbcNode::nullNodeInfo()
   // say not active
   state_ &= ~2;
 }
+// Set node info (for recreating a node)
+void CbcNode::setNodeInfo(CbcNodeInfo *info)
+{
+  assert(!nodeInfo_);
+  nodeInfo_ = info;
+  // say active
+  state_ |= 2;
+}
 
 int CbcNode::branch(OsiSolverInterface *solver)
 {
@@ -14,6 +14,7 @@
 #include "CbcNodeInfo.hpp"
 #include "CbcFullNodeInfo.hpp"
 #include "CbcPartialNodeInfo.hpp"
+#include "CbcNodePool.hpp"
 
 class OsiSolverInterface;
 class OsiSolverBranch;
@@ -63,6 +64,17 @@ public:
   /// Destructor
   ~CbcNode();
 
+  /// Allocate from node pool
+  static void *operator new(size_t size)
+  {
+    return CbcNodePool::allocate(size);
+  }
+  /// Return to node pool
+  static void operator delete(void *block, size_t size)
+  {
+    CbcNodePool::release(block, size);
+  }
+
   /** Create a description of the subproblem at this node
 
       The CbcNodeInfo structure holds the information (basis & variable bounds)
@@ -193,6 +205,11 @@ public:
 
   /// Nulls out node info
   void nullNodeInfo();
+  /** Set node info (for recreating a node) and say active
+
+      The node takes over \p info.
+    */
+  void setNodeInfo(CbcNodeInfo *info);
   /** Initialize reference counts in attached CbcNodeInfo
 
       This is a convenience routine, which will initialize the reference counts
@@ -280,6 +297,22 @@ public:
   {
     guessedObjectiveValue_ = value;
   }
+  /// Set work (iterations and seconds) of solving LP and cuts at this node
+  inline void setLpWork(int iterations, double seconds)
+  {
+    lpIterations_ = iterations;
+    lpSeconds_ = seconds;
+  }
+  /// Iterations to solve LP and cuts at this node (0 if not measured)
+  inline int lpIterations() const
+  {
+    return lpIterations_;
+  }
+  /// Seconds to solve LP and cuts at this node (0.0 if not measured)
+  inline double lpSeconds() const
+  {
+    return lpSeconds_;
+  }
   /// Branching object for this node
   inline const OsiBranchingObject *branchingObject() const
   {
@@ -340,6 +373,22 @@ public:
   {
     state_ = value;
   }
+  /** Keep results of solving both arms of branch when node was made -
+      first is the arm branch() will do first.  Takes bases (may be NULL).
+      Objective COIN_DBL_MAX if infeasible */
+  void setChildResults(double objective0, CoinWarmStartBasis *basis0,
+    double objective1, CoinWarmStartBasis *basis1);
+  /// Whether arms were solved when node was made
+  inline bool haveChildResults() const
+  {
+    return childObjective_[0] != -COIN_DBL_MAX;
+  }
+  /// Objective of arm branch() will do next (if haveChildResults)
+  double childObjective() const;
+  /// Optimal basis of arm branch() will do next (NULL if none)
+  const CoinWarmStartBasis *childBasis() const;
+  /// Delete basis of arm branch() will do next (once used)
+  void freeChildBasis();
   /// Print
   void print() const;
   /// Debug
@@ -358,6 +407,8 @@ private:
   double guessedObjectiveValue_;
   /// Sum of "infeasibilities" reported by each object
   double sumInfeasibilities_;
+  /// Seconds to solve LP and cuts at this node
+  double lpSeconds_;
   /// Branching object for this node
   OsiBranchingObject *branch_;
   /// Depth of the node in the search tree
@@ -366,11 +417,17 @@ private:
   int numberUnsatisfied_;
   /// The node number
   int nodeNumber_;
+  /// Iterations to solve LP and cuts at this node
+  int lpIterations_;
   /** State
         1 - on tree
         2 - active
     */
   int state_;
+  /// Objectives of arms if solved when node was made (else -COIN_DBL_MAX)
+  double childObjective_[2];
+  /// Optimal bases of arms if solved when node was made
+  CoinWarmStartBasis *childBasis_[2];
 };
 
 #endif
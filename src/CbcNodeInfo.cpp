@@ -44,6 +44,7 @@
 using namespace std;
 #include "CglCutGenerator.hpp"
 #include "CbcNodeInfo.hpp"
+#include "CbcStrongCache.hpp"
 
 // Default Constructor
 CbcNodeInfo::CbcNodeInfo()
@@ -53,10 +54,14 @@ CbcNodeInfo::CbcNodeInfo()
   , owner_(NULL)
   , numberCuts_(0)
   , nodeNumber_(0)
+  , traceId_(-1)
   , cuts_(NULL)
   , numberRows_(0)
   , numberBranchesLeft_(0)
   , active_(7)
+  , strongCache_(NULL)
+  , cutPool_(NULL)
+  , childCuts_(NULL)
 {
 #ifdef CHECK_NODE
   printf("CbcNodeInfo %p Constructor\n", this);
@@ -87,6 +92,28 @@ void CbcNodeInfo::unsetParentBasedData()
   }
 }
 
+// Strong branching results saved by children
+CbcStrongCache *CbcNodeInfo::strongCache(int maximumEntries)
+{
+  if (!strongCache_ && maximumEntries > 0)
+    strongCache_ = new CbcStrongCache(maximumEntries);
+  return strongCache_;
+}
+// Cuts valid in subtree
+CbcRowCuts *CbcNodeInfo::cutPool(bool create)
+{
+  if (!cutPool_ && create)
+    cutPool_ = new CbcRowCuts();
+  return cutPool_;
+}
+// Cuts in cut pools of children
+CbcRowCuts *CbcNodeInfo::childCuts(bool create)
+{
+  if (!childCuts_ && create)
+    childCuts_ = new CbcRowCuts();
+  return childCuts_;
+}
+
 #ifdef JJF_ZERO
 // Constructor given parent
 CbcNodeInfo::CbcNodeInfo(CbcNodeInfo *parent)
@@ -96,10 +123,14 @@ CbcNodeInfo::CbcNodeInfo(CbcNodeInfo *parent)
   , owner_(NULL)
   , numberCuts_(0)
   , nodeNumber_(0)
+  , traceId_(-1)
   , cuts_(NULL)
   , numberRows_(0)
   , numberBranchesLeft_(2)
   , active_(7)
+  , strongCache_(NULL)
+  , cutPool_(NULL)
+  , childCuts_(NULL)
 {
 #ifdef CHECK_NODE
   printf("CbcNodeInfo %p Constructor from parent %p\n", this, parent_);
@@ -116,10 +147,14 @@ CbcNodeInfo::CbcNodeInfo(const CbcNodeInfo &rhs)
   , owner_(rhs.owner_)
   , numberCuts_(rhs.numberCuts_)
   , nodeNumber_(rhs.nodeNumber_)
+  , traceId_(rhs.traceId_)
   , cuts_(NULL)
   , numberRows_(rhs.numberRows_)
   , numberBranchesLeft_(rhs.numberBranchesLeft_)
   , active_(rhs.active_)
+  , strongCache_(NULL)
+  , cutPool_(NULL)
+  , childCuts_(NULL)
 {
 #ifdef CHECK_NODE
   printf("CbcNodeInfo %p Copy constructor\n", this);
@@ -150,10 +185,14 @@ CbcNodeInfo::CbcNodeInfo(CbcNodeInfo *parent, CbcNode *owner)
   , owner_(owner)
   , numberCuts_(0)
   , nodeNumber_(0)
+  , traceId_(-1)
   , cuts_(NULL)
   , numberRows_(0)
   , numberBranchesLeft_(2)
   , active_(7)
+  , strongCache_(NULL)
+  , cutPool_(NULL)
+  , childCuts_(NULL)
 {
 #ifdef CHECK_NODE
   printf("CbcNodeInfo %p Constructor from parent %p\n", this, parent_);
@@ -194,6 +233,9 @@ CbcNodeInfo::~CbcNodeInfo()
       delete parent_;
   }
   delete parentBranch_;
+  delete strongCache_;
+  delete cutPool_;
+  delete childCuts_;
 }
 
 //#define ALLCUTS
@@ -233,6 +275,23 @@ void CbcNodeInfo::incrementCuts(int change)
       cuts_[i]->increment(change);
   }
 }
+// Default is to apply everything
+void CbcNodeInfo::applyBasisAndCuts(CbcModel *model, CoinWarmStartBasis *&basis,
+  CbcCountRowCut **addCuts,
+  int &currentNumberCuts) const
+{
+  applyToModel(model, basis, addCuts, currentNumberCuts);
+}
+// Add cuts to list without bounds or basis
+void CbcNodeInfo::applyCutsToList(CbcCountRowCut **addCuts,
+  int &currentNumberCuts) const
+{
+  if ((active_ & 2) != 0) {
+    for (int i = 0; i < numberCuts_; i++)
+      addCuts[currentNumberCuts + i] = cuts_[i];
+    currentNumberCuts += numberCuts_;
+  }
+}
 void CbcNodeInfo::decrementParentCuts(CbcModel *model, int change)
 {
   if (parent_) {
@@ -13,6 +13,7 @@
 #include "CoinWarmStartBasis.hpp"
 #include "CoinSearchTree.hpp"
 #include "CbcBranchBase.hpp"
+#include "CbcNodePool.hpp"
 
 class OsiSolverInterface;
 class OsiSolverBranch;
@@ -26,6 +27,8 @@ class CbcModel;
 class CbcNode;
 class CbcSubProblem;
 class CbcGeneralBranchingObject;
+class CbcStrongCache;
+class CbcRowCuts;
 
 //#############################################################################
 /** Information required to recreate the subproblem at this node
@@ -101,6 +104,17 @@ public:
   virtual ~CbcNodeInfo();
   //@}
 
+  /// Allocate from node pool
+  static void *operator new(size_t size)
+  {
+    return CbcNodePool::allocate(size);
+  }
+  /// Return to node pool
+  static void operator delete(void *block, size_t size)
+  {
+    CbcNodePool::release(block, size);
+  }
+
   /** \brief Modify model according to information at node
 
         The routine modifies the model according to bound and basis
@@ -109,6 +123,12 @@ public:
   virtual void applyToModel(CbcModel *model, CoinWarmStartBasis *&basis,
     CbcCountRowCut **addCuts,
     int &currentNumberCuts) const = 0;
+  /** As applyToModel but leaves bounds alone (they have been set by
+        CbcBoundTrail).  Default just calls applyToModel.
+    */
+  virtual void applyBasisAndCuts(CbcModel *model, CoinWarmStartBasis *&basis,
+    CbcCountRowCut **addCuts,
+    int &currentNumberCuts) const;
   /// Just apply bounds to one variable - force means overwrite by lower,upper (1=>infeasible)
   virtual int applyBounds(int iColumn, double &lower, double &upper, int force) = 0;
 
@@ -210,6 +230,11 @@ public:
   void addCuts(OsiCuts &cuts, int numberToBranch, //int * whichGenerator,
     int numberPointingToThis);
   void addCuts(int numberCuts, CbcCountRowCut **cuts, int numberToBranch);
+  /** Add the cuts at this node to list (as applyToModel) without
+        touching bounds or basis.  Used for nodes above a CbcFullNodeInfo
+        checkpoint when restoring a subproblem.
+    */
+  void applyCutsToList(CbcCountRowCut **addCuts, int &currentNumberCuts) const;
   /** Delete cuts (decrements counts)
         Slow unless cuts in same order as saved
     */
@@ -269,6 +294,15 @@ public:
   {
     nodeNumber_ = node;
   }
+  /// Number of node in node trace (-1 if not traced)
+  inline int traceId() const
+  {
+    return traceId_;
+  }
+  inline void setTraceId(int id)
+  {
+    traceId_ = id;
+  }
   /** Deactivate node information.
         1 - bounds
         2 - cuts
@@ -315,6 +349,17 @@ public:
   }
   /// If we need to take off parent based data
   void unsetParentBasedData();
+  /** Strong branching results saved by children (NULL if none).
+      If \p maximumEntries is positive one is created if needed */
+  CbcStrongCache *strongCache(int maximumEntries = 0);
+  /** Cuts valid in subtree of this node which may be wanted again by
+      descendants (NULL if none).  If \p create is true one is created
+      if needed */
+  CbcRowCuts *cutPool(bool create = false);
+  /** Cuts children have put in their cut pools (NULL if none).  A cut
+      reported by both children of a two way branch is valid here.
+      If \p create is true one is created if needed */
+  CbcRowCuts *childCuts(bool create = false);
 
 protected:
   /** Number of other nodes pointing to this node.
@@ -341,6 +386,9 @@ protected:
   /// The node number
   int nodeNumber_;
 
+  /// Number of node in node trace
+  int traceId_;
+
   /// Array of pointers to cuts
   CbcCountRowCut **cuts_;
 
@@ -362,6 +410,15 @@ protected:
     */
   int active_;
 
+  /// Strong branching results saved by children
+  CbcStrongCache *strongCache_;
+
+  /// Cuts valid in subtree (optional)
+  CbcRowCuts *cutPool_;
+
+  /// Cuts in cut pools of children (optional)
+  CbcRowCuts *childCuts_;
+
 private:
   /// Illegal Assignment operator
   CbcNodeInfo &operator=(const CbcNodeInfo &rhs);
@@ -0,0 +1,200 @@
+// Copyright (C) 2002, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include "CbcConfig.h"
+
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include "CbcNodePool.hpp"
+
+#ifndef CBC_NO_NODE_POOL
+#ifdef CBC_THREAD
+#include <pthread.h>
+#endif
+
+namespace {
+// Free lists and current slab for each size class
+typedef struct {
+  void *freeList[CbcNodePool::numberClasses];
+  int numberFree[CbcNodePool::numberClasses];
+  char *next[CbcNodePool::numberClasses];
+  char *end[CbcNodePool::numberClasses];
+} poolCache;
+
+// Shared depot of free blocks
+typedef struct {
+  void *freeList[CbcNodePool::numberClasses];
+  int numberFree[CbcNodePool::numberClasses];
+} poolDepot;
+
+poolDepot depot;
+double totalSlabBytes = 0.0;
+
+inline void *&nextBlock(void *block)
+{
+  return *reinterpret_cast< void ** >(block);
+}
+
+#ifdef CBC_THREAD
+pthread_mutex_t depotMutex = PTHREAD_MUTEX_INITIALIZER;
+pthread_key_t cacheKey;
+pthread_once_t cacheOnce = PTHREAD_ONCE_INIT;
+inline void lockDepot()
+{
+  pthread_mutex_lock(&depotMutex);
+}
+inline void unlockDepot()
+{
+  pthread_mutex_unlock(&depotMutex);
+}
+// Thread exiting - give free blocks to depot (rest of slab is lost)
+void freeCache(void *value)
+{
+  poolCache *cache = reinterpret_cast< poolCache * >(value);
+  lockDepot();
+  for (int i = 0; i < CbcNodePool::numberClasses; i++) {
+    void *block = cache->freeList[i];
+    while (block) {
+      void *next = nextBlock(block);
+      nextBlock(block) = depot.freeList[i];
+      depot.freeList[i] = block;
+      depot.numberFree[i]++;
+      block = next;
+    }
+  }
+  unlockDepot();
+  free(cache);
+}
+void createKey()
+{
+  pthread_key_create(&cacheKey, freeCache);
+}
+inline poolCache *getCache()
+{
+  pthread_once(&cacheOnce, createKey);
+  poolCache *cache = reinterpret_cast< poolCache * >(pthread_getspecific(cacheKey));
+  if (!cache) {
+    cache = reinterpret_cast< poolCache * >(calloc(1, sizeof(poolCache)));
+    if (!cache)
+      throw std::bad_alloc();
+    pthread_setspecific(cacheKey, cache);
+  }
+  return cache;
+}
+#else
+poolCache theCache;
+inline void lockDepot() {}
+inline void unlockDepot() {}
+inline poolCache *getCache()
+{
+  return &theCache;
+}
+#endif
+}
+
+// Get block of (at least) size bytes
+void *
+CbcNodePool::allocate(size_t size)
+{
+  int which = size ? static_cast< int >((size - 1) / granularity) : 0;
+  if (which >= numberClasses)
+    return ::operator new(size);
+  poolCache *cache = getCache();
+  void *block = cache->freeList[which];
+  if (!block) {
+    // take a batch from depot (looked at only under lock)
+    lockDepot();
+    int n = 0;
+    while (depot.freeList[which] && n < depotBatch) {
+      void *next = nextBlock(depot.freeList[which]);
+      nextBlock(depot.freeList[which]) = cache->freeList[which];
+      cache->freeList[which] = depot.freeList[which];
+      depot.freeList[which] = next;
+      n++;
+    }
+    depot.numberFree[which] -= n;
+    unlockDepot();
+    cache->numberFree[which] += n;
+    block = cache->freeList[which];
+  }
+  if (block) {
+    cache->freeList[which] = nextBlock(block);
+    cache->numberFree[which]--;
+    return block;
+  }
+  size_t blockSize = (which + 1) * granularity;
+  if (!cache->next[which] || cache->next[which] + blockSize > cache->end[which]) {
+    char *slab = reinterpret_cast< char * >(malloc(slabSize));
+    if (!slab)
+      throw std::bad_alloc();
+    lockDepot();
+    totalSlabBytes += slabSize;
+    unlockDepot();
+    cache->next[which] = slab;
+    cache->end[which] = slab + slabSize;
+  }
+  block = cache->next[which];
+  cache->next[which] += blockSize;
+  return block;
+}
+
+// Return block to free list
+void CbcNodePool::release(void *block, size_t size)
+{
+  if (!block)
+    return;
+  int which = size ? static_cast< int >((size - 1) / granularity) : 0;
+  if (which >= numberClasses) {
+    ::operator delete(block);
+    return;
+  }
+  poolCache *cache = getCache();
+  nextBlock(block) = cache->freeList[which];
+  cache->freeList[which] = block;
+  cache->numberFree[which]++;
+#ifdef CBC_THREAD
+  if (cache->numberFree[which] > 2 * depotBatch) {
+    // give a batch to depot so other threads can use
+    lockDepot();
+    for (int n = 0; n < depotBatch; n++) {
+      void *moved = cache->freeList[which];
+      cache->freeList[which] = nextBlock(moved);
+      nextBlock(moved) = depot.freeList[which];
+      depot.freeList[which] = moved;
+    }
+    depot.numberFree[which] += depotBatch;
+    unlockDepot();
+    cache->numberFree[which] -= depotBatch;
+  }
+#endif
+}
+
+// Bytes obtained from system for slabs
+double
+CbcNodePool::slabBytes()
+{
+  return totalSlabBytes;
+}
+#else
+void *
+CbcNodePool::allocate(size_t size)
+{
+  return ::operator new(size);
+}
+void CbcNodePool::release(void *block, size_t)
+{
+  ::operator delete(block);
+}
+double
+CbcNodePool::slabBytes()
+{
+  return 0.0;
+}
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
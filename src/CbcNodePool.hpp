@@ -0,0 +1,50 @@
+// Copyright (C) 2002, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcNodePool_H
+#define CbcNodePool_H
+
+#include <cstddef>
+
+#include "CbcConfig.h"
+
+/** Slab pool for small search tree objects
+
+    CbcNode, CbcNodeInfo, CbcBranchingObject (and derived classes) and the
+    bound change arrays in CbcPartialNodeInfo are allocated here.  Blocks
+    are rounded up to a multiple of 16 bytes and each size class has a free
+    list fed from 64K slabs, so a node and its branching object cost a
+    couple of pointer moves rather than calls to malloc.  Requests larger
+    than the biggest size class go to operator new.
+
+    With CBC_THREAD each thread has its own free lists.  Blocks freed by
+    one thread may have been allocated by another, so when a free list gets
+    long half of it is moved to a shared depot which threads draw on
+    before carving new slabs.  Slabs are not returned to the system until
+    the program exits but memory freed when a subtree is deleted is
+    available to the next nodes straight away.
+
+    Define CBC_NO_NODE_POOL when building to use operator new throughout.
+*/
+class CBCLIB_EXPORT CbcNodePool {
+
+public:
+  /// Get block of (at least) size bytes
+  static void *allocate(size_t size);
+  /// Return block of size bytes (size as given to allocate)
+  static void release(void *block, size_t size);
+  /// Bytes obtained from system for slabs
+  static double slabBytes();
+
+  /// Size classes
+  enum { granularity = 16,
+    numberClasses = 32,
+    slabSize = 65536,
+    depotBatch = 256 };
+};
+
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -0,0 +1,217 @@
+// Copyright (C) 2005, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#pragma warning(disable : 4786)
+#endif
+#include <cmath>
+#include <cstring>
+
+#include "CoinFinite.hpp"
+#include "OsiBranchingObject.hpp"
+#include "CbcNode.hpp"
+#include "CbcNodeInfo.hpp"
+#include "CbcSimpleInteger.hpp"
+#include "CbcNodeTrace.hpp"
+
+static const char *outcomeNames[] = {
+  "branched", "infeasible", "cutoff", "solution", "fathomed"
+};
+
+// Constructor - opens file
+CbcNodeTrace::CbcNodeTrace(const char *fileName)
+  : fp_(NULL)
+  , numberRecords_(0)
+  , numberWritten_(0)
+  , csv_(false)
+{
+  size_t length = strlen(fileName);
+  csv_ = length > 4 && !strcmp(fileName + length - 4, ".csv");
+  fp_ = fopen(fileName, csv_ ? "w" : "wb");
+  if (!fp_)
+    return;
+  if (csv_) {
+    fprintf(fp_, "id,parent,depth,variable,way,bound,iterations,objective,unsatisfied,outcome,time\n");
+  } else {
+    int header[2];
+    header[0] = version;
+    header[1] = static_cast< int >(sizeof(Record));
+    fwrite("CBCTRACE", 1, 8, fp_);
+    fwrite(header, sizeof(int), 2, fp_);
+  }
+  pending_.reserve(blockSize);
+#ifdef CBC_THREAD
+  flushing_ = false;
+  stop_ = false;
+  pthread_mutex_init(&mutex_, NULL);
+  pthread_cond_init(&work_, NULL);
+  pthread_cond_init(&done_, NULL);
+  pthread_create(&writerThread_, NULL, writer, this);
+#endif
+}
+
+// Destructor - writes what is left and closes file
+CbcNodeTrace::~CbcNodeTrace()
+{
+  if (!fp_)
+    return;
+#ifdef CBC_THREAD
+  pthread_mutex_lock(&mutex_);
+  stop_ = true;
+  pthread_cond_signal(&work_);
+  pthread_mutex_unlock(&mutex_);
+  pthread_join(writerThread_, NULL);
+  pthread_cond_destroy(&done_);
+  pthread_cond_destroy(&work_);
+  pthread_mutex_destroy(&mutex_);
+#else
+  write(pending_);
+#endif
+  fclose(fp_);
+}
+
+// Fill in record from empty values
+void CbcNodeTrace::initialize(Record &record)
+{
+  memset(&record, 0, sizeof(Record));
+  record.objective = COIN_DBL_MAX;
+  record.id = -1;
+  record.parent = -1;
+  record.variable = -1;
+}
+
+// Fill in branch of record from node before branch is done
+void CbcNodeTrace::setBranch(Record &record, const CbcNode *node)
+{
+  const CbcNodeInfo *nodeInfo = node->nodeInfo();
+  record.parent = nodeInfo ? nodeInfo->traceId() : -1;
+  record.depth = node->depth() + 1;
+  record.way = static_cast< signed char >(node->way() < 0 ? -1 : 1);
+  const OsiBranchingObject *branch = node->branchingObject();
+  const CbcBranchingObject *cbcBranch = dynamic_cast< const CbcBranchingObject * >(branch);
+  double value = branch ? branch->value() : 0.0;
+  bool integer = false;
+  record.variable = -1;
+  if (cbcBranch) {
+    if (dynamic_cast< const CbcIntegerBranchingObject * >(cbcBranch)) {
+      integer = true;
+      record.variable = cbcBranch->variable();
+    }
+  } else {
+    const OsiTwoWayBranchingObject *branch2 = dynamic_cast< const OsiTwoWayBranchingObject * >(branch);
+    const OsiSimpleInteger *obj = branch2 ? dynamic_cast< const OsiSimpleInteger * >(branch2->originalObject()) : NULL;
+    if (obj) {
+      integer = true;
+      record.variable = obj->columnNumber();
+    }
+  }
+  if (integer)
+    record.bound = record.way < 0 ? floor(value) : ceil(value);
+  else
+    record.bound = value;
+}
+
+// Give record a number and add to trace
+int CbcNodeTrace::add(Record &record)
+{
+  if (!fp_)
+    return -1;
+#ifdef CBC_THREAD
+  pthread_mutex_lock(&mutex_);
+  record.id = numberRecords_++;
+  pending_.push_back(record);
+  if (pending_.size() >= blockSize)
+    pthread_cond_signal(&work_);
+  pthread_mutex_unlock(&mutex_);
+#else
+  record.id = numberRecords_++;
+  pending_.push_back(record);
+  if (pending_.size() >= blockSize) {
+    write(pending_);
+    numberWritten_ += static_cast< int >(pending_.size());
+    pending_.clear();
+  }
+#endif
+  return record.id;
+}
+
+// Number of records added
+int CbcNodeTrace::numberRecords() const
+{
+  return numberRecords_;
+}
+
+// Wait until all records added are in file
+void CbcNodeTrace::flush()
+{
+  if (!fp_)
+    return;
+#ifdef CBC_THREAD
+  pthread_mutex_lock(&mutex_);
+  flushing_ = true;
+  pthread_cond_signal(&work_);
+  while (numberWritten_ < numberRecords_)
+    pthread_cond_wait(&done_, &mutex_);
+  flushing_ = false;
+  pthread_mutex_unlock(&mutex_);
+#else
+  write(pending_);
+  numberWritten_ += static_cast< int >(pending_.size());
+  pending_.clear();
+#endif
+  fflush(fp_);
+}
+
+// Write records to file
+void CbcNodeTrace::write(const std::vector< Record > &records)
+{
+  int n = static_cast< int >(records.size());
+  if (!n)
+    return;
+  if (!csv_) {
+    fwrite(&records[0], sizeof(Record), n, fp_);
+    return;
+  }
+  for (int i = 0; i < n; i++) {
+    const Record &record = records[i];
+    fprintf(fp_, "%d,%d,%d,%d,%d,%.12g,%d,", record.id, record.parent,
+      record.depth, record.variable, static_cast< int >(record.way),
+      record.bound, record.iterations);
+    if (record.objective != COIN_DBL_MAX)
+      fprintf(fp_, "%.12g", record.objective);
+    fprintf(fp_, ",%d,%s,%.4f\n", record.numberUnsatisfied,
+      outcomeNames[static_cast< int >(record.outcome)], record.time);
+  }
+}
+
+#ifdef CBC_THREAD
+// What writing thread does
+void *CbcNodeTrace::writer(void *voidTrace)
+{
+  CbcNodeTrace *trace = reinterpret_cast< CbcNodeTrace * >(voidTrace);
+  std::vector< Record > records;
+  records.reserve(blockSize);
+  pthread_mutex_lock(&trace->mutex_);
+  while (true) {
+    while (!trace->stop_ && trace->pending_.size() < (trace->flushing_ ? 1u : static_cast< unsigned int >(blockSize)))
+      pthread_cond_wait(&trace->work_, &trace->mutex_);
+    records.swap(trace->pending_);
+    pthread_mutex_unlock(&trace->mutex_);
+    // write without lock so adding is not held up
+    trace->write(records);
+    pthread_mutex_lock(&trace->mutex_);
+    trace->numberWritten_ += static_cast< int >(records.size());
+    records.clear();
+    pthread_cond_broadcast(&trace->done_);
+    if (trace->stop_ && trace->pending_.empty())
+      break;
+  }
+  pthread_mutex_unlock(&trace->mutex_);
+  return NULL;
+}
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
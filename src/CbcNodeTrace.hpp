@@ -0,0 +1,145 @@
+// Copyright (C) 2005, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcNodeTrace_H
+#define CbcNodeTrace_H
+
+#include <cstdio>
+#include <vector>
+
+#include "CbcConfig.h"
+#ifdef CBC_THREAD
+#include <pthread.h>
+#endif
+
+class CbcNode;
+
+/** Trace of nodes of search tree for offline analysis
+
+    One record is written for each node evaluated (and the root).  Records
+    are given numbers in order added and a record gives the number of the
+    record of its parent, so the tree can be rebuilt.  The same trace is
+    used by all threads of a model.
+
+    If the file name ends in ".csv" records are written as text with a
+    header line, otherwise as binary - the eight characters "CBCTRACE",
+    int version and int size of record, then the records as in Record.
+
+    With threads records are written by a thread of their own, so adding a
+    record only copies it (under a lock).  Without threads they are
+    written in blocks.
+*/
+
+class CBCLIB_EXPORT CbcNodeTrace {
+public:
+  /// Outcome of node
+  enum Outcome {
+    /// Branched - children will go on tree
+    branched = 0,
+    /// LP infeasible
+    infeasible,
+    /// LP objective not better than cutoff
+    cutoff,
+    /// Integer solution (no branching)
+    solution,
+    /// Fathomed by bound when taken from tree (no LP)
+    fathomed
+  };
+  /// One node
+  typedef struct {
+    /// Elapsed seconds
+    double time;
+    /// Objective (COIN_DBL_MAX if infeasible)
+    double objective;
+    /// New bound on branching variable (or branching value if not integer)
+    double bound;
+    /// Number of this record
+    int id;
+    /// Number of record of parent (-1 for root)
+    int parent;
+    int depth;
+    /// Branching variable (-1 if root or not simple variable)
+    int variable;
+    /// LP iterations at node
+    int iterations;
+    /// Number unsatisfied after node (0 if infeasible)
+    int numberUnsatisfied;
+    /// -1 down, +1 up (0 root)
+    signed char way;
+    /// Outcome
+    signed char outcome;
+    char spare[6];
+  } Record;
+  /// Version of binary format
+  enum {
+    version = 1
+  };
+
+  /// Constructor - opens file (check with isOpen)
+  CbcNodeTrace(const char *fileName);
+  /// Destructor - writes what is left and closes file
+  ~CbcNodeTrace();
+
+  /// Whether file open
+  inline bool isOpen() const
+  {
+    return fp_ != NULL;
+  }
+  /// Whether text
+  inline bool isCsv() const
+  {
+    return csv_;
+  }
+  /// Fill in record from empty values
+  static void initialize(Record &record);
+  /** Fill in parent, depth, variable, way and bound of record from node
+      before branch is done */
+  static void setBranch(Record &record, const CbcNode *node);
+  /// Give record a number and add to trace - returns number
+  int add(Record &record);
+  /// Number of records added
+  int numberRecords() const;
+  /// Wait until all records added are in file
+  void flush();
+
+private:
+  /// Illegal copy constructor
+  CbcNodeTrace(const CbcNodeTrace &rhs);
+  /// Illegal assignment operator
+  CbcNodeTrace &operator=(const CbcNodeTrace &rhs);
+  /// Write records to file
+  void write(const std::vector< Record > &records);
+#ifdef CBC_THREAD
+  /// What writing thread does
+  static void *writer(void *trace);
+#endif
+  /// Number of records kept before writing
+  enum {
+    blockSize = 1024
+  };
+
+  /// File
+  FILE *fp_;
+  /// Records not yet given to writer
+  std::vector< Record > pending_;
+  /// Number of records added
+  int numberRecords_;
+  /// Number of records written
+  int numberWritten_;
+  /// Whether text
+  bool csv_;
+#ifdef CBC_THREAD
+  pthread_mutex_t mutex_;
+  pthread_cond_t work_; // wakes writer
+  pthread_cond_t done_; // wakes flush
+  pthread_t writerThread_;
+  bool flushing_;
+  bool stop_;
+#endif
+};
+
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -32,6 +32,7 @@ CbcObjectUpdateData::CbcObjectUpdateData()
   , branchingValue_(0.0)
   , originalObjective_(COIN_DBL_MAX)
   , cutoff_(COIN_DBL_MAX)
+  , movement_(-1.0)
 {
 }
 
@@ -51,6 +52,7 @@ CbcObjectUpdateData::CbcObjectUpdateData(CbcObject *object,
   , branchingValue_(branchingValue)
   , originalObjective_(COIN_DBL_MAX)
   , cutoff_(COIN_DBL_MAX)
+  , movement_(-1.0)
 {
 }
 
@@ -70,6 +72,7 @@ CbcObjectUpdateData::CbcObjectUpdateData(const CbcObjectUpdateData &rhs)
   , branchingValue_(rhs.branchingValue_)
   , originalObjective_(rhs.originalObjective_)
   , cutoff_(rhs.cutoff_)
+  , movement_(rhs.movement_)
 {
 }
 
@@ -87,6 +90,7 @@ CbcObjectUpdateData::operator=(const CbcObjectUpdateData &rhs)
     branchingValue_ = rhs.branchingValue_;
     originalObjective_ = rhs.originalObjective_;
     cutoff_ = rhs.cutoff_;
+    movement_ = rhs.movement_;
   }
   return *this;
 }
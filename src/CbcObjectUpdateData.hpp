@@ -54,6 +54,9 @@ public:
   double originalObjective_;
   /// Current cutoff
   double cutoff_;
+  /** Distance branch moved variable if range was split (so not from
+      branching value to next integer) - negative if not split */
+  double movement_;
 };
 
 #endif
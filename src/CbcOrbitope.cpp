@@ -0,0 +1,258 @@
+// Copyright (C) 2008, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#pragma warning(disable : 4786)
+#endif
+
+#include <cassert>
+#include <cstring>
+#include <vector>
+
+#include "OsiSolverInterface.hpp"
+#include "CbcOrbitope.hpp"
+#include "CbcBoundPropagator.hpp"
+#include "CoinHelperFunctions.hpp"
+
+// Default Constructor
+CbcOrbitope::CbcOrbitope()
+  : variables_(NULL)
+  , numberRows_(0)
+  , numberColumns_(0)
+{
+}
+
+// Constructor from variables
+CbcOrbitope::CbcOrbitope(int numberRows, int numberColumns, const int *variables)
+  : numberRows_(numberRows)
+  , numberColumns_(numberColumns)
+{
+  variables_ = CoinCopyOfArray(variables, numberRows_ * numberColumns_);
+}
+
+// Copy constructor
+CbcOrbitope::CbcOrbitope(const CbcOrbitope &rhs)
+  : numberRows_(rhs.numberRows_)
+  , numberColumns_(rhs.numberColumns_)
+{
+  variables_ = CoinCopyOfArray(rhs.variables_, numberRows_ * numberColumns_);
+}
+
+// Assignment operator
+CbcOrbitope &
+CbcOrbitope::operator=(const CbcOrbitope &rhs)
+{
+  if (this != &rhs) {
+    delete[] variables_;
+    numberRows_ = rhs.numberRows_;
+    numberColumns_ = rhs.numberColumns_;
+    variables_ = CoinCopyOfArray(rhs.variables_, numberRows_ * numberColumns_);
+  }
+  return *this;
+}
+
+// Destructor
+CbcOrbitope::~CbcOrbitope()
+{
+  delete[] variables_;
+}
+
+/* Find orbitope from generators.
+   First two column swap generator gives first two columns (cycles give
+   rows).  Then a generator whose cycles each pair a variable of one
+   column of orbitope with a new variable gives a new column (new variable
+   goes in row of variable it is paired with).  Transpositions of columns
+   which connect all columns generate all permutations of columns.
+*/
+CbcOrbitope *
+CbcOrbitope::find(const OsiSolverInterface *solver,
+  int numberGenerators, const int *const *next, const int *cycleLength)
+{
+  if (numberGenerators <= 0)
+    return NULL;
+  int numberColumns = solver->getNumCols();
+  int *whichColumn = new int[3 * numberColumns];
+  int *whichRow = whichColumn + numberColumns;
+  int *first = whichRow + numberColumns;
+  for (int i = 0; i < numberColumns; i++)
+    whichColumn[i] = -1;
+  char *used = new char[numberGenerators];
+  memset(used, 0, numberGenerators);
+  std::vector< int > variables;
+  std::vector< int > newColumn;
+  int numberRows = 0;
+  int numberOrbitColumns = 0;
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (int k = 0; k < numberGenerators; k++) {
+      if (used[k])
+        continue;
+      used[k] = 1;
+      if (cycleLength[k] != 2)
+        continue;
+      const int *nextK = next[k];
+      int numberPairs = 0;
+      bool binary = true;
+      for (int i = 0; i < numberColumns; i++) {
+        int j = nextK[i];
+        if (j > i) {
+          first[numberPairs++] = i;
+          if (!solver->isBinary(i) || !solver->isBinary(j))
+            binary = false;
+        }
+      }
+      if (!binary || !numberPairs)
+        continue;
+      if (!numberOrbitColumns) {
+        numberRows = numberPairs;
+        for (int iRow = 0; iRow < numberRows; iRow++) {
+          int i = first[iRow];
+          whichColumn[i] = 0;
+          whichRow[i] = iRow;
+          variables.push_back(i);
+        }
+        for (int iRow = 0; iRow < numberRows; iRow++) {
+          int j = nextK[first[iRow]];
+          whichColumn[j] = 1;
+          whichRow[j] = iRow;
+          variables.push_back(j);
+        }
+        numberOrbitColumns = 2;
+        changed = true;
+        continue;
+      }
+      if (numberPairs != numberRows)
+        continue;
+      newColumn.assign(numberRows, -1);
+      int column = -1;
+      bool good = true;
+      for (int iPair = 0; iPair < numberPairs; iPair++) {
+        int known = first[iPair];
+        int other = nextK[known];
+        if (whichColumn[known] < 0) {
+          known = other;
+          other = first[iPair];
+        }
+        if (whichColumn[known] < 0 || whichColumn[other] >= 0
+          || (column >= 0 && whichColumn[known] != column)) {
+          good = false;
+          break;
+        }
+        column = whichColumn[known];
+        newColumn[whichRow[known]] = other;
+      }
+      if (!good) {
+        // may fit when more columns known
+        used[k] = 0;
+        continue;
+      }
+      for (int iRow = 0; iRow < numberRows; iRow++) {
+        int i = newColumn[iRow];
+        whichColumn[i] = numberOrbitColumns;
+        whichRow[i] = iRow;
+        variables.push_back(i);
+      }
+      numberOrbitColumns++;
+      changed = true;
+    }
+  }
+  delete[] whichColumn;
+  delete[] used;
+  if (numberOrbitColumns < 2)
+    return NULL;
+  return new CbcOrbitope(numberRows, numberOrbitColumns, &variables[0]);
+}
+
+// Fix variables so columns stay in lexicographic order
+int CbcOrbitope::propagate(CbcBoundPropagator &propagator) const
+{
+  int numberFixed = 0;
+  for (int iPass = 0; iPass < numberColumns_; iPass++) {
+    int numberThis = 0;
+    for (int j = 0; j < numberColumns_ - 1; j++) {
+      int n = propagatePair(propagator, variables_ + j * numberRows_,
+        variables_ + (j + 1) * numberRows_);
+      if (n < 0)
+        return -1;
+      numberThis += n;
+    }
+    numberFixed += numberThis;
+    if (!numberThis)
+      break;
+  }
+  return numberFixed;
+}
+
+/* Fix so first >= second lexicographically.
+   Go down rows while both are fixed to same value.  At first row where
+   they can differ - if first can only be 0 then second must be 0, if
+   second can only be 1 then first must be 1 (and go on).  Otherwise
+   if rest of first at upper bounds is lexicographically smaller than
+   rest of second at lower bounds this row must be 1 in first and 0 in
+   second.
+*/
+int CbcOrbitope::propagatePair(CbcBoundPropagator &propagator,
+  const int *first, const int *second) const
+{
+  const double *lower = propagator.lower();
+  const double *upper = propagator.upper();
+  int numberFixed = 0;
+  for (int iRow = 0; iRow < numberRows_; iRow++) {
+    int iFirst = first[iRow];
+    int iSecond = second[iRow];
+    bool firstLower = lower[iFirst] > 0.5;
+    bool firstUpper = upper[iFirst] > 0.5;
+    bool secondLower = lower[iSecond] > 0.5;
+    bool secondUpper = upper[iSecond] > 0.5;
+    if (firstLower == firstUpper && secondLower == secondUpper) {
+      if (firstLower == secondLower)
+        continue;
+      // decided
+      return firstLower ? numberFixed : -1;
+    }
+    if (!firstUpper) {
+      // second must be 0 as well
+      if (propagator.fix(iSecond, 0.0) < 0)
+        return -1;
+      numberFixed++;
+      continue;
+    }
+    if (secondLower) {
+      // first must be 1 as well
+      if (propagator.fix(iFirst, 1.0) < 0)
+        return -1;
+      numberFixed++;
+      continue;
+    }
+    // can rows be equal here
+    bool canBeEqual = true;
+    for (int jRow = iRow + 1; jRow < numberRows_; jRow++) {
+      bool bestFirst = upper[first[jRow]] > 0.5;
+      bool bestSecond = lower[second[jRow]] > 0.5;
+      if (bestFirst != bestSecond) {
+        canBeEqual = bestFirst;
+        break;
+      }
+    }
+    if (!canBeEqual) {
+      if (!firstLower) {
+        if (propagator.fix(iFirst, 1.0) < 0)
+          return -1;
+        numberFixed++;
+      }
+      if (secondUpper) {
+        if (propagator.fix(iSecond, 0.0) < 0)
+          return -1;
+        numberFixed++;
+      }
+    }
+    break;
+  }
+  return numberFixed;
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -0,0 +1,90 @@
+// Copyright (C) 2008, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcOrbitope_H
+#define CbcOrbitope_H
+
+#include "CbcConfig.h"
+
+class OsiSolverInterface;
+class CbcBoundPropagator;
+
+/** Full orbitope of binary variables
+
+    A matrix of binaries (numberRows by numberColumns) where any
+    permutation of columns maps feasible solutions to feasible solutions
+    with same objective - e.g. identical machines or bins.  So columns may
+    be taken in lexicographically decreasing order.  propagate fixes
+    variables so each column stays lexicographically at least as large as
+    the next one, given current bounds.
+
+    find builds one from generators of symmetry group (as stored by
+    CbcSymmetry) using generators which swap two columns of matrix.
+ */
+
+class CBCLIB_EXPORT CbcOrbitope {
+public:
+  /// Default Constructor
+  CbcOrbitope();
+
+  /** Constructor from variables - variable in row i of column j is
+      variables[j*numberRows+i] */
+  CbcOrbitope(int numberRows, int numberColumns, const int *variables);
+
+  /// Copy constructor
+  CbcOrbitope(const CbcOrbitope &);
+
+  /// Assignment operator
+  CbcOrbitope &operator=(const CbcOrbitope &rhs);
+
+  /// Destructor
+  ~CbcOrbitope();
+
+  /** Find orbitope from generators.  For generator k next[k][i] is
+      column following i in its cycle (-1 if i fixed) and cycleLength[k]
+      is length of cycles.  Only generators with all cycles of length
+      two are used and all variables must be binary in solver.
+      Returns NULL if no orbitope with at least two columns */
+  static CbcOrbitope *find(const OsiSolverInterface *solver,
+    int numberGenerators, const int *const *next, const int *cycleLength);
+
+  /** Fix variables (via propagator) so columns stay in lexicographic
+      order.  Returns number fixed or -1 if infeasible */
+  int propagate(CbcBoundPropagator &propagator) const;
+
+  /// Number of rows
+  inline int numberRows() const
+  {
+    return numberRows_;
+  }
+  /// Number of columns
+  inline int numberColumns() const
+  {
+    return numberColumns_;
+  }
+  /// Variables (column by column)
+  inline const int *variables() const
+  {
+    return variables_;
+  }
+
+private:
+  /** Fix so first column is lexicographically >= second.
+      Returns number fixed or -1 if infeasible */
+  int propagatePair(CbcBoundPropagator &propagator,
+    const int *first, const int *second) const;
+
+private:
+  /// Variables column by column
+  int *variables_;
+  /// Number of rows
+  int numberRows_;
+  /// Number of columns
+  int numberColumns_;
+};
+
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -13,6 +13,7 @@
 //#define CBC_CHECK_BASIS
 #include <cassert>
 #include <cfloat>
+#include <cstring>
 #define CUTS
 #include "CoinPragma.hpp"
 #include "OsiSolverInterface.hpp"
@@ -45,9 +46,13 @@ CbcPartialNodeInfo::CbcPartialNodeInfo()
 
   : CbcNodeInfo()
   , basisDiff_(NULL)
+  , newBasis_(NULL)
+  , oldBasis_(NULL)
   , variables_(NULL)
   , newBounds_(NULL)
   , numberChangedBounds_(0)
+  , basisDiffBytes_(0)
+  , binary_(false)
 
 { /* this space intentionally left blank */
 }
@@ -59,46 +64,52 @@ CbcPartialNodeInfo::CbcPartialNodeInfo(CbcNodeInfo *parent, CbcNode *owner,
   const double *boundChanges,
   const CoinWarmStartDiff *basisDiff)
   : CbcNodeInfo(parent, owner)
+  , newBasis_(NULL)
+  , oldBasis_(NULL)
+  , basisDiffBytes_(0)
 {
   basisDiff_ = basisDiff->clone();
 #ifdef CBC_CHECK_BASIS
   std::cout << "Constructor (" << this << ") " << std::endl;
 #endif
 
-  numberChangedBounds_ = numberChangedBounds;
-  size_t size = numberChangedBounds_ * (sizeof(double) + sizeof(int));
-  char *temp = new char[size];
-  newBounds_ = reinterpret_cast< double * >(temp);
-  variables_ = reinterpret_cast< int * >(newBounds_ + numberChangedBounds_);
+  setBounds(numberChangedBounds, variables, boundChanges, false);
+}
 
-  int i;
-  for (i = 0; i < numberChangedBounds_; i++) {
-    variables_[i] = variables[i];
-    newBounds_[i] = boundChanges[i];
-  }
+// Constructor from current state - basis diff deferred
+CbcPartialNodeInfo::CbcPartialNodeInfo(CbcNodeInfo *parent, CbcNode *owner,
+  int numberChangedBounds,
+  const int *variables,
+  const double *boundChanges,
+  CoinWarmStartBasis *newBasis, CoinWarmStartBasis *oldBasis)
+  : CbcNodeInfo(parent, owner)
+  , basisDiff_(NULL)
+  , newBasis_(newBasis)
+  , oldBasis_(oldBasis)
+  , basisDiffBytes_(0)
+{
+#ifdef CBC_CHECK_BASIS
+  std::cout << "Deferred constructor (" << this << ") " << std::endl;
+#endif
+
+  setBounds(numberChangedBounds, variables, boundChanges, false);
 }
 
 CbcPartialNodeInfo::CbcPartialNodeInfo(const CbcPartialNodeInfo &rhs)
 
   : CbcNodeInfo(rhs)
+  , newBasis_(NULL)
+  , oldBasis_(NULL)
+  , basisDiffBytes_(rhs.basisDiffBytes_)
 
 {
-  basisDiff_ = rhs.basisDiff_->clone();
+  basisDiff_ = rhs.basisDiff()->clone();
 
 #ifdef CBC_CHECK_BASIS
   std::cout << "Copy constructor (" << this << ") from " << this << std::endl;
 #endif
-  numberChangedBounds_ = rhs.numberChangedBounds_;
-  size_t size = numberChangedBounds_ * (sizeof(double) + sizeof(int));
-  char *temp = new char[size];
-  newBounds_ = reinterpret_cast< double * >(temp);
-  variables_ = reinterpret_cast< int * >(newBounds_ + numberChangedBounds_);
-
-  int i;
-  for (i = 0; i < numberChangedBounds_; i++) {
-    variables_[i] = rhs.variables_[i];
-    newBounds_[i] = rhs.newBounds_[i];
-  }
+  setBounds(rhs.numberChangedBounds_, rhs.variables_, rhs.newBounds_,
+    rhs.binary_);
 }
 
 CbcNodeInfo *
@@ -110,7 +121,79 @@ CbcPartialNodeInfo::clone() const
 CbcPartialNodeInfo::~CbcPartialNodeInfo()
 {
   delete basisDiff_;
-  delete[] newBounds_;
+  delete newBasis_;
+  delete oldBasis_;
+  freeBounds();
+}
+
+/*
+  Store bound changes.  If they are all a lower bound going to one or an
+  upper bound going to zero only variables_ is kept (value is given by upper
+  bound bit) which is a third of the space and applies without loads of
+  bounds.  Otherwise one block holds bounds then variables.
+*/
+void CbcPartialNodeInfo::setBounds(int numberChangedBounds,
+  const int *variables, const double *boundChanges, bool binary)
+{
+  numberChangedBounds_ = numberChangedBounds;
+  int i;
+  if (!binary && numberChangedBounds_) {
+    binary = true;
+    for (i = 0; i < numberChangedBounds_; i++) {
+      int variable = variables[i];
+      double value = ((variable & 0x80000000) == 0) ? 1.0 : 0.0;
+      if ((variable & 0x40000000) != 0 || boundChanges[i] != value) {
+        binary = false;
+        break;
+      }
+    }
+  }
+  binary_ = binary;
+  if (binary_) {
+    size_t size = numberChangedBounds_ * sizeof(int);
+    variables_ = reinterpret_cast< int * >(CbcNodePool::allocate(size));
+    newBounds_ = NULL;
+    memcpy(variables_, variables, size);
+  } else {
+    size_t size = numberChangedBounds_ * (sizeof(double) + sizeof(int));
+    char *temp = reinterpret_cast< char * >(CbcNodePool::allocate(size));
+    newBounds_ = reinterpret_cast< double * >(temp);
+    variables_ = reinterpret_cast< int * >(newBounds_ + numberChangedBounds_);
+    for (i = 0; i < numberChangedBounds_; i++) {
+      variables_[i] = variables[i];
+      newBounds_[i] = boundChanges[i];
+    }
+  }
+}
+
+// Free bound changes
+void CbcPartialNodeInfo::freeBounds()
+{
+  if (binary_)
+    CbcNodePool::release(variables_, numberChangedBounds_ * sizeof(int));
+  else
+    CbcNodePool::release(newBounds_, numberChangedBounds_ * (sizeof(double) + sizeof(int)));
+  variables_ = NULL;
+  newBounds_ = NULL;
+}
+
+// Store bounds in full (if held as binary)
+void CbcPartialNodeInfo::unpackBinary() const
+{
+  if (!binary_)
+    return;
+  size_t size = numberChangedBounds_ * (sizeof(double) + sizeof(int));
+  char *temp = reinterpret_cast< char * >(CbcNodePool::allocate(size));
+  double *newBounds = reinterpret_cast< double * >(temp);
+  int *variables = reinterpret_cast< int * >(newBounds + numberChangedBounds_);
+  for (int i = 0; i < numberChangedBounds_; i++) {
+    variables[i] = variables_[i];
+    newBounds[i] = newBound(i);
+  }
+  CbcNodePool::release(variables_, numberChangedBounds_ * sizeof(int));
+  variables_ = variables;
+  newBounds_ = newBounds;
+  binary_ = false;
 }
 
 /**
@@ -126,17 +209,21 @@ void CbcPartialNodeInfo::applyToModel(CbcModel *model,
 
 {
   OsiSolverInterface *solver = model->solver();
-  if ((active_ & 4) != 0 && basis) {
-    basis->applyDiff(basisDiff_);
-#ifdef CBC_CHECK_BASIS
-    std::cout << "Basis (after applying " << this << ") " << std::endl;
-    basis->print();
-#endif
-  }
+  applyBasisAndCuts(model, basis, addCuts, currentNumberCuts);
 
   // branch - do bounds
   int i;
-  if ((active_ & 1) != 0) {
+  if ((active_ & 1) != 0 && binary_) {
+    // all lower to one or upper to zero
+    for (i = 0; i < numberChangedBounds_; i++) {
+      int variable = variables_[i];
+      int k = variable & 0x3fffffff;
+      if ((variable & 0x80000000) == 0)
+        solver->setColLower(k, 1.0);
+      else
+        solver->setColUpper(k, 0.0);
+    }
+  } else if ((active_ & 1) != 0) {
     for (i = 0; i < numberChangedBounds_; i++) {
       int variable = variables_[i];
       int k = variable & 0x3fffffff;
@@ -174,8 +261,26 @@ void CbcPartialNodeInfo::applyToModel(CbcModel *model,
       }
     }
   }
+  return;
+}
+
+/*
+  As applyToModel but leaves bounds alone (CbcBoundTrail has set them).
+*/
+void CbcPartialNodeInfo::applyBasisAndCuts(CbcModel *model,
+  CoinWarmStartBasis *&basis,
+  CbcCountRowCut **addCuts,
+  int &currentNumberCuts) const
+{
+  if ((active_ & 4) != 0 && basis) {
+    basis->applyDiff(basisDiff());
+#ifdef CBC_CHECK_BASIS
+    std::cout << "Basis (after applying " << this << ") " << std::endl;
+    basis->print();
+#endif
+  }
   if ((active_ & 2) != 0) {
-    for (i = 0; i < numberCuts_; i++) {
+    for (int i = 0; i < numberCuts_; i++) {
       addCuts[currentNumberCuts + i] = cuts_[i];
       if (cuts_[i] && model->messageHandler()->logLevel() > 4) {
         cuts_[i]->print();
@@ -184,11 +289,14 @@ void CbcPartialNodeInfo::applyToModel(CbcModel *model,
 
     currentNumberCuts += numberCuts_;
   }
-  return;
 }
 // Just apply bounds to one variable (1=>infeasible)
 int CbcPartialNodeInfo::applyBounds(int iColumn, double &lower, double &upper, int force)
 {
+  /* Only a forced bound overwrites or adds changes (which need them in
+     full) - otherwise read bounds from packed form */
+  if (force)
+    unpackBinary();
   // branch - do bounds
   int i;
   int found = 0;
@@ -198,14 +306,15 @@ int CbcPartialNodeInfo::applyBounds(int iColumn, double &lower, double &upper, i
     int variable = variables_[i];
     int k = variable & 0x3fffffff;
     if (k == iColumn) {
+      double bound = newBound(i);
       if ((variable & 0x80000000) == 0) {
         // lower bound changing
         found |= 1;
-        newLower = CoinMax(newLower, newBounds_[i]);
+        newLower = CoinMax(newLower, bound);
         if ((force & 1) == 0) {
-          if (lower > newBounds_[i])
-            COIN_DETAIL_PRINT(printf("%d odd lower going from %g to %g\n", iColumn, lower, newBounds_[i]));
-          lower = newBounds_[i];
+          if (lower > bound)
+            COIN_DETAIL_PRINT(printf("%d odd lower going from %g to %g\n", iColumn, lower, bound));
+          lower = bound;
         } else {
           newBounds_[i] = lower;
           variables_[i] |= 0x40000000; // say can go odd way
@@ -213,11 +322,11 @@ int CbcPartialNodeInfo::applyBounds(int iColumn, double &lower, double &upper, i
       } else {
         // upper bound changing
         found |= 2;
-        newUpper = CoinMin(newUpper, newBounds_[i]);
+        newUpper = CoinMin(newUpper, bound);
         if ((force & 2) == 0) {
-          if (upper < newBounds_[i])
-            COIN_DETAIL_PRINT(printf("%d odd upper going from %g to %g\n", iColumn, upper, newBounds_[i]));
-          upper = newBounds_[i];
+          if (upper < bound)
+            COIN_DETAIL_PRINT(printf("%d odd upper going from %g to %g\n", iColumn, upper, bound));
+          upper = bound;
         } else {
           newBounds_[i] = upper;
           variables_[i] |= 0x40000000; // say can go odd way
@@ -238,7 +347,7 @@ int CbcPartialNodeInfo::applyBounds(int iColumn, double &lower, double &upper, i
   }
   if (nAdd) {
     size_t size = (numberChangedBounds_ + nAdd) * (sizeof(double) + sizeof(int));
-    char *temp = new char[size];
+    char *temp = reinterpret_cast< char * >(CbcNodePool::allocate(size));
     double *newBounds = reinterpret_cast< double * >(temp);
     int *variables = reinterpret_cast< int * >(newBounds + numberChangedBounds_ + nAdd);
 
@@ -247,7 +356,7 @@ int CbcPartialNodeInfo::applyBounds(int iColumn, double &lower, double &upper, i
       variables[i] = variables_[i];
       newBounds[i] = newBounds_[i];
     }
-    delete[] newBounds_;
+    CbcNodePool::release(newBounds_, numberChangedBounds_ * (sizeof(double) + sizeof(int)));
     newBounds_ = newBounds;
     variables_ = variables;
     if ((force & 2) != 0 && (found & 2) == 0) {
@@ -276,10 +385,21 @@ CbcNodeInfo *
 CbcPartialNodeInfo::buildRowBasis(CoinWarmStartBasis &basis) const
 
 {
-  basis.applyDiff(basisDiff_);
+  basis.applyDiff(basisDiff());
 
   return parent_;
 }
 
+// Make basis diff from deferred bases
+void CbcPartialNodeInfo::makeBasisDiff() const
+{
+  assert(newBasis_ && oldBasis_);
+  basisDiff_ = newBasis_->generateDiff(oldBasis_);
+  delete newBasis_;
+  newBasis_ = NULL;
+  delete oldBasis_;
+  oldBasis_ = NULL;
+}
+
 /* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
 */
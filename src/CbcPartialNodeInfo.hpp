@@ -33,6 +33,11 @@ class CbcGeneralBranchingObject;
   A CbcPartialNodeInfo object contains changes to the bounds and basis, and
   additional cuts, required to recreate a subproblem by modifying and
   augmenting the parent subproblem.
+
+  When every bound change is a lower bound going to one or an upper bound
+  going to zero (as on pure 0-1 problems) the new bounds are not stored -
+  the upper bound bit in variables() says which it is.  Use newBound(i),
+  which works either way; newBounds() makes the full array if needed.
 */
 
 class CBCLIB_EXPORT CbcPartialNodeInfo : public CbcNodeInfo {
@@ -47,6 +52,11 @@ public:
     CbcCountRowCut **addCuts,
     int &currentNumberCuts) const;
 
+  /// As applyToModel but leaves bounds alone
+  virtual void applyBasisAndCuts(CbcModel *model, CoinWarmStartBasis *&basis,
+    CbcCountRowCut **addCuts,
+    int &currentNumberCuts) const;
+
   /// Just apply bounds to one variable - force means overwrite by lower,upper (1=>infeasible)
   virtual int applyBounds(int iColumn, double &lower, double &upper, int force);
   /** Builds up row basis backwards (until original model).
@@ -63,6 +73,15 @@ public:
     const double *boundChanges,
     const CoinWarmStartDiff *basisDiff);
 
+  /** Constructor from current state with basis diff left until first
+      needed.  Takes over newBasis and oldBasis; the diff of newBasis
+      against oldBasis is made when the basis is first applied, so a node
+      pruned before any of its subproblems is restored never makes it */
+  CbcPartialNodeInfo(CbcNodeInfo *parent, CbcNode *owner,
+    int numberChangedBounds, const int *variables,
+    const double *boundChanges,
+    CoinWarmStartBasis *newBasis, CoinWarmStartBasis *oldBasis);
+
   // Copy constructor
   CbcPartialNodeInfo(const CbcPartialNodeInfo &);
 
@@ -71,40 +90,89 @@ public:
 
   /// Clone
   virtual CbcNodeInfo *clone() const;
-  /// Basis diff information
+  /// Basis diff information (made now if deferred)
   inline const CoinWarmStartDiff *basisDiff() const
   {
+    if (!basisDiff_)
+      makeBasisDiff();
     return basisDiff_;
   }
+  /// Whether basis diff has still to be made
+  inline bool basisDiffDeferred() const
+  {
+    return basisDiff_ == NULL && newBasis_ != NULL;
+  }
   /// Which variable (top bit if upper bound changing)
   inline const int *variables() const
   {
     return variables_;
   }
-  // New bound
+  // New bounds (made if changes held as binary)
   inline const double *newBounds() const
   {
+    if (binary_)
+      unpackBinary();
     return newBounds_;
   }
+  /// New bound of change i
+  inline double newBound(int i) const
+  {
+    if (!binary_)
+      return newBounds_[i];
+    else
+      return (variables_[i] & 0x80000000) == 0 ? 1.0 : 0.0;
+  }
+  /// Whether bound changes are all to one or zero (so no bounds stored)
+  inline bool binaryBounds() const
+  {
+    return binary_;
+  }
   /// Number of bound changes
   inline int numberChangedBounds() const
   {
     return numberChangedBounds_;
   }
+  /// Estimated bytes in basis diff
+  inline int basisDiffBytes() const
+  {
+    return basisDiffBytes_;
+  }
+  /// Set estimated bytes in basis diff
+  inline void setBasisDiffBytes(int value)
+  {
+    basisDiffBytes_ = value;
+  }
 
 protected:
   /* Data values */
 
-  /// Basis diff information
-  CoinWarmStartDiff *basisDiff_;
+  /// Basis diff information (NULL until made if deferred)
+  mutable CoinWarmStartDiff *basisDiff_;
+  /// Bases to diff if deferred (deleted when diff made)
+  mutable CoinWarmStartBasis *newBasis_;
+  mutable CoinWarmStartBasis *oldBasis_;
   /// Which variable (top bit if upper bound changing)
-  int *variables_;
-  // New bound
-  double *newBounds_;
+  mutable int *variables_;
+  // New bound (NULL if binary_)
+  mutable double *newBounds_;
   /// Number of bound changes
   int numberChangedBounds_;
+  /// Estimated bytes in basis diff
+  int basisDiffBytes_;
+  /// Whether changes are all lower to one or upper to zero
+  mutable bool binary_;
 
 private:
+  /// Make basis diff from deferred bases
+  void makeBasisDiff() const;
+  /** Store bound changes (held as binary if possible).  If binary
+      boundChanges may be NULL */
+  void setBounds(int numberChangedBounds, const int *variables,
+    const double *boundChanges, bool binary);
+  /// Free bound changes
+  void freeBounds();
+  /// Store bounds in full (if held as binary)
+  void unpackBinary() const;
   /// Illegal Assignment operator
   CbcPartialNodeInfo &operator=(const CbcPartialNodeInfo &rhs);
 };
@@ -0,0 +1,209 @@
+// Copyright (C) 2005, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#pragma warning(disable : 4786)
+#endif
+#include <cstdio>
+#include <cstring>
+
+#include "CoinFinite.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinTime.hpp"
+#include "OsiRowCut.hpp"
+#include "CbcModel.hpp"
+#include "CbcCountRowCut.hpp"
+#include "CbcCheckpoint.hpp"
+#include "CbcPeerExchange.hpp"
+
+namespace {
+/*
+  A slot file is the eight characters "CBCPEERX" and the header, then the
+  solution (if any) and the cuts (cutHeader then indices and elements).
+*/
+typedef struct {
+  double stamp;
+  double objective;
+  int version;
+  unsigned int hash;
+  int numberColumns;
+  int haveSolution;
+  int numberCuts;
+  int spare;
+} slotHeader;
+
+typedef struct {
+  double lb;
+  double ub;
+  int numberElements;
+  int spare;
+} cutHeader;
+}
+
+// Constructor
+CbcPeerExchange::CbcPeerExchange(const char *baseName, int slot, int numberPeers)
+  : baseName_(baseName)
+  , lastStamp_(numberPeers, 0.0)
+  , publishedObjective_(COIN_DBL_MAX)
+  , publishedCuts_(0)
+  , slot_(slot)
+  , numberSolutionsTaken_(0)
+  , numberCutsTaken_(0)
+{
+}
+
+// Destructor
+CbcPeerExchange::~CbcPeerExchange()
+{
+}
+
+// Name of file of slot
+std::string CbcPeerExchange::slotName(int slot) const
+{
+  char suffix[20];
+  sprintf(suffix, ".%d", slot);
+  return baseName_ + suffix;
+}
+
+// Write incumbent and global cuts to own slot
+bool CbcPeerExchange::publish(CbcModel *model)
+{
+  const double *solution = model->bestSolution();
+  double objective = model->savedSolutionObjective(0);
+  CbcRowCuts *globalCuts = model->globalCuts();
+  int numberGlobal = globalCuts->sizeRowCuts();
+  if ((!solution || objective >= publishedObjective_) && numberGlobal == publishedCuts_)
+    return false;
+  slotHeader header;
+  memset(&header, 0, sizeof(header));
+  header.stamp = CoinGetTimeOfDay();
+  header.objective = objective;
+  header.version = version;
+  header.hash = CbcCheckpoint::problemHash(model);
+  header.numberColumns = model->solver()->getNumCols();
+  header.haveSolution = solution ? 1 : 0;
+  // most recent cuts
+  int firstCut = CoinMax(numberGlobal - static_cast< int >(maximumCuts), 0);
+  header.numberCuts = numberGlobal - firstCut;
+  std::string name = slotName(slot_);
+  std::string tempName = name + ".tmp";
+  FILE *fp = fopen(tempName.c_str(), "wb");
+  if (!fp)
+    return false;
+  bool ok = fwrite("CBCPEERX", 1, 8, fp) == 8;
+  ok = ok && fwrite(&header, sizeof(header), 1, fp) == 1;
+  if (solution)
+    ok = ok && fwrite(solution, sizeof(double), header.numberColumns, fp) == static_cast< size_t >(header.numberColumns);
+  for (int i = firstCut; ok && i < numberGlobal; i++) {
+    const OsiRowCut *cut = globalCuts->rowCutPtr(i);
+    const CoinPackedVector &row = cut->row();
+    cutHeader cutRecord;
+    memset(&cutRecord, 0, sizeof(cutRecord));
+    cutRecord.lb = cut->lb();
+    cutRecord.ub = cut->ub();
+    cutRecord.numberElements = row.getNumElements();
+    size_t n = cutRecord.numberElements;
+    ok = fwrite(&cutRecord, sizeof(cutRecord), 1, fp) == 1;
+    ok = ok && fwrite(row.getIndices(), sizeof(int), n, fp) == n;
+    ok = ok && fwrite(row.getElements(), sizeof(double), n, fp) == n;
+  }
+  ok = !fclose(fp) && ok;
+  if (ok) {
+    // rename will not replace on some systems
+    remove(name.c_str());
+    ok = !rename(tempName.c_str(), name.c_str());
+  }
+  if (ok) {
+    if (solution)
+      publishedObjective_ = objective;
+    publishedCuts_ = numberGlobal;
+  }
+  return ok;
+}
+
+// Take better solutions and new cuts from other slots
+int CbcPeerExchange::poll(CbcModel *model)
+{
+  int numberTaken = 0;
+  int numberColumns = model->solver()->getNumCols();
+  unsigned int hash = 0;
+  bool haveHash = false;
+  double *solution = NULL;
+  int numberPeers = static_cast< int >(lastStamp_.size());
+  for (int iSlot = 0; iSlot < numberPeers; iSlot++) {
+    if (iSlot == slot_)
+      continue;
+    FILE *fp = fopen(slotName(iSlot).c_str(), "rb");
+    if (!fp)
+      continue;
+    char magic[8];
+    slotHeader header;
+    bool ok = fread(magic, 1, 8, fp) == 8 && !memcmp(magic, "CBCPEERX", 8);
+    ok = ok && fread(&header, sizeof(header), 1, fp) == 1;
+    ok = ok && header.version == version && header.stamp != lastStamp_[iSlot]
+      && header.numberColumns == numberColumns;
+    if (ok) {
+      if (!haveHash) {
+        hash = CbcCheckpoint::problemHash(model);
+        haveHash = true;
+      }
+      ok = header.hash == hash;
+    }
+    if (!ok) {
+      fclose(fp);
+      continue;
+    }
+    lastStamp_[iSlot] = header.stamp;
+    if (header.haveSolution) {
+      if (!solution)
+        solution = new double[numberColumns];
+      if (fread(solution, sizeof(double), numberColumns, fp) != static_cast< size_t >(numberColumns)) {
+        fclose(fp);
+        continue;
+      }
+      if (header.objective < model->getCutoff()) {
+        // checked as a heuristic solution would be
+        double cutoff = model->getCutoff();
+        double objective = header.objective;
+        model->setLastHeuristic(NULL);
+        model->setBestSolution(CBC_ROUNDING, objective, solution);
+        if (model->getCutoff() < cutoff) {
+          numberTaken++;
+          numberSolutionsTaken_++;
+          char general[200];
+          sprintf(general, "Solution of %g taken from peer %d", objective, iSlot);
+          model->messageHandler()->message(CBC_GENERAL, model->messages())
+            << general << CoinMessageEol;
+        }
+      }
+    }
+    std::vector< int > indices;
+    std::vector< double > elements;
+    for (int i = 0; i < header.numberCuts; i++) {
+      cutHeader cutRecord;
+      if (fread(&cutRecord, sizeof(cutRecord), 1, fp) != 1 || cutRecord.numberElements <= 0
+        || cutRecord.numberElements > numberColumns)
+        break;
+      size_t n = cutRecord.numberElements;
+      indices.resize(n);
+      elements.resize(n);
+      if (fread(&indices[0], sizeof(int), n, fp) != n
+        || fread(&elements[0], sizeof(double), n, fp) != n)
+        break;
+      OsiRowCut cut;
+      cut.setLb(cutRecord.lb);
+      cut.setUb(cutRecord.ub);
+      cut.setRow(cutRecord.numberElements, &indices[0], &elements[0], false);
+      model->makeGlobalCut(cut);
+      numberCutsTaken_++;
+    }
+    fclose(fp);
+  }
+  delete[] solution;
+  return numberTaken;
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -0,0 +1,90 @@
+// Copyright (C) 2005, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcPeerExchange_H
+#define CbcPeerExchange_H
+
+#include <string>
+#include <vector>
+
+#include "CbcConfig.h"
+
+class CbcModel;
+
+/** Exchange of incumbents and global cuts between processes
+
+    Several processes searching the same problem with different settings
+    (a portfolio) each have a slot numbered 0 to numberPeers-1.  A process
+    publishes its incumbent and its most recent global cuts by writing
+    file baseName.slot (as baseName.slot.tmp then renamed, so readers
+    never see half a file) and polls the slots of the others, taking any
+    better solution (checked as a heuristic solution is) and their cuts.
+    Files are in a directory all processes can see, so this works on any
+    system and even across machines with a shared file system.
+
+    A slot is only used if it is of the same problem (as for
+    CbcCheckpoint - sizes, objective and integers after preprocessing).
+*/
+
+class CBCLIB_EXPORT CbcPeerExchange {
+public:
+  /// Version of file
+  enum {
+    version = 1
+  };
+  /// Constructor - slot of this process among numberPeers
+  CbcPeerExchange(const char *baseName, int slot, int numberPeers);
+  /// Destructor
+  ~CbcPeerExchange();
+
+  /** Write incumbent and global cuts of model to own slot if either has
+      changed since last time.  Returns true if written */
+  bool publish(CbcModel *model);
+  /** Take better solutions and new cuts from other slots (between
+      nodes).  Returns number of solutions taken */
+  int poll(CbcModel *model);
+  /// Number of solutions taken from peers
+  inline int numberSolutionsTaken() const
+  {
+    return numberSolutionsTaken_;
+  }
+  /// Number of cuts taken from peers (including duplicates)
+  inline int numberCutsTaken() const
+  {
+    return numberCutsTaken_;
+  }
+  /// Slot of this process
+  inline int slot() const
+  {
+    return slot_;
+  }
+
+private:
+  /// Illegal copy constructor
+  CbcPeerExchange(const CbcPeerExchange &rhs);
+  /// Illegal assignment operator
+  CbcPeerExchange &operator=(const CbcPeerExchange &rhs);
+  /// Name of file of slot
+  std::string slotName(int slot) const;
+  /// Largest number of cuts published
+  enum {
+    maximumCuts = 1000
+  };
+
+  /// Start of file names
+  std::string baseName_;
+  /// Stamps (time written) of slots when last read
+  std::vector< double > lastStamp_;
+  /// Objective and number of global cuts when last published
+  double publishedObjective_;
+  int publishedCuts_;
+  int slot_;
+  int numberSolutionsTaken_;
+  int numberCutsTaken_;
+};
+
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
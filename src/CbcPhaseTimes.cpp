@@ -0,0 +1,169 @@
+// Copyright (C) 2005, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#pragma warning(disable : 4786)
+#endif
+#include <cstring>
+
+#include "CoinMessageHandler.hpp"
+#include "CbcMessage.hpp"
+#include "CbcPhaseTimes.hpp"
+
+static const char *phaseNames[CbcPhaseTimes::numberPhases] = {
+  "select", "restore", "lp", "cuts", "heuristics", "branch", "push"
+};
+
+// Name of phase
+const char *CbcPhaseTimes::name(int phase)
+{
+  if (phase < 0 || phase >= numberPhases)
+    return NULL;
+  return phaseNames[phase];
+}
+
+// Constructor
+CbcPhaseTimes::CbcPhaseTimes(int traceFrequency, const char *traceFile)
+  : firstTick_(tick())
+  , firstTime_(CoinGetTimeOfDay())
+  , start_(0)
+  , current_(-1)
+  , node_(0)
+  , traceFrequency_(traceFrequency)
+  , traceFile_(traceFile ? traceFile : "")
+  , tracing_(false)
+{
+  memset(ticks_, 0, sizeof(ticks_));
+  memset(counts_, 0, sizeof(counts_));
+}
+
+// Copy constructor - settings but no times
+CbcPhaseTimes::CbcPhaseTimes(const CbcPhaseTimes &rhs)
+  : firstTick_(rhs.firstTick_)
+  , firstTime_(rhs.firstTime_)
+  , start_(0)
+  , current_(-1)
+  , node_(0)
+  , traceFrequency_(rhs.traceFrequency_)
+  , traceFile_(rhs.traceFile_)
+  , tracing_(false)
+{
+  memset(ticks_, 0, sizeof(ticks_));
+  memset(counts_, 0, sizeof(counts_));
+}
+
+CbcPhaseTimes::~CbcPhaseTimes()
+{
+}
+
+// Zero times and events
+void CbcPhaseTimes::clear()
+{
+  memset(ticks_, 0, sizeof(ticks_));
+  memset(counts_, 0, sizeof(counts_));
+  threadTicks_.clear();
+  events_.clear();
+  current_ = -1;
+  tracing_ = false;
+}
+
+void CbcPhaseTimes::addEvent(int phase, CoinUInt64 startTick, CoinUInt64 endTick)
+{
+  Event event;
+  event.start = startTick;
+  event.end = endTick;
+  event.node = node_;
+  event.phase = static_cast< short >(phase);
+  event.thread = 0;
+  events_.push_back(event);
+}
+
+// Add times (and trace events) of thread and zero them there
+void CbcPhaseTimes::addThread(CbcPhaseTimes &threadTimes, int threadNumber)
+{
+  size_t needed = (threadNumber + 1) * numberPhases;
+  if (threadTicks_.size() < needed)
+    threadTicks_.resize(needed, 0);
+  for (int i = 0; i < numberPhases; i++) {
+    ticks_[i] += threadTimes.ticks_[i];
+    counts_[i] += threadTimes.counts_[i];
+    threadTicks_[threadNumber * numberPhases + i] += threadTimes.ticks_[i];
+  }
+  for (size_t i = 0; i < threadTimes.events_.size()
+       && events_.size() < maximumEvents;
+       i++) {
+    Event event = threadTimes.events_[i];
+    event.thread = static_cast< short >(threadNumber + 1);
+    events_.push_back(event);
+  }
+  threadTimes.clear();
+}
+
+// Ticks per second (from ticks and wallclock since creation)
+double CbcPhaseTimes::ticksPerSecond() const
+{
+#ifdef CBC_PHASE_RDTSC
+  double elapsed = CoinGetTimeOfDay() - firstTime_;
+  if (elapsed > 1.0e-3)
+    return static_cast< double >(tick() - firstTick_) / elapsed;
+#endif
+  return 1.0e9;
+}
+
+// Print summary table
+void CbcPhaseTimes::print(CoinMessageHandler *handler, CoinMessages *messages) const
+{
+  double perSecond = ticksPerSecond();
+  double total = 0.0;
+  for (int i = 0; i < numberPhases; i++)
+    total += static_cast< double >(ticks_[i]);
+  if (!total)
+    return;
+  int numberThreads = static_cast< int >(threadTicks_.size() / numberPhases);
+  char line[200];
+  size_t n = sprintf(line, "%-10s %10s %10s %6s %10s", "Phase", "Count",
+    "Seconds", "%", "us/count");
+  for (int j = 0; j < numberThreads && n < sizeof(line) - 12; j++)
+    n += sprintf(line + n, " %8s%d", "thread", j);
+  handler->message(CBC_GENERAL, *messages)
+    << line << CoinMessageEol;
+  for (int i = 0; i < numberPhases; i++) {
+    double seconds = static_cast< double >(ticks_[i]) / perSecond;
+    n = sprintf(line, "%-10s %10.0f %10.3f %6.1f %10.2f", phaseNames[i],
+      counts_[i], seconds, 100.0 * ticks_[i] / total,
+      counts_[i] ? 1.0e6 * seconds / counts_[i] : 0.0);
+    for (int j = 0; j < numberThreads && n < sizeof(line) - 12; j++)
+      n += sprintf(line + n, " %9.3f",
+        static_cast< double >(threadTicks_[j * numberPhases + i]) / perSecond);
+    handler->message(CBC_GENERAL, *messages)
+      << line << CoinMessageEol;
+  }
+}
+
+// Write Chrome trace (JSON) - returns false if could not
+bool CbcPhaseTimes::writeTrace(const char *fileName) const
+{
+  FILE *fp = fopen(fileName, "w");
+  if (!fp)
+    return false;
+  double microSeconds = 1.0e6 / ticksPerSecond();
+  fprintf(fp, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+  for (size_t i = 0; i < events_.size(); i++) {
+    const Event &event = events_[i];
+    double start = event.start > firstTick_
+      ? static_cast< double >(event.start - firstTick_) * microSeconds
+      : 0.0;
+    double duration = static_cast< double >(event.end - event.start) * microSeconds;
+    fprintf(fp, "{\"name\": \"%s\", \"cat\": \"cbc\", \"ph\": \"X\", \"ts\": %.3f, \"dur\": %.3f, \"pid\": 1, \"tid\": %d, \"args\": {\"node\": %d}}%s\n",
+      phaseNames[event.phase], start, duration, event.thread, event.node,
+      i + 1 < events_.size() ? "," : "");
+  }
+  fprintf(fp, "]}\n");
+  fclose(fp);
+  return true;
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
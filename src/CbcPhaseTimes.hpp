@@ -0,0 +1,200 @@
+// Copyright (C) 2005, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcPhaseTimes_H
+#define CbcPhaseTimes_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "CbcConfig.h"
+#include "CoinTypes.hpp"
+#include "CoinTime.hpp"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define CBC_PHASE_RDTSC
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define CBC_PHASE_RDTSC
+#endif
+
+class CoinMessageHandler;
+class CoinMessages;
+
+/** Times of phases of node processing
+
+    Each model (so each thread) may have one.  Phases are timed by
+    CbcPhaseTimer objects with the time stamp counter where there is one.
+    Times are exclusive - a phase started inside another (an LP inside
+    cut generation) is not counted in the outer one.  With no
+    CbcPhaseTimes a CbcPhaseTimer costs a test of a pointer.
+
+    If trace frequency is set, phases of every traceFrequency'th node (by
+    node count) are kept as events for a Chrome trace (chrome://tracing or
+    Perfetto).
+*/
+
+class CBCLIB_EXPORT CbcPhaseTimes {
+public:
+  /// Phases
+  enum Phase {
+    /// Choosing node from tree
+    select = 0,
+    /// Restoring subproblem (addCuts)
+    restore,
+    /// Solving LP
+    solveLP,
+    /// Generating cuts (without LPs)
+    cuts,
+    /// Heuristics at node
+    heuristics,
+    /// Choosing branch (including strong branching LPs)
+    branch,
+    /// Putting node on tree
+    treePush,
+    numberPhases
+  };
+  /// Constructor
+  CbcPhaseTimes(int traceFrequency = 0, const char *traceFile = NULL);
+  /// Copy constructor - settings but no times (for threads)
+  CbcPhaseTimes(const CbcPhaseTimes &rhs);
+  /// Destructor
+  ~CbcPhaseTimes();
+
+  /// Time stamp
+  static inline CoinUInt64 tick()
+  {
+#ifdef CBC_PHASE_RDTSC
+    return __rdtsc();
+#else
+    return static_cast< CoinUInt64 >(CoinGetTimeOfDay() * 1.0e9);
+#endif
+  }
+  /// Start phase - returns phase interrupted in savedPhase
+  inline void start(int phase, int &savedPhase, CoinUInt64 &startTick)
+  {
+    CoinUInt64 now = tick();
+    if (current_ >= 0)
+      ticks_[current_] += now - start_;
+    savedPhase = current_;
+    current_ = phase;
+    start_ = now;
+    startTick = now;
+    counts_[phase]++;
+  }
+  /// End current phase and restart savedPhase
+  inline void stop(int savedPhase, CoinUInt64 startTick)
+  {
+    CoinUInt64 now = tick();
+    ticks_[current_] += now - start_;
+    if (tracing_)
+      addEvent(current_, startTick, now);
+    current_ = savedPhase;
+    start_ = now;
+  }
+  /// Say which node is being done (decides if traced)
+  inline void setNode(int nodeNumber)
+  {
+    node_ = nodeNumber;
+    tracing_ = traceFrequency_ > 0 && (nodeNumber % traceFrequency_) == 0
+      && events_.size() < maximumEvents;
+  }
+  /// Add times (and trace events) of thread and zero them there
+  void addThread(CbcPhaseTimes &threadTimes, int threadNumber);
+  /// Zero times and events
+  void clear();
+  /// Print summary table
+  void print(CoinMessageHandler *handler, CoinMessages *messages) const;
+  /// Write Chrome trace (JSON) - returns false if could not
+  bool writeTrace(const char *fileName) const;
+  /// Trace file (NULL if none)
+  inline const char *traceFile() const
+  {
+    return traceFile_.size() ? traceFile_.c_str() : NULL;
+  }
+  /// Name of phase
+  static const char *name(int phase);
+
+private:
+  /// Illegal assignment operator
+  CbcPhaseTimes &operator=(const CbcPhaseTimes &rhs);
+  /// One traced phase
+  typedef struct {
+    CoinUInt64 start;
+    CoinUInt64 end;
+    int node;
+    short phase;
+    short thread;
+  } Event;
+  /// Maximum number of events kept
+  enum {
+    maximumEvents = 1000000
+  };
+  void addEvent(int phase, CoinUInt64 startTick, CoinUInt64 endTick);
+  /// Ticks per second (from ticks and wallclock since creation)
+  double ticksPerSecond() const;
+
+  /// Ticks in each phase
+  CoinUInt64 ticks_[numberPhases];
+  /// Number of times each phase started
+  double counts_[numberPhases];
+  /// Ticks in each phase for each thread (numberPhases per thread)
+  std::vector< CoinUInt64 > threadTicks_;
+  /// Trace events
+  std::vector< Event > events_;
+  /// Tick and wallclock when created (for ticks per second and trace)
+  CoinUInt64 firstTick_;
+  double firstTime_;
+  /// Start of current phase
+  CoinUInt64 start_;
+  /// Current phase (-1 if none)
+  int current_;
+  /// Current node
+  int node_;
+  /// Every traceFrequency_'th node traced (0 none)
+  int traceFrequency_;
+  /// File for Chrome trace
+  std::string traceFile_;
+  /// Whether current node traced
+  bool tracing_;
+};
+
+/** Scoped timer of a phase
+
+    Times phase from construction until stop or destruction.  Does
+    nothing if times is NULL. */
+
+class CbcPhaseTimer {
+public:
+  inline CbcPhaseTimer(CbcPhaseTimes *times, int phase)
+    : times_(times)
+  {
+    if (times_)
+      times_->start(phase, savedPhase_, startTick_);
+  }
+  inline ~CbcPhaseTimer()
+  {
+    stop();
+  }
+  /// End phase before destruction
+  inline void stop()
+  {
+    if (times_) {
+      times_->stop(savedPhase_, startTick_);
+      times_ = NULL;
+    }
+  }
+
+private:
+  CbcPhaseTimes *times_;
+  int savedPhase_;
+  CoinUInt64 startTick_;
+};
+
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -0,0 +1,406 @@
+// Copyright (C) 2002, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#pragma warning(disable : 4786)
+#endif
+#include <cassert>
+#include <cstdlib>
+#include <cmath>
+#include <cfloat>
+
+#include "CoinTypes.h"
+#include "OsiSolverInterface.hpp"
+#include "CbcModel.hpp"
+#include "CbcMessage.hpp"
+#include "CbcPiecewise.hpp"
+#include "CoinHelperFunctions.hpp"
+
+// Tolerance on y below f(x)
+#define CBC_PIECEWISE_TOLERANCE 1.0e-7
+
+//##############################################################################
+
+// Default Constructor
+CbcPiecewise::CbcPiecewise()
+  : CbcObject()
+  , xColumn_(-1)
+  , yColumn_(-1)
+  , numberPoints_(0)
+  , x_(NULL)
+  , f_(NULL)
+{
+}
+
+// Useful constructor (which are integer indices)
+CbcPiecewise::CbcPiecewise(CbcModel *model, int xColumn, int yColumn,
+  int numberPoints, const double *x, const double *f, int identifier)
+  : CbcObject(model)
+  , xColumn_(xColumn)
+  , yColumn_(yColumn)
+  , numberPoints_(numberPoints)
+{
+  id_ = identifier;
+  x_ = CoinCopyOfArray(x, numberPoints_);
+  f_ = CoinCopyOfArray(f, numberPoints_);
+#ifndef NDEBUG
+  for (int i = 1; i < numberPoints_; i++)
+    assert(x_[i] > x_[i - 1]);
+#endif
+}
+
+// Copy constructor
+CbcPiecewise::CbcPiecewise(const CbcPiecewise &rhs)
+  : CbcObject(rhs)
+  , xColumn_(rhs.xColumn_)
+  , yColumn_(rhs.yColumn_)
+  , numberPoints_(rhs.numberPoints_)
+{
+  x_ = CoinCopyOfArray(rhs.x_, numberPoints_);
+  f_ = CoinCopyOfArray(rhs.f_, numberPoints_);
+}
+
+// Clone
+CbcObject *
+CbcPiecewise::clone() const
+{
+  return new CbcPiecewise(*this);
+}
+
+// Assignment operator
+CbcPiecewise &
+CbcPiecewise::operator=(const CbcPiecewise &rhs)
+{
+  if (this != &rhs) {
+    CbcObject::operator=(rhs);
+    delete[] x_;
+    delete[] f_;
+    xColumn_ = rhs.xColumn_;
+    yColumn_ = rhs.yColumn_;
+    numberPoints_ = rhs.numberPoints_;
+    x_ = CoinCopyOfArray(rhs.x_, numberPoints_);
+    f_ = CoinCopyOfArray(rhs.f_, numberPoints_);
+  }
+  return *this;
+}
+
+// Destructor
+CbcPiecewise::~CbcPiecewise()
+{
+  delete[] x_;
+  delete[] f_;
+}
+// Value of f at x (clamped to breakpoints)
+double
+CbcPiecewise::value(double x) const
+{
+  if (x <= x_[0])
+    return f_[0];
+  if (x >= x_[numberPoints_ - 1])
+    return f_[numberPoints_ - 1];
+  // binary search for segment
+  int iLow = 0;
+  int iHigh = numberPoints_ - 1;
+  while (iHigh - iLow > 1) {
+    int iMid = (iLow + iHigh) >> 1;
+    if (x_[iMid] <= x)
+      iLow = iMid;
+    else
+      iHigh = iMid;
+  }
+  double fraction = (x - x_[iLow]) / (x_[iHigh] - x_[iLow]);
+  return f_[iLow] + fraction * (f_[iHigh] - f_[iLow]);
+}
+/* Lower convex envelope of f on [lower,upper] - fills x and f
+   and returns number of points */
+int CbcPiecewise::envelope(double lower, double upper, double *x, double *f) const
+{
+  lower = CoinMax(lower, x_[0]);
+  upper = CoinMin(upper, x_[numberPoints_ - 1]);
+  int n = 0;
+  x[n] = lower;
+  f[n++] = value(lower);
+  if (upper <= lower)
+    return n;
+  for (int i = 0; i <= numberPoints_; i++) {
+    double xValue;
+    double fValue;
+    if (i < numberPoints_) {
+      xValue = x_[i];
+      if (xValue <= lower || xValue >= upper)
+        continue;
+      fValue = f_[i];
+    } else {
+      xValue = upper;
+      fValue = value(upper);
+    }
+    // lower hull - drop points with no left turn
+    while (n >= 2) {
+      double cross = (x[n - 1] - x[n - 2]) * (fValue - f[n - 2])
+        - (f[n - 1] - f[n - 2]) * (xValue - x[n - 2]);
+      if (cross > 0.0)
+        break;
+      n--;
+    }
+    x[n] = xValue;
+    f[n++] = fValue;
+  }
+  return n;
+}
+/* Cut y >= segment of envelope on [lower,upper] containing xValue.
+   Returns amount solution (xValue,yValue) violates it */
+double
+CbcPiecewise::envelopeCut(double lower, double upper, double xValue, double yValue,
+  OsiRowCut &cut) const
+{
+  double *x = new double[2 * (numberPoints_ + 2)];
+  double *f = x + numberPoints_ + 2;
+  int n = envelope(lower, upper, x, f);
+  double slope = 0.0;
+  double rhs = f[0];
+  if (n > 1) {
+    int i;
+    for (i = 0; i < n - 2; i++) {
+      if (x[i + 1] >= xValue)
+        break;
+    }
+    slope = (f[i + 1] - f[i]) / (x[i + 1] - x[i]);
+    rhs = f[i] - slope * x[i];
+  }
+  delete[] x;
+  // y - slope * x >= rhs
+  int columns[2];
+  double elements[2];
+  int numberElements = 0;
+  columns[numberElements] = yColumn_;
+  elements[numberElements++] = 1.0;
+  if (slope) {
+    columns[numberElements] = xColumn_;
+    elements[numberElements++] = -slope;
+  }
+  cut.setLb(rhs);
+  cut.setUb(COIN_DBL_MAX);
+  cut.setRow(numberElements, columns, elements, false);
+  return rhs - (yValue - slope * xValue);
+}
+double
+CbcPiecewise::infeasibility(const OsiBranchingInformation *info,
+  int &preferredWay) const
+{
+  preferredWay = -1;
+  if (xColumn_ < 0 || yColumn_ < 0 || !numberPoints_)
+    return 0.0;
+  const double *solution = info->solution_;
+  double xValue = solution[xColumn_];
+  double fValue = value(xValue);
+  double violation = fValue - solution[yColumn_];
+  double tolerance = CoinMax(CBC_PIECEWISE_TOLERANCE, info->primalTolerance_)
+    * (1.0 + fabs(fValue));
+  if (violation <= tolerance)
+    return 0.0; // satisfied
+  // prefer side of nearer breakpoint
+  if (numberPoints_ > 1) {
+    int iLow = 0;
+    while (iLow < numberPoints_ - 2 && x_[iLow + 1] <= xValue)
+      iLow++;
+    if (xValue - x_[iLow] > x_[iLow + 1] - xValue)
+      preferredWay = 1;
+  }
+  return CoinMin(violation, 0.5);
+}
+
+// Nothing to fix - y is free above f(x)
+void CbcPiecewise::feasibleRegion()
+{
+}
+// Redoes data when sequence numbers change
+void CbcPiecewise::redoSequenceEtc(CbcModel *model, int numberColumns, const int *originalColumns)
+{
+  model_ = model;
+  int numberOld = CoinMax(xColumn_, yColumn_) + 1;
+  int i;
+  for (i = 0; i < numberColumns; i++)
+    numberOld = CoinMax(numberOld, originalColumns[i] + 1);
+  int *newColumn = new int[numberOld];
+  for (i = 0; i < numberOld; i++)
+    newColumn[i] = -1;
+  for (i = 0; i < numberColumns; i++)
+    newColumn[originalColumns[i]] = i;
+  mapColumns(newColumn);
+  delete[] newColumn;
+}
+// Change column numbers using map from old to new (-1 if gone)
+void CbcPiecewise::mapColumns(const int *newColumn)
+{
+  if (xColumn_ >= 0)
+    xColumn_ = newColumn[xColumn_];
+  if (yColumn_ >= 0)
+    yColumn_ = newColumn[yColumn_];
+  if (xColumn_ < 0 || yColumn_ < 0)
+    printf("** Piecewise column vanished - piecewise cost ignored!\n");
+}
+CbcBranchingObject *
+CbcPiecewise::createCbcBranch(OsiSolverInterface *solver, const OsiBranchingInformation *info, int way)
+{
+  const double *solution = info->solution_;
+  double xValue = solution[xColumn_];
+  double yValue = solution[yColumn_];
+  double lower = CoinMax(solver->getColLower()[xColumn_], x_[0]);
+  double upper = CoinMin(solver->getColUpper()[xColumn_], x_[numberPoints_ - 1]);
+  double tolerance = CoinMax(CBC_PIECEWISE_TOLERANCE, info->primalTolerance_)
+    * (1.0 + fabs(yValue));
+  OsiRowCut cut;
+  double violation = envelopeCut(lower, upper, xValue, yValue, cut);
+  // nearest breakpoint strictly inside bounds
+  int iBest = -1;
+  double bestDistance = COIN_DBL_MAX;
+  for (int i = 0; i < numberPoints_; i++) {
+    if (x_[i] > lower + tolerance && x_[i] < upper - tolerance) {
+      double distance = fabs(x_[i] - xValue);
+      if (distance < bestDistance) {
+        bestDistance = distance;
+        iBest = i;
+      }
+    }
+  }
+  CbcBranchingObject *branch;
+  if (violation > tolerance || iBest < 0) {
+    // below envelope - tangent cut is enough
+    branch = new CbcPiecewiseBranchingObject(model_, this, cut);
+  } else {
+    // f not convex here - split so envelope is tighter on each side
+    double value = x_[iBest];
+    OsiRowCut down;
+    envelopeCut(lower, value, value, yValue, down);
+    OsiRowCut up;
+    envelopeCut(value, upper, value, yValue, up);
+    branch = new CbcPiecewiseBranchingObject(model_, this, way, value, down, up);
+  }
+  branch->setOriginalObject(this);
+  return branch;
+}
+
+// Default Constructor
+CbcPiecewiseBranchingObject::CbcPiecewiseBranchingObject()
+  : CbcBranchingObject()
+  , object_(NULL)
+  , split_(false)
+{
+}
+
+// Useful constructor - just adds cut
+CbcPiecewiseBranchingObject::CbcPiecewiseBranchingObject(CbcModel *model,
+  const CbcPiecewise *piecewise, const OsiRowCut &cut)
+  : CbcBranchingObject(model, piecewise->xColumn(), 1, 0.0)
+  , object_(piecewise)
+  , up_(cut)
+  , split_(false)
+{
+  setNumberBranchesLeft(1);
+}
+
+// Useful constructor - splits x at value
+CbcPiecewiseBranchingObject::CbcPiecewiseBranchingObject(CbcModel *model,
+  const CbcPiecewise *piecewise, int way, double value,
+  const OsiRowCut &down, const OsiRowCut &up)
+  : CbcBranchingObject(model, piecewise->xColumn(), way, value)
+  , object_(piecewise)
+  , down_(down)
+  , up_(up)
+  , split_(true)
+{
+}
+
+// Copy constructor
+CbcPiecewiseBranchingObject::CbcPiecewiseBranchingObject(const CbcPiecewiseBranchingObject &rhs)
+  : CbcBranchingObject(rhs)
+  , object_(rhs.object_)
+  , down_(rhs.down_)
+  , up_(rhs.up_)
+  , split_(rhs.split_)
+{
+}
+
+// Assignment operator
+CbcPiecewiseBranchingObject &
+CbcPiecewiseBranchingObject::operator=(const CbcPiecewiseBranchingObject &rhs)
+{
+  if (this != &rhs) {
+    CbcBranchingObject::operator=(rhs);
+    object_ = rhs.object_;
+    down_ = rhs.down_;
+    up_ = rhs.up_;
+    split_ = rhs.split_;
+  }
+  return *this;
+}
+CbcBranchingObject *
+CbcPiecewiseBranchingObject::clone() const
+{
+  return (new CbcPiecewiseBranchingObject(*this));
+}
+
+// Destructor
+CbcPiecewiseBranchingObject::~CbcPiecewiseBranchingObject()
+{
+}
+double
+CbcPiecewiseBranchingObject::branch()
+{
+  decrementNumberBranchesLeft();
+  OsiSolverInterface *solver = model_->solver();
+  int iColumn = object_->xColumn();
+  if (!split_) {
+    model_->setNextRowCut(up_);
+  } else if (way_ < 0) {
+    solver->setColUpper(iColumn, value_);
+    model_->setNextRowCut(down_);
+    way_ = 1;
+  } else {
+    solver->setColLower(iColumn, value_);
+    model_->setNextRowCut(up_);
+    way_ = -1; // Swap direction
+  }
+  return 0.0;
+}
+void CbcPiecewiseBranchingObject::print()
+{
+  int iColumn = object_->xColumn();
+  if (!split_)
+    printf("Piecewise %d - envelope cut\n", iColumn);
+  else if (way_ < 0)
+    printf("Piecewise %d - x <= %g\n", iColumn, value_);
+  else
+    printf("Piecewise %d - x >= %g\n", iColumn, value_);
+}
+
+/** Compare the original object of \c this with the original object of \c
+    brObj.  Ordered by argument column.
+*/
+int CbcPiecewiseBranchingObject::compareOriginalObject(const CbcBranchingObject *brObj) const
+{
+  const CbcPiecewiseBranchingObject *br = dynamic_cast< const CbcPiecewiseBranchingObject * >(brObj);
+  assert(br);
+  return object_->xColumn() - br->object_->xColumn();
+}
+
+/** Compare the \c this with \c brObj.  Same way and split is same
+    region, otherwise overlap is not worked out.
+*/
+CbcRangeCompare
+CbcPiecewiseBranchingObject::compareBranchingObject(const CbcBranchingObject *brObj, const bool /*replaceIfOverlap*/)
+{
+  const CbcPiecewiseBranchingObject *br = dynamic_cast< const CbcPiecewiseBranchingObject * >(brObj);
+  assert(br);
+  if (split_ != br->split_ || value_ != br->value_)
+    return CbcRangeOverlap;
+  else if (!split_ || way_ == br->way_)
+    return CbcRangeSame;
+  else
+    return CbcRangeDisjoint;
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -0,0 +1,184 @@
+// Copyright (C) 2002, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcPiecewise_H
+#define CbcPiecewise_H
+
+#include "CbcBranchBase.hpp"
+#include "OsiRowCut.hpp"
+
+/** Define a piecewise linear cost.
+
+    Cost column y must be at least f(x) where f is piecewise linear
+    through breakpoints (x[k],f[k]) in increasing x.  Nothing is in the
+    LP - no SOS2 columns or rows.  For current bounds of x the lower
+    convex envelope of f is a valid relaxation; if LP solution is below
+    the envelope a tangent (segment) cut is added so the object only
+    branches with one arm.  If LP solution is above the envelope but
+    below f (f not convex on the interval) x is split at a breakpoint
+    and each side gets the envelope segment next to the split as a cut.
+    Once x is inside one segment the envelope is f.
+
+    Normally y has a positive objective coefficient (so y = f(x) at
+    optimum).  x must be bounded by the first and last breakpoints.
+*/
+
+class CBCLIB_EXPORT CbcPiecewise : public CbcObject {
+
+public:
+  // Default Constructor
+  CbcPiecewise();
+
+  /** Useful constructor - x and y are matrix indices, breakpoints
+        in increasing x (duplicates not allowed)
+    */
+  CbcPiecewise(CbcModel *model, int xColumn, int yColumn,
+    int numberPoints, const double *x, const double *f, int identifier);
+
+  // Copy constructor
+  CbcPiecewise(const CbcPiecewise &);
+
+  /// Clone
+  virtual CbcObject *clone() const;
+
+  /// Assignment operator
+  CbcPiecewise &operator=(const CbcPiecewise &rhs);
+
+  /// Destructor
+  virtual ~CbcPiecewise();
+
+  /// Infeasibility - amount y below f(x) (at most 0.5)
+  virtual double infeasibility(const OsiBranchingInformation *info,
+    int &preferredWay) const;
+
+  using CbcObject::feasibleRegion;
+  /// Nothing to fix - y is free above f(x)
+  virtual void feasibleRegion();
+
+  /// Creates a branching object
+  virtual CbcBranchingObject *createCbcBranch(OsiSolverInterface *solver, const OsiBranchingInformation *info, int way);
+
+  /// Redoes data when sequence numbers change
+  virtual void redoSequenceEtc(CbcModel *model, int numberColumns, const int *originalColumns);
+  /// Change column numbers using map from old to new (-1 if gone)
+  void mapColumns(const int *newColumn);
+
+  /// Value of f at x (clamped to breakpoints)
+  double value(double x) const;
+  /** Lower convex envelope of f on [lower,upper] - fills x and f
+        (space numberPoints+2) and returns number of points */
+  int envelope(double lower, double upper, double *x, double *f) const;
+  /** Cut y >= segment of envelope on [lower,upper] containing xValue.
+        Returns amount solution (xValue,yValue) violates it */
+  double envelopeCut(double lower, double upper, double xValue, double yValue,
+    OsiRowCut &cut) const;
+
+  /// Argument column
+  inline int xColumn() const
+  {
+    return xColumn_;
+  }
+  /// Cost column
+  inline int yColumn() const
+  {
+    return yColumn_;
+  }
+  /// Number of breakpoints
+  inline int numberPoints() const
+  {
+    return numberPoints_;
+  }
+  /// x of breakpoints
+  inline const double *x() const
+  {
+    return x_;
+  }
+  /// f of breakpoints
+  inline const double *f() const
+  {
+    return f_;
+  }
+
+protected:
+  /// data
+  /// Argument column
+  int xColumn_;
+  /// Cost column
+  int yColumn_;
+  /// Number of breakpoints
+  int numberPoints_;
+  /// x of breakpoints (increasing)
+  double *x_;
+  /// f of breakpoints
+  double *f_;
+};
+/** Piecewise linear branching object class.
+    Either one arm which just adds envelope cut or two arms
+    x <= breakpoint and x >= breakpoint each with own envelope cut
+ */
+class CBCLIB_EXPORT CbcPiecewiseBranchingObject : public CbcBranchingObject {
+
+public:
+  // Default Constructor
+  CbcPiecewiseBranchingObject();
+
+  /// Useful constructor - just adds cut
+  CbcPiecewiseBranchingObject(CbcModel *model, const CbcPiecewise *piecewise,
+    const OsiRowCut &cut);
+
+  /// Useful constructor - splits x at value
+  CbcPiecewiseBranchingObject(CbcModel *model, const CbcPiecewise *piecewise,
+    int way, double value, const OsiRowCut &down, const OsiRowCut &up);
+
+  // Copy constructor
+  CbcPiecewiseBranchingObject(const CbcPiecewiseBranchingObject &);
+
+  // Assignment operator
+  CbcPiecewiseBranchingObject &operator=(const CbcPiecewiseBranchingObject &rhs);
+
+  /// Clone
+  virtual CbcBranchingObject *clone() const;
+
+  // Destructor
+  virtual ~CbcPiecewiseBranchingObject();
+
+  using CbcBranchingObject::branch;
+  /// Does next branch and updates state
+  virtual double branch();
+
+  using CbcBranchingObject::print;
+  /** \brief Print something about branch - only if log level high
+    */
+  virtual void print();
+
+  /** Return the type (an integer identifier) of \c this */
+  virtual CbcBranchObjType type() const
+  {
+    return PiecewiseBranchObj;
+  }
+
+  /** Compare the original object of \c this with the original object of \c
+        brObj.  Ordered by argument column.
+    */
+  virtual int compareOriginalObject(const CbcBranchingObject *brObj) const;
+
+  /** Compare the \c this with \c brObj.  Same way and split is same
+        region, otherwise overlap is not worked out.
+     */
+  virtual CbcRangeCompare compareBranchingObject(const CbcBranchingObject *brObj, const bool replaceIfOverlap = false);
+
+private:
+  /// Points back to object
+  const CbcPiecewise *object_;
+  /// Cut for down arm
+  OsiRowCut down_;
+  /// Cut for up arm (or only arm)
+  OsiRowCut up_;
+  /// Whether x is split (two arms)
+  bool split_;
+};
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
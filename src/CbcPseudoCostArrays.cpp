@@ -0,0 +1,275 @@
+// Copyright (C) 2005, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#pragma warning(disable : 4786)
+#endif
+
+#include "CbcConfig.h"
+
+#include <cassert>
+#include <cmath>
+#include <typeinfo>
+
+#include "CoinHelperFunctions.hpp"
+#include "CbcModel.hpp"
+#include "CbcSimpleIntegerDynamicPseudoCost.hpp"
+#include "CbcPseudoCostArrays.hpp"
+
+/* Scores here follow the default settings of
+   CbcSimpleIntegerDynamicPseudoCost::infeasibility - with other settings
+   everything is left to the virtual method */
+#if TYPE2 == 0 && INFEAS == 1 && MOD_SHADOW == 1 && defined(WEIGHT_PRODUCT)
+#define CBC_BATCH_SCORES
+#endif
+#ifndef INFEAS_MULTIPLIER
+#define INFEAS_MULTIPLIER 1.5
+#endif
+
+// Default Constructor
+CbcPseudoCostArrays::CbcPseudoCostArrays()
+  : object_(NULL)
+  , which_(NULL)
+  , column_(NULL)
+  , list_(NULL)
+  , value_(NULL)
+  , sumDownCost_(NULL)
+  , sumUpCost_(NULL)
+  , downDynamicPseudoCost_(NULL)
+  , upDynamicPseudoCost_(NULL)
+  , downShadowPrice_(NULL)
+  , upShadowPrice_(NULL)
+  , numberTimesDown_(NULL)
+  , numberTimesUp_(NULL)
+  , numberTimesDownInfeasible_(NULL)
+  , numberTimesUpInfeasible_(NULL)
+  , numberBeforeTrust_(NULL)
+  , infeasibility_(NULL)
+  , downEstimate_(NULL)
+  , upEstimate_(NULL)
+  , numberObjects_(-1)
+  , numberEntries_(0)
+  , numberFractional_(0)
+{
+}
+
+// Destructor
+CbcPseudoCostArrays::~CbcPseudoCostArrays()
+{
+  delete[] object_;
+  delete[] which_;
+  delete[] value_;
+  delete[] numberTimesDown_;
+  delete[] infeasibility_;
+}
+
+// Build entries from objects of model
+void CbcPseudoCostArrays::build(const CbcModel *model)
+{
+  delete[] object_;
+  delete[] which_;
+  delete[] value_;
+  delete[] numberTimesDown_;
+  delete[] infeasibility_;
+  object_ = NULL;
+  which_ = NULL;
+  column_ = NULL;
+  list_ = NULL;
+  value_ = NULL;
+  numberTimesDown_ = NULL;
+  infeasibility_ = NULL;
+  downEstimate_ = NULL;
+  upEstimate_ = NULL;
+  numberEntries_ = 0;
+  numberFractional_ = 0;
+  numberObjects_ = model->numberObjects();
+  OsiObject **objects = model->objects();
+  int n = 0;
+  for (int i = 0; i < numberObjects_; i++) {
+    const OsiObject *object = objects[i];
+    // not derived classes as they may do something different
+    if (typeid(*object) != typeid(CbcSimpleIntegerDynamicPseudoCost))
+      continue;
+    const CbcSimpleIntegerDynamicPseudoCost *dynamicObject = static_cast< const CbcSimpleIntegerDynamicPseudoCost * >(object);
+    if (dynamicObject->model() == model && !dynamicObject->method()
+      && dynamicObject->priority() != -999)
+      n++;
+  }
+  if (!n)
+    return;
+  object_ = new CbcSimpleIntegerDynamicPseudoCost *[n];
+  which_ = new int[3 * n];
+  column_ = which_ + n;
+  list_ = column_ + n;
+  value_ = new double[7 * n];
+  sumDownCost_ = value_ + n;
+  sumUpCost_ = sumDownCost_ + n;
+  downDynamicPseudoCost_ = sumUpCost_ + n;
+  upDynamicPseudoCost_ = downDynamicPseudoCost_ + n;
+  downShadowPrice_ = upDynamicPseudoCost_ + n;
+  upShadowPrice_ = downShadowPrice_ + n;
+  numberTimesDown_ = new int[5 * n];
+  numberTimesUp_ = numberTimesDown_ + n;
+  numberTimesDownInfeasible_ = numberTimesUp_ + n;
+  numberTimesUpInfeasible_ = numberTimesDownInfeasible_ + n;
+  numberBeforeTrust_ = numberTimesUpInfeasible_ + n;
+  infeasibility_ = new double[3 * numberObjects_];
+  downEstimate_ = infeasibility_ + numberObjects_;
+  upEstimate_ = downEstimate_ + numberObjects_;
+  for (int i = 0; i < numberObjects_; i++) {
+    infeasibility_[i] = -1.0;
+    OsiObject *object = objects[i];
+    if (typeid(*object) != typeid(CbcSimpleIntegerDynamicPseudoCost))
+      continue;
+    CbcSimpleIntegerDynamicPseudoCost *dynamicObject = static_cast< CbcSimpleIntegerDynamicPseudoCost * >(object);
+    if (dynamicObject->model() == model && !dynamicObject->method()
+      && dynamicObject->priority() != -999) {
+      object_[numberEntries_] = dynamicObject;
+      which_[numberEntries_] = i;
+      column_[numberEntries_++] = dynamicObject->columnNumber();
+    }
+  }
+  assert(numberEntries_ == n);
+}
+
+// Make sure entries match objects of model
+bool CbcPseudoCostArrays::check(const CbcModel *model)
+{
+#ifdef CBC_BATCH_SCORES
+  bool same = (numberObjects_ == model->numberObjects());
+  if (same) {
+    OsiObject **objects = model->objects();
+    for (int k = 0; k < numberEntries_; k++) {
+      if (objects[which_[k]] != object_[k]) {
+        same = false;
+        break;
+      }
+    }
+  }
+  if (!same)
+    build(model);
+  return numberEntries_ > 0;
+#else
+  return false;
+#endif
+}
+
+// Get pseudocost data for fractional entries from objects
+void CbcPseudoCostArrays::gather()
+{
+  for (int j = 0; j < numberFractional_; j++) {
+    const CbcSimpleIntegerDynamicPseudoCost *object = object_[list_[j]];
+    sumDownCost_[j] = object->sumDownCost();
+    sumUpCost_[j] = object->sumUpCost();
+    downDynamicPseudoCost_[j] = object->downDynamicPseudoCost();
+    upDynamicPseudoCost_[j] = object->upDynamicPseudoCost();
+    downShadowPrice_[j] = object->downShadowPrice();
+    upShadowPrice_[j] = object->upShadowPrice();
+    numberTimesDown_[j] = object->numberTimesDown();
+    numberTimesUp_[j] = object->numberTimesUp();
+    numberTimesDownInfeasible_[j] = object->numberTimesDownInfeasible();
+    numberTimesUpInfeasible_[j] = object->numberTimesUpInfeasible();
+    numberBeforeTrust_[j] = object->numberBeforeTrust();
+  }
+}
+
+/* Infeasibility of every object as infeasibility() would give it.
+   First pass finds fractional entries, second works out their scores. */
+const double *CbcPseudoCostArrays::infeasibilities(const CbcModel *model)
+{
+#ifdef CBC_BATCH_SCORES
+  const double *solution = model->testSolution();
+  const double *lower = model->getCbcColLower();
+  const double *upper = model->getCbcColUpper();
+  double integerTolerance = model->getDblParam(CbcModel::CbcIntegerTolerance);
+  numberFractional_ = 0;
+  for (int k = 0; k < numberEntries_; k++) {
+    int iColumn = column_[k];
+    double value = solution[iColumn];
+    value = CoinMax(value, lower[iColumn]);
+    value = CoinMin(value, upper[iColumn]);
+    double nearest = floor(value + 0.5);
+    // fixed or integral give zero
+    infeasibility_[which_[k]] = 0.0;
+    if (upper[iColumn] != lower[iColumn] && fabs(value - nearest) > integerTolerance) {
+      value_[numberFractional_] = value;
+      list_[numberFractional_++] = k;
+    }
+  }
+  if (!numberFractional_)
+    return infeasibility_;
+  gather();
+  double objectiveValue = model->getCurrentMinimizationObjValue();
+  double distanceToCutoff = model->getCutoff() - objectiveValue;
+  if (distanceToCutoff < 1.0e20)
+    distanceToCutoff *= 10.0;
+  else
+    distanceToCutoff = 1.0e2 + fabs(objectiveValue);
+  distanceToCutoff = CoinMax(distanceToCutoff, 1.0e-12 * (1.0 + fabs(objectiveValue)));
+  bool noSolution = (model->stateOfSearch() % 10) < 1;
+  double minProductWeight = model->getDblParam(CbcModel::CbcSmallChange);
+  for (int j = 0; j < numberFractional_; j++) {
+    int k = list_[j];
+    int iColumn = column_[k];
+    double value = value_[j];
+    double below = floor(value + integerTolerance);
+    double above = below + 1.0;
+    if (above > upper[iColumn]) {
+      above = below;
+      below = above - 1;
+    }
+    double sum;
+    double number;
+    // estimates as downEstimate and upEstimate
+    downEstimate_[which_[k]] = CoinMax((value - below) * downDynamicPseudoCost_[j], 0.0);
+    upEstimate_[which_[k]] = CoinMax((above - value) * upDynamicPseudoCost_[j], 0.0);
+    double downCost = CoinMax(value - below, 0.0);
+    sum = sumDownCost_[j];
+    number = numberTimesDown_[j];
+    sum += INFEAS_MULTIPLIER * numberTimesDownInfeasible_[j] * CoinMax(distanceToCutoff / (downCost + 1.0e-12), sumDownCost_[j]);
+    if (!downShadowPrice_[j]) {
+      if (number > 0.0)
+        downCost *= sum / number;
+      else
+        downCost *= downDynamicPseudoCost_[j];
+    } else if (downShadowPrice_[j] > 0.0) {
+      downCost *= downShadowPrice_[j];
+    } else {
+      downCost *= (downDynamicPseudoCost_[j] - downShadowPrice_[j]);
+    }
+    double upCost = CoinMax((above - value), 0.0);
+    sum = sumUpCost_[j];
+    number = numberTimesUp_[j];
+    sum += INFEAS_MULTIPLIER * numberTimesUpInfeasible_[j] * CoinMax(distanceToCutoff / (upCost + 1.0e-12), sumUpCost_[j]);
+    if (!upShadowPrice_[j]) {
+      if (number > 0.0)
+        upCost *= sum / number;
+      else
+        upCost *= upDynamicPseudoCost_[j];
+    } else if (upShadowPrice_[j] > 0.0) {
+      upCost *= upShadowPrice_[j];
+    } else {
+      upCost *= (upDynamicPseudoCost_[j] - upShadowPrice_[j]);
+    }
+    double minValue = CoinMin(downCost, upCost);
+    double maxValue = CoinMax(downCost, upCost);
+    double returnValue;
+    if (noSolution)
+      returnValue = WEIGHT_BEFORE * minValue + (1.0 - WEIGHT_BEFORE) * maxValue;
+    else
+      returnValue = CoinMax(minValue, minProductWeight) * CoinMax(maxValue, minProductWeight);
+    if (numberTimesUp_[j] < numberBeforeTrust_[j] || numberTimesDown_[j] < numberBeforeTrust_[j]) {
+      returnValue *= 1.0e3;
+      if (!numberTimesUp_[j] && !numberTimesDown_[j])
+        returnValue *= 1.0e10;
+    }
+    infeasibility_[which_[k]] = CoinMax(returnValue, 1.0e-15);
+  }
+#endif
+  return infeasibility_;
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -0,0 +1,122 @@
+// Copyright (C) 2005, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcPseudoCostArrays_H
+#define CbcPseudoCostArrays_H
+
+#include "CbcConfig.h"
+
+class CbcModel;
+class CbcSimpleIntegerDynamicPseudoCost;
+
+/** Pseudocosts of simple dynamic integer objects in contiguous arrays
+
+    CbcNode::chooseDynamicBranch asks every object for its infeasibility
+    through a virtual call and most of the answers (for large models) are
+    zero.  This keeps, for the objects which are exactly
+    CbcSimpleIntegerDynamicPseudoCost, the column numbers in one array so
+    integral and fixed columns can be found in one pass over the model's
+    solution and bounds.  For the fractional ones pseudocost data is then
+    gathered from the objects into arrays and the scores worked out in
+    a second pass, with the same arithmetic as
+    CbcSimpleIntegerDynamicPseudoCost::infeasibility.  Both loops are plain
+    loops over arrays so the compiler is free to vectorize them.  The same
+    pass gives the down and up estimates (as downEstimate and upEstimate)
+    which chooseDynamicBranch adds up for the node estimate.
+
+    Other objects (SOS, cliques, lotsizing ...) are left to the virtual
+    method.  Used if CbcModel::CbcBatchPseudoCosts is set.
+*/
+class CBCLIB_EXPORT CbcPseudoCostArrays {
+
+public:
+  /// Default Constructor
+  CbcPseudoCostArrays();
+  /// Destructor
+  ~CbcPseudoCostArrays();
+
+  /** Make sure entries match objects of model (rebuilt if not).
+      Returns false if nothing can be done here (so caller should
+      use virtual methods).  Priorities and methods are taken when
+      entries are built.
+    */
+  bool check(const CbcModel *model);
+  /** Infeasibility of every object as infeasibility() would give it.
+      Array is indexed by object and has -1.0 for objects not kept
+      here (caller must ask object).  Uses model's testSolution and bounds.
+    */
+  const double *infeasibilities(const CbcModel *model);
+  /** Down estimate of every object as downEstimate() would give it -
+      only valid where last infeasibilities gave a positive value */
+  inline const double *downEstimates() const
+  {
+    return downEstimate_;
+  }
+  /// Up estimates (as downEstimates)
+  inline const double *upEstimates() const
+  {
+    return upEstimate_;
+  }
+  /// Number of objects kept here
+  inline int numberEntries() const
+  {
+    return numberEntries_;
+  }
+  /// Number fractional at last infeasibilities
+  inline int numberFractional() const
+  {
+    return numberFractional_;
+  }
+
+private:
+  /// Build entries from objects of model
+  void build(const CbcModel *model);
+  /// Get pseudocost data for fractional entries from objects
+  void gather();
+
+private:
+  /// Illegal copy constructor
+  CbcPseudoCostArrays(const CbcPseudoCostArrays &);
+  /// Illegal assignment operator
+  CbcPseudoCostArrays &operator=(const CbcPseudoCostArrays &);
+
+  /// Objects (as in model when built)
+  CbcSimpleIntegerDynamicPseudoCost **object_;
+  /// Object number of each entry
+  int *which_;
+  /// Column of each entry
+  int *column_;
+  /// Entries in list (fractional ones)
+  int *list_;
+  /// Value of column for fractional entries (position in list)
+  double *value_;
+  /// Pseudocost data for fractional entries (position in list)
+  double *sumDownCost_;
+  double *sumUpCost_;
+  double *downDynamicPseudoCost_;
+  double *upDynamicPseudoCost_;
+  double *downShadowPrice_;
+  double *upShadowPrice_;
+  int *numberTimesDown_;
+  int *numberTimesUp_;
+  int *numberTimesDownInfeasible_;
+  int *numberTimesUpInfeasible_;
+  int *numberBeforeTrust_;
+  /// Infeasibility of each object (-1.0 if not kept here)
+  double *infeasibility_;
+  /// Down and up estimates of each object (for fractional entries)
+  double *downEstimate_;
+  double *upEstimate_;
+  /// Number of objects in model when built
+  int numberObjects_;
+  /// Number of entries
+  int numberEntries_;
+  /// Number fractional at last pass
+  int numberFractional_;
+};
+
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -12,6 +12,7 @@
 #include <cstdlib>
 #include <cmath>
 #include <cfloat>
+#include <algorithm>
 //#define CBC_DEBUG
 
 #include "CoinTypes.h"
@@ -250,12 +251,8 @@ CbcSOS::infeasibility(const OsiBranchingInformation *info,
       weight = 0.5 * (weights_[firstNonZero] + weights_[lastNonZero]);
     if (info->defaultDual_ >= 0.0 && info->usefulRegion_ && info->columnStart_) {
       assert(sosType_ == 1);
-      int iWhere;
-      for (iWhere = firstNonZero; iWhere < lastNonZero - 1; iWhere++) {
-        if (weight < weights_[iWhere + 1]) {
-          break;
-        }
-      }
+      int iWhere = CoinMin(separatorIndex(weight, firstNonZero, lastNonZero),
+        lastNonZero - 1);
       int jColumnDown = members_[iWhere];
       int jColumnUp = members_[iWhere + 1];
       int n = 0;
@@ -558,11 +555,8 @@ CbcSOS::createCbcBranch(OsiSolverInterface *solver, const OsiBranchingInformatio
     weight /= sum;
   else
     weight = 0.5*(weights_[firstNonZero]+weights_[lastNonZero]);
-  int iWhere;
+  int iWhere = separatorIndex(weight, firstNonZero, lastNonZero);
   double separator = 0.0;
-  for (iWhere = firstNonZero; iWhere < lastNonZero; iWhere++)
-    if (weight < weights_[iWhere+1])
-      break;
   // If we are dealing with really oddly scaled problems 
   // was assert (iWhere<lastNonZero);
   if (iWhere==lastNonZero)
@@ -769,12 +763,9 @@ CbcSOS::solverBranch() const
   else
     weight = 0.5*(weights_[firstNonZero]+weights_[lastNonZero]);
   // down branch fixes ones above weight to 0
-  int iWhere;
+  int iWhere = separatorIndex(weight, firstNonZero, lastNonZero);
   int iDownStart = 0;
   int iUpEnd = 0;
-  for (iWhere = firstNonZero; iWhere < lastNonZero; iWhere++)
-    if (weight < weights_[iWhere+1])
-      break;
   if (sosType_ == 1) {
     // SOS 1
     iUpEnd = iWhere + 1;
@@ -796,6 +787,16 @@ CbcSOS::solverBranch() const
   delete[] which;
   return branch;
 }
+/* Where to branch - first iWhere in firstNonZero..lastNonZero-1 with
+   weight < weights_[iWhere+1] (lastNonZero if none).  Weights are
+   increasing so binary search.
+*/
+int CbcSOS::separatorIndex(double weight, int firstNonZero, int lastNonZero) const
+{
+  const double *where = std::upper_bound(weights_ + firstNonZero + 1,
+    weights_ + lastNonZero + 1, weight);
+  return static_cast< int >(where - weights_) - 1;
+}
 // Construct an OsiSOS object
 OsiSOS *
 CbcSOS::osiObject(const OsiSolverInterface *solver) const
@@ -903,11 +904,10 @@ CbcSOSBranchingObject::branch()
 #endif
   // *** for way - up means fix all those in down section
   if (way_ < 0) {
-    int i;
-    for (i = 0; i < numberMembers; i++) {
-      if (weights[i] > separator_)
-        break;
-    }
+    // first with weight above separator
+    int i = static_cast< int >(std::upper_bound(weights, weights + numberMembers,
+                                 separator_)
+      - weights);
     assert(i < numberMembers);
     for (; i < numberMembers; i++) {
 #ifdef CBC_INVESTIGATE_SOS
@@ -958,11 +958,10 @@ void CbcSOSBranchingObject::fix(OsiSolverInterface *solver,
   //const double * upper = solver->getColUpper();
   // *** for way - up means fix all those in down section
   if (branchState < 0) {
-    int i;
-    for (i = 0; i < numberMembers; i++) {
-      if (weights[i] > separator_)
-        break;
-    }
+    // first with weight above separator
+    int i = static_cast< int >(std::upper_bound(weights, weights + numberMembers,
+                                 separator_)
+      - weights);
     assert(i < numberMembers);
     for (; i < numberMembers; i++) {
       solver->setColLower(which[i], 0.0);
@@ -151,6 +151,12 @@ public:
     integerValued_ = yesNo;
   }
 
+protected:
+  /** Where to branch for weighted average weight - first iWhere in
+      firstNonZero..lastNonZero-1 with weight < weights_[iWhere+1] or
+      lastNonZero if none (binary search) */
+  int separatorIndex(double weight, int firstNonZero, int lastNonZero) const;
+
 protected:
   /// data
 
@@ -0,0 +1,73 @@
+// Copyright (C) 2002, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#pragma warning(disable : 4786)
+#endif
+
+#include "CbcConfig.h"
+
+#include <cstdlib>
+
+#include "OsiSolverInterface.hpp"
+#include "CbcSeparationContext.hpp"
+
+// Default Constructor
+CbcSeparationContext::CbcSeparationContext()
+  : solver_(NULL)
+  , matrixByRow_(NULL)
+  , matrixByColumn_(NULL)
+  , colSolution_(NULL)
+  , rowPrice_(NULL)
+  , reducedCost_(NULL)
+  , rowActivity_(NULL)
+  , colLower_(NULL)
+  , colUpper_(NULL)
+  , rowLower_(NULL)
+  , rowUpper_(NULL)
+  , objectiveValue_(0.0)
+  , numberRows_(0)
+  , numberColumns_(0)
+  , numberBuilds_(0)
+{
+}
+
+// Destructor
+CbcSeparationContext::~CbcSeparationContext()
+{
+}
+
+// Take view of solver
+void CbcSeparationContext::build(const OsiSolverInterface *solver)
+{
+  solver_ = solver;
+  numberBuilds_++;
+  numberRows_ = solver->getNumRows();
+  numberColumns_ = solver->getNumCols();
+  // these may be made by solver on first request
+  matrixByRow_ = solver->getMatrixByRow();
+  matrixByColumn_ = solver->getMatrixByCol();
+  rowActivity_ = solver->getRowActivity();
+  colSolution_ = solver->getColSolution();
+  rowPrice_ = solver->getRowPrice();
+  reducedCost_ = solver->getReducedCost();
+  colLower_ = solver->getColLower();
+  colUpper_ = solver->getColUpper();
+  rowLower_ = solver->getRowLower();
+  rowUpper_ = solver->getRowUpper();
+  objectiveValue_ = solver->getObjValue();
+}
+
+// Primal solution of solver - from view if view of solver
+const double *CbcSeparationContext::colSolution(const OsiSolverInterface *solver) const
+{
+  if (valid(solver))
+    return colSolution_;
+  else
+    return solver->getColSolution();
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -0,0 +1,141 @@
+// Copyright (C) 2002, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcSeparationContext_H
+#define CbcSeparationContext_H
+
+#include "CbcConfig.h"
+#include "CoinTypes.hpp"
+
+class OsiSolverInterface;
+class CoinPackedMatrix;
+
+/** Read-only view of an LP solution for one round of cut generation
+
+    Cut generators are handed the whole solver and each asks again for
+    the row copy and the primal and dual vectors.  Some of these are built
+    lazily by the solver (row copy, row activities) and Cbc code after each
+    generator asks for them again.  build() gets every array once, so lazy
+    ones are made before the first generator (and before the solver is
+    cloned for threads) and the rest of the round just uses pointers.
+    Nothing is copied - the view is only valid while the solver is not
+    changed, so solveWithCuts builds it at the start of a round, serialCuts
+    builds it again after any resolve and it is invalidated when cuts are
+    added.
+*/
+class CBCLIB_EXPORT CbcSeparationContext {
+
+public:
+  /// Default Constructor
+  CbcSeparationContext();
+  /// Destructor
+  ~CbcSeparationContext();
+
+  /// Take view of solver (which must not change while view is used)
+  void build(const OsiSolverInterface *solver);
+  /// Forget view
+  inline void invalidate()
+  {
+    solver_ = NULL;
+  }
+  /// True if view of this solver
+  inline bool valid(const OsiSolverInterface *solver) const
+  {
+    return solver_ && solver_ == solver;
+  }
+  /// Primal solution of solver - from view if view of solver
+  const double *colSolution(const OsiSolverInterface *solver) const;
+  /// Number of times view built
+  inline int numberBuilds() const
+  {
+    return numberBuilds_;
+  }
+
+  /**@name Arrays of view (only if valid) */
+  //@{
+  inline int numberRows() const
+  {
+    return numberRows_;
+  }
+  inline int numberColumns() const
+  {
+    return numberColumns_;
+  }
+  inline const CoinPackedMatrix *matrixByRow() const
+  {
+    return matrixByRow_;
+  }
+  inline const CoinPackedMatrix *matrixByColumn() const
+  {
+    return matrixByColumn_;
+  }
+  inline const double *colSolution() const
+  {
+    return colSolution_;
+  }
+  inline const double *rowPrice() const
+  {
+    return rowPrice_;
+  }
+  inline const double *reducedCost() const
+  {
+    return reducedCost_;
+  }
+  inline const double *rowActivity() const
+  {
+    return rowActivity_;
+  }
+  inline const double *colLower() const
+  {
+    return colLower_;
+  }
+  inline const double *colUpper() const
+  {
+    return colUpper_;
+  }
+  inline const double *rowLower() const
+  {
+    return rowLower_;
+  }
+  inline const double *rowUpper() const
+  {
+    return rowUpper_;
+  }
+  /// Objective value of solver when view taken
+  inline double objectiveValue() const
+  {
+    return objectiveValue_;
+  }
+  //@}
+
+private:
+  /// Illegal copy constructor
+  CbcSeparationContext(const CbcSeparationContext &);
+  /// Illegal assignment operator
+  CbcSeparationContext &operator=(const CbcSeparationContext &);
+
+private:
+  /// Solver of view (NULL if not valid)
+  const OsiSolverInterface *solver_;
+  const CoinPackedMatrix *matrixByRow_;
+  const CoinPackedMatrix *matrixByColumn_;
+  const double *colSolution_;
+  const double *rowPrice_;
+  const double *reducedCost_;
+  const double *rowActivity_;
+  const double *colLower_;
+  const double *colUpper_;
+  const double *rowLower_;
+  const double *rowUpper_;
+  double objectiveValue_;
+  int numberRows_;
+  int numberColumns_;
+  /// Number of times view built
+  int numberBuilds_;
+};
+
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -446,12 +446,15 @@ CbcIntegerBranchingObject::branch()
         iColumn, olb, oub, down_[0], down_[1]);
     }
 #endif
+    // only bound which changes (binary - just upper)
 #ifndef CBCSIMPLE_TIGHTEN_BOUNDS
-    model_->solver()->setColLower(iColumn, down_[0]);
+    if (down_[0] != olb)
+      model_->solver()->setColLower(iColumn, down_[0]);
 #else
     model_->solver()->setColLower(iColumn, CoinMax(down_[0], olb));
 #endif
-    model_->solver()->setColUpper(iColumn, down_[1]);
+    if (down_[1] != oub)
+      model_->solver()->setColUpper(iColumn, down_[1]);
     //#define CBC_PRINT2
 #ifdef CBC_PRINT2
     printf("%d branching down has bounds %g %g", iColumn, down_[0], down_[1]);
@@ -496,9 +499,12 @@ CbcIntegerBranchingObject::branch()
         iColumn, olb, oub, up_[0], up_[1]);
     }
 #endif
-    model_->solver()->setColLower(iColumn, up_[0]);
+    // only bound which changes (binary - just lower)
+    if (up_[0] != olb)
+      model_->solver()->setColLower(iColumn, up_[0]);
 #ifndef CBCSIMPLE_TIGHTEN_BOUNDS
-    model_->solver()->setColUpper(iColumn, up_[1]);
+    if (up_[1] != oub)
+      model_->solver()->setColUpper(iColumn, up_[1]);
 #else
     model_->solver()->setColUpper(iColumn, CoinMin(up_[1], oub));
 #endif
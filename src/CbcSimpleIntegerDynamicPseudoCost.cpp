@@ -141,6 +141,10 @@ CbcSimpleIntegerDynamicPseudoCost::CbcSimpleIntegerDynamicPseudoCost()
   , numberTimesDownTotalFixed_(0.0)
   , numberTimesUpTotalFixed_(0.0)
   , numberTimesProbingTotal_(0)
+  , sumDownInference_(0.0)
+  , sumUpInference_(0.0)
+  , numberDownInference_(0)
+  , numberUpInference_(0)
   , method_(0)
 {
 }
@@ -175,6 +179,10 @@ CbcSimpleIntegerDynamicPseudoCost::CbcSimpleIntegerDynamicPseudoCost(CbcModel *m
   , numberTimesDownTotalFixed_(0.0)
   , numberTimesUpTotalFixed_(0.0)
   , numberTimesProbingTotal_(0)
+  , sumDownInference_(0.0)
+  , sumUpInference_(0.0)
+  , numberDownInference_(0)
+  , numberUpInference_(0)
   , method_(0)
 {
   const double *cost = model->getObjCoefficients();
@@ -239,6 +247,10 @@ CbcSimpleIntegerDynamicPseudoCost::CbcSimpleIntegerDynamicPseudoCost(CbcModel *m
   , numberTimesDownTotalFixed_(0.0)
   , numberTimesUpTotalFixed_(0.0)
   , numberTimesProbingTotal_(0)
+  , sumDownInference_(0.0)
+  , sumUpInference_(0.0)
+  , numberDownInference_(0)
+  , numberUpInference_(0)
   , method_(0)
 {
   downDynamicPseudoCost_ = downDynamicPseudoCost;
@@ -310,6 +322,10 @@ CbcSimpleIntegerDynamicPseudoCost::CbcSimpleIntegerDynamicPseudoCost(const CbcSi
   , numberTimesDownTotalFixed_(rhs.numberTimesDownTotalFixed_)
   , numberTimesUpTotalFixed_(rhs.numberTimesUpTotalFixed_)
   , numberTimesProbingTotal_(rhs.numberTimesProbingTotal_)
+  , sumDownInference_(rhs.sumDownInference_)
+  , sumUpInference_(rhs.sumUpInference_)
+  , numberDownInference_(rhs.numberDownInference_)
+  , numberUpInference_(rhs.numberUpInference_)
   , method_(rhs.method_)
 
 {
@@ -353,6 +369,10 @@ CbcSimpleIntegerDynamicPseudoCost::operator=(const CbcSimpleIntegerDynamicPseudo
     numberTimesDownTotalFixed_ = rhs.numberTimesDownTotalFixed_;
     numberTimesUpTotalFixed_ = rhs.numberTimesUpTotalFixed_;
     numberTimesProbingTotal_ = rhs.numberTimesProbingTotal_;
+    sumDownInference_ = rhs.sumDownInference_;
+    sumUpInference_ = rhs.sumUpInference_;
+    numberDownInference_ = rhs.numberDownInference_;
+    numberUpInference_ = rhs.numberUpInference_;
     method_ = rhs.method_;
   }
   return *this;
@@ -388,6 +408,10 @@ void CbcSimpleIntegerDynamicPseudoCost::copySome(const CbcSimpleIntegerDynamicPs
   numberTimesDownTotalFixed_ = otherObject->numberTimesDownTotalFixed_;
   numberTimesUpTotalFixed_ = otherObject->numberTimesUpTotalFixed_;
   numberTimesProbingTotal_ = otherObject->numberTimesProbingTotal_;
+  sumDownInference_ = otherObject->sumDownInference_;
+  sumUpInference_ = otherObject->sumUpInference_;
+  numberDownInference_ = otherObject->numberDownInference_;
+  numberUpInference_ = otherObject->numberUpInference_;
 }
 // Updates stuff like pseudocosts before threads
 void CbcSimpleIntegerDynamicPseudoCost::updateBefore(const OsiObject *rhs)
@@ -448,6 +472,10 @@ void CbcSimpleIntegerDynamicPseudoCost::updateAfter(const OsiObject *rhs, const
   numberTimesDownTotalFixed_ += rhsObject->numberTimesDownTotalFixed_ - baseObject->numberTimesDownTotalFixed_;
   numberTimesUpTotalFixed_ += rhsObject->numberTimesUpTotalFixed_ - baseObject->numberTimesUpTotalFixed_;
   numberTimesProbingTotal_ += rhsObject->numberTimesProbingTotal_ - baseObject->numberTimesProbingTotal_;
+  sumDownInference_ += rhsObject->sumDownInference_ - baseObject->sumDownInference_;
+  sumUpInference_ += rhsObject->sumUpInference_ - baseObject->sumUpInference_;
+  numberDownInference_ += rhsObject->numberDownInference_ - baseObject->numberDownInference_;
+  numberUpInference_ += rhsObject->numberUpInference_ - baseObject->numberUpInference_;
   if (numberTimesDown_ > 0) {
     setDownDynamicPseudoCost(sumDown / static_cast< double >(numberTimesDown_));
   }
@@ -508,6 +536,14 @@ bool CbcSimpleIntegerDynamicPseudoCost::same(const CbcSimpleIntegerDynamicPseudo
     okay = false;
   if (numberTimesProbingTotal_ != otherObject->numberTimesProbingTotal_)
     okay = false;
+  if (sumDownInference_ != otherObject->sumDownInference_)
+    okay = false;
+  if (sumUpInference_ != otherObject->sumUpInference_)
+    okay = false;
+  if (numberDownInference_ != otherObject->numberDownInference_)
+    okay = false;
+  if (numberUpInference_ != otherObject->numberUpInference_)
+    okay = false;
   return okay;
 }
 /* Create an OsiSolverBranch object
@@ -847,6 +883,27 @@ CbcSimpleIntegerDynamicPseudoCost::createCbcBranch(OsiSolverInterface * /*solver
   assert(value >= info->lower_[columnNumber_] && value <= info->upper_[columnNumber_]);
   CbcDynamicPseudoCostBranchingObject *newObject = new CbcDynamicPseudoCostBranchingObject(model_, columnNumber_, way,
     value, this);
+  int splitRange = model_->getIntParam(CbcModel::CbcSplitRange);
+  if (splitRange && !info->hotstartSolution_) {
+    /* Wide domain - if solution is in outer quarter of range
+       one unit at a time would take many levels so halve domain.
+       Branching value stays as solution so pseudo costs know distance */
+    double lower = info->lower_[columnNumber_];
+    double upper = info->upper_[columnNumber_];
+    double range = upper - lower;
+    if (range > splitRange
+      && (floor(value) - lower < 0.25 * range || upper - ceil(value) < 0.25 * range)) {
+      double middle = floor(0.5 * (lower + upper));
+      double down[2];
+      double up[2];
+      down[0] = newObject->downBounds()[0];
+      down[1] = middle;
+      up[0] = middle + 1.0;
+      up[1] = newObject->upBounds()[1];
+      newObject->setDownBounds(down);
+      newObject->setUpBounds(up);
+    }
+  }
   double up = upDynamicPseudoCost_ * (ceil(value) - value);
   double down = downDynamicPseudoCost_ * (value - floor(value));
   double changeInGuessed = up - down;
@@ -1013,6 +1070,15 @@ CbcSimpleIntegerDynamicPseudoCost::createUpdateInformation(const OsiSolverInterf
   CbcObjectUpdateData newData(this, way,
     change, iStatus,
     originalUnsatisfied - unsatisfied, value);
+  const CbcIntegerBranchingObject *integerBranch = dynamic_cast< const CbcIntegerBranchingObject * >(branchingObject);
+  if (integerBranch && integerBranch->downBounds()[1] != -COIN_DBL_MAX
+    && integerBranch->downBounds()[1] != floor(value)) {
+    // range was split - distance to new bound
+    if (way < 0)
+      newData.movement_ = CoinMax(0.0, value - integerBranch->downBounds()[1]);
+    else
+      newData.movement_ = CoinMax(0.0, integerBranch->upBounds()[0] - value);
+  }
   newData.originalObjective_ = originalValue;
   // Solvers know about direction
   double direction = solver->getObjSense();
@@ -1034,9 +1100,11 @@ void CbcSimpleIntegerDynamicPseudoCost::updateInformation(const CbcObjectUpdateD
   hist.where_ = 'U'; // need to tell if hot
 #endif
   double movement = 0.0;
+  if (!data.movement_)
+    return; // range split and solution still in branch so nothing learnt
   if (way < 0) {
     // down
-    movement = value - floor(value);
+    movement = data.movement_ < 0.0 ? value - floor(value) : data.movement_;
     if (feasible) {
 #ifdef COIN_DEVELOP
       hist.status_ = 'D';
@@ -1099,7 +1167,7 @@ void CbcSimpleIntegerDynamicPseudoCost::updateInformation(const CbcObjectUpdateD
 #endif
   } else {
     // up
-    movement = ceil(value) - value;
+    movement = data.movement_ < 0.0 ? ceil(value) - value : data.movement_;
     if (feasible) {
 #ifdef COIN_DEVELOP
       hist.status_ = 'U';
@@ -1223,6 +1291,17 @@ void CbcSimpleIntegerDynamicPseudoCost::setProbingInformation(int fixedDown, int
   numberTimesUpLocalFixed_ = fixedUp;
   numberTimesUpTotalFixed_ += fixedUp;
 }
+// Pass in number of bounds implied by a branch
+void CbcSimpleIntegerDynamicPseudoCost::addInference(int way, int numberImplied)
+{
+  if (way < 0) {
+    numberDownInference_++;
+    sumDownInference_ += numberImplied;
+  } else {
+    numberUpInference_++;
+    sumUpInference_ += numberImplied;
+  }
+}
 // Print
 void CbcSimpleIntegerDynamicPseudoCost::print(int type, double value) const
 {
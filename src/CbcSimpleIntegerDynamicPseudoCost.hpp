@@ -328,6 +328,17 @@ public:
     numberBeforeTrust_++;
   }
 
+  /// Average bounds implied by branching down (0.0 if never counted)
+  inline double averageDownInference() const
+  {
+    return numberDownInference_ ? sumDownInference_ / static_cast< double >(numberDownInference_) : 0.0;
+  }
+  /// Average bounds implied by branching up (0.0 if never counted)
+  inline double averageUpInference() const
+  {
+    return numberUpInference_ ? sumUpInference_ / static_cast< double >(numberUpInference_) : 0.0;
+  }
+
   /// Return "up" estimate
   virtual double upEstimate() const;
   /// Return "down" estimate (default 1.0e-5)
@@ -350,6 +361,9 @@ public:
   void setUpInformation(double changeObjectiveUp, int changeInfeasibilityUp);
   /// Pass in probing information
   void setProbingInformation(int fixedDown, int fixedUp);
+  /** Pass in number of bounds implied by a branch (way -1 down, +1 up)
+      e.g. fixings found when node was solved after branching on this */
+  void addInference(int way, int numberImplied);
 
   /// Print - 0 -summary, 1 just before strong
   void print(int type = 0, double value = 0.0) const;
@@ -412,6 +426,14 @@ protected:
   double numberTimesUpTotalFixed_;
   /// Number of times probing done
   int numberTimesProbingTotal_;
+  /// Total bounds implied by branching down (see addInference)
+  double sumDownInference_;
+  /// Total bounds implied by branching up
+  double sumUpInference_;
+  /// Number of times inference counted going down
+  int numberDownInference_;
+  /// Number of times inference counted going up
+  int numberUpInference_;
   /// Number of times infeasible when tested
   /** Method -
         0 - pseudo costs
@@ -0,0 +1,521 @@
+// Copyright (C) 2002, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#pragma warning(disable : 4786)
+#endif
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define CBC_SNAPSHOT_MMAP
+#endif
+
+#include "CoinPackedMatrix.hpp"
+#include "OsiClpSolverInterface.hpp"
+#include "ClpSimplex.hpp"
+#include "CbcSnapshot.hpp"
+
+// Change if layout changes
+#define CBC_SNAPSHOT_VERSION 1
+// To see if written on machine with other byte order
+#define CBC_SNAPSHOT_CHECK 0x01020304
+
+namespace {
+// Arrays in file
+enum {
+  sectionStart = 0,
+  sectionRow,
+  sectionElement,
+  sectionColumnLower,
+  sectionColumnUpper,
+  sectionObjective,
+  sectionRowLower,
+  sectionRowUpper,
+  sectionInteger,
+  sectionNames,
+  sectionPriority,
+  sectionSosStart,
+  sectionSosType,
+  sectionSosPriority,
+  sectionSosIndices,
+  sectionSosReference,
+  sectionMipStartColumn,
+  sectionMipStartValue,
+  numberSections
+};
+// Header at start of file
+typedef struct {
+  char magic[8];
+  int version;
+  int check;
+  int sizeBigIndex;
+  int numberRows;
+  int numberColumns;
+  int numberSOS;
+  int numberMipStart;
+  int spare;
+  double objectiveSense;
+  double objectiveOffset;
+  // offset and size in bytes of each array (offset 0 if absent)
+  CoinInt64 offset[numberSections];
+  CoinInt64 size[numberSections];
+} CbcSnapshotHeader;
+const char snapshotMagic[8] = { 'C', 'B', 'C', 'S', 'N', 'A', 'P', '\0' };
+// Round up to 8 bytes
+inline CoinInt64 roundUp(CoinInt64 value)
+{
+  return (value + 7) & ~static_cast< CoinInt64 >(7);
+}
+// Whether section is there with size number*width (or absent if allowed)
+inline bool goodSize(const CbcSnapshotHeader *header, int which,
+  CoinInt64 number, CoinInt64 width, bool optional)
+{
+  if (!header->offset[which])
+    return optional || !number;
+  return header->size[which] == number * width;
+}
+// Whether starts go up from 0 and indices are in range
+bool goodStarts(const char *data, const CbcSnapshotHeader *header,
+  int number, int whichStart, int whichIndex, int range, bool bigIndex)
+{
+  const CoinBigIndex *bigStart = reinterpret_cast< const CoinBigIndex * >(data + header->offset[whichStart]);
+  const int *start = reinterpret_cast< const int * >(data + header->offset[whichStart]);
+  CoinInt64 last = 0;
+  for (int i = 0; i <= number; i++) {
+    CoinInt64 value = bigIndex ? bigStart[i] : start[i];
+    if (value < last || (!i && value))
+      return false;
+    last = value;
+  }
+  if (!goodSize(header, whichIndex, last, sizeof(int), false))
+    return false;
+  const int *index = reinterpret_cast< const int * >(data + header->offset[whichIndex]);
+  for (CoinInt64 j = 0; j < last; j++) {
+    if (index[j] < 0 || index[j] >= range)
+      return false;
+  }
+  return true;
+}
+/* Whether sizes of sections agree with header, so arrays can be used
+   without going off end (offsets and alignment already checked) */
+bool goodSections(const char *data, const CbcSnapshotHeader *header)
+{
+  int numberRows = header->numberRows;
+  int numberColumns = header->numberColumns;
+  int numberSOS = header->numberSOS;
+  int numberMipStart = header->numberMipStart;
+  if (numberRows < 0 || numberColumns < 0 || numberSOS < 0 || numberMipStart < 0)
+    return false;
+  // matrix
+  if (!goodSize(header, sectionStart, numberColumns + 1, sizeof(CoinBigIndex), false)
+    || !goodStarts(data, header, numberColumns, sectionStart, sectionRow, numberRows, true))
+    return false;
+  CoinInt64 numberElements = reinterpret_cast< const CoinBigIndex * >(data + header->offset[sectionStart])[numberColumns];
+  if (!goodSize(header, sectionElement, numberElements, sizeof(double), false))
+    return false;
+  // bounds, objective and integers
+  if (!goodSize(header, sectionColumnLower, numberColumns, sizeof(double), false)
+    || !goodSize(header, sectionColumnUpper, numberColumns, sizeof(double), false)
+    || !goodSize(header, sectionObjective, numberColumns, sizeof(double), false)
+    || !goodSize(header, sectionRowLower, numberRows, sizeof(double), false)
+    || !goodSize(header, sectionRowUpper, numberRows, sizeof(double), false)
+    || !goodSize(header, sectionInteger, numberColumns, 1, false))
+    return false;
+  // names must end with a terminator
+  CoinInt64 sizeNames = header->size[sectionNames];
+  if (sizeNames && data[header->offset[sectionNames] + sizeNames - 1])
+    return false;
+  if (!goodSize(header, sectionPriority, numberColumns, sizeof(int), true))
+    return false;
+  // SOS
+  if (numberSOS) {
+    if (!goodSize(header, sectionSosStart, numberSOS + 1, sizeof(int), false)
+      || !goodSize(header, sectionSosType, numberSOS, 1, false)
+      || !goodSize(header, sectionSosPriority, numberSOS, sizeof(int), true)
+      || !goodStarts(data, header, numberSOS, sectionSosStart, sectionSosIndices, numberColumns, false))
+      return false;
+    int numberInSets = reinterpret_cast< const int * >(data + header->offset[sectionSosStart])[numberSOS];
+    if (!goodSize(header, sectionSosReference, numberInSets, sizeof(double), false))
+      return false;
+  } else if (header->offset[sectionSosStart]) {
+    return false;
+  }
+  // MIP start
+  if (!goodSize(header, sectionMipStartColumn, numberMipStart, sizeof(int), false)
+    || !goodSize(header, sectionMipStartValue, numberMipStart, sizeof(double), false))
+    return false;
+  if (numberMipStart) {
+    const int *column = reinterpret_cast< const int * >(data + header->offset[sectionMipStartColumn]);
+    for (int i = 0; i < numberMipStart; i++) {
+      if (column[i] < 0 || column[i] >= numberColumns)
+        return false;
+    }
+  }
+  return true;
+}
+}
+
+// Constructor
+CbcSnapshot::CbcSnapshot()
+  : data_(NULL)
+  , size_(0)
+  , mapped_(false)
+{
+}
+
+// Destructor - unmaps file
+CbcSnapshot::~CbcSnapshot()
+{
+  close();
+}
+// Write solver and extra information
+int CbcSnapshot::write(const char *fileName, const OsiClpSolverInterface *solver,
+  const CbcSnapshotExtra *extra)
+{
+  FILE *fp = fopen(fileName, "wb");
+  if (!fp)
+    return -1;
+  int numberRows = solver->getNumRows();
+  int numberColumns = solver->getNumCols();
+  const CoinPackedMatrix *matrix = solver->getMatrixByCol();
+  const CoinBigIndex *columnStart = matrix->getVectorStarts();
+  const int *columnLength = matrix->getVectorLengths();
+  const int *row = matrix->getIndices();
+  const double *element = matrix->getElements();
+  // matrix may have gaps - written packed
+  CoinBigIndex *start = new CoinBigIndex[numberColumns + 1];
+  start[0] = 0;
+  for (int i = 0; i < numberColumns; i++)
+    start[i + 1] = start[i] + columnLength[i];
+  CoinBigIndex numberElements = start[numberColumns];
+  char *integer = new char[numberColumns];
+  for (int i = 0; i < numberColumns; i++)
+    integer[i] = solver->isInteger(i) ? 1 : 0;
+  std::string names;
+  for (int i = 0; i < numberRows; i++) {
+    names += solver->getRowName(i);
+    names += '\0';
+  }
+  for (int i = 0; i < numberColumns; i++) {
+    names += solver->getColName(i);
+    names += '\0';
+  }
+  CbcSnapshotHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, snapshotMagic, sizeof(header.magic));
+  header.version = CBC_SNAPSHOT_VERSION;
+  header.check = CBC_SNAPSHOT_CHECK;
+  header.sizeBigIndex = static_cast< int >(sizeof(CoinBigIndex));
+  header.numberRows = numberRows;
+  header.numberColumns = numberColumns;
+  header.objectiveSense = solver->getObjSense();
+  solver->getDblParam(OsiObjOffset, header.objectiveOffset);
+  // where each array comes from
+  const void *array[numberSections];
+  memset(array, 0, sizeof(array));
+  array[sectionStart] = start;
+  header.size[sectionStart] = (numberColumns + 1) * sizeof(CoinBigIndex);
+  array[sectionRow] = NULL; // packed from matrix
+  header.size[sectionRow] = numberElements * sizeof(int);
+  array[sectionElement] = NULL;
+  header.size[sectionElement] = numberElements * sizeof(double);
+  array[sectionColumnLower] = solver->getColLower();
+  array[sectionColumnUpper] = solver->getColUpper();
+  array[sectionObjective] = solver->getObjCoefficients();
+  header.size[sectionColumnLower] = numberColumns * sizeof(double);
+  header.size[sectionColumnUpper] = numberColumns * sizeof(double);
+  header.size[sectionObjective] = numberColumns * sizeof(double);
+  array[sectionRowLower] = solver->getRowLower();
+  array[sectionRowUpper] = solver->getRowUpper();
+  header.size[sectionRowLower] = numberRows * sizeof(double);
+  header.size[sectionRowUpper] = numberRows * sizeof(double);
+  array[sectionInteger] = integer;
+  header.size[sectionInteger] = numberColumns;
+  array[sectionNames] = names.c_str();
+  header.size[sectionNames] = names.size();
+  if (extra) {
+    if (extra->priorities) {
+      array[sectionPriority] = extra->priorities;
+      header.size[sectionPriority] = numberColumns * sizeof(int);
+    }
+    if (extra->numberSOS && extra->sosStart) {
+      int numberSOS = extra->numberSOS;
+      int numberInSets = extra->sosStart[numberSOS];
+      header.numberSOS = numberSOS;
+      array[sectionSosStart] = extra->sosStart;
+      header.size[sectionSosStart] = (numberSOS + 1) * sizeof(int);
+      array[sectionSosType] = extra->sosType;
+      header.size[sectionSosType] = numberSOS;
+      if (extra->sosPriority) {
+        array[sectionSosPriority] = extra->sosPriority;
+        header.size[sectionSosPriority] = numberSOS * sizeof(int);
+      }
+      array[sectionSosIndices] = extra->sosIndices;
+      header.size[sectionSosIndices] = numberInSets * sizeof(int);
+      array[sectionSosReference] = extra->sosReference;
+      header.size[sectionSosReference] = numberInSets * sizeof(double);
+    }
+    if (extra->numberMipStart) {
+      header.numberMipStart = extra->numberMipStart;
+      array[sectionMipStartColumn] = extra->mipStartColumns;
+      header.size[sectionMipStartColumn] = extra->numberMipStart * sizeof(int);
+      array[sectionMipStartValue] = extra->mipStartValues;
+      header.size[sectionMipStartValue] = extra->numberMipStart * sizeof(double);
+    }
+  }
+  CoinInt64 position = roundUp(sizeof(header));
+  for (int i = 0; i < numberSections; i++) {
+    if (header.size[i] || i <= sectionNames) {
+      header.offset[i] = position;
+      position = roundUp(position + header.size[i]);
+    }
+  }
+  bool good = fwrite(&header, sizeof(header), 1, fp) == 1;
+  const char zero[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+  CoinInt64 written = sizeof(header);
+  for (int i = 0; i < numberSections && good; i++) {
+    if (!header.offset[i])
+      continue;
+    if (header.offset[i] > written)
+      good = fwrite(zero, header.offset[i] - written, 1, fp) == 1;
+    written = header.offset[i];
+    if (!header.size[i] || !good)
+      continue;
+    if (i == sectionRow || i == sectionElement) {
+      for (int iColumn = 0; iColumn < numberColumns && good; iColumn++) {
+        int n = columnLength[iColumn];
+        if (!n)
+          continue;
+        if (i == sectionRow)
+          good = fwrite(row + columnStart[iColumn], sizeof(int), n, fp) == static_cast< size_t >(n);
+        else
+          good = fwrite(element + columnStart[iColumn], sizeof(double), n, fp) == static_cast< size_t >(n);
+      }
+    } else {
+      good = fwrite(array[i], header.size[i], 1, fp) == 1;
+    }
+    written += header.size[i];
+  }
+  if (good && position > written)
+    good = fwrite(zero, position - written, 1, fp) == 1;
+  if (fclose(fp))
+    good = false;
+  delete[] start;
+  delete[] integer;
+  return good ? 0 : -1;
+}
+// Whether file starts like a snapshot
+bool CbcSnapshot::isSnapshot(const char *fileName)
+{
+  FILE *fp = fopen(fileName, "rb");
+  if (!fp)
+    return false;
+  char magic[8];
+  bool yes = fread(magic, sizeof(magic), 1, fp) == 1 && !memcmp(magic, snapshotMagic, sizeof(magic));
+  fclose(fp);
+  return yes;
+}
+// Map file
+int CbcSnapshot::open(const char *fileName)
+{
+  close();
+#ifdef CBC_SNAPSHOT_MMAP
+  int fd = ::open(fileName, O_RDONLY);
+  if (fd < 0)
+    return -1;
+  struct stat info;
+  if (fstat(fd, &info) || info.st_size < static_cast< off_t >(sizeof(CbcSnapshotHeader))) {
+    ::close(fd);
+    return -2;
+  }
+  size_ = static_cast< size_t >(info.st_size);
+  void *data = mmap(NULL, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED) {
+    size_ = 0;
+    return -1;
+  }
+  data_ = reinterpret_cast< char * >(data);
+  mapped_ = true;
+#else
+  FILE *fp = fopen(fileName, "rb");
+  if (!fp)
+    return -1;
+  fseek(fp, 0, SEEK_END);
+  long size = ftell(fp);
+  fseek(fp, 0, SEEK_SET);
+  if (size < static_cast< long >(sizeof(CbcSnapshotHeader))) {
+    fclose(fp);
+    return -2;
+  }
+  size_ = static_cast< size_t >(size);
+  // doubles will be aligned
+  data_ = reinterpret_cast< char * >(new double[(size_ + 7) / 8]);
+  bool good = fread(data_, size_, 1, fp) == 1;
+  fclose(fp);
+  if (!good) {
+    close();
+    return -1;
+  }
+#endif
+  const CbcSnapshotHeader *header = reinterpret_cast< const CbcSnapshotHeader * >(data_);
+  bool good = !memcmp(header->magic, snapshotMagic, sizeof(header->magic))
+    && header->version == CBC_SNAPSHOT_VERSION
+    && header->check == CBC_SNAPSHOT_CHECK
+    && header->sizeBigIndex == static_cast< int >(sizeof(CoinBigIndex));
+  for (int i = 0; i < numberSections && good; i++) {
+    if (header->size[i] < 0 || header->offset[i] < 0)
+      good = false;
+    else if (header->offset[i] && (header->offset[i] & 7 || header->offset[i] < static_cast< CoinInt64 >(sizeof(CbcSnapshotHeader)) || header->offset[i] + header->size[i] > static_cast< CoinInt64 >(size_)))
+      good = false;
+  }
+  for (int i = 0; i <= sectionNames && good; i++) {
+    if (!header->offset[i])
+      good = false;
+  }
+  if (good)
+    good = goodSections(data_, header);
+  if (!good) {
+    close();
+    return -2;
+  }
+  return 0;
+}
+// Unmap file
+void CbcSnapshot::close()
+{
+  if (!data_)
+    return;
+#ifdef CBC_SNAPSHOT_MMAP
+  if (mapped_)
+    munmap(data_, size_);
+#else
+  delete[] reinterpret_cast< double * >(data_);
+#endif
+  data_ = NULL;
+  size_ = 0;
+  mapped_ = false;
+}
+// Pointer to section (NULL if absent)
+const void *
+CbcSnapshot::section(int which) const
+{
+  if (!data_)
+    return NULL;
+  const CbcSnapshotHeader *header = reinterpret_cast< const CbcSnapshotHeader * >(data_);
+  return header->offset[which] ? data_ + header->offset[which] : NULL;
+}
+// Load problem (with integers and names) into solver
+void CbcSnapshot::load(OsiClpSolverInterface *solver) const
+{
+  assert(data_);
+  const CbcSnapshotHeader *header = reinterpret_cast< const CbcSnapshotHeader * >(data_);
+  int numberRows = header->numberRows;
+  int numberColumns = header->numberColumns;
+  solver->loadProblem(numberColumns, numberRows,
+    reinterpret_cast< const CoinBigIndex * >(section(sectionStart)),
+    reinterpret_cast< const int * >(section(sectionRow)),
+    reinterpret_cast< const double * >(section(sectionElement)),
+    reinterpret_cast< const double * >(section(sectionColumnLower)),
+    reinterpret_cast< const double * >(section(sectionColumnUpper)),
+    reinterpret_cast< const double * >(section(sectionObjective)),
+    reinterpret_cast< const double * >(section(sectionRowLower)),
+    reinterpret_cast< const double * >(section(sectionRowUpper)));
+  const char *integer = reinterpret_cast< const char * >(section(sectionInteger));
+  for (int i = 0; i < numberColumns; i++) {
+    if (integer[i])
+      solver->setInteger(i);
+  }
+  solver->setObjSense(header->objectiveSense);
+  solver->setDblParam(OsiObjOffset, header->objectiveOffset);
+  if (header->size[sectionNames]) {
+    const char *name = reinterpret_cast< const char * >(section(sectionNames));
+    const char *end = name + header->size[sectionNames];
+    std::vector< std::string > rowNames;
+    std::vector< std::string > columnNames;
+    rowNames.reserve(numberRows);
+    columnNames.reserve(numberColumns);
+    for (int i = 0; i < numberRows + numberColumns && name < end; i++) {
+      size_t length = strlen(name);
+      if (i < numberRows)
+        rowNames.push_back(std::string(name, length));
+      else
+        columnNames.push_back(std::string(name, length));
+      name += length + 1;
+    }
+    solver->getModelPtr()->copyNames(rowNames, columnNames);
+  }
+}
+// Number of rows
+int CbcSnapshot::numberRows() const
+{
+  return data_ ? reinterpret_cast< const CbcSnapshotHeader * >(data_)->numberRows : 0;
+}
+// Number of columns
+int CbcSnapshot::numberColumns() const
+{
+  return data_ ? reinterpret_cast< const CbcSnapshotHeader * >(data_)->numberColumns : 0;
+}
+// Priorities (NULL if none)
+const int *CbcSnapshot::priorities() const
+{
+  return reinterpret_cast< const int * >(section(sectionPriority));
+}
+// Number of SOS
+int CbcSnapshot::numberSOS() const
+{
+  return data_ ? reinterpret_cast< const CbcSnapshotHeader * >(data_)->numberSOS : 0;
+}
+// SOS start
+const int *CbcSnapshot::sosStart() const
+{
+  return reinterpret_cast< const int * >(section(sectionSosStart));
+}
+// SOS type
+const char *CbcSnapshot::sosType() const
+{
+  return reinterpret_cast< const char * >(section(sectionSosType));
+}
+// SOS priority (NULL if none)
+const int *CbcSnapshot::sosPriority() const
+{
+  return reinterpret_cast< const int * >(section(sectionSosPriority));
+}
+// SOS columns
+const int *CbcSnapshot::sosIndices() const
+{
+  return reinterpret_cast< const int * >(section(sectionSosIndices));
+}
+// SOS weights
+const double *CbcSnapshot::sosReference() const
+{
+  return reinterpret_cast< const double * >(section(sectionSosReference));
+}
+// Number in MIP start
+int CbcSnapshot::numberMipStart() const
+{
+  return data_ ? reinterpret_cast< const CbcSnapshotHeader * >(data_)->numberMipStart : 0;
+}
+// MIP start columns
+const int *CbcSnapshot::mipStartColumns() const
+{
+  return reinterpret_cast< const int * >(section(sectionMipStartColumn));
+}
+// MIP start values
+const double *CbcSnapshot::mipStartValues() const
+{
+  return reinterpret_cast< const double * >(section(sectionMipStartValue));
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
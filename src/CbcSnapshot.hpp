@@ -0,0 +1,112 @@
+// Copyright (C) 2002, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcSnapshot_H
+#define CbcSnapshot_H
+
+#include <cstddef>
+
+#include "CbcSolverConfig.h"
+#include "CoinTypes.hpp"
+
+class OsiClpSolverInterface;
+
+/// Cbc information beyond the solver kept in a snapshot (all may be NULL)
+typedef struct {
+  /// Priority for each column
+  const int *priorities;
+  /// SOS as in CbcSolver - start (numberSOS+1), type, priority
+  int numberSOS;
+  const int *sosStart;
+  const char *sosType;
+  const int *sosPriority;
+  /// SOS columns and weights
+  const int *sosIndices;
+  const double *sosReference;
+  /// MIP start as columns and values
+  int numberMipStart;
+  const int *mipStartColumns;
+  const double *mipStartValues;
+} CbcSnapshotExtra;
+
+/** Binary snapshot of a MIP.
+
+    Matrix, bounds, objective, integrality, names and optionally
+    priorities, SOS and a MIP start are written as arrays (each on an
+    8 byte boundary) after a versioned header.  Loading maps the file
+    (read into memory where mmap is not available) and arrays are used
+    in place - so loading a model is one copy into the solver and no
+    parsing.  Files are for the machine (and CoinBigIndex size) they
+    were written on; open rejects others.
+*/
+
+class CBCSOLVERLIB_EXPORT CbcSnapshot {
+public:
+  /// Constructor
+  CbcSnapshot();
+  /// Destructor - unmaps file
+  ~CbcSnapshot();
+
+  /** Write solver and extra information (which may be NULL).
+      Returns 0 if fine, -1 if file could not be written */
+  static int write(const char *fileName, const OsiClpSolverInterface *solver,
+    const CbcSnapshotExtra *extra = NULL);
+  /// Whether file starts like a snapshot
+  static bool isSnapshot(const char *fileName);
+
+  /** Map file.  Returns 0 if fine, -1 if file can not be opened,
+      -2 if not a snapshot (or wrong version or machine) or if sizes
+      or indices of arrays do not agree with header */
+  int open(const char *fileName);
+  /// Unmap file
+  void close();
+  /// Load problem (with integers and names) into solver
+  void load(OsiClpSolverInterface *solver) const;
+
+  /// Number of rows
+  int numberRows() const;
+  /// Number of columns
+  int numberColumns() const;
+  /// Priorities (NULL if none)
+  const int *priorities() const;
+  /// Number of SOS
+  int numberSOS() const;
+  /// SOS start (numberSOS+1)
+  const int *sosStart() const;
+  /// SOS type
+  const char *sosType() const;
+  /// SOS priority (NULL if none)
+  const int *sosPriority() const;
+  /// SOS columns
+  const int *sosIndices() const;
+  /// SOS weights
+  const double *sosReference() const;
+  /// Number in MIP start
+  int numberMipStart() const;
+  /// MIP start columns
+  const int *mipStartColumns() const;
+  /// MIP start values
+  const double *mipStartValues() const;
+
+private:
+  /// Pointer to section (NULL if absent)
+  const void *section(int which) const;
+  /// Illegal copy constructor
+  CbcSnapshot(const CbcSnapshot &);
+  /// Illegal assignment operator
+  CbcSnapshot &operator=(const CbcSnapshot &);
+
+private:
+  /// Start of mapped file
+  char *data_;
+  /// Size of file
+  size_t size_;
+  /// Whether mapped (otherwise read)
+  bool mapped_;
+};
+
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -0,0 +1,86 @@
+// Copyright (C) 2002, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#pragma warning(disable : 4786)
+#endif
+
+#include "CbcConfig.h"
+
+#include "CoinHelperFunctions.hpp"
+#include "CbcSolutionChanges.hpp"
+
+// Default Constructor
+CbcSolutionChanges::CbcSolutionChanges()
+  : saved_(NULL)
+  , changed_(NULL)
+  , solution_(NULL)
+  , lower_(NULL)
+  , upper_(NULL)
+  , numberColumns_(0)
+  , numberChanged_(0)
+  , stamp_(0)
+  , active_(false)
+{
+}
+
+// Destructor
+CbcSolutionChanges::~CbcSolutionChanges()
+{
+  delete[] saved_;
+  delete[] changed_;
+}
+// Compare with arrays of last mark and start new pass
+void CbcSolutionChanges::mark(int numberColumns, const double *solution,
+  const double *lower, const double *upper)
+{
+  solution_ = solution;
+  lower_ = lower;
+  upper_ = upper;
+  stamp_++;
+  active_ = true;
+  if (numberColumns != numberColumns_) {
+    // first time (or problem changed) - everything changed
+    delete[] saved_;
+    delete[] changed_;
+    numberColumns_ = numberColumns;
+    saved_ = new double[3 * numberColumns];
+    changed_ = new char[numberColumns];
+    memset(changed_, 1, numberColumns);
+    numberChanged_ = numberColumns;
+    memcpy(saved_, solution, numberColumns * sizeof(double));
+    memcpy(saved_ + numberColumns, lower, numberColumns * sizeof(double));
+    memcpy(saved_ + 2 * numberColumns, upper, numberColumns * sizeof(double));
+    return;
+  }
+  double *savedSolution = saved_;
+  double *savedLower = saved_ + numberColumns;
+  double *savedUpper = saved_ + 2 * numberColumns;
+  int numberChanged = 0;
+  for (int i = 0; i < numberColumns; i++) {
+    char change = static_cast< char >((solution[i] != savedSolution[i])
+      | (lower[i] != savedLower[i]) | (upper[i] != savedUpper[i]));
+    changed_[i] = change;
+    numberChanged += change;
+    savedSolution[i] = solution[i];
+    savedLower[i] = lower[i];
+    savedUpper[i] = upper[i];
+  }
+  numberChanged_ = numberChanged;
+}
+// Whether any of list changed at last mark
+bool CbcSolutionChanges::anyChanged(int number, const int *which) const
+{
+  if (!numberChanged_)
+    return false;
+  for (int i = 0; i < number; i++) {
+    if (changed_[which[i]])
+      return true;
+  }
+  return false;
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
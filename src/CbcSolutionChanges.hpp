@@ -0,0 +1,92 @@
+// Copyright (C) 2002, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcSolutionChanges_H
+#define CbcSolutionChanges_H
+
+#include "CbcConfig.h"
+
+/** Columns whose solution value or bounds changed
+
+    Before a pass over objects (CbcNode::chooseBranch and
+    CbcModel::feasibleSolution) the model marks solution and bounds.
+    Each mark compares with the copy saved by the previous mark, flags
+    columns which changed and starts a new stamp.  Objects with many
+    members (CbcNWay, CbcBranchAllDifferent) keep their infeasibility
+    with the stamp and only recompute if evaluated at the previous
+    stamp and one of their members changed.  Outside a pass stamp is -1
+    and nothing may be cached.
+
+    Created by CbcModel::wantSolutionChanges (objects ask when first
+    evaluated).
+*/
+class CBCLIB_EXPORT CbcSolutionChanges {
+
+public:
+  /// Default Constructor
+  CbcSolutionChanges();
+  /// Destructor
+  ~CbcSolutionChanges();
+
+  /// Compare with arrays of last mark and start new pass
+  void mark(int numberColumns, const double *solution,
+    const double *lower, const double *upper);
+  /// End of pass
+  inline void clear()
+  {
+    active_ = false;
+  }
+  /// Stamp of current pass (-1 if not in pass)
+  inline int stamp() const
+  {
+    return active_ ? stamp_ : -1;
+  }
+  /// Whether column changed at last mark
+  inline bool changed(int iColumn) const
+  {
+    return changed_[iColumn] != 0;
+  }
+  /// Whether any of list changed at last mark
+  bool anyChanged(int number, const int *which) const;
+  /// Number of columns changed at last mark
+  inline int numberChanged() const
+  {
+    return numberChanged_;
+  }
+  /** Whether arrays are those marked - objects should check before
+      trusting stamp */
+  inline bool sameArrays(const double *solution, const double *lower,
+    const double *upper) const
+  {
+    return solution == solution_ && lower == lower_ && upper == upper_;
+  }
+
+private:
+  /// Illegal copy constructor
+  CbcSolutionChanges(const CbcSolutionChanges &);
+  /// Illegal assignment operator
+  CbcSolutionChanges &operator=(const CbcSolutionChanges &);
+
+  /// Solution, lower and upper at last mark (3*numberColumns_)
+  double *saved_;
+  /// Whether each column changed
+  char *changed_;
+  /// Arrays marked (not owned)
+  const double *solution_;
+  const double *lower_;
+  const double *upper_;
+  /// Number of columns
+  int numberColumns_;
+  /// Number changed
+  int numberChanged_;
+  /// Stamp of last mark
+  int stamp_;
+  /// Whether in pass
+  bool active_;
+};
+
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
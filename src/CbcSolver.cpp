@@ -62,6 +62,10 @@ void CbcCrashHandler( int sig );
 #include "OsiChooseVariable.hpp"
 #include "OsiAuxInfo.hpp"
 #include "CbcMipStartIO.hpp"
+#include "CbcMpsReader.hpp"
+#include "CbcSnapshot.hpp"
+#include "CbcNameHash.hpp"
+#include "CbcTuner.hpp"
 #include "CbcMessage.hpp"
 // for printing
 #ifndef CLP_OUTPUT_FORMAT
@@ -193,7 +197,6 @@ static void malloc_stats2()
 #define FOREIGN_BARRIER
 #endif
 
-static int initialPumpTune = -1;
 #include "CoinWarmStartBasis.hpp"
 
 #include "OsiSolverInterface.hpp"
@@ -253,6 +256,7 @@ extern int debugNumberColumns;
 #include "CbcTreeLocal.hpp"
 #include "CbcCompareActual.hpp"
 #include "CbcCompareObjective.hpp"
+#include "CbcComparePlunge.hpp"
 #include "CbcBranchActual.hpp"
 #include "CbcBranchLotsize.hpp"
 #include "CbcOrClpParam.hpp"
@@ -561,9 +565,36 @@ CbcUser *CbcSolver::userFunction(const char *name) const
   else
     return NULL;
 }
+/*
+  establishParams makes several hundred parameters, each with its help
+  text and options, which is slow next to solving a small problem.  The
+  table is made once (kept for the life of the process) and copied after
+  that.
+*/
+static std::vector< CbcOrClpParam > *prototypeParameters = NULL;
+static void makePrototypeParameters()
+{
+  prototypeParameters = new std::vector< CbcOrClpParam >();
+  establishParams(*prototypeParameters);
+}
+#ifdef CBC_THREAD
+#include <pthread.h>
+static pthread_once_t prototypeOnce = PTHREAD_ONCE_INIT;
+#endif
+// Fill parameters from table made once
+static void copyParameters(std::vector< CbcOrClpParam > &parameters)
+{
+#ifdef CBC_THREAD
+  pthread_once(&prototypeOnce, makePrototypeParameters);
+#else
+  if (!prototypeParameters)
+    makePrototypeParameters();
+#endif
+  parameters = *prototypeParameters;
+}
 void CbcSolver::fillParameters()
 {
-  establishParams(parameters_);
+  copyParameters(parameters_);
   const char dirsep = CoinFindDirSeparator();
   std::string directory;
   std::string dirSample;
@@ -662,7 +693,6 @@ void CbcSolver::fillParameters()
   parameters_[whichParam(CBC_PARAM_DBL_INCREMENT, parameters_)].setDoubleValue(model_.getDblParam(CbcModel::CbcCutoffIncrement));
   parameters_[whichParam(CBC_PARAM_INT_TESTOSI, parameters_)].setIntValue(testOsiParameters);
   parameters_[whichParam(CBC_PARAM_INT_FPUMPTUNE, parameters_)].setIntValue(1003);
-  initialPumpTune = 1003;
 #ifdef CBC_THREAD
   parameters_[whichParam(CBC_PARAM_INT_THREADS, parameters_)].setIntValue(0);
 #endif
@@ -1181,41 +1211,67 @@ int CbcClpUnitTest(const CbcModel &saveModel,
 		   int callBack(CbcModel *currentSolver, int whereFrom),
 		   CbcSolverUsefulData &parameterData);
 
-//#define CBC_THREAD_SAFE
-#ifdef CBC_THREAD_SAFE
-// Copies of some input decoding
-
+/* Copies of some input decoding which only look at arguments so there
+   is no global state (CoinRead* keep position in a global and can switch
+   to stdin) and several CbcMain1 can run at once.  whichArgument < 0
+   means use CoinRead*.  As there "-name=value" is split at "=".
+*/
 static std::string
-CoinReadGetCommand(int &whichArgument, int argc, const char *argv[])
+CbcReadGetCommand(int &whichArgument, std::string &afterEquals,
+  int argc, const char *argv[])
 {
+  if (whichArgument < 0)
+    return CoinReadGetCommand(argc, argv);
   std::string field;
+  afterEquals = "";
   if (whichArgument < argc)
     field = argv[whichArgument++];
   else
     field = "quit";
   if (field[0] == '-')
     field = field.substr(1);
+  std::string::size_type found = field.find('=');
+  if (found != std::string::npos) {
+    afterEquals = field.substr(found + 1);
+    field = field.substr(0, found);
+  }
   return field;
 }
 static std::string
-CoinReadGetString(int &whichArgument, int argc, const char *argv[])
+CbcReadGetString(int &whichArgument, std::string &afterEquals,
+  int argc, const char *argv[])
 {
+  if (whichArgument < 0)
+    return CoinReadGetString(argc, argv);
   std::string field;
-  if (whichArgument < argc)
+  if (afterEquals != "") {
+    field = afterEquals;
+    afterEquals = "";
+  } else if (whichArgument < argc && argv[whichArgument][0] != '-') {
     field = argv[whichArgument++];
-  else
-    field = "";
+  } else {
+    field = "EOL";
+  }
   return field;
 }
 // valid 0 - okay, 1 bad, 2 not there
 static int
-CoinReadGetIntField(int &whichArgument, int argc, const char *argv[], int *valid)
+CbcReadGetIntField(int &whichArgument, std::string &afterEquals,
+  int argc, const char *argv[], int *valid)
 {
+  if (whichArgument < 0)
+    return CoinReadGetIntField(argc, argv, valid);
   std::string field;
-  if (whichArgument < argc)
+  if (afterEquals != "") {
+    field = afterEquals;
+    afterEquals = "";
+  } else if (whichArgument < argc) {
+    // may be negative value so do not check for -
     field = argv[whichArgument++];
-  else
-    field = "0";
+  } else {
+    *valid = 2;
+    return 0;
+  }
   long int value = 0;
   const char *start = field.c_str();
   char *endPointer = NULL;
@@ -1230,13 +1286,21 @@ CoinReadGetIntField(int &whichArgument, int argc, const char *argv[], int *valid
   return static_cast< int >(value);
 }
 static double
-CoinReadGetDoubleField(int &whichArgument, int argc, const char *argv[], int *valid)
+CbcReadGetDoubleField(int &whichArgument, std::string &afterEquals,
+  int argc, const char *argv[], int *valid)
 {
+  if (whichArgument < 0)
+    return CoinReadGetDoubleField(argc, argv, valid);
   std::string field;
-  if (whichArgument < argc)
+  if (afterEquals != "") {
+    field = afterEquals;
+    afterEquals = "";
+  } else if (whichArgument < argc) {
     field = argv[whichArgument++];
-  else
-    field = "0.0";
+  } else {
+    *valid = 2;
+    return 0.0;
+  }
   double value = 0.0;
   const char *start = field.c_str();
   char *endPointer = NULL;
@@ -1251,11 +1315,10 @@ CoinReadGetDoubleField(int &whichArgument, int argc, const char *argv[], int *va
   return value;
 }
 // Redefine all
-#define CoinReadGetCommand(x, y) CoinReadGetCommand(whichArgument, x, y)
-#define CoinReadGetString(x, y) CoinReadGetString(whichArgument, x, y)
-#define CoinReadGetIntField(x, y, z) CoinReadGetIntField(whichArgument, x, y, z)
-#define CoinReadGetDoubleField(x, y, z) CoinReadGetDoubleField(whichArgument, x, y, z)
-#endif
+#define CoinReadGetCommand(x, y) CbcReadGetCommand(whichArgument, afterEquals, x, y)
+#define CoinReadGetString(x, y) CbcReadGetString(whichArgument, afterEquals, x, y)
+#define CoinReadGetIntField(x, y, z) CbcReadGetIntField(whichArgument, afterEquals, x, y, z)
+#define CoinReadGetDoubleField(x, y, z) CbcReadGetDoubleField(whichArgument, afterEquals, x, y, z)
 // Default Constructor
 CbcSolverUsefulData::CbcSolverUsefulData()
 {
@@ -1263,7 +1326,11 @@ CbcSolverUsefulData::CbcSolverUsefulData()
   noPrinting_ = true;
   printWelcome_ = true;
   useSignalHandler_ = false;
-  establishParams(parameters_);
+  argumentsOnly_ = false;
+  initialPumpTune_ = -1;
+  keepPseudoCosts_ = false;
+  autoConfigure_ = false;
+  copyParameters(parameters_);
 }
 
 /* Copy constructor .
@@ -1273,6 +1340,14 @@ CbcSolverUsefulData::CbcSolverUsefulData(const CbcSolverUsefulData &rhs)
   totalTime_ = rhs.totalTime_;
   noPrinting_ = rhs.noPrinting_;
   useSignalHandler_ = rhs.useSignalHandler_;
+  argumentsOnly_ = rhs.argumentsOnly_;
+  initialPumpTune_ = rhs.initialPumpTune_;
+  printWelcome_ = rhs.printWelcome_;
+  keepPseudoCosts_ = rhs.keepPseudoCosts_;
+  pseudoCostNames_ = rhs.pseudoCostNames_;
+  pseudoCosts_ = rhs.pseudoCosts_;
+  autoConfigure_ = rhs.autoConfigure_;
+  analysis_ = rhs.analysis_;
   this->parameters_ = rhs.parameters_;
 }
 
@@ -1283,6 +1358,14 @@ CbcSolverUsefulData &CbcSolverUsefulData::operator=(const CbcSolverUsefulData &r
     totalTime_ = rhs.totalTime_;
     noPrinting_ = rhs.noPrinting_;
     useSignalHandler_ = rhs.useSignalHandler_;
+    argumentsOnly_ = rhs.argumentsOnly_;
+    initialPumpTune_ = rhs.initialPumpTune_;
+    printWelcome_ = rhs.printWelcome_;
+    keepPseudoCosts_ = rhs.keepPseudoCosts_;
+    pseudoCostNames_ = rhs.pseudoCostNames_;
+    pseudoCosts_ = rhs.pseudoCosts_;
+    autoConfigure_ = rhs.autoConfigure_;
+    analysis_ = rhs.analysis_;
     this->parameters_ = rhs.parameters_;
   }
   return *this;
@@ -1327,10 +1410,10 @@ int CbcMain1(int argc, const char *argv[],
   bool useSignalHandler = parameterData.useSignalHandler_;
   CbcModel &model_ = model;
   CglPreProcess *preProcessPointer = NULL;
-#ifdef CBC_THREAD_SAFE
-  // Initialize argument
-  int whichArgument = 1;
-#endif
+  // Initialize argument (if not using CoinRead*)
+  int whichArgument = parameterData.argumentsOnly_ ? 1 : -1;
+  std::string afterEquals;
+  int initialPumpTune = parameterData.initialPumpTune_;
   // Meaning 0 - start at very beginning
   // 1 start at beginning of preprocessing
   // 2 start at beginning of branch and bound
@@ -1345,7 +1428,8 @@ int CbcMain1(int argc, const char *argv[],
 #endif
   CbcModel *babModel_ = NULL;
   int returnMode = 1;
-  setCbcOrClpReadMode(1);
+  if (whichArgument < 0)
+    setCbcOrClpReadMode(1);
   int statusUserFunction_[1];
   int numberUserFunctions_ = 1; // to allow for ampl
   // Statistics
@@ -1462,6 +1546,10 @@ int CbcMain1(int argc, const char *argv[],
     std::vector< std::pair< std::string, double > > mipStart;
     std::vector< std::pair< std::string, double > > mipStartBefore;
     std::string mipStartFile = "";
+    // priorityIn file with pseudocost counts (read by branchAndBound)
+    std::string pseudoCostFile = "";
+    // file for pseudocosts learnt (never the priorityIn file)
+    std::string pseudoCostOutFile = "";
     int numberSOS = 0;
     int *sosStart = NULL;
     int *sosIndices = NULL;
@@ -1516,7 +1604,10 @@ int CbcMain1(int argc, const char *argv[],
 	  sosReference = info.sosReference;
 	  sosPriority = info.sosPriority;
 	}
-        setCbcOrClpReadMode(2); // so will start with parameters
+        if (whichArgument < 0)
+          setCbcOrClpReadMode(2); // so will start with parameters
+        else
+          whichArgument = 2;
         // see if log in list (including environment)
         for (int i = 1; i < info.numberArguments; i++) {
           if (!strcmp(info.arguments[i], "log")) {
@@ -1829,6 +1920,15 @@ int CbcMain1(int argc, const char *argv[],
     //zerohalfGen.switchOnExpensive();
     // set default action (0=off,1=on,2=root)
     int zerohalfAction = 3;
+    // cut generators switched off by autoConfigure (1 knapsack, 2 clique, 4 odd wheel, 8 flow)
+    int autoCutsOff = 0;
+    // and what they were (so put back as they were)
+    int autoCutsWere[4] = { 0, 0, 0, 0 };
+    // set by user so left alone by autoConfigure (bits as autoCutsOff, 16 threads, 32 orbital)
+    int autoUserSet = 0;
+    // threads and orbital switched off by autoConfigure for this solve
+    bool autoNoThreads = false;
+    bool autoNoOrbital = false;
 
     // Stored cuts
     //bool storedCuts = false;
@@ -1978,6 +2078,66 @@ int CbcMain1(int argc, const char *argv[],
         }
         field = field.substr(0, length - numberQuery);
       }
+      if (field == "tune" && !numberQuery) {
+        // parameter sweep - not in parameter table (which lives in Clp)
+        numberGoodCommands++;
+        std::string fileName = CoinReadGetString(argc, argv);
+        if (!goodModel) {
+          sprintf(generalPrint, "** Current model not valid");
+          printGeneralMessage(model_, generalPrint);
+        } else if (fileName == "$" || fileName == "EOL" || !fileName.length()) {
+          sprintf(generalPrint, "tune needs specification file");
+          printGeneralMessage(model_, generalPrint);
+        } else {
+          CbcTuner tuner(model_);
+          int returnCode = tuner.readSpecification(fileName.c_str());
+          if (returnCode) {
+            if (returnCode < 0)
+              sprintf(generalPrint, "Unable to open tuning file %s", fileName.c_str());
+            else
+              sprintf(generalPrint, "Bad line %d in tuning file %s", returnCode, fileName.c_str());
+            printGeneralMessage(model_, generalPrint);
+          } else {
+            tuner.tune();
+            if (tuner.outputFile().length()) {
+              if (!tuner.writeBest(tuner.outputFile().c_str()))
+                sprintf(generalPrint, "Best parameters written to %s", tuner.outputFile().c_str());
+              else
+                sprintf(generalPrint, "Unable to write best parameters to %s", tuner.outputFile().c_str());
+              printGeneralMessage(model_, generalPrint);
+            }
+          }
+        }
+        continue;
+      }
+      if (field == "pseudoCostOut" && !numberQuery) {
+        // where learnt pseudocosts go after branch and bound - not in parameter table
+        numberGoodCommands++;
+        std::string fileName = CoinReadGetString(argc, argv);
+        if (fileName == "$" || fileName == "EOL" || !fileName.length()) {
+          sprintf(generalPrint, "pseudoCostOut needs file name");
+          printGeneralMessage(model_, generalPrint);
+        } else if (fileName == "none") {
+          pseudoCostOutFile = "";
+        } else {
+          pseudoCostOutFile = fileName;
+        }
+        continue;
+      }
+      if (field == "autoConfigure" && !numberQuery) {
+        // choose some settings from analysis of model - not in parameter table
+        numberGoodCommands++;
+        std::string value = CoinReadGetString(argc, argv);
+        if (value == "on" || value == "off") {
+          parameterData.autoConfigure_ = (value == "on");
+          if (value == "off")
+            parameterData.analysis_.clear();
+        } else {
+          sprintf(generalPrint, "autoConfigure needs on or off");
+          printGeneralMessage(model_, generalPrint);
+        }
+        continue;
+      }
       // find out if valid command
       int iParam;
       int numberMatches = 0;
@@ -2484,6 +2644,8 @@ int CbcMain1(int argc, const char *argv[],
                   }
                 }
               }
+              if (parameters_[iParam].type() == CBC_PARAM_INT_THREADS)
+                autoUserSet |= 16;
               int returnCode;
               const char *message = parameters_[iParam].setIntParameterWithMessage(model_, value, returnCode);
               if (!noPrinting_ && strlen(message)) {
@@ -2672,10 +2834,12 @@ int CbcMain1(int argc, const char *argv[],
             case CBC_PARAM_STR_CLIQUECUTS:
               defaultSettings = false; // user knows what she is doing
               cliqueAction = action;
+              autoUserSet |= 2;
               break;
             case CBC_PARAM_STR_ODDWHEELCUTS:
               defaultSettings = false; // user knows what she is doing
               oddWheelAction = action;
+              autoUserSet |= 4;
               break;
             case CBC_PARAM_STR_GOMORYCUTS:
               defaultSettings = false; // user knows what she is doing
@@ -2688,6 +2852,7 @@ int CbcMain1(int argc, const char *argv[],
             case CBC_PARAM_STR_KNAPSACKCUTS:
               defaultSettings = false; // user knows what she is doing
               knapsackAction = action;
+              autoUserSet |= 1;
               break;
             case CBC_PARAM_STR_REDSPLITCUTS:
               defaultSettings = false; // user knows what she is doing
@@ -2704,6 +2869,7 @@ int CbcMain1(int argc, const char *argv[],
             case CBC_PARAM_STR_FLOWCUTS:
               defaultSettings = false; // user knows what she is doing
               flowAction = action;
+              autoUserSet |= 8;
               break;
             case CBC_PARAM_STR_MIXEDCUTS:
               defaultSettings = false; // user knows what she is doing
@@ -2737,7 +2903,11 @@ int CbcMain1(int argc, const char *argv[],
               break;
             case CBC_PARAM_STR_RENS:
               break;
+            case CBC_PARAM_STR_ORBITAL:
+              autoUserSet |= 32;
+              break;
             case CBC_PARAM_STR_CUTSSTRATEGY:
+              autoUserSet |= 15;
               gomoryAction = action;
               probingAction = action;
               knapsackAction = action;
@@ -4407,6 +4577,24 @@ int CbcMain1(int argc, const char *argv[],
                         prohibited[iColumn] = 1;
                         numberProhibited++;
                       }
+                      // preprocessing does not see indicator rows
+                      CbcIndicator *obj3 = dynamic_cast< CbcIndicator * >(oldObjects[iObj]);
+                      if (obj3 && obj3->indicatorColumn() >= 0) {
+                        prohibited[obj3->indicatorColumn()] = 1;
+                        numberProhibited++;
+                        int n = obj3->numberElements();
+                        const int *which = obj3->columns();
+                        for (int i = 0; i < n; i++) {
+                          prohibited[which[i]] = 1;
+                          numberProhibited++;
+                        }
+                      }
+                      CbcPiecewise *obj4 = dynamic_cast< CbcPiecewise * >(oldObjects[iObj]);
+                      if (obj4 && obj4->xColumn() >= 0) {
+                        prohibited[obj4->xColumn()] = 1;
+                        prohibited[obj4->yColumn()] = 1;
+                        numberProhibited += 2;
+                      }
                     }
                     if (numberProhibited)
                       process.passInProhibited(prohibited, numberColumns);
@@ -4473,7 +4661,14 @@ int CbcMain1(int argc, const char *argv[],
                  keepPPN = 1;
 #endif
                     process.setKeepColumnNames(keepPPN);
-                    process.setTimeLimit(babModel_->getMaximumSeconds() - babModel_->getCurrentSeconds(), babModel_->useElapsedTime());
+                    {
+                      double timeLimit = babModel_->getMaximumSeconds() - babModel_->getCurrentSeconds();
+                      // time box preprocessing (mainly probing) if asked
+                      double preProcessLimit = babModel_->getDblParam(CbcModel::CbcPreProcessTimeLimit);
+                      if (preProcessLimit > 0.0)
+                        timeLimit = CoinMin(timeLimit, preProcessLimit);
+                      process.setTimeLimit(timeLimit, babModel_->useElapsedTime());
+                    }
                     if (model.getKeepNamesPreproc())
                       process.setKeepColumnNames(true);
 		    if (keepPPN)
@@ -5276,10 +5471,16 @@ int CbcMain1(int argc, const char *argv[],
                       int extra1 = parameters_[whichParam(CBC_PARAM_INT_EXTRA1, parameters_)].intValue();
                       int extra2 = parameters_[whichParam(CBC_PARAM_INT_EXTRA2, parameters_)].intValue();
                       int logLevel = parameters_[log].intValue();
+                      // budget - quarter of time left and 20 times elements
+                      double secondsLeft = babModel_->getMaximumSeconds() - babModel_->getCurrentSeconds();
+                      double maximumSeconds = secondsLeft < 1.0e10 ? CoinMax(0.25 * secondsLeft, 1.0) : 0.0;
+                      double maximumElements = CoinMax(1.0e6, 20.0 * saveCoinModel.numberElements());
+                      maximumElements = CoinMin(maximumElements, static_cast< double >(COIN_INT_MAX));
                       OsiSolverInterface *solver = expandKnapsack(saveCoinModel, whichColumn, knapsackStart,
                         knapsackRow, numberKnapsack,
                         storedAmpl, logLevel, extra1, extra2,
-                        saveTightenedModel);
+                        saveTightenedModel, maximumSeconds,
+                        static_cast< CoinBigIndex >(maximumElements));
                       if (solver) {
 #ifndef CBC_OTHER_SOLVER
                         clpSolver = dynamic_cast< OsiClpSolverInterface * >(solver);
@@ -5361,13 +5562,80 @@ int CbcMain1(int argc, const char *argv[],
                 delete[] sort;
                 delete[] dsort;
               }
+              // Choose settings from structure of model
+              std::vector< CbcOrClpParam > autoParameters;
+              autoNoThreads = false;
+              autoNoOrbital = false;
+              if (parameterData.autoConfigure_) {
+                // put back generators switched off for last model (unless user set them since)
+                autoCutsOff &= ~autoUserSet;
+                if ((autoCutsOff & 1) != 0)
+                  knapsackAction = autoCutsWere[0];
+                if ((autoCutsOff & 2) != 0)
+                  cliqueAction = autoCutsWere[1];
+                if ((autoCutsOff & 4) != 0)
+                  oddWheelAction = autoCutsWere[2];
+                if ((autoCutsOff & 8) != 0)
+                  flowAction = autoCutsWere[3];
+                autoCutsOff = 0;
+                CbcModelAnalysis &analysis = parameterData.analysis_;
+                int numberThreads = parameters_[whichParam(CBC_PARAM_INT_THREADS, parameters_)].intValue() % 100;
+                analysis.analyze(babModel_->solver(), numberThreads);
+                if (!noPrinting_)
+                  analysis.print(babModel_->messageHandler(), babModel_->messages());
+                // only generators user has not chosen
+                if (!analysis.rowsWithBinaries() && knapsackAction && (autoUserSet & 1) == 0) {
+                  autoCutsWere[0] = knapsackAction;
+                  knapsackAction = 0;
+                  autoCutsOff |= 1;
+                }
+                if (!analysis.numberBinary()) {
+                  if (cliqueAction && (autoUserSet & 2) == 0) {
+                    autoCutsWere[1] = cliqueAction;
+                    cliqueAction = 0;
+                    autoCutsOff |= 2;
+                  }
+                  if (oddWheelAction && (autoUserSet & 4) == 0) {
+                    autoCutsWere[2] = oddWheelAction;
+                    oddWheelAction = 0;
+                    autoCutsOff |= 4;
+                  }
+                }
+                if ((!analysis.numberContinuous() || !analysis.rowsOfType(CbcModelAnalysis::variableBoundRow)) && flowAction && (autoUserSet & 8) == 0) {
+                  autoCutsWere[3] = flowAction;
+                  flowAction = 0;
+                  autoCutsOff |= 8;
+                }
+                // mostly set partitioning/packing with only binaries - try diving
+                int numberSetRows = analysis.rowsOfType(CbcModelAnalysis::setPartitionRow)
+                  + analysis.rowsOfType(CbcModelAnalysis::setPackingRow);
+                if (!analysis.numberContinuous() && !analysis.numberGeneralInteger()
+                  && 2 * numberSetRows > analysis.numberRows()
+                  && !parameters_[whichParam(CBC_PARAM_STR_DIVINGS, parameters_)].currentOptionAsInteger()) {
+                  autoParameters = parameters_;
+                  autoParameters[whichParam(CBC_PARAM_STR_DIVINGS, autoParameters)].setCurrentOption("on");
+                }
+                // not worth threads on tiny models (unless user asked for them)
+                autoNoThreads = (autoUserSet & 16) == 0 && analysis.numberElements() < 2000;
+                // symmetry unlikely if no columns look alike
+                autoNoOrbital = (autoUserSet & 32) == 0 && analysis.symmetryLikelihood() < 0.01;
+              }
               // Set up heuristics
-              doHeuristics(babModel_, ((!miplib) ? 1 : 10), parameters_,
+              doHeuristics(babModel_, ((!miplib) ? 1 : 10),
+                autoParameters.size() ? autoParameters : parameters_,
                 noPrinting_, initialPumpTune);
               if (!miplib) {
                 if (parameters_[whichParam(CBC_PARAM_STR_LOCALTREE, parameters_)].currentOptionAsInteger()) {
                   CbcTreeLocal localTree(babModel_, NULL, 10, 0, 0, 10000, 2000);
                   babModel_->passInTreeHandler(localTree);
+                } else if ((parameters_[whichParam(CBC_PARAM_INT_MOREMOREMIPOPTIONS, parameters_)].intValue() & 4194304) != 0) {
+                  // 4-ary heap with nodes counted in objective buckets
+                  CbcTreeBucket bucketTree;
+                  babModel_->passInTreeHandler(bucketTree);
+                } else if ((parameters_[whichParam(CBC_PARAM_INT_MOREMOREMIPOPTIONS, parameters_)].intValue() & 2097152) != 0) {
+                  // 4-ary heap with lazy pruning
+                  CbcTreeDHeap heapTree;
+                  babModel_->passInTreeHandler(heapTree);
                 }
               }
               if (type == CBC_PARAM_ACTION_MIPLIB) {
@@ -5855,7 +6123,8 @@ int CbcMain1(int argc, const char *argv[],
 #endif
               // probably faster to use a basis to get integer solutions
               babModel_->setSpecialOptions(babModel_->specialOptions() | 2);
-              currentBranchModel = babModel_;
+              if (useSignalHandler)
+                currentBranchModel = babModel_;
               //OsiSolverInterface * strengthenedModel=NULL;
               if (type == CBC_PARAM_ACTION_BAB || type == CBC_PARAM_ACTION_MIPLIB) {
                 if (strategyFlag == 1) {
@@ -5973,9 +6242,13 @@ int CbcMain1(int argc, const char *argv[],
                   std::vector< std::string > colNames;
                   if (preProcess) {
                     /* translating mipstart solution */
-                    std::map< std::string, double > mipStartV;
-                    for (size_t i = 0; (i < mipStart.size()); ++i)
-                      mipStartV[mipStart[i].first] = mipStart[i].second;
+                    CbcNameHash mipStartV;
+                    {
+                      std::vector< std::string > names(mipStart.size());
+                      for (size_t i = 0; (i < mipStart.size()); ++i)
+                        names[i] = mipStart[i].first;
+                      mipStartV.build(names);
+                    }
 
                     std::vector< std::pair< std::string, double > > mipStart2;
                     for (int i = 0; (i < babModel_->solver()->getNumCols()); ++i) {
@@ -5984,9 +6257,9 @@ int CbcMain1(int argc, const char *argv[],
                         std::string cname = model_.solver()->getColName(iColumn);
                         colNames.push_back(cname);
                         babModel_->solver()->setColName(i, cname);
-                        std::map< std::string, double >::const_iterator msIt = mipStartV.find(cname);
-                        if (msIt != mipStartV.end())
-                          mipStart2.push_back(std::pair< std::string, double >(cname, msIt->second));
+                        int msIt = mipStartV.find(cname.c_str());
+                        if (msIt >= 0)
+                          mipStart2.push_back(std::pair< std::string, double >(cname, mipStart[msIt].second));
                       } else {
                         // created variable
                         char newName[15];
@@ -6186,6 +6459,12 @@ int CbcMain1(int argc, const char *argv[],
                             }
                             obj->setNumberMembers(nn);
                           }
+                          CbcIndicator *obj2 = dynamic_cast< CbcIndicator * >(oldObjects[iObj]);
+                          if (obj2)
+                            obj2->mapColumns(newColumn);
+                          CbcPiecewise *obj3 = dynamic_cast< CbcPiecewise * >(oldObjects[iObj]);
+                          if (obj3)
+                            obj3->mapColumns(newColumn);
                         }
                         continue;
                       }
@@ -6641,7 +6920,8 @@ int CbcMain1(int argc, const char *argv[],
                   FILE *fp = fopen("user_driver.cpp", "w");
                   if (fp) {
                     // generate enough to do BAB
-                    babModel_->generateCpp(fp, 1);
+                    // 8 in cpp value says write structure of model as well
+                    babModel_->generateCpp(fp, 1 | ((cppValue & 8) ? 2 : 0));
                     OsiClpSolverInterface *osiclp = dynamic_cast< OsiClpSolverInterface * >(babModel_->solver());
                     // Make general so do factorization
                     int factor = osiclp->getModelPtr()->factorizationFrequency();
@@ -7002,6 +7282,8 @@ int CbcMain1(int argc, const char *argv[],
                 }
 #ifdef CBC_THREAD
                 int numberThreads = parameters_[whichParam(CBC_PARAM_INT_THREADS, parameters_)].intValue();
+                if (autoNoThreads)
+                  numberThreads = 0;
                 babModel_->setNumberThreads(numberThreads % 100);
                 babModel_->setThreadMode(numberThreads / 100);
 #endif
@@ -7253,6 +7535,9 @@ int CbcMain1(int argc, const char *argv[],
                 } else if (hOp1 == 10) {
                   CbcCompareObjective compare;
                   babModel_->setNodeComparison(compare);
+                } else if ((parameters_[whichParam(CBC_PARAM_INT_MOREMOREMIPOPTIONS, parameters_)].intValue() & 8388608) != 0) {
+                  CbcComparePlunge compare;
+                  babModel_->setNodeComparison(compare);
                 }
 #if CBC_OTHER_SOLVER == 1
                 if (dynamic_cast< OsiCpxSolverInterface * >(babModel_->solver()))
@@ -7514,7 +7799,7 @@ int CbcMain1(int argc, const char *argv[],
                 {
                   int jParam = whichParam(CBC_PARAM_STR_ORBITAL,
                     parameters_);
-                  if (parameters_[jParam].currentOptionAsInteger()) {
+                  if (parameters_[jParam].currentOptionAsInteger() && !autoNoOrbital) {
                     int k = parameters_[jParam].currentOptionAsInteger();
                     if (k < 4) {
                       babModel_->setMoreSpecialOptions2(babModel_->moreSpecialOptions2() | (k * 128));
@@ -7557,7 +7842,44 @@ int CbcMain1(int argc, const char *argv[],
 		  }
 		}
 #endif
+                std::vector< std::string > pseudoCostNames;
+                if (pseudoCostFile.size() || pseudoCostOutFile.size()
+                  || parameterData.keepPseudoCosts_) {
+                  // names of columns as in original model (solver ones left alone)
+                  const int *originalColumns = babModel_->originalColumns();
+                  int numberColumns = babModel_->solver()->getNumCols();
+                  for (int i = 0; i < numberColumns; i++) {
+                    int iColumn = originalColumns ? originalColumns[i] : i;
+                    if (iColumn >= 0 && iColumn < model_.getNumCols()) {
+                      pseudoCostNames.push_back(model_.solver()->getColName(iColumn));
+                    } else {
+                      pseudoCostNames.push_back("");
+                    }
+                  }
+                  babModel_->setPseudoCostColumnNames(pseudoCostNames);
+                  if (pseudoCostFile.size())
+                    babModel_->readPseudoCosts(pseudoCostFile.c_str());
+                  else if (parameterData.pseudoCostNames_.size())
+                    babModel_->setPseudoCostStart(parameterData.pseudoCostNames_,
+                      parameterData.pseudoCosts_);
+                }
                 babModel_->branchAndBound(statistics);
+                if (parameterData.keepPseudoCosts_)
+                  babModel_->getPseudoCosts(parameterData.pseudoCostNames_,
+                    parameterData.pseudoCosts_, &pseudoCostNames);
+                if (pseudoCostOutFile.size()) {
+                  if (pseudoCostOutFile == pseudoCostFile) {
+                    // would lose priorities and other columns of file
+                    sprintf(generalPrint, "pseudocosts not written - %s is priorityIn file", pseudoCostOutFile.c_str());
+                  } else {
+                    int numberWritten = babModel_->writePseudoCosts(pseudoCostOutFile.c_str(), &pseudoCostNames);
+                    if (numberWritten >= 0)
+                      sprintf(generalPrint, "%d pseudocosts written to %s", numberWritten, pseudoCostOutFile.c_str());
+                    else
+                      sprintf(generalPrint, "Unable to open file %s", pseudoCostOutFile.c_str());
+                  }
+                  printGeneralMessage(model_, generalPrint);
+                }
 #ifdef CBC_HAS_NAUTY
                 if (nautyAdded) {
                   int *which = new int[nautyAdded];
@@ -7644,6 +7966,8 @@ int CbcMain1(int argc, const char *argv[],
                 babModel_->setStrategy(strategy);
 #ifdef CBC_THREAD
                 int numberThreads = parameters_[whichParam(CBC_PARAM_INT_THREADS, parameters_)].intValue();
+                if (autoNoThreads)
+                  numberThreads = 0;
                 babModel_->setNumberThreads(numberThreads % 100);
                 babModel_->setThreadMode(numberThreads / 100);
 #endif
@@ -7761,7 +8085,8 @@ int CbcMain1(int argc, const char *argv[],
                 abort(); // can't get here
                 //strengthenedModel = babModel_->strengthenedModel();
               }
-              currentBranchModel = NULL;
+              if (useSignalHandler)
+                currentBranchModel = NULL;
 #ifndef CBC_OTHER_SOLVER
               osiclp = dynamic_cast< OsiClpSolverInterface * >(babModel_->solver());
               if (debugFile == "createAfterPre" && babModel_->bestSolution()) {
@@ -7820,6 +8145,20 @@ int CbcMain1(int argc, const char *argv[],
                     << generalPrint
                     << CoinMessageEol;
                 }
+                for (iGenerator = 0; iGenerator < babModel_->numberHeuristics(); iGenerator++) {
+                  CbcHeuristic *heuristic = babModel_->heuristic(iGenerator);
+                  if (!heuristic->timeUsed())
+                    continue;
+                  sprintf(generalPrint, "Heuristic %s took %.3f seconds and %d iterations and improved solution %d times (total gain %g)",
+                    heuristic->heuristicName(),
+                    heuristic->timeUsed(),
+                    heuristic->iterationsUsed(),
+                    heuristic->numberImprovements(),
+                    heuristic->objectiveGain());
+                  generalMessageHandler->message(CLP_GENERAL, generalMessages)
+                    << generalPrint
+                    << CoinMessageEol;
+                }
 #ifdef COIN_DEVELOP
                 printf("%d solutions found by heuristics\n",
                   babModel_->getNumberHeuristicSolutions());
@@ -8474,9 +8813,14 @@ int CbcMain1(int argc, const char *argv[],
 #ifndef CBC_OTHER_SOLVER
               ClpSimplex *lpSolver = clpSolver->getModelPtr();
               if (!gmpl) {
-                status = clpSolver->readMps(fileName.c_str(),
-                  keepImportNames != 0,
-                  allowImportErrors != 0);
+                // straight into solver - CoinMpsIO if file has sections not handled
+                CbcMpsReader reader;
+                status = reader.readMps(fileName.c_str(), clpSolver,
+                  keepImportNames != 0);
+                if (status == CbcMpsReader::unsupported)
+                  status = clpSolver->readMps(fileName.c_str(),
+                    keepImportNames != 0,
+                    allowImportErrors != 0);
               } else if (gmpl > 0) {
                 status = lpSolver->readGMPL(fileName.c_str(),
                   (gmpl == 2) ? gmplData.c_str() : NULL,
@@ -8610,7 +8954,7 @@ int CbcMain1(int argc, const char *argv[],
                 totalTime += time2 - time1;
                 time1 = time2;
                 // Go to canned file if just input file
-                if (getCbcOrClpReadMode() == 2 && argc == 2) {
+                if (whichArgument < 0 && getCbcOrClpReadMode() == 2 && argc == 2) {
                   // only if ends .mps
                   char *find = const_cast< char * >(strstr(fileName.c_str(), ".mps"));
                   if (find && find[4] == '\0') {
@@ -9001,9 +9345,9 @@ int CbcMain1(int argc, const char *argv[],
               if (fp) {
                 // can open - lets go for it
                 std::string headings[] = { "name", "number", "direction", "priority", "up", "down",
-                  "solution", "priin" };
-                int got[] = { -1, -1, -1, -1, -1, -1, -1, -1 };
-                int order[8];
+                  "solution", "priin", "downcount", "upcount" };
+                int got[] = { -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 };
+                int order[10];
                 bool useMasks = false;
                 if (strstr(fileName.c_str(), "mask_")) {
                   // look more closely
@@ -9311,6 +9655,12 @@ int CbcMain1(int argc, const char *argv[],
                       free(columnNames[iColumn]);
                     }
                     delete[] columnNames;
+                    // counts as well - so use as pseudocosts learnt last time
+                    // (written to pseudoCostOut file, never back to this one)
+                    if (got[0] >= 0 && (got[8] >= 0 || got[9] >= 0))
+                      pseudoCostFile = fileName;
+                    else
+                      pseudoCostFile = "";
                   } else {
                     std::cout << "Duplicate or unknown keyword - or name/number fields wrong" << line << std::endl;
                   }
@@ -9551,7 +9901,46 @@ int CbcMain1(int argc, const char *argv[],
               sprintf(generalPrint, "Unable to open file %s", fileName.c_str());
               printGeneralMessage(model_, generalPrint);
             }
-            if (canOpen) {
+            if (canOpen && ends_with(fileName, ".cbcsnap")) {
+              // binary snapshot of whole MIP
+              CbcSnapshotExtra extra;
+              memset(&extra, 0, sizeof(extra));
+              extra.priorities = priorities;
+              extra.numberSOS = numberSOS;
+              extra.sosStart = sosStart;
+              extra.sosType = sosType;
+              extra.sosPriority = sosPriority;
+              extra.sosIndices = sosIndices;
+              extra.sosReference = sosReference;
+              std::vector< int > mipStartColumns;
+              std::vector< double > mipStartValues;
+              if (mipStart.size()) {
+                std::map< std::string, int > columnIndex;
+                for (int i = 0; i < clpSolver->getNumCols(); i++)
+                  columnIndex[clpSolver->getColName(i)] = i;
+                for (size_t i = 0; i < mipStart.size(); i++) {
+                  std::map< std::string, int >::const_iterator it = columnIndex.find(mipStart[i].first);
+                  if (it != columnIndex.end()) {
+                    mipStartColumns.push_back(it->second);
+                    mipStartValues.push_back(mipStart[i].second);
+                  }
+                }
+                extra.numberMipStart = static_cast< int >(mipStartColumns.size());
+                if (extra.numberMipStart) {
+                  extra.mipStartColumns = &mipStartColumns[0];
+                  extra.mipStartValues = &mipStartValues[0];
+                }
+              }
+              printf("Saving snapshot on %s\n", fileName.c_str());
+              if (!CbcSnapshot::write(fileName.c_str(), clpSolver, &extra)) {
+                time2 = CoinCpuTime();
+                totalTime += time2 - time1;
+                time1 = time2;
+              } else {
+                sprintf(generalPrint, "There were errors on output");
+                printGeneralMessage(model_, generalPrint);
+              }
+            } else if (canOpen) {
               int status;
               // If presolve on then save presolved
               bool deleteModel2 = false;
@@ -9626,7 +10015,58 @@ int CbcMain1(int argc, const char *argv[],
               sprintf(generalPrint, "Unable to open file %s", fileName.c_str());
               printGeneralMessage(model_, generalPrint);
             }
-            if (canOpen) {
+            if (canOpen && CbcSnapshot::isSnapshot(fileName.c_str())) {
+              // binary snapshot of whole MIP - arrays used from mapped file
+              CbcSnapshot snapshot;
+              if (!snapshot.open(fileName.c_str())) {
+                snapshot.load(clpSolver);
+                int numberColumns = snapshot.numberColumns();
+                free(priorities);
+                priorities = NULL;
+                if (snapshot.priorities()) {
+                  priorities = reinterpret_cast< int * >(malloc(numberColumns * sizeof(int)));
+                  memcpy(priorities, snapshot.priorities(), numberColumns * sizeof(int));
+                }
+                free(sosStart);
+                sosStart = NULL;
+                free(sosIndices);
+                sosIndices = NULL;
+                free(sosType);
+                sosType = NULL;
+                free(sosReference);
+                sosReference = NULL;
+                free(sosPriority);
+                sosPriority = NULL;
+                numberSOS = snapshot.numberSOS();
+                if (numberSOS) {
+                  int numberInSets = snapshot.sosStart()[numberSOS];
+                  sosStart = reinterpret_cast< int * >(malloc((numberSOS + 1) * sizeof(int)));
+                  memcpy(sosStart, snapshot.sosStart(), (numberSOS + 1) * sizeof(int));
+                  sosType = reinterpret_cast< char * >(malloc(numberSOS * sizeof(char)));
+                  memcpy(sosType, snapshot.sosType(), numberSOS * sizeof(char));
+                  if (snapshot.sosPriority()) {
+                    sosPriority = reinterpret_cast< int * >(malloc(numberSOS * sizeof(int)));
+                    memcpy(sosPriority, snapshot.sosPriority(), numberSOS * sizeof(int));
+                  }
+                  sosIndices = reinterpret_cast< int * >(malloc(numberInSets * sizeof(int)));
+                  memcpy(sosIndices, snapshot.sosIndices(), numberInSets * sizeof(int));
+                  sosReference = reinterpret_cast< double * >(malloc(numberInSets * sizeof(double)));
+                  memcpy(sosReference, snapshot.sosReference(), numberInSets * sizeof(double));
+                }
+                mipStart.clear();
+                const int *mipStartColumns = snapshot.mipStartColumns();
+                const double *mipStartValues = snapshot.mipStartValues();
+                for (int i = 0; i < snapshot.numberMipStart(); i++)
+                  mipStart.push_back(std::pair< std::string, double >(clpSolver->getColName(mipStartColumns[i]), mipStartValues[i]));
+                goodModel = true;
+                time2 = CoinCpuTime();
+                totalTime += time2 - time1;
+                time1 = time2;
+              } else {
+                sprintf(generalPrint, "There were errors on input");
+                printGeneralMessage(model_, generalPrint);
+              }
+            } else if (canOpen) {
               int status = lpSolver->restoreModel(fileName.c_str());
               if (!status) {
                 goodModel = true;
@@ -9726,7 +10166,8 @@ int CbcMain1(int argc, const char *argv[],
             }
           } break;
           case CLP_PARAM_ACTION_STDIN:
-            setCbcOrClpReadMode(-1);
+            if (whichArgument < 0)
+              setCbcOrClpReadMode(-1);
             break;
           case CLP_PARAM_ACTION_NETLIB_DUAL:
           case CLP_PARAM_ACTION_NETLIB_EITHER:
@@ -11026,7 +11467,7 @@ void CbcMain0(CbcModel &model,
   parameters[whichParam(CBC_PARAM_DBL_INCREMENT, parameters)].setDoubleValue(model.getDblParam(CbcModel::CbcCutoffIncrement));
   parameters[whichParam(CBC_PARAM_INT_TESTOSI, parameters)].setIntValue(testOsiParameters);
   parameters[whichParam(CBC_PARAM_INT_FPUMPTUNE, parameters)].setIntValue(1003);
-  initialPumpTune = 1003;
+  parameterData.initialPumpTune_ = 1003;
 #ifdef CBC_THREAD
   parameters[whichParam(CBC_PARAM_INT_THREADS, parameters)].setIntValue(0);
 #endif
@@ -12570,6 +13011,7 @@ static void generateCode(CbcModel * /*model*/, const char *fileName, int type, i
 {
   // options on code generation
   bool sizecode = (type & 4) != 0;
+  bool structure = (type & 8) != 0;
   type &= 3;
   FILE *fp = fopen(fileName, "r");
   assert(fp);
@@ -12589,6 +13031,8 @@ static void generateCode(CbcModel * /*model*/, const char *fileName, int type, i
   strcpy(line[numberLines++], "0#include \"CbcStrategy.hpp\"");
   strcpy(line[numberLines++], "0#include \"CglPreProcess.hpp\"");
   strcpy(line[numberLines++], "0#include \"CoinTime.hpp\"");
+  if (structure)
+    strcpy(line[numberLines++], "0#include \"CbcObject.hpp\"");
   if (preProcess > 0)
     strcpy(line[numberLines++], "0#include \"CglProbing.hpp\""); // possibly redundant
   // To allow generated 5's to be just before branchAndBound - do rest here
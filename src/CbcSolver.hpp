@@ -27,6 +27,7 @@
 
 #include "CbcModel.hpp"
 #include "CbcOrClpParam.hpp"
+#include "CbcModelAnalysis.hpp"
 #include "CbcSolverConfig.h"
 
 class CbcUser;
@@ -296,11 +297,28 @@ public:
   bool noPrinting_;
   // Whether to use signal handler
   bool useSignalHandler_;
+  /** If true commands are only read from arguments (never stdin) and
+      no global state is used - so separate models can be solved by
+      CbcMain1 on several threads at once (with useSignalHandler_ false) */
+  bool argumentsOnly_;
   // Default pump tuning
   int initialPumpTune_;
   // even with verbose >=1  this may not be the first call to
   // the solver
   bool printWelcome_;
+  /** If true pseudocosts in pseudoCostNames_ and pseudoCosts_ are used
+      at start of branch and bound and replaced by ones learnt (by name
+      of original column) - so a session can solve related problems */
+  bool keepPseudoCosts_;
+  // Names of columns with pseudocosts kept
+  std::vector< std::string > pseudoCostNames_;
+  // Down, up, down count and up count for each name
+  std::vector< double > pseudoCosts_;
+  /** If true model is analyzed before branch and bound and cut
+      generators, heuristics and threads chosen from analysis */
+  bool autoConfigure_;
+  // Analysis of last model (kept so not redone on same model)
+  CbcModelAnalysis analysis_;
 
   //@}
 };
@@ -15,6 +15,9 @@
 #include "CbcConfig.h"
 #include "CoinPragma.hpp"
 
+#include <vector>
+
+#include "CoinTime.hpp"
 #include "OsiSolverInterface.hpp"
 
 #include "CglStored.hpp"
@@ -29,33 +32,86 @@
 #ifdef COIN_HAS_LINK
 
 
-/* Expands out all possible combinations for a knapsack
-   If buildObj NULL then just computes space needed - returns number elements
-   On entry numberOutput is maximum allowed, on exit it is number needed or
-   -1 (as will be number elements) if maximum exceeded.  numberOutput will have at
-   least space to return values which reconstruct input.
+/* Upper bound on number of expanded columns - number of ways of picking
+   values in bounds with size in [minSize,maxSize] ignoring other rows.
+   Counted by dynamic programming when sizes are integer and maxSize
+   is not too large, otherwise product of ranges.  Stops counting at
+   (about) limit.
+*/
+static double estimateKnapsack(int numJ, const int *bound, const double *size,
+  double minSize, double maxSize, double limit)
+{
+  double product = 1.0;
+  bool integral = (maxSize < 1.0e6);
+  for (int j = 0; j < numJ; j++) {
+    product *= bound[j] + 1.0;
+    if (product > limit)
+      product = limit + 1.0;
+    if (fabs(floor(size[j] + 0.5) - size[j]) > 1.0e-9 || size[j] < 0.5)
+      integral = false;
+  }
+  if (!integral || product <= limit || maxSize < 0.0)
+    return product;
+  int maxS = static_cast< int >(floor(maxSize + 1.0e-7));
+  int minS = minSize > 0.0 ? static_cast< int >(ceil(minSize - 1.0e-7)) : 0;
+  // count[s] number of ways of getting size s (fixed sizes so windowed sums)
+  std::vector< double > count(maxS + 1, 0.0);
+  std::vector< double > newCount(maxS + 1);
+  count[0] = 1.0;
+  for (int j = 0; j < numJ; j++) {
+    int sizeJ = static_cast< int >(floor(size[j] + 0.5));
+    // size of bound+1 copies (may be past maxS)
+    double width = (bound[j] + 1.0) * sizeJ;
+    int iWidth = width <= maxS ? static_cast< int >(width) : maxS + 1;
+    for (int s = 0; s <= maxS; s++) {
+      double value = count[s];
+      if (s >= sizeJ)
+        value += newCount[s - sizeJ];
+      if (s >= iWidth)
+        value -= count[s - iWidth];
+      // keep bounded so no overflow
+      newCount[s] = CoinMin(CoinMax(value, 0.0), 1.0e30);
+    }
+    count.swap(newCount);
+  }
+  double estimate = 0.0;
+  for (int s = minS; s <= maxS; s++)
+    estimate += count[s];
+  return estimate;
+}
+
+/* Expands out all possible combinations for a knapsack in one pass,
+   columns appended in column order (buildStart, buildRow, buildElement).
+   fullModel is cm loaded into Clp (so only columns in knapsack are copied).
+   Returns number of columns or -1 if more than maximumColumns columns,
+   maximumElements elements (if >0) or time past endTime (if >0) - first
+   checked on estimate.
    Rows returned will be original rows but no entries will be returned for
    any rows all of whose entries are in knapsack.  So up to user to allow for this.
-   If reConstruct >=0 then returns number of entrie which make up item "reConstruct"
+   If reConstruct >=0 then returns number of entries which make up item "reConstruct"
    in expanded knapsack.  Values in buildRow and buildElement;
 */
-int expandKnapsack(CoinModel& cm, int knapsackRow, int &numberOutput, double *buildObj, CoinBigIndex *buildStart,
-  int *buildRow, double *buildElement, int reConstruct = -1)
+static int expandKnapsack(CoinModel &cm, const ClpSimplex &fullModel, int knapsackRow,
+  int maximumColumns, CoinBigIndex maximumElements, double endTime,
+  std::vector< double > &buildObj, std::vector< CoinBigIndex > &buildStart,
+  std::vector< int > &buildRow, std::vector< double > &buildElement, int reConstruct = -1)
 {
+  buildObj.clear();
+  buildStart.clear();
+  buildRow.clear();
+  buildElement.clear();
   /* mark rows
        -2 in knapsack and other variables
        -1 not involved
        0 only in knapsack
     */
-  int *markRow = new int[cm.numberRows_];
+  int numberRows = cm.numberRows();
+  int numberColumns = cm.numberColumns();
+  std::vector< int > markRow(numberRows, -1);
+  std::vector< int > whichColumn(numberColumns, -1);
   int iRow;
   int iColumn;
-  int *whichColumn = new int[cm.numberColumns_];
-  for (iColumn = 0; iColumn < cm.numberColumns_; iColumn++)
-    whichColumn[iColumn] = -1;
   int numJ = 0;
-  for (iRow = 0; iRow < cm.numberRows_; iRow++)
-    markRow[iRow] = -1;
   CoinModelLink triple;
   triple = cm.firstInRow(knapsackRow);
   while (triple.column() >= 0) {
@@ -68,7 +124,7 @@ int expandKnapsack(CoinModel& cm, int knapsackRow, int &numberOutput, double *bu
     numJ++;
     triple = cm.next(triple);
   }
-  for (iRow = 0; iRow < cm.numberRows_; iRow++) {
+  for (iRow = 0; iRow < numberRows; iRow++) {
     triple = cm.firstInRow(iRow);
     int type = -3;
     while (triple.column() >= 0) {
@@ -90,16 +146,10 @@ int expandKnapsack(CoinModel& cm, int knapsackRow, int &numberOutput, double *bu
       type = -1;
     markRow[iRow] = type;
   }
-  int *bound = new int[cm.numberColumns_ + 1];
-  int *whichRow = new int[cm.numberRows_];
-  ClpSimplex tempModel;
-  CoinModel tempModel2(cm);
-  tempModel.loadProblem(tempModel2);
-  int *stack = new int[cm.numberColumns_ + 1];
-  double *size = new double[cm.numberColumns_ + 1];
-  double *rhsOffset = new double[cm.numberRows_];
-  int *build = new int[cm.numberColumns_];
-  int maxNumber = numberOutput;
+  std::vector< int > bound(numJ + 1);
+  std::vector< int > stack(numJ + 1);
+  std::vector< double > size(numJ + 1);
+  std::vector< int > build(numberRows);
   numJ = 0;
   double minSize = cm.getRowLower(knapsackRow);
   double maxSize = cm.getRowUpper(knapsackRow);
@@ -119,15 +169,19 @@ int expandKnapsack(CoinModel& cm, int knapsackRow, int &numberOutput, double *bu
     offset += triple.value() * lowerColumn;
     triple = cm.next(triple);
   }
+  maxSize -= offset;
+  minSize -= offset;
+  if (reConstruct < 0 && estimateKnapsack(numJ, &bound[0], &size[0], minSize, maxSize, maximumColumns) > maximumColumns)
+    return -1;
+  std::vector< int > whichRow(numberRows);
   int jRow;
-  for (iRow = 0; iRow < cm.numberRows_; iRow++)
+  for (iRow = 0; iRow < numberRows; iRow++)
     whichRow[iRow] = iRow;
-  ClpSimplex smallModel(&tempModel, cm.numberRows_, whichRow, numJ, whichColumn, true, true, true);
+  ClpSimplex smallModel(&fullModel, numberRows, &whichRow[0], numJ, &whichColumn[0], true, true, true);
   // modify rhs to allow for nonzero lower bounds
   double *rowLower = smallModel.rowLower();
   double *rowUpper = smallModel.rowUpper();
   const double *columnLower = smallModel.columnLower();
-  //const double * columnUpper = smallModel.columnUpper();
   const CoinPackedMatrix *matrix = smallModel.matrix();
   const double *element = matrix->getElements();
   const int *row = matrix->getIndices();
@@ -135,7 +189,6 @@ int expandKnapsack(CoinModel& cm, int knapsackRow, int &numberOutput, double *bu
   const int *columnLength = matrix->getVectorLengths();
   const double *objective = smallModel.objective();
   double objectiveOffset = 0.0;
-  CoinZeroN(rhsOffset, cm.numberRows_);
   for (iColumn = 0; iColumn < numJ; iColumn++) {
     double lower = columnLower[iColumn];
     if (lower) {
@@ -144,7 +197,6 @@ int expandKnapsack(CoinModel& cm, int knapsackRow, int &numberOutput, double *bu
            j < columnStart[iColumn] + columnLength[iColumn]; j++) {
         double value = element[j] * lower;
         int kRow = row[j];
-        rhsOffset[kRow] += value;
         if (rowLower[kRow] > -1.0e20)
           rowLower[kRow] -= value;
         if (rowUpper[kRow] < 1.0e20)
@@ -153,7 +205,7 @@ int expandKnapsack(CoinModel& cm, int knapsackRow, int &numberOutput, double *bu
     }
   }
   // relax
-  for (jRow = 0; jRow < cm.numberRows_; jRow++) {
+  for (jRow = 0; jRow < numberRows; jRow++) {
     if (markRow[jRow] == 0 && knapsackRow != jRow) {
       if (rowLower[jRow] > -1.0e20)
         rowLower[jRow] -= 1.0e-7;
@@ -165,9 +217,7 @@ int expandKnapsack(CoinModel& cm, int knapsackRow, int &numberOutput, double *bu
     }
   }
   double *rowActivity = smallModel.primalRowSolution();
-  CoinZeroN(rowActivity, cm.numberRows_);
-  maxSize -= offset;
-  minSize -= offset;
+  CoinZeroN(rowActivity, numberRows);
   // now generate
   int i;
   int iStack = numJ;
@@ -179,26 +229,21 @@ int expandKnapsack(CoinModel& cm, int knapsackRow, int &numberOutput, double *bu
   size[numJ] = tooMuch;
   bound[numJ] = 0;
   double sum = tooMuch;
-  numberOutput = 0;
-  int nelCreate = 0;
-  /* typeRun is - 0 for initial sizes
-                    1 for build
-      	  2 for reconstruct
-    */
-  int typeRun = buildObj ? 1 : 0;
-  if (reConstruct >= 0) {
-    assert(buildRow && buildElement);
-    typeRun = 2;
-  }
-  if (typeRun == 1)
-    buildStart[0] = 0;
+  int numberOutput = 0;
+  int numberPasses = 0;
+  if (reConstruct < 0)
+    buildStart.push_back(0);
   while (iStack >= 0) {
+    // check time now and then
+    if (endTime > 0.0 && ((++numberPasses) & 1023) == 0 && CoinCpuTime() > endTime) {
+      numberOutput = -1;
+      break;
+    }
     if (sum >= minSize && sum <= maxSize) {
       double checkSize = 0.0;
       bool good = true;
       int nRow = 0;
       double obj = objectiveOffset;
-      // nRow is zero? CoinZeroN(rowActivity,nRow);
       for (iColumn = 0; iColumn < numJ; iColumn++) {
         int iValue = stack[iColumn];
         if (iValue > bound[iColumn]) {
@@ -232,55 +277,32 @@ int expandKnapsack(CoinModel& cm, int knapsackRow, int &numberOutput, double *bu
         }
       }
       if (good) {
-        if (typeRun == 1) {
-          buildObj[numberOutput] = obj;
-          for (jRow = 0; jRow < nRow; jRow++) {
-            int kRow = build[jRow];
-            double value = rowActivity[kRow];
-            if (markRow[kRow] < 0 && fabs(value) > 1.0e-13) {
-              buildElement[nelCreate] = value;
-              buildRow[nelCreate++] = kRow;
-            }
-          }
-          buildStart[numberOutput + 1] = nelCreate;
-        } else if (!typeRun) {
+        if (reConstruct < 0) {
+          buildObj.push_back(obj);
           for (jRow = 0; jRow < nRow; jRow++) {
             int kRow = build[jRow];
             double value = rowActivity[kRow];
             if (markRow[kRow] < 0 && fabs(value) > 1.0e-13) {
-              nelCreate++;
+              buildElement.push_back(value);
+              buildRow.push_back(kRow);
             }
           }
-        }
-        if (typeRun == 2 && reConstruct == numberOutput) {
+          buildStart.push_back(static_cast< CoinBigIndex >(buildRow.size()));
+        } else if (reConstruct == numberOutput) {
           // build and exit
-          nelCreate = 0;
           for (iColumn = 0; iColumn < numJ; iColumn++) {
             int iValue = stack[iColumn];
             if (iValue) {
-              buildRow[nelCreate] = whichColumn[iColumn];
-              buildElement[nelCreate++] = iValue;
+              buildRow.push_back(whichColumn[iColumn]);
+              buildElement.push_back(iValue);
             }
           }
-          numberOutput = 1;
-          for (i = 0; i < numJ; i++) {
-            bound[i] = 0;
-          }
+          numberOutput = static_cast< int >(buildRow.size());
           break;
         }
         numberOutput++;
-        if (numberOutput > maxNumber) {
-          nelCreate = -1;
+        if (reConstruct < 0 && (numberOutput > maximumColumns || (maximumElements > 0 && static_cast< CoinBigIndex >(buildRow.size()) > maximumElements))) {
           numberOutput = -1;
-          for (i = 0; i < numJ; i++) {
-            bound[i] = 0;
-          }
-          break;
-        } else if (typeRun == 1 && numberOutput == maxNumber) {
-          // On second run
-          for (i = 0; i < numJ; i++) {
-            bound[i] = 0;
-          }
           break;
         }
         for (int j = 0; j < numJ; j++) {
@@ -308,23 +330,24 @@ int expandKnapsack(CoinModel& cm, int knapsackRow, int &numberOutput, double *bu
       stack[iStack]++;
     }
   }
-  //printf("%d will be created\n",numberOutput);
-  delete[] whichColumn;
-  delete[] whichRow;
-  delete[] bound;
-  delete[] stack;
-  delete[] size;
-  delete[] rhsOffset;
-  delete[] build;
-  delete[] markRow;
-  return nelCreate;
+  if (reConstruct >= 0) {
+    // number of entries (0 if not found)
+    return static_cast< int >(buildRow.size());
+  } else if (numberOutput < 0) {
+    buildObj.clear();
+    buildStart.clear();
+    buildRow.clear();
+    buildElement.clear();
+  }
+  return numberOutput;
 }
 
 OsiSolverInterface *
 expandKnapsack(CoinModel &model, int *whichColumn, int *knapsackStart,
   int *knapsackRow, int &numberKnapsack,
   CglStored &stored, int logLevel,
-  int fixedPriority, int SOSPriority, CoinModel &tightenedModel)
+  int fixedPriority, int SOSPriority, CoinModel &tightenedModel,
+  double maximumSeconds, CoinBigIndex maximumElements)
 {
   int maxTotal = numberKnapsack;
   // load from coin model
@@ -680,84 +703,97 @@ expandKnapsack(CoinModel &model, int *whichColumn, int *knapsackStart,
         whichRow[iRow] = iRow;
       }
       int numberOther = finalModel->getNumCols();
-      int nLargest = 0;
-      int nelLargest = 0;
+      /*
+        Each knapsack is expanded in one pass straight into column form
+        and appended, giving up (so caller keeps unexpanded model) as soon
+        as total columns, elements or time go over budget.
+      */
+      double endTime = maximumSeconds > 0.0 ? CoinCpuTime() + maximumSeconds : 0.0;
       int nTotal = 0;
+      std::vector< double > buildObj;
+      std::vector< CoinBigIndex > buildStart;
+      std::vector< int > buildRow;
+      std::vector< double > buildElement;
+      // integers in knapsacks and SOS for nonlinear ones
+      std::vector< OsiObject * > intObject;
+      std::vector< OsiObject * > sosObject;
       for (iKnapsack = 0; iKnapsack < numberKnapsack; iKnapsack++) {
+        knapsackStart[iKnapsack] = finalModel->getNumCols();
         iRow = knapsackRow[iKnapsack];
-        int nCreate = maxTotal;
-        int nelCreate = expandKnapsack(coinModel, iRow, nCreate, NULL, NULL, NULL, NULL);
-        if (nelCreate < 0)
+        CoinBigIndex elementsLeft = 0;
+        if (maximumElements > 0) {
+          elementsLeft = maximumElements - finalModel->getNumElements();
+          if (elementsLeft <= 0) {
+            badModel = true;
+            break;
+          }
+        }
+        int nCreate = expandKnapsack(coinModel, tempModel, iRow, maxTotal - nTotal,
+          elementsLeft, endTime, buildObj, buildStart, buildRow, buildElement);
+        if (nCreate < 0) {
           badModel = true;
+          break;
+        }
         nTotal += nCreate;
-        nLargest = CoinMax(nLargest, nCreate);
-        nelLargest = CoinMax(nelLargest, nelCreate);
-      }
-      if (nTotal > maxTotal)
-        badModel = true;
-      if (!badModel) {
-        // Now arrays for building
-        nelLargest = CoinMax(nelLargest, nLargest) + 1;
-        double *buildObj = new double[nLargest];
-        double *buildElement = new double[nelLargest];
-        CoinBigIndex *buildStart = new CoinBigIndex[nLargest + 1];
-        int *buildRow = new int[nelLargest];
-        // alow for integers in knapsacks
-        OsiObject **object = new OsiObject *[numberKnapsack + nTotal];
-        int nSOS = 0;
-        int nObj = numberKnapsack;
-        for (iKnapsack = 0; iKnapsack < numberKnapsack; iKnapsack++) {
-          knapsackStart[iKnapsack] = finalModel->getNumCols();
-          iRow = knapsackRow[iKnapsack];
-          int nCreate = 10000;
-          expandKnapsack(coinModel, iRow, nCreate, buildObj, buildStart, buildRow, buildElement);
-          // Redo row numbers
-          for (iColumn = 0; iColumn < nCreate; iColumn++) {
-            for (CoinBigIndex j = buildStart[iColumn]; j < buildStart[iColumn + 1]; j++) {
-              int jRow = buildRow[j];
-              jRow = lookupRow[jRow];
-              assert(jRow >= 0 && jRow < nRow);
-              buildRow[j] = jRow;
-            }
-          }
-          finalModel->addCols(nCreate, buildStart, buildRow, buildElement, NULL, NULL, buildObj);
-          int numberFinal = finalModel->getNumCols();
-          for (iColumn = numberOther; iColumn < numberFinal; iColumn++) {
-            if (markKnapsack[iKnapsack] < 0) {
-              finalModel->setColUpper(iColumn, maxCoefficient);
-              finalModel->setInteger(iColumn);
-            } else {
-              finalModel->setColUpper(iColumn, maxCoefficient + 1.0);
-              finalModel->setInteger(iColumn);
-            }
-            OsiSimpleInteger *sosObject = new OsiSimpleInteger(finalModel, iColumn);
-            sosObject->setPriority(1000000);
-            object[nObj++] = sosObject;
-            buildRow[iColumn - numberOther] = iColumn;
-            buildElement[iColumn - numberOther] = 1.0;
-          }
+        // Redo row numbers
+        for (size_t j = 0; j < buildRow.size(); j++) {
+          int jRow = lookupRow[buildRow[j]];
+          assert(jRow >= 0 && jRow < nRow);
+          buildRow[j] = jRow;
+        }
+        if (nCreate)
+          finalModel->addCols(nCreate, &buildStart[0], buildRow.size() ? &buildRow[0] : NULL,
+            buildElement.size() ? &buildElement[0] : NULL, NULL, NULL, &buildObj[0]);
+        int numberFinal = finalModel->getNumCols();
+        buildRow.resize(nCreate + 1);
+        buildElement.resize(nCreate + 1);
+        for (iColumn = numberOther; iColumn < numberFinal; iColumn++) {
           if (markKnapsack[iKnapsack] < 0) {
-            // convexity row
-            finalModel->addRow(numberFinal - numberOther, buildRow, buildElement, 1.0, 1.0);
+            finalModel->setColUpper(iColumn, maxCoefficient);
+            finalModel->setInteger(iColumn);
           } else {
-            int iColumn = markKnapsack[iKnapsack];
-            int n = numberFinal - numberOther;
-            buildRow[n] = iColumn;
-            buildElement[n++] = -fabs(coefficient[iKnapsack]);
-            // convexity row (sort of)
-            finalModel->addRow(n, buildRow, buildElement, 0.0, 0.0);
-            OsiSOS *sosObject = new OsiSOS(finalModel, n - 1, buildRow, NULL, 1);
-            sosObject->setPriority(iKnapsack + SOSPriority);
-            // Say not integral even if is (switch off heuristics)
-            sosObject->setIntegerValued(false);
-            object[nSOS++] = sosObject;
+            finalModel->setColUpper(iColumn, maxCoefficient + 1.0);
+            finalModel->setInteger(iColumn);
           }
-          numberOther = numberFinal;
+          OsiSimpleInteger *integerObject = new OsiSimpleInteger(finalModel, iColumn);
+          integerObject->setPriority(1000000);
+          intObject.push_back(integerObject);
+          buildRow[iColumn - numberOther] = iColumn;
+          buildElement[iColumn - numberOther] = 1.0;
+        }
+        if (markKnapsack[iKnapsack] < 0) {
+          // convexity row
+          finalModel->addRow(numberFinal - numberOther, &buildRow[0], &buildElement[0], 1.0, 1.0);
+        } else {
+          int iColumn = markKnapsack[iKnapsack];
+          int n = numberFinal - numberOther;
+          buildRow[n] = iColumn;
+          buildElement[n++] = -fabs(coefficient[iKnapsack]);
+          // convexity row (sort of)
+          finalModel->addRow(n, &buildRow[0], &buildElement[0], 0.0, 0.0);
+          OsiSOS *sos = new OsiSOS(finalModel, n - 1, &buildRow[0], NULL, 1);
+          sos->setPriority(iKnapsack + SOSPriority);
+          // Say not integral even if is (switch off heuristics)
+          sos->setIntegerValued(false);
+          sosObject.push_back(sos);
         }
-        finalModel->addObjects(nObj, object);
-        for (iKnapsack = 0; iKnapsack < nObj; iKnapsack++)
-          delete object[iKnapsack];
-        delete[] object;
+        numberOther = numberFinal;
+      }
+      if (badModel) {
+        if (logLevel > 0)
+          printf("knapsack %d would take expanded model over budget\n", iKnapsack);
+      } else {
+        // SOS first
+        std::vector< OsiObject * > object(sosObject);
+        object.insert(object.end(), intObject.begin(), intObject.end());
+        if (object.size())
+          finalModel->addObjects(static_cast< int >(object.size()), &object[0]);
+      }
+      for (size_t i = 0; i < sosObject.size(); i++)
+        delete sosObject[i];
+      for (size_t i = 0; i < intObject.size(); i++)
+        delete intObject[i];
+      if (!badModel) {
         // Can we move any rows to cuts
         const int *cutMarker = coinModel.cutMarker();
         if (cutMarker && 0) {
@@ -787,10 +823,6 @@ expandKnapsack(CoinModel &model, int *whichColumn, int *knapsackStart,
           finalModel->deleteRows(nDelete, whichRow);
         }
         knapsackStart[numberKnapsack] = finalModel->getNumCols();
-        delete[] buildObj;
-        delete[] buildElement;
-        delete[] buildStart;
-        delete[] buildRow;
         finalModel->writeMps("full");
       }
     }
@@ -833,8 +865,12 @@ void afterKnapsack(const CoinModel &coinModel2, const int *whichColumn, const in
     int jColumn = whichColumn[iColumn];
     solution[jColumn] = knapsackSolution[iColumn];
   }
-  int *buildRow = new int[numberColumns]; // wild overkill
-  double *buildElement = new double[numberColumns];
+  ClpSimplex tempModel;
+  tempModel.loadProblem(coinModel);
+  std::vector< double > buildObj;
+  std::vector< CoinBigIndex > buildStart;
+  std::vector< int > buildRow;
+  std::vector< double > buildElement;
   int iKnapsack;
   for (iKnapsack = 0; iKnapsack < numberKnapsack; iKnapsack++) {
     int k = -1;
@@ -851,8 +887,8 @@ void afterKnapsack(const CoinModel &coinModel2, const int *whichColumn, const in
     }
     if (k >= 0) {
       int iRow = knapsackRow[iKnapsack];
-      int nCreate = 10000;
-      int nel = expandKnapsack(coinModel, iRow, nCreate, NULL, NULL, buildRow, buildElement, k - knapsackStart[iKnapsack]);
+      int nel = expandKnapsack(coinModel, tempModel, iRow, COIN_INT_MAX, 0, 0.0,
+        buildObj, buildStart, buildRow, buildElement, k - knapsackStart[iKnapsack]);
       assert(nel);
       if (logLevel > 0)
         printf("expanded column %d in knapsack %d has %d nonzero entries:\n",
@@ -866,8 +902,6 @@ void afterKnapsack(const CoinModel &coinModel2, const int *whichColumn, const in
       }
     }
   }
-  delete[] buildRow;
-  delete[] buildElement;
 #if 0
    for (iColumn=0;iColumn<numberColumns;iColumn++) {
       if (solution[iColumn]>1.0e-5&&coinModel.isInteger(iColumn))
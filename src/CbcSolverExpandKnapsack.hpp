@@ -10,11 +10,17 @@
 #ifndef CbcSolverExpandKnapsack_H
 #define CbcSolverExpandKnapsack_H
 
+/*! On entry numberKnapsack is maximum number of expanded columns.
+    Gives up (returns NULL) if more than maximumSeconds (if >0) would be
+    taken or model would have more than maximumElements (if >0) elements.
+    Size of each knapsack is estimated before expanding it.
+*/
 OsiSolverInterface *
 expandKnapsack(CoinModel &model, int *whichColumn, int *knapsackStart,
   int *knapsackRow, int &numberKnapsack,
   CglStored &stored, int logLevel,
-  int fixedPriority, int SOSPriority, CoinModel &tightenedModel);
+  int fixedPriority, int SOSPriority, CoinModel &tightenedModel,
+  double maximumSeconds = 0.0, CoinBigIndex maximumElements = 0);
 
 void afterKnapsack(const CoinModel &coinModel2, const int *whichColumn, const int *knapsackStart,
   const int *knapsackRow, int numberKnapsack,
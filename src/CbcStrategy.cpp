@@ -26,6 +26,11 @@
 #include "CbcNode.hpp"
 #include "CoinWarmStart.hpp"
 #include "CglPreProcess.hpp"
+#include "CbcEventHandler.hpp"
+#include "CoinTime.hpp"
+#ifdef CBC_THREAD
+#include <pthread.h>
+#endif
 // Cuts
 
 #include "CglGomory.hpp"
@@ -296,10 +301,7 @@ void CbcStrategyDefault::setupCutGenerators(CbcModel &model)
 // Setup heuristics
 void CbcStrategyDefault::setupHeuristics(CbcModel &model)
 {
-  // Allow rounding heuristic
-
-  CbcRounding heuristic1(model);
-  heuristic1.setHeuristicName("rounding");
+  // Allow rounding heuristic (only made if not there - it copies matrix)
   int numberHeuristics = model.numberHeuristics();
   int iHeuristic;
   bool found;
@@ -312,8 +314,11 @@ void CbcStrategyDefault::setupHeuristics(CbcModel &model)
       break;
     }
   }
-  if (!found)
+  if (!found) {
+    CbcRounding heuristic1(model);
+    heuristic1.setHeuristicName("rounding");
     model.addHeuristic(&heuristic1);
+  }
 #ifdef JJF_ZERO
   // Allow join solutions
   CbcHeuristicLocal heuristic2(model);
@@ -890,10 +895,7 @@ void CbcStrategyDefaultSubTree::setupCutGenerators(CbcModel &model)
 // Setup heuristics
 void CbcStrategyDefaultSubTree::setupHeuristics(CbcModel &model)
 {
-  // Allow rounding heuristic
-
-  CbcRounding heuristic1(model);
-  heuristic1.setHeuristicName("rounding");
+  // Allow rounding heuristic (only made if not there - it copies matrix)
   int numberHeuristics = model.numberHeuristics();
   int iHeuristic;
   bool found;
@@ -906,8 +908,11 @@ void CbcStrategyDefaultSubTree::setupHeuristics(CbcModel &model)
       break;
     }
   }
-  if (!found)
+  if (!found) {
+    CbcRounding heuristic1(model);
+    heuristic1.setHeuristicName("rounding");
     model.addHeuristic(&heuristic1);
+  }
   if ((model.moreSpecialOptions() & 32768) != 0) {
     // Allow join solutions
     CbcHeuristicLocal heuristic2(model);
@@ -1005,5 +1010,252 @@ void setCutAndHeuristicOptions(CbcModel &model)
   }
 }
 
+// Default Constructor
+CbcStrategyPortfolio::CbcStrategyPortfolio(double probeSeconds)
+  : CbcStrategy()
+  , strategies_(NULL)
+  , numberStrategies_(0)
+  , probeSeconds_(probeSeconds)
+  , chosen_(-1)
+{
+}
+
+// Copy constructor
+CbcStrategyPortfolio::CbcStrategyPortfolio(const CbcStrategyPortfolio &rhs)
+  : CbcStrategy()
+  , strategies_(NULL)
+  , numberStrategies_(rhs.numberStrategies_)
+  , probeSeconds_(rhs.probeSeconds_)
+  , chosen_(rhs.chosen_)
+{
+  setNested(rhs.getNested());
+  if (numberStrategies_) {
+    strategies_ = new CbcStrategy *[numberStrategies_];
+    for (int i = 0; i < numberStrategies_; i++)
+      strategies_[i] = rhs.strategies_[i]->clone();
+  }
+}
+
+// Destructor
+CbcStrategyPortfolio::~CbcStrategyPortfolio()
+{
+  for (int i = 0; i < numberStrategies_; i++)
+    delete strategies_[i];
+  delete[] strategies_;
+}
+
+// Clone
+CbcStrategy *
+CbcStrategyPortfolio::clone() const
+{
+  return new CbcStrategyPortfolio(*this);
+}
+
+// Add a strategy to race (copy is taken)
+void CbcStrategyPortfolio::addStrategy(const CbcStrategy &strategy)
+{
+  CbcStrategy **temp = new CbcStrategy *[numberStrategies_ + 1];
+  for (int i = 0; i < numberStrategies_; i++)
+    temp[i] = strategies_[i];
+  temp[numberStrategies_++] = strategy.clone();
+  delete[] strategies_;
+  strategies_ = temp;
+}
+
+namespace {
+/// Best objective (minimization) shared by probes
+typedef struct {
+  double bestObjective;
+#ifdef CBC_THREAD
+  pthread_mutex_t mutex;
+#endif
+} CbcPortfolioShared;
+
+/// One probe
+typedef struct {
+  CbcModel *model;
+  CbcPortfolioShared *shared;
+  double seconds;
+} CbcPortfolioProbe;
+
+/** Passes objective of solutions found by one probe to the others
+    as a cutoff */
+class CbcPortfolioEventHandler : public CbcEventHandler {
+public:
+  CbcPortfolioEventHandler(CbcPortfolioShared *shared)
+    : CbcEventHandler()
+    , shared_(shared)
+  {
+  }
+  CbcPortfolioEventHandler(const CbcPortfolioEventHandler &rhs)
+    : CbcEventHandler(rhs)
+    , shared_(rhs.shared_)
+  {
+  }
+  virtual CbcEventHandler *clone() const
+  {
+    return new CbcPortfolioEventHandler(*this);
+  }
+  virtual CbcAction event(CbcEvent whichEvent)
+  {
+    // not in sub trees
+    if (!model_ || model_->parentModel())
+      return noAction;
+    if (whichEvent == solution || whichEvent == heuristicSolution) {
+      double value = model_->getMinimizationObjValue();
+#ifdef CBC_THREAD
+      pthread_mutex_lock(&shared_->mutex);
+#endif
+      if (value < shared_->bestObjective)
+        shared_->bestObjective = value;
+#ifdef CBC_THREAD
+      pthread_mutex_unlock(&shared_->mutex);
+#endif
+    } else if (whichEvent == node) {
+      // a stale read only delays the tighter cutoff
+      double value = shared_->bestObjective - model_->getCutoffIncrement();
+      if (value < model_->getCutoff())
+        model_->setCutoff(value);
+    }
+    return noAction;
+  }
+
+private:
+  CbcPortfolioShared *shared_;
+};
+}
+
+// Runs one probe
+static void *doPortfolioProbe(void *voidInfo)
+{
+  CbcPortfolioProbe *info = reinterpret_cast< CbcPortfolioProbe * >(voidInfo);
+  double time0 = CoinGetTimeOfDay();
+  info->model->branchAndBound();
+  info->seconds = CoinGetTimeOfDay() - time0;
+  return NULL;
+}
+
+/*
+  Race a copy of the model for each strategy.  Copies do not use this
+  portfolio (so no recursion) and are stopped after probeSeconds_.
+  Progress is gap closed (1.0 if search finished) per second.  The best
+  solution found is given to model before the chosen strategy does its
+  own setupOther (which may preprocess - in which case we take over its
+  preprocessing object so CbcModel finds it as usual).
+*/
+void CbcStrategyPortfolio::setupOther(CbcModel &model)
+{
+  if (!numberStrategies_)
+    return;
+  if (numberStrategies_ > 1 && chosen_ < 0) {
+    CbcPortfolioShared shared;
+    shared.bestObjective = model.getMinimizationObjValue();
+#ifdef CBC_THREAD
+    pthread_mutex_init(&shared.mutex, NULL);
+#endif
+    CbcPortfolioEventHandler shareHandler(&shared);
+    CbcPortfolioProbe *probes = new CbcPortfolioProbe[numberStrategies_];
+    double seconds = probeSeconds_;
+    double secondsLeft = model.getMaximumSeconds() - model.getCurrentSeconds();
+    if (secondsLeft < numberStrategies_ * seconds)
+      seconds = CoinMax(0.1 * secondsLeft / numberStrategies_, 0.0);
+    for (int i = 0; i < numberStrategies_; i++) {
+      CbcModel *probe = new CbcModel(model, true);
+      probe->setStrategy(*strategies_[i]);
+      probe->passInEventHandler(&shareHandler);
+      probe->setLogLevel(0);
+      probe->solver()->setHintParam(OsiDoReducePrint, true, OsiHintTry);
+      probe->setMaximumSeconds(seconds);
+      // probes run at once so cpu time would be shared
+      probe->setUseElapsedTime(true);
+      probe->setDblParam(CbcModel::CbcStartSeconds, 0.0);
+      probes[i].model = probe;
+      probes[i].shared = &shared;
+      probes[i].seconds = 0.0;
+    }
+#ifdef CBC_THREAD
+    pthread_t *threads = new pthread_t[numberStrategies_];
+    for (int i = 0; i < numberStrategies_; i++)
+      pthread_create(threads + i, NULL, doPortfolioProbe, probes + i);
+    for (int i = 0; i < numberStrategies_; i++)
+      pthread_join(threads[i], NULL);
+    delete[] threads;
+    pthread_mutex_destroy(&shared.mutex);
+#else
+    for (int i = 0; i < numberStrategies_; i++)
+      doPortfolioProbe(probes + i);
+#endif
+    double bestRate = -1.0;
+    int iBestSolution = -1;
+    double bestObjective = model.getMinimizationObjValue();
+    chosen_ = 0;
+    for (int i = 0; i < numberStrategies_; i++) {
+      CbcModel *probe = probes[i].model;
+      double closed;
+      if (!probe->status()) {
+        closed = 1.0;
+      } else if (probe->bestSolution()) {
+        double best = probe->getMinimizationObjValue();
+        double bound = probe->getBestPossibleObjValue() * probe->solver()->getObjSense();
+        closed = 1.0 - CoinMin(1.0, fabs(best - bound) / CoinMax(1.0e-10, fabs(best)));
+      } else {
+        closed = 0.0;
+      }
+      double rate = closed / CoinMax(probes[i].seconds, 1.0e-3);
+      if (rate > bestRate) {
+        bestRate = rate;
+        chosen_ = i;
+      }
+      if (probe->bestSolution() && probe->getMinimizationObjValue() < bestObjective) {
+        bestObjective = probe->getMinimizationObjValue();
+        iBestSolution = i;
+      }
+    }
+    char general[200];
+    sprintf(general, "Portfolio of %d strategies raced for %g seconds - strategy %d chosen",
+      numberStrategies_, seconds, chosen_);
+    model.messageHandler()->message(CBC_GENERAL, model.messages())
+      << general << CoinMessageEol;
+    if (iBestSolution >= 0) {
+      CbcModel *probe = probes[iBestSolution].model;
+      model.setBestSolution(probe->bestSolution(), model.getNumCols(),
+        probe->getObjValue(), true);
+    }
+    for (int i = 0; i < numberStrategies_; i++)
+      delete probes[i].model;
+    delete[] probes;
+  } else if (chosen_ < 0) {
+    chosen_ = 0;
+  }
+  CbcStrategy *strategy = strategies_[chosen_];
+  strategy->setupOther(model);
+  delete process_;
+  preProcessState_ = strategy->preProcessState_;
+  process_ = strategy->process_;
+  strategy->preProcessState_ = 0;
+  strategy->process_ = NULL;
+}
+
+// Setup cut generators
+void CbcStrategyPortfolio::setupCutGenerators(CbcModel &model)
+{
+  if (chosen_ >= 0)
+    strategies_[chosen_]->setupCutGenerators(model);
+}
+
+// Setup heuristics
+void CbcStrategyPortfolio::setupHeuristics(CbcModel &model)
+{
+  if (chosen_ >= 0)
+    strategies_[chosen_]->setupHeuristics(model);
+}
+
+// Do printing stuff
+void CbcStrategyPortfolio::setupPrinting(CbcModel &model, int modelLogLevel)
+{
+  if (chosen_ >= 0)
+    strategies_[chosen_]->setupPrinting(model, modelLogLevel);
+}
+
 /* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
 */
@@ -79,6 +79,8 @@ public:
 private:
   /// Illegal Assignment operator
   CbcStrategy &operator=(const CbcStrategy &rhs);
+  /// Takes over preprocessing of chosen strategy
+  friend class CbcStrategyPortfolio;
 
 protected:
   // Data
@@ -262,6 +264,77 @@ private:
   CbcStrategyDefaultSubTree &operator=(const CbcStrategyDefaultSubTree &rhs);
 };
 
+/** Portfolio of strategies.
+
+    setupOther races a copy of the model for each strategy for a short
+    probe (all at once if threads).  Copies share the best objective
+    found through their cutoffs and the best solution is given to the
+    model.  Then the strategy which closed most gap per second is used
+    for the real search.
+ */
+
+class CBCLIB_EXPORT CbcStrategyPortfolio : public CbcStrategy {
+public:
+  // Default Constructor
+  CbcStrategyPortfolio(double probeSeconds = 10.0);
+
+  // Copy constructor
+  CbcStrategyPortfolio(const CbcStrategyPortfolio &);
+
+  // Destructor
+  ~CbcStrategyPortfolio();
+
+  /// Clone
+  virtual CbcStrategy *clone() const;
+
+  /// Add a strategy to race (copy is taken)
+  void addStrategy(const CbcStrategy &strategy);
+  /// Number of strategies
+  inline int numberStrategies() const
+  {
+    return numberStrategies_;
+  }
+  /// Set seconds for each probe
+  inline void setProbeSeconds(double value)
+  {
+    probeSeconds_ = value;
+  }
+  /// Seconds for each probe
+  inline double probeSeconds() const
+  {
+    return probeSeconds_;
+  }
+  /// Strategy chosen (-1 if not raced yet)
+  inline int chosen() const
+  {
+    return chosen_;
+  }
+
+  /// Setup cut generators
+  virtual void setupCutGenerators(CbcModel &model);
+  /// Setup heuristics
+  virtual void setupHeuristics(CbcModel &model);
+  /// Do printing stuff
+  virtual void setupPrinting(CbcModel &model, int modelLogLevel);
+  /// Races and then other stuff of chosen strategy
+  virtual void setupOther(CbcModel &model);
+
+protected:
+  // Data
+  /// Strategies
+  CbcStrategy **strategies_;
+  /// Number of strategies
+  int numberStrategies_;
+  /// Seconds for each probe
+  double probeSeconds_;
+  /// Strategy chosen
+  int chosen_;
+
+private:
+  /// Illegal Assignment operator
+  CbcStrategyPortfolio &operator=(const CbcStrategyPortfolio &rhs);
+};
+
 #endif
 
 /* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
@@ -0,0 +1,112 @@
+// Copyright (C) 2002, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#pragma warning(disable : 4786)
+#endif
+
+#include "CbcConfig.h"
+
+#include <cmath>
+
+#include "CoinHelperFunctions.hpp"
+#include "CbcStrongBudget.hpp"
+
+// Adjust after this many predictions in range
+#define CBC_STRONG_ADJUST 50
+// Limits on scale factor
+#define CBC_STRONG_MINIMUM_SCALE 0.25
+#define CBC_STRONG_MAXIMUM_SCALE 4.0
+
+// Default Constructor
+CbcStrongBudget::CbcStrongBudget()
+  : strongTime_(0.0)
+  , totalTime_(0.0)
+  , targetRatio_(1.0)
+{
+  for (int i = 0; i < CBC_STRONG_RANGES; i++) {
+    sumError_[i] = 0.0;
+    numberPredictions_[i] = 0.0;
+    scale_[i] = 1.0;
+  }
+}
+
+// Destructor
+CbcStrongBudget::~CbcStrongBudget()
+{
+}
+
+// Depth range of depth
+int CbcStrongBudget::range(int depth)
+{
+  if (!depth)
+    return 0;
+  // number of bits - 1-3 give range 1, 4-7 range 2 ...
+  int numberBits = 0;
+  while (depth) {
+    numberBits++;
+    depth >>= 1;
+  }
+  return CoinMin(CoinMax(numberBits - 1, 1), CBC_STRONG_RANGES - 1);
+}
+
+// Number of candidates to test at depth
+int CbcStrongBudget::numberCandidates(int depth, int numberTest) const
+{
+  if (numberTest <= 0)
+    return numberTest;
+  double value = scale_[range(depth)] * numberTest;
+  return CoinMax(1, static_cast< int >(value + 0.5));
+}
+
+// Hot start iteration limit at depth
+int CbcStrongBudget::iterationLimit(int depth, int limit) const
+{
+  double value = scale_[range(depth)] * limit;
+  return CoinMax(10, static_cast< int >(CoinMin(value, 1.0e8)));
+}
+
+// Add result of strong branching one way
+void CbcStrongBudget::addPrediction(int depth, double estimate, double change)
+{
+  int iRange = range(depth);
+  estimate = CoinMax(estimate, 0.0);
+  change = CoinMax(change, 0.0);
+  double largest = CoinMax(CoinMax(estimate, change), 1.0e-8);
+  double error;
+  if (change >= 1.0e100)
+    error = 1.0; // infeasible is never predicted
+  else
+    error = CoinMin(fabs(change - estimate) / largest, 1.0);
+  sumError_[iRange] += error;
+  numberPredictions_[iRange] += 1.0;
+  if (numberPredictions_[iRange] >= CBC_STRONG_ADJUST)
+    adjust(iRange);
+}
+
+// Add time spent in strong branching at node
+void CbcStrongBudget::addTime(double seconds, double totalSeconds)
+{
+  strongTime_ += CoinMax(seconds, 0.0);
+  totalTime_ = totalSeconds;
+}
+
+/* Ratio of fraction of time in strong branching to mean error -
+   well above target means little learnt for time spent */
+void CbcStrongBudget::adjust(int iRange)
+{
+  double meanError = sumError_[iRange] / numberPredictions_[iRange];
+  double fraction = CoinMin(strongTime_ / CoinMax(totalTime_, 1.0e-3), 1.0);
+  double ratio = fraction / CoinMax(meanError, 1.0e-2);
+  if (ratio > 2.0 * targetRatio_)
+    scale_[iRange] = CoinMax(0.8 * scale_[iRange], CBC_STRONG_MINIMUM_SCALE);
+  else if (ratio < 0.5 * targetRatio_)
+    scale_[iRange] = CoinMin(1.25 * scale_[iRange], CBC_STRONG_MAXIMUM_SCALE);
+  sumError_[iRange] *= 0.5;
+  numberPredictions_[iRange] *= 0.5;
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
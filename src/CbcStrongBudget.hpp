@@ -0,0 +1,90 @@
+// Copyright (C) 2002, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcStrongBudget_H
+#define CbcStrongBudget_H
+
+#include "CbcConfig.h"
+
+/// Number of depth ranges (0, 1-3, 4-7, 8-15, 16-31, 32 and deeper)
+#define CBC_STRONG_RANGES 6
+
+/** Adaptive budget for strong branching
+
+    numberStrong, numberBeforeTrust and the hot start iteration limit are
+    fixed for the whole search.  This keeps, for each range of depths, how
+    far strong branching results were from the pseudocost estimates
+    (relative error - an infeasible side counts as 1.0) and the fraction of
+    run time spent in strong branching.  If little is learnt - the estimates
+    were good - for the time spent, candidates and iterations at those
+    depths are scaled down, and if much is learnt cheaply they are scaled up.
+
+    The ratio compared with targetRatio is time fraction divided by mean
+    error.  Statistics decay by half at each adjustment so later behaviour
+    counts most.  Used by CbcNode::chooseDynamicBranch if
+    CbcModel::CbcAdaptiveStrong is set.
+*/
+class CBCLIB_EXPORT CbcStrongBudget {
+
+public:
+  /// Default Constructor
+  CbcStrongBudget();
+  /// Destructor
+  ~CbcStrongBudget();
+
+  /// Depth range of depth
+  static int range(int depth);
+  /// Number of candidates to test at depth (from default number)
+  int numberCandidates(int depth, int numberTest) const;
+  /// Hot start iteration limit at depth (from default limit)
+  int iterationLimit(int depth, int limit) const;
+  /// Add result of strong branching one way (change may be COIN_DBL_MAX)
+  void addPrediction(int depth, double estimate, double change);
+  /// Add time spent in strong branching at node and total time so far
+  void addTime(double seconds, double totalSeconds);
+
+  /// Current scale factor at depth
+  inline double scale(int depth) const
+  {
+    return scale_[range(depth)];
+  }
+  /// Target ratio of time fraction to mean error
+  inline double targetRatio() const
+  {
+    return targetRatio_;
+  }
+  /// Set target ratio of time fraction to mean error
+  inline void setTargetRatio(double value)
+  {
+    targetRatio_ = value;
+  }
+
+private:
+  /// Adjust scale for range
+  void adjust(int iRange);
+
+private:
+  /// Illegal copy constructor
+  CbcStrongBudget(const CbcStrongBudget &);
+  /// Illegal assignment operator
+  CbcStrongBudget &operator=(const CbcStrongBudget &);
+
+  /// Sum of relative errors of estimates (decayed)
+  double sumError_[CBC_STRONG_RANGES];
+  /// Number of estimates compared (decayed)
+  double numberPredictions_[CBC_STRONG_RANGES];
+  /// Scale factor for candidates and iterations
+  double scale_[CBC_STRONG_RANGES];
+  /// Time spent in strong branching
+  double strongTime_;
+  /// Total time at last addTime
+  double totalTime_;
+  /// Target ratio of time fraction to mean error
+  double targetRatio_;
+};
+
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -0,0 +1,136 @@
+// Copyright (C) 2002, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#pragma warning(disable : 4786)
+#endif
+
+#include "CbcConfig.h"
+
+#include <cassert>
+#include <cstring>
+
+#include "CoinPackedMatrix.hpp"
+#include "OsiSolverInterface.hpp"
+#include "CbcStrongCache.hpp"
+
+// Constructor with maximum number of entries
+CbcStrongCache::CbcStrongCache(int maximumEntries)
+  : column_(NULL)
+  , downMovement_(NULL)
+  , upMovement_(NULL)
+  , mark_(NULL)
+  , solver_(NULL)
+  , numberRows_(0)
+  , numberEntries_(0)
+  , maximumEntries_(maximumEntries)
+{
+  assert(maximumEntries_ > 0);
+  column_ = new int[maximumEntries_];
+  downMovement_ = new double[2 * maximumEntries_];
+  upMovement_ = downMovement_ + maximumEntries_;
+}
+
+// Destructor
+CbcStrongCache::~CbcStrongCache()
+{
+  delete[] column_;
+  delete[] downMovement_;
+  delete[] mark_;
+}
+
+/* Find columns whose bounds in solver differ from those given
+   (bounds at node) and mark rows they are in */
+void CbcStrongCache::setCurrent(const OsiSolverInterface *solver,
+  const double *lowerBefore, const double *upperBefore)
+{
+  delete[] mark_;
+  solver_ = solver;
+  numberRows_ = solver->getNumRows();
+  int numberColumns = solver->getNumCols();
+  mark_ = new char[numberRows_ + numberColumns];
+  memset(mark_, 0, numberRows_ + numberColumns);
+  char *markColumn = mark_ + numberRows_;
+  const double *lower = solver->getColLower();
+  const double *upper = solver->getColUpper();
+  const CoinPackedMatrix *matrix = solver->getMatrixByCol();
+  const int *row = matrix->getIndices();
+  const CoinBigIndex *columnStart = matrix->getVectorStarts();
+  const int *columnLength = matrix->getVectorLengths();
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    if (lower[iColumn] != lowerBefore[iColumn] || upper[iColumn] != upperBefore[iColumn]) {
+      markColumn[iColumn] = 1;
+      for (CoinBigIndex j = columnStart[iColumn]; j < columnStart[iColumn] + columnLength[iColumn]; j++)
+        mark_[row[j]] = 1;
+    }
+  }
+}
+
+// Forget current changes (frees work space)
+void CbcStrongCache::clearCurrent()
+{
+  delete[] mark_;
+  mark_ = NULL;
+  solver_ = NULL;
+}
+
+// Whether current changes share a row with column
+bool CbcStrongCache::touched(int iColumn) const
+{
+  assert(mark_);
+  if (iColumn >= solver_->getNumCols() || mark_[numberRows_ + iColumn])
+    return true;
+  const CoinPackedMatrix *matrix = solver_->getMatrixByCol();
+  const int *row = matrix->getIndices();
+  const CoinBigIndex *columnStart = matrix->getVectorStarts();
+  const int *columnLength = matrix->getVectorLengths();
+  for (CoinBigIndex j = columnStart[iColumn]; j < columnStart[iColumn] + columnLength[iColumn]; j++) {
+    // rows may have been added since setCurrent
+    if (row[j] >= numberRows_ || mark_[row[j]])
+      return true;
+  }
+  return false;
+}
+
+// Save result for candidate (if room and not touched by current changes)
+void CbcStrongCache::add(int iColumn, double downMovement, double upMovement)
+{
+  if (!mark_ || touched(iColumn))
+    return;
+  int i;
+  for (i = 0; i < numberEntries_; i++) {
+    if (column_[i] == iColumn)
+      break;
+  }
+  if (i == numberEntries_) {
+    if (numberEntries_ == maximumEntries_)
+      return;
+    numberEntries_++;
+  }
+  column_[i] = iColumn;
+  downMovement_[i] = downMovement;
+  upMovement_[i] = upMovement;
+}
+
+/* Find saved result for candidate.  Returns false if none or
+   current changes touch candidate */
+bool CbcStrongCache::find(int iColumn, double &downMovement, double &upMovement) const
+{
+  if (!mark_)
+    return false;
+  for (int i = 0; i < numberEntries_; i++) {
+    if (column_[i] == iColumn) {
+      if (touched(iColumn))
+        return false;
+      downMovement = downMovement_[i];
+      upMovement = upMovement_[i];
+      return true;
+    }
+  }
+  return false;
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -0,0 +1,89 @@
+// Copyright (C) 2002, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcStrongCache_H
+#define CbcStrongCache_H
+
+#include "CbcConfig.h"
+
+class OsiSolverInterface;
+
+/** Strong branching results kept in a CbcNodeInfo for its children
+
+    When a child of a node does strong branching the results (both
+    ways feasible) are saved here.  A sibling (or later child) with
+    bounds changed since the node only on columns which share no row
+    with a candidate can then use the saved changes for that candidate
+    rather than solving again.  Candidates found infeasible one way are
+    not kept as they are already fixed at the child which found them and
+    the saved values are only used as estimates - so the cache can never
+    cut off a solution.
+
+    setCurrent() must be called with the bounds at the node before
+    a child uses the cache and clearCurrent() afterwards.  Entries are only
+    added for candidates the current child's changes do not touch.
+    Used if CbcModel::CbcStrongCacheSize is set.
+*/
+class CBCLIB_EXPORT CbcStrongCache {
+
+public:
+  /// Constructor with maximum number of entries
+  CbcStrongCache(int maximumEntries);
+  /// Destructor
+  ~CbcStrongCache();
+
+  /** Find columns whose bounds in solver differ from those given
+      (bounds at node) and mark rows they are in */
+  void setCurrent(const OsiSolverInterface *solver,
+    const double *lowerBefore, const double *upperBefore);
+  /// Forget current changes (frees work space)
+  void clearCurrent();
+  /// Whether setCurrent has been done
+  inline bool active() const
+  {
+    return mark_ != 0;
+  }
+  /// Save result for candidate (if room and not touched by current changes)
+  void add(int iColumn, double downMovement, double upMovement);
+  /** Find saved result for candidate.  Returns false if none or
+      current changes touch candidate */
+  bool find(int iColumn, double &downMovement, double &upMovement) const;
+  /// Number of entries
+  inline int numberEntries() const
+  {
+    return numberEntries_;
+  }
+
+private:
+  /// Whether current changes share a row with column
+  bool touched(int iColumn) const;
+
+private:
+  /// Illegal copy constructor
+  CbcStrongCache(const CbcStrongCache &);
+  /// Illegal assignment operator
+  CbcStrongCache &operator=(const CbcStrongCache &);
+
+  /// Column of each entry
+  int *column_;
+  /// Down change of each entry
+  double *downMovement_;
+  /// Up change of each entry
+  double *upMovement_;
+  /// Rows (and columns after) touched by current changes (NULL if none)
+  char *mark_;
+  /// Solver given to setCurrent
+  const OsiSolverInterface *solver_;
+  /// Number of rows when setCurrent done
+  int numberRows_;
+  /// Number of entries
+  int numberEntries_;
+  /// Maximum number of entries
+  int maximumEntries_;
+};
+
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
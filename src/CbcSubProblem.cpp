@@ -8,6 +8,7 @@
 #include <cstdlib>
 #include <cmath>
 #include <cfloat>
+#include <cstring>
 //#define CBC_DEBUG
 
 #include "CoinPragma.hpp"
@@ -328,5 +329,222 @@ void CbcSubProblem::apply(OsiSolverInterface *solver, int what) const
   }
 }
 
+/*
+  Helpers for packed format. Integers are written as little endian base
+  128 varints, signed ones zigzag coded first.
+*/
+static int packVarint(unsigned char *buffer, int n, CoinUInt64 value)
+{
+  while (value >= 0x80) {
+    if (buffer)
+      buffer[n] = static_cast< unsigned char >((value & 0x7f) | 0x80);
+    n++;
+    value >>= 7;
+  }
+  if (buffer)
+    buffer[n] = static_cast< unsigned char >(value);
+  return n + 1;
+}
+static int packDouble(unsigned char *buffer, int n, double value)
+{
+  if (buffer)
+    memcpy(buffer + n, &value, sizeof(double));
+  return n + static_cast< int >(sizeof(double));
+}
+static bool unpackVarint(const unsigned char *buffer, int length, int &n, CoinUInt64 &value)
+{
+  value = 0;
+  int shift = 0;
+  while (n < length && shift < 64) {
+    unsigned char c = buffer[n++];
+    value |= static_cast< CoinUInt64 >(c & 0x7f) << shift;
+    if ((c & 0x80) == 0)
+      return true;
+    shift += 7;
+  }
+  return false;
+}
+static bool unpackDouble(const unsigned char *buffer, int length, int &n, double &value)
+{
+  if (n + static_cast< int >(sizeof(double)) > length)
+    return false;
+  memcpy(&value, buffer + n, sizeof(double));
+  n += static_cast< int >(sizeof(double));
+  return true;
+}
+static inline CoinUInt64 zigzag(CoinInt64 value)
+{
+  return (static_cast< CoinUInt64 >(value) << 1) ^ static_cast< CoinUInt64 >(value >> 63);
+}
+static inline CoinInt64 unzigzag(CoinUInt64 value)
+{
+  return static_cast< CoinInt64 >(value >> 1) ^ -static_cast< CoinInt64 >(value & 1);
+}
+/*
+  Packed format is
+    objective, sum of infeasibilities, branch value and dj as doubles
+    depth, number of infeasibilities, problem status, branch variable
+      and number of bound changes as varints
+    for each bound change a varint holding the difference from the last
+      column, the two flag bits and a two bit code (0 - new bound 0.0,
+      1 - new bound 1.0, 2 - integer bound follows as varint, 3 - double
+      follows)
+    0 if no basis or 1 followed by number of structurals and artificials
+      and then runs of status as varints (length-1 shifted left 2 | status)
+*/
+int CbcSubProblem::serialize(unsigned char *buffer) const
+{
+  int n = 0;
+  n = packDouble(buffer, n, objectiveValue_);
+  n = packDouble(buffer, n, sumInfeasibilities_);
+  n = packDouble(buffer, n, branchValue_);
+  n = packDouble(buffer, n, djValue_);
+  n = packVarint(buffer, n, zigzag(depth_));
+  n = packVarint(buffer, n, zigzag(numberInfeasibilities_));
+  n = packVarint(buffer, n, zigzag(problemStatus_));
+  n = packVarint(buffer, n, zigzag(branchVariable_));
+  n = packVarint(buffer, n, numberChangedBounds_);
+  int lastColumn = 0;
+  for (int i = 0; i < numberChangedBounds_; i++) {
+    unsigned int variable = static_cast< unsigned int >(variables_[i]);
+    int iColumn = variable & 0x3fffffff;
+    int flags = variable >> 30;
+    double value = newBounds_[i];
+    int code;
+    if (value == 0.0)
+      code = 0;
+    else if (value == 1.0)
+      code = 1;
+    else if (fabs(value) < 1.0e9 && value == floor(value))
+      code = 2;
+    else
+      code = 3;
+    CoinUInt64 token = (zigzag(iColumn - lastColumn) << 4) | (flags << 2) | code;
+    lastColumn = iColumn;
+    n = packVarint(buffer, n, token);
+    if (code == 2)
+      n = packVarint(buffer, n, zigzag(static_cast< CoinInt64 >(value)));
+    else if (code == 3)
+      n = packDouble(buffer, n, value);
+  }
+  if (!status_) {
+    n = packVarint(buffer, n, 0);
+  } else {
+    int numberStructural = status_->getNumStructural();
+    int numberArtificial = status_->getNumArtificial();
+    int numberTotal = numberStructural + numberArtificial;
+    n = packVarint(buffer, n, 1);
+    n = packVarint(buffer, n, numberStructural);
+    n = packVarint(buffer, n, numberArtificial);
+    int i = 0;
+    while (i < numberTotal) {
+      int status = (i < numberStructural) ? status_->getStructStatus(i) : status_->getArtifStatus(i - numberStructural);
+      int j = i + 1;
+      while (j < numberTotal) {
+        int status2 = (j < numberStructural) ? status_->getStructStatus(j) : status_->getArtifStatus(j - numberStructural);
+        if (status2 != status)
+          break;
+        j++;
+      }
+      n = packVarint(buffer, n, (static_cast< CoinUInt64 >(j - i - 1) << 2) | status);
+      i = j;
+    }
+  }
+  return n;
+}
+// Unpack subproblem
+int CbcSubProblem::deserialize(const unsigned char *buffer, int length)
+{
+  delete[] variables_;
+  delete[] newBounds_;
+  delete status_;
+  variables_ = NULL;
+  newBounds_ = NULL;
+  status_ = NULL;
+  numberChangedBounds_ = 0;
+  int n = 0;
+  CoinUInt64 value;
+  bool ok = unpackDouble(buffer, length, n, objectiveValue_);
+  ok = ok && unpackDouble(buffer, length, n, sumInfeasibilities_);
+  ok = ok && unpackDouble(buffer, length, n, branchValue_);
+  ok = ok && unpackDouble(buffer, length, n, djValue_);
+  ok = ok && unpackVarint(buffer, length, n, value);
+  depth_ = static_cast< int >(unzigzag(value));
+  ok = ok && unpackVarint(buffer, length, n, value);
+  numberInfeasibilities_ = static_cast< int >(unzigzag(value));
+  ok = ok && unpackVarint(buffer, length, n, value);
+  problemStatus_ = static_cast< int >(unzigzag(value));
+  ok = ok && unpackVarint(buffer, length, n, value);
+  branchVariable_ = static_cast< int >(unzigzag(value));
+  ok = ok && unpackVarint(buffer, length, n, value);
+  // each change needs at least one byte
+  ok = ok && value <= static_cast< CoinUInt64 >(length - n);
+  if (!ok)
+    return -1;
+  int numberChanged = static_cast< int >(value);
+  if (numberChanged) {
+    variables_ = new int[numberChanged];
+    newBounds_ = new double[numberChanged];
+  }
+  int lastColumn = 0;
+  for (int i = 0; i < numberChanged; i++) {
+    if (!unpackVarint(buffer, length, n, value))
+      return -1;
+    int code = static_cast< int >(value & 3);
+    unsigned int flags = static_cast< unsigned int >((value >> 2) & 3);
+    int iColumn = lastColumn + static_cast< int >(unzigzag(value >> 4));
+    if (iColumn < 0 || iColumn > 0x3fffffff)
+      return -1;
+    lastColumn = iColumn;
+    double bound;
+    if (code == 0) {
+      bound = 0.0;
+    } else if (code == 1) {
+      bound = 1.0;
+    } else if (code == 2) {
+      if (!unpackVarint(buffer, length, n, value))
+        return -1;
+      bound = static_cast< double >(unzigzag(value));
+    } else {
+      if (!unpackDouble(buffer, length, n, bound))
+        return -1;
+    }
+    variables_[i] = static_cast< int >(static_cast< unsigned int >(iColumn) | (flags << 30));
+    newBounds_[i] = bound;
+    numberChangedBounds_++;
+  }
+  if (!unpackVarint(buffer, length, n, value))
+    return -1;
+  if (value) {
+    CoinUInt64 numberStructural;
+    CoinUInt64 numberArtificial;
+    if (!unpackVarint(buffer, length, n, numberStructural)
+      || !unpackVarint(buffer, length, n, numberArtificial)
+      || numberStructural > 0x3fffffff || numberArtificial > 0x3fffffff)
+      return -1;
+    int numberColumns = static_cast< int >(numberStructural);
+    int numberTotal = numberColumns + static_cast< int >(numberArtificial);
+    status_ = new CoinWarmStartBasis();
+    status_->setSize(numberColumns, static_cast< int >(numberArtificial));
+    int i = 0;
+    while (i < numberTotal) {
+      if (!unpackVarint(buffer, length, n, value))
+        return -1;
+      CoinWarmStartBasis::Status status = static_cast< CoinWarmStartBasis::Status >(value & 3);
+      CoinUInt64 runLength = (value >> 2) + 1;
+      if (runLength > static_cast< CoinUInt64 >(numberTotal - i))
+        return -1;
+      int j = i + static_cast< int >(runLength);
+      for (; i < j; i++) {
+        if (i < numberColumns)
+          status_->setStructStatus(i, status);
+        else
+          status_->setArtifStatus(i - numberColumns, status);
+      }
+    }
+  }
+  return n;
+}
+
 /* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
 */
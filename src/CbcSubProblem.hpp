@@ -12,7 +12,7 @@
 #include "ClpNode.hpp"
 
 /** Defines a general subproblem
-    Basis will be made more compact later
+    serialize and deserialize give a packed form for storing or shipping
 */
 class CoinWarmStartDiff;
 class CBCLIB_EXPORT CbcSubProblem {
@@ -41,6 +41,22 @@ public:
   void takeOver(CbcSubProblem &, bool cleanup);
   /// Apply subproblem (1=bounds, 2=basis, 3=both)
   void apply(OsiSolverInterface *model, int what = 3) const;
+  /** Pack subproblem into buffer and return number of bytes.
+      If \p buffer is NULL just returns number of bytes needed.
+      Column indices are varint coded as differences, bound changes to
+      0.0 or 1.0 (and other small integers) take no extra space and the
+      basis status is run-length coded.
+  */
+  int serialize(unsigned char *buffer) const;
+  /// Number of bytes needed by serialize
+  inline int serializedSize() const
+  {
+    return serialize(NULL);
+  }
+  /** Unpack subproblem from buffer (replacing current contents).
+      Returns number of bytes used or -1 if buffer is not valid.
+  */
+  int deserialize(const unsigned char *buffer, int length);
 
 public:
   /// Value of objective
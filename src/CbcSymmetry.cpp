@@ -22,6 +22,7 @@ extern "C" {
 }
 
 #include <stdio.h>
+#include <cstring>
 #include <cassert>
 #include <vector>
 #include <algorithm>
@@ -32,25 +33,11 @@ extern "C" {
 #include "CbcBranchingObject.hpp"
 #include "CbcSimpleInteger.hpp"
 #include "CoinTime.hpp"
+#include "CoinTypes.hpp"
 #define NAUTY_MAX_LEVEL 0
 #if NAUTY_MAX_LEVEL
 extern int nauty_maxalllevel;
 #endif
-/* Deliberately not threadsafe to save effort
-   Just for statistics
-   and not worth gathering across threads
-   can redo later
- */
-static int nautyBranchCalls_ = 0;
-static int lastNautyBranchSucceeded_ = 0;
-static int nautyBranchSucceeded_ = 0;
-static int nautyFixCalls_ = 0;
-static int lastNautyFixSucceeded_ = 0;
-static int nautyFixSucceeded_ = 0;
-static double nautyTime_ = 0.0;
-static double nautyFixes_ = 0.0;
-static double nautyOtherBranches_ = 0.0;
-static char message_[100];
 
 void CbcSymmetry::Node::node(int i, double c, double l, double u, int cod, int s)
 {
@@ -74,18 +61,120 @@ inline bool CbcSymmetry::compare(register Node &a, register Node &b) const
   return 0;
 }
 
+/* One entry for each distinct (row, value) - row -1 for objective.
+   Open addressing on row and bit pattern of value so equal
+   coefficients of a row share a vertex in graph */
+class CbcCoefficientHash {
+public:
+  CbcCoefficientHash(int maximumEntries)
+    : numberEntries_(0)
+  {
+    int size = 4;
+    while (size < 2 * maximumEntries)
+      size *= 2;
+    mask_ = size - 1;
+    slot_ = new int[size];
+    for (int i = 0; i < size; i++)
+      slot_[i] = -1;
+    rows_ = new int[CoinMax(maximumEntries, 1)];
+    values_ = new double[CoinMax(maximumEntries, 1)];
+  }
+  ~CbcCoefficientHash()
+  {
+    delete[] slot_;
+    delete[] rows_;
+    delete[] values_;
+  }
+  // Number of (row, value) - new ones are numbered in order
+  int find(int row, double value)
+  {
+    CoinUInt64 bits;
+    memcpy(&bits, &value, sizeof(double));
+    bits ^= static_cast< CoinUInt64 >(row + 1) * 0x9e3779b97f4a7c15ULL;
+    bits ^= bits >> 31;
+    bits *= 0xbf58476d1ce4e5b9ULL;
+    bits ^= bits >> 29;
+    int h = static_cast< int >(bits & static_cast< CoinUInt64 >(mask_));
+    while (slot_[h] >= 0) {
+      int k = slot_[h];
+      if (rows_[k] == row && values_[k] == value)
+        return k;
+      h = (h + 1) & mask_;
+    }
+    slot_[h] = numberEntries_;
+    rows_[numberEntries_] = row;
+    values_[numberEntries_] = value;
+    return numberEntries_++;
+  }
+  inline int numberEntries() const
+  {
+    return numberEntries_;
+  }
+  inline int row(int k) const
+  {
+    return rows_[k];
+  }
+  inline double value(int k) const
+  {
+    return values_[k];
+  }
+
+private:
+  int *slot_;
+  int *rows_;
+  double *values_;
+  int mask_;
+  int numberEntries_;
+};
+
+/* Separate models may be solved on threads of the application even if
+   Cbc itself is built without threads, so lock wherever pthreads are
+   (Windows only has them in builds with CBC_THREAD) */
+#if defined(CBC_THREAD) || !defined(_WIN32)
+#define CBC_NAUTY_MUTEX
+#include <pthread.h>
+static pthread_mutex_t nautyMutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+/* nauty keeps static work space and callbacks have no user pointer
+   so one computation at a time - this is held while statics below
+   are in use (so symmetry of separate models can be found on threads) */
+class CbcNautyLock {
+public:
+  CbcNautyLock()
+  {
+#ifdef CBC_NAUTY_MUTEX
+    pthread_mutex_lock(&nautyMutex);
+#endif
+  }
+  ~CbcNautyLock()
+  {
+#ifdef CBC_NAUTY_MUTEX
+    pthread_mutex_unlock(&nautyMutex);
+#endif
+  }
+};
 // simple nauty definitely not thread safe
+static char nautyMessage[100];
 static int calls = 0;
 static int maxLevel = 0;
 static CbcSymmetry * baseSymmetry=NULL;
+// wall clock so right when on a thread
+static double nautyDeadline = COIN_DBL_MAX;
+static const CbcSymmetry *nautySetup = NULL; // set while in setupSymmetry
+static bool nautyTimedOut = false;
+static bool nautyManyGenerators = false; // so not all stored
 static void
 userlevelproc(int *lab, int *ptn, int level, int *orbits, statsblk *stats,
   int tv, int index, int tcellsize,
   int numcells, int childcount, int n)
 {
   calls++;
+  if (nautySetup && (nautySetup->abandoned() || CoinGetTimeOfDay() > nautyDeadline)) {
+    nautyTimedOut = true;
+    throw CoinError("Out of time", "", "CbcSymmetry");
+  }
   if (level > maxLevel) {
-    sprintf(message_,"Nauty:: level %d after %d calls", level, calls);
+    sprintf(nautyMessage,"Nauty:: level %d after %d calls", level, calls);
     maxLevel = level;
   }
   if (level > 1500) {
@@ -101,8 +190,10 @@ static void userautomproc(int numGenerators,
 		   int stabvertex, int n)
 {
   //printf("count %d\n",numGenerators);
-  if (numGenerators>64)
+  if (numGenerators>64) {
+    nautyManyGenerators = true;
     return;
+  }
   assert (baseSymmetry);
   int numberColumns = baseSymmetry->numberColumns();
   int * workperm = new int [n];
@@ -112,6 +203,7 @@ static void userautomproc(int numGenerators,
     orbitsX[i]=-1;
   int numberPerms=0;
   int numberInPerm=-1;
+  bool mixedCycles=false;
   int firstL=-1;
   for (int i = 0; i < n; ++i) {
     if (workperm[i] == 0 && perm[i] != i) {
@@ -156,8 +248,9 @@ static void userautomproc(int numGenerators,
       int nThis=nCol+nRow;
       if (numberInPerm<0) {
 	numberInPerm=nThis;
-      } else {
-	assert (numberInPerm==nThis);
+      } else if (numberInPerm!=nThis) {
+	// cycles of different lengths - not stored
+	mixedCycles=true;
       }
       if (nCol>0)
 	numberPerms++;
@@ -165,6 +258,10 @@ static void userautomproc(int numGenerators,
   }
   //printf("%d permutations, %d in each\n",numberPerms,numberInPerm);
   delete [] workperm;
+  if (mixedCycles) {
+    nautyManyGenerators = true;
+    numberPerms = 0;
+  }
   if (numberPerms) {
     cbc_permute permute;
     permute.numberInPerm=numberInPerm;
@@ -179,7 +276,7 @@ void CbcSymmetry::Compute_Symmetry() const
 {
 
   nauty_info_->options()->userlevelproc = userlevelproc;
-  message_[0]='\0';
+  nautyMessage[0]='\0';
   std::sort(node_info_.begin(), node_info_.end(), node_sort);
 
   for (std::vector< Node >::iterator i = node_info_.begin(); i != node_info_.end(); ++i)
@@ -221,32 +318,45 @@ int CbcSymmetry::statsOrbits(CbcModel *model, int type) const
     return 0;
   if (type) {
     double branchSuccess = 0.0;
-    if (nautyBranchSucceeded_)
-      branchSuccess = nautyOtherBranches_ / nautyBranchSucceeded_;
+    if (nautyStats_.branchSucceeded)
+      branchSuccess = nautyStats_.otherBranches / nautyStats_.branchSucceeded;
     double fixSuccess = 0.0;
-    if (nautyFixSucceeded_)
-      fixSuccess = nautyFixes_ / nautyFixSucceeded_;
-    if (nautyBranchSucceeded_ > lastNautyBranchSucceeded_ || nautyFixSucceeded_ > lastNautyFixSucceeded_) {
+    if (nautyStats_.fixSucceeded)
+      fixSuccess = nautyStats_.fixes / nautyStats_.fixSucceeded;
+    if (nautyStats_.branchSucceeded > nautyStats_.lastBranchSucceeded || nautyStats_.fixSucceeded > nautyStats_.lastFixSucceeded) {
       sprintf(general, "Orbital branching tried %d times, succeeded %d times - average extra %7.3f, fixing %d times (%d, %7.3f)",
-        nautyBranchCalls_, nautyBranchSucceeded_, branchSuccess,
-        nautyFixCalls_, nautyFixSucceeded_, fixSuccess);
+        nautyStats_.branchCalls, nautyStats_.branchSucceeded, branchSuccess,
+        nautyStats_.fixCalls, nautyStats_.fixSucceeded, fixSuccess);
       if ((model->moreSpecialOptions2()&(131072|262144)) == 131072) {
 	sprintf(general, "Orbital branching succeeded %d times - average extra %7.3f, fixing (%d, %7.3f)",
-		nautyBranchSucceeded_, branchSuccess,
-		nautyFixSucceeded_, fixSuccess);
+		nautyStats_.branchSucceeded, branchSuccess,
+		nautyStats_.fixSucceeded, fixSuccess);
 	model->messageHandler()->message(CBC_GENERAL,
 					 model->messages())
 	  << general << CoinMessageEol;
 	return 0;
       }
-      lastNautyBranchSucceeded_ = nautyBranchSucceeded_;
-      lastNautyFixSucceeded_ = nautyFixSucceeded_;
+      nautyStats_.lastBranchSucceeded = nautyStats_.branchSucceeded;
+      nautyStats_.lastFixSucceeded = nautyStats_.fixSucceeded;
     } else {
       printSomething = false;
     }
   } else {
     returnCode = nauty_info_->getNumGenerators();
-    if (!nauty_info_->errorStatus()) {
+    if (cachedGenerators_ >= 0) {
+      returnCode = cachedGenerators_;
+      if (returnCode && numberUsefulOrbits_) {
+        sprintf(general, "Symmetry: %d generators read from %.80s (%d useful orbits covering %d variables) - took %g seconds",
+          cachedGenerators_, model->symmetryFile(), numberUsefulOrbits_,
+          numberUsefulObjects_, nautyStats_.time);
+      } else {
+        sprintf(general, "Symmetry: no useful orbits (as read from %.80s)",
+          model->symmetryFile());
+	int options2 = model->moreSpecialOptions2();
+	if ((options2 & 131072) != 0)
+	  model->setMoreSpecialOptions2(options2 & ~(128 | 256 | 131072));
+      }
+    } else if (!nauty_info_->errorStatus()) {
       if (returnCode && numberUsefulOrbits_) {
 	if ((model->moreSpecialOptions2()&(131072|262144)) != 131072) 
 	  model->messageHandler()->message(CBC_GENERAL,
@@ -256,16 +366,16 @@ int CbcSymmetry::statsOrbits(CbcModel *model, int type) const
           nauty_info_->getNumOrbits(), numberUsefulOrbits_, numberUsefulObjects_,
           nauty_info_->getNumGenerators(),
           nauty_info_->getGroupSize(),
-          stats_[0],stats_[1], nautyTime_);
+          stats_[0],stats_[1], nautyStats_.time);
       } else {
 	int options2 = model->moreSpecialOptions2();
         if ((options2 & (128 | 256)) != (128 | 256)) {
-          sprintf(general, "Nauty did not find any useful orbits in time %g", nautyTime_);
+          sprintf(general, "Nauty did not find any useful orbits in time %g", nautyStats_.time);
         } else {
 	  if ((options2 & 131072) == 0) {
 	    sprintf(general, "Nauty did not find any useful orbits - but keeping Nauty on");
 	  } else {
-	    sprintf(general, "Nauty did not find any useful orbits in time %g", nautyTime_);
+	    sprintf(general, "Nauty did not find any useful orbits in time %g", nautyStats_.time);
 	    model->setMoreSpecialOptions2(options2 & ~(128 | 256 | 131072));
 	  }
 	}
@@ -273,7 +383,7 @@ int CbcSymmetry::statsOrbits(CbcModel *model, int type) const
     } else {
       // error
       sprintf(general, "Nauty failed with error code %d (%g seconds)",
-        nauty_info_->errorStatus(), nautyTime_);
+        nauty_info_->errorStatus(), nautyStats_.time);
       model->setMoreSpecialOptions2(model->moreSpecialOptions2() & ~(128 | 256));
     }
   }
@@ -282,7 +392,7 @@ int CbcSymmetry::statsOrbits(CbcModel *model, int type) const
       model->messages())
       << general << CoinMessageEol;
   if (!type && (model->moreSpecialOptions2()&(131072|262144)) !=
-		131072)
+		131072 && cachedGenerators_ < 0)
     Print_Orbits ();
 #if 0
   if (!type && (model->moreSpecialOptions2()&(131072|262144)) != 0) {
@@ -491,9 +601,9 @@ void CbcSymmetry::ChangeBounds(const double *new_lb, const double *new_ub,
   int num_cols, bool justFixedAtOne) const
 {
   if (justFixedAtOne)
-    nautyFixCalls_++;
+    nautyStats_.fixCalls++;
   else
-    nautyBranchCalls_++;
+    nautyStats_.branchCalls++;
   std::sort(node_info_.begin(), node_info_.end(), index_sort);
 
   for (int i = 0; i < num_cols; i++) {
@@ -522,7 +632,7 @@ CbcSymmetry::changeBounds(int iColumn, double * saveLower,
   if (saveUpper[iColumn]>1.0e12 || whichOrbit_[iColumn]<0)
     return 0; // only 0-1 at present
   if (mode)
-    nautyBranchCalls_++;
+    nautyStats_.branchCalls++;
   int nFixed = 0;
   int * originalUpper = whichOrbit_ + numberColumns_;
   double * columnLower = saveLower;
@@ -533,10 +643,10 @@ CbcSymmetry::changeBounds(int iColumn, double * saveLower,
   int * whichMarked = marked + numberColumns_;
   int * save = whichOrbit_+4*numberColumns_;
   memset(marked,0,numberColumns_*sizeof(int));
-  for (int iPerm = 0;iPerm < numberPermutations_;iPerm++) {
+  buildGeneratorLists();
+  for (int k = generatorStart_[iColumn];k < generatorStart_[iColumn+1];k++) {
+    int iPerm = generatorList_[k];
     const int * orbit = permutations_[iPerm].orbits;
-    if (orbit[iColumn]<0)
-      continue;
     int nMarked = 0;
     int nTotalOdd = 0;
     int goodOddOne = -1;
@@ -610,8 +720,8 @@ CbcSymmetry::changeBounds(int iColumn, double * saveLower,
   }
   columnUpper[iColumn] = saveUp;
   if (mode && nFixed>0) {
-    // done in CbcOrbital nautyBranchSucceeded_++;
-    nautyOtherBranches_+=nFixed;
+    // done in CbcOrbital nautyStats_.branchSucceeded++;
+    nautyStats_.otherBranches+=nFixed;
   }
   return nFixed;
 }
@@ -628,14 +738,24 @@ CbcSymmetry::orbitalFixing2(OsiSolverInterface * solver)
   }
   if (iCheck==numberColumns_)
     return 0; 
-  nautyFixCalls_ ++;
+  nautyStats_.fixCalls ++;
   int * originalUpper = whichOrbit_ + numberColumns_;
   int * marked = originalUpper + numberColumns_;
   int * whichMarked = marked + numberColumns_;
   int * save = whichOrbit_+4*numberColumns_;
   memset(marked,0,numberColumns_*sizeof(int));
   int possibleNauty = 0;
+  updateGenerators(columnLower, columnUpper);
+  const int * numberMismatched = generatorCounts_;
+  const int * numberAtOne = generatorCounts_ + numberPermutations_;
   for (int iPerm = 0;iPerm < numberPermutations_;iPerm++) {
+    // one odd one gives exactly two mismatches (into and out of it)
+    if (numberAtOne[iPerm] || numberMismatched[iPerm] > 2)
+      continue;
+    if (!numberMismatched[iPerm]) {
+      possibleNauty++;
+      continue;
+    }
     const int * orbit = permutations_[iPerm].orbits;
     int nMarked = 0;
     int nTotalOdd = 0;
@@ -691,17 +811,17 @@ CbcSymmetry::orbitalFixing2(OsiSolverInterface * solver)
     for (int i=0;i<nMarked;i++) 
       marked[whichMarked[i]]=0;
     if (nTotalOdd==1) {
-      nautyFixSucceeded_++;
+      nautyStats_.fixSucceeded++;
       int j = orbit[goodOddOne];
       if (columnUpper[goodOddOne]) {
-	nautyFixes_++;
+	nautyStats_.fixes++;
 	save[nFixed++]=goodOddOne;
 	solver->setColUpper(goodOddOne,0.0); 
       }
       while (j!=goodOddOne) {
 	if (columnUpper[j]) {
 	  //printf("setting %d to zero\n",j);
-	  nautyFixes_++;
+	  nautyStats_.fixes++;
 	  solver->setColUpper(j,0.0);
 	  save[nFixed++]=j;
 	}
@@ -716,6 +836,418 @@ CbcSymmetry::orbitalFixing2(OsiSolverInterface * solver)
     nFixed = -1; // say no good from here on
   return nFixed;
 }
+// Bound as integer for comparing columns in cycles
+static inline int intBound(double value)
+{
+  if (value >= COIN_INT_MAX)
+    return COIN_INT_MAX;
+  else if (value <= -COIN_INT_MAX)
+    return -COIN_INT_MAX;
+  else
+    return static_cast<int>(value);
+}
+// Build lists of generators moving each column
+void CbcSymmetry::buildGeneratorLists() const
+{
+  if (generatorStart_)
+    return;
+  generatorStart_ = new int[numberColumns_+1];
+  memset(generatorStart_,0,(numberColumns_+1)*sizeof(int));
+  for (int iPerm = 0;iPerm < numberPermutations_;iPerm++) {
+    const int * orbit = permutations_[iPerm].orbits;
+    for (int i=0;i<numberColumns_;i++) {
+      if (orbit[i]>=0)
+	generatorStart_[i+1]++;
+    }
+  }
+  for (int i=0;i<numberColumns_;i++)
+    generatorStart_[i+1] += generatorStart_[i];
+  generatorList_ = new int[CoinMax(generatorStart_[numberColumns_],1)];
+  int * position = CoinCopyOfArray(generatorStart_,numberColumns_);
+  for (int iPerm = 0;iPerm < numberPermutations_;iPerm++) {
+    const int * orbit = permutations_[iPerm].orbits;
+    for (int i=0;i<numberColumns_;i++) {
+      if (orbit[i]>=0)
+	generatorList_[position[i]++] = iPerm;
+    }
+  }
+  delete [] position;
+}
+// Free lists and counts for generators
+void CbcSymmetry::deleteGeneratorLists()
+{
+  delete [] generatorStart_;
+  delete [] generatorList_;
+  delete [] lastBounds_;
+  delete [] generatorCounts_;
+  generatorStart_ = NULL;
+  generatorList_ = NULL;
+  lastBounds_ = NULL;
+  generatorCounts_ = NULL;
+}
+/* Bring counts for generators up to date with bounds.
+   A directed edge i->orbit[i] of a generator is mismatched if bounds of i
+   and orbit[i] differ.  When bounds of a column change only edges into
+   and out of it (for generators moving it) can change.  Edges between
+   two changed columns are only taken off and put back once (as out
+   edges).  Just comparing with last bounds means jumping to a node in
+   another part of tree costs number of columns changed, so nothing has
+   to be undone on backtracking.
+*/
+void CbcSymmetry::updateGenerators(const double *lower, const double *upper)
+{
+  buildGeneratorLists();
+  int * lastLower;
+  int * lastUpper;
+  int * mark;
+  int * numberMismatched;
+  int * numberAtOne;
+  if (!lastBounds_) {
+    lastBounds_ = new int[3*numberColumns_];
+    generatorCounts_ = new int[2*CoinMax(numberPermutations_,1)];
+    lastLower = lastBounds_;
+    lastUpper = lastLower + numberColumns_;
+    mark = lastUpper + numberColumns_;
+    numberMismatched = generatorCounts_;
+    numberAtOne = numberMismatched + numberPermutations_;
+    for (int i=0;i<numberColumns_;i++) {
+      lastLower[i] = intBound(lower[i]);
+      lastUpper[i] = intBound(upper[i]);
+      mark[i] = 0;
+    }
+    for (int iPerm = 0;iPerm < numberPermutations_;iPerm++) {
+      const int * orbit = permutations_[iPerm].orbits;
+      int nMismatched = 0;
+      int nAtOne = 0;
+      for (int i=0;i<numberColumns_;i++) {
+	int j = orbit[i];
+	if (j>=0) {
+	  if (lastLower[i])
+	    nAtOne++;
+	  if (lastLower[i]!=lastLower[j]||lastUpper[i]!=lastUpper[j])
+	    nMismatched++;
+	}
+      }
+      numberMismatched[iPerm] = nMismatched;
+      numberAtOne[iPerm] = nAtOne;
+    }
+    return;
+  }
+  lastLower = lastBounds_;
+  lastUpper = lastLower + numberColumns_;
+  mark = lastUpper + numberColumns_;
+  numberMismatched = generatorCounts_;
+  numberAtOne = numberMismatched + numberPermutations_;
+  std::vector<int> changed;
+  for (int i=0;i<numberColumns_;i++) {
+    if (generatorStart_[i+1]>generatorStart_[i] &&
+	(intBound(lower[i])!=lastLower[i]||intBound(upper[i])!=lastUpper[i])) {
+      changed.push_back(i);
+      mark[i] = 1;
+    }
+  }
+  int numberChanged = static_cast<int>(changed.size());
+  // take off with old bounds (pass 0) then put back with new (pass 1)
+  for (int iPass = 0;iPass < 2;iPass++) {
+    int change = iPass ? 1 : -1;
+    for (int k = 0;k < numberChanged;k++) {
+      int i = changed[k];
+      for (int kk = generatorStart_[i];kk < generatorStart_[i+1];kk++) {
+	int iPerm = generatorList_[kk];
+	const int * orbit = permutations_[iPerm].orbits;
+	if (lastLower[i])
+	  numberAtOne[iPerm] += change;
+	int j = orbit[i];
+	if (lastLower[i]!=lastLower[j]||lastUpper[i]!=lastUpper[j])
+	  numberMismatched[iPerm] += change;
+	// edge in (if other end changed it does as out edge)
+	int previous = j;
+	while (orbit[previous]!=i)
+	  previous = orbit[previous];
+	if (!mark[previous] &&
+	    (lastLower[i]!=lastLower[previous]||lastUpper[i]!=lastUpper[previous]))
+	  numberMismatched[iPerm] += change;
+      }
+    }
+    if (!iPass) {
+      for (int k = 0;k < numberChanged;k++) {
+	int i = changed[k];
+	lastLower[i] = intBound(lower[i]);
+	lastUpper[i] = intBound(upper[i]);
+      }
+    }
+  }
+  for (int k = 0;k < numberChanged;k++)
+    mark[changed[k]] = 0;
+}
+// Mix value into hash of symmetry file key or row
+static inline CoinUInt64 mixHash(CoinUInt64 hash, CoinUInt64 value)
+{
+  CoinUInt64 bits = hash ^ (value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2));
+  bits ^= bits >> 31;
+  bits *= 0xbf58476d1ce4e5b9ULL;
+  bits ^= bits >> 29;
+  return bits;
+}
+static inline CoinUInt64 doubleBits(double value)
+{
+  CoinUInt64 bits;
+  if (!value)
+    value = 0.0; // not -0.0
+  memcpy(&bits, &value, sizeof(double));
+  return bits;
+}
+// Hash of structure - matrix and integers
+CoinUInt64 CbcSymmetry::structureKey(const OsiSolverInterface *solver)
+{
+  int numberColumns = solver->getNumCols();
+  const CoinPackedMatrix *matrix = solver->getMatrixByCol();
+  const double *element = matrix->getElements();
+  const int *row = matrix->getIndices();
+  const CoinBigIndex *columnStart = matrix->getVectorStarts();
+  const int *columnLength = matrix->getVectorLengths();
+  CoinUInt64 key = mixHash(solver->getNumRows(), numberColumns);
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    key = mixHash(key, solver->isInteger(iColumn) ? 1 : 0);
+    key = mixHash(key, columnLength[iColumn]);
+    for (CoinBigIndex j = columnStart[iColumn];
+         j < columnStart[iColumn] + columnLength[iColumn]; j++) {
+      key = mixHash(key, row[j]);
+      key = mixHash(key, doubleBits(element[j]));
+    }
+  }
+  return key;
+}
+/* Whether generator maps problem to itself.  Moved columns must match
+   their images exactly.  Rows with moved columns must map onto same
+   set of rows - checked with order free hash of each row (and its
+   bounds) before and after mapping.
+*/
+bool CbcSymmetry::validGenerator(const OsiSolverInterface *solver,
+  const CoinPackedMatrix *rowCopy, const int *orbit)
+{
+  int numberColumns = solver->getNumCols();
+  int numberRows = solver->getNumRows();
+  const double *objective = solver->getObjCoefficients();
+  const double *columnLower = solver->getColLower();
+  const double *columnUpper = solver->getColUpper();
+  const double *rowLower = solver->getRowLower();
+  const double *rowUpper = solver->getRowUpper();
+  const CoinPackedMatrix *columnCopy = solver->getMatrixByCol();
+  const int *row = columnCopy->getIndices();
+  const CoinBigIndex *columnStart = columnCopy->getVectorStarts();
+  const int *columnLength = columnCopy->getVectorLengths();
+  int *count = new int[numberColumns];
+  memset(count, 0, numberColumns * sizeof(int));
+  bool good = true;
+  for (int i = 0; i < numberColumns; i++) {
+    int j = orbit[i];
+    if (j < 0)
+      continue;
+    if (j >= numberColumns || orbit[j] < 0 || count[j]++
+      || objective[i] != objective[j] || columnLower[i] != columnLower[j]
+      || columnUpper[i] != columnUpper[j]
+      || solver->isInteger(i) != solver->isInteger(j)
+      || columnLength[i] != columnLength[j]) {
+      good = false;
+      break;
+    }
+  }
+  delete[] count;
+  if (!good)
+    return false;
+  char *marked = new char[CoinMax(numberRows, 1)];
+  memset(marked, 0, numberRows);
+  std::vector< int > rows;
+  for (int i = 0; i < numberColumns; i++) {
+    if (orbit[i] < 0)
+      continue;
+    for (CoinBigIndex j = columnStart[i]; j < columnStart[i] + columnLength[i]; j++) {
+      int iRow = row[j];
+      if (!marked[iRow]) {
+        marked[iRow] = 1;
+        rows.push_back(iRow);
+      }
+    }
+  }
+  delete[] marked;
+  const double *elementByRow = rowCopy->getElements();
+  const int *column = rowCopy->getIndices();
+  const CoinBigIndex *rowStart = rowCopy->getVectorStarts();
+  const int *rowLength = rowCopy->getVectorLengths();
+  int numberTouched = static_cast< int >(rows.size());
+  std::vector< CoinUInt64 > before(numberTouched);
+  std::vector< CoinUInt64 > after(numberTouched);
+  for (int k = 0; k < numberTouched; k++) {
+    int iRow = rows[k];
+    CoinUInt64 sumBefore = 0;
+    CoinUInt64 sumAfter = 0;
+    for (CoinBigIndex j = rowStart[iRow]; j < rowStart[iRow] + rowLength[iRow]; j++) {
+      int iColumn = column[j];
+      int jColumn = orbit[iColumn] >= 0 ? orbit[iColumn] : iColumn;
+      CoinUInt64 bits = doubleBits(elementByRow[j]);
+      sumBefore += mixHash(iColumn, bits);
+      sumAfter += mixHash(jColumn, bits);
+    }
+    CoinUInt64 bounds = mixHash(doubleBits(rowLower[iRow]), doubleBits(rowUpper[iRow]));
+    before[k] = mixHash(sumBefore, bounds);
+    after[k] = mixHash(sumAfter, bounds);
+  }
+  std::sort(before.begin(), before.end());
+  std::sort(after.begin(), after.end());
+  return before == after;
+}
+/* Read generators for key from file.  File has any number of sets -
+   CBC_SYMMETRY key columns generators, then for each generator
+   length of cycles, number of cycles, number moved and pairs of column
+   and next in its cycle.
+*/
+bool CbcSymmetry::loadGenerators(const char *fileName, CoinUInt64 key,
+  const OsiSolverInterface *solver)
+{
+  FILE *fp = fopen(fileName, "r");
+  if (!fp)
+    return false;
+  const CoinPackedMatrix *rowCopy = solver->getMatrixByRow();
+  bool found = false;
+  bool readError = false;
+  unsigned long long fileKey;
+  int numberColumns;
+  int numberGenerators;
+  std::vector< cbc_permute > generators;
+  while (!found && !readError
+    && fscanf(fp, " CBC_SYMMETRY %llx %d %d", &fileKey, &numberColumns,
+         &numberGenerators) == 3) {
+    bool match = fileKey == static_cast< unsigned long long >(key)
+      && numberColumns == numberColumns_;
+    bool good = match;
+    for (int iGenerator = 0; iGenerator < numberGenerators; iGenerator++) {
+      cbc_permute permute;
+      int numberMoved;
+      if (fscanf(fp, "%d %d %d", &permute.numberInPerm, &permute.numberPerms,
+            &numberMoved) != 3) {
+        readError = true;
+        break;
+      }
+      permute.orbits = NULL;
+      if (match) {
+        permute.orbits = new int[numberColumns_];
+        for (int i = 0; i < numberColumns_; i++)
+          permute.orbits[i] = -1;
+        generators.push_back(permute);
+      }
+      for (int k = 0; k < numberMoved; k++) {
+        int i, j;
+        if (fscanf(fp, "%d %d", &i, &j) != 2) {
+          readError = true;
+          break;
+        }
+        if (match) {
+          if (i >= 0 && i < numberColumns_ && j >= 0 && j < numberColumns_)
+            permute.orbits[i] = j;
+          else
+            good = false;
+        }
+      }
+      if (readError)
+        break;
+    }
+    if (good && !readError) {
+      for (size_t k = 0; k < generators.size(); k++) {
+        if (!validGenerator(solver, rowCopy, generators[k].orbits)) {
+          good = false;
+          break;
+        }
+      }
+    }
+    if (good && !readError) {
+      found = true;
+      for (size_t k = 0; k < generators.size(); k++)
+        addPermutation(generators[k]);
+      cachedGenerators_ = numberGenerators;
+    } else {
+      for (size_t k = 0; k < generators.size(); k++)
+        delete[] generators[k].orbits;
+    }
+    generators.clear();
+  }
+  fclose(fp);
+  return found;
+}
+// Append generators to file
+void CbcSymmetry::saveGenerators(const char *fileName, CoinUInt64 key) const
+{
+  FILE *fp = fopen(fileName, "a");
+  if (!fp)
+    return;
+  fprintf(fp, "CBC_SYMMETRY %llx %d %d\n", static_cast< unsigned long long >(key),
+    numberColumns_, numberPermutations_);
+  for (int iPerm = 0; iPerm < numberPermutations_; iPerm++) {
+    const int *orbit = permutations_[iPerm].orbits;
+    int numberMoved = 0;
+    for (int i = 0; i < numberColumns_; i++) {
+      if (orbit[i] >= 0)
+        numberMoved++;
+    }
+    fprintf(fp, "%d %d %d", permutations_[iPerm].numberInPerm,
+      permutations_[iPerm].numberPerms, numberMoved);
+    for (int i = 0; i < numberColumns_; i++) {
+      if (orbit[i] >= 0)
+        fprintf(fp, " %d %d", i, orbit[i]);
+    }
+    fprintf(fp, "\n");
+  }
+  fclose(fp);
+}
+// Orbits of columns under stored generators (union-find)
+void CbcSymmetry::fillOrbitsFromGenerators()
+{
+  int *parent = new int[2 * numberColumns_];
+  int *orbitNumber = parent + numberColumns_;
+  for (int i = 0; i < numberColumns_; i++) {
+    parent[i] = i;
+    orbitNumber[i] = 0;
+  }
+  for (int iPerm = 0; iPerm < numberPermutations_; iPerm++) {
+    const int *orbit = permutations_[iPerm].orbits;
+    for (int i = 0; i < numberColumns_; i++) {
+      if (orbit[i] < 0)
+        continue;
+      int iRoot = i;
+      while (parent[iRoot] != iRoot)
+        iRoot = parent[iRoot];
+      int jRoot = orbit[i];
+      while (parent[jRoot] != jRoot)
+        jRoot = parent[jRoot];
+      if (iRoot != jRoot)
+        parent[CoinMax(iRoot, jRoot)] = CoinMin(iRoot, jRoot);
+    }
+  }
+  for (int i = 0; i < numberColumns_; i++) {
+    int iRoot = i;
+    while (parent[iRoot] != iRoot)
+      iRoot = parent[iRoot];
+    parent[i] = iRoot;
+    orbitNumber[iRoot]++;
+  }
+  // number orbits with more than one column
+  numberUsefulOrbits_ = 0;
+  numberUsefulObjects_ = 0;
+  for (int i = 0; i < numberColumns_; i++) {
+    if (parent[i] == i) {
+      if (orbitNumber[i] > 1)
+        orbitNumber[i] = numberUsefulOrbits_++;
+      else
+        orbitNumber[i] = -2;
+    }
+  }
+  for (int i = 0; i < numberColumns_; i++) {
+    whichOrbit_[i] = orbitNumber[parent[i]];
+    if (whichOrbit_[i] >= 0)
+      numberUsefulObjects_++;
+  }
+  delete[] parent;
+}
 void CbcSymmetry::setupSymmetry(CbcModel * model)
 {
   OsiSolverInterface * solver = model->continuousSolver();
@@ -729,44 +1261,49 @@ void CbcSymmetry::setupSymmetry(CbcModel * model)
   int numberRows = solver->getNumRows();
   int iRow, iColumn;
 
-  // Row copy
-  CoinPackedMatrix matrixByRow(*solver->getMatrixByRow());
-  const double *elementByRow = matrixByRow.getElements();
-  const int *column = matrixByRow.getIndices();
-  const CoinBigIndex *rowStart = matrixByRow.getVectorStarts();
-  const int *rowLength = matrixByRow.getVectorLengths();
+  const CoinPackedMatrix *matrix = solver->getMatrixByCol();
+  const double *element = matrix->getElements();
+  const int *row = matrix->getIndices();
+  const CoinBigIndex *columnStart = matrix->getVectorStarts();
+  const int *columnLength = matrix->getVectorLengths();
 
   const double *rowLower = solver->getRowLower();
   const double *rowUpper = solver->getRowUpper();
-  //  // Find Coefficients
-
-  /// initialize nauty
-
-  int num_affine = 0;
 
+  /* Graph - columns, objective, rows and then one coefficient vertex for
+     each distinct value other than 1.0 in a row (or objective) - joined
+     to that row and to all its columns with that value */
+  int numberNonUnit = 0;
   for (iColumn = 0; iColumn < numberColumns; iColumn++) {
     if (objective[iColumn] && objective[iColumn] != 1.0)
-      num_affine++;
+      numberNonUnit++;
+    for (CoinBigIndex j = columnStart[iColumn];
+         j < columnStart[iColumn] + columnLength[iColumn]; j++) {
+      if (element[j] != 1.0)
+        numberNonUnit++;
+    }
   }
-  for (iRow = 0; iRow < numberRows; iRow++) {
-    for (CoinBigIndex j = rowStart[iRow];
-         j < rowStart[iRow] + rowLength[iRow]; j++) {
-      int jColumn = column[j];
-      double value = elementByRow[j];
-      if (value != 1.0)
-        num_affine++;
+  int objectiveVertex = numberColumns;
+  int firstRowVertex = numberColumns + 1;
+  int firstCoefficientVertex = numberColumns + 1 + numberRows;
+  CbcCoefficientHash coefficients(numberNonUnit);
+  for (iColumn = 0; iColumn < numberColumns; iColumn++) {
+    double value = objective[iColumn];
+    if (value && value != 1.0)
+      coefficients.find(-1, value);
+    for (CoinBigIndex j = columnStart[iColumn];
+         j < columnStart[iColumn] + columnLength[iColumn]; j++) {
+      if (element[j] != 1.0)
+        coefficients.find(row[j], element[j]);
     }
   }
-
-  // Create Nauty object
-
-  int coef_count = numberRows + numberColumns + 1;
-  int nc = num_affine + coef_count;
+  int numberCoefficients = coefficients.numberEntries();
+  int nc = firstCoefficientVertex + numberCoefficients;
   if (nc > 100000) {
     // too big
     char general[200];
-    sprintf(general,"Nauty too large %d affine and %d coefficient count",
-	    num_affine,coef_count);
+    sprintf(general,"Nauty too large %d coefficient vertices (%d non unit elements) and %d rows and columns",
+	    numberCoefficients,numberNonUnit,firstCoefficientVertex);
     model->messageHandler()->message(CBC_GENERAL,
 				     model->messages())
       << general << CoinMessageEol;
@@ -776,278 +1313,154 @@ void CbcSymmetry::setupSymmetry(CbcModel * model)
     nauty_info_ = new CbcNauty(0,NULL,NULL,NULL);
     return;
   }
-  // create graph (part 1)
-
+  // vertices for coloring
+  node_info_.reserve(nc);
   for (iColumn = 0; iColumn < numberColumns; iColumn++) {
     Node var_vertex;
     var_vertex.node(iColumn, 0.0, columnLower[iColumn], columnUpper[iColumn], -1, -1);
     node_info_.push_back(var_vertex);
   }
-  // objective
-  int index = numberColumns;
   {
     Node vertex;
-    vertex.node(index, 0.0, -COIN_DBL_MAX, COIN_DBL_MAX,
+    vertex.node(objectiveVertex, 0.0, -COIN_DBL_MAX, COIN_DBL_MAX,
       COUENNE_HACKED_EXPRGROUP, 0);
     node_info_.push_back(vertex);
   }
-
-  // compute space for sparse
-  size_t *v = NULL;
-  int *d = NULL;
-  int *e = NULL;
-  bool sparse = false;
-  double spaceDense = nc + WORDSIZE - 1;
-  spaceDense *= nc + WORDSIZE - 1;
-  spaceDense /= WORDSIZE;
-  int spaceSparse = 0;
-  {
-    size_t numberElements = 0;
-    for (iColumn = 0; iColumn < numberColumns; iColumn++) {
-      double value = objective[iColumn];
-      if (value) {
-        if (value == 1.0) {
-          numberElements += 2;
-        } else {
-          numberElements += 4;
-          coef_count++;
-        }
-      }
+  for (iRow = 0; iRow < numberRows; iRow++) {
+    Node vertex;
+    vertex.node(firstRowVertex + iRow, 0.0, rowLower[iRow], rowUpper[iRow],
+      COUENNE_HACKED_EXPRGROUP, 0);
+    node_info_.push_back(vertex);
+  }
+  for (int k = 0; k < numberCoefficients; k++) {
+    double value = coefficients.value(k);
+    Node coef_vertex;
+    coef_vertex.node(firstCoefficientVertex + k, value, value, value, -2, 0);
+    node_info_.push_back(coef_vertex);
+  }
+  // degrees
+  int *d = new int[nc];
+  memset(d, 0, nc * sizeof(int));
+  for (iColumn = 0; iColumn < numberColumns; iColumn++) {
+    double value = objective[iColumn];
+    if (value) {
+      d[iColumn]++;
+      if (value == 1.0)
+        d[objectiveVertex]++;
+      else
+        d[firstCoefficientVertex + coefficients.find(-1, value)]++;
     }
-    for (iRow = 0; iRow < numberRows; iRow++) {
-      for (CoinBigIndex j = rowStart[iRow];
-           j < rowStart[iRow] + rowLength[iRow]; j++) {
-        int jColumn = column[j];
-        double value = elementByRow[j];
-        if (value == 1.0) {
-          numberElements += 2;
-        } else {
-          numberElements += 4;
-          coef_count++;
-        }
-      }
+    for (CoinBigIndex j = columnStart[iColumn];
+         j < columnStart[iColumn] + columnLength[iColumn]; j++) {
+      d[iColumn]++;
+      if (element[j] == 1.0)
+        d[firstRowVertex + row[j]]++;
+      else
+        d[firstCoefficientVertex + coefficients.find(row[j], element[j])]++;
     }
-    spaceSparse = 2 * nc + numberElements;
-    //printf("Space for sparse is %d for dense %g\n",
-    //	   spaceSparse,spaceDense);
-#ifdef NTY_TRACES
-    bool goSparse = true;
-#else
-    bool goSparse = (spaceSparse < spaceDense);
-#endif
-    // for now always sparse
-    goSparse = true;
-    if (goSparse) {
-      sparse = true;
-      v = new size_t[nc + 1];
-      d = new int[nc];
-      e = new int[numberElements];
-      size_t *counts = new size_t[coef_count + 1];
-      memset(counts, 0, coef_count * sizeof(size_t));
-      coef_count = numberRows + numberColumns + 1;
-      // create graph (part 2)
-      for (iColumn = 0; iColumn < numberColumns; iColumn++) {
-        double value = objective[iColumn];
-        if (value) {
-          if (value == 1.0) {
-            counts[index]++;
-            counts[iColumn]++;
-          } else {
-            counts[index]++;
-            counts[coef_count] += 2;
-            counts[iColumn]++;
-            coef_count++;
-          }
-        }
-      }
-      index++;
-      for (iRow = 0; iRow < numberRows; iRow++) {
-        for (CoinBigIndex j = rowStart[iRow];
-             j < rowStart[iRow] + rowLength[iRow]; j++) {
-          int jColumn = column[j];
-          double value = elementByRow[j];
-          if (value == 1.0) {
-            counts[index]++;
-            counts[jColumn]++;
-          } else {
-            counts[index]++;
-            counts[coef_count] += 2;
-            counts[jColumn]++;
-            coef_count++;
-          }
-        }
-        index++;
-      }
-      // create graph (part 3)
-      assert(nc == coef_count);
-      numberElements = 0;
-      v[0] = 0;
-      for (int i = 0; i < nc; i++) {
-        int count = counts[i];
-        d[i] = count;
-        counts[i] = v[i];
-        numberElements += count;
-        ;
-        v[i + 1] = numberElements;
-      }
-      index = numberColumns;
-      coef_count = numberRows + numberColumns + 1;
-      for (iColumn = 0; iColumn < numberColumns; iColumn++) {
-        double value = objective[iColumn];
-        if (value) {
-          int where;
-          if (value == 1.0) {
-            where = counts[index];
-            counts[index]++;
-            e[where] = iColumn;
-            where = counts[iColumn];
-            counts[iColumn]++;
-            e[where] = index;
-          } else {
-            Node coef_vertex;
-            coef_vertex.node(coef_count, value, value, value, -2, 0);
-            node_info_.push_back(coef_vertex);
-            where = counts[index];
-            counts[index]++;
-            e[where] = coef_count;
-            where = counts[coef_count];
-            counts[coef_count]++;
-            e[where] = index;
-            where = counts[coef_count];
-            counts[coef_count]++;
-            e[where] = iColumn;
-            where = counts[iColumn];
-            counts[iColumn]++;
-            e[where] = coef_count;
-            coef_count++;
-          }
-        }
-      }
-      index++;
-      for (iRow = 0; iRow < numberRows; iRow++) {
-        Node vertex;
-        vertex.node(index, 0.0, rowLower[iRow], rowUpper[iRow],
-          COUENNE_HACKED_EXPRGROUP, 0);
-        node_info_.push_back(vertex);
-        for (CoinBigIndex j = rowStart[iRow];
-             j < rowStart[iRow] + rowLength[iRow]; j++) {
-          int jColumn = column[j];
-          double value = elementByRow[j];
-          int where;
-          if (value == 1.0) {
-            where = counts[index];
-            counts[index]++;
-            e[where] = jColumn;
-            where = counts[jColumn];
-            counts[jColumn]++;
-            e[where] = index;
-          } else {
-            Node coef_vertex;
-            coef_vertex.node(coef_count, value, value, value, -2, 0);
-            node_info_.push_back(coef_vertex);
-            where = counts[index];
-            counts[index]++;
-            e[where] = coef_count;
-            where = counts[coef_count];
-            counts[coef_count]++;
-            e[where] = index;
-            where = counts[coef_count];
-            counts[coef_count]++;
-            e[where] = jColumn;
-            where = counts[jColumn];
-            counts[jColumn]++;
-            e[where] = coef_count;
-            coef_count++;
-          }
-        }
-        index++;
-      }
-      delete[] counts;
+  }
+  for (int k = 0; k < numberCoefficients; k++) {
+    int kRow = coefficients.row(k);
+    d[firstCoefficientVertex + k]++;
+    d[kRow >= 0 ? firstRowVertex + kRow : objectiveVertex]++;
+  }
+  // sparse graph in nauty format
+  size_t *v = new size_t[nc + 1];
+  size_t numberElements = 0;
+  v[0] = 0;
+  for (int i = 0; i < nc; i++) {
+    numberElements += d[i];
+    v[i + 1] = numberElements;
+  }
+  int *e = new int[numberElements];
+  size_t *put = CoinCopyOfArray(v, nc);
+  for (iColumn = 0; iColumn < numberColumns; iColumn++) {
+    double value = objective[iColumn];
+    if (value) {
+      int other = (value == 1.0) ? objectiveVertex
+                                 : firstCoefficientVertex + coefficients.find(-1, value);
+      e[put[iColumn]++] = other;
+      e[put[other]++] = iColumn;
+    }
+    for (CoinBigIndex j = columnStart[iColumn];
+         j < columnStart[iColumn] + columnLength[iColumn]; j++) {
+      int other = (element[j] == 1.0) ? firstRowVertex + row[j]
+                                      : firstCoefficientVertex + coefficients.find(row[j], element[j]);
+      e[put[iColumn]++] = other;
+      e[put[other]++] = iColumn;
     }
   }
+  for (int k = 0; k < numberCoefficients; k++) {
+    int kRow = coefficients.row(k);
+    int other = kRow >= 0 ? firstRowVertex + kRow : objectiveVertex;
+    e[put[firstCoefficientVertex + k]++] = other;
+    e[put[other]++] = firstCoefficientVertex + k;
+  }
+  delete[] put;
+  double spaceDense = nc + WORDSIZE - 1;
+  spaceDense *= nc + WORDSIZE - 1;
+  spaceDense /= WORDSIZE;
+  int spaceSparse = static_cast< int >(2 * nc + numberElements);
 
   nauty_info_ = new CbcNauty(nc, v, d, e);
   delete[] v;
   delete[] d;
   delete[] e;
-  if (!sparse) {
-    // create graph (part 2)
-    coef_count = numberRows + numberColumns + 1;
-    for (iColumn = 0; iColumn < numberColumns; iColumn++) {
-      double value = objective[iColumn];
-      if (value) {
-        if (value == 1.0) {
-          nauty_info_->addElement(index, iColumn);
-          nauty_info_->addElement(iColumn, index);
-        } else {
-          Node coef_vertex;
-          coef_vertex.node(coef_count, value, value, value, -2, 0);
-          node_info_.push_back(coef_vertex);
-          nauty_info_->addElement(index, coef_count);
-          nauty_info_->addElement(coef_count, index);
-          nauty_info_->addElement(coef_count, iColumn);
-          nauty_info_->addElement(iColumn, coef_count);
-          coef_count++;
-        }
-      }
-    }
-    index++;
-    for (iRow = 0; iRow < numberRows; iRow++) {
-      Node vertex;
-      vertex.node(index, 0.0, rowLower[iRow], rowUpper[iRow],
-        COUENNE_HACKED_EXPRGROUP, 0);
-      node_info_.push_back(vertex);
-      for (CoinBigIndex j = rowStart[iRow];
-           j < rowStart[iRow] + rowLength[iRow]; j++) {
-        int jColumn = column[j];
-        double value = elementByRow[j];
-        if (value == 1.0) {
-          nauty_info_->addElement(index, jColumn);
-          nauty_info_->addElement(jColumn, index);
-        } else {
-          Node coef_vertex;
-          coef_vertex.node(coef_count, value, value, value, -2, 0);
-          node_info_.push_back(coef_vertex);
-          nauty_info_->addElement(index, coef_count);
-          nauty_info_->addElement(coef_count, index);
-          nauty_info_->addElement(coef_count, jColumn);
-          nauty_info_->addElement(jColumn, coef_count);
-          coef_count++;
-        }
-      }
-      index++;
-    }
-  }
   numberColumns_ = numberColumns;
   whichOrbit_ = new int[5*numberColumns_];
   for (int i = 0; i < 2*numberColumns_; i++)
     whichOrbit_[i] = -1;
-  // zero out static stuff
-  calls = 0;
-  maxLevel = 0;
-  nautyBranchCalls_ = 0;
-  nautyBranchSucceeded_ = 0;
-  nautyFixCalls_ = 0;
-  nautyFixSucceeded_ = 0;
-  nautyTime_ = 0.0;
-  nautyFixes_ = 0.0;
-  nautyOtherBranches_ = 0.0;
-  lastNautyBranchSucceeded_ = 0;
-  lastNautyFixSucceeded_ = 0;
-  if ((model->moreSpecialOptions2()&131072)!=0) {
-    baseSymmetry = this;
+  memset(&nautyStats_, 0, sizeof(nautyStats_));
+  message_[0] = '\0';
+  // generators also used to prune symmetric nodes before sharing with threads
+  bool wantGenerators = (model->moreSpecialOptions2()&131072)!=0
+    || model->getIntParam(CbcModel::CbcOrbitopeFixing)
+    || model->getNumberThreads() > 0;
+  if (wantGenerators)
     nauty_info_->options()->userautomproc = userautomproc;
+  // generators may be kept from an earlier run on same structure
+  const char * symmetryFile = wantGenerators ? model->symmetryFile() : NULL;
+  CoinUInt64 key = 0;
+  cachedGenerators_ = -1;
+  if (symmetryFile) {
+    key = structureKey(solver);
+    if (loadGenerators(symmetryFile, key, solver))
+      fillOrbitsFromGenerators();
   }
-  try {
-    Compute_Symmetry();
-  } catch (CoinError &e) {
-    char general[200];
-    sprintf(general, "Nauty - initial level %d - will probably take too long",
-        maxLevel);
-    model->messageHandler()->message(CBC_GENERAL,model->messages())
-      <<general <<CoinMessageEol;
+  if (cachedGenerators_ < 0) {
+    CbcNautyLock lock;
+    // zero out static stuff
+    calls = 0;
+    maxLevel = 0;
+    baseSymmetry = this;
+    nautyTimedOut = false;
+    nautyManyGenerators = false;
+    nautyDeadline = (maximumTime_ > 0.0) ? CoinGetTimeOfDay() + maximumTime_ : COIN_DBL_MAX;
+    nautySetup = this;
+    bool complete = true;
+    try {
+      Compute_Symmetry();
+    } catch (CoinError &e) {
+      complete = false;
+      char general[200];
+      if (nautyTimedOut)
+	sprintf(general, "Nauty - stopped at level %d after %g seconds",
+		maxLevel, maximumTime_);
+      else
+	sprintf(general, "Nauty - initial level %d - will probably take too long",
+		maxLevel);
+      model->messageHandler()->message(CBC_GENERAL,model->messages())
+	<<general <<CoinMessageEol;
+    }
+    // later calls (orbital fixing) not limited
+    nautySetup = NULL;
+    strcpy(message_, nautyMessage);
+    fillOrbits();
+    // only whole group worth keeping
+    if (symmetryFile && complete && !nautyManyGenerators
+	&& !nauty_info_->errorStatus())
+      saveGenerators(symmetryFile, key);
   }
-  fillOrbits();
   int options2 =  model->moreSpecialOptions2();
   if (numberUsefulOrbits_ && (options2&131072)!=0) {
     // store original bounds for integers
@@ -1080,7 +1493,7 @@ void CbcSymmetry::setupSymmetry(CbcModel * model)
     stats_[0] = COIN_INT_MAX;
   stats_[1] = spaceSparse;
   double endCPU = CoinCpuTime();
-  nautyTime_ = endCPU - startCPU;
+  nautyStats_.time = endCPU - startCPU;
 }
 // Fixes variables using orbits (returns number fixed)
 int CbcSymmetry::orbitalFixing(OsiSolverInterface *solver)
@@ -1090,8 +1503,12 @@ int CbcSymmetry::orbitalFixing(OsiSolverInterface *solver)
   ChangeBounds(solver->getColLower(),
     solver->getColUpper(),
     solver->getNumCols(), true);
-  Compute_Symmetry();
-  fillOrbits();
+  {
+    CbcNautyLock lock;
+    baseSymmetry = this;
+    Compute_Symmetry();
+    fillOrbits();
+  }
   int n = 0;
   //#define PRINT_MORE 1
   const int *alternativeOrbits = whichOrbit();
@@ -1136,8 +1553,8 @@ int CbcSymmetry::orbitalFixing(OsiSolverInterface *solver)
   }
   delete[] status;
   if (n) {
-    nautyFixSucceeded_++;
-    nautyFixes_ += n;
+    nautyStats_.fixSucceeded++;
+    nautyStats_.fixes += n;
 #if PRINT_MORE
     printf("%d orbital fixes\n", n);
 #endif
@@ -1148,6 +1565,7 @@ int CbcSymmetry::orbitalFixing(OsiSolverInterface *solver)
 void
 CbcSymmetry::addPermutation(cbc_permute permutation)
 {
+  deleteGeneratorLists();
   cbc_permute * temp = new cbc_permute[numberPermutations_+1];
   memcpy(temp,permutations_,numberPermutations_*sizeof(cbc_permute));
   delete [] permutations_;
@@ -1164,12 +1582,30 @@ CbcSymmetry::CbcSymmetry()
   , numberPermutations_(0)
   , permutations_(NULL)
   , whichOrbit_(NULL)
+  , maximumTime_(0.0)
+  , abandoned_(false)
+  , generatorStart_(NULL)
+  , generatorList_(NULL)
+  , lastBounds_(NULL)
+  , generatorCounts_(NULL)
+  , cachedGenerators_(-1)
 {
+  memset(&nautyStats_, 0, sizeof(nautyStats_));
+  message_[0] = '\0';
 }
 // Copy constructor
 CbcSymmetry::CbcSymmetry(const CbcSymmetry &rhs)
+  : generatorStart_(NULL)
+  , generatorList_(NULL)
+  , lastBounds_(NULL)
+  , generatorCounts_(NULL)
+  , cachedGenerators_(rhs.cachedGenerators_)
+  , nautyStats_(rhs.nautyStats_)
 {
+  strcpy(message_, rhs.message_);
   node_info_ = rhs.node_info_;
+  maximumTime_ = rhs.maximumTime_;
+  abandoned_ = false;
   nauty_info_ = new CbcNauty(*rhs.nauty_info_);
   numberUsefulOrbits_ = rhs.numberUsefulOrbits_;
   numberUsefulObjects_ = rhs.numberUsefulObjects_;
@@ -1199,6 +1635,7 @@ CbcSymmetry::operator=(const CbcSymmetry &rhs)
     node_info_ = rhs.node_info_;
     nauty_info_ = new CbcNauty(*rhs.nauty_info_);
     delete[] whichOrbit_;
+    deleteGeneratorLists();
     if (numberPermutations_) {
       for (int i=0;i<numberPermutations_;i++) {
 	delete [] permutations_[i].orbits;
@@ -1206,6 +1643,10 @@ CbcSymmetry::operator=(const CbcSymmetry &rhs)
       delete [] permutations_;
     }
     numberColumns_ = rhs.numberColumns_;
+    maximumTime_ = rhs.maximumTime_;
+    cachedGenerators_ = rhs.cachedGenerators_;
+    nautyStats_ = rhs.nautyStats_;
+    strcpy(message_, rhs.message_);
     numberUsefulOrbits_ = rhs.numberUsefulOrbits_;
     numberUsefulObjects_ = rhs.numberUsefulObjects_;
     if (rhs.whichOrbit_)
@@ -1231,6 +1672,7 @@ CbcSymmetry::~CbcSymmetry()
 {
   delete nauty_info_;
   delete[] whichOrbit_;
+  deleteGeneratorLists();
   if (numberPermutations_) {
     for (int i=0;i<numberPermutations_;i++) {
       delete [] permutations_[i].orbits;
@@ -1613,7 +2055,7 @@ void CbcNauty::computeAuto()
 
   //double endCPU = CoinCpuTime ();
 
-  //nautyTime_ += endCPU - startCPU;
+  //nautyStats_.time += endCPU - startCPU;
   // Need to make sure all generators are written
   if (afp_)
     fflush(afp_);
@@ -1789,8 +2231,7 @@ CbcOrbitalBranchingObject::CbcOrbitalBranchingObject(CbcModel *model, int column
       numberOther_++;
   }
   assert(numberOther_ > 0);
-  nautyBranchSucceeded_++;
-  nautyOtherBranches_ += numberOther_;
+  symmetryInfo->orbitalBranchSucceeded(numberOther_);
   numberExtra_ = numberExtra;
   fixToZero_ = new int[numberOther_ + numberExtra_];
   int n = 0;
@@ -1815,7 +2256,7 @@ CbcOrbitalBranchingObject::CbcOrbitalBranchingObject(CbcModel *model,
 {
   CbcSymmetry *symmetryInfo = model->rootSymmetryInfo();
   assert(symmetryInfo);
-  nautyBranchSucceeded_++;
+  symmetryInfo->orbitalBranchSucceeded(0);
   
   fixToZero_ = CoinCopyOfArray(model->rootSymmetryInfo()->fixedToZero(),
 			       nFixed);
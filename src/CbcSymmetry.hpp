@@ -44,6 +44,7 @@ extern "C" {
 #include <string.h>
 
 #include "CbcModel.hpp"
+#include "CoinTypes.hpp"
 
 class OsiObject;
 // when to give up (depth since last success)
@@ -56,6 +57,18 @@ typedef struct {
   int numberPerms;
   int * orbits;
 } cbc_permute;
+/// Orbital branching and fixing statistics
+typedef struct {
+  int branchCalls;
+  int lastBranchSucceeded;
+  int branchSucceeded;
+  int fixCalls;
+  int lastFixSucceeded;
+  int fixSucceeded;
+  double time;
+  double fixes;
+  double otherBranches;
+} cbc_nauty_stats;
 
 #define COUENNE_HACKED_EPS 1.e-07
 #define COUENNE_HACKED_EPS_SYMM 1e-8
@@ -148,6 +161,11 @@ public:
   int orbitalFixing(OsiSolverInterface *solver);
   /// Fixes variables using root orbits (returns number fixed)
   int orbitalFixing2(OsiSolverInterface *solver);
+  /** Bring counts kept for each generator (columns whose bounds differ
+      from those of image and columns at one) up to date with bounds.
+      Only columns whose bounds changed since last call are looked at so
+      cost goes with changes along branch, not with number of generators */
+  void updateGenerators(const double *lower, const double *upper);
   inline int *whichOrbit()
   {
     return numberUsefulOrbits_ ? whichOrbit_ : NULL;
@@ -182,6 +200,26 @@ public:
 
   /// empty if no NTY, symmetry data structure setup otherwise
   void setupSymmetry(CbcModel * model);
+  /** Set most seconds (wall clock) nauty may take in setupSymmetry -
+      if exceeded search stops with orbits of generators found so far.
+      0.0 - no limit */
+  inline void setMaximumTime(double value)
+  { maximumTime_ = value;}
+  /// Most seconds nauty may take in setupSymmetry
+  inline double maximumTime() const
+  { return maximumTime_;}
+  /** Make setupSymmetry running on another thread stop soon (as with
+      time limit) */
+  inline void abandonSetup()
+  { abandoned_ = true;}
+  /// Whether setupSymmetry told to stop
+  inline bool abandoned() const
+  { return abandoned_;}
+
+  /** Number of generators read from symmetry file (see
+      CbcModel::setSymmetryFile) or -1 if found by nauty */
+  inline int cachedGenerators() const
+  { return cachedGenerators_;}
 
   /// takes ownership of cbc_permute (orbits part)
   void addPermutation(cbc_permute permutation);
@@ -193,6 +231,29 @@ public:
   { return permutations_[which].orbits;}
   inline int numberInPermutation(int which) const
   { return permutations_[which].numberInPerm;}
+  /// Count orbital branch (numberOther extra fixed) in statistics
+  inline void orbitalBranchSucceeded(int numberOther)
+  { nautyStats_.branchSucceeded++; nautyStats_.otherBranches += numberOther;}
+private:
+  /// Build lists of generators moving each column
+  void buildGeneratorLists() const;
+  /// Free lists and counts for generators
+  void deleteGeneratorLists();
+  /** Hash of structure of problem (matrix with elements, integers) -
+      not of objective, bounds or row bounds */
+  static CoinUInt64 structureKey(const OsiSolverInterface *solver);
+  /** Whether generator maps problem in solver to itself (objective,
+      bounds and rows with row bounds) */
+  static bool validGenerator(const OsiSolverInterface *solver,
+    const CoinPackedMatrix *rowCopy, const int *orbit);
+  /** Read generators stored for key from file - keeps first set which is
+      valid for solver.  Returns true if found */
+  bool loadGenerators(const char *fileName, CoinUInt64 key,
+    const OsiSolverInterface *solver);
+  /// Append generators to file with key
+  void saveGenerators(const char *fileName, CoinUInt64 key) const;
+  /// Orbits of group made by stored generators (instead of fillOrbits)
+  void fillOrbitsFromGenerators();
 private:
   mutable std::vector< Node > node_info_;
   mutable CbcNauty *nauty_info_;
@@ -203,6 +264,26 @@ private:
   cbc_permute * permutations_;
   int *whichOrbit_;
   int stats_[5];
+  /// Most seconds for nauty in setupSymmetry (0.0 no limit)
+  double maximumTime_;
+  /// Set from another thread to stop setupSymmetry
+  volatile bool abandoned_;
+  /// Start of generators moving each column in generatorList_
+  mutable int *generatorStart_;
+  /// Generators moving each column (in order)
+  mutable int *generatorList_;
+  /** Bounds as last given to updateGenerators - lower, upper, then
+      marks (NULL until first call) */
+  int *lastBounds_;
+  /** For each generator number of moved columns whose bounds differ from
+      those of image, then number of moved columns at one */
+  int *generatorCounts_;
+  /// Number of generators read from file (-1 if found by nauty)
+  int cachedGenerators_;
+  /// Statistics (per object so separate models can run at once)
+  mutable cbc_nauty_stats nautyStats_;
+  /// Deepest level message from nauty in setupSymmetry
+  char message_[100];
 };
 
 class CbcNauty {
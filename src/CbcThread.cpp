@@ -14,22 +14,42 @@
 #include <cassert>
 #include <cmath>
 #include <cfloat>
+#if defined(CBC_THREAD) && defined(__linux__)
+#include <sched.h>
+#endif
 
 #include "CbcEventHandler.hpp"
 
 #include "OsiSolverInterface.hpp"
 #include "OsiRowCutDebugger.hpp"
 #include "CbcThread.hpp"
+#include "CbcPhaseTimes.hpp"
 #include "CbcTree.hpp"
+#include "CbcPartialNodeInfo.hpp"
 #include "CbcHeuristic.hpp"
+#include "CbcHeuristicFPump.hpp"
+#include "CbcHeuristicRINS.hpp"
+#include "CbcHeuristicDive.hpp"
+#include "CbcHeuristicLocal.hpp"
+#include "CbcTreeLocal.hpp"
 #include "CbcCutGenerator.hpp"
 #include "CbcModel.hpp"
 #include "CbcFathom.hpp"
 #include "CbcSimpleIntegerDynamicPseudoCost.hpp"
+#ifdef CBC_HAS_NAUTY
+#include "CbcSymmetry.hpp"
+#endif
 #include "ClpDualRowDantzig.hpp"
+#ifdef CBC_HAS_CLP
+#include "OsiClpSolverInterface.hpp"
+#include "ClpSimplex.hpp"
+#include "ClpSolve.hpp"
+#include "ClpEventHandler.hpp"
+#endif
 #include "OsiAuxInfo.hpp"
 
 #include "CoinTime.hpp"
+#include "CoinSort.hpp"
 #ifdef CBC_THREAD
 /// Thread functions
 static void *doNodesThread(void *voidInfo);
@@ -208,6 +228,33 @@ void CbcSpecificThread::startThread(void *(*routine)(void *), CbcThread *thread)
 #else
 #endif
 }
+// Bind calling thread to which'th allowed processor
+bool CbcSpecificThread::bindToProcessor(int which)
+{
+#if defined(CBC_PTHREAD) && defined(__linux__)
+  cpu_set_t allowed;
+  if (sched_getaffinity(0, sizeof(allowed), &allowed))
+    return false;
+  int numberAllowed = CPU_COUNT(&allowed);
+  if (!numberAllowed)
+    return false;
+  which = which % numberAllowed;
+  for (int iCpu = 0; iCpu < CPU_SETSIZE; iCpu++) {
+    if (CPU_ISSET(iCpu, &allowed)) {
+      if (!which) {
+        cpu_set_t mask;
+        CPU_ZERO(&mask);
+        CPU_SET(iCpu, &mask);
+        return !pthread_setaffinity_np(pthread_self(), sizeof(mask), &mask);
+      }
+      which--;
+    }
+  }
+  return false;
+#else
+  return false;
+#endif
+}
 // Exits thread (from master)
 int CbcSpecificThread::exit()
 {
@@ -242,22 +289,673 @@ void CbcSpecificThread::setStatus(int value)
 #else
 #endif
 }
+// What a root heuristic needs
+struct CbcRootHeuristics::Bundle {
+  CbcRootHeuristics *owner;
+  CbcModel *model;
+  double *solution;
+  double solutionValue;
+  int which; // heuristic in original model
+  int foundSol;
+  int posted; // 1 solution posted, 3 being taken, 2 passed to model
+};
+// Constructor - starts heuristics
+CbcRootHeuristics::CbcRootHeuristics(CbcModel *model, int numberThreads,
+  int numberHeuristics, CbcModel **models, const int *which)
+  : model_(model)
+  , bundle_(NULL)
+  , pool_(NULL)
+  , numberPosted_(0)
+  , numberTaken_(0)
+  , numberImproved_(0)
+  , numberHeuristics_(numberHeuristics)
+  , running_(false)
+{
+#ifdef CBC_PTHREAD
+  pthread_mutex_init(&mutex_, NULL);
+#endif
+  int numberColumns = model->getNumCols();
+  bundle_ = new Bundle[CoinMax(numberHeuristics, 1)];
+  for (int i = 0; i < numberHeuristics; i++) {
+    Bundle &bundle = bundle_[i];
+    bundle.owner = this;
+    bundle.model = models[i];
+    bundle.solution = new double[numberColumns];
+    bundle.solutionValue = model->getCutoff();
+    bundle.which = which[i];
+    bundle.foundSol = 0;
+    bundle.posted = 0;
+  }
+  if (numberHeuristics_) {
+    pool_ = new CbcThreadPool(CoinMin(numberThreads, numberHeuristics_));
+    pool_->start(doHeuristic, numberHeuristics_, bundle_,
+      static_cast< int >(sizeof(Bundle)));
+    running_ = true;
+  }
+}
+// Destructor - waits for heuristics and throws away anything found
+CbcRootHeuristics::~CbcRootHeuristics()
+{
+  if (running_)
+    pool_->wait();
+  delete pool_;
+  for (int i = 0; i < numberHeuristics_; i++) {
+    delete[] bundle_[i].solution;
+    delete bundle_[i].model;
+  }
+  delete[] bundle_;
+#ifdef CBC_PTHREAD
+  pthread_mutex_destroy(&mutex_);
+#endif
+}
+// What each thread does
+void *CbcRootHeuristics::doHeuristic(void *voidInfo)
+{
+  Bundle *bundle = reinterpret_cast< Bundle * >(voidInfo);
+  CbcRootHeuristics *owner = bundle->owner;
+  bundle->foundSol = bundle->model->heuristic(0)->solution(bundle->solutionValue,
+    bundle->solution);
+  if (bundle->foundSol > 0) {
+    // solution is complete - thread does not touch bundle again
+#ifdef CBC_PTHREAD
+    pthread_mutex_lock(&owner->mutex_);
+#endif
+    bundle->posted = 1;
+    owner->numberPosted_++;
+#ifdef CBC_PTHREAD
+    pthread_mutex_unlock(&owner->mutex_);
+#endif
+  }
+  return NULL;
+}
+/*
+  Pass posted solutions to model.  Cutoff of model is only changed by
+  setBestSolution so a solution the model rejects leaves it alone.
+*/
+int CbcRootHeuristics::takeSolutions()
+{
+  // read without lock - at worst a solution is picked up next time
+  if (numberPosted_ == numberTaken_)
+    return 0;
+#ifdef CBC_PTHREAD
+  pthread_mutex_lock(&mutex_);
+#endif
+  int numberToTake = 0;
+  for (int i = 0; i < numberHeuristics_; i++) {
+    if (bundle_[i].posted == 1) {
+      bundle_[i].posted = 3; // being taken
+      numberToTake++;
+    }
+  }
+#ifdef CBC_PTHREAD
+  pthread_mutex_unlock(&mutex_);
+#endif
+  numberTaken_ += numberToTake;
+  int numberImproved = 0;
+  // in order of heuristics so same for solutions there at same time
+  for (int i = 0; i < numberHeuristics_; i++) {
+    Bundle &bundle = bundle_[i];
+    if (bundle.posted != 3)
+      continue;
+    bundle.posted = 2;
+    if (bundle.solutionValue < model_->getCutoff()) {
+      CbcHeuristic *heuristic = model_->heuristic(bundle.which);
+      double cutoff = model_->getCutoff();
+      model_->setLastHeuristic(heuristic);
+      model_->setBestSolution(CBC_ROUNDING, bundle.solutionValue, bundle.solution);
+      if (model_->getCutoff() < cutoff) {
+        heuristic->incrementNumberSolutionsFound();
+        model_->incrementUsed(bundle.solution);
+        numberImproved++;
+      }
+    }
+  }
+  numberImproved_ += numberImproved;
+  return numberImproved;
+}
+// Wait for heuristics and pass solutions to model
+int CbcRootHeuristics::finish()
+{
+  if (running_) {
+    pool_->wait();
+    running_ = false;
+  }
+  takeSolutions();
+  for (int i = 0; i < numberHeuristics_; i++) {
+    delete[] bundle_[i].solution;
+    delete bundle_[i].model;
+  }
+  numberHeuristics_ = 0;
+  return numberImproved_;
+}
+// What a heuristic in tree needs
+struct CbcTreeHeuristics::Bundle {
+  CbcModel *model;
+  double *solution;
+  double solutionValue;
+  int which; // heuristic in original model
+  int foundSol;
+};
+// Constructor - starts thread
+CbcTreeHeuristics::CbcTreeHeuristics(CbcModel *model, int numberHeuristics,
+  CbcModel **models, const int *which)
+  : model_(model)
+  , bundle_(NULL)
+  , pool_(NULL)
+  , numberHeuristics_(numberHeuristics)
+  , running_(-1)
+{
+  int numberColumns = model->getNumCols();
+  bundle_ = new Bundle[CoinMax(numberHeuristics, 1)];
+  for (int i = 0; i < numberHeuristics; i++) {
+    Bundle &bundle = bundle_[i];
+    bundle.model = models[i];
+    bundle.solution = new double[numberColumns];
+    bundle.solutionValue = COIN_DBL_MAX;
+    bundle.which = which[i];
+    bundle.foundSol = 0;
+  }
+  pool_ = new CbcThreadPool(1);
+}
+// Destructor - waits for heuristic and throws away anything found
+CbcTreeHeuristics::~CbcTreeHeuristics()
+{
+  if (running_ >= 0)
+    pool_->wait();
+  delete pool_;
+  for (int i = 0; i < numberHeuristics_; i++) {
+    delete[] bundle_[i].solution;
+    delete bundle_[i].model;
+  }
+  delete[] bundle_;
+}
+// Copy of model for heuristic in original model
+int CbcTreeHeuristics::whichModel(int iHeuristic) const
+{
+  for (int k = 0; k < numberHeuristics_; k++) {
+    if (bundle_[k].which == iHeuristic)
+      return k;
+  }
+  return -1;
+}
+// Start heuristic of copy k on thread
+void CbcTreeHeuristics::post(int k)
+{
+  assert(running_ < 0);
+  Bundle &bundle = bundle_[k];
+  bundle.solutionValue = bundle.model->getCutoff();
+  bundle.foundSol = 0;
+  running_ = k;
+  pool_->start(doHeuristic, 1, &bundle, static_cast< int >(sizeof(Bundle)));
+}
+// What thread does
+void *CbcTreeHeuristics::doHeuristic(void *voidInfo)
+{
+  Bundle *bundle = reinterpret_cast< Bundle * >(voidInfo);
+  bundle->foundSol = bundle->model->heuristic(0)->solution(bundle->solutionValue,
+    bundle->solution);
+  return NULL;
+}
+// Pass solution to model if heuristic has finished
+int CbcTreeHeuristics::poll(bool wait)
+{
+  if (running_ < 0)
+    return 0;
+  if (!wait && !pool_->finished())
+    return 0;
+  pool_->wait();
+  Bundle &bundle = bundle_[running_];
+  running_ = -1;
+  if (bundle.foundSol > 0 && bundle.solutionValue < model_->getCutoff()) {
+    CbcHeuristic *heuristic = model_->heuristic(bundle.which);
+    double cutoff = model_->getCutoff();
+    model_->setLastHeuristic(heuristic);
+    model_->setBestSolution(CBC_ROUNDING, bundle.solutionValue, bundle.solution);
+    if (model_->getCutoff() < cutoff) {
+      heuristic->incrementNumberSolutionsFound();
+      model_->incrementUsed(bundle.solution);
+      return 1;
+    }
+  }
+  return 0;
+}
+// What a dive in portfolio needs
+struct CbcDivePortfolio::Bundle {
+  CbcDivePortfolio *owner;
+  CbcModel *model;
+  double *solution;
+  double solutionValue;
+  double time; // elapsed seconds in all runs
+  int which; // heuristic in original model
+  int foundSol;
+  int numberRuns;
+  int numberSuccesses;
+};
+// Constructor - starts threads
+CbcDivePortfolio::CbcDivePortfolio(CbcModel *model, int numberConcurrent,
+  int numberDives, CbcModel **models, const int *which)
+  : model_(model)
+  , bundle_(NULL)
+  , pool_(NULL)
+  , bestObjective_(COIN_DBL_MAX)
+  , numberDives_(numberDives)
+  , numberRuns_(0)
+  , lastNode_(-1)
+{
+#ifdef CBC_PTHREAD
+  pthread_mutex_init(&mutex_, NULL);
+#endif
+  int numberColumns = model->getNumCols();
+  bundle_ = new Bundle[CoinMax(numberDives, 1)];
+  for (int i = 0; i < numberDives; i++) {
+    Bundle &bundle = bundle_[i];
+    bundle.owner = this;
+    bundle.model = models[i];
+    bundle.solution = new double[numberColumns];
+    bundle.solutionValue = COIN_DBL_MAX;
+    bundle.time = 0.0;
+    bundle.which = which[i];
+    bundle.foundSol = 0;
+    bundle.numberRuns = 0;
+    bundle.numberSuccesses = 0;
+    CbcHeuristicDive *dive
+      = dynamic_cast< CbcHeuristicDive * >(models[i]->heuristic(0));
+    assert(dive);
+    dive->setSharedObjective(&bestObjective_);
+  }
+  pool_ = new CbcThreadPool(CoinMax(CoinMin(numberConcurrent, numberDives), 1));
+}
+// Destructor - stops threads
+CbcDivePortfolio::~CbcDivePortfolio()
+{
+  delete pool_;
+  for (int i = 0; i < numberDives_; i++) {
+    delete[] bundle_[i].solution;
+    delete bundle_[i].model;
+  }
+  delete[] bundle_;
+#ifdef CBC_PTHREAD
+  pthread_mutex_destroy(&mutex_);
+#endif
+}
+// Copy of model for heuristic in original model
+int CbcDivePortfolio::whichModel(int iHeuristic) const
+{
+  for (int k = 0; k < numberDives_; k++) {
+    if (bundle_[k].which == iHeuristic)
+      return k;
+  }
+  return -1;
+}
+/* Choose dives by UCB1 - reward is an improving solution and mean is
+   taken per second so a cheap dive which finds solutions is preferred.
+   Dives not yet run go first (in order) and switched off ones not at all. */
+int CbcDivePortfolio::choose(int numberNodes, int *which)
+{
+  lastNode_ = numberNodes;
+  numberRuns_++;
+  double *score = new double[numberDives_];
+  int numberCandidates = 0;
+  double logRuns = log(static_cast< double >(numberRuns_));
+  for (int k = 0; k < numberDives_; k++) {
+    const Bundle &bundle = bundle_[k];
+    if (!bundle.model->heuristic(0)->when())
+      continue;
+    double value;
+    if (!bundle.numberRuns) {
+      value = COIN_DBL_MAX;
+    } else {
+      double averageTime = CoinMax(bundle.time / bundle.numberRuns, 1.0e-3);
+      double mean = bundle.numberSuccesses / (bundle.numberRuns * averageTime);
+      value = mean + sqrt(2.0 * logRuns / bundle.numberRuns);
+    }
+    score[numberCandidates] = value;
+    which[numberCandidates++] = k;
+  }
+  int numberChosen = CoinMin(numberCandidates, pool_->numberThreads());
+  // best to front - ties go in order of heuristics
+  for (int i = 0; i < numberChosen; i++) {
+    int best = i;
+    for (int j = i + 1; j < numberCandidates; j++) {
+      if (score[j] > score[best])
+        best = j;
+    }
+    double value = score[best];
+    int k = which[best];
+    for (int j = best; j > i; j--) {
+      score[j] = score[j - 1];
+      which[j] = which[j - 1];
+    }
+    score[i] = value;
+    which[i] = k;
+  }
+  delete[] score;
+  return numberChosen;
+}
+// What each thread does
+void *CbcDivePortfolio::doDive(void *voidInfo)
+{
+  Bundle *bundle = *reinterpret_cast< Bundle ** >(voidInfo);
+  CbcDivePortfolio *owner = bundle->owner;
+  double time1 = CoinGetTimeOfDay();
+  bundle->foundSol = bundle->model->heuristic(0)->solution(bundle->solutionValue,
+    bundle->solution);
+  if (bundle->foundSol > 0) {
+#ifdef CBC_PTHREAD
+    pthread_mutex_lock(&owner->mutex_);
+#endif
+    // others will stop
+    if (bundle->solutionValue < owner->bestObjective_)
+      owner->bestObjective_ = bundle->solutionValue;
+#ifdef CBC_PTHREAD
+    pthread_mutex_unlock(&owner->mutex_);
+#endif
+  }
+  bundle->time += CoinGetTimeOfDay() - time1;
+  return NULL;
+}
+// Run chosen dives and pass best solution to model
+int CbcDivePortfolio::run(int numberChosen, const int *which)
+{
+  if (!numberChosen)
+    return 0;
+  double cutoff = model_->getCutoff();
+  bestObjective_ = cutoff;
+  Bundle **chosen = new Bundle *[numberChosen];
+  for (int i = 0; i < numberChosen; i++) {
+    Bundle &bundle = bundle_[which[i]];
+    bundle.solutionValue = cutoff;
+    bundle.foundSol = 0;
+    bundle.numberRuns++;
+    chosen[i] = &bundle;
+  }
+  pool_->run(doDive, numberChosen, chosen,
+    static_cast< int >(sizeof(Bundle *)));
+  int improved = 0;
+  // in order chosen
+  for (int i = 0; i < numberChosen; i++) {
+    Bundle &bundle = *chosen[i];
+    if (bundle.foundSol > 0 && bundle.solutionValue < model_->getCutoff()) {
+      CbcHeuristic *heuristic = model_->heuristic(bundle.which);
+      double oldCutoff = model_->getCutoff();
+      model_->setLastHeuristic(heuristic);
+      model_->setBestSolution(CBC_ROUNDING, bundle.solutionValue, bundle.solution);
+      if (model_->getCutoff() < oldCutoff) {
+        heuristic->incrementNumberSolutionsFound();
+        model_->incrementUsed(bundle.solution);
+        bundle.numberSuccesses++;
+        improved = 1;
+      }
+    }
+  }
+  delete[] chosen;
+  return improved;
+}
+/* Event handler given to each sub-MIP in CbcSubMipQueue.  At each node
+   it lowers cutoff of sub-MIP to that of parent and stops sub-MIP once
+   its best possible objective can not beat it (or queue is stopping). */
+class CbcSubMipEventHandler : public CbcEventHandler {
+public:
+  CbcSubMipEventHandler(const CbcSubMipQueue *queue)
+    : CbcEventHandler()
+    , queue_(queue)
+  {
+  }
+  CbcSubMipEventHandler(const CbcSubMipEventHandler &rhs)
+    : CbcEventHandler(rhs)
+    , queue_(rhs.queue_)
+  {
+  }
+  virtual CbcEventHandler *clone() const
+  {
+    return new CbcSubMipEventHandler(*this);
+  }
+  virtual CbcAction event(CbcEvent whichEvent)
+  {
+    if (whichEvent != node)
+      return noAction;
+    double cutoff = queue_->cutoff();
+    if (cutoff == -COIN_DBL_MAX)
+      return stop;
+    if (cutoff < model_->getCutoff())
+      model_->setCutoff(cutoff);
+    // best possible is in user sense (and huge until tree has bound)
+    double bestPossible = model_->getBestPossibleObjValue()
+      * model_->solver()->getObjSense();
+    if (bestPossible < 1.0e50 && bestPossible > cutoff - 1.0e-7 * (1.0 + fabs(cutoff)))
+      return stop;
+    return noAction;
+  }
+
+private:
+  const CbcSubMipQueue *queue_;
+};
+// What a sub-MIP needs
+struct CbcSubMipQueue::Bundle {
+  CbcModel *model;
+  CbcModel *presolvedModel;
+  double cutoff; // of model when submitted
+};
+// Constructor - starts threads
+CbcSubMipQueue::CbcSubMipQueue(CbcModel *model, int numberThreads)
+  : model_(model)
+  , running_(NULL)
+  , pool_(NULL)
+  , cutoff_(model->getCutoff())
+  , numberRunning_(0)
+{
+  numberThreads = CoinMax(numberThreads, 1);
+  running_ = new Bundle[numberThreads];
+  pool_ = new CbcThreadPool(numberThreads);
+}
+// Destructor - stops sub-MIPs and throws away anything found
+CbcSubMipQueue::~CbcSubMipQueue()
+{
+  stop();
+  if (numberRunning_)
+    pool_->wait();
+  delete pool_;
+  for (int i = 0; i < numberRunning_; i++)
+    waiting_.push_back(running_[i]);
+  for (size_t i = 0; i < waiting_.size(); i++) {
+    Bundle &bundle = waiting_[i];
+    CbcModel *model2 = bundle.presolvedModel ? bundle.presolvedModel : bundle.model;
+    delete model2->nodeComparison();
+    delete bundle.presolvedModel;
+    delete bundle.model;
+  }
+  delete[] running_;
+}
+// Add sub-MIP
+void CbcSubMipQueue::submit(CbcModel *subModel, CbcModel *presolvedModel)
+{
+  Bundle bundle;
+  bundle.model = subModel;
+  bundle.presolvedModel = presolvedModel;
+  bundle.cutoff = subModel->getCutoff();
+  waiting_.push_back(bundle);
+}
+// What each thread does
+void *CbcSubMipQueue::doSubMip(void *voidInfo)
+{
+  Bundle *bundle = reinterpret_cast< Bundle * >(voidInfo);
+  CbcModel *model2 = bundle->presolvedModel ? bundle->presolvedModel : bundle->model;
+  model2->branchAndBound();
+  return NULL;
+}
+// Tell sub-MIPs to stop
+void CbcSubMipQueue::stop()
+{
+  cutoff_ = -COIN_DBL_MAX;
+}
+// Pass solutions of finished sub-MIPs to model and start next ones
+int CbcSubMipQueue::poll(bool wait)
+{
+  bool stopping = (cutoff_ == -COIN_DBL_MAX);
+  if (!stopping)
+    cutoff_ = model_->getCutoff();
+  int numberImproved = 0;
+  while (true) {
+    if (numberRunning_) {
+      if (!wait && !pool_->finished())
+        break;
+      pool_->wait();
+      // in order submitted
+      for (int i = 0; i < numberRunning_; i++) {
+        Bundle &bundle = running_[i];
+        double oldCutoff = model_->getCutoff();
+        model_->takeSubBranchAndBound(bundle.model, bundle.presolvedModel,
+          bundle.cutoff);
+        if (model_->getCutoff() < oldCutoff)
+          numberImproved++;
+      }
+      numberRunning_ = 0;
+      if (!stopping)
+        cutoff_ = model_->getCutoff();
+    }
+    if (waiting_.empty() || stopping)
+      break;
+    int numberThreads = pool_->numberThreads();
+    int numberToStart = CoinMin(numberThreads, static_cast< int >(waiting_.size()));
+    for (int i = 0; i < numberToStart; i++) {
+      Bundle &bundle = waiting_[i];
+      CbcModel *model2 = bundle.presolvedModel ? bundle.presolvedModel : bundle.model;
+      // parent may have improved since submitted
+      if (cutoff_ < model2->getCutoff())
+        model2->setCutoff(cutoff_);
+      running_[i] = bundle;
+    }
+    waiting_.erase(waiting_.begin(), waiting_.begin() + numberToStart);
+    numberRunning_ = numberToStart;
+    pool_->start(doSubMip, numberRunning_, running_,
+      static_cast< int >(sizeof(Bundle)));
+    if (!wait)
+      break;
+  }
+  return numberImproved;
+}
 // Parallel heuristics
-void parallelHeuristics(int numberThreads,
+void parallelHeuristics(CbcThreadPool *pool,
+  int numberThreads,
   int sizeOfData,
   void *argBundle)
 {
-  Coin_pthread_t *threadId = new Coin_pthread_t[numberThreads];
-  char *args = reinterpret_cast< char * >(argBundle);
-  for (int i = 0; i < numberThreads; i++) {
-    pthread_create(&(threadId[i].thr), NULL, doHeurThread,
-      args + i * sizeOfData);
+  pool->run(doHeurThread, numberThreads, argBundle, sizeOfData);
+}
+// Constructor - starts threads
+CbcThreadPool::CbcThreadPool(int numberThreads)
+  : routine_(NULL)
+  , arguments_(NULL)
+  , sizeOfData_(0)
+  , numberThreads_(numberThreads)
+  , numberTasks_(0)
+  , nextTask_(0)
+  , numberDone_(0)
+  , stop_(false)
+{
+#ifdef CBC_PTHREAD
+  pthread_mutex_init(&mutex_, NULL);
+  pthread_cond_init(&work_, NULL);
+  pthread_cond_init(&done_, NULL);
+  threadId_ = new Coin_pthread_t[numberThreads_];
+  for (int i = 0; i < numberThreads_; i++) {
+    pthread_create(&(threadId_[i].thr), NULL, worker, this);
+    threadId_[i].status = 1;
   }
-  // now wait
-  for (int i = 0; i < numberThreads; i++) {
-    pthread_join(threadId[i].thr, NULL);
+#else
+#endif
+}
+// Destructor - stops threads
+CbcThreadPool::~CbcThreadPool()
+{
+#ifdef CBC_PTHREAD
+  pthread_mutex_lock(&mutex_);
+  stop_ = true;
+  pthread_cond_broadcast(&work_);
+  pthread_mutex_unlock(&mutex_);
+  for (int i = 0; i < numberThreads_; i++)
+    pthread_join(threadId_[i].thr, NULL);
+  delete[] threadId_;
+  pthread_cond_destroy(&done_);
+  pthread_cond_destroy(&work_);
+  pthread_mutex_destroy(&mutex_);
+#else
+#endif
+}
+// Run batch and wait until all done
+void CbcThreadPool::run(void *(*routine)(void *), int numberTasks,
+  void *arguments, int sizeOfData)
+{
+  start(routine, numberTasks, arguments, sizeOfData);
+  wait();
+}
+// Start batch and return at once
+void CbcThreadPool::start(void *(*routine)(void *), int numberTasks,
+  void *arguments, int sizeOfData)
+{
+#ifdef CBC_PTHREAD
+  pthread_mutex_lock(&mutex_);
+  assert(!numberTasks_);
+  routine_ = routine;
+  arguments_ = reinterpret_cast< char * >(arguments);
+  sizeOfData_ = sizeOfData;
+  numberTasks_ = numberTasks;
+  nextTask_ = 0;
+  numberDone_ = 0;
+  pthread_cond_broadcast(&work_);
+  pthread_mutex_unlock(&mutex_);
+#else
+#endif
+}
+// Wait until batch started by start is done
+void CbcThreadPool::wait()
+{
+#ifdef CBC_PTHREAD
+  pthread_mutex_lock(&mutex_);
+  while (numberDone_ < numberTasks_)
+    pthread_cond_wait(&done_, &mutex_);
+  numberTasks_ = 0;
+  pthread_mutex_unlock(&mutex_);
+#else
+#endif
+}
+// Whether batch started by start is done
+bool CbcThreadPool::finished()
+{
+  bool done = true;
+#ifdef CBC_PTHREAD
+  pthread_mutex_lock(&mutex_);
+  done = numberDone_ >= numberTasks_;
+  pthread_mutex_unlock(&mutex_);
+#else
+#endif
+  return done;
+}
+// What each thread does
+void *CbcThreadPool::worker(void *voidPool)
+{
+#ifdef CBC_PTHREAD
+  CbcThreadPool *pool = reinterpret_cast< CbcThreadPool * >(voidPool);
+  pthread_mutex_lock(&pool->mutex_);
+  while (true) {
+    while (!pool->stop_ && pool->nextTask_ >= pool->numberTasks_)
+      pthread_cond_wait(&pool->work_, &pool->mutex_);
+    if (pool->stop_)
+      break;
+    int iTask = pool->nextTask_++;
+    void *(*routine)(void *) = pool->routine_;
+    void *argument = pool->arguments_ + iTask * pool->sizeOfData_;
+    pthread_mutex_unlock(&pool->mutex_);
+    (*routine)(argument);
+    pthread_mutex_lock(&pool->mutex_);
+    pool->numberDone_++;
+    if (pool->numberDone_ == pool->numberTasks_)
+      pthread_cond_signal(&pool->done_);
   }
-  delete[] threadId;
+  pthread_mutex_unlock(&pool->mutex_);
+#else
+#endif
+  return NULL;
 }
 // End of specific thread stuff
 
@@ -280,13 +978,24 @@ CbcThread::CbcThread()
   , numberTimesWaitingToStart_(0)
   , dantzigState_(0)
   , // 0 unset, -1 waiting to be set, 1 set
-  locked_(false)
+  lastHotDepth_(-1)
+  , locked_(false)
   , nDeleteNode_(0)
   , delNode_(NULL)
   , maxDeleteNode_(0)
   , nodesThisTime_(0)
   , iterationsThisTime_(0)
   , deterministic_(0)
+  , numberNodesKept_(0)
+  , siblings_(NULL)
+  , numberSiblings_(0)
+  , tick_(-1)
+  , numberNodesDone_(0)
+  , numberIterationsDone_(0.0)
+  , numberMerges_(0)
+  , timeInMerge_(0.0)
+  , processor_(-1)
+  , setUp_(true)
 {
 }
 void CbcThread::gutsOfDelete()
@@ -322,12 +1031,21 @@ void CbcThread::setUsefulStuff(CbcModel *model, int deterministic, CbcModel *bas
   numberTimesUnlocked_ = 0;
   numberTimesWaitingToStart_ = 0;
   dantzigState_ = 0; // 0 unset, -1 waiting to be set, 1 set
+  lastHotDepth_ = -1;
   locked_ = false;
   delNode_ = NULL;
   maxDeleteNode_ = 0;
   nDeleteNode_ = 0;
   nodesThisTime_ = 0;
   iterationsThisTime_ = 0;
+  numberNodesKept_ = 0;
+  siblings_ = NULL;
+  numberSiblings_ = 0;
+  tick_ = -1;
+  numberNodesDone_ = 0;
+  numberIterationsDone_ = 0.0;
+  numberMerges_ = 0;
+  timeInMerge_ = 0.0;
   if (model != baseModel) {
     // thread
     thisModel_->setInfoInChild(-3, this);
@@ -339,6 +1057,20 @@ void CbcThread::setUsefulStuff(CbcModel *model, int deterministic, CbcModel *bas
       threadStuff_.startThread(doNodesThread, this);
   }
 }
+/*
+  Memory is placed on the memory node of the processor which first
+  touches it.  Thread models are copied by master so, once bound, the
+  thread copies the solver again (the rest is small or is made later in
+  thread anyway).  Master waits for isSetUp before using the model.
+*/
+void CbcThread::setUpInThread()
+{
+  if (processor_ >= 0) {
+    if (threadStuff_.bindToProcessor(processor_))
+      thisModel_->makeSolverLocal();
+  }
+  setUp_ = true;
+}
 /*
   Locks a thread if parallel so that stuff like cut pool
   can be updated and/or used.
@@ -452,6 +1184,34 @@ void CbcThread::waitNano(int time)
   threadStuff_.timedWait(time);
   threadStuff_.unlockThread2();
 }
+/* Ticks up to tick done - publish cutoff and take best of other
+   threads' cutoffs at tick-1 once they have all got there.  Thread holds
+   mutex2 while working so can wait on its own condition.
+*/
+void CbcThread::synchronizeTick(int tick)
+{
+  if (!siblings_ || tick <= tick_)
+    return;
+  tick = CoinMin(tick, CBC_DETERMINISTIC_TICKS - 1);
+  double cutoff = thisModel_->getCutoff();
+  for (int i = tick_ + 1; i <= tick; i++)
+    tickCutoff_[i] = cutoff;
+  // values must be there before tick
+  tick_ = tick;
+  if (!tick)
+    return;
+  double bestCutoff = cutoff;
+  for (int i = 0; i < numberSiblings_; i++) {
+    CbcThread *other = siblings_ + i;
+    if (other == this)
+      continue;
+    while (other->tick_ < tick - 1)
+      threadStuff_.timedWait(100000); // 0.1 millisecond
+    bestCutoff = CoinMin(bestCutoff, static_cast< double >(other->tickCutoff_[tick - 1]));
+  }
+  if (bestCutoff < cutoff)
+    thisModel_->setCutoff(bestCutoff);
+}
 // Signal child to carry on
 void CbcThread::signal()
 {
@@ -502,6 +1262,11 @@ CbcBaseModel::CbcBaseModel()
   , saveObjects_(NULL)
   , defaultParallelIterations_(400)
   , defaultParallelNodes_(2)
+  , startTime_(0.0)
+  , numberActive_(0)
+  , lastActive_(0)
+  , lastAdjustTime_(0.0)
+  , lastWaiting_(0.0)
 {
 }
 // Constructor with model
@@ -514,8 +1279,13 @@ CbcBaseModel::CbcBaseModel(CbcModel &model, int type)
   , saveObjects_(NULL)
   , defaultParallelIterations_(400)
   , defaultParallelNodes_(2)
+  , startTime_(getTime())
+  , lastWaiting_(0.0)
 {
   numberThreads_ = model.getNumberThreads();
+  numberActive_ = numberThreads_;
+  lastActive_ = numberThreads_;
+  lastAdjustTime_ = startTime_;
   if (numberThreads_) {
     children_ = new CbcThread[numberThreads_ + 1];
     // Do a partial one for base model
@@ -552,6 +1322,8 @@ CbcBaseModel::CbcBaseModel(CbcModel &model, int type)
       if (solver)
         solver->setCbcModel(thisModel);
 #endif
+      // threadMode 16 - bind to processors
+      children_[i].setProcessor(((model.getThreadMode() & 16) != 0) ? i : -1);
       children_[i].setUsefulStuff(threadModel_[i], type_, &model,
         children_ + numberThreads_, mutex_main);
 #ifdef THREAD_DEBUG
@@ -560,6 +1332,11 @@ CbcBaseModel::CbcBaseModel(CbcModel &model, int type)
 #endif
     }
     model.setStrategy(saveStrategy);
+    // wait until threads have made their solvers
+    for (int i = 0; i < numberThreads_; i++) {
+      while (!children_[i].isSetUp())
+        children_[numberThreads_].waitNano(100000);
+    }
   }
 }
 // Stop threads
@@ -725,11 +1502,21 @@ int CbcBaseModel::waitForThreadsInTree(int type)
   } else if (type == 1) {
     // normal
     double cutoff = baseModel->getCutoff();
-    CbcNode *node = baseModel->tree()->bestNode(cutoff);
-    // Possible one on tree worse than cutoff
-    if (!node || node->objectiveValue() > cutoff)
-      return 1;
-    threadStats_[0]++;
+    // threads over quota are not given nodes (go idle)
+    int numberActive = activeThreads(baseModel);
+    int numberBusy = 0;
+    for (int i = 0; i < numberThreads_; i++) {
+      if (children_[i].returnCode() != -1)
+        numberBusy++;
+    }
+    CbcNode *node = NULL;
+    if (numberBusy < numberActive) {
+      node = baseModel->tree()->bestNode(cutoff);
+      // Possible one on tree worse than cutoff
+      if (!node || node->objectiveValue() > cutoff)
+        return 1;
+      threadStats_[0]++;
+    }
     //need to think
     int iThread;
     // Start one off if any available
@@ -738,7 +1525,7 @@ int CbcBaseModel::waitForThreadsInTree(int type)
         break;
       }
     }
-    if (iThread < numberThreads_) {
+    if (node && iThread < numberThreads_) {
       children_[iThread].setNode(node);
 #ifdef THREAD_PRINT
       printf("empty thread %d node %x\n", iThread, children_[iThread].node());
@@ -776,7 +1563,7 @@ int CbcBaseModel::waitForThreadsInTree(int type)
         if (children_[iThread].returnCode() == -1)
           break;
       }
-      if (iThread < numberThreads_) {
+      if (iThread < numberThreads_ && numberBusy + (node ? 1 : 0) < numberActive) {
         // If any on tree get
         if (!baseModel->tree()->empty()) {
           //node = baseModel->tree()->bestNode(cutoff) ;
@@ -873,6 +1660,10 @@ int CbcBaseModel::waitForThreadsInTree(int type)
       children_[i].setStatus(0);
       //else
       threadModel_[i]->moveToModel(baseModel, 2);
+      // nodes done without going back to master
+      threadCount_[i] += children_[i].numberNodesKept();
+      if (baseModel->phaseTimes() && threadModel_[i]->phaseTimes())
+        baseModel->phaseTimes()->addThread(*threadModel_[i]->phaseTimes(), i);
       assert(children_[i].numberTimesLocked() == children_[i].numberTimesUnlocked());
       baseModel->messageHandler()->message(CBC_THREAD_STATS, baseModel->messages())
         << "Thread";
@@ -893,6 +1684,14 @@ int CbcBaseModel::waitForThreadsInTree(int type)
     baseModel->messageHandler()->printing(true) << children_[numberThreads_].numberTimesLocked()
                                                 << children_[numberThreads_].timeLocked() << children_[numberThreads_].timeWaitingToLock()
                                                 << CoinMessageEol;
+    const char *fileName = baseModel->threadStatisticsFile();
+    if (fileName) {
+      FILE *fp = fopen(fileName, "w");
+      if (fp) {
+        writeThreadStatistics(fp);
+        fclose(fp);
+      }
+    }
     // delete models (here in case some point to others)
     for (i = 0; i < numberThreads_; i++) {
       // make sure handler will be deleted
@@ -973,6 +1772,103 @@ CbcBaseModel::masterThread() const
 {
   return children_ + numberThreads_;
 }
+// One log line per thread
+void CbcBaseModel::logThreadStatistics() const
+{
+  CbcModel *baseModel = children_[numberThreads_].baseModel();
+  double elapsed = CoinMax(getTime() - startTime_, 1.0e-6);
+  for (int i = 0; i < numberThreads_; i++) {
+    const CbcThread &child = children_[i];
+    baseModel->messageHandler()->message(CBC_THREAD_PROGRESS, baseModel->messages())
+      << i << child.numberNodesDone() << child.numberIterationsDone()
+      << child.timeWaitingToStart() << 100.0 * child.timeWaitingToStart() / elapsed
+      << child.numberTimesLocked() << child.timeWaitingToLock()
+      << child.numberMerges() << child.timeInMerge()
+      << CoinMessageEol;
+  }
+}
+// Same statistics as JSON
+void CbcBaseModel::writeThreadStatistics(FILE *fp) const
+{
+  double elapsed = getTime() - startTime_;
+  int totalNodes = 0;
+  double totalIterations = 0.0;
+  fprintf(fp, "{\n  \"type\": \"%s\",\n  \"elapsed\": %g,\n  \"threads\": [\n",
+    type_ > 0 ? "deterministic" : "opportunistic", elapsed);
+  for (int i = 0; i <= numberThreads_; i++) {
+    const CbcThread &child = children_[i];
+    if (i < numberThreads_) {
+      totalNodes += child.numberNodesDone();
+      totalIterations += child.numberIterationsDone();
+      fprintf(fp, "    { \"thread\": %d, \"nodes\": %d, \"iterations\": %.0f,",
+        i, child.numberNodesDone(), child.numberIterationsDone());
+    } else {
+      fprintf(fp, "    { \"thread\": \"main\",");
+    }
+    fprintf(fp, " \"idle\": %g, \"busy\": %g, \"locks\": %d, \"locked\": %g, \"waitingForLocks\": %g,",
+      child.timeWaitingToStart(), child.timeInThread(),
+      child.numberTimesLocked(), child.timeLocked(), child.timeWaitingToLock());
+    fprintf(fp, " \"merges\": %d, \"merging\": %g }%s\n",
+      child.numberMerges(), child.timeInMerge(), i < numberThreads_ ? "," : "");
+  }
+  fprintf(fp, "  ],\n  \"nodes\": %d,\n  \"iterations\": %.0f\n}\n",
+    totalNodes, totalIterations);
+}
+// Fraction of time each thread has been busy
+void CbcBaseModel::threadBusy(double *busy) const
+{
+  double elapsed = CoinMax(getTime() - startTime_, 1.0e-6);
+  for (int i = 0; i < numberThreads_; i++)
+    busy[i] = CoinMax(0.0, 1.0 - children_[i].timeWaitingToStart() / elapsed);
+}
+
+/* Number of threads which may be given nodes now.  About once a second
+   quota file is read and, with CbcAdaptiveThreads, if threads spent more
+   than half the time since last look waiting for lock one fewer is used,
+   or one more if they hardly waited and the tree has enough nodes.
+*/
+int CbcBaseModel::activeThreads(CbcModel *baseModel)
+{
+  double now = getTime();
+  if (now > lastAdjustTime_ + 1.0) {
+    const char *fileName = baseModel->threadQuotaFile();
+    if (fileName) {
+      FILE *fp = fopen(fileName, "r");
+      if (fp) {
+        int value;
+        if (fscanf(fp, "%d", &value) == 1)
+          baseModel->setThreadQuota(value);
+        fclose(fp);
+      }
+    }
+    double waiting = 0.0;
+    for (int i = 0; i < numberThreads_; i++)
+      waiting += children_[i].timeWaitingToLock();
+    if (baseModel->getIntParam(CbcModel::CbcAdaptiveThreads)) {
+      double fraction = (waiting - lastWaiting_) / ((now - lastAdjustTime_) * numberActive_);
+      if (fraction > 0.5 && numberActive_ > 1)
+        numberActive_--;
+      else if (fraction < 0.1 && numberActive_ < numberThreads_
+        && baseModel->tree()->size() > numberActive_)
+        numberActive_++;
+    }
+    lastWaiting_ = waiting;
+    lastAdjustTime_ = now;
+  }
+  int numberActive = numberActive_;
+  int quota = baseModel->threadQuota();
+  if (quota > 0)
+    numberActive = CoinMin(numberActive, quota);
+  numberActive = CoinMax(numberActive, 1);
+  if (numberActive != lastActive_) {
+    lastActive_ = numberActive;
+    char general[200];
+    sprintf(general, "Giving nodes to %d of %d threads", numberActive, numberThreads_);
+    baseModel->messageHandler()->message(CBC_GENERAL, baseModel->messages())
+      << general << CoinMessageEol;
+  }
+  return numberActive;
+}
 
 // Split model and do work in deterministic parallel
 void CbcBaseModel::deterministicParallel()
@@ -989,9 +1885,17 @@ void CbcBaseModel::deterministicParallel()
 
   int nAffected = baseModel->splitModel(numberThreads_, threadModel, defaultParallelNodes_);
   // do all until finished
+  bool shareAtTicks = (baseModel->moreSpecialOptions2() & 134217728) != 0;
   for (iThread = 0; iThread < numberThreads_; iThread++) {
     // obviously tune
-    children_[iThread].setNDeleteNode(defaultParallelIterations_);
+    if (!shareAtTicks) {
+      children_[iThread].setNDeleteNode(defaultParallelIterations_);
+      children_[iThread].setSiblings(NULL, 0);
+    } else {
+      // cutoffs shared at ticks so can go longer between merges
+      children_[iThread].setNDeleteNode(4 * defaultParallelIterations_);
+      children_[iThread].setSiblings(children_, numberThreads_);
+    }
   }
   // Save current state
   int iObject;
@@ -1094,11 +1998,14 @@ void CbcBaseModel::setDantzigState()
     children_[i].setDantzigState(-1);
   }
 }
+// Most nodes a thread does in a row before going back to master
+#define CBC_LOCAL_NODES 50
 static void *doNodesThread(void *voidInfo)
 {
   CbcThread *stuff = reinterpret_cast< CbcThread * >(voidInfo);
   CbcModel *thisModel = stuff->thisModel();
   CbcModel *baseModel = stuff->baseModel();
+  stuff->setUpInThread();
   while (true) {
     stuff->waitThread();
     //printf("start node %x\n",stuff->node);
@@ -1114,6 +2021,41 @@ static void *doNodesThread(void *voidInfo)
         // try and see if this has slipped through
         if (node) {
           thisModel->doOneNode(baseModel, node, createdNode);
+          if ((baseModel->moreSpecialOptions2() & 67108864) != 0) {
+            /*
+              Keep going down from node just done without going back to
+              master - parent goes on tree (where other threads can take it)
+              and child is done next by this thread.  Master is only needed
+              again when there is no child worth doing.
+            */
+            for (int iLocal = 0; iLocal < CBC_LOCAL_NODES; iLocal++) {
+              if (!createdNode)
+                break;
+              stuff->lockThread();
+              double cutoff = baseModel->getCutoff();
+              double bestPossible = baseModel->tree()->empty() ? createdNode->objectiveValue() : baseModel->tree()->getBestPossibleObjective();
+              bool keep = createdNode->objectiveValue() < cutoff;
+              // leave if child has drifted too far from best bound
+              if (keep && cutoff < 1.0e50 && createdNode->objectiveValue() > bestPossible + 0.1 * (cutoff - bestPossible))
+                keep = false;
+              stuff->unlockThread();
+              if (!keep)
+                break;
+              // give back parent and statistics
+              CbcNode *nextNode = createdNode;
+              stuff->setNode(node);
+              stuff->setCreatedNode(NULL);
+              thisModel->moveToModel(baseModel, 1);
+              // pick up cutoff, solutions and cuts from others
+              stuff->lockThread();
+              thisModel->moveToModel(baseModel, 0);
+              stuff->unlockThread();
+              stuff->incrementNodesKept();
+              node = nextNode;
+              createdNode = NULL;
+              thisModel->doOneNode(baseModel, node, createdNode);
+            }
+          }
         } else {
           //printf("null node\n");
           createdNode = NULL;
@@ -1151,7 +2093,10 @@ static void *doNodesThread(void *voidInfo)
           int nodesNow = thisModel->getNodeCount();
           int iterationsNow = thisModel->getIterationCount();
           int strongNow = thisModel->numberStrongIterations();
-          bool exit1 = (NODE_ITERATIONS * ((nodesNow - nodesThisTime) + ((strongNow - strongThisTime) >> 1)) + (iterationsNow - iterationsThisTime) > numberIterations);
+          int workNow = NODE_ITERATIONS * ((nodesNow - nodesThisTime) + ((strongNow - strongThisTime) >> 1)) + (iterationsNow - iterationsThisTime);
+          bool exit1 = (workNow > numberIterations);
+          // share cutoffs with other threads on work unit clock
+          stuff->synchronizeTick(static_cast< int >((CBC_DETERMINISTIC_TICKS * static_cast< double >(workNow)) / numberIterations));
           //bool exit2 =(thisModel->getIterationCount()>thisModel->getStopNumberIterations()) ;
           //assert (exit1==exit2);
           if (exit1 && nodesNow - nodesThisTime >= 10) {
@@ -1206,7 +2151,8 @@ static void *doNodesThread(void *voidInfo)
             delNode[nDeleteNode++] = node;
           }
         }
-        // end of this sub-tree
+        // end of this sub-tree - others may still be waiting for ticks
+        stuff->synchronizeTick(CBC_DETERMINISTIC_TICKS - 1);
         int *usedA = thisModel->usedInSolution();
         for (int i = 0; i < numberColumns; i++) {
           usedA[i] -= used[i];
@@ -1248,6 +2194,7 @@ static void *doCutsThread(void *voidInfo)
 {
   CbcThread *stuff = reinterpret_cast< CbcThread * >(voidInfo);
   CbcModel *thisModel = stuff->thisModel();
+  stuff->setUpInThread();
   while (true) {
     stuff->waitThread();
     //printf("start node %x\n",stuff->node);
@@ -1260,7 +2207,12 @@ static void *doCutsThread(void *voidInfo)
       generator->refreshModel(thisModel);
       OsiCuts *cuts = reinterpret_cast< OsiCuts * >(stuff->delNode());
       OsiSolverInterface *thisSolver = thisModel->solver();
-      generator->generateCuts(*cuts, fullScan, thisSolver, NULL);
+      double time1 = CoinGetTimeOfDay();
+      // node is only set for cuts at tree nodes (CbcParallelTreeCuts)
+      generator->generateCuts(*cuts, fullScan, thisSolver, thisModel->currentNode());
+      // so base model can start expensive generators first
+      if (!generator->timing())
+        generator->incrementTimeInCutGenerator(CoinGetTimeOfDay() - time1);
       stuff->setReturnCode(1);
       stuff->unlockFromThread();
     } else {
@@ -1335,6 +2287,8 @@ int CbcModel::splitModel(int numberModels, CbcModel **model,
         break;
       CbcModel *otherModel = model[iModel];
       CbcNode *node = tree_->bestNode(cutoff);
+      if (!node)
+        break;
       CbcNodeInfo *nodeInfo = node->nodeInfo();
       assert(nodeInfo);
       if (!nodeInfo->marked()) {
@@ -1453,18 +2407,18 @@ void CbcModel::moveToModel(CbcModel *baseModel, int mode)
     }
     numberGlobalCutsIn_ = baseNumberCuts;
   } else if (mode == 1) {
+    double time = getTime();
     lockThread();
     CbcThread *stuff = reinterpret_cast< CbcThread * >(masterThread_);
     assert(stuff);
-    // deal with hotstart
-    static int lastHotDepth = -1;
+    // deal with hotstart (depth shared by threads of this model)
     if (baseModel->hotstartSolution_) {
       if (!baseModel->numberNodes_) {
-        lastHotDepth = -1;
+        stuff->setLastHotDepth(-1);
       } else if (stuff->node()) {
-        if (stuff->node()->depth() >= lastHotDepth) {
-          lastHotDepth = stuff->node()->depth();
-          //printf("hotdepth %d\n",lastHotDepth);
+        if (stuff->node()->depth() >= stuff->lastHotDepth()) {
+          stuff->setLastHotDepth(stuff->node()->depth());
+          //printf("hotdepth %d\n",stuff->lastHotDepth());
         } else {
           // switch off
           delete[] hotstartSolution_;
@@ -1519,6 +2473,9 @@ void CbcModel::moveToModel(CbcModel *baseModel, int mode)
     }
     //thisGlobal->truncate(numberGlobalCutsIn_);
     numberGlobalCutsIn_ = 999999;
+    // node may have been NULL (nothing done)
+    stuff->addMerge(stuff->node() ? 1 : 0, numberIterations_ - numberFixedAtRoot_,
+      getTime() - time);
     unlockThread();
   } else if (mode == 2) {
     baseModel->sumChangeObjective1_ += sumChangeObjective1_;
@@ -1536,6 +2493,8 @@ void CbcModel::moveToModel(CbcModel *baseModel, int mode)
       nodeCompare_ = NULL;
     baseModel->maximumDepthActual_ = CoinMax(baseModel->maximumDepthActual_, maximumDepthActual_);
     baseModel->numberDJFixed_ += numberDJFixed_;
+    baseModel->numberFathomTries_ += numberFathomTries_;
+    baseModel->numberFathomSuccesses_ += numberFathomSuccesses_;
     baseModel->numberStrongIterations_ += numberStrongIterations_;
     int i;
     for (i = 0; i < 3; i++)
@@ -1551,6 +2510,8 @@ void CbcModel::moveToModel(CbcModel *baseModel, int mode)
     if ((moreSpecialOptions2_ & 32) != 0)
       delete eventHandler_;
     eventHandler_ = NULL;
+    // node trace belongs to base model
+    nodeTrace_ = NULL;
     delete solverCharacteristics_;
     solverCharacteristics_ = NULL;
     bool newMethod = (baseModel->branchingMethod_ && baseModel->branchingMethod_->chooseMethod());
@@ -1567,6 +2528,8 @@ void CbcModel::moveToModel(CbcModel *baseModel, int mode)
       eventHandler_ = baseModel->eventHandler_->clone();
       eventHandler_->setModel(this);
     }
+    // records from all threads go in one node trace
+    nodeTrace_ = baseModel->nodeTrace_;
     assert(!statistics_);
     assert(baseModel->solverCharacteristics_);
     solverCharacteristics_ = new OsiBabSolver(*baseModel->solverCharacteristics_);
@@ -1668,6 +2631,7 @@ void CbcModel::moveToModel(CbcModel *baseModel, int mode)
   } else if (mode == 11) {
     if (parallelMode() < 0) {
       // from deterministic
+      double time = getTime();
       CbcThread *stuff = reinterpret_cast< CbcThread * >(masterThread_);
       assert(stuff);
       // Move solution etc
@@ -1715,6 +2679,8 @@ void CbcModel::moveToModel(CbcModel *baseModel, int mode)
       double cutoff = baseModel->getCutoff();
       while (!tree_->empty()) {
         CbcNode *node = tree_->bestNode(COIN_DBL_MAX);
+        if (!node)
+          break; // only dead nodes were left
         if (node->objectiveValue() < cutoff) {
           assert(node->nodeInfo());
           // Make node join correctly
@@ -1738,6 +2704,8 @@ void CbcModel::moveToModel(CbcModel *baseModel, int mode)
         //printf("CbcNode %x stuff delete\n",stuff->delNode[i]);
         delete stuff->delNode()[i];
       }
+      stuff->addMerge(stuff->nodesThisTime(), stuff->iterationsThisTime(),
+        getTime() - time);
     }
   } else {
     abort();
@@ -1745,7 +2713,7 @@ void CbcModel::moveToModel(CbcModel *baseModel, int mode)
 }
 // Generate one round of cuts - parallel mode
 int CbcModel::parallelCuts(CbcBaseModel *master, OsiCuts &theseCuts,
-  CbcNode * /*node*/, OsiCuts &slackCuts, int lastNumberCuts)
+  CbcNode *node, OsiCuts &slackCuts, int lastNumberCuts)
 {
   /*
       Is it time to scan the cuts in order to remove redundant cuts? If so, set
@@ -1764,28 +2732,83 @@ int CbcModel::parallelCuts(CbcBaseModel *master, OsiCuts &theseCuts,
   int i;
   assert(master);
   for (i = 0; i < numberThreads_; i++) {
-    // set solver here after cloning
-    master->model(i)->solver_ = solver_->clone();
-    master->model(i)->numberNodes_ = (fullScan) ? 1 : 0;
+    // set solver here after cloning (solver from last pass is out of date)
+    CbcModel *thisModel = master->model(i);
+    if (thisModel->modelOwnsSolver())
+      delete thisModel->solver_;
+    thisModel->solver_ = solver_->clone();
+    if (!numberNodes_) {
+      thisModel->numberNodes_ = (fullScan) ? 1 : 0;
+      thisModel->currentNode_ = NULL;
+    } else {
+      // at tree node generators need to see where they are
+      thisModel->numberNodes_ = numberNodes_;
+      thisModel->currentDepth_ = currentDepth_;
+      thisModel->currentPassNumber_ = currentPassNumber_;
+      thisModel->currentNode_ = node;
+      thisModel->setCutoff(getCutoff());
+      // settings may have been changed by base model
+      for (int j = 0; j < numberCutGenerators_; j++)
+        thisModel->generator_[j]->copyControl(generator_[j]);
+    }
   }
   // generate cuts
   int status = 0;
   const OsiRowCutDebugger *debugger = NULL;
   bool onOptimalPath = false;
+  /*
+    Start most expensive generators first so a long one (often probing)
+    does not start last and leave other threads idle.  Time is what
+    copies in thread models have taken so far.  Cuts are still put
+    together in generator order so result does not depend on timing.
+  */
+  int *order = new int[numberCutGenerators_];
+  double *expected = new double[2 * numberCutGenerators_];
+  // time in thread models before this pass (for schedule)
+  double *timeBefore = expected + numberCutGenerators_;
+  int numberToGenerate = 0;
+  int switchOff = (numberNodes_ && !doCutsNow(1) && !fullScan) ? 1 : 0;
   for (i = 0; i < numberCutGenerators_; i++) {
-    bool generate = generator_[i]->normal();
-    // skip if not optimal and should be (maybe a cut generator has fixed variables)
-    if (generator_[i]->needsOptimalBasis() && !solver_->basisIsAvailable())
-      generate = false;
-    if (generator_[i]->switchedOff())
-      generate = false;
-    ;
+    bool generate;
+    if (!numberNodes_) {
+      generate = generator_[i]->normal();
+      // skip if not optimal and should be (maybe a cut generator has fixed variables)
+      if (generator_[i]->needsOptimalBasis() && !solver_->basisIsAvailable())
+        generate = false;
+      if (generator_[i]->switchedOff())
+        generate = false;
+    } else {
+      // same as serialCuts
+      generate = generatorWanted(i, switchOff);
+    }
+    double time = 0.0;
+    for (int iThread = 0; iThread < numberThreads_; iThread++)
+      time += master->model(iThread)->generator_[i]->timeInCutGenerator();
+    timeBefore[i] = time;
     if (generate) {
-      master->waitForThreadsInCuts(0, eachCuts + i, i);
+      expected[numberToGenerate] = -time;
+      order[numberToGenerate++] = i;
     }
   }
+  CoinSort_2(expected, expected + numberToGenerate, order);
+  for (int k = 0; k < numberToGenerate; k++) {
+    i = order[k];
+    master->waitForThreadsInCuts(0, eachCuts + i, i);
+  }
   // wait
   master->waitForThreadsInCuts(1, eachCuts, 0);
+  for (int k = 0; k < numberToGenerate; k++) {
+    i = order[k];
+    double time = 0.0;
+    for (int iThread = 0; iThread < numberThreads_; iThread++)
+      time += master->model(iThread)->generator_[i]->timeInCutGenerator();
+    generator_[i]->addScheduleCall(!numberNodes_, time - timeBefore[i],
+      eachCuts[i].sizeRowCuts());
+  }
+  delete[] order;
+  delete[] expected;
+  // Same cut may come from more than one generator
+  CbcRowCuts uniqueCuts;
   // Now put together
   for (i = 0; i < numberCutGenerators_; i++) {
     // add column cuts
@@ -1805,7 +2828,8 @@ int CbcModel::parallelCuts(CbcBaseModel *master, OsiCuts &theseCuts,
       numberRowCuts = 0;
       for (j = 0; j < n; j++) {
         const OsiRowCut *thisCut = eachCuts[i].rowCutPtr(j);
-        if (thisCut->lb() <= 1.0e10 && thisCut->ub() >= -1.0e10) {
+        if (thisCut->lb() <= 1.0e10 && thisCut->ub() >= -1.0e10
+          && !uniqueCuts.addCutIfNotDuplicate(*thisCut)) {
           theseCuts.insert(eachCuts[i].rowCut(j));
           numberRowCuts++;
         }
@@ -1881,6 +2905,12 @@ int CbcModel::parallelCuts(CbcBaseModel *master, OsiCuts &theseCuts,
 
     for (j = numberRowCutsBefore; j < numberRowCutsAfter; j++) {
       whichGenerator_[numberBefore++] = i;
+      if (numberNodes_) {
+        // mark as in serialCuts so cuts at tree nodes are kept local
+        whichGenerator_[numberBefore - 1] = i + 20000;
+        if (generator_[i]->globalCuts())
+          whichGenerator_[numberBefore - 1] = i + 10000;
+      }
       const OsiRowCut *thisCut = theseCuts.rowCutPtr(j);
       if (thisCut->lb() > thisCut->ub())
         status = -1; // sub-problem is infeasible
@@ -1890,6 +2920,8 @@ int CbcModel::parallelCuts(CbcBaseModel *master, OsiCuts &theseCuts,
         newCut.setGloballyValid(true);
         newCut.mutableRow().setTestForDuplicateIndex(false);
         globalCuts_.addCutIfNotDuplicate(newCut);
+        if (numberNodes_)
+          whichGenerator_[numberBefore - 1] = i + 10000;
       }
     }
     for (j = numberColumnCutsBefore; j < numberColumnCutsAfter; j++) {
@@ -1941,6 +2973,528 @@ void CbcModel::unlockThread()
   if (masterThread_ && (threadMode_ & 1) == 0)
     masterThread_->unlockThread();
 }
+/*
+  Pick up better cutoff from base model.  A double is written in one go
+  so no lock is needed - at worst an older value is seen.  Solutions of
+  root heuristics still running are passed to model - cutoff only
+  changes if one is accepted.
+*/
+bool CbcModel::refreshPublishedCutoff()
+{
+  if (rootHeuristics_) {
+    double cutoff = getCutoff();
+    rootHeuristics_->takeSolutions();
+    if (getCutoff() < cutoff)
+      return true;
+  }
+  if (!masterThread_ || (threadMode_ & 1) != 0)
+    return false;
+  CbcModel *baseModel = masterThread_->baseModel();
+  if (!baseModel || baseModel == this)
+    return false;
+  double cutoff = baseModel->publishedCutoff_;
+  if (cutoff < getCutoff()) {
+    setCutoff(cutoff);
+    return true;
+  } else {
+    return false;
+  }
+}
+/*
+  With moreSpecialOptions2 bit 28 opportunistic threads share one set of
+  pseudocosts - those of base model.  Updates go there as soon as they
+  are found rather than at end of node.  Only the base object is updated
+  here - callers which keep the thread's object up to date still do so
+  and others pick it up with refreshSharedPseudoCosts.  The caller may
+  already hold the lock (lock flag is not a count) so it is only taken
+  and given back if not.
+*/
+bool CbcModel::shareUpdateInformation(const CbcObjectUpdateData &data)
+{
+  if (!masterThread_ || (threadMode_ & 1) != 0 || (moreSpecialOptions2_ & 268435456) == 0)
+    return false;
+  CbcModel *baseModel = masterThread_->baseModel();
+  if (!baseModel || baseModel == this)
+    return false;
+  CbcObject *baseObject = dynamic_cast< CbcObject * >(baseModel->object_[data.objectNumber_]);
+  if (!baseObject)
+    return false;
+  bool alreadyLocked = masterThread_->locked();
+  if (!alreadyLocked)
+    lockThread();
+  baseObject->updateInformation(data);
+  if (!alreadyLocked)
+    unlockThread();
+  return true;
+}
+/*
+  Quick look (without lock) at counts in base model - if another thread
+  has made object trusted take its pseudocosts.
+*/
+bool CbcModel::refreshSharedPseudoCosts(int iObject)
+{
+  if (!masterThread_ || (threadMode_ & 1) != 0 || (moreSpecialOptions2_ & 268435456) == 0)
+    return false;
+  CbcModel *baseModel = masterThread_->baseModel();
+  if (!baseModel || baseModel == this)
+    return false;
+  CbcSimpleIntegerDynamicPseudoCost *thisObject = dynamic_cast< CbcSimpleIntegerDynamicPseudoCost * >(object_[iObject]);
+  if (!thisObject)
+    return false;
+  CbcSimpleIntegerDynamicPseudoCost *baseObject = dynamic_cast< CbcSimpleIntegerDynamicPseudoCost * >(baseModel->object_[iObject]);
+  if (!baseObject)
+    return false;
+  int numberBeforeTrust = thisObject->numberBeforeTrust();
+  bool wantDown = thisObject->numberTimesDown() < numberBeforeTrust
+    && baseObject->numberTimesDown() > thisObject->numberTimesDown();
+  bool wantUp = thisObject->numberTimesUp() < numberBeforeTrust
+    && baseObject->numberTimesUp() > thisObject->numberTimesUp();
+  if (!wantDown && !wantUp)
+    return false;
+  bool alreadyLocked = masterThread_->locked();
+  if (!alreadyLocked)
+    lockThread();
+  thisObject->copySome(baseObject);
+  if (!alreadyLocked)
+    unlockThread();
+  return true;
+}
+// Make solver again in calling thread and delete old one
+void CbcModel::makeSolverLocal()
+{
+  if (!solver_ || !modelOwnsSolver())
+    return;
+  OsiSolverInterface *oldSolver = solver_;
+  solver_ = oldSolver->clone();
+  delete oldSolver;
+  if (solverCharacteristics_)
+    solverCharacteristics_->setSolver(solver_);
+#ifdef CBC_HAS_CLP
+  // Solver may need to know about model
+  CbcOsiSolver *solver = dynamic_cast< CbcOsiSolver * >(solver_);
+  if (solver)
+    solver->setCbcModel(this);
+#endif
+  setPointers(solver_);
+}
+// Get pool with at least numberThreads threads (created if needed)
+CbcThreadPool *CbcModel::threadPool(int numberThreads)
+{
+  if (!threadPool_ || threadPool_->numberThreads() < numberThreads) {
+    delete threadPool_;
+    threadPool_ = new CbcThreadPool(numberThreads);
+  }
+  return threadPool_;
+}
+/*
+  With moreSpecialOptions2 bit 30 root heuristics are run on copies of
+  model on threads while root cuts are being done.  Each runs once (not
+  again if others find solutions) and event handler is not told.
+*/
+bool CbcModel::startRootHeuristics()
+{
+  if ((moreSpecialOptions2_ & 1073741824) == 0 || !numberThreads_ || !numberHeuristics_ || rootHeuristics_)
+    return false;
+  currentPassNumber_ = 1; // so root heuristics will run
+  // Modify based on size etc
+  adjustHeuristics();
+  // See if already within allowable gap
+  for (int i = 0; i < numberHeuristics_; i++) {
+    if (heuristic_[i]->exitNow(bestObjective_)) {
+      currentPassNumber_ = 0;
+      return false;
+    }
+  }
+  CbcModel **models = new CbcModel *[numberHeuristics_];
+  int *which = new int[numberHeuristics_];
+  int numberStarted = 0;
+  for (int i = 0; i < numberHeuristics_; i++) {
+    // skip if can't run here
+    if (!heuristic_[i]->shouldHeurRun(0))
+      continue;
+    CbcModel *newModel = copyWithoutHeuristics();
+    assert(!newModel->continuousSolver_);
+    if (continuousSolver_)
+      newModel->continuousSolver_ = continuousSolver_->clone();
+    else
+      newModel->continuousSolver_ = solver_->clone();
+    newModel->numberThreads_ = 0;
+    newModel->moreSpecialOptions2_ &= ~1073741824;
+    newModel->heuristic_ = new CbcHeuristic *[1];
+    newModel->heuristic_[0] = heuristic_[i]->clone();
+    newModel->heuristic_[0]->setModel(newModel);
+    newModel->heuristic_[0]->resetModel(newModel);
+    newModel->numberHeuristics_ = 1;
+    models[numberStarted] = newModel;
+    which[numberStarted++] = i;
+  }
+  currentPassNumber_ = 0;
+  if (numberStarted)
+    rootHeuristics_ = new CbcRootHeuristics(this, numberThreads_,
+      numberStarted, models, which);
+  delete[] models;
+  delete[] which;
+  return numberStarted > 0;
+}
+// Wait for root heuristics started by startRootHeuristics and take solutions
+void CbcModel::finishRootHeuristics()
+{
+  if (!rootHeuristics_)
+    return;
+  int numberFound = rootHeuristics_->finish();
+  delete rootHeuristics_;
+  rootHeuristics_ = NULL;
+  if (numberFound) {
+    numberHeuristicSolutions_ += numberFound;
+    CbcTreeLocal *tree
+      = dynamic_cast< CbcTreeLocal * >(tree_);
+    if (tree)
+      tree->passInSolution(bestSolution_, bestObjective_);
+  }
+  // feasibility pump has had its chance (as doHeuristicsAtRoot)
+  for (int i = 0; i < numberHeuristics_; i++) {
+    CbcHeuristicFPump *pump
+      = dynamic_cast< CbcHeuristicFPump * >(heuristic_[i]);
+    if (pump && pump->feasibilityPumpOptions() < 1000000
+      && (specialOptions_ & 33554432) == 0) {
+      delete pump;
+      numberHeuristics_--;
+      for (int j = i; j < numberHeuristics_; j++)
+        heuristic_[j] = heuristic_[j + 1];
+    }
+  }
+}
+// Copy of model with only clone of heuristic in it
+CbcModel *CbcModel::heuristicModel(const CbcHeuristic *heuristic)
+{
+  CbcModel *newModel = copyWithoutHeuristics();
+  assert(!newModel->continuousSolver_);
+  if (continuousSolver_)
+    newModel->continuousSolver_ = continuousSolver_->clone();
+  else
+    newModel->continuousSolver_ = solver_->clone();
+  newModel->numberThreads_ = 0;
+  newModel->intParam_[CbcAsyncHeuristics] = 0;
+  newModel->intParam_[CbcConcurrentDives] = 0;
+  newModel->heuristic_ = new CbcHeuristic *[1];
+  newModel->heuristic_[0] = heuristic->clone();
+  newModel->heuristic_[0]->setModel(newModel);
+  newModel->heuristic_[0]->resetModel(newModel);
+  newModel->numberHeuristics_ = 1;
+  return newModel;
+}
+// Give copy of model solver, incumbent and cutoff of this node
+void CbcModel::snapshotForHeuristic(CbcModel *newModel) const
+{
+  if (newModel->modelOwnsSolver())
+    delete newModel->solver_;
+  newModel->solver_ = solver_->clone();
+  newModel->setPointers(newModel->solver_);
+  if (bestSolution_) {
+    int numberColumns = solver_->getNumCols();
+    if (!newModel->bestSolution_)
+      newModel->bestSolution_ = new double[numberColumns];
+    memcpy(newModel->bestSolution_, bestSolution_, numberColumns * sizeof(double));
+  }
+  newModel->bestObjective_ = bestObjective_;
+  newModel->setCutoff(getCutoff());
+  newModel->numberSolutions_ = numberSolutions_;
+  newModel->numberNodes_ = numberNodes_;
+  newModel->currentDepth_ = currentDepth_;
+}
+/*
+  With CbcAsyncHeuristics RINS, diving, local search and polish heuristics in
+  serial tree search run on a background thread on copies of model.
+  Copies are made here before tree search starts.
+*/
+bool CbcModel::startTreeHeuristics()
+{
+  if (!intParam_[CbcAsyncHeuristics] || parallelMode() || parentModel_
+    || !numberHeuristics_ || treeHeuristics_)
+    return false;
+  CbcModel **models = new CbcModel *[numberHeuristics_];
+  int *which = new int[numberHeuristics_];
+  int numberStarted = 0;
+  for (int i = 0; i < numberHeuristics_; i++) {
+    CbcHeuristic *heuristic = heuristic_[i];
+    if (!dynamic_cast< CbcHeuristicRINS * >(heuristic)
+      && !dynamic_cast< CbcHeuristicDive * >(heuristic)
+      && !dynamic_cast< CbcHeuristicLocal * >(heuristic)
+      && !dynamic_cast< CbcHeuristicPolish * >(heuristic))
+      continue;
+    // dives in portfolio run there
+    if (divePortfolio_ && divePortfolio_->whichModel(i) >= 0)
+      continue;
+    models[numberStarted] = heuristicModel(heuristic);
+    which[numberStarted++] = i;
+  }
+  if (numberStarted)
+    treeHeuristics_ = new CbcTreeHeuristics(this, numberStarted, models, which);
+  delete[] models;
+  delete[] which;
+  return numberStarted > 0;
+}
+/*
+  Post heuristic with snapshot of this node (solver, incumbent and
+  cutoff) to background thread.  Returns false if heuristic should be
+  run here - true if posted or skipped because another is running.
+*/
+bool CbcModel::postTreeHeuristic(int iHeuristic)
+{
+  if (!treeHeuristics_)
+    return false;
+  int k = treeHeuristics_->whichModel(iHeuristic);
+  if (k < 0)
+    return false;
+  if (treeHeuristics_->running())
+    return true;
+  snapshotForHeuristic(treeHeuristics_->model(k));
+  treeHeuristics_->post(k);
+  return true;
+}
+// Take solution from background heuristic if finished (or wait)
+int CbcModel::pollTreeHeuristics(bool wait)
+{
+  if (!treeHeuristics_)
+    return 0;
+  int numberFound = treeHeuristics_->poll(wait);
+  if (numberFound) {
+    numberHeuristicSolutions_ += numberFound;
+    CbcTreeLocal *tree
+      = dynamic_cast< CbcTreeLocal * >(tree_);
+    if (tree)
+      tree->passInSolution(bestSolution_, bestObjective_);
+  }
+  return numberFound;
+}
+// Wait for background heuristic, take solution and stop thread
+void CbcModel::finishTreeHeuristics()
+{
+  if (!treeHeuristics_)
+    return;
+  pollTreeHeuristics(true);
+  delete treeHeuristics_;
+  treeHeuristics_ = NULL;
+}
+/*
+  With CbcConcurrentDives dives in serial tree search run together on
+  copies of model.  Copies are made here before tree search starts.
+*/
+bool CbcModel::startDivePortfolio()
+{
+  if (intParam_[CbcConcurrentDives] <= 0 || parallelMode() || parentModel_
+    || !numberHeuristics_ || divePortfolio_)
+    return false;
+  CbcModel **models = new CbcModel *[numberHeuristics_];
+  int *which = new int[numberHeuristics_];
+  int numberDives = 0;
+  for (int i = 0; i < numberHeuristics_; i++) {
+    CbcHeuristic *heuristic = heuristic_[i];
+    if (!dynamic_cast< CbcHeuristicDive * >(heuristic))
+      continue;
+    models[numberDives] = heuristicModel(heuristic);
+    which[numberDives++] = i;
+  }
+  // not worth it for one dive
+  if (numberDives > 1) {
+    divePortfolio_ = new CbcDivePortfolio(this, intParam_[CbcConcurrentDives],
+      numberDives, models, which);
+  } else {
+    for (int i = 0; i < numberDives; i++)
+      delete models[i];
+  }
+  delete[] models;
+  delete[] which;
+  return divePortfolio_ != NULL;
+}
+/*
+  First dive which wants to run at a node runs the portfolio - later ones
+  are skipped as portfolio has chosen which dives to run here.
+*/
+int CbcModel::runDivePortfolio(int iHeuristic)
+{
+  if (!divePortfolio_ || divePortfolio_->whichModel(iHeuristic) < 0)
+    return -1;
+  if (divePortfolio_->lastNode() == numberNodes_)
+    return 0;
+  int *which = new int[numberHeuristics_];
+  int numberChosen = divePortfolio_->choose(numberNodes_, which);
+  for (int i = 0; i < numberChosen; i++)
+    snapshotForHeuristic(divePortfolio_->model(which[i]));
+  int numberFound = divePortfolio_->run(numberChosen, which);
+  delete[] which;
+  if (numberFound) {
+    numberHeuristicSolutions_ += numberFound;
+    CbcTreeLocal *tree
+      = dynamic_cast< CbcTreeLocal * >(tree_);
+    if (tree)
+      tree->passInSolution(bestSolution_, bestObjective_);
+  }
+  return numberFound;
+}
+// Delete dive portfolio
+void CbcModel::finishDivePortfolio()
+{
+  delete divePortfolio_;
+  divePortfolio_ = NULL;
+}
+/*
+  With CbcSubMipThreads sub-MIPs are solved on threads of their own.
+  Global cuts are copied into sub-MIP here, on thread of this model, so
+  nothing is shared while it runs.  Cuts sub-MIP finds are not passed
+  back as they may only be valid with its bounds.
+*/
+int CbcModel::startSubBranchAndBound(CbcModel *model,
+  CbcModel *presolvedModel,
+  int maximumNodes)
+{
+  if (intParam_[CbcSubMipThreads] <= 0)
+    return subBranchAndBound(model, presolvedModel, maximumNodes);
+  CbcModel *model2 = presolvedModel ? presolvedModel : model;
+  setUpSubBranchAndBound(model2, maximumNodes);
+  if (!presolvedModel && model->getNumCols() == solver_->getNumCols()) {
+    int numberCuts = globalCuts_.sizeRowCuts();
+    for (int i = 0; i < numberCuts; i++)
+      model2->globalCuts()->addCutIfNotDuplicate(*globalCuts_.rowCutPtr(i));
+  }
+  if (!subMipQueue_)
+    subMipQueue_ = new CbcSubMipQueue(this, intParam_[CbcSubMipThreads]);
+  CbcSubMipEventHandler handler(subMipQueue_);
+  model2->passInEventHandler(&handler);
+  subMipQueue_->submit(model, presolvedModel);
+  // start if threads free
+  pollSubBranchAndBound(false);
+  return -1;
+}
+// Save solutions from finished sub-MIPs and start more
+int CbcModel::pollSubBranchAndBound(bool wait)
+{
+  if (!subMipQueue_)
+    return 0;
+  int numberFound = subMipQueue_->poll(wait);
+  if (numberFound) {
+    CbcTreeLocal *tree
+      = dynamic_cast< CbcTreeLocal * >(tree_);
+    if (tree)
+      tree->passInSolution(bestSolution_, bestObjective_);
+  }
+  return numberFound;
+}
+/* Stop sub-MIPs and stop threads.  At end of search those waiting can
+   only look where tree has been, running ones may have a solution. */
+void CbcModel::finishSubBranchAndBound()
+{
+  if (!subMipQueue_)
+    return;
+  subMipQueue_->stop();
+  pollSubBranchAndBound(true);
+  delete subMipQueue_;
+  subMipQueue_ = NULL;
+}
+// Constructor - starts nauty on copy of solver
+CbcSymmetryDetection::CbcSymmetryDetection(const CbcModel *model,
+  const OsiSolverInterface *solver, double maximumTime)
+  : model_(NULL)
+  , symmetry_(NULL)
+  , pool_(NULL)
+  , running_(false)
+{
+#ifdef CBC_HAS_NAUTY
+  model_ = new CbcModel(*solver);
+  model_->setMoreSpecialOptions2(model->moreSpecialOptions2());
+  model_->setLogLevel(model->logLevel());
+  model_->setIntParam(CbcModel::CbcOrbitopeFixing,
+    model->getIntParam(CbcModel::CbcOrbitopeFixing));
+  model_->setSymmetryFile(model->symmetryFile());
+  symmetry_ = new CbcSymmetry();
+  if (maximumTime > 0.0)
+    symmetry_->setMaximumTime(maximumTime);
+  pool_ = new CbcThreadPool(1);
+  pool_->start(doDetection, 1, this, static_cast< int >(sizeof(CbcSymmetryDetection)));
+  running_ = true;
+#endif
+}
+// Destructor - tells nauty to stop and waits
+CbcSymmetryDetection::~CbcSymmetryDetection()
+{
+#ifdef CBC_HAS_NAUTY
+  if (running_) {
+    symmetry_->abandonSetup();
+    pool_->wait();
+  }
+  delete symmetry_;
+#endif
+  delete pool_;
+  delete model_;
+}
+// What thread does
+void *CbcSymmetryDetection::doDetection(void *voidInfo)
+{
+#ifdef CBC_HAS_NAUTY
+  CbcSymmetryDetection *detection = reinterpret_cast< CbcSymmetryDetection * >(voidInfo);
+  detection->symmetry_->setupSymmetry(detection->model_);
+#endif
+  return NULL;
+}
+// Whether finished
+bool CbcSymmetryDetection::finished()
+{
+  return !running_ || pool_->finished();
+}
+// Wait and hand over symmetry found
+CbcSymmetry *CbcSymmetryDetection::take(int &options)
+{
+  if (running_) {
+    pool_->wait();
+    running_ = false;
+  }
+  options = model_ ? model_->moreSpecialOptions2() : 0;
+  CbcSymmetry *symmetry = symmetry_;
+  symmetry_ = NULL;
+  return symmetry;
+}
+/*
+  Nauty is run on a model of its own so the bits it clears in
+  moreSpecialOptions2 are not seen by tree search until it has finished.
+  Until then symmetry options are off here.
+*/
+bool CbcModel::startSymmetryDetection()
+{
+#ifdef CBC_HAS_NAUTY
+  if (symmetryDetection_ || !continuousSolver_)
+    return false;
+  symmetryDetection_ = new CbcSymmetryDetection(this, continuousSolver_,
+    dblParam_[CbcSymmetryTimeLimit]);
+  moreSpecialOptions2_ &= ~(128 | 256 | 131072 | 262144);
+  messageHandler()->message(CBC_GENERAL, messages())
+    << "Symmetry being found on background thread" << CoinMessageEol;
+  return true;
+#else
+  return false;
+#endif
+}
+// Take orbits if symmetry detection has finished
+bool CbcModel::pollSymmetryDetection(bool wait)
+{
+#ifdef CBC_HAS_NAUTY
+  if (!symmetryDetection_ || (!wait && !symmetryDetection_->finished()))
+    return false;
+  int options;
+  CbcSymmetry *symmetry = symmetryDetection_->take(options);
+  delete symmetryDetection_;
+  symmetryDetection_ = NULL;
+  const int symmetryOptions = 128 | 256 | 131072 | 262144;
+  moreSpecialOptions2_ = (moreSpecialOptions2_ & ~symmetryOptions) | (options & symmetryOptions);
+  if (!symmetry)
+    return false;
+  delete symmetryInfo_;
+  symmetryInfo_ = symmetry;
+  adoptSymmetry();
+  return symmetryInfo_ != NULL || rootSymmetryInfo_ != NULL;
+#else
+  return false;
+#endif
+}
 // Returns true if locked
 bool CbcModel::isLocked() const
 {
@@ -1984,6 +3538,157 @@ void CbcModel::setInfoInChild(int type, CbcThread *info)
     object_ = NULL;
   }
 }
+#ifdef CBC_HAS_CLP
+/// Stops a concurrent LP once another one has finished
+class CbcConcurrentStop : public ClpEventHandler {
+public:
+  CbcConcurrentStop(volatile int *winner)
+    : ClpEventHandler()
+    , winner_(winner)
+  {
+  }
+  virtual int event(Event whichEvent)
+  {
+    if (*winner_ >= 0 && (whichEvent == endOfIteration || whichEvent == endOfFactorization))
+      return 5; // stopped by event handler
+    return -1;
+  }
+  virtual ClpEventHandler *clone() const
+  {
+    return new CbcConcurrentStop(*this);
+  }
+
+private:
+  volatile int *winner_;
+};
+// What each concurrent LP needs
+typedef struct {
+  OsiClpSolverInterface *solver;
+  ClpSolve::SolveType method;
+  volatile int *winner;
+  int which;
+  double time;
+} CbcConcurrentLp;
+// What each thread does
+static void *doConcurrentLp(void *voidInfo)
+{
+  CbcConcurrentLp *info = reinterpret_cast< CbcConcurrentLp * >(voidInfo);
+  ClpSimplex *simplex = info->solver->getModelPtr();
+  CbcConcurrentStop stop(info->winner);
+  simplex->passInEventHandler(&stop);
+  // own quiet handler - clone may share handler of main solver
+  CoinMessageHandler handler;
+  handler.setLogLevel(0);
+  simplex->passInMessageHandler(&handler);
+  ClpSolve options;
+  options.setSolveType(info->method);
+  options.setPresolveType(ClpSolve::presolveOn);
+  double time1 = CoinCpuTime();
+  simplex->initialSolve(options);
+  info->time = CoinCpuTime() - time1;
+  // an int is written in one go - if two finish together either will do
+  if (simplex->isProvenOptimal() && *info->winner < 0)
+    *info->winner = info->which;
+  return NULL;
+}
+#endif
+/*
+  Dual, primal and barrier are raced on clones of solver.  Basis of
+  first to finish optimal is put in solver and solver resolved (no
+  iterations).  If none is optimal (infeasible, unbounded, stopped)
+  nothing is changed and caller solves as usual so status is right.
+*/
+bool CbcModel::concurrentInitialSolve()
+{
+#ifdef CBC_HAS_CLP
+  OsiClpSolverInterface *clpSolver = dynamic_cast< OsiClpSolverInterface * >(solver_);
+  if (!intParam_[CbcConcurrentRootLp] || !clpSolver || clpSolver->getNumRows() == 0)
+    return false;
+  const int numberRuns = 3;
+  CbcThreadPool *pool = threadPool(numberRuns);
+  if (!pool)
+    return false;
+  static const ClpSolve::SolveType methods[numberRuns] = {
+    ClpSolve::useDual, ClpSolve::usePrimal, ClpSolve::useBarrier
+  };
+  static const char *names[numberRuns] = { "dual", "primal", "barrier" };
+  volatile int winner = -1;
+  CbcConcurrentLp runs[numberRuns];
+  for (int i = 0; i < numberRuns; i++) {
+    runs[i].solver = dynamic_cast< OsiClpSolverInterface * >(clpSolver->clone());
+    runs[i].method = methods[i];
+    runs[i].winner = &winner;
+    runs[i].which = i;
+    runs[i].time = 0.0;
+  }
+  pool->run(doConcurrentLp, numberRuns, runs, static_cast< int >(sizeof(CbcConcurrentLp)));
+  bool done = false;
+  if (winner >= 0) {
+    CoinWarmStart *basis = runs[winner].solver->getWarmStart();
+    solver_->setWarmStart(basis);
+    delete basis;
+    solver_->resolve();
+    done = solver_->isProvenOptimal();
+    char general[200];
+    sprintf(general, "Concurrent root LP - %s finished first in %.2f seconds",
+      names[winner], runs[winner].time);
+    messageHandler()->message(CBC_GENERAL, messages())
+      << general << CoinMessageEol;
+  }
+  for (int i = 0; i < numberRuns; i++)
+    delete runs[i].solver;
+  return done;
+#else
+  return false;
+#endif
+}
+// Make deferred basis diffs of path from node info to root
+static void *doNodePrefetch(void *voidInfo)
+{
+  CbcNodeInfo *nodeInfo = *reinterpret_cast< CbcNodeInfo ** >(voidInfo);
+  while (nodeInfo) {
+    const CbcPartialNodeInfo *partial = dynamic_cast< const CbcPartialNodeInfo * >(nodeInfo);
+    if (!partial)
+      break; // full node info - restore starts here
+    if (partial->basisDiffDeferred())
+      partial->basisDiff();
+    nodeInfo = nodeInfo->parent();
+  }
+  return NULL;
+}
+/*
+  With CbcPrefetchNodes the node at top of tree (likely to be taken next)
+  has the path to its nearest full node info made ready on a thread of its
+  own while this node is solved - basis diffs deferred when nodes were
+  made (CbcPartialNodeInfo) are generated so restoring it only applies
+  them.  Nothing else is touched on the thread (not bounds or cuts, which
+  the search may change), and nothing on the path is changed by the
+  search before finishNodePrefetch, as nodes on tree are not deleted
+  while a node is being solved.  Serial search only.
+*/
+void CbcModel::startNodePrefetch()
+{
+  prefetchNodeInfo_ = NULL;
+  if (!intParam_[CbcPrefetchNodes] || numberThreads_ || parentModel_
+    || !tree_ || tree_->empty())
+    return;
+  CbcNode *next = tree_->top();
+  if (!next || !next->nodeInfo())
+    return;
+  if (!prefetchPool_)
+    prefetchPool_ = new CbcThreadPool(1);
+  prefetchNodeInfo_ = next->nodeInfo();
+  prefetchPool_->start(doNodePrefetch, 1, &prefetchNodeInfo_,
+    static_cast< int >(sizeof(CbcNodeInfo *)));
+}
+// Wait for thread started by startNodePrefetch
+void CbcModel::finishNodePrefetch()
+{
+  if (prefetchNodeInfo_) {
+    prefetchPool_->wait();
+    prefetchNodeInfo_ = NULL;
+  }
+}
 
 /// Indicates whether Cbc library has been compiled with multithreading support
 bool CbcModel::haveMultiThreadSupport() { return true; }
@@ -1997,6 +3702,33 @@ bool CbcModel::haveMultiThreadSupport() { return false; }
 bool CbcModel::isLocked() const { return false; }
 void CbcModel::lockThread() {}
 void CbcModel::unlockThread() {}
+bool CbcModel::refreshPublishedCutoff() { return false; }
+CbcThreadPool *CbcModel::threadPool(int numberThreads) { return NULL; }
+void CbcModel::startNodePrefetch() {}
+void CbcModel::finishNodePrefetch() {}
+void CbcModel::makeSolverLocal() {}
+bool CbcModel::startRootHeuristics() { return false; }
+void CbcModel::finishRootHeuristics() {}
+bool CbcModel::startTreeHeuristics() { return false; }
+bool CbcModel::postTreeHeuristic(int) { return false; }
+int CbcModel::pollTreeHeuristics(bool) { return 0; }
+void CbcModel::finishTreeHeuristics() {}
+CbcModel *CbcModel::heuristicModel(const CbcHeuristic *) { return NULL; }
+void CbcModel::snapshotForHeuristic(CbcModel *) const {}
+bool CbcModel::startDivePortfolio() { return false; }
+int CbcModel::runDivePortfolio(int) { return -1; }
+void CbcModel::finishDivePortfolio() {}
+int CbcModel::startSubBranchAndBound(CbcModel *model, CbcModel *presolvedModel, int maximumNodes)
+{
+  return subBranchAndBound(model, presolvedModel, maximumNodes);
+}
+int CbcModel::pollSubBranchAndBound(bool) { return 0; }
+void CbcModel::finishSubBranchAndBound() {}
+bool CbcModel::startSymmetryDetection() { return false; }
+bool CbcModel::pollSymmetryDetection(bool) { return false; }
+bool CbcModel::concurrentInitialSolve() { return false; }
+bool CbcModel::shareUpdateInformation(const CbcObjectUpdateData &) { return false; }
+bool CbcModel::refreshSharedPseudoCosts(int) { return false; }
 void CbcModel::setInfoInChild(int type, CbcThread *info) {}
 void CbcModel::moveToModel(CbcModel *baseModel, int mode) {}
 int CbcModel::splitModel(int numberModels, CbcModel **model, int numberNodes) { return 0; }
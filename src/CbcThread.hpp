@@ -21,6 +21,9 @@ typedef struct {
 } Coin_pthread_t;
 #endif
 //#define THREAD_DEBUG 1
+/** Number of work unit ticks in a deterministic round.
+    Threads share cutoffs at ticks (see CbcThread::synchronizeTick) */
+#define CBC_DETERMINISTIC_TICKS 16
 /** A class to encapsulate specific thread stuff
     To use another api with same style - you just need to implement
     these methods.
@@ -60,6 +63,9 @@ public:
   void timedWait(int time);
   /// Actually starts a thread
   void startThread(void *(*routine)(void *), CbcThread *thread);
+  /** Bind calling thread to which'th processor it is allowed to run on
+      (modulo number allowed).  Returns false if not possible here */
+  bool bindToProcessor(int which);
   /// Exits thread (called from master) - return code should be zero
   int exit();
   /// Exits thread
@@ -80,6 +86,349 @@ public: // private:
 #endif
   bool locked_; // For mutex2
 };
+/** A pool of threads kept for life of a model
+
+    Used for work given out in batches (root models, parallel heuristics)
+    so threads are not created and joined every batch.  Idle threads and
+    the caller block on condition variables rather than polling.
+ */
+
+class CbcThreadPool {
+public:
+  /// Constructor - starts threads
+  CbcThreadPool(int numberThreads);
+
+  /// Destructor - stops threads
+  ~CbcThreadPool();
+
+  /// Number of threads
+  inline int numberThreads() const
+  {
+    return numberThreads_;
+  }
+  /** Run routine on numberTasks arguments (each sizeOfData bytes apart
+      starting at arguments) and wait until all done.  At most
+      numberThreads() run at once */
+  void run(void *(*routine)(void *), int numberTasks,
+    void *arguments, int sizeOfData);
+  /// As run but return at once - wait must be called before next batch
+  void start(void *(*routine)(void *), int numberTasks,
+    void *arguments, int sizeOfData);
+  /// Wait until batch given to start is done
+  void wait();
+  /// Whether batch given to start is done (so wait will not block)
+  bool finished();
+
+private:
+  /// What each thread does
+  static void *worker(void *pool);
+  /// Illegal copy constructor
+  CbcThreadPool(const CbcThreadPool &);
+  /// Illegal assignment operator
+  CbcThreadPool &operator=(const CbcThreadPool &);
+
+private:
+#ifdef CBC_PTHREAD
+  pthread_mutex_t mutex_;
+  pthread_cond_t work_; // wakes threads
+  pthread_cond_t done_; // wakes caller
+  Coin_pthread_t *threadId_;
+#endif
+  void *(*routine_)(void *);
+  char *arguments_;
+  int sizeOfData_;
+  int numberThreads_;
+  int numberTasks_; // in current batch
+  int nextTask_; // next to be taken
+  int numberDone_; // finished in current batch
+  bool stop_;
+};
+/** Root heuristics run on threads while main thread does root cuts
+
+    Each heuristic which would run at root has its own copy of the model
+    (as for parallel heuristics).  Solutions posted so far can be passed
+    to model at any time by takeSolutions so cut loop can use cutoff at
+    once - cutoff only changes if model accepts solution.  The rest are
+    passed to model by finish.
+ */
+
+class CbcRootHeuristics {
+public:
+  /** Constructor - starts heuristics.
+      models[i] is copy of model with only heuristic which[i] in it -
+      models are then owned by this. */
+  CbcRootHeuristics(CbcModel *model, int numberThreads,
+    int numberHeuristics, CbcModel **models, const int *which);
+
+  /// Destructor - waits for heuristics and throws away anything found
+  ~CbcRootHeuristics();
+
+  /// Number of heuristics started
+  inline int numberHeuristics() const
+  {
+    return numberHeuristics_;
+  }
+  /** Pass solutions posted by heuristics which have finished to model
+      (main thread only).  Returns number which improved solution */
+  int takeSolutions();
+  /** Wait for heuristics and pass solutions to model.
+      Returns number of heuristics which improved solution (including
+      those in takeSolutions) */
+  int finish();
+
+private:
+  /// What each thread does
+  static void *doHeuristic(void *bundle);
+  /// Illegal copy constructor
+  CbcRootHeuristics(const CbcRootHeuristics &);
+  /// Illegal assignment operator
+  CbcRootHeuristics &operator=(const CbcRootHeuristics &);
+
+private:
+  struct Bundle;
+  /// Model heuristics came from
+  CbcModel *model_;
+  /// One per heuristic
+  Bundle *bundle_;
+  /// Threads
+  CbcThreadPool *pool_;
+#ifdef CBC_PTHREAD
+  pthread_mutex_t mutex_; // for posted flags
+#endif
+  /// Number of solutions posted by threads (may be read without lock)
+  volatile int numberPosted_;
+  /// Number of those passed to model
+  int numberTaken_;
+  /// Number which improved solution
+  int numberImproved_;
+  int numberHeuristics_;
+  bool running_;
+};
+/** Heuristics run on a background thread during serial tree search
+    (CbcModel::CbcAsyncHeuristics)
+
+    Each heuristic which may run there has its own copy of the model.
+    CbcModel sets up a copy with a snapshot of the node and posts it;
+    tree search goes on and the solution is passed to model by poll
+    once heuristic has finished.  Only one heuristic runs at a time.
+ */
+
+class CbcTreeHeuristics {
+public:
+  /** Constructor - starts thread.
+      models[i] is copy of model with only heuristic which[i] in it -
+      models are then owned by this. */
+  CbcTreeHeuristics(CbcModel *model, int numberHeuristics,
+    CbcModel **models, const int *which);
+
+  /// Destructor - waits for heuristic and throws away anything found
+  ~CbcTreeHeuristics();
+
+  /// Copy of model for heuristic in original model (-1 if not run here)
+  int whichModel(int iHeuristic) const;
+  /// Copy of model k (only to be changed if not running)
+  inline CbcModel *model(int k) const
+  {
+    return bundle_[k].model;
+  }
+  /// Whether a heuristic is running (or finished but not polled)
+  inline bool running() const
+  {
+    return running_ >= 0;
+  }
+  /// Start heuristic of copy k on thread
+  void post(int k);
+  /** If heuristic has finished (or wait true) pass any better solution
+      to model.  Returns 1 if solution improved otherwise 0 */
+  int poll(bool wait);
+
+private:
+  /// What thread does
+  static void *doHeuristic(void *bundle);
+  /// Illegal copy constructor
+  CbcTreeHeuristics(const CbcTreeHeuristics &);
+  /// Illegal assignment operator
+  CbcTreeHeuristics &operator=(const CbcTreeHeuristics &);
+
+private:
+  struct Bundle;
+  /// Model heuristics came from
+  CbcModel *model_;
+  /// One per heuristic
+  Bundle *bundle_;
+  /// Thread
+  CbcThreadPool *pool_;
+  int numberHeuristics_;
+  /// Copy running (-1 if none)
+  int running_;
+};
+/** Symmetry found on a background thread (CbcModel::CbcAsyncSymmetry)
+
+    Nauty runs on a model of its own (with a copy of continuous solver)
+    so options it changes are not those of model.  CbcModel takes orbits
+    once finished says they are ready.
+ */
+
+class CbcSymmetryDetection {
+public:
+  /// Constructor - starts nauty on copy of solver (at most maximumTime seconds)
+  CbcSymmetryDetection(const CbcModel *model, const OsiSolverInterface *solver,
+    double maximumTime);
+
+  /// Destructor - tells nauty to stop and waits
+  ~CbcSymmetryDetection();
+
+  /// Whether finished (so take will not block)
+  bool finished();
+  /** Wait and hand over symmetry found (or NULL).  options gets
+      moreSpecialOptions2 as left by setupSymmetry */
+  CbcSymmetry *take(int &options);
+
+private:
+  /// What thread does
+  static void *doDetection(void *detection);
+  /// Illegal copy constructor
+  CbcSymmetryDetection(const CbcSymmetryDetection &);
+  /// Illegal assignment operator
+  CbcSymmetryDetection &operator=(const CbcSymmetryDetection &);
+
+private:
+  /// Model nauty runs on (owns copy of solver)
+  CbcModel *model_;
+  /// Symmetry being found
+  CbcSymmetry *symmetry_;
+  /// Thread
+  CbcThreadPool *pool_;
+  bool running_;
+};
+/** Portfolio of dives run at same time in tree (CbcConcurrentDives)
+
+    Each dive heuristic has its own copy of the model.  At a node chosen
+    dives start from the same LP solution on clones of solver.  They share
+    the best objective found so the others stop as soon as one has found
+    a better solution.  Dives are chosen as a bandit (UCB1 on how often
+    each has found an improving solution per second of diving).
+ */
+
+class CbcDivePortfolio {
+public:
+  /** Constructor - starts threads.
+      models[i] is copy of model with only dive which[i] in it -
+      models are then owned by this.  At most numberConcurrent run at once */
+  CbcDivePortfolio(CbcModel *model, int numberConcurrent,
+    int numberDives, CbcModel **models, const int *which);
+
+  /// Destructor - stops threads
+  ~CbcDivePortfolio();
+
+  /// Copy of model for heuristic in original model (-1 if not in portfolio)
+  int whichModel(int iHeuristic) const;
+  /// Copy of model k
+  inline CbcModel *model(int k) const
+  {
+    return bundle_[k].model;
+  }
+  /// Node count when last run
+  inline int lastNode() const
+  {
+    return lastNode_;
+  }
+  /** Choose dives to run at node with count numberNodes.
+      Returns number chosen - copies are put in which */
+  int choose(int numberNodes, int *which);
+  /** Run chosen dives (copies must have snapshot of node) and pass
+      any better solution to model.  Returns 1 if solution improved */
+  int run(int numberChosen, const int *which);
+
+private:
+  /// What each thread does
+  static void *doDive(void *bundle);
+  /// Illegal copy constructor
+  CbcDivePortfolio(const CbcDivePortfolio &);
+  /// Illegal assignment operator
+  CbcDivePortfolio &operator=(const CbcDivePortfolio &);
+
+private:
+  struct Bundle;
+  /// Model dives came from
+  CbcModel *model_;
+  /// One per dive
+  Bundle *bundle_;
+  /// Threads
+  CbcThreadPool *pool_;
+#ifdef CBC_PTHREAD
+  pthread_mutex_t mutex_;
+#endif
+  /// Best objective found by dives now running
+  volatile double bestObjective_;
+  int numberDives_;
+  /// Number of times portfolio has been run
+  int numberRuns_;
+  /// Node count when last run
+  int lastNode_;
+};
+/** Sub-MIPs solved on threads while search goes on (CbcSubMipThreads)
+
+    Each sub-MIP is a model set up as for CbcModel::subBranchAndBound and
+    owned by this once submitted.  They run on a pool of their own (so
+    the pool of model is free for others) at most numberThreads at once,
+    in order submitted.  Cutoff of model is copied in by poll and read by
+    sub-MIPs at each node without lock - a sub-MIP lowers its cutoff to it
+    and stops when its best possible objective can not beat it, as it
+    would then be pointless.  Solutions are passed to model by poll, so
+    only on thread of model.
+ */
+
+class CbcSubMipQueue {
+public:
+  /// Constructor - starts threads
+  CbcSubMipQueue(CbcModel *model, int numberThreads);
+
+  /// Destructor - stops sub-MIPs and throws away anything found
+  ~CbcSubMipQueue();
+
+  /** Add sub-MIP - model and presolved model (may be NULL) are then
+      owned by this.  Started by next poll if threads free */
+  void submit(CbcModel *subModel, CbcModel *presolvedModel);
+  /** If running sub-MIPs have finished (or wait true) pass any better
+      solutions to model and start next ones waiting.  Returns number of
+      times solution improved */
+  int poll(bool wait);
+  /// Tell running and waiting sub-MIPs to stop (poll still to be called)
+  void stop();
+  /// Number of sub-MIPs running or waiting
+  inline int numberSubMips() const
+  {
+    return numberRunning_ + static_cast< int >(waiting_.size());
+  }
+  /// Cutoff sub-MIPs must beat (read by sub-MIPs while running)
+  inline double cutoff() const
+  {
+    return cutoff_;
+  }
+
+private:
+  /// What each thread does
+  static void *doSubMip(void *bundle);
+  /// Illegal copy constructor
+  CbcSubMipQueue(const CbcSubMipQueue &);
+  /// Illegal assignment operator
+  CbcSubMipQueue &operator=(const CbcSubMipQueue &);
+
+private:
+  struct Bundle;
+  /// Model sub-MIPs came from
+  CbcModel *model_;
+  /// Sub-MIPs running (numberThreads)
+  Bundle *running_;
+  /// Sub-MIPs waiting for a thread
+  std::vector< Bundle > waiting_;
+  /// Threads
+  CbcThreadPool *pool_;
+  /// Cutoff of model when last polled (or -COIN_DBL_MAX to stop)
+  volatile double cutoff_;
+  int numberRunning_;
+};
 /** A class to encapsulate thread stuff */
 
 class CbcThread {
@@ -317,11 +666,91 @@ public:
   {
     return saveStuff_;
   }
+  /// Deepest node seen while using hotstart (kept in master thread)
+  inline int lastHotDepth() const
+  {
+    return master_->lastHotDepth_;
+  }
+  inline void setLastHotDepth(int value)
+  {
+    master_->lastHotDepth_ = value;
+  }
   /// Say if locked
   inline bool locked() const
   {
     return locked_;
   }
+  /// Get number of nodes done without going back to master
+  inline int numberNodesKept() const
+  {
+    return numberNodesKept_;
+  }
+  /// Increment number of nodes done without going back to master
+  inline void incrementNodesKept()
+  {
+    numberNodesKept_++;
+  }
+  /** Set threads to share cutoffs with at ticks in deterministic mode
+      (NULL to switch off) and say no tick done */
+  inline void setSiblings(CbcThread *siblings, int numberSiblings)
+  {
+    siblings_ = siblings;
+    numberSiblings_ = numberSiblings;
+    tick_ = -1;
+  }
+  /// Get last tick done in this deterministic round
+  inline int tick() const
+  {
+    return tick_;
+  }
+  /** Ticks up to \p tick done - publish cutoff and wait until all other
+      threads have published tick-1, then take best of their cutoffs at
+      tick-1.  As values at a tick never change once published the result
+      does not depend on timing.  Does nothing if no siblings. */
+  void synchronizeTick(int tick);
+  /// Get number of nodes merged into base model
+  inline int numberNodesDone() const
+  {
+    return numberNodesDone_;
+  }
+  /// Get number of iterations merged into base model
+  inline double numberIterationsDone() const
+  {
+    return numberIterationsDone_;
+  }
+  /// Get number of times merged into base model (moveToModel)
+  inline int numberMerges() const
+  {
+    return numberMerges_;
+  }
+  /// Get time spent merging into base model
+  inline double timeInMerge() const
+  {
+    return timeInMerge_;
+  }
+  /// Add in one merge into base model
+  inline void addMerge(int numberNodes, double numberIterations, double time)
+  {
+    numberNodesDone_ += numberNodes;
+    numberIterationsDone_ += numberIterations;
+    numberMerges_++;
+    timeInMerge_ += time;
+  }
+  /// Set processor thread is to be bound to (-1 none) - before setUsefulStuff
+  inline void setProcessor(int value)
+  {
+    processor_ = value;
+    setUp_ = (value < 0);
+  }
+  /// Whether thread has done setUpInThread
+  inline bool isSetUp() const
+  {
+    return setUp_;
+  }
+  /** Called by thread before it waits for first work.  If bound to a
+      processor, binds and makes solver again so its memory is on the
+      processor's memory node */
+  void setUpInThread();
 
 public: // private:
   CbcSpecificThread threadStuff_;
@@ -341,6 +770,7 @@ public: // private:
   int numberTimesWaitingToStart_;
   int saveStuff_[2];
   int dantzigState_; // 0 unset, -1 waiting to be set, 1 set
+  int lastHotDepth_; // deepest node with hotstart (used in master)
   bool locked_;
   int nDeleteNode_;
   CbcNode **delNode_;
@@ -348,6 +778,17 @@ public: // private:
   int nodesThisTime_;
   int iterationsThisTime_;
   int deterministic_;
+  int numberNodesKept_; // nodes done without going back to master
+  CbcThread *siblings_; // threads to share cutoffs with (deterministic)
+  int numberSiblings_;
+  volatile int tick_; // last tick published (-1 none)
+  volatile double tickCutoff_[CBC_DETERMINISTIC_TICKS]; // cutoff at each tick
+  int numberNodesDone_; // nodes merged into base model
+  double numberIterationsDone_; // iterations merged into base model
+  int numberMerges_;
+  double timeInMerge_; // time in moveToModel merging into base
+  int processor_; // processor to bind to (-1 none)
+  volatile bool setUp_; // true when setUpInThread done
 #ifdef THREAD_DEBUG
 public:
   int threadNumber_;
@@ -441,6 +882,18 @@ public:
   /// Sets Dantzig state in children
   void setDantzigState();
 
+  /** One log line per thread (CBC_THREAD_PROGRESS) with nodes,
+      iterations, idle time, locks and merges so far */
+  void logThreadStatistics() const;
+  /** Write same statistics as JSON (a "threads" array and totals).
+      Values are read without locking so may be slightly out of date */
+  void writeThreadStatistics(FILE *fp) const;
+  /// Fraction of time since start each thread has been busy
+  void threadBusy(double *busy) const;
+  /** Number of threads which may be given nodes now - from thread
+      quota of model and (CbcAdaptiveThreads) time waiting for lock */
+  int activeThreads(CbcModel *baseModel);
+
 private:
   /// Number of children
   int numberThreads_;
@@ -457,6 +910,16 @@ private:
   int threadStats_[6];
   int defaultParallelIterations_;
   int defaultParallelNodes_;
+  /// Time threads were started (for idle fraction)
+  double startTime_;
+  /// Threads which may be given nodes (before quota)
+  int numberActive_;
+  /// Number given out last time (for message when it changes)
+  int lastActive_;
+  /// When number active was last looked at
+  double lastAdjustTime_;
+  /// Total time waiting for lock then
+  double lastWaiting_;
 };
 #else
 // Dummy threads
@@ -478,6 +941,23 @@ public:
 
   virtual ~CbcBaseModel() {}
 };
+/** Thread pool - never created without threads (CbcModel::threadPool
+    returns NULL) so just enough for code using it to compile */
+
+class CbcThreadPool {
+public:
+  inline int numberThreads() const
+  {
+    return 0;
+  }
+  inline void run(void *(*)(void *), int, void *, int) {}
+  inline void start(void *(*)(void *), int, void *, int) {}
+  inline void wait() {}
+  inline bool finished()
+  {
+    return true;
+  }
+};
 #endif
 
 #endif
@@ -8,8 +8,12 @@
 #include "CbcThread.hpp"
 #include "CbcCountRowCut.hpp"
 #include "CbcCompareActual.hpp"
+#include "CbcCompareObjective.hpp"
+#include "CbcCompareEstimate.hpp"
 #include "CbcBranchActual.hpp"
 
+#include <typeinfo>
+
 #if CBC_DEBUG_HEAP > 0
 
 namespace {
@@ -144,6 +148,7 @@ CbcTree::CbcTree()
   maximumBranching_ = 0;
   branched_ = NULL;
   newBound_ = NULL;
+  boundsDirty_ = false;
 }
 CbcTree::~CbcTree()
 {
@@ -154,6 +159,8 @@ CbcTree::~CbcTree()
 CbcTree::CbcTree(const CbcTree &rhs)
 {
   nodes_ = rhs.nodes_;
+  bounds_ = rhs.bounds_;
+  boundsDirty_ = rhs.boundsDirty_;
   maximumNodeNumber_ = rhs.maximumNodeNumber_;
   numberBranching_ = rhs.numberBranching_;
   maximumBranching_ = rhs.maximumBranching_;
@@ -171,6 +178,8 @@ CbcTree::operator=(const CbcTree &rhs)
 {
   if (this != &rhs) {
     nodes_ = rhs.nodes_;
+    bounds_ = rhs.bounds_;
+    boundsDirty_ = rhs.boundsDirty_;
     maximumNodeNumber_ = rhs.maximumNodeNumber_;
     delete[] branched_;
     delete[] newBound_;
@@ -219,7 +228,6 @@ void CbcTree::addBranchingInformation(const CbcModel *model, const CbcNodeInfo *
     assert(currentUpper[iColumn] == up[1]);
     if (dynamic_cast< const CbcPartialNodeInfo * >(nodeInfo)) {
       const CbcPartialNodeInfo *info = dynamic_cast< const CbcPartialNodeInfo * >(nodeInfo);
-      const double *newBounds = info->newBounds();
       const int *variables = info->variables();
       int numberChanged = info->numberChangedBounds();
       for (int i = 0; i < numberChanged; i++) {
@@ -228,7 +236,7 @@ void CbcTree::addBranchingInformation(const CbcModel *model, const CbcNodeInfo *
         if (iColumn == kColumn) {
           jColumn |= 0x40000000;
 #ifndef NDEBUG
-          double value = newBounds[i];
+          double value = info->newBound(i);
           if ((jColumn & 0x80000000) == 0) {
             assert(value == up[0]);
           } else {
@@ -238,7 +246,7 @@ void CbcTree::addBranchingInformation(const CbcModel *model, const CbcNodeInfo *
         }
         if (numberBranching_ == maximumBranching_)
           increaseSpace();
-        newBound_[numberBranching_] = static_cast< int >(newBounds[i]);
+        newBound_[numberBranching_] = static_cast< int >(info->newBound(i));
         branched_[numberBranching_++] = jColumn;
       }
     } else {
@@ -374,6 +382,7 @@ void CbcTree::push(CbcNode *x)
   x->setOnTree(true);
   nodes_.push_back(x);
   std::push_heap(nodes_.begin(), nodes_.end(), comparison_);
+  addBound(x);
 #if CBC_DEBUG_HEAP > 0
   validateHeap();
 #endif
@@ -399,6 +408,7 @@ void CbcTree::pop()
   validateHeap();
 #endif
   nodes_.front()->setOnTree(false);
+  removeBound(nodes_.front());
   std::pop_heap(nodes_.begin(), nodes_.end(), comparison_);
   nodes_.pop_back();
 
@@ -510,6 +520,7 @@ CbcTree::bestNode(double cutoff)
       << ", refd by " << info->numberPointingToThis() << "." << std::endl;
 #endif
     // take off
+    removeBound(best);
     std::pop_heap(nodes_.begin(), nodes_.end(), comparison_);
     nodes_.pop_back();
   }
@@ -578,10 +589,180 @@ void CbcTree::cleanTree(CbcModel *model, double cutoff, double &bestPossibleObje
 #if CBC_DEBUG_HEAP > 0
   validateHeap();
 #endif
+  deleteNodes(model, cutoff, nodeArray + kDelete, depth + kDelete, nNodes - kDelete);
+  delete[] nodeArray;
+  delete[] depth;
+  adjustForThreads(model, bestPossibleObjective);
+}
+
+// Allow for nodes which are being worked on by threads and so are not on tree
+void CbcTree::adjustForThreads(CbcModel *model, double &bestPossibleObjective)
+{
+#ifdef CBC_THREAD
+  if (model->parallelMode() > 0 && model->master()) {
+    // need to adjust for ones not on tree
+    CbcBaseModel *master = model->master();
+    int numberThreads = master->numberThreads();
+    for (int i = 0; i < numberThreads; i++) {
+      CbcThread *child = master->child(i);
+      if (child->node()) {
+        double value = child->node()->objectiveValue();
+        // adjust
+        bestPossibleObjective = CoinMin(bestPossibleObjective, value);
+      }
+    }
+  }
+#endif
+}
+
+// Nodes deleted at once before bases of paths are made on threads
+#define CBC_BULK_DELETE 100
+/*
+  Cuts on path of node as addCuts1 collects them (and basis for node if
+  basis given) but nothing is done to solver or model.  Only node
+  information is read so nodes can be done on threads once deferred basis
+  diffs have been made.  Returns false if basis went away.
+*/
+static bool collectNodeCuts(CbcModel *model, CbcNode *node,
+  std::vector< CbcNodeInfo * > &walkback, CoinWarmStartBasis *&basis,
+  std::vector< CbcCountRowCut * > &cuts)
+{
+  walkback.clear();
+  int numberCuts = 0;
+  CbcNodeInfo *nodeInfo = node->nodeInfo();
+  while (nodeInfo) {
+    walkback.push_back(nodeInfo);
+    numberCuts += nodeInfo->numberCuts();
+    nodeInfo = nodeInfo->parent();
+  }
+  cuts.resize(numberCuts);
+  CbcCountRowCut **addedCuts = numberCuts ? &cuts[0] : NULL;
+  bool wantBasis = basis != NULL;
+  if (basis)
+    basis->setSize(model->getNumCols(), model->numberRowsAtContinuous() + numberCuts);
+  int nNode = static_cast< int >(walkback.size());
+  // above a checkpoint only cuts are needed
+  int nFull = nNode;
+  for (int i = 0; i < nNode - 1; i++) {
+    if (walkback[i]->allActivated() && dynamic_cast< CbcFullNodeInfo * >(walkback[i])) {
+      nFull = i + 1;
+      break;
+    }
+  }
+  numberCuts = 0;
+  while (nNode > nFull) {
+    --nNode;
+    walkback[nNode]->applyCutsToList(addedCuts, numberCuts);
+  }
+  while (nNode) {
+    --nNode;
+    walkback[nNode]->applyBasisAndCuts(model, basis, addedCuts, numberCuts);
+  }
+  cuts.resize(numberCuts);
+  return basis != NULL || !wantBasis;
+}
+/* Nodes of a block of bulk deletion.  For each node the number of cuts
+   on its path (-1 if not done) and whether each is not basic */
+typedef struct {
+  CbcModel *model;
+  CbcNode **nodes;
+  int numberNodes;
+  CoinWarmStartBasis *basis;
+  int *numberCuts;
+  std::vector< char > tight;
+} CbcDeleteBlock;
+
+static void *doDeleteBlock(void *voidInfo)
+{
+  CbcDeleteBlock *info = reinterpret_cast< CbcDeleteBlock * >(voidInfo);
+  CbcModel *model = info->model;
+  int numberRowsAtContinuous = model->numberRowsAtContinuous();
+  std::vector< CbcNodeInfo * > walkback;
+  std::vector< CbcCountRowCut * > cuts;
+  info->tight.clear();
+  for (int j = 0; j < info->numberNodes; j++)
+    info->numberCuts[j] = -1;
+  if (!info->basis)
+    return NULL;
+  for (int j = 0; j < info->numberNodes; j++) {
+    if (!collectNodeCuts(model, info->nodes[j], walkback, info->basis, cuts))
+      break; // rest done as before
+    int numberCuts = static_cast< int >(cuts.size());
+    info->numberCuts[j] = numberCuts;
+    for (int i = 0; i < numberCuts; i++) {
+      CoinWarmStartBasis::Status status = info->basis->getArtifStatus(i + numberRowsAtContinuous);
+      info->tight.push_back(status != CoinWarmStartBasis::basic ? 1 : 0);
+    }
+  }
+  return NULL;
+}
+
+/*
+  Delete nodes which have been taken off the heap. Nodes are processed from
+  deepest to shallowest so that cut reference counts are decremented before
+  the parent node information goes away. depth is used as workspace and
+  nodeArray is sorted on exit.
+
+  When many nodes go at once (a better cutoff) the bases of their paths,
+  which say which cuts they hold, are made first - on threads if model
+  has them - and then cut counts are decremented and nodes deleted in
+  order.  Nodes not done that way (basis went away or cuts on path have
+  changed) are done as below.
+*/
+void CbcTree::deleteNodes(CbcModel *model, double cutoff, CbcNode **nodeArray,
+  int *depth, int numberDelete)
+{
   /*
       Sort the list of nodes to be deleted, nondecreasing.
     */
-  CoinSort_2(depth + kDelete, depth + nNodes, nodeArray + kDelete);
+  CoinSort_2(depth, depth + numberDelete, nodeArray);
+  std::vector< CbcNodeInfo * > walkback;
+  std::vector< CbcCountRowCut * > cuts;
+  int numberBlocks = 0;
+  int blockSize = numberDelete;
+  CbcDeleteBlock *blocks = NULL;
+  int *numberCutsOfNode = NULL;
+  if (cutoff != -COIN_DBL_MAX && numberDelete >= CBC_BULK_DELETE
+    && model->parallelMode() >= 0) {
+    int numberThreads = model->getNumberThreads();
+    CbcThreadPool *pool = (numberThreads > 0 && !model->parentModel())
+      ? model->threadPool(numberThreads) : NULL;
+    numberBlocks = pool ? CoinMin(numberThreads, numberDelete / CBC_BULK_DELETE + 1) : 1;
+    blockSize = (numberDelete + numberBlocks - 1) / numberBlocks;
+    numberBlocks = (numberDelete + blockSize - 1) / blockSize;
+    // make deferred basis diffs first as paths share node information
+    for (int j = 0; j < numberDelete; j++) {
+      CbcNodeInfo *nodeInfo = nodeArray[j]->nodeInfo();
+      while (nodeInfo) {
+        const CbcPartialNodeInfo *partial = dynamic_cast< const CbcPartialNodeInfo * >(nodeInfo);
+        if (!partial) {
+          if (nodeInfo->allActivated())
+            break; // full node info - basis starts here
+        } else if (partial->basisDiffDeferred()) {
+          partial->basisDiff();
+        }
+        nodeInfo = nodeInfo->parent();
+      }
+    }
+    blocks = new CbcDeleteBlock[numberBlocks];
+    numberCutsOfNode = new int[numberDelete];
+    for (int i = 0; i < numberBlocks; i++) {
+      int first = i * blockSize;
+      blocks[i].model = model;
+      blocks[i].nodes = nodeArray + first;
+      blocks[i].numberNodes = CoinMin(blockSize, numberDelete - first);
+      blocks[i].basis = model->getEmptyBasis();
+      blocks[i].numberCuts = numberCutsOfNode + first;
+    }
+    if (pool && numberBlocks > 1)
+      pool->run(doDeleteBlock, numberBlocks, blocks, static_cast< int >(sizeof(CbcDeleteBlock)));
+    else
+      for (int i = 0; i < numberBlocks; i++)
+        doDeleteBlock(blocks + i);
+  }
+  std::vector< int > tightStart(numberBlocks, 0);
+  for (int i = 0; i < numberBlocks; i++)
+    tightStart[i] = static_cast< int >(blocks[i].tight.size());
   /*
       Work back from deepest to shallowest. In spite of the name, addCuts1 is
       just a preparatory step. When it returns, the following will be true:
@@ -605,36 +786,56 @@ void CbcTree::cleanTree(CbcModel *model, double cutoff, double &bestPossibleObje
       doing more work than needed, modifying the model to match a subproblem
       at a node that will be discarded.  Then again, we seem to need the basis.
     */
-  for (j = nNodes - 1; j >= kDelete; j--) {
+  for (int j = numberDelete - 1; j >= 0; j--) {
     CbcNode *node = nodeArray[j];
-    CoinWarmStartBasis *lastws = (cutoff != -COIN_DBL_MAX) ? model->getEmptyBasis() : NULL;
-
-    model->addCuts1(node, lastws);
-    // Decrement cut counts
     assert(node);
-    //assert (node->nodeInfo());
     int numberLeft = (node->nodeInfo()) ? node->nodeInfo()->numberBranchesLeft() : 0;
-    if (cutoff != -COIN_DBL_MAX) {
-      // normal
-      for (int i = 0; i < model->currentNumberCuts(); i++) {
-        // take off node
-        CoinWarmStartBasis::Status status = lastws->getArtifStatus(i + model->numberRowsAtContinuous());
-        if (status != CoinWarmStartBasis::basic && model->addedCuts()[i]) {
-          if (!model->addedCuts()[i]->decrement(numberLeft))
-            delete model->addedCuts()[i];
+    bool done = false;
+    if (numberCutsOfNode && numberCutsOfNode[j] >= 0) {
+      // basis made in bulk - cuts now (some may have gone)
+      int iBlock = j / blockSize;
+      tightStart[iBlock] -= numberCutsOfNode[j];
+      CoinWarmStartBasis *noBasis = NULL;
+      collectNodeCuts(model, node, walkback, noBasis, cuts);
+      if (static_cast< int >(cuts.size()) == numberCutsOfNode[j]) {
+        const char *tight = numberCutsOfNode[j] ? &blocks[iBlock].tight[tightStart[iBlock]] : NULL;
+        for (int i = 0; i < numberCutsOfNode[j]; i++) {
+          if (tight[i] && cuts[i]) {
+            if (!cuts[i]->decrement(numberLeft))
+              delete cuts[i];
+          }
         }
+        done = true;
       }
-    } else {
-      // quick
-      for (int i = 0; i < model->currentNumberCuts(); i++) {
-        // take off node
-        if (model->addedCuts()[i]) {
-          if (model->parallelMode() != 1 || true) {
+    }
+    if (!done) {
+      CoinWarmStartBasis *lastws = (cutoff != -COIN_DBL_MAX) ? model->getEmptyBasis() : NULL;
+
+      model->addCuts1(node, lastws);
+      // Decrement cut counts
+      if (cutoff != -COIN_DBL_MAX) {
+        // normal
+        for (int i = 0; i < model->currentNumberCuts(); i++) {
+          // take off node
+          CoinWarmStartBasis::Status status = lastws->getArtifStatus(i + model->numberRowsAtContinuous());
+          if (status != CoinWarmStartBasis::basic && model->addedCuts()[i]) {
             if (!model->addedCuts()[i]->decrement(numberLeft))
               delete model->addedCuts()[i];
           }
         }
+      } else {
+        // quick
+        for (int i = 0; i < model->currentNumberCuts(); i++) {
+          // take off node
+          if (model->addedCuts()[i]) {
+            if (model->parallelMode() != 1 || true) {
+              if (!model->addedCuts()[i]->decrement(numberLeft))
+                delete model->addedCuts()[i];
+            }
+          }
+        }
       }
+      delete lastws;
     }
 #ifdef CBC_THREAD
     if (model->parallelMode() > 0 && model->master()) {
@@ -651,25 +852,43 @@ void CbcTree::cleanTree(CbcModel *model, double cutoff, double &bestPossibleObje
     if (node->nodeInfo())
       node->nodeInfo()->throwAway();
     model->deleteNode(node);
-    delete lastws;
   }
-  delete[] nodeArray;
-  delete[] depth;
-#ifdef CBC_THREAD
-  if (model->parallelMode() > 0 && model->master()) {
-    // need to adjust for ones not on tree
-    CbcBaseModel *master = model->master();
-    int numberThreads = master->numberThreads();
-    for (int i = 0; i < numberThreads; i++) {
-      CbcThread *child = master->child(i);
-      if (child->node()) {
-        double value = child->node()->objectiveValue();
-        // adjust
-        bestPossibleObjective = CoinMin(bestPossibleObjective, value);
-      }
+  for (int i = 0; i < numberBlocks; i++)
+    delete blocks[i].basis;
+  delete[] blocks;
+  delete[] numberCutsOfNode;
+}
+
+// Take given nodes off tree and delete them
+void CbcTree::removeNodes(CbcModel *model, CbcNode **which, int numberRemove)
+{
+  if (!numberRemove)
+    return;
+  std::vector< CbcNode * > remove(which, which + numberRemove);
+  std::sort(remove.begin(), remove.end());
+  int nNodes = size();
+  CbcNode **nodeArray = new CbcNode *[nNodes];
+  int *depth = new int[nNodes];
+  int k = 0;
+  int kDelete = nNodes;
+  for (int j = 0; j < nNodes; j++) {
+    CbcNode *node = top();
+    pop();
+    if (!node)
+      continue;
+    if (std::binary_search(remove.begin(), remove.end(), node)) {
+      nodeArray[--kDelete] = node;
+      depth[kDelete] = node->depth();
+    } else {
+      nodeArray[k++] = node;
     }
   }
-#endif
+  for (int j = 0; j < k; j++) {
+    push(nodeArray[j]);
+  }
+  deleteNodes(model, model->getCutoff(), nodeArray + kDelete, depth + kDelete, nNodes - kDelete);
+  delete[] nodeArray;
+  delete[] depth;
 }
 
 // Return the best node of the heap using alternate criterion
@@ -689,6 +908,445 @@ CbcTree::bestAlternate()
   return best;
 }
 
+CbcTreeDHeap::CbcTreeDHeap()
+  : CbcTree()
+  , keyType_(0)
+  , numberDead_(0)
+  , cutoff_(COIN_DBL_MAX)
+  , model_(NULL)
+{
+}
+CbcTreeDHeap::~CbcTreeDHeap()
+{
+}
+// Copy constructor
+CbcTreeDHeap::CbcTreeDHeap(const CbcTreeDHeap &rhs)
+  : CbcTree(rhs)
+  , keys_(rhs.keys_)
+  , keyType_(rhs.keyType_)
+  , numberDead_(rhs.numberDead_)
+  , cutoff_(rhs.cutoff_)
+  , model_(rhs.model_)
+{
+  // keys may tie so comparison object is needed as well
+  comparison_ = rhs.comparison_;
+}
+// Assignment operator
+CbcTreeDHeap &
+CbcTreeDHeap::operator=(const CbcTreeDHeap &rhs)
+{
+  if (this != &rhs) {
+    CbcTree::operator=(rhs);
+    keys_ = rhs.keys_;
+    keyType_ = rhs.keyType_;
+    numberDead_ = rhs.numberDead_;
+    cutoff_ = rhs.cutoff_;
+    model_ = rhs.model_;
+    comparison_ = rhs.comparison_;
+  }
+  return *this;
+}
+// Clone
+CbcTree *
+CbcTreeDHeap::clone() const
+{
+  return new CbcTreeDHeap(*this);
+}
+// Create C++ lines to get to current state
+void CbcTreeDHeap::generateCpp(FILE *fp)
+{
+  fprintf(fp, "0#include \"CbcTree.hpp\"\n");
+  fprintf(fp, "5  CbcTreeDHeap heapTree;\n");
+  fprintf(fp, "5  cbcModel->passInTreeHandler(heapTree);\n");
+}
+// Fill in key for a node
+void CbcTreeDHeap::fillKey(CbcTreeDHeapKey &key, const CbcNode *node)
+{
+  key.objective = node->objectiveValue();
+  key.estimate = node->guessedObjectiveValue();
+  key.depth = node->depth();
+  key.numberUnsatisfied = node->numberUnsatisfied();
+}
+// Move entry up
+void CbcTreeDHeap::siftUp(int i)
+{
+  while (i > 0) {
+    int parent = (i - 1) / arity;
+    if (!better(parent, i))
+      break;
+    swapEntries(parent, i);
+    i = parent;
+  }
+}
+// Move entry down
+void CbcTreeDHeap::siftDown(int i)
+{
+  int n = static_cast< int >(nodes_.size());
+  while (true) {
+    int first = arity * i + 1;
+    if (first >= n)
+      break;
+    int last = CoinMin(first + arity, n);
+    int best = first;
+    for (int j = first + 1; j < last; j++) {
+      if (better(best, j))
+        best = j;
+    }
+    if (!better(i, best))
+      break;
+    swapEntries(i, best);
+    i = best;
+  }
+}
+// Remove top entry
+void CbcTreeDHeap::removeTop()
+{
+  int last = static_cast< int >(nodes_.size()) - 1;
+  if (last > 0) {
+    nodes_[0] = nodes_[last];
+    keys_[0] = keys_[last];
+  }
+  nodes_.pop_back();
+  keys_.pop_back();
+  if (last > 1)
+    siftDown(0);
+}
+/*
+  Rebuild the heap. The comparison object may have changed so decide
+  whether the inline keys can be used and refresh them from the nodes.
+*/
+void CbcTreeDHeap::rebuild()
+{
+  CbcCompareBase *test = comparison_.comparisonObject();
+  keyType_ = 0;
+  if (test) {
+    if (typeid(*test) == typeid(CbcCompareObjective))
+      keyType_ = 1;
+    else if (typeid(*test) == typeid(CbcCompareDepth))
+      keyType_ = 2;
+    else if (typeid(*test) == typeid(CbcCompareEstimate))
+      keyType_ = 3;
+  }
+  int n = static_cast< int >(nodes_.size());
+  keys_.resize(n);
+  numberDead_ = 0;
+  for (int i = 0; i < n; i++) {
+    fillKey(keys_[i], nodes_[i]);
+    if (keys_[i].objective >= cutoff_)
+      numberDead_++;
+  }
+  if (test) {
+    for (int i = (n - 2) / arity; i >= 0; i--)
+      siftDown(i);
+  }
+}
+
+// Return the top node of the heap
+CbcNode *
+CbcTreeDHeap::top() const
+{
+  return nodes_.front();
+}
+
+// Add a node to the heap
+void CbcTreeDHeap::push(CbcNode *x)
+{
+  x->setNodeNumber(maximumNodeNumber_);
+  lastObjective_ = x->objectiveValue();
+  lastDepth_ = x->depth();
+  lastUnsatisfied_ = x->numberUnsatisfied();
+  maximumNodeNumber_++;
+  x->setOnTree(true);
+  CbcTreeDHeapKey key;
+  fillKey(key, x);
+  if (key.objective >= cutoff_)
+    numberDead_++;
+  nodes_.push_back(x);
+  keys_.push_back(key);
+  siftUp(static_cast< int >(nodes_.size()) - 1);
+}
+
+// Remove the top node from the heap
+void CbcTreeDHeap::pop()
+{
+  nodes_.front()->setOnTree(false);
+  if (keys_.front().objective >= cutoff_)
+    numberDead_--;
+  removeTop();
+}
+
+/*
+  Return the best node from the heap. Nodes which were left on the heap
+  by cleanTree and are still cut off are deleted here.
+*/
+CbcNode *
+CbcTreeDHeap::bestNode(double cutoff)
+{
+  while (!nodes_.empty()) {
+    CbcNode *best = nodes_.front();
+    assert(best && best->nodeInfo());
+    bool dead = keys_.front().objective >= cutoff_;
+    if (dead)
+      numberDead_--;
+    best->setOnTree(false);
+    removeTop();
+    if (dead && model_ && best->checkIsCutoff(cutoff_) >= cutoff_) {
+      int depth = best->depth();
+      deleteNodes(model_, cutoff_, &best, &depth, 1);
+      continue;
+    }
+    if (best->objectiveValue() >= cutoff) {
+      // double check in case node can change its mind!
+      best->checkIsCutoff(cutoff);
+    }
+    return best;
+  }
+  return NULL;
+}
+
+/*
+  Take dead nodes off the heap, heapify what is left and delete the
+  dead ones.
+*/
+void CbcTreeDHeap::compact()
+{
+  int n = static_cast< int >(nodes_.size());
+  CbcNode **nodeArray = new CbcNode *[n];
+  int *depth = new int[n];
+  int numberDelete = 0;
+  int k = 0;
+  for (int i = 0; i < n; i++) {
+    CbcNode *node = nodes_[i];
+    double value = keys_[i].objective;
+    if (value >= cutoff_)
+      value = node->checkIsCutoff(cutoff_);
+    if (value >= cutoff_ || !node->active()) {
+      if (cutoff_ < -1.0e30)
+        node->nodeInfo()->deactivate(7);
+      node->setOnTree(false);
+      nodeArray[numberDelete] = node;
+      depth[numberDelete++] = node->depth();
+    } else {
+      nodes_[k] = node;
+      keys_[k] = keys_[i];
+      keys_[k++].objective = value;
+    }
+  }
+  nodes_.resize(k);
+  keys_.resize(k);
+  numberDead_ = 0;
+  for (int i = (k - 2) / arity; i >= 0; i--)
+    siftDown(i);
+  deleteNodes(model_, cutoff_, nodeArray, depth, numberDelete);
+  delete[] nodeArray;
+  delete[] depth;
+}
+
+/*
+  Prune the tree using an objective function cutoff. Unless a large part
+  of the heap is dead (or everything is to go) nodes are just counted
+  and left for bestNode to get rid of.
+*/
+void CbcTreeDHeap::cleanTree(CbcModel *model, double cutoff, double &bestPossibleObjective)
+{
+  model_ = model;
+  cutoff_ = cutoff;
+  int n = static_cast< int >(nodes_.size());
+  numberDead_ = 0;
+  bestPossibleObjective = 1.0e100;
+  for (int i = 0; i < n; i++) {
+    double value = keys_[i].objective;
+    if (value >= cutoff)
+      numberDead_++;
+    else
+      bestPossibleObjective = CoinMin(bestPossibleObjective, value);
+  }
+  if (cutoff < -1.0e30 || 4 * numberDead_ > n)
+    compact();
+  if (cutoff < -1.0e30)
+    cutoff_ = COIN_DBL_MAX;
+  adjustForThreads(model, bestPossibleObjective);
+}
+
+// Get best possible objective function in the tree (ignoring dead nodes)
+double
+CbcTreeDHeap::getBestPossibleObjective()
+{
+  double r_val = 1e100;
+  int n = static_cast< int >(keys_.size());
+  for (int i = 0; i < n; i++) {
+    double value = keys_[i].objective;
+    if (value < r_val && value < cutoff_)
+      r_val = value;
+  }
+  return r_val;
+}
+
+CbcTreeBucket::CbcTreeBucket(int numberBuckets)
+  : CbcTreeDHeap()
+  , origin_(0.0)
+  , width_(0.0)
+  , numberBuckets_(CoinMax(numberBuckets, 2))
+  , lowest_(0)
+{
+}
+CbcTreeBucket::~CbcTreeBucket()
+{
+}
+// Copy constructor
+CbcTreeBucket::CbcTreeBucket(const CbcTreeBucket &rhs)
+  : CbcTreeDHeap(rhs)
+  , count_(rhs.count_)
+  , lower_(rhs.lower_)
+  , origin_(rhs.origin_)
+  , width_(rhs.width_)
+  , numberBuckets_(rhs.numberBuckets_)
+  , lowest_(rhs.lowest_)
+{
+}
+// Assignment operator
+CbcTreeBucket &
+CbcTreeBucket::operator=(const CbcTreeBucket &rhs)
+{
+  if (this != &rhs) {
+    CbcTreeDHeap::operator=(rhs);
+    count_ = rhs.count_;
+    lower_ = rhs.lower_;
+    origin_ = rhs.origin_;
+    width_ = rhs.width_;
+    numberBuckets_ = rhs.numberBuckets_;
+    lowest_ = rhs.lowest_;
+  }
+  return *this;
+}
+// Clone
+CbcTree *
+CbcTreeBucket::clone() const
+{
+  return new CbcTreeBucket(*this);
+}
+// Create C++ lines to get to current state
+void CbcTreeBucket::generateCpp(FILE *fp)
+{
+  fprintf(fp, "0#include \"CbcTree.hpp\"\n");
+  fprintf(fp, "5  CbcTreeBucket bucketTree(%d);\n", numberBuckets_);
+  fprintf(fp, "5  cbcModel->passInTreeHandler(bucketTree);\n");
+}
+/*
+  Choose bucket width so that the buckets cover the range from the best
+  node to the cutoff and put all nodes in their buckets.
+*/
+void CbcTreeBucket::rebucket()
+{
+  int n = static_cast< int >(keys_.size());
+  if (cutoff_ >= 1.0e50 || cutoff_ < -1.0e30) {
+    width_ = 0.0;
+    return;
+  }
+  double best = cutoff_;
+  for (int i = 0; i < n; i++)
+    best = CoinMin(best, keys_[i].objective);
+  origin_ = best;
+  width_ = CoinMax((cutoff_ - origin_) / (numberBuckets_ - 1),
+    1.0e-9 * (1.0 + fabs(cutoff_)));
+  count_.assign(numberBuckets_, 0);
+  lower_.assign(numberBuckets_, COIN_DBL_MAX);
+  lowest_ = numberBuckets_;
+  for (int i = 0; i < n; i++) {
+    double value = keys_[i].objective;
+    int iBucket = bucket(value);
+    count_[iBucket]++;
+    lower_[iBucket] = CoinMin(lower_[iBucket], value);
+    lowest_ = CoinMin(lowest_, iBucket);
+  }
+}
+// Add a node to the heap
+void CbcTreeBucket::push(CbcNode *x)
+{
+  CbcTreeDHeap::push(x);
+  if (width_) {
+    double value = x->objectiveValue();
+    int iBucket = bucket(value);
+    count_[iBucket]++;
+    lower_[iBucket] = CoinMin(lower_[iBucket], value);
+    lowest_ = CoinMin(lowest_, iBucket);
+  }
+}
+// Remove top entry
+void CbcTreeBucket::removeTop()
+{
+  if (width_) {
+    int iBucket = bucket(keys_.front().objective);
+    assert(count_[iBucket] > 0);
+    if (!--count_[iBucket]) {
+      lower_[iBucket] = COIN_DBL_MAX;
+      while (lowest_ < numberBuckets_ && !count_[lowest_])
+        lowest_++;
+    }
+  }
+  CbcTreeDHeap::removeTop();
+}
+// Take dead nodes off heap and delete them
+void CbcTreeBucket::compact()
+{
+  CbcTreeDHeap::compact();
+  rebucket();
+}
+// Rebuild the heap (refreshes keys and buckets)
+void CbcTreeBucket::rebuild()
+{
+  CbcTreeDHeap::rebuild();
+  rebucket();
+}
+/*
+  Prune the tree using an objective function cutoff. All buckets from
+  the one containing the cutoff upward are counted as dead without
+  looking at the nodes.
+*/
+void CbcTreeBucket::cleanTree(CbcModel *model, double cutoff, double &bestPossibleObjective)
+{
+  model_ = model;
+  cutoff_ = cutoff;
+  int n = static_cast< int >(nodes_.size());
+  if (cutoff < -1.0e30) {
+    compact();
+    cutoff_ = COIN_DBL_MAX;
+    width_ = 0.0;
+    bestPossibleObjective = 1.0e100;
+  } else {
+    if (!width_) {
+      rebucket();
+    } else if (cutoff < 1.0e50 && bucket(cutoff) < numberBuckets_ / 8) {
+      // range has shrunk a lot - spread out again
+      rebucket();
+    }
+    if (width_) {
+      numberDead_ = 0;
+      for (int i = bucket(cutoff); i < numberBuckets_; i++)
+        numberDead_ += count_[i];
+    } else {
+      numberDead_ = 0;
+    }
+    if (4 * numberDead_ > n)
+      compact();
+    bestPossibleObjective = getBestPossibleObjective();
+  }
+  adjustForThreads(model, bestPossibleObjective);
+}
+// Get best possible objective function in the tree
+double
+CbcTreeBucket::getBestPossibleObjective()
+{
+  if (!width_)
+    return CbcTreeDHeap::getBestPossibleObjective();
+  int last = bucket(cutoff_);
+  for (int i = lowest_; i <= last; i++) {
+    if (count_[i] && lower_[i] < cutoff_)
+      return lower_[i];
+  }
+  return 1e100;
+}
+
 #ifdef JJF_ZERO // not used, reference removed in CbcModel.cpp
 CbcTreeArray::CbcTreeArray()
   : CbcTree()
@@ -1450,16 +2108,39 @@ void CbcTree::realpush(CbcNode *node)
 }
 #endif
 
+// Add objective of node to bounds
+void CbcTree::addBound(const CbcNode *node)
+{
+  bounds_.insert(node->objectiveValue());
+}
+// Take objective of node out of bounds
+void CbcTree::removeBound(const CbcNode *node)
+{
+  std::multiset< double >::iterator it = bounds_.find(node->objectiveValue());
+  if (it != bounds_.end())
+    bounds_.erase(it);
+  else
+    boundsDirty_ = true;
+}
+/*
+  Best objective over nodes on heap. If the multiset can't be trusted
+  (a node changed its objective while on the heap or a derived class
+  changed nodes_ directly) it is rebuilt from the heap.
+*/
 double
 CbcTree::getBestPossibleObjective()
 {
-  double r_val = 1e100;
-  for (int i = 0; i < static_cast< int >(nodes_.size()); i++) {
-    if (nodes_[i] && nodes_[i]->objectiveValue() < r_val) {
-      r_val = nodes_[i]->objectiveValue();
+  if (boundsDirty_ || bounds_.size() != nodes_.size()) {
+    bounds_.clear();
+    for (int i = 0; i < static_cast< int >(nodes_.size()); i++) {
+      if (nodes_[i])
+        bounds_.insert(nodes_[i]->objectiveValue());
     }
+    boundsDirty_ = false;
   }
-  return r_val;
+  if (bounds_.empty() || *bounds_.begin() >= 1e100)
+    return 1e100;
+  return *bounds_.begin();
 }
 
 /* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
@@ -6,6 +6,7 @@
 #define CbcTree_H
 
 #include <vector>
+#include <set>
 #include <algorithm>
 #include <cmath>
 
@@ -127,13 +128,26 @@ public:
     */
   virtual void cleanTree(CbcModel *model, double cutoff, double &bestPossibleObjective);
 
+  /*! \brief Take given nodes off the tree and delete them
+
+      As cleanTree but nodes are chosen by caller (e.g. symmetric copies
+      of other nodes) rather than by cutoff.
+    */
+  void removeNodes(CbcModel *model, CbcNode **which, int numberRemove);
+
   /// Get best on list using alternate method
   CbcNode *bestAlternate();
 
   /// We may have got an intelligent tree so give it one more chance
   virtual void endSearch() {}
 
-  /// Get best possible objective function in the tree
+  /*! \brief Get best possible objective function in the tree
+
+      The objective values of nodes on the heap are kept in a multiset
+      as nodes are pushed and popped, so this is normally just a look at
+      the smallest entry.  If nodes have been added or removed behind the
+      tree's back, or a node changed its objective, the set is rebuilt.
+    */
   virtual double getBestPossibleObjective();
 
   /// Reset maximum node number
@@ -191,6 +205,23 @@ public:
   //@}
 #endif
 
+protected:
+  /*! \brief Delete nodes which are no longer on the heap
+
+      Decrements cut reference counts and releases node information,
+      deepest nodes first. \p depth is workspace of size \p numberDelete.
+      When many go at once which cuts each holds is found first for all
+      (on threads of model if it has them) without changing solver.
+    */
+  void deleteNodes(CbcModel *model, double cutoff, CbcNode **nodeArray,
+    int *depth, int numberDelete);
+  /// Allow for nodes held by threads when computing best possible objective
+  void adjustForThreads(CbcModel *model, double &bestPossibleObjective);
+  /// Add objective of node to bounds
+  void addBound(const CbcNode *node);
+  /// Take objective of node out of bounds
+  void removeBound(const CbcNode *node);
+
 protected:
   /// Storage vector for the heap
   std::vector< CbcNode * > nodes_;
@@ -215,6 +246,253 @@ protected:
   unsigned int *branched_;
   /// New bound
   int *newBound_;
+  /// Objective values of nodes on heap
+  std::multiset< double > bounds_;
+  /// True if bounds_ may not match nodes on heap
+  bool boundsDirty_;
+};
+
+/*! \brief Key held inline in CbcTreeDHeap
+
+    Copy of the node data used by the simple comparison objects so that
+    sift operations do not have to touch the nodes themselves.
+*/
+struct CbcTreeDHeapKey {
+  /// Objective value of node
+  double objective;
+  /// Guessed objective value of node
+  double estimate;
+  /// Depth of node
+  int depth;
+  /// Number of unsatisfied objects
+  int numberUnsatisfied;
+};
+
+/*! \class CbcTreeDHeap
+    \brief Implementation of the live set as a 4-ary heap.
+
+    Same interface as CbcTree but the heap has four children per parent,
+    which halves the depth of the heap and keeps siblings in one cache
+    line.  A copy of each node's objective, estimate and depth is kept
+    inline so that CbcCompareObjective, CbcCompareDepth and
+    CbcCompareEstimate can be evaluated without dereferencing nodes.
+    Other comparison objects fall back to CbcCompareBase::test.
+
+    cleanTree does not rebuild the heap. Nodes worse than the cutoff are
+    left in place and deleted when they reach the top, unless more than
+    a quarter of the heap is dead in which case the heap is compacted and
+    re-heapified in linear time.
+*/
+class CBCLIB_EXPORT CbcTreeDHeap : public CbcTree {
+
+public:
+  /// Default Constructor
+  CbcTreeDHeap();
+
+  /// Copy constructor
+  CbcTreeDHeap(const CbcTreeDHeap &rhs);
+
+  /// = operator
+  CbcTreeDHeap &operator=(const CbcTreeDHeap &rhs);
+
+  /// Destructor
+  virtual ~CbcTreeDHeap();
+
+  /// Clone
+  virtual CbcTree *clone() const;
+
+  /// Create C++ lines to get to current state
+  virtual void generateCpp(FILE *fp);
+
+  /*! \name Heap access and maintenance methods */
+  //@{
+  /// Return the top node of the heap
+  virtual CbcNode *top() const;
+
+  /// Add a node to the heap
+  virtual void push(CbcNode *x);
+
+  /// Remove the top node from the heap
+  virtual void pop();
+
+  /// Gets best node and takes off heap (deleting dead nodes on the way)
+  virtual CbcNode *bestNode(double cutoff);
+
+  /// Rebuild the heap (refreshes inline keys)
+  virtual void rebuild();
+  //@}
+
+  /*! \name Search tree maintenance */
+  //@{
+  /// Prune the tree using an objective function cutoff (lazily)
+  virtual void cleanTree(CbcModel *model, double cutoff, double &bestPossibleObjective);
+
+  /// Get best possible objective function in the tree
+  virtual double getBestPossibleObjective();
+
+  /// Number of dead nodes still on heap
+  inline int numberDead() const
+  {
+    return numberDead_;
+  }
+  //@}
+
+protected:
+  /// Arity of heap
+  enum { arity = 4 };
+  /// Fill in key for a node
+  static void fillKey(CbcTreeDHeapKey &key, const CbcNode *node);
+  /// Returns true if entry j is better than entry i
+  inline bool better(int i, int j)
+  {
+    const CbcTreeDHeapKey &keyI = keys_[i];
+    const CbcTreeDHeapKey &keyJ = keys_[j];
+    switch (keyType_) {
+    case 1:
+      if (keyI.objective != keyJ.objective)
+        return keyI.objective > keyJ.objective;
+      break;
+    case 2:
+      if (keyI.depth != keyJ.depth)
+        return keyI.depth < keyJ.depth;
+      break;
+    case 3:
+      if (keyI.estimate != keyJ.estimate)
+        return keyI.estimate > keyJ.estimate;
+      break;
+    default:
+      break;
+    }
+    return comparison_.compareNodes(nodes_[i], nodes_[j]);
+  }
+  /// Swap two entries
+  inline void swapEntries(int i, int j)
+  {
+    CbcNode *tempNode = nodes_[i];
+    nodes_[i] = nodes_[j];
+    nodes_[j] = tempNode;
+    CbcTreeDHeapKey tempKey = keys_[i];
+    keys_[i] = keys_[j];
+    keys_[j] = tempKey;
+  }
+  /// Move entry up
+  void siftUp(int i);
+  /// Move entry down
+  void siftDown(int i);
+  /// Remove top entry
+  virtual void removeTop();
+  /// Take dead nodes off heap and delete them
+  virtual void compact();
+
+protected:
+  /// Inline keys - same order as nodes_
+  std::vector< CbcTreeDHeapKey > keys_;
+  /** Type of key comparison
+      0 - use comparison object
+      1 - objective
+      2 - depth
+      3 - estimate
+  */
+  int keyType_;
+  /// Number of nodes on heap with objective >= cutoff_
+  int numberDead_;
+  /// Cutoff used by last cleanTree
+  double cutoff_;
+  /// Model which last cleaned tree (needed to delete dead nodes)
+  CbcModel *model_;
+};
+
+/*! \class CbcTreeBucket
+    \brief 4-ary heap with nodes counted in objective buckets.
+
+    The range between the best objective on the tree and the cutoff is
+    split into equal width buckets and the tree keeps a count and a lower
+    bound on the objective for each bucket.  When the cutoff drops, every
+    bucket at or above the cutoff is dead as a whole, so cleanTree does
+    not look at the nodes, and getBestPossibleObjective is a lookup in
+    the lowest non-empty bucket.  Dead nodes are deleted as in
+    CbcTreeDHeap.  Buckets are re-sized when the heap is compacted or
+    when the live range has shrunk to a small number of buckets.
+
+    Until there is a finite cutoff there is nothing to bucket and bound
+    queries scan the heap.
+*/
+class CBCLIB_EXPORT CbcTreeBucket : public CbcTreeDHeap {
+
+public:
+  /// Default Constructor
+  CbcTreeBucket(int numberBuckets = 1024);
+
+  /// Copy constructor
+  CbcTreeBucket(const CbcTreeBucket &rhs);
+
+  /// = operator
+  CbcTreeBucket &operator=(const CbcTreeBucket &rhs);
+
+  /// Destructor
+  virtual ~CbcTreeBucket();
+
+  /// Clone
+  virtual CbcTree *clone() const;
+
+  /// Create C++ lines to get to current state
+  virtual void generateCpp(FILE *fp);
+
+  /// Add a node to the heap
+  virtual void push(CbcNode *x);
+
+  /// Rebuild the heap (refreshes keys and buckets)
+  virtual void rebuild();
+
+  /// Prune the tree using an objective function cutoff
+  virtual void cleanTree(CbcModel *model, double cutoff, double &bestPossibleObjective);
+
+  /// Get best possible objective function in the tree
+  virtual double getBestPossibleObjective();
+
+  /// Number of buckets
+  inline int numberBuckets() const
+  {
+    return numberBuckets_;
+  }
+  /// Width of each bucket (0.0 until there is a cutoff)
+  inline double bucketWidth() const
+  {
+    return width_;
+  }
+
+protected:
+  /// Bucket for an objective value
+  inline int bucket(double objective) const
+  {
+    double value = (objective - origin_) / width_;
+    if (value <= 0.0)
+      return 0;
+    else if (value >= numberBuckets_ - 1)
+      return numberBuckets_ - 1;
+    else
+      return static_cast< int >(value);
+  }
+  /// Remove top entry
+  virtual void removeTop();
+  /// Take dead nodes off heap and delete them
+  virtual void compact();
+  /// Choose bucket width from range on tree and recount
+  void rebucket();
+
+protected:
+  /// Number of nodes in each bucket
+  std::vector< int > count_;
+  /// Lower bound on objective of nodes in each bucket
+  std::vector< double > lower_;
+  /// Objective at start of bucket 0
+  double origin_;
+  /// Width of buckets
+  double width_;
+  /// Number of buckets
+  int numberBuckets_;
+  /// Lowest bucket which may be non-empty
+  int lowest_;
 };
 
 #ifdef JJF_ZERO // not used
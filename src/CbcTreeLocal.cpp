@@ -445,6 +445,9 @@ bool CbcTreeLocal::empty()
   saveNumberSolutions_ = model_->getSolutionCount();
   bool finished = false;
   bool lastTry = false;
+  // old distance cut which new one will replace
+  bool replaceOld = false;
+  OsiRowCut oldCut;
   switch (state) {
   case 1:
     // solution found and subtree exhausted
@@ -578,8 +581,9 @@ bool CbcTreeLocal::empty()
         reverseCut(3, rhs_);
       } else {
         searchType_ = 1;
-        // delete last cut
-        deleteCut(cut_);
+        // last cut will be replaced by new one
+        oldCut = cut_;
+        replaceOld = true;
       }
     } else {
       searchType_ = 1;
@@ -599,8 +603,9 @@ bool CbcTreeLocal::empty()
         diversification_++;
         searchType_ = 0;
       } else {
-        // delete last cut
-        deleteCut(cut_);
+        // last cut will be replaced by new one
+        oldCut = cut_;
+        replaceOld = true;
         searchType_ = 1;
       }
       nextStrong_ = true;
@@ -623,12 +628,30 @@ bool CbcTreeLocal::empty()
   }
   if (rhs_ < 1.0e30 || lastTry) {
     int goodSolution = createCut(savedSolution_, cut_);
+    CbcRowCuts *global = model_->globalCuts();
+    int iOld = -1;
+    if (replaceOld) {
+      for (int i = 0; i < global->sizeRowCuts(); i++) {
+        if (oldCut == *global->rowCutPtr(i)) {
+          iOld = i;
+          break;
+        }
+      }
+    }
     if (goodSolution >= 0) {
-      // Add to global cuts
-      model_->makeGlobalCut(cut_);
-      CbcRowCuts *global = model_->globalCuts();
-      int n = global->sizeRowCuts();
-      OsiRowCut *rowCut = global->rowCutPtr(n - 1);
+      int n;
+      OsiRowCut *rowCut;
+      if (iOld >= 0) {
+        // Update distance cut in place
+        global->replaceRowCut(iOld, cut_);
+        n = global->sizeRowCuts();
+        rowCut = global->rowCutPtr(iOld);
+      } else {
+        // Add to global cuts
+        model_->makeGlobalCut(cut_);
+        n = global->sizeRowCuts();
+        rowCut = global->rowCutPtr(n - 1);
+      }
       if (model_->messageHandler()->logLevel() > 1)
         printf("inserting cut - now %d cuts, rhs %g %g, cutspace %g, diversification %d\n",
           n, rowCut->lb(), rowCut->ub(), rhs_, diversification_);
@@ -643,6 +666,9 @@ bool CbcTreeLocal::empty()
           printf("%d - rhs %g %g\n",
             i, rowCut->lb(), rowCut->ub());
       }
+    } else if (iOld >= 0) {
+      // delete last cut
+      deleteCut(oldCut);
     }
     // put back node
     startTime_ = static_cast< int >(CoinCpuTime());
@@ -805,7 +831,7 @@ void CbcTreeLocal::reverseCut(int state, double bias)
       break;
     }
   }
-  if (!rowCut) {
+  if (i == n) {
     // must have got here in odd way e.g. strong branching
     return;
   }
@@ -825,8 +851,12 @@ void CbcTreeLocal::reverseCut(int state, double bias)
   if (model_->messageHandler()->logLevel() > 1)
     printf("reverseCut - changing cut %d out of %d, old rhs %g %g ",
       i, n, rowCut->lb(), rowCut->ub());
-  rowCut->setLb(rowCut->ub() + smallest - bias);
-  rowCut->setUb(COIN_DBL_MAX);
+  // bounds are part of hash so replace rather than modify
+  OsiRowCut newCut(*rowCut);
+  newCut.setLb(rowCut->ub() + smallest - bias);
+  newCut.setUb(COIN_DBL_MAX);
+  global->replaceRowCut(i, newCut);
+  rowCut = global->rowCutPtr(i);
   if (model_->messageHandler()->logLevel() > 1)
     printf("new rhs %g %g, bias %g smallest %g ",
       rowCut->lb(), rowCut->ub(), bias, smallest);
@@ -1306,6 +1336,9 @@ bool CbcTreeVariable::empty()
   saveNumberSolutions_ = model_->getSolutionCount();
   bool finished = false;
   bool lastTry = false;
+  // old distance cut which new one will replace
+  bool replaceOld = false;
+  OsiRowCut oldCut;
   switch (state) {
   case 1:
     // solution found and subtree exhausted
@@ -1439,8 +1472,9 @@ bool CbcTreeVariable::empty()
         reverseCut(3, rhs_);
       } else {
         searchType_ = 1;
-        // delete last cut
-        deleteCut(cut_);
+        // last cut will be replaced by new one
+        oldCut = cut_;
+        replaceOld = true;
       }
     } else {
       searchType_ = 1;
@@ -1460,8 +1494,9 @@ bool CbcTreeVariable::empty()
         diversification_++;
         searchType_ = 0;
       } else {
-        // delete last cut
-        deleteCut(cut_);
+        // last cut will be replaced by new one
+        oldCut = cut_;
+        replaceOld = true;
         searchType_ = 1;
       }
       nextStrong_ = true;
@@ -1484,12 +1519,30 @@ bool CbcTreeVariable::empty()
   }
   if (rhs_ < 1.0e30 || lastTry) {
     int goodSolution = createCut(savedSolution_, cut_);
+    CbcRowCuts *global = model_->globalCuts();
+    int iOld = -1;
+    if (replaceOld) {
+      for (int i = 0; i < global->sizeRowCuts(); i++) {
+        if (oldCut == *global->rowCutPtr(i)) {
+          iOld = i;
+          break;
+        }
+      }
+    }
     if (goodSolution >= 0) {
-      // Add to global cuts
-      model_->makeGlobalCut(cut_);
-      CbcRowCuts *global = model_->globalCuts();
-      int n = global->sizeRowCuts();
-      OsiRowCut *rowCut = global->rowCutPtr(n - 1);
+      int n;
+      OsiRowCut *rowCut;
+      if (iOld >= 0) {
+        // Update distance cut in place
+        global->replaceRowCut(iOld, cut_);
+        n = global->sizeRowCuts();
+        rowCut = global->rowCutPtr(iOld);
+      } else {
+        // Add to global cuts
+        model_->makeGlobalCut(cut_);
+        n = global->sizeRowCuts();
+        rowCut = global->rowCutPtr(n - 1);
+      }
       if (model_->messageHandler()->logLevel() > 1)
         printf("inserting cut - now %d cuts, rhs %g %g, cutspace %g, diversification %d\n",
           n, rowCut->lb(), rowCut->ub(), rhs_, diversification_);
@@ -1504,6 +1557,9 @@ bool CbcTreeVariable::empty()
           printf("%d - rhs %g %g\n",
             i, rowCut->lb(), rowCut->ub());
       }
+    } else if (iOld >= 0) {
+      // delete last cut
+      deleteCut(oldCut);
     }
     // put back node
     startTime_ = static_cast< int >(CoinCpuTime());
@@ -1657,7 +1713,7 @@ void CbcTreeVariable::reverseCut(int state, double bias)
       break;
     }
   }
-  if (!rowCut) {
+  if (i == n) {
     // must have got here in odd way e.g. strong branching
     return;
   }
@@ -1677,8 +1733,12 @@ void CbcTreeVariable::reverseCut(int state, double bias)
   if (model_->messageHandler()->logLevel() > 1)
     printf("reverseCut - changing cut %d out of %d, old rhs %g %g ",
       i, n, rowCut->lb(), rowCut->ub());
-  rowCut->setLb(rowCut->ub() + smallest - bias);
-  rowCut->setUb(COIN_DBL_MAX);
+  // bounds are part of hash so replace rather than modify
+  OsiRowCut newCut(*rowCut);
+  newCut.setLb(rowCut->ub() + smallest - bias);
+  newCut.setUb(COIN_DBL_MAX);
+  global->replaceRowCut(i, newCut);
+  rowCut = global->rowCutPtr(i);
   if (model_->messageHandler()->logLevel() > 1)
     printf("new rhs %g %g, bias %g smallest %g ",
       rowCut->lb(), rowCut->ub(), bias, smallest);
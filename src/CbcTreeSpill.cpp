@@ -0,0 +1,523 @@
+// Copyright (C) 2004, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include <cassert>
+#include <cstring>
+#include <algorithm>
+
+#include "CoinHelperFunctions.hpp"
+#include "CoinWarmStartBasis.hpp"
+#include "CbcModel.hpp"
+#include "CbcNode.hpp"
+#include "CbcFullNodeInfo.hpp"
+#include "CbcPartialNodeInfo.hpp"
+#include "CbcSimpleInteger.hpp"
+#include "CbcSimpleIntegerDynamicPseudoCost.hpp"
+#include "CbcBranchDynamic.hpp"
+#include "CbcTreeSpill.hpp"
+
+namespace {
+/*
+  Fixed part of a spill record. It is followed by the bound changes
+  (indices, then lower and upper bounds) and then the basis status arrays.
+*/
+typedef struct {
+  double objective;
+  double estimate;
+  double sumInfeasibilities;
+  double value;
+  double down[2];
+  double up[2];
+  double changeInGuessed;
+  int depth;
+  int numberUnsatisfied;
+  int state;
+  int nodeInfoNumber;
+  int traceId;
+  int dynamic;
+  int column;
+  int way;
+  int branchesLeft;
+  int position;
+  int numberChanged;
+  int numberStructural;
+  int numberArtificial;
+} spillHeader;
+
+// Bytes used by status array in CoinWarmStartBasis
+inline int statusBytes(int n)
+{
+  return 4 * ((n + 15) >> 4);
+}
+}
+
+CbcTreeSpill::CbcTreeSpill(double memoryBudget, const char *spillFile)
+  : CbcTreeDHeap()
+  , memoryBudget_(memoryBudget)
+  , fp_(NULL)
+  , bestSpilled_(COIN_DBL_MAX)
+  , endOfFile_(0)
+  , lastCheck_(0)
+  , numberWritten_(0)
+  , numberRead_(0)
+{
+  if (spillFile)
+    fileName_ = spillFile;
+}
+CbcTreeSpill::~CbcTreeSpill()
+{
+  if (fp_) {
+    fclose(fp_);
+    if (fileName_.size())
+      remove(fileName_.c_str());
+  }
+}
+// Copy constructor
+CbcTreeSpill::CbcTreeSpill(const CbcTreeSpill &rhs)
+  : CbcTreeDHeap(rhs)
+  , memoryBudget_(rhs.memoryBudget_)
+  , fileName_(rhs.fileName_)
+  , fp_(NULL)
+  , bestSpilled_(COIN_DBL_MAX)
+  , endOfFile_(0)
+  , lastCheck_(0)
+  , numberWritten_(0)
+  , numberRead_(0)
+{
+}
+// Assignment operator
+CbcTreeSpill &
+CbcTreeSpill::operator=(const CbcTreeSpill &rhs)
+{
+  if (this != &rhs) {
+    CbcTreeDHeap::operator=(rhs);
+    memoryBudget_ = rhs.memoryBudget_;
+    if (fp_) {
+      fclose(fp_);
+      if (fileName_.size())
+        remove(fileName_.c_str());
+      fp_ = NULL;
+    }
+    fileName_ = rhs.fileName_;
+    spilled_.clear();
+    bestSpilled_ = COIN_DBL_MAX;
+    endOfFile_ = 0;
+    lastCheck_ = 0;
+    numberWritten_ = 0;
+    numberRead_ = 0;
+  }
+  return *this;
+}
+// Clone
+CbcTree *
+CbcTreeSpill::clone() const
+{
+  return new CbcTreeSpill(*this);
+}
+// Create C++ lines to get to current state
+void CbcTreeSpill::generateCpp(FILE *fp)
+{
+  fprintf(fp, "0#include \"CbcTreeSpill.hpp\"\n");
+  fprintf(fp, "5  CbcTreeSpill spillTree(%g);\n", memoryBudget_);
+  fprintf(fp, "5  cbcModel->passInTreeHandler(spillTree);\n");
+}
+// Open spill file if needed
+bool CbcTreeSpill::openFile()
+{
+  if (!fp_) {
+    if (fileName_.size())
+      fp_ = fopen(fileName_.c_str(), "w+b");
+    else
+      fp_ = tmpfile();
+    endOfFile_ = 0;
+    if (!fp_) {
+      // can't spill - switch off
+      memoryBudget_ = 0.0;
+      return false;
+    }
+  }
+  return true;
+}
+/*
+  Estimate of bytes used by a node on the heap. Counts the node, its
+  branching object and node info if the node owns it.
+*/
+double
+CbcTreeSpill::nodeBytes(const CbcNode *node, int numberColumns)
+{
+  double bytes = sizeof(CbcNode) + sizeof(CbcDynamicPseudoCostBranchingObject);
+  const CbcNodeInfo *info = node->nodeInfo();
+  if (info && info->owner() == node) {
+    const CbcPartialNodeInfo *partial = dynamic_cast< const CbcPartialNodeInfo * >(info);
+    if (partial) {
+      bytes += sizeof(CbcPartialNodeInfo);
+      bytes += partial->numberChangedBounds() * (sizeof(int) + sizeof(double));
+    } else {
+      const CbcFullNodeInfo *full = dynamic_cast< const CbcFullNodeInfo * >(info);
+      bytes += sizeof(CbcFullNodeInfo);
+      bytes += full ? full->boundsBytes() : 2 * sizeof(double) * numberColumns;
+    }
+    bytes += info->numberCuts() * sizeof(void *);
+  }
+  return bytes;
+}
+// Estimated bytes used by nodes on heap (from a sample)
+double
+CbcTreeSpill::heapBytes() const
+{
+  int n = static_cast< int >(nodes_.size());
+  if (!n)
+    return 0.0;
+  int step = CoinMax(n / 32, 1);
+  int numberColumns = model_ ? model_->getNumCols() : 0;
+  double bytes = 0.0;
+  int numberSampled = 0;
+  for (int i = 0; i < n; i += step) {
+    bytes += nodeBytes(nodes_[i], numberColumns);
+    numberSampled++;
+  }
+  return (bytes * n) / numberSampled;
+}
+/*
+  Write one node to end of spill file. The solver must have the bounds
+  and basis for the node (from addCuts1).
+*/
+bool CbcTreeSpill::writeNode(const CbcNode *node, const CoinWarmStartBasis *basis)
+{
+  const CbcIntegerBranchingObject *branch = dynamic_cast< const CbcIntegerBranchingObject * >(node->branchingObject());
+  spillHeader header;
+  memset(&header, 0, sizeof(header));
+  header.objective = node->objectiveValue();
+  header.estimate = node->guessedObjectiveValue();
+  header.sumInfeasibilities = node->sumInfeasibilities();
+  header.value = branch->value();
+  memcpy(header.down, branch->downBounds(), 2 * sizeof(double));
+  memcpy(header.up, branch->upBounds(), 2 * sizeof(double));
+  header.depth = node->depth();
+  header.numberUnsatisfied = node->numberUnsatisfied();
+  header.state = node->getState();
+  header.nodeInfoNumber = node->nodeInfo()->nodeNumber();
+  header.traceId = node->nodeInfo()->traceId();
+  if (branch->type() == DynamicPseudoCostBranchObj) {
+    const CbcDynamicPseudoCostBranchingObject *dynamicBranch = dynamic_cast< const CbcDynamicPseudoCostBranchingObject * >(branch);
+    header.dynamic = 1;
+    header.changeInGuessed = dynamicBranch->changeInGuessed();
+  }
+  header.column = branch->variable();
+  header.way = branch->way();
+  header.branchesLeft = branch->numberBranchesLeft();
+  header.position = branch->object()->position();
+  // bounds relative to root
+  const OsiSolverInterface *solver = model_->solver();
+  int numberColumns = solver->getNumCols();
+  const double *lower = solver->getColLower();
+  const double *upper = solver->getColUpper();
+  const double *rootLower = model_->topOfTree()->lower();
+  const double *rootUpper = model_->topOfTree()->upper();
+  int *which = new int[numberColumns];
+  double *newLower = new double[2 * numberColumns];
+  double *newUpper = newLower + numberColumns;
+  int numberChanged = 0;
+  for (int i = 0; i < numberColumns; i++) {
+    if (lower[i] != rootLower[i] || upper[i] != rootUpper[i]) {
+      which[numberChanged] = i;
+      newLower[numberChanged] = lower[i];
+      newUpper[numberChanged++] = upper[i];
+    }
+  }
+  header.numberChanged = numberChanged;
+  header.numberStructural = basis->getNumStructural();
+  header.numberArtificial = basis->getNumArtificial();
+  bool ok = !fseek(fp_, endOfFile_, SEEK_SET);
+  if (ok) {
+    size_t nBytes = sizeof(header) + numberChanged * (sizeof(int) + 2 * sizeof(double))
+      + statusBytes(header.numberStructural) + statusBytes(header.numberArtificial);
+    size_t nWritten = fwrite(&header, sizeof(header), 1, fp_) * sizeof(header);
+    nWritten += fwrite(which, sizeof(int), numberChanged, fp_) * sizeof(int);
+    nWritten += fwrite(newLower, sizeof(double), numberChanged, fp_) * sizeof(double);
+    nWritten += fwrite(newUpper, sizeof(double), numberChanged, fp_) * sizeof(double);
+    nWritten += fwrite(basis->getStructuralStatus(), 1, statusBytes(header.numberStructural), fp_);
+    nWritten += fwrite(basis->getArtificialStatus(), 1, statusBytes(header.numberArtificial), fp_);
+    ok = (nWritten == nBytes);
+    if (ok) {
+      spillEntry entry;
+      entry.objective = header.objective;
+      entry.offset = endOfFile_;
+      spilled_.push_back(entry);
+      bestSpilled_ = CoinMin(bestSpilled_, header.objective);
+      endOfFile_ += static_cast< long >(nBytes);
+      numberWritten_++;
+    }
+  }
+  delete[] which;
+  delete[] newLower;
+  return ok;
+}
+/*
+  Spill nodes ranked worst by the comparison object until estimated memory is back to
+  three quarters of budget.
+*/
+void CbcTreeSpill::spill()
+{
+  int n = static_cast< int >(nodes_.size());
+  if (!n)
+    return;
+  if (!model_) {
+    const CbcBranchingObject *branch = dynamic_cast< const CbcBranchingObject * >(nodes_[0]->branchingObject());
+    if (branch)
+      model_ = branch->model();
+  }
+  if (!model_ || model_->parallelMode() || !model_->topOfTree()) {
+    // can't spill
+    lastCheck_ = -1;
+    return;
+  }
+  if (!openFile())
+    return;
+  double bytes = heapBytes();
+  int numberToSpill = static_cast< int >((bytes - 0.75 * memoryBudget_) / (bytes / n));
+  if (numberToSpill <= 0)
+    return;
+  // sort positions so worst first
+  int *which = new int[n];
+  for (int i = 0; i < n; i++)
+    which[i] = i;
+  worseFirst worse;
+  worse.tree = this;
+  std::sort(which, which + n, worse);
+  char *gone = new char[n];
+  memset(gone, 0, n);
+  CbcNode **nodeArray = new CbcNode *[n];
+  int *depth = new int[n];
+  int numberDelete = 0;
+  int numberRowsAtContinuous = model_->numberRowsAtContinuous();
+  int numberColumns = model_->solver()->getNumCols();
+  for (int j = 0; j < n && numberDelete < numberToSpill; j++) {
+    int i = which[j];
+    CbcNode *node = nodes_[i];
+    if (!node->nodeInfo() || !node->active())
+      continue;
+    const CbcIntegerBranchingObject *branch = dynamic_cast< const CbcIntegerBranchingObject * >(node->branchingObject());
+    if (!branch || (branch->type() != SimpleIntegerBranchObj && branch->type() != DynamicPseudoCostBranchObj))
+      continue;
+    const CbcObject *object = branch->object();
+    if (!object || object->position() < 0 || object->position() >= model_->numberObjects() || model_->modifiableObject(object->position()) != object)
+      continue;
+    CoinWarmStartBasis *lastws = model_->getEmptyBasis();
+    model_->addCuts1(node, lastws);
+    // no cuts in record
+    lastws->resize(numberRowsAtContinuous, numberColumns);
+    bool ok = writeNode(node, lastws);
+    delete lastws;
+    if (!ok)
+      break;
+    gone[i] = 1;
+    node->setOnTree(false);
+    nodeArray[numberDelete] = node;
+    depth[numberDelete++] = node->depth();
+  }
+  // take off heap
+  int k = 0;
+  numberDead_ = 0;
+  for (int i = 0; i < n; i++) {
+    if (!gone[i]) {
+      nodes_[k] = nodes_[i];
+      keys_[k] = keys_[i];
+      if (keys_[k].objective >= cutoff_)
+        numberDead_++;
+      k++;
+    }
+  }
+  nodes_.resize(k);
+  keys_.resize(k);
+  for (int i = (k - 2) / arity; i >= 0; i--)
+    siftDown(i);
+  deleteNodes(model_, model_->getCutoff(), nodeArray, depth, numberDelete);
+  lastCheck_ = k;
+  delete[] which;
+  delete[] gone;
+  delete[] nodeArray;
+  delete[] depth;
+}
+// Read one node and recreate it
+CbcNode *
+CbcTreeSpill::readNode(long offset)
+{
+  spillHeader header;
+  if (fseek(fp_, offset, SEEK_SET) || fread(&header, sizeof(header), 1, fp_) != 1)
+    return NULL;
+  int numberChanged = header.numberChanged;
+  int *which = new int[numberChanged];
+  double *newLower = new double[2 * numberChanged];
+  double *newUpper = newLower + numberChanged;
+  int nStructural = statusBytes(header.numberStructural);
+  int nArtificial = statusBytes(header.numberArtificial);
+  char *structuralStatus = new char[nStructural];
+  char *artificialStatus = new char[nArtificial];
+  bool ok = (fread(which, sizeof(int), numberChanged, fp_) == static_cast< size_t >(numberChanged));
+  ok = ok && (fread(newLower, sizeof(double), numberChanged, fp_) == static_cast< size_t >(numberChanged));
+  ok = ok && (fread(newUpper, sizeof(double), numberChanged, fp_) == static_cast< size_t >(numberChanged));
+  ok = ok && (fread(structuralStatus, 1, nStructural, fp_) == static_cast< size_t >(nStructural));
+  ok = ok && (fread(artificialStatus, 1, nArtificial, fp_) == static_cast< size_t >(nArtificial));
+  if (!ok) {
+    delete[] which;
+    delete[] newLower;
+    delete[] structuralStatus;
+    delete[] artificialStatus;
+    return NULL;
+  }
+  // bounds
+  int numberColumns = model_->solver()->getNumCols();
+  double *lower = CoinCopyOfArray(model_->topOfTree()->lower(), numberColumns);
+  double *upper = CoinCopyOfArray(model_->topOfTree()->upper(), numberColumns);
+  for (int i = 0; i < numberChanged; i++) {
+    int iColumn = which[i];
+    lower[iColumn] = newLower[i];
+    upper[iColumn] = newUpper[i];
+  }
+  delete[] which;
+  delete[] newLower;
+  CoinWarmStartBasis *basis = new CoinWarmStartBasis();
+  basis->assignBasisStatus(header.numberStructural, header.numberArtificial,
+    structuralStatus, artificialStatus);
+  // node
+  CbcNode *node = new CbcNode();
+  node->setObjectiveValue(header.objective);
+  node->setGuessedObjectiveValue(header.estimate);
+  node->setSumInfeasibilities(header.sumInfeasibilities);
+  node->setDepth(header.depth);
+  node->setNumberUnsatisfied(header.numberUnsatisfied);
+  node->setState(header.state & ~3);
+  CbcFullNodeInfo *info = new CbcFullNodeInfo(model_, node, lower, upper, basis,
+    model_->numberRowsAtContinuous());
+  delete[] lower;
+  delete[] upper;
+  info->setNodeNumber(header.nodeInfoNumber);
+  info->setTraceId(header.traceId);
+  node->setNodeInfo(info);
+  // branching object
+  CbcObject *object = dynamic_cast< CbcObject * >(model_->modifiableObject(header.position));
+  CbcIntegerBranchingObject *branch;
+  if (header.dynamic) {
+    CbcSimpleIntegerDynamicPseudoCost *dynamicObject = dynamic_cast< CbcSimpleIntegerDynamicPseudoCost * >(object);
+    CbcDynamicPseudoCostBranchingObject *dynamicBranch = new CbcDynamicPseudoCostBranchingObject(model_, header.column, header.way, header.value, dynamicObject);
+    dynamicBranch->setChangeInGuessed(header.changeInGuessed);
+    branch = dynamicBranch;
+  } else {
+    branch = new CbcIntegerBranchingObject(model_, header.column, header.way, header.value);
+  }
+  branch->setOriginalObject(object);
+  branch->setDownBounds(header.down);
+  branch->setUpBounds(header.up);
+  if (header.branchesLeft == 1)
+    branch->setNumberBranchesLeft(1);
+  node->setBranchingObject(branch);
+  node->initializeInfo();
+  numberRead_++;
+  return node;
+}
+/*
+  Read back best records until half the memory budget would be used
+  (at least one node is read).
+*/
+void CbcTreeSpill::reload(double cutoff)
+{
+  std::sort(spilled_.begin(), spilled_.end(), spillEntry::better);
+  int n = static_cast< int >(spilled_.size());
+  double bytes = heapBytes();
+  int i;
+  for (i = 0; i < n; i++) {
+    if (spilled_[i].objective >= cutoff) {
+      // rest are no good
+      i = n;
+      break;
+    }
+    CbcNode *node = readNode(spilled_[i].offset);
+    if (!node) {
+      // file is bad - forget rest
+      i = n;
+      break;
+    }
+    push(node);
+    bytes += nodeBytes(node, model_->getNumCols());
+    if (bytes > 0.5 * memoryBudget_) {
+      i++;
+      break;
+    }
+  }
+  spilled_.erase(spilled_.begin(), spilled_.begin() + i);
+  if (spilled_.empty()) {
+    bestSpilled_ = COIN_DBL_MAX;
+    endOfFile_ = 0;
+  } else {
+    bestSpilled_ = spilled_[0].objective;
+  }
+  lastCheck_ = static_cast< int >(nodes_.size());
+}
+/*
+  Return the best node. Spill first if the heap looks too large and
+  reload if the heap is empty.
+*/
+CbcNode *
+CbcTreeSpill::bestNode(double cutoff)
+{
+  if (memoryBudget_ > 0.0 && lastCheck_ >= 0) {
+    int n = static_cast< int >(nodes_.size());
+    if (n < lastCheck_) {
+      lastCheck_ = n;
+    } else if (n >= lastCheck_ + CoinMax(32, lastCheck_ >> 4)) {
+      lastCheck_ = n;
+      if (heapBytes() > memoryBudget_)
+        spill();
+    }
+  }
+  CbcNode *best = CbcTreeDHeap::bestNode(cutoff);
+  if (!best && spilled_.size()) {
+    reload(CoinMin(cutoff, cutoff_));
+    best = CbcTreeDHeap::bestNode(cutoff);
+  }
+  return best;
+}
+// Test for an empty tree
+bool CbcTreeSpill::empty()
+{
+  return nodes_.empty() && spilled_.empty();
+}
+/*
+  Prune the tree using an objective function cutoff. Spilled records
+  at or above the cutoff are just forgotten.
+*/
+void CbcTreeSpill::cleanTree(CbcModel *model, double cutoff, double &bestPossibleObjective)
+{
+  CbcTreeDHeap::cleanTree(model, cutoff, bestPossibleObjective);
+  if (spilled_.size()) {
+    int k = 0;
+    int n = static_cast< int >(spilled_.size());
+    bestSpilled_ = COIN_DBL_MAX;
+    if (cutoff != -COIN_DBL_MAX) {
+      for (int i = 0; i < n; i++) {
+        if (spilled_[i].objective < cutoff) {
+          bestSpilled_ = CoinMin(bestSpilled_, spilled_[i].objective);
+          spilled_[k++] = spilled_[i];
+        }
+      }
+    }
+    spilled_.resize(k);
+    if (!k)
+      endOfFile_ = 0;
+    bestPossibleObjective = CoinMin(bestPossibleObjective, bestSpilled_);
+  }
+}
+// Get best possible objective function in the tree
+double
+CbcTreeSpill::getBestPossibleObjective()
+{
+  double r_val = CbcTreeDHeap::getBestPossibleObjective();
+  if (bestSpilled_ < cutoff_)
+    r_val = CoinMin(r_val, bestSpilled_);
+  return r_val;
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
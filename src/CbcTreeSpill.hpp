@@ -0,0 +1,156 @@
+// Copyright (C) 2004, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcTreeSpill_H
+#define CbcTreeSpill_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "CbcTree.hpp"
+
+class CoinWarmStartBasis;
+
+/*! \class CbcTreeSpill
+    \brief Live set which spills nodes to disk past a memory budget.
+
+    Behaves as CbcTreeDHeap until the estimated memory used by nodes on
+    the heap goes over the budget.  Then the worst nodes, as ranked by the
+    comparison object, are written to a spill file as self-contained
+    records (bounds relative to the root, basis without cuts, and the state
+    of the branching object) and deleted from the search tree. When the
+    heap runs dry the best records (by objective) are read back and
+    recreated as nodes with a CbcFullNodeInfo and no parent.
+
+    Only nodes branching on a simple integer variable
+    (CbcIntegerBranchingObject or CbcDynamicPseudoCostBranchingObject) are
+    spilled; others stay in memory. Cuts are not saved, so a reloaded node
+    starts without the cuts it had.  Spilling is switched off when
+    running with threads.
+*/
+class CBCLIB_EXPORT CbcTreeSpill : public CbcTreeDHeap {
+
+public:
+  /** Default Constructor
+      \p memoryBudget is in bytes (0.0 means never spill).
+      If \p spillFile is NULL a temporary file is used.
+    */
+  CbcTreeSpill(double memoryBudget = 0.0, const char *spillFile = NULL);
+
+  /// Copy constructor (spilled records are not copied)
+  CbcTreeSpill(const CbcTreeSpill &rhs);
+
+  /// = operator (spilled records are not copied)
+  CbcTreeSpill &operator=(const CbcTreeSpill &rhs);
+
+  /// Destructor
+  virtual ~CbcTreeSpill();
+
+  /// Clone
+  virtual CbcTree *clone() const;
+
+  /// Create C++ lines to get to current state
+  virtual void generateCpp(FILE *fp);
+
+  /// Gets best node and takes off heap - may spill or reload
+  virtual CbcNode *bestNode(double cutoff);
+
+  /// Test for an empty tree (includes spilled nodes)
+  virtual bool empty();
+
+  /// Prune the tree (and spilled records) using an objective function cutoff
+  virtual void cleanTree(CbcModel *model, double cutoff, double &bestPossibleObjective);
+
+  /// Get best possible objective function in the tree (includes spilled nodes)
+  virtual double getBestPossibleObjective();
+
+  /// Set memory budget in bytes (0.0 switches off)
+  inline void setMemoryBudget(double value)
+  {
+    memoryBudget_ = value;
+  }
+  /// Get memory budget in bytes
+  inline double memoryBudget() const
+  {
+    return memoryBudget_;
+  }
+  /// Number of nodes currently spilled
+  inline int numberSpilled() const
+  {
+    return static_cast< int >(spilled_.size());
+  }
+  /// Total number of nodes written to spill file
+  inline int numberWritten() const
+  {
+    return numberWritten_;
+  }
+  /// Total number of nodes read back
+  inline int numberRead() const
+  {
+    return numberRead_;
+  }
+  /// Estimated bytes used by one node on heap
+  static double nodeBytes(const CbcNode *node, int numberColumns);
+
+protected:
+  /// Entry in index of spill file
+  struct spillEntry {
+    /// Objective value of node
+    double objective;
+    /// Position in file
+    long offset;
+    /// Smaller objective first
+    static bool better(const spillEntry &a, const spillEntry &b)
+    {
+      return a.objective < b.objective;
+    }
+  };
+
+  /// Orders heap positions so worst node comes first
+  struct worseFirst {
+    CbcTreeSpill *tree;
+    bool operator()(int i, int j) const
+    {
+      return tree->better(i, j);
+    }
+  };
+  /// Make room by spilling worst nodes
+  void spill();
+  /// Read back best records
+  void reload(double cutoff);
+  /// Write one node (solver must be at node) - returns false if not possible
+  bool writeNode(const CbcNode *node, const CoinWarmStartBasis *basis);
+  /// Read one node
+  CbcNode *readNode(long offset);
+  /// Estimated bytes used by nodes on heap
+  double heapBytes() const;
+  /// Open spill file if needed
+  bool openFile();
+
+protected:
+  /// Memory budget in bytes
+  double memoryBudget_;
+  /// Name of spill file (empty means temporary file)
+  std::string fileName_;
+  /// Spill file
+  FILE *fp_;
+  /// Index of spilled nodes
+  std::vector< spillEntry > spilled_;
+  /// Best objective of spilled nodes
+  double bestSpilled_;
+  /// End of records in spill file
+  long endOfFile_;
+  /// Heap size when memory was last estimated (-1 if spilling not possible)
+  int lastCheck_;
+  /// Number of nodes written
+  int numberWritten_;
+  /// Number of nodes read
+  int numberRead_;
+};
+
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
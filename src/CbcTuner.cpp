@@ -0,0 +1,378 @@
+// Copyright (C) 2002, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#pragma warning(disable : 4786)
+#endif
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include "CoinHelperFunctions.hpp"
+#include "CoinTime.hpp"
+#include "CbcModel.hpp"
+#include "CbcMessage.hpp"
+#include "CbcSolver.hpp"
+#include "CbcTuner.hpp"
+#ifdef CBC_THREAD
+#include <pthread.h>
+#endif
+
+// Constructor - model is only read
+CbcTuner::CbcTuner(const CbcModel &model)
+  : model_(&model)
+  , seconds_(60.0)
+  , gap_(1.0e-4)
+  , numberThreads_(1)
+  , maximumRuns_(0)
+  , seed_(1234567)
+{
+}
+
+CbcTuner::~CbcTuner()
+{
+}
+
+// Reads specification
+int CbcTuner::readSpecification(const char *fileName)
+{
+  std::ifstream input(fileName);
+  if (!input)
+    return -1;
+  std::string line;
+  int lineNumber = 0;
+  while (std::getline(input, line)) {
+    lineNumber++;
+    std::string::size_type comment = line.find('#');
+    if (comment != std::string::npos)
+      line.erase(comment);
+    std::istringstream fields(line);
+    std::string key;
+    if (!(fields >> key))
+      continue;
+    std::string value;
+    std::vector< std::string > values;
+    while (fields >> value)
+      values.push_back(value);
+    int nValues = static_cast< int >(values.size());
+    if (key == "param") {
+      if (nValues < 2)
+        return lineNumber;
+      std::string name = values[0];
+      if (name[0] == '-')
+        name.erase(0, 1);
+      names_.push_back(name);
+      values_.push_back(std::vector< std::string >(values.begin() + 1, values.end()));
+    } else if (key == "fixed") {
+      if (nValues < 1)
+        return lineNumber;
+      std::string text;
+      for (int i = 0; i < nValues; i++) {
+        if (i)
+          text += " ";
+        text += values[i];
+      }
+      if (text[0] == '-')
+        text.erase(0, 1);
+      fixed_.push_back(text);
+    } else if (nValues != 1) {
+      return lineNumber;
+    } else if (key == "threads") {
+      numberThreads_ = CoinMax(1, atoi(values[0].c_str()));
+    } else if (key == "runs") {
+      maximumRuns_ = CoinMax(0, atoi(values[0].c_str()));
+    } else if (key == "seconds") {
+      seconds_ = atof(values[0].c_str());
+    } else if (key == "gap") {
+      gap_ = atof(values[0].c_str());
+    } else if (key == "seed") {
+      seed_ = atoi(values[0].c_str());
+    } else if (key == "output") {
+      outputFile_ = values[0];
+    } else {
+      return lineNumber;
+    }
+  }
+  return 0;
+}
+
+// Makes list of configurations to run (first one is defaults)
+void CbcTuner::makeRuns()
+{
+  int numberParameters = static_cast< int >(names_.size());
+  runs_.clear();
+  CbcTuneRun run;
+  run.seconds = 0.0;
+  run.gap = COIN_DBL_MAX;
+  run.finished = false;
+  run.score = COIN_DBL_MAX;
+  // -1 means leave at default
+  run.choice.assign(numberParameters, -1);
+  runs_.push_back(run);
+  double gridSize = 1.0;
+  for (int i = 0; i < numberParameters; i++)
+    gridSize *= static_cast< double >(values_[i].size());
+  if (!numberParameters)
+    return;
+  // full grid unless asked for sample or grid silly
+  int maximumRuns = maximumRuns_;
+  if (!maximumRuns && gridSize > 10000.0)
+    maximumRuns = 10000;
+  if (!maximumRuns || gridSize <= maximumRuns) {
+    int numberGrid = static_cast< int >(gridSize);
+    for (int k = 0; k < numberGrid; k++) {
+      int left = k;
+      for (int i = 0; i < numberParameters; i++) {
+        int n = static_cast< int >(values_[i].size());
+        run.choice[i] = left % n;
+        left /= n;
+      }
+      runs_.push_back(run);
+    }
+  } else {
+    // random sample without repeats
+    CoinThreadRandom random(seed_);
+    int numberTries = 0;
+    while (static_cast< int >(runs_.size()) <= maximumRuns && numberTries < 100 * maximumRuns) {
+      numberTries++;
+      for (int i = 0; i < numberParameters; i++) {
+        int n = static_cast< int >(values_[i].size());
+        run.choice[i] = CoinMin(n - 1, static_cast< int >(random.randomDouble() * n));
+      }
+      bool repeat = false;
+      for (size_t j = 1; j < runs_.size(); j++) {
+        if (runs_[j].choice == run.choice) {
+          repeat = true;
+          break;
+        }
+      }
+      if (!repeat)
+        runs_.push_back(run);
+    }
+  }
+}
+
+// Description of a run
+std::string CbcTuner::describe(int iRun) const
+{
+  const CbcTuneRun &run = runs_[iRun];
+  std::string text;
+  for (size_t i = 0; i < names_.size(); i++) {
+    if (run.choice[i] < 0)
+      continue;
+    if (text.size())
+      text += " ";
+    text += names_[i] + " " + values_[i][run.choice[i]];
+  }
+  if (!text.size())
+    text = "defaults";
+  return text;
+}
+
+static int dummyCallBack(CbcModel * /*model*/, int /*whereFrom*/)
+{
+  return 0;
+}
+
+// Does one run on copy of model
+void CbcTuner::doRun(int iRun, CbcModel *model)
+{
+  CbcTuneRun &run = runs_[iRun];
+  std::vector< std::string > arguments;
+  arguments.push_back("cbc");
+  arguments.push_back("-log");
+  arguments.push_back("0");
+  arguments.push_back("-slogLevel");
+  arguments.push_back("0");
+  for (size_t i = 0; i < fixed_.size(); i++) {
+    std::istringstream fields(fixed_[i]);
+    std::string field;
+    fields >> field;
+    arguments.push_back("-" + field);
+    while (fields >> field)
+      arguments.push_back(field);
+  }
+  char buffer[32];
+  arguments.push_back("-seconds");
+  sprintf(buffer, "%g", seconds_);
+  arguments.push_back(buffer);
+  arguments.push_back("-ratioGap");
+  sprintf(buffer, "%g", gap_);
+  arguments.push_back(buffer);
+  for (size_t i = 0; i < names_.size(); i++) {
+    if (run.choice[i] < 0)
+      continue;
+    arguments.push_back("-" + names_[i]);
+    arguments.push_back(values_[i][run.choice[i]]);
+  }
+  arguments.push_back("-solve");
+  arguments.push_back("-quit");
+  int nArgs = static_cast< int >(arguments.size());
+  std::vector< const char * > args(nArgs);
+  for (int i = 0; i < nArgs; i++)
+    args[i] = arguments[i].c_str();
+  CbcSolverUsefulData data;
+  CbcMain0(*model, data);
+  data.argumentsOnly_ = true;
+  data.printWelcome_ = false;
+  data.noPrinting_ = true;
+  model->messageHandler()->setLogLevel(0);
+  double time0 = CoinGetTimeOfDay();
+  CbcMain1(nArgs, &args[0], *model, dummyCallBack, data);
+  run.seconds = CoinGetTimeOfDay() - time0;
+  // status 0 is finished (optimal within gap or infeasible)
+  run.finished = (model->status() == 0);
+  if (run.finished) {
+    run.gap = 0.0;
+    run.score = run.seconds;
+  } else {
+    double best = model->getObjValue();
+    double bound = model->getBestPossibleObjValue();
+    if (model->bestSolution() && fabs(best) < 1.0e50)
+      run.gap = fabs(best - bound) / CoinMax(1.0e-10, fabs(best));
+    else
+      run.gap = 1.0;
+    run.score = 10.0 * CoinMax(seconds_, run.seconds) + CoinMin(run.gap, 1.0);
+  }
+}
+
+namespace {
+/// Shared by tuning threads
+typedef struct {
+  CbcTuner *tuner;
+  int numberRuns;
+  int nextRun;
+#ifdef CBC_THREAD
+  pthread_mutex_t *mutex;
+#endif
+} CbcTuneShared;
+}
+
+// Takes runs off list until none left
+static void *doTuneRuns(void *voidInfo)
+{
+  CbcTuneShared *info = reinterpret_cast< CbcTuneShared * >(voidInfo);
+  while (true) {
+#ifdef CBC_THREAD
+    pthread_mutex_lock(info->mutex);
+#endif
+    int iRun = info->nextRun++;
+    CbcModel *model = NULL;
+    if (iRun < info->numberRuns)
+      model = info->tuner->copyModel();
+#ifdef CBC_THREAD
+    pthread_mutex_unlock(info->mutex);
+#endif
+    if (!model)
+      break;
+    info->tuner->doRun(iRun, model);
+    delete model;
+  }
+  return NULL;
+}
+
+// Copy of model (called under lock)
+CbcModel *CbcTuner::copyModel() const
+{
+  return new CbcModel(*model_);
+}
+
+// Does all runs and returns number finished
+int CbcTuner::tune()
+{
+  makeRuns();
+  int numberRuns = static_cast< int >(runs_.size());
+  CoinMessageHandler *handler = model_->messageHandler();
+  CoinMessages messages = model_->messages();
+  char general[200];
+  sprintf(general, "Tuning with %d runs of at most %g seconds%s", numberRuns, seconds_,
+    numberThreads_ > 1 ? "" : " (one at a time)");
+  handler->message(CBC_GENERAL, messages)
+    << general << CoinMessageEol;
+  CbcTuneShared info;
+  info.tuner = this;
+  info.numberRuns = numberRuns;
+  info.nextRun = 0;
+#ifdef CBC_THREAD
+  pthread_mutex_t mutex;
+  pthread_mutex_init(&mutex, NULL);
+  info.mutex = &mutex;
+  int numberThreads = CoinMin(numberThreads_, numberRuns);
+  if (numberThreads > 1) {
+    std::vector< pthread_t > threads(numberThreads);
+    for (int i = 0; i < numberThreads; i++)
+      pthread_create(&threads[i], NULL, doTuneRuns, &info);
+    for (int i = 0; i < numberThreads; i++)
+      pthread_join(threads[i], NULL);
+  } else {
+    doTuneRuns(&info);
+  }
+  pthread_mutex_destroy(&mutex);
+#else
+  doTuneRuns(&info);
+#endif
+  int numberFinished = 0;
+  for (int iRun = 0; iRun < numberRuns; iRun++) {
+    const CbcTuneRun &run = runs_[iRun];
+    if (run.finished) {
+      numberFinished++;
+      sprintf(general, "Run %d finished in %.2f seconds - ", iRun, run.seconds);
+    } else {
+      sprintf(general, "Run %d stopped after %.2f seconds with gap %g - ", iRun, run.seconds, run.gap);
+    }
+    handler->message(CBC_GENERAL, messages)
+      << general + describe(iRun) << CoinMessageEol;
+  }
+  int iBest = bestRun();
+  if (iBest >= 0) {
+    sprintf(general, "Best is run %d (score %g) - ", iBest, runs_[iBest].score);
+    handler->message(CBC_GENERAL, messages)
+      << general + describe(iBest) << CoinMessageEol;
+  }
+  return numberFinished;
+}
+
+// Index of best run (-1 if none) - ties go to earlier run
+int CbcTuner::bestRun() const
+{
+  int iBest = -1;
+  double bestScore = COIN_DBL_MAX;
+  for (int iRun = 0; iRun < static_cast< int >(runs_.size()); iRun++) {
+    if (runs_[iRun].score < bestScore) {
+      bestScore = runs_[iRun].score;
+      iBest = iRun;
+    }
+  }
+  return iBest;
+}
+
+// Writes best configuration as "name value" lines
+int CbcTuner::writeBest(const char *fileName) const
+{
+  int iBest = bestRun();
+  if (iBest < 0)
+    return 1;
+  FILE *fp = fopen(fileName, "w");
+  if (!fp)
+    return -1;
+  fprintf(fp, "# best of %d runs - %s %.2f seconds\n", static_cast< int >(runs_.size()),
+    runs_[iBest].finished ? "finished in" : "not finished after", runs_[iBest].seconds);
+  for (size_t i = 0; i < fixed_.size(); i++)
+    fprintf(fp, "%s\n", fixed_[i].c_str());
+  const CbcTuneRun &run = runs_[iBest];
+  for (size_t i = 0; i < names_.size(); i++) {
+    if (run.choice[i] >= 0)
+      fprintf(fp, "%s %s\n", names_[i].c_str(), values_[i][run.choice[i]].c_str());
+  }
+  fclose(fp);
+  return 0;
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -0,0 +1,119 @@
+// Copyright (C) 2002, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CbcTuner_H
+#define CbcTuner_H
+
+#include <string>
+#include <vector>
+
+#include "CbcSolverConfig.h"
+
+class CbcModel;
+
+/// One run of a tuning
+typedef struct {
+  /// Value chosen for each parameter (index into its values)
+  std::vector< int > choice;
+  /// Elapsed seconds
+  double seconds;
+  /// Gap left at end (0.0 if search finished)
+  double gap;
+  /// Whether search finished (optimal within gap or infeasible)
+  bool finished;
+  /// Score - seconds if finished, otherwise penalized
+  double score;
+} CbcTuneRun;
+
+/** Parameter sweep for the cbc command tune.
+
+    The model is loaded once and each run solves its own copy through
+    CbcMain1 with the chosen parameter values as arguments, several
+    runs at a time when there are threads.  Runs are scored by time to
+    reach the gap (stopping there), runs which do not get there by ten
+    times the time limit plus gap left.  Specification file has lines
+
+    param name value1 value2 ... - values to try for a cbc parameter
+    fixed name value - used in every run
+    threads n - runs at once (default 1)
+    runs n - random sample of n configurations (default 0 - full grid)
+    seconds t - time limit of each run (default 60)
+    gap g - relative gap which counts as solved (default 1.0e-4)
+    seed n - for random sample
+    output file - where best configuration is written
+
+    and # starts a comment.  The defaults of cbc are always run first.
+*/
+
+class CBCSOLVERLIB_EXPORT CbcTuner {
+public:
+  /// Constructor - model is only read
+  CbcTuner(const CbcModel &model);
+  /// Destructor
+  ~CbcTuner();
+
+  /** Reads specification.  Returns 0 if fine, -1 if file can not be
+      opened, otherwise line number of first bad line */
+  int readSpecification(const char *fileName);
+  /// Does all runs and returns number finished
+  int tune();
+  /// Writes best configuration as "name value" lines - returns 0 if fine
+  int writeBest(const char *fileName) const;
+  /// Index of best run (-1 if none)
+  int bestRun() const;
+  /// Output file from specification (may be empty)
+  inline const std::string &outputFile() const
+  {
+    return outputFile_;
+  }
+  /// Runs done
+  inline const std::vector< CbcTuneRun > &runs() const
+  {
+    return runs_;
+  }
+
+  /// Copy of model for a run (used by threads under lock)
+  CbcModel *copyModel() const;
+  /// Does one run on copy of model (used by threads)
+  void doRun(int iRun, CbcModel *model);
+  /// Description of a run
+  std::string describe(int iRun) const;
+
+private:
+  /// Makes list of configurations to run
+  void makeRuns();
+  /// Illegal copy constructor
+  CbcTuner(const CbcTuner &);
+  /// Illegal assignment operator
+  CbcTuner &operator=(const CbcTuner &);
+
+private:
+  /// Model to copy
+  const CbcModel *model_;
+  /// Parameter names
+  std::vector< std::string > names_;
+  /// Values to try for each parameter
+  std::vector< std::vector< std::string > > values_;
+  /// Fixed parameters ("name value" without -)
+  std::vector< std::string > fixed_;
+  /// Runs (filled by tune)
+  std::vector< CbcTuneRun > runs_;
+  /// Output file
+  std::string outputFile_;
+  /// Time limit per run
+  double seconds_;
+  /// Relative gap counted as solved
+  double gap_;
+  /// Runs at once
+  int numberThreads_;
+  /// Maximum number of configurations (0 all)
+  int maximumRuns_;
+  /// Seed for sample
+  int seed_;
+};
+
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -15,6 +15,7 @@
 
 #ifdef CBC_THREAD
 #include <pthread.h>
+#include <ctime>
 #endif
 
 #include "CoinPragma.hpp"
@@ -29,6 +30,7 @@
 #include "CoinMessageHandler.hpp"
 #include "OsiClpSolverInterface.hpp"
 #include "OsiFeatures.hpp"
+#include "CbcFeatures.hpp"
 #include "ClpSimplexOther.hpp"
 #include "CglCutGenerator.hpp"
 #include "CglProbing.hpp"
@@ -55,6 +57,9 @@
 #include "ClpPEDualRowSteepest.hpp"
 #include "ClpPEDualRowDantzig.hpp"
 #include "CbcMipStartIO.hpp"
+#include "CbcMpsReader.hpp"
+#include "CbcSnapshot.hpp"
+#include "CbcNameHash.hpp"
 #include "ClpMessage.hpp"
 #include "CoinStaticConflictGraph.hpp"
 #include <OsiAuxInfo.hpp>
@@ -190,6 +195,12 @@ struct Cbc_Model {
   vector< double > *iniSol;
   double iniObj;
 
+  /* session - kept between solves if keepSession */
+  char keepSession;
+  vector< string > sessionPseudoNames;
+  vector< double > sessionPseudoCosts;
+  vector< double > sessionSolution;
+
   // buffer for rows
   int rowSpace;
   int nRows;
@@ -203,7 +214,9 @@ struct Cbc_Model {
   int *rIdx;
   double *rCoef;
 
-  // for fast search of columns
+  /* for fast search of columns (CbcNameHash) - nothing is done until a
+   * name is searched, after that added or renamed entries are appended
+   * and anything else marks the index stale so it is built again */
   void *colNameIndex;
   void *rowNameIndex;
 
@@ -229,11 +242,30 @@ struct Cbc_Model {
    **/
   void *pgrAppData;
 
+  /**
+   * Callbacks see node events only every so many nodes
+   **/
+  int eventNodeInterval;
+
 #ifdef CBC_THREAD
   pthread_mutex_t cbcMutexCG;
   pthread_mutex_t cbcMutexEvent;
 #endif
 
+  /* asynchronous solve - counters only written by solving thread */
+  volatile int asyncNodes;
+  volatile double asyncBestBound;
+  volatile double asyncIncumbent;
+  volatile char cancelRequested;
+  /* 0 no solve pending, 1 running, 2 finished (thread not joined) */
+  volatile char asyncState;
+  int asyncStatus;
+#ifdef CBC_THREAD
+  pthread_t asyncThread;
+  pthread_mutex_t asyncMutex;
+  pthread_cond_t asyncCond;
+#endif
+
   double obj_value;
   
   /* storage of Special Ordered Sets */
@@ -247,6 +279,22 @@ struct Cbc_Model {
   int *sosEl;
   double *sosElWeight;
 
+  /* indicator constraints - row of indicator i is from indStart[i] */
+  vector< int > indColumn;
+  vector< char > indValue;
+  vector< double > indLB;
+  vector< double > indUB;
+  vector< int > indStart;
+  vector< int > indIdx;
+  vector< double > indCoef;
+
+  /* piecewise linear costs - breakpoints of i are from pwStart[i] */
+  vector< int > pwX;
+  vector< int > pwY;
+  vector< int > pwStart;
+  vector< double > pwPx;
+  vector< double > pwPf;
+
   /* MIPStart */
   int nColsMS;
   char **colNamesMS;
@@ -289,12 +337,13 @@ struct Cbc_Model {
   double mipBestPossibleObjValue;
   int mipNumSavedSolutions;
   int mipNodeCount;
-  std::vector< std::vector< double > > *mipSavedSolution;
+  /* solution pool in one block, numCols per solution, best first */
+  std::vector< double > *mipSavedSolution;
   std::vector< double > *mipSavedSolutionObj;
-  std::vector< double > *mipBestSolution;
+  /* row activity of best MIP solution, computed when asked for */
   std::vector< double > *mipRowActivity;
 
-  // to store computed slacks for MIPs and LPs
+  // to store computed slacks for MIPs and LPs - computed when asked for
   std::vector< double > *slack;
 
   int mipIterationCount;
@@ -336,6 +385,8 @@ class CglCallback : public CglCutGenerator
 
         cbc_cut_callback cut_callback_;
         void *appdata;
+        // rows from callback kept as lazy constraints (may be NULL)
+        CglStored *lazyPool;
 #ifdef CBC_THREAD
         pthread_mutex_t *cbcMutex;
 #endif
@@ -357,7 +408,8 @@ class CglCallback : public CglCutGenerator
 
 CglCallback::CglCallback()
     : cut_callback_(NULL),
-    appdata(NULL)
+    appdata(NULL),
+    lazyPool(NULL)
 #ifdef CBC_THREAD
     ,cbcMutex(NULL)
 #endif
@@ -369,6 +421,7 @@ CglCallback::CglCallback(const CglCallback& rhs)
 {
     this->cut_callback_ = rhs.cut_callback_;
     this->appdata = rhs.appdata;
+    this->lazyPool = rhs.lazyPool;
 #ifdef CBC_THREAD
     this->cbcMutex = rhs.cbcMutex;
 #endif
@@ -379,6 +432,7 @@ CglCutGenerator* CglCallback::clone() const
     CglCallback *cglcb = new CglCallback();
     cglcb->cut_callback_ = this->cut_callback_;
     cglcb->appdata = this->appdata;
+    cglcb->lazyPool = this->lazyPool;
 #ifdef CBC_THREAD
     cglcb->cbcMutex = this->cbcMutex;
 #endif
@@ -393,7 +447,26 @@ void CglCallback::generateCuts( const OsiSolverInterface &si, OsiCuts &cs, const
     pthread_mutex_lock((this->cbcMutex));
 #endif
 
-  this->cut_callback_( (OsiSolverInterface *) &si, &cs, this->appdata, info.level, info.pass );
+  if (this->lazyPool) {
+    // rows found before come first - callback only if none violated
+    int nBefore = cs.sizeRowCuts();
+    this->lazyPool->generateCuts(si, cs, info);
+    if (cs.sizeRowCuts() == nBefore) {
+      OsiCuts userCuts;
+      this->cut_callback_( (OsiSolverInterface *) &si, &userCuts, this->appdata, info.level, info.pass );
+      const double *x = si.getColSolution();
+      for ( int i=0 ; i<userCuts.sizeRowCuts() ; ++i ) {
+        const OsiRowCut &rc = userCuts.rowCut(i);
+        this->lazyPool->addCut(rc);
+        if (rc.violated(x) > 1e-6)
+          cs.insert(rc);
+      }
+      for ( int i=0 ; i<userCuts.sizeColCuts() ; ++i )
+        cs.insert(userCuts.colCut(i));
+    }
+  } else {
+    this->cut_callback_( (OsiSolverInterface *) &si, &cs, this->appdata, info.level, info.pass );
+  }
 
 #ifdef CBC_THREAD
     pthread_mutex_unlock((this->cbcMutex));
@@ -421,6 +494,8 @@ public:
   cbc_progress_callback progr_callback;
   void *appData;
   void *pgAppData;
+  // to publish progress and look for cancel (may be NULL)
+  Cbc_Model *asyncModel;
 #ifdef CBC_THREAD
   pthread_mutex_t *cbcMutex;
 #endif
@@ -434,6 +509,7 @@ Cbc_EventHandler::Cbc_EventHandler()
   , progr_callback(NULL)
   , appData(NULL)
   , pgAppData(NULL)
+  , asyncModel(NULL)
 #ifdef CBC_THREAD
   , cbcMutex(NULL)
 #endif
@@ -448,6 +524,7 @@ Cbc_EventHandler::Cbc_EventHandler(const Cbc_EventHandler &rhs)
   , progr_callback(rhs.progr_callback)
   , appData(rhs.appData)
   , pgAppData(rhs.pgAppData)
+  , asyncModel(rhs.asyncModel)
 #ifdef CBC_THREAD
   , cbcMutex(rhs.cbcMutex)
 #endif
@@ -463,6 +540,7 @@ Cbc_EventHandler::Cbc_EventHandler(CbcModel *model)
   , progr_callback(NULL)
   , appData(NULL)
   , pgAppData(NULL)
+  , asyncModel(NULL)
 #ifdef CBC_THREAD
   , cbcMutex(NULL)
 #endif
@@ -484,6 +562,7 @@ Cbc_EventHandler &Cbc_EventHandler::operator=(const Cbc_EventHandler &rhs)
     this->progr_callback = rhs.progr_callback;
     this->appData = rhs.appData;
     this->pgAppData = rhs.pgAppData;
+    this->asyncModel = rhs.asyncModel;
 #ifdef CBC_THREAD
     this->cbcMutex = rhs.cbcMutex;
 #endif
@@ -498,6 +577,20 @@ CbcEventHandler *Cbc_EventHandler::clone() const
 
 CbcEventHandler::CbcAction Cbc_EventHandler::event(CbcEvent whichEvent)
 {
+  if (asyncModel) {
+    if (asyncModel->cancelRequested) {
+      model_->sayEventHappened();
+      return stop;
+    }
+    if ((model_->specialOptions() & 2048) == 0) {
+      // plain stores read by Cbc_poll
+      asyncModel->asyncNodes = model_->getNodeCount();
+      asyncModel->asyncBestBound = model_->getBestPossibleObjValue();
+      if (model_->bestSolution())
+        asyncModel->asyncIncumbent = model_->getObjValue();
+    }
+  }
+
   // if in sub tree carry on
   if ((model_->specialOptions() & 2048) == 0) {
     if ((whichEvent == solution || whichEvent == heuristicSolution)) {
@@ -1017,6 +1110,20 @@ static void Cbc_deleteRowBuffer(Cbc_Model *model)
   model->rElementsSpace = 0;
 }
 
+static void Cbc_iniAsync(Cbc_Model *model)
+{
+  model->asyncNodes = 0;
+  model->asyncBestBound = -COIN_DBL_MAX;
+  model->asyncIncumbent = COIN_DBL_MAX;
+  model->cancelRequested = 0;
+  model->asyncState = 0;
+  model->asyncStatus = 0;
+#ifdef CBC_THREAD
+  pthread_mutex_init(&(model->asyncMutex), NULL);
+  pthread_cond_init(&(model->asyncCond), NULL);
+#endif
+}
+
 static void Cbc_iniBuffer(Cbc_Model *model) 
 {
   // initialize columns buffer
@@ -1094,6 +1201,7 @@ Cbc_newModel()
 
   model->icAppData = NULL;
   model->pgrAppData = NULL;
+  model->eventNodeInterval = 1;
 
   model->colNameIndex = NULL;
   model->rowNameIndex = NULL;
@@ -1101,13 +1209,14 @@ Cbc_newModel()
   model->iniSol = NULL;
   model->iniObj = DBL_MAX;
 
+  model->keepSession = 0;
+
   Cbc_cleanOptResults(model);
   Cbc_iniBuffer(model);
 
   // MIP Solution storage structures
   model->mipSavedSolution = NULL;
   model->mipSavedSolutionObj = NULL;
-  model->mipBestSolution = NULL;
   model->mipRowActivity = NULL;
 
   model->slack = NULL;
@@ -1116,6 +1225,7 @@ Cbc_newModel()
   pthread_mutex_init(&(model->cbcMutexCG), NULL);
   pthread_mutex_init(&(model->cbcMutexEvent), NULL);
 #endif
+  Cbc_iniAsync(model);
 
   model->lazyConstrs = NULL;
 
@@ -1126,6 +1236,15 @@ Cbc_newModel()
 void CBC_LINKAGE
 Cbc_deleteModel(Cbc_Model *model)
 {
+  if (model->asyncState) {
+    Cbc_cancel(model);
+    Cbc_waitFor(model, -1.0);
+  }
+#ifdef CBC_THREAD
+  pthread_mutex_destroy(&(model->asyncMutex));
+  pthread_cond_destroy(&(model->asyncCond));
+#endif
+
   Cbc_deleteColBuffer(model);
   Cbc_deleteRowBuffer(model);
 
@@ -1152,9 +1271,9 @@ Cbc_deleteModel(Cbc_Model *model)
 
   if (model->colNameIndex)
   {
-    NameIndex *m = (NameIndex *)model->colNameIndex;
+    CbcNameHash *m = (CbcNameHash *)model->colNameIndex;
     delete m;
-    m = (NameIndex *)model->rowNameIndex;
+    m = (CbcNameHash *)model->rowNameIndex;
     assert( m != NULL );
     delete m;
   }
@@ -1181,7 +1300,6 @@ Cbc_deleteModel(Cbc_Model *model)
   if (model->mipSavedSolution) {
     delete model->mipSavedSolution;
     delete model->mipSavedSolutionObj;
-    delete model->mipBestSolution;
     delete model->mipRowActivity;
   }
 
@@ -1216,23 +1334,15 @@ Cbc_loadProblem(Cbc_Model *model, const int numcols, const int numrows,
     collb, colub, obj, rowlb, rowub);
 } //  Cbc_loadProblem()
 
-/* should be called after reading a new problem */
+/* should be called after reading a new problem - indexes are
+   built again at next search */
 static void fillAllNameIndexes(Cbc_Model *model)
 {
   if (!model->colNameIndex)
     return;
 
-  OsiClpSolverInterface *solver = model->solver_;
-  NameIndex &colNameIndex = *((NameIndex  *)model->colNameIndex);
-  colNameIndex.clear();
-  NameIndex &rowNameIndex = *((NameIndex  *)model->rowNameIndex);
-  rowNameIndex.clear();
-
-  for ( int i=0 ; (i<solver->getNumCols()) ; ++i )
-    colNameIndex[solver->getColName(i)] = i;
-
-  for ( int i=0 ; (i<solver->getNumRows()) ; ++i )
-    rowNameIndex[solver->getRowName(i)] = i;
+  ((CbcNameHash *)model->colNameIndex)->invalidate();
+  ((CbcNameHash *)model->rowNameIndex)->invalidate();
 }
 
 /** Reads an MPS file
@@ -1245,7 +1355,11 @@ int CBC_LINKAGE
 Cbc_readMps(Cbc_Model *model, const char *filename)
 {
   OsiClpSolverInterface *solver = model->solver_;
-  int status = solver->readMps(filename, true, false);
+  // straight into solver - CoinMpsIO if file has sections not handled
+  CbcMpsReader reader;
+  int status = reader.readMps(filename, solver, true);
+  if (status == CbcMpsReader::unsupported)
+    status = solver->readMps(filename, true, false);
   if ((status>0)&&(model->int_param[INT_PARAM_LOG_LEVEL] > 0)) {
     fflush(stdout); fflush(stderr);
     fprintf(stderr, "%d errors occurred while reading MPS.\n", status);
@@ -1274,6 +1388,98 @@ Cbc_writeMps(Cbc_Model *model, const char *filename)
   model->solver_->writeMps(filename, "mps", Cbc_getObjSense(model));
 }
 
+/** Reads a binary snapshot
+ *
+ * @param model problem object
+ * @param fileName file name
+ * @return 0 if fine, -1 if file could not be opened, -2 if not a snapshot
+ **/
+int CBC_LINKAGE
+Cbc_readSnapshot(Cbc_Model *model, const char *filename)
+{
+  CbcSnapshot snapshot;
+  int status = snapshot.open(filename);
+  if (status) {
+    if (model->int_param[INT_PARAM_LOG_LEVEL] > 0) {
+      fflush(stdout); fflush(stderr);
+      fprintf(stderr, "%s is not a readable snapshot.\n", filename);
+      fflush(stderr);
+    }
+    return status;
+  }
+
+  snapshot.load(model->solver_);
+
+  Cbc_deleteColBuffer(model);
+  Cbc_deleteRowBuffer(model);
+  Cbc_iniBuffer(model);
+
+  fillAllNameIndexes(model);
+
+  // SOS of snapshot replace any there were
+  model->nSos = 0;
+  model->sosElSize = 0;
+  const int *sosStart = snapshot.sosStart();
+  for (int i = 0; i < snapshot.numberSOS(); i++) {
+    int start[2] = { 0, sosStart[i + 1] - sosStart[i] };
+    Cbc_addSOS(model, 1, start, snapshot.sosIndices() + sosStart[i],
+      snapshot.sosReference() + sosStart[i], snapshot.sosType()[i]);
+  }
+
+  if (snapshot.numberMipStart())
+    Cbc_setMIPStartI(model, snapshot.numberMipStart(), snapshot.mipStartColumns(),
+      snapshot.mipStartValues());
+
+  return 0;
+}
+
+/** Writes a binary snapshot
+ *
+ * @param model problem object
+ * @param fileName file name
+ * @return 0 if fine, -1 if file could not be written
+ **/
+int CBC_LINKAGE
+Cbc_writeSnapshot(Cbc_Model *model, const char *filename)
+{
+  Cbc_flush(model);
+
+  CbcSnapshotExtra extra;
+  memset(&extra, 0, sizeof(extra));
+  std::vector< char > sosType(model->nSos);
+  for (int i = 0; i < model->nSos; i++)
+    sosType[i] = static_cast< char >(model->sosType[i]);
+  if (model->nSos) {
+    extra.numberSOS = model->nSos;
+    extra.sosStart = model->sosRowStart;
+    extra.sosType = &sosType[0];
+    extra.sosIndices = model->sosEl;
+    extra.sosReference = model->sosElWeight;
+  }
+
+  std::vector< int > mipStartColumns;
+  std::vector< double > mipStartValues;
+  if (model->nColsMS) {
+    NameIndex columnIndex;
+    for (int i = 0; i < model->solver_->getNumCols(); i++)
+      columnIndex[model->solver_->getColName(i)] = i;
+    for (int i = 0; i < model->nColsMS; i++) {
+      NameIndex::const_iterator it = columnIndex.find(std::string(model->colNamesMS[i]));
+      if (it != columnIndex.end()) {
+        mipStartColumns.push_back(it->second);
+        mipStartValues.push_back(model->colValuesMS[i]);
+      }
+    }
+  }
+  if (mipStartColumns.size()) {
+    extra.numberMipStart = static_cast< int >(mipStartColumns.size());
+    extra.mipStartColumns = &mipStartColumns[0];
+    extra.mipStartValues = &mipStartValues[0];
+  }
+
+  return CbcSnapshot::write(filename, model->solver_, &extra);
+}
+
 int Cbc_readBasis(Cbc_Model *model, const char *filename) {
   OsiClpSolverInterface *solver = model->solver_;
   ClpSimplex *clps = solver->getModelPtr();
@@ -1379,6 +1585,18 @@ Cbc_setInitialSolution(Cbc_Model *model, const double *sol)
   model->iniObj = objval;
 }
 
+/** Keep pseudocosts and best solution between calls of Cbc_solve */
+void CBC_LINKAGE
+Cbc_setKeepSession(Cbc_Model *model, char keep)
+{
+  model->keepSession = keep;
+  if (!keep) {
+    model->sessionPseudoNames.clear();
+    model->sessionPseudoCosts.clear();
+    model->sessionSolution.clear();
+  }
+}
+
 
 void CBC_LINKAGE
 Cbc_setIntParam(Cbc_Model *model, enum IntParam which, const int val) {
@@ -1478,6 +1696,19 @@ const char *Cbc_featureName(int i) {
   return OsiFeatures::name(i);
 }
 
+void Cbc_computeQuickFeatures(Cbc_Model *model, double *features) {
+  Cbc_flush(model);
+  CbcFeatures::compute(features, model->solver_);
+}
+
+int Cbc_nQuickFeatures() {
+  return CbcFeatures::numberFeatures;
+}
+
+const char *Cbc_quickFeatureName(int i) {
+  return CbcFeatures::name(i);
+}
+
 /* Number of elements in matrix */
 int CBC_LINKAGE
 Cbc_getNumElements(Cbc_Model *model)
@@ -1630,16 +1861,11 @@ Cbc_setColName(Cbc_Model *model, int iColumn, const char *name)
 
   Cbc_flush(model);
   OsiClpSolverInterface *solver = model->solver_;
-  std::string previousName = solver->getColName(iColumn);
   solver->setColName(iColumn, name);
 
   if (!model->colNameIndex)
     return;
-  NameIndex &colNameIndex = *((NameIndex  *)model->colNameIndex);
-  NameIndex::iterator it = colNameIndex.find(previousName);
-  if (it!=colNameIndex.end())
-    colNameIndex.erase(it);
-  colNameIndex[name] = iColumn;
+  ((CbcNameHash *)model->colNameIndex)->add(iColumn, name);
 }
 
 void CBC_LINKAGE
@@ -1649,16 +1875,11 @@ Cbc_setRowName(Cbc_Model *model, int iRow, const char *name)
 
   Cbc_flush(model);
   OsiClpSolverInterface *solver = model->solver_;
-  std::string previousName = solver->getRowName(iRow);
   solver->setRowName(iRow, name);
 
   if (!model->rowNameIndex)
     return;
-  NameIndex &rowNameIndex = *((NameIndex  *)model->rowNameIndex);
-  NameIndex::iterator it = rowNameIndex.find(std::string(previousName));
-  if (it!=rowNameIndex.end())
-    rowNameIndex.erase(it);
-  rowNameIndex[name] = iRow;
+  ((CbcNameHash *)model->rowNameIndex)->add(iRow, name);
 }
 
 void CBC_LINKAGE
@@ -1693,6 +1914,10 @@ static int cbc_callb(CbcModel *cbcModel, int whereFrom) {
 // adds all sos objects to the current cbcModel_ object
 static void Cbc_addAllSOS( Cbc_Model *model, CbcModel &cbcModel );
 
+// adds all indicator objects to the current cbcModel_ object
+static void Cbc_addAllIndicators( Cbc_Model *model, CbcModel &cbcModel );
+static void Cbc_addAllPiecewise( Cbc_Model *model, CbcModel &cbcModel );
+
 // adds mipstart if available
 static void Cbc_addMS( Cbc_Model *model, CbcModel &cbcModel  );
 
@@ -1904,8 +2129,6 @@ Cbc_solveLinearProgram(Cbc_Model *model)
     model->obj_value = solver->getObjValue();
     model->x = solver->getColSolution();
     model->rActv = solver->getRowActivity();
-    Cbc_updateSlack(model, solver->getRowActivity());
-    model->rSlk = &((*(model->slack))[0]);
     return 0;
   }
   if (solver->isIterationLimitReached()) {
@@ -2020,36 +2243,30 @@ static void Cbc_getMIPOptimizationResults( Cbc_Model *model, CbcModel &cbcModel
     return;
 
   /* allocating space for MIP solution(s) related structures */
-  if (model->mipBestSolution == NULL) {
-    model->mipSavedSolution = new std::vector< vector< double > >();
+  if (model->mipSavedSolution == NULL) {
+    model->mipSavedSolution = new std::vector< double >();
     model->mipSavedSolutionObj = new std::vector< double >();
-    model->mipBestSolution = new std::vector< double >();
     model->mipRowActivity = new std::vector< double >();
   }
   int numCols = Cbc_getNumCols(model);
-  int numRows = Cbc_getNumRows(model);
-  model->mipSavedSolution->resize( numSols );
-  for ( int i=0 ; i<numSols ; ++i )
-    (*(model->mipSavedSolution))[i].resize( numCols );
-
+  // capacity is kept between solves
+  model->mipSavedSolution->resize( (size_t)numSols*numCols );
   model->mipSavedSolutionObj->resize( numSols );
-  model->mipBestSolution->resize( numCols );
-  model->mipRowActivity->resize( numRows );
 
   OsiClpSolverInterface *solver = model->solver_;
   if (model->int_param[INT_PARAM_ROUND_INT_VARS]) {
     cbcModel.roundIntVars();
   }
 
-  memcpy( VEC_PTR(model->mipBestSolution), cbcModel.bestSolution(), sizeof(double)*numCols );
-  model->x = VEC_PTR(model->mipBestSolution);
+  /* best solution is first of pool so no copy of its own */
+  model->x = VEC_PTR(model->mipSavedSolution);
   model->obj_value = cbcModel.getObjValue();
 
   /* solution pool */
   for ( int i=0 ; i<numSols ; ++i ) {
     (*(model->mipSavedSolutionObj))[i] = cbcModel.savedSolutionObjective(i);
     const double *xi = cbcModel.savedSolution(i);
-    double *xd = &((*(model->mipSavedSolution))[i][0]);
+    double *xd = VEC_PTR(model->mipSavedSolution) + (size_t)i*numCols;
     memcpy(xd, xi, sizeof(double)*numCols );
     if (model->int_param[INT_PARAM_ROUND_INT_VARS]) {
       for ( int j=0 ; (j<numCols) ; ++j ) {
@@ -2060,9 +2277,7 @@ static void Cbc_getMIPOptimizationResults( Cbc_Model *model, CbcModel &cbcModel
     } /* round integer variables */
   } /* saving solution pool */
 
-  Cbc_updateSlack(model, cbcModel.getRowActivity() );
-  /* storing row activity in MIP sol */
-  memcpy(&((*(model->mipRowActivity))[0]), cbcModel.getRowActivity(), sizeof(double)*numRows );
+  /* row activity and slacks are computed by their getters */
 
   if (cbcModel.getObjSense()==-1) {
     model->obj_value = 0.0;
@@ -2126,9 +2341,7 @@ Cbc_solve(Cbc_Model *model)
       || ((solver->getNumIntegers()+model->nSos)==0)) {
     if (solver->isProvenOptimal() || solver->isIterationLimitReached()) {
       model->obj_value = solver->getObjValue();
-      Cbc_updateSlack(model, solver->getRowActivity() );
       model->x = solver->getColSolution();
-      model->rSlk = &((*(model->slack))[0]);
       model->rActv = solver->getRowActivity();
     }
 
@@ -2148,12 +2361,15 @@ Cbc_solve(Cbc_Model *model)
       }
 
       Cbc_EventHandler *cbc_eh = NULL;
-      if (model->inc_callback!=NULL || model->progr_callback!=NULL)
+      if (model->inc_callback!=NULL || model->progr_callback!=NULL
+        || model->asyncState == 1)
       {
         cbc_eh = new Cbc_EventHandler(&cbcModel);
 #ifdef CBC_THREAD
         cbc_eh->cbcMutex = &(model->cbcMutexEvent);
 #endif
+        if (model->asyncState == 1)
+          cbc_eh->asyncModel = model;
 
         if (model->inc_callback) {
           cbc_eh->inc_callback = model->inc_callback;
@@ -2163,6 +2379,12 @@ Cbc_solve(Cbc_Model *model)
           cbc_eh->progr_callback = model->progr_callback;
           cbc_eh->pgAppData = model->pgrAppData;
         }
+        if (model->progr_callback == NULL && model->asyncState != 1) {
+          // incumbent callback only - model need not make other events
+          cbc_eh->setEventMask(CbcEventHandler::eventBit(CbcEventHandler::solution)
+            | CbcEventHandler::eventBit(CbcEventHandler::heuristicSolution));
+        }
+        cbc_eh->setNodeInterval(model->eventNodeInterval);
 
         cbcModel.passInEventHandler(cbc_eh);
       } // callbacks
@@ -2170,14 +2392,22 @@ Cbc_solve(Cbc_Model *model)
       /* initial solution */
       if (model->iniSol)
         cbcModel.setBestSolution(&((*model->iniSol)[0]), Cbc_getNumCols(model), model->iniObj, true);
+      else if (model->keepSession && model->nColsMS == 0
+        && (int)model->sessionSolution.size() == Cbc_getNumCols(model))
+        // last solution of session - checked as bounds may have changed
+        cbcModel.setBestSolution(&model->sessionSolution[0], Cbc_getNumCols(model), COIN_DBL_MAX, true);
 
       // add cut generator if necessary
+      CglStored lazyPool;
       if (model->cut_callback) {
         cbcModel.setKeepNamesPreproc(true);
 
         CglCallback cglCb;
         cglCb.appdata = model->cutCBData;
         cglCb.cut_callback_ = model->cut_callback;
+        // rows from callback at solutions are constraints - never generate twice
+        if (model->cutCBAtSol)
+          cglCb.lazyPool = &lazyPool;
 #ifdef CBC_THREAD
         cglCb.cbcMutex = &(model->cbcMutexCG);
 #endif
@@ -2237,10 +2467,23 @@ Cbc_solve(Cbc_Model *model)
       CbcSolverUsefulData cbcData;
       CbcMain0(cbcModel, cbcData);
       cbcData.printWelcome_ = false;
+      // no global state so models can be solved on several threads
+      cbcData.argumentsOnly_ = true;
+      if (model->keepSession) {
+        cbcData.keepPseudoCosts_ = true;
+        cbcData.pseudoCostNames_ = model->sessionPseudoNames;
+        cbcData.pseudoCosts_ = model->sessionPseudoCosts;
+      }
 
       // adds SOSs if any
       Cbc_addAllSOS(model, cbcModel);
 
+      // adds indicator constraints if any
+      Cbc_addAllIndicators(model, cbcModel);
+
+      // adds piecewise linear costs if any
+      Cbc_addAllPiecewise(model, cbcModel);
+
       // adds MIPStart if any
       Cbc_addMS(model, cbcModel);
 
@@ -2315,6 +2558,13 @@ Cbc_solve(Cbc_Model *model)
 
       Cbc_getMIPOptimizationResults( model, cbcModel );
 
+      if (model->keepSession) {
+        model->sessionPseudoNames = cbcData.pseudoCostNames_;
+        model->sessionPseudoCosts = cbcData.pseudoCosts_;
+        if (model->mipNumSavedSolutions)
+          model->sessionSolution.assign(model->x, model->x + Cbc_getNumCols(model));
+      }
+
       free(charCbcOpts);
 
       if (cbc_eh)
@@ -2333,6 +2583,128 @@ Cbc_solve(Cbc_Model *model)
   return model->mipStatus;
 }
 
+/* final values for Cbc_poll - also right when only an LP was solved.
+   obj_value is set on an iteration limit too so incumbent is only
+   taken from it if there is a solution */
+static int Cbc_solveAndPublish(Cbc_Model *model)
+{
+  int status = Cbc_solve(model);
+
+  model->asyncIncumbent = COIN_DBL_MAX;
+  if (model->lastOptimization == IntegerOptimization) {
+    model->asyncNodes = model->mipNodeCount;
+    model->asyncBestBound = model->mipBestPossibleObjValue;
+    if (model->mipNumSavedSolutions)
+      model->asyncIncumbent = model->obj_value;
+  } else if (model->lastOptimization == ContinuousOptimization
+    && model->solver_->isProvenOptimal()) {
+    model->asyncIncumbent = model->obj_value;
+    model->asyncBestBound = model->obj_value;
+  }
+  model->cancelRequested = 0;
+
+  return status;
+}
+
+#ifdef CBC_THREAD
+static void *Cbc_asyncSolve(void *arg)
+{
+  Cbc_Model *model = (Cbc_Model *)arg;
+  int status = Cbc_solveAndPublish(model);
+
+  pthread_mutex_lock(&(model->asyncMutex));
+  model->asyncStatus = status;
+  model->asyncState = 2;
+  pthread_cond_broadcast(&(model->asyncCond));
+  pthread_mutex_unlock(&(model->asyncMutex));
+
+  return NULL;
+}
+#endif
+
+int CBC_LINKAGE
+Cbc_solveAsync(Cbc_Model *model)
+{
+  if (model->asyncState == 1)
+    return -1;
+  if (model->asyncState == 2)
+    Cbc_waitFor(model, -1.0);
+
+  // flush here so the solving thread is the only one to touch the model
+  Cbc_flush(model);
+  model->asyncNodes = 0;
+  model->asyncBestBound = -COIN_DBL_MAX;
+  model->asyncIncumbent = COIN_DBL_MAX;
+  model->cancelRequested = 0;
+  model->asyncState = 1;
+#ifdef CBC_THREAD
+  if (pthread_create(&(model->asyncThread), NULL, Cbc_asyncSolve, model) == 0)
+    return 0;
+#endif
+  // no threads - solve now
+  model->asyncStatus = Cbc_solveAndPublish(model);
+  model->asyncState = 0;
+
+  return 0;
+}
+
+int CBC_LINKAGE
+Cbc_poll(Cbc_Model *model, double *bestBound, double *incumbent, int *nodes)
+{
+  if (bestBound)
+    *bestBound = model->asyncBestBound;
+  if (incumbent)
+    *incumbent = model->asyncIncumbent;
+  if (nodes)
+    *nodes = model->asyncNodes;
+
+  return (model->asyncState == 1);
+}
+
+int CBC_LINKAGE
+Cbc_waitFor(Cbc_Model *model, double seconds)
+{
+#ifdef CBC_THREAD
+  if (model->asyncState == 0)
+    return model->asyncStatus;
+
+  pthread_mutex_lock(&(model->asyncMutex));
+  if (seconds < 0.0) {
+    while (model->asyncState == 1)
+      pthread_cond_wait(&(model->asyncCond), &(model->asyncMutex));
+  } else {
+    struct timespec until;
+    clock_gettime(CLOCK_REALTIME, &until);
+    double whole = floor(seconds);
+    until.tv_sec += (time_t)whole;
+    until.tv_nsec += (long)((seconds - whole) * 1.0e9);
+    if (until.tv_nsec >= 1000000000L) {
+      until.tv_sec++;
+      until.tv_nsec -= 1000000000L;
+    }
+    while (model->asyncState == 1) {
+      if (pthread_cond_timedwait(&(model->asyncCond), &(model->asyncMutex), &until))
+        break;
+    }
+  }
+  bool finished = (model->asyncState == 2);
+  pthread_mutex_unlock(&(model->asyncMutex));
+
+  if (!finished)
+    return -1;
+  pthread_join(model->asyncThread, NULL);
+  model->asyncState = 0;
+#endif
+
+  return model->asyncStatus;
+}
+
+void CBC_LINKAGE
+Cbc_cancel(Cbc_Model *model)
+{
+  model->cancelRequested = 1;
+}
+
 void CBC_LINKAGE Cbc_addIncCallback(
     Cbc_Model *model, cbc_incumbent_callback inccb,
     void *appData )
@@ -2349,6 +2721,11 @@ void CBC_LINKAGE Cbc_addProgrCallback(
   model->pgrAppData = appData;
 }
 
+void CBC_LINKAGE Cbc_setEventNodeInterval(Cbc_Model *model, int interval)
+{
+  model->eventNodeInterval = interval > 0 ? interval : 1;
+}
+
 void CBC_LINKAGE Cbc_addCutCallback( 
     Cbc_Model *model, 
     cbc_cut_callback cutcb, 
@@ -2637,12 +3014,21 @@ Cbc_savedSolution(Cbc_Model *model, int whichSol)
         fflush(stderr);
         abort();
       }
-      return &((*model->mipSavedSolution)[whichSol][0]);
+      return VEC_PTR(model->mipSavedSolution) + (size_t)whichSol*Cbc_getNumCols(model);
   }
 
   return NULL;
 }
 
+const double *CBC_LINKAGE
+Cbc_savedSolutionPool(Cbc_Model *model)
+{
+  if (model->lastOptimization != IntegerOptimization || model->mipNumSavedSolutions == 0)
+    return NULL;
+
+  return VEC_PTR(model->mipSavedSolution);
+}
+
 double CBC_LINKAGE
 Cbc_savedSolutionObj(Cbc_Model *model, int whichSol)
 {
@@ -3008,6 +3394,14 @@ Cbc_getRowActivity(Cbc_Model *model) {
     abort();
   }
 
+  if (model->rActv == NULL && model->x != NULL
+    && model->lastOptimization == IntegerOptimization) {
+    /* first time asked for after MIP - from best solution */
+    model->mipRowActivity->resize(Cbc_getNumRows(model));
+    model->solver_->getMatrixByCol()->times(model->x, VEC_PTR(model->mipRowActivity));
+    model->rActv = VEC_PTR(model->mipRowActivity);
+  }
+
   return model->rActv;
 }
 
@@ -3019,6 +3413,14 @@ Cbc_getRowSlack(Cbc_Model *model) {
       abort();
   }
 
+  if (model->rSlk == NULL) {
+    const double *activity = Cbc_getRowActivity(model);
+    if (activity) {
+      Cbc_updateSlack(model, activity);
+      model->rSlk = VEC_PTR(model->slack);
+    }
+  }
+
   return model->rSlk;
 }
 
@@ -3129,8 +3531,8 @@ Cbc_bestSolution(Cbc_Model *model)
     case ContinuousOptimization:
       return model->solver_->getColSolution();
     case IntegerOptimization:
-      if (model->mipBestSolution)
-        return VEC_PTR(model->mipBestSolution);
+      if (model->mipNumSavedSolutions)
+        return model->x;
       else
         return NULL;
   }
@@ -3190,15 +3592,12 @@ Cbc_clone(Cbc_Model *model)
 
   result->lastOptimization = model->lastOptimization;
 
-  if (model->slack) {
-    result->slack = new vector<double>(model->slack->begin(), model->slack->end());
-  }
-  else {
-    result->slack = NULL;
-  }
+  // slacks and row activity are computed again if asked for
+  result->slack = NULL;
 
   result->icAppData = model->icAppData;
   result->pgrAppData = model->pgrAppData;
+  result->eventNodeInterval = model->eventNodeInterval;
 
   if (model->colNameIndex) {
     Cbc_storeNameIndexes(result, 1);
@@ -3210,6 +3609,11 @@ Cbc_clone(Cbc_Model *model)
 
   Cbc_iniBuffer(result);
 
+  result->keepSession = model->keepSession;
+  result->sessionPseudoNames = model->sessionPseudoNames;
+  result->sessionPseudoCosts = model->sessionPseudoCosts;
+  result->sessionSolution = model->sessionSolution;
+
   if (model->iniSol) {
     result->iniSol = new vector<double>( model->iniSol->begin(), model->iniSol->end() );
     result->iniObj = model->iniObj;
@@ -3258,10 +3662,27 @@ Cbc_clone(Cbc_Model *model)
     memcpy( result->sosElWeight, model->sosElWeight, sizeof(double)*(result->sosElSize) );
   }
 
+  /* indicators */
+  result->indColumn = model->indColumn;
+  result->indValue = model->indValue;
+  result->indLB = model->indLB;
+  result->indUB = model->indUB;
+  result->indStart = model->indStart;
+  result->indIdx = model->indIdx;
+  result->indCoef = model->indCoef;
+
+  /* piecewise linear costs */
+  result->pwX = model->pwX;
+  result->pwY = model->pwY;
+  result->pwStart = model->pwStart;
+  result->pwPx = model->pwPx;
+  result->pwPf = model->pwPf;
+
 #ifdef CBC_THREAD
   pthread_mutex_init(&(result->cbcMutexCG), NULL);
   pthread_mutex_init(&(result->cbcMutexEvent), NULL);
 #endif
+  Cbc_iniAsync(result);
 
   // copying parameters
   result->lp_method = model->lp_method;
@@ -3290,16 +3711,21 @@ Cbc_clone(Cbc_Model *model)
   result->mipNodeCount = model->mipNodeCount;
 
   if (model->mipSavedSolution) {
-    result->mipSavedSolution = new vector< vector<double> >(model->mipSavedSolution->begin(), model->mipSavedSolution->end());
+    result->mipSavedSolution = new vector<double>(model->mipSavedSolution->begin(), model->mipSavedSolution->end());
     result->mipSavedSolutionObj = new vector<double>(model->mipSavedSolutionObj->begin(), model->mipSavedSolutionObj->end());
-    result->mipBestSolution = new vector<double>(model->mipBestSolution->begin(), model->mipBestSolution->end());
-    result->mipRowActivity = new vector<double>(model->mipRowActivity->begin(), model->mipRowActivity->end());
+    result->mipRowActivity = new vector<double>();
   } else {
     result->mipSavedSolution = NULL;
     result->mipSavedSolutionObj = NULL;
-    result->mipBestSolution = NULL;
     result->mipRowActivity = NULL;
   }
+  if (result->lastOptimization == IntegerOptimization) {
+    if (result->mipNumSavedSolutions)
+      result->x = VEC_PTR(result->mipSavedSolution);
+  } else if (result->lastOptimization == ContinuousOptimization) {
+    result->x = result->solver_->getColSolution();
+    result->rActv = result->solver_->getRowActivity();
+  }
 
   return result;
 }
@@ -3340,26 +3766,14 @@ Cbc_addCol(Cbc_Model *model, const char *name, double lb,
   Cbc_addColBuffer( model, name, nz, rows, coefs,  lb, ub, obj,  isInteger );
 
   if (model->colNameIndex)
-  {
-    NameIndex &colNameIndex = *((NameIndex  *)model->colNameIndex);
-    colNameIndex[std::string(name)] = Cbc_getNumCols(model)-1;
-  }
+    ((CbcNameHash *)model->colNameIndex)->add(Cbc_getNumCols(model)-1, name);
 }
 
-/** Adds a new row */
-void CBC_LINKAGE
-Cbc_addRow(Cbc_Model *model, const char *name, int nz,
-  const int *cols, const double *coefs, char sense, double rhs)
+// row bounds from sense and right hand side
+static void senseToBounds(char sense, double rhs, double &rowLB, double &rowUB)
 {
-  if (nz == 0)
-    return;
-
-  if (nz >= 1 && model->cStart && model->cStart[model->nCols] >= 1) {
-    // new rows have reference to columns which have references to rows, flushing
-    Cbc_flush(model);
-  }
-
-  double rowLB = -DBL_MAX, rowUB = DBL_MAX;
+  rowLB = -DBL_MAX;
+  rowUB = DBL_MAX;
   switch (toupper(sense)) {
   case '=':
     rowLB = rowUB = rhs;
@@ -3383,13 +3797,98 @@ Cbc_addRow(Cbc_Model *model, const char *name, int nz,
     fprintf(stderr, "unknown row sense %c.", toupper(sense));
     abort();
   }
+}
+
+/** Adds a new row */
+void CBC_LINKAGE
+Cbc_addRow(Cbc_Model *model, const char *name, int nz,
+  const int *cols, const double *coefs, char sense, double rhs)
+{
+  if (nz == 0)
+    return;
+
+  if (nz >= 1 && model->cStart && model->cStart[model->nCols] >= 1) {
+    // new rows have reference to columns which have references to rows, flushing
+    Cbc_flush(model);
+  }
+
+  double rowLB, rowUB;
+  senseToBounds(sense, rhs, rowLB, rowUB);
 
   Cbc_addRowBuffer(model, nz, cols, coefs, rowLB, rowUB, name);
 
   if (model->rowNameIndex)
-  {
-    NameIndex &rowNameIndex = *((NameIndex  *)model->rowNameIndex);
-    rowNameIndex[std::string(name)] = Cbc_getNumRows(model)-1;
+    ((CbcNameHash *)model->rowNameIndex)->add(Cbc_getNumRows(model)-1, name);
+}
+
+/** Adds columns given in column order */
+void CBC_LINKAGE
+Cbc_addCols(Cbc_Model *model, int numCols, const char **names,
+  const double *lb, const double *ub, const double *obj,
+  const char *isInteger, const CoinBigIndex *starts,
+  const int *rows, const double *coefs)
+{
+  if (numCols <= 0)
+    return;
+
+  Cbc_flush(model);
+  OsiClpSolverInterface *solver = model->solver_;
+  int colsBefore = solver->getNumCols();
+
+  if (starts) {
+    solver->addCols(numCols, starts, rows, coefs, lb, ub, obj);
+  } else {
+    std::vector< CoinBigIndex > noStarts(numCols + 1, 0);
+    solver->addCols(numCols, &noStarts[0], rows, coefs, lb, ub, obj);
+  }
+
+  if (isInteger) {
+    for ( int i=0 ; i<numCols; ++i )
+      if (isInteger[i])
+        solver->setInteger(colsBefore+i);
+  }
+
+  CbcNameHash *colNameIndex = (CbcNameHash *)model->colNameIndex;
+  if (names) {
+    for ( int i=0 ; i<numCols; ++i ) {
+      solver->setColName(colsBefore+i, std::string(names[i]));
+      if (colNameIndex)
+        colNameIndex->add(colsBefore+i, names[i]);
+    }
+  } else if (colNameIndex) {
+    // default names
+    colNameIndex->invalidate();
+  }
+}
+
+/** Adds rows given in row order */
+void CBC_LINKAGE
+Cbc_addRows(Cbc_Model *model, int numRows, const char **names,
+  const CoinBigIndex *starts, const int *cols, const double *coefs,
+  const char *sense, const double *rhs)
+{
+  if (numRows <= 0)
+    return;
+
+  Cbc_flush(model);
+  OsiClpSolverInterface *solver = model->solver_;
+  int rowsBefore = solver->getNumRows();
+
+  std::vector< double > rowLB(numRows), rowUB(numRows);
+  for ( int i=0 ; i<numRows; ++i )
+    senseToBounds(sense[i], rhs[i], rowLB[i], rowUB[i]);
+
+  solver->addRows(numRows, starts, cols, coefs, &rowLB[0], &rowUB[0]);
+
+  CbcNameHash *rowNameIndex = (CbcNameHash *)model->rowNameIndex;
+  if (names) {
+    for ( int i=0 ; i<numRows; ++i ) {
+      solver->setRowName(rowsBefore+i, std::string(names[i]));
+      if (rowNameIndex)
+        rowNameIndex->add(rowsBefore+i, names[i]);
+    }
+  } else if (rowNameIndex) {
+    rowNameIndex->invalidate();
   }
 }
 
@@ -3438,30 +3937,32 @@ Cbc_addLazyConstraint(Cbc_Model *model, int nz,
 
 void CBC_LINKAGE
 Cbc_readMIPStart(Cbc_Model *model, const char fileName[]) {
-  std::vector< std::pair< std::string, double > > colValues;
+  Cbc_flush(model);
+  std::vector< int > colIdxs;
+  std::vector< double > colValues;
   double obj;
   CoinMessages generalMessages = model->solver_->getModelPtr()->messages();
   CoinMessageHandler *messHandler = model->solver_->messageHandler();
-  CbcMipStartIO::read(model->solver_, fileName, colValues, obj, messHandler, &generalMessages);
-  
-  char **cnames = new char*[colValues.size()];
-  size_t charSpace = 0;
-  for ( int i=0 ; (i<(int)colValues.size()) ; ++i )
-    charSpace += colValues[i].first.size() + 1;
-  cnames[0] = new char[charSpace];
-  for ( int i=1 ; (i<(int)colValues.size()) ; ++i )
-    cnames[i] = cnames[i-1] + colValues[i-1].first.size() + 1;
+  if (CbcMipStartIO::read(model->solver_, fileName, colIdxs, colValues, obj, messHandler, &generalMessages))
+    return;
 
-  double *cval = new double[colValues.size()];
-  for ( int i=0 ; (i<(int)colValues.size()) ; ++i ) {
-    cval[i] = colValues[i].second;
-    strcpy(cnames[i], colValues[i].first.c_str());
-  }
+  /* columns not in file are zero */
+  int numCols = Cbc_getNumCols(model);
+  std::vector< double > fullValues(numCols, 0.0);
+  std::vector< int > allColumns(numCols);
+  for ( int i=0 ; (i<(int)colIdxs.size()) ; ++i )
+    fullValues[colIdxs[i]] = colValues[i];
+  for ( int i=0 ; (i<numCols) ; ++i )
+    allColumns[i] = i;
+
+  Cbc_setMIPStartI(model, numCols, VEC_PTR(&allColumns), VEC_PTR(&fullValues));
+}
 
-  Cbc_setMIPStart(model, colValues.size(), (const char **) cnames, cval);
-  delete[] cnames[0];
-  delete[] cnames;
-  delete[] cval;
+int CBC_LINKAGE
+Cbc_writeMIPStartI(Cbc_Model *model, const char fileName[], int count,
+  const int colIdxs[], const double colValues[])
+{
+  return CbcMipStartIO::writeBinary(fileName, count, colIdxs, colValues, model->obj_value);
 }
 
 void CBC_LINKAGE
@@ -3511,22 +4012,10 @@ Cbc_deleteRows(Cbc_Model *model, int numRows, const int rows[])
   Cbc_flush(model);
   OsiSolverInterface *solver = model->solver_;
 
-  if (model->rowNameIndex)
-  {
-    NameIndex &rowNameIndex = *((NameIndex  *)model->rowNameIndex);
-    for ( int i=0 ; i<numRows; ++i )
-      rowNameIndex.erase(solver->getRowName(rows[i]));
-  }
-
   solver->deleteRows(numRows, rows);
 
-  if (model->rowNameIndex) {
-    int nRows = Cbc_getNumRows(model);
-    NameIndex &rowNameIndex = *((NameIndex  *)model->rowNameIndex);
-    for ( int i=0 ; i<nRows ; ++i ) {
-      rowNameIndex[solver->getRowName(i)] = i;
-    }
-  } // updating row indexes
+  if (model->rowNameIndex)
+    ((CbcNameHash *)model->rowNameIndex)->invalidate();
 }
 
 void CBC_LINKAGE
@@ -3535,23 +4024,10 @@ Cbc_deleteCols(Cbc_Model *model, int numCols, const int cols[])
   Cbc_flush(model);
   OsiSolverInterface *solver = model->solver_;
 
-  if (model->colNameIndex)
-  {
-    NameIndex &colNameIndex = *((NameIndex  *)model->colNameIndex);
-    for ( int i=0 ; i<numCols; ++i )
-      colNameIndex.erase(solver->getColName(cols[i]));
-  }
-
   solver->deleteCols(numCols, cols);
 
-  if (model->colNameIndex) {
-    int nCols = Cbc_getNumCols(model);
-    NameIndex &colNameIndex = *((NameIndex  *)model->colNameIndex);
-    for ( int i=0 ; i<nCols ; ++i ) {
-      colNameIndex[solver->getColName(i)] = i;
-    }
-  } // updating column indexes
-
+  if (model->colNameIndex)
+    ((CbcNameHash *)model->colNameIndex)->invalidate();
 }
 
 Cbc_Column Cbc_getColumn(Cbc_Model *model, int colIdx ) {
@@ -3637,6 +4113,74 @@ int CBC_LINKAGE Cbc_numberSOS(Cbc_Model *model) {
   return model->nSos;
 }
 
+/** Add indicator constraint - row only has to hold if indicator is at activeValue */
+void CBC_LINKAGE
+Cbc_addIndicator(Cbc_Model *model, int indicator, int activeValue, int nz,
+  const int *cols, const double *coefs, char sense, double rhs)
+{
+  double rowLB = -DBL_MAX, rowUB = DBL_MAX;
+  switch (toupper(sense)) {
+  case '=':
+  case 'E':
+    rowLB = rowUB = rhs;
+    break;
+  case '<':
+  case 'L':
+    rowUB = rhs;
+    break;
+  case '>':
+  case 'G':
+    rowLB = rhs;
+    break;
+  default:
+    fprintf(stderr, "unknown row sense %c.", toupper(sense));
+    abort();
+  }
+
+  if (model->indStart.empty())
+    model->indStart.push_back(0);
+  model->indColumn.push_back(indicator);
+  model->indValue.push_back(activeValue ? 1 : 0);
+  model->indLB.push_back(rowLB);
+  model->indUB.push_back(rowUB);
+  model->indIdx.insert(model->indIdx.end(), cols, cols + nz);
+  model->indCoef.insert(model->indCoef.end(), coefs, coefs + nz);
+  model->indStart.push_back((int)model->indIdx.size());
+}
+
+int CBC_LINKAGE Cbc_numberIndicators(Cbc_Model *model) {
+  return (int)model->indColumn.size();
+}
+
+/** Add piecewise linear cost - yCol must be at least f(xCol) */
+void CBC_LINKAGE
+Cbc_addPiecewise(Cbc_Model *model, int xCol, int yCol, int nPoints,
+  const double *x, const double *f)
+{
+  if (nPoints < 1) {
+    fprintf(stderr, "piecewise cost needs at least one breakpoint.");
+    abort();
+  }
+  for (int i = 1; i < nPoints; i++) {
+    if (x[i] <= x[i - 1]) {
+      fprintf(stderr, "breakpoints of piecewise cost must be increasing.");
+      abort();
+    }
+  }
+
+  if (model->pwStart.empty())
+    model->pwStart.push_back(0);
+  model->pwX.push_back(xCol);
+  model->pwY.push_back(yCol);
+  model->pwPx.insert(model->pwPx.end(), x, x + nPoints);
+  model->pwPf.insert(model->pwPf.end(), f, f + nPoints);
+  model->pwStart.push_back((int)model->pwPx.size());
+}
+
+int CBC_LINKAGE Cbc_numberPiecewise(Cbc_Model *model) {
+  return (int)model->pwX.size();
+}
+
 void CBC_LINKAGE
 Cbc_setMIPStart(Cbc_Model *model, int count, const char **colNames, const double colValues[])
 {
@@ -4582,17 +5126,17 @@ Cbc_storeNameIndexes(Cbc_Model *model, char _store)
     if (model->colNameIndex==NULL)
     {
       assert(model->rowNameIndex==NULL);
-      model->colNameIndex = new NameIndex();
-      model->rowNameIndex = new NameIndex();
+      model->colNameIndex = new CbcNameHash();
+      model->rowNameIndex = new CbcNameHash();
     }
   }
   else
   {
     if (model->colNameIndex!=NULL)
     {
-      NameIndex *m = (NameIndex *)model->colNameIndex;
+      CbcNameHash *m = (CbcNameHash *)model->colNameIndex;
       delete m;
-      m = (NameIndex *)model->rowNameIndex;
+      m = (CbcNameHash *)model->rowNameIndex;
       assert( m != NULL );
       delete m;
 
@@ -4610,12 +5154,13 @@ Cbc_getColNameIndex(Cbc_Model *model, const char *name)
     abort();
   }
 
-  NameIndex &colNameIndex = *((NameIndex  *)model->colNameIndex);
-  NameIndex::iterator it = colNameIndex.find(std::string(name));
-  if (it == colNameIndex.end())
-    return -1;
+  CbcNameHash *colNameIndex = (CbcNameHash *)model->colNameIndex;
+  if (colNameIndex->stale()) {
+    Cbc_flush(model);
+    colNameIndex->build(model->solver_, true);
+  }
 
-  return it->second;
+  return colNameIndex->find(name);
 }
 
 int CBC_LINKAGE
@@ -4627,12 +5172,13 @@ Cbc_getRowNameIndex(Cbc_Model *model, const char *name)
     abort();
   }
 
-  NameIndex &rowNameIndex = *((NameIndex  *)model->rowNameIndex);
-  NameIndex::iterator it = rowNameIndex.find(std::string(name));
-  if (it == rowNameIndex.end())
-    return -1;
+  CbcNameHash *rowNameIndex = (CbcNameHash *)model->rowNameIndex;
+  if (rowNameIndex->stale()) {
+    Cbc_flush(model);
+    rowNameIndex->build(model->solver_, false);
+  }
 
-  return it->second;
+  return rowNameIndex->find(name);
 }
 
 static char **to_char_vec( const vector< string > &names )
@@ -4704,6 +5250,66 @@ void Cbc_addAllSOS( Cbc_Model *model, CbcModel &cbcModel ) {
     delete objects[i];
 }
 
+void Cbc_addAllIndicators( Cbc_Model *model, CbcModel &cbcModel ) {
+  int nIndicators = (int)model->indColumn.size();
+  if (nIndicators == 0)
+    return;
+
+  vector< CbcObject *> objects;
+  objects.reserve( nIndicators );
+  for ( int i=0 ; i<nIndicators ; ++i ) {
+    int start = model->indStart[i];
+    int nz = model->indStart[i+1] - start;
+    objects.push_back(
+        new CbcIndicator(
+            &cbcModel,
+            model->indColumn[i],
+            model->indValue[i],
+            nz,
+            nz ? &model->indIdx[start] : NULL,
+            nz ? &model->indCoef[start] : NULL,
+            model->indLB[i],
+            model->indUB[i],
+            model->nSos + i
+          )
+        ); // add in objects
+  }
+
+  cbcModel.addObjects( (int) objects.size(), &objects[0] );
+
+  for ( int i=0 ; i<nIndicators ; ++i )
+    delete objects[i];
+}
+
+void Cbc_addAllPiecewise( Cbc_Model *model, CbcModel &cbcModel ) {
+  int nPiecewise = (int)model->pwX.size();
+  if (nPiecewise == 0)
+    return;
+
+  int firstId = model->nSos + (int)model->indColumn.size();
+  vector< CbcObject *> objects;
+  objects.reserve( nPiecewise );
+  for ( int i=0 ; i<nPiecewise ; ++i ) {
+    int start = model->pwStart[i];
+    objects.push_back(
+        new CbcPiecewise(
+            &cbcModel,
+            model->pwX[i],
+            model->pwY[i],
+            model->pwStart[i+1] - start,
+            &model->pwPx[start],
+            &model->pwPf[start],
+            firstId + i
+          )
+        ); // add in objects
+  }
+
+  cbcModel.addObjects( (int) objects.size(), &objects[0] );
+
+  for ( int i=0 ; i<nPiecewise ; ++i )
+    delete objects[i];
+}
+
 static void Cbc_addMS( Cbc_Model *model, CbcModel &cbcModel  ) {
   if ( model->nColsMS == 0 )
     return;
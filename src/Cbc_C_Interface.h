@@ -193,6 +193,7 @@ Cbc_setProblemName(Cbc_Model *model, const char *array);
 /** @brief activates/deactivates name indexes
  *
  * When name indexes are active column/row indexes can be queried fast. 
+ * Indexes are only built (as hash tables) when first searched.
  *
  * @param model problem object
  * @param store: 1 maintain indexes of column and constraints names for searching indexes, 0 not
@@ -247,6 +248,47 @@ CBCSOLVERLIB_EXPORT void CBC_LINKAGE
 Cbc_addRow(Cbc_Model *model, const char *name, int nz,
   const int *cols, const double *coefs, char sense, double rhs);
 
+/** @brief Adds several columns at once
+  *
+  * Columns are given in column ordered (CSC) format and passed to the
+  * solver in one call - much faster than Cbc_addCol for large models.
+  *
+  * @param model problem object
+  * @param numCols number of columns
+  * @param names column names, NULL for default names
+  * @param lb column lower bounds, NULL for all 0
+  * @param ub column upper bounds, NULL for all infinity
+  * @param obj objective function coefficients, NULL for all 0
+  * @param isInteger 1 for integral columns, NULL if all continuous
+  * @param starts start of each column in rows/coefs (numCols+1), NULL if no rows yet
+  * @param rows row indexes
+  * @param coefs coefficients
+  **/
+CBCSOLVERLIB_EXPORT void CBC_LINKAGE
+Cbc_addCols(Cbc_Model *model, int numCols, const char **names,
+  const double *lb, const double *ub, const double *obj,
+  const char *isInteger, const CoinBigIndex *starts,
+  const int *rows, const double *coefs);
+
+/** @brief Adds several rows at once
+  *
+  * Rows are given in row ordered (CSR) format and passed to the
+  * solver in one call - much faster than Cbc_addRow for large models.
+  *
+  * @param model problem object
+  * @param numRows number of rows
+  * @param names row names, NULL for default names
+  * @param starts start of each row in cols/coefs (numRows+1)
+  * @param cols column indexes
+  * @param coefs coefficients
+  * @param sense constraint sense of each row: L if <=, G if >= and E if =
+  * @param rhs right hand side of each row
+  **/
+CBCSOLVERLIB_EXPORT void CBC_LINKAGE
+Cbc_addRows(Cbc_Model *model, int numRows, const char **names,
+  const CoinBigIndex *starts, const int *cols, const double *coefs,
+  const char *sense, const double *rhs);
+
 
 /** @brief Adds a lazy constraint
  *
@@ -278,6 +320,51 @@ Cbc_addSOS(Cbc_Model *model, int numRows, const int *rowStarts,
 /** @brief Queries the number os SOS objects */
 CBCSOLVERLIB_EXPORT int CBC_LINKAGE Cbc_numberSOS(Cbc_Model *model);
 
+/** @brief Add indicator constraint
+ *
+ * If binary column indicator is at activeValue (0 or 1) then the row
+ * given as in Cbc_addRow must hold, otherwise it is free.  The row is
+ * not added to the LP, so no big-M coefficient is needed - it is
+ * enforced by branching (see CbcIndicator).
+ *
+ * @param model problem object
+ * @param indicator index of binary column
+ * @param activeValue value of indicator for which row must hold
+ * @param nz number of non-zeros in row
+ * @param cols index of columns in row
+ * @param coefs coefficients of columns in row
+ * @param sense row sense: L, G or E
+ * @param rhs right hand side
+ **/
+CBCSOLVERLIB_EXPORT void CBC_LINKAGE
+Cbc_addIndicator(Cbc_Model *model, int indicator, int activeValue, int nz,
+  const int *cols, const double *coefs, char sense, double rhs);
+
+/** @brief Queries the number of indicator constraints */
+CBCSOLVERLIB_EXPORT int CBC_LINKAGE Cbc_numberIndicators(Cbc_Model *model);
+
+/** @brief Add piecewise linear cost
+ *
+ * Column yCol must be at least f(xCol) where f is piecewise linear
+ * through breakpoints (x[i],f[i]).  No SOS2 columns or rows are
+ * added - envelope cuts and branching on xCol are done by the
+ * solver (see CbcPiecewise).  Give yCol a positive objective
+ * coefficient and bound xCol by the first and last breakpoints.
+ *
+ * @param model problem object
+ * @param xCol index of argument column
+ * @param yCol index of cost column
+ * @param nPoints number of breakpoints
+ * @param x breakpoints in increasing order
+ * @param f value of function at breakpoints
+ **/
+CBCSOLVERLIB_EXPORT void CBC_LINKAGE
+Cbc_addPiecewise(Cbc_Model *model, int xCol, int yCol, int nPoints,
+  const double *x, const double *f);
+
+/** @brief Queries the number of piecewise linear costs */
+CBCSOLVERLIB_EXPORT int CBC_LINKAGE Cbc_numberPiecewise(Cbc_Model *model);
+
 /** Loads a problem (the constraints on the
     rows are given by lower and upper bounds). If a pointer is NULL then the
     following values are the default:
@@ -444,7 +531,8 @@ Cbc_setMIPStartI(Cbc_Model *model, int count, const int colIdxs[], const double
   * Reads an initial feasible solution from a file. The file format
   * is the same used as output by CBC. In the case of a Mixed-Integer
   * Linear Program only the non-zero integer/binary variables need to 
-  * be informed.
+  * be informed.  Files written by Cbc_writeMIPStartI (binary, by
+  * column index) are also accepted.
   *
   * @param model problem object 
   * @param fileName problem object 
@@ -452,6 +540,23 @@ Cbc_setMIPStartI(Cbc_Model *model, int count, const int colIdxs[], const double
 CBCSOLVERLIB_EXPORT void CBC_LINKAGE
 Cbc_readMIPStart(Cbc_Model *model, const char fileName[]);
 
+/** @brief Writes an initial solution by column indexes to a binary file
+  *
+  * Columns are stored by index so no names are written or searched
+  * when read back by Cbc_readMIPStart or the mipstart command.  The
+  * objective value of the last solution found is stored.
+  *
+  * @param model problem object
+  * @param fileName file name
+  * @param count number of variables
+  * @param colIdxs indexes of variables
+  * @param colValues variable values
+  * @return 0 if written, 1 otherwise
+  **/
+CBCSOLVERLIB_EXPORT int CBC_LINKAGE
+Cbc_writeMIPStartI(Cbc_Model *model, const char fileName[], int count,
+  const int colIdxs[], const double colValues[]);
+
 /** @brief Creates a copy of the current model 
   *
   * @param model problem object 
@@ -791,6 +896,27 @@ Cbc_nFeatures();
  CBCSOLVERLIB_EXPORT const char * CBC_LINKAGE
  Cbc_featureName(int i);
 
+/** @brief Computes vector of quick instance features
+  *
+  * As Cbc_computeFeatures but with the features of CbcFeatures, which
+  * only look at bounds, types and the matrix (no LP is solved) in passes
+  * linear in the number of nonzeros, so can be used before every solve
+  * to choose parameters and threads.
+  *
+  * @param model problem object
+  * @param features vector of size Cbc_nQuickFeatures() that will be filled
+  **/
+CBCSOLVERLIB_EXPORT void CBC_LINKAGE
+Cbc_computeQuickFeatures(Cbc_Model *model, double *features);
+
+/** @brief Returns the number of quick instance features */
+CBCSOLVERLIB_EXPORT int CBC_LINKAGE
+Cbc_nQuickFeatures();
+
+/** @brief Name of the i-th quick instance feature */
+CBCSOLVERLIB_EXPORT const char * CBC_LINKAGE
+Cbc_quickFeatureName(int i);
+
 /** @brief Returns the conflict graph of the model
  *
  * Returns the conflict graph of the model, if it returns NULL or 
@@ -844,6 +970,30 @@ Cbc_readBasis(Cbc_Model *model, const char *filename);
 CBCSOLVERLIB_EXPORT void CBC_LINKAGE
 Cbc_writeMps(Cbc_Model *model, const char *filename);
 
+/** @brief Read a binary snapshot written by Cbc_writeSnapshot
+  *
+  * Arrays are used straight from the (memory mapped) file so this is
+  * much faster than reading an MPS file.  SOS and MIP start saved with
+  * the model are restored.
+  *
+  * @param model problem object
+  * @param fileName file name
+  * @return 0 if fine, -1 if file could not be opened, -2 if not a snapshot
+  **/
+CBCSOLVERLIB_EXPORT int CBC_LINKAGE
+Cbc_readSnapshot(Cbc_Model *model, const char *filename);
+
+/** @brief Write a binary snapshot of the model (with SOS and MIP start)
+  *
+  * Snapshots are only meant to be read on the same kind of machine.
+  *
+  * @param model problem object
+  * @param fileName file name
+  * @return 0 if fine, -1 if file could not be written
+  **/
+CBCSOLVERLIB_EXPORT int CBC_LINKAGE
+Cbc_writeSnapshot(Cbc_Model *model, const char *filename);
+
 /** @brief Write an LP file from the given filename 
   *
   * @param model problem object
@@ -894,6 +1044,16 @@ Cbc_supportsBzip2();
 CBCSOLVERLIB_EXPORT void CBC_LINKAGE
 Cbc_setInitialSolution(Cbc_Model *model, const double *sol);
 
+/** Keep a session between calls of Cbc_solve for related problems
+     (same columns, changed bounds or objective).  The LP basis of the
+     model is always kept; with keep nonzero pseudocosts learnt are
+     given to the next branch and bound and the best solution is tried
+     (and checked) as initial solution unless one is given.  keep 0
+     forgets what is kept.
+    */
+CBCSOLVERLIB_EXPORT void CBC_LINKAGE
+Cbc_setKeepSession(Cbc_Model *model, char keep);
+
 /** "Column start" vector of constraint matrix. Same format as Cbc_loadProblem() */
 CBCSOLVERLIB_EXPORT const CoinBigIndex *CBC_LINKAGE
 Cbc_getVectorStarts(Cbc_Model *model);
@@ -1103,7 +1263,10 @@ Cbc_clearCallBack(Cbc_Model *model);
  * @param howOften 1 if the cut generator should be called at every node, > 1 at every howOften nodes negative
  *        values have the same meaning but in this case the cut generator may be disable if not bound improvement
  *        was obtained with these cuts. -99 for cut generators that will be called only at the root node
- * @param atSolution if the cut generator must to be called also when an integer solution if found (=1) or zero otherwise
+ * @param atSolution if the cut generator must to be called also when an integer solution if found (=1) or zero otherwise.
+ *        With 1 rows generated are taken as (lazy) constraints of the problem: they are kept in a pool
+ *        checked first so the callback is only called when no row already found is violated, and
+ *        only violated rows are added to the LP
  **/
 CBCSOLVERLIB_EXPORT void CBC_LINKAGE Cbc_addCutCallback( 
     Cbc_Model *model, 
@@ -1124,12 +1287,22 @@ CBCSOLVERLIB_EXPORT void CBC_LINKAGE Cbc_addProgrCallback(
   Cbc_Model *model, cbc_progress_callback prgcbc,
   void *appData);
 
+/** callbacks (and Cbc_poll of an asynchronous solve) see node
+ * events only every interval nodes (default 1) - less overhead
+ * on problems with many cheap nodes */
+CBCSOLVERLIB_EXPORT void CBC_LINKAGE Cbc_setEventNodeInterval(
+  Cbc_Model *model, int interval);
+
 /*@}*/
 
 /**@name Solving the model */
 /*@{*/
 
 /** @brief Solves the model with CBC
+   *
+   * Separate models may be solved at the same time on different
+   * threads (a model must only be used by one thread at a time).
+   * On Windows this needs a build with thread support (CBC_THREAD).
    *
    * @param model problem object
    * @return execution status, for MIPs: 
@@ -1142,6 +1315,50 @@ CBCSOLVERLIB_EXPORT void CBC_LINKAGE Cbc_addProgrCallback(
 CBCSOLVERLIB_EXPORT int CBC_LINKAGE
 Cbc_solve(Cbc_Model *model);
 
+/** @brief Starts Cbc_solve on a thread of its own and returns at once
+   *
+   * Until Cbc_waitFor reports the solve finished only Cbc_poll,
+   * Cbc_waitFor and Cbc_cancel may be called for the model.  Without
+   * thread support the model is solved before returning.
+   *
+   * @param model problem object
+   * @return 0 if started, -1 if a solve of this model is still running
+   **/
+CBCSOLVERLIB_EXPORT int CBC_LINKAGE
+Cbc_solveAsync(Cbc_Model *model);
+
+/** @brief Progress of an asynchronous solve
+   *
+   * Values are plain copies published by the solving thread at each
+   * node (no locks are taken) and are final once the solve finished.
+   * Any pointer may be NULL.
+   *
+   * @param model problem object
+   * @param bestBound best possible objective value found so far
+   * @param incumbent objective value of best solution (COIN_DBL_MAX if none)
+   * @param nodes number of nodes explored
+   * @return 1 if solve still running, 0 otherwise
+   **/
+CBCSOLVERLIB_EXPORT int CBC_LINKAGE
+Cbc_poll(Cbc_Model *model, double *bestBound, double *incumbent, int *nodes);
+
+/** @brief Waits for an asynchronous solve to finish
+   *
+   * @param model problem object
+   * @param seconds longest time to wait, negative to wait until finished
+   * @return -1 if still running, otherwise what Cbc_solve returned
+   **/
+CBCSOLVERLIB_EXPORT int CBC_LINKAGE
+Cbc_waitFor(Cbc_Model *model, double seconds);
+
+/** @brief Asks an asynchronous solve to stop as soon as possible
+   *
+   * The best solution found so far is kept; Cbc_waitFor still
+   * has to be called to end the solve.
+   **/
+CBCSOLVERLIB_EXPORT void CBC_LINKAGE
+Cbc_cancel(Cbc_Model *model);
+
 /** @brief Solves only the linear programming relaxation
   *
   * @param model problem object
@@ -1247,6 +1464,19 @@ Cbc_savedSolution(Cbc_Model *model, int whichSol);
 CBCSOLVERLIB_EXPORT double CBC_LINKAGE
 Cbc_savedSolutionObj(Cbc_Model *model, int whichSol);
 
+/** @brief All saved solutions in one block, no copy made
+  *
+  * Solution i starts at position i*Cbc_getNumCols(); the first is
+  * the best solution.  Pointer (as the one of Cbc_savedSolution and
+  * Cbc_getColSolution) stays valid until the model is changed or
+  * solved again.
+  *
+  * @param model problem object
+  * @return Cbc_numberSavedSolutions solutions, NULL if none
+  **/
+CBCSOLVERLIB_EXPORT const double *CBC_LINKAGE
+Cbc_savedSolutionPool(Cbc_Model *model);
+
 /** @brief Queries vector of reduced costs
   *
   * @param model problem object
@@ -1374,13 +1604,15 @@ Cbc_isInitialSolveProvenPrimalInfeasible(Cbc_Model *model);
 
 /** "row" solution
   *  This is the vector A*x, where A is the constraint matrix
-  *  and x is the current solution. */
+  *  and x is the current solution.  After a MIP it is only
+  *  computed the first time it is asked for. */
 CBCSOLVERLIB_EXPORT const double *CBC_LINKAGE
 Cbc_getRowActivity(Cbc_Model *model);
 
  /** Row slack
   *
-  *  Returns the vector of row slacks
+  *  Returns the vector of row slacks, computed the first time
+  *  it is asked for after a solve
   *  
   *  @param model problem object
   *  @return vector with row slacks
@@ -9,6 +9,7 @@
 #include "CoinTime.hpp"
 #include "CoinHelperFunctions.hpp"
 #include "CoinIndexedVector.hpp"
+#include "CbcSimpleInteger.hpp"
 
 /*
   Default solver configuration: In any environment, clp is the default if you
@@ -253,21 +254,25 @@ std::vector< double * > OsiCbcSolverInterface::getPrimalRays(int maxNumRays) con
 //#############################################################################
 void OsiCbcSolverInterface::setContinuous(int index)
 {
+  changes_ |= OsiCbcOtherChange;
   modelPtr_->solver()->setContinuous(index);
 }
 //-----------------------------------------------------------------------------
 void OsiCbcSolverInterface::setInteger(int index)
 {
+  changes_ |= OsiCbcOtherChange;
   modelPtr_->solver()->setInteger(index);
 }
 //-----------------------------------------------------------------------------
 void OsiCbcSolverInterface::setContinuous(const int *indices, int len)
 {
+  changes_ |= OsiCbcOtherChange;
   modelPtr_->solver()->setContinuous(indices, len);
 }
 //-----------------------------------------------------------------------------
 void OsiCbcSolverInterface::setInteger(const int *indices, int len)
 {
+  changes_ |= OsiCbcOtherChange;
   modelPtr_->solver()->setInteger(indices, len);
 }
 //-----------------------------------------------------------------------------
@@ -288,6 +293,7 @@ void OsiCbcSolverInterface::addCol(const CoinPackedVectorBase &vec,
   const double collb, const double colub,
   const double obj)
 {
+  changes_ |= OsiCbcColumnsAdded;
   modelPtr_->solver()->addCol(vec, collb, colub, obj);
 }
 /* Add a column (primal variable) to the problem. */
@@ -295,6 +301,7 @@ void OsiCbcSolverInterface::addCol(int numberElements, const int *rows, const do
   const double collb, const double colub,
   const double obj)
 {
+  changes_ |= OsiCbcColumnsAdded;
   modelPtr_->solver()->addCol(numberElements, rows, elements,
     collb, colub, obj);
 }
@@ -304,17 +311,20 @@ void OsiCbcSolverInterface::addCols(const int numcols,
   const double *collb, const double *colub,
   const double *obj)
 {
+  changes_ |= OsiCbcColumnsAdded;
   modelPtr_->solver()->addCols(numcols, cols, collb, colub, obj);
 }
 //-----------------------------------------------------------------------------
 void OsiCbcSolverInterface::deleteCols(const int num, const int *columnIndices)
 {
+  changes_ |= OsiCbcOtherChange;
   modelPtr_->solver()->deleteCols(num, columnIndices);
 }
 //-----------------------------------------------------------------------------
 void OsiCbcSolverInterface::addRow(const CoinPackedVectorBase &vec,
   const double rowlb, const double rowub)
 {
+  changes_ |= OsiCbcRowsChanged;
   modelPtr_->solver()->addRow(vec, rowlb, rowub);
 }
 //-----------------------------------------------------------------------------
@@ -322,6 +332,7 @@ void OsiCbcSolverInterface::addRow(const CoinPackedVectorBase &vec,
   const char rowsen, const double rowrhs,
   const double rowrng)
 {
+  changes_ |= OsiCbcRowsChanged;
   modelPtr_->solver()->addRow(vec, rowsen, rowrhs, rowrng);
 }
 //-----------------------------------------------------------------------------
@@ -329,6 +340,7 @@ void OsiCbcSolverInterface::addRows(const int numrows,
   const CoinPackedVectorBase *const *rows,
   const double *rowlb, const double *rowub)
 {
+  changes_ |= OsiCbcRowsChanged;
   modelPtr_->solver()->addRows(numrows, rows, rowlb, rowub);
 }
 //-----------------------------------------------------------------------------
@@ -337,11 +349,13 @@ void OsiCbcSolverInterface::addRows(const int numrows,
   const char *rowsen, const double *rowrhs,
   const double *rowrng)
 {
+  changes_ |= OsiCbcRowsChanged;
   modelPtr_->solver()->addRows(numrows, rows, rowsen, rowrhs, rowrng);
 }
 //-----------------------------------------------------------------------------
 void OsiCbcSolverInterface::deleteRows(const int num, const int *rowIndices)
 {
+  changes_ |= OsiCbcRowsChanged;
   modelPtr_->solver()->deleteRows(num, rowIndices);
 }
 
@@ -354,6 +368,7 @@ void OsiCbcSolverInterface::loadProblem(const CoinPackedMatrix &matrix,
   const double *obj,
   const double *rowlb, const double *rowub)
 {
+  changes_ |= OsiCbcOtherChange;
   modelPtr_->solver()->loadProblem(matrix, collb, colub, obj, rowlb, rowub);
 }
 
@@ -364,6 +379,7 @@ void OsiCbcSolverInterface::assignProblem(CoinPackedMatrix *&matrix,
   double *&obj,
   double *&rowlb, double *&rowub)
 {
+  changes_ |= OsiCbcOtherChange;
   modelPtr_->solver()->assignProblem(matrix, collb, colub, obj, rowlb, rowub);
 }
 
@@ -375,6 +391,7 @@ void OsiCbcSolverInterface::loadProblem(const CoinPackedMatrix &matrix,
   const char *rowsen, const double *rowrhs,
   const double *rowrng)
 {
+  changes_ |= OsiCbcOtherChange;
   modelPtr_->solver()->loadProblem(matrix, collb, colub, obj, rowsen, rowrhs, rowrng);
 }
 
@@ -386,6 +403,7 @@ void OsiCbcSolverInterface::assignProblem(CoinPackedMatrix *&matrix,
   char *&rowsen, double *&rowrhs,
   double *&rowrng)
 {
+  changes_ |= OsiCbcOtherChange;
   modelPtr_->solver()->assignProblem(matrix, collb, colub, obj, rowsen, rowrhs, rowrng);
 }
 
@@ -398,6 +416,7 @@ void OsiCbcSolverInterface::loadProblem(const int numcols, const int numrows,
   const double *obj,
   const double *rowlb, const double *rowub)
 {
+  changes_ |= OsiCbcOtherChange;
   modelPtr_->solver()->loadProblem(numcols, numrows, start, index, value,
     collb, colub, obj, rowlb, rowub);
 }
@@ -411,6 +430,7 @@ void OsiCbcSolverInterface::loadProblem(const int numcols, const int numrows,
   const char *rowsen, const double *rowrhs,
   const double *rowrng)
 {
+  changes_ |= OsiCbcOtherChange;
   modelPtr_->solver()->loadProblem(numcols, numrows, start, index, value,
     collb, colub, obj, rowsen, rowrhs, rowrng);
 }
@@ -456,6 +476,9 @@ OsiCbcSolverInterface::OsiCbcSolverInterface(OsiSolverInterface *solver,
     CbcStrategyDefault defaultStrategy;
     modelPtr_->setStrategy(defaultStrategy);
   }
+  changes_ = 0;
+  lastNumberColumns_ = modelPtr_->solver()->getNumCols();
+  cutoff_ = COIN_DBL_MAX;
 }
 
 //-------------------------------------------------------------------
@@ -479,6 +502,9 @@ OsiCbcSolverInterface::OsiCbcSolverInterface(
 {
   assert(rhs.modelPtr_);
   modelPtr_ = new CbcModel(*rhs.modelPtr_);
+  changes_ = rhs.changes_;
+  lastNumberColumns_ = rhs.lastNumberColumns_;
+  cutoff_ = rhs.cutoff_;
 }
 
 //-------------------------------------------------------------------
@@ -499,6 +525,9 @@ OsiCbcSolverInterface::operator=(const OsiCbcSolverInterface &rhs)
     OsiSolverInterface::operator=(rhs);
     delete modelPtr_;
     modelPtr_ = new CbcModel(*rhs.modelPtr_);
+    changes_ = rhs.changes_;
+    lastNumberColumns_ = rhs.lastNumberColumns_;
+    cutoff_ = rhs.cutoff_;
   }
   return *this;
 }
@@ -509,6 +538,7 @@ OsiCbcSolverInterface::operator=(const OsiCbcSolverInterface &rhs)
 
 void OsiCbcSolverInterface::applyRowCut(const OsiRowCut &rowCut)
 {
+  changes_ |= OsiCbcRowsChanged;
   modelPtr_->solver()->applyRowCuts(1, &rowCut);
 }
 /* Apply a collection of row cuts which are all effective.
@@ -516,6 +546,7 @@ void OsiCbcSolverInterface::applyRowCut(const OsiRowCut &rowCut)
 */
 void OsiCbcSolverInterface::applyRowCuts(int numberCuts, const OsiRowCut *cuts)
 {
+  changes_ |= OsiCbcRowsChanged;
   modelPtr_->solver()->applyRowCuts(numberCuts, cuts);
 }
 /* Apply a collection of row cuts which are all effective.
@@ -523,6 +554,7 @@ void OsiCbcSolverInterface::applyRowCuts(int numberCuts, const OsiRowCut *cuts)
 */
 void OsiCbcSolverInterface::applyRowCuts(int numberCuts, const OsiRowCut **cuts)
 {
+  changes_ |= OsiCbcRowsChanged;
   modelPtr_->solver()->applyRowCuts(numberCuts, cuts);
 }
 //-----------------------------------------------------------------------------
@@ -539,12 +571,14 @@ void OsiCbcSolverInterface::applyColCut(const OsiColCut &cc)
     int iCol = lbs.getIndices()[i];
     double value = lbs.getElements()[i];
     if (value > lower[iCol])
+      changes_ |= OsiCbcBoundsChanged;
       modelPtr_->solver()->setColLower(iCol, value);
   }
   for (i = 0; i < ubs.getNumElements(); i++) {
     int iCol = ubs.getIndices()[i];
     double value = ubs.getElements()[i];
     if (value < upper[iCol])
+      changes_ |= OsiCbcBoundsChanged;
       modelPtr_->solver()->setColUpper(iCol, value);
   }
 }
@@ -553,6 +587,7 @@ void OsiCbcSolverInterface::applyColCut(const OsiColCut &cc)
 int OsiCbcSolverInterface::readMps(const char *filename,
   const char *extension)
 {
+  changes_ |= OsiCbcOtherChange;
   return modelPtr_->solver()->readMps(filename, extension);
 }
 // Get pointer to array[getNumCols()] of primal solution vector
@@ -592,6 +627,7 @@ OsiCbcSolverInterface::getObjValue() const
 /* Set an objective function coefficient */
 void OsiCbcSolverInterface::setObjCoeff(int elementIndex, double elementValue)
 {
+  changes_ |= OsiCbcObjectiveChanged;
   modelPtr_->solver()->setObjCoeff(elementIndex, elementValue);
 }
 
@@ -599,6 +635,7 @@ void OsiCbcSolverInterface::setObjCoeff(int elementIndex, double elementValue)
    Use -DBL_MAX for -infinity. */
 void OsiCbcSolverInterface::setColLower(int elementIndex, double elementValue)
 {
+  changes_ |= OsiCbcBoundsChanged;
   modelPtr_->solver()->setColLower(elementIndex, elementValue);
 }
 
@@ -606,6 +643,7 @@ void OsiCbcSolverInterface::setColLower(int elementIndex, double elementValue)
    Use DBL_MAX for infinity. */
 void OsiCbcSolverInterface::setColUpper(int elementIndex, double elementValue)
 {
+  changes_ |= OsiCbcBoundsChanged;
   modelPtr_->solver()->setColUpper(elementIndex, elementValue);
 }
 
@@ -613,12 +651,14 @@ void OsiCbcSolverInterface::setColUpper(int elementIndex, double elementValue)
 void OsiCbcSolverInterface::setColBounds(int elementIndex,
   double lower, double upper)
 {
+  changes_ |= OsiCbcBoundsChanged;
   modelPtr_->solver()->setColBounds(elementIndex, lower, upper);
 }
 void OsiCbcSolverInterface::setColSetBounds(const int *indexFirst,
   const int *indexLast,
   const double *boundList)
 {
+  changes_ |= OsiCbcBoundsChanged;
   modelPtr_->solver()->setColSetBounds(indexFirst, indexLast, boundList);
 }
 //------------------------------------------------------------------
@@ -626,6 +666,7 @@ void OsiCbcSolverInterface::setColSetBounds(const int *indexFirst,
    Use -DBL_MAX for -infinity. */
 void OsiCbcSolverInterface::setRowLower(int elementIndex, double elementValue)
 {
+  changes_ |= OsiCbcBoundsChanged;
   modelPtr_->solver()->setRowLower(elementIndex, elementValue);
 }
 
@@ -633,6 +674,7 @@ void OsiCbcSolverInterface::setRowLower(int elementIndex, double elementValue)
    Use DBL_MAX for infinity. */
 void OsiCbcSolverInterface::setRowUpper(int elementIndex, double elementValue)
 {
+  changes_ |= OsiCbcBoundsChanged;
   modelPtr_->solver()->setRowUpper(elementIndex, elementValue);
 }
 
@@ -640,12 +682,14 @@ void OsiCbcSolverInterface::setRowUpper(int elementIndex, double elementValue)
 void OsiCbcSolverInterface::setRowBounds(int elementIndex,
   double lower, double upper)
 {
+  changes_ |= OsiCbcBoundsChanged;
   modelPtr_->solver()->setRowBounds(elementIndex, lower, upper);
 }
 //-----------------------------------------------------------------------------
 void OsiCbcSolverInterface::setRowType(int i, char sense, double rightHandSide,
   double range)
 {
+  changes_ |= OsiCbcBoundsChanged;
   modelPtr_->solver()->setRowType(i, sense, rightHandSide, range);
 }
 //-----------------------------------------------------------------------------
@@ -653,6 +697,7 @@ void OsiCbcSolverInterface::setRowSetBounds(const int *indexFirst,
   const int *indexLast,
   const double *boundList)
 {
+  changes_ |= OsiCbcBoundsChanged;
   modelPtr_->solver()->setRowSetBounds(indexFirst, indexLast, boundList);
 }
 //-----------------------------------------------------------------------------
@@ -662,6 +707,7 @@ void OsiCbcSolverInterface::setRowSetTypes(const int *indexFirst,
   const double *rhsList,
   const double *rangeList)
 {
+  changes_ |= OsiCbcBoundsChanged;
   modelPtr_->solver()->setRowSetTypes(indexFirst, indexLast, senseList, rhsList, rangeList);
 }
 // Set a hint parameter
@@ -741,6 +787,7 @@ int OsiCbcSolverInterface::getIterationCount() const
 }
 void OsiCbcSolverInterface::setObjSense(double s)
 {
+  changes_ |= OsiCbcObjectiveChanged;
   modelPtr_->setObjSense(s);
 }
 // Invoke solver's built-in enumeration algorithm
@@ -750,7 +797,39 @@ void OsiCbcSolverInterface::branchAndBound()
     *messageHandler() << "Warning: Use of OsiCbc is deprecated." << CoinMessageEol;
     *messageHandler() << "To enjoy the full performance of Cbc, use the CbcSolver interface." << CoinMessageEol;
   }
+  /*
+    The same model is used for every call so objects (with pseudo costs),
+    cut generators and heuristics are kept.  If the problem changed since
+    the last search forget its solutions and tree (they may not be valid)
+    and only redo objects if integer columns are out of date.
+  */
+  if (changes_ && modelPtr_->status() != -1) {
+    modelPtr_->resetModel();
+    modelPtr_->setCutoff(cutoff_);
+  }
+  if (modelPtr_->numberObjects()) {
+    if ((changes_ & OsiCbcOtherChange) != 0) {
+      modelPtr_->findIntegers(true);
+    } else if ((changes_ & OsiCbcColumnsAdded) != 0) {
+      // just add objects for new integer columns
+      OsiSolverInterface *solver = modelPtr_->solver();
+      int numberColumns = solver->getNumCols();
+      std::vector< OsiObject * > objects;
+      for (int iColumn = lastNumberColumns_; iColumn < numberColumns; iColumn++) {
+        if (solver->isInteger(iColumn))
+          objects.push_back(new CbcSimpleInteger(modelPtr_, iColumn));
+      }
+      int numberNew = static_cast< int >(objects.size());
+      if (numberNew) {
+        modelPtr_->addObjects(numberNew, &objects[0]);
+        for (int i = 0; i < numberNew; i++)
+          delete objects[i];
+      }
+    }
+  }
+  changes_ = 0;
   modelPtr_->branchAndBound();
+  lastNumberColumns_ = modelPtr_->solver()->getNumCols();
 }
 
 /*
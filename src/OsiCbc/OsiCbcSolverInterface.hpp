@@ -670,6 +670,7 @@ public:
   /// Set cutoff bound on the objective function.
   inline void setCutoff(double value)
   {
+    cutoff_ = value;
     modelPtr_->setCutoff(value);
   }
   /// Get the cutoff bound on the objective function - always as minimize
@@ -778,7 +779,24 @@ protected:
   //@{
   /// Cbc model represented by this class instance
   mutable CbcModel *modelPtr_;
+  /** Changes to problem since last branchAndBound.  The model (objects,
+      cut generators and heuristics) is kept between calls and only what
+      the changes make out of date is redone */
+  int changes_;
+  /// Number of columns at end of last branchAndBound
+  int lastNumberColumns_;
+  /// Cutoff set by user (kept when model reset for next branchAndBound)
+  double cutoff_;
   //@}
+  /// Bits in changes_
+  enum {
+    OsiCbcBoundsChanged = 1,
+    OsiCbcObjectiveChanged = 2,
+    OsiCbcColumnsAdded = 4,
+    OsiCbcRowsChanged = 8,
+    /// integrality, columns deleted or new problem
+    OsiCbcOtherChange = 16
+  };
 };
 // So unit test can find out if NDEBUG set
 OSICBCLIB_EXPORT
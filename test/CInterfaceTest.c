@@ -16,6 +16,10 @@
 #define INFINITY (HUGE_VAL * 2)
 #endif
 
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
 
 static int callback_called = 0;
 
@@ -100,6 +104,12 @@ void testKnapsack() {
     assert(fabs(sol[3] - 1.0) < 1e-6);
     assert(fabs(sol[4] - 1.0) < 1e-6);
 
+    /* best solution is first of pool, row activity from it */
+    assert(Cbc_numberSavedSolutions(model) >= 1);
+    assert(Cbc_savedSolutionPool(model) == sol);
+    assert(fabs(Cbc_getRowActivity(model)[0] - 9.0) < 1e-6);
+    assert(fabs(Cbc_getRowSlack(model)[0] - 1.0) < 1e-6);
+
     Cbc_problemName(model, 20, getname);
     i = strcmp(getname,setname);
     assert( (i == 0) );
@@ -1083,6 +1093,148 @@ void testTSPUlysses22( char lazy ) {
     Cbc_deleteModel(m);
 }
 
+/* multi dimensional knapsack with data from seed - added in blocks */
+static Cbc_Model *buildKnapsack(int seed) {
+    enum { nItems = 40, nRows = 3 };
+    unsigned int r = (unsigned int) seed * 2654435761u + 1;
+    double obj[nItems], lb[nItems], ub[nItems], coef[nItems*nRows];
+    char isInteger[nItems];
+    char names[nItems][16];
+    const char *colNames[nItems];
+    CoinBigIndex starts[nRows+1];
+    int cols[nItems*nRows];
+    char sense[nRows];
+    double rhs[nRows];
+
+    Cbc_Model *model = Cbc_newModel();
+    Cbc_storeNameIndexes(model, 1);
+    Cbc_setLogLevel(model, 0);
+    for ( int j=0 ; j<nItems ; ++j ) {
+        r = r * 1103515245u + 12345u;
+        obj[j] = 10 + (r >> 16) % 90;
+        lb[j] = 0.0;
+        ub[j] = 1.0;
+        isInteger[j] = 1;
+        sprintf(names[j], "x%d", j);
+        colNames[j] = names[j];
+    }
+    Cbc_addCols(model, nItems, colNames, lb, ub, obj, isInteger, NULL, NULL, NULL);
+    for ( int i=0 ; i<nRows ; ++i ) {
+        double sum = 0.0;
+        starts[i] = i*nItems;
+        for ( int j=0 ; j<nItems ; ++j ) {
+            r = r * 1103515245u + 12345u;
+            cols[i*nItems+j] = j;
+            coef[i*nItems+j] = 5 + (r >> 16) % 45;
+            sum += coef[i*nItems+j];
+        }
+        sense[i] = 'L';
+        rhs[i] = floor(sum / 2);
+    }
+    starts[nRows] = nRows*nItems;
+    Cbc_addRows(model, nRows, NULL, starts, cols, coef, sense, rhs);
+    Cbc_setObjSense(model, -1);
+    assert(Cbc_getColNameIndex(model, "x17") == 17);
+    return model;
+}
+
+#ifndef _WIN32
+enum { concurrentThreads = 8, concurrentModels = 32 };
+
+typedef struct {
+    int first;
+    double *obj;
+} ConcurrentJob;
+
+static void *solveKnapsacks(void *arg) {
+    ConcurrentJob *job = (ConcurrentJob *) arg;
+    for ( int k=job->first ; k<concurrentModels ; k += concurrentThreads ) {
+        Cbc_Model *model = buildKnapsack(k);
+        Cbc_solve(model);
+        assert(Cbc_isProvenOptimal(model));
+        job->obj[k] = Cbc_getObjValue(model);
+        Cbc_deleteModel(model);
+    }
+    return NULL;
+}
+
+/* separate models solved at same time on threads must give
+   same answers as when solved one after another */
+void testConcurrentSolves() {
+    double expected[concurrentModels], obj[concurrentModels];
+    pthread_t threads[concurrentThreads];
+    ConcurrentJob jobs[concurrentThreads];
+
+    for ( int k=0 ; k<concurrentModels ; ++k ) {
+        Cbc_Model *model = buildKnapsack(k);
+        Cbc_solve(model);
+        assert(Cbc_isProvenOptimal(model));
+        expected[k] = Cbc_getObjValue(model);
+        Cbc_deleteModel(model);
+    }
+
+    for ( int round=0 ; round<3 ; ++round ) {
+        for ( int t=0 ; t<concurrentThreads ; ++t ) {
+            jobs[t].first = t;
+            jobs[t].obj = obj;
+            assert(pthread_create(&threads[t], NULL, solveKnapsacks, &jobs[t]) == 0);
+        }
+        for ( int t=0 ; t<concurrentThreads ; ++t )
+            pthread_join(threads[t], NULL);
+        for ( int k=0 ; k<concurrentModels ; ++k )
+            assert(fabs(obj[k] - expected[k]) < 1e-6);
+    }
+}
+#endif
+
+/* models solved asynchronously and polled from one thread;
+   last one is cancelled at once */
+void testAsyncSolves() {
+    enum { nAsync = 6 };
+    Cbc_Model *models[nAsync];
+    double expected[nAsync];
+
+    for ( int k=0 ; k<nAsync ; ++k ) {
+        Cbc_Model *model = buildKnapsack(k);
+        Cbc_solve(model);
+        expected[k] = Cbc_getObjValue(model);
+        Cbc_deleteModel(model);
+    }
+
+    for ( int k=0 ; k<nAsync ; ++k ) {
+        models[k] = buildKnapsack(k);
+        assert(Cbc_solveAsync(models[k]) == 0);
+    }
+    Cbc_cancel(models[nAsync-1]);
+
+    int running;
+    do {
+        running = 0;
+        for ( int k=0 ; k<nAsync ; ++k ) {
+            double bound, incumbent;
+            int nodes;
+            if (Cbc_poll(models[k], &bound, &incumbent, &nodes))
+                running++;
+            assert(nodes >= 0);
+        }
+        if (running)
+            Cbc_waitFor(models[0], 0.01);
+    } while (running);
+
+    for ( int k=0 ; k<nAsync ; ++k ) {
+        assert(Cbc_waitFor(models[k], -1.0) >= 0);
+        assert(!Cbc_poll(models[k], NULL, NULL, NULL));
+        if (k < nAsync-1) {
+            double incumbent;
+            assert(Cbc_isProvenOptimal(models[k]));
+            assert(fabs(Cbc_getObjValue(models[k]) - expected[k]) < 1e-6);
+            Cbc_poll(models[k], NULL, &incumbent, NULL);
+            assert(fabs(incumbent - expected[k]) < 1e-6);
+        }
+        Cbc_deleteModel(models[k]);
+    }
+}
+
 int main() {
     printf("\nStarting C Interface test.\n\n");
     char buildInfo[1024];
@@ -1115,5 +1267,12 @@ int main() {
     testTSPUlysses22( 1 );
     testTSPUlysses22( 0 );
 
+#ifndef _WIN32
+    printf("Concurrent solves test\n");
+    testConcurrentSolves();
+#endif
+    printf("Asynchronous solves test\n");
+    testAsyncSolves();
+
     return 0;
 }
@@ -0,0 +1,400 @@
+// Copyright (C) 2005, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#pragma warning(disable : 4786)
+#endif
+/*
+  Micro-benchmarks of branch and bound hot paths.
+
+  Data is captured from a real model - LP solutions, bases and bound
+  changes from dives from the root, cuts generated at each LP of the dives
+  and nodes with the objective, depth and infeasibilities seen - then each
+  component is driven with it in isolation:
+
+    tree      CbcTree::push then bestNode until empty
+    apply     CbcPartialNodeInfo::applyToModel for path to each dive node
+    cuts      CbcRowCuts::addCutIfNotDuplicate for stream of cuts
+    score     OsiObject::infeasibility for each object (as chooseDynamicBranch)
+    feasible  CbcModel::feasibleSolution for each LP solution
+
+  and ns/op and allocations (operator new calls) per op are printed.
+
+  usage: microBench [file.mps] [repeats]
+*/
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "CoinHelperFunctions.hpp"
+#include "CoinTime.hpp"
+#include "CoinWarmStartBasis.hpp"
+#include "OsiClpSolverInterface.hpp"
+#include "OsiCuts.hpp"
+#include "CglGomory.hpp"
+#include "CglKnapsackCover.hpp"
+#include "CglMixedIntegerRounding2.hpp"
+#include "CbcModel.hpp"
+#include "CbcNode.hpp"
+#include "CbcPartialNodeInfo.hpp"
+#include "CbcTree.hpp"
+#include "CbcCompareDefault.hpp"
+#include "CbcCountRowCut.hpp"
+
+// count allocations
+static size_t numberAllocations = 0;
+
+void *operator new(size_t size)
+#if __cplusplus < 201103L
+  throw(std::bad_alloc)
+#endif
+{
+  numberAllocations++;
+  void *p = malloc(size ? size : 1);
+  if (!p)
+    throw std::bad_alloc();
+  return p;
+}
+
+void operator delete(void *p)
+#if __cplusplus >= 201103L
+  noexcept
+#else
+  throw()
+#endif
+{
+  free(p);
+}
+
+// One node seen in a dive
+typedef struct {
+  double objective;
+  double sumInfeasibilities;
+  int depth;
+  int numberUnsatisfied;
+  // index of dive node above (-1 at root)
+  int parent;
+  // bound change from parent (upper if column has 0x80000000 set)
+  int column;
+  double bound;
+  // basis at node as difference from parent
+  CoinWarmStartDiff *basisDiff;
+} benchNode;
+
+typedef struct {
+  std::vector< benchNode > nodes;
+  std::vector< double * > solutions;
+  OsiCuts cuts;
+} benchData;
+
+static void generateCuts(OsiSolverInterface *solver, benchData &data)
+{
+  CglGomory gomory;
+  CglKnapsackCover knapsack;
+  CglMixedIntegerRounding2 mixedIntegerRounding;
+  gomory.generateCuts(*solver, data.cuts);
+  knapsack.generateCuts(*solver, data.cuts);
+  mixedIntegerRounding.generateCuts(*solver, data.cuts);
+}
+
+// Dive from root fixing most fractional variable, alternate dives go down first
+static void captureData(CbcModel &model, int numberDives, benchData &data)
+{
+  OsiSolverInterface *solver = model.solver();
+  int numberColumns = solver->getNumCols();
+  double *saveLower = CoinCopyOfArray(solver->getColLower(), numberColumns);
+  double *saveUpper = CoinCopyOfArray(solver->getColUpper(), numberColumns);
+  CoinWarmStart *rootBasis = solver->getWarmStart();
+  double tolerance = model.getIntegerTolerance();
+  for (int iDive = 0; iDive < numberDives; iDive++) {
+    solver->setColLower(saveLower);
+    solver->setColUpper(saveUpper);
+    solver->setWarmStart(rootBasis);
+    solver->resolve();
+    int parent = -1;
+    int column = -1;
+    double bound = 0.0;
+    CoinWarmStart *lastBasis = rootBasis->clone();
+    int depth = 0;
+    while (solver->isProvenOptimal()) {
+      const double *solution = solver->getColSolution();
+      int numberUnsatisfied = 0;
+      double sumInfeasibilities = 0.0;
+      int chosen = -1;
+      double best = 0.0;
+      for (int i = 0; i < numberColumns; i++) {
+        if (!solver->isInteger(i))
+          continue;
+        double away = fabs(solution[i] - floor(solution[i] + 0.5));
+        if (away > tolerance) {
+          numberUnsatisfied++;
+          sumInfeasibilities += away;
+          // vary choice between dives
+          double value = away + 1.0e-3 * ((i * 7 + iDive * 13) % 97);
+          if (value > best) {
+            best = value;
+            chosen = i;
+          }
+        }
+      }
+      benchNode node;
+      node.objective = solver->getObjValue();
+      node.sumInfeasibilities = sumInfeasibilities;
+      node.depth = depth;
+      node.numberUnsatisfied = numberUnsatisfied;
+      node.parent = parent;
+      node.column = column;
+      node.bound = bound;
+      CoinWarmStart *basis = solver->getWarmStart();
+      node.basisDiff = basis->generateDiff(lastBasis);
+      delete lastBasis;
+      lastBasis = basis;
+      parent = static_cast< int >(data.nodes.size());
+      data.nodes.push_back(node);
+      data.solutions.push_back(CoinCopyOfArray(solution, numberColumns));
+      generateCuts(solver, data);
+      if (chosen < 0)
+        break;
+      bool down = ((iDive + depth) & 1) != 0;
+      if (down) {
+        bound = floor(solution[chosen]);
+        column = chosen | 0x80000000;
+        solver->setColUpper(chosen, bound);
+      } else {
+        bound = ceil(solution[chosen]);
+        column = chosen;
+        solver->setColLower(chosen, bound);
+      }
+      solver->resolve();
+      depth++;
+    }
+    delete lastBasis;
+  }
+  solver->setColLower(saveLower);
+  solver->setColUpper(saveUpper);
+  solver->setWarmStart(rootBasis);
+  solver->resolve();
+  delete rootBasis;
+  delete[] saveLower;
+  delete[] saveUpper;
+}
+
+static void report(const char *name, double time, size_t allocations, double numberOps)
+{
+  if (numberOps <= 0.0)
+    numberOps = 1.0;
+  printf("%-10s %12.0f ops %10.1f ns/op %8.2f allocs/op\n", name, numberOps,
+    1.0e9 * time / numberOps, static_cast< double >(allocations) / numberOps);
+}
+
+static void benchTree(const benchData &data, int numberRepeats)
+{
+  int numberNodes = static_cast< int >(data.nodes.size());
+  double time = 0.0;
+  size_t allocations = 0;
+  std::vector< CbcNode * > nodes(numberNodes);
+  for (int iRepeat = 0; iRepeat < numberRepeats; iRepeat++) {
+    for (int i = 0; i < numberNodes; i++) {
+      const benchNode &node = data.nodes[i];
+      CbcNode *newNode = new CbcNode();
+      newNode->setObjectiveValue(node.objective);
+      newNode->setDepth(node.depth);
+      newNode->setNumberUnsatisfied(node.numberUnsatisfied);
+      newNode->setSumInfeasibilities(node.sumInfeasibilities);
+      newNode->setGuessedObjectiveValue(node.objective + node.sumInfeasibilities);
+      newNode->setNodeInfo(new CbcPartialNodeInfo(NULL, newNode, 0, NULL, NULL,
+        node.basisDiff));
+      nodes[i] = newNode;
+    }
+    CbcTree tree;
+    CbcCompareDefault compare;
+    tree.setComparison(compare);
+    size_t saveAllocations = numberAllocations;
+    double startTime = CoinGetTimeOfDay();
+    for (int i = 0; i < numberNodes; i++)
+      tree.push(nodes[i]);
+    while (!tree.empty())
+      tree.bestNode(COIN_DBL_MAX);
+    time += CoinGetTimeOfDay() - startTime;
+    allocations += numberAllocations - saveAllocations;
+    for (int i = 0; i < numberNodes; i++)
+      delete nodes[i];
+  }
+  report("tree", time, allocations, 2.0 * numberNodes * numberRepeats);
+}
+
+static void benchApply(CbcModel &model, const benchData &data, int numberRepeats)
+{
+  OsiSolverInterface *solver = model.solver();
+  int numberNodes = static_cast< int >(data.nodes.size());
+  std::vector< CbcPartialNodeInfo * > infos(numberNodes);
+  for (int i = 0; i < numberNodes; i++) {
+    const benchNode &node = data.nodes[i];
+    CbcNodeInfo *parent = node.parent >= 0 ? infos[node.parent] : NULL;
+    int numberChanged = node.column != -1 ? 1 : 0;
+    infos[i] = new CbcPartialNodeInfo(parent, NULL, numberChanged,
+      &node.column, &node.bound, node.basisDiff);
+  }
+  int numberColumns = solver->getNumCols();
+  double *saveLower = CoinCopyOfArray(solver->getColLower(), numberColumns);
+  double *saveUpper = CoinCopyOfArray(solver->getColUpper(), numberColumns);
+  CoinWarmStartBasis *rootBasis = dynamic_cast< CoinWarmStartBasis * >(solver->getWarmStart());
+  std::vector< const CbcNodeInfo * > path;
+  double time = 0.0;
+  size_t allocations = 0;
+  double numberOps = 0.0;
+  for (int iRepeat = 0; iRepeat < numberRepeats; iRepeat++) {
+    for (int i = 0; i < numberNodes; i++) {
+      // root first as in CbcModel::addCuts1
+      path.clear();
+      for (const CbcNodeInfo *info = infos[i]; info; info = info->parent())
+        path.push_back(info);
+      CoinWarmStartBasis *basis = new CoinWarmStartBasis(*rootBasis);
+      int currentNumberCuts = 0;
+      size_t saveAllocations = numberAllocations;
+      double startTime = CoinGetTimeOfDay();
+      for (int j = static_cast< int >(path.size()) - 1; j >= 0; j--)
+        path[j]->applyToModel(&model, basis, NULL, currentNumberCuts);
+      time += CoinGetTimeOfDay() - startTime;
+      allocations += numberAllocations - saveAllocations;
+      numberOps += static_cast< double >(path.size());
+      delete basis;
+      solver->setColLower(saveLower);
+      solver->setColUpper(saveUpper);
+    }
+  }
+  report("apply", time, allocations, numberOps);
+  // free leaves first so parents are not deleted from under children
+  for (int i = numberNodes - 1; i >= 0; i--) {
+    infos[i]->decrement(infos[i]->numberPointingToThis());
+    infos[i]->nullParent();
+    delete infos[i];
+  }
+  delete rootBasis;
+  delete[] saveLower;
+  delete[] saveUpper;
+}
+
+static void benchCuts(const benchData &data, int numberRepeats)
+{
+  int numberCuts = data.cuts.sizeRowCuts();
+  double time = 0.0;
+  size_t allocations = 0;
+  for (int iRepeat = 0; iRepeat < numberRepeats; iRepeat++) {
+    size_t saveAllocations = numberAllocations;
+    double startTime = CoinGetTimeOfDay();
+    {
+      CbcRowCuts rowCuts;
+      for (int i = 0; i < numberCuts; i++)
+        rowCuts.addCutIfNotDuplicate(*data.cuts.rowCutPtr(i));
+    }
+    time += CoinGetTimeOfDay() - startTime;
+    allocations += numberAllocations - saveAllocations;
+  }
+  report("cuts", time, allocations,
+    static_cast< double >(numberCuts) * numberRepeats);
+}
+
+static void benchScore(CbcModel &model, const benchData &data, int numberRepeats)
+{
+  int numberSolutions = static_cast< int >(data.solutions.size());
+  int numberObjects = model.numberObjects();
+  OsiObject **objects = model.objects();
+  double time = 0.0;
+  size_t allocations = 0;
+  double sum = 0.0;
+  for (int iRepeat = 0; iRepeat < numberRepeats; iRepeat++) {
+    for (int i = 0; i < numberSolutions; i++) {
+      model.setTestSolution(data.solutions[i]);
+      size_t saveAllocations = numberAllocations;
+      double startTime = CoinGetTimeOfDay();
+      OsiBranchingInformation usefulInfo = model.usefulInformation();
+      for (int j = 0; j < numberObjects; j++) {
+        int preferredWay;
+        sum += objects[j]->infeasibility(&usefulInfo, preferredWay);
+      }
+      time += CoinGetTimeOfDay() - startTime;
+      allocations += numberAllocations - saveAllocations;
+    }
+  }
+  model.setTestSolution(NULL);
+  report("score", time, allocations,
+    static_cast< double >(numberSolutions) * numberObjects * numberRepeats);
+  if (sum < 0.0)
+    printf("odd sum of infeasibilities %g\n", sum);
+}
+
+static void benchFeasible(CbcModel &model, const benchData &data, int numberRepeats)
+{
+  OsiSolverInterface *solver = model.solver();
+  int numberSolutions = static_cast< int >(data.solutions.size());
+  double time = 0.0;
+  size_t allocations = 0;
+  for (int iRepeat = 0; iRepeat < numberRepeats; iRepeat++) {
+    for (int i = 0; i < numberSolutions; i++) {
+      solver->setColSolution(data.solutions[i]);
+      int numberIntegerInfeasibilities;
+      int numberObjectInfeasibilities;
+      size_t saveAllocations = numberAllocations;
+      double startTime = CoinGetTimeOfDay();
+      model.feasibleSolution(numberIntegerInfeasibilities,
+        numberObjectInfeasibilities);
+      time += CoinGetTimeOfDay() - startTime;
+      allocations += numberAllocations - saveAllocations;
+    }
+  }
+  report("feasible", time, allocations,
+    static_cast< double >(numberSolutions) * numberRepeats);
+}
+
+int main(int argc, const char *argv[])
+{
+  std::string mpsFile;
+  if (argc > 1)
+    mpsFile = argv[1];
+  else
+    mpsFile = "p0033.mps";
+  int numberRepeats = argc > 2 ? atoi(argv[2]) : 100;
+  if (numberRepeats < 1)
+    numberRepeats = 1;
+  OsiClpSolverInterface solver1;
+  solver1.messageHandler()->setLogLevel(0);
+  if (solver1.readMps(mpsFile.c_str(), "") < 0) {
+    fprintf(stderr, "Unable to read %s\n", mpsFile.c_str());
+    return 1;
+  }
+  solver1.initialSolve();
+  if (!solver1.isProvenOptimal()) {
+    fprintf(stderr, "Continuous problem of %s not optimal\n", mpsFile.c_str());
+    return 1;
+  }
+  CbcModel model(solver1);
+  model.setLogLevel(0);
+  model.findIntegers(false);
+  benchData data;
+  double startTime = CoinGetTimeOfDay();
+  captureData(model, 20, data);
+  printf("%s - %d nodes, %d cuts from dives captured in %.2f seconds, %d repeats\n",
+    mpsFile.c_str(), static_cast< int >(data.nodes.size()),
+    data.cuts.sizeRowCuts(), CoinGetTimeOfDay() - startTime, numberRepeats);
+  benchTree(data, numberRepeats);
+  benchApply(model, data, numberRepeats);
+  benchCuts(data, numberRepeats);
+  benchScore(model, data, numberRepeats);
+  benchFeasible(model, data, numberRepeats);
+  for (size_t i = 0; i < data.nodes.size(); i++)
+    delete data.nodes[i].basisDiff;
+  for (size_t i = 0; i < data.solutions.size(); i++)
+    delete[] data.solutions[i];
+  return 0;
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
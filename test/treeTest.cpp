@@ -0,0 +1,278 @@
+// Copyright (C) 2005, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#pragma warning(disable : 4786)
+#endif
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <vector>
+using namespace std;
+#include "CoinHelperFunctions.hpp"
+#include "CoinWarmStartBasis.hpp"
+#include "CbcNode.hpp"
+#include "CbcTree.hpp"
+#include "CbcCompareObjective.hpp"
+#include "CbcCompareDepth.hpp"
+#include "CbcSubProblem.hpp"
+
+/** Copy constructor, assignment and clone of CbcTreeDHeap
+    (with ties so comparison object is used as well as inline keys) */
+void heapCopy(int &error_count);
+#ifdef CBC_HAS_CLP
+/** Serialize of CbcSubProblem read back by deserialize
+    (all kinds of bound change and a basis with runs) */
+void subProblemSerialize(int &error_count);
+#endif
+
+int main(int argc, const char *argv[])
+{
+  WindowsErrorPopupBlocker();
+  int error_count = 0;
+
+  heapCopy(error_count);
+#ifdef CBC_HAS_CLP
+  subProblemSerialize(error_count);
+#endif
+
+  if (error_count) {
+    cout << "\n" << error_count << " errors in tree tests" << endl;
+    return 1;
+  }
+  cout << "\nAll tree tests passed" << endl;
+  return 0;
+}
+
+// Pops all nodes of heap into order
+static void popAll(CbcTree &heap, std::vector< CbcNode * > &order)
+{
+  order.clear();
+  while (!heap.empty()) {
+    order.push_back(heap.top());
+    heap.pop();
+  }
+}
+
+// Checks order is by objective and the same as wanted
+static void checkOrder(const char *what, const std::vector< CbcNode * > &order,
+  const std::vector< CbcNode * > &wanted, int numberNodes, int &error_count)
+{
+  if (static_cast< int >(order.size()) != numberNodes
+    || order != wanted) {
+    cerr << "Error: " << what << " gives different nodes" << endl;
+    error_count++;
+    return;
+  }
+  for (int i = 1; i < numberNodes; i++) {
+    if (order[i]->objectiveValue() < order[i - 1]->objectiveValue()) {
+      cerr << "Error: " << what << " out of order at " << i << endl;
+      error_count++;
+      return;
+    }
+  }
+}
+
+void heapCopy(int &error_count)
+{
+  const double objective[] = { 5.0, 3.0, 8.0, 3.0, 1.0, 9.0, 4.0, 3.0, 7.0, 1.0, 6.0, 2.0 };
+  const int numberNodes = static_cast< int >(sizeof(objective) / sizeof(double));
+  std::vector< CbcNode * > nodes;
+  for (int i = 0; i < numberNodes; i++) {
+    CbcNode *node = new CbcNode();
+    node->setObjectiveValue(objective[i]);
+    node->setGuessedObjectiveValue(objective[i]);
+    node->setDepth(i % 4);
+    nodes.push_back(node);
+  }
+  // ties broken by node number of tree as nodes have no node info
+  CbcCompareObjective compare;
+  compare.sayThreaded();
+  CbcTreeDHeap heap;
+  heap.setComparison(compare);
+  for (int i = 0; i < numberNodes; i++)
+    heap.push(nodes[i]);
+  // order of original (on a copy so original stays)
+  std::vector< CbcNode * > wanted;
+  {
+    CbcTreeDHeap reference(heap);
+    if (reference.size() != numberNodes || reference.top() != heap.top()) {
+      cerr << "Error: copy of heap has different size or top" << endl;
+      error_count++;
+    }
+    popAll(reference, wanted);
+  }
+  if (heap.size() != numberNodes) {
+    cerr << "Error: popping copy changed original heap" << endl;
+    error_count++;
+  }
+  // assignment over existing heap with other comparison
+  {
+    CbcCompareDepth compareDepth;
+    compareDepth.sayThreaded();
+    CbcTreeDHeap assigned;
+    assigned.setComparison(compareDepth);
+    assigned.push(new CbcNode());
+    CbcNode *extra = assigned.top();
+    assigned = heap;
+    delete extra;
+    std::vector< CbcNode * > order;
+    popAll(assigned, order);
+    checkOrder("assigned heap", order, wanted, numberNodes, error_count);
+  }
+  // clone and new nodes pushed on copy
+  {
+    CbcTree *cloned = heap.clone();
+    CbcNode *extra = new CbcNode();
+    extra->setObjectiveValue(3.0);
+    extra->setGuessedObjectiveValue(3.0);
+    cloned->push(extra);
+    std::vector< CbcNode * > order;
+    popAll(*cloned, order);
+    std::vector< CbcNode * > wantedExtra;
+    for (int i = 0; i < numberNodes; i++) {
+      wantedExtra.push_back(wanted[i]);
+      // newest of equal objective comes last
+      if (wanted[i]->objectiveValue() == 3.0
+        && (i == numberNodes - 1 || wanted[i + 1]->objectiveValue() != 3.0))
+        wantedExtra.push_back(extra);
+    }
+    checkOrder("cloned heap", order, wantedExtra, numberNodes + 1, error_count);
+    delete extra;
+    delete cloned;
+  }
+  // original still gives same order
+  {
+    std::vector< CbcNode * > order;
+    popAll(heap, order);
+    checkOrder("original heap", order, wanted, numberNodes, error_count);
+  }
+  for (int i = 0; i < numberNodes; i++)
+    delete nodes[i];
+}
+
+#ifdef CBC_HAS_CLP
+void subProblemSerialize(int &error_count)
+{
+  CbcSubProblem sub;
+  sub.objectiveValue_ = 12.5;
+  sub.sumInfeasibilities_ = 0.75;
+  sub.branchValue_ = 3.5;
+  sub.djValue_ = -1.25;
+  sub.depth_ = 7;
+  sub.numberInfeasibilities_ = 3;
+  sub.problemStatus_ = 256 + 5;
+  sub.branchVariable_ = -1;
+  // columns up and down, both flag bits and every kind of bound
+  const int column[] = { 4, 2, 9, 9, 1000000, 0, 17 };
+  const int flags[] = { 0, 2, 1, 3, 0, 2, 1 };
+  const double bound[] = { 1.0, 0.0, -3.0, 250.0, 2.5, 1.0e12, 1.0e-7 };
+  int numberChanged = static_cast< int >(sizeof(column) / sizeof(int));
+  sub.numberChangedBounds_ = numberChanged;
+  sub.variables_ = new int[numberChanged];
+  sub.newBounds_ = new double[numberChanged];
+  for (int i = 0; i < numberChanged; i++) {
+    sub.variables_[i] = static_cast< int >(static_cast< unsigned int >(column[i])
+      | (static_cast< unsigned int >(flags[i]) << 30));
+    sub.newBounds_[i] = bound[i];
+  }
+  int numberColumns = 20;
+  int numberRows = 6;
+  sub.status_ = new CoinWarmStartBasis();
+  sub.status_->setSize(numberColumns, numberRows);
+  for (int i = 0; i < numberColumns; i++)
+    sub.status_->setStructStatus(i, static_cast< CoinWarmStartBasis::Status >((i / 3) % 4));
+  for (int i = 0; i < numberRows; i++)
+    sub.status_->setArtifStatus(i, (i < 4) ? CoinWarmStartBasis::basic : CoinWarmStartBasis::atUpperBound);
+  int size = sub.serializedSize();
+  std::vector< unsigned char > buffer(size + 1);
+  if (sub.serialize(&buffer[0]) != size) {
+    cerr << "Error: serialize gives different size from serializedSize" << endl;
+    error_count++;
+    return;
+  }
+  CbcSubProblem back;
+  if (back.deserialize(&buffer[0], size) != size) {
+    cerr << "Error: deserialize does not use all of buffer" << endl;
+    error_count++;
+    return;
+  }
+  if (back.objectiveValue_ != sub.objectiveValue_
+    || back.sumInfeasibilities_ != sub.sumInfeasibilities_
+    || back.branchValue_ != sub.branchValue_ || back.djValue_ != sub.djValue_
+    || back.depth_ != sub.depth_
+    || back.numberInfeasibilities_ != sub.numberInfeasibilities_
+    || back.problemStatus_ != sub.problemStatus_
+    || back.branchVariable_ != sub.branchVariable_) {
+    cerr << "Error: deserialized subproblem has different values" << endl;
+    error_count++;
+  }
+  if (back.numberChangedBounds_ != numberChanged) {
+    cerr << "Error: deserialized subproblem has " << back.numberChangedBounds_
+         << " bound changes not " << numberChanged << endl;
+    error_count++;
+  } else {
+    for (int i = 0; i < numberChanged; i++) {
+      if (back.variables_[i] != sub.variables_[i]
+        || back.newBounds_[i] != sub.newBounds_[i]) {
+        cerr << "Error: bound change " << i << " differs after deserialize" << endl;
+        error_count++;
+        break;
+      }
+    }
+  }
+  if (!back.status_ || back.status_->getNumStructural() != numberColumns
+    || back.status_->getNumArtificial() != numberRows) {
+    cerr << "Error: deserialized basis has wrong size" << endl;
+    error_count++;
+  } else {
+    for (int i = 0; i < numberColumns; i++) {
+      if (back.status_->getStructStatus(i) != sub.status_->getStructStatus(i)) {
+        cerr << "Error: status of column " << i << " differs after deserialize" << endl;
+        error_count++;
+        break;
+      }
+    }
+    for (int i = 0; i < numberRows; i++) {
+      if (back.status_->getArtifStatus(i) != sub.status_->getArtifStatus(i)) {
+        cerr << "Error: status of row " << i << " differs after deserialize" << endl;
+        error_count++;
+        break;
+      }
+    }
+  }
+  // serialized again gives same bytes
+  if (back.serializedSize() != size) {
+    cerr << "Error: deserialized subproblem serializes to different size" << endl;
+    error_count++;
+  } else {
+    std::vector< unsigned char > again(size);
+    back.serialize(&again[0]);
+    if (memcmp(&again[0], &buffer[0], size)) {
+      cerr << "Error: deserialized subproblem serializes to different bytes" << endl;
+      error_count++;
+    }
+  }
+  // truncated buffer must be refused
+  CbcSubProblem truncated;
+  if (truncated.deserialize(&buffer[0], size - 1) != -1) {
+    cerr << "Error: deserialize accepts truncated buffer" << endl;
+    error_count++;
+  }
+  // and no basis
+  delete sub.status_;
+  sub.status_ = NULL;
+  size = sub.serializedSize();
+  sub.serialize(&buffer[0]);
+  if (back.deserialize(&buffer[0], size) != size || back.status_
+    || back.numberChangedBounds_ != numberChanged) {
+    cerr << "Error: subproblem without basis not read back" << endl;
+    error_count++;
+  }
+}
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/